@@ -34,12 +34,34 @@ using Real = double;
 
 #endif // SINGLE_PRECISION_ENABLED
 
+// type alias for storage of face-centered fluxes.  In mixed precision mode fluxes are
+// computed in double precision but stored (halving their memory traffic) as floats,
+// while conserved variables, the time integrator and all reductions remain in doubles.
+// Because each face flux is stored once and used by both adjacent cells, the update
+// remains conservative to round-off.
+#if MIXED_PRECISION_ENABLED
+using FluxReal = float;
+#else
+using FluxReal = Real;
+#endif
+
+// type alias for storage of radiation intensities.  In radiation mixed precision mode the
+// intensities (and their fluxes, coarse copies and intermediate RK register) are stored
+// as floats, halving the memory used by radiation, while angular moments, the implicit
+// source term solve and all arithmetic in the update are performed in Real.
+#if RAD_MIXED_PRECISION_ENABLED
+using RadReal = float;
+#else
+using RadReal = Real;
+#endif
+
 //----------------------------------------------------------------------------------------
 // general purpose macros (never modified)
 
-// number of bits needed to store MeshBlock local ID in each rank in an integer.  Thus
-// maximum number of MBs per rank is 2^(NUM_BITS_LID).  Limit is set by MPI tag limit
-#define NUM_BITS_LID 14
+// number of bits of MPI tags used to store boundary buffer IDs.  The remaining bits up to
+// MPI_TAG_UB store the MeshBlock local ID (global_variable::nbits_lid), which sets the
+// maximum number of MBs per rank
+#define NUM_BITS_BUFID 6
 
 #define SQR(x) ( (x)*(x) )
 #define SIGN(x) ( ((x) < 0.0) ? -1.0 : 1.0 )
@@ -55,6 +77,8 @@ enum BFieldIndex {IBX=0, IBY=1, IBZ=2, NMAG=3};
 // array indices for metric matrices in GR
 enum MetricIndex {I00=0, I01=1, I02=2, I03=3, I11=4, I12=5, I13=6, I22=7, I23=8, I33=9,
                   NMETRIC=10};
+// array indices for grey M1 radiation moments: energy density and flux
+enum RadMomentIndex {IRE=0, IRF1=1, IRF2=2, IRF3=3, NRMOM=4};
 // array indices for particle arrays
 enum ParticlesIndex {PGID=0, PTAG=1, IPX=0, IPVX=1, IPY=2, IPVY=3, IPZ=4, IPVZ=5};
 
@@ -64,6 +88,9 @@ enum ReconstructionMethod {dc, plm, ppm4, ppmx, wenoz};
 // constants that enumerate time evolution options
 enum TimeEvolution {tstatic, kinematic, dynamic};
 
+// constants that enumerate non-relativistic EOS, used to instantiate kernels per EOS
+enum class EOS_Type {isothermal, ideal};
+
 // constants that enumerate Physics Modules implemented in code
 enum PhysicsModule {HydroDynamics, MagnetoHydroDynamics,
                     SpaceTimeDynamics, UserDefined}; //SpaceTimeDynamics = Z4c
@@ -138,6 +165,27 @@ using ScrArray1D = Kokkos::View<T *, LayoutWrapper, ScratchMemSpace,
 template <typename T>
 using ScrArray2D = Kokkos::View<T **, LayoutWrapper, ScratchMemSpace,
                                      Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+template <typename T>
+using ScrArray3D = Kokkos::View<T ***, LayoutWrapper, ScratchMemSpace,
+                                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+template <typename T>
+using ScrArray4D = Kokkos::View<T ****, LayoutWrapper, ScratchMemSpace,
+                                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+// length of the innermost (unit-stride) dimension of a scratch array, rounded up to a
+// multiple of SIMD_WIDTH so that every row of a ScrArray2D/3D starts on a vector boundary
+constexpr int ScrRowLength(int n) {
+  return ((n + SIMD_WIDTH - 1)/SIMD_WIDTH)*SIMD_WIDTH;
+}
+
+// When FIXED_MB_NX1>0 the x1-size of MeshBlocks and the number of ghost zones are fixed
+// at compile time, so the limits of the inner (vector) loops and the sizes of scratch
+// arrays in the most expensive kernels are constants that the compiler can unroll.
+#if FIXED_MB_NX1 > 0
+#define FIXED_MB_IS (FIXED_NGHOST)
+#define FIXED_MB_IE (FIXED_NGHOST + FIXED_MB_NX1 - 1)
+#define FIXED_MB_NCELLS1 (FIXED_MB_NX1 + 2*(FIXED_NGHOST))
+#endif
 
 //----------------------------------------------------------------------------------------
 // struct for storing face-centered (area-averaged) variables, e.g. magnetic field
@@ -332,6 +380,85 @@ inline void par_for(const std::string &name, DevExeSpace exec_space,
   });
 }
 
+//----------------------------------------------------------------------------------------
+// Launch parameters for outer (team) loops.  By default every par_for_outer uses
+// Kokkos::AUTO for the team size and vector length.  These can be overridden for each
+// named kernel from a file of tuned values, or searched for automatically in a
+// calibration run (see utils/launch_tuning.cpp).  The scratch level is always the one
+// requested by the caller, since kernels allocate their team scratch at that level.
+
+namespace launch_tuning {
+struct LaunchParams {
+  int team_size;      // 0 = Kokkos::AUTO
+  int vector_length;  // 0 = Kokkos::AUTO
+};
+extern bool active;   // false unless tuning file read or calibration requested
+LaunchParams GetParams(const std::string &name, bool &calibrating);
+void RecordTime(const std::string &name, double time);
+} // namespace launch_tuning
+
+//------------------------------------------
+// construct TeamPolicy from launch parameters
+inline Kokkos::TeamPolicy<> MakeTeamPolicy(DevExeSpace exec_space, const int nteams,
+                                           const launch_tuning::LaunchParams &lp) {
+  if (lp.team_size > 0 && lp.vector_length > 0) {
+    return Kokkos::TeamPolicy<>(exec_space, nteams, lp.team_size, lp.vector_length);
+  } else if (lp.team_size > 0) {
+    return Kokkos::TeamPolicy<>(exec_space, nteams, lp.team_size, Kokkos::AUTO);
+  } else if (lp.vector_length > 0) {
+    return Kokkos::TeamPolicy<>(exec_space, nteams, Kokkos::AUTO, lp.vector_length);
+  }
+  return Kokkos::TeamPolicy<>(exec_space, nteams, Kokkos::AUTO);
+}
+
+//------------------------------------------
+// launch functor over nteams teams, using tuned launch parameters when available
+template <typename Functor>
+inline void team_launch(const std::string &name, DevExeSpace exec_space, const int nteams,
+                        size_t scr_size, const int scr_level, const Functor &functor) {
+  if (!launch_tuning::active) {
+    Kokkos::TeamPolicy<> policy(exec_space, nteams, Kokkos::AUTO);
+    Kokkos::parallel_for(name, policy.set_scratch_size(scr_level,
+                         Kokkos::PerTeam(scr_size)), functor);
+    return;
+  }
+
+  // get parameters for this kernel, rejecting any that cannot be launched
+  bool calibrating;
+  launch_tuning::LaunchParams lp;
+  Kokkos::TeamPolicy<> policy(exec_space, nteams, Kokkos::AUTO);
+  while (true) {
+    lp = launch_tuning::GetParams(name, calibrating);
+    int vmax = Kokkos::TeamPolicy<>::vector_length_max();
+    bool valid = (lp.vector_length <= vmax) &&
+                 ((lp.vector_length & (lp.vector_length - 1)) == 0);
+    if (valid) {
+      policy = MakeTeamPolicy(exec_space, nteams, lp);
+      policy.set_scratch_size(scr_level, Kokkos::PerTeam(scr_size));
+      valid = (static_cast<int>(scr_size) <= policy.scratch_size_max(scr_level)) &&
+              (lp.team_size <= policy.team_size_max(functor, Kokkos::ParallelForTag()));
+    }
+    if (valid) break;
+    if (!calibrating) {  // tuned values do not fit this device; revert to defaults
+      lp = {0, 0};
+      policy = MakeTeamPolicy(exec_space, nteams, lp);
+      policy.set_scratch_size(scr_level, Kokkos::PerTeam(scr_size));
+      break;
+    }
+    launch_tuning::RecordTime(name, -1.0);
+  }
+
+  if (calibrating) {
+    Kokkos::fence();
+    Kokkos::Timer timer;
+    Kokkos::parallel_for(name, policy, functor);
+    Kokkos::fence();
+    launch_tuning::RecordTime(name, timer.seconds());
+  } else {
+    Kokkos::parallel_for(name, policy, functor);
+  }
+}
+
 //------------------------------------------
 // 1D outer parallel loop using Kokkos Teams
 template <typename Function>
@@ -339,8 +466,7 @@ inline void par_for_outer(const std::string &name, DevExeSpace exec_space,
                           size_t scr_size, const int scr_level,
                           const int kl, const int ku, const Function &function) {
   const int nk = ku - kl + 1;
-  Kokkos::TeamPolicy<> policy(exec_space, nk, Kokkos::AUTO);
-  Kokkos::parallel_for(name, policy.set_scratch_size(scr_level,Kokkos::PerTeam(scr_size)),
+  team_launch(name, exec_space, nk, scr_size, scr_level,
   KOKKOS_LAMBDA(TeamMember_t tmember) {
     const int k = tmember.league_rank() + kl;
     function(tmember, k);
@@ -357,8 +483,7 @@ inline void par_for_outer(const std::string &name, DevExeSpace exec_space,
   const int nk = ku - kl + 1;
   const int nj = ju - jl + 1;
   const int nkj = nk*nj;
-  Kokkos::TeamPolicy<> policy(exec_space, nkj, Kokkos::AUTO);
-  Kokkos::parallel_for(name, policy.set_scratch_size(scr_level,Kokkos::PerTeam(scr_size)),
+  team_launch(name, exec_space, nkj, scr_size, scr_level,
   KOKKOS_LAMBDA(TeamMember_t tmember) {
     const int k = tmember.league_rank()/nj + kl;
     const int j = tmember.league_rank()%nj + jl;
@@ -378,8 +503,7 @@ inline void par_for_outer(const std::string &name, DevExeSpace exec_space,
   const int nj = ju - jl + 1;
   const int nkj  = nk*nj;
   const int nnkj = nn*nk*nj;
-  Kokkos::TeamPolicy<> policy(exec_space, nnkj, Kokkos::AUTO);
-  Kokkos::parallel_for(name, policy.set_scratch_size(scr_level,Kokkos::PerTeam(scr_size)),
+  team_launch(name, exec_space, nnkj, scr_size, scr_level,
   KOKKOS_LAMBDA(TeamMember_t tmember) {
     int n = (tmember.league_rank())/nkj;
     int k = (tmember.league_rank() - n*nkj)/nj;
@@ -405,8 +529,7 @@ inline void par_for_outer(const std::string &name, DevExeSpace exec_space,
   const int nkj   = nk*nj;
   const int nnkj  = nn*nk*nj;
   const int nmnkj = nm*nn*nk*nj;
-  Kokkos::TeamPolicy<> policy(exec_space, nmnkj, Kokkos::AUTO);
-  Kokkos::parallel_for(name, policy.set_scratch_size(scr_level,Kokkos::PerTeam(scr_size)),
+  team_launch(name, exec_space, nmnkj, scr_size, scr_level,
   KOKKOS_LAMBDA(TeamMember_t tmember) {
     int m = (tmember.league_rank())/nnkj;
     int n = (tmember.league_rank() - m*nnkj)/nkj;
@@ -9,6 +9,12 @@
 //  \brief provides classes for tensor-like fields
 //
 //  Convention: indices a,b,c,d are tensor indices. Indices n,i,j,k are grid indices.
+//
+//  Components are stored with each symmetric pair of indices packed (a<=b in row-major
+//  order).  The maps from tensor indices to components are constexpr functions, so they
+//  are resolved at compile time for constant indices (e.g. in unrolled loops), and
+//  otherwise cost a few integer operations, rather than a lookup in a table stored in
+//  (and captured with) every tensor.
 
 #include <cassert> // assert
 #include <utility>
@@ -22,6 +28,68 @@ enum class TensorSymm {
   SYM22,    // symmetric in the last 2 pairs of indices
 };
 
+//----------------------------------------------------------------------------------------
+// compile-time maps from tensor indices to stored components
+namespace tensor_index {
+
+// number of independent components of a symmetric pair of indices
+template<int ndim>
+constexpr int NSym() {return ndim*(ndim + 1)/2;}
+
+// component of a symmetric pair of indices (a,b)
+template<int ndim>
+KOKKOS_FORCEINLINE_FUNCTION
+constexpr int SymPair(int const a, int const b) {
+  int const lo = (a < b)? a : b;
+  int const hi = (a < b)? b : a;
+  return lo*ndim - (lo*(lo - 1))/2 + (hi - lo);
+}
+
+template<TensorSymm sym, int ndim>
+struct Map {
+  // number of stored components of tensors of rank 2, 3, and 4
+  static constexpr int ndof2 = (sym == TensorSymm::SYM2 || sym == TensorSymm::ISYM2)?
+                               NSym<ndim>() : ndim*ndim;
+  static constexpr int ndof3 = (sym == TensorSymm::SYM2 || sym == TensorSymm::ISYM2)?
+                               ndim*NSym<ndim>() : ndim*ndim*ndim;
+  static constexpr int ndof4 = (sym == TensorSymm::SYM22)? NSym<ndim>()*NSym<ndim>() :
+                               ((sym == TensorSymm::SYM2 || sym == TensorSymm::ISYM2)?
+                               ndim*ndim*NSym<ndim>() : ndim*ndim*ndim*ndim);
+
+  KOKKOS_FORCEINLINE_FUNCTION
+  static constexpr int Index(int const a, int const b) {
+    if constexpr (sym == TensorSymm::SYM2 || sym == TensorSymm::ISYM2) {
+      return SymPair<ndim>(a, b);
+    } else {
+      return a*ndim + b;
+    }
+  }
+  KOKKOS_FORCEINLINE_FUNCTION
+  static constexpr int Index(int const a, int const b, int const c) {
+    if constexpr (sym == TensorSymm::SYM2) {
+      return a*NSym<ndim>() + SymPair<ndim>(b, c);
+    } else if constexpr (sym == TensorSymm::ISYM2) {
+      return SymPair<ndim>(a, b)*ndim + c;
+    } else {
+      return (a*ndim + b)*ndim + c;
+    }
+  }
+  KOKKOS_FORCEINLINE_FUNCTION
+  static constexpr int Index(int const a, int const b, int const c, int const d) {
+    if constexpr (sym == TensorSymm::SYM2) {
+      return (a*ndim + b)*NSym<ndim>() + SymPair<ndim>(c, d);
+    } else if constexpr (sym == TensorSymm::ISYM2) {
+      return (SymPair<ndim>(a, b)*ndim + c)*ndim + d;
+    } else if constexpr (sym == TensorSymm::SYM22) {
+      return SymPair<ndim>(a, b)*NSym<ndim>() + SymPair<ndim>(c, d);
+    } else {
+      return ((a*ndim + b)*ndim + c)*ndim + d;
+    }
+  }
+};
+
+} // namespace tensor_index
+
 
 using sub_DvceArray5D_2D = decltype(Kokkos::subview(
                            std::declval<DvceArray5D<Real>>(),
@@ -109,21 +177,22 @@ class AthenaHostTensor<T, sym, ndim, 1> {
 template<typename T, TensorSymm sym, int ndim>
 class AthenaHostTensor<T, sym, ndim, 2> {
  public:
-  AthenaHostTensor();
-  // the default destructor/copy operators are sufficient
+  // the default constructor/destructor/copy operators are sufficient
+  AthenaHostTensor() = default;
   ~AthenaHostTensor() = default;
   AthenaHostTensor(AthenaHostTensor<T, sym, ndim, 2> const &) = default;
   AthenaHostTensor<T, sym, ndim, 2> & operator=
   (AthenaHostTensor<T, sym, ndim, 2> const &) = default;
 
-  int idxmap(int const a, int const b) const {
-    return idxmap_[a][b];
+  KOKKOS_INLINE_FUNCTION
+  static constexpr int idxmap(int const a, int const b) {
+    return tensor_index::Map<sym, ndim>::Index(a, b);
   }
   // operators to access the data
   KOKKOS_INLINE_FUNCTION
   decltype(auto) operator() (int const m, int const a, int const b,
                              int const k, int const j, int const i) const {
-    return data_(m,idxmap_[a][b],k,j,i);
+    return data_(m,idxmap(a,b),k,j,i);
   }
   //KOKKOS_INLINE_FUNCTION
   void InitWithShallowSlice(HostArray5D<Real> src, const int indx1, const int indx2) {
@@ -133,35 +202,8 @@ class AthenaHostTensor<T, sym, ndim, 2> {
 
  private:
   sub_HostArray5D_2D data_;
-  int idxmap_[3][3];
-  int ndof_;
 };
 
-//----------------------------------------------------------------------------------------
-// Implementation details
-// They are all duplicated to account for dim 0
-template<typename T, TensorSymm sym, int ndim>
-AthenaHostTensor<T, sym, ndim, 2>::AthenaHostTensor() {
-  switch(sym) {
-    case TensorSymm::NONE:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = 0; b < ndim; ++b) {
-        idxmap_[a][b] = ndof_++;
-      }
-      break;
-    case TensorSymm::SYM2:
-    case TensorSymm::ISYM2:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = a; b < ndim; ++b) {
-        idxmap_[a][b] = ndof_++;
-        idxmap_[b][a] = idxmap_[a][b];
-      }
-      break;
-  }
-}
-
 
 // this is the abstract base class
 // This now works only for spatially 3D data
@@ -225,21 +267,22 @@ class AthenaTensor<T, sym, ndim, 1> {
 template<typename T, TensorSymm sym, int ndim>
 class AthenaTensor<T, sym, ndim, 2> {
  public:
-  AthenaTensor();
-  // the default destructor/copy operators are sufficient
+  // the default constructor/destructor/copy operators are sufficient
+  AthenaTensor() = default;
   ~AthenaTensor() = default;
   AthenaTensor(AthenaTensor<T, sym, ndim, 2> const &) = default;
   AthenaTensor<T, sym, ndim, 2> & operator=
   (AthenaTensor<T, sym, ndim, 2> const &) = default;
 
-  int idxmap(int const a, int const b) const {
-    return idxmap_[a][b];
+  KOKKOS_INLINE_FUNCTION
+  static constexpr int idxmap(int const a, int const b) {
+    return tensor_index::Map<sym, ndim>::Index(a, b);
   }
   // operators to access the data
   KOKKOS_INLINE_FUNCTION
   decltype(auto) operator() (int const m, int const a, int const b,
                              int const k, int const j, int const i) const {
-    return data_(m,idxmap_[a][b],k,j,i);
+    return data_(m,idxmap(a,b),k,j,i);
   }
   //KOKKOS_INLINE_FUNCTION
   void InitWithShallowSlice(DvceArray5D<Real> src, const int indx1, const int indx2) {
@@ -249,38 +292,11 @@ class AthenaTensor<T, sym, ndim, 2> {
 
  private:
   sub_DvceArray5D_2D data_;
-  int idxmap_[3][3];
-  int ndof_;
 };
 
-//----------------------------------------------------------------------------------------
-// Implementation details
-// They are all duplicated to account for dim 0
-template<typename T, TensorSymm sym, int ndim>
-AthenaTensor<T, sym, ndim, 2>::AthenaTensor() {
-  switch(sym) {
-    case TensorSymm::NONE:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = 0; b < ndim; ++b) {
-        idxmap_[a][b] = ndof_++;
-      }
-      break;
-    case TensorSymm::SYM2:
-    case TensorSymm::ISYM2:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = a; b < ndim; ++b) {
-        idxmap_[a][b] = ndof_++;
-        idxmap_[b][a] = idxmap_[a][b];
-      }
-      break;
-  }
-}
-
 
-// Here tensors are defined as static 1D arrays, with compile-time dimension calculated as
-// dim**rank
+// Here tensors are defined as static 1D arrays, with compile-time dimension equal to the
+// number of independent components
 // this is the abstract base class
 template<typename T, TensorSymm sym, int ndim, int rank>
 class AthenaScratchTensor;
@@ -314,7 +330,7 @@ class AthenaScratchTensor<T, sym, ndim, 1> {
   }
 
  private:
-  Real data_[3];
+  Real data_[ndim];
 };
 
 //----------------------------------------------------------------------------------------
@@ -323,224 +339,111 @@ class AthenaScratchTensor<T, sym, ndim, 1> {
 template<typename T, TensorSymm sym, int ndim>
 class AthenaScratchTensor<T, sym, ndim, 2> {
  public:
-  KOKKOS_INLINE_FUNCTION
-  AthenaScratchTensor();
-  // the default destructor/copy operators are sufficient
+  // the default constructor/destructor/copy operators are sufficient
+  AthenaScratchTensor() = default;
   ~AthenaScratchTensor() = default;
   AthenaScratchTensor(AthenaScratchTensor<T, sym, ndim, 2> const &) = default;
   AthenaScratchTensor<T, sym, ndim, 2> & operator=
   (AthenaScratchTensor<T, sym, ndim, 2> const &) = default;
   KOKKOS_INLINE_FUNCTION
-  int idxmap(int const a, int const b) const {
-    return idxmap_[a][b];
+  static constexpr int idxmap(int const a, int const b) {
+    return tensor_index::Map<sym, ndim>::Index(a, b);
   }
   KOKKOS_INLINE_FUNCTION
   Real operator()(int const a, int const b) const {
-    return data_[idxmap_[a][b]];
+    return data_[idxmap(a,b)];
   }
   KOKKOS_INLINE_FUNCTION
   Real & operator()(int const a, int const b) {
-    return data_[idxmap_[a][b]];
+    return data_[idxmap(a,b)];
   }
   KOKKOS_INLINE_FUNCTION
   void ZeroClear() {
-    for (int i = 0; i < ndim*ndim; ++i) {
+    for (int i = 0; i < ndof; ++i) {
       data_[i] = 0.0;
     }
   }
 
  private:
-  Real data_[9];
-  int idxmap_[3][3];
-  int ndof_;
+  // number of stored components, with symmetric pairs of indices packed
+  static constexpr int ndof = tensor_index::Map<sym, ndim>::ndof2;
+  Real data_[ndof];
 };
 
-//----------------------------------------------------------------------------------------
-// Implementation details
-template<typename T, TensorSymm sym, int ndim>
-KOKKOS_INLINE_FUNCTION
-AthenaScratchTensor<T, sym, ndim, 2>::AthenaScratchTensor() {
-switch(sym) {
-    case TensorSymm::NONE:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = 0; b < ndim; ++b) {
-        idxmap_[a][b] = ndof_++;
-      }
-      break;
-    case TensorSymm::SYM2:
-    case TensorSymm::ISYM2:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = a; b < ndim; ++b) {
-        idxmap_[a][b] = ndof_++;
-        idxmap_[b][a] = idxmap_[a][b];
-      }
-      break;
-  }
-}
-
 //----------------------------------------------------------------------------------------
 // rank 3 AthenaScratchTensor
 // This is a 0D AthenaScratchTensor
 template<typename T, TensorSymm sym, int ndim>
 class AthenaScratchTensor<T, sym, ndim, 3> {
  public:
-  KOKKOS_INLINE_FUNCTION
-  AthenaScratchTensor();
-  // the default destructor/copy operators are sufficient
+  // the default constructor/destructor/copy operators are sufficient
+  AthenaScratchTensor() = default;
   ~AthenaScratchTensor() = default;
   AthenaScratchTensor(AthenaScratchTensor<T, sym, ndim, 3> const &) = default;
   AthenaScratchTensor<T, sym, ndim, 3> & operator=
   (AthenaScratchTensor<T, sym, ndim, 3> const &) = default;
   KOKKOS_INLINE_FUNCTION
-  int idxmap(int const a, int const b, int const c) const {
-    return idxmap_[a][b][c];
+  static constexpr int idxmap(int const a, int const b, int const c) {
+    return tensor_index::Map<sym, ndim>::Index(a, b, c);
   }
   KOKKOS_INLINE_FUNCTION
   Real operator()(int const a, int const b, int const c) const {
-    return data_[idxmap_[a][b][c]];
+    return data_[idxmap(a,b,c)];
   }
   KOKKOS_INLINE_FUNCTION
   Real & operator()(int const a, int const b, int const c) {
-    return data_[idxmap_[a][b][c]];
+    return data_[idxmap(a,b,c)];
   }
   KOKKOS_INLINE_FUNCTION
   void ZeroClear() {
-    for (int i = 0; i < ndim*ndim*ndim; ++i) {
+    for (int i = 0; i < ndof; ++i) {
       data_[i] = 0.0;
     }
   }
 
  private:
-  Real data_[27];
-  int idxmap_[3][3][3];
-  int ndof_;
+  // number of stored components, with symmetric pairs of indices packed
+  static constexpr int ndof = tensor_index::Map<sym, ndim>::ndof3;
+  Real data_[ndof];
 };
 
-//----------------------------------------------------------------------------------------
-// Implementation details
-template<typename T, TensorSymm sym, int ndim>
-KOKKOS_INLINE_FUNCTION
-AthenaScratchTensor<T, sym, ndim, 3>::AthenaScratchTensor() {
-  switch(sym) {
-    case TensorSymm::NONE:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = 0; b < ndim; ++b)
-      for(int c = 0; c < ndim; ++c) {
-        idxmap_[a][b][c] = ndof_++;
-      }
-      break;
-    case TensorSymm::SYM2:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = 0; b < ndim; ++b)
-      for(int c = b; c < ndim; ++c) {
-        idxmap_[a][b][c] = ndof_++;
-        idxmap_[a][c][b] = idxmap_[a][b][c];
-      }
-      break;
-    case TensorSymm::ISYM2:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = a; b < ndim; ++b)
-      for(int c = 0; c < ndim; ++c) {
-        idxmap_[a][b][c] = ndof_++;
-        idxmap_[b][a][c] = idxmap_[a][b][c];
-      }
-      break;
-  }
-}
-
 //----------------------------------------------------------------------------------------
 // rank 4 AthenaScratchTensor
 // This is a 0D AthenaScratchTensor
 template<typename T, TensorSymm sym, int ndim>
 class AthenaScratchTensor<T, sym, ndim, 4> {
  public:
-  KOKKOS_INLINE_FUNCTION
-  AthenaScratchTensor();
-  // the default destructor/copy operators are sufficient
+  // the default constructor/destructor/copy operators are sufficient
+  AthenaScratchTensor() = default;
   ~AthenaScratchTensor() = default;
   AthenaScratchTensor(AthenaScratchTensor<T, sym, ndim, 4> const &) = default;
   AthenaScratchTensor<T, sym, ndim, 4> & operator=
   (AthenaScratchTensor<T, sym, ndim, 4> const &) = default;
   KOKKOS_INLINE_FUNCTION
-  int idxmap(int const a, int const b, int const c, int const d) const {
-    return idxmap_[a][b][c][d];
+  static constexpr int idxmap(int const a, int const b, int const c, int const d) {
+    return tensor_index::Map<sym, ndim>::Index(a, b, c, d);
   }
   KOKKOS_INLINE_FUNCTION
   Real operator()(int const a, int const b,
                   int const c, int const d) const {
-    return data_[idxmap_[a][b][c][d]];
+    return data_[idxmap(a,b,c,d)];
   }
   KOKKOS_INLINE_FUNCTION
   Real & operator()(int const a, int const b,
                     int const c, int const d) {
-    return data_[idxmap_[a][b][c][d]];
+    return data_[idxmap(a,b,c,d)];
   }
   KOKKOS_INLINE_FUNCTION
   void ZeroClear() {
-    for (int i = 0; i < ndim*ndim*ndim*ndim; ++i) {
+    for (int i = 0; i < ndof; ++i) {
       data_[i] = 0.0;
     }
   }
 
  private:
-  Real data_[81];
-  int idxmap_[3][3][3][3];
-  int ndof_;
+  // number of stored components, with symmetric pairs of indices packed
+  static constexpr int ndof = tensor_index::Map<sym, ndim>::ndof4;
+  Real data_[ndof];
 };
 
-//----------------------------------------------------------------------------------------
-// Implementation details
-template<typename T, TensorSymm sym, int ndim>
-KOKKOS_INLINE_FUNCTION
-AthenaScratchTensor<T, sym, ndim, 4>::AthenaScratchTensor() {
-  switch(sym) {
-    case TensorSymm::NONE:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = 0; b < ndim; ++b)
-      for(int c = 0; c < ndim; ++c)
-      for(int d = 0; d < ndim; ++d) {
-        idxmap_[a][b][c][d] = ndof_++;
-      }
-      break;
-    case TensorSymm::SYM2:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = 0; b < ndim; ++b)
-      for(int c = 0; c < ndim; ++c)
-      for(int d = c; d < ndim; ++d) {
-        idxmap_[a][b][c][d] = ndof_++;
-        idxmap_[a][b][d][c] = idxmap_[a][b][c][d];
-      }
-      break;
-    case TensorSymm::ISYM2:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = a; b < ndim; ++b)
-      for(int c = 0; c < ndim; ++c)
-      for(int d = 0; d < ndim; ++d) {
-        idxmap_[a][b][c][d] = ndof_++;
-        idxmap_[b][a][c][d] = idxmap_[a][b][c][d];
-      }
-      break;
-    case TensorSymm::SYM22:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = a; b < ndim; ++b)
-      for(int c = 0; c < ndim; ++c)
-      for(int d = c; d < ndim; ++d) {
-        idxmap_[a][b][c][d] = ndof_++;
-        idxmap_[b][a][c][d] = idxmap_[a][b][c][d];
-        idxmap_[a][b][d][c] = idxmap_[a][b][c][d];
-        idxmap_[b][a][d][c] = idxmap_[a][b][c][d];
-      }
-      break;
-  }
-}
-
 #endif // ATHENA_TENSOR_HPP_
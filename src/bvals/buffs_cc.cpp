@@ -30,17 +30,20 @@ void MeshBoundaryValuesCC::InitSendIndices(MeshBoundaryBuffer &buf,
   auto &mb_indcs  = pmy_pack->pmesh->mb_indcs;
   int ng  = mb_indcs.ng;
   int ng1 = ng - 1;
+  // depth of ghost zones exchanged with neighbors on the same level
+  int ngs  = nghost_exch;
+  int ngs1 = ngs - 1;
 
   // set indices for sends to neighbors on SAME level
   // Formulae taken from LoadBoundaryBufferSameLevel() in src/bvals/cc/bvals_cc.cpp
   if ((f1 == 0) && (f2 == 0)) {  // this buffer used for same level (e.g. #0,4,8,12,...)
     auto &isame = buf.isame[0];    // indices of buffer for neighbor same level
-    isame.bis = (ox1 > 0) ? (mb_indcs.ie - ng1) : mb_indcs.is;
-    isame.bie = (ox1 < 0) ? (mb_indcs.is + ng1) : mb_indcs.ie;
-    isame.bjs = (ox2 > 0) ? (mb_indcs.je - ng1) : mb_indcs.js;
-    isame.bje = (ox2 < 0) ? (mb_indcs.js + ng1) : mb_indcs.je;
-    isame.bks = (ox3 > 0) ? (mb_indcs.ke - ng1) : mb_indcs.ks;
-    isame.bke = (ox3 < 0) ? (mb_indcs.ks + ng1) : mb_indcs.ke;
+    isame.bis = (ox1 > 0) ? (mb_indcs.ie - ngs1) : mb_indcs.is;
+    isame.bie = (ox1 < 0) ? (mb_indcs.is + ngs1) : mb_indcs.ie;
+    isame.bjs = (ox2 > 0) ? (mb_indcs.je - ngs1) : mb_indcs.js;
+    isame.bje = (ox2 < 0) ? (mb_indcs.js + ngs1) : mb_indcs.je;
+    isame.bks = (ox3 > 0) ? (mb_indcs.ke - ngs1) : mb_indcs.ks;
+    isame.bke = (ox3 < 0) ? (mb_indcs.ks + ngs1) : mb_indcs.ke;
     buf.isame_ndat = (isame.bie - isame.bis + 1)*(isame.bje - isame.bjs + 1)*
                      (isame.bke - isame.bks + 1);
   }
@@ -165,6 +168,7 @@ void MeshBoundaryValuesCC::InitRecvIndices(MeshBoundaryBuffer &buf,
                                            int ox1, int ox2, int ox3, int f1, int f2) {
   auto &mb_indcs  = pmy_pack->pmesh->mb_indcs;
   int ng = mb_indcs.ng;
+  int ngs = nghost_exch;  // depth of ghost zones exchanged with neighbors on same level
 
   // set indices for receives from neighbors on SAME level
   // Formulae taken from SetBoundarySameLevel() in src/bvals/cc/bvals_cc.cpp
@@ -173,25 +177,25 @@ void MeshBoundaryValuesCC::InitRecvIndices(MeshBoundaryBuffer &buf,
     if (ox1 == 0) {
       isame.bis = mb_indcs.is;          isame.bie = mb_indcs.ie;
     } else if (ox1 > 0) {
-      isame.bis = mb_indcs.ie + 1;      isame.bie = mb_indcs.ie + ng;
+      isame.bis = mb_indcs.ie + 1;      isame.bie = mb_indcs.ie + ngs;
     } else {
-      isame.bis = mb_indcs.is - ng;     isame.bie = mb_indcs.is - 1;
+      isame.bis = mb_indcs.is - ngs;    isame.bie = mb_indcs.is - 1;
     }
 
     if (ox2 == 0) {
       isame.bjs = mb_indcs.js;          isame.bje = mb_indcs.je;
     } else if (ox2 > 0) {
-      isame.bjs = mb_indcs.je + 1;      isame.bje = mb_indcs.je + ng;
+      isame.bjs = mb_indcs.je + 1;      isame.bje = mb_indcs.je + ngs;
     } else {
-      isame.bjs = mb_indcs.js - ng;     isame.bje = mb_indcs.js - 1;
+      isame.bjs = mb_indcs.js - ngs;    isame.bje = mb_indcs.js - 1;
     }
 
     if (ox3 == 0) {
       isame.bks = mb_indcs.ks;          isame.bke = mb_indcs.ke;
     } else if (ox3 > 0) {
-      isame.bks = mb_indcs.ke + 1;      isame.bke = mb_indcs.ke + ng;
+      isame.bks = mb_indcs.ke + 1;      isame.bke = mb_indcs.ke + ngs;
     } else {
-      isame.bks = mb_indcs.ks - ng;     isame.bke = mb_indcs.ks - 1;
+      isame.bks = mb_indcs.ks - ngs;    isame.bke = mb_indcs.ks - 1;
     }
     buf.isame_ndat = (isame.bie - isame.bis + 1)*(isame.bje - isame.bjs + 1)*
                      (isame.bke - isame.bks + 1);
@@ -9,8 +9,10 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <string>
 #include <utility>
 #include <algorithm> // max
+#include <vector>
 
 #include "athena.hpp"
 #include "globals.hpp"
@@ -18,6 +20,7 @@
 #include "mesh/nghbr_index.hpp"
 #include "mesh/mesh.hpp"
 #include "particles/particles.hpp"
+#include "utils/memory_registry.hpp"
 #include "bvals.hpp"
 
 //----------------------------------------------------------------------------------------
@@ -28,9 +31,53 @@ MeshBoundaryValues::MeshBoundaryValues(MeshBlockPack *pp, ParameterInput *pin, b
   is_z4c_(z4c),
   u_in("uin",1,1),
   b_in("bin",1,1),
-  i_in("iin",1,1) {
+  i_in("iin",1,1),
+  prol_list("prol_list",1),
+  rank_on_node("rank_on_node",1),
+  nprol_(0),
+  prol_version_(-1) {
+  nghost_exch = pmy_pack->pmesh->mb_indcs.ng;
   // allocate vector of status flags and MPI requests (if needed)
   int nnghbr = pmy_pack->pmb->nnghbr;
+  persistent_mpi_ = pin->GetOrAddBoolean("mesh", "persistent_mpi", false);
+  coalesce_mpi_ = pin->GetOrAddBoolean("mesh", "coalesce_mpi", false);
+  // coalesced messages are rebuilt when the mesh changes, so no persistent requests
+  if (coalesce_mpi_) {persistent_mpi_ = false;}
+  // direct copies between ranks on the same node are only implemented for coalesced
+  // messages with GPU-aware MPI on CUDA/HIP devices
+  node_ipc_ = pin->GetOrAddBoolean("mesh", "node_ipc", false);
+  if (node_ipc_ && (!(coalesce_mpi_) || !(NODE_IPC_ENABLED))) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<mesh>/node_ipc requires <mesh>/coalesce_mpi=true, GPU-aware MPI, and "
+              << "a CUDA or HIP device. All messages will be sent with MPI." << std::endl;
+    node_ipc_ = false;
+  }
+  // one-sided messages are only implemented for coalesced messages
+  rma_mpi_ = pin->GetOrAddBoolean("mesh", "rma_mpi", false);
+  if (rma_mpi_ && (!(coalesce_mpi_) || node_ipc_)) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<mesh>/rma_mpi requires <mesh>/coalesce_mpi=true, and cannot be used "
+              << "with <mesh>/node_ipc. Messages will be sent with MPI_Isend/Irecv."
+              << std::endl;
+    rma_mpi_ = false;
+  }
+  // device-to-device messages with NCCL are only implemented for coalesced messages
+  nccl_ = pin->GetOrAddBoolean("mesh", "nccl", false);
+  if (nccl_ && (!(coalesce_mpi_) || node_ipc_ || rma_mpi_ || !(NCCL_ENABLED))) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<mesh>/nccl requires <mesh>/coalesce_mpi=true and compiling with "
+              << "Athena_ENABLE_NCCL, and cannot be used with <mesh>/node_ipc or "
+              << "<mesh>/rma_mpi. Messages will be sent with MPI." << std::endl;
+    nccl_ = false;
+  }
+#if MPI_PARALLEL_ENABLED
+  nmb_req_ = std::max((pmy_pack->nmb_thispack), (pmy_pack->pmesh->nmb_maxperrank));
+  precv_nvar_ = -1;
+  psend_nvar_ = -1;
+  precv_version_ = -1;
+  psend_version_ = -1;
+  poll_start_ = -1.0;
+#endif
 
   // sendbuf and recvbuf are fixed-length [56-element] arrays
   // Initialize some of the data in appropriate elements based on dimensionality of
@@ -38,7 +85,7 @@ MeshBoundaryValues::MeshBoundaryValues(MeshBlockPack *pp, ParameterInput *pin, b
   for (int n=0; n<nnghbr; ++n) {
 #if MPI_PARALLEL_ENABLED
     // allocate vector of MPI requests (if needed)
-    int nmb = std::max((pmy_pack->nmb_thispack), (pmy_pack->pmesh->nmb_maxperrank));
+    int nmb = nmb_req_;
     sendbuf[n].vars_req = new MPI_Request[nmb];
     sendbuf[n].flux_req = new MPI_Request[nmb];
     recvbuf[n].vars_req = new MPI_Request[nmb];
@@ -67,8 +114,14 @@ MeshBoundaryValues::MeshBoundaryValues(MeshBlockPack *pp, ParameterInput *pin, b
 
 #if MPI_PARALLEL_ENABLED
   // create unique communicators for variables and fluxes in this BoundaryValues object
-  MPI_Comm_dup(MPI_COMM_WORLD, &comm_vars);
-  MPI_Comm_dup(MPI_COMM_WORLD, &comm_flux);
+  MPI_Comm_dup(global_variable::athena_comm, &comm_vars);
+  MPI_Comm_dup(global_variable::athena_comm, &comm_flux);
+#endif
+#if NCCL_ENABLED
+  if (nccl_) {
+    nccl_vars_.Init(comm_vars);
+    nccl_flux_.Init(comm_flux);
+  }
 #endif
 }
 
@@ -78,15 +131,59 @@ MeshBoundaryValues::MeshBoundaryValues(MeshBlockPack *pp, ParameterInput *pin, b
 MeshBoundaryValues::~MeshBoundaryValues() {
 #if MPI_PARALLEL_ENABLED
   int nnghbr = pmy_pack->pmb->nnghbr;
+  if (persistent_mpi_) {
+    FreePersistentRequests(sendbuf);
+    FreePersistentRequests(recvbuf);
+  }
   for (int n=0; n<nnghbr; ++n) {
     delete [] sendbuf[n].vars_req;
     delete [] sendbuf[n].flux_req;
     delete [] recvbuf[n].vars_req;
     delete [] recvbuf[n].flux_req;
   }
+  if (node_ipc_) {
+    FreeCoalescedIPC(csend_vars_);
+    FreeCoalescedIPC(crecv_vars_);
+    FreeCoalescedIPC(csend_flux_);
+    FreeCoalescedIPC(crecv_flux_);
+  }
+  if (rma_mpi_) {
+    FreeCoalescedRMA(crecv_vars_);
+    FreeCoalescedRMA(crecv_flux_);
+  }
 #endif
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn int MeshBoundaryValues::SetGhostDepth()
+//! \brief Sets the number of ghost cells exchanged with neighbors on the same level to
+//! <block>/nghost (default <mesh>/nghost), so that a module needing fewer ghost cells
+//! than others (e.g. PLM hydro coupled to Z4c with 4 ghost cells) sends smaller messages.
+//! Arrays are still allocated with <mesh>/nghost ghost cells, and those beyond this depth
+//! are set by physical BCs but not by neighbors.  Only used on uniform grids without a
+//! shearing box, since prolongation and orbital advection read all ghost cells.  Must be
+//! called before InitializeBuffers().  Returns the number of ghost cells exchanged.
+
+int MeshBoundaryValues::SetGhostDepth(ParameterInput *pin, const std::string &block) {
+  int ng = pmy_pack->pmesh->mb_indcs.ng;
+  nghost_exch = pin->GetOrAddInteger(block, "nghost", ng);
+  if (nghost_exch < 2 || nghost_exch > ng) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<" << block << ">/nghost=" << nghost_exch << " must be at least 2 and "
+              << "at most <mesh>/nghost=" << ng << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  if (nghost_exch < ng &&
+      (pmy_pack->pmesh->multilevel || pin->DoesBlockExist("shearing_box"))) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<" << block << ">/nghost cannot be less than <mesh>/nghost with "
+              << "SMR/AMR or shearing box. All ghost cells will be exchanged."
+              << std::endl;
+    nghost_exch = ng;
+  }
+  return nghost_exch;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void MeshBoundaryValues::InitializeBuffers
 //! \brief initialize each element of send/recv MeshBoundaryBuffers fixed-length arrays
@@ -97,6 +194,7 @@ MeshBoundaryValues::~MeshBoundaryValues() {
 //! virtual functions that only get instantiated when the derived classes are constructed
 
 void MeshBoundaryValues::InitializeBuffers(const int nvar) {
+  MemoryRegistry::PushTag("bvals");
   // allocate memory for inflow BCs (but only if domain not strictly periodic)
   if (!(pmy_pack->pmesh->strictly_periodic)) {
     Kokkos::realloc(u_in, nvar, 6);
@@ -218,8 +316,102 @@ void MeshBoundaryValues::InitializeBuffers(const int nvar) {
     }
   }
 
+  // with node_ipc, find ranks on the same node (which exchange data through IPC)
+#if MPI_PARALLEL_ENABLED
+  if (node_ipc_) {FindRanksOnNode();}
+#endif
+
+  // with compress_mpi, find ranks on the same node (which exchange data uncompressed),
+  // and allocate single-precision buffers.  Only implemented for messages posted
+  // separately for each buffer.
+  if (compress_mpi) {
+#if MPI_PARALLEL_ENABLED
+    if (persistent_mpi_ || coalesce_mpi_) {
+      std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "compress_mpi cannot be used with <mesh>/persistent_mpi "
+                << "or <mesh>/coalesce_mpi. Messages will not be compressed."
+                << std::endl;
+      compress_mpi = false;
+      MemoryRegistry::PopTag();
+      return;
+    }
+    FindRanksOnNode();
+
+    int nnghbr = pmy_pack->pmb->nnghbr;
+    for (int n=0; n<nnghbr; ++n) {
+      sendbuf[n].AllocateCompressedBuffers();
+      recvbuf[n].AllocateCompressedBuffers();
+    }
+#else
+    compress_mpi = false;
+#endif
+  }
+
+  MemoryRegistry::PopTag();
+  return;
+}
+
+#if MPI_PARALLEL_ENABLED
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValues::FindRanksOnNode()
+//! \brief Sets rank_on_node to true for all ranks on the same (shared-memory) node as
+//! this rank.  Collective over all ranks.
+
+void MeshBoundaryValues::FindRanksOnNode() {
+  MPI_Comm node_comm;
+  MPI_Comm_split_type(global_variable::athena_comm, MPI_COMM_TYPE_SHARED, 0,
+                      MPI_INFO_NULL, &node_comm);
+  int nnode;
+  MPI_Comm_size(node_comm, &nnode);
+  std::vector<int> node_ranks(nnode);
+  MPI_Allgather(&(global_variable::my_rank), 1, MPI_INT, node_ranks.data(), 1, MPI_INT,
+                node_comm);
+  MPI_Comm_free(&node_comm);
+  Kokkos::realloc(rank_on_node, global_variable::nranks);
+  for (int r=0; r<global_variable::nranks; ++r) {rank_on_node.h_view(r) = false;}
+  for (int r=0; r<nnode; ++r) {rank_on_node.h_view(node_ranks[r]) = true;}
+  rank_on_node.template modify<HostMemSpace>();
+  rank_on_node.template sync<DevExeSpace>();
   return;
 }
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \fn int MeshBoundaryValues::SetProlongationList()
+//! \brief Builds list of all buffers on this rank that receive data from a coarser
+//! neighbor, and returns its length.  List is only rebuilt when the mesh changes.
+
+int MeshBoundaryValues::SetProlongationList() {
+  if (prol_version_ == pmy_pack->pmesh->mesh_version) {return nprol_;}
+  int nmb = pmy_pack->nmb_thispack;
+  int nnghbr = pmy_pack->pmb->nnghbr;
+  auto &nghbr = pmy_pack->pmb->nghbr;
+  auto &mblev = pmy_pack->pmb->mb_lev;
+
+  nprol_ = 0;
+  for (int m=0; m<nmb; ++m) {
+    for (int n=0; n<nnghbr; ++n) {
+      if ((nghbr.h_view(m,n).gid >= 0) && (nghbr.h_view(m,n).lev < mblev.h_view(m))) {
+        ++nprol_;
+      }
+    }
+  }
+  if (nprol_ > static_cast<int>(prol_list.extent(0))) {
+    Kokkos::realloc(prol_list, nprol_);
+  }
+  int i = 0;
+  for (int m=0; m<nmb; ++m) {
+    for (int n=0; n<nnghbr; ++n) {
+      if ((nghbr.h_view(m,n).gid >= 0) && (nghbr.h_view(m,n).lev < mblev.h_view(m))) {
+        prol_list.h_view(i++) = m*nnghbr + n;
+      }
+    }
+  }
+  prol_list.template modify<HostMemSpace>();
+  prol_list.template sync<DevExeSpace>();
+  prol_version_ = pmy_pack->pmesh->mesh_version;
+  return nprol_;
+}
 
 //----------------------------------------------------------------------------------------
 // ParticlesBoundaryValues constructor:
@@ -227,6 +419,7 @@ void MeshBoundaryValues::InitializeBuffers(const int nvar) {
 particles::ParticlesBoundaryValues::ParticlesBoundaryValues(
   particles::Particles *pp, ParameterInput *pin) :
     sendlist("sendlist",1),
+    sendpos("sendpos",1),
 #if MPI_PARALLEL_ENABLED
     prtcl_rsendbuf("rsend",1),
     prtcl_rrecvbuf("rrecv",1),
@@ -238,11 +431,8 @@ particles::ParticlesBoundaryValues::ParticlesBoundaryValues(
   // Guess that no more than 10% of particles will be communicated to set size of buffer
   int npart = pmy_part->nprtcl_thispack;
 
-  //resize vectors over number of ranks
-  nsends_eachrank.resize(global_variable::nranks);
-
   // create unique communicator for particles
-  MPI_Comm_dup(MPI_COMM_WORLD, &mpi_comm_part);
+  MPI_Comm_dup(global_variable::athena_comm, &mpi_comm_part);
 #endif
 }
 
@@ -20,14 +20,36 @@ enum class BoundaryFlag {undef=-1,block, reflect, inflow, outflow, diode, user,
                          shear_periodic, vacuum};
 
 #include <algorithm>
+#include <cstdint>
+#include <string>
 #include <vector>
 
 #include "athena.hpp"
+#include "globals.hpp"
 #include "mesh/mesh.hpp"
 #include "coordinates/coordinates.hpp"
 #include "tasklist/task_list.hpp"
+#include "utils/nccl_channel.hpp"
 //#include "particles/particles.hpp"
 
+// Memory space of data passed to MPI calls.  Without GPU-aware MPI, buffers are staged
+// through host-pinned memory (which is just HostSpace on CPUs).
+#if MPI_PARALLEL_ENABLED && !(GPU_AWARE_MPI_ENABLED)
+using MPIBuffMemSpace = Kokkos::SharedHostPinnedSpace;
+#else
+using MPIBuffMemSpace = DevMemSpace;
+#endif
+
+// Coalesced messages between ranks on the same node can be written directly into the
+// receive buffer of the other rank through CUDA/HIP IPC (with <mesh>/node_ipc=true).
+// This requires GPU-aware MPI, since the receive buffers are then device memory.
+#if MPI_PARALLEL_ENABLED && GPU_AWARE_MPI_ENABLED && \
+    (defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP))
+#define NODE_IPC_ENABLED 1
+#else
+#define NODE_IPC_ENABLED 0
+#endif
+
 // Forward declarations
 class MeshBlockPack;
 namespace particles {
@@ -36,12 +58,23 @@ class Particles;
 
 //----------------------------------------------------------------------------------------
 //! \fn int CreateBvals_MPI_Tag(int lid, int bufid)
-//! \brief calculate an MPI tag for boundary buffer communications.  Note maximum size of
-//! lid that can be encoded is set by (NUM_BITS_LID) macro.
+//! \brief calculate an MPI tag for boundary buffer communications.  Note bufid must fit
+//! in (NUM_BITS_BUFID) bits, and the maximum size of lid that can be encoded is set by
+//! global_variable::nbits_lid, i.e. by the MPI_TAG_UB of the MPI library.
 //! The convention in Athena++ is lid and bufid are both for the *receiving* process.
 //! The MPI standard requires signed int tag, with MPI_TAG_UB>=2^15-1 = 32,767 (inclusive)
 static int CreateBvals_MPI_Tag(int lid, int bufid) {
-  return (bufid << (NUM_BITS_LID)) | lid;
+  return (bufid << (global_variable::nbits_lid)) | lid;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool IsFaceBuffer(int n)
+//! \brief returns true if boundary buffer n is for a face (rather than an edge or corner)
+//! of a MeshBlock, using the neighbor indexing scheme given in mesh/nghbr_index.hpp
+
+KOKKOS_INLINE_FUNCTION
+static bool IsFaceBuffer(int n) {
+  return (n < 16) || ((n >= 24) && (n < 32));
 }
 
 //----------------------------------------------------------------------------------------
@@ -77,11 +110,17 @@ struct MeshBoundaryBuffer {
 
   // 2D Views that store buffer data on device, dimensioned (nmb, ndata)
   DvceArray2D<Real> vars, flux;
+  // single-precision copy of vars used for compressed messages to other nodes
+  DvceArray2D<float> vars_cmp;
 
 #if MPI_PARALLEL_ENABLED
   // vectors of length (number of MBs) to hold MPI requests
   // Using STL vector causes problems with some GPU compilers, so just use plain C array
   MPI_Request *vars_req, *flux_req;
+  // buffer data passed to MPI.  With GPU-aware MPI these are the same Views as vars/flux,
+  // otherwise they are host-pinned mirrors
+  Kokkos::View<Real**, LayoutWrapper, MPIBuffMemSpace> vars_mpi, flux_mpi;
+  Kokkos::View<float**, LayoutWrapper, MPIBuffMemSpace> vars_cmp_mpi;
 #endif
 
   // function to allocate memory for buffers for variables and their fluxes
@@ -97,8 +136,81 @@ struct MeshBoundaryBuffer {
     }
     int nmax = std::max(iflxs_ndat, iflxc_ndat);
     Kokkos::realloc(flux, nmb, (nvars*nmax));
+#if MPI_PARALLEL_ENABLED
+    vars_mpi = Kokkos::create_mirror_view(MPIBuffMemSpace(), vars);
+    flux_mpi = Kokkos::create_mirror_view(MPIBuffMemSpace(), flux);
+#endif
   }
+
+  // function to allocate single-precision buffers for compressed messages
+  // Must only be called after AllocateBuffers()
+  void AllocateCompressedBuffers() {
+    Kokkos::realloc(vars_cmp, vars.extent(0), vars.extent(1));
+#if MPI_PARALLEL_ENABLED
+    vars_cmp_mpi = Kokkos::create_mirror_view(MPIBuffMemSpace(), vars_cmp);
+#endif
+  }
+};
+
+#if MPI_PARALLEL_ENABLED
+//----------------------------------------------------------------------------------------
+//! \struct CoalescedEntry
+//! \brief location of one boundary buffer within a coalesced message to/from a rank
+
+struct CoalescedEntry {
+  int rank;     // rank of sending/receiving process
+  int tag;      // tag for this buffer (encodes lid and buffer index on receiving process)
+  int m, n;     // MeshBlock and buffer indices of buffer on this rank
+  int offset;   // starting index of buffer in coalesced data
+  int size;     // number of data elements in buffer
+};
+
+//----------------------------------------------------------------------------------------
+//! \struct IpcHandleMsg
+//! \brief IPC handle of coalesced receive data, and offset of one message within it, sent
+//! to ranks on the same node.  Handles are 64 bytes with both CUDA and HIP.
+
+struct IpcHandleMsg {
+  char handle[64];
+  std::int64_t offset;
+};
+
+//----------------------------------------------------------------------------------------
+//! \struct CoalescedMessages
+//! \brief container for data, index table, and requests of messages in which all boundary
+//! buffers exchanged between a pair of ranks are aggregated into one contiguous message
+
+struct CoalescedMessages {
+  int nvar = -1;                      // number of variables when table was built
+  int version = -1;                   // Mesh::mesh_version when table was built
+  bool faces_only = false;            // value of faces_only when table was built
+  std::vector<int> msg_rank;          // rank of each message
+  std::vector<int> msg_offset;        // starting index of each message in data
+  std::vector<int> msg_size;          // number of data elements in each message
+  DualArray1D<CoalescedEntry> entry;  // index table of all buffers in all messages
+  DvceArray1D<Real> data;             // contiguous data for all messages
+  Kokkos::View<Real*, LayoutWrapper, MPIBuffMemSpace> data_mpi;  // data passed to MPI
+  std::vector<MPI_Request> req;       // request for each message
+  // with <mesh>/node_ipc, messages to/from ranks on the same node are copied directly
+  // between device buffers, and only zero-size messages are sent with MPI
+  std::vector<Real*> msg_ipc;         // address of IPC message in receiver data, or null
+  std::vector<void*> ipc_open;        // (sends) receiver allocations opened on this rank
+  Real *ipc_data = nullptr;           // (recvs) data allocated to be shared with IPC
+  std::vector<IpcHandleMsg> ipc_msg;  // handle and offset of each IPC message
+  std::vector<MPI_Request> ipc_req;   // requests for sending handles
+  std::vector<MPI_Request> ready_req; // requests for "ready to receive" messages
+  // with <mesh>/rma_mpi, receive tables expose their data and an array of flags in RMA
+  // windows.  Flags are indexed by rank, and hold (1) the last exchange (epoch)
+  // received from each sender, (2) the last epoch each receiver is ready for, and (3) the
+  // offset in the data of each receiver of the message from this rank
+  MPI_Win win_data = MPI_WIN_NULL, win_flag = MPI_WIN_NULL;
+  std::int64_t *flag = nullptr;
+  std::int64_t epoch = 0;             // number of exchanges since table was built
+  // with <mesh>/nccl, last epoch of receive table whose messages have been issued with
+  // NCCL by SendCoalesced() of the matching send table
+  std::int64_t nccl_epoch = 0;
 };
+#endif
 
 // Forward declarations
 class MeshBlockPack;
@@ -120,6 +232,28 @@ class MeshBoundaryValues {
   // constant inflow states at each face, initialized in problem generator
   DualArray2D<Real> u_in, b_in, i_in;
 
+  // flag to exchange CC variables only through buffers on faces, skipping buffers on
+  // edges and corners (which are not needed by dimensionally-split stencils)
+  bool faces_only = false;
+
+  // index of first CC variable exchanged, so that variables [0,var_start) which do not
+  // change (e.g. the fixed flow with <hydro>/fixed_flow) are skipped
+  int var_start = 0;
+
+  // number of ghost cells exchanged with neighbors on the same level, which may be less
+  // than <mesh>/nghost (see SetGhostDepth()).  Must be set before InitializeBuffers().
+  int nghost_exch;
+
+  // flag to send CC variables in single precision to MeshBlocks on other nodes (lossy
+  // compression).  Must be set before InitializeBuffers() is called.
+  bool compress_mpi = false;
+  // flag for each rank that is true if rank is on same (shared-memory) node as this rank
+  DualArray1D<bool> rank_on_node;
+
+  // list of buffers (encoded as m*nnghbr+n) at boundaries with coarser neighbors, so
+  // prolongation kernels only launch teams for buffers that are prolongated
+  DualArray1D<int> prol_list;
+
 #if MPI_PARALLEL_ENABLED
   // unique MPI communicators for each case (variables/fluxes)
   MPI_Comm comm_vars, comm_flux;
@@ -129,8 +263,35 @@ class MeshBoundaryValues {
   virtual void InitSendIndices(MeshBoundaryBuffer &buf,int x,int y,int z,int a,int b)=0;
   virtual void InitRecvIndices(MeshBoundaryBuffer &buf,int x,int y,int z,int a,int b)=0;
   void InitializeBuffers(const int nvar);
+  int SetGhostDepth(ParameterInput *pin, const std::string &block);
+  int SetProlongationList();
 
   TaskStatus InitRecv(const int nvar);
+#if MPI_PARALLEL_ENABLED
+  // functions to aggregate buffers into one message per rank (in bvals_coalesce.cpp)
+  void BuildCoalesced(CoalescedMessages &c, std::vector<CoalescedEntry> &list, int nvar);
+  void SendCoalesced(CoalescedMessages &c, bool flux, MPI_Comm comm);
+  void SendCoalescedNCCL(CoalescedMessages &c, bool flux);
+  void PostCoalescedRecv(CoalescedMessages &c, MPI_Comm comm);
+  bool TestCoalescedRecv(CoalescedMessages &c, bool flux);
+  void WaitCoalesced(CoalescedMessages &c);
+  bool CoalescedIsStale(const CoalescedMessages &c, int nvar);
+  void SetupCoalescedIPC(CoalescedMessages &c, bool recv, MPI_Comm comm);
+  void FreeCoalescedIPC(CoalescedMessages &c);
+  void SetupCoalescedRMA(CoalescedMessages &c, MPI_Comm comm);
+  void FreeCoalescedRMA(CoalescedMessages &c);
+  void FindRanksOnNode();
+  bool CompressMessage(int rank) const {
+    return compress_mpi && !(rank_on_node.h_view(rank));
+  }
+  void StageSendBuffers(bool flux);
+  void StageRecvBuffers(bool flux);
+  void StartPersistentRecv(const int nvar);
+  void StartPersistentSend(const int nvar);
+  void FreePersistentRequests(MeshBoundaryBuffer *pbuf);
+  int VarsMessageSize(MeshBoundaryBuffer *pbuf, int m, int n, int nvar);
+  void RecordPoll(bool incomplete);
+#endif
   virtual TaskStatus InitFluxRecv(const int nvar)=0;
   TaskStatus ClearRecv();
   TaskStatus ClearSend();
@@ -140,15 +301,35 @@ class MeshBoundaryValues {
   // BCs associated with various physics modules
   static void HydroBCs(MeshBlockPack *pp, DualArray2D<Real> uin, DvceArray5D<Real> u0);
   static void BFieldBCs(MeshBlockPack *pp, DualArray2D<Real> bin, DvceFaceFld4D<Real> b0);
-  static void RadiationBCs(MeshBlockPack *pp,DualArray2D<Real> iin,DvceArray5D<Real> i0);
+  static void RadiationBCs(MeshBlockPack *pp, DualArray2D<Real> iin,
+                           DvceArray5D<RadReal> i0);
   static void Z4cBCs(MeshBlockPack *pp, DualArray2D<Real> uin, DvceArray5D<Real> u0,
                      DvceArray5D<Real> coarse_u0);
+  static void WeylBCs(MeshBlockPack *pp, DvceArray5D<Real> u_weyl,
+                      DvceArray5D<Real> coarse_u_weyl);
 
  protected:
   // must use pointer to MBPack and not parent physics module since parent can be one of
   // many types (Hydro, MHD, Radiation, Z4c, etc.)
   MeshBlockPack* pmy_pack;
   bool is_z4c_;   // flag to denote if this BoundaryValues is for Z4c module
+  bool persistent_mpi_;  // flag to use persistent MPI requests for communicating vars
+  bool coalesce_mpi_;    // flag to aggregate buffers into one message per rank
+  bool node_ipc_;        // flag to copy coalesced messages on same node with device IPC
+  bool rma_mpi_;         // flag to send coalesced messages with one-sided MPI (RMA)
+  bool nccl_;            // flag to send coalesced messages with NCCL on device stream
+  int nprol_;            // number of buffers in prol_list
+  int prol_version_;     // Mesh::mesh_version when prol_list was built
+#if MPI_PARALLEL_ENABLED
+  CoalescedMessages csend_vars_, crecv_vars_, csend_flux_, crecv_flux_;
+#if NCCL_ENABLED
+  NcclChannel nccl_vars_, nccl_flux_;    // NCCL communicators for vars and fluxes
+#endif
+  int nmb_req_;                          // length of arrays of MPI requests in buffers
+  int precv_nvar_, psend_nvar_;          // # of vars in persistent recv/send requests
+  int precv_version_, psend_version_;    // Mesh::mesh_version when requests created
+  double poll_start_;                    // time of first failed poll of recvs (or -1)
+#endif
 };
 
 //----------------------------------------------------------------------------------------
@@ -165,22 +346,31 @@ class MeshBoundaryValuesCC : public MeshBoundaryValues {
   TaskStatus InitFluxRecv(const int nvar) override;
 
   // functions to communicate CC data
-  TaskStatus PackAndSendCC(DvceArray5D<Real> &a, DvceArray5D<Real> &ca);
-  TaskStatus RecvAndUnpackCC(DvceArray5D<Real> &a, DvceArray5D<Real> &ca);
+  template <typename T> TaskStatus PackAndSendCC(DvceArray5D<T> &a, DvceArray5D<T> &ca);
+  template <typename T> TaskStatus RecvAndUnpackCC(DvceArray5D<T> &a, DvceArray5D<T> &ca);
   // functions to communicate fluxes of CC data
-  TaskStatus PackAndSendFluxCC(DvceFaceFld5D<Real> &flx);
-  TaskStatus RecvAndUnpackFluxCC(DvceFaceFld5D<Real> &flx);
+  template <typename T> TaskStatus PackAndSendFluxCC(DvceFaceFld5D<T> &flx);
+  template <typename T> TaskStatus RecvAndUnpackFluxCC(DvceFaceFld5D<T> &flx);
 
   // functions to prolongate conserved and primitive CC variables
-  void FillCoarseInBndryCC(DvceArray5D<Real> &a, DvceArray5D<Real> &ca,
+  template <typename T> void FillCoarseInBndryCC(DvceArray5D<T> &a, DvceArray5D<T> &ca,
+       bool is_z4c=false);
+  template <typename T> void ProlongateCC(DvceArray5D<T> &a, DvceArray5D<T> &ca,
        bool is_z4c=false);
-  void ProlongateCC(DvceArray5D<Real> &a, DvceArray5D<Real> &ca, bool is_z4c=false);
-  void ConsToPrimCoarseBndry(const DvceArray5D<Real> &cons, DvceArray5D<Real> &prim);
-  void PrimToConsFineBndry(const DvceArray5D<Real> &prim, DvceArray5D<Real> &cons);
+  void ProlongatePrimsCC(const DvceArray5D<Real> &ccons, DvceArray5D<Real> &prim,
+                         DvceArray5D<Real> &cons);
   void ConsToPrimCoarseBndry(const DvceArray5D<Real> &cons, const DvceFaceFld4D<Real> &b,
                              DvceArray5D<Real> &prim);
   void PrimToConsFineBndry(const DvceArray5D<Real> &prim, const DvceFaceFld4D<Real> &b,
                            DvceArray5D<Real> &cons);
+
+ private:
+  // compact lists of pairs (MeshBlock,neighbor), stored as m*nnghbr+n, at faces shared
+  // with a coarser (send) or finer (recv) neighbor, the only faces with flux correction
+  DualArray1D<int> fcorr_send_, fcorr_recv_;
+  int nfcorr_send_, nfcorr_recv_;
+  int fcorr_version_;                  // Mesh::mesh_version when lists were built
+  void UpdateFluxCorrLists();
 };
 
 //----------------------------------------------------------------------------------------
@@ -219,16 +409,6 @@ struct ParticleLocationData {
   int dest_rank;    // rank of target MeshBlock
 };
 
-// Custom operators to sort ParticleLocationData array by dest_rank or prtcl_indx
-struct {
-  bool operator()(ParticleLocationData a, ParticleLocationData b)
-    const { return a.dest_rank < b.dest_rank; }
-} SortByRank;
-struct {
-  bool operator()(ParticleLocationData a, ParticleLocationData b)
-    const { return a.prtcl_indx < b.prtcl_indx; }
-} SortByIndex;
-
 //----------------------------------------------------------------------------------------
 //! \struct ParticleMessageData
 //! \brief Data describing MPI messages containing particles
@@ -252,19 +432,25 @@ class ParticlesBoundaryValues {
   ~ParticlesBoundaryValues();
 
   int nprtcl_send, nprtcl_recv;
-  DualArray1D<ParticleLocationData> sendlist;
+  DualArray1D<ParticleLocationData> sendlist;   // ordered by index in particle array
+  DvceArray1D<int> sendpos;                     // position of each send in send buffer
 
   // Data needed to count number of messages and particles to send between ranks
   int nsends; // number of MPI sends to neighboring ranks on this rank
   int nrecvs; // number of MPI recvs from neighboring ranks on this rank
-  std::vector<int> nsends_eachrank;                // length nranks
+  std::vector<int> nghbr_ranks;                    // ranks of neighboring MeshBlocks
   std::vector<ParticleMessageData> sends_thisrank; // length nsends
   std::vector<ParticleMessageData> recvs_thisrank; // length nrecvs
-  std::vector<ParticleMessageData> sends_allranks; // length ncounts summed over ranks
 
 #if MPI_PARALLEL_ENABLED
   DvceArray1D<Real> prtcl_rsendbuf, prtcl_rrecvbuf;
   DvceArray1D<int>  prtcl_isendbuf, prtcl_irecvbuf;
+  // buffer data passed to MPI.  With GPU-aware MPI these are the same Views as above,
+  // otherwise they are host-pinned mirrors
+  Kokkos::View<Real*, LayoutWrapper, MPIBuffMemSpace> prtcl_rsendbuf_mpi;
+  Kokkos::View<Real*, LayoutWrapper, MPIBuffMemSpace> prtcl_rrecvbuf_mpi;
+  Kokkos::View<int*, LayoutWrapper, MPIBuffMemSpace> prtcl_isendbuf_mpi;
+  Kokkos::View<int*, LayoutWrapper, MPIBuffMemSpace> prtcl_irecvbuf_mpi;
   std::vector<MPI_Request> rrecv_req, rsend_req;  // vectors of requests for Reals
   std::vector<MPI_Request> irecv_req, isend_req;  // vectors of requests for ints
   MPI_Comm mpi_comm_part;                       // unique MPI communicators for particles
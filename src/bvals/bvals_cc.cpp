@@ -11,6 +11,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <utility>
+#include <vector>
 
 #include "athena.hpp"
 #include "globals.hpp"
@@ -23,7 +24,12 @@
 
 MeshBoundaryValuesCC::MeshBoundaryValuesCC(MeshBlockPack *pp, ParameterInput *pin,
                                            bool z4c) :
-  MeshBoundaryValues(pp, pin, z4c) {
+  MeshBoundaryValues(pp, pin, z4c),
+  fcorr_send_("fcorr_send",1),
+  fcorr_recv_("fcorr_recv",1),
+  nfcorr_send_(0),
+  nfcorr_recv_(0),
+  fcorr_version_(-1) {
 }
 
 //----------------------------------------------------------------------------------------
@@ -38,31 +44,37 @@ MeshBoundaryValuesCC::MeshBoundaryValuesCC(MeshBlockPack *pp, ParameterInput *pi
 //! Input arrays must be 5D Kokkos View dimensioned (nmb, nvar, nx3, nx2, nx1)
 //! 5D Kokkos View of coarsened (restricted) array data also required with SMR/AMR
 
-TaskStatus MeshBoundaryValuesCC::PackAndSendCC(DvceArray5D<Real> &a,
-                                               DvceArray5D<Real> &ca) {
+template <typename T>
+TaskStatus MeshBoundaryValuesCC::PackAndSendCC(DvceArray5D<T> &a, DvceArray5D<T> &ca) {
   // create local references for variables in kernel
   int nmb = pmy_pack->nmb_thispack;
   int nnghbr = pmy_pack->pmb->nnghbr;
-  int nvar = a.extent_int(1);  // TODO(@user): 2nd index from L of in array must be NVAR
+  int vs = var_start;
+  int nvar = a.extent_int(1) - vs;  // only variables [var_start,nvar) are exchanged
 
   {int my_rank = global_variable::my_rank;
   auto &nghbr = pmy_pack->pmb->nghbr;
   auto &mbgid = pmy_pack->pmb->mb_gid;
   auto &mblev = pmy_pack->pmb->mb_lev;
+  auto &cidx = pmy_pack->pmb->mb_cidx;
   auto &sbuf = sendbuf;
   auto &rbuf = recvbuf;
   auto &is_z4c = is_z4c_;
   auto &multilevel = pmy_pack->pmesh->multilevel;
+  bool faces_only_ = faces_only;
+  bool compress = compress_mpi;
+  auto &on_node = rank_on_node;
   // Outer loop over (# of MeshBlocks)*(# of buffers)*(# of variables)
   int nmnv = nmb*nnghbr*nvar;
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), nmnv, Kokkos::AUTO);
+  Kokkos::TeamPolicy<> policy(pmy_pack->exec_space, nmnv, Kokkos::AUTO);
   Kokkos::parallel_for("SendBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
     const int m = (tmember.league_rank())/(nnghbr*nvar);
     const int n = (tmember.league_rank() - m*(nnghbr*nvar))/nvar;
     const int v = (tmember.league_rank() - m*(nnghbr*nvar) - n*nvar);
+    const int cm = cidx.d_view(m);  // index of MB in coarse array
 
-    // only load buffers when neighbor exists
-    if (nghbr.d_view(m,n).gid >= 0) {
+    // only load buffers when neighbor exists (and buffer is on a face with faces_only)
+    if (nghbr.d_view(m,n).gid >= 0 && !(faces_only_ && !(IsFaceBuffer(n)))) {
       // if neighbor is at coarser level, use coar indices to pack buffer
       int il, iu, jl, ju, kl, ku;
       if (nghbr.d_view(m,n).lev < mblev.d_view(m)) {
@@ -113,14 +125,37 @@ TaskStatus MeshBoundaryValuesCC::PackAndSendCC(DvceArray5D<Real> &a,
           if (nghbr.d_view(m,n).lev >= mblev.d_view(m)) {
             Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
             [&](const int i) {
-              rbuf[dn].vars(dm, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) = a(m,v,k,j,i);
+              rbuf[dn].vars(dm, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) = a(m,v+vs,k,j,i);
             });
             tmember.team_barrier();
           // if neighbor is at coarser level, load data from coarse_u0
           } else {
             Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
             [&](const int i) {
-              rbuf[dn].vars(dm, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) = ca(m,v,k,j,i);
+              rbuf[dn].vars(dm, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) =
+                  ca(cm,v+vs,k,j,i);
+            });
+            tmember.team_barrier();
+          }
+
+        // else copy into single-precision send buffer for compressed MPI communication
+        // to other nodes
+
+        } else if (compress && !(on_node.d_view(nghbr.d_view(m,n).rank))) {
+          // if neighbor is at same or finer level, load data from u0
+          if (nghbr.d_view(m,n).lev >= mblev.d_view(m)) {
+            Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
+            [&](const int i) {
+              sbuf[n].vars_cmp(m, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) =
+                  static_cast<float>(a(m,v+vs,k,j,i));
+            });
+            tmember.team_barrier();
+          // if neighbor is at coarser level, load data from coarse_u0
+          } else {
+            Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
+            [&](const int i) {
+              sbuf[n].vars_cmp(m, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) =
+                  static_cast<float>(ca(cm,v+vs,k,j,i));
             });
             tmember.team_barrier();
           }
@@ -132,14 +167,14 @@ TaskStatus MeshBoundaryValuesCC::PackAndSendCC(DvceArray5D<Real> &a,
           if (nghbr.d_view(m,n).lev >= mblev.d_view(m)) {
             Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
             [&](const int i) {
-              sbuf[n].vars(m, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) = a(m,v,k,j,i);
+              sbuf[n].vars(m, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) = a(m,v+vs,k,j,i);
             });
             tmember.team_barrier();
           // if neighbor is at coarser level, load data from coarse_u0
           } else {
             Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
             [&](const int i) {
-              sbuf[n].vars(m, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) = ca(m,v,k,j,i);
+              sbuf[n].vars(m, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) = ca(cm,v+vs,k,j,i);
             });
             tmember.team_barrier();
           }
@@ -152,13 +187,15 @@ TaskStatus MeshBoundaryValuesCC::PackAndSendCC(DvceArray5D<Real> &a,
     const int m = (tmember.league_rank())/(nnghbr*nvar);
     const int n = (tmember.league_rank() - m*(nnghbr*nvar))/nvar;
     const int v = (tmember.league_rank() - m*(nnghbr*nvar) - n*nvar);
+    const int cm = cidx.d_view(m);  // index of MB in coarse array
 
-    // only load buffers when neighbor exists
-    if (nghbr.d_view(m,n).gid >= 0) {
+    // only load buffers when neighbor exists (and buffer is on a face with faces_only)
+    if (nghbr.d_view(m,n).gid >= 0 && !(faces_only_ && !(IsFaceBuffer(n)))) {
       int il, iu, jl, ju, kl, ku;
       // If neighbor is at same level and data is for Z4c module, append data from coarse
-      // array for higher-order prolongation
-      if ((nghbr.d_view(m,n).lev == mblev.d_view(m)) && (is_z4c) && (multilevel)) {
+      // array for higher-order prolongation (if neighbor uses it)
+      if ((nghbr.d_view(m,n).lev == mblev.d_view(m)) && (is_z4c) && (multilevel) &&
+          (nghbr.d_view(m,n).send_coarse)) {
         il = sbuf[n].isame_z4c.bis;
         iu = sbuf[n].isame_z4c.bie;
         jl = sbuf[n].isame_z4c.bjs;
@@ -188,16 +225,26 @@ TaskStatus MeshBoundaryValuesCC::PackAndSendCC(DvceArray5D<Real> &a,
             // load data from coarse_u0
             Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
             [&](const int i) {
-              rbuf[dn].vars(dm,ndat+ (i-il + ni*(j-jl + nj*(k-kl + nk*v))))=ca(m,v,k,j,i);
+              rbuf[dn].vars(dm,ndat+ (i-il + ni*(j-jl + nj*(k-kl + nk*v)))) =
+                  ca(cm,v+vs,k,j,i);
             });
             tmember.team_barrier();
 
-          // else copy into send buffer for MPI communication below
+          // else copy into (single-precision) send buffer for MPI communication below
+          } else if (compress && !(on_node.d_view(nghbr.d_view(m,n).rank))) {
+            // load data from coarse_u0
+            Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
+            [&](const int i) {
+              sbuf[n].vars_cmp(m,ndat+ (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) =
+                  static_cast<float>(ca(cm,v+vs,k,j,i));
+            });
+            tmember.team_barrier();
           } else {
             // load data from coarse_u0
             Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
             [&](const int i) {
-              sbuf[n].vars(m,ndat+ (i-il + ni*(j-jl + nj*(k-kl + nk*v))) )=ca(m,v,k,j,i);
+              sbuf[n].vars(m,ndat+ (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) =
+                  ca(cm,v+vs,k,j,i);
             });
             tmember.team_barrier();
           }
@@ -209,13 +256,19 @@ TaskStatus MeshBoundaryValuesCC::PackAndSendCC(DvceArray5D<Real> &a,
 
 #if MPI_PARALLEL_ENABLED
   // Send boundary buffer to neighboring MeshBlocks using MPI
-  Kokkos::fence();
+  StageSendBuffers(false);
+  if (persistent_mpi_) {
+    StartPersistentSend(nvar);
+    return TaskStatus::complete;
+  }
   auto &is_z4c = is_z4c_;
   int my_rank = global_variable::my_rank;
   auto &nghbr = pmy_pack->pmb->nghbr;
   bool no_errors=true;
+  std::vector<CoalescedEntry> clist;
   for (int m=0; m<nmb; ++m) {
     for (int n=0; n<nnghbr; ++n) {
+      if (faces_only && !(IsFaceBuffer(n))) continue;
       if (nghbr.h_view(m,n).gid >= 0) {  // neighbor exists and not a physical boundary
         // index and rank of destination Neighbor
         int dn = nghbr.h_view(m,n).dest;
@@ -230,7 +283,7 @@ TaskStatus MeshBoundaryValuesCC::PackAndSendCC(DvceArray5D<Real> &a,
           if ( nghbr.h_view(m,n).lev < pmy_pack->pmb->mb_lev.h_view(m) ) {
             data_size *= sendbuf[n].icoar_ndat;
           } else if ( nghbr.h_view(m,n).lev == pmy_pack->pmb->mb_lev.h_view(m) ) {
-            if (is_z4c) {
+            if (is_z4c && nghbr.h_view(m,n).send_coarse) {
               data_size *= sendbuf[n].isame_z4c_ndat;
             } else {
               data_size *= sendbuf[n].isame_ndat;
@@ -238,15 +291,35 @@ TaskStatus MeshBoundaryValuesCC::PackAndSendCC(DvceArray5D<Real> &a,
           } else {
             data_size *= sendbuf[n].ifine_ndat;
           }
-          auto send_ptr = Kokkos::subview(sendbuf[n].vars, m, Kokkos::ALL);
+          // with coalesced messages, just record buffer in list
+          if (coalesce_mpi_) {
+            clist.push_back({drank, tag, m, n, 0, data_size});
+            continue;
+          }
+          // with compressed messages, send single-precision buffer
+          if (CompressMessage(drank)) {
+            auto send_ptr = Kokkos::subview(sendbuf[n].vars_cmp_mpi, m, Kokkos::ALL);
+            int ierr = MPI_Isend(send_ptr.data(), data_size, MPI_FLOAT, drank, tag,
+                                 comm_vars, &(sendbuf[n].vars_req[m]));
+            pmy_pack->pmesh->ccounter.Tally(drank, true, data_size*sizeof(float));
+            if (ierr != MPI_SUCCESS) {no_errors=false;}
+            continue;
+          }
+          auto send_ptr = Kokkos::subview(sendbuf[n].vars_mpi, m, Kokkos::ALL);
 
           int ierr = MPI_Isend(send_ptr.data(), data_size, MPI_ATHENA_REAL, drank, tag,
                                comm_vars, &(sendbuf[n].vars_req[m]));
+          pmy_pack->pmesh->ccounter.Tally(drank, true, data_size*sizeof(Real));
           if (ierr != MPI_SUCCESS) {no_errors=false;}
         }
       }
     }
   }
+  // Gather buffers and send one message to each neighboring rank
+  if (coalesce_mpi_) {
+    if (CoalescedIsStale(csend_vars_, nvar)) {BuildCoalesced(csend_vars_, clist, nvar);}
+    SendCoalesced(csend_vars_, false, comm_vars);
+  }
   // Quit if MPI error detected
   if (!(no_errors)) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
@@ -261,8 +334,8 @@ TaskStatus MeshBoundaryValuesCC::PackAndSendCC(DvceArray5D<Real> &a,
 // \!fn void RecvBuffers()
 // \brief Unpack boundary buffers
 
-TaskStatus MeshBoundaryValuesCC::RecvAndUnpackCC(DvceArray5D<Real> &a,
-                                                 DvceArray5D<Real> &ca) {
+template <typename T>
+TaskStatus MeshBoundaryValuesCC::RecvAndUnpackCC(DvceArray5D<T> &a, DvceArray5D<T> &ca) {
   // create local references for variables in kernel
   int nmb = pmy_pack->nmb_thispack;
   int nnghbr = pmy_pack->pmb->nnghbr;
@@ -277,8 +350,9 @@ TaskStatus MeshBoundaryValuesCC::RecvAndUnpackCC(DvceArray5D<Real> &a,
   bool no_errors=true;
   for (int m=0; m<nmb; ++m) {
     for (int n=0; n<nnghbr; ++n) {
+      if (faces_only && !(IsFaceBuffer(n))) continue;
       if (nghbr.h_view(m,n).gid >= 0) { // neighbor exists and not a physical boundary
-        if (nghbr.h_view(m,n).rank != global_variable::my_rank) {
+        if ((nghbr.h_view(m,n).rank != global_variable::my_rank) && !(coalesce_mpi_)) {
           int test;
           int ierr = MPI_Test(&(rbuf[n].vars_req[m]), &test, MPI_STATUS_IGNORE);
           if (ierr != MPI_SUCCESS) {no_errors=false;}
@@ -296,24 +370,35 @@ TaskStatus MeshBoundaryValuesCC::RecvAndUnpackCC(DvceArray5D<Real> &a,
               << std::endl;
     std::exit(EXIT_FAILURE);
   }
+  // test coalesced receives, and scatter into recv buffers once complete
+  if (coalesce_mpi_) {bflag = !(TestCoalescedRecv(crecv_vars_, false));}
   // exit if recv boundary buffer communications have not completed
+  RecordPoll(bflag);
   if (bflag) {return TaskStatus::incomplete;}
+  StageRecvBuffers(false);
 #endif
 
   //----- STEP 2: buffers have all completed, so unpack
 
-  int nvar = a.extent_int(1);  // TODO(@user): 2nd index from L of in array must be NVAR
+  int vs = var_start;
+  int nvar = a.extent_int(1) - vs;  // only variables [var_start,nvar) are exchanged
   auto &mblev = pmy_pack->pmb->mb_lev;
+  auto &cidx = pmy_pack->pmb->mb_cidx;
+  bool faces_only_ = faces_only;
+  bool compress = compress_mpi;
+  auto &on_node = rank_on_node;
+  int my_rank = global_variable::my_rank;
 
   // Outer loop over (# of MeshBlocks)*(# of buffers)*(# of variables)
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), (nmb*nnghbr*nvar), Kokkos::AUTO);
+  Kokkos::TeamPolicy<> policy(pmy_pack->exec_space, (nmb*nnghbr*nvar), Kokkos::AUTO);
   Kokkos::parallel_for("RecvBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
     const int m = (tmember.league_rank())/(nnghbr*nvar);
     const int n = (tmember.league_rank() - m*(nnghbr*nvar))/nvar;
     const int v = (tmember.league_rank() - m*(nnghbr*nvar) - n*nvar);
+    const int cm = cidx.d_view(m);  // index of MB in coarse array
 
-    // only unpack buffers when neighbor exists
-    if (nghbr.d_view(m,n).gid >= 0) {
+    // only unpack buffers when neighbor exists (and buffer is on a face with faces_only)
+    if (nghbr.d_view(m,n).gid >= 0 && !(faces_only_ && !(IsFaceBuffer(n)))) {
       int il, iu, jl, ju, kl, ku;
       // if neighbor is at coarser level, use coar indices to unpack buffer
       if (nghbr.d_view(m,n).lev < mblev.d_view(m)) {
@@ -344,6 +429,9 @@ TaskStatus MeshBoundaryValuesCC::RecvAndUnpackCC(DvceArray5D<Real> &a,
       int nj = ju - jl + 1;
       int nk = ku - kl + 1;
       int nkj  = nk*nj;
+      // messages from other nodes may be compressed into single-precision buffer
+      bool cmp = compress && (nghbr.d_view(m,n).rank != my_rank) &&
+                 !(on_node.d_view(nghbr.d_view(m,n).rank));
 
       // Middle loop over k,j
       Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nkj), [&](const int idx) {
@@ -351,11 +439,28 @@ TaskStatus MeshBoundaryValuesCC::RecvAndUnpackCC(DvceArray5D<Real> &a,
         int j = (idx - k * nj) + jl;
         k += kl;
 
+        // unpack compressed data from single-precision buffer into u0 or coarse_u0
+        if (cmp) {
+          if (nghbr.d_view(m,n).lev >= mblev.d_view(m)) {
+            Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
+            [&](const int i) {
+              a(m,v+vs,k,j,i) =
+                  rbuf[n].vars_cmp(m, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) );
+            });
+          } else {
+            Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
+            [&](const int i) {
+              ca(cm,v+vs,k,j,i) =
+                  rbuf[n].vars_cmp(m, (i-il + ni*(j-jl + nj*(k-kl + nk*v))));
+            });
+          }
+          tmember.team_barrier();
+
         // if neighbor is at same or finer level, load data directly into u0
-        if (nghbr.d_view(m,n).lev >= mblev.d_view(m)) {
+        } else if (nghbr.d_view(m,n).lev >= mblev.d_view(m)) {
           Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
           [&](const int i) {
-            a(m,v,k,j,i) = rbuf[n].vars(m, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) );
+            a(m,v+vs,k,j,i) = rbuf[n].vars(m, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) );
           });
           tmember.team_barrier();
 
@@ -363,7 +468,7 @@ TaskStatus MeshBoundaryValuesCC::RecvAndUnpackCC(DvceArray5D<Real> &a,
         } else {
           Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
           [&](const int i) {
-            ca(m,v,k,j,i) = rbuf[n].vars(m, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) );
+            ca(cm,v+vs,k,j,i) = rbuf[n].vars(m, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) );
           });
           tmember.team_barrier();
         }
@@ -376,12 +481,14 @@ TaskStatus MeshBoundaryValuesCC::RecvAndUnpackCC(DvceArray5D<Real> &a,
     const int m = (tmember.league_rank())/(nnghbr*nvar);
     const int n = (tmember.league_rank() - m*(nnghbr*nvar))/nvar;
     const int v = (tmember.league_rank() - m*(nnghbr*nvar) - n*nvar);
-    // only unpack buffers when neighbor exists
-    if (nghbr.d_view(m,n).gid >= 0) {
+    const int cm = cidx.d_view(m);  // index of MB in coarse array
+    // only unpack buffers when neighbor exists (and buffer is on a face with faces_only)
+    if (nghbr.d_view(m,n).gid >= 0 && !(faces_only_ && !(IsFaceBuffer(n)))) {
       int il, iu, jl, ju, kl, ku;
       // If neighbor is at same level and data is for Z4c module, unpack data from coarse
-      // array for higher-order prolongation
-      if ((nghbr.d_view(m,n).lev == mblev.d_view(m)) && (is_z4c) && (multilevel)) {
+      // array for higher-order prolongation (if this MB uses it)
+      if ((nghbr.d_view(m,n).lev == mblev.d_view(m)) && (is_z4c) && (multilevel) &&
+          (nghbr.d_view(m,n).recv_coarse)) {
         il = rbuf[n].isame_z4c.bis;
         iu = rbuf[n].isame_z4c.bie;
         jl = rbuf[n].isame_z4c.bjs;
@@ -400,11 +507,22 @@ TaskStatus MeshBoundaryValuesCC::RecvAndUnpackCC(DvceArray5D<Real> &a,
           int j = (idx - k * nj) + jl;
           k += kl;
 
-          // load data into coarse_u0
-          Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
-          [&](const int i) {
-            ca(m,v,k,j,i) = rbuf[n].vars(m,ndat + (i-il + ni*(j-jl + nj*(k-kl + nk*v))) );
-          });
+          // load data into coarse_u0 (from single-precision buffer if compressed)
+          bool cmp = compress && (nghbr.d_view(m,n).rank != my_rank) &&
+                     !(on_node.d_view(nghbr.d_view(m,n).rank));
+          if (cmp) {
+            Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
+            [&](const int i) {
+              ca(cm,v+vs,k,j,i) =
+                  rbuf[n].vars_cmp(m,ndat + (i-il + ni*(j-jl + nj*(k-kl + nk*v))) );
+            });
+          } else {
+            Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
+            [&](const int i) {
+              ca(cm,v+vs,k,j,i) =
+                  rbuf[n].vars(m,ndat + (i-il + ni*(j-jl + nj*(k-kl + nk*v))) );
+            });
+          }
           tmember.team_barrier();
         });
       }
@@ -413,3 +531,15 @@ TaskStatus MeshBoundaryValuesCC::RecvAndUnpackCC(DvceArray5D<Real> &a,
 
   return TaskStatus::complete;
 }
+
+// function definitions for each template parameter
+template TaskStatus MeshBoundaryValuesCC::PackAndSendCC<Real>(DvceArray5D<Real> &a,
+  DvceArray5D<Real> &ca);
+template TaskStatus MeshBoundaryValuesCC::RecvAndUnpackCC<Real>(DvceArray5D<Real> &a,
+  DvceArray5D<Real> &ca);
+#if RAD_MIXED_PRECISION_ENABLED
+template TaskStatus MeshBoundaryValuesCC::PackAndSendCC<RadReal>(DvceArray5D<RadReal> &a,
+  DvceArray5D<RadReal> &ca);
+template TaskStatus MeshBoundaryValuesCC::RecvAndUnpackCC<RadReal>(
+  DvceArray5D<RadReal> &a, DvceArray5D<RadReal> &ca);
+#endif
@@ -0,0 +1,587 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file bvals_coalesce.cpp
+//! \brief functions to aggregate all boundary buffers exchanged between a pair of ranks
+//! into a single contiguous MPI message (enabled with <mesh>/coalesce_mpi=true).
+//!
+//! Boundary buffers are packed as usual into sendbuf[n].vars/flux, then gathered into one
+//! contiguous device array with one segment per destination rank, and sent with a single
+//! MPI_Isend per rank.  Receives are posted with a single MPI_Irecv per source rank, and
+//! data are scattered back into recvbuf[n].vars/flux before the usual unpack kernels.
+//! Within each message buffers are ordered by the tag of the *receiving* buffer, so that
+//! the sender and receiver build identical index tables independently.
+//!
+//! With <mesh>/node_ipc=true, the receive data is allocated so that it can be shared
+//! through CUDA/HIP IPC, and its handle sent once (each time the index table is rebuilt)
+//! to every sending rank on the same node.  Messages between such ranks are then copied
+//! by the sender directly into the receive data of the other rank, and MPI only carries
+//! zero-size messages: one from the receiver when its data may be overwritten (posted
+//! with the receives), and one from the sender when the copy is complete (in place of
+//! the data message).  Messages between nodes are sent with MPI as before.
+//!
+//! With <mesh>/rma_mpi=true, messages are instead sent with one-sided MPI.  The data of
+//! each receive table is exposed in an RMA window (with passive target synchronization),
+//! along with a window of flags.  Receivers post "ready" by writing the current epoch
+//! (number of exchanges since the table was built) into a flag of each sender, senders
+//! wait for this flag, put their data into the window of the receiver followed by the
+//! epoch into a flag of the receiver, and receivers poll their local flags instead of
+//! testing MPI requests.  No MPI message matching is needed.
+//!
+//! With <mesh>/nccl=true, all receives and sends of an exchange are instead issued by the
+//! sender as one NCCL group (see utils/nccl_channel.hpp), ordered on the device stream
+//! after the gather kernel and before the scatter kernel, so neither the sends nor the
+//! receives wait for a fence on the host.
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "mesh/mesh.hpp"
+#include "utils/memory_registry.hpp"
+#include "bvals.hpp"
+
+#if NODE_IPC_ENABLED
+#if defined(KOKKOS_ENABLE_CUDA)
+#include <cuda_runtime.h>
+#else
+#include <hip/hip_runtime.h>
+#endif
+#endif
+
+#if MPI_PARALLEL_ENABLED
+namespace {
+#if NODE_IPC_ENABLED
+//----------------------------------------------------------------------------------------
+// wrappers for CUDA/HIP IPC functions, which exit on errors
+
+void IpcCheck(bool ok, const char *func) {
+  if (!(ok)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << func << " failed for coalesced message" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+}
+
+Real *IpcAlloc(std::size_t n) {
+  void *p = nullptr;
+#if defined(KOKKOS_ENABLE_CUDA)
+  IpcCheck(cudaMalloc(&p, n*sizeof(Real)) == cudaSuccess, "cudaMalloc");
+#else
+  IpcCheck(hipMalloc(&p, n*sizeof(Real)) == hipSuccess, "hipMalloc");
+#endif
+  return static_cast<Real*>(p);
+}
+
+void IpcFree(Real *p) {
+#if defined(KOKKOS_ENABLE_CUDA)
+  IpcCheck(cudaFree(p) == cudaSuccess, "cudaFree");
+#else
+  IpcCheck(hipFree(p) == hipSuccess, "hipFree");
+#endif
+}
+
+void IpcGetHandle(Real *p, char *handle) {
+#if defined(KOKKOS_ENABLE_CUDA)
+  static_assert(sizeof(cudaIpcMemHandle_t) == sizeof(IpcHandleMsg::handle),
+                "unexpected size of IPC handle");
+  cudaIpcMemHandle_t h;
+  IpcCheck(cudaIpcGetMemHandle(&h, p) == cudaSuccess, "cudaIpcGetMemHandle");
+#else
+  static_assert(sizeof(hipIpcMemHandle_t) == sizeof(IpcHandleMsg::handle),
+                "unexpected size of IPC handle");
+  hipIpcMemHandle_t h;
+  IpcCheck(hipIpcGetMemHandle(&h, p) == hipSuccess, "hipIpcGetMemHandle");
+#endif
+  std::memcpy(handle, &h, sizeof(h));
+}
+
+void *IpcOpen(const char *handle) {
+  void *p = nullptr;
+#if defined(KOKKOS_ENABLE_CUDA)
+  cudaIpcMemHandle_t h;
+  std::memcpy(&h, handle, sizeof(h));
+  IpcCheck(cudaIpcOpenMemHandle(&p, h, cudaIpcMemLazyEnablePeerAccess) == cudaSuccess,
+           "cudaIpcOpenMemHandle");
+#else
+  hipIpcMemHandle_t h;
+  std::memcpy(&h, handle, sizeof(h));
+  IpcCheck(hipIpcOpenMemHandle(&p, h, hipIpcMemLazyEnablePeerAccess) == hipSuccess,
+           "hipIpcOpenMemHandle");
+#endif
+  return p;
+}
+
+void IpcClose(void *p) {
+#if defined(KOKKOS_ENABLE_CUDA)
+  IpcCheck(cudaIpcCloseMemHandle(p) == cudaSuccess, "cudaIpcCloseMemHandle");
+#else
+  IpcCheck(hipIpcCloseMemHandle(p) == hipSuccess, "hipIpcCloseMemHandle");
+#endif
+}
+
+// copies n Reals between devices, and returns once the copy is complete
+void IpcCopy(Real *dst, const Real *src, std::size_t n) {
+#if defined(KOKKOS_ENABLE_CUDA)
+  IpcCheck(cudaMemcpy(dst, src, n*sizeof(Real), cudaMemcpyDefault) == cudaSuccess &&
+           cudaDeviceSynchronize() == cudaSuccess, "cudaMemcpy");
+#else
+  IpcCheck(hipMemcpy(dst, src, n*sizeof(Real), hipMemcpyDefault) == hipSuccess &&
+           hipDeviceSynchronize() == hipSuccess, "hipMemcpy");
+#endif
+}
+#endif // NODE_IPC_ENABLED
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn bool MeshBoundaryValues::CoalescedIsStale
+//! \brief Returns true if index table must be rebuilt, because the number of variables,
+//! the set of buffers exchanged (faces_only), or the Mesh (through AMR or load balancing)
+//! has changed since it was built.
+
+bool MeshBoundaryValues::CoalescedIsStale(const CoalescedMessages &c, int nvar) {
+  return (c.nvar != nvar || c.faces_only != faces_only ||
+          c.version != pmy_pack->pmesh->mesh_version);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValues::BuildCoalesced
+//! \brief Builds index table, and allocates data and requests, for coalesced messages
+//! from input list of buffers (with rank, tag, m, n, and size set for each entry).
+
+void MeshBoundaryValues::BuildCoalesced(CoalescedMessages &c,
+                                        std::vector<CoalescedEntry> &list, int nvar) {
+  std::sort(list.begin(), list.end(),
+            [](const CoalescedEntry &a, const CoalescedEntry &b) {
+              return (a.rank < b.rank) || (a.rank == b.rank && a.tag < b.tag);
+            });
+  c.msg_rank.clear();
+  c.msg_offset.clear();
+  c.msg_size.clear();
+  int offset = 0;
+  for (auto &it : list) {
+    if (c.msg_rank.empty() || c.msg_rank.back() != it.rank) {
+      c.msg_rank.push_back(it.rank);
+      c.msg_offset.push_back(offset);
+      c.msg_size.push_back(0);
+    }
+    it.offset = offset;
+    offset += it.size;
+    c.msg_size.back() += it.size;
+  }
+
+  int nentry = static_cast<int>(list.size());
+  MemoryRegistry::PushTag("bvals");
+  Kokkos::realloc(c.entry, std::max(nentry,1));
+  for (int e=0; e<nentry; ++e) {c.entry.h_view(e) = list[e];}
+  c.entry.template modify<HostMemSpace>();
+  c.entry.template sync<DevExeSpace>();
+  // with node_ipc, receive data is allocated outside of Kokkos so it can be shared
+  bool recv = (&c == &crecv_vars_ || &c == &crecv_flux_);
+  if (node_ipc_) {FreeCoalescedIPC(c);}
+  if (rma_mpi_ && recv) {FreeCoalescedRMA(c);}
+#if NODE_IPC_ENABLED
+  if (node_ipc_ && recv) {
+    c.ipc_data = IpcAlloc(std::max(offset,1));
+    c.data = DvceArray1D<Real>(c.ipc_data, std::max(offset,1));
+  } else {
+    Kokkos::realloc(c.data, std::max(offset,1));
+  }
+#else
+  Kokkos::realloc(c.data, std::max(offset,1));
+#endif
+  c.data_mpi = Kokkos::create_mirror_view(MPIBuffMemSpace(), c.data);
+  c.req.assign(c.msg_rank.size(), MPI_REQUEST_NULL);
+  c.nvar = nvar;
+  c.faces_only = faces_only;
+  c.version = pmy_pack->pmesh->mesh_version;
+  c.epoch = 0;
+  c.nccl_epoch = 0;
+  MemoryRegistry::PopTag();
+
+  MPI_Comm comm = (&c == &csend_flux_ || &c == &crecv_flux_)? comm_flux : comm_vars;
+  if (node_ipc_) {SetupCoalescedIPC(c, recv, comm);}
+  if (rma_mpi_ && recv) {SetupCoalescedRMA(c, comm);}
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValues::SetupCoalescedRMA
+//! \brief With rma_mpi, creates RMA windows for the data and flags of receive table c,
+//! and writes the offset of each message into the flags of its sender.  Collective over
+//! all ranks, which always rebuild their receive tables together.
+
+void MeshBoundaryValues::SetupCoalescedRMA(CoalescedMessages &c, MPI_Comm comm) {
+  int nranks = global_variable::nranks;
+  MPI_Aint nflag = 3*nranks;
+  MPI_Win_allocate(nflag*sizeof(std::int64_t), sizeof(std::int64_t), MPI_INFO_NULL,
+                   comm, &(c.flag), &(c.win_flag));
+  for (int i=0; i<nflag; ++i) {c.flag[i] = 0;}
+  MPI_Aint ndata = static_cast<MPI_Aint>(c.data_mpi.size())*sizeof(Real);
+  MPI_Win_create(c.data_mpi.data(), ndata, sizeof(Real), MPI_INFO_NULL, comm,
+                 &(c.win_data));
+  // flags must be initialized on all ranks before they are written by other ranks
+  MPI_Barrier(comm);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, c.win_flag);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, c.win_data);
+
+  std::vector<std::int64_t> offset(c.msg_rank.size());
+  MPI_Aint disp = 2*nranks + global_variable::my_rank;
+  for (std::size_t k=0; k<c.msg_rank.size(); ++k) {
+    offset[k] = c.msg_offset[k];
+    MPI_Put(&(offset[k]), 1, MPI_INT64_T, c.msg_rank[k], disp, 1, MPI_INT64_T,
+            c.win_flag);
+  }
+  MPI_Win_flush_all(c.win_flag);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValues::FreeCoalescedRMA
+//! \brief Frees RMA windows of receive table c.  Collective over all ranks.
+
+void MeshBoundaryValues::FreeCoalescedRMA(CoalescedMessages &c) {
+  if (c.win_flag == MPI_WIN_NULL) {return;}
+  MPI_Win_unlock_all(c.win_data);
+  MPI_Win_unlock_all(c.win_flag);
+  MPI_Win_free(&(c.win_data));
+  MPI_Win_free(&(c.win_flag));
+  c.flag = nullptr;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValues::SetupCoalescedIPC
+//! \brief With node_ipc, sends (recv=true) the IPC handle of the receive data and the
+//! offset of each message to all sending ranks on the same node, or receives (recv=false)
+//! and opens the handles of all receiving ranks on the same node.  Receiving ranks always
+//! rebuild their tables in InitRecv() before sends in the same stage, so the blocking
+//! receives here are always matched.
+
+void MeshBoundaryValues::SetupCoalescedIPC(CoalescedMessages &c, bool recv,
+                                           MPI_Comm comm) {
+  int nmsg = static_cast<int>(c.msg_rank.size());
+  c.msg_ipc.assign(nmsg, nullptr);
+  c.ipc_msg.resize(nmsg);
+  c.ipc_req.assign(nmsg, MPI_REQUEST_NULL);
+  c.ready_req.assign(nmsg, MPI_REQUEST_NULL);
+#if NODE_IPC_ENABLED
+  IpcHandleMsg own;
+  if (recv) {IpcGetHandle(c.ipc_data, own.handle);}
+  bool no_errors=true;
+  for (int k=0; k<nmsg; ++k) {
+    int r = c.msg_rank[k];
+    if (!(rank_on_node.h_view(r))) continue;
+    if (recv) {
+      c.ipc_msg[k] = own;
+      c.ipc_msg[k].offset = c.msg_offset[k];
+      c.msg_ipc[k] = c.ipc_data + c.msg_offset[k];
+      int ierr = MPI_Isend(&(c.ipc_msg[k]), sizeof(IpcHandleMsg), MPI_BYTE, r, 1, comm,
+                           &(c.ipc_req[k]));
+      if (ierr != MPI_SUCCESS) {no_errors=false;}
+    } else {
+      int ierr = MPI_Recv(&(c.ipc_msg[k]), sizeof(IpcHandleMsg), MPI_BYTE, r, 1, comm,
+                          MPI_STATUS_IGNORE);
+      if (ierr != MPI_SUCCESS) {no_errors=false;}
+      void *base = IpcOpen(c.ipc_msg[k].handle);
+      c.ipc_open.push_back(base);
+      c.msg_ipc[k] = static_cast<Real*>(base) + c.ipc_msg[k].offset;
+    }
+  }
+  if (!(no_errors)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+       << std::endl << "MPI error in exchanging IPC handles" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+#endif
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValues::FreeCoalescedIPC
+//! \brief Closes IPC handles opened for sends, and frees receive data shared with IPC.
+
+void MeshBoundaryValues::FreeCoalescedIPC(CoalescedMessages &c) {
+#if NODE_IPC_ENABLED
+  for (auto base : c.ipc_open) {IpcClose(base);}
+  if (c.ipc_data != nullptr) {
+    c.data = DvceArray1D<Real>();
+    c.data_mpi = decltype(c.data_mpi)();
+    IpcFree(c.ipc_data);
+  }
+#endif
+  c.ipc_open.clear();
+  c.msg_ipc.clear();
+  c.ipc_data = nullptr;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValues::SendCoalesced
+//! \brief Gathers packed send buffers (vars, or fluxes if flux=true) into contiguous
+//! data, and sends one message to each neighboring rank.
+
+void MeshBoundaryValues::SendCoalesced(CoalescedMessages &c, bool flux, MPI_Comm comm) {
+  int nentry = static_cast<int>(c.entry.extent(0));
+  if (c.msg_rank.empty()) {
+    // with NCCL, receives must be issued even if there is nothing to send
+    if (nccl_) {SendCoalescedNCCL(c, flux);}
+    return;
+  }
+  auto &sbuf = sendbuf;
+  auto &ent = c.entry.d_view;
+  auto &data = c.data;
+  Kokkos::TeamPolicy<> policy(pmy_pack->exec_space, nentry, Kokkos::AUTO);
+  Kokkos::parallel_for("GatherBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
+    const int e = tmember.league_rank();
+    const int m = ent(e).m;
+    const int n = ent(e).n;
+    const int os = ent(e).offset;
+    if (flux) {
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(tmember, ent(e).size),
+      [&](const int i) {
+        data(os + i) = sbuf[n].flux(m,i);
+      });
+    } else {
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(tmember, ent(e).size),
+      [&](const int i) {
+        data(os + i) = sbuf[n].vars(m,i);
+      });
+    }
+  });
+  if (nccl_) {
+    SendCoalescedNCCL(c, flux);
+    return;
+  }
+  if (c.data_mpi.data() != c.data.data()) {
+    Kokkos::deep_copy(pmy_pack->exec_space, c.data_mpi, c.data);
+  }
+  pmy_pack->exec_space.fence();
+
+  // with RMA, put each message once its receiver is ready, then set flag of receiver
+  if (rma_mpi_) {
+    CoalescedMessages &r = (flux)? crecv_flux_ : crecv_vars_;
+    int nranks = global_variable::nranks;
+    int nmsg = static_cast<int>(c.msg_rank.size());
+    volatile std::int64_t *flag = r.flag;
+    std::vector<bool> sent(nmsg, false);
+    c.epoch++;
+    for (int nsent=0; nsent<nmsg;) {
+      MPI_Win_sync(r.win_flag);
+      for (int k=0; k<nmsg; ++k) {
+        int dst = c.msg_rank[k];
+        if (sent[k] || flag[nranks + dst] < c.epoch) continue;
+        Real *pdata = c.data_mpi.data() + c.msg_offset[k];
+        MPI_Put(pdata, c.msg_size[k], MPI_ATHENA_REAL, dst, flag[2*nranks + dst],
+                c.msg_size[k], MPI_ATHENA_REAL, r.win_data);
+        MPI_Win_flush(dst, r.win_data);
+        MPI_Put(&(c.epoch), 1, MPI_INT64_T, dst, global_variable::my_rank, 1,
+                MPI_INT64_T, r.win_flag);
+        pmy_pack->pmesh->ccounter.Tally(dst, true, c.msg_size[k]*sizeof(Real));
+        sent[k] = true;
+        nsent++;
+      }
+    }
+    MPI_Win_flush_all(r.win_flag);
+    return;
+  }
+
+  bool no_errors=true;
+  for (std::size_t k=0; k<c.msg_rank.size(); ++k) {
+    Real *pdata = c.data_mpi.data() + c.msg_offset[k];
+#if NODE_IPC_ENABLED
+    // wait until receiver is ready, copy into its data, then signal copy is complete
+    if (!(c.msg_ipc.empty()) && c.msg_ipc[k] != nullptr) {
+      int ierr = MPI_Recv(nullptr, 0, MPI_BYTE, c.msg_rank[k], 2, comm,
+                          MPI_STATUS_IGNORE);
+      if (ierr != MPI_SUCCESS) {no_errors=false;}
+      IpcCopy(c.msg_ipc[k], pdata, c.msg_size[k]);
+      ierr = MPI_Isend(nullptr, 0, MPI_BYTE, c.msg_rank[k], 0, comm, &(c.req[k]));
+      if (ierr != MPI_SUCCESS) {no_errors=false;}
+      pmy_pack->pmesh->ccounter.Tally(c.msg_rank[k], true, c.msg_size[k]*sizeof(Real));
+      continue;
+    }
+#endif
+    int ierr = MPI_Isend(pdata, c.msg_size[k], MPI_ATHENA_REAL, c.msg_rank[k], 0, comm,
+                         &(c.req[k]));
+    if (ierr != MPI_SUCCESS) {no_errors=false;}
+    pmy_pack->pmesh->ccounter.Tally(c.msg_rank[k], true, c.msg_size[k]*sizeof(Real));
+  }
+  if (!(no_errors)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+       << std::endl << "MPI error in posting coalesced sends" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValues::SendCoalescedNCCL
+//! \brief With nccl, issues receives of the matching receive table and sends of send
+//! table c (already gathered into its data) as one NCCL group on the device stream.
+
+void MeshBoundaryValues::SendCoalescedNCCL(CoalescedMessages &c, bool flux) {
+#if NCCL_ENABLED
+  CoalescedMessages &r = (flux)? crecv_flux_ : crecv_vars_;
+  NcclChannel &chan = (flux)? nccl_flux_ : nccl_vars_;
+  chan.Start(pmy_pack->exec_space);
+  for (std::size_t k=0; k<r.msg_rank.size(); ++k) {
+    chan.Recv(r.data.data() + r.msg_offset[k], r.msg_size[k], r.msg_rank[k]);
+  }
+  for (std::size_t k=0; k<c.msg_rank.size(); ++k) {
+    chan.Send(c.data.data() + c.msg_offset[k], c.msg_size[k], c.msg_rank[k]);
+    pmy_pack->pmesh->ccounter.Tally(c.msg_rank[k], true, c.msg_size[k]*sizeof(Real));
+  }
+  chan.Finish(pmy_pack->exec_space);
+  r.nccl_epoch = r.epoch;
+#endif
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValues::PostCoalescedRecv
+//! \brief Posts one non-blocking receive from each neighboring rank
+
+void MeshBoundaryValues::PostCoalescedRecv(CoalescedMessages &c, MPI_Comm comm) {
+  // with IPC, data from the last exchange must be scattered before it is overwritten
+  if (!(c.msg_ipc.empty())) {pmy_pack->exec_space.fence();}
+
+  // with NCCL, receives are issued with the sends in SendCoalescedNCCL()
+  if (nccl_) {
+    c.epoch++;
+    for (std::size_t k=0; k<c.msg_rank.size(); ++k) {
+      pmy_pack->pmesh->ccounter.Tally(c.msg_rank[k], false, c.msg_size[k]*sizeof(Real));
+    }
+    return;
+  }
+
+  // with RMA, tell each sender the data may be overwritten in this epoch
+  if (rma_mpi_) {
+    pmy_pack->exec_space.fence();
+    int nranks = global_variable::nranks;
+    c.epoch++;
+    for (std::size_t k=0; k<c.msg_rank.size(); ++k) {
+      MPI_Put(&(c.epoch), 1, MPI_INT64_T, c.msg_rank[k], nranks+global_variable::my_rank,
+              1, MPI_INT64_T, c.win_flag);
+      pmy_pack->pmesh->ccounter.Tally(c.msg_rank[k], false, c.msg_size[k]*sizeof(Real));
+    }
+    MPI_Win_flush_all(c.win_flag);
+    return;
+  }
+
+  bool no_errors=true;
+  for (std::size_t k=0; k<c.msg_rank.size(); ++k) {
+    Real *pdata = c.data_mpi.data() + c.msg_offset[k];
+    // with IPC, post zero-size receive for the completion of the copy by the sender, and
+    // tell the sender the data may now be overwritten
+    if (!(c.msg_ipc.empty()) && c.msg_ipc[k] != nullptr) {
+      int ierr = MPI_Irecv(nullptr, 0, MPI_BYTE, c.msg_rank[k], 0, comm, &(c.req[k]));
+      if (ierr != MPI_SUCCESS) {no_errors=false;}
+      ierr = MPI_Isend(nullptr, 0, MPI_BYTE, c.msg_rank[k], 2, comm, &(c.ready_req[k]));
+      if (ierr != MPI_SUCCESS) {no_errors=false;}
+      pmy_pack->pmesh->ccounter.Tally(c.msg_rank[k], false, c.msg_size[k]*sizeof(Real));
+      continue;
+    }
+    int ierr = MPI_Irecv(pdata, c.msg_size[k], MPI_ATHENA_REAL, c.msg_rank[k], 0, comm,
+                         &(c.req[k]));
+    if (ierr != MPI_SUCCESS) {no_errors=false;}
+    pmy_pack->pmesh->ccounter.Tally(c.msg_rank[k], false, c.msg_size[k]*sizeof(Real));
+  }
+  if (!(no_errors)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+       << std::endl << "MPI error in posting coalesced receives" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool MeshBoundaryValues::TestCoalescedRecv
+//! \brief Tests whether all coalesced receives have completed.  If so, scatters received
+//! data into recv buffers (vars, or fluxes if flux=true) and returns true.
+
+bool MeshBoundaryValues::TestCoalescedRecv(CoalescedMessages &c, bool flux) {
+  if (c.msg_rank.empty()) {return true;}
+  int test = 1;
+  if (nccl_) {
+    // with NCCL, the scatter below follows the receives on the device stream, so they
+    // only have to be issued
+    if (c.nccl_epoch < c.epoch) {test = 0;}
+  } else if (rma_mpi_) {
+    // with RMA, messages are complete once all senders have set their flags
+    MPI_Win_sync(c.win_flag);
+    volatile std::int64_t *flag = c.flag;
+    for (std::size_t k=0; k<c.msg_rank.size(); ++k) {
+      if (flag[c.msg_rank[k]] < c.epoch) {test = 0;}
+    }
+    if (test) {MPI_Win_sync(c.win_data);}
+  } else {
+    int ierr = MPI_Testall(static_cast<int>(c.req.size()), c.req.data(), &test,
+                           MPI_STATUSES_IGNORE);
+    if (ierr != MPI_SUCCESS) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "MPI error in testing coalesced receives" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  }
+  if (!(static_cast<bool>(test))) {return false;}
+  if (!(nccl_) && c.data_mpi.data() != c.data.data()) {
+    Kokkos::deep_copy(pmy_pack->exec_space, c.data, c.data_mpi);
+  }
+
+  int nentry = static_cast<int>(c.entry.extent(0));
+  auto &rbuf = recvbuf;
+  auto &ent = c.entry.d_view;
+  auto &data = c.data;
+  Kokkos::TeamPolicy<> policy(pmy_pack->exec_space, nentry, Kokkos::AUTO);
+  Kokkos::parallel_for("ScatterBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
+    const int e = tmember.league_rank();
+    const int m = ent(e).m;
+    const int n = ent(e).n;
+    const int os = ent(e).offset;
+    if (flux) {
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(tmember, ent(e).size),
+      [&](const int i) {
+        rbuf[n].flux(m,i) = data(os + i);
+      });
+    } else {
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(tmember, ent(e).size),
+      [&](const int i) {
+        rbuf[n].vars(m,i) = data(os + i);
+      });
+    }
+  });
+  return true;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValues::WaitCoalesced
+//! \brief Waits for all coalesced sends or receives to complete
+
+void MeshBoundaryValues::WaitCoalesced(CoalescedMessages &c) {
+  if (c.req.empty()) {return;}
+  int ierr = MPI_Waitall(static_cast<int>(c.req.size()), c.req.data(),
+                         MPI_STATUSES_IGNORE);
+  // with node_ipc, also complete messages with handles and "ready to receive" messages
+  if (ierr == MPI_SUCCESS && !(c.ready_req.empty())) {
+    ierr = MPI_Waitall(static_cast<int>(c.ready_req.size()), c.ready_req.data(),
+                       MPI_STATUSES_IGNORE);
+  }
+  if (ierr == MPI_SUCCESS && !(c.ipc_req.empty())) {
+    ierr = MPI_Waitall(static_cast<int>(c.ipc_req.size()), c.ipc_req.data(),
+                       MPI_STATUSES_IGNORE);
+  }
+  if (ierr != MPI_SUCCESS) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "MPI error in clearing coalesced messages" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  return;
+}
+#endif
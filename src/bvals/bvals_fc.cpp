@@ -11,6 +11,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <utility>
+#include <vector>
 #include <iomanip>    // std::setprecision()
 
 #include "athena.hpp"
@@ -47,15 +48,17 @@ TaskStatus MeshBoundaryValuesFC::PackAndSendFC(DvceFaceFld4D<Real> &b,
   auto &nghbr = pmy_pack->pmb->nghbr;
   auto &mbgid = pmy_pack->pmb->mb_gid;
   auto &mblev = pmy_pack->pmb->mb_lev;
+  auto &cidx = pmy_pack->pmb->mb_cidx;
   auto &sbuf = sendbuf;
   auto &rbuf = recvbuf;
 
   // Outer loop over (# of MeshBlocks)*(# of buffers)*(three field components)
   int nmnv = 3*nmb;
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), nmnv, Kokkos::AUTO);
+  Kokkos::TeamPolicy<> policy(pmy_pack->exec_space, nmnv, Kokkos::AUTO);
   Kokkos::parallel_for("SendBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
     const int m = tmember.league_rank()/3;
     const int v = tmember.league_rank()%3;
+    const int cm = cidx.d_view(m);  // index of MB in coarse array
 
     // scalar loop over neighbors to prevent race condition in overlapping assignments
     for (int n=0; n<nnghbr; ++n) {
@@ -131,11 +134,13 @@ TaskStatus MeshBoundaryValuesFC::PackAndSendFC(DvceFaceFld4D<Real> &b,
               k += kl;
               j += jl;
               if (v==0) {
-                rbuf[dn].vars(dm,i-il + ni*(j-jl + nj*(k-kl))) = cb.x1f(m,k,j,i);
+                rbuf[dn].vars(dm,i-il + ni*(j-jl + nj*(k-kl))) = cb.x1f(cm,k,j,i);
               } else if (v==1) {
-                rbuf[dn].vars(dm,ndat*v + i-il + ni*(j-jl + nj*(k-kl))) = cb.x2f(m,k,j,i);
+                rbuf[dn].vars(dm,ndat*v + i-il + ni*(j-jl + nj*(k-kl))) =
+                    cb.x2f(cm,k,j,i);
               } else if (v==2) {
-                rbuf[dn].vars(dm,ndat*v + i-il + ni*(j-jl + nj*(k-kl))) = cb.x3f(m,k,j,i);
+                rbuf[dn].vars(dm,ndat*v + i-il + ni*(j-jl + nj*(k-kl))) =
+                    cb.x3f(cm,k,j,i);
               }
             });
             tmember.team_barrier();
@@ -171,11 +176,11 @@ TaskStatus MeshBoundaryValuesFC::PackAndSendFC(DvceFaceFld4D<Real> &b,
               k += kl;
               j += jl;
               if (v==0) {
-                sbuf[n].vars(m,i-il + ni*(j-jl + nj*(k-kl))) = cb.x1f(m,k,j,i);
+                sbuf[n].vars(m,i-il + ni*(j-jl + nj*(k-kl))) = cb.x1f(cm,k,j,i);
               } else if (v==1) {
-                sbuf[n].vars(m,ndat*v + i-il + ni*(j-jl + nj*(k-kl))) = cb.x2f(m,k,j,i);
+                sbuf[n].vars(m,ndat*v + i-il + ni*(j-jl + nj*(k-kl))) = cb.x2f(cm,k,j,i);
               } else if (v==2) {
-                sbuf[n].vars(m,ndat*v + i-il + ni*(j-jl + nj*(k-kl))) = cb.x3f(m,k,j,i);
+                sbuf[n].vars(m,ndat*v + i-il + ni*(j-jl + nj*(k-kl))) = cb.x3f(cm,k,j,i);
               }
             });
             tmember.team_barrier();
@@ -188,10 +193,15 @@ TaskStatus MeshBoundaryValuesFC::PackAndSendFC(DvceFaceFld4D<Real> &b,
 
 #if MPI_PARALLEL_ENABLED
   // Send boundary buffer to neighboring MeshBlocks using MPI
-  Kokkos::fence();
+  StageSendBuffers(false);
+  if (persistent_mpi_) {
+    StartPersistentSend(3);
+    return TaskStatus::complete;
+  }
   int my_rank = global_variable::my_rank;
   auto &nghbr = pmy_pack->pmb->nghbr;
   bool no_errors=true;
+  std::vector<CoalescedEntry> clist;
   for (int m=0; m<nmb; ++m) {
     for (int n=0; n<nnghbr; ++n) {
       if (nghbr.h_view(m,n).gid >= 0) {  // neighbor exists and not a physical boundary
@@ -212,15 +222,26 @@ TaskStatus MeshBoundaryValuesFC::PackAndSendFC(DvceFaceFld4D<Real> &b,
           } else {
             data_size *= sendbuf[n].ifine_ndat;
           }
-          auto send_ptr = Kokkos::subview(sendbuf[n].vars, m, Kokkos::ALL);
+          // with coalesced messages, just record buffer in list
+          if (coalesce_mpi_) {
+            clist.push_back({drank, tag, m, n, 0, data_size});
+            continue;
+          }
+          auto send_ptr = Kokkos::subview(sendbuf[n].vars_mpi, m, Kokkos::ALL);
 
           int ierr = MPI_Isend(send_ptr.data(), data_size, MPI_ATHENA_REAL, drank, tag,
                                comm_vars, &(sendbuf[n].vars_req[m]));
+          pmy_pack->pmesh->ccounter.Tally(drank, true, data_size*sizeof(Real));
           if (ierr != MPI_SUCCESS) {no_errors=false;}
         }
       }
     }
   }
+  // Gather buffers and send one message to each neighboring rank
+  if (coalesce_mpi_) {
+    if (CoalescedIsStale(csend_vars_, 3)) {BuildCoalesced(csend_vars_, clist, 3);}
+    SendCoalesced(csend_vars_, false, comm_vars);
+  }
   // Quit if MPI error detected
   if (!(no_errors)) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
@@ -250,7 +271,7 @@ TaskStatus MeshBoundaryValuesFC::RecvAndUnpackFC(DvceFaceFld4D<Real> &b,
   for (int m=0; m<nmb; ++m) {
     for (int n=0; n<nnghbr; ++n) {
       if (nghbr.h_view(m,n).gid >= 0) { // ID != -1, so not a physical boundary
-        if (nghbr.h_view(m,n).rank != global_variable::my_rank) {
+        if ((nghbr.h_view(m,n).rank != global_variable::my_rank) && !(coalesce_mpi_)) {
           int test;
           int ierr = MPI_Test(&(rbuf[n].vars_req[m]), &test, MPI_STATUS_IGNORE);
           if (ierr != MPI_SUCCESS) {no_errors=false;}
@@ -268,18 +289,24 @@ TaskStatus MeshBoundaryValuesFC::RecvAndUnpackFC(DvceFaceFld4D<Real> &b,
               << std::endl;
     std::exit(EXIT_FAILURE);
   }
+  // test coalesced receives, and scatter into recv buffers once complete
+  if (coalesce_mpi_) {bflag = !(TestCoalescedRecv(crecv_vars_, false));}
   // exit if recv boundary buffer communications have not completed
+  RecordPoll(bflag);
   if (bflag) {return TaskStatus::incomplete;}
+  StageRecvBuffers(false);
 #endif
 
   //----- STEP 2: buffers have all completed, so unpack 3-components of field
 
   auto &mblev = pmy_pack->pmb->mb_lev;
+  auto &cidx = pmy_pack->pmb->mb_cidx;
   // Outer loop over (# of MeshBlocks)*(# of buffers)*(three field components)
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), (3*nmb), Kokkos::AUTO);
+  Kokkos::TeamPolicy<> policy(pmy_pack->exec_space, (3*nmb), Kokkos::AUTO);
   Kokkos::parallel_for("RecvBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
     const int m = tmember.league_rank()/3;
     const int v = tmember.league_rank()%3;
+    const int cm = cidx.d_view(m);  // index of MB in coarse array
 
     // scalar loop over neighbors to prevent race condition in overlapping assignments
     for (int n=0; n<nnghbr; ++n) {
@@ -348,11 +375,11 @@ TaskStatus MeshBoundaryValuesFC::RecvAndUnpackFC(DvceFaceFld4D<Real> &b,
             k += kl;
             j += jl;
             if (v==0) {
-              cb.x1f(m,k,j,i) = rbuf[n].vars(m,i-il + ni*(j-jl + nj*(k-kl)));
+              cb.x1f(cm,k,j,i) = rbuf[n].vars(m,i-il + ni*(j-jl + nj*(k-kl)));
             } else if (v==1) {
-              cb.x2f(m,k,j,i) = rbuf[n].vars(m,ndat*v + i-il + ni*(j-jl + nj*(k-kl)));
+              cb.x2f(cm,k,j,i) = rbuf[n].vars(m,ndat*v + i-il + ni*(j-jl + nj*(k-kl)));
             } else if (v==2) {
-              cb.x3f(m,k,j,i) = rbuf[n].vars(m,ndat*v + i-il + ni*(j-jl + nj*(k-kl)));
+              cb.x3f(cm,k,j,i) = rbuf[n].vars(m,ndat*v + i-il + ni*(j-jl + nj*(k-kl)));
             }
           });
           tmember.team_barrier();
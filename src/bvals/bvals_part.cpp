@@ -12,7 +12,6 @@
 #include <vector>
 #include <algorithm>
 #include <Kokkos_Core.hpp>
-#include <Kokkos_StdAlgorithms.hpp>
 
 #include "athena.hpp"
 #include "globals.hpp"
@@ -26,19 +25,14 @@ namespace particles {
 //----------------------------------------------------------------------------------------
 //! \fn void ParticlesBoundaryValues::UpdateGID()
 //! \brief Updates GID of particles that cross boundary of their parent MeshBlock.  If
-//! the new GID is on a different rank, then store in sendlist_buf DvceArray: (1) index of
-//! particle in prtcl array, (2) destination GID, and (3) destination rank.
+//! the new GID is on a different rank, then store the destination rank in destrank.
 
 KOKKOS_INLINE_FUNCTION
-void UpdateGID(int &newgid, NeighborBlock nghbr, int myrank, int *pcounter,
-               DualArray1D<ParticleLocationData> slist, int p) {
+void UpdateGID(int &newgid, NeighborBlock nghbr, int myrank, int &destrank) {
   newgid = nghbr.gid;
 #if MPI_PARALLEL_ENABLED
   if (nghbr.rank != myrank) {
-    int index = Kokkos::atomic_fetch_add(pcounter,1);
-    slist.d_view(index).prtcl_indx = p;
-    slist.d_view(index).dest_gid   = nghbr.gid;
-    slist.d_view(index).dest_rank  = nghbr.rank;
+    destrank = nghbr.rank;
   }
 #endif
   return;
@@ -59,14 +53,13 @@ TaskStatus ParticlesBoundaryValues::SetNewPrtclGID() {
   auto &meshsize = pmy_part->pmy_pack->pmesh->mesh_size;
   auto myrank = global_variable::my_rank;
   auto &nghbr = pmy_part->pmy_pack->pmb->nghbr;
-  auto &psendl = sendlist;
-  int counter=0;
-  int *pcounter = &counter;
   bool &multi_d = pmy_part->pmy_pack->pmesh->multi_d;
   bool &three_d = pmy_part->pmy_pack->pmesh->three_d;
 
-  Kokkos::realloc(sendlist, static_cast<int>(0.1*npart));
+  // rank to which each particle is sent (-1 if it stays on this rank)
+  DvceArray1D<int> prank("prank", npart);
   par_for("part_update",DevExeSpace(),0,(npart-1), KOKKOS_LAMBDA(const int p) {
+    prank(p) = -1;
     int m = pi(PGID,p) - gids;
     int mylevel = mblev.d_view(m);
     Real x1 = pr(IPX,p);
@@ -100,7 +93,7 @@ TaskStatus ParticlesBoundaryValues::SetNewPrtclGID() {
             indx = NeighborIndex(ix,0,0,fy,fz);
           }
           while (nghbr.d_view(m,indx).gid < 0) {indx++;}  // neighbor at coarser level
-          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, pcounter, psendl, p);
+          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, prank(p));
         } else if (ix == 0) {
           // x2 face
           int indx = NeighborIndex(0,iy,0,0,0);
@@ -108,7 +101,7 @@ TaskStatus ParticlesBoundaryValues::SetNewPrtclGID() {
             indx = NeighborIndex(0,iy,0,fx,fz);
           }
           while (nghbr.d_view(m,indx).gid < 0) {indx++;}
-          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, pcounter, psendl, p);
+          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, prank(p));
         } else {
           // x1x2 edge
           int indx = NeighborIndex(ix,iy,0,0,0);
@@ -116,7 +109,7 @@ TaskStatus ParticlesBoundaryValues::SetNewPrtclGID() {
             indx = NeighborIndex(ix,iy,0,fz,0);
           }
           while (nghbr.d_view(m,indx).gid < 0) {indx++;}
-          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, pcounter, psendl, p);
+          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, prank(p));
         }
       } else if (iy == 0) {
         if (ix == 0) {
@@ -126,7 +119,7 @@ TaskStatus ParticlesBoundaryValues::SetNewPrtclGID() {
             indx = NeighborIndex(0,0,iz,fx,fy);
           }
           while (nghbr.d_view(m,indx).gid < 0) {indx++;}
-          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, pcounter, psendl, p);
+          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, prank(p));
         } else {
           // x3x1 edge
           int indx = NeighborIndex(ix,0,iz,0,0);
@@ -134,7 +127,7 @@ TaskStatus ParticlesBoundaryValues::SetNewPrtclGID() {
             indx = NeighborIndex(ix,0,iz,fy,0);
           }
           while (nghbr.d_view(m,indx).gid < 0) {indx++;}
-          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, pcounter, psendl, p);
+          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, prank(p));
         }
       } else {
         if (ix == 0) {
@@ -144,11 +137,11 @@ TaskStatus ParticlesBoundaryValues::SetNewPrtclGID() {
             indx = NeighborIndex(0,iy,iz,fx,0);
           }
           while (nghbr.d_view(m,indx).gid < 0) {indx++;}
-          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, pcounter, psendl, p);
+          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, prank(p));
         } else {
           // corners
           int indx = NeighborIndex(ix,iy,iz,0,0);
-          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, pcounter, psendl, p);
+          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, prank(p));
         }
       }
 
@@ -170,11 +163,29 @@ TaskStatus ParticlesBoundaryValues::SetNewPrtclGID() {
       }
     }
   });
-  nprtcl_send = counter;
-  Kokkos::resize(sendlist, nprtcl_send);
-  // sync sendlist device array with host
+
+  // Build sendlist on device with a scan over particles, so that it is ordered by
+  // index in particle array
+  int nsend = 0;
+  Kokkos::parallel_reduce("part_nsend",Kokkos::RangePolicy<>(DevExeSpace(),0,npart),
+  KOKKOS_LAMBDA(const int p, int &sum) {
+    if (prank(p) >= 0) {sum++;}
+  }, Kokkos::Sum<int>(nsend));
+  nprtcl_send = nsend;
+  Kokkos::realloc(sendlist, nprtcl_send);
+  auto &psendl = sendlist;
+  Kokkos::parallel_scan("part_sendlist",Kokkos::RangePolicy<>(DevExeSpace(),0,npart),
+  KOKKOS_LAMBDA(const int p, int &partial, const bool final) {
+    if (prank(p) >= 0) {
+      if (final) {
+        psendl.d_view(partial).prtcl_indx = p;
+        psendl.d_view(partial).dest_gid   = pi(PGID,p);
+        psendl.d_view(partial).dest_rank  = prank(p);
+      }
+      partial++;
+    }
+  });
   sendlist.template modify<DevExeSpace>();
-  sendlist.template sync<HostMemSpace>();
 
   return TaskStatus::complete;
 }
@@ -185,60 +196,101 @@ TaskStatus ParticlesBoundaryValues::SetNewPrtclGID() {
 
 TaskStatus ParticlesBoundaryValues::CountSendsAndRecvs() {
 #if MPI_PARALLEL_ENABLED
-  // Sort sendlist on host by destrank.
-  namespace KE = Kokkos::Experimental;
-  std::sort(KE::begin(sendlist.h_view), KE::end(sendlist.h_view), SortByRank);
-  // sync sendlist host array with device.  This results in sorted array on device
-  sendlist.template modify<HostMemSpace>();
-  sendlist.template sync<DevExeSpace>();
+  // Find ranks (other than this rank) of all neighboring MeshBlocks.  Particles are only
+  // exchanged with these ranks, and since neighbors are symmetric this rank is also a
+  // neighbor of each of them, so counts need only be exchanged with them.
+  int &myrank = global_variable::my_rank;
+  auto &nghbr = pmy_part->pmy_pack->pmb->nghbr;
+  int nmb = pmy_part->pmy_pack->nmb_thispack;
+  int nnghbr = pmy_part->pmy_pack->pmb->nnghbr;
+  nghbr_ranks.clear();
+  for (int m=0; m<nmb; ++m) {
+    for (int n=0; n<nnghbr; ++n) {
+      if (nghbr.h_view(m,n).gid >= 0 && nghbr.h_view(m,n).rank != myrank) {
+        nghbr_ranks.push_back(nghbr.h_view(m,n).rank);
+      }
+    }
+  }
+  std::sort(nghbr_ranks.begin(), nghbr_ranks.end());
+  nghbr_ranks.erase(std::unique(nghbr_ranks.begin(), nghbr_ranks.end()),
+                    nghbr_ranks.end());
+  int nnr = nghbr_ranks.size();
+  DualArray1D<int> ranks("pnghbr_ranks", nnr);
+  for (int s=0; s<nnr; ++s) {ranks.h_view(s) = nghbr_ranks[s];}
+  ranks.template modify<HostMemSpace>();
+  ranks.template sync<DevExeSpace>();
+
+  // Count particles sent to each neighbor rank on device, storing index of rank in
+  // sendpos
+  DvceArray1D<int> count("pcount", nnr);
+  Kokkos::realloc(sendpos, nprtcl_send);
+  auto &psendl = sendlist;
+  auto &spos = sendpos;
+  par_for("part_count",DevExeSpace(),0,(nprtcl_send-1), KOKKOS_LAMBDA(const int n) {
+    int s = 0;
+    while (ranks.d_view(s) != psendl.d_view(n).dest_rank) {s++;}
+    spos(n) = s;
+    Kokkos::atomic_add(&count(s), 1);
+  });
+  auto count_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), count);
 
   // load STL::vector of ParticleMessageData with <sendrank, recvrank, nprtcls> for sends
-  // from this rank. Length will be nsends; initially this length is unknown
+  // from this rank, and offset of each message in send buffer
   sends_thisrank.clear();
-  if (nprtcl_send > 0) {
-    int &myrank = global_variable::my_rank;
-    int rank = sendlist.h_view(0).dest_rank;
-    int nprtcl = 1;
-
-    for (int n=1; n<nprtcl_send; ++n) {
-      if (sendlist.h_view(n).dest_rank == rank) {
-        ++nprtcl;
-      } else {
-        sends_thisrank.emplace_back(ParticleMessageData(myrank,rank,nprtcl));
-        rank = sendlist.h_view(n).dest_rank;
-        nprtcl = 1;
-      }
+  DualArray1D<int> offset("poffset", nnr);
+  int noffset = 0;
+  for (int s=0; s<nnr; ++s) {
+    offset.h_view(s) = noffset;
+    noffset += count_h(s);
+    if (count_h(s) > 0) {
+      sends_thisrank.emplace_back(ParticleMessageData(myrank,nghbr_ranks[s],count_h(s)));
     }
-    sends_thisrank.emplace_back(ParticleMessageData(myrank,rank,nprtcl));
   }
   nsends = sends_thisrank.size();
+  offset.template modify<HostMemSpace>();
+  offset.template sync<DevExeSpace>();
+
+  // Position of each particle in send buffer, so that particles are ordered by
+  // destination rank (order of particles within each message is arbitrary)
+  Kokkos::deep_copy(count, 0);
+  par_for("part_sendpos",DevExeSpace(),0,(nprtcl_send-1), KOKKOS_LAMBDA(const int n) {
+    int s = spos(n);
+    spos(n) = offset.d_view(s) + Kokkos::atomic_fetch_add(&count(s), 1);
+  });
 
-  // Share number of ranks to send to amongst all ranks
-  nsends_eachrank[global_variable::my_rank] = nsends;
-  MPI_Allgather(&nsends, 1, MPI_INT, nsends_eachrank.data(), 1, MPI_INT, mpi_comm_part);
-
-  // Now share ParticleMessageData amongst all ranks
-  // First create vector of starting indices in full vector
-  std::vector<int> nsends_displ;
-  nsends_displ.resize(global_variable::nranks);
-  nsends_displ[0] = 0;
-  for (int n=1; n<(global_variable::nranks); ++n) {
-    nsends_displ[n] = nsends_displ[n-1] + nsends_eachrank[n-1];
+  // Exchange number of particles sent with each neighbor rank
+  std::vector<int> nsend_eachnghbr(nnr), nrecv_eachnghbr(nnr, 0);
+  std::vector<MPI_Request> count_req(2*nnr, MPI_REQUEST_NULL);
+  bool no_errors=true;
+  for (int s=0; s<nnr; ++s) {
+    nsend_eachnghbr[s] = count_h(s);
+    int tag = 2; // 0 for Reals, 1 for ints
+    int ierr = MPI_Irecv(&(nrecv_eachnghbr[s]), 1, MPI_INT, nghbr_ranks[s], tag,
+                         mpi_comm_part, &(count_req[s]));
+    if (ierr != MPI_SUCCESS) {no_errors=false;}
+    ierr = MPI_Isend(&(nsend_eachnghbr[s]), 1, MPI_INT, nghbr_ranks[s], tag,
+                     mpi_comm_part, &(count_req[nnr+s]));
+    if (ierr != MPI_SUCCESS) {no_errors=false;}
   }
-  int nsends_allranks = nsends_displ[global_variable::nranks - 1] +
-                        nsends_eachrank[global_variable::nranks - 1];
-  // Load ParticleMessageData on this rank into full vector
-  sends_allranks.resize(nsends_allranks, ParticleMessageData(0,0,0));
-  for (int n=0; n<nsends_eachrank[global_variable::my_rank]; ++n) {
-    sends_allranks[n + nsends_displ[global_variable::my_rank]] = sends_thisrank[n];
+  int ierr = MPI_Waitall(2*nnr, count_req.data(), MPI_STATUSES_IGNORE);
+  if (ierr != MPI_SUCCESS) {no_errors=false;}
+  // Quit if MPI error detected
+  if (!(no_errors)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "MPI error in exchanging particle counts" << std::endl;
+    std::exit(EXIT_FAILURE);
   }
 
-  // Share tuples using MPI derived data type for tuple of 3*int
-  MPI_Datatype mpi_ituple;
-  MPI_Type_contiguous(3, MPI_INT, &mpi_ituple);
-  MPI_Allgatherv(MPI_IN_PLACE, nsends_eachrank[global_variable::my_rank],
-                   mpi_ituple, sends_allranks.data(), nsends_eachrank.data(),
-                   nsends_displ.data(), mpi_ituple, mpi_comm_part);
+  // load STL::vector of ParticleMessageData with <sendrank,recvrank,nprtcl_recv> for
+  // receives on this rank.
+  recvs_thisrank.clear();
+  for (int s=0; s<nnr; ++s) {
+    if (nrecv_eachnghbr[s] > 0) {
+      recvs_thisrank.emplace_back(ParticleMessageData(nghbr_ranks[s],myrank,
+                                                      nrecv_eachnghbr[s]));
+    }
+  }
+  nrecvs = recvs_thisrank.size();
 #endif
   return TaskStatus::complete;
 }
@@ -249,18 +301,6 @@ TaskStatus ParticlesBoundaryValues::CountSendsAndRecvs() {
 
 TaskStatus ParticlesBoundaryValues::InitPrtclRecv() {
 #if MPI_PARALLEL_ENABLED
-  // load STL::vector of ParticleMessageData with <sendrank,recvrank,nprtcl_recv> for
-  // receives // on this rank. Length will be nrecvs, initially this length is unknown
-  recvs_thisrank.clear();
-
-  int nsends_allranks = sends_allranks.size();
-  for (int n=0; n<nsends_allranks; ++n) {
-    if (sends_allranks[n].recvrank == global_variable::my_rank) {
-      recvs_thisrank.emplace_back(sends_allranks[n]);
-    }
-  }
-  nrecvs = recvs_thisrank.size();
-
   // Figure out how many particles will be received from all ranks
   nprtcl_recv=0;
   for (int n=0; n<nrecvs; ++n) {
@@ -270,6 +310,8 @@ TaskStatus ParticlesBoundaryValues::InitPrtclRecv() {
   // Allocate receive buffer
   Kokkos::realloc(prtcl_rrecvbuf, (pmy_part->nrdata)*nprtcl_recv);
   Kokkos::realloc(prtcl_irecvbuf, (pmy_part->nidata)*nprtcl_recv);
+  prtcl_rrecvbuf_mpi = Kokkos::create_mirror_view(MPIBuffMemSpace(), prtcl_rrecvbuf);
+  prtcl_irecvbuf_mpi = Kokkos::create_mirror_view(MPIBuffMemSpace(), prtcl_irecvbuf);
 
   // Post non-blocking receives
   bool no_errors=true;
@@ -286,7 +328,8 @@ TaskStatus ParticlesBoundaryValues::InitPrtclRecv() {
     // calculate amount of data to be passed, get pointer to variables
     int data_size = (pmy_part->nrdata)*(recvs_thisrank[n].nprtcls);
     int data_end = data_start + (pmy_part->nrdata)*(recvs_thisrank[n].nprtcls - 1);
-    auto recv_ptr = Kokkos::subview(prtcl_rrecvbuf, std::make_pair(data_start, data_end));
+    auto recv_ptr = Kokkos::subview(prtcl_rrecvbuf_mpi, std::make_pair(data_start,
+                                                                  data_end));
     int drank = recvs_thisrank[n].sendrank;
     int tag = 0; // 0 for Reals, 1 for ints
 
@@ -302,7 +345,8 @@ TaskStatus ParticlesBoundaryValues::InitPrtclRecv() {
     // calculate amount of data to be passed, get pointer to variables
     int data_size = (pmy_part->nidata)*(recvs_thisrank[n].nprtcls);
     int data_end = data_start + (pmy_part->nidata)*(recvs_thisrank[n].nprtcls - 1);
-    auto recv_ptr = Kokkos::subview(prtcl_irecvbuf, std::make_pair(data_start, data_end));
+    auto recv_ptr = Kokkos::subview(prtcl_irecvbuf_mpi, std::make_pair(data_start,
+                                                                  data_end));
     int drank = recvs_thisrank[n].sendrank;
     int tag = 1; // 0 for Reals, 1 for ints
 
@@ -340,27 +384,35 @@ TaskStatus ParticlesBoundaryValues::PackAndSendPrtcls() {
     // Allocate send buffer
     Kokkos::realloc(prtcl_rsendbuf, (pmy_part->nrdata)*nprtcl_send);
     Kokkos::realloc(prtcl_isendbuf, (pmy_part->nidata)*nprtcl_send);
+    prtcl_rsendbuf_mpi = Kokkos::create_mirror_view(MPIBuffMemSpace(), prtcl_rsendbuf);
+    prtcl_isendbuf_mpi = Kokkos::create_mirror_view(MPIBuffMemSpace(), prtcl_isendbuf);
 
-    // sendlist on device is already sorted by destrank in CountSendAndRecvs()
-    // Use sendlist on device to load particles into send buffer ordered by dest_rank
+    // Use sendlist and sendpos set in CountSendAndRecvs() to load particles into send
+    // buffer ordered by dest_rank
     int nrdata = pmy_part->nrdata;
     int nidata = pmy_part->nidata;
     auto &pr = pmy_part->prtcl_rdata;
     auto &pi = pmy_part->prtcl_idata;
     auto &rsendbuf = prtcl_rsendbuf;
     auto &isendbuf = prtcl_isendbuf;
+    auto &spos = sendpos;
     par_for("ppack",DevExeSpace(),0,(nprtcl_send-1), KOKKOS_LAMBDA(const int n) {
       int p = sendlist.d_view(n).prtcl_indx;
+      int q = spos(n);
       for (int i=0; i<nidata; ++i) {
-        isendbuf(nidata*n + i) = pi(i,p);
+        isendbuf(nidata*q + i) = pi(i,p);
       }
       for (int i=0; i<nrdata; ++i) {
-        rsendbuf(nrdata*n + i) = pr(i,p);
+        rsendbuf(nrdata*q + i) = pr(i,p);
       }
     });
 
-    // Post non-blocking sends
+    // Post non-blocking sends, without GPU-aware MPI from host-pinned copy of buffers
     Kokkos::fence();
+#if !(GPU_AWARE_MPI_ENABLED)
+    Kokkos::deep_copy(prtcl_rsendbuf_mpi, prtcl_rsendbuf);
+    Kokkos::deep_copy(prtcl_isendbuf_mpi, prtcl_isendbuf);
+#endif
     rsend_req.clear();
     isend_req.clear();
     for (int n=0; n<nsends; ++n) {
@@ -374,7 +426,8 @@ TaskStatus ParticlesBoundaryValues::PackAndSendPrtcls() {
       // calculate amount of data to be passed, get pointer to variables
       int data_size = nrdata*(sends_thisrank[n].nprtcls);
       int data_end = data_start + nrdata*(sends_thisrank[n].nprtcls - 1);
-      auto send_ptr = Kokkos::subview(prtcl_rsendbuf,std::make_pair(data_start,data_end));
+      auto send_ptr = Kokkos::subview(prtcl_rsendbuf_mpi,
+                                      std::make_pair(data_start,data_end));
       int drank = sends_thisrank[n].recvrank;
       int tag = 0; // 0 for Reals, 1 for ints
 
@@ -390,7 +443,8 @@ TaskStatus ParticlesBoundaryValues::PackAndSendPrtcls() {
       // calculate amount of data to be passed, get pointer to variables
       int data_size = nidata*(sends_thisrank[n].nprtcls);
       int data_end = data_start + nidata*(sends_thisrank[n].nprtcls - 1);
-      auto send_ptr = Kokkos::subview(prtcl_isendbuf,std::make_pair(data_start,data_end));
+      auto send_ptr = Kokkos::subview(prtcl_isendbuf_mpi,
+                                      std::make_pair(data_start,data_end));
       int drank = sends_thisrank[n].recvrank;
       int tag = 1; // 0 for Reals, 1 for ints
 
@@ -418,12 +472,7 @@ TaskStatus ParticlesBoundaryValues::PackAndSendPrtcls() {
 
 TaskStatus ParticlesBoundaryValues::RecvAndUnpackPrtcls() {
 #if MPI_PARALLEL_ENABLED
-  // Sort sendlist on host by index in particle array
-  namespace KE = Kokkos::Experimental;
-  std::sort(KE::begin(sendlist.h_view), KE::end(sendlist.h_view), SortByIndex);
-  // sync sendlist host array with device.  This results in sorted array on device
-  sendlist.template modify<HostMemSpace>();
-  sendlist.template sync<DevExeSpace>();
+  // Note sendlist was built ordered by index in particle array in SetNewPrtclGID()
 
   // increase size of particle arrays if needed
   int new_npart = pmy_part->nprtcl_thispack + (nprtcl_recv - nprtcl_send);
@@ -457,6 +506,11 @@ TaskStatus ParticlesBoundaryValues::RecvAndUnpackPrtcls() {
   }
   // exit if particle communications have not completed
   if (bflag) {return TaskStatus::incomplete;}
+#if !(GPU_AWARE_MPI_ENABLED)
+  // copy received data from host-pinned memory to device
+  Kokkos::deep_copy(prtcl_rrecvbuf, prtcl_rrecvbuf_mpi);
+  Kokkos::deep_copy(prtcl_irecvbuf, prtcl_irecvbuf_mpi);
+#endif
 
   // unpack particles into positions of sent particles
   if (nprtcl_recv > 0) {
@@ -488,26 +542,39 @@ TaskStatus ParticlesBoundaryValues::RecvAndUnpackPrtcls() {
   // remaining holes
   int nremain = nprtcl_send - nprtcl_recv;
   if (nremain > 0) {
-    int &npart = pmy_part->nprtcl_thispack;
-    int i_last_hole = nprtcl_send-1;
-    int i_next_hole = nprtcl_recv;
-    for (int n=1; n<=nremain; ++n) {
-      int nend = npart-n;
-      if (nend > sendlist.h_view(i_last_hole).prtcl_indx) {
-        // copy particle from end into hole
-        int next_hole = sendlist.h_view(i_next_hole).prtcl_indx;
-        auto rdest = Kokkos::subview(pmy_part->prtcl_rdata, Kokkos::ALL, next_hole);
-        auto rsrc  = Kokkos::subview(pmy_part->prtcl_rdata, Kokkos::ALL, nend);
-        Kokkos::deep_copy(rdest, rsrc);
-        auto idest = Kokkos::subview(pmy_part->prtcl_idata, Kokkos::ALL, next_hole);
-        auto isrc  = Kokkos::subview(pmy_part->prtcl_idata, Kokkos::ALL, nend);
-        Kokkos::deep_copy(idest, isrc);
-        i_next_hole += 1;
-      } else {
-        // this index contains a hole, so do nothing except find new index of last hole
-        i_last_hole -= 1;
+    int npart = pmy_part->nprtcl_thispack;
+    int nrdata = pmy_part->nrdata;
+    int nidata = pmy_part->nidata;
+    auto &pr = pmy_part->prtcl_rdata;
+    auto &pi = pmy_part->prtcl_idata;
+    auto &psendl = sendlist;
+    // flag remaining holes at indices >= new_npart
+    DvceArray1D<int> hole("phole", npart - new_npart);
+    par_for("phole",DevExeSpace(),nprtcl_recv,(nprtcl_send-1),
+    KOKKOS_LAMBDA(const int n) {
+      int p = psendl.d_view(n).prtcl_indx;
+      if (p >= new_npart) {hole(p - new_npart) = 1;}
+    });
+    // Remaining holes below new_npart are the first entries of sendlist after those
+    // filled above (since sendlist is ordered by index), and there are as many of them
+    // as particles at indices >= new_npart.  Move these particles into the holes in
+    // order, on device.
+    Kokkos::parallel_scan("pcompact",Kokkos::RangePolicy<>(DevExeSpace(),0,
+                          (npart - new_npart)),
+    KOKKOS_LAMBDA(const int n, int &partial, const bool final) {
+      if (hole(n) == 0) {
+        if (final) {
+          int p = psendl.d_view(nprtcl_recv + partial).prtcl_indx;
+          for (int i=0; i<nidata; ++i) {
+            pi(i,p) = pi(i,new_npart + n);
+          }
+          for (int i=0; i<nrdata; ++i) {
+            pr(i,p) = pr(i,new_npart + n);
+          }
+        }
+        partial++;
       }
-    }
+    });
 
     // shrink size of particle data arrays
     Kokkos::resize(pmy_part->prtcl_idata, pmy_part->nidata, new_npart);
@@ -518,7 +585,7 @@ TaskStatus ParticlesBoundaryValues::RecvAndUnpackPrtcls() {
   pmy_part->nprtcl_thispack = new_npart;
   pmy_part->pmy_pack->pmesh->nprtcl_thisrank = new_npart;
   MPI_Allgather(&new_npart,1,MPI_INT,(pmy_part->pmy_pack->pmesh->nprtcl_eachrank),1,
-                MPI_INT,MPI_COMM_WORLD);
+                MPI_INT,global_variable::athena_comm);
 #endif
   return TaskStatus::complete;
 }
@@ -17,6 +17,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <utility>
+#include <vector>
 
 #include "athena.hpp"
 #include "globals.hpp"
@@ -30,14 +31,20 @@
 
 TaskStatus MeshBoundaryValues::InitRecv(const int nvars) {
 #if MPI_PARALLEL_ENABLED
+  if (!(coalesce_mpi_) && persistent_mpi_) {
+    StartPersistentRecv(nvars);
+    return TaskStatus::complete;
+  }
   int &nmb = pmy_pack->nmb_thispack;
   int &nnghbr = pmy_pack->pmb->nnghbr;
   auto &nghbr = pmy_pack->pmb->nghbr;
 
   // Initialize communications of variables
   bool no_errors=true;
+  std::vector<CoalescedEntry> clist;
   for (int m=0; m<nmb; ++m) {
     for (int n=0; n<nnghbr; ++n) {
+      if (faces_only && !(IsFaceBuffer(n))) continue;
       if (nghbr.h_view(m,n).gid >= 0) {
         // rank of destination buffer
         int drank = nghbr.h_view(m,n).rank;
@@ -52,7 +59,7 @@ TaskStatus MeshBoundaryValues::InitRecv(const int nvars) {
           if ( nghbr.h_view(m,n).lev < pmy_pack->pmb->mb_lev.h_view(m) ) {
             data_size *= recvbuf[n].icoar_ndat;
           } else if ( nghbr.h_view(m,n).lev == pmy_pack->pmb->mb_lev.h_view(m) ) {
-            if (is_z4c_) {
+            if (is_z4c_ && nghbr.h_view(m,n).recv_coarse) {
               data_size *= recvbuf[n].isame_z4c_ndat;
             } else {
               data_size *= recvbuf[n].isame_ndat;
@@ -60,16 +67,36 @@ TaskStatus MeshBoundaryValues::InitRecv(const int nvars) {
           } else {
             data_size *= recvbuf[n].ifine_ndat;
           }
-          auto recv_ptr = Kokkos::subview(recvbuf[n].vars, m, Kokkos::ALL);
+          // with coalesced messages, just record buffer in list
+          if (coalesce_mpi_) {
+            clist.push_back({drank, tag, m, n, 0, data_size});
+            continue;
+          }
+          // with compressed messages, receive into single-precision buffer
+          if (CompressMessage(drank)) {
+            auto recv_ptr = Kokkos::subview(recvbuf[n].vars_cmp_mpi, m, Kokkos::ALL);
+            int ierr = MPI_Irecv(recv_ptr.data(), data_size, MPI_FLOAT, drank, tag,
+                                 comm_vars, &(recvbuf[n].vars_req[m]));
+            pmy_pack->pmesh->ccounter.Tally(drank, false, data_size*sizeof(float));
+            if (ierr != MPI_SUCCESS) {no_errors=false;}
+            continue;
+          }
+          auto recv_ptr = Kokkos::subview(recvbuf[n].vars_mpi, m, Kokkos::ALL);
 
           // Post non-blocking receive for this buffer on this MeshBlock
           int ierr = MPI_Irecv(recv_ptr.data(), data_size, MPI_ATHENA_REAL, drank, tag,
                                comm_vars, &(recvbuf[n].vars_req[m]));
+          pmy_pack->pmesh->ccounter.Tally(drank, false, data_size*sizeof(Real));
           if (ierr != MPI_SUCCESS) {no_errors=false;}
         }
       }
     }
   }
+  // Post one receive from each neighboring rank for coalesced messages
+  if (coalesce_mpi_) {
+    if (CoalescedIsStale(crecv_vars_, nvars)) {BuildCoalesced(crecv_vars_, clist, nvars);}
+    PostCoalescedRecv(crecv_vars_, comm_vars);
+  }
   // Quit if MPI error detected
   if (!(no_errors)) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
@@ -80,6 +107,281 @@ TaskStatus MeshBoundaryValues::InitRecv(const int nvars) {
   return TaskStatus::complete;
 }
 
+#if MPI_PARALLEL_ENABLED
+//----------------------------------------------------------------------------------------
+//! \fn  void MeshBoundaryValues::StartPersistentRecv
+//! \brief Starts persistent receives for boundary communications of vars.  Requests are
+//! created with MPI_Recv_init() the first time this function is called, and re-created
+//! only if the number of variables changes, or the Mesh has changed (AMR or load
+//! balancing).  Avoids overhead of setting up each message every stage.
+
+void MeshBoundaryValues::StartPersistentRecv(const int nvars) {
+  int &nmb = pmy_pack->nmb_thispack;
+  int &nnghbr = pmy_pack->pmb->nnghbr;
+  auto &nghbr = pmy_pack->pmb->nghbr;
+
+  // (re)create persistent requests if needed
+  bool no_errors=true;
+  if (nvars != precv_nvar_ || pmy_pack->pmesh->mesh_version != precv_version_) {
+    FreePersistentRequests(recvbuf);
+    for (int m=0; m<nmb; ++m) {
+      for (int n=0; n<nnghbr; ++n) {
+        if (nghbr.h_view(m,n).gid >= 0) {
+          int drank = nghbr.h_view(m,n).rank;
+          if (drank != global_variable::my_rank) {
+            // create tag using local ID and buffer index of *receiving* MeshBlock
+            int tag = CreateBvals_MPI_Tag(m, n);
+            int data_size = nvars;
+            if ( nghbr.h_view(m,n).lev < pmy_pack->pmb->mb_lev.h_view(m) ) {
+              data_size *= recvbuf[n].icoar_ndat;
+            } else if ( nghbr.h_view(m,n).lev == pmy_pack->pmb->mb_lev.h_view(m) ) {
+              if (is_z4c_ && nghbr.h_view(m,n).recv_coarse) {
+                data_size *= recvbuf[n].isame_z4c_ndat;
+              } else {
+                data_size *= recvbuf[n].isame_ndat;
+              }
+            } else {
+              data_size *= recvbuf[n].ifine_ndat;
+            }
+            auto recv_ptr = Kokkos::subview(recvbuf[n].vars_mpi, m, Kokkos::ALL);
+            int ierr = MPI_Recv_init(recv_ptr.data(), data_size, MPI_ATHENA_REAL, drank,
+                                     tag, comm_vars, &(recvbuf[n].vars_req[m]));
+            if (ierr != MPI_SUCCESS) {no_errors=false;}
+          }
+        }
+      }
+    }
+    precv_nvar_ = nvars;
+    precv_version_ = pmy_pack->pmesh->mesh_version;
+  }
+
+  // start all receives (only on faces with faces_only)
+  for (int m=0; m<nmb; ++m) {
+    for (int n=0; n<nnghbr; ++n) {
+      if (faces_only && !(IsFaceBuffer(n))) continue;
+      if ( (nghbr.h_view(m,n).gid >= 0) &&
+           (nghbr.h_view(m,n).rank != global_variable::my_rank) ) {
+        int ierr = MPI_Start(&(recvbuf[n].vars_req[m]));
+        if (ierr != MPI_SUCCESS) {no_errors=false;}
+        int nbytes = VarsMessageSize(recvbuf, m, n, nvars)*sizeof(Real);
+        pmy_pack->pmesh->ccounter.Tally(nghbr.h_view(m,n).rank, false, nbytes);
+      }
+    }
+  }
+  // Quit if MPI error detected
+  if (!(no_errors)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+       << std::endl << "MPI error in starting persistent receives" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MeshBoundaryValues::StartPersistentSend
+//! \brief Starts persistent sends for boundary communications of vars, after the send
+//! buffers have been packed.  Requests are (re)created with MPI_Send_init() under the
+//! same conditions as the receives in StartPersistentRecv().  Used for both CC and FC
+//! vars (with nvar=3 for FC).
+
+void MeshBoundaryValues::StartPersistentSend(const int nvar) {
+  int &nmb = pmy_pack->nmb_thispack;
+  int &nnghbr = pmy_pack->pmb->nnghbr;
+  auto &nghbr = pmy_pack->pmb->nghbr;
+  int my_rank = global_variable::my_rank;
+
+  // (re)create persistent requests if needed
+  bool no_errors=true;
+  if (nvar != psend_nvar_ || pmy_pack->pmesh->mesh_version != psend_version_) {
+    FreePersistentRequests(sendbuf);
+    for (int m=0; m<nmb; ++m) {
+      for (int n=0; n<nnghbr; ++n) {
+        if (nghbr.h_view(m,n).gid >= 0) {
+          // index and rank of destination Neighbor
+          int dn = nghbr.h_view(m,n).dest;
+          int drank = nghbr.h_view(m,n).rank;
+          if (drank != my_rank) {
+            // create tag using local ID and buffer index of *receiving* MeshBlock
+            int lid = nghbr.h_view(m,n).gid - pmy_pack->pmesh->gids_eachrank[drank];
+            int tag = CreateBvals_MPI_Tag(lid, dn);
+            int data_size = nvar;
+            if ( nghbr.h_view(m,n).lev < pmy_pack->pmb->mb_lev.h_view(m) ) {
+              data_size *= sendbuf[n].icoar_ndat;
+            } else if ( nghbr.h_view(m,n).lev == pmy_pack->pmb->mb_lev.h_view(m) ) {
+              if (is_z4c_ && nghbr.h_view(m,n).send_coarse) {
+                data_size *= sendbuf[n].isame_z4c_ndat;
+              } else {
+                data_size *= sendbuf[n].isame_ndat;
+              }
+            } else {
+              data_size *= sendbuf[n].ifine_ndat;
+            }
+            auto send_ptr = Kokkos::subview(sendbuf[n].vars_mpi, m, Kokkos::ALL);
+            int ierr = MPI_Send_init(send_ptr.data(), data_size, MPI_ATHENA_REAL, drank,
+                                     tag, comm_vars, &(sendbuf[n].vars_req[m]));
+            if (ierr != MPI_SUCCESS) {no_errors=false;}
+          }
+        }
+      }
+    }
+    psend_nvar_ = nvar;
+    psend_version_ = pmy_pack->pmesh->mesh_version;
+  }
+
+  // start all sends (only on faces with faces_only)
+  for (int m=0; m<nmb; ++m) {
+    for (int n=0; n<nnghbr; ++n) {
+      if (faces_only && !(IsFaceBuffer(n))) continue;
+      if ( (nghbr.h_view(m,n).gid >= 0) && (nghbr.h_view(m,n).rank != my_rank) ) {
+        int ierr = MPI_Start(&(sendbuf[n].vars_req[m]));
+        if (ierr != MPI_SUCCESS) {no_errors=false;}
+        int nbytes = VarsMessageSize(sendbuf, m, n, nvar)*sizeof(Real);
+        pmy_pack->pmesh->ccounter.Tally(nghbr.h_view(m,n).rank, true, nbytes);
+      }
+    }
+  }
+  // Quit if MPI error detected
+  if (!(no_errors)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+       << std::endl << "MPI error in starting persistent sends" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MeshBoundaryValues::StageSendBuffers
+//! \brief Waits for the packing kernels of this MeshBlockPack to complete before data is
+//! passed to MPI, by fencing only the execution-space instance of the pack rather than
+//! the whole device.  Without GPU-aware MPI, send buffers (vars, or fluxes if flux=true)
+//! are first copied into host-pinned memory.  Coalesced messages are staged separately.
+
+void MeshBoundaryValues::StageSendBuffers(bool flux) {
+  auto &exec = pmy_pack->exec_space;
+#if !(GPU_AWARE_MPI_ENABLED)
+  if (!(coalesce_mpi_)) {
+    int &nmb = pmy_pack->nmb_thispack;
+    int &nnghbr = pmy_pack->pmb->nnghbr;
+    auto &nghbr = pmy_pack->pmb->nghbr;
+    for (int m=0; m<nmb; ++m) {
+      for (int n=0; n<nnghbr; ++n) {
+        if ( (nghbr.h_view(m,n).gid >= 0) &&
+             (nghbr.h_view(m,n).rank != global_variable::my_rank) ) {
+          if (flux) {
+            Kokkos::deep_copy(exec, Kokkos::subview(sendbuf[n].flux_mpi, m, Kokkos::ALL),
+                              Kokkos::subview(sendbuf[n].flux, m, Kokkos::ALL));
+          } else if (CompressMessage(nghbr.h_view(m,n).rank)) {
+            Kokkos::deep_copy(exec,
+                              Kokkos::subview(sendbuf[n].vars_cmp_mpi, m, Kokkos::ALL),
+                              Kokkos::subview(sendbuf[n].vars_cmp, m, Kokkos::ALL));
+          } else {
+            Kokkos::deep_copy(exec, Kokkos::subview(sendbuf[n].vars_mpi, m, Kokkos::ALL),
+                              Kokkos::subview(sendbuf[n].vars, m, Kokkos::ALL));
+          }
+        }
+      }
+    }
+  }
+#endif
+  exec.fence();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MeshBoundaryValues::StageRecvBuffers
+//! \brief Without GPU-aware MPI, copies completed receive buffers (vars, or fluxes if
+//! flux=true) from host-pinned memory back to device, before they are unpacked.  The
+//! copies are enqueued on the execution-space instance of this MeshBlockPack, so they are
+//! ordered before the unpacking kernels without a fence.
+
+void MeshBoundaryValues::StageRecvBuffers(bool flux) {
+#if !(GPU_AWARE_MPI_ENABLED)
+  if (coalesce_mpi_) {return;}
+  // only rows for neighbors on other ranks are copied, since data from neighbors on the
+  // same rank is written directly into device buffers
+  auto &exec = pmy_pack->exec_space;
+  int &nmb = pmy_pack->nmb_thispack;
+  int &nnghbr = pmy_pack->pmb->nnghbr;
+  auto &nghbr = pmy_pack->pmb->nghbr;
+  for (int m=0; m<nmb; ++m) {
+    for (int n=0; n<nnghbr; ++n) {
+      if ( (nghbr.h_view(m,n).gid >= 0) &&
+           (nghbr.h_view(m,n).rank != global_variable::my_rank) ) {
+        if (flux) {
+          Kokkos::deep_copy(exec, Kokkos::subview(recvbuf[n].flux, m, Kokkos::ALL),
+                            Kokkos::subview(recvbuf[n].flux_mpi, m, Kokkos::ALL));
+        } else if (CompressMessage(nghbr.h_view(m,n).rank)) {
+          Kokkos::deep_copy(exec, Kokkos::subview(recvbuf[n].vars_cmp, m, Kokkos::ALL),
+                            Kokkos::subview(recvbuf[n].vars_cmp_mpi, m, Kokkos::ALL));
+        } else {
+          Kokkos::deep_copy(exec, Kokkos::subview(recvbuf[n].vars, m, Kokkos::ALL),
+                            Kokkos::subview(recvbuf[n].vars_mpi, m, Kokkos::ALL));
+        }
+      }
+    }
+  }
+#endif
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MeshBoundaryValues::FreePersistentRequests
+//! \brief Frees all (inactive) persistent requests for vars in input array of buffers.
+//! Loops over full length of request arrays since number of MBs may have changed.
+
+void MeshBoundaryValues::FreePersistentRequests(MeshBoundaryBuffer *pbuf) {
+  int &nnghbr = pmy_pack->pmb->nnghbr;
+  for (int n=0; n<nnghbr; ++n) {
+    for (int m=0; m<nmb_req_; ++m) {
+      if (pbuf[n].vars_req[m] != MPI_REQUEST_NULL) {
+        MPI_Request_free(&(pbuf[n].vars_req[m]));
+      }
+    }
+  }
+  return;
+}
+#endif
+
+#if MPI_PARALLEL_ENABLED
+//----------------------------------------------------------------------------------------
+//! \fn  int MeshBoundaryValues::VarsMessageSize
+//! \brief Returns number of values in message of vars for buffer n of MeshBlock m, which
+//! depends on level of neighbor.  Only used to tally bytes for persistent messages.
+
+int MeshBoundaryValues::VarsMessageSize(MeshBoundaryBuffer *pbuf, int m, int n,
+                                        int nvar) {
+  auto &nghbr = pmy_pack->pmb->nghbr;
+  if ( nghbr.h_view(m,n).lev < pmy_pack->pmb->mb_lev.h_view(m) ) {
+    return nvar*pbuf[n].icoar_ndat;
+  } else if ( nghbr.h_view(m,n).lev == pmy_pack->pmb->mb_lev.h_view(m) ) {
+    // with Z4c, coarse data is appended if used by receiving MB
+    bool coarse = (pbuf == sendbuf)? nghbr.h_view(m,n).send_coarse :
+                                     nghbr.h_view(m,n).recv_coarse;
+    return (is_z4c_ && coarse)? nvar*pbuf[n].isame_z4c_ndat : nvar*pbuf[n].isame_ndat;
+  }
+  return nvar*pbuf[n].ifine_ndat;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MeshBoundaryValues::RecordPoll
+//! \brief Records result of polling for completion of receives (incomplete=true if any
+//! receive has not finished).  The time from the first failed poll until the receives
+//! complete is added to the idle time of this rank.
+
+void MeshBoundaryValues::RecordPoll(bool incomplete) {
+  auto &cc = pmy_pack->pmesh->ccounter;
+  if (!(cc.enabled)) return;
+  if (incomplete) {
+    cc.npoll++;
+    if (poll_start_ < 0.0) {poll_start_ = MPI_Wtime();}
+  } else if (poll_start_ >= 0.0) {
+    cc.t_poll += MPI_Wtime() - poll_start_;
+    poll_start_ = -1.0;
+  }
+  return;
+}
+#endif
+
 //----------------------------------------------------------------------------------------
 //! \fn  void MeshBoundaryValues::ClearRecv
 //! \brief Waits for all MPI receives associated with communcation of boundary variables
@@ -91,8 +393,15 @@ TaskStatus MeshBoundaryValues::ClearRecv() {
   int &nmb = pmy_pack->nmb_thispack;
   int &nnghbr = pmy_pack->pmb->nnghbr;
   auto &nghbr = pmy_pack->pmb->nghbr;
+  auto &cc = pmy_pack->pmesh->ccounter;
+  double t_start = (cc.enabled)? MPI_Wtime() : 0.0;
 
   // wait for all non-blocking receives for vars to finish before continuing
+  if (coalesce_mpi_) {
+    WaitCoalesced(crecv_vars_);
+    if (cc.enabled) {cc.t_recv += MPI_Wtime() - t_start;}
+    return TaskStatus::complete;
+  }
   for (int m=0; m<nmb; ++m) {
     for (int n=0; n<nnghbr; ++n) {
       if ( (nghbr.h_view(m,n).gid >= 0) &&
@@ -102,6 +411,7 @@ TaskStatus MeshBoundaryValues::ClearRecv() {
       }
     }
   }
+  if (cc.enabled) {cc.t_recv += MPI_Wtime() - t_start;}
   // Quit if MPI error detected
   if (!(no_errors)) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
@@ -123,8 +433,15 @@ TaskStatus MeshBoundaryValues::ClearSend() {
   int &nmb = pmy_pack->nmb_thispack;
   int &nnghbr = pmy_pack->pmb->nnghbr;
   auto &nghbr = pmy_pack->pmb->nghbr;
+  auto &cc = pmy_pack->pmesh->ccounter;
+  double t_start = (cc.enabled)? MPI_Wtime() : 0.0;
 
   // wait for all non-blocking sends for vars to finish before continuing
+  if (coalesce_mpi_) {
+    WaitCoalesced(csend_vars_);
+    if (cc.enabled) {cc.t_send += MPI_Wtime() - t_start;}
+    return TaskStatus::complete;
+  }
   for (int m=0; m<nmb; ++m) {
     for (int n=0; n<nnghbr; ++n) {
       if ( (nghbr.h_view(m,n).gid >= 0) &&
@@ -134,6 +451,7 @@ TaskStatus MeshBoundaryValues::ClearSend() {
       }
     }
   }
+  if (cc.enabled) {cc.t_send += MPI_Wtime() - t_start;}
   // Quit if MPI error detected
   if (!(no_errors)) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
@@ -155,8 +473,15 @@ TaskStatus MeshBoundaryValues::ClearFluxRecv() {
   int &nmb = pmy_pack->nmb_thispack;
   int &nnghbr = pmy_pack->pmb->nnghbr;
   auto &nghbr = pmy_pack->pmb->nghbr;
+  auto &cc = pmy_pack->pmesh->ccounter;
+  double t_start = (cc.enabled)? MPI_Wtime() : 0.0;
 
   // wait for all non-blocking receives for fluxes to finish before continuing
+  if (coalesce_mpi_) {
+    WaitCoalesced(crecv_flux_);
+    if (cc.enabled) {cc.t_recv += MPI_Wtime() - t_start;}
+    return TaskStatus::complete;
+  }
   for (int m=0; m<nmb; ++m) {
     for (int n=0; n<nnghbr; ++n) {
       if ( (nghbr.h_view(m,n).gid >= 0) &&
@@ -167,6 +492,7 @@ TaskStatus MeshBoundaryValues::ClearFluxRecv() {
       }
     }
   }
+  if (cc.enabled) {cc.t_recv += MPI_Wtime() - t_start;}
 #endif
   if (no_errors) return TaskStatus::complete;
 
@@ -184,8 +510,15 @@ TaskStatus MeshBoundaryValues::ClearFluxSend() {
   int &nmb = pmy_pack->nmb_thispack;
   int &nnghbr = pmy_pack->pmb->nnghbr;
   auto &nghbr = pmy_pack->pmb->nghbr;
+  auto &cc = pmy_pack->pmesh->ccounter;
+  double t_start = (cc.enabled)? MPI_Wtime() : 0.0;
 
   // wait for all non-blocking sends for fluxes to finish before continuing
+  if (coalesce_mpi_) {
+    WaitCoalesced(csend_flux_);
+    if (cc.enabled) {cc.t_send += MPI_Wtime() - t_start;}
+    return TaskStatus::complete;
+  }
   for (int m=0; m<nmb; ++m) {
     for (int n=0; n<nnghbr; ++n) {
       if ( (nghbr.h_view(m,n).gid >= 0) &&
@@ -196,6 +529,7 @@ TaskStatus MeshBoundaryValues::ClearFluxSend() {
       }
     }
   }
+  if (cc.enabled) {cc.t_send += MPI_Wtime() - t_start;}
 #endif
   if (no_errors) return TaskStatus::complete;
 
@@ -7,8 +7,10 @@
 //! \brief functions to pack/send and recv/unpack fluxes for cell-centered variables at
 //! fine/coarse boundaries for the flux correction step.
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
+#include <vector>
 
 #include "athena.hpp"
 #include "globals.hpp"
@@ -16,17 +18,57 @@
 #include "mesh/mesh.hpp"
 #include "bvals.hpp"
 
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValuesCC::UpdateFluxCorrLists()
+//! \brief Builds lists of the faces of MeshBlocks shared with a neighbor at a coarser
+//! level (fluxes restricted and sent) or finer level (fluxes received), so that flux
+//! correction kernels only run over these faces rather than over all neighbors of all
+//! MeshBlocks.  Lists are rebuilt only when the Mesh has changed (AMR or load balancing).
+
+void MeshBoundaryValuesCC::UpdateFluxCorrLists() {
+  if (fcorr_version_ == pmy_pack->pmesh->mesh_version) return;
+  int nmb = pmy_pack->nmb_thispack;
+  int nnghbr = pmy_pack->pmb->nnghbr;
+  auto &nghbr = pmy_pack->pmb->nghbr;
+  auto &mblev = pmy_pack->pmb->mb_lev;
+
+  std::vector<int> slist, rlist;
+  for (int m=0; m<nmb; ++m) {
+    for (int n=0; n<nnghbr; ++n) {
+      if ((nghbr.h_view(m,n).gid >= 0) && ((n<16) || ((n>=24) && (n<32)))) {
+        if (nghbr.h_view(m,n).lev < mblev.h_view(m)) {slist.push_back(m*nnghbr + n);}
+        if (nghbr.h_view(m,n).lev > mblev.h_view(m)) {rlist.push_back(m*nnghbr + n);}
+      }
+    }
+  }
+  nfcorr_send_ = static_cast<int>(slist.size());
+  nfcorr_recv_ = static_cast<int>(rlist.size());
+  Kokkos::realloc(fcorr_send_, std::max(nfcorr_send_, 1));
+  Kokkos::realloc(fcorr_recv_, std::max(nfcorr_recv_, 1));
+  for (int l=0; l<nfcorr_send_; ++l) {fcorr_send_.h_view(l) = slist[l];}
+  for (int l=0; l<nfcorr_recv_; ++l) {fcorr_recv_.h_view(l) = rlist[l];}
+  fcorr_send_.template modify<HostMemSpace>();
+  fcorr_send_.template sync<DevExeSpace>();
+  fcorr_recv_.template modify<HostMemSpace>();
+  fcorr_recv_.template sync<DevExeSpace>();
+  fcorr_version_ = pmy_pack->pmesh->mesh_version;
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void MeshBoundaryValuesCC::PackAndSendFlux()
 //! \brief Pack restricted fluxes of cell-centered variables at fine/coarse boundaries
 //! into boundary buffers and send to neighbors for flux-correction step.  These fluxes
 //! (e.g. for the conserved hydro variables) live at cell faces.
 //!
-//! This routine packs ALL the buffers on ALL the faces simultaneously for ALL the
-//! MeshBlocks. Buffer data are then sent (via MPI) or copied directly for periodic or
-//! block boundaries.
+//! This routine packs ALL the buffers on ALL the faces shared with a coarser neighbor
+//! simultaneously for ALL the MeshBlocks, with one team per face in the compact list
+//! built by UpdateFluxCorrLists(). Buffer data are then sent (via MPI) or copied directly
+//! for periodic or block boundaries.
 
-TaskStatus MeshBoundaryValuesCC::PackAndSendFluxCC(DvceFaceFld5D<Real> &flx) {
+template <typename T>
+TaskStatus MeshBoundaryValuesCC::PackAndSendFluxCC(DvceFaceFld5D<T> &flx) {
+  UpdateFluxCorrLists();
   // create local references for variables in kernel
   int nmb = pmy_pack->nmb_thispack;
   int nnghbr = pmy_pack->pmb->nnghbr;
@@ -44,13 +86,15 @@ TaskStatus MeshBoundaryValuesCC::PackAndSendFluxCC(DvceFaceFld5D<Real> &flx) {
   auto &rbuf = recvbuf;
   auto &one_d = pmy_pack->pmesh->one_d;
   auto &two_d = pmy_pack->pmesh->two_d;
+  auto &flist = fcorr_send_;
 
-  // Outer loop over (# of MeshBlocks)*(# of neighbors)*(# of variables)
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), (nmb*nnghbr*nvar), Kokkos::AUTO);
-  Kokkos::parallel_for("RecvBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-    const int m = (tmember.league_rank())/(nnghbr*nvar);
-    const int n = (tmember.league_rank() - m*(nnghbr*nvar))/nvar;
-    const int v = (tmember.league_rank() - m*(nnghbr*nvar) - n*nvar);
+  // Outer loop over (# of faces with coarser neighbors)*(# of variables)
+  Kokkos::TeamPolicy<> policy(pmy_pack->exec_space, (nfcorr_send_*nvar), Kokkos::AUTO);
+  Kokkos::parallel_for("SendFluxCC", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
+    const int l = (tmember.league_rank())/nvar;
+    const int v = (tmember.league_rank() - l*nvar);
+    const int m = flist.d_view(l)/nnghbr;
+    const int n = flist.d_view(l) - m*nnghbr;
 
     // Note send buffer flux indices are for the coarse mesh
     int il = sbuf[n].iflux_coar[0].bis;
@@ -157,8 +201,9 @@ TaskStatus MeshBoundaryValuesCC::PackAndSendFluxCC(DvceFaceFld5D<Real> &flx) {
 #if MPI_PARALLEL_ENABLED
   // Send boundary buffer to neighboring MeshBlocks using MPI
   // Sends only occur to neighbors on FACES at a COARSER level
-  Kokkos::fence();
+  StageSendBuffers(true);
   bool no_errors=true;
+  std::vector<CoalescedEntry> clist;
   for (int m=0; m<nmb; ++m) {
     for (int n=0; n<nnghbr; ++n) {
       if ( (nghbr.h_view(m,n).gid >=0) &&
@@ -175,15 +220,26 @@ TaskStatus MeshBoundaryValuesCC::PackAndSendFluxCC(DvceFaceFld5D<Real> &flx) {
 
           // get ptr to send buffer for fluxes
           int data_size = nvar*(sendbuf[n].iflxc_ndat);
-          auto send_ptr = Kokkos::subview(sendbuf[n].flux, m, Kokkos::ALL);
+          // with coalesced messages, just record buffer in list
+          if (coalesce_mpi_) {
+            clist.push_back({drank, tag, m, n, 0, data_size});
+            continue;
+          }
+          auto send_ptr = Kokkos::subview(sendbuf[n].flux_mpi, m, Kokkos::ALL);
 
           int ierr = MPI_Isend(send_ptr.data(), data_size, MPI_ATHENA_REAL, drank, tag,
                                comm_flux, &(sendbuf[n].flux_req[m]));
+          pmy_pack->pmesh->ccounter.Tally(drank, true, data_size*sizeof(Real));
           if (ierr != MPI_SUCCESS) {no_errors=false;}
         }
       }
     }
   }
+  // Gather buffers and send one message to each neighboring rank
+  if (coalesce_mpi_) {
+    if (CoalescedIsStale(csend_flux_, nvar)) {BuildCoalesced(csend_flux_, clist, nvar);}
+    SendCoalesced(csend_flux_, true, comm_flux);
+  }
   // Quit if MPI error detected
   if (!(no_errors)) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
@@ -198,7 +254,9 @@ TaskStatus MeshBoundaryValuesCC::PackAndSendFluxCC(DvceFaceFld5D<Real> &flx) {
 //! \fn void RecvBuffers()
 //! \brief Unpack boundary buffers for flux correction of CC variables.
 
-TaskStatus MeshBoundaryValuesCC::RecvAndUnpackFluxCC(DvceFaceFld5D<Real> &flx) {
+template <typename T>
+TaskStatus MeshBoundaryValuesCC::RecvAndUnpackFluxCC(DvceFaceFld5D<T> &flx) {
+  UpdateFluxCorrLists();
   // create local references for variables in kernel
   int nmb = pmy_pack->nmb_thispack;
   int nnghbr = pmy_pack->pmb->nnghbr;
@@ -216,7 +274,7 @@ TaskStatus MeshBoundaryValuesCC::RecvAndUnpackFluxCC(DvceFaceFld5D<Real> &flx) {
       if ( (nghbr.h_view(m,n).gid >=0) &&
            (nghbr.h_view(m,n).lev > mblev.h_view(m)) &&
            ((n<16) || ((n>=24) && (n<32))) ) {
-        if (nghbr.h_view(m,n).rank != global_variable::my_rank) {
+        if ((nghbr.h_view(m,n).rank != global_variable::my_rank) && !(coalesce_mpi_)) {
           int test;
           int ierr = MPI_Test(&(rbuf[n].flux_req[m]), &test, MPI_STATUS_IGNORE);
           if (ierr != MPI_SUCCESS) {no_errors=false;}
@@ -234,20 +292,27 @@ TaskStatus MeshBoundaryValuesCC::RecvAndUnpackFluxCC(DvceFaceFld5D<Real> &flx) {
               << std::endl;
     std::exit(EXIT_FAILURE);
   }
+  // test coalesced receives, and scatter into recv buffers once complete
+  if (coalesce_mpi_) {bflag = !(TestCoalescedRecv(crecv_flux_, true));}
   // exit if recv boundary buffer communications have not completed
+  RecordPoll(bflag);
   if (bflag) {return TaskStatus::incomplete;}
+  StageRecvBuffers(true);
 #endif
 
   //----- STEP 2: buffers have all completed, so unpack
 
   int nvar = flx.x1f.extent_int(1); // TODO(@user): 2nd idx from L of in arr must be NVAR
+  if (nfcorr_recv_ == 0) {return TaskStatus::complete;}
+  auto &flist = fcorr_recv_;
 
-  // Outer loop over (# of MeshBlocks)*(# of neighbors)*(# of variables)
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), (nmb*nnghbr*nvar), Kokkos::AUTO);
-  Kokkos::parallel_for("RecvBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-    const int m = (tmember.league_rank())/(nnghbr*nvar);
-    const int n = (tmember.league_rank() - m*(nnghbr*nvar))/nvar;
-    const int v = (tmember.league_rank() - m*(nnghbr*nvar) - n*nvar);
+  // Outer loop over (# of faces with finer neighbors)*(# of variables)
+  Kokkos::TeamPolicy<> policy(pmy_pack->exec_space, (nfcorr_recv_*nvar), Kokkos::AUTO);
+  Kokkos::parallel_for("RecvFluxCC", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
+    const int l = (tmember.league_rank())/nvar;
+    const int v = (tmember.league_rank() - l*nvar);
+    const int m = flist.d_view(l)/nnghbr;
+    const int n = flist.d_view(l) - m*nnghbr;
 
     // Recv buffer flux indices are for the regular mesh
     int il = rbuf[n].iflux_coar[0].bis;
@@ -313,6 +378,7 @@ TaskStatus MeshBoundaryValuesCC::InitFluxRecv(const int nvars) {
 
   // Initialize communications of fluxes
   bool no_errors=true;
+  std::vector<CoalescedEntry> clist;
   for (int m=0; m<nmb; ++m) {
     for (int n=0; n<nnghbr; ++n) {
       // only post receives for neighbors on FACES at FINER level
@@ -330,16 +396,27 @@ TaskStatus MeshBoundaryValuesCC::InitFluxRecv(const int nvars) {
 
           // calculate amount of data to be passed, get pointer to variables
           int data_size = nvars*(recvbuf[n].iflxc_ndat);
-          auto recv_ptr = Kokkos::subview(recvbuf[n].flux, m, Kokkos::ALL);
+          // with coalesced messages, just record buffer in list
+          if (coalesce_mpi_) {
+            clist.push_back({drank, tag, m, n, 0, data_size});
+            continue;
+          }
+          auto recv_ptr = Kokkos::subview(recvbuf[n].flux_mpi, m, Kokkos::ALL);
 
           // Post non-blocking receive for this buffer on this MeshBlock
           int ierr = MPI_Irecv(recv_ptr.data(), data_size, MPI_ATHENA_REAL, drank, tag,
                                comm_flux, &(recvbuf[n].flux_req[m]));
+          pmy_pack->pmesh->ccounter.Tally(drank, false, data_size*sizeof(Real));
           if (ierr != MPI_SUCCESS) {no_errors=false;}
         }
       }
     }
   }
+  // Post one receive from each neighboring rank for coalesced messages
+  if (coalesce_mpi_) {
+    if (CoalescedIsStale(crecv_flux_, nvars)) {BuildCoalesced(crecv_flux_, clist, nvars);}
+    PostCoalescedRecv(crecv_flux_, comm_flux);
+  }
   // Quit if MPI error detected
   if (!(no_errors)) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
@@ -349,3 +426,21 @@ TaskStatus MeshBoundaryValuesCC::InitFluxRecv(const int nvars) {
 #endif
   return TaskStatus::complete;
 }
+
+// function definitions for each template parameter
+template TaskStatus MeshBoundaryValuesCC::PackAndSendFluxCC<Real>(
+  DvceFaceFld5D<Real> &flx);
+template TaskStatus MeshBoundaryValuesCC::RecvAndUnpackFluxCC<Real>(
+  DvceFaceFld5D<Real> &flx);
+#if MIXED_PRECISION_ENABLED
+template TaskStatus MeshBoundaryValuesCC::PackAndSendFluxCC<FluxReal>(
+  DvceFaceFld5D<FluxReal> &flx);
+template TaskStatus MeshBoundaryValuesCC::RecvAndUnpackFluxCC<FluxReal>(
+  DvceFaceFld5D<FluxReal> &flx);
+#endif
+#if RAD_MIXED_PRECISION_ENABLED && !(MIXED_PRECISION_ENABLED)
+template TaskStatus MeshBoundaryValuesCC::PackAndSendFluxCC<RadReal>(
+  DvceFaceFld5D<RadReal> &flx);
+template TaskStatus MeshBoundaryValuesCC::RecvAndUnpackFluxCC<RadReal>(
+  DvceFaceFld5D<RadReal> &flx);
+#endif
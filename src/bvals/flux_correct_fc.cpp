@@ -9,6 +9,7 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <vector>
 
 #include "athena.hpp"
 #include "globals.hpp"
@@ -45,7 +46,7 @@ TaskStatus MeshBoundaryValuesFC::PackAndSendFluxFC(DvceEdgeFld4D<Real> &flx) {
   auto &two_d = pmy_pack->pmesh->two_d;
 
   // Outer loop over (# of MeshBlocks)*(# of neighbors)*(3 field components)
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), (3*nmb*nnghbr), Kokkos::AUTO);
+  Kokkos::TeamPolicy<> policy(pmy_pack->exec_space, (3*nmb*nnghbr), Kokkos::AUTO);
   Kokkos::parallel_for("RecvBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
     const int m = (tmember.league_rank())/(3*nnghbr);
     const int n = (tmember.league_rank() - m*(3*nnghbr))/3;
@@ -328,8 +329,9 @@ TaskStatus MeshBoundaryValuesFC::PackAndSendFluxFC(DvceEdgeFld4D<Real> &flx) {
 #if MPI_PARALLEL_ENABLED
   // Send boundary buffer to neighboring MeshBlocks using MPI
   // Sends only occur to neighbors on FACES and EDGES at COARSER or SAME level
-  Kokkos::fence();
+  StageSendBuffers(true);
   bool no_errors=true;
+  std::vector<CoalescedEntry> clist;
   for (int m=0; m<nmb; ++m) {
     for (int n=0; n<nnghbr; ++n) {
       if ( (nghbr.h_view(m,n).gid >=0) &&
@@ -351,15 +353,26 @@ TaskStatus MeshBoundaryValuesFC::PackAndSendFluxFC(DvceEdgeFld4D<Real> &flx) {
           } else if ( nghbr.h_view(m,n).lev == pmy_pack->pmb->mb_lev.h_view(m) ) {
             data_size *= sendbuf[n].iflxs_ndat;
           }
-          auto send_ptr = Kokkos::subview(sendbuf[n].flux, m, Kokkos::ALL);
+          // with coalesced messages, just record buffer in list
+          if (coalesce_mpi_) {
+            clist.push_back({drank, tag, m, n, 0, data_size});
+            continue;
+          }
+          auto send_ptr = Kokkos::subview(sendbuf[n].flux_mpi, m, Kokkos::ALL);
 
           int ierr = MPI_Isend(send_ptr.data(), data_size, MPI_ATHENA_REAL, drank, tag,
                                comm_flux, &(sendbuf[n].flux_req[m]));
+          pmy_pack->pmesh->ccounter.Tally(drank, true, data_size*sizeof(Real));
           if (ierr != MPI_SUCCESS) {no_errors=false;}
         }
       }
     }
   }
+  // Gather buffers and send one message to each neighboring rank
+  if (coalesce_mpi_) {
+    if (CoalescedIsStale(csend_flux_, 3)) {BuildCoalesced(csend_flux_, clist, 3);}
+    SendCoalesced(csend_flux_, true, comm_flux);
+  }
   // Quit if MPI error detected
   if (!(no_errors)) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
@@ -394,7 +407,7 @@ TaskStatus MeshBoundaryValuesFC::RecvAndUnpackFluxFC(DvceEdgeFld4D<Real> &flx) {
       if ( (nghbr.h_view(m,n).gid >=0) &&
            (nghbr.h_view(m,n).lev >= mblev.h_view(m)) &&
            (n<48) ) {
-        if (nghbr.h_view(m,n).rank != global_variable::my_rank) {
+        if ((nghbr.h_view(m,n).rank != global_variable::my_rank) && !(coalesce_mpi_)) {
           int test;
           int ierr = MPI_Test(&(rbuf[n].flux_req[m]), &test, MPI_STATUS_IGNORE);
           if (ierr != MPI_SUCCESS) {no_errors=false;}
@@ -412,15 +425,19 @@ TaskStatus MeshBoundaryValuesFC::RecvAndUnpackFluxFC(DvceEdgeFld4D<Real> &flx) {
               << std::endl;
     std::exit(EXIT_FAILURE);
   }
+  // test coalesced receives, and scatter into recv buffers once complete
+  if (coalesce_mpi_) {bflag = !(TestCoalescedRecv(crecv_flux_, true));}
   // exit if recv boundary buffer communications have not completed
+  RecordPoll(bflag);
   if (bflag) {return TaskStatus::incomplete;}
+  StageRecvBuffers(true);
 #endif
 
   //----- STEP 2: buffers have all completed, so unpack and perform appropriate averaging
 
   // 2D array to store number of fluxes summed into corner buffers
   DvceArray2D<int> nflx("nflx",nmb,48);
-  par_for("init_nflx", DevExeSpace(), 0, (nmb-1), 0, 47,
+  par_for("init_nflx", pmy_pack->exec_space, 0, (nmb-1), 0, 47,
   KOKKOS_LAMBDA(const int m, const int n) {
     nflx(m,n) = 1;
   });
@@ -459,7 +476,7 @@ void MeshBoundaryValuesFC::SumBoundaryFluxes(DvceEdgeFld4D<Real> &flx,
 
   // Sum recieve buffers into EMFs stored on MeshBlocks
   // Outer loop over (# of MeshBlocks)*(3 field components)
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), (3*nmb), Kokkos::AUTO);
+  Kokkos::TeamPolicy<> policy(pmy_pack->exec_space, (3*nmb), Kokkos::AUTO);
   Kokkos::parallel_for("RecvBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
     const int m = tmember.league_rank()/3;
     const int v = tmember.league_rank()%3;
@@ -659,7 +676,7 @@ void MeshBoundaryValuesFC::ZeroFluxesAtBoundaryWithFiner(DvceEdgeFld4D<Real> &fl
   auto &mblev = pmy_pack->pmb->mb_lev;
 
   // Outer loop over (# of MeshBlocks)*(# of neighbors)*(3 field components)
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), (3*nmb*nnghbr), Kokkos::AUTO);
+  Kokkos::TeamPolicy<> policy(pmy_pack->exec_space, (3*nmb*nnghbr), Kokkos::AUTO);
   Kokkos::parallel_for("RecvBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
     const int m = (tmember.league_rank())/(3*nnghbr);
     const int n = (tmember.league_rank() - m*(3*nnghbr))/3;
@@ -815,7 +832,7 @@ void MeshBoundaryValuesFC::AverageBoundaryFluxes(DvceEdgeFld4D<Real> &flx,
   bool &three_d = pmy_pack->pmesh->three_d;
 
   // Outer loop over (# of MeshBlocks)*(# of neighbors)*(3 field components)
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), (3*nmb*nnghbr), Kokkos::AUTO);
+  Kokkos::TeamPolicy<> policy(pmy_pack->exec_space, (3*nmb*nnghbr), Kokkos::AUTO);
   Kokkos::parallel_for("RecvBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
     const int m = (tmember.league_rank())/(3*nnghbr);
     const int n = (tmember.league_rank() - m*(3*nnghbr))/3;
@@ -1047,6 +1064,7 @@ TaskStatus MeshBoundaryValuesFC::InitFluxRecv(const int nvars) {
 
   // Initialize communications of fluxes
   bool no_errors=true;
+  std::vector<CoalescedEntry> clist;
   for (int m=0; m<nmb; ++m) {
     for (int n=0; n<nnghbr; ++n) {
       // only post receives for neighbors on FACES and EDGES at FINER and SAME levels
@@ -1069,16 +1087,27 @@ TaskStatus MeshBoundaryValuesFC::InitFluxRecv(const int nvars) {
           } else if ( nghbr.h_view(m,n).lev == pmy_pack->pmb->mb_lev.h_view(m) ) {
             data_size *= recvbuf[n].iflxs_ndat;
           }
-          auto recv_ptr = Kokkos::subview(recvbuf[n].flux, m, Kokkos::ALL);
+          // with coalesced messages, just record buffer in list
+          if (coalesce_mpi_) {
+            clist.push_back({drank, tag, m, n, 0, data_size});
+            continue;
+          }
+          auto recv_ptr = Kokkos::subview(recvbuf[n].flux_mpi, m, Kokkos::ALL);
 
           // Post non-blocking receive for this buffer on this MeshBlock
           int ierr = MPI_Irecv(recv_ptr.data(), data_size, MPI_ATHENA_REAL, drank, tag,
                                comm_flux, &(recvbuf[n].flux_req[m]));
+          pmy_pack->pmesh->ccounter.Tally(drank, false, data_size*sizeof(Real));
           if (ierr != MPI_SUCCESS) {no_errors=false;}
         }
       }
     }
   }
+  // Post one receive from each neighboring rank for coalesced messages
+  if (coalesce_mpi_) {
+    if (CoalescedIsStale(crecv_flux_, nvars)) {BuildCoalesced(crecv_flux_, clist, nvars);}
+    PostCoalescedRecv(crecv_flux_, comm_flux);
+  }
   // Quit if MPI error detected
   if (!(no_errors)) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
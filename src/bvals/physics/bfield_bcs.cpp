@@ -19,273 +19,289 @@
 
 void MeshBoundaryValues::BFieldBCs(MeshBlockPack *ppack, DualArray2D<Real> b_in,
                                DvceFaceFld4D<Real> b0) {
-  // loop over all MeshBlocks in this MeshBlockPack
   auto &pm = ppack->pmesh;
   auto &indcs = ppack->pmesh->mb_indcs;
   int &ng = indcs.ng;
   auto &mb_bcs = ppack->pmb->mb_bcs;
+  auto &phys_mb = ppack->pmb->phys_mb;
+  int nmb_phys = ppack->pmb->nmb_phys;
+  if (nmb_phys == 0) return;
 
   int n1 = indcs.nx1 + 2*ng;
   int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng) : 1;
   int n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng) : 1;
-  int nmb = ppack->nmb_thispack;
+  int &is = indcs.is, &ie = indcs.ie;
+  int &js = indcs.js, &je = indcs.je;
+  int &ks = indcs.ks, &ke = indcs.ke;
+  // parity of normal (bn) and tangential (bt) components at reflecting boundaries, for
+  // B reflected as a vector (default), or as a pseudovector (e.g. a dipole field in a
+  // domain with equatorial symmetry)
+  const Real bn = (pm->reflect_b_pseudovector)? 1.0 : -1.0;
+  const Real bt = -bn;
 
-  // only apply BCs if not periodic
-  if (pm->mesh_bcs[BoundaryFace::inner_x1] != BoundaryFlag::periodic) {
-    int &is = indcs.is;
-    int &ie = indcs.ie;
-    par_for("bfield-bc_x1", DevExeSpace(), 0,(nmb-1),0,(n3-1),0,(n2-1),
-    KOKKOS_LAMBDA(int m, int k, int j) {
-      // apply physical boundaries to inner_x1
-      switch (mb_bcs.d_view(m,BoundaryFace::inner_x1)) {
-        case BoundaryFlag::reflect:
-          for (int i=0; i<ng; ++i) {
-            b0.x1f(m,k,j,is-i-1) = -b0.x1f(m,k,j,is+i+1);
-            b0.x2f(m,k,j,is-i-1) =  b0.x2f(m,k,j,is+i);
-            if (j == n2-1) {b0.x2f(m,k,j+1,is-i-1) = b0.x2f(m,k,j+1,is+i);}
-            b0.x3f(m,k,j,is-i-1) =  b0.x3f(m,k,j,is+i);
-            if (k == n3-1) {b0.x3f(m,k+1,j,is-i-1) = b0.x3f(m,k+1,j,is+i);}
-          }
-          break;
-        case BoundaryFlag::outflow:
-        case BoundaryFlag::diode:
-        case BoundaryFlag::vacuum:
-          for (int i=0; i<ng; ++i) {
-            b0.x1f(m,k,j,is-i-1) = b0.x1f(m,k,j,is);
-            b0.x2f(m,k,j,is-i-1) = b0.x2f(m,k,j,is);
-            if (j == n2-1) {b0.x2f(m,k,j+1,is-i-1) = b0.x2f(m,k,j+1,is);}
-            b0.x3f(m,k,j,is-i-1) = b0.x3f(m,k,j,is);
-            if (k == n3-1) {b0.x3f(m,k+1,j,is-i-1) = b0.x3f(m,k+1,j,is);}
-          }
-          break;
-        case BoundaryFlag::inflow:
-          for (int i=0; i<ng; ++i) {
-            b0.x1f(m,k,j,is-i-1) = b_in.d_view(IBX,BoundaryFace::inner_x1);
-            b0.x2f(m,k,j,is-i-1) = b_in.d_view(IBY,BoundaryFace::inner_x1);
-            if (j == n2-1) {
-              b0.x2f(m,k,j+1,is-i-1) = b_in.d_view(IBY,BoundaryFace::inner_x1);
+  // Single kernel over all MBs with physical boundaries, with x1 faces set before x2
+  // faces before x3 faces, so edges and corners of the ghost zones are filled in the
+  // same order as with a separate kernel for each direction.
+  par_for_outer("bfield-bc", DevExeSpace(), 0, 0, 0, (nmb_phys-1),
+  KOKKOS_LAMBDA(TeamMember_t member, const int p) {
+    const int m = phys_mb.d_view(p,0);
+    const int faces = phys_mb.d_view(p,1);
+
+    // apply physical boundaries to x1 faces
+    if (faces & 3) {
+      par_for_inner(member, 0, (n3*n2-1), [&](const int idx) {
+        const int k = idx/n2;
+        const int j = idx - k*n2;
+        // apply physical boundaries to inner_x1
+        switch (mb_bcs.d_view(m,BoundaryFace::inner_x1)) {
+          case BoundaryFlag::reflect:
+            for (int i=0; i<ng; ++i) {
+              b0.x1f(m,k,j,is-i-1) = bn*b0.x1f(m,k,j,is+i+1);
+              b0.x2f(m,k,j,is-i-1) = bt*b0.x2f(m,k,j,is+i);
+              if (j == n2-1) {b0.x2f(m,k,j+1,is-i-1) = bt*b0.x2f(m,k,j+1,is+i);}
+              b0.x3f(m,k,j,is-i-1) = bt*b0.x3f(m,k,j,is+i);
+              if (k == n3-1) {b0.x3f(m,k+1,j,is-i-1) = bt*b0.x3f(m,k+1,j,is+i);}
+            }
+            break;
+          case BoundaryFlag::outflow:
+          case BoundaryFlag::diode:
+          case BoundaryFlag::vacuum:
+            for (int i=0; i<ng; ++i) {
+              b0.x1f(m,k,j,is-i-1) = b0.x1f(m,k,j,is);
+              b0.x2f(m,k,j,is-i-1) = b0.x2f(m,k,j,is);
+              if (j == n2-1) {b0.x2f(m,k,j+1,is-i-1) = b0.x2f(m,k,j+1,is);}
+              b0.x3f(m,k,j,is-i-1) = b0.x3f(m,k,j,is);
+              if (k == n3-1) {b0.x3f(m,k+1,j,is-i-1) = b0.x3f(m,k+1,j,is);}
             }
-            b0.x3f(m,k,j,is-i-1) = b_in.d_view(IBZ,BoundaryFace::inner_x1);
-            if (k == n3-1) {
-              b0.x3f(m,k+1,j,is-i-1) = b_in.d_view(IBZ,BoundaryFace::inner_x1);
+            break;
+          case BoundaryFlag::inflow:
+            for (int i=0; i<ng; ++i) {
+              b0.x1f(m,k,j,is-i-1) = b_in.d_view(IBX,BoundaryFace::inner_x1);
+              b0.x2f(m,k,j,is-i-1) = b_in.d_view(IBY,BoundaryFace::inner_x1);
+              if (j == n2-1) {
+                b0.x2f(m,k,j+1,is-i-1) = b_in.d_view(IBY,BoundaryFace::inner_x1);
+              }
+              b0.x3f(m,k,j,is-i-1) = b_in.d_view(IBZ,BoundaryFace::inner_x1);
+              if (k == n3-1) {
+                b0.x3f(m,k+1,j,is-i-1) = b_in.d_view(IBZ,BoundaryFace::inner_x1);
+              }
             }
-          }
-          break;
-        default:
-          break;
-      }
+            break;
+          default:
+            break;
+        }
 
-      // apply physical boundaries to outer_x1
-      switch (mb_bcs.d_view(m,BoundaryFace::outer_x1)) {
-        case BoundaryFlag::reflect:
-          for (int i=0; i<ng; ++i) {
-            b0.x1f(m,k,j,ie+i+2) = -b0.x1f(m,k,j,ie-i);
-            b0.x2f(m,k,j,ie+i+1) =  b0.x2f(m,k,j,ie-i);
-            if (j == n2-1) {b0.x2f(m,k,j+1,ie+i+1) = b0.x2f(m,k,j+1,ie-i);}
-            b0.x3f(m,k,j,ie+i+1) =  b0.x3f(m,k,j,ie-i);
-            if (k == n3-1) {b0.x3f(m,k+1,j,ie+i+1) = b0.x3f(m,k+1,j,ie-i);}
-          }
-          break;
-        case BoundaryFlag::outflow:
-        case BoundaryFlag::diode:
-        case BoundaryFlag::vacuum:
-          for (int i=0; i<ng; ++i) {
-            b0.x1f(m,k,j,ie+i+2) = b0.x1f(m,k,j,ie+1);
-            b0.x2f(m,k,j,ie+i+1) = b0.x2f(m,k,j,ie);
-            if (j == n2-1) {b0.x2f(m,k,j+1,ie+i+1) = b0.x2f(m,k,j+1,ie);}
-            b0.x3f(m,k,j,ie+i+1) = b0.x3f(m,k,j,ie);
-            if (k == n3-1) {b0.x3f(m,k+1,j,ie+i+1) = b0.x3f(m,k+1,j,ie);}
-          }
-          break;
-        case BoundaryFlag::inflow:
-          for (int i=0; i<ng; ++i) {
-            b0.x1f(m,k,j,ie+i+2) = b_in.d_view(IBX,BoundaryFace::outer_x1);
-            b0.x2f(m,k,j,ie+i+1) = b_in.d_view(IBY,BoundaryFace::outer_x1);
-            if (j == n2-1) {
-              b0.x2f(m,k,j+1,ie+i+1) = b_in.d_view(IBY,BoundaryFace::outer_x1);
+        // apply physical boundaries to outer_x1
+        switch (mb_bcs.d_view(m,BoundaryFace::outer_x1)) {
+          case BoundaryFlag::reflect:
+            for (int i=0; i<ng; ++i) {
+              b0.x1f(m,k,j,ie+i+2) = bn*b0.x1f(m,k,j,ie-i);
+              b0.x2f(m,k,j,ie+i+1) = bt*b0.x2f(m,k,j,ie-i);
+              if (j == n2-1) {b0.x2f(m,k,j+1,ie+i+1) = bt*b0.x2f(m,k,j+1,ie-i);}
+              b0.x3f(m,k,j,ie+i+1) = bt*b0.x3f(m,k,j,ie-i);
+              if (k == n3-1) {b0.x3f(m,k+1,j,ie+i+1) = bt*b0.x3f(m,k+1,j,ie-i);}
             }
-            b0.x3f(m,k,j,ie+i+1) = b_in.d_view(IBZ,BoundaryFace::outer_x1);
-            if (k == n3-1) {
-              b0.x3f(m,k+1,j,ie+i+1) = b_in.d_view(IBZ,BoundaryFace::outer_x1);
+            break;
+          case BoundaryFlag::outflow:
+          case BoundaryFlag::diode:
+          case BoundaryFlag::vacuum:
+            for (int i=0; i<ng; ++i) {
+              b0.x1f(m,k,j,ie+i+2) = b0.x1f(m,k,j,ie+1);
+              b0.x2f(m,k,j,ie+i+1) = b0.x2f(m,k,j,ie);
+              if (j == n2-1) {b0.x2f(m,k,j+1,ie+i+1) = b0.x2f(m,k,j+1,ie);}
+              b0.x3f(m,k,j,ie+i+1) = b0.x3f(m,k,j,ie);
+              if (k == n3-1) {b0.x3f(m,k+1,j,ie+i+1) = b0.x3f(m,k+1,j,ie);}
             }
-          }
-          break;
-        default:
-          break;
-      }
-    });
-  }
-  if (pm->one_d) return;
+            break;
+          case BoundaryFlag::inflow:
+            for (int i=0; i<ng; ++i) {
+              b0.x1f(m,k,j,ie+i+2) = b_in.d_view(IBX,BoundaryFace::outer_x1);
+              b0.x2f(m,k,j,ie+i+1) = b_in.d_view(IBY,BoundaryFace::outer_x1);
+              if (j == n2-1) {
+                b0.x2f(m,k,j+1,ie+i+1) = b_in.d_view(IBY,BoundaryFace::outer_x1);
+              }
+              b0.x3f(m,k,j,ie+i+1) = b_in.d_view(IBZ,BoundaryFace::outer_x1);
+              if (k == n3-1) {
+                b0.x3f(m,k+1,j,ie+i+1) = b_in.d_view(IBZ,BoundaryFace::outer_x1);
+              }
+            }
+            break;
+          default:
+            break;
+        }
+      });
+    }
+    member.team_barrier();
 
-  // only apply BCs if not periodic
-  if (pm->mesh_bcs[BoundaryFace::inner_x2] != BoundaryFlag::periodic) {
-    int &js = indcs.js;
-    int &je = indcs.je;
-    par_for("bfield-bc_x2", DevExeSpace(), 0,(nmb-1),0,(n3-1),0,(n1-1),
-    KOKKOS_LAMBDA(int m, int k, int i) {
-      // apply physical boundaries to inner_x2
-      switch (mb_bcs.d_view(m,BoundaryFace::inner_x2)) {
-        case BoundaryFlag::reflect:
-          for (int j=0; j<ng; ++j) {
-            b0.x1f(m,k,js-j-1,i) =  b0.x1f(m,k,js+j,i);
-            if (i == n1-1) {b0.x1f(m,k,js-j-1,i+1) = b0.x1f(m,k,js+j,i+1);}
-            b0.x2f(m,k,js-j-1,i) = -b0.x2f(m,k,js+j+1,i);
-            b0.x3f(m,k,js-j-1,i) =  b0.x3f(m,k,js+j,i);
-            if (k == n3-1) {b0.x3f(m,k+1,js-j-1,i) = b0.x3f(m,k+1,js+j,i);}
-          }
-          break;
-        case BoundaryFlag::outflow:
-        case BoundaryFlag::diode:
-        case BoundaryFlag::vacuum:
-          for (int j=0; j<ng; ++j) {
-            b0.x1f(m,k,js-j-1,i) = b0.x1f(m,k,js,i);
-            if (i == n1-1) {b0.x1f(m,k,js-j-1,i+1) = b0.x1f(m,k,js,i+1);}
-            b0.x2f(m,k,js-j-1,i) = b0.x2f(m,k,js,i);
-            b0.x3f(m,k,js-j-1,i) = b0.x3f(m,k,js,i);
-            if (k == n3-1) {b0.x3f(m,k+1,js-j-1,i) = b0.x3f(m,k+1,js,i);}
-          }
-          break;
-        case BoundaryFlag::inflow:
-          for (int j=0; j<ng; ++j) {
-            b0.x1f(m,k,js-j-1,i) = b_in.d_view(IBX,BoundaryFace::inner_x2);
-            if (i == n1-1) {
-              b0.x1f(m,k,js-j-1,i+1) = b_in.d_view(IBX,BoundaryFace::inner_x2);
+    // apply physical boundaries to x2 faces
+    if (faces & 12) {
+      par_for_inner(member, 0, (n3*n1-1), [&](const int idx) {
+        const int k = idx/n1;
+        const int i = idx - k*n1;
+        // apply physical boundaries to inner_x2
+        switch (mb_bcs.d_view(m,BoundaryFace::inner_x2)) {
+          case BoundaryFlag::reflect:
+            for (int j=0; j<ng; ++j) {
+              b0.x1f(m,k,js-j-1,i) = bt*b0.x1f(m,k,js+j,i);
+              if (i == n1-1) {b0.x1f(m,k,js-j-1,i+1) = bt*b0.x1f(m,k,js+j,i+1);}
+              b0.x2f(m,k,js-j-1,i) = bn*b0.x2f(m,k,js+j+1,i);
+              b0.x3f(m,k,js-j-1,i) = bt*b0.x3f(m,k,js+j,i);
+              if (k == n3-1) {b0.x3f(m,k+1,js-j-1,i) = bt*b0.x3f(m,k+1,js+j,i);}
+            }
+            break;
+          case BoundaryFlag::outflow:
+          case BoundaryFlag::diode:
+          case BoundaryFlag::vacuum:
+            for (int j=0; j<ng; ++j) {
+              b0.x1f(m,k,js-j-1,i) = b0.x1f(m,k,js,i);
+              if (i == n1-1) {b0.x1f(m,k,js-j-1,i+1) = b0.x1f(m,k,js,i+1);}
+              b0.x2f(m,k,js-j-1,i) = b0.x2f(m,k,js,i);
+              b0.x3f(m,k,js-j-1,i) = b0.x3f(m,k,js,i);
+              if (k == n3-1) {b0.x3f(m,k+1,js-j-1,i) = b0.x3f(m,k+1,js,i);}
             }
-            b0.x2f(m,k,js-j-1,i) = b_in.d_view(IBY,BoundaryFace::inner_x2);
-            b0.x3f(m,k,js-j-1,i) = b_in.d_view(IBZ,BoundaryFace::inner_x2);
-            if (k == n3-1) {
-              b0.x3f(m,k+1,js-j-1,i) = b_in.d_view(IBZ,BoundaryFace::inner_x2);
+            break;
+          case BoundaryFlag::inflow:
+            for (int j=0; j<ng; ++j) {
+              b0.x1f(m,k,js-j-1,i) = b_in.d_view(IBX,BoundaryFace::inner_x2);
+              if (i == n1-1) {
+                b0.x1f(m,k,js-j-1,i+1) = b_in.d_view(IBX,BoundaryFace::inner_x2);
+              }
+              b0.x2f(m,k,js-j-1,i) = b_in.d_view(IBY,BoundaryFace::inner_x2);
+              b0.x3f(m,k,js-j-1,i) = b_in.d_view(IBZ,BoundaryFace::inner_x2);
+              if (k == n3-1) {
+                b0.x3f(m,k+1,js-j-1,i) = b_in.d_view(IBZ,BoundaryFace::inner_x2);
+              }
             }
-          }
-          break;
-        default:
-          break;
-      }
+            break;
+          default:
+            break;
+        }
 
-      // apply physical boundaries to outer_x2
-      switch (mb_bcs.d_view(m,BoundaryFace::outer_x2)) {
-        case BoundaryFlag::reflect:
-          for (int j=0; j<ng; ++j) {
-            b0.x1f(m,k,je+j+1,i) =  b0.x1f(m,k,je-j,i);
-            if (i == n1-1) {b0.x1f(m,k,je+j+1,i+1) = b0.x1f(m,k,je-j,i+1);}
-            b0.x2f(m,k,je+j+2,i) = -b0.x2f(m,k,je-j,i);
-            b0.x3f(m,k,je+j+1,i) =  b0.x3f(m,k,je-j,i);
-            if (k == n3-1) {b0.x3f(m,k+1,je+j+1,i) = b0.x3f(m,k+1,je-j,i);}
-          }
-          break;
-        case BoundaryFlag::outflow:
-        case BoundaryFlag::diode:
-        case BoundaryFlag::vacuum:
-          for (int j=0; j<ng; ++j) {
-            b0.x1f(m,k,je+j+1,i) = b0.x1f(m,k,je,i);
-            if (i == n1-1) {b0.x1f(m,k,je+j+1,i+1) = b0.x1f(m,k,je,i+1);}
-            b0.x2f(m,k,je+j+2,i) = b0.x2f(m,k,je+1,i);
-            b0.x3f(m,k,je+j+1,i) = b0.x3f(m,k,je,i);
-            if (k == n3-1) {b0.x3f(m,k+1,je+j+1,i) = b0.x3f(m,k+1,je,i);}
-          }
-          break;
-        case BoundaryFlag::inflow:
-          for (int j=0; j<ng; ++j) {
-            b0.x1f(m,k,je+j+1,i) = b_in.d_view(IBX,BoundaryFace::outer_x2);
-            if (i == n1-1) {
-              b0.x1f(m,k,je+j+1,i+1) = b_in.d_view(IBX,BoundaryFace::outer_x2);
+        // apply physical boundaries to outer_x2
+        switch (mb_bcs.d_view(m,BoundaryFace::outer_x2)) {
+          case BoundaryFlag::reflect:
+            for (int j=0; j<ng; ++j) {
+              b0.x1f(m,k,je+j+1,i) = bt*b0.x1f(m,k,je-j,i);
+              if (i == n1-1) {b0.x1f(m,k,je+j+1,i+1) = bt*b0.x1f(m,k,je-j,i+1);}
+              b0.x2f(m,k,je+j+2,i) = bn*b0.x2f(m,k,je-j,i);
+              b0.x3f(m,k,je+j+1,i) = bt*b0.x3f(m,k,je-j,i);
+              if (k == n3-1) {b0.x3f(m,k+1,je+j+1,i) = bt*b0.x3f(m,k+1,je-j,i);}
             }
-            b0.x2f(m,k,je+j+2,i) = b_in.d_view(IBY,BoundaryFace::outer_x2);
-            b0.x3f(m,k,je+j+1,i) = b_in.d_view(IBZ,BoundaryFace::outer_x2);
-            if (k == n3-1) {
-              b0.x3f(m,k+1,je+j+1,i) = b_in.d_view(IBZ,BoundaryFace::outer_x2);
+            break;
+          case BoundaryFlag::outflow:
+          case BoundaryFlag::diode:
+          case BoundaryFlag::vacuum:
+            for (int j=0; j<ng; ++j) {
+              b0.x1f(m,k,je+j+1,i) = b0.x1f(m,k,je,i);
+              if (i == n1-1) {b0.x1f(m,k,je+j+1,i+1) = b0.x1f(m,k,je,i+1);}
+              b0.x2f(m,k,je+j+2,i) = b0.x2f(m,k,je+1,i);
+              b0.x3f(m,k,je+j+1,i) = b0.x3f(m,k,je,i);
+              if (k == n3-1) {b0.x3f(m,k+1,je+j+1,i) = b0.x3f(m,k+1,je,i);}
             }
-          }
-          break;
-        default:
-          break;
-      }
-    });
-  }
-  if (pm->two_d) return;
-
-  // only apply BCs if not periodic
-  if (pm->mesh_bcs[BoundaryFace::inner_x3] == BoundaryFlag::periodic) return;
-  int &ks = indcs.ks;
-  int &ke = indcs.ke;
-  par_for("bfield-bc_x3", DevExeSpace(), 0,(nmb-1),0,(n2-1),0,(n1-1),
-  KOKKOS_LAMBDA(int m, int j, int i) {
-    // apply physical boundaries to inner_x3
-    switch (mb_bcs.d_view(m,BoundaryFace::inner_x3)) {
-      case BoundaryFlag::reflect:
-        for (int k=0; k<ng; ++k) {
-          b0.x1f(m,ks-k-1,j,i) =  b0.x1f(m,ks+k,j,i);
-          if (i == n1-1) {b0.x1f(m,ks-k-1,j,i+1) = b0.x1f(m,ks+k,j,i+1);}
-          b0.x2f(m,ks-k-1,j,i) =  b0.x2f(m,ks+k,j,i);
-          if (j == n2-1) {b0.x2f(m,ks-k-1,j+1,i) = b0.x2f(m,ks+k,j+1,i);}
-          b0.x3f(m,ks-k-1,j,i) = -b0.x3f(m,ks+k+1,j,i);
-        }
-        break;
-      case BoundaryFlag::outflow:
-      case BoundaryFlag::diode:
-      case BoundaryFlag::vacuum:
-        for (int k=0; k<ng; ++k) {
-          b0.x1f(m,ks-k-1,j,i) = b0.x1f(m,ks,j,i);
-          if (i == n1-1) {b0.x1f(m,ks-k-1,j,i+1) = b0.x1f(m,ks,j,i+1);}
-          b0.x2f(m,ks-k-1,j,i) = b0.x2f(m,ks,j,i);
-          if (j == n2-1) {b0.x2f(m,ks-k-1,j+1,i) = b0.x2f(m,ks,j+1,i);}
-          b0.x3f(m,ks-k-1,j,i) = b0.x3f(m,ks,j,i);
-        }
-        break;
-      case BoundaryFlag::inflow:
-        for (int k=0; k<ng; ++k) {
-          b0.x1f(m,ks-k-1,j,i) = b_in.d_view(IBX,BoundaryFace::inner_x3);
-          if (i == n1-1) {
-            b0.x1f(m,ks-k-1,j,i+1) = b_in.d_view(IBX,BoundaryFace::inner_x3);
-          }
-          b0.x2f(m,ks-k-1,j,i) = b_in.d_view(IBY,BoundaryFace::inner_x3);
-          if (j == n2-1) {
-            b0.x2f(m,ks-k-1,j+1,i) = b_in.d_view(IBY,BoundaryFace::inner_x3);
-          }
-          b0.x3f(m,ks-k-1,j,i) = b_in.d_view(IBZ,BoundaryFace::inner_x3);
+            break;
+          case BoundaryFlag::inflow:
+            for (int j=0; j<ng; ++j) {
+              b0.x1f(m,k,je+j+1,i) = b_in.d_view(IBX,BoundaryFace::outer_x2);
+              if (i == n1-1) {
+                b0.x1f(m,k,je+j+1,i+1) = b_in.d_view(IBX,BoundaryFace::outer_x2);
+              }
+              b0.x2f(m,k,je+j+2,i) = b_in.d_view(IBY,BoundaryFace::outer_x2);
+              b0.x3f(m,k,je+j+1,i) = b_in.d_view(IBZ,BoundaryFace::outer_x2);
+              if (k == n3-1) {
+                b0.x3f(m,k+1,je+j+1,i) = b_in.d_view(IBZ,BoundaryFace::outer_x2);
+              }
+            }
+            break;
+          default:
+            break;
         }
-        break;
-      default:
-        break;
+      });
     }
+    member.team_barrier();
 
-    // apply physical boundaries to outer_x3
-    switch (mb_bcs.d_view(m,BoundaryFace::outer_x3)) {
-      case BoundaryFlag::reflect:
-        for (int k=0; k<ng; ++k) {
-          b0.x1f(m,ke+k+1,j,i) =  b0.x1f(m,ke-k,j,i);
-          if (i == n1-1) {b0.x1f(m,ke+k+1,j,i+1) = b0.x1f(m,ke-k,j,i+1);}
-          b0.x2f(m,ke+k+1,j,i) =  b0.x2f(m,ke-k,j,i);
-          if (j == n2-1) {b0.x2f(m,ke+k+1,j+1,i) = b0.x2f(m,ke-k,j+1,i);}
-          b0.x3f(m,ke+k+2,j,i) = -b0.x3f(m,ke-k,j,i);
-        }
-        break;
-      case BoundaryFlag::outflow:
-      case BoundaryFlag::diode:
-      case BoundaryFlag::vacuum:
-        for (int k=0; k<ng; ++k) {
-          b0.x1f(m,ke+k+1,j,i) = b0.x1f(m,ke,j,i);
-          if (i == n1-1) {b0.x1f(m,ke+k+1,j,i+1) = b0.x1f(m,ke,j,i+1);}
-          b0.x2f(m,ke+k+1,j,i) = b0.x2f(m,ke,j,i);
-          if (j == n2-1) {b0.x2f(m,ke+k+1,j+1,i) = b0.x2f(m,ke,j+1,i);}
-          b0.x3f(m,ke+k+2,j,i) = b0.x3f(m,ke+1,j,i);
+    // apply physical boundaries to x3 faces
+    if (faces & 48) {
+      par_for_inner(member, 0, (n2*n1-1), [&](const int idx) {
+        const int j = idx/n1;
+        const int i = idx - j*n1;
+        // apply physical boundaries to inner_x3
+        switch (mb_bcs.d_view(m,BoundaryFace::inner_x3)) {
+          case BoundaryFlag::reflect:
+            for (int k=0; k<ng; ++k) {
+              b0.x1f(m,ks-k-1,j,i) = bt*b0.x1f(m,ks+k,j,i);
+              if (i == n1-1) {b0.x1f(m,ks-k-1,j,i+1) = bt*b0.x1f(m,ks+k,j,i+1);}
+              b0.x2f(m,ks-k-1,j,i) = bt*b0.x2f(m,ks+k,j,i);
+              if (j == n2-1) {b0.x2f(m,ks-k-1,j+1,i) = bt*b0.x2f(m,ks+k,j+1,i);}
+              b0.x3f(m,ks-k-1,j,i) = bn*b0.x3f(m,ks+k+1,j,i);
+            }
+            break;
+          case BoundaryFlag::outflow:
+          case BoundaryFlag::diode:
+          case BoundaryFlag::vacuum:
+            for (int k=0; k<ng; ++k) {
+              b0.x1f(m,ks-k-1,j,i) = b0.x1f(m,ks,j,i);
+              if (i == n1-1) {b0.x1f(m,ks-k-1,j,i+1) = b0.x1f(m,ks,j,i+1);}
+              b0.x2f(m,ks-k-1,j,i) = b0.x2f(m,ks,j,i);
+              if (j == n2-1) {b0.x2f(m,ks-k-1,j+1,i) = b0.x2f(m,ks,j+1,i);}
+              b0.x3f(m,ks-k-1,j,i) = b0.x3f(m,ks,j,i);
+            }
+            break;
+          case BoundaryFlag::inflow:
+            for (int k=0; k<ng; ++k) {
+              b0.x1f(m,ks-k-1,j,i) = b_in.d_view(IBX,BoundaryFace::inner_x3);
+              if (i == n1-1) {
+                b0.x1f(m,ks-k-1,j,i+1) = b_in.d_view(IBX,BoundaryFace::inner_x3);
+              }
+              b0.x2f(m,ks-k-1,j,i) = b_in.d_view(IBY,BoundaryFace::inner_x3);
+              if (j == n2-1) {
+                b0.x2f(m,ks-k-1,j+1,i) = b_in.d_view(IBY,BoundaryFace::inner_x3);
+              }
+              b0.x3f(m,ks-k-1,j,i) = b_in.d_view(IBZ,BoundaryFace::inner_x3);
+            }
+            break;
+          default:
+            break;
         }
-        break;
-      case BoundaryFlag::inflow:
-        for (int k=0; k<ng; ++k) {
-          b0.x1f(m,ke+k+1,j,i) = b_in.d_view(IBX,BoundaryFace::outer_x3);
-          if (i == n1-1) {
-            b0.x1f(m,ke+k+1,j,i+1) = b_in.d_view(IBX,BoundaryFace::outer_x3);
-          }
-          b0.x2f(m,ke+k+1,j,i) = b_in.d_view(IBY,BoundaryFace::outer_x3);
-          if (j == n2-1) {
-            b0.x2f(m,ke+k+1,j+1,i) = b_in.d_view(IBY,BoundaryFace::outer_x3);
-          }
-          b0.x3f(m,ke+k+2,j,i) = b_in.d_view(IBZ,BoundaryFace::outer_x3);
+
+        // apply physical boundaries to outer_x3
+        switch (mb_bcs.d_view(m,BoundaryFace::outer_x3)) {
+          case BoundaryFlag::reflect:
+            for (int k=0; k<ng; ++k) {
+              b0.x1f(m,ke+k+1,j,i) = bt*b0.x1f(m,ke-k,j,i);
+              if (i == n1-1) {b0.x1f(m,ke+k+1,j,i+1) = bt*b0.x1f(m,ke-k,j,i+1);}
+              b0.x2f(m,ke+k+1,j,i) = bt*b0.x2f(m,ke-k,j,i);
+              if (j == n2-1) {b0.x2f(m,ke+k+1,j+1,i) = bt*b0.x2f(m,ke-k,j+1,i);}
+              b0.x3f(m,ke+k+2,j,i) = bn*b0.x3f(m,ke-k,j,i);
+            }
+            break;
+          case BoundaryFlag::outflow:
+          case BoundaryFlag::diode:
+          case BoundaryFlag::vacuum:
+            for (int k=0; k<ng; ++k) {
+              b0.x1f(m,ke+k+1,j,i) = b0.x1f(m,ke,j,i);
+              if (i == n1-1) {b0.x1f(m,ke+k+1,j,i+1) = b0.x1f(m,ke,j,i+1);}
+              b0.x2f(m,ke+k+1,j,i) = b0.x2f(m,ke,j,i);
+              if (j == n2-1) {b0.x2f(m,ke+k+1,j+1,i) = b0.x2f(m,ke,j+1,i);}
+              b0.x3f(m,ke+k+2,j,i) = b0.x3f(m,ke+1,j,i);
+            }
+            break;
+          case BoundaryFlag::inflow:
+            for (int k=0; k<ng; ++k) {
+              b0.x1f(m,ke+k+1,j,i) = b_in.d_view(IBX,BoundaryFace::outer_x3);
+              if (i == n1-1) {
+                b0.x1f(m,ke+k+1,j,i+1) = b_in.d_view(IBX,BoundaryFace::outer_x3);
+              }
+              b0.x2f(m,ke+k+1,j,i) = b_in.d_view(IBY,BoundaryFace::outer_x3);
+              if (j == n2-1) {
+                b0.x2f(m,ke+k+1,j+1,i) = b_in.d_view(IBY,BoundaryFace::outer_x3);
+              }
+              b0.x3f(m,ke+k+2,j,i) = b_in.d_view(IBZ,BoundaryFace::outer_x3);
+            }
+            break;
+          default:
+            break;
         }
-        break;
-      default:
-        break;
+      });
     }
   });
 
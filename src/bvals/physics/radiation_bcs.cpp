@@ -18,137 +18,147 @@
 //! are at the edge of the computational domain
 
 void MeshBoundaryValues::RadiationBCs(MeshBlockPack *ppack, DualArray2D<Real> i_in,
-                                      DvceArray5D<Real> i0) {
-  // loop over all MeshBlocks in this MeshBlockPack
-  auto &pm = ppack->pmesh;
+                                      DvceArray5D<RadReal> i0) {
   auto &indcs = ppack->pmesh->mb_indcs;
   int &ng = indcs.ng;
   auto &mb_bcs = ppack->pmb->mb_bcs;
+  auto &phys_mb = ppack->pmb->phys_mb;
+  int nmb_phys = ppack->pmb->nmb_phys;
+  if (nmb_phys == 0) return;
 
   int n1 = indcs.nx1 + 2*ng;
   int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng) : 1;
   int n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng) : 1;
   int nvar = i0.extent_int(1);  // TODO(@user): 2nd index from L of in array must be NVAR
-  int nmb = ppack->nmb_thispack;
+  int &is = indcs.is, &ie = indcs.ie;
+  int &js = indcs.js, &je = indcs.je;
+  int &ks = indcs.ks, &ke = indcs.ke;
 
-  // only apply BCs if not periodic
-  if (pm->mesh_bcs[BoundaryFace::inner_x1] != BoundaryFlag::periodic) {
-    int &is = indcs.is;
-    int &ie = indcs.ie;
-    par_for("radiationbc_x1", DevExeSpace(), 0,(nmb-1),0,(nvar-1),0,(n3-1),0,(n2-1),
-    KOKKOS_LAMBDA(int m, int n, int k, int j) {
-      // apply physical boundaries to inner_x1
-      switch (mb_bcs.d_view(m,BoundaryFace::inner_x1)) {
-        case BoundaryFlag::outflow:
-          for (int i=0; i<ng; ++i) {
-            i0(m,n,k,j,is-i-1) = i0(m,n,k,j,is);
-          }
-          break;
-        case BoundaryFlag::inflow:
-          for (int i=0; i<ng; ++i) {
-            i0(m,n,k,j,is-i-1) = i_in.d_view(n,BoundaryFace::inner_x1);
-          }
-          break;
-        default:
-          break;
-      }
+  // Single kernel over all MBs with physical boundaries and all variables, with x1 faces
+  // set before x2 faces before x3 faces, so edges and corners of the ghost zones are
+  // filled in the same order as with a separate kernel for each direction.
+  par_for_outer("radiationbc", DevExeSpace(), 0, 0, 0, (nmb_phys-1), 0, (nvar-1),
+  KOKKOS_LAMBDA(TeamMember_t member, const int p, const int n) {
+    const int m = phys_mb.d_view(p,0);
+    const int faces = phys_mb.d_view(p,1);
 
-      // apply physical boundaries to outer_x1
-      switch (mb_bcs.d_view(m,BoundaryFace::outer_x1)) {
-        case BoundaryFlag::outflow:
-          for (int i=0; i<ng; ++i) {
-            i0(m,n,k,j,ie+i+1) = i0(m,n,k,j,ie);
-          }
-          break;
-        case BoundaryFlag::inflow:
-          for (int i=0; i<ng; ++i) {
-            i0(m,n,k,j,ie+i+1) = i_in.d_view(n,BoundaryFace::outer_x1);
-          }
-          break;
-        default:
-          break;
-      }
-    });
-  }
-  if (pm->one_d) return;
-
-  // only apply BCs if not periodic
-  if (pm->mesh_bcs[BoundaryFace::inner_x2] != BoundaryFlag::periodic) {
-    int &js = indcs.js;
-    int &je = indcs.je;
-    par_for("radiationbc_x2", DevExeSpace(), 0,(nmb-1),0,(nvar-1),0,(n3-1),0,(n1-1),
-    KOKKOS_LAMBDA(int m, int n, int k, int i) {
-      // apply physical boundaries to inner_x2
-      switch (mb_bcs.d_view(m,BoundaryFace::inner_x2)) {
-        case BoundaryFlag::outflow:
-          for (int j=0; j<ng; ++j) {
-            i0(m,n,k,js-j-1,i) = i0(m,n,k,js,i);
-          }
-          break;
-        case BoundaryFlag::inflow:
-          for (int j=0; j<ng; ++j) {
-            i0(m,n,k,js-j-1,i) = i_in.d_view(n,BoundaryFace::inner_x2);
-          }
-          break;
-        default:
-          break;
-      }
+    // apply physical boundaries to x1 faces
+    if (faces & 3) {
+      par_for_inner(member, 0, (n3*n2-1), [&](const int idx) {
+        const int k = idx/n2;
+        const int j = idx - k*n2;
+        // apply physical boundaries to inner_x1
+        switch (mb_bcs.d_view(m,BoundaryFace::inner_x1)) {
+          case BoundaryFlag::outflow:
+            for (int i=0; i<ng; ++i) {
+              i0(m,n,k,j,is-i-1) = i0(m,n,k,j,is);
+            }
+            break;
+          case BoundaryFlag::inflow:
+            for (int i=0; i<ng; ++i) {
+              i0(m,n,k,j,is-i-1) = i_in.d_view(n,BoundaryFace::inner_x1);
+            }
+            break;
+          default:
+            break;
+        }
 
-      // apply physical boundaries to outer_x2
-      switch (mb_bcs.d_view(m,BoundaryFace::outer_x2)) {
-        case BoundaryFlag::outflow:
-          for (int j=0; j<ng; ++j) {
-            i0(m,n,k,je+j+1,i) = i0(m,n,k,je,i);
-          }
-          break;
-        case BoundaryFlag::inflow:
-          for (int j=0; j<ng; ++j) {
-            i0(m,n,k,je+j+1,i) = i_in.d_view(n,BoundaryFace::outer_x2);
-          }
-          break;
-        default:
-          break;
-      }
-    });
-  }
-  if (pm->two_d) return;
+        // apply physical boundaries to outer_x1
+        switch (mb_bcs.d_view(m,BoundaryFace::outer_x1)) {
+          case BoundaryFlag::outflow:
+            for (int i=0; i<ng; ++i) {
+              i0(m,n,k,j,ie+i+1) = i0(m,n,k,j,ie);
+            }
+            break;
+          case BoundaryFlag::inflow:
+            for (int i=0; i<ng; ++i) {
+              i0(m,n,k,j,ie+i+1) = i_in.d_view(n,BoundaryFace::outer_x1);
+            }
+            break;
+          default:
+            break;
+        }
+      });
+    }
+    member.team_barrier();
 
-  // only apply BCs if not periodic
-  if (pm->mesh_bcs[BoundaryFace::inner_x3] == BoundaryFlag::periodic) return;
-  int &ks = indcs.ks;
-  int &ke = indcs.ke;
-  par_for("radiationbc_x3", DevExeSpace(), 0,(nmb-1),0,(nvar-1),0,(n2-1),0,(n1-1),
-  KOKKOS_LAMBDA(int m, int n, int j, int i) {
-    // apply physical boundaries to inner_x3
-    switch (mb_bcs.d_view(m,BoundaryFace::inner_x3)) {
-      case BoundaryFlag::outflow:
-        for (int k=0; k<ng; ++k) {
-          i0(m,n,ks-k-1,j,i) = i0(m,n,ks,j,i);
+    // apply physical boundaries to x2 faces
+    if (faces & 12) {
+      par_for_inner(member, 0, (n3*n1-1), [&](const int idx) {
+        const int k = idx/n1;
+        const int i = idx - k*n1;
+        // apply physical boundaries to inner_x2
+        switch (mb_bcs.d_view(m,BoundaryFace::inner_x2)) {
+          case BoundaryFlag::outflow:
+            for (int j=0; j<ng; ++j) {
+              i0(m,n,k,js-j-1,i) = i0(m,n,k,js,i);
+            }
+            break;
+          case BoundaryFlag::inflow:
+            for (int j=0; j<ng; ++j) {
+              i0(m,n,k,js-j-1,i) = i_in.d_view(n,BoundaryFace::inner_x2);
+            }
+            break;
+          default:
+            break;
         }
-        break;
-      case BoundaryFlag::inflow:
-        for (int k=0; k<ng; ++k) {
-          i0(m,n,ks-k-1,j,i) = i_in.d_view(n,BoundaryFace::inner_x3);
+
+        // apply physical boundaries to outer_x2
+        switch (mb_bcs.d_view(m,BoundaryFace::outer_x2)) {
+          case BoundaryFlag::outflow:
+            for (int j=0; j<ng; ++j) {
+              i0(m,n,k,je+j+1,i) = i0(m,n,k,je,i);
+            }
+            break;
+          case BoundaryFlag::inflow:
+            for (int j=0; j<ng; ++j) {
+              i0(m,n,k,je+j+1,i) = i_in.d_view(n,BoundaryFace::outer_x2);
+            }
+            break;
+          default:
+            break;
         }
-        break;
-      default:
-        break;
+      });
     }
+    member.team_barrier();
 
-    // apply physical boundaries to outer_x3
-    switch (mb_bcs.d_view(m,BoundaryFace::outer_x3)) {
-      case BoundaryFlag::outflow:
-        for (int k=0; k<ng; ++k) {
-          i0(m,n,ke+k+1,j,i) = i0(m,n,ke,j,i);
+    // apply physical boundaries to x3 faces
+    if (faces & 48) {
+      par_for_inner(member, 0, (n2*n1-1), [&](const int idx) {
+        const int j = idx/n1;
+        const int i = idx - j*n1;
+        // apply physical boundaries to inner_x3
+        switch (mb_bcs.d_view(m,BoundaryFace::inner_x3)) {
+          case BoundaryFlag::outflow:
+            for (int k=0; k<ng; ++k) {
+              i0(m,n,ks-k-1,j,i) = i0(m,n,ks,j,i);
+            }
+            break;
+          case BoundaryFlag::inflow:
+            for (int k=0; k<ng; ++k) {
+              i0(m,n,ks-k-1,j,i) = i_in.d_view(n,BoundaryFace::inner_x3);
+            }
+            break;
+          default:
+            break;
         }
-        break;
-      case BoundaryFlag::inflow:
-        for (int k=0; k<ng; ++k) {
-          i0(m,n,ke+k+1,j,i) = i_in.d_view(n,BoundaryFace::outer_x3);
+
+        // apply physical boundaries to outer_x3
+        switch (mb_bcs.d_view(m,BoundaryFace::outer_x3)) {
+          case BoundaryFlag::outflow:
+            for (int k=0; k<ng; ++k) {
+              i0(m,n,ke+k+1,j,i) = i0(m,n,ke,j,i);
+            }
+            break;
+          case BoundaryFlag::inflow:
+            for (int k=0; k<ng; ++k) {
+              i0(m,n,ke+k+1,j,i) = i_in.d_view(n,BoundaryFace::outer_x3);
+            }
+            break;
+          default:
+            break;
         }
-        break;
-      default:
-        break;
+      });
     }
   });
 
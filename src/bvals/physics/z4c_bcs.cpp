@@ -16,6 +16,8 @@
 template<int order>
 void BCHelper(MeshBlockPack *ppack, DualArray2D<Real> u_in, DvceArray5D<Real> u0,
               int is, int ie, int js, int je, int ks, int ke, int n1, int n2, int n3);
+void WeylHelper(MeshBlockPack *ppack, DvceArray5D<Real> u,
+                int is, int ie, int js, int je, int ks, int ke, int n1, int n2, int n3);
 
 // A simple function for doing one-sided extrapolation.
 // The off[xyz] variables control the direction of the extrapolation,
@@ -125,219 +127,327 @@ void MeshBoundaryValues::Z4cBCs(MeshBlockPack *ppack, DualArray2D<Real> u_in,
   }
 }
 
-//void BoundaryValues::Z4cBCs(MeshBlockPack *ppack, DualArray2D<Real> u_in,
-//                            DvceArray5D<Real> u0) {
-template<int order>
-void BCHelper(MeshBlockPack *ppack, DualArray2D<Real> u_in, DvceArray5D<Real> u0,
-              int is, int ie, int js, int je, int ks, int ke, int n1, int n2, int n3) {
-  // loop over all MeshBlocks in this MeshBlockPack
+//----------------------------------------------------------------------------------------
+// \!fn void MeshBoundaryValues::WeylBCs()
+// \brief Apply reflecting boundary conditions to the real and imaginary parts of the
+//  Weyl scalar (components 0 and 1 of u_weyl), so that interpolation to spheres near a
+//  plane of symmetry can use the ghost zones.  Under a reflection psi4 is mapped to its
+//  complex conjugate, so the imaginary part is odd.  Other boundaries are not changed.
+void MeshBoundaryValues::WeylBCs(MeshBlockPack *ppack, DvceArray5D<Real> u,
+                                 DvceArray5D<Real> coarse_u) {
   auto &pm = ppack->pmesh;
+  auto &indcs = ppack->pmesh->mb_indcs;
+  int &ng = indcs.ng;
+
+  int n1 = indcs.nx1 + 2*ng;
+  int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng) : 1;
+  int n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng) : 1;
+  WeylHelper(ppack, u, indcs.is, indcs.ie, indcs.js, indcs.je, indcs.ks, indcs.ke,
+             n1, n2, n3);
+  if (pm->multilevel) {
+    int cn1 = indcs.cnx1 + 2*ng;
+    int cn2 = (indcs.cnx2 > 1)? (indcs.cnx2 + 2*ng) : 1;
+    int cn3 = (indcs.cnx3 > 1)? (indcs.cnx3 + 2*ng) : 1;
+    WeylHelper(ppack, coarse_u, indcs.cis, indcs.cie, indcs.cjs, indcs.cje, indcs.cks,
+               indcs.cke, cn1, cn2, cn3);
+  }
+}
+
+void WeylHelper(MeshBlockPack *ppack, DvceArray5D<Real> u,
+                int is, int ie, int js, int je, int ks, int ke, int n1, int n2, int n3) {
   int &ng = ppack->pmesh->mb_indcs.ng;
   auto &mb_bcs = ppack->pmb->mb_bcs;
+  auto &phys_mb = ppack->pmb->phys_mb;
+  int nmb_phys = ppack->pmb->nmb_phys;
+  if (nmb_phys == 0) return;
 
-  int nvar = u0.extent_int(1);  // TODO(@user): 2nd index from L of in array must be NVAR
-  int nmb = ppack->nmb_thispack;
+  // single kernel over all MBs with physical boundaries, see HydroBCs()
+  par_for_outer("weylbc", DevExeSpace(), 0, 0, 0, (nmb_phys-1), 0, 1,
+  KOKKOS_LAMBDA(TeamMember_t member, const int p, const int n) {
+    const int m = phys_mb.d_view(p,0);
+    const int faces = phys_mb.d_view(p,1);
+    Real sign = (n == 1)? -1.0 : 1.0;
 
-  // only apply BCs unless periodic or shear_periodic
-  if (pm->mesh_bcs[BoundaryFace::inner_x1] != BoundaryFlag::periodic
-      && pm->mesh_bcs[BoundaryFace::inner_x1] != BoundaryFlag::shear_periodic) {
-    par_for("z4cbc_x1", DevExeSpace(), 0,(nmb-1),0,(nvar-1),0,(n3-1),0,(n2-1),
-    KOKKOS_LAMBDA(int m, int n, int k, int j) {
-      // apply physical boundaries to inner_x1
-      switch (mb_bcs.d_view(m,BoundaryFace::inner_x1)) {
-        case BoundaryFlag::reflect:
+    // apply physical boundaries to x1 faces
+    if (faces & 3) {
+      par_for_inner(member, 0, (n3*n2-1), [&](const int idx) {
+        const int k = idx/n2;
+        const int j = idx - k*n2;
+        if (mb_bcs.d_view(m,BoundaryFace::inner_x1) == BoundaryFlag::reflect) {
           for (int i=0; i<ng; ++i) {
-            if (n==z4c::Z4c::I_Z4C_GXY || n==z4c::Z4c::I_Z4C_GXZ ||
-                n==z4c::Z4c::I_Z4C_AXY || n==z4c::Z4c::I_Z4C_AXZ ||
-                n==z4c::Z4c::I_Z4C_GAMX || n==z4c::Z4c::I_Z4C_BETAX) {
-              u0(m,n,k,j,is-i-1) = -u0(m,n,k,j,is+i);
-            } else {
-              u0(m,n,k,j,is-i-1) =  u0(m,n,k,j,is+i);
-            }
-          }
-          break;
-        case BoundaryFlag::diode:
-        case BoundaryFlag::outflow:
-        case BoundaryFlag::vacuum:
-          for (int i=0; i<ng; ++i) {
-            //u0(m,n,k,j,is-i-1) = u0(m,n,k,j,is);
-            u0(m,n,k,j,is-i-1) = Extrapolate<order>(u0,m,n,k,j,is,0,0,1,i+1);
+            u(m,n,k,j,is-i-1) = sign*u(m,n,k,j,is+i);
           }
-          break;
-        case BoundaryFlag::inflow:
-          for (int i=0; i<ng; ++i) {
-            u0(m,n,k,j,is-i-1) = u_in.d_view(n,BoundaryFace::inner_x1);
-          }
-          break;
-        default:
-          break;
-      }
-
-      // apply physical boundaries to outer_x1
-      switch (mb_bcs.d_view(m,BoundaryFace::outer_x1)) {
-        case BoundaryFlag::reflect:
-          for (int i=0; i<ng; ++i) {
-            if (n==z4c::Z4c::I_Z4C_GXY || n==z4c::Z4c::I_Z4C_GXZ ||
-                n==z4c::Z4c::I_Z4C_AXY || n==z4c::Z4c::I_Z4C_AXZ ||
-                n==z4c::Z4c::I_Z4C_GAMX || n==z4c::Z4c::I_Z4C_BETAX) {
-              u0(m,n,k,j,ie+i+1) = -u0(m,n,k,j,ie-i);
-            } else {
-              u0(m,n,k,j,ie+i+1) =  u0(m,n,k,j,ie-i);
-            }
-          }
-          break;
-        case BoundaryFlag::diode:
-        case BoundaryFlag::outflow:
-        case BoundaryFlag::vacuum:
-          for (int i=0; i<ng; ++i) {
-            //u0(m,n,k,j,ie+i+1) = u0(m,n,k,j,ie);
-            u0(m,n,k,j,ie+i+1) = Extrapolate<order>(u0,m,n,k,j,ie,0,0,-1,i+1);
-          }
-          break;
-        case BoundaryFlag::inflow:
+        }
+        if (mb_bcs.d_view(m,BoundaryFace::outer_x1) == BoundaryFlag::reflect) {
           for (int i=0; i<ng; ++i) {
-            u0(m,n,k,j,ie+i+1) = u_in.d_view(n,BoundaryFace::outer_x1);
+            u(m,n,k,j,ie+i+1) = sign*u(m,n,k,j,ie-i);
           }
-          break;
-        default:
-          break;
-      }
-    });
-  }
-
-  if (pm->one_d) return;
+        }
+      });
+    }
+    member.team_barrier();
 
-  // only apply BCs if not periodic
-  if (pm->mesh_bcs[BoundaryFace::inner_x2] != BoundaryFlag::periodic) {
-    par_for("z4cbc_x2", DevExeSpace(), 0,(nmb-1),0,(nvar-1),0,(n3-1),0,(n1-1),
-    KOKKOS_LAMBDA(int m, int n, int k, int i) {
-      // apply physical boundaries to inner_x2
-      switch (mb_bcs.d_view(m,BoundaryFace::inner_x2)) {
-        case BoundaryFlag::reflect:
-          for (int j=0; j<ng; ++j) {
-            if (n==z4c::Z4c::I_Z4C_GXY || n==z4c::Z4c::I_Z4C_GYZ ||
-                n==z4c::Z4c::I_Z4C_AXY || n==z4c::Z4c::I_Z4C_AYZ ||
-                n==z4c::Z4c::I_Z4C_GAMY || n==z4c::Z4c::I_Z4C_BETAY) {
-              u0(m,n,k,js-j-1,i) = -u0(m,n,k,js+j,i);
-            } else {
-              u0(m,n,k,js-j-1,i) =  u0(m,n,k,js+j,i);
-            }
-          }
-          break;
-        case BoundaryFlag::diode:
-        case BoundaryFlag::outflow:
-        case BoundaryFlag::vacuum:
+    // apply physical boundaries to x2 faces
+    if (faces & 12) {
+      par_for_inner(member, 0, (n3*n1-1), [&](const int idx) {
+        const int k = idx/n1;
+        const int i = idx - k*n1;
+        if (mb_bcs.d_view(m,BoundaryFace::inner_x2) == BoundaryFlag::reflect) {
           for (int j=0; j<ng; ++j) {
-            //u0(m,n,k,js-j-1,i) = u0(m,n,k,js,i);
-            u0(m,n,k,js-j-1,i) = Extrapolate<order>(u0,m,n,k,js,i,0,1,0,j+1);
+            u(m,n,k,js-j-1,i) = sign*u(m,n,k,js+j,i);
           }
-          break;
-        case BoundaryFlag::inflow:
+        }
+        if (mb_bcs.d_view(m,BoundaryFace::outer_x2) == BoundaryFlag::reflect) {
           for (int j=0; j<ng; ++j) {
-            u0(m,n,k,js-j-1,i) = u_in.d_view(n,BoundaryFace::inner_x2);
+            u(m,n,k,je+j+1,i) = sign*u(m,n,k,je-j,i);
           }
-          break;
-        default:
-          break;
-      }
+        }
+      });
+    }
+    member.team_barrier();
 
-      // apply physical boundaries to outer_x2
-      switch (mb_bcs.d_view(m,BoundaryFace::outer_x2)) {
-        case BoundaryFlag::reflect:
-          for (int j=0; j<ng; ++j) {
-            if (n==z4c::Z4c::I_Z4C_GXY || n==z4c::Z4c::I_Z4C_GYZ ||
-                n==z4c::Z4c::I_Z4C_AXY || n==z4c::Z4c::I_Z4C_AYZ ||
-                n==z4c::Z4c::I_Z4C_GAMY || n==z4c::Z4c::I_Z4C_BETAY) {
-              u0(m,n,k,je+j+1,i) = -u0(m,n,k,je-j,i);
-            } else {
-              u0(m,n,k,je+j+1,i) =  u0(m,n,k,je-j,i);
-            }
-          }
-          break;
-        case BoundaryFlag::diode:
-        case BoundaryFlag::outflow:
-        case BoundaryFlag::vacuum:
-          for (int j=0; j<ng; ++j) {
-            //u0(m,n,k,je+j+1,i) = u0(m,n,k,je,i);
-            u0(m,n,k,je+j+1,i) = Extrapolate<order>(u0,m,n,k,je,i,0,-1,0,j+1);
-          }
-          break;
-        case BoundaryFlag::inflow:
-          for (int j=0; j<ng; ++j) {
-            u0(m,n,k,je+j+1,i) = u_in.d_view(n,BoundaryFace::outer_x2);
+    // apply physical boundaries to x3 faces
+    if (faces & 48) {
+      par_for_inner(member, 0, (n2*n1-1), [&](const int idx) {
+        const int j = idx/n1;
+        const int i = idx - j*n1;
+        if (mb_bcs.d_view(m,BoundaryFace::inner_x3) == BoundaryFlag::reflect) {
+          for (int k=0; k<ng; ++k) {
+            u(m,n,ks-k-1,j,i) = sign*u(m,n,ks+k,j,i);
           }
-          break;
-        default:
-          break;
-      }
-    });
-  }
-  if (pm->two_d) return;
-
-  // only apply BCs if not periodic
-  if (pm->mesh_bcs[BoundaryFace::inner_x3] == BoundaryFlag::periodic) return;
-  par_for("z4cbc_x3", DevExeSpace(), 0,(nmb-1),0,(nvar-1),0,(n2-1),0,(n1-1),
-  KOKKOS_LAMBDA(int m, int n, int j, int i) {
-    // apply physical boundaries to inner_x3
-    switch (mb_bcs.d_view(m,BoundaryFace::inner_x3)) {
-      case BoundaryFlag::reflect:
-        for (int k=0; k<ng; ++k) {
-          if (n==z4c::Z4c::I_Z4C_GXZ || n==z4c::Z4c::I_Z4C_GYZ ||
-              n==z4c::Z4c::I_Z4C_AXZ || n==z4c::Z4c::I_Z4C_AYZ ||
-              n==z4c::Z4c::I_Z4C_GAMZ || n==z4c::Z4c::I_Z4C_BETAZ) {
-            u0(m,n,ks-k-1,j,i) = -u0(m,n,ks+k,j,i);
-          } else {
-            u0(m,n,ks-k-1,j,i) =  u0(m,n,ks+k,j,i);
+        }
+        if (mb_bcs.d_view(m,BoundaryFace::outer_x3) == BoundaryFlag::reflect) {
+          for (int k=0; k<ng; ++k) {
+            u(m,n,ke+k+1,j,i) = sign*u(m,n,ke-k,j,i);
           }
         }
-        break;
-      case BoundaryFlag::diode:
-      case BoundaryFlag::outflow:
-      case BoundaryFlag::vacuum:
-        for (int k=0; k<ng; ++k) {
-          //u0(m,n,ks-k-1,j,i) = u0(m,n,ks,j,i);
-          u0(m,n,ks-k-1,j,i) = Extrapolate<order>(u0,m,n,ks,j,i,1,0,0,k+1);
+      });
+    }
+  });
+  return;
+}
+
+//void BoundaryValues::Z4cBCs(MeshBlockPack *ppack, DualArray2D<Real> u_in,
+//                            DvceArray5D<Real> u0) {
+template<int order>
+void BCHelper(MeshBlockPack *ppack, DualArray2D<Real> u_in, DvceArray5D<Real> u0,
+              int is, int ie, int js, int je, int ks, int ke, int n1, int n2, int n3) {
+  int &ng = ppack->pmesh->mb_indcs.ng;
+  auto &mb_bcs = ppack->pmb->mb_bcs;
+  auto &phys_mb = ppack->pmb->phys_mb;
+  int nmb_phys = ppack->pmb->nmb_phys;
+  if (nmb_phys == 0) return;
+
+  int nvar = u0.extent_int(1);  // TODO(@user): 2nd index from L of in array must be NVAR
+
+  // single kernel over all MBs with physical boundaries, see HydroBCs()
+  par_for_outer("z4cbc", DevExeSpace(), 0, 0, 0, (nmb_phys-1), 0, (nvar-1),
+  KOKKOS_LAMBDA(TeamMember_t member, const int p, const int n) {
+    const int m = phys_mb.d_view(p,0);
+    const int faces = phys_mb.d_view(p,1);
+
+    // apply physical boundaries to x1 faces
+    if (faces & 3) {
+      par_for_inner(member, 0, (n3*n2-1), [&](const int idx) {
+        const int k = idx/n2;
+        const int j = idx - k*n2;
+        // apply physical boundaries to inner_x1
+        switch (mb_bcs.d_view(m,BoundaryFace::inner_x1)) {
+          case BoundaryFlag::reflect:
+            for (int i=0; i<ng; ++i) {
+              if (n==z4c::Z4c::I_Z4C_GXY || n==z4c::Z4c::I_Z4C_GXZ ||
+                  n==z4c::Z4c::I_Z4C_AXY || n==z4c::Z4c::I_Z4C_AXZ ||
+                  n==z4c::Z4c::I_Z4C_GAMX || n==z4c::Z4c::I_Z4C_BETAX) {
+                u0(m,n,k,j,is-i-1) = -u0(m,n,k,j,is+i);
+              } else {
+                u0(m,n,k,j,is-i-1) =  u0(m,n,k,j,is+i);
+              }
+            }
+            break;
+          case BoundaryFlag::diode:
+          case BoundaryFlag::outflow:
+          case BoundaryFlag::vacuum:
+            for (int i=0; i<ng; ++i) {
+              //u0(m,n,k,j,is-i-1) = u0(m,n,k,j,is);
+              u0(m,n,k,j,is-i-1) = Extrapolate<order>(u0,m,n,k,j,is,0,0,1,i+1);
+            }
+            break;
+          case BoundaryFlag::inflow:
+            for (int i=0; i<ng; ++i) {
+              u0(m,n,k,j,is-i-1) = u_in.d_view(n,BoundaryFace::inner_x1);
+            }
+            break;
+          default:
+            break;
         }
-        break;
-      case BoundaryFlag::inflow:
-        for (int k=0; k<ng; ++k) {
-          u0(m,n,ks-k-1,j,i) = u_in.d_view(n,BoundaryFace::inner_x3);
+
+        // apply physical boundaries to outer_x1
+        switch (mb_bcs.d_view(m,BoundaryFace::outer_x1)) {
+          case BoundaryFlag::reflect:
+            for (int i=0; i<ng; ++i) {
+              if (n==z4c::Z4c::I_Z4C_GXY || n==z4c::Z4c::I_Z4C_GXZ ||
+                  n==z4c::Z4c::I_Z4C_AXY || n==z4c::Z4c::I_Z4C_AXZ ||
+                  n==z4c::Z4c::I_Z4C_GAMX || n==z4c::Z4c::I_Z4C_BETAX) {
+                u0(m,n,k,j,ie+i+1) = -u0(m,n,k,j,ie-i);
+              } else {
+                u0(m,n,k,j,ie+i+1) =  u0(m,n,k,j,ie-i);
+              }
+            }
+            break;
+          case BoundaryFlag::diode:
+          case BoundaryFlag::outflow:
+          case BoundaryFlag::vacuum:
+            for (int i=0; i<ng; ++i) {
+              //u0(m,n,k,j,ie+i+1) = u0(m,n,k,j,ie);
+              u0(m,n,k,j,ie+i+1) = Extrapolate<order>(u0,m,n,k,j,ie,0,0,-1,i+1);
+            }
+            break;
+          case BoundaryFlag::inflow:
+            for (int i=0; i<ng; ++i) {
+              u0(m,n,k,j,ie+i+1) = u_in.d_view(n,BoundaryFace::outer_x1);
+            }
+            break;
+          default:
+            break;
         }
-        break;
-      default:
-        break;
+      });
     }
+    member.team_barrier();
 
-    // apply physical boundaries to outer_x3
-    switch (mb_bcs.d_view(m,BoundaryFace::outer_x3)) {
-      case BoundaryFlag::reflect:
-        for (int k=0; k<ng; ++k) {
-          if (n==z4c::Z4c::I_Z4C_GXZ || n==z4c::Z4c::I_Z4C_GYZ ||
-              n==z4c::Z4c::I_Z4C_AXZ || n==z4c::Z4c::I_Z4C_AYZ ||
-              n==z4c::Z4c::I_Z4C_GAMZ || n==z4c::Z4c::I_Z4C_BETAZ) {
-            u0(m,n,ke+k+1,j,i) = -u0(m,n,ke-k,j,i);
-          } else {
-            u0(m,n,ke+k+1,j,i) =  u0(m,n,ke-k,j,i);
-          }
+    // apply physical boundaries to x2 faces
+    if (faces & 12) {
+      par_for_inner(member, 0, (n3*n1-1), [&](const int idx) {
+        const int k = idx/n1;
+        const int i = idx - k*n1;
+        // apply physical boundaries to inner_x2
+        switch (mb_bcs.d_view(m,BoundaryFace::inner_x2)) {
+          case BoundaryFlag::reflect:
+            for (int j=0; j<ng; ++j) {
+              if (n==z4c::Z4c::I_Z4C_GXY || n==z4c::Z4c::I_Z4C_GYZ ||
+                  n==z4c::Z4c::I_Z4C_AXY || n==z4c::Z4c::I_Z4C_AYZ ||
+                  n==z4c::Z4c::I_Z4C_GAMY || n==z4c::Z4c::I_Z4C_BETAY) {
+                u0(m,n,k,js-j-1,i) = -u0(m,n,k,js+j,i);
+              } else {
+                u0(m,n,k,js-j-1,i) =  u0(m,n,k,js+j,i);
+              }
+            }
+            break;
+          case BoundaryFlag::diode:
+          case BoundaryFlag::outflow:
+          case BoundaryFlag::vacuum:
+            for (int j=0; j<ng; ++j) {
+              //u0(m,n,k,js-j-1,i) = u0(m,n,k,js,i);
+              u0(m,n,k,js-j-1,i) = Extrapolate<order>(u0,m,n,k,js,i,0,1,0,j+1);
+            }
+            break;
+          case BoundaryFlag::inflow:
+            for (int j=0; j<ng; ++j) {
+              u0(m,n,k,js-j-1,i) = u_in.d_view(n,BoundaryFace::inner_x2);
+            }
+            break;
+          default:
+            break;
         }
-        break;
-      case BoundaryFlag::diode:
-      case BoundaryFlag::outflow:
-      case BoundaryFlag::vacuum:
-        for (int k=0; k<ng; ++k) {
-          //u0(m,n,ke+k+1,j,i) = u0(m,n,ke,j,i);
-          u0(m,n,ke+k+1,j,i) = Extrapolate<order>(u0,m,n,ke,j,i,-1,0,0,k+1);
+
+        // apply physical boundaries to outer_x2
+        switch (mb_bcs.d_view(m,BoundaryFace::outer_x2)) {
+          case BoundaryFlag::reflect:
+            for (int j=0; j<ng; ++j) {
+              if (n==z4c::Z4c::I_Z4C_GXY || n==z4c::Z4c::I_Z4C_GYZ ||
+                  n==z4c::Z4c::I_Z4C_AXY || n==z4c::Z4c::I_Z4C_AYZ ||
+                  n==z4c::Z4c::I_Z4C_GAMY || n==z4c::Z4c::I_Z4C_BETAY) {
+                u0(m,n,k,je+j+1,i) = -u0(m,n,k,je-j,i);
+              } else {
+                u0(m,n,k,je+j+1,i) =  u0(m,n,k,je-j,i);
+              }
+            }
+            break;
+          case BoundaryFlag::diode:
+          case BoundaryFlag::outflow:
+          case BoundaryFlag::vacuum:
+            for (int j=0; j<ng; ++j) {
+              //u0(m,n,k,je+j+1,i) = u0(m,n,k,je,i);
+              u0(m,n,k,je+j+1,i) = Extrapolate<order>(u0,m,n,k,je,i,0,-1,0,j+1);
+            }
+            break;
+          case BoundaryFlag::inflow:
+            for (int j=0; j<ng; ++j) {
+              u0(m,n,k,je+j+1,i) = u_in.d_view(n,BoundaryFace::outer_x2);
+            }
+            break;
+          default:
+            break;
         }
-        break;
-      case BoundaryFlag::inflow:
-        for (int k=0; k<ng; ++k) {
-          u0(m,n,ke+k+1,j,i) = u_in.d_view(n,BoundaryFace::outer_x3);
+      });
+    }
+    member.team_barrier();
+
+    // apply physical boundaries to x3 faces
+    if (faces & 48) {
+      par_for_inner(member, 0, (n2*n1-1), [&](const int idx) {
+        const int j = idx/n1;
+        const int i = idx - j*n1;
+        // apply physical boundaries to inner_x3
+        switch (mb_bcs.d_view(m,BoundaryFace::inner_x3)) {
+          case BoundaryFlag::reflect:
+            for (int k=0; k<ng; ++k) {
+              if (n==z4c::Z4c::I_Z4C_GXZ || n==z4c::Z4c::I_Z4C_GYZ ||
+                  n==z4c::Z4c::I_Z4C_AXZ || n==z4c::Z4c::I_Z4C_AYZ ||
+                  n==z4c::Z4c::I_Z4C_GAMZ || n==z4c::Z4c::I_Z4C_BETAZ) {
+                u0(m,n,ks-k-1,j,i) = -u0(m,n,ks+k,j,i);
+              } else {
+                u0(m,n,ks-k-1,j,i) =  u0(m,n,ks+k,j,i);
+              }
+            }
+            break;
+          case BoundaryFlag::diode:
+          case BoundaryFlag::outflow:
+          case BoundaryFlag::vacuum:
+            for (int k=0; k<ng; ++k) {
+              //u0(m,n,ks-k-1,j,i) = u0(m,n,ks,j,i);
+              u0(m,n,ks-k-1,j,i) = Extrapolate<order>(u0,m,n,ks,j,i,1,0,0,k+1);
+            }
+            break;
+          case BoundaryFlag::inflow:
+            for (int k=0; k<ng; ++k) {
+              u0(m,n,ks-k-1,j,i) = u_in.d_view(n,BoundaryFace::inner_x3);
+            }
+            break;
+          default:
+            break;
         }
-        break;
-      default:
-        break;
+
+        // apply physical boundaries to outer_x3
+        switch (mb_bcs.d_view(m,BoundaryFace::outer_x3)) {
+          case BoundaryFlag::reflect:
+            for (int k=0; k<ng; ++k) {
+              if (n==z4c::Z4c::I_Z4C_GXZ || n==z4c::Z4c::I_Z4C_GYZ ||
+                  n==z4c::Z4c::I_Z4C_AXZ || n==z4c::Z4c::I_Z4C_AYZ ||
+                  n==z4c::Z4c::I_Z4C_GAMZ || n==z4c::Z4c::I_Z4C_BETAZ) {
+                u0(m,n,ke+k+1,j,i) = -u0(m,n,ke-k,j,i);
+              } else {
+                u0(m,n,ke+k+1,j,i) =  u0(m,n,ke-k,j,i);
+              }
+            }
+            break;
+          case BoundaryFlag::diode:
+          case BoundaryFlag::outflow:
+          case BoundaryFlag::vacuum:
+            for (int k=0; k<ng; ++k) {
+              //u0(m,n,ke+k+1,j,i) = u0(m,n,ke,j,i);
+              u0(m,n,ke+k+1,j,i) = Extrapolate<order>(u0,m,n,ke,j,i,-1,0,0,k+1);
+            }
+            break;
+          case BoundaryFlag::inflow:
+            for (int k=0; k<ng; ++k) {
+              u0(m,n,ke+k+1,j,i) = u_in.d_view(n,BoundaryFace::outer_x3);
+            }
+            break;
+          default:
+            break;
+        }
+      });
     }
   });
-
   return;
 }
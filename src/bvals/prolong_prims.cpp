@@ -6,7 +6,8 @@
 //! \file prolong_prims.cpp
 //! \brief functions to convert conserved to primitive variables (and vice-versa) in
 //! boundary buffers where prolongation is used at fine/coarse level boundaries.  This
-//! enables prolongation in either the conserved or primitive variables.
+//! enables prolongation in either the conserved or primitive variables.  For Hydro the
+//! conversions and prolongation are fused into a single kernel, ProlongatePrimsCC().
 #include <cstdlib>
 #include <iostream>
 #include <string>
@@ -26,20 +27,103 @@
 #include "coordinates/cell_locations.hpp"
 
 //----------------------------------------------------------------------------------------
-//! \fn void ConsToPrimCoarseBndry()
-//! \brief Converts Hydro conserved variables in coarse level boundary buffers into
-//! Hydro primitive variables for prolongation. Coarse arrays should be passed in through
-//! arguments.
-//! Only works for hydrodynamics, the same function for MHD has different argument list.
+//! \fn void CoarseConsToPrimHyd()
+//! \brief Converts Hydro conserved variables in one cell (k,j,i) of the coarse array of
+//! MeshBlock m (at index cm) into primitive variables w[IDN..IEN].  Floors are applied
+//! to w, but the conserved variables are not corrected since they are overwritten by
+//! prolongation anyways.
+
+KOKKOS_INLINE_FUNCTION
+void CoarseConsToPrimHyd(const DvceArray5D<Real> &ccons, const int cm,
+                         const int k, const int j, const int i, const RegionIndcs &indcs,
+                         const RegionSize &size, const EOS_Data &eos, const bool is_sr,
+                         const bool is_gr, const bool flat, const Real spin, Real w[5]) {
+  // load single state conserved variables
+  HydCons1D u;
+  u.d  = ccons(cm,IDN,k,j,i);
+  u.mx = ccons(cm,IM1,k,j,i);
+  u.my = ccons(cm,IM2,k,j,i);
+  u.mz = ccons(cm,IM3,k,j,i);
+  u.e  = ccons(cm,IEN,k,j,i);
+  HydPrim1D wc;
+
+  bool dfloor_used=false, efloor_used=false, tfloor_used=false;
+  if (is_gr) {
+    // Note indices refer to coarse arrays, so use cis, cnx1
+    Real x1v = CellCenterX(i-indcs.cis, indcs.cnx1, size.x1min, size.x1max);
+    Real x2v = CellCenterX(j-indcs.cjs, indcs.cnx2, size.x2min, size.x2max);
+    Real x3v = CellCenterX(k-indcs.cks, indcs.cnx3, size.x3min, size.x3max);
+
+    Real glower[4][4], gupper[4][4];
+    ComputeMetricAndInverse(x1v, x2v, x3v, flat, spin, glower, gupper);
+
+    HydCons1D u_sr;
+    Real s2;
+    TransformToSRHyd(u,glower,gupper,s2,u_sr);
+    bool c2p_failure=false;
+    int iter_used=0;
+    SingleC2P_IdealSRHyd(u_sr, eos, s2, wc,
+                         dfloor_used, efloor_used, c2p_failure, iter_used);
+
+    // apply velocity ceiling if necessary
+    Real tmp = glower[1][1]*SQR(wc.vx)
+             + glower[2][2]*SQR(wc.vy)
+             + glower[3][3]*SQR(wc.vz)
+             + 2.0*glower[1][2]*wc.vx*wc.vy + 2.0*glower[1][3]*wc.vx*wc.vz
+             + 2.0*glower[2][3]*wc.vy*wc.vz;
+    Real lor = sqrt(1.0+tmp);
+    if (lor > eos.gamma_max) {
+      Real factor = sqrt((SQR(eos.gamma_max)-1.0)/(SQR(lor)-1.0));
+      wc.vx *= factor;
+      wc.vy *= factor;
+      wc.vz *= factor;
+    }
+  } else if (is_sr) {
+    // Compute (S^i S_i) (eqn C2)
+    Real s2 = SQR(u.mx) + SQR(u.my) + SQR(u.mz);
+    bool c2p_failure=false;
+    int iter_used=0;
+    SingleC2P_IdealSRHyd(u, eos, s2, wc,
+                         dfloor_used, efloor_used, c2p_failure, iter_used);
+    // apply velocity ceiling if necessary
+    Real lor = sqrt(1.0+SQR(wc.vx)+SQR(wc.vy)+SQR(wc.vz));
+    if (lor > eos.gamma_max) {
+      Real factor = sqrt((SQR(eos.gamma_max)-1.0)/(SQR(lor)-1.0));
+      wc.vx *= factor;
+      wc.vy *= factor;
+      wc.vz *= factor;
+    }
+  } else {
+    SingleC2P_IdealHyd(u, eos, wc, dfloor_used, efloor_used, tfloor_used);
+  }
+  w[IDN] = wc.d;
+  w[IVX] = wc.vx;
+  w[IVY] = wc.vy;
+  w[IVZ] = wc.vz;
+  w[IEN] = wc.e;
+  return;
+}
 
-void MeshBoundaryValuesCC::ConsToPrimCoarseBndry(const DvceArray5D<Real> &cons,
-                                                 DvceArray5D<Real> &prim) {
+//----------------------------------------------------------------------------------------
+//! \fn void ProlongatePrimsCC()
+//! \brief Prolongates Hydro variables at fine/coarse boundaries in the primitive
+//! variables.  For each buffer with a coarser neighbor, the conserved variables in the
+//! coarse array ccons are converted to primitives in each cell of the prolongation
+//! stencil, prolongated with the same min-mod limited slopes as ProlongCC(), and the
+//! fine primitives (stored in prim) converted back to conserved variables in cons, all in
+//! one kernel, so no array of coarse primitive variables is needed.
+//! Only works for hydrodynamics, MHD uses ConsToPrimCoarseBndry() and
+//! PrimToConsFineBndry() since the fine magnetic fields must be prolongated first.
+
+void MeshBoundaryValuesCC::ProlongatePrimsCC(const DvceArray5D<Real> &ccons,
+                                             DvceArray5D<Real> &prim,
+                                             DvceArray5D<Real> &cons) {
   // create local references for variables in kernel
-  int nmb = pmy_pack->nmb_thispack;
   int nnghbr = pmy_pack->pmb->nnghbr;
 
   auto &nghbr = pmy_pack->pmb->nghbr;
   auto &mblev = pmy_pack->pmb->mb_lev;
+  auto &cidx = pmy_pack->pmb->mb_cidx;
   auto &rbuf = recvbuf;
   auto &indcs  = pmy_pack->pmesh->mb_indcs;
   const bool multi_d = pmy_pack->pmesh->multi_d;
@@ -50,38 +134,34 @@ void MeshBoundaryValuesCC::ConsToPrimCoarseBndry(const DvceArray5D<Real> &cons,
   bool &is_sr = pmy_pack->pcoord->is_special_relativistic;
   bool &is_gr = pmy_pack->pcoord->is_general_relativistic;
   auto &eos = pmy_pack->phydro->peos->eos_data;
+  Real &gamma = pmy_pack->phydro->peos->eos_data.gamma;
   int &nhyd  = pmy_pack->phydro->nhydro;
   int &nscal = pmy_pack->phydro->nscalars;
 
-  // Outer loop over (# of MeshBlocks)*(# of buffers)
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), (nmb*nnghbr), Kokkos::AUTO);
-  Kokkos::parallel_for("Prol_C2P_CC", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-    const int m = tmember.league_rank()/nnghbr;
-    const int n = tmember.league_rank() - m*nnghbr;
+  // Outer loop over (# of buffers with coarser neighbors)
+  int nprol = SetProlongationList();
+  auto &plist = prol_list;
+  Kokkos::TeamPolicy<> policy(DevExeSpace(), nprol, Kokkos::AUTO);
+  Kokkos::parallel_for("ProlPrimsCC", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
+    const int m = plist.d_view(tmember.league_rank())/nnghbr;
+    const int n = plist.d_view(tmember.league_rank()) - m*nnghbr;
+    const int cm = cidx.d_view(m);  // index of MB in coarse arrays
 
-    // only convert coarse vars when neighbor exists and is at coarser level
+    // only prolongate when neighbor exists and is at coarser level
     if ((nghbr.d_view(m,n).gid >= 0) && (nghbr.d_view(m,n).lev < mblev.d_view(m))) {
-      // use indices for prolongation on this buffer as loop limits.
-      // Note that one extra cell is added to match stencil of 2nd-order prolongation
-      int il = rbuf[n].iprol[0].bis - 1;
-      int iu = rbuf[n].iprol[0].bie + 1;
+      // loop over indices for prolongation on this buffer
+      int il = rbuf[n].iprol[0].bis;
+      int iu = rbuf[n].iprol[0].bie;
       int jl = rbuf[n].iprol[0].bjs;
       int ju = rbuf[n].iprol[0].bje;
-      if (multi_d) {
-        jl -= 1;
-        ju += 1;
-      }
       int kl = rbuf[n].iprol[0].bks;
       int ku = rbuf[n].iprol[0].bke;
-      if (three_d) {
-        kl -= 1;
-        ku += 1;
-      }
       const int ni = iu - il + 1;
       const int nj = ju - jl + 1;
       const int nk = ku - kl + 1;
       const int nkji = nk*nj*ni;
       const int nji  = nj*ni;
+      const RegionSize msize = size.d_view(m);
 
       // Middle loop over k,j,i
       Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nkji), [&](const int idx) {
@@ -91,200 +171,106 @@ void MeshBoundaryValuesCC::ConsToPrimCoarseBndry(const DvceArray5D<Real> &cons,
         j += jl;
         k += kl;
 
-        // load single state conserved variables
-        HydCons1D u;
-        u.d  = cons(m,IDN,k,j,i);
-        u.mx = cons(m,IM1,k,j,i);
-        u.my = cons(m,IM2,k,j,i);
-        u.mz = cons(m,IM3,k,j,i);
-        u.e  = cons(m,IEN,k,j,i);
-        HydPrim1D w;
-
-        bool dfloor_used=false, efloor_used=false, tfloor_used=false;
-        if (is_gr) {
-          Real &x1min = size.d_view(m).x1min;
-          Real &x1max = size.d_view(m).x1max;
-          // Note indices refer to coarse arrays, so use cis, cnx1
-          Real x1v = CellCenterX(i-indcs.cis, indcs.cnx1, x1min, x1max);
-
-          Real &x2min = size.d_view(m).x2min;
-          Real &x2max = size.d_view(m).x2max;
-          Real x2v = CellCenterX(j-indcs.cjs, indcs.cnx2, x2min, x2max);
-
-          Real &x3min = size.d_view(m).x3min;
-          Real &x3max = size.d_view(m).x3max;
-          Real x3v = CellCenterX(k-indcs.cks, indcs.cnx3, x3min, x3max);
-
-          Real glower[4][4], gupper[4][4];
-          ComputeMetricAndInverse(x1v, x2v, x3v, flat, spin, glower, gupper);
-
-          HydCons1D u_sr;
-          Real s2;
-          TransformToSRHyd(u,glower,gupper,s2,u_sr);
-          bool c2p_failure=false;
-          int iter_used=0;
-          SingleC2P_IdealSRHyd(u_sr, eos, s2, w,
-                               dfloor_used, efloor_used, c2p_failure, iter_used);
-
-          // apply velocity ceiling if necessary
-          Real tmp = glower[1][1]*SQR(w.vx)
-                   + glower[2][2]*SQR(w.vy)
-                   + glower[3][3]*SQR(w.vz)
-                   + 2.0*glower[1][2]*w.vx*w.vy + 2.0*glower[1][3]*w.vx*w.vz
-                   + 2.0*glower[2][3]*w.vy*w.vz;
-          Real lor = sqrt(1.0+tmp);
-          if (lor > eos.gamma_max) {
-            Real factor = sqrt((SQR(eos.gamma_max)-1.0)/(SQR(lor)-1.0));
-            w.vx *= factor;
-            w.vy *= factor;
-            w.vz *= factor;
-          }
-        } else if (is_sr) {
-          // Compute (S^i S_i) (eqn C2)
-          Real s2 = SQR(u.mx) + SQR(u.my) + SQR(u.mz);
-          bool c2p_failure=false;
-          int iter_used=0;
-          SingleC2P_IdealSRHyd(u, eos, s2, w,
-                               dfloor_used, efloor_used, c2p_failure, iter_used);
-          // apply velocity ceiling if necessary
-          Real lor = sqrt(1.0+SQR(w.vx)+SQR(w.vy)+SQR(w.vz));
-          if (lor > eos.gamma_max) {
-            Real factor = sqrt((SQR(eos.gamma_max)-1.0)/(SQR(lor)-1.0));
-            w.vx *= factor;
-            w.vy *= factor;
-            w.vz *= factor;
-          }
-        } else {
-          SingleC2P_IdealHyd(u, eos, w, dfloor_used, efloor_used, tfloor_used);
+        // convert coarse cell and its neighbors in the stencil of 2nd-order prolongation,
+        // stored in the order (k,j,i),(i-1),(i+1),(j-1),(j+1),(k-1),(k+1)
+        const int nst = (three_d)? 7 : ((multi_d)? 5 : 3);
+        const int sk[7] = {k, k, k, k, k, k-1, k+1};
+        const int sj[7] = {j, j, j, j-1, j+1, j, j};
+        const int si[7] = {i, i-1, i+1, i, i, i, i};
+        Real wc[7][5];
+        for (int s=0; s<nst; ++s) {
+          CoarseConsToPrimHyd(ccons, cm, sk[s], sj[s], si[s], indcs, msize, eos,
+                              is_sr, is_gr, flat, spin, wc[s]);
         }
 
-        // No need to correct conserved state in coarse boundary arrays if floors used
-        // since these values will be overwritten after prolongation anyways.
-        // store primitive state in 3D array
-        prim(m,IDN,k,j,i) = w.d;
-        prim(m,IVX,k,j,i) = w.vx;
-        prim(m,IVY,k,j,i) = w.vy;
-        prim(m,IVZ,k,j,i) = w.vz;
-        prim(m,IEN,k,j,i) = w.e;
-        // convert scalars (if any)
-        for (int n=nhyd; n<(nhyd+nscal); ++n) {
-          // apply scalar floor
-          if (cons(m,n,k,j,i) < 0.0) {
-            cons(m,n,k,j,i) = 0.0;
+        // indices for prolongation refer to coarse array.  So must compute
+        // indices for fine array
+        int fi = (i - indcs.cis)*2 + indcs.is;
+        int fj = (j - indcs.cjs)*2 + indcs.js;
+        int fk = (k - indcs.cks)*2 + indcs.ks;
+
+        // min-mod limited slopes, as in ProlongCC()
+        Real dw[3][5];
+        for (int v=0; v<nhyd; ++v) {
+          for (int d=0; d<3; ++d) {
+            dw[d][v] = 0.0;
+            if (2*d+2 < nst) {
+              Real dl = wc[0][v] - wc[2*d+1][v];
+              Real dr = wc[2*d+2][v] - wc[0][v];
+              dw[d][v] = 0.125*(SIGN(dl) + SIGN(dr))*fmin(fabs(dl), fabs(dr));
+            }
           }
-          prim(m,n,k,j,i) = cons(m,n,k,j,i)/u.d;
         }
-      });
-      tmember.team_barrier();
-    }
-  });
-  return;
-}
-
-//----------------------------------------------------------------------------------------
-//! \fn void PrimToConsFineBndry()
-//! \brief Converts prolongated Hydro primitive variables at fine level in boundary
-//! buffers into Hydro conservative variables.
-//! Note same function for MHD has different argument list.
 
-void MeshBoundaryValuesCC::PrimToConsFineBndry(const DvceArray5D<Real> &prim,
-                                               DvceArray5D<Real> &cons) {
-  // create local references for variables in kernel
-  int nmb = pmy_pack->nmb_thispack;
-  int nnghbr = pmy_pack->pmb->nnghbr;
-
-  auto &nghbr = pmy_pack->pmb->nghbr;
-  auto &mblev = pmy_pack->pmb->mb_lev;
-  auto &rbuf = recvbuf;
-  auto &indcs  = pmy_pack->pmesh->mb_indcs;
-  const bool multi_d = pmy_pack->pmesh->multi_d;
-  const bool three_d = pmy_pack->pmesh->three_d;
-  auto &size = pmy_pack->pmb->mb_size;
-  auto &flat = pmy_pack->pcoord->coord_data.is_minkowski;
-  auto &spin = pmy_pack->pcoord->coord_data.bh_spin;
-  bool &is_sr = pmy_pack->pcoord->is_special_relativistic;
-  bool &is_gr = pmy_pack->pcoord->is_general_relativistic;
-  Real &gamma = pmy_pack->phydro->peos->eos_data.gamma;
-  int &nhyd  = pmy_pack->phydro->nhydro;
-  int &nscal = pmy_pack->phydro->nscalars;
-
-  // Outer loop over (# of MeshBlocks)*(# of buffers)
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), (nmb*nnghbr), Kokkos::AUTO);
-  Kokkos::parallel_for("ProlCC", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-    const int m = tmember.league_rank()/nnghbr;
-    const int n = tmember.league_rank() - m*nnghbr;
-
-    // only prolongate when neighbor exists and is at coarser level
-    if ((nghbr.d_view(m,n).gid >= 0) && (nghbr.d_view(m,n).lev < mblev.d_view(m))) {
-      // loop over indices for prolongation on this buffer
-      // Convert indices from coarse to fine arrays
-      int il = (rbuf[n].iprol[0].bis - indcs.cis)*2 + indcs.is;
-      int iu = (rbuf[n].iprol[0].bie - indcs.cis)*2 + indcs.is + 1;
-      int jl = (rbuf[n].iprol[0].bjs - indcs.cjs)*2 + indcs.js;
-      int ju = (rbuf[n].iprol[0].bje - indcs.cjs)*2 + indcs.js;
-      if (multi_d) {
-        ju += 1;
-      }
-      int kl = (rbuf[n].iprol[0].bks - indcs.cks)*2 + indcs.ks;
-      int ku = (rbuf[n].iprol[0].bke - indcs.cks)*2 + indcs.ks;
-      if (three_d) {
-        ku += 1;
-      }
-      const int ni = iu - il + 1;
-      const int nj = ju - jl + 1;
-      const int nk = ku - kl + 1;
-      const int nkji = nk*nj*ni;
-      const int nji  = nj*ni;
-
-      // Middle loop over k,j,i
-      Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nkji), [&](const int idx) {
-        int k = idx/nji;
-        int j = (idx - k*nji)/ni;
-        int i = (idx - k*nji - j*ni) + il;
-        j += jl;
-        k += kl;
-
-        // Load single state of primitive variables
-        HydPrim1D w;
-        w.d  = prim(m,IDN,k,j,i);
-        w.vx = prim(m,IVX,k,j,i);
-        w.vy = prim(m,IVY,k,j,i);
-        w.vz = prim(m,IVZ,k,j,i);
-        w.e  = prim(m,IEN,k,j,i);
-        HydCons1D u;
-
-        if (is_gr) {
-          Real &x1min = size.d_view(m).x1min;
-          Real &x1max = size.d_view(m).x1max;
-          Real x1v = CellCenterX(i-indcs.is, indcs.nx1, x1min, x1max);
-
-          Real &x2min = size.d_view(m).x2min;
-          Real &x2max = size.d_view(m).x2max;
-          Real x2v = CellCenterX(j-indcs.js, indcs.nx2, x2min, x2max);
-
-          Real &x3min = size.d_view(m).x3min;
-          Real &x3max = size.d_view(m).x3max;
-          Real x3v = CellCenterX(k-indcs.ks, indcs.nx3, x3min, x3max);
-
-          Real glower[4][4], gupper[4][4];
-          ComputeMetricAndInverse(x1v, x2v, x3v, flat, spin, glower, gupper);
-          SingleP2C_IdealGRHyd(glower, gupper, w, gamma, u);
-        } else if (is_sr) {
-          SingleP2C_IdealSRHyd(w, gamma, u);
-        } else {
-          SingleP2C_IdealHyd(w, u);
+        // interpolate to each fine cell, and convert to conserved variables
+        const int nfk = (three_d)? 2 : 1;
+        const int nfj = (multi_d)? 2 : 1;
+        for (int kk=0; kk<nfk; ++kk) {
+          for (int jj=0; jj<nfj; ++jj) {
+            for (int ii=0; ii<2; ++ii) {
+              Real s1 = (ii == 0)? -1.0 : 1.0;
+              Real s2 = (jj == 0)? -1.0 : 1.0;
+              Real s3 = (kk == 0)? -1.0 : 1.0;
+              int fkk = fk + kk, fjj = fj + jj, fii = fi + ii;
+              for (int v=0; v<nhyd; ++v) {
+                prim(m,v,fkk,fjj,fii) = wc[0][v] + s1*dw[0][v] + s2*dw[1][v] +
+                                        s3*dw[2][v];
+              }
+
+              HydPrim1D w;
+              w.d  = prim(m,IDN,fkk,fjj,fii);
+              w.vx = prim(m,IVX,fkk,fjj,fii);
+              w.vy = prim(m,IVY,fkk,fjj,fii);
+              w.vz = prim(m,IVZ,fkk,fjj,fii);
+              w.e  = prim(m,IEN,fkk,fjj,fii);
+              HydCons1D u;
+              if (is_gr) {
+                Real x1v = CellCenterX(fii-indcs.is, indcs.nx1, msize.x1min, msize.x1max);
+                Real x2v = CellCenterX(fjj-indcs.js, indcs.nx2, msize.x2min, msize.x2max);
+                Real x3v = CellCenterX(fkk-indcs.ks, indcs.nx3, msize.x3min, msize.x3max);
+                Real glower[4][4], gupper[4][4];
+                ComputeMetricAndInverse(x1v, x2v, x3v, flat, spin, glower, gupper);
+                SingleP2C_IdealGRHyd(glower, gupper, w, gamma, u);
+              } else if (is_sr) {
+                SingleP2C_IdealSRHyd(w, gamma, u);
+              } else {
+                SingleP2C_IdealHyd(w, u);
+              }
+
+              // Set conserved quantities
+              cons(m,IDN,fkk,fjj,fii) = u.d;
+              cons(m,IM1,fkk,fjj,fii) = u.mx;
+              cons(m,IM2,fkk,fjj,fii) = u.my;
+              cons(m,IM3,fkk,fjj,fii) = u.mz;
+              cons(m,IEN,fkk,fjj,fii) = u.e;
+            }
+          }
         }
 
-        // Set conserved quantities
-        cons(m,IDN,k,j,i) = u.d;
-        cons(m,IM1,k,j,i) = u.mx;
-        cons(m,IM2,k,j,i) = u.my;
-        cons(m,IM3,k,j,i) = u.mz;
-        cons(m,IEN,k,j,i) = u.e;
-
-        // convert scalars (if any)
-        for (int n=nhyd; n<(nhyd+nscal); ++n) {
-          cons(m,n,k,j,i) = u.d*prim(m,n,k,j,i);
+        // prolongate scalars (if any) in the specific scalars, with floor s >= 0
+        for (int v=nhyd; v<(nhyd+nscal); ++v) {
+          Real rc[7], dsc[3] = {0.0, 0.0, 0.0};
+          for (int s=0; s<nst; ++s) {
+            rc[s] = fmax(ccons(cm,v,sk[s],sj[s],si[s]), 0.0)/
+                    ccons(cm,IDN,sk[s],sj[s],si[s]);
+          }
+          for (int d=0; 2*d+2<nst; ++d) {
+            Real dl = rc[0] - rc[2*d+1];
+            Real dr = rc[2*d+2] - rc[0];
+            dsc[d] = 0.125*(SIGN(dl) + SIGN(dr))*fmin(fabs(dl), fabs(dr));
+          }
+          for (int kk=0; kk<nfk; ++kk) {
+            for (int jj=0; jj<nfj; ++jj) {
+              for (int ii=0; ii<2; ++ii) {
+                Real s1 = (ii == 0)? -1.0 : 1.0;
+                Real s2 = (jj == 0)? -1.0 : 1.0;
+                Real s3 = (kk == 0)? -1.0 : 1.0;
+                int fkk = fk + kk, fjj = fj + jj, fii = fi + ii;
+                prim(m,v,fkk,fjj,fii) = rc[0] + s1*dsc[0] + s2*dsc[1] + s3*dsc[2];
+                cons(m,v,fkk,fjj,fii) = cons(m,IDN,fkk,fjj,fii)*prim(m,v,fkk,fjj,fii);
+              }
+            }
+          }
         }
       });
       tmember.team_barrier();
@@ -303,11 +289,11 @@ void MeshBoundaryValuesCC::PrimToConsFineBndry(const DvceArray5D<Real> &prim,
 void MeshBoundaryValuesCC::ConsToPrimCoarseBndry(const DvceArray5D<Real> &cons,
                                  const DvceFaceFld4D<Real> &b, DvceArray5D<Real> &prim) {
   // create local references for variables in kernel
-  int nmb = pmy_pack->nmb_thispack;
   int nnghbr = pmy_pack->pmb->nnghbr;
 
   auto &nghbr = pmy_pack->pmb->nghbr;
   auto &mblev = pmy_pack->pmb->mb_lev;
+  auto &cidx = pmy_pack->pmb->mb_cidx;
   auto &rbuf = recvbuf;
   auto &indcs  = pmy_pack->pmesh->mb_indcs;
   const bool multi_d = pmy_pack->pmesh->multi_d;
@@ -321,11 +307,14 @@ void MeshBoundaryValuesCC::ConsToPrimCoarseBndry(const DvceArray5D<Real> &cons,
   int &nmhd  = pmy_pack->pmhd->nmhd;
   int &nscal = pmy_pack->pmhd->nscalars;
 
-  // Outer loop over (# of MeshBlocks)*(# of buffers)
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), (nmb*nnghbr), Kokkos::AUTO);
+  // Outer loop over (# of buffers with coarser neighbors)
+  int nprol = SetProlongationList();
+  auto &plist = prol_list;
+  Kokkos::TeamPolicy<> policy(DevExeSpace(), nprol, Kokkos::AUTO);
   Kokkos::parallel_for("ProlCC", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-    const int m = tmember.league_rank()/nnghbr;
-    const int n = tmember.league_rank() - m*nnghbr;
+    const int m = plist.d_view(tmember.league_rank())/nnghbr;
+    const int n = plist.d_view(tmember.league_rank()) - m*nnghbr;
+    const int cm = cidx.d_view(m);  // index of MB in coarse arrays
 
     // only convert coarse vars when neighbor exists and is at coarser level
     if ((nghbr.d_view(m,n).gid >= 0) && (nghbr.d_view(m,n).lev < mblev.d_view(m))) {
@@ -361,15 +350,15 @@ void MeshBoundaryValuesCC::ConsToPrimCoarseBndry(const DvceArray5D<Real> &cons,
 
         // load single state conserved variables
         MHDCons1D u;
-        u.d  = cons(m,IDN,k,j,i);
-        u.mx = cons(m,IM1,k,j,i);
-        u.my = cons(m,IM2,k,j,i);
-        u.mz = cons(m,IM3,k,j,i);
-        u.e  = cons(m,IEN,k,j,i);
+        u.d  = cons(cm,IDN,k,j,i);
+        u.mx = cons(cm,IM1,k,j,i);
+        u.my = cons(cm,IM2,k,j,i);
+        u.mz = cons(cm,IM3,k,j,i);
+        u.e  = cons(cm,IEN,k,j,i);
         // use simple linear average of face-centered fields
-        u.bx = 0.5*(b.x1f(m,k,j,i) + b.x1f(m,k,j,i+1));
-        u.by = 0.5*(b.x2f(m,k,j,i) + b.x2f(m,k,j+1,i));
-        u.bz = 0.5*(b.x3f(m,k,j,i) + b.x3f(m,k+1,j,i));
+        u.bx = 0.5*(b.x1f(cm,k,j,i) + b.x1f(cm,k,j,i+1));
+        u.by = 0.5*(b.x2f(cm,k,j,i) + b.x2f(cm,k,j+1,i));
+        u.bz = 0.5*(b.x3f(cm,k,j,i) + b.x3f(cm,k+1,j,i));
         HydPrim1D w;
 
         bool dfloor_used=false, efloor_used=false, tfloor_used=false;
@@ -435,19 +424,19 @@ void MeshBoundaryValuesCC::ConsToPrimCoarseBndry(const DvceArray5D<Real> &cons,
         // No need to correct conserved state in coarse boundary arrays if floors used
         // since these values will be overwritten after prolongation anyways.
         // store primitive state in 3D array
-        prim(m,IDN,k,j,i) = w.d;
-        prim(m,IVX,k,j,i) = w.vx;
-        prim(m,IVY,k,j,i) = w.vy;
-        prim(m,IVZ,k,j,i) = w.vz;
-        prim(m,IEN,k,j,i) = w.e;
+        prim(cm,IDN,k,j,i) = w.d;
+        prim(cm,IVX,k,j,i) = w.vx;
+        prim(cm,IVY,k,j,i) = w.vy;
+        prim(cm,IVZ,k,j,i) = w.vz;
+        prim(cm,IEN,k,j,i) = w.e;
         // No need to store cell-centered fields since they will not be prolongated
         // convert scalars (if any)
         for (int n=nmhd; n<(nmhd+nscal); ++n) {
           // apply scalar floor
-          if (cons(m,n,k,j,i) < 0.0) {
-            cons(m,n,k,j,i) = 0.0;
+          if (cons(cm,n,k,j,i) < 0.0) {
+            cons(cm,n,k,j,i) = 0.0;
           }
-          prim(m,n,k,j,i) = cons(m,n,k,j,i)/u.d;
+          prim(cm,n,k,j,i) = cons(cm,n,k,j,i)/u.d;
         }
       });
       tmember.team_barrier();
@@ -465,7 +454,6 @@ void MeshBoundaryValuesCC::ConsToPrimCoarseBndry(const DvceArray5D<Real> &cons,
 void MeshBoundaryValuesCC::PrimToConsFineBndry(const DvceArray5D<Real> &prim,
                                const DvceFaceFld4D<Real> &b, DvceArray5D<Real> &cons) {
   // create local references for variables in kernel
-  int nmb = pmy_pack->nmb_thispack;
   int nnghbr = pmy_pack->pmb->nnghbr;
 
   auto &nghbr = pmy_pack->pmb->nghbr;
@@ -483,11 +471,13 @@ void MeshBoundaryValuesCC::PrimToConsFineBndry(const DvceArray5D<Real> &prim,
   int &nmhd  = pmy_pack->pmhd->nmhd;
   int &nscal = pmy_pack->pmhd->nscalars;
 
-  // Outer loop over (# of MeshBlocks)*(# of buffers)
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), (nmb*nnghbr), Kokkos::AUTO);
+  // Outer loop over (# of buffers with coarser neighbors)
+  int nprol = SetProlongationList();
+  auto &plist = prol_list;
+  Kokkos::TeamPolicy<> policy(DevExeSpace(), nprol, Kokkos::AUTO);
   Kokkos::parallel_for("ProlCC", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-    const int m = tmember.league_rank()/nnghbr;
-    const int n = tmember.league_rank() - m*nnghbr;
+    const int m = plist.d_view(tmember.league_rank())/nnghbr;
+    const int n = plist.d_view(tmember.league_rank()) - m*nnghbr;
 
     // only prolongate when neighbor exists and is at coarser level
     if ((nghbr.d_view(m,n).gid >= 0) && (nghbr.d_view(m,n).lev < mblev.d_view(m))) {
@@ -26,8 +26,8 @@
 //! by the prolongation interpolation stencil, data is restricted to coarse array in
 //! boundaries between MeshBlocks at the same level.
 
-void MeshBoundaryValuesCC::FillCoarseInBndryCC(DvceArray5D<Real> &a,
-                                               DvceArray5D<Real> &ca,
+template <typename T>
+void MeshBoundaryValuesCC::FillCoarseInBndryCC(DvceArray5D<T> &a, DvceArray5D<T> &ca,
                                                bool is_z4c) {
   // create local references for variables in kernel
   int nmb = pmy_pack->nmb_thispack;
@@ -39,6 +39,7 @@ void MeshBoundaryValuesCC::FillCoarseInBndryCC(DvceArray5D<Real> &a,
   int nmnv = nmb*nnghbr*nvar;
   auto &nghbr = pmy_pack->pmb->nghbr;
   auto &mblev = pmy_pack->pmb->mb_lev;
+  auto &cidx = pmy_pack->pmb->mb_cidx;
   auto &rbuf = recvbuf;
   auto &indcs  = pmy_pack->pmesh->mb_indcs;
   const bool multi_d = pmy_pack->pmesh->multi_d;
@@ -65,9 +66,11 @@ void MeshBoundaryValuesCC::FillCoarseInBndryCC(DvceArray5D<Real> &a,
       const int m = (tmember.league_rank())/(nnghbr*nvar);
       const int n = (tmember.league_rank() - m*(nnghbr*nvar))/nvar;
       const int v = (tmember.league_rank() - m*(nnghbr*nvar) - n*nvar);
+      const int cm = cidx.d_view(m);  // index of MB in coarse array
 
-      // only restrict when neighbor exists and is at SAME level
-      if ((nghbr.d_view(m,n).gid >= 0) && (nghbr.d_view(m,n).lev == mblev.d_view(m))) {
+      // only restrict when neighbor exists and is at SAME level (and MB has coarse data)
+      if ((nghbr.d_view(m,n).gid >= 0) && (nghbr.d_view(m,n).lev == mblev.d_view(m)) &&
+          (cm >= 0)) {
         // loop over indices for receives at same level, but convert loop limits to
         // coarse array
         int il = (rbuf[n].isame[0].bis + cis)/2;
@@ -98,22 +101,22 @@ void MeshBoundaryValuesCC::FillCoarseInBndryCC(DvceArray5D<Real> &a,
 
           // restrict in 2D
           if (!(three_d)) {
-            ca(m,v,kl,j,i) = 0.25*(a(m,v,kl,finej  ,finei) + a(m,v,kl,finej  ,finei+1)
-                                 + a(m,v,kl,finej+1,finei) + a(m,v,kl,finej+1,finei+1));
+            ca(cm,v,kl,j,i) = 0.25*(a(m,v,kl,finej  ,finei) + a(m,v,kl,finej  ,finei+1)
+                                  + a(m,v,kl,finej+1,finei) + a(m,v,kl,finej+1,finei+1));
           // restrict in 3D
           } else {
             if (!is_z4c) {
-              ca(m,v,k,j,i) = 0.125*(
+              ca(cm,v,k,j,i) = 0.125*(
                   a(m,v,finek  ,finej  ,finei) + a(m,v,finek  ,finej  ,finei+1)
                 + a(m,v,finek  ,finej+1,finei) + a(m,v,finek  ,finej+1,finei+1)
                 + a(m,v,finek+1,finej,  finei) + a(m,v,finek+1,finej,  finei+1)
                 + a(m,v,finek+1,finej+1,finei) + a(m,v,finek+1,finej+1,finei+1));
             } else {
                 switch (indcs.ng) {
-                  case 2: ca(m,v,k,j,i) = RestrictInterpolation<2>(m,v,finek,finej,finei,
+                  case 2: ca(cm,v,k,j,i) = RestrictInterpolation<2>(m,v,finek,finej,finei,
                               nx1,nx2,nx3,a,restrict_2nd,restrict_4th,restrict_4th_edge);
                           break;
-                  case 4: ca(m,v,k,j,i) = RestrictInterpolation<4>(m,v,finek,finej,finei,
+                  case 4: ca(cm,v,k,j,i) = RestrictInterpolation<4>(m,v,finek,finej,finei,
                               nx1,nx2,nx3,a,restrict_2nd,restrict_4th,restrict_4th_edge);
                           break;
                 }
@@ -132,10 +135,10 @@ void MeshBoundaryValuesCC::FillCoarseInBndryCC(DvceArray5D<Real> &a,
 //! \brief Prolongate data at boundaries for cell-centered data.
 //! Code here is based on MeshRefinement::ProlongateCellCenteredValues() in C++ version
 
-void MeshBoundaryValuesCC::ProlongateCC(DvceArray5D<Real> &a, DvceArray5D<Real> &ca,
+template <typename T>
+void MeshBoundaryValuesCC::ProlongateCC(DvceArray5D<T> &a, DvceArray5D<T> &ca,
     bool is_z4c) {
   // create local references for variables in kernel
-  int nmb = pmy_pack->nmb_thispack;
   int nnghbr = pmy_pack->pmb->nnghbr;
 
   // ptr to z4c, which requires different prolongation/restriction scheme
@@ -143,9 +146,11 @@ void MeshBoundaryValuesCC::ProlongateCC(DvceArray5D<Real> &a, DvceArray5D<Real>
   //bool not_z4c = (pmbp->pz4c == nullptr)? true : false;
 
   int nvar = a.extent_int(1);  // TODO(@user): 2nd index from L of in array must be NVAR
-  int nmnv = nmb*nnghbr*nvar;
+  int nmnv = SetProlongationList()*nvar;
+  auto &plist = prol_list;
   auto &nghbr = pmy_pack->pmb->nghbr;
   auto &mblev = pmy_pack->pmb->mb_lev;
+  auto &cidx = pmy_pack->pmb->mb_cidx;
   auto &rbuf = recvbuf;
   auto &indcs  = pmy_pack->pmesh->mb_indcs;
   const bool multi_d = pmy_pack->pmesh->multi_d;
@@ -156,12 +161,14 @@ void MeshBoundaryValuesCC::ProlongateCC(DvceArray5D<Real> &a, DvceArray5D<Real>
   auto& prolong_2nd = pmy_pack->pmesh->pmr->weights.prolong_2nd;
   auto& prolong_4th = pmy_pack->pmesh->pmr->weights.prolong_4th;
 
-  // Outer loop over (# of MeshBlocks)*(# of buffers)*(# of variables)
+  // Outer loop over (# of buffers with coarser neighbors)*(# of variables)
   Kokkos::TeamPolicy<> policy(DevExeSpace(), nmnv, Kokkos::AUTO);
   Kokkos::parallel_for("ProlCC", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-    const int m = (tmember.league_rank())/(nnghbr*nvar);
-    const int n = (tmember.league_rank() - m*(nnghbr*nvar))/nvar;
-    const int v = (tmember.league_rank() - m*(nnghbr*nvar) - n*nvar);
+    const int p = (tmember.league_rank())/nvar;
+    const int v = (tmember.league_rank() - p*nvar);
+    const int m = (plist.d_view(p))/nnghbr;
+    const int n = (plist.d_view(p) - m*nnghbr);
+    const int cm = cidx.d_view(m);  // index of MB in coarse array
 
     // only prolongate when neighbor exists and is at coarser level
     if ((nghbr.d_view(m,n).gid >= 0) && (nghbr.d_view(m,n).lev < mblev.d_view(m))) {
@@ -193,7 +200,7 @@ void MeshBoundaryValuesCC::ProlongateCC(DvceArray5D<Real> &a, DvceArray5D<Real>
         int fk = (k - indcs.cks)*2 + indcs.ks;
         // call inlined prolongation operator for CC variables
         if (!is_z4c) {
-          ProlongCC(m,v,k,j,i,fk,fj,fi,multi_d,three_d,ca,a);
+          ProlongCC(m,cm,v,k,j,i,fk,fj,fi,multi_d,three_d,ca,a);
         } else {
           switch (indcs.ng) {
             case 2: HighOrderProlongCC<2>(m,v,k,j,i,fk,fj,fi,nx1,nx2,nx3,
@@ -227,6 +234,7 @@ void MeshBoundaryValuesFC::FillCoarseInBndryFC(DvceFaceFld4D<Real> &b,
   auto &nghbr = pmy_pack->pmb->nghbr;
   auto &indcs  = pmy_pack->pmesh->mb_indcs;
   auto &mblev = pmy_pack->pmb->mb_lev;
+  auto &cidx = pmy_pack->pmb->mb_cidx;
   bool &multi_d = pmy_pack->pmesh->multi_d;
   bool &three_d = pmy_pack->pmesh->three_d;
 
@@ -245,9 +253,11 @@ void MeshBoundaryValuesFC::FillCoarseInBndryFC(DvceFaceFld4D<Real> &b,
       const int m = (tmember.league_rank())/(3*nnghbr);
       const int n = (tmember.league_rank() - m*(3*nnghbr))/3;
       const int v = (tmember.league_rank() - m*(3*nnghbr) - 3*n);
+      const int cm = cidx.d_view(m);  // index of MB in coarse array
 
-      // only restrict when neighbor exists and is at SAME level
-      if ((nghbr.d_view(m,n).gid >= 0) && (nghbr.d_view(m,n).lev == mblev.d_view(m))) {
+      // only restrict when neighbor exists and is at SAME level (and MB has coarse data)
+      if ((nghbr.d_view(m,n).gid >= 0) && (nghbr.d_view(m,n).lev == mblev.d_view(m)) &&
+          (cm >= 0)) {
         // loop over indices for receives at same level, but convert loop limits to
         // coarse array
         int il = (rbuf[n].isame[v].bis + cis)/2;
@@ -279,27 +289,27 @@ void MeshBoundaryValuesFC::FillCoarseInBndryFC(DvceFaceFld4D<Real> &b,
           // restrict in 2D
           if (!(three_d)) {
             if (v==0) {
-              cb.x1f(m,kl,j,i) = 0.5*(b.x1f(m,kl,fj,fi) + b.x1f(m,kl,fj+1,fi));
+              cb.x1f(cm,kl,j,i) = 0.5*(b.x1f(m,kl,fj,fi) + b.x1f(m,kl,fj+1,fi));
             } else if (v==1) {
-              cb.x2f(m,kl,j,i) = 0.5*(b.x2f(m,kl,fj,fi) + b.x2f(m,kl,fj,fi+1));
+              cb.x2f(cm,kl,j,i) = 0.5*(b.x2f(m,kl,fj,fi) + b.x2f(m,kl,fj,fi+1));
             } else {
               Real b3c = 0.25*(b.x3f(m,kl,fj  ,fi) + b.x3f(m,kl,fj  ,fi+1)
                              + b.x3f(m,kl,fj+1,fi) + b.x3f(m,kl,fj+1,fi+1));
-              cb.x3f(m,kl  ,j,i) = b3c;
-              cb.x3f(m,kl+1,j,i) = b3c;
+              cb.x3f(cm,kl  ,j,i) = b3c;
+              cb.x3f(cm,kl+1,j,i) = b3c;
             }
 
           // restrict in 3D
           } else {
             if (v==0) {
-              cb.x1f(m,k,j,i) = 0.25*(b.x1f(m,fk  ,fj,fi) + b.x1f(m,fk  ,fj+1,fi)
-                                    + b.x1f(m,fk+1,fj,fi) + b.x1f(m,fk+1,fj+1,fi));
+              cb.x1f(cm,k,j,i) = 0.25*(b.x1f(m,fk  ,fj,fi) + b.x1f(m,fk  ,fj+1,fi)
+                                     + b.x1f(m,fk+1,fj,fi) + b.x1f(m,fk+1,fj+1,fi));
             } else if (v==1) {
-              cb.x2f(m,k,j,i) = 0.25*(b.x2f(m,fk  ,fj,fi) + b.x2f(m,fk  ,fj,fi+1)
-                                    + b.x2f(m,fk+1,fj,fi) + b.x2f(m,fk+1,fj,fi+1));
+              cb.x2f(cm,k,j,i) = 0.25*(b.x2f(m,fk  ,fj,fi) + b.x2f(m,fk  ,fj,fi+1)
+                                     + b.x2f(m,fk+1,fj,fi) + b.x2f(m,fk+1,fj,fi+1));
             } else {
-              cb.x3f(m,k,j,i) = 0.25*(b.x3f(m,fk,fj  ,fi) + b.x3f(m,fk,fj  ,fi+1)
-                                    + b.x3f(m,fk,fj+1,fi) + b.x3f(m,fk,fj+1,fi+1));
+              cb.x3f(cm,k,j,i) = 0.25*(b.x3f(m,fk,fj  ,fi) + b.x3f(m,fk,fj  ,fi+1)
+                                     + b.x3f(m,fk,fj+1,fi) + b.x3f(m,fk,fj+1,fi+1));
             }
           }
         });
@@ -316,12 +326,12 @@ void MeshBoundaryValuesFC::FillCoarseInBndryFC(DvceFaceFld4D<Real> &b,
 
 void MeshBoundaryValuesFC::ProlongateFC(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Real> &cb) {
   // create local references for variables in kernel
-  int nmb = pmy_pack->nmb_thispack;
   int nnghbr = pmy_pack->pmb->nnghbr;
 
   auto &nghbr = pmy_pack->pmb->nghbr;
   auto &indcs  = pmy_pack->pmesh->mb_indcs;
   auto &mblev = pmy_pack->pmb->mb_lev;
+  auto &cidx = pmy_pack->pmb->mb_cidx;
   bool &multi_d = pmy_pack->pmesh->multi_d;
   bool &three_d = pmy_pack->pmesh->three_d;
 
@@ -329,14 +339,19 @@ void MeshBoundaryValuesFC::ProlongateFC(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Re
   // Code here is based on MeshRefinement::ProlongateSharedFieldX1/2/3() and
   // MeshRefinement::ProlongateInternalField() in C++ version
 
-  // Outer loop over (# of MeshBlocks)*(# of buffers)*(three field components)
-  {int nmnv = 3*nmb*nnghbr;
+  int nprol = SetProlongationList();
+  auto &plist = prol_list;
+
+  // Outer loop over (# of buffers with coarser neighbors)*(three field components)
+  {int nmnv = 3*nprol;
   auto &rbuf = recvbuf;
   Kokkos::TeamPolicy<> policy(DevExeSpace(), nmnv, Kokkos::AUTO);
   Kokkos::parallel_for("ProFC-2d-shared", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-    const int m = (tmember.league_rank())/(3*nnghbr);
-    const int n = (tmember.league_rank() - m*(3*nnghbr))/3;
-    const int v = (tmember.league_rank() - m*(3*nnghbr) - 3*n);
+    const int p = (tmember.league_rank())/3;
+    const int v = (tmember.league_rank() - 3*p);
+    const int m = (plist.d_view(p))/nnghbr;
+    const int n = (plist.d_view(p) - m*nnghbr);
+    const int cm = cidx.d_view(m);  // index of MB in coarse array
 
     // only prolongate when neighbor exists and is at coarser level
     if ((nghbr.d_view(m,n).gid >= 0) && (nghbr.d_view(m,n).lev < mblev.d_view(m))) {
@@ -367,11 +382,11 @@ void MeshBoundaryValuesFC::ProlongateFC(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Re
         // Prolongate face-centered fields at shared faces betwen fine and coarse cells
         // by calling inlined prolongation operator for FC variables
         if (v==0) {
-          ProlongFCSharedX1Face(m,k,j,i,fk,fj,fi,multi_d,three_d,cb.x1f,b.x1f);
+          ProlongFCSharedX1Face(m,cm,k,j,i,fk,fj,fi,multi_d,three_d,cb.x1f,b.x1f);
         } else if (v==1) {
-          ProlongFCSharedX2Face(m,k,j,i,fk,fj,fi,three_d,cb.x2f,b.x2f);
+          ProlongFCSharedX2Face(m,cm,k,j,i,fk,fj,fi,three_d,cb.x2f,b.x2f);
         } else {
-          ProlongFCSharedX3Face(m,k,j,i,fk,fj,fi,multi_d,cb.x3f,b.x3f);
+          ProlongFCSharedX3Face(m,cm,k,j,i,fk,fj,fi,multi_d,cb.x3f,b.x3f);
         }
       });
       tmember.team_barrier();
@@ -383,14 +398,13 @@ void MeshBoundaryValuesFC::ProlongateFC(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Re
   // Note prolongation at shared coarse/fine cell edges must be completed first as
   // interpolation formulae use these values.
 
-  // Outer loop over (# of MeshBlocks)*(# of buffers)
-  {int nmn = nmb*nnghbr;
-  bool &one_d = pmy_pack->pmesh->one_d;
+  // Outer loop over (# of buffers with coarser neighbors)
+  {bool &one_d = pmy_pack->pmesh->one_d;
   auto &rbuf = recvbuf;
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), nmn, Kokkos::AUTO);
+  Kokkos::TeamPolicy<> policy(DevExeSpace(), nprol, Kokkos::AUTO);
   Kokkos::parallel_for("ProFC-2d-int", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-    const int m = (tmember.league_rank())/(nnghbr);
-    const int n = (tmember.league_rank() - m*(nnghbr));
+    const int m = (plist.d_view(tmember.league_rank()))/nnghbr;
+    const int n = (plist.d_view(tmember.league_rank()) - m*nnghbr);
 
     // only prolongate when neighbor exists and is at coarser level
     if ((nghbr.d_view(m,n).gid >= 0) && (nghbr.d_view(m,n).lev < mblev.d_view(m))) {
@@ -433,3 +447,15 @@ void MeshBoundaryValuesFC::ProlongateFC(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Re
 
   return;
 }
+
+// function definitions for each template parameter
+template void MeshBoundaryValuesCC::FillCoarseInBndryCC<Real>(DvceArray5D<Real> &a,
+  DvceArray5D<Real> &ca, bool is_z4c);
+template void MeshBoundaryValuesCC::ProlongateCC<Real>(DvceArray5D<Real> &a,
+  DvceArray5D<Real> &ca, bool is_z4c);
+#if RAD_MIXED_PRECISION_ENABLED
+template void MeshBoundaryValuesCC::FillCoarseInBndryCC<RadReal>(DvceArray5D<RadReal> &a,
+  DvceArray5D<RadReal> &ca, bool is_z4c);
+template void MeshBoundaryValuesCC::ProlongateCC<RadReal>(DvceArray5D<RadReal> &a,
+  DvceArray5D<RadReal> &ca, bool is_z4c);
+#endif
@@ -6,6 +6,7 @@
 //! \file adm.cpp
 //  \brief implementation of ADM class
 #include <algorithm>
+#include <iostream>
 
 #include "coordinates/adm.hpp"
 #include "athena.hpp"
@@ -13,6 +14,7 @@
 #include "mesh/mesh.hpp"
 #include "mesh/meshblock_pack.hpp"
 #include "z4c/z4c.hpp"
+#include "eos/primitive-solver/geom_math.hpp"
 
 namespace adm {
 char const * const ADM::ADM_names[ADM::nadm] = {
@@ -26,7 +28,11 @@ char const * const ADM::ADM_names[ADM::nadm] = {
 // constructor: initializes data structures and parameters
 ADM::ADM(MeshBlockPack *ppack, ParameterInput *pin):
   pmy_pack(ppack),
-  u_adm("u_adm",1,1,1,1,1) {
+  u_adm("u_adm",1,1,1,1,1),
+  cc_metric("cc_metric",1,1,1,1,1),
+  fc_metric1("fc_metric1",1,1,1,1,1),
+  fc_metric2("fc_metric2",1,1,1,1,1),
+  fc_metric3("fc_metric3",1,1,1,1,1) {
   int nmb = std::max((ppack->nmb_thispack), (ppack->pmesh->nmb_maxperrank));
   auto &indcs = pmy_pack->pmesh->mb_indcs;
   int ncells1 = indcs.nx1 + 2*(indcs.ng);
@@ -47,6 +53,87 @@ ADM::ADM(MeshBlockPack *ppack, ParameterInput *pin):
   adm.psi4.InitWithShallowSlice(u_adm, I_ADM_PSI4);
   adm.g_dd.InitWithShallowSlice(u_adm, I_ADM_GXX, I_ADM_GZZ);
   adm.vK_dd.InitWithShallowSlice(u_adm, I_ADM_KXX, I_ADM_KZZ);
+  adm_fluid = adm;
+
+  // caching is only valid if the metric never changes after initialization
+  metric_cached = false;
+  cache_metric = pin->GetOrAddBoolean("adm", "cache_metric", false);
+  if (cache_metric && (pmy_pack->pz4c != nullptr || pmy_pack->pmesh->adaptive)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "<adm> cache_metric = true requires a fixed spacetime "
+              << "(no <z4c> block) and no mesh refinement" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  if (cache_metric) {
+    Kokkos::realloc(cc_metric, nmb, ncc_metric, ncells3, ncells2, ncells1);
+    Kokkos::realloc(fc_metric1, nmb, nfc_metric, ncells3, ncells2, ncells1);
+    if (indcs.nx2 > 1) {
+      Kokkos::realloc(fc_metric2, nmb, nfc_metric, ncells3, ncells2, ncells1);
+    }
+    if (indcs.nx3 > 1) {
+      Kokkos::realloc(fc_metric3, nmb, nfc_metric, ncells3, ncells2, ncells1);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ADM::CacheMetric()
+//! \brief Fills cc_metric and fc_metric{1,2,3} from the current metric, with the same
+//! operations used by C2P and the face interpolation in the Riemann solvers, so results
+//! are unchanged.  Called once the metric is set (in Driver::Initialize).
+
+void ADM::CacheMetric() {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int nmb = pmy_pack->nmb_thispack;
+  int n1m1 = indcs.nx1 + 2*indcs.ng - 1;
+  int n2m1 = (indcs.nx2 > 1)? (indcs.nx2 + 2*indcs.ng - 1) : 0;
+  int n3m1 = (indcs.nx3 > 1)? (indcs.nx3 + 2*indcs.ng - 1) : 0;
+  bool multi_d = pmy_pack->pmesh->multi_d;
+  bool three_d = pmy_pack->pmesh->three_d;
+  auto &adm_ = adm;
+  auto &cc = cc_metric;
+  auto &fc1 = fc_metric1, &fc2 = fc_metric2, &fc3 = fc_metric3;
+
+  par_for("adm_cache_metric",DevExeSpace(),0,nmb-1,0,n3m1,0,n2m1,0,n1m1,
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    Real g3d[NSPMETRIC], g3u[NSPMETRIC], beta_u[3], alpha;
+    g3d[S11] = adm_.g_dd(m,0,0,k,j,i);
+    g3d[S12] = adm_.g_dd(m,0,1,k,j,i);
+    g3d[S13] = adm_.g_dd(m,0,2,k,j,i);
+    g3d[S22] = adm_.g_dd(m,1,1,k,j,i);
+    g3d[S23] = adm_.g_dd(m,1,2,k,j,i);
+    g3d[S33] = adm_.g_dd(m,2,2,k,j,i);
+    Real detg = Primitive::GetDeterminant(g3d);
+    SpatialInv(1.0/detg, g3d[S11], g3d[S12], g3d[S13], g3d[S22], g3d[S23], g3d[S33],
+               &g3u[S11], &g3u[S12], &g3u[S13], &g3u[S22], &g3u[S23], &g3u[S33]);
+    cc(m,I_CC_SDETG,k,j,i) = sqrt(detg);
+    for (int n=0; n<NSPMETRIC; ++n) {
+      cc(m,I_CC_GUXX+n,k,j,i) = g3u[n];
+    }
+
+    if (i > 0) {
+      Face1Metric(m, k, j, i, adm_.g_dd, adm_.beta_u, adm_.alpha, g3d, beta_u, alpha);
+      for (int n=0; n<NSPMETRIC; ++n) {fc1(m,I_FC_GXX+n,k,j,i) = g3d[n];}
+      for (int a=0; a<3; ++a) {fc1(m,I_FC_BETAX+a,k,j,i) = beta_u[a];}
+      fc1(m,I_FC_ALPHA,k,j,i) = alpha;
+      fc1(m,I_FC_SDETG,k,j,i) = sqrt(Primitive::GetDeterminant(g3d));
+    }
+    if (multi_d && j > 0) {
+      Face2Metric(m, k, j, i, adm_.g_dd, adm_.beta_u, adm_.alpha, g3d, beta_u, alpha);
+      for (int n=0; n<NSPMETRIC; ++n) {fc2(m,I_FC_GXX+n,k,j,i) = g3d[n];}
+      for (int a=0; a<3; ++a) {fc2(m,I_FC_BETAX+a,k,j,i) = beta_u[a];}
+      fc2(m,I_FC_ALPHA,k,j,i) = alpha;
+      fc2(m,I_FC_SDETG,k,j,i) = sqrt(Primitive::GetDeterminant(g3d));
+    }
+    if (three_d && k > 0) {
+      Face3Metric(m, k, j, i, adm_.g_dd, adm_.beta_u, adm_.alpha, g3d, beta_u, alpha);
+      for (int n=0; n<NSPMETRIC; ++n) {fc3(m,I_FC_GXX+n,k,j,i) = g3d[n];}
+      for (int a=0; a<3; ++a) {fc3(m,I_FC_BETAX+a,k,j,i) = beta_u[a];}
+      fc3(m,I_FC_ALPHA,k,j,i) = alpha;
+      fc3(m,I_FC_SDETG,k,j,i) = sqrt(Primitive::GetDeterminant(g3d));
+    }
+  });
+  metric_cached = true;
 }
 
 //----------------------------------------------------------------------------------------
@@ -45,6 +45,9 @@ class ADM {
     AthenaTensor<Real, TensorSymm::SYM2, 3, 2> vK_dd;      // extrinsic curvature
   };
   ADM_vars adm;
+  // metric seen by the fluid.  Same arrays as adm, except during the fluid step of
+  // multirate evolution, where it holds the metric interpolated in time (see DynGRMHD)
+  ADM_vars adm_fluid;
 
   struct ADMhost_vars {
     AthenaHostTensor<Real, TensorSymm::NONE, 3, 0> alpha;
@@ -56,6 +59,25 @@ class ADM {
 
   DvceArray5D<Real> u_adm;                                   // adm variables
 
+  // Metric-derived quantities used by DynGRMHD, computed once for a fixed spacetime
+  // (no Z4c).  Cell-centered sqrt(det g) and inverse metric are used in C2P, and the
+  // metric, lapse, shift and sqrt(det g) at faces are used in the Riemann solvers.
+  // Face i (j, k) lies between cells i-1 and i.
+  enum {
+    I_CC_SDETG, I_CC_GUXX, I_CC_GUXY, I_CC_GUXZ, I_CC_GUYY, I_CC_GUYZ, I_CC_GUZZ,
+    ncc_metric
+  };
+  enum {
+    I_FC_GXX, I_FC_GXY, I_FC_GXZ, I_FC_GYY, I_FC_GYZ, I_FC_GZZ,
+    I_FC_BETAX, I_FC_BETAY, I_FC_BETAZ, I_FC_ALPHA, I_FC_SDETG,
+    nfc_metric
+  };
+  bool cache_metric;          // true to cache metric-derived quantities
+  bool metric_cached;         // true once cache has been filled
+  DvceArray5D<Real> cc_metric;
+  DvceArray5D<Real> fc_metric1, fc_metric2, fc_metric3;
+  void CacheMetric();
+
   // TODO(Francesco): handle regridding
 
  private:
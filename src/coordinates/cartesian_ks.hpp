@@ -378,5 +378,69 @@ void ComputeMetricDerivatives(Real x, Real y, Real z, bool minkowski, Real a,
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void CachedMetricAndInverse
+//! \brief loads 10 covariant and contravariant components of metric at one location from
+//!  array computed by Coordinates::SetMetricCache().  Components (0,1,...,9) of the cache
+//!  store the covariant components (00,01,02,03,11,12,13,22,23,33), and components
+//!  (10,...,19) the contravariant components in the same order.  In compact mode only the
+//!  covariant components are stored, and since g_nm = eta_nm + f*l_n*l_m with l_0=1 and
+//!  l^n = (-1,l_1,l_2,l_3), the inverse follows exactly as g^00 = -2-g_00, g^0i = g_0i,
+//!  and g^ij = 2*delta_ij - g_ij.
+
+KOKKOS_INLINE_FUNCTION
+void CachedMetricAndInverse(const DvceArray5D<Real> &g, const bool compact,
+                            const int m, const int k, const int j, const int i,
+                            Real glower[][4], Real gupper[][4]) {
+  int n = 0;
+  for (int a=0; a<4; ++a) {
+    for (int b=a; b<4; ++b) {
+      glower[a][b] = g(m,n,k,j,i);
+      glower[b][a] = glower[a][b];
+      if (compact) {
+        if (a == 0 && b == 0) {
+          gupper[a][b] = -2.0 - glower[a][b];
+        } else if (a == 0) {
+          gupper[a][b] = glower[a][b];
+        } else if (a == b) {
+          gupper[a][b] = 2.0 - glower[a][b];
+        } else {
+          gupper[a][b] = -glower[a][b];
+        }
+      } else {
+        gupper[a][b] = g(m,n+10,k,j,i);
+      }
+      gupper[b][a] = gupper[a][b];
+      n++;
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void CachedMetricDerivatives
+//! \brief loads derivatives of covariant components of metric at one cell center from
+//!  array computed by Coordinates::SetMetricCache().  Only stored in full (not compact)
+//!  mode, as components (20,...,29), (30,...,39), and (40,...,49) for the x1-, x2-, and
+//!  x3-derivatives respectively, each in the same order as above.
+
+KOKKOS_INLINE_FUNCTION
+void CachedMetricDerivatives(const DvceArray5D<Real> &g,
+                             const int m, const int k, const int j, const int i,
+                             Real dg_dx1[][4], Real dg_dx2[][4], Real dg_dx3[][4]) {
+  int n = 20;
+  for (int a=0; a<4; ++a) {
+    for (int b=a; b<4; ++b) {
+      dg_dx1[a][b] = g(m,n   ,k,j,i);
+      dg_dx2[a][b] = g(m,n+10,k,j,i);
+      dg_dx3[a][b] = g(m,n+20,k,j,i);
+      dg_dx1[b][a] = dg_dx1[a][b];
+      dg_dx2[b][a] = dg_dx2[a][b];
+      dg_dx3[b][a] = dg_dx3[a][b];
+      n++;
+    }
+  }
+  return;
+}
 
 #endif // COORDINATES_CARTESIAN_KS_HPP_
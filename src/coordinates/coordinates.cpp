@@ -23,7 +23,9 @@
 Coordinates::Coordinates(ParameterInput *pin, MeshBlockPack *ppack) :
     pmy_pack(ppack),
     excision_floor("excision_floor",1,1,1,1),
-    excision_flux("excision_flux",1,1,1,1) {
+    excision_flux("excision_flux",1,1,1,1),
+    excision_pencil("excision_pencil",1,1,1),
+    excision_mb("excision_mb",1) {
   // Check for relativistic dynamics
   // WGC: idea for handling new EOS
   is_dynamical_relativistic = (pin->DoesBlockExist("adm") || pin->DoesBlockExist("z4c"))
@@ -40,6 +42,47 @@ Coordinates::Coordinates(ParameterInput *pin, MeshBlockPack *ppack) :
     std::exit(EXIT_FAILURE);
   }
 
+  // Select coordinates of the mesh.  In spherical-polar coordinates the mesh is uniform
+  // in (x1,x2,x3) = (ln r,theta,phi), which is only implemented for non-relativistic
+  // hydrodynamics on uniform grids (geometric terms are added in the hydro update).
+  std::string coords = pin->GetOrAddString("coord","coordinates","cartesian");
+  if (coords.compare("spherical_polar") == 0) {
+    is_spherical_polar = true;
+  } else if (coords.compare("cartesian") != 0) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<coord>/coordinates = '" << coords << "' not implemented, use "
+              << "'cartesian' or 'spherical_polar'" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  if (is_spherical_polar) {
+    std::string evolution_t = pin->GetString("time","evolution");
+    if (is_special_relativistic || is_general_relativistic ||
+        is_dynamical_relativistic || ppack->pmesh->multilevel ||
+        !(pin->DoesBlockExist("hydro")) || pin->DoesBlockExist("mhd") ||
+        pin->DoesBlockExist("radiation") || pin->DoesBlockExist("particles") ||
+        pin->DoesBlockExist("shearing_box") || pin->DoesBlockExist("turb_driving") ||
+        pin->DoesBlockExist("self_gravity") || evolution_t.compare("dynamic") != 0 ||
+        pin->DoesParameterExist("hydro","viscosity") ||
+        pin->DoesParameterExist("hydro","conductivity") ||
+        pin->DoesParameterExist("hydro","tdep_conductivity") ||
+        pin->GetOrAddBoolean("hydro","fofc",false)) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<coord>/coordinates = spherical_polar requires dynamic "
+                << "non-relativistic hydrodynamics on a uniform grid without MHD, "
+                << "diffusion, FOFC, shearing box, turbulence driving, self-gravity, "
+                << "radiation, or particles" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    auto &msize = ppack->pmesh->mesh_size;
+    if (msize.x2min < 0.0 || msize.x2max > M_PI ||
+        (msize.x3max - msize.x3min) > 2.0*M_PI) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "In spherical_polar coordinates x2 (theta) must lie in "
+                << "[0,pi] and x3 (phi) must span at most 2*pi" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  }
+
   // Read properties of metric and excision from input file for GR.
   if (is_general_relativistic || is_dynamical_relativistic) {
     coord_data.is_minkowski = pin->GetOrAddBoolean("coord","minkowski",false);
@@ -70,6 +113,12 @@ Coordinates::Coordinates(ParameterInput *pin, MeshBlockPack *ppack) :
         } else if (emethod.compare("lapse") == 0) {
           coord_data.excision_scheme = ExcisionScheme::lapse;
           coord_data.excise_lapse = pin->GetOrAddReal("coord","excise_lapse", 0.25);
+        } else if (emethod.compare("horizon") == 0) {
+          // lapse criterion is used until the first apparent horizon is found
+          coord_data.excision_scheme = ExcisionScheme::horizon;
+          coord_data.excise_lapse = pin->GetOrAddReal("coord","excise_lapse", 0.25);
+          coord_data.excise_horizon_frac =
+            pin->GetOrAddReal("coord","excise_horizon_frac", 0.8);
         } else {
           std::cout << "### FATAL ERROR in " << __FILE__ << " at line "
                     << __LINE__ << std::endl
@@ -86,11 +135,132 @@ Coordinates::Coordinates(ParameterInput *pin, MeshBlockPack *ppack) :
       int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
       Kokkos::realloc(excision_floor, nmb, ncells3, ncells2, ncells1);
       Kokkos::realloc(excision_flux, nmb, ncells3, ncells2, ncells1);
+      Kokkos::realloc(excision_pencil, nmb, ncells3, ncells2);
+      Kokkos::realloc(excision_mb, nmb);
       if (coord_data.excision_scheme == ExcisionScheme::fixed) {
         SetExcisionMasks(excision_floor, excision_flux);
+        SetExcisionBlockMasks();
       }
     }
   }
+
+  // Optionally cache the (stationary) metric at cell centers and faces.  Since the
+  // Coordinates object is re-constructed after each mesh refinement, the cache is then
+  // automatically recomputed for the new MeshBlocks.
+  if (is_general_relativistic) {
+    std::string cache = pin->GetOrAddString("coord","metric_cache","none");
+    if (cache.compare("full") == 0) {
+      coord_data.metric_cached = true;
+      coord_data.metric_compact = false;
+    } else if (cache.compare("compact") == 0) {
+      coord_data.metric_cached = true;
+      coord_data.metric_compact = true;
+    } else if (cache.compare("none") != 0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<coord>/metric_cache = '" << cache << "' not "
+                << "implemented, use 'none', 'full', or 'compact'" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    if (coord_data.metric_cached) {
+      SetMetricCache();
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Coordinates::SetMetricCache()
+//! \brief Computes and stores the metric in Cartesian Kerr-Schild coordinates at all cell
+//! centers and faces (including ghost zones), so that it need not be recomputed in every
+//! kernel each stage.  In full mode the contravariant components at centers and faces,
+//! and the derivatives used in the coordinate source terms at centers, are also stored.
+//! In compact mode only the 10 covariant components are stored (see the inline function
+//! CachedMetricAndInverse() for how the inverse is recovered).  Note sqrt(-g)=1 in these
+//! coordinates, so it is never stored.
+
+void Coordinates::SetMetricCache() {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, js = indcs.js, ks = indcs.ks;
+  int n1 = indcs.nx1 + 2*(indcs.ng);
+  int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
+  int n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
+  int nmb = pmy_pack->nmb_thispack;
+  bool compact = coord_data.metric_compact;
+  int ncc = (compact)? 10 : 50;
+  int nfc = (compact)? 10 : 20;
+  Kokkos::realloc(coord_data.gcc, nmb, ncc, n3, n2, n1);
+  Kokkos::realloc(coord_data.gx1f, nmb, nfc, n3, n2, n1+1);
+  Kokkos::realloc(coord_data.gx2f, nmb, nfc, n3, n2+1, n1);
+  Kokkos::realloc(coord_data.gx3f, nmb, nfc, n3+1, n2, n1);
+
+  auto &size = pmy_pack->pmb->mb_size;
+  auto &flat = coord_data.is_minkowski;
+  auto &spin = coord_data.bh_spin;
+  auto &gcc_ = coord_data.gcc;
+  par_for("metric_cc", DevExeSpace(), 0, (nmb-1), 0, (n3-1), 0, (n2-1), 0, (n1-1),
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    Real &x1min = size.d_view(m).x1min, &x1max = size.d_view(m).x1max;
+    Real &x2min = size.d_view(m).x2min, &x2max = size.d_view(m).x2max;
+    Real &x3min = size.d_view(m).x3min, &x3max = size.d_view(m).x3max;
+    Real x1v = CellCenterX(i-is, indcs.nx1, x1min, x1max);
+    Real x2v = CellCenterX(j-js, indcs.nx2, x2min, x2max);
+    Real x3v = CellCenterX(k-ks, indcs.nx3, x3min, x3max);
+
+    Real glower[4][4], gupper[4][4];
+    ComputeMetricAndInverse(x1v, x2v, x3v, flat, spin, glower, gupper);
+    Real dg_dx1[4][4], dg_dx2[4][4], dg_dx3[4][4];
+    if (!(compact)) {
+      ComputeMetricDerivatives(x1v, x2v, x3v, flat, spin, dg_dx1, dg_dx2, dg_dx3);
+    }
+    int n = 0;
+    for (int a=0; a<4; ++a) {
+      for (int b=a; b<4; ++b) {
+        gcc_(m,n,k,j,i) = glower[a][b];
+        if (!(compact)) {
+          gcc_(m,n+10,k,j,i) = gupper[a][b];
+          gcc_(m,n+20,k,j,i) = dg_dx1[a][b];
+          gcc_(m,n+30,k,j,i) = dg_dx2[a][b];
+          gcc_(m,n+40,k,j,i) = dg_dx3[a][b];
+        }
+        n++;
+      }
+    }
+  });
+
+  // metric at faces in each direction (only the face-centered coordinate differs)
+  for (int dir=1; dir<=3; ++dir) {
+    auto g_ = (dir == 1)? coord_data.gx1f :
+              ((dir == 2)? coord_data.gx2f : coord_data.gx3f);
+    int f1 = (dir == 1)? 1 : 0;
+    int f2 = (dir == 2)? 1 : 0;
+    int f3 = (dir == 3)? 1 : 0;
+    par_for("metric_fc", DevExeSpace(), 0, (nmb-1), 0, (n3-1+f3), 0, (n2-1+f2),
+            0, (n1-1+f1),
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      Real &x1min = size.d_view(m).x1min, &x1max = size.d_view(m).x1max;
+      Real &x2min = size.d_view(m).x2min, &x2max = size.d_view(m).x2max;
+      Real &x3min = size.d_view(m).x3min, &x3max = size.d_view(m).x3max;
+      Real x1v = (f1 == 1)? LeftEdgeX  (i-is, indcs.nx1, x1min, x1max) :
+                            CellCenterX(i-is, indcs.nx1, x1min, x1max);
+      Real x2v = (f2 == 1)? LeftEdgeX  (j-js, indcs.nx2, x2min, x2max) :
+                            CellCenterX(j-js, indcs.nx2, x2min, x2max);
+      Real x3v = (f3 == 1)? LeftEdgeX  (k-ks, indcs.nx3, x3min, x3max) :
+                            CellCenterX(k-ks, indcs.nx3, x3min, x3max);
+
+      Real glower[4][4], gupper[4][4];
+      ComputeMetricAndInverse(x1v, x2v, x3v, flat, spin, glower, gupper);
+      int n = 0;
+      for (int a=0; a<4; ++a) {
+        for (int b=a; b<4; ++b) {
+          g_(m,n,k,j,i) = glower[a][b];
+          if (!(compact)) {
+            g_(m,n+10,k,j,i) = gupper[a][b];
+          }
+          n++;
+        }
+      }
+    });
+  }
+  return;
 }
 
 //----------------------------------------------------------------------------------------
@@ -107,12 +277,20 @@ void Coordinates::CoordSrcTerms(const DvceArray5D<Real> &prim, const EOS_Data &e
   auto &size = pmy_pack->pmb->mb_size;
   auto &flat = coord_data.is_minkowski;
   auto &spin = coord_data.bh_spin;
+  bool &cached = coord_data.metric_cached;
+  bool &compact = coord_data.metric_compact;
+  auto &gcc_ = coord_data.gcc;
+  bool &excise = coord_data.bh_excise;
+  auto &excision_floor_ = excision_floor;
 
   Real gamma_prime = eos.gamma / (eos.gamma - 1.0);
 
   int nmb1 = pmy_pack->nmb_thispack - 1;
   par_for("coord_src", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie,
   KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    // skip excised cells, conserved variables there are reset in ConsToPrim
+    if (excise && excision_floor_(m,k,j,i)) return;
+
     // Extract components of metric
     Real &x1min = size.d_view(m).x1min;
     Real &x1max = size.d_view(m).x1max;
@@ -127,7 +305,11 @@ void Coordinates::CoordSrcTerms(const DvceArray5D<Real> &prim, const EOS_Data &e
     Real x3v = CellCenterX(k-ks, indcs.nx3, x3min, x3max);
 
     Real glower[4][4], gupper[4][4];
-    ComputeMetricAndInverse(x1v, x2v, x3v, flat, spin, glower, gupper);
+    if (cached) {
+      CachedMetricAndInverse(gcc_, compact, m, k, j, i, glower, gupper);
+    } else {
+      ComputeMetricAndInverse(x1v, x2v, x3v, flat, spin, glower, gupper);
+    }
 
     // Extract primitives
     const Real &rho  = prim(m,IDN,k,j,i);
@@ -164,7 +346,11 @@ void Coordinates::CoordSrcTerms(const DvceArray5D<Real> &prim, const EOS_Data &e
 
     // compute derivates of metric.
     Real dg_dx1[4][4], dg_dx2[4][4], dg_dx3[4][4];
-    ComputeMetricDerivatives(x1v, x2v, x3v, flat, spin, dg_dx1, dg_dx2, dg_dx3);
+    if (cached && !(compact)) {
+      CachedMetricDerivatives(gcc_, m, k, j, i, dg_dx1, dg_dx2, dg_dx3);
+    } else {
+      ComputeMetricDerivatives(x1v, x2v, x3v, flat, spin, dg_dx1, dg_dx2, dg_dx3);
+    }
 
     // Calculate source terms, exploiting symmetries
     Real s_1 = 0.0, s_2 = 0.0, s_3 = 0.0;
@@ -230,12 +416,20 @@ void Coordinates::CoordSrcTerms(const DvceArray5D<Real> &prim,
   auto &size = pmy_pack->pmb->mb_size;
   auto &flat = coord_data.is_minkowski;
   auto &spin = coord_data.bh_spin;
+  bool &cached = coord_data.metric_cached;
+  bool &compact = coord_data.metric_compact;
+  auto &gcc_ = coord_data.gcc;
+  bool &excise = coord_data.bh_excise;
+  auto &excision_floor_ = excision_floor;
 
   Real gamma_prime = eos.gamma / (eos.gamma - 1.0);
 
   int nmb1 = pmy_pack->nmb_thispack - 1;
   par_for("coord_src", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie,
   KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    // skip excised cells, conserved variables there are reset in ConsToPrim
+    if (excise && excision_floor_(m,k,j,i)) return;
+
     // Extract components of metric
     Real &x1min = size.d_view(m).x1min;
     Real &x1max = size.d_view(m).x1max;
@@ -250,7 +444,11 @@ void Coordinates::CoordSrcTerms(const DvceArray5D<Real> &prim,
     Real x3v = CellCenterX(k-ks, indcs.nx3, x3min, x3max);
 
     Real glower[4][4], gupper[4][4];
-    ComputeMetricAndInverse(x1v, x2v, x3v, flat, spin, glower, gupper);
+    if (cached) {
+      CachedMetricAndInverse(gcc_, compact, m, k, j, i, glower, gupper);
+    } else {
+      ComputeMetricAndInverse(x1v, x2v, x3v, flat, spin, glower, gupper);
+    }
 
     // Extract primitives
     const Real &rho  = prim(m,IDN,k,j,i);
@@ -308,7 +506,11 @@ void Coordinates::CoordSrcTerms(const DvceArray5D<Real> &prim,
 
     // compute derivates of metric.
     Real dg_dx1[4][4], dg_dx2[4][4], dg_dx3[4][4];
-    ComputeMetricDerivatives(x1v, x2v, x3v, flat, spin, dg_dx1, dg_dx2, dg_dx3);
+    if (cached && !(compact)) {
+      CachedMetricDerivatives(gcc_, m, k, j, i, dg_dx1, dg_dx2, dg_dx3);
+    } else {
+      ComputeMetricDerivatives(x1v, x2v, x3v, flat, spin, dg_dx1, dg_dx2, dg_dx3);
+    }
 
     // Calculate source terms
     Real s_1 = 0.0, s_2 = 0.0, s_3 = 0.0;
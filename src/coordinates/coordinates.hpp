@@ -9,7 +9,8 @@
 //! \brief implemention of light-weight coordinates class.  Provides data structure that
 //! stores array of RegionSizes over (# of MeshBlocks), and inline functions for
 //! computing positions.  In GR, also provides inline metric functions (currently only
-//! Cartesian Kerr-Schild)
+//! Cartesian Kerr-Schild).  Non-relativistic hydrodynamics can instead use logarithmic
+//! spherical-polar coordinates (see spherical_polar.hpp)
 
 #include "athena.hpp"
 #include "parameter_input.hpp"
@@ -21,7 +22,8 @@ struct EOS_Data;
 // Enumerator for the excision method
 enum class ExcisionScheme {
   fixed,
-  lapse
+  lapse,
+  horizon
 };
 
 //----------------------------------------------------------------------------------------
@@ -41,6 +43,14 @@ struct CoordData {
   Real flux_excise_r;              // reduce to first-order inside this radius
   ExcisionScheme excision_scheme;  // excision method
   Real excise_lapse;               // if excision_scheme = lapse, excise under this lapse
+  Real excise_horizon_frac;        // if excision_scheme = horizon, excise inside this
+                                   // fraction of the apparent horizon radius
+
+  // optional cache of (stationary) metric in GR, see Coordinates::SetMetricCache()
+  bool metric_cached = false;      // flag to use cached metric
+  bool metric_compact = false;     // flag to store only covariant components of metric
+  DvceArray5D<Real> gcc;           // metric (and derivatives) at cell centers
+  DvceArray5D<Real> gx1f, gx2f, gx3f;  // metric at x1-, x2-, and x3-faces
 };
 
 //----------------------------------------------------------------------------------------
@@ -56,6 +66,8 @@ class Coordinates {
   bool is_special_relativistic = false;
   bool is_general_relativistic = false;
   bool is_dynamical_relativistic = false;
+  // flag to denote mesh is uniform in (ln r, theta, phi) rather than Cartesian
+  bool is_spherical_polar = false;
 
   // data needed to compute metric in GR
   CoordData coord_data;
@@ -63,15 +75,22 @@ class Coordinates {
   // excision masks
   DvceArray4D<bool> excision_floor;  // cell-centered mask for C2P flooring about horizon
   DvceArray4D<bool> excision_flux;   // cell-centered mask for FOFC about horizon
+  DvceArray3D<bool> excision_pencil; // true if all cells along x1 at (m,k,j) are excised
+  DvceArray1D<bool> excision_mb;     // true if all cells in MeshBlock are excised
 
   // functions
   void CoordSrcTerms(const DvceArray5D<Real> &w0, const EOS_Data &eos, const Real dt,
                      DvceArray5D<Real> &u0);
   void CoordSrcTerms(const DvceArray5D<Real> &w0, const DvceArray5D<Real> &bcc,
                      const EOS_Data &eos, const Real dt, DvceArray5D<Real> &u0);
+  void SphericalPolarSrcTerms(const DvceArray5D<Real> &w0,
+                              const DvceFaceFld5D<FluxReal> &flx, const EOS_Data &eos,
+                              const Real dt, DvceArray5D<Real> &u0);
   void SetExcisionMasks(DvceArray4D<bool> &floor, DvceArray4D<bool> &flux);
 
   void UpdateExcisionMasks();
+  void SetExcisionBlockMasks();
+  void SetMetricCache();
 
  private:
   MeshBlockPack* pmy_pack;
@@ -13,6 +13,8 @@
 #include "coordinates.hpp"
 #include "cell_locations.hpp"
 #include "coordinates/adm.hpp"
+#include "z4c/z4c.hpp"
+#include "z4c/z4c_horizon_finder.hpp"
 
 // inlined spherical Kerr-Schild r evaluated at CKS x1, x2, x3
 KOKKOS_INLINE_FUNCTION
@@ -166,21 +168,39 @@ void Coordinates::SetExcisionMasks(DvceArray4D<bool> &excision_floor,
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void Coordinates::UpdateExcisionMasks()
+//  \brief Updates the excision masks from the evolved metric.  With the lapse scheme,
+//  cells where the lapse is below excise_lapse are excised.  With the horizon scheme,
+//  cells inside a fraction of the last apparent horizon found are excised, and the lapse
+//  criterion is used until any horizon has been found.
+
 void Coordinates::UpdateExcisionMasks() {
-  if (coord_data.excision_scheme == ExcisionScheme::lapse) {
-    // capture variables for kernel
-    auto &indcs = pmy_pack->pmesh->mb_indcs;
-    int is = indcs.is; int js = indcs.js; int ks = indcs.ks;
-    int &ng = indcs.ng;
-    int n1 = indcs.nx1 + 2*ng;
-    int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng) : 1;
-    int n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng) : 1;
-    int nmb1 = pmy_pack->nmb_thispack - 1;
-    auto &size = pmy_pack->pmb->mb_size;
-    auto &adm = pmy_pack->padm->adm;
-    auto &floor = excision_floor;
-    auto &flux = excision_flux;
+  if (coord_data.excision_scheme != ExcisionScheme::lapse &&
+      coord_data.excision_scheme != ExcisionScheme::horizon) return;
+
+  // capture variables for kernel
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is; int js = indcs.js; int ks = indcs.ks;
+  int &ng = indcs.ng;
+  int n1 = indcs.nx1 + 2*ng;
+  int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng) : 1;
+  int n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng) : 1;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  auto &size = pmy_pack->pmb->mb_size;
+  auto &floor = excision_floor;
+  auto &flux = excision_flux;
 
+  bool any_horizon = false;
+  if (coord_data.excision_scheme == ExcisionScheme::horizon &&
+      pmy_pack->pz4c != nullptr) {
+    for (auto &pahf : pmy_pack->pz4c->horizon_finders) {
+      any_horizon = any_horizon || pahf->found;
+    }
+  }
+
+  if (!any_horizon) {
+    auto &adm = pmy_pack->padm->adm;
     Real &excise_lapse = coord_data.excise_lapse;
 
     par_for("set_excision", DevExeSpace(), 0, nmb1, 0, (n3-1), 0, (n2-1), 0, (n1-1),
@@ -189,5 +209,76 @@ void Coordinates::UpdateExcisionMasks() {
       floor(m,k,j,i) = excise;
       flux(m,k,j,i) = excise;
     });
+    SetExcisionBlockMasks();
+    return;
   }
+
+  // excise inside every horizon found
+  Kokkos::deep_copy(floor, false);
+  Kokkos::deep_copy(flux, false);
+  Real frac = coord_data.excise_horizon_frac;
+  for (auto &pahf : pmy_pack->pz4c->horizon_finders) {
+    if (!pahf->found) continue;
+    auto &alm = pahf->alm;
+    int lmax = pahf->lmax;
+    Real c[3] = {pahf->center[0], pahf->center[1], pahf->center[2]};
+    par_for("set_excision_ah", DevExeSpace(), 0, nmb1, 0, (n3-1), 0, (n2-1), 0, (n1-1),
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      Real &x1min = size.d_view(m).x1min;
+      Real &x1max = size.d_view(m).x1max;
+      Real &x2min = size.d_view(m).x2min;
+      Real &x2max = size.d_view(m).x2max;
+      Real &x3min = size.d_view(m).x3min;
+      Real &x3max = size.d_view(m).x3max;
+      Real x1v = CellCenterX(i-is, indcs.nx1, x1min, x1max);
+      Real x2v = CellCenterX(j-js, indcs.nx2, x2min, x2max);
+      Real x3v = CellCenterX(k-ks, indcs.nx3, x3min, x3max);
+      if (z4c::InsideHorizon(alm.d_view, lmax, c, frac, x1v, x2v, x3v)) {
+        floor(m,k,j,i) = true;
+        flux(m,k,j,i) = true;
+      }
+    });
+  }
+  SetExcisionBlockMasks();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Coordinates::SetExcisionBlockMasks()
+//  \brief Sets coarser masks from the excision_floor mask: excision_pencil(m,k,j) is true
+//  if every cell (including ghost cells) along x1 at (m,k,j) is excised, and
+//  excision_mb(m) is true if every cell in the MeshBlock is excised.  Since excised
+//  cells are reset to the (fixed) excised state by ConsToPrim, these masks are used to
+//  skip computing fluxes and source terms over whole rows and MeshBlocks.
+
+void Coordinates::SetExcisionBlockMasks() {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int &ng = indcs.ng;
+  int n1 = indcs.nx1 + 2*ng;
+  int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng) : 1;
+  int n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng) : 1;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  auto &floor = excision_floor;
+  auto &pencil = excision_pencil;
+  auto &mb = excision_mb;
+
+  par_for("excise_pencil", DevExeSpace(), 0, nmb1, 0, (n3-1), 0, (n2-1),
+  KOKKOS_LAMBDA(const int m, const int k, const int j) {
+    bool all_excised = true;
+    for (int i=0; i<n1; ++i) {
+      all_excised = all_excised && floor(m,k,j,i);
+    }
+    pencil(m,k,j) = all_excised;
+  });
+
+  par_for("excise_mb", DevExeSpace(), 0, nmb1,
+  KOKKOS_LAMBDA(const int m) {
+    bool all_excised = true;
+    for (int k=0; k<n3; ++k) {
+      for (int j=0; j<n2; ++j) {
+        all_excised = all_excised && pencil(m,k,j);
+      }
+    }
+    mb(m) = all_excised;
+  });
+  return;
 }
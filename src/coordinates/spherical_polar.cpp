@@ -0,0 +1,79 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file spherical_polar.cpp
+//! \brief geometric source terms for non-relativistic hydrodynamics in logarithmically
+//! spaced spherical-polar coordinates
+
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+#include "eos/eos.hpp"
+#include "coordinates.hpp"
+#include "spherical_polar.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn void Coordinates::SphericalPolarSrcTerms()
+//! \brief Adds geometric source terms to the momentum equations in spherical-polar
+//! coordinates.  Terms in which the momentum flux appears are computed from the fluxes
+//! at cell faces, so that angular momentum is conserved to round-off (see
+//! spherical_polar.cpp in Athena++).  There are no source terms for the density, energy,
+//! or passive scalars.
+
+void Coordinates::SphericalPolarSrcTerms(const DvceArray5D<Real> &prim,
+                                         const DvceFaceFld5D<FluxReal> &flx,
+                                         const EOS_Data &eos, const Real dt,
+                                         DvceArray5D<Real> &cons) {
+  // capture variables for kernel
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is; int ie = indcs.ie;
+  int js = indcs.js; int je = indcs.je;
+  int ks = indcs.ks; int ke = indcs.ke;
+  bool multi_d = pmy_pack->pmesh->multi_d;
+  auto &size = pmy_pack->pmb->mb_size;
+  auto flx1 = flx.x1f;
+  auto flx2 = flx.x2f;
+
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  par_for("sph_polar_src", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie,
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    Real rm, rp, vol1;
+    SphPolarRadialFactors(i-is, indcs.nx1, size.d_view(m).x1min, size.d_view(m).x1max,
+                          rm, rp, vol1);
+    Real sm, sp, vol2;
+    SphPolarPolarFactors(j-js, indcs.nx2, size.d_view(m).x2min, size.d_view(m).x2max,
+                         sm, sp, vol2);
+    // volume averages of 1/r and cot(theta), and factors multiplying the face-centered
+    // fluxes so that r*M_theta, r*M_phi and sin(theta)*M_phi are conserved
+    Real src1_i = 0.5*(rp*rp - rm*rm)/vol1;
+    Real src2_i = (rp - rm)/((rm + rp)*vol1);
+    Real src1_j = (sp - sm)/vol2;
+
+    const Real &rho = prim(m,IDN,k,j,i);
+    const Real &v2  = prim(m,IVY,k,j,i);
+    const Real &v3  = prim(m,IVZ,k,j,i);
+    Real pgas = (eos.is_ideal)? eos.IdealGasPressure(prim(m,IEN,k,j,i)) :
+                                rho*SQR(eos.iso_cs);
+
+    // src_1 = <M_{theta theta} + M_{phi phi}><1/r>
+    cons(m,IM1,k,j,i) += dt*src1_i*(rho*(v2*v2 + v3*v3) + 2.0*pgas);
+
+    // src_2 = -<M_{theta r}><1/r>, src_3 = -<M_{phi r}><1/r>
+    cons(m,IM2,k,j,i) -= dt*src2_i*(rm*rm*flx1(m,IM2,k,j,i) + rp*rp*flx1(m,IM2,k,j,i+1));
+    cons(m,IM3,k,j,i) -= dt*src2_i*(rm*rm*flx1(m,IM3,k,j,i) + rp*rp*flx1(m,IM3,k,j,i+1));
+
+    // src_2 = <M_{phi phi}><cot(theta)/r>
+    cons(m,IM2,k,j,i) += dt*src1_i*src1_j*(rho*v3*v3 + pgas);
+
+    // src_3 = -<M_{phi theta}><cot(theta)/r>
+    if (multi_d) {
+      Real src2_j = (sp - sm)/((sm + sp)*vol2);
+      cons(m,IM3,k,j,i) -= dt*src1_i*src2_j*(sm*flx2(m,IM3,k,j,i) +
+                                             sp*flx2(m,IM3,k,j+1,i));
+    } else {
+      cons(m,IM3,k,j,i) -= dt*src1_i*src1_j*(rho*v2*v3);
+    }
+  });
+  return;
+}
@@ -0,0 +1,49 @@
+#ifndef COORDINATES_SPHERICAL_POLAR_HPP_
+#define COORDINATES_SPHERICAL_POLAR_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file spherical_polar.hpp
+//! \brief inline functions for logarithmically spaced spherical-polar coordinates in
+//! non-relativistic hydrodynamics.  The mesh is uniform in (x1,x2,x3) = (ln r,theta,phi),
+//! so that all functions in cell_locations.hpp still return code coordinates, and these
+//! functions convert them into the volumes and areas used in the flux divergence and
+//! geometric source terms.  Volume factors follow spherical_polar.cpp in Athena++.
+
+#include "athena.hpp"
+#include "coordinates/cell_locations.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn void SphPolarRadialFactors()
+//! \brief returns radii of the inner and outer x1-faces of i^th cell where index range
+//! [0,N] maps to ln(r) in [x1min,x1max], and the radial factor (rp^3-rm^3)/3 of the
+//! cell volume
+
+KOKKOS_INLINE_FUNCTION
+void SphPolarRadialFactors(int ith, int n, Real x1min, Real x1max,
+                           Real &rm, Real &rp, Real &vol1) {
+  rm = exp(LeftEdgeX(ith, n, x1min, x1max));
+  rp = exp(LeftEdgeX(ith+1, n, x1min, x1max));
+  vol1 = (rp*rp*rp - rm*rm*rm)/3.0;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void SphPolarPolarFactors()
+//! \brief returns sin(theta) at the inner and outer x2-faces of j^th cell where index
+//! range [0,N] maps to theta in [x2min,x2max], and the polar factor cos(thm)-cos(thp)
+//! of the cell volume
+
+KOKKOS_INLINE_FUNCTION
+void SphPolarPolarFactors(int jth, int n, Real x2min, Real x2max,
+                          Real &sm, Real &sp, Real &vol2) {
+  Real thm = LeftEdgeX(jth, n, x2min, x2max);
+  Real thp = LeftEdgeX(jth+1, n, x2min, x2max);
+  // fabs() keeps areas of faces at the poles non-negative despite round-off
+  sm = fabs(sin(thm));
+  sp = fabs(sin(thp));
+  vol2 = cos(thm) - cos(thp);
+}
+
+#endif // COORDINATES_SPHERICAL_POLAR_HPP_
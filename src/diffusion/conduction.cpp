@@ -21,7 +21,9 @@
 #include "hydro/hydro.hpp"
 #include "mhd/mhd.hpp"
 #include "eos/eos.hpp"
+#include "bvals/bvals.hpp"
 #include "conduction.hpp"
+#include "utils/block_multigrid.hpp"
 #include "units/units.hpp"
 
 KOKKOS_INLINE_FUNCTION
@@ -81,20 +83,66 @@ Conduction::Conduction(std::string block, MeshBlockPack *pp, ParameterInput *pin
   kappa_ceiling = pin->GetOrAddReal(block,"cond_ceiling",
                   static_cast<Real>(std::numeric_limits<float>::max()));
   sat_hflux = pin->GetOrAddBoolean(block,"sat_hflux",false);
+
+  // Read parameters for implicit conduction, and allocate memory for CG solver
+  implicit = pin->GetOrAddBoolean(block,"implicit_conduction",false);
+  impl_max_iter = pin->GetOrAddInteger(block,"implicit_max_iter",100);
+  impl_tol = pin->GetOrAddReal(block,"implicit_tol",1.0e-8);
+  impl_niter = 0;
+  std::string precond = pin->GetOrAddString(block,"implicit_precond","jacobi");
+  impl_mg = (precond.compare("multigrid") == 0);
+  if (implicit && !(impl_mg) && precond.compare("jacobi") != 0) {
+    std::cout << "### FATAL ERROR in "<< __FILE__ <<" at line " << __LINE__ << std::endl
+              << "<" << block << ">/implicit_precond = '" << precond
+              << "' not implemented, valid choices are [jacobi,multigrid]" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  if (implicit) {
+    if (block.compare("hydro") != 0 || tdep_kappa || sat_hflux ||
+        pmy_pack->pmesh->multilevel || pmy_pack->pmesh->nmb_packs_thisrank > 1) {
+      std::cout << "### FATAL ERROR in "<< __FILE__ <<" at line " << __LINE__ << std::endl
+                << "Implicit conduction only implemented for Hydro with constant "
+                << "isotropic conductivity, one MeshBlockPack per rank, and no SMR/AMR"
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    auto &indcs = pmy_pack->pmesh->mb_indcs;
+    int nmb = std::max((pmy_pack->nmb_thispack), (pmy_pack->pmesh->nmb_maxperrank));
+    int ncells1 = indcs.nx1 + 2*(indcs.ng);
+    int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
+    int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
+    Kokkos::realloc(tx, nmb, 1, ncells3, ncells2, ncells1);
+    Kokkos::realloc(tp, nmb, 1, ncells3, ncells2, ncells1);
+    Kokkos::realloc(tr, nmb, ncells3, ncells2, ncells1);
+    Kokkos::realloc(tq, nmb, ncells3, ncells2, ncells1);
+    Kokkos::realloc(tz, nmb, ncells3, ncells2, ncells1);
+    Kokkos::realloc(td, nmb, ncells3, ncells2, ncells1);
+    Kokkos::realloc(cv, nmb, ncells3, ncells2, ncells1);
+    pbval_t = new MeshBoundaryValuesCC(pmy_pack, pin, false);
+    pbval_t->InitializeBuffers(1);
+    if (impl_mg) {
+      pmg = new BlockMultigrid(pmy_pack,
+                               pin->GetOrAddInteger(block,"implicit_mg_nsmooth",2),
+                               pin->GetOrAddInteger(block,"implicit_mg_ncoarse",16));
+    }
+  }
 }
 
 //----------------------------------------------------------------------------------------
 //! \brief Conduction destructor
 
 Conduction::~Conduction() {
+  if (pbval_t != nullptr) {delete pbval_t;}
+  if (pmg != nullptr) {delete pmg;}
 }
 
 //----------------------------------------------------------------------------------------
 //! \fn void AddHeatFlux()
 //! \brief Adds heat flux to face-centered fluxes of conserved variables
 
+template <typename T>
 void Conduction::AddHeatFlux(const DvceArray5D<Real> &w0, const EOS_Data &eos,
-  DvceFaceFld5D<Real> &flx) {
+  DvceFaceFld5D<T> &flx) {
   if (tdep_kappa) {
     TempDependentHeatFlux(w0, eos, flx);
   } else if (kappa > 0.0) {
@@ -108,8 +156,9 @@ void Conduction::AddHeatFlux(const DvceArray5D<Real> &w0, const EOS_Data &eos,
 //! \fn void IsotropicHeatFlux()
 //! \brief Adds isotropic heat flux to face-centered fluxes of conserved variables
 
+template <typename T>
 void Conduction::IsotropicHeatFlux(const DvceArray5D<Real> &w0, const EOS_Data &eos,
-  DvceFaceFld5D<Real> &flx) {
+  DvceFaceFld5D<T> &flx) {
   auto &indcs = pmy_pack->pmesh->mb_indcs;
   int is = indcs.is, ie = indcs.ie;
   int js = indcs.js, je = indcs.je;
@@ -184,8 +233,9 @@ void Conduction::IsotropicHeatFlux(const DvceArray5D<Real> &w0, const EOS_Data &
 //! \brief Adds heat flux to face-centered fluxes of conserved variables with
 //! temperature-dependent conductivity
 
+template <typename T>
 void Conduction::TempDependentHeatFlux(const DvceArray5D<Real> &w0, const EOS_Data &eos,
-  DvceFaceFld5D<Real> &flx) {
+  DvceFaceFld5D<T> &flx) {
   auto &indcs = pmy_pack->pmesh->mb_indcs;
   int is = indcs.is, ie = indcs.ie;
   int js = indcs.js, je = indcs.je;
@@ -474,3 +524,11 @@ void Conduction::NewTimeStep(const DvceArray5D<Real> &w0, const EOS_Data &eos_da
 
   return;
 }
+
+// function definitions for each template parameter
+template void Conduction::AddHeatFlux<Real>(const DvceArray5D<Real> &w0,
+  const EOS_Data &eos, DvceFaceFld5D<Real> &flx);
+#if MIXED_PRECISION_ENABLED
+template void Conduction::AddHeatFlux<FluxReal>(const DvceArray5D<Real> &w0,
+  const EOS_Data &eos, DvceFaceFld5D<FluxReal> &flx);
+#endif
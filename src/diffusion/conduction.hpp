@@ -14,6 +14,10 @@
 #include "athena.hpp"
 #include "parameter_input.hpp"
 
+// forward declarations
+class MeshBoundaryValuesCC;
+class BlockMultigrid;
+
 //----------------------------------------------------------------------------------------
 //! \class Conduction
 //! \brief data and functions that implement thermal conduction in Hydro and MHD
@@ -29,17 +33,39 @@ class Conduction {
   bool tdep_kappa;    // temperature-dependent conductivity
   Real kappa_ceiling; // ceiling of thermal conductivity
   bool sat_hflux;     // saturtion of heat flux
+  bool implicit;      // backward-Euler update solved with preconditioned CG
+  int impl_max_iter;  // maximum number of CG iterations
+  Real impl_tol;      // tolerance on |r|/|b| of CG solution
+  int impl_niter;     // number of CG iterations used in last implicit update
+  bool impl_mg;       // precondition CG with multigrid V-cycle (rather than Jacobi)
 
   // function to add heat fluxes to Hydro and/or MHD fluxes
+  template <typename T>
   void AddHeatFlux(const DvceArray5D<Real> &w, const EOS_Data &eos,
-                   DvceFaceFld5D<Real> &f);
+                   DvceFaceFld5D<T> &f);
+  template <typename T>
   void IsotropicHeatFlux(const DvceArray5D<Real> &w, const EOS_Data &eos,
-                         DvceFaceFld5D<Real> &f);
+                         DvceFaceFld5D<T> &f);
+  template <typename T>
   void TempDependentHeatFlux(const DvceArray5D<Real> &w, const EOS_Data &eos,
-                             DvceFaceFld5D<Real> &f);
+                             DvceFaceFld5D<T> &f);
   void NewTimeStep(const DvceArray5D<Real> &w, const EOS_Data &eos_data);
+  // implicit (backward-Euler) update of internal energy over timestep dt
+  void ImplicitUpdate(DvceArray5D<Real> &w, DvceArray5D<Real> &u,
+                      const EOS_Data &eos, const Real dt);
 
  private:
   MeshBlockPack* pmy_pack;
+  // following only used with implicit conduction
+  MeshBoundaryValuesCC *pbval_t = nullptr;  // boundary values of temperature vectors
+  BlockMultigrid *pmg = nullptr;            // multigrid preconditioner
+  DvceArray5D<Real> tx, tp;      // CG solution and search direction (with ghost zones)
+  DvceArray5D<Real> ctx;         // unused coarse array required by boundary exchange
+  DvceArray4D<Real> tr, tq, tz;  // CG residual, A*p, and preconditioned residual
+  DvceArray4D<Real> td, cv;      // diagonal of A and heat capacity rho/(gamma-1)
+  void ApplyImplicitOperator(const DvceArray5D<Real> &v, DvceArray4D<Real> &av,
+                             const Real dt);
+  void ExchangeImplicitGhosts(DvceArray5D<Real> &v);
+  Real MultigridPrecondition();
 };
 #endif // DIFFUSION_CONDUCTION_HPP_
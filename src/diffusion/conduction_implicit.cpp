@@ -0,0 +1,316 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file conduction_implicit.cpp
+//! \brief Implements implicit (backward-Euler) isotropic thermal conduction, which is not
+//! limited by the diffusion timestep.  The linear system for the new temperature T,
+//!   A T = (rho/(gamma-1)) T - dt div(kappa grad T) = (rho/(gamma-1)) T^n,
+//! is symmetric positive definite, and is solved matrix-free with the preconditioned
+//! conjugate gradient (CG) method.  The preconditioner is either the diagonal of A
+//! (Jacobi), or with <hydro>/implicit_precond=multigrid one geometric multigrid V-cycle
+//! within each MeshBlock (see utils/block_multigrid.hpp).  Ghost zones of the CG vectors
+//! are exchanged with the usual boundary value functions, and heat fluxes through faces
+//! at physical (non-periodic) boundaries of the domain are zero.
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "mesh/mesh.hpp"
+#include "eos/eos.hpp"
+#include "bvals/bvals.hpp"
+#include "conduction.hpp"
+#include "utils/block_multigrid.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \fn bool HeatFlows()
+//! \brief true if heat can flow through a face of a cell, i.e. if the face is interior
+//! to the MeshBlock, or at a MeshBlock boundary that is not a physical boundary
+
+KOKKOS_INLINE_FUNCTION
+bool HeatFlows(const bool interior, const BoundaryFlag bc) {
+  return (interior || bc == BoundaryFlag::block || bc == BoundaryFlag::periodic);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Conduction::ImplicitUpdate()
+//! \brief Solves for temperature at end of timestep dt given primitives w0, and updates
+//! internal energy in u0 and w0 in active cells and ghost zones at MeshBlock boundaries.
+//! Ghost zones at physical boundaries have to be set afterwards by the caller.
+
+void Conduction::ImplicitUpdate(DvceArray5D<Real> &w0, DvceArray5D<Real> &u0,
+                                const EOS_Data &eos, const Real dt) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  int n1m1 = indcs.nx1 + 2*indcs.ng - 1;
+  int n2m1 = (indcs.nx2 > 1)? (indcs.nx2 + 2*indcs.ng - 1) : 0;
+  int n3m1 = (indcs.nx3 > 1)? (indcs.nx3 + 2*indcs.ng - 1) : 0;
+  const int nji  = indcs.nx2*indcs.nx1;
+  const int nkji = indcs.nx3*nji;
+  const int nmkji = (pmy_pack->nmb_thispack)*nkji;
+  const int nx1 = indcs.nx1;
+  const bool &use_e = eos.use_e;
+  Real gm1 = eos.gamma - 1.0;
+  auto x_ = tx;
+  auto p_ = tp;
+  auto r_ = tr;
+  auto q_ = tq;
+  auto z_ = tz;
+  auto d_ = td;
+  auto cv_ = cv;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+  auto &mb_bcs = pmy_pack->pmb->mb_bcs;
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  Real kdt = kappa*dt;
+
+  // initial guess T^n and heat capacity everywhere (ghost zones are up to date)
+  par_for("icond_init", DevExeSpace(), 0, nmb1, 0, n3m1, 0, n2m1, 0, n1m1,
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    x_(m,0,k,j,i) = (use_e)? (w0(m,IEN,k,j,i)/w0(m,IDN,k,j,i)*gm1) : w0(m,ITM,k,j,i);
+    cv_(m,k,j,i) = w0(m,IDN,k,j,i)/gm1;
+  });
+  if (impl_mg) {pmg->SetOperator(cv_, kdt);}
+
+  // r = b - A x,  z = r/diag(A) (Jacobi), and sums of r*z, b*b and r*r
+  ApplyImplicitOperator(x_, q_, dt);
+  array_sum::GlobalSum sum0;
+  Kokkos::parallel_reduce("icond_r0", Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
+  KOKKOS_LAMBDA(const int &idx, array_sum::GlobalSum &rsum) {
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/nx1;
+    int i = (idx - m*nkji - k*nji - j*nx1) + is;
+    k += ks;
+    j += js;
+    Real b = cv_(m,k,j,i)*x_(m,0,k,j,i);
+    Real r = b - q_(m,k,j,i);
+    // Jacobi preconditioner, diagonal of A including only faces with heat flow
+    Real d = cv_(m,k,j,i);
+    d += kdt*((HeatFlows(i > is, mb_bcs.d_view(m,BoundaryFace::inner_x1))? 1.0 : 0.0) +
+              (HeatFlows(i < ie, mb_bcs.d_view(m,BoundaryFace::outer_x1))? 1.0 : 0.0))
+            /SQR(mbsize.d_view(m).dx1);
+    if (multi_d) {
+      d += kdt*((HeatFlows(j > js, mb_bcs.d_view(m,BoundaryFace::inner_x2))? 1.0 : 0.0) +
+                (HeatFlows(j < je, mb_bcs.d_view(m,BoundaryFace::outer_x2))? 1.0 : 0.0))
+              /SQR(mbsize.d_view(m).dx2);
+    }
+    if (three_d) {
+      d += kdt*((HeatFlows(k > ks, mb_bcs.d_view(m,BoundaryFace::inner_x3))? 1.0 : 0.0) +
+                (HeatFlows(k < ke, mb_bcs.d_view(m,BoundaryFace::outer_x3))? 1.0 : 0.0))
+              /SQR(mbsize.d_view(m).dx3);
+    }
+    r_(m,k,j,i) = r;
+    d_(m,k,j,i) = d;
+    z_(m,k,j,i) = r/d;
+    rsum.the_array[0] += r*r/d;
+    rsum.the_array[1] += b*b;
+    rsum.the_array[2] += r*r;
+  }, Kokkos::Sum<array_sum::GlobalSum>(sum0));
+  Real gsum[3];
+  for (int n=0; n<3; ++n) {gsum[n] = sum0.the_array[n];}
+  if (impl_mg) {gsum[0] = MultigridPrecondition();}
+  // p = z
+  par_for("icond_p0", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie,
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    p_(m,0,k,j,i) = z_(m,k,j,i);
+  });
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, gsum, 3, MPI_ATHENA_REAL, MPI_SUM,
+                global_variable::athena_comm);
+#endif
+  Real rz = gsum[0];
+  Real bb = gsum[1];
+  Real tol2 = SQR(impl_tol)*bb;
+  Real rr = gsum[2];
+
+  impl_niter = 0;
+  while (rr > tol2 && impl_niter < impl_max_iter) {
+    // A*p, with ghost zones of p from neighbors
+    ExchangeImplicitGhosts(p_);
+    ApplyImplicitOperator(p_, q_, dt);
+    Real pq = 0.0;
+    Kokkos::parallel_reduce("icond_pq", Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
+    KOKKOS_LAMBDA(const int &idx, Real &sum) {
+      int m = (idx)/nkji;
+      int k = (idx - m*nkji)/nji;
+      int j = (idx - m*nkji - k*nji)/nx1;
+      int i = (idx - m*nkji - k*nji - j*nx1) + is;
+      k += ks;
+      j += js;
+      sum += p_(m,0,k,j,i)*q_(m,k,j,i);
+    }, Kokkos::Sum<Real>(pq));
+#if MPI_PARALLEL_ENABLED
+    MPI_Allreduce(MPI_IN_PLACE, &pq, 1, MPI_ATHENA_REAL, MPI_SUM,
+                  global_variable::athena_comm);
+#endif
+    Real alpha = rz/pq;
+
+    // x += alpha p,  r -= alpha A*p, and new sums of r*z and r*r
+    array_sum::GlobalSum sum1;
+    Kokkos::parallel_reduce("icond_xr", Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
+    KOKKOS_LAMBDA(const int &idx, array_sum::GlobalSum &rsum) {
+      int m = (idx)/nkji;
+      int k = (idx - m*nkji)/nji;
+      int j = (idx - m*nkji - k*nji)/nx1;
+      int i = (idx - m*nkji - k*nji - j*nx1) + is;
+      k += ks;
+      j += js;
+      x_(m,0,k,j,i) += alpha*p_(m,0,k,j,i);
+      Real r = r_(m,k,j,i) - alpha*q_(m,k,j,i);
+      r_(m,k,j,i) = r;
+      z_(m,k,j,i) = r/d_(m,k,j,i);
+      rsum.the_array[0] += r*r/d_(m,k,j,i);
+      rsum.the_array[1] += r*r;
+    }, Kokkos::Sum<array_sum::GlobalSum>(sum1));
+    gsum[0] = sum1.the_array[0];
+    gsum[1] = sum1.the_array[1];
+    if (impl_mg) {gsum[0] = MultigridPrecondition();}
+#if MPI_PARALLEL_ENABLED
+    MPI_Allreduce(MPI_IN_PLACE, gsum, 2, MPI_ATHENA_REAL, MPI_SUM,
+                  global_variable::athena_comm);
+#endif
+    Real beta = gsum[0]/rz;
+    rz = gsum[0];
+    rr = gsum[1];
+
+    // p = z + beta p
+    par_for("icond_p", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie,
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      p_(m,0,k,j,i) = z_(m,k,j,i) + beta*p_(m,0,k,j,i);
+    });
+    impl_niter++;
+  }
+
+  if (rr > tol2 && global_variable::my_rank == 0) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Implicit conduction did not converge in " << impl_max_iter
+              << " iterations, |r|/|b|=" << std::sqrt(rr/bb)
+              << std::endl;
+  }
+
+  // update internal energy in active cells and ghost zones at MeshBlock boundaries with
+  // new temperature.  Density and velocity are unchanged.
+  ExchangeImplicitGhosts(x_);
+  par_for("icond_updt", DevExeSpace(), 0, nmb1, 0, n3m1, 0, n2m1, 0, n1m1,
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    Real told = (use_e)? (w0(m,IEN,k,j,i)/w0(m,IDN,k,j,i)*gm1) : w0(m,ITM,k,j,i);
+    u0(m,IEN,k,j,i) += cv_(m,k,j,i)*(x_(m,0,k,j,i) - told);
+    if (use_e) {
+      w0(m,IEN,k,j,i) = cv_(m,k,j,i)*x_(m,0,k,j,i);
+    } else {
+      w0(m,ITM,k,j,i) = x_(m,0,k,j,i);
+    }
+  });
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Real Conduction::MultigridPrecondition()
+//! \brief Replaces z by the multigrid-preconditioned residual z = M r, and returns the
+//! sum of r*z over active cells on this rank
+
+Real Conduction::MultigridPrecondition() {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, js = indcs.js, ks = indcs.ks;
+  const int nji  = indcs.nx2*indcs.nx1;
+  const int nkji = indcs.nx3*nji;
+  const int nmkji = (pmy_pack->nmb_thispack)*nkji;
+  const int nx1 = indcs.nx1;
+  auto r_ = tr;
+  auto z_ = tz;
+  pmg->Precondition(r_, z_);
+  Real rz = 0.0;
+  Kokkos::parallel_reduce("icond_rz", Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
+  KOKKOS_LAMBDA(const int &idx, Real &sum) {
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/nx1;
+    int i = (idx - m*nkji - k*nji - j*nx1) + is;
+    k += ks;
+    j += js;
+    sum += r_(m,k,j,i)*z_(m,k,j,i);
+  }, Kokkos::Sum<Real>(rz));
+  return rz;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Conduction::ApplyImplicitOperator()
+//! \brief Computes A*v = (rho/(gamma-1)) v - dt div(kappa grad v) in active cells.  Ghost
+//! zones of v must be set at all MeshBlock boundaries that are not physical boundaries.
+
+void Conduction::ApplyImplicitOperator(const DvceArray5D<Real> &v, DvceArray4D<Real> &av,
+                                       const Real dt) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  auto cv_ = cv;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+  auto &mb_bcs = pmy_pack->pmb->mb_bcs;
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  Real kdt = kappa*dt;
+
+  par_for("icond_op", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie,
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    // heat fluxes through faces at physical boundaries are zero
+    Real vc = v(m,0,k,j,i);
+    Real fl = 0.0, fr = 0.0;
+    if (HeatFlows(i > is, mb_bcs.d_view(m,BoundaryFace::inner_x1))) {
+      fl = vc - v(m,0,k,j,i-1);
+    }
+    if (HeatFlows(i < ie, mb_bcs.d_view(m,BoundaryFace::outer_x1))) {
+      fr = v(m,0,k,j,i+1) - vc;
+    }
+    Real lap = (fr - fl)/SQR(mbsize.d_view(m).dx1);
+    if (multi_d) {
+      fl = 0.0, fr = 0.0;
+      if (HeatFlows(j > js, mb_bcs.d_view(m,BoundaryFace::inner_x2))) {
+        fl = vc - v(m,0,k,j-1,i);
+      }
+      if (HeatFlows(j < je, mb_bcs.d_view(m,BoundaryFace::outer_x2))) {
+        fr = v(m,0,k,j+1,i) - vc;
+      }
+      lap += (fr - fl)/SQR(mbsize.d_view(m).dx2);
+    }
+    if (three_d) {
+      fl = 0.0, fr = 0.0;
+      if (HeatFlows(k > ks, mb_bcs.d_view(m,BoundaryFace::inner_x3))) {
+        fl = vc - v(m,0,k-1,j,i);
+      }
+      if (HeatFlows(k < ke, mb_bcs.d_view(m,BoundaryFace::outer_x3))) {
+        fr = v(m,0,k+1,j,i) - vc;
+      }
+      lap += (fr - fl)/SQR(mbsize.d_view(m).dx3);
+    }
+    av(m,k,j,i) = cv_(m,k,j,i)*vc - kdt*lap;
+  });
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Conduction::ExchangeImplicitGhosts()
+//! \brief Sets ghost zones of a CG vector at MeshBlock boundaries by (blocking) exchange
+//! with neighbors, in the same sequence as Driver::InitBoundaryValuesAndPrimitives().
+
+void Conduction::ExchangeImplicitGhosts(DvceArray5D<Real> &v) {
+  (void) pbval_t->InitRecv(1);
+  (void) pbval_t->PackAndSendCC(v, ctx);
+  (void) pbval_t->ClearSend();
+  (void) pbval_t->ClearRecv();
+  (void) pbval_t->RecvAndUnpackCC(v, ctx);
+  return;
+}
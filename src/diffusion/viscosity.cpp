@@ -60,8 +60,9 @@ Viscosity::~Viscosity() {
 //! \fn void AddIsoViscousFlux
 //  \brief Adds viscous fluxes to face-centered fluxes of conserved variables
 
+template <typename T>
 void Viscosity::IsotropicViscousFlux(const DvceArray5D<Real> &w0, const Real nu,
-  const EOS_Data &eos, DvceFaceFld5D<Real> &flx) {
+  const EOS_Data &eos, DvceFaceFld5D<T> &flx) {
   auto &indcs = pmy_pack->pmesh->mb_indcs;
   int is = indcs.is, ie = indcs.ie;
   int js = indcs.js, je = indcs.je;
@@ -216,3 +217,11 @@ void Viscosity::IsotropicViscousFlux(const DvceArray5D<Real> &w0, const Real nu,
 
   return;
 }
+
+// function definitions for each template parameter
+template void Viscosity::IsotropicViscousFlux<Real>(const DvceArray5D<Real> &w0,
+  const Real nu, const EOS_Data &eos, DvceFaceFld5D<Real> &flx);
+#if MIXED_PRECISION_ENABLED
+template void Viscosity::IsotropicViscousFlux<FluxReal>(const DvceArray5D<Real> &w0,
+  const Real nu, const EOS_Data &eos, DvceFaceFld5D<FluxReal> &flx);
+#endif
@@ -30,8 +30,9 @@ class Viscosity {
   Real nu;     // coefficient of isotropic kinematic shear viscosity
 
   // function to add viscous fluxes to Hydro and/or MHD fluxes
+  template <typename T>
   void IsotropicViscousFlux(const DvceArray5D<Real> &w, const Real nu,
-                            const EOS_Data &eos, DvceFaceFld5D<Real> &f);
+                            const EOS_Data &eos, DvceFaceFld5D<T> &f);
 
  private:
   MeshBlockPack* pmy_pack;
@@ -6,11 +6,16 @@
 //! \file driver.cpp
 //  \brief implementation of functions in class Driver
 
+#include <cmath>
 #include <iostream>
 #include <iomanip>    // std::setprecision()
 #include <limits>
 #include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
 #include <string> // string
+#include <thread>
 
 #include "athena.hpp"
 #include "globals.hpp"
@@ -20,15 +25,24 @@
 #include "hydro/hydro.hpp"
 #include "mhd/mhd.hpp"
 #include "z4c/z4c.hpp"
+#include "coordinates/adm.hpp"
 #include "dyn_grmhd/dyn_grmhd.hpp"
 #include "ion-neutral/ion-neutral.hpp"
 #include "radiation/radiation.hpp"
+#include "utils/first_touch.hpp"
+#include "utils/memory_registry.hpp"
 #include "driver.hpp"
 
 #if MPI_PARALLEL_ENABLED
 #include <mpi.h>
 #endif
 
+namespace {
+// set by handler of SIGTERM/SIGUSR1, and tested once per cycle in Driver::Execute()
+volatile std::sig_atomic_t signal_caught = 0;
+extern "C" void CatchSignal(int sig) {signal_caught = 1;}
+} // namespace
+
 //----------------------------------------------------------------------------------------
 // constructor, initializes data structures and parameters
 //
@@ -62,6 +76,11 @@ Driver::Driver(ParameterInput *pin, Mesh *pmesh, Real wtlim, Kokkos::Timer* ptim
   nmb_updated_(0),
   npart_updated_(0),
   lb_efficiency_(0),
+  last_cycle_due_(false),
+  stop_delayed_(false),
+  wall_reserve_(0.0),
+  cycle_wtime_(0.0),
+  stop_signal_(false),
   pwall_clock_(ptimer),
   wall_time(wtlim),
   impl_src("ru",1,1,1,1,1,1) {
@@ -81,6 +100,105 @@ Driver::Driver(ParameterInput *pin, Mesh *pmesh, Real wtlim, Kokkos::Timer* ptim
     }
   } // extra brace to limit scope of string
 
+  // maximum time to sleep between sweeps over TaskLists that are all waiting.  Default
+  // of zero polls continuously; a small value frees the core (e.g. for MPI progress)
+  max_idle_wait_us_ = pin->GetOrAddInteger("time", "max_idle_wait_us", 0);
+
+  // start reduction of new timestep over ranks as soon as the last "stagen" TaskList is
+  // complete, and only wait for it once the cycle is finished
+  overlap_dt_reduce_ = pin->GetOrAddBoolean("time", "overlap_dt_reduce", false);
+  // instead use the result of the reduction started in the previous cycle as the new
+  // timestep, and only wait for it in the next cycle.  Falls back to a synchronous
+  // reduction for lag_dt_sync_cycles if the lagged timestep violates the CFL condition.
+  lag_dt_reduce_ = pin->GetOrAddBoolean("time", "lag_dt_reduce", false);
+  lag_dt_sync_cycles_ = pin->GetOrAddInteger("time", "lag_dt_sync_cycles", 10);
+  if (lag_dt_reduce_) {overlap_dt_reduce_ = true;}
+
+  // drive progress of non-blocking MPI communication from a background thread while the
+  // main thread is in kernels or outputs.  Only possible with MPI_THREAD_MULTIPLE.
+  mpi_progress_ = pin->GetOrAddBoolean("job", "mpi_progress_thread", false);
+  mpi_progress_us_ = pin->GetOrAddInteger("job", "mpi_progress_interval_us", 10);
+  if (mpi_progress_) {
+    int provided = 0;
+#if MPI_PARALLEL_ENABLED
+    MPI_Query_thread(&provided);
+    if (provided != MPI_THREAD_MULTIPLE) {provided = 0;}
+#endif
+    if (provided == 0) {
+      if (global_variable::my_rank == 0) {
+        std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<job>/mpi_progress_thread requires MPI initialized "
+                  << "with MPI_THREAD_MULTIPLE (MPI+OpenMP builds), thread not used"
+                  << std::endl;
+      }
+      mpi_progress_ = false;
+    }
+  }
+
+  // time named regions (TaskLists, each Task, outputs, AMR) and write a report at the end
+  // of the run, and optionally every profile_dcycle cycles, to file basename.prof
+  timers.enabled = pin->GetOrAddBoolean("time", "profile", false);
+  profile_dcycle_ = pin->GetOrAddInteger("time", "profile_dcycle", 0);
+
+  // measure energy used by GPU, and optionally lower its clocks in phases of the cycle
+  // given by timed regions (so timing is enabled with power control)
+  power.Init(pin);
+  if (power.control) {
+    timers.enabled = true;
+    timers.ppower = &power;
+  }
+  if (timers.enabled) {profile_file_ = pin->GetString("job", "basename") + ".prof";}
+  profile_written_ = false;
+
+  // time named kernels and report achieved bandwidth and FLOP rate of each, compared to
+  // roofline of device given by its peak bandwidth (GB/s) and FLOP rate (GFLOP/s), in
+  // file basename.roofline at the end of the run
+  pmesh->kcounter.enabled = pin->GetOrAddBoolean("time", "roofline", false);
+  pmesh->kcounter.peak_bw = pin->GetOrAddReal("time", "peak_bandwidth", 0.0);
+  pmesh->kcounter.peak_flops = pin->GetOrAddReal("time", "peak_gflops", 0.0);
+
+  // every telemetry_dcycle cycles, append one JSON record of throughput, time in each
+  // phase of the cycle, communication, memory and AMR activity to basename.telemetry
+  telemetry_dcycle_ = pin->GetOrAddInteger("time", "telemetry_dcycle", 0);
+  if (telemetry_dcycle_ > 0) {
+    telemetry_file_ = pin->GetString("job", "basename") + ".telemetry";
+    // communication is only measured when CommCounters are enabled
+    pmesh->ccounter.enabled = true;
+  }
+
+  // with a wall time limit, measure the longest cycle and the longest write of each
+  // output, and stop when the time left is just enough (times checkpoint_safety) for one
+  // more cycle plus the final outputs written in Finalize(), including the restart
+  predict_checkpoint_ = pin->GetOrAddBoolean("time", "predict_checkpoint", false);
+  checkpoint_safety_ = pin->GetOrAddReal("time", "checkpoint_safety", 1.5);
+
+  // stop at the end of the cycle (so final outputs and restart are written) when the
+  // scheduler sends SIGTERM or SIGUSR1 to any rank (e.g. SLURM --signal=USR1@300)
+  catch_signals_ = pin->GetOrAddBoolean("job", "checkpoint_on_signal", false);
+  if (catch_signals_) {
+    std::signal(SIGTERM, CatchSignal);
+    std::signal(SIGUSR1, CatchSignal);
+  }
+
+  // stop at the end of cycle rescale_cycle, and continue the run in the same job on
+  // rescale_nranks ranks (by spawning new ranks or dropping existing ones, see main.cpp)
+  rescale_cycle = pin->GetOrAddInteger("job", "rescale_cycle", -1);
+  rescale_nranks = pin->GetOrAddInteger("job", "rescale_nranks", global_variable::nranks);
+  if (rescale_cycle >= 0) {
+#if MPI_PARALLEL_ENABLED
+    if (rescale_nranks < 1) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<job>/rescale_nranks=" << rescale_nranks
+                << " must be >= 1" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+#else
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "<job>/rescale_cycle requires MPI" << std::endl;
+    std::exit(EXIT_FAILURE);
+#endif
+  }
+
   // read <time> parameters controlling driver if run requires time-evolution
   if (time_evolution != TimeEvolution::tstatic) {
     integrator = pin->GetOrAddString("time", "integrator", "rk2");
@@ -88,6 +206,8 @@ Driver::Driver(ParameterInput *pin, Mesh *pmesh, Real wtlim, Kokkos::Timer* ptim
     nlim = pin->GetOrAddInteger("time", "nlim", -1);
     ndiag = pin->GetOrAddInteger("time", "ndiag", 1);
 
+    // only the 2S low-storage methods (rk4, ssprk104) update u1 at each stage
+    use_delta = false;
     if (integrator == "rk1") {
       // RK1: first-order Runge-Kutta / the forward Euler (FE) method
       nimp_stages = 0;
@@ -154,10 +274,40 @@ Driver::Driver(ParameterInput *pin, Mesh *pmesh, Real wtlim, Kokkos::Timer* ptim
       gam1[3] = 0.198653035682705;
       beta[3] = 0.310665766509336;
 
+      use_delta = true;
       delta[0] = 1.0;
       delta[1] = 0.217683334308543;
       delta[2] = 1.065841341361089;
       delta[3] = 0.0;
+    } else if (integrator == "ssprk104") {
+      // SSPRK (10,4): Ketcheson (2008) SIAM J. Sci. Comput. 30, 2113, pseudocode 3
+      // Explicit ten-stage, fourth-order SSPRK with a two-register implementation
+      // SSP coefficient C = 6, so c_eff = C/nstages = 0.6, twice that of SSPRK (5,4)
+      // Stages 1-5 and 6-9 are forward Euler steps of dt/6.  The combination of
+      // registers after stage 5 is folded into the weights of stage 5 (u0) and a delta
+      // at stage 6 (u1), so that u1 holds (u^n - 1.8*u0) for the final stage.
+      nimp_stages = 0;
+      nexp_stages = 10;
+      cfl_limit = 6.0;
+      use_delta = true;
+      for (int n=0; n<nexp_stages; ++n) {
+        gam0[n] = 1.0;
+        gam1[n] = 0.0;
+        beta[n] = 1.0/6.0;
+        delta[n] = 0.0;
+      }
+      gam0[0] = 0.0;
+      gam1[0] = 1.0;
+
+      gam0[4] = 0.4;
+      gam1[4] = 0.6;
+      beta[4] = 1.0/15.0;
+
+      delta[5] = -1.8;
+
+      gam0[9] = 0.6;
+      gam1[9] = -0.5;
+      beta[9] = 0.1;
     } else if (integrator == "imex2") {
       // IMEX-SSP2(3,2,2): Pareschi & Russo (2005) Table III.
       // two-stage explicit, three-stage implicit, second-order ImEx
@@ -231,9 +381,55 @@ Driver::Driver(ParameterInput *pin, Mesh *pmesh, Real wtlim, Kokkos::Timer* ptim
     } else {
       std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
          << std::endl << "integrator=" << integrator << " not implemented. "
-         << "Valid choices are [rk1,rk2,rk3,imex2,imex3]." << std::endl;
+         << "Valid choices are [rk1,rk2,rk3,rk4,ssprk104,imex2,imex3]."
+         << std::endl;
       exit(EXIT_FAILURE);
     }
+
+    // with <hydro>/deep_halo all explicit stages between exchanges of ghost zones must
+    // fit within the ghost zones, and no implicit stages may change them in between
+    hydro::Hydro *phyd = pmesh->pmb_pack->phydro;
+    if ((phyd != nullptr) && (phyd->deep_halo)) {
+      int ng = phyd->nghost;
+      if ((nimp_stages > 0) || (ng < nexp_stages*(phyd->deep_halo_width))) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+           << std::endl << "<hydro>/deep_halo with integrator=" << integrator
+           << " requires an explicit integrator and at least "
+           << nexp_stages*(phyd->deep_halo_width) << " ghost zones, but <hydro>/nghost="
+           << ng << std::endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+
+    // super-time-stepping of diffusion terms, operator split before time-integrator
+    std::string sts_integrator = pin->GetOrAddString("time", "sts_integrator", "none");
+    nsts_stages = 0;
+    if (sts_integrator == "none") {
+      use_sts = false;
+    } else if (sts_integrator == "rkl2") {
+      use_sts = true;
+      if (pin->DoesBlockExist("mhd") || pin->DoesBlockExist("radiation") ||
+          pin->DoesBlockExist("z4c") || pin->DoesBlockExist("adm") ||
+          pin->DoesBlockExist("shearing_box")) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+           << std::endl << "sts_integrator=rkl2 only implemented for Hydro without "
+           << "shearing box" << std::endl;
+        exit(EXIT_FAILURE);
+      }
+    } else {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+         << std::endl << "sts_integrator=" << sts_integrator << " not implemented. "
+         << "Valid choices are [none,rkl2]." << std::endl;
+      exit(EXIT_FAILURE);
+    }
+
+    // abscissae of explicit stages, found by integrating du/dt=1 from u^n=0
+    Real c0 = 0.0, c1 = 0.0;
+    for (int n=0; n<nexp_stages; ++n) {
+      if (use_delta && n > 0) {c1 += delta[n]*c0;}
+      cstage[n] = c0;
+      c0 = gam0[n]*c0 + gam1[n]*c1 + beta[n];
+    }
   }
 }
 
@@ -242,23 +438,34 @@ Driver::Driver(ParameterInput *pin, Mesh *pmesh, Real wtlim, Kokkos::Timer* ptim
 //! \brief Perform tasks over all MeshBlocks for the TaskList specified by string "tl".
 //! Integer argument "stage" can be used to indicate at which step in overall algorithm
 //! these tasks are to be performed, e.g. which stage of a multi-stage RK integrator.
+//! When a pass makes no progress (all remaining tasks are waiting), the thread yields,
+//! then sleeps with exponential back-off up to <time>/max_idle_wait_us.
 
 void Driver::ExecuteTaskList(Mesh *pm, std::string tl, int stage) {
-  MeshBlockPack* pmbp = pm->pmb_pack;
-  for (int p=0; p<(pm->nmb_packs_thisrank); ++p) {
-    if (!(pmbp->tl_map[tl]->Empty())) {pmbp->tl_map[tl]->Reset();}
+  timers.Start(tl);
+  auto &ptl = pm->pmb_pack->tl_map[tl];
+  if (ptl->Empty()) {
+    timers.Stop();
+    return;
   }
-  int npack_left = (pm->nmb_packs_thisrank);
-  while (npack_left > 0) {
-    if (pmbp->tl_map[tl]->Empty()) {
-      npack_left--;
-    } else {
-      if (!pmbp->tl_map[tl]->IsComplete()) {
-        auto status = pmbp->tl_map[tl]->DoAvailable(this, stage);
-        if (status == TaskListStatus::complete) { npack_left--; }
+  ptl->Reset();
+  int idle_wait = 0;
+  while (!(ptl->IsComplete())) {
+    auto status = ptl->DoAvailable(this, stage);
+    if (status == TaskListStatus::complete) break;
+    if (status != TaskListStatus::stuck) {
+      idle_wait = 0;
+    } else if (max_idle_wait_us_ > 0) {
+      if (idle_wait == 0) {
+        std::this_thread::yield();
+        idle_wait = 1;
+      } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(idle_wait));
+        idle_wait = std::min(2*idle_wait, max_idle_wait_us_);
       }
     }
   }
+  timers.Stop();
   return;
 }
 
@@ -268,6 +475,7 @@ void Driver::ExecuteTaskList(Mesh *pm, std::string tl, int stage) {
 //  outputting ICs, and computing initial time step
 
 void Driver::Initialize(Mesh *pmesh, ParameterInput *pin, Outputs *pout, bool res_flag) {
+  timers.Start("initialize");
   //---- Step 1.  Set conserved variables in ghost zones for all physics
   InitBoundaryValuesAndPrimitives(pmesh);
 
@@ -296,6 +504,7 @@ void Driver::Initialize(Mesh *pmesh, ParameterInput *pin, Outputs *pout, bool re
 
   //---- Step 3.  Cycle through output Types and load data / write files.
   if (!res_flag) { // only write outputs at the beginning of the run
+    pout->StageOutputData(pmesh, pout->pout_list);
     for (auto &out : pout->pout_list) {
       out->LoadOutputData(pmesh);
       out->WriteOutputFile(pmesh, pin);
@@ -305,6 +514,15 @@ void Driver::Initialize(Mesh *pmesh, ParameterInput *pin, Outputs *pout, bool re
   //---- Step 4.  Initialize various counters, timers, etc.
   run_time_.reset();
   nmb_updated_ = 0;
+  for (int n=0; n<4; ++n) {telemetry_phase_[n] = 0.0;}
+  telemetry_start_ = 0.0;
+  telemetry_ncycle_ = pmesh->ncycle;
+  telemetry_nmb_updated_ = 0;
+  telemetry_nmb_created_ = (pmesh->pmr != nullptr)? pmesh->pmr->nmb_created : 0;
+  telemetry_nmb_deleted_ = (pmesh->pmr != nullptr)? pmesh->pmr->nmb_deleted : 0;
+  telemetry_comm_[0] = 0.0;
+  telemetry_comm_[1] = 0.0;
+  telemetry_energy_ = 0.0;
 
   // allocate memory for stiff source terms with ImEx integrators
   // only implemented for ion-neutral two fluid for now
@@ -323,7 +541,12 @@ void Driver::Initialize(Mesh *pmesh, ParameterInput *pin, Outputs *pout, bool re
     int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
     Kokkos::realloc(impl_src, nimp_stages, nmb, 8, ncells3, ncells2, ncells1);
   }
+  timers.Stop();
 
+  // report device memory used by each module (<job>/memory_report)
+  MemoryRegistry::Report("at startup");
+  // report thread binding with <job>/numa_first_touch
+  FirstTouch::Report(pmesh->pmb_pack->nmb_thispack);
   return;
 }
 
@@ -346,18 +569,46 @@ void Driver::Execute(Mesh *pmesh, ParameterInput *pin, Outputs *pout) {
     if (wall_time > 0.) {
       elapsed_time = UpdateWallClock();
     }
-    while ((pmesh->time < tlim) && (pmesh->ncycle < nlim || nlim < 0) &&
-           (elapsed_time < wall_time)) {
+    timers.Start("main_loop");
+    if (mpi_progress_) {progress_thread_.Start(mpi_progress_us_);}
+    // with multirate fluid evolution the fluid lags the spacetime between fluid cycles,
+    // so a stop on the wall clock or a signal is delayed by one cycle, which is taken as
+    // the last so that the fluid is advanced before the final outputs and restart
+    dyngr::DynGRMHD *pdyngr = pmesh->pmb_pack->pdyngr;
+    bool multirate = (pdyngr != nullptr && pdyngr->nmultirate > 1);
+    while ((pmesh->time < tlim) && (pmesh->ncycle < nlim || nlim < 0)) {
+      if ((elapsed_time + wall_reserve_ >= wall_time) || stop_signal_ ||
+          RescaleDue(pmesh)) {
+        if (!(multirate) || stop_delayed_) break;
+        stop_delayed_ = true;
+      }
       if (global_variable::my_rank == 0) {OutputCycleDiagnostics(pmesh);}
+      SetOutputsDue(pmesh, pout);
+      double tphase = run_time_.seconds();
 
       // Execute TaskLists
       // Work before time integrator indicated by "0" in stage
       ExecuteTaskList(pmesh, "before_timeintegrator", 0);
 
+      // super-time-stepping of diffusion terms over full timestep.  Number of RKL2
+      // stages s set by stability, dt <= dt_diff*(s^2+s-2)/4, rounded up to odd s>=3
+      if (use_sts) {
+        Real ratio = pmesh->dt/pmesh->dt_diff;
+        nsts_stages = static_cast<int>(std::ceil(0.5*(std::sqrt(9.0+16.0*ratio)-1.0)));
+        nsts_stages = std::max(nsts_stages, 3);
+        if (nsts_stages % 2 == 0) {nsts_stages++;}
+        for (int stage=1; stage<=nsts_stages; ++stage) {
+          ExecuteTaskList(pmesh, "before_sts", stage);
+          ExecuteTaskList(pmesh, "sts", stage);
+          ExecuteTaskList(pmesh, "after_sts", stage);
+        }
+      }
+
       // time-integrator tasks for each stage of integrator
       for (int stage=1; stage<=(nexp_stages); ++stage) {
         ExecuteTaskList(pmesh, "before_stagen", stage);
         ExecuteTaskList(pmesh, "stagen", stage);
+        if (overlap_dt_reduce_ && stage == nexp_stages) {pmesh->StartNewTimeStep();}
         ExecuteTaskList(pmesh, "after_stagen", stage);
       }
 
@@ -380,47 +631,119 @@ void Driver::Execute(Mesh *pmesh, ParameterInput *pin, Outputs *pout) {
             static_cast<float>(pmesh->nmb_total);
       }
 
+      // time of each phase of cycle for telemetry (without fences, so device work still
+      // running at the end of one phase is attributed to the next)
+      double tnow = run_time_.seconds();
+      telemetry_phase_[0] += tnow - tphase;
+      tphase = tnow;
+
       // Test for/make outputs
+      timers.Start("outputs");
+      std::vector<BaseTypeOutput*> due;
       for (auto &out : pout->pout_list) {
-        // compare at floating point (32-bit) precision to reduce effect of round off
-        float time_32 = static_cast<float>(pmesh->time);
-        float next_32 = static_cast<float>(out->out_params.last_time+out->out_params.dt);
-        float tlim_32 = static_cast<float>(tlim);
-        int &dcycle_ = out->out_params.dcycle;
-
-        if (((out->out_params.dt > 0.0) && ((time_32 >= next_32) && (time_32<tlim_32))) ||
-            ((dcycle_ > 0) && ((pmesh->ncycle)%(dcycle_) == 0)) ) {
-          out->LoadOutputData(pmesh);
-          out->WriteOutputFile(pmesh, pin);
+        out->Accumulate(pmesh);
+        if (IsOutputCycle(out->out_params, pmesh->time, pmesh->ncycle)) {
+          due.push_back(out);
         }
       }
+      // variables read by several outputs on this cycle are transferred only once
+      pout->StageOutputData(pmesh, due);
+      for (auto &out : due) {
+        double tout = run_time_.seconds();
+        out->LoadOutputData(pmesh);
+        out->WriteOutputFile(pmesh, pin);
+        if (predict_checkpoint_) {
+          double &tmax = output_wtime_[out];
+          tmax = std::max(tmax, run_time_.seconds() - tout);
+        }
+      }
+      timers.Stop();
+      tnow = run_time_.seconds();
+      telemetry_phase_[1] += tnow - tphase;
+      tphase = tnow;
 
       // AMR
+      timers.Start("amr");
       if (pmesh->adaptive) {pmesh->pmr->AdaptiveMeshRefinement(this, pin);}
+      // Automatic load balancing using measured cost of each MeshBlock
+      if (pmesh->lb_automatic && (pmesh->ncycle % pmesh->lb_interval == 0)) {
+        pmesh->pmr->RebalanceMeshBlocks(this, pin);
+      }
+      timers.Stop();
+      tnow = run_time_.seconds();
+      telemetry_phase_[2] += tnow - tphase;
+      tphase = tnow;
       // compute new timestep AFTER all Meshblocks refined/derefined
-      pmesh->NewTimeStep(tlim);
+      timers.Start("new_timestep");
+      if (lag_dt_reduce_) {
+        pmesh->FinishLaggedTimeStep(tlim, lag_dt_sync_cycles_);
+      } else if (overlap_dt_reduce_) {
+        pmesh->FinishNewTimeStep(tlim);
+      } else {
+        pmesh->NewTimeStep(tlim);
+      }
+      timers.Stop();
+      telemetry_phase_[3] += run_time_.seconds() - tphase;
+
+      // periodic profiling report
+      if (timers.enabled && profile_dcycle_ > 0 && pmesh->ncycle % profile_dcycle_ == 0) {
+        WriteProfile(pmesh, false);
+      }
+
+      // periodic telemetry record
+      if (telemetry_dcycle_ > 0 && pmesh->ncycle % telemetry_dcycle_ == 0) {
+        WriteTelemetry(pmesh);
+      }
 
       // Update wall clock time if needed.
       if (wall_time > 0.) {
+        Real tlast = elapsed_time;
         elapsed_time = UpdateWallClock();
+        cycle_wtime_ = std::max(cycle_wtime_, static_cast<double>(elapsed_time - tlast));
       }
+      if (catch_signals_) {stop_signal_ = SignalReceived();}
     }  // end while
+    pmesh->WaitNewTimeStep();
+    progress_thread_.Stop();
+    timers.Stop();
   }    // end of (time_evolution != tstatic) clause
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn bool Driver::RescaleDue()
+//! \brief true once the run has reached <job>/rescale_cycle, in which case Execute()
+//! returns so that the run continues on a different number of ranks (and Finalize() is
+//! not called).
+
+bool Driver::RescaleDue(Mesh *pm) const {
+  return (rescale_cycle >= 0 && pm->ncycle >= rescale_cycle && pm->time < tlim &&
+          (pm->ncycle < nlim || nlim < 0));
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn Driver::Finalize()
 //! \brief Tasks to be performed after execution of Driver, such as making final output
 //!  and printing diagnostic messages
 
 void Driver::Finalize(Mesh *pmesh, ParameterInput *pin, Outputs *pout) {
+  // diagnostics computed only when an output is due may be stale if the run stopped on
+  // a cycle that was not predicted to be the last (e.g. on the wall clock limit)
+  if (time_evolution != TimeEvolution::tstatic && !last_cycle_due_ &&
+      pmesh->pmb_pack->pz4c != nullptr) {
+    pmesh->pmb_pack->pz4c->Diagnostics(true, true);
+  }
+
   // cycle through output Types and load data / write files
   //  This design allows for asynchronous outputs to implemented in the future.
+  timers.Start("final_outputs");
+  pout->StageOutputData(pmesh, pout->pout_list);
   for (auto &out : pout->pout_list) {
     out->LoadOutputData(pmesh);
     out->WriteOutputFile(pmesh, pin);
+    out->Flush(pmesh);
   }
+  timers.Stop();
 
   // call any problem specific functions to do work after main loop
   if (pmesh->pgen->pgen_final_func != nullptr) {
@@ -429,12 +752,36 @@ void Driver::Finalize(Mesh *pmesh, ParameterInput *pin, Outputs *pout) {
 
   float exe_time = run_time_.seconds();
 
+  // energy used by devices of all ranks, time in low state and switches (max over ranks)
+  double energy[3] = {power.Energy(), power.LowTime(),
+                      static_cast<double>(power.NSwitch())};
+  if (power.requested) {
+#if MPI_PARALLEL_ENABLED
+    MPI_Allreduce(MPI_IN_PLACE, &energy[0], 1, MPI_DOUBLE, MPI_SUM,
+                  global_variable::athena_comm);
+    MPI_Allreduce(MPI_IN_PLACE, &energy[1], 2, MPI_DOUBLE, MPI_MAX,
+                  global_variable::athena_comm);
+#endif
+  }
+  power.Restore();
+
   if (time_evolution != TimeEvolution::tstatic) {
 #if MPI_PARALLEL_ENABLED
-    // Collect number of MeshBlocks communicated during load balancing across all ranks
-    if (pmesh->adaptive) {
-      MPI_Allreduce(MPI_IN_PLACE, &(pmesh->pmr->nmb_sent_thisrank), 1, MPI_INT, MPI_SUM,
-                    MPI_COMM_WORLD);
+    // Collect number of MeshBlocks communicated during load balancing across all ranks,
+    // and peak size (in MB) of device send/recv buffers for AMR over all ranks
+    float amr_buff_size = 0.0;
+    if (pmesh->adaptive || pmesh->lb_automatic) {
+      std::size_t nbuff = pmesh->pmr->send_data.size() + pmesh->pmr->recv_data.size();
+      amr_buff_size = static_cast<float>(nbuff*sizeof(Real))/1048576.0;
+      GlobalReductions &gr = pmesh->greduce;
+      gr.Clear();
+      int hsent = gr.Add("nmb_sent", pmesh->pmr->nmb_sent_thisrank, ReduceOp::sum);
+      int hbuff = gr.Add("amr_buff_size", amr_buff_size, ReduceOp::max);
+      gr.Start();
+      gr.Finish();
+      pmesh->pmr->nmb_sent_thisrank = static_cast<int>(gr.Result(hsent));
+      amr_buff_size = static_cast<float>(gr.Result(hbuff));
+      gr.Clear();
     }
 #endif
     if (global_variable::my_rank == 0) {
@@ -444,6 +791,11 @@ void Driver::Finalize(Mesh *pmesh, ParameterInput *pin, Outputs *pout) {
         std::cout << std::endl << "Terminating on cycle limit" << std::endl;
       } else if (pmesh->time >= tlim) {
         std::cout << std::endl << "Terminating on time limit" << std::endl;
+      } else if (stop_signal_) {
+        std::cout << std::endl << "Terminating on signal from scheduler" << std::endl;
+      } else if (predict_checkpoint_) {
+        std::cout << std::endl << "Terminating before wall clock limit, " << wall_reserve_
+                  << " s reserved for last cycle and final outputs" << std::endl;
       } else {
         std::cout << std::endl << "Terminating on wall clock limit" << std::endl;
       }
@@ -458,6 +810,8 @@ void Driver::Finalize(Mesh *pmesh, ParameterInput *pin, Outputs *pout) {
 #if MPI_PARALLEL_ENABLED
         std::cout << pmesh->pmr->nmb_sent_thisrank << " communicated for load balancing, "
           <<"load balancing efficiency = " << (lb_efficiency_/pmesh->ncycle) << std::endl;
+        std::cout << "peak size of AMR send/recv buffers = " << amr_buff_size
+          << " MB (max over ranks)" << std::endl;
 #endif
       }
 
@@ -472,11 +826,121 @@ void Driver::Finalize(Mesh *pmesh, ParameterInput *pin, Outputs *pout) {
       std::cout << "cpu time used  = " << exe_time << std::endl;
       std::cout << "zone-cycles/cpu_second = " << zcps << std::endl;
       std::cout << "particle-updates/cpu_second = " << pups << std::endl;
+      if (power.requested && energy[0] > 0.0) {
+        std::cout << "device energy used (J) = " << energy[0] << std::endl;
+        std::cout << "zone-cycles/joule = " << static_cast<double>(zonecycles)/energy[0]
+                  << std::endl;
+        std::cout << "time at low clocks (s) = " << energy[1] << " in "
+                  << static_cast<int>(energy[2]) << " phases (max over ranks)"
+                  << std::endl;
+      }
     }
+
+    // print time each Task spent stuck on this rank, if measured
+    bool task_timing = pin->GetOrAddBoolean("time","task_timing",false);
+    if (global_variable::my_rank == 0 && task_timing) {
+      std::cout << std::endl << "Time (s) Tasks spent waiting on rank 0:" << std::endl;
+      for (auto &it : pmesh->pmb_pack->tl_map) {
+        for (int n=0; n<it.second->Size(); ++n) {
+          double t = it.second->GetStuckTime(n);
+          if (t > 0.0) {
+            std::cout << "  " << it.first << " task " << n << " : " << t << std::endl;
+          }
+        }
+      }
+    }
+  }
+
+  // write (and print) final profiling report
+  if (timers.enabled) {WriteProfile(pmesh, true);}
+
+  // report current and peak device memory used by each module
+  MemoryRegistry::Report("at end of run");
+  pmesh->scratch.Report("at end of run");
+
+  // write (and print) report of achieved rates of timed kernels
+  if (pmesh->kcounter.enabled) {
+    pmesh->kcounter.WriteReport(pin->GetString("job", "basename") + ".roofline", true);
   }
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn Driver::WriteProfile()
+//! \brief Adds time spent in each Task to the timed regions, then writes report of
+//! min/mean/max over ranks to profile file.
+//! The first report truncates the file, later reports are appended.
+
+void Driver::WriteProfile(Mesh *pm, bool print) {
+  for (auto &it : pm->pmb_pack->tl_map) {
+    for (int n=0; n<it.second->Size(); ++n) {
+      timers.Set("tasks/" + it.first + "/task" + std::to_string(n),
+                 it.second->GetRunTime(n), it.second->GetNCalls(n));
+    }
+  }
+  timers.WriteReport(profile_file_, pm->ncycle, profile_written_, print);
+  profile_written_ = true;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Driver::IsOutputCycle()
+//! \brief true if an output with parameters op is written once time and ncycle have been
+//! reached at the end of a cycle
+
+bool Driver::IsOutputCycle(const OutputParameters &op, Real time, int ncycle) const {
+  // compare at floating point (32-bit) precision to reduce effect of round off
+  float time_32 = static_cast<float>(time);
+  float next_32 = static_cast<float>(op.last_time + op.dt);
+  float tlim_32 = static_cast<float>(tlim);
+  return (((op.dt > 0.0) && ((time_32 >= next_32) && (time_32 < tlim_32))) ||
+          ((op.dcycle > 0) && (ncycle%(op.dcycle) == 0)));
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Driver::SetOutputsDue()
+//! \brief Predicts which outputs will be written at the end of the cycle about to be
+//! taken.  If the cycle will be the last, all outputs are written by Finalize().  Outputs
+//! that sample their variables on this cycle (time averages) are also included, so that
+//! OutputDue() is true for the arrays they read.
+
+void Driver::SetOutputsDue(Mesh *pm, Outputs *pout) {
+  Real time_next = pm->time + pm->dt;
+  int ncycle_next = pm->ncycle + 1;
+  last_cycle_due_ = (time_next >= tlim) || (nlim >= 0 && ncycle_next >= nlim) ||
+                    stop_delayed_;
+  outputs_due_.clear();
+  for (auto &out : pout->pout_list) {
+    if (last_cycle_due_ || IsOutputCycle(out->out_params, time_next, ncycle_next) ||
+        out->SampleDue(ncycle_next)) {
+      outputs_due_.push_back(out);
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Driver::OutputDue()
+//! \brief true if any output written at the end of this cycle reads the array parray
+
+bool Driver::OutputDue(const DvceArray5D<Real> *parray) const {
+  for (auto &out : outputs_due_) {
+    if (out->ReadsArray(parray)) return true;
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Driver::RestartDue()
+//! \brief true if a restart file will be written at the end of this cycle
+
+bool Driver::RestartDue() const {
+  for (auto &out : outputs_due_) {
+    if (out->out_params.file_type.compare("rst") == 0) return true;
+  }
+  return false;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn Driver::OutputCycleDiagnostics()
 //! \brief Simple function to print diagnostics every 'ndiag' cycles to stdout
@@ -491,6 +955,105 @@ void Driver::OutputCycleDiagnostics(Mesh *pm) {
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn Driver::WriteTelemetry()
+//! \brief Appends one line to the telemetry file containing a JSON object of metrics
+//! accumulated since the last record: zone-cycles/s, maximum and mean over ranks of the
+//! time spent in each phase of the cycle (tasks, outputs, amr, new_timestep), total
+//! bytes sent and maximum time waiting for communication over ranks, device memory
+//! (with <job>/memory_report), energy used by devices summed over ranks (with
+//! <time>/power_control or power_report), and MeshBlocks created/deleted by AMR.  The
+//! file is closed after every record, so it can be followed by an external monitoring
+//! tool.
+//! Must be called by all ranks.
+
+void Driver::WriteTelemetry(Mesh *pm) {
+  double tnow = run_time_.seconds();
+  int ncycles = pm->ncycle - telemetry_ncycle_;
+
+  // bytes sent and time waiting for communication since last record (CommCounters may
+  // also be reset by the "comm" output, in which case the totals are used)
+  double comm[2] = {0.0, pm->ccounter.t_recv + pm->ccounter.t_send + pm->ccounter.t_dt};
+  for (auto &it : pm->ccounter.nghbr) {comm[0] += static_cast<double>(it.second.bsend);}
+  double dcomm[2];
+  for (int n=0; n<2; ++n) {
+    dcomm[n] = (comm[n] >= telemetry_comm_[n])? (comm[n] - telemetry_comm_[n]) : comm[n];
+    telemetry_comm_[n] = comm[n];
+  }
+
+  // max over ranks of elapsed time, phase times, comm wait, and memory; sum over ranks
+  // of phase times and bytes sent
+  double vmax[8] = {tnow - telemetry_start_, telemetry_phase_[0], telemetry_phase_[1],
+                    telemetry_phase_[2], telemetry_phase_[3], dcomm[1],
+                    MemoryRegistry::CurrentBytes()/1.048576e6,
+                    MemoryRegistry::PeakBytes()/1.048576e6};
+  double energy = power.Energy();
+  double vsum[6] = {telemetry_phase_[0], telemetry_phase_[1], telemetry_phase_[2],
+                    telemetry_phase_[3], dcomm[0], energy - telemetry_energy_};
+  telemetry_energy_ = energy;
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, vmax, 8, MPI_DOUBLE, MPI_MAX, global_variable::athena_comm);
+  MPI_Allreduce(MPI_IN_PLACE, vsum, 6, MPI_DOUBLE, MPI_SUM, global_variable::athena_comm);
+#endif
+
+  int nmb_created = 0, nmb_deleted = 0;
+  if (pm->pmr != nullptr) {
+    nmb_created = pm->pmr->nmb_created - telemetry_nmb_created_;
+    nmb_deleted = pm->pmr->nmb_deleted - telemetry_nmb_deleted_;
+    telemetry_nmb_created_ = pm->pmr->nmb_created;
+    telemetry_nmb_deleted_ = pm->pmr->nmb_deleted;
+  }
+  double zonecycles = static_cast<double>(nmb_updated_ - telemetry_nmb_updated_)*
+                      static_cast<double>(pm->NumberOfMeshBlockCells());
+
+  if (global_variable::my_rank == 0) {
+    FILE *pfile;
+    if ((pfile = std::fopen(telemetry_file_.c_str(),"a")) == nullptr) {
+      std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+                << "Telemetry file '" << telemetry_file_ << "' could not be opened, "
+                << "telemetry disabled" << std::endl;
+      telemetry_dcycle_ = 0;
+    } else {
+      const char *phase[4] = {"tasks", "outputs", "amr", "new_timestep"};
+      int nranks = global_variable::nranks;
+      std::fprintf(pfile, "{\"cycle\": %d, \"time\": %.8e, \"dt\": %.8e, ",
+                   pm->ncycle, pm->time, pm->dt);
+      std::fprintf(pfile, "\"ncycles\": %d, \"wall_time\": %.6e, ", ncycles, vmax[0]);
+      std::fprintf(pfile, "\"zone_cycles_per_second\": %.6e, ",
+                   (vmax[0] > 0.0)? zonecycles/vmax[0] : 0.0);
+      if (power.requested) {
+        std::fprintf(pfile, "\"energy_j\": %.6e, \"zone_cycles_per_joule\": %.6e, ",
+                     vsum[5], (vsum[5] > 0.0)? zonecycles/vsum[5] : 0.0);
+      }
+      std::fprintf(pfile, "\"phase_time\": {");
+      for (int n=0; n<4; ++n) {
+        std::fprintf(pfile, "%s\"%s\": {\"max\": %.6e, \"mean\": %.6e}",
+                     (n > 0)? ", " : "", phase[n], vmax[n+1], vsum[n]/nranks);
+      }
+      std::fprintf(pfile, "}, \"comm_bytes_sent\": %.0f, \"comm_wait_max\": %.6e, ",
+                   vsum[4], vmax[5]);
+      if (MemoryRegistry::Enabled()) {
+        std::fprintf(pfile, "\"memory_mb\": {\"current\": %.2f, \"peak\": %.2f}, ",
+                     vmax[6], vmax[7]);
+      }
+      std::fprintf(pfile, "\"nmb_total\": %d, \"nmb_created\": %d, ", pm->nmb_total,
+                   nmb_created);
+      std::fprintf(pfile, "\"nmb_deleted\": %d}\n", nmb_deleted);
+      std::fclose(pfile);
+    }
+  }
+#if MPI_PARALLEL_ENABLED
+  MPI_Bcast(&telemetry_dcycle_, 1, MPI_INT, 0, global_variable::athena_comm);
+#endif
+
+  // reset accumulators
+  for (int n=0; n<4; ++n) {telemetry_phase_[n] = 0.0;}
+  telemetry_start_ = tnow;
+  telemetry_ncycle_ = pm->ncycle;
+  telemetry_nmb_updated_ = nmb_updated_;
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn Driver::UpdateWallClock()
 //! \brief Update and sync the wall clock across all MPI ranks. This is necessary because
@@ -500,14 +1063,33 @@ void Driver::OutputCycleDiagnostics(Mesh *pm) {
 //! slightly below the wall clock time while others determine that it's time to quit.
 
 Real Driver::UpdateWallClock() {
-  Real tnow;
+  // elapsed time and (with predict_checkpoint) reserved time measured on rank 0
+  Real tnow[2] = {0.0, 0.0};
   if (global_variable::my_rank == 0) {
-    tnow = pwall_clock_->seconds();
+    tnow[0] = pwall_clock_->seconds();
+    if (predict_checkpoint_) {
+      double twrite = 0.0;
+      for (auto &it : output_wtime_) {twrite += it.second;}
+      tnow[1] = checkpoint_safety_*(cycle_wtime_ + twrite);
+    }
   }
 #if MPI_PARALLEL_ENABLED
-  MPI_Bcast(&tnow, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  MPI_Bcast(tnow, 2, MPI_ATHENA_REAL, 0, global_variable::athena_comm);
+#endif
+  wall_reserve_ = tnow[1];
+  return tnow[0];
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Driver::SignalReceived()
+//! \brief Returns true on all ranks if SIGTERM or SIGUSR1 has been caught on any rank.
+
+bool Driver::SignalReceived() {
+  int caught = (signal_caught != 0)? 1 : 0;
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, &caught, 1, MPI_INT, MPI_MAX, global_variable::athena_comm);
 #endif
-  return tnow;
+  return (caught != 0);
 }
 
 //----------------------------------------------------------------------------------------
@@ -579,6 +1161,9 @@ void Driver::InitBoundaryValuesAndPrimitives(Mesh *pm) {
     } else {
       if (pz4c != nullptr) {
         (void) pz4c->Z4cToADM_(this, 0);
+      } else if (pm->pmb_pack->padm->cache_metric) {
+        // fixed spacetime is now set by problem generator (or restart)
+        pm->pmb_pack->padm->CacheMetric();
       }
       (void) pdyngr->ConToPrim(this, 0);
     }
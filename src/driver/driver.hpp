@@ -13,12 +13,17 @@
 // called in Finalize().
 
 #include <ctime>
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "parameter_input.hpp"
 #include "outputs/outputs.hpp"
 #include "pgen/pgen.hpp"
+#include "utils/mpi_progress.hpp"
+#include "utils/power_manager.hpp"
+#include "utils/region_timers.hpp"
 
 //----------------------------------------------------------------------------------------
 //! \class Driver
@@ -40,12 +45,21 @@ class Driver {
   std::string integrator;          // integrator name (rk1, rk2, rk3)
   int nimp_stages;                 // number of implicit stages (ImEx only)
   int nexp_stages;                 // number of explicit stages (both SSP-RK and ImEx)
-  Real gam0[4], gam1[4], beta[4];  // weights and fractional timestep per explicit stage
-  Real delta[4];                   // weights for updating the intermediate stage (u1)
+  Real gam0[10], gam1[10], beta[10];  // weights and fractional timestep per stage
+  Real delta[10];                  // weights for updating the intermediate stage (u1)
+  bool use_delta;                  // u1 += delta*u0 each stage (2S low-storage methods)
+  Real cstage[10];                 // fraction of timestep at start of each explicit stage
   Real a_twid[4][4], a_impl;       // matrix elements for implicit stages in ImEx
   Real cfl_limit;                  // maximum CFL number for integrator
+  // variables for super-time-stepping (STS) of diffusion terms
+  bool use_sts;                    // STS enabled (<time>/sts_integrator=rkl2)
+  int nsts_stages;                 // number of RKL2 stages in current cycle
   Kokkos::Timer* pwall_clock_;     // timer for tracking the wall clock
   Real wall_time;
+  RegionTimers timers;             // wall-clock time in named regions (<time>/profile)
+  int rescale_cycle;               // cycle after which run continues on new # of ranks
+  int rescale_nranks;              // number of ranks on which run continues
+  PowerManager power;              // GPU energy and per-phase clocks (<time>/power_*)
 
   // functions
   void ExecuteTaskList(Mesh *pm, std::string tl, int stage);
@@ -53,13 +67,57 @@ class Driver {
   void Execute(Mesh *pmesh, ParameterInput *pin, Outputs *pout);
   void Finalize(Mesh *pmesh, ParameterInput *pin, Outputs *pout);
   void InitBoundaryValuesAndPrimitives(Mesh *pm);
+  // true if an output that reads the given array will be written at the end of this
+  // cycle, so that diagnostics used only by outputs can be skipped on other cycles
+  bool OutputDue(const DvceArray5D<Real> *parray) const;
+  // true if a restart file will be written at the end of this cycle
+  bool RestartDue() const;
+  // true if run must continue on rescale_nranks ranks rather than finish
+  bool RescaleDue(Mesh *pm) const;
 
  private:
   Kokkos::Timer run_time_;      // generalized timer for cpu/gpu/etc
   std::uint64_t nmb_updated_;   // running total of MB updated during run
   std::uint64_t npart_updated_; // running total of particles updated during run
   float lb_efficiency_;         // measure of how efficient was load balancing
+  int max_idle_wait_us_;        // max back-off (microsec) when all TaskLists are stuck
+  bool overlap_dt_reduce_;      // overlap allreduce of new dt with after_stagen tasks
+  bool lag_dt_reduce_;          // use allreduce of new dt from previous cycle
+  int lag_dt_sync_cycles_;      // cycles of synchronous allreduce after CFL violation
+  bool mpi_progress_;           // run MPI progress thread during main loop
+  int mpi_progress_us_;         // interval (microsec) between polls of progress thread
+  MPIProgressThread progress_thread_;
+  std::vector<BaseTypeOutput*> outputs_due_;  // outputs written/sampled at end of cycle
+  bool last_cycle_due_;         // true if final outputs were predicted on last cycle
+  bool stop_delayed_;           // stop on wall clock/signal delayed to close fluid cycle
+  bool IsOutputCycle(const OutputParameters &op, Real time, int ncycle) const;
+  void SetOutputsDue(Mesh *pm, Outputs *pout);
   void OutputCycleDiagnostics(Mesh *pm);
   Real UpdateWallClock();
+  // predictive scheduling of final outputs (and restart) before the wall clock limit
+  bool predict_checkpoint_;     // stop early so final outputs finish before wall_time
+  Real checkpoint_safety_;      // factor multiplying predicted time of last cycle+outputs
+  Real wall_reserve_;           // wall time (on rank 0) reserved for last cycle+outputs
+  double cycle_wtime_;          // longest wall time of a cycle on rank 0
+  std::map<BaseTypeOutput*, double> output_wtime_;  // longest write time of each output
+  // stopping (and writing final restart) on SIGTERM/SIGUSR1 sent by the scheduler
+  bool catch_signals_;
+  bool stop_signal_;            // true once a signal has been caught on any rank
+  bool SignalReceived();
+  int profile_dcycle_;          // cycles between profiling reports (0 = only at end)
+  bool profile_written_;        // true once first profiling report has been written
+  std::string profile_file_;    // name of file of profiling reports
+  void WriteProfile(Mesh *pm, bool print);
+  int telemetry_dcycle_;        // cycles between telemetry records (0 = disabled)
+  std::string telemetry_file_;  // name of append-only JSONL file of telemetry records
+  double telemetry_phase_[4];   // time in each phase of cycles since last record
+  double telemetry_start_;      // run time at last telemetry record
+  int telemetry_ncycle_;        // cycle of last telemetry record
+  std::uint64_t telemetry_nmb_updated_;  // MBs updated during run at last record
+  int telemetry_nmb_created_;   // MeshBlocks created by AMR at last telemetry record
+  int telemetry_nmb_deleted_;   // MeshBlocks deleted by AMR at last telemetry record
+  double telemetry_comm_[2];    // bytes sent and comm wait on this rank at last record
+  double telemetry_energy_;     // energy used by device of this rank at last record
+  void WriteTelemetry(Mesh *pm);
 };
 #endif // DRIVER_DRIVER_HPP_
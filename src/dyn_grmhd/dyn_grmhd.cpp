@@ -9,6 +9,7 @@
 
 #include <math.h>
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -94,7 +95,13 @@ DynGRMHD* BuildDynGRMHD(MeshBlockPack *ppack, ParameterInput *pin) {
   return dyn_gr;
 }
 
-DynGRMHD::DynGRMHD(MeshBlockPack *pp, ParameterInput *pin) : pmy_pack(pp) {
+DynGRMHD::DynGRMHD(MeshBlockPack *pp, ParameterInput *pin) :
+    pmy_pack(pp),
+    u_adm_old("u_adm_old",1,1,1,1,1),
+    u_adm_mr("u_adm_mr",1,1,1,1,1),
+    u_tmunu_old("u_tmunu_old",1,1,1,1,1),
+    mb_active("mb_active",1),
+    mb_change("mb_change",1) {
   std::string rsolver = pin->GetString("mhd", "rsolver");
   if (rsolver.compare("llf") == 0) {
     rsolver_method = DynGRMHD_RSolver::llf_dyngr;
@@ -122,6 +129,67 @@ DynGRMHD::DynGRMHD(MeshBlockPack *pp, ParameterInput *pin) : pmy_pack(pp) {
   dmp_M = pin->GetOrAddReal("mhd", "dmp_M", 1.2);
 
   fixed_evolution = pin->GetOrAddBoolean("mhd", "fixed", false);
+
+  // multirate evolution, in which the fluid is advanced once every nmultirate cycles of
+  // the spacetime using the metric interpolated in time
+  nmultirate = pin->GetOrAddInteger("mhd", "multirate", 1);
+  if (nmultirate < 1) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "<mhd> multirate = " << nmultirate
+              << " must be >= 1" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  if (nmultirate > 1 && (pp->pmesh->adaptive || pp->pmesh->lb_automatic)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "<mhd> multirate > 1 cannot be used with mesh refinement"
+              << " or automatic load balancing" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
+  // evaluate the matter sources of the Z4c RHS and diagnostics on the fly from the fluid
+  // variables and metric, rather than storing them in u_tmunu every stage
+  fused_tmunu = pin->GetOrAddBoolean("mhd", "fused_tmunu", false);
+  if (fused_tmunu && (nmultirate > 1 || fixed_evolution)) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<mhd> fused_tmunu cannot be used with multirate > 1 or fixed = true, "
+              << "it will be disabled" << std::endl;
+    fused_tmunu = false;
+  }
+
+  // skip fluxes, source terms, and C2P on MBs in which the density (including ghost
+  // zones) is everywhere below atmosphere_factor times the atmosphere threshold
+  skip_atmosphere = pin->GetOrAddBoolean("mhd", "skip_atmosphere", false);
+  atmosphere_factor = pin->GetOrAddReal("mhd", "atmosphere_factor", 10.0);
+  active_version = -1;
+  nsub_cycle = nmultirate - 1;
+  fluid_cycle = true;
+  update_tmunu = true;
+  time_fluid = pp->pmesh->time;
+  if (nmultirate > 1) {
+    int nmb = std::max((pp->nmb_thispack), (pp->pmesh->nmb_maxperrank));
+    auto &indcs = pp->pmesh->mb_indcs;
+    int ncells1 = indcs.nx1 + 2*(indcs.ng);
+    int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
+    int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
+    Kokkos::realloc(u_adm_old, nmb, adm::ADM::nadm, ncells3, ncells2, ncells1);
+    Kokkos::realloc(u_adm_mr, nmb, adm::ADM::nadm, ncells3, ncells2, ncells1);
+    adm_old.alpha.InitWithShallowSlice(u_adm_old, adm::ADM::I_ADM_ALPHA);
+    adm_old.beta_u.InitWithShallowSlice(u_adm_old, adm::ADM::I_ADM_BETAX,
+                                        adm::ADM::I_ADM_BETAZ);
+    adm_old.psi4.InitWithShallowSlice(u_adm_old, adm::ADM::I_ADM_PSI4);
+    adm_old.g_dd.InitWithShallowSlice(u_adm_old, adm::ADM::I_ADM_GXX,
+                                      adm::ADM::I_ADM_GZZ);
+    adm_old.vK_dd.InitWithShallowSlice(u_adm_old, adm::ADM::I_ADM_KXX,
+                                       adm::ADM::I_ADM_KZZ);
+    adm_mr.alpha.InitWithShallowSlice(u_adm_mr, adm::ADM::I_ADM_ALPHA);
+    adm_mr.beta_u.InitWithShallowSlice(u_adm_mr, adm::ADM::I_ADM_BETAX,
+                                       adm::ADM::I_ADM_BETAZ);
+    adm_mr.psi4.InitWithShallowSlice(u_adm_mr, adm::ADM::I_ADM_PSI4);
+    adm_mr.g_dd.InitWithShallowSlice(u_adm_mr, adm::ADM::I_ADM_GXX,
+                                     adm::ADM::I_ADM_GZZ);
+    adm_mr.vK_dd.InitWithShallowSlice(u_adm_mr, adm::ADM::I_ADM_KXX,
+                                      adm::ADM::I_ADM_KZZ);
+  }
 }
 
 DynGRMHD::~DynGRMHD() {
@@ -137,10 +205,24 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::QueueDynGRMHDTasks() {
   NumericalRelativity *pnr = pmy_pack->pnr;
 
   // Start task list
-  pnr->QueueTask(&MHD::InitRecv, pmhd, MHD_Recv, "MHD_Recv", Task_Start);
+  if (nmultirate > 1) {
+    pnr->QueueTask(&DynGRMHD::MultirateStart, this, MHD_MRStart, "MHD_MRStart",
+                   Task_Start);
+    pnr->QueueTask(&MHD::InitRecv, pmhd, MHD_Recv, "MHD_Recv", Task_Start,
+                   {MHD_MRStart});
+  } else {
+    pnr->QueueTask(&MHD::InitRecv, pmhd, MHD_Recv, "MHD_Recv", Task_Start);
+  }
 
   // Run task list
-  pnr->QueueTask(&MHD::CopyCons, pmhd, MHD_CopyU, "MHD_CopyU", Task_Run);
+  if (skip_atmosphere) {
+    pnr->QueueTask(&DynGRMHDPS<EOSPolicy, ErrorPolicy>::UpdateActiveBlocks, this,
+                   MHD_SetActive, "MHD_SetActive", Task_Run);
+    pnr->QueueTask(&MHD::CopyCons, pmhd, MHD_CopyU, "MHD_CopyU", Task_Run,
+                   {MHD_SetActive});
+  } else {
+    pnr->QueueTask(&MHD::CopyCons, pmhd, MHD_CopyU, "MHD_CopyU", Task_Run);
+  }
 
   // Select which CalculateFlux function to add based on rsolver_method.
   // CalcFlux requires metric in flux - must happen before z4ctoadm updates the metric
@@ -166,8 +248,11 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::QueueDynGRMHDTasks() {
   pnr->QueueTask(&MHD::RecvFlux, pmhd, MHD_RecvFlux, "MHD_RecvFlux",
                  Task_Run, {MHD_SendFlux});
   if (pz4c != nullptr) {
+    // with fused_tmunu the Z4c RHS reads u0, so it must be evaluated before the update
+    std::vector<TaskName> rkdep;
+    if (fused_tmunu) rkdep.push_back(Z4c_CalcRHS);
     pnr->QueueTask(&MHD::RKUpdate, pmhd, MHD_ExplRK, "MHD_ExplRK", Task_Run,
-                   {MHD_RecvFlux, MHD_SetTmunu});
+                   {MHD_RecvFlux, MHD_SetTmunu}, rkdep);
   } else {
     pnr->QueueTask(&MHD::RKUpdate, pmhd, MHD_ExplRK, "MHD_ExplRK", Task_Run,
                    {MHD_RecvFlux});
@@ -188,13 +273,162 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::QueueDynGRMHDTasks() {
   //pnr->QueueTask(&DynGRMHD::ApplyPhysicalBCs, this, MHD_BCS, "MHD_BCS", Task_Run,
   //                 {MHD_RecvB});
   pnr->QueueTask(&MHD::Prolongate, pmhd, MHD_Prolong, "MHD_Prolong", Task_Run, {MHD_BCS});
-  pnr->QueueTask(&DynGRMHDPS<EOSPolicy, ErrorPolicy>::ConToPrim, this, MHD_C2P, "MHD_C2P",
-                 Task_Run, {MHD_Prolong}, {Z4c_Excise});
+  if (nmultirate > 1) {
+    // metric at the fluid stage is needed for C2P and for the fluxes of next stage
+    pnr->QueueTask(&DynGRMHD::MultirateMetric, this, MHD_MRMetric, "MHD_MRMetric",
+                   Task_Run, {MHD_Prolong}, {Z4c_Excise});
+    pnr->QueueTask(&DynGRMHDPS<EOSPolicy, ErrorPolicy>::ConToPrim, this, MHD_C2P,
+                   "MHD_C2P", Task_Run, {MHD_MRMetric});
+  } else {
+    pnr->QueueTask(&DynGRMHDPS<EOSPolicy, ErrorPolicy>::ConToPrim, this, MHD_C2P,
+                   "MHD_C2P", Task_Run, {MHD_Prolong}, {Z4c_Excise});
+  }
   pnr->QueueTask(&MHD::NewTimeStep, pmhd, MHD_Newdt, "MHD_Newdt", Task_Run, {MHD_C2P});
 
   // End task list
   pnr->QueueTask(&MHD::ClearSend, pmhd, MHD_ClearS, "MHD_ClearS", Task_End);
   pnr->QueueTask(&MHD::ClearRecv, pmhd, MHD_ClearR, "MHD_ClearR", Task_End);
+  if (nmultirate > 1) {
+    pnr->QueueTask(&DynGRMHD::MultirateTmunu, this, MHD_MRTmunu, "MHD_MRTmunu",
+                   Task_End, {MHD_ClearR});
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Real DynGRMHD::FluidDt()
+//! \brief Timestep taken by the fluid on this cycle.  With multirate evolution this spans
+//! all the spacetime cycles since the fluid was last advanced.
+
+Real DynGRMHD::FluidDt() const {
+  Mesh *pm = pmy_pack->pmesh;
+  return (nmultirate > 1)? (pm->time + pm->dt - time_fluid) : pm->dt;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool DynGRMHD::MeshBlockActive()
+//! \brief true if the fluid is evolved on MB m of this pack, i.e. unless it was found to
+//! hold only atmosphere by UpdateActiveBlocks() (with <mhd>/skip_atmosphere=true).  Used
+//! to estimate the cost of each MB for load balancing.
+
+bool DynGRMHD::MeshBlockActive(int m) const {
+  if (!(skip_atmosphere) || active_version != pmy_pack->pmesh->mesh_version ||
+      m >= static_cast<int>(mb_active.h_view.extent(0))) {
+    return true;
+  }
+  return (mb_active.h_view(m) != 0);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus DynGRMHD::MultirateStart(Driver *pdrive, int stage)
+//! \brief At the start of each cycle, decides whether the fluid is advanced on it.  At
+//! the start of each fluid cycle, saves the metric at time_fluid.  The fluid is advanced
+//! on the last spacetime cycle of each fluid cycle (or the last cycle of the run, or a
+//! cycle that ends with a restart), from time_fluid to the end of the cycle, with the
+//! metric interpolated linearly in time.  Restarts therefore always hold the fluid and
+//! spacetime at the same time, and the next fluid cycle starts on the restart cycle.
+
+TaskStatus DynGRMHD::MultirateStart(Driver *pdrive, int stage) {
+  if (stage != 1) return TaskStatus::complete;
+  Mesh *pm = pmy_pack->pmesh;
+  auto &adm = pmy_pack->padm->adm;
+
+  nsub_cycle = (nsub_cycle + 1) % nmultirate;
+  if (nsub_cycle == 0) {
+    time_fluid = pm->time;
+    LerpADM(adm_old, adm, adm, 0.0);
+    // first fluid cycle: held Tmunu is that set by the problem generator
+    if (pmy_pack->ptmunu != nullptr &&
+        u_tmunu_old.extent(1) != pmy_pack->ptmunu->u_tmunu.extent(1)) {
+      auto &u_tmunu = pmy_pack->ptmunu->u_tmunu;
+      Kokkos::realloc(u_tmunu_old, u_tmunu.extent(0), u_tmunu.extent(1),
+                      u_tmunu.extent(2), u_tmunu.extent(3), u_tmunu.extent(4));
+      Kokkos::deep_copy(u_tmunu_old, u_tmunu);
+    }
+  }
+  update_tmunu = false;
+
+  fluid_cycle = (nsub_cycle == nmultirate - 1) || (pm->time + pm->dt >= pdrive->tlim) ||
+                (pdrive->nlim >= 0 && pm->ncycle + 1 >= pdrive->nlim) ||
+                pdrive->RestartDue();
+  if (fluid_cycle) {
+    nsub_cycle = nmultirate - 1;
+    LerpADM(adm_mr, adm_old, adm_old, 0.0);
+    pmy_pack->padm->adm_fluid = adm_mr;
+  }
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus DynGRMHD::MultirateMetric(Driver *pdrive, int stage)
+//! \brief Interpolates the metric to the time of the end of this fluid stage (the start
+//! of the next one), after the spacetime has been updated to the end of this stage.
+
+TaskStatus DynGRMHD::MultirateMetric(Driver *pdrive, int stage) {
+  Mesh *pm = pmy_pack->pmesh;
+  Real c = (stage < pdrive->nexp_stages)? pdrive->cstage[stage] : 1.0;
+  Real tdenom = pm->time + c*(pm->dt) - time_fluid;
+  Real w = (tdenom > 0.0)? c*FluidDt()/tdenom : 0.0;
+  LerpADM(adm_mr, adm_old, pmy_pack->padm->adm, w);
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus DynGRMHD::MultirateTmunu(Driver *pdrive, int stage)
+//! \brief At the end of each fluid cycle, computes Tmunu from the updated fluid and
+//! holds it fixed over the next fluid cycle at the value extrapolated linearly to the
+//! middle of that cycle.  Also restores the metric seen by the fluid.
+
+TaskStatus DynGRMHD::MultirateTmunu(Driver *pdrive, int stage) {
+  if (!fluid_cycle || stage != pdrive->nexp_stages) return TaskStatus::complete;
+  pmy_pack->padm->adm_fluid = pmy_pack->padm->adm;
+  if (pmy_pack->ptmunu == nullptr) return TaskStatus::complete;
+
+  update_tmunu = true;
+  SetTmunu(pdrive, 0);
+  update_tmunu = false;
+
+  auto &u_tmunu = pmy_pack->ptmunu->u_tmunu;
+  auto &u_old = u_tmunu_old;
+  int nmb = pmy_pack->nmb_thispack;
+  int nvar = u_tmunu.extent_int(1);
+  int n3m1 = u_tmunu.extent_int(2) - 1;
+  int n2m1 = u_tmunu.extent_int(3) - 1;
+  int n1m1 = u_tmunu.extent_int(4) - 1;
+  par_for("dyngr_mr_tmunu",DevExeSpace(),0,nmb-1,0,nvar-1,0,n3m1,0,n2m1,0,n1m1,
+  KOKKOS_LAMBDA(const int m, const int n, const int k, const int j, const int i) {
+    Real t1 = u_tmunu(m,n,k,j,i);
+    u_tmunu(m,n,k,j,i) = 1.5*t1 - 0.5*u_old(m,n,k,j,i);
+    u_old(m,n,k,j,i) = t1;
+  });
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void DynGRMHD::LerpADM
+//! \brief Sets dst = a + w*(b - a) for each ADM variable, in all cells including ghosts
+
+void DynGRMHD::LerpADM(adm::ADM::ADM_vars &dst, adm::ADM::ADM_vars &a,
+                       adm::ADM::ADM_vars &b, Real w) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int nmb = pmy_pack->nmb_thispack;
+  int n1m1 = indcs.nx1 + 2*indcs.ng - 1;
+  int n2m1 = (indcs.nx2 > 1)? (indcs.nx2 + 2*indcs.ng - 1) : 0;
+  int n3m1 = (indcs.nx3 > 1)? (indcs.nx3 + 2*indcs.ng - 1) : 0;
+  par_for("dyngr_mr_lerp",DevExeSpace(),0,nmb-1,0,n3m1,0,n2m1,0,n1m1,
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    dst.alpha(m,k,j,i) = a.alpha(m,k,j,i) + w*(b.alpha(m,k,j,i) - a.alpha(m,k,j,i));
+    dst.psi4(m,k,j,i) = a.psi4(m,k,j,i) + w*(b.psi4(m,k,j,i) - a.psi4(m,k,j,i));
+    for (int p=0; p<3; ++p) {
+      dst.beta_u(m,p,k,j,i) = a.beta_u(m,p,k,j,i) +
+                              w*(b.beta_u(m,p,k,j,i) - a.beta_u(m,p,k,j,i));
+      for (int q=p; q<3; ++q) {
+        dst.g_dd(m,p,q,k,j,i) = a.g_dd(m,p,q,k,j,i) +
+                                w*(b.g_dd(m,p,q,k,j,i) - a.g_dd(m,p,q,k,j,i));
+        dst.vK_dd(m,p,q,k,j,i) = a.vK_dd(m,p,q,k,j,i) +
+                                 w*(b.vK_dd(m,p,q,k,j,i) - a.vK_dd(m,p,q,k,j,i));
+      }
+    }
+  });
 }
 
 //----------------------------------------------------------------------------------------
@@ -255,8 +489,163 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::ConToPrim(Driver *pdrive, int sta
   int n1m1 = indcs.nx1 + 2*ng - 1;
   int n2m1 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng - 1) : 0;
   int n3m1 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng - 1) : 0;
-  eos.ConsToPrim(pmy_pack->pmhd->u0, pmy_pack->pmhd->b0, pmy_pack->pmhd->bcc0,
-                 pmy_pack->pmhd->w0, 0, n1m1, 0, n2m1, 0, n3m1, false);
+  if (skip_atmosphere) {
+    eos.ConsToPrim(pmy_pack->pmhd->u0, pmy_pack->pmhd->b0, pmy_pack->pmhd->bcc0,
+                   pmy_pack->pmhd->w0, 0, n1m1, 0, n2m1, 0, n3m1, false,
+                   mb_active.d_view);
+  } else {
+    eos.ConsToPrim(pmy_pack->pmhd->u0, pmy_pack->pmhd->b0, pmy_pack->pmhd->bcc0,
+                   pmy_pack->pmhd->w0, 0, n1m1, 0, n2m1, 0, n3m1, false);
+  }
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus DynGRMHDPS::UpdateActiveBlocks(Driver *pdrive, int stage)
+//! \brief At the start of each cycle, flags MBs on which the fluid is evolved.  A MB is
+//! active if D/sqrt(g) exceeds atmosphere_factor times the atmosphere threshold of the
+//! ErrorPolicy in any cell, including ghost zones, so MBs are activated when matter in a
+//! neighbor reaches their boundary.  Fluxes, source terms, and C2P are skipped on
+//! inactive MBs, whose fluid state is reset to atmosphere (and fluxes and electric
+//! fields zeroed) when they are deactivated, so it stays unchanged in the RK update.
+//! Newly activated MBs need a C2P, since their primitives were not updated in the ghost
+//! zones while they were inactive.  The atmosphere is assumed to be (nearly)
+//! unmagnetized, since the magnetic field is not evolved on inactive MBs.
+
+template<class EOSPolicy, class ErrorPolicy>
+TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::UpdateActiveBlocks(Driver *pdrive,
+                                                                 int stage) {
+  if (stage != 1 || fixed_evolution) {
+    return TaskStatus::complete;
+  }
+  int nmb = pmy_pack->nmb_thispack;
+  // all MBs are active after they are created or redistributed
+  if (active_version != pmy_pack->pmesh->mesh_version) {
+    Kokkos::realloc(mb_active, nmb);
+    Kokkos::realloc(mb_change, nmb);
+    Kokkos::deep_copy(mb_active.d_view, 1);
+    Kokkos::deep_copy(mb_active.h_view, 1);
+    active_version = pmy_pack->pmesh->mesh_version;
+  }
+
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int &ng = indcs.ng;
+  const int n1 = indcs.nx1 + 2*ng;
+  const int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng) : 1;
+  const int n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng) : 1;
+  const int nji = n2*n1;
+  const int nkji = n3*nji;
+
+  auto &eos_ = eos.ps.GetEOS();
+  const Real mb = eos_.GetBaryonMass();
+  const Real dthresh = atmosphere_factor*eos_.GetThreshold()*eos_.GetDensityFloor()*mb;
+  auto &u0 = pmy_pack->pmhd->u0;
+  auto &w0 = pmy_pack->pmhd->w0;
+  auto &bcc0 = pmy_pack->pmhd->bcc0;
+  auto &adm = pmy_pack->padm->adm_fluid;
+  auto active = mb_active.d_view;
+  auto change = mb_change.d_view;
+
+  par_for_outer("dyngr_active",DevExeSpace(), 0, 0, 0, (nmb-1),
+  KOKKOS_LAMBDA(TeamMember_t tmember, const int m) {
+    Real dmax = 0.0;
+    Kokkos::parallel_reduce(Kokkos::TeamThreadRange(tmember, nkji),
+    [=](const int idx, Real& rmax) {
+      int k = (idx)/nji;
+      int j = (idx - k*nji)/n1;
+      int i = (idx - k*nji - j*n1);
+      Real detg = adm::SpatialDet(adm.g_dd(m,0,0,k,j,i), adm.g_dd(m,0,1,k,j,i),
+                                  adm.g_dd(m,0,2,k,j,i), adm.g_dd(m,1,1,k,j,i),
+                                  adm.g_dd(m,1,2,k,j,i), adm.g_dd(m,2,2,k,j,i));
+      rmax = fmax(u0(m,IDN,k,j,i)/sqrt(detg), rmax);
+    },Kokkos::Max<Real>(dmax));
+    Kokkos::single(Kokkos::PerTeam(tmember), [&]() {
+      int flag = (dmax > dthresh)? 1 : 0;
+      change(m) = flag - active(m);
+      active(m) = flag;
+    });
+  });
+  mb_active.template modify<DevExeSpace>();
+  mb_active.template sync<HostMemSpace>();
+  mb_change.template modify<DevExeSpace>();
+  mb_change.template sync<HostMemSpace>();
+
+  int nactivated = 0, ndeactivated = 0;
+  for (int m=0; m<nmb; ++m) {
+    if (mb_change.h_view(m) > 0) nactivated++;
+    if (mb_change.h_view(m) < 0) ndeactivated++;
+  }
+
+  // reset deactivated MBs to atmosphere, and zero their fluxes and electric fields
+  if (ndeactivated > 0) {
+    int &nhyd = pmy_pack->pmhd->nmhd;
+    int &nscal = pmy_pack->pmhd->nscalars;
+    auto &ps_ = eos.ps;
+    par_for("dyngr_atmosphere",DevExeSpace(),0,nmb-1,0,n3-1,0,n2-1,0,n1-1,
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      if (change(m) >= 0) return;
+      Real g3d[NSPMETRIC];
+      g3d[S11] = adm.g_dd(m, 0, 0, k, j, i);
+      g3d[S12] = adm.g_dd(m, 0, 1, k, j, i);
+      g3d[S13] = adm.g_dd(m, 0, 2, k, j, i);
+      g3d[S22] = adm.g_dd(m, 1, 1, k, j, i);
+      g3d[S23] = adm.g_dd(m, 1, 2, k, j, i);
+      g3d[S33] = adm.g_dd(m, 2, 2, k, j, i);
+      Real sdetg = sqrt(Primitive::GetDeterminant(g3d));
+      Real isdetg = 1.0/sdetg;
+
+      Real prim_pt[NPRIM], cons_pt[NCONS], b3u[NMAG];
+      prim_pt[PRH] = eos_.GetDensityFloor();
+      prim_pt[PVX] = 0.0;
+      prim_pt[PVY] = 0.0;
+      prim_pt[PVZ] = 0.0;
+      for (int n = 0; n < nscal; n++) {
+        prim_pt[PYF + n] = eos_.GetSpeciesAtmosphere(n);
+      }
+      prim_pt[PTM] = eos_.GetTemperatureFloor();
+      prim_pt[PPR] = eos_.GetPressure(prim_pt[PRH], prim_pt[PTM], &prim_pt[PYF]);
+      b3u[IBX] = bcc0(m, IBX, k, j, i)*isdetg;
+      b3u[IBY] = bcc0(m, IBY, k, j, i)*isdetg;
+      b3u[IBZ] = bcc0(m, IBZ, k, j, i)*isdetg;
+      ps_.PrimToCon(prim_pt, cons_pt, b3u, g3d);
+
+      w0(m, IDN, k, j, i) = prim_pt[PRH]*mb;
+      w0(m, IVX, k, j, i) = 0.0;
+      w0(m, IVY, k, j, i) = 0.0;
+      w0(m, IVZ, k, j, i) = 0.0;
+      w0(m, IPR, k, j, i) = prim_pt[PPR];
+      u0(m, IDN, k, j, i) = cons_pt[CDN]*sdetg;
+      u0(m, IM1, k, j, i) = cons_pt[CSX]*sdetg;
+      u0(m, IM2, k, j, i) = cons_pt[CSY]*sdetg;
+      u0(m, IM3, k, j, i) = cons_pt[CSZ]*sdetg;
+      u0(m, IEN, k, j, i) = cons_pt[CTA]*sdetg;
+      for (int n = 0; n < nscal; n++) {
+        w0(m, nhyd + n, k, j, i) = prim_pt[PYF + n];
+        u0(m, nhyd + n, k, j, i) = cons_pt[CYD + n]*sdetg;
+      }
+    });
+    auto &uflx = pmy_pack->pmhd->uflx;
+    auto &pmhd = pmy_pack->pmhd;
+    for (int m=0; m<nmb; ++m) {
+      if (mb_change.h_view(m) >= 0) continue;
+      auto all = Kokkos::ALL;
+      Kokkos::deep_copy(Kokkos::subview(uflx.x1f, m, all, all, all, all), 0.0);
+      Kokkos::deep_copy(Kokkos::subview(uflx.x2f, m, all, all, all, all), 0.0);
+      Kokkos::deep_copy(Kokkos::subview(uflx.x3f, m, all, all, all, all), 0.0);
+      Kokkos::deep_copy(Kokkos::subview(pmhd->e2x1, m, all, all, all), 0.0);
+      Kokkos::deep_copy(Kokkos::subview(pmhd->e3x1, m, all, all, all), 0.0);
+      Kokkos::deep_copy(Kokkos::subview(pmhd->e1x2, m, all, all, all), 0.0);
+      Kokkos::deep_copy(Kokkos::subview(pmhd->e3x2, m, all, all, all), 0.0);
+      Kokkos::deep_copy(Kokkos::subview(pmhd->e1x3, m, all, all, all), 0.0);
+      Kokkos::deep_copy(Kokkos::subview(pmhd->e2x3, m, all, all, all), 0.0);
+    }
+  }
+
+  // primitives of newly activated MBs (including ghost zones) from conserved variables
+  if (nactivated > 0) {
+    eos.ConsToPrim(u0, pmy_pack->pmhd->b0, bcc0, w0, 0, n1-1, 0, n2-1, 0, n3-1, false,
+                   mb_change.d_view);
+  }
   return TaskStatus::complete;
 }
 
@@ -328,8 +717,10 @@ TaskStatus DynGRMHD::ApplyPhysicalBCs(Driver *pdrive, int stage) {
   pmhd->pbval_b->BFieldBCs((pmy_pack), (pmhd->pbval_b->b_in), pmhd->b0);
 
   // User BCs
-  if (pmy_pack->pmesh->pgen->user_bcs) {
-    (pmy_pack->pmesh->pgen->user_bcs_func)(pmy_pack->pmesh);
+  // user BCs may instead be defined as a device hook applied in HydroBCs()
+  auto &pgen = pmy_pack->pmesh->pgen;
+  if (pgen->user_bcs && pgen->user_bcs_func != nullptr) {
+    (pgen->user_bcs_func)(pmy_pack->pmesh);
   }
 
   // We now need to do a PrimToCon on all these boundary points.
@@ -355,7 +746,14 @@ TaskStatus DynGRMHD::ApplyPhysicalBCs(Driver *pdrive, int stage) {
 //! \brief Add the perfect fluid contribution to the stress-energy tensor. This is assumed
 //!  to be the first contribution, so it sets the values rather than adding.
 TaskStatus DynGRMHD::SetTmunu(Driver *pdrive, int stage) {
-  if (fixed_evolution) {
+  // with multirate evolution Tmunu is held fixed except at end of fluid cycle
+  if (fixed_evolution || (nmultirate > 1 && !update_tmunu)) {
+    return TaskStatus::complete;
+  }
+  // with fused_tmunu the Z4c RHS and diagnostics evaluate Tmunu themselves, so within
+  // the task list u_tmunu is only set in the last stage of cycles in which it is output
+  if (fused_tmunu && pdrive != nullptr && (stage != pdrive->nexp_stages ||
+      !(pdrive->OutputDue(&pmy_pack->ptmunu->u_tmunu)))) {
     return TaskStatus::complete;
   }
   auto &indcs = pmy_pack->pmesh->mb_indcs;
@@ -367,52 +765,20 @@ TaskStatus DynGRMHD::SetTmunu(Driver *pdrive, int stage) {
   int ncells1 = indcs.nx1+indcs.ng; // Align scratch buffers with variables
   int nmb = pmy_pack->nmb_thispack;
 
-  auto &adm = pmy_pack->padm->adm;
   auto &tmunu = pmy_pack->ptmunu->tmunu;
-  //auto &nhyd = pmy_pack->pmhd->nmhd;
-  //int &nscal = pmy_pack->pmhd->nscalars;
-  auto &prim = pmy_pack->pmhd->w0;
   // TODO(JMF): double-check that this needs to be u1, not u0!
-  auto &cons = pmy_pack->pmhd->u0;
-  auto &bcc = pmy_pack->pmhd->bcc0;
+  TmunuFromFluid fluid{pmy_pack->pmhd->w0, pmy_pack->pmhd->u0, pmy_pack->pmhd->bcc0,
+                       pmy_pack->padm->adm.g_dd};
 
   par_for("dyngr_tmunu_loop",DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
   KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
-    // Calculate the determinant/volume form
-    Real detg = adm::SpatialDet(adm.g_dd(m,0,0,k,j,i),adm.g_dd(m,0,1,k,j,i),
-                                adm.g_dd(m,0,2,k,j,i),adm.g_dd(m,1,1,k,j,i),
-                                adm.g_dd(m,1,2,k,j,i),adm.g_dd(m,2,2,k,j,i));
-    Real ivol = 1.0/sqrt(detg);
-
-    // Calculate the lower velocity components
-    Real v_d[3] = {0.0};
-    Real iW = 0.;
-    Real B_d[3] = {0.0};
-    for (int a = 0; a < 3; ++a) {
-      for (int b = 0; b < 3; ++b) {
-        v_d[a] += prim(m, IVX + b, k, j, i)*adm.g_dd(m, a, b, k, j, i);
-        iW += prim(m, IVX + a, k, j, i)*prim(m, IVX + b, k, j, i) *
-                adm.g_dd(m, a, b, k, j, i);
-        B_d[a] += bcc(m, b, k, j, i)*adm.g_dd(m, a, b, k, j, i)*ivol;
-      }
-    }
-    iW = 1.0/sqrt(1. + iW);
-    Real Bv = 0.;
-    Real Bsq = 0.;
+    Real E, S_d[3], S_dd[3][3];
+    fluid(m, k, j, i, E, S_d, S_dd);
+    tmunu.E(m, k, j, i) = E;
     for (int a = 0; a < 3; ++a) {
-      Bv += bcc(m, a, k, j, i) * v_d[a]*ivol;
-      Bsq += bcc(m, a, k, j, i) * B_d[a]*ivol;
-    }
-    Real bsq = (Bsq + Bv*Bv)*(iW*iW);
-
-    tmunu.E(m, k, j, i) = (cons(m, IEN, k, j, i) + cons(m, IDN, k, j, i))*ivol;
-    for (int a = 0; a < 3; ++a) {
-      tmunu.S_d(m, a, k, j, i) = cons(m, IM1 + a, k, j, i)*ivol;
+      tmunu.S_d(m, a, k, j, i) = S_d[a];
       for (int b = a; b < 3; ++b) {
-        tmunu.S_dd(m, a, b, k, j, i) =
-              cons(m, IM1 + a, k, j, i)*ivol*v_d[b]*iW
-              - (B_d[a] + Bv*v_d[a])*SQR(iW)*B_d[b]
-              + (prim(m, IPR, k, j, i) + 0.5*bsq)*adm.g_dd(m, a, b, k, j, i);
+        tmunu.S_dd(m, a, b, k, j, i) = S_dd[a][b];
       }
     }
   });
@@ -434,7 +800,7 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::AddCoordTermsEOS(const DvceArray5D<Real
 
   int nmb = pmy_pack->nmb_thispack;
 
-  auto &adm = pmy_pack->padm->adm;
+  auto &adm = pmy_pack->padm->adm_fluid;
   auto &eos_ = eos.ps.GetEOS();
   //auto &tmunu = pmy_pack->ptmunu->tmunu;
 
@@ -458,8 +824,13 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::AddCoordTermsEOS(const DvceArray5D<Real
     ndim = 3;
   }
 
+  // no source terms on MBs containing only atmosphere
+  const bool skip_ = skip_atmosphere;
+  auto active_ = mb_active.d_view;
+
   par_for("coord_src", DevExeSpace(), 0, nmb-1, ks, ke, js, je, is, ie,
   KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    if (skip_ && active_(m) == 0) return;
     // Extract the metric and coordinate quantities.
     Real g3d[NSPMETRIC] = {adm.g_dd(m,0,0,k,j,i), adm.g_dd(m,0,1,k,j,i),
                            adm.g_dd(m,0,2,k,j,i), adm.g_dd(m,1,1,k,j,i),
@@ -487,10 +858,14 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::AddCoordTermsEOS(const DvceArray5D<Real
       }
     }
     Real dg_ddd[3][3][3] = {0.};
-    for (int a = 0; a < 3; ++a) {
-      for (int b = 0; b < 3; ++b) {
-        for (int c = 0; c < ndim; ++c) {
-          dg_ddd[c][a][b] = Dx<NGHOST>(c, idx, adm.g_dd, m, a, b, k, j, i);
+    for (int c = 0; c < ndim; ++c) {
+      Real dg[6];
+      DxSym<NGHOST>(c, idx, adm.g_dd, m, k, j, i, dg);
+      int n = 0;
+      for (int a = 0; a < 3; ++a) {
+        for (int b = a; b < 3; ++b) {
+          dg_ddd[c][a][b] = dg[n];
+          dg_ddd[c][b][a] = dg[n++];
         }
       }
     }
@@ -13,6 +13,7 @@
 #include "tasklist/task_list.hpp"
 #include "driver/driver.hpp"
 #include "eos/primitive_solver_hyd.hpp"
+#include "coordinates/adm.hpp"
 
 enum class DynGRMHD_RSolver {llf_dyngr, hlle_dyngr};   // Riemann solvers for dynamical GR
 enum class DynGRMHD_EOS {eos_ideal, eos_piecewise_poly,
@@ -77,8 +78,26 @@ class DynGRMHD {
   DynGRMHDTaskIDs id;
 
   TaskStatus SetTmunu(Driver *d, int stage);
+  bool fused_tmunu;         // evaluate Tmunu in the Z4c RHS instead of storing it
   TaskStatus ApplyPhysicalBCs(Driver *d, int stage);
 
+  // multirate evolution: fluid advanced once every nmultirate spacetime cycles
+  int nmultirate;           // number of spacetime cycles per fluid cycle
+  Real time_fluid;          // time of fluid variables
+  TaskStatus MultirateStart(Driver *d, int stage);
+  TaskStatus MultirateMetric(Driver *d, int stage);
+  TaskStatus MultirateTmunu(Driver *d, int stage);
+  // true if fluid is advanced on this cycle
+  bool FluidCycle() const {return fluid_cycle;}
+  // timestep taken by fluid on this cycle
+  Real FluidDt() const;
+
+  // skipping of MeshBlocks filled with atmosphere
+  bool skip_atmosphere;     // do not evolve fluid on MBs containing only atmosphere
+  virtual TaskStatus UpdateActiveBlocks(Driver *d, int stage) = 0;
+  // true if fluid is evolved on MB m of this pack
+  bool MeshBlockActive(int m) const;
+
   // functions
 
   virtual void QueueDynGRMHDTasks() = 0;
@@ -104,6 +123,24 @@ class DynGRMHD {
   bool enforce_maximum;     // enforce local maximum principle during FOFC
   Real dmp_M;               // threshold multiplier for discrete maximum principle.
   bool fixed_evolution;     // Disable mhd evolution
+
+  // multirate evolution
+  int nsub_cycle;           // index of spacetime cycle within current fluid cycle
+  bool fluid_cycle;         // true if fluid is advanced on this cycle
+  bool update_tmunu;        // false while Tmunu is held fixed between fluid cycles
+  DvceArray5D<Real> u_adm_old;    // metric at start of fluid cycle
+  DvceArray5D<Real> u_adm_mr;     // metric interpolated to fluid stage
+  DvceArray5D<Real> u_tmunu_old;  // Tmunu at end of previous fluid cycle
+  adm::ADM::ADM_vars adm_old, adm_mr;
+
+  // skipping of MeshBlocks filled with atmosphere
+  Real atmosphere_factor;      // MB active if D > factor*threshold*floor in any cell
+  int active_version;          // Mesh::mesh_version when mb_active was initialized
+  DualArray1D<int> mb_active;  // 1 if fluid is evolved on MB, 0 otherwise
+  DualArray1D<int> mb_change;  // +1 (-1) if MB was activated (deactivated) this cycle
+  // set dst = a + w*(b - a) for all ADM variables in all cells
+  void LerpADM(adm::ADM::ADM_vars &dst, adm::ADM::ADM_vars &a, adm::ADM::ADM_vars &b,
+               Real w);
 };
 
 template<class EOSPolicy, class ErrorPolicy>
@@ -127,6 +164,7 @@ class DynGRMHDPS : public DynGRMHD {
   virtual void QueueDynGRMHDTasks();
 
   virtual TaskStatus ConToPrim(Driver* pdrive, int stage);
+  virtual TaskStatus UpdateActiveBlocks(Driver* pdrive, int stage);
   virtual void ConToPrimBC(int is, int ie, int js, int je, int ks, int ke);
   virtual void PrimToConInit(int is, int ie, int js, int je, int ks, int ke);
   virtual void ConvertInternalEnergyToPressure(int is, int ie,
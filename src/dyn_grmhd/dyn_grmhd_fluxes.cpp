@@ -41,7 +41,7 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
   int is = indcs_.is, ie = indcs_.ie;
   int js = indcs_.js, je = indcs_.je;
   int ks = indcs_.ks, ke = indcs_.ke;
-  int ncells1 = indcs_.nx1 + 2*(indcs_.ng);
+  int ncells1 = ScrRowLength(indcs_.nx1 + 2*(indcs_.ng));
 
   int nhyd = pmy_pack->pmhd->nmhd;
   int nvars = pmy_pack->pmhd->nmhd + pmy_pack->pmhd->nscalars;
@@ -51,7 +51,11 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
   auto coord_ = pmy_pack->pcoord->coord_data;
   auto &w0_ = pmy_pack->pmhd->w0;
   auto &b0_ = pmy_pack->pmhd->bcc0;
-  auto &adm = pmy_pack->padm->adm;
+  auto &adm = pmy_pack->padm->adm_fluid;
+  auto &fmetric1_ = pmy_pack->padm->fc_metric1;
+  auto &fmetric2_ = pmy_pack->padm->fc_metric2;
+  auto &fmetric3_ = pmy_pack->padm->fc_metric3;
+  bool cached_ = pmy_pack->padm->metric_cached;
   auto &eos_ = pmy_pack->pmhd->peos->eos_data;
   auto &dyn_eos_ = eos;
   auto &use_fofc = pmy_pack->pmhd->use_fofc;
@@ -59,6 +63,9 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
   if (recon_method_ == ReconstructionMethod::ppmx) {
     extrema = true;
   }
+  // fluxes on MBs containing only atmosphere are not computed (and remain zero)
+  const bool skip_ = skip_atmosphere;
+  auto active_ = mb_active.d_view;
   // Short-circuit the flux calculation if everything is to be fixed.
   if (fixed_evolution) {
     return TaskStatus::complete;
@@ -90,6 +97,7 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
   par_for_outer("dyngrflux_x1",DevExeSpace(), scr_size, scr_level,
       0, nmb1, kl, ku, jl, ju,
   KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+    if (skip_ && active_(m) == 0) return;
     ScrArray2D<Real> wl(member.team_scratch(scr_level), nvars, ncells1);
     ScrArray2D<Real> wr(member.team_scratch(scr_level), nvars, ncells1);
     ScrArray2D<Real> bl(member.team_scratch(scr_level), 3, ncells1);
@@ -137,11 +145,11 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
     //int il = is; int iu = ie+1;
     if constexpr (rsolver_method_ == DynGRMHD_RSolver::llf_dyngr) {
       LLF_DYNGR<IVX>(member, dyn_eos, indcs, size, coord, m, k, j, il, iu,
-                wl, wr, bl, br, bx, nhyd_, nscal_, adm_,
+                wl, wr, bl, br, bx, nhyd_, nscal_, adm_, fmetric1_, cached_,
                 flx1, e31, e21);
     } else if constexpr (rsolver_method_ == DynGRMHD_RSolver::hlle_dyngr) {
       HLLE_DYNGR<IVX>(member, dyn_eos, indcs, size, coord, m, k, j, il, iu,
-                wl, wr, bl, br, bx, nhyd_, nscal_, adm_,
+                wl, wr, bl, br, bx, nhyd_, nscal_, adm_, fmetric1_, cached_,
                 flx1, e31, e21);
     }
     member.team_barrier();
@@ -183,6 +191,7 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
 
     par_for_outer("dyngrflux_x2",DevExeSpace(), scr_size, scr_level, 0, nmb1, kl, ku,
     KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k) {
+      if (skip_ && active_(m) == 0) return;
       ScrArray2D<Real> scr1(member.team_scratch(scr_level), nvars, ncells1);
       ScrArray2D<Real> scr2(member.team_scratch(scr_level), nvars, ncells1);
       ScrArray2D<Real> scr3(member.team_scratch(scr_level), nvars, ncells1);
@@ -250,10 +259,12 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
         if (j>(jl)) {
           if constexpr (rsolver_method_ == DynGRMHD_RSolver::llf_dyngr) {
             LLF_DYNGR<IVY>(member, dyn_eos, indcs, size, coord, m, k, j, is-1, ie+1,
-                      wl, wr, bl, br, by, nhyd_, nscal_, adm_, flx2, e12, e32);
+                      wl, wr, bl, br, by, nhyd_, nscal_, adm_,
+                      fmetric2_, cached_, flx2, e12, e32);
           } else if constexpr (rsolver_method_ == DynGRMHD_RSolver::hlle_dyngr) {
             HLLE_DYNGR<IVY>(member, dyn_eos, indcs, size, coord, m, k, j, is-1, ie+1,
-                      wl, wr, bl, br, by, nhyd_, nscal_, adm_, flx2, e12, e32);
+                      wl, wr, bl, br, by, nhyd_, nscal_, adm_,
+                      fmetric2_, cached_, flx2, e12, e32);
           }
         }
         member.team_barrier();
@@ -291,6 +302,7 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
 
     par_for_outer("dyngrflux_x3",DevExeSpace(), scr_size, scr_level, 0, nmb1, js-1, je+1,
     KOKKOS_LAMBDA(TeamMember_t member, const int m, const int j) {
+      if (skip_ && active_(m) == 0) return;
       ScrArray2D<Real> scr1(member.team_scratch(scr_level), nvars, ncells1);
       ScrArray2D<Real> scr2(member.team_scratch(scr_level), nvars, ncells1);
       ScrArray2D<Real> scr3(member.team_scratch(scr_level), nvars, ncells1);
@@ -358,10 +370,12 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
         if (k>(kl)) {
           if constexpr (rsolver_method_ == DynGRMHD_RSolver::llf_dyngr) {
             LLF_DYNGR<IVZ>(member, dyn_eos, indcs, size, coord, m, k, j, is-1, ie+1,
-                      wl, wr, bl, br, bz, nhyd_, nscal_, adm_, flx3, e23, e13);
+                      wl, wr, bl, br, bz, nhyd_, nscal_, adm_,
+                      fmetric3_, cached_, flx3, e23, e13);
           } else if constexpr (rsolver_method_ == DynGRMHD_RSolver::hlle_dyngr) {
             HLLE_DYNGR<IVZ>(member, dyn_eos, indcs, size, coord, m, k, j, is-1, ie+1,
-                      wl, wr, bl, br, bz, nhyd_, nscal_, adm_, flx3, e23, e13);
+                      wl, wr, bl, br, bz, nhyd_, nscal_, adm_,
+                      fmetric3_, cached_, flx3, e23, e13);
           }
         }
         member.team_barrier();
@@ -60,15 +60,26 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::FOFC(Driver *pdriver, int stage) {
   int &nmhd_ = pmy_pack->pmhd->nmhd;
   int &nscal_ = pmy_pack->pmhd->nscalars;
 
+  // fluxes on MBs containing only atmosphere are not corrected (and remain zero)
+  const bool skip_ = skip_atmosphere;
+  auto active_ = mb_active.d_view;
+
   if (pmy_pack->pmhd->use_fofc) {
     Real &gam0 = pdriver->gam0[stage-1];
     Real &gam1 = pdriver->gam1[stage-1];
-    Real beta_dt = (pdriver->beta[stage-1])*(pmy_pack->pmesh->dt);
+    Real beta_dt = (pdriver->beta[stage-1])*(pmy_pack->pmhd->FluidDt());
 
     auto &u0_ = pmy_pack->pmhd->u0;
     auto &u1_ = pmy_pack->pmhd->u1;
-    auto &utest_ = pmy_pack->pmhd->utest;
-    auto &bcctest_ = pmy_pack->pmhd->bcctest;
+    // estimates of updated variables are checked out of the scratch pool
+    int ncells1 = indcs.nx1 + 2*(indcs.ng);
+    int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
+    int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
+    auto &scratch = pmy_pack->pmesh->scratch;
+    auto utest = scratch.Checkout("utest", nmb, nmhd_+nscal_, ncells3, ncells2, ncells1);
+    auto bcctest = scratch.Checkout("bcctest", nmb, 3, ncells3, ncells2, ncells1);
+    auto &utest_ = utest.view;
+    auto &bcctest_ = bcctest.view;
     auto &b1_ = pmy_pack->pmhd->b1;
     auto fofc_ = pmy_pack->pmhd->fofc;
 
@@ -85,6 +96,7 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::FOFC(Driver *pdriver, int stage) {
     // Estimate updated conserved variables and cell-centered fields
     par_for("FOFC-newu", DevExeSpace(), 0, nmb-1, kl, ku, jl, ju, il, iu,
     KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      if (skip_ && active_(m) == 0) return;
       Real dtodx1 = beta_dt/size.d_view(m).dx1;
       Real dtodx2 = beta_dt/size.d_view(m).dx2;
       Real dtodx3 = beta_dt/size.d_view(m).dx3;
@@ -146,8 +158,13 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::FOFC(Driver *pdriver, int stage) {
 
     // Test whether conversion to primitives requires floors
     // Note b0 and w0 passed to function, but not used/changed.
-    eos.ConsToPrim(utest_, pmy_pack->pmhd->b0, bcctest_,
-                           pmy_pack->pmhd->w0, il, iu, jl, ju, kl, ku, true);
+    if (skip_) {
+      eos.ConsToPrim(utest_, pmy_pack->pmhd->b0, bcctest_,
+                             pmy_pack->pmhd->w0, il, iu, jl, ju, kl, ku, true, active_);
+    } else {
+      eos.ConsToPrim(utest_, pmy_pack->pmhd->b0, bcctest_,
+                             pmy_pack->pmhd->w0, il, iu, jl, ju, kl, ku, true);
+    }
   }
 
   auto &coord = pmy_pack->pcoord->coord_data;
@@ -158,7 +175,7 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::FOFC(Driver *pdriver, int stage) {
   auto &excision_flux_ = pmy_pack->pcoord->excision_flux;
   auto &w0_ = pmy_pack->pmhd->w0;
   auto &b0_ = pmy_pack->pmhd->b0;
-  auto &adm = pmy_pack->padm->adm;
+  auto &adm = pmy_pack->padm->adm_fluid;
 
   // Index bounds
   int il = is-1, iu = ie+1, jl = js, ju = je, kl = ks, ku = ke;
@@ -169,6 +186,7 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::FOFC(Driver *pdriver, int stage) {
   // and/or excision is used (if GR+excising)
   par_for("FOFC-flx", DevExeSpace(), 0, nmb-1, kl, ku, jl, ju, il, iu,
   KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    if (skip_ && active_(m) == 0) return;
     // Check for FOFC flag
     bool fofc_flag = false;
     if (use_fofc_) { fofc_flag = fofc_(m,k,j,i); }
@@ -296,6 +314,7 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::FOFC(Driver *pdriver, int stage) {
   // FOFC and/or excision is used (if GR+excising)
   par_for("FOFC-flx", DevExeSpace(), 0, nmb-1, kl, ku, jl, ju, il, iu,
   KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    if (skip_ && active_(m) == 0) return;
     // Check for FOFC flag
     bool fofc_flag = false;
     if (use_fofc_) { fofc_flag = fofc_(m,k,j,i); }
@@ -130,7 +130,7 @@ void HLLE_DYNGR(TeamMember_t const &member,
      const ScrArray2D<Real> &wl, const ScrArray2D<Real> &wr,
      const ScrArray2D<Real> &bl, const ScrArray2D<Real> &br, const DvceArray4D<Real> &bx,
      const int& nhyd, const int& nscal,
-     const adm::ADM::ADM_vars& adm,
+     const adm::ADM::ADM_vars& adm, const DvceArray5D<Real> &fmetric, const bool cached,
      DvceArray5D<Real> flx, DvceArray4D<Real> ey, DvceArray4D<Real> ez) {
   par_for_inner(member, il, iu, [&](const int i) {
     constexpr int ibx = ivx - IVX;
@@ -149,15 +149,27 @@ void HLLE_DYNGR(TeamMember_t const &member,
     Real g3d[NSPMETRIC];
     Real beta_u[3];
     Real alpha;
-    if constexpr (ivx == IVX) {
-      adm::Face1Metric(m, k, j, i, adm.g_dd, adm.beta_u, adm.alpha, g3d, beta_u, alpha);
-    } else if (ivx == IVY) {
-      adm::Face2Metric(m, k, j, i, adm.g_dd, adm.beta_u, adm.alpha, g3d, beta_u, alpha);
-    } else if (ivx == IVZ) {
-      adm::Face3Metric(m, k, j, i, adm.g_dd, adm.beta_u, adm.alpha, g3d, beta_u, alpha);
+    Real sdetg;
+    if (cached) {
+      // metric at faces precomputed for a fixed spacetime
+      for (int n = 0; n < NSPMETRIC; ++n) {
+        g3d[n] = fmetric(m, adm::ADM::I_FC_GXX + n, k, j, i);
+      }
+      for (int a = 0; a < 3; ++a) {
+        beta_u[a] = fmetric(m, adm::ADM::I_FC_BETAX + a, k, j, i);
+      }
+      alpha = fmetric(m, adm::ADM::I_FC_ALPHA, k, j, i);
+      sdetg = fmetric(m, adm::ADM::I_FC_SDETG, k, j, i);
+    } else {
+      if constexpr (ivx == IVX) {
+        adm::Face1Metric(m, k, j, i, adm.g_dd, adm.beta_u, adm.alpha, g3d, beta_u, alpha);
+      } else if (ivx == IVY) {
+        adm::Face2Metric(m, k, j, i, adm.g_dd, adm.beta_u, adm.alpha, g3d, beta_u, alpha);
+      } else if (ivx == IVZ) {
+        adm::Face3Metric(m, k, j, i, adm.g_dd, adm.beta_u, adm.alpha, g3d, beta_u, alpha);
+      }
+      sdetg = sqrt(Primitive::GetDeterminant(g3d));
     }
-
-    Real sdetg = sqrt(Primitive::GetDeterminant(g3d));
     Real isdetg = 1.0/sdetg;
 
     // Extract left and right primitives
@@ -0,0 +1,64 @@
+#ifndef EOS_EOS_TRAITS_HPP_
+#define EOS_EOS_TRAITS_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file eos_traits.hpp
+//! \brief compile-time traits for the non-relativistic hydrodynamic EOS.  Kernels
+//! templated over EOS_Type call these functions in place of the virtual ConsToPrim()
+//! and PrimToCons() of the EquationOfState classes, so that the conversion of a single
+//! state is inlined into fused kernels (e.g. RK update followed by ConsToPrim), and the
+//! branches on the EOS are resolved at compile time.
+
+#include "athena.hpp"
+#include "eos/eos.hpp"
+#include "eos/ideal_c2p_hyd.hpp"
+#include "eos/isothermal_c2p_hyd.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \struct HydEOSTraits
+//! \brief single state conversions and sound speed for each non-relativistic EOS
+
+template <EOS_Type T> struct HydEOSTraits;
+
+template <>
+struct HydEOSTraits<EOS_Type::ideal> {
+  static constexpr bool has_energy = true;
+
+  KOKKOS_INLINE_FUNCTION
+  static void C2P(HydCons1D &u, const EOS_Data &eos, HydPrim1D &w, bool &dfloor_used,
+                  bool &efloor_used, bool &tfloor_used) {
+    SingleC2P_IdealHyd(u, eos, w, dfloor_used, efloor_used, tfloor_used);
+  }
+  KOKKOS_INLINE_FUNCTION
+  static void P2C(const HydPrim1D &w, HydCons1D &u) {
+    SingleP2C_IdealHyd(w, u);
+  }
+  KOKKOS_INLINE_FUNCTION
+  static Real SoundSpeed(const EOS_Data &eos, const HydPrim1D &w) {
+    return eos.IdealHydroSoundSpeed(w.d, eos.IdealGasPressure(w.e));
+  }
+};
+
+template <>
+struct HydEOSTraits<EOS_Type::isothermal> {
+  static constexpr bool has_energy = false;
+
+  KOKKOS_INLINE_FUNCTION
+  static void C2P(HydCons1D &u, const EOS_Data &eos, HydPrim1D &w, bool &dfloor_used,
+                  bool &efloor_used, bool &tfloor_used) {
+    SingleC2P_IsothermalHyd(u, eos.dfloor, w, dfloor_used);
+  }
+  KOKKOS_INLINE_FUNCTION
+  static void P2C(const HydPrim1D &w, HydCons1D &u) {
+    SingleP2C_IsothermalHyd(w, u);
+  }
+  KOKKOS_INLINE_FUNCTION
+  static Real SoundSpeed(const EOS_Data &eos, const HydPrim1D &w) {
+    return eos.iso_cs;
+  }
+};
+
+#endif // EOS_EOS_TRAITS_HPP_
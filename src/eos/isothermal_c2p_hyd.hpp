@@ -0,0 +1,49 @@
+#ifndef EOS_ISOTHERMAL_C2P_HYD_HPP_
+#define EOS_ISOTHERMAL_C2P_HYD_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file isothermal_c2p_hyd.hpp
+//! \brief Inline functions that transform a single state of conserved variables into
+//! primitive variables (and the reverse, primitive to conserved) for non-relativistic
+//! hydrodynamics with an isothermal EOS.
+
+//----------------------------------------------------------------------------------------
+//! \fn void SingleC2P_IsothermalHyd()
+//! \brief Converts single state of conserved variables into primitive variables for
+//! non-relativistic hydrodynamics with an isothermal EOS.
+
+KOKKOS_INLINE_FUNCTION
+void SingleC2P_IsothermalHyd(HydCons1D &u, const Real &dfloor_,
+                             HydPrim1D &w, bool &dfloor_used) {
+  // apply density floor, without changing momentum
+  if (u.d < dfloor_) {
+    u.d = dfloor_;
+    dfloor_used = true;
+  }
+  w.d = u.d;
+  // compute velocities
+  Real di = 1.0/u.d;
+  w.vx = di*u.mx;
+  w.vy = di*u.my;
+  w.vz = di*u.mz;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void SingleP2C_IsothermalHyd()
+//! \brief Converts single state of primitive variables into conserved variables for
+//! non-relativistic hydrodynamics with an isothermal gas EOS.
+
+KOKKOS_INLINE_FUNCTION
+void SingleP2C_IsothermalHyd(const HydPrim1D &w, HydCons1D &u) {
+  u.d  = w.d;
+  u.mx = w.d*w.vx;
+  u.my = w.d*w.vy;
+  u.mz = w.d*w.vz;
+  return;
+}
+
+#endif // EOS_ISOTHERMAL_C2P_HYD_HPP_
@@ -11,6 +11,7 @@
 #include "mesh/mesh.hpp"
 #include "hydro/hydro.hpp"
 #include "eos/eos.hpp"
+#include "eos/isothermal_c2p_hyd.hpp"
 
 //----------------------------------------------------------------------------------------
 // ctor: also calls EOS base class constructor
@@ -24,42 +25,6 @@ IsothermalHydro::IsothermalHydro(MeshBlockPack *pp, ParameterInput *pin) :
   eos_data.use_t = false;
 }
 
-//----------------------------------------------------------------------------------------
-//! \fn void SingleC2P_IsothermalHyd()
-//! \brief Converts single state of conserved variables into primitive variables for
-//! non-relativistic hydrodynamics with an isothermal EOS.
-
-KOKKOS_INLINE_FUNCTION
-void SingleC2P_IsothermalHyd(HydCons1D &u, const Real &dfloor_,
-                             HydPrim1D &w, bool &dfloor_used) {
-  // apply density floor, without changing momentum
-  if (u.d < dfloor_) {
-    u.d = dfloor_;
-    dfloor_used = true;
-  }
-  w.d = u.d;
-  // compute velocities
-  Real di = 1.0/u.d;
-  w.vx = di*u.mx;
-  w.vy = di*u.my;
-  w.vz = di*u.mz;
-  return;
-}
-
-//----------------------------------------------------------------------------------------
-//! \fn void SingleP2C_IsothermalHyd()
-//! \brief Converts single state of primitive variables into conserved variables for
-//! non-relativistic hydrodynamics with an isothermal gas EOS.
-
-KOKKOS_INLINE_FUNCTION
-void SingleP2C_IsothermalHyd(const HydPrim1D &w, HydCons1D &u) {
-  u.d  = w.d;
-  u.mx = w.d*w.vx;
-  u.my = w.d*w.vy;
-  u.mz = w.d*w.vz;
-  return;
-}
-
 //----------------------------------------------------------------------------------------
 //! \fn void ConsToPrim()
 //! \brief Converts conserved into primitive variables. Operates over range of cells given
@@ -20,12 +20,12 @@
 
 using namespace Primitive; // NOLINT
 
-void EOSCompOSE::ReadTableFromFile(std::string fname) {
+void EOSCompOSE::ReadTableFromFile(std::string fname, bool node_shared) {
   if (m_initialized==false) {
     TableReader::Table table;
-    auto read_result = table.ReadTable(fname);
+    auto read_result = table.ReadTable(fname, node_shared);
     if (read_result.error != TableReader::ReadResult::SUCCESS) {
-      std::cout << "Table could not be read.\n";
+      std::cout << "Table could not be read.\n" << read_result.message;
       assert (false);
     }
     // Make sure table has correct dimentions
@@ -46,7 +46,7 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
     Kokkos::realloc(m_log_nb, m_nn);
     Kokkos::realloc(m_yq,     m_ny);
     Kokkos::realloc(m_log_t,  m_nt);
-    Kokkos::realloc(m_table, ECNVARS, m_nn, m_ny, m_nt);
+    Kokkos::realloc(m_table, m_nn, m_ny, m_nt, ECNVARS);
 
     // Create host storage to read into
     HostArray1D<Real>::HostMirror host_log_nb = create_mirror_view(m_log_nb);
@@ -90,7 +90,7 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
         for (size_t iy=0; iy<m_ny; ++iy) {
           for (size_t it=0; it<m_nt; ++it) {
             size_t iflat = it + m_nt*(iy + m_ny*in);
-            host_table(ECLOGP,in,iy,it) = log(table_Q1[iflat]) + host_log_nb(in);
+            host_table(in,iy,it,ECLOGP) = log(table_Q1[iflat]) + host_log_nb(in);
           }
         }
       }
@@ -102,7 +102,7 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
         for (size_t iy=0; iy<m_ny; ++iy) {
           for (size_t it=0; it<m_nt; ++it) {
             size_t iflat = it + m_nt*(iy + m_ny*in);
-            host_table(ECENT,in,iy,it) = table_Q2[iflat];
+            host_table(in,iy,it,ECENT) = table_Q2[iflat];
           }
         }
       }
@@ -114,7 +114,7 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
         for (size_t iy=0; iy<m_ny; ++iy) {
           for (size_t it=0; it<m_nt; ++it) {
             size_t iflat = it + m_nt*(iy + m_ny*in);
-            host_table(ECMUB,in,iy,it) = (table_Q3[iflat]+1)*mb;
+            host_table(in,iy,it,ECMUB) = (table_Q3[iflat]+1)*mb;
           }
         }
       }
@@ -126,7 +126,7 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
         for (size_t iy=0; iy<m_ny; ++iy) {
           for (size_t it=0; it<m_nt; ++it) {
             size_t iflat = it + m_nt*(iy + m_ny*in);
-            host_table(ECMUB,in,iy,it) = table_Q4[iflat]*mb;
+            host_table(in,iy,it,ECMUB) = table_Q4[iflat]*mb;
           }
         }
       }
@@ -138,7 +138,7 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
         for (size_t iy=0; iy<m_ny; ++iy) {
           for (size_t it=0; it<m_nt; ++it) {
             size_t iflat = it + m_nt*(iy + m_ny*in);
-            host_table(ECMUL,in,iy,it) = table_Q5[iflat]*mb;
+            host_table(in,iy,it,ECMUL) = table_Q5[iflat]*mb;
           }
         }
       }
@@ -150,7 +150,7 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
         for (size_t iy=0; iy<m_ny; ++iy) {
           for (size_t it=0; it<m_nt; ++it) {
             size_t iflat = it + m_nt*(iy + m_ny*in);
-            host_table(ECLOGE,in,iy,it) = log(mb*(table_Q7[iflat] + 1)) + host_log_nb(in);
+            host_table(in,iy,it,ECLOGE) = log(mb*(table_Q7[iflat] + 1)) + host_log_nb(in);
           }
         }
       }
@@ -162,7 +162,7 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
         for (size_t iy=0; iy<m_ny; ++iy) {
           for (size_t it=0; it<m_nt; ++it) {
             size_t iflat = it + m_nt*(iy + m_ny*in);
-            host_table(ECCS,in,iy,it) = sqrt(table_cs2[iflat]);
+            host_table(in,iy,it,ECCS) = sqrt(table_cs2[iflat]);
           }
         }
       }
@@ -173,6 +173,7 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
     Kokkos::deep_copy(m_yq,     host_yq);
     Kokkos::deep_copy(m_log_t,  host_log_t);
     Kokkos::deep_copy(m_table,  host_table);
+    m_table_ro = m_table;
 
     m_initialized = true;
 
@@ -184,8 +185,8 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
         for (int iy = 0; iy < m_ny; ++iy) {
           // This would use GPU memory, and we are currently on the CPU, so Enthalpy is
           // hardcoded
-          Real e = exp(host_table(ECLOGE,in,iy,it));
-          Real p = exp(host_table(ECLOGP,in,iy,it));
+          Real e = exp(host_table(in,iy,it,ECLOGE));
+          Real p = exp(host_table(in,iy,it,ECLOGP));
           Real h = (e + p) / nb;
           m_min_h = fmin(m_min_h, h);
         }
@@ -14,6 +14,10 @@
 
 ///  \warning This code assumes the table to be uniformly spaced in
 ///           log nb, log t, and yq
+///
+///  The table is stored as (nb, yq, t, variable), with all variables at a table point
+///  stored contiguously, so that several quantities at the same (n, T, Y) share the
+///  interpolation weights and the same cache lines (see eval_at_lnty_multi)
 
 #include <string>
 #include <limits>
@@ -111,9 +115,11 @@ class EOSCompOSE : public EOSPolicyInterface {
 
   /// Calculate the enthalpy per baryon using.
   KOKKOS_INLINE_FUNCTION Real Enthalpy(Real n, Real T, Real *Y) const {
-    Real const P = Pressure(n, T, Y);
-    Real const e = Energy(n, T, Y);
-    return (P + e)/n;
+    assert (m_initialized);
+    const int iv[2] = {ECLOGP, ECLOGE};
+    Real lpe[2];
+    eval_at_lnty_multi(2, iv, log(n), log(T), Y[0], lpe);
+    return (exp(lpe[0]) + exp(lpe[1]))/n;
   }
 
   /// Calculate the sound speed.
@@ -174,8 +180,9 @@ class EOSCompOSE : public EOSPolicyInterface {
   }
 
  public:
-  /// Reads the table file.
-  void ReadTableFromFile(std::string fname);
+  /// Reads the table file. With node_shared, the file is read once per node into
+  /// MPI shared memory (see TableReader::Table::ReadTable).
+  void ReadTableFromFile(std::string fname, bool node_shared = false);
 
   /// Get the raw number density
   KOKKOS_INLINE_FUNCTION DvceArray1D<Real> const GetRawLogNumberDensity() const {
@@ -190,14 +197,22 @@ class EOSCompOSE : public EOSPolicyInterface {
   KOKKOS_INLINE_FUNCTION DvceArray1D<Real> const GetRawLogTemperature() const {
     return m_log_t;
   }
-  /// Get the raw table data
+  /// Get the raw table data, stored as (nb, yq, t, variable)
   KOKKOS_INLINE_FUNCTION DvceArray4D<Real> const GetRawTable() const {
     return m_table;
   }
 
   // Indexing used to access the data
   KOKKOS_INLINE_FUNCTION ptrdiff_t index(int iv, int in, int iy, int it) const {
-    return it + m_nt*(iy + m_ny*(in + m_nn*iv));
+    return iv + ECNVARS*(it + m_nt*(iy + m_ny*in));
+  }
+
+  /// Evaluate nv table variables iv[] (in EOS units, e.g. log P for ECLOGP) at the same
+  /// n, T, Y, computing the interpolation weights only once.
+  KOKKOS_INLINE_FUNCTION void EvaluateTable(int nv, const int *iv, Real n, Real T,
+                                            const Real *Y, Real *out) const {
+    assert (m_initialized);
+    eval_at_lnty_multi(nv, iv, log(n), log(T), Y[0], out);
   }
 
   /// Check if the EOS has been initialized properly.
@@ -239,14 +254,38 @@ class EOSCompOSE : public EOSPolicyInterface {
     weight_idx_lt(&wt0, &wt1, &it, log_t);
 
     return
-      wn0 * (wy0 * (wt0 * m_table(iv, in+0, iy+0, it+0)   +
-                    wt1 * m_table(iv, in+0, iy+0, it+1))  +
-             wy1 * (wt0 * m_table(iv, in+0, iy+1, it+0)   +
-                    wt1 * m_table(iv, in+0, iy+1, it+1))) +
-      wn1 * (wy0 * (wt0 * m_table(iv, in+1, iy+0, it+0)   +
-                    wt1 * m_table(iv, in+1, iy+0, it+1))  +
-             wy1 * (wt0 * m_table(iv, in+1, iy+1, it+0)   +
-                    wt1 * m_table(iv, in+1, iy+1, it+1)));
+      wn0 * (wy0 * (wt0 * m_table_ro(in+0, iy+0, it+0, iv)   +
+                    wt1 * m_table_ro(in+0, iy+0, it+1, iv))  +
+             wy1 * (wt0 * m_table_ro(in+0, iy+1, it+0, iv)   +
+                    wt1 * m_table_ro(in+0, iy+1, it+1, iv))) +
+      wn1 * (wy0 * (wt0 * m_table_ro(in+1, iy+0, it+0, iv)   +
+                    wt1 * m_table_ro(in+1, iy+0, it+1, iv))  +
+             wy1 * (wt0 * m_table_ro(in+1, iy+1, it+0, iv)   +
+                    wt1 * m_table_ro(in+1, iy+1, it+1, iv)));
+  }
+  /// Low level evaluation of several variables with one set of weights, not intended
+  /// for outside use
+  KOKKOS_INLINE_FUNCTION void eval_at_lnty_multi(int nv, const int *iv, Real log_n,
+                                                 Real log_t, Real yq, Real *out) const {
+    int in, iy, it;
+    Real wn0, wn1, wy0, wy1, wt0, wt1;
+
+    weight_idx_ln(&wn0, &wn1, &in, log_n);
+    weight_idx_yq(&wy0, &wy1, &iy, yq);
+    weight_idx_lt(&wt0, &wt1, &it, log_t);
+
+    // weights of the 8 corners, ordered as (in, iy, it) with it fastest
+    Real w[8] = {wn0*wy0*wt0, wn0*wy0*wt1, wn0*wy1*wt0, wn0*wy1*wt1,
+                 wn1*wy0*wt0, wn1*wy0*wt1, wn1*wy1*wt0, wn1*wy1*wt1};
+    for (int v=0; v<nv; ++v) {
+      out[v] = 0.0;
+    }
+    for (int c=0; c<8; ++c) {
+      int jn = in + (c >> 2), jy = iy + ((c >> 1) & 1), jt = it + (c & 1);
+      for (int v=0; v<nv; ++v) {
+        out[v] += w[c]*m_table_ro(jn, jy, jt, iv[v]);
+      }
+    }
   }
 
   /// Evaluate interpolation weight for density
@@ -285,10 +324,10 @@ class EOSCompOSE : public EOSPolicyInterface {
 
     auto f = [=](int it){
       Real var_pt =
-        wn0 * (wy0 * m_table(iv, in+0, iy+0, it)  +
-               wy1 * m_table(iv, in+0, iy+1, it)) +
-        wn1 * (wy0 * m_table(iv, in+1, iy+0, it)  +
-               wy1 * m_table(iv, in+1, iy+1, it));
+        wn0 * (wy0 * m_table_ro(in+0, iy+0, it, iv)  +
+               wy1 * m_table_ro(in+0, iy+1, it, iv)) +
+        wn1 * (wy0 * m_table_ro(in+1, iy+0, it, iv)  +
+               wy1 * m_table_ro(in+1, iy+1, it, iv));
 
       return var - var_pt;
     };
@@ -366,6 +405,9 @@ class EOSCompOSE : public EOSPolicyInterface {
   DvceArray1D<Real> m_yq;
   DvceArray1D<Real> m_log_t;
   DvceArray4D<Real> m_table;
+  // Read-only view of m_table used for lookups (read through texture cache on GPUs)
+  Kokkos::View<const Real ****, LayoutWrapper, DevMemSpace,
+               Kokkos::MemoryTraits<Kokkos::RandomAccess>> m_table_ro;
 };
 
 }; // namespace Primitive
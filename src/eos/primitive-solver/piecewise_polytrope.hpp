@@ -42,6 +42,11 @@ class PiecewisePolytrope : public EOSPolicyInterface {
   Real pressure_pieces[MAX_PIECES];
   Real eps_pieces[MAX_PIECES];
   Real gamma_thermal;
+
+  /// Tables derived from the parameters, so that the cold part of the EOS can be
+  /// evaluated with a single pow and no divisions
+  Real rdensity_pieces[MAX_PIECES];  // 1/density_pieces
+  Real rgamma1_pieces[MAX_PIECES];   // 1/(gamma_pieces - 1)
   bool initialized;
 
  protected:
@@ -51,6 +56,9 @@ class PiecewisePolytrope : public EOSPolicyInterface {
     initialized = false;
     n_species = 0;
     gamma_thermal = 5.0/3.0;
+    for (int i = 0; i < MAX_PIECES; i++) {
+      density_pieces[i] = DBL_MAX;
+    }
     for (int i = 0; i < MAX_SPECIES; i++) {
       min_Y[i] = 0.0;
       max_Y[i] = 1.0;
@@ -64,7 +72,7 @@ class PiecewisePolytrope : public EOSPolicyInterface {
   /// Calculate the temperature using the ideal gas law.
   KOKKOS_INLINE_FUNCTION Real TemperatureFromE(Real n, Real e, Real *Y) const {
     int p = FindPiece(n);
-    Real e_cold = GetColdEnergy(n, p);
+    Real e_cold = GetColdEnergy(n, p, GetColdPressure(n, p));
     return (e - e_cold)*(gamma_thermal - 1.0)/n;
   }
 
@@ -98,7 +106,8 @@ class PiecewisePolytrope : public EOSPolicyInterface {
   /// Calculate the enthalpy per baryon using the ideal gas law.
   KOKKOS_INLINE_FUNCTION Real Enthalpy(Real n, Real T, Real *Y) const {
     int p = FindPiece(n);
-    return (GetColdEnergy(n, p) + GetColdPressure(n, p))/n +
+    Real P_cold = GetColdPressure(n, p);
+    return (GetColdEnergy(n, p, P_cold) + P_cold)/n +
            gamma_thermal/(gamma_thermal - 1.0)*T;
   }
 
@@ -112,10 +121,9 @@ class PiecewisePolytrope : public EOSPolicyInterface {
     int p = FindPiece(n);
     Real rho = n*mb;
 
-    Real h_cold = (GetColdEnergy(n, p) + GetColdPressure(n, p))/rho;
-    Real h_th = gamma_thermal/(gamma_thermal - 1.0)*T/mb;
-
     Real P_cold = GetColdPressure(n, p);
+    Real h_cold = (GetColdEnergy(n, p, P_cold) + P_cold)/rho;
+    Real h_th = gamma_thermal/(gamma_thermal - 1.0)*T/mb;
 
     Real csq_cold_w = gamma_pieces[p]*P_cold/rho;
     Real csq_th_w = (gamma_thermal - 1.0)*h_th;
@@ -126,7 +134,7 @@ class PiecewisePolytrope : public EOSPolicyInterface {
   /// Calculate the internal energy per mass.
   KOKKOS_INLINE_FUNCTION Real SpecificInternalEnergy(Real n, Real T, Real *Y) const {
     int p = FindPiece(n);
-    Real eps_cold = GetColdEnergy(n, p)/(n*mb) - 1.0;
+    Real eps_cold = eps_pieces[p] + GetColdPressure(n, p)*rgamma1_pieces[p]/(n*mb);
     return eps_cold + T/(mb*(gamma_thermal - 1.0));
   }
 
@@ -211,6 +219,7 @@ class PiecewisePolytrope : public EOSPolicyInterface {
     density_pieces[0] = densities[1]/mb;
     gamma_pieces[0] = gammas[0];
     pressure_pieces[0] = P0;
+    eps_pieces[0] = 0.0;
 
     for (int i = 1; i < n; i++) {
       density_pieces[i] = densities[i]/mb;
@@ -224,6 +233,14 @@ class PiecewisePolytrope : public EOSPolicyInterface {
                       (density_pieces[i-1] * mb) *
                       (1.0/(gammas[i-1] - 1.0) - 1.0/(gammas[i] - 1.0));
     }
+    // Unused pieces are never selected by FindPiece
+    for (int i = n; i < MAX_PIECES; i++) {
+      density_pieces[i] = DBL_MAX;
+    }
+    for (int i = 0; i < n; i++) {
+      rdensity_pieces[i] = 1.0/density_pieces[i];
+      rgamma1_pieces[i] = 1.0/(gamma_pieces[i] - 1.0);
+    }
 
     // Because we're adding in a finite-temperature component via the ideal gas,
     // the only restriction on our temperature is that it needs to be nonnegative.
@@ -261,24 +278,30 @@ class PiecewisePolytrope : public EOSPolicyInterface {
   }
 
   /// Find the index of the piece that the density aligns with.
+  //  The loop has a fixed trip count and no branches, so it is fully unrolled and
+  //  does not diverge between threads; unused pieces have density_pieces = DBL_MAX.
   KOKKOS_INLINE_FUNCTION int FindPiece(Real n) const {
     // WARNING: assumes the EOS is initialized!
-    for (int i = 0; i < n_pieces-1; ++i) {
-      if (n < density_pieces[i+1]) {
-        return i;
-      }
+    int p = 0;
+    for (int i = 1; i < MAX_PIECES; ++i) {
+      p += (n >= density_pieces[i]);
     }
-    return n_pieces - 1;
+    return p;
   }
 
   /// Polytropic Energy Density
   KOKKOS_INLINE_FUNCTION Real GetColdEnergy(Real n, int p) const {
-    return mb*n*(1.0 + eps_pieces[p]) + GetColdPressure(n, p)/(gamma_pieces[p] - 1.0);
+    return GetColdEnergy(n, p, GetColdPressure(n, p));
+  }
+
+  /// Polytropic Energy Density, given the polytropic pressure P_cold = P(n, p)
+  KOKKOS_INLINE_FUNCTION Real GetColdEnergy(Real n, int p, Real P_cold) const {
+    return mb*n*(1.0 + eps_pieces[p]) + P_cold*rgamma1_pieces[p];
   }
 
   /// Polytropic Pressure
   KOKKOS_INLINE_FUNCTION Real GetColdPressure(Real n, int p) const {
-    return pressure_pieces[p]*pow((n/density_pieces[p]), gamma_pieces[p]);
+    return pressure_pieces[p]*pow(n*rdensity_pieces[p], gamma_pieces[p]);
   }
 
   /// Inverse of GetColdPressure
@@ -201,6 +201,10 @@ class PrimitiveSolver {
 
  public:
   Real tol;
+  /// Warm start: seed the root solve with the primitives passed in to ConToPrim,
+  /// bracketing the root within a relative width warm_width about the guess.
+  bool warm_start;
+  Real warm_width;
 
   /// Constructor
   //PrimitiveSolver(EOS<EOSPolicy, ErrorPolicy> *eos) : peos(eos) {
@@ -208,6 +212,8 @@ class PrimitiveSolver {
     //root = NumTools::Root();
     tol = 1e-15;
     root.iterations = 30;
+    warm_start = false;
+    warm_width = 1e-2;
   }
 
   /// Destructor
@@ -215,16 +221,24 @@ class PrimitiveSolver {
 
   //! \brief Get the primitive variables from the conserved variables.
   //
-  //  \param[out]    prim  The array of primitive variables
+  //  \param[in,out] prim  The array of primitive variables. If use_guess is true, it
+  //                       must hold a guess for the solution (e.g. from the previous
+  //                       step) on input.
   //  \param[in,out] cons  The array of conserved variables
   //  \param[in,out] bu    The magnetic field
   //  \param[in]     g3d   The 3x3 spatial metric
   //  \param[in]     g3u   The 3x3 inverse spatial metric
+  //  \param[in]     use_guess  Try a root solve in a tight bracket about the guess in
+  //                            prim before bracketing the root from scratch
+  //  \param[in]     defer_failure  If the root solve does not converge, return
+  //                                NO_SOLUTION without calling the failure response,
+  //                                so the caller may retry the solve later
   //
   //  \return information about the solve
   KOKKOS_INLINE_FUNCTION
   SolverResult ConToPrim(Real prim[NPRIM], Real cons[NCONS], Real b[NMAG],
-                         Real g3d[NSPMETRIC], Real g3u[NSPMETRIC]) const;
+                         Real g3d[NSPMETRIC], Real g3u[NSPMETRIC],
+                         bool use_guess = false, bool defer_failure = false) const;
 
   //! \brief Get the conserved variables from the primitive variables.
   //
@@ -364,7 +378,8 @@ Error PrimitiveSolver<EOSPolicy, ErrorPolicy>::CheckDensityValid(Real& mul, Real
 template<typename EOSPolicy, typename ErrorPolicy>
 KOKKOS_INLINE_FUNCTION
 SolverResult PrimitiveSolver<EOSPolicy, ErrorPolicy>::ConToPrim(Real prim[NPRIM],
-      Real cons[NCONS], Real b[NMAG], Real g3d[NSPMETRIC], Real g3u[NSPMETRIC]) const {
+      Real cons[NCONS], Real b[NMAG], Real g3d[NSPMETRIC], Real g3u[NSPMETRIC],
+      bool use_guess, bool defer_failure) const {
   SolverResult solver_result{Error::SUCCESS, 0, false, false, false};
 
   // Extract the undensitized conserved variables.
@@ -475,52 +490,82 @@ SolverResult PrimitiveSolver<EOSPolicy, ErrorPolicy>::ConToPrim(Real prim[NPRIM]
     rsqr *= (factor*factor);
   }*/
 
-  // Bracket the root.
   Real min_h = eos.GetMinimumEnthalpy();
-  Real mul = 0.0;
-  Real muh = 1.0/min_h;
-  // Check if a tighter upper bound exists.
-  if (rsqr > min_h*min_h) {
-    Real mu = 0.0;
-    // We don't need the bound to be that tight, so we reduce
-    // the accuracy of the root solve for speed reasons.
-    Real mulc = mul;
-    Real mulh = muh;
-    bool result = root.NewtonSafe(UpperRoot, mulc, mulh, mu, 1e-10,
-                                  bsqr, rsqr, rbsqr, min_h);
-    // Scream if the bracketing failed.
-    if (!result) {
-      HandleFailure(prim, cons, b, g3d);
-      solver_result.error = Error::BRACKETING_FAILED;
-      return solver_result;
-    } else {
-      // To avoid problems with the case where the root and the upper bound collide,
-      // we will perturb the bound slightly upward.
-      // TODO(JF): Is there a more rigorous way of treating this?
-      muh = mu*(1. + 1e-10);
+  Real n, P, T, mu;
+  bool result = false;
+
+  // Warm start: mu = 1/(hW) of the guess is used to bracket the root tightly. This is
+  // skipped when the density may violate the limits of the EOS, which requires the
+  // checks in CheckDensityValid, and we fall back to the full bracketing below if the
+  // root does not lie within the tight bracket.
+  if (use_guess && prim[PRH] > 0.0 && isfinite(prim[PRH]) && isfinite(prim[PTM])) {
+    Real W_max = sqrt(1.0 + rsqr/(min_h*min_h));
+    Real rho_max = eos.GetMaximumDensity()*eos.GetBaryonMass();
+    Real rho_min = eos.GetMinimumDensity()*eos.GetBaryonMass();
+    if (D <= rho_max && D >= W_max*rho_min) {
+      Real Wv_g[3] = {prim[PVX], prim[PVY], prim[PVZ]};
+      Real W_g = sqrt(1.0 + SquareVector(Wv_g, g3d));
+      Real h_g = eos.GetEnthalpy(prim[PRH], prim[PTM], &prim[PYF]);
+      Real mu_g = 1.0/(h_g*W_g);
+      if (isfinite(mu_g) && mu_g > 0.0) {
+        Real mulw = mu_g*(1.0 - warm_width);
+        Real muhw = fmin(mu_g*(1.0 + warm_width), 1.0/min_h);
+        if (mulw < muhw) {
+          result = root.FalsePosition(RootFunction, mulw, muhw, mu, tol,
+                                      D, q, bsqr, rsqr, rbsqr, Y, &eos, &n, &T, &P);
+        }
+      }
     }
   }
 
-  // Check the corner case where the density is outside the permitted
-  // bounds according to the ErrorPolicy.
-  error = CheckDensityValid(mul, muh, D, bsqr, rsqr, rbsqr, min_h);
-  // TODO(JF): This is probably something that should be handled by the ErrorPolicy.
-  if (error != Error::SUCCESS) {
-    HandleFailure(prim, cons, b, g3d);
-    solver_result.error = error;
-    return solver_result;
-  }
+  if (!result) {
+    // Bracket the root.
+    Real mul = 0.0;
+    Real muh = 1.0/min_h;
+    // Check if a tighter upper bound exists.
+    if (rsqr > min_h*min_h) {
+      Real mub = 0.0;
+      // We don't need the bound to be that tight, so we reduce
+      // the accuracy of the root solve for speed reasons.
+      Real mulc = mul;
+      Real mulh = muh;
+      bool bracketed = root.NewtonSafe(UpperRoot, mulc, mulh, mub, 1e-10,
+                                       bsqr, rsqr, rbsqr, min_h);
+      // Scream if the bracketing failed.
+      if (!bracketed) {
+        HandleFailure(prim, cons, b, g3d);
+        solver_result.error = Error::BRACKETING_FAILED;
+        return solver_result;
+      } else {
+        // To avoid problems with the case where the root and the upper bound collide,
+        // we will perturb the bound slightly upward.
+        // TODO(JF): Is there a more rigorous way of treating this?
+        muh = mub*(1. + 1e-10);
+      }
+    }
 
+    // Check the corner case where the density is outside the permitted
+    // bounds according to the ErrorPolicy.
+    error = CheckDensityValid(mul, muh, D, bsqr, rsqr, rbsqr, min_h);
+    // TODO(JF): This is probably something that should be handled by the ErrorPolicy.
+    if (error != Error::SUCCESS) {
+      HandleFailure(prim, cons, b, g3d);
+      solver_result.error = error;
+      return solver_result;
+    }
 
-  // Do the root solve.
-  Real n, P, T, mu;
-  bool result = root.FalsePosition(RootFunction, mul, muh, mu, tol,
-                                   D, q, bsqr, rsqr, rbsqr, Y, &eos, &n, &T, &P);
+
+    // Do the root solve.
+    result = root.FalsePosition(RootFunction, mul, muh, mu, tol,
+                                D, q, bsqr, rsqr, rbsqr, Y, &eos, &n, &T, &P);
+  }
   // WARNING: the reported number of iterations is not thread-safe and should only be
   // trusted on single-thread benchmarks.
   solver_result.iterations = root.iterations;
   if (!result) {
-    HandleFailure(prim, cons, b, g3d);
+    if (!defer_failure) {
+      HandleFailure(prim, cons, b, g3d);
+    }
     solver_result.error = Error::NO_SOLUTION;
     return solver_result;
   }
@@ -79,7 +79,8 @@ class PrimitiveSolverHydro {
 
       // Get table filename, then read the table,
       std::string fname = pin->GetString(block, "table");
-      ps.GetEOSMutable().ReadTableFromFile(fname);
+      bool table_shared = pin->GetOrAddBoolean(block, "table_shared", false);
+      ps.GetEOSMutable().ReadTableFromFile(fname, table_shared);
 
       // Ensure table was read properly
       assert(ps.GetEOSMutable().IsInitialized());
@@ -91,10 +92,14 @@ class PrimitiveSolverHydro {
   MeshBlockPack* pmy_pack;
   unsigned int nerrs;
   unsigned int errcap;
+  bool two_pass;                 // finish slowly converging cells on a second pass
+  int fast_iter;                 // maximum root solver iterations on the first pass
+  DvceArray1D<int> c2p_list;     // cells deferred to the second pass
+  DvceArray1D<int> c2p_nlist;    // number of cells deferred to the second pass
 
   PrimitiveSolverHydro(std::string block, MeshBlockPack *pp, ParameterInput *pin) :
 //        pmy_pack(pp), ps{&eos} {
-        pmy_pack(pp), nerrs(0) {
+        pmy_pack(pp), nerrs(0), c2p_list("c2p_list",1), c2p_nlist("c2p_nlist",1) {
     SetPolicyParams(block, pin);
     Real mb = ps.GetEOS().GetBaryonMass();
     ps.GetEOSMutable().SetDensityFloor(pin->GetOrAddReal(block, "dfloor", (FLT_MIN))/mb);
@@ -102,6 +107,10 @@ class PrimitiveSolverHydro {
     ps.GetEOSMutable().SetThreshold(pin->GetOrAddReal(block, "dthreshold", 1.0));
     ps.tol = pin->GetOrAddReal(block, "c2p_tol", 1e-15);
     ps.GetRootSolverMutable().iterations = pin->GetOrAddInteger(block, "c2p_iter", 50);
+    ps.warm_start = pin->GetOrAddBoolean(block, "c2p_warm_start", false);
+    ps.warm_width = pin->GetOrAddReal(block, "c2p_warm_width", 1e-2);
+    two_pass = pin->GetOrAddBoolean(block, "c2p_two_pass", false);
+    fast_iter = pin->GetOrAddInteger(block, "c2p_fast_iter", 10);
     errcap = pin->GetOrAddInteger(block, "c2perrs", 1000);
 
     // Calculate maximum allowed velocity
@@ -188,7 +197,7 @@ class PrimitiveSolverHydro {
     auto &eos_ = ps.GetEOS();
     auto &ps_  = ps;
 
-    auto &adm = pmy_pack->padm->adm;
+    auto &adm = pmy_pack->padm->adm_fluid;
 
     int &nhyd = pmy_pack->pmhd->nmhd;
     int &nscal = pmy_pack->pmhd->nscalars;
@@ -273,7 +282,8 @@ class PrimitiveSolverHydro {
   void ConsToPrim(DvceArray5D<Real> &cons, const DvceFaceFld4D<Real> &bfc,
                   DvceArray5D<Real> &bcc0, DvceArray5D<Real> &prim,
                   const int il, const int iu, const int jl, const int ju,
-                  const int kl, const int ku, bool floors_only=false) {
+                  const int kl, const int ku, bool floors_only=false,
+                  const DvceArray1D<int> &mb_mask=DvceArray1D<int>()) {
     auto &indcs = pmy_pack->pmesh->mb_indcs;
     int &is = indcs.is, &js = indcs.js, &ks = indcs.ks;
     int &ie = indcs.ie, &je = indcs.ie, &ke = indcs.ke;
@@ -291,7 +301,9 @@ class PrimitiveSolverHydro {
     auto &dexcise_ = pmy_pack->pcoord->coord_data.dexcise;
     auto &pexcise_ = pmy_pack->pcoord->coord_data.pexcise;
 
-    auto &adm  = pmy_pack->padm->adm;
+    auto &adm  = pmy_pack->padm->adm_fluid;
+    auto &cc_metric_ = pmy_pack->padm->cc_metric;
+    bool metric_cached_ = pmy_pack->padm->metric_cached;
     auto &eos_ = ps.GetEOS();
     auto &ps_  = ps;
 
@@ -301,9 +313,12 @@ class PrimitiveSolverHydro {
     const int nmkji = nmb*nkji;
 
     const int rank = global_variable::my_rank;
-    const int nerrs_ = nerrs;
     const int errcap_ = errcap;
 
+    // if a mask is given, only MBs with mb_mask(m) > 0 are solved
+    const bool use_mask_ = (mb_mask.extent_int(0) > 0);
+    auto mb_mask_ = mb_mask;
+
     Real mb = eos_.GetBaryonMass();
 
     // FIXME: This only works for a flooring policy that has these functions!
@@ -315,199 +330,266 @@ class PrimitiveSolverHydro {
       ps.GetEOSMutable().SetConservedFloorFailure(true);
     }
 
-    // FIXME(JMF): We can short-circuit the primitive solve if FOFC is already enabled
-    // due to a maximum principle violation.
-    int count_errs=0;
-    Kokkos::parallel_reduce("pshyd_c2p",Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
-    KOKKOS_LAMBDA(const int &idx, int &sumerrs) {
-      int m = (idx)/nkji;
-      int k = (idx - m*nkji)/nji;
-      int j = (idx - m*nkji - k*nji)/ni;
-      int i = (idx - m*nkji - k*nji - j*ni) + il;
-      j += jl;
-      k += kl;
-
-      // Add in a short circuit where FOFC is guaranteed.
-      if (floors_only && fofc_(m, k, j, i)) {
-        return;
+    // With two_pass, the first pass solves every cell with at most fast_iter iterations
+    // of the root solver, so that cells which converge slowly (e.g. near the
+    // atmosphere or at high magnetization) do not stall the others.  Cells which do not
+    // converge are compacted into c2p_list, and a second pass over that list alone
+    // finishes them with the full number of iterations, applying the ErrorPolicy
+    // failure response to any that still fail.
+    const bool two_pass_ = two_pass && !floors_only;
+    auto ps_fast = ps;
+    ps_fast.GetRootSolverMutable().iterations = fast_iter;
+    if (two_pass_ && c2p_list.extent_int(0) < nmkji) {
+      Kokkos::realloc(c2p_list, nmkji);
+    }
+    auto &c2p_list_ = c2p_list;
+    auto &c2p_nlist_ = c2p_nlist;
+    if (two_pass_) {
+      Kokkos::deep_copy(c2p_nlist, 0);
+    }
+
+    const int npass = (two_pass_) ? 2 : 1;
+    int ncells = nmkji;
+    for (int pass = 0; pass < npass; ++pass) {
+      if (pass == 1) {
+        auto nlist_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), c2p_nlist);
+        ncells = nlist_h(0);
+        if (ncells == 0) break;
       }
-      if (floors_only && excise) {
-        if (excision_flux_(m,k,j,i)) {
+      const bool defer = two_pass_ && (pass == 0);
+      const auto &solver = (defer) ? ps_fast : ps;
+      const int nerrs_ = nerrs;
+
+      // FIXME(JMF): We can short-circuit the primitive solve if FOFC is already enabled
+      // due to a maximum principle violation.
+      int count_errs=0;
+      Kokkos::parallel_reduce("pshyd_c2p",Kokkos::RangePolicy<>(DevExeSpace(), 0, ncells),
+      KOKKOS_LAMBDA(const int &ic, int &sumerrs) {
+        const int idx = (pass == 0) ? ic : c2p_list_(ic);
+        int m = (idx)/nkji;
+        int k = (idx - m*nkji)/nji;
+        int j = (idx - m*nkji - k*nji)/ni;
+        int i = (idx - m*nkji - k*nji - j*ni) + il;
+        j += jl;
+        k += kl;
+
+        if (use_mask_ && mb_mask_(m) <= 0) {
           return;
         }
-      }
+        // Add in a short circuit where FOFC is guaranteed.
+        if (floors_only && fofc_(m, k, j, i)) {
+          return;
+        }
+        if (floors_only && excise) {
+          if (excision_flux_(m,k,j,i)) {
+            return;
+          }
+        }
 
-      // Extract the metric
-      Real g3d[NSPMETRIC], g3u[NSPMETRIC], detg, sdetg;
-      g3d[S11] = adm.g_dd(m, 0, 0, k, j, i);
-      g3d[S12] = adm.g_dd(m, 0, 1, k, j, i);
-      g3d[S13] = adm.g_dd(m, 0, 2, k, j, i);
-      g3d[S22] = adm.g_dd(m, 1, 1, k, j, i);
-      g3d[S23] = adm.g_dd(m, 1, 2, k, j, i);
-      g3d[S33] = adm.g_dd(m, 2, 2, k, j, i);
-      detg = Primitive::GetDeterminant(g3d);
-      sdetg = sqrt(detg);
-      Real isdetg = 1.0/sdetg;
-      adm::SpatialInv(1.0/detg,
-                  g3d[S11], g3d[S12], g3d[S13], g3d[S22], g3d[S23], g3d[S33],
-                 &g3u[S11], &g3u[S12], &g3u[S13], &g3u[S22], &g3u[S23], &g3u[S33]);
-
-      // Extract the conserved variables
-      Real cons_pt[NCONS], cons_pt_old[NCONS], prim_pt[NPRIM];
-      cons_pt[CDN] = cons_pt_old[CDN] = cons(m, IDN, k, j, i)*isdetg;
-      cons_pt[CSX] = cons_pt_old[CSX] = cons(m, IM1, k, j, i)*isdetg;
-      cons_pt[CSY] = cons_pt_old[CSY] = cons(m, IM2, k, j, i)*isdetg;
-      cons_pt[CSZ] = cons_pt_old[CSZ] = cons(m, IM3, k, j, i)*isdetg;
-      cons_pt[CTA] = cons_pt_old[CTA] = cons(m, IEN, k, j, i)*isdetg;
-      for (int n = 0; n < nscal; n++) {
-        cons_pt[CYD + n] = cons_pt_old[CYD + n] = cons(m, nhyd + n, k, j, i)*isdetg;
-      }
-      // If we're only testing the floors, we can use the CC fields.
-      Real b3u[NMAG];
-      if (floors_only) {
-        b3u[IBX] = bcc0(m, IBX, k, j, i)*isdetg;
-        b3u[IBY] = bcc0(m, IBY, k, j, i)*isdetg;
-        b3u[IBZ] = bcc0(m, IBZ, k, j, i)*isdetg;
-      } else {
-        // Otherwise we don't have the correct CC fields yet, so use
-        // the FC fields.
-        bcc0(m, IBX, k, j, i) = 0.5*(bfc.x1f(m,k,j,i) + bfc.x1f(m,k,j,i+1));
-        bcc0(m, IBY, k, j, i) = 0.5*(bfc.x2f(m,k,j,i) + bfc.x2f(m,k,j+1,i));
-        bcc0(m, IBZ, k, j, i) = 0.5*(bfc.x3f(m,k,j,i) + bfc.x3f(m,k+1,j,i));
-        b3u[IBX] = bcc0(m, IBX, k, j, i)*isdetg;
-        b3u[IBY] = bcc0(m, IBY, k, j, i)*isdetg;
-        b3u[IBZ] = bcc0(m, IBZ, k, j, i)*isdetg;
-      }
+        // Extract the metric
+        Real g3d[NSPMETRIC], g3u[NSPMETRIC], detg, sdetg;
+        g3d[S11] = adm.g_dd(m, 0, 0, k, j, i);
+        g3d[S12] = adm.g_dd(m, 0, 1, k, j, i);
+        g3d[S13] = adm.g_dd(m, 0, 2, k, j, i);
+        g3d[S22] = adm.g_dd(m, 1, 1, k, j, i);
+        g3d[S23] = adm.g_dd(m, 1, 2, k, j, i);
+        g3d[S33] = adm.g_dd(m, 2, 2, k, j, i);
+        if (metric_cached_) {
+          sdetg = cc_metric_(m, adm::ADM::I_CC_SDETG, k, j, i);
+          detg = sdetg*sdetg;
+          for (int n = 0; n < NSPMETRIC; n++) {
+            g3u[n] = cc_metric_(m, adm::ADM::I_CC_GUXX + n, k, j, i);
+          }
+        } else {
+          detg = Primitive::GetDeterminant(g3d);
+          sdetg = sqrt(detg);
+          adm::SpatialInv(1.0/detg,
+                      g3d[S11], g3d[S12], g3d[S13], g3d[S22], g3d[S23], g3d[S33],
+                     &g3u[S11], &g3u[S12], &g3u[S13], &g3u[S22], &g3u[S23], &g3u[S33]);
+        }
+        Real isdetg = 1.0/sdetg;
+
+        // Extract the conserved variables
+        Real cons_pt[NCONS], cons_pt_old[NCONS], prim_pt[NPRIM];
+        cons_pt[CDN] = cons_pt_old[CDN] = cons(m, IDN, k, j, i)*isdetg;
+        cons_pt[CSX] = cons_pt_old[CSX] = cons(m, IM1, k, j, i)*isdetg;
+        cons_pt[CSY] = cons_pt_old[CSY] = cons(m, IM2, k, j, i)*isdetg;
+        cons_pt[CSZ] = cons_pt_old[CSZ] = cons(m, IM3, k, j, i)*isdetg;
+        cons_pt[CTA] = cons_pt_old[CTA] = cons(m, IEN, k, j, i)*isdetg;
+        for (int n = 0; n < nscal; n++) {
+          cons_pt[CYD + n] = cons_pt_old[CYD + n] = cons(m, nhyd + n, k, j, i)*isdetg;
+        }
+        // If we're only testing the floors, we can use the CC fields.
+        Real b3u[NMAG];
+        if (floors_only) {
+          b3u[IBX] = bcc0(m, IBX, k, j, i)*isdetg;
+          b3u[IBY] = bcc0(m, IBY, k, j, i)*isdetg;
+          b3u[IBZ] = bcc0(m, IBZ, k, j, i)*isdetg;
+        } else {
+          // Otherwise we don't have the correct CC fields yet, so use
+          // the FC fields.
+          bcc0(m, IBX, k, j, i) = 0.5*(bfc.x1f(m,k,j,i) + bfc.x1f(m,k,j,i+1));
+          bcc0(m, IBY, k, j, i) = 0.5*(bfc.x2f(m,k,j,i) + bfc.x2f(m,k,j+1,i));
+          bcc0(m, IBZ, k, j, i) = 0.5*(bfc.x3f(m,k,j,i) + bfc.x3f(m,k+1,j,i));
+          b3u[IBX] = bcc0(m, IBX, k, j, i)*isdetg;
+          b3u[IBY] = bcc0(m, IBY, k, j, i)*isdetg;
+          b3u[IBZ] = bcc0(m, IBZ, k, j, i)*isdetg;
+        }
 
-      // If we're in an excised region, set the primitives to some default value.
-      Primitive::SolverResult result;
-      if (excise) {
-        if (excision_floor_(m,k,j,i)) {
-          prim_pt[PRH] = dexcise_/mb;
-          prim_pt[PVX] = 0.0;
-          prim_pt[PVY] = 0.0;
-          prim_pt[PVZ] = 0.0;
-          prim_pt[PPR] = pexcise_;
+        // Use the primitives from the previous step as an initial guess
+        bool use_guess = false;
+        if (ps_.warm_start && prim(m, IDN, k, j, i) > 0.0 &&
+                              prim(m, IPR, k, j, i) > 0.0) {
+          prim_pt[PRH] = prim(m, IDN, k, j, i)/mb;
+          prim_pt[PVX] = prim(m, IVX, k, j, i);
+          prim_pt[PVY] = prim(m, IVY, k, j, i);
+          prim_pt[PVZ] = prim(m, IVZ, k, j, i);
+          prim_pt[PPR] = prim(m, IPR, k, j, i);
           for (int n = 0; n < nscal; n++) {
-            // FIXME: Particle abundances should probably be set to a
-            // default inside an excised region.
-            prim_pt[PYF + n] = cons_pt[CYD]/cons_pt[CDN];
+            prim_pt[PYF + n] = prim(m, nhyd + n, k, j, i);
           }
-          prim_pt[PTM] =
-            eos_.GetTemperatureFromP(prim_pt[PRH], prim_pt[PPR], &prim_pt[PYF]);
-          result.error = Primitive::Error::SUCCESS;
-          result.iterations = 0;
-          result.cons_floor = false;
-          result.prim_floor = false;
-          result.cons_adjusted = true;
-          ps_.PrimToCon(prim_pt, cons_pt, b3u, g3d);
-        } else {
-          result = ps_.ConToPrim(prim_pt, cons_pt, b3u, g3d, g3u);
+          prim_pt[PTM] = eos_.GetTemperatureFromP(prim_pt[PRH], prim_pt[PPR],
+                                                  &prim_pt[PYF]);
+          use_guess = true;
         }
-      } else {
-        result = ps_.ConToPrim(prim_pt, cons_pt, b3u, g3d, g3u);
-      }
 
-      if (result.error != Primitive::Error::SUCCESS && floors_only) {
-        fofc_(m,k,j,i) = true;
-      } else if (!floors_only) {
-        if (result.error != Primitive::Error::SUCCESS && (nerrs_ + sumerrs < errcap_)) {
-          // TODO(JF): put in a proper error response here.
-          sumerrs++;
-          printf("An error occurred during the primitive solve: %s\n"
-                 "  Location: (%d, %d, %d, %d)\n"
-                 "  Conserved vars: \n"
-                 "    D   = %.17g\n"
-                 "    Sx  = %.17g\n"
-                 "    Sy  = %.17g\n"
-                 "    Sz  = %.17g\n"
-                 "    tau = %.17g\n"
-                 "    Dye = %.17g\n"
-                 "    Bx  = %.17g\n"
-                 "    By  = %.17g\n"
-                 "    Bz  = %.17g\n"
-                 "  Metric vars: \n"
-                 "    detg = %.17g\n"
-                 "    g_dd = {%.17g, %.17g, %.17g, %.17g, %.17g, %.17g}\n"
-                 "    alp  = %.17g\n"
-                 "    beta = {%.17g, %.17g, %.17g}\n"
-                 "    psi4 = %.17g\n"
-                 "    K_dd = {%.17g, %.17g, %.17g, %.17g, %.17g, %.17g}\n",
-                 ErrorToString(result.error),
-                 m, k, j, i,
-                 cons_pt_old[CDN], cons_pt_old[CSX], cons_pt_old[CSY], cons_pt_old[CSZ],
-                 cons_pt_old[CTA], cons_pt_old[CYD], b3u[IBX], b3u[IBY], b3u[IBZ], detg,
-                 g3d[S11], g3d[S12], g3d[S13], g3d[S22], g3d[S23], g3d[S33],
-                 adm.alpha(m, k, j, i),
-                 adm.beta_u(m, 0, k, j, i),
-                 adm.beta_u(m, 1, k, j, i), adm.beta_u(m, 2, k, j, i),
-                 adm.psi4(m, k, j, i),
-                 adm.vK_dd(m, 0, 0, k, j, i), adm.vK_dd(m, 0, 1, k, j, i),
-                 adm.vK_dd(m, 0, 2, k, j, i),
-                 adm.vK_dd(m, 1, 1, k, j, i), adm.vK_dd(m, 1, 2, k, j, i),
-                 adm.vK_dd(m, 2, 2, k, j, i));
-          if (nerrs_ + sumerrs == errcap_) {
-            printf("%d C2P errors have been detected on rank %d. All future C2P errors\n"
-                   "on this rank will be suppressed. Fix your code!\n",
-                   nerrs_ + sumerrs,rank);
+        // If we're in an excised region, set the primitives to some default value.
+        Primitive::SolverResult result;
+        if (excise) {
+          if (excision_floor_(m,k,j,i)) {
+            prim_pt[PRH] = dexcise_/mb;
+            prim_pt[PVX] = 0.0;
+            prim_pt[PVY] = 0.0;
+            prim_pt[PVZ] = 0.0;
+            prim_pt[PPR] = pexcise_;
+            for (int n = 0; n < nscal; n++) {
+              // FIXME: Particle abundances should probably be set to a
+              // default inside an excised region.
+              prim_pt[PYF + n] = cons_pt[CYD]/cons_pt[CDN];
+            }
+            prim_pt[PTM] =
+              eos_.GetTemperatureFromP(prim_pt[PRH], prim_pt[PPR], &prim_pt[PYF]);
+            result.error = Primitive::Error::SUCCESS;
+            result.iterations = 0;
+            result.cons_floor = false;
+            result.prim_floor = false;
+            result.cons_adjusted = true;
+            ps_.PrimToCon(prim_pt, cons_pt, b3u, g3d);
+          } else {
+            result = solver.ConToPrim(prim_pt, cons_pt, b3u, g3d, g3u, use_guess, defer);
           }
+        } else {
+          result = solver.ConToPrim(prim_pt, cons_pt, b3u, g3d, g3u, use_guess, defer);
         }
-        // Regardless of failure, we need to copy the primitives.
-        prim(m, IDN, k, j, i) = prim_pt[PRH]*mb;
-        prim(m, IVX, k, j, i) = prim_pt[PVX];
-        prim(m, IVY, k, j, i) = prim_pt[PVY];
-        prim(m, IVZ, k, j, i) = prim_pt[PVZ];
-        prim(m, IPR, k, j, i) = prim_pt[PPR];
-        for (int n = 0; n < nscal; n++) {
-          prim(m, nhyd + n, k, j, i) = prim_pt[PYF + n];
+
+        // Defer cells that did not converge within fast_iter iterations to the next pass.
+        if (defer && result.error == Primitive::Error::NO_SOLUTION) {
+          c2p_list_(Kokkos::atomic_fetch_add(&c2p_nlist_(0), 1)) = idx;
+          return;
         }
 
-        // If the conservative variables were floored or adjusted for consistency,
-        // we need to copy the conserved variables, too.
-        if (result.cons_floor || result.cons_adjusted) {
-          /*if (fabs((cons_pt[CDN] - cons_pt_old[CDN])/cons_pt_old[CDN]) > 1e-12) {
-            Real &x1min = size.d_view(m).x1min;
-            Real &x1max = size.d_view(m).x1max;
-            Real x1v = CellCenterX(i-is, indcs.nx1, x1min, x1max);
-
-            Real &x2min = size.d_view(m).x2min;
-            Real &x2max = size.d_view(m).x2max;
-            Real x2v = CellCenterX(j-js, indcs.nx2, x2min, x2max);
-
-            Real &x3min = size.d_view(m).x3min;
-            Real &x3max = size.d_view(m).x3max;
-            Real x3v = CellCenterX(k-ks, indcs.nx3, x3min, x3max);
-            bool is_ghost = (i < is) || (i > ie) ||
-                            (j < js) || (j > je) ||
-                            (k < ks) || (k > ke);
-
-            printf("Density was nontrivially adjusted on MeshBlock %d!\n"
-                   "  Grid index: (i=%d, j=%d, k=%d)\n"
-                   "  Physical position: (%g, %g, %g)\n"
-                   "  D (old): %.17g\n"
-                   "  D (new): %.17g\n"
-                   "  Ghost zone? %s\n",
-                   m, i, j, k,
-                   x1v, x2v, x3v, cons_pt_old[CDN], cons_pt[CDN],
-                   is_ghost ? "true" : "false");
-          }*/
-          cons(m, IDN, k, j, i) = cons_pt[CDN]*sdetg;
-          cons(m, IM1, k, j, i) = cons_pt[CSX]*sdetg;
-          cons(m, IM2, k, j, i) = cons_pt[CSY]*sdetg;
-          cons(m, IM3, k, j, i) = cons_pt[CSZ]*sdetg;
-          cons(m, IEN, k, j, i) = cons_pt[CTA]*sdetg;
+        if (result.error != Primitive::Error::SUCCESS && floors_only) {
+          fofc_(m,k,j,i) = true;
+        } else if (!floors_only) {
+          if (result.error != Primitive::Error::SUCCESS && (nerrs_ + sumerrs < errcap_)) {
+            // TODO(JF): put in a proper error response here.
+            sumerrs++;
+            printf("An error occurred during the primitive solve: %s\n"
+                   "  Location: (%d, %d, %d, %d)\n"
+                   "  Conserved vars: \n"
+                   "    D   = %.17g\n"
+                   "    Sx  = %.17g\n"
+                   "    Sy  = %.17g\n"
+                   "    Sz  = %.17g\n"
+                   "    tau = %.17g\n"
+                   "    Dye = %.17g\n"
+                   "    Bx  = %.17g\n"
+                   "    By  = %.17g\n"
+                   "    Bz  = %.17g\n"
+                   "  Metric vars: \n"
+                   "    detg = %.17g\n"
+                   "    g_dd = {%.17g, %.17g, %.17g, %.17g, %.17g, %.17g}\n"
+                   "    alp  = %.17g\n"
+                   "    beta = {%.17g, %.17g, %.17g}\n"
+                   "    psi4 = %.17g\n"
+                   "    K_dd = {%.17g, %.17g, %.17g, %.17g, %.17g, %.17g}\n",
+                   ErrorToString(result.error),
+                   m, k, j, i,
+                   cons_pt_old[CDN], cons_pt_old[CSX], cons_pt_old[CSY], cons_pt_old[CSZ],
+                   cons_pt_old[CTA], cons_pt_old[CYD], b3u[IBX], b3u[IBY], b3u[IBZ], detg,
+                   g3d[S11], g3d[S12], g3d[S13], g3d[S22], g3d[S23], g3d[S33],
+                   adm.alpha(m, k, j, i),
+                   adm.beta_u(m, 0, k, j, i),
+                   adm.beta_u(m, 1, k, j, i), adm.beta_u(m, 2, k, j, i),
+                   adm.psi4(m, k, j, i),
+                   adm.vK_dd(m, 0, 0, k, j, i), adm.vK_dd(m, 0, 1, k, j, i),
+                   adm.vK_dd(m, 0, 2, k, j, i),
+                   adm.vK_dd(m, 1, 1, k, j, i), adm.vK_dd(m, 1, 2, k, j, i),
+                   adm.vK_dd(m, 2, 2, k, j, i));
+            if (nerrs_ + sumerrs == errcap_) {
+              printf("%d C2P errors have been detected on rank %d. All future C2P "
+                     "errors\non this rank will be suppressed. Fix your code!\n",
+                     nerrs_ + sumerrs,rank);
+            }
+          }
+          // Regardless of failure, we need to copy the primitives.
+          prim(m, IDN, k, j, i) = prim_pt[PRH]*mb;
+          prim(m, IVX, k, j, i) = prim_pt[PVX];
+          prim(m, IVY, k, j, i) = prim_pt[PVY];
+          prim(m, IVZ, k, j, i) = prim_pt[PVZ];
+          prim(m, IPR, k, j, i) = prim_pt[PPR];
           for (int n = 0; n < nscal; n++) {
-            cons(m, nhyd + n, k, j, i) = cons_pt[CYD + n]*sdetg;
+            prim(m, nhyd + n, k, j, i) = prim_pt[PYF + n];
+          }
+
+          // If the conservative variables were floored or adjusted for consistency,
+          // we need to copy the conserved variables, too.
+          if (result.cons_floor || result.cons_adjusted) {
+            /*if (fabs((cons_pt[CDN] - cons_pt_old[CDN])/cons_pt_old[CDN]) > 1e-12) {
+              Real &x1min = size.d_view(m).x1min;
+              Real &x1max = size.d_view(m).x1max;
+              Real x1v = CellCenterX(i-is, indcs.nx1, x1min, x1max);
+
+              Real &x2min = size.d_view(m).x2min;
+              Real &x2max = size.d_view(m).x2max;
+              Real x2v = CellCenterX(j-js, indcs.nx2, x2min, x2max);
+
+              Real &x3min = size.d_view(m).x3min;
+              Real &x3max = size.d_view(m).x3max;
+              Real x3v = CellCenterX(k-ks, indcs.nx3, x3min, x3max);
+              bool is_ghost = (i < is) || (i > ie) ||
+                              (j < js) || (j > je) ||
+                              (k < ks) || (k > ke);
+
+              printf("Density was nontrivially adjusted on MeshBlock %d!\n"
+                     "  Grid index: (i=%d, j=%d, k=%d)\n"
+                     "  Physical position: (%g, %g, %g)\n"
+                     "  D (old): %.17g\n"
+                     "  D (new): %.17g\n"
+                     "  Ghost zone? %s\n",
+                     m, i, j, k,
+                     x1v, x2v, x3v, cons_pt_old[CDN], cons_pt[CDN],
+                     is_ghost ? "true" : "false");
+            }*/
+            cons(m, IDN, k, j, i) = cons_pt[CDN]*sdetg;
+            cons(m, IM1, k, j, i) = cons_pt[CSX]*sdetg;
+            cons(m, IM2, k, j, i) = cons_pt[CSY]*sdetg;
+            cons(m, IM3, k, j, i) = cons_pt[CSZ]*sdetg;
+            cons(m, IEN, k, j, i) = cons_pt[CTA]*sdetg;
+            for (int n = 0; n < nscal; n++) {
+              cons(m, nhyd + n, k, j, i) = cons_pt[CYD + n]*sdetg;
+            }
           }
         }
+      }, Kokkos::Sum<int>(count_errs));
+      if (!floors_only) {
+        nerrs += count_errs;
       }
-    }, Kokkos::Sum<int>(count_errs));
+    }
 
     if (floors_only) {
       ps.GetEOSMutable().SetPrimitiveFloorFailure(prim_failure);
       ps.GetEOSMutable().SetConservedFloorFailure(cons_failure);
-    } else {
-      nerrs += count_errs;
     }
   }
 
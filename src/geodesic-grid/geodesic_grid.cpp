@@ -34,7 +34,10 @@ GeodesicGrid::GeodesicGrid(int nlev, bool rotate, bool fluxes) :
     cart_pos_mid("cart_pos_mid",1,1,1),
     polar_pos("polar_pos",1,1),
     polar_pos_mid("polar_pos_mid",1,1,1),
-    unit_flux("unit_flux",1,1,1) {
+    unit_flux("unit_flux",1,1,1),
+    nbr_offset("nbr_offset",1),
+    nbr_index("nbr_index",1),
+    nbr_weight("nbr_weight",1) {
   if (nlevel > 0) {  // construct geodesic mesh
     // number of angles
     nangles = 5*2*SQR(nlevel) + 2;
@@ -338,6 +341,28 @@ GeodesicGrid::GeodesicGrid(int nlev, bool rotate, bool fluxes) :
       unit_flux.template sync<DevExeSpace>();
     }
 
+    // build CSR table of neighbors and geometric weights used in angular fluxes
+    Kokkos::realloc(nbr_offset,nangles+1);
+    nbr_offset.h_view(0) = 0;
+    for (int n=0; n<nangles; ++n) {
+      nbr_offset.h_view(n+1) = nbr_offset.h_view(n) + num_neighbors.h_view(n);
+    }
+    Kokkos::realloc(nbr_index,nbr_offset.h_view(nangles));
+    Kokkos::realloc(nbr_weight,nbr_offset.h_view(nangles));
+    for (int n=0; n<nangles; ++n) {
+      for (int nb=0; nb<num_neighbors.h_view(n); ++nb) {
+        int e = nbr_offset.h_view(n) + nb;
+        nbr_index.h_view(e) = ind_neighbors.h_view(n,nb);
+        nbr_weight.h_view(e) = arc_lengths.h_view(n,nb)/solid_angles.h_view(n);
+      }
+    }
+    nbr_offset.template modify<HostMemSpace>();
+    nbr_offset.template sync<DevExeSpace>();
+    nbr_index.template modify<HostMemSpace>();
+    nbr_index.template sync<DevExeSpace>();
+    nbr_weight.template modify<HostMemSpace>();
+    nbr_weight.template sync<DevExeSpace>();
+
   } else if (nlevel==0) {  // one angle per octant
     // throw warning---this should only ever be used for testing
     std::cout << "### WARNING! in " << __FILE__ << " at line " << __LINE__ << std::endl
@@ -388,6 +413,18 @@ GeodesicGrid::GeodesicGrid(int nlev, bool rotate, bool fluxes) :
 GeodesicGrid::~GeodesicGrid() {
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn int GeodesicGrid::NumLevels
+//! \brief returns level of geodesic mesh with nang angles, or -1 if there is none
+
+int GeodesicGrid::NumLevels(int nang) {
+  if (nang == 8) {return 0;}
+  for (int l=1; 5*2*SQR(l) + 2 <= nang; ++l) {
+    if (5*2*SQR(l) + 2 == nang) {return l;}
+  }
+  return -1;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void GeodesicGrid::GridCartPosition
 //! \brief find position at face center
@@ -29,8 +29,15 @@ class GeodesicGrid {
   DualArray2D<Real> polar_pos;            // polar coordinates at face center
   DualArray3D<Real> polar_pos_mid;        // polar coordinates at face edges
   DualArray3D<Real> unit_flux;            // angular unit vectors computed at face edges
+  // neighbors of all angles in compressed sparse row (CSR) format: neighbors of angle n
+  // are entries [nbr_offset(n), nbr_offset(n+1)), in the same order as ind_neighbors,
+  // with the weight arc_lengths(n,nb)/solid_angles(n) of the flux through each edge
+  DualArray1D<int>  nbr_offset;
+  DualArray1D<int>  nbr_index;
+  DualArray1D<Real> nbr_weight;
 
   // functions
+  static int NumLevels(int nang);
   void GridCartPosition(int n, Real& x, Real& y, Real& z);
   void GridCartPositionMid(int n, int nb, Real& x, Real& y, Real& z);
   void Neighbors(int n, int& num_nghbr, int neighbors[6]);
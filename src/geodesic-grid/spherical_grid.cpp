@@ -18,6 +18,7 @@
 #include "hydro/hydro.hpp"
 #include "mhd/mhd.hpp"
 #include "coordinates/coordinates.hpp"
+#include "utils/point_interpolator.hpp"
 #include "spherical_grid.hpp"
 
 //----------------------------------------------------------------------------------------
@@ -28,19 +29,18 @@ SphericalGrid::SphericalGrid(MeshBlockPack *ppack, int nlev, Real rad):
     pmy_pack(ppack),
     radius(rad),
     interp_coord("interp_coord",1,1),
-    interp_indcs("interp_indcs",1,1),
-    interp_wghts("interp_wghts",1,1,1),
-    interp_vals("interp_vals",1,1) {
-  // reallocate and set interpolation coordinates, indices, and weights
-  int &ng = pmy_pack->pmesh->mb_indcs.ng;
-  Kokkos::realloc(interp_coord,nangles,3);
-  Kokkos::realloc(interp_indcs,nangles,4);
-  Kokkos::realloc(interp_wghts,nangles,2*ng,3);
+    interp_vals("interp_vals",1,1),
+    nreflect("nreflect",1) {
+  // coordinates of grid points are shared with the interpolator
+  pinterp = new PointInterpolator(pmy_pack, nangles);
+  interp_coord = pinterp->coords;
+  interp_vals = pinterp->vals;
+  Kokkos::realloc(nreflect, nangles);
+  for (int d=0; d<3; ++d) {center[d] = 0.0;}
 
   // Call functions to prepare SphericalGrid object for interpolation
   SetInterpolationCoordinates();
-  SetInterpolationIndices();
-  SetInterpolationWeights();
+  pinterp->SetPoints(true);
 
   return;
 }
@@ -49,162 +49,75 @@ SphericalGrid::SphericalGrid(MeshBlockPack *ppack, int nlev, Real rad):
 //! \brief SphericalGrid destructor
 
 SphericalGrid::~SphericalGrid() {
+  delete pinterp;
 }
 
 //----------------------------------------------------------------------------------------
 //! \fn void SphericalGrid::SetInterpolationCoordinates
-//! \brief set Cartesian coordinates corresponding to radius at spherical surface
+//! \brief set Cartesian coordinates corresponding to radius at spherical surface, in a
+//! kernel over angles.  Coordinates are copied to the host for diagnostics.
 
 void SphericalGrid::SetInterpolationCoordinates() {
   // NOTE(@pdmullen): if constructing a SphericalGrid to interface with Cartesian Kerr-
   // Schild data, the SphericalGrid radius is assumed to correspond to a spherical Kerr-
   // Schild radius, meaning that when setting the x1, x2, and x3 interpolation coordinates
   // we must translate between the two coordinate systems.
-  if (pmy_pack->pcoord->is_general_relativistic ||
-      pmy_pack->pcoord->is_dynamical_relativistic) {
-    for (int n=0; n<nangles; ++n) {
-      Real &spin = pmy_pack->pcoord->coord_data.bh_spin;
-      Real &theta = polar_pos.h_view(n,0);
-      Real &phi = polar_pos.h_view(n,1);
-      interp_coord.h_view(n,0) = (radius*cos(phi)-spin*sin(phi))*sin(theta);
-      interp_coord.h_view(n,1) = (radius*sin(phi)+spin*cos(phi))*sin(theta);
-      interp_coord.h_view(n,2) = radius*cos(theta);
-    }
-  } else {
-    for (int n=0; n<nangles; ++n) {
-      Real &theta = polar_pos.h_view(n,0);
-      Real &phi = polar_pos.h_view(n,1);
-      interp_coord.h_view(n,0) = radius*cos(phi)*sin(theta);
-      interp_coord.h_view(n,1) = radius*sin(phi)*sin(theta);
-      interp_coord.h_view(n,2) = radius*cos(theta);
-    }
-  }
-
-  // sync dual arrays
-  interp_coord.template modify<HostMemSpace>();
-  interp_coord.template sync<DevExeSpace>();
-
-  return;
-}
-
-//----------------------------------------------------------------------------------------
-//! \fn void SphericalGrid::SetInterpolationIndices
-//! \brief determine which MeshBlocks and MeshBlock zones therein will be used in
-//         interpolation onto the sphere
-
-void SphericalGrid::SetInterpolationIndices() {
-  auto &size = pmy_pack->pmb->mb_size;
-  int nmb1 = pmy_pack->nmb_thispack - 1;
-  int nang1 = nangles - 1;
-
-  auto &rcoord = interp_coord;
-  auto &iindcs = interp_indcs;
-  for (int n=0; n<=nang1; ++n) {
-    // indices default to -1 if angle does not reside in this MeshBlockPack
-    iindcs.h_view(n,0) = -1;
-    iindcs.h_view(n,1) = -1;
-    iindcs.h_view(n,2) = -1;
-    iindcs.h_view(n,3) = -1;
-    for (int m=0; m<=nmb1; ++m) {
-      // extract MeshBlock bounds
-      Real &x1min = size.h_view(m).x1min;
-      Real &x1max = size.h_view(m).x1max;
-      Real &x2min = size.h_view(m).x2min;
-      Real &x2max = size.h_view(m).x2max;
-      Real &x3min = size.h_view(m).x3min;
-      Real &x3max = size.h_view(m).x3max;
-
-      // extract MeshBlock grid cell spacings
-      Real &dx1 = size.h_view(m).dx1;
-      Real &dx2 = size.h_view(m).dx2;
-      Real &dx3 = size.h_view(m).dx3;
-
-      // save MeshBlock and zone indicies for nearest position to spherical patch center
-      // if this angle position resides in this MeshBlock
-      if ((rcoord.h_view(n,0) >= x1min && rcoord.h_view(n,0) <= x1max) &&
-          (rcoord.h_view(n,1) >= x2min && rcoord.h_view(n,1) <= x2max) &&
-          (rcoord.h_view(n,2) >= x3min && rcoord.h_view(n,2) <= x3max)) {
-        iindcs.h_view(n,0) = m;
-        iindcs.h_view(n,1) = static_cast<int>(std::floor((rcoord.h_view(n,0)-
-                                                          (x1min+dx1/2.0))/dx1));
-        iindcs.h_view(n,2) = static_cast<int>(std::floor((rcoord.h_view(n,1)-
-                                                          (x2min+dx2/2.0))/dx2));
-        iindcs.h_view(n,3) = static_cast<int>(std::floor((rcoord.h_view(n,2)-
-                                                          (x3min+dx3/2.0))/dx3));
+  bool is_gr = (pmy_pack->pcoord->is_general_relativistic ||
+                pmy_pack->pcoord->is_dynamical_relativistic);
+  Real spin = (is_gr)? pmy_pack->pcoord->coord_data.bh_spin : 0.0;
+  Real rad = radius;
+  Real x1c = center[0], x2c = center[1], x3c = center[2];
+
+  // With reflection symmetry about xN=0, points at xN<0 are reflected into the Mesh.
+  // Users of the interpolated values must apply the parity of each variable.
+  auto &symmetric = pmy_pack->pmesh->symmetric;
+  bool sym1 = symmetric[0], sym2 = symmetric[1], sym3 = symmetric[2];
+
+  auto &polar_pos_ = polar_pos;
+  auto &interp_coord_ = interp_coord;
+  auto &nreflect_ = nreflect;
+  par_for("sph_coords",DevExeSpace(),0,nangles-1,
+  KOKKOS_LAMBDA(int n) {
+    Real theta = polar_pos_.d_view(n,0);
+    Real phi = polar_pos_.d_view(n,1);
+    Real x[3];
+    x[0] = x1c + (rad*cos(phi)-spin*sin(phi))*sin(theta);
+    x[1] = x2c + (rad*sin(phi)+spin*cos(phi))*sin(theta);
+    x[2] = x3c + rad*cos(theta);
+    bool sym[3] = {sym1, sym2, sym3};
+    int nref = 0;
+    for (int d=0; d<3; ++d) {
+      if (sym[d] && x[d] < 0.0) {
+        x[d] = -x[d];
+        nref++;
       }
+      interp_coord_.d_view(n,d) = x[d];
     }
-  }
+    nreflect_.d_view(n) = nref;
+  });
 
   // sync dual arrays
-  interp_indcs.template modify<HostMemSpace>();
-  interp_indcs.template sync<DevExeSpace>();
+  interp_coord.template modify<DevExeSpace>();
+  interp_coord.template sync<HostMemSpace>();
+  nreflect.template modify<DevExeSpace>();
+  nreflect.template sync<HostMemSpace>();
 
   return;
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn void SphericalGrid::SetInterpolationWeights
-//! \brief set weights used by Lagrangian interpolation
-
-void SphericalGrid::SetInterpolationWeights() {
-  auto &indcs = pmy_pack->pmesh->mb_indcs;
-  auto &size = pmy_pack->pmb->mb_size;
-  int &ng = indcs.ng;
-
-  auto &iindcs = interp_indcs;
-  auto &iwghts = interp_wghts;
-  for (int n=0; n<nangles; ++n) {
-    // extract indices
-    int &ii0 = iindcs.h_view(n,0);
-    int &ii1 = iindcs.h_view(n,1);
-    int &ii2 = iindcs.h_view(n,2);
-    int &ii3 = iindcs.h_view(n,3);
-
-    if (ii0==-1) {  // angle not on this rank
-      for (int i=0; i<2*ng; ++i) {
-        iwghts.h_view(n,i,0) = 0.0;
-        iwghts.h_view(n,i,1) = 0.0;
-        iwghts.h_view(n,i,2) = 0.0;
-      }
-    } else {
-      // extract spherical grid positions
-      Real &x0 = interp_coord.h_view(n,0);
-      Real &y0 = interp_coord.h_view(n,1);
-      Real &z0 = interp_coord.h_view(n,2);
-
-      // extract MeshBlock bounds
-      Real &x1min = size.h_view(ii0).x1min;
-      Real &x1max = size.h_view(ii0).x1max;
-      Real &x2min = size.h_view(ii0).x2min;
-      Real &x2max = size.h_view(ii0).x2max;
-      Real &x3min = size.h_view(ii0).x3min;
-      Real &x3max = size.h_view(ii0).x3max;
-
-      // set interpolation weights
-      for (int i=0; i<2*ng; ++i) {
-        iwghts.h_view(n,i,0) = 1.;
-        iwghts.h_view(n,i,1) = 1.;
-        iwghts.h_view(n,i,2) = 1.;
-        for (int j=0; j<2*ng; ++j) {
-          if (j != i) {
-            Real x1vpi1 = CellCenterX(ii1-ng+i+1, indcs.nx1, x1min, x1max);
-            Real x1vpj1 = CellCenterX(ii1-ng+j+1, indcs.nx1, x1min, x1max);
-            iwghts.h_view(n,i,0) *= (x0-x1vpj1)/(x1vpi1-x1vpj1);
-            Real x2vpi1 = CellCenterX(ii2-ng+i+1, indcs.nx2, x2min, x2max);
-            Real x2vpj1 = CellCenterX(ii2-ng+j+1, indcs.nx2, x2min, x2max);
-            iwghts.h_view(n,i,1) *= (y0-x2vpj1)/(x2vpi1-x2vpj1);
-            Real x3vpi1 = CellCenterX(ii3-ng+i+1, indcs.nx3, x3min, x3max);
-            Real x3vpj1 = CellCenterX(ii3-ng+j+1, indcs.nx3, x3min, x3max);
-            iwghts.h_view(n,i,2) *= (z0-x3vpj1)/(x3vpi1-x3vpj1);
-          }
-        }
-      }
-    }
-  }
-
-  // sync dual arrays
-  interp_wghts.template modify<HostMemSpace>();
-  interp_wghts.template sync<DevExeSpace>();
+//! \fn void SphericalGrid::SetCenterAndRadius
+//! \brief moves sphere to center (x1c,x2c,x3c) with radius rad.  Grid points are only
+//! relocated if the surface has changed.
+
+void SphericalGrid::SetCenterAndRadius(Real x1c, Real x2c, Real x3c, Real rad) {
+  if (x1c == center[0] && x2c == center[1] && x3c == center[2] && rad == radius) return;
+  center[0] = x1c;
+  center[1] = x2c;
+  center[2] = x3c;
+  radius = rad;
+  SetInterpolationCoordinates();
+  pinterp->SetPoints(true);
 
   return;
 }
@@ -214,51 +127,12 @@ void SphericalGrid::SetInterpolationWeights() {
 //! \brief interpolate Cartesian data to surface of sphere
 
 void SphericalGrid::InterpolateToSphere(int nvars, DvceArray5D<Real> &val) {
-  // reinitialize interpolation indices and weights if AMR
-  if (pmy_pack->pmesh->adaptive) {
-    SetInterpolationIndices();
-    SetInterpolationWeights();
+  // relocate grid points in MeshBlocks if the Mesh has changed since they were located
+  if (pinterp->version != pmy_pack->pmesh->mesh_version) {
+    pinterp->SetPoints(true);
   }
-
-  // capturing variables for kernel
-  auto &indcs = pmy_pack->pmesh->mb_indcs;
-  int &is = indcs.is; int &js = indcs.js; int &ks = indcs.ks;
-  int &ng = indcs.ng;
-  int nang1 = nangles - 1;
-  int nvar1 = nvars - 1;
-
-  // reallocate container
-  Kokkos::realloc(interp_vals,nangles,nvars);
-
-  auto &iindcs = interp_indcs;
-  auto &iwghts = interp_wghts;
-  auto &ivals = interp_vals;
-  par_for("int2sph",DevExeSpace(),0,nang1,0,nvar1,
-  KOKKOS_LAMBDA(int n, int v) {
-    int ii0 = iindcs.d_view(n,0);
-    int ii1 = iindcs.d_view(n,1);
-    int ii2 = iindcs.d_view(n,2);
-    int ii3 = iindcs.d_view(n,3);
-
-    if (ii0==-1) {  // angle not on this rank
-      ivals.d_view(n,v) = 0.0;
-    } else {
-      Real int_value = 0.0;
-      for (int i=0; i<2*ng; i++) {
-        for (int j=0; j<2*ng; j++) {
-          for (int k=0; k<2*ng; k++) {
-            Real iwght = iwghts.d_view(n,i,0)*iwghts.d_view(n,j,1)*iwghts.d_view(n,k,2);
-            int_value += iwght*val(ii0,v,ii3-(ng-k-ks)+1,ii2-(ng-j-js)+1,ii1-(ng-i-is)+1);
-          }
-        }
-      }
-      ivals.d_view(n,v) = int_value;
-    }
-  });
-
-  // sync dual arrays
-  interp_vals.template modify<DevExeSpace>();
-  interp_vals.template sync<HostMemSpace>();
+  pinterp->Interpolate(nvars, val);
+  interp_vals = pinterp->vals;
 
   return;
 }
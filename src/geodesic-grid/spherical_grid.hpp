@@ -7,13 +7,16 @@
 // Licensed under the 3-clause BSD License (the "LICENSE")
 //========================================================================================
 //! \file spherical_grid.hpp
-//  \brief definitions for SphericalGrid class
+//  \brief definitions for SphericalGrid class.  Coordinates of grid points, the
+//  MeshBlocks containing them, and interpolation weights are all computed on the device,
+//  so surfaces that move (e.g. with punctures or horizons) can be rebuilt cheaply.
 
 #include "athena.hpp"
 #include "geodesic-grid/geodesic_grid.hpp"
 
 // Forward declarations
 class MeshBlockPack;
+class PointInterpolator;
 
 //----------------------------------------------------------------------------------------
 //! \class SphericalGrid
@@ -24,18 +27,19 @@ class SphericalGrid: public GeodesicGrid {
     SphericalGrid(MeshBlockPack *pmy_pack, int nlev, Real rad);
     ~SphericalGrid();
 
-    Real radius;  // const radius for SphericalGrid
+    Real radius;     // radius of SphericalGrid
+    Real center[3];  // Cartesian coordinates of center of SphericalGrid (default origin)
     DualArray2D<Real> interp_coord;  // Cartesian coordinates for grid points
     DualArray2D<Real> interp_vals;   // container for data interpolated to sphere
+    DualArray1D<int> nreflect;       // number of symmetry planes point reflected across
     void InterpolateToSphere(int nvars, DvceArray5D<Real> &val);  // interpolate to sphere
+    // move sphere to new center and radius, and rebuild grid points if they changed
+    void SetCenterAndRadius(Real x1c, Real x2c, Real x3c, Real rad);
 
  private:
     MeshBlockPack* pmy_pack;  // ptr to MeshBlockPack containing this Hydro
-    DualArray2D<int> interp_indcs;   // indices of MeshBlock and zones therein for interp
-    DualArray3D<Real> interp_wghts;  // weights for interpolation
-    void SetInterpolationCoordinates();  // set indexing for interpolation
-    void SetInterpolationIndices();      // set indexing for interpolation
-    void SetInterpolationWeights();      // set weights for interpolation
+    PointInterpolator *pinterp;      // locates grid points and interpolates to them
+    void SetInterpolationCoordinates();  // set Cartesian coordinates of grid points
 };
 
 #endif // GEODESIC_GRID_SPHERICAL_GRID_HPP_
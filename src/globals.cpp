@@ -16,4 +16,14 @@
 namespace global_variable {
 int my_rank;   // MPI rank of this process; set at start of main();
 int nranks;    // total number of MPI ranks; set at start of main();
+// number of bits of MPI tags used to store MeshBlock local IDs, so maximum number of MBs
+// per rank is 2^nbits_lid.  Set from MPI_TAG_UB at start of main().
+int nbits_lid = 14;
+#if MPI_PARALLEL_ENABLED
+// communicator containing all ranks of the run, used by all communication (directly or
+// duplicated) instead of MPI_COMM_WORLD, so that the run is not tied to the ranks it
+// was launched with.  MPI_COMM_WORLD, except with <ensemble>/ngroups > 1 when it
+// contains the ranks of one group of ensemble members (see main()).
+MPI_Comm athena_comm = MPI_COMM_WORLD;
+#endif
 }
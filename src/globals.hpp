@@ -8,8 +8,18 @@
 //! \file globals.hpp
 //  \brief namespace containing external global variables
 
+#include "config.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
 namespace global_variable {
 extern int my_rank, nranks;
+extern int nbits_lid;
+#if MPI_PARALLEL_ENABLED
+extern MPI_Comm athena_comm;
+#endif
 }
 
 #endif // GLOBALS_HPP_
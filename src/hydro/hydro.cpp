@@ -19,6 +19,8 @@
 #include "srcterms/srcterms.hpp"
 #include "shearing_box/shearing_box.hpp"
 #include "bvals/bvals.hpp"
+#include "utils/first_touch.hpp"
+#include "utils/managed_memory.hpp"
 #include "hydro/hydro.hpp"
 
 namespace hydro {
@@ -30,11 +32,12 @@ Hydro::Hydro(MeshBlockPack *ppack, ParameterInput *pin) :
     u0("cons",1,1,1,1,1),
     w0("prim",1,1,1,1,1),
     coarse_u0("ccons",1,1,1,1,1),
-    coarse_w0("cprim",1,1,1,1,1),
     u1("cons1",1,1,1,1,1),
     uflx("uflx",1,1,1,1,1),
-    utest("utest",1,1,1,1,1),
-    fofc("fofc",1,1,1,1) {
+    fofc("fofc",1,1,1,1),
+    fofc_cells("fofc_cells",1),
+    c2p_nfloor("c2p_nfloor",1),
+    rs_nrow("rs_nrow",1) {
   // Total number of MeshBlocks on this rank to be used in array dimensioning
   int nmb = std::max((ppack->nmb_thispack), (ppack->pmesh->nmb_maxperrank));
 
@@ -70,6 +73,15 @@ Hydro::Hydro(MeshBlockPack *ppack, ParameterInput *pin) :
 
   // (2) Initialize scalars, diffusion, source terms
   nscalars = pin->GetOrAddInteger("hydro","nscalars",0);
+  // the last ndiag_scalars scalars are diagnostic tracers, always reconstructed with
+  // (cheap) donor cell regardless of <hydro>/reconstruct
+  ndiag_scalars = pin->GetOrAddInteger("hydro","ndiag_scalars",0);
+  if (ndiag_scalars < 0 || ndiag_scalars > nscalars) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<hydro>/ndiag_scalars=" << ndiag_scalars << " must be between 0 and "
+              << "nscalars=" << nscalars << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
 
   // Viscosity (if requested in input file)
   if (pin->DoesParameterExist("hydro","viscosity")) {
@@ -101,22 +113,28 @@ Hydro::Hydro(MeshBlockPack *ppack, ParameterInput *pin) :
     int ncells1 = indcs.nx1 + 2*(indcs.ng);
     int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
     int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
-    Kokkos::realloc(u0, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
-    Kokkos::realloc(w0, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+    FirstTouch::Realloc(u0, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+    FirstTouch::Realloc(w0, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
   }
 
-  // allocate memory for conserved variables on coarse mesh
+  // allocate memory for conserved variables on coarse mesh (only for MBs with coarser
+  // neighbors when arrays are compacted with SMR)
   if (ppack->pmesh->multilevel) {
     auto &indcs = pmy_pack->pmesh->mb_indcs;
     int n_ccells1 = indcs.cnx1 + 2*(indcs.ng);
     int n_ccells2 = (indcs.cnx2 > 1)? (indcs.cnx2 + 2*(indcs.ng)) : 1;
     int n_ccells3 = (indcs.cnx3 > 1)? (indcs.cnx3 + 2*(indcs.ng)) : 1;
-    Kokkos::realloc(coarse_u0, nmb, (nhydro+nscalars), n_ccells3, n_ccells2, n_ccells1);
-    Kokkos::realloc(coarse_w0, nmb, (nhydro+nscalars), n_ccells3, n_ccells2, n_ccells1);
+    int ncmb = (pmy_pack->pmb->compact_coarse)? pmy_pack->pmb->nmb_coarse : nmb;
+    ManagedMemory::Realloc(coarse_u0, ncmb, (nhydro+nscalars), n_ccells3, n_ccells2,
+                           n_ccells1);
   }
 
   // allocate boundary buffers for conserved (cell-centered) variables
   pbval_u = new MeshBoundaryValuesCC(ppack, pin, false);
+  // optionally send single-precision ghost zones to MeshBlocks on other nodes
+  pbval_u->compress_mpi = pin->GetOrAddBoolean("hydro","compress_mpi",false);
+  // optionally exchange fewer ghost cells than <mesh>/nghost
+  nghost = pbval_u->SetGhostDepth(pin, "hydro");
   pbval_u->InitializeBuffers((nhydro+nscalars));
 
   // Orbital advection and shearing box BCs (if requested in input file)
@@ -133,6 +151,59 @@ Hydro::Hydro(MeshBlockPack *ppack, ParameterInput *pin) :
     // determine if FOFC is enabled
     use_fofc = pin->GetOrAddBoolean("hydro","fofc",false);
 
+    // determine if ConsToPrim in active cells is overlapped with communications
+    overlap_comm = pin->GetOrAddBoolean("hydro","overlap_comm",false);
+
+    // determine if fluxes and RK update are computed in a single fused kernel.  Only
+    // possible when the x1/x2-fluxes are not needed elsewhere (flux correction, FOFC,
+    // diffusive fluxes), and no other task modifies u0 between fluxes and update.
+    fused_update = pin->GetOrAddBoolean("hydro","fused_update",false);
+    if (fused_update) {
+      if (ppack->pmesh->multilevel || use_fofc || (pvisc != nullptr) ||
+          (pcond != nullptr) || pin->DoesBlockExist("mhd") ||
+          pin->DoesBlockExist("turb_driving") || pmy_pack->pcoord->is_spherical_polar ||
+          (pmy_pack->pcoord->is_general_relativistic &&
+           pmy_pack->pcoord->coord_data.bh_excise)) {
+        std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<hydro>/fused_update cannot be used with SMR/AMR, "
+                  << "FOFC, diffusion, two-fluid, turbulence driving, excision, or "
+                  << "spherical-polar coordinates. "
+                  << "Using unfused fluxes and update." << std::endl;
+        fused_update = false;
+      }
+    }
+
+    // determine if RK update, ConsToPrim and new timestep in active cells are computed
+    // in a single kernel.  Only possible for non-relativistic hydrodynamics (the kernel
+    // is instantiated for each EOS) when no source terms or orbital advection change
+    // u0 after the update.  User source terms are checked at runtime, since the
+    // ProblemGenerator does not yet exist here.
+    fused_c2p = pin->GetOrAddBoolean("hydro","fused_c2p",false);
+    if (fused_c2p) {
+      if (fused_update || evolution_t.compare("dynamic") != 0 ||
+          pmy_pack->pcoord->is_special_relativistic ||
+          pmy_pack->pcoord->is_general_relativistic ||
+          pmy_pack->pcoord->is_dynamical_relativistic ||
+          pmy_pack->pcoord->is_spherical_polar ||
+          psrc->const_accel || psrc->ism_cooling || psrc->rel_cooling ||
+          psrc->shearing_box || (porb_u != nullptr) || (psbox_u != nullptr)) {
+        std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<hydro>/fused_c2p requires non-relativistic "
+                  << "hydrodynamics in Cartesian coordinates without fused_update, "
+                  << "source terms, or shearing box. Using separate update and "
+                  << "ConsToPrim." << std::endl;
+        fused_c2p = false;
+      } else {
+        Kokkos::realloc(c2p_nfloor, 3);
+      }
+    }
+
+    // determine if viscosity and conduction are integrated with super-time-stepping
+    // [sts_integrator error checked in driver constructor]
+    std::string sts_integrator = pin->GetOrAddString("time","sts_integrator","none");
+    use_sts = ((sts_integrator.compare("rkl2") == 0) &&
+               ((pvisc != nullptr) || (pcond != nullptr && !(pcond->implicit))));
+
     // select reconstruction method (default PLM)
     std::string xorder = pin->GetOrAddString("hydro","reconstruct","plm");
     if (xorder.compare("dc") == 0) {
@@ -140,29 +211,27 @@ Hydro::Hydro(MeshBlockPack *ppack, ParameterInput *pin) :
     } else if (xorder.compare("plm") == 0) {
       recon_method = ReconstructionMethod::plm;
       // check that nghost > 2 with PLM+FOFC
-      auto &indcs = pmy_pack->pmesh->mb_indcs;
-      if (use_fofc && indcs.ng < 3) {
+      if (use_fofc && nghost < 3) {
         std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
           << std::endl << "FOFC and " << xorder << " reconstruction requires at "
-          << "least 3 ghost zones, but <mesh>/nghost=" << indcs.ng << std::endl;
+          << "least 3 ghost zones, but <hydro>/nghost=" << nghost << std::endl;
         std::exit(EXIT_FAILURE);
       }
     } else if (xorder.compare("ppm4") == 0 ||
                xorder.compare("ppmx") == 0 ||
                xorder.compare("wenoz") == 0) {
       // check that nghost > 2
-      auto &indcs = pmy_pack->pmesh->mb_indcs;
-      if (indcs.ng < 3) {
+      if (nghost < 3) {
         std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
           << std::endl << xorder << " reconstruction requires at least 3 ghost zones, "
-          << "but <mesh>/nghost=" << indcs.ng << std::endl;
+          << "but <hydro>/nghost=" << nghost << std::endl;
         std::exit(EXIT_FAILURE);
       }
       // check that nghost > 3 with PPM4(or PPMX or WENOZ)+FOFC
-      if (use_fofc && indcs.ng < 4) {
+      if (use_fofc && nghost < 4) {
         std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
           << std::endl << "FOFC and " << xorder << " reconstruction requires at "
-          << "least 4 ghost zones, but <mesh>/nghost=" << indcs.ng << std::endl;
+          << "least 4 ghost zones, but <hydro>/nghost=" << nghost << std::endl;
         std::exit(EXIT_FAILURE);
       }
       if (xorder.compare("ppm4") == 0) {
@@ -179,6 +248,75 @@ Hydro::Hydro(MeshBlockPack *ppack, ParameterInput *pin) :
       std::exit(EXIT_FAILURE);
     }
 
+    // determine if ghost zones are exchanged only once per timestep (deep halo).  Only
+    // possible on periodic uniform grids when no other task updates u0 only in active
+    // cells.  Number of ghost zones is checked in driver constructor, since it depends
+    // on number of stages of the time-integrator.
+    deep_halo = pin->GetOrAddBoolean("hydro","deep_halo",false);
+    if (deep_halo) {
+      if (!(ppack->pmesh->strictly_periodic) || ppack->pmesh->multilevel || use_fofc ||
+          fused_update || fused_c2p || overlap_comm || use_sts || (pvisc != nullptr) ||
+          (pcond != nullptr) || psrc->const_accel || psrc->ism_cooling ||
+          psrc->rel_cooling || psrc->shearing_box || (porb_u != nullptr) ||
+          pmy_pack->pcoord->is_general_relativistic ||
+          pmy_pack->pcoord->is_dynamical_relativistic ||
+          pin->DoesBlockExist("mhd") || pin->DoesBlockExist("turb_driving") ||
+          pin->DoesBlockExist("self_gravity") || pin->DoesBlockExist("radiation")) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+          << std::endl << "<hydro>/deep_halo requires periodic uniform grids without "
+          << "FOFC, fused kernels, overlap_comm, diffusion, source terms, GR, MHD, "
+          << "turbulence driving, self-gravity, or radiation" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+      switch (recon_method) {
+        case ReconstructionMethod::dc:
+          deep_halo_width = 1;
+          break;
+        case ReconstructionMethod::plm:
+          deep_halo_width = 2;
+          break;
+        default:
+          deep_halo_width = 3;
+          break;
+      }
+    }
+
+    // determine if ghost zones of u0 in edges and corners of MeshBlocks are skipped in
+    // the exchange at each stage.  Only possible when every stencil is dimensionally
+    // split, so that cells in edge and corner ghost zones are never used.  They still
+    // are filled once in Driver::Initialize, but otherwise contain stale data.
+    faces_only_exchange = pin->GetOrAddBoolean("hydro","exchange_faces_only",false);
+    if (faces_only_exchange) {
+      if (ppack->pmesh->multilevel || use_fofc || deep_halo || (pvisc != nullptr) ||
+          (pcond != nullptr) || (porb_u != nullptr) || (psbox_u != nullptr) ||
+          pin->DoesBlockExist("mhd") || pin->DoesBlockExist("radiation") ||
+          pin->DoesBlockExist("particles")) {
+        std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<hydro>/exchange_faces_only cannot be used with "
+                  << "SMR/AMR, FOFC, deep_halo, diffusion, shearing box, two-fluid, "
+                  << "radiation, or particles. Exchanging all ghost zones." << std::endl;
+        faces_only_exchange = false;
+      }
+    }
+
+    // determine if the flow is held fixed in kinematic problems, so that only passive
+    // scalars are advected.  Hydro variables in ghost zones are filled once in
+    // Driver::Initialize and never change, so they are skipped in the exchange at each
+    // stage.  Not possible with SMR/AMR since prolongation acts on all variables.
+    fixed_flow = pin->GetOrAddBoolean("hydro","fixed_flow",false);
+    if (fixed_flow) {
+      if (evolution_t.compare("kinematic") != 0 || ppack->pmesh->multilevel ||
+          fused_update || (pvisc != nullptr) || (pcond != nullptr) || psrc->const_accel ||
+          psrc->ism_cooling || psrc->rel_cooling || psrc->shearing_box ||
+          (porb_u != nullptr) || (psbox_u != nullptr)) {
+        std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<hydro>/fixed_flow requires kinematic evolution on "
+                  << "uniform grids without fused_update, diffusion, source terms, or "
+                  << "shearing box. Evolving all variables." << std::endl;
+        fixed_flow = false;
+      }
+    }
+
     // select Riemann solver (no default).  Test for compatibility of options
     std::string rsolver = pin->GetString("hydro","rsolver");
     // Special relativistic dynamic solvers
@@ -265,6 +403,20 @@ Hydro::Hydro(MeshBlockPack *ppack, ParameterInput *pin) :
       }
     }
 
+    // determine if HLLE is used in smooth rows of faces (hybrid Riemann solver)
+    rsolver_hybrid = pin->GetOrAddBoolean("hydro","rsolver_hybrid",false);
+    if (rsolver_hybrid) {
+      if (rsolver_method != Hydro_RSolver::hllc && rsolver_method != Hydro_RSolver::roe) {
+        std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<hydro>/rsolver_hybrid requires rsolver = hllc or "
+                  << "roe. Using '" << rsolver << "' everywhere." << std::endl;
+        rsolver_hybrid = false;
+      } else {
+        rsolver_hybrid_tol = pin->GetOrAddReal("hydro","rsolver_hybrid_tol",0.1);
+        Kokkos::realloc(rs_nrow, 2);
+      }
+    }
+
     // Final memory allocations
     {
       // allocate second registers, fluxes
@@ -272,15 +424,24 @@ Hydro::Hydro(MeshBlockPack *ppack, ParameterInput *pin) :
       int ncells1 = indcs.nx1 + 2*(indcs.ng);
       int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
       int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
-      Kokkos::realloc(u1,       nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
-      Kokkos::realloc(uflx.x1f, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
-      Kokkos::realloc(uflx.x2f, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
-      Kokkos::realloc(uflx.x3f, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+      FirstTouch::Realloc(u1,       nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+      // x1/x2-fluxes are kept only in scratch memory with fused kernel
+      if (!(fused_update)) {
+        FirstTouch::Realloc(uflx.x1f, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+        FirstTouch::Realloc(uflx.x2f, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+      }
+      FirstTouch::Realloc(uflx.x3f, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+
+      // allocate registers used with STS
+      if (use_sts) {
+        Kokkos::realloc(u_sts0,  nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+        Kokkos::realloc(u_sts1,  nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+        Kokkos::realloc(lu_sts0, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+      }
 
       // allocate array of flags used with FOFC
       if (use_fofc) {
         Kokkos::realloc(fofc,  nmb, ncells3, ncells2, ncells1);
-        Kokkos::realloc(utest, nmb, nhydro, ncells3, ncells2, ncells1);
       }
     }
   }
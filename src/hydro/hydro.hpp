@@ -37,6 +37,7 @@ enum class Hydro_RSolver {advect, llf, hlle, hllc, roe,    // non-relativistic
 //  \brief container to hold TaskIDs of all hydro tasks
 
 struct HydroTaskIDs {
+  TaskID impcond;
   TaskID irecv;
   TaskID copyu;
   TaskID flux;
@@ -54,9 +55,24 @@ struct HydroTaskIDs {
   TaskID bcs;
   TaskID prol;
   TaskID c2p;
+  TaskID c2pa;
   TaskID newdt;
   TaskID csend;
   TaskID crecv;
+  // super-time-stepping tasks
+  TaskID sts_irecv;
+  TaskID sts_flux;
+  TaskID sts_sendf;
+  TaskID sts_recvf;
+  TaskID sts_updt;
+  TaskID sts_restu;
+  TaskID sts_sendu;
+  TaskID sts_recvu;
+  TaskID sts_bcs;
+  TaskID sts_prol;
+  TaskID sts_c2p;
+  TaskID sts_csend;
+  TaskID sts_crecv;
 };
 
 namespace hydro {
@@ -76,11 +92,12 @@ class Hydro {
 
   int nhydro;             // number of hydro variables (5/4 for ideal/isothermal EOS)
   int nscalars;           // number of passive scalars
+  int ndiag_scalars;      // number of (last) scalars reconstructed with donor cell
+  int nghost;             // number of ghost cells exchanged with neighbors
   DvceArray5D<Real> u0;   // conserved variables
   DvceArray5D<Real> w0;   // primitive variables
 
   DvceArray5D<Real> coarse_u0;  // conserved variables on 2x coarser grid (for SMR/AMR)
-  DvceArray5D<Real> coarse_w0;  // primitive variables on 2x coarser grid (for SMR/AMR)
 
   // Boundary communication buffers and functions for u
   MeshBoundaryValuesCC *pbval_u;
@@ -96,19 +113,48 @@ class Hydro {
 
   // following only used for time-evolving flow
   DvceArray5D<Real> u1;       // conserved variables at intermediate step
-  DvceFaceFld5D<Real> uflx;   // fluxes of conserved quantities on cell faces
+  DvceFaceFld5D<FluxReal> uflx; // fluxes of conserved quantities on cell faces
   Real dtnew;
 
   // following used for FOFC
   DvceArray4D<bool> fofc;  // flag for each cell to indicate if FOFC is needed
   bool use_fofc = false;   // flag to enable FOFC
-  DvceArray5D<Real> utest;  // scratch array for FOFC
+  DvceArray1D<int> fofc_cells;  // compacted list of cells flagged for FOFC
+
+  // flag to overlap ConsToPrim in active cells with communication of ghost zones
+  bool overlap_comm = false;
+  // flag to compute x1/x2-fluxes in scratch and update u0 in same kernel (uniform grids)
+  bool fused_update = false;
+  // flag to compute RK update, ConsToPrim and new timestep in active cells in one kernel
+  bool fused_c2p = false;
+  DvceArray1D<int> c2p_nfloor;  // counters of floors used in fused kernel
+  // flag to use HLLE instead of HLLC/Roe in rows of faces without discontinuities
+  bool rsolver_hybrid = false;
+  Real rsolver_hybrid_tol = 0.1;  // largest relative jump at faces of "smooth" rows
+  DvceArray1D<int> rs_nrow;       // number of rows using (rsolver, HLLE)
+  // flag to exchange ghost zones only once per timestep, with fluxes and updates in the
+  // earlier stages extended over the ghost zones that are still valid
+  bool deep_halo = false;
+  int deep_halo_width = 0;      // number of ghost cells invalidated by each stage
+  // flag to exchange ghost zones of u0 only across faces (not edges and corners)
+  bool faces_only_exchange = false;
+  // flag to hold the flow (hydro variables) fixed in kinematic problems, so only the
+  // passive scalars are updated and exchanged
+  bool fixed_flow = false;
+
+  // following used for RKL2 super-time-stepping (STS) of viscosity and conduction
+  bool use_sts = false;
+  DvceArray5D<Real> u_sts0;   // conserved variables at start of STS (Y_0)
+  DvceArray5D<Real> u_sts1;   // conserved variables two STS stages ago (Y_{j-2})
+  DvceArray5D<Real> lu_sts0;  // dt*(diffusive flux divergence) at start of STS
 
   // container to hold names of TaskIDs
   HydroTaskIDs id;
 
   // functions...
   void AssembleHydroTasks(std::map<std::string, std::shared_ptr<TaskList>> tl);
+  // ...in "before_timeintegrator_tl" list
+  TaskStatus ImplicitConduction(Driver *d, int stage);
   // ...in "before_stagen_tl" list
   TaskStatus InitRecv(Driver *d, int stage);
   // ...in "stagen_tl" list
@@ -117,6 +163,8 @@ class Hydro {
   TaskStatus SendFlux(Driver *d, int stage);
   TaskStatus RecvFlux(Driver *d, int stage);
   TaskStatus RKUpdate(Driver *d, int stage);
+  template <EOS_Type T>
+  TaskStatus RKUpdateAndConToPrim(Driver *d, int stage);
   TaskStatus HydroSrcTerms(Driver *d, int stage);
   TaskStatus SendU_OA(Driver *d, int stage);
   TaskStatus RecvU_OA(Driver *d, int stage);
@@ -128,20 +176,34 @@ class Hydro {
   TaskStatus ApplyPhysicalBCs(Driver* pdrive, int stage);
   TaskStatus Prolongate(Driver* pdrive, int stage);
   TaskStatus ConToPrim(Driver *d, int stage);
+  TaskStatus ConToPrimActive(Driver *d, int stage);
+  TaskStatus ConToPrimGhosts(Driver *d, int stage);
   TaskStatus NewTimeStep(Driver *d, int stage);
   // ...in "after_stagen_tl" list
   TaskStatus ClearSend(Driver *d, int stage);
   TaskStatus ClearRecv(Driver *d, int stage);  // also in Driver::Initialize
+  // ...in "sts" list
+  TaskStatus STSFluxes(Driver *d, int stage);
+  TaskStatus STSUpdate(Driver *d, int stage);
 
   // CalculateFluxes function templated over Riemann Solvers
   template <Hydro_RSolver T>
   void CalculateFluxes(Driver *d, int stage);
+  template <Hydro_RSolver T, int NDIM>
+  void CalculateFluxesAndUpdate(Driver *d, int stage);
 
   // first-order flux correction
   void FOFC(Driver *d, int stage);
+  template <EOS_Type T>
+  void FOFCFlagCells(Driver *d, int stage);
 
  private:
   MeshBlockPack* pmy_pack;  // ptr to MeshBlockPack containing this Hydro
+  // fused_c2p kernel is used only when no user source terms change u0 after RKUpdate
+  bool FuseConToPrim() const;
+  // number of ghost cells updated in each direction at given stage with deep_halo
+  int DeepHaloExtent(Driver *d, int stage) const;
+  bool dtnew_computed = false;  // set when fused_c2p kernel has already computed dtnew
 };
 
 } // namespace hydro
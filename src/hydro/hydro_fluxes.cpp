@@ -10,6 +10,7 @@
 
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
+#include "driver/driver.hpp"
 #include "coordinates/coordinates.hpp"
 #include "hydro.hpp"
 #include "eos/eos.hpp"
@@ -17,6 +18,7 @@
 #include "reconstruct/plm.hpp"
 #include "reconstruct/ppm.hpp"
 #include "reconstruct/wenoz.hpp"
+#include "reconstruct/jump_indicator.hpp"
 #include "hydro/rsolvers/advect_hyd.hpp"
 #include "hydro/rsolvers/llf_hyd.hpp"
 #include "hydro/rsolvers/hlle_hyd.hpp"
@@ -29,6 +31,27 @@
 #include "hydro/rsolvers/hlle_grhyd.hpp"
 
 namespace hydro {
+//----------------------------------------------------------------------------------------
+//! \fn double RSolverFlops()
+//! \brief Rough number of FLOPs of each Riemann solver per face, used only in estimates
+//! passed to KernelCounters (<time>/roofline)
+
+static double RSolverFlops(Hydro_RSolver rsolver) {
+  switch (rsolver) {
+    case Hydro_RSolver::advect:  return 10.0;
+    case Hydro_RSolver::llf:     return 60.0;
+    case Hydro_RSolver::hlle:    return 80.0;
+    case Hydro_RSolver::hllc:    return 120.0;
+    case Hydro_RSolver::roe:     return 200.0;
+    case Hydro_RSolver::llf_sr:  return 150.0;
+    case Hydro_RSolver::hlle_sr: return 180.0;
+    case Hydro_RSolver::hllc_sr: return 300.0;
+    case Hydro_RSolver::llf_gr:  return 400.0;
+    case Hydro_RSolver::hlle_gr: return 450.0;
+    default: return 0.0;
+  }
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void Hydro::CalculateFluxes
 //! \brief Calls reconstruction and Riemann solver functions to compute hydro fluxes
@@ -37,13 +60,19 @@ namespace hydro {
 template <Hydro_RSolver rsolver_method_>
 void Hydro::CalculateFluxes(Driver *pdriver, int stage) {
   RegionIndcs &indcs_ = pmy_pack->pmesh->mb_indcs;
+#if FIXED_MB_NX1 > 0
+  constexpr int is = FIXED_MB_IS, ie = FIXED_MB_IE;
+  constexpr int ncells1 = ScrRowLength(FIXED_MB_NCELLS1);
+#else
   int is = indcs_.is, ie = indcs_.ie;
+  int ncells1 = ScrRowLength(indcs_.nx1 + 2*(indcs_.ng));
+#endif
   int js = indcs_.js, je = indcs_.je;
   int ks = indcs_.ks, ke = indcs_.ke;
-  int ncells1 = indcs_.nx1 + 2*(indcs_.ng);
 
   int &nhyd_  = nhydro;
   int nvars = nhydro + nscalars;
+  int nrec = nvars - ndiag_scalars;  // variables reconstructed with recon_method
   int nmb1 = pmy_pack->nmb_thispack - 1;
   const auto recon_method_ = recon_method;
   bool extrema = false;
@@ -56,15 +85,46 @@ void Hydro::CalculateFluxes(Driver *pdriver, int stage) {
   auto &coord_ = pmy_pack->pcoord->coord_data;
   auto &w0_ = w0;
 
+  // In GR with excision, fluxes are not computed in rows (or MeshBlocks) in which every
+  // cell is excised, since the conserved variables there are reset in ConsToPrim.  Fluxes
+  // are instead set to zero so that these conserved variables remain bounded.
+  bool excise_ = (pmy_pack->pcoord->is_general_relativistic)? coord_.bh_excise : false;
+  auto &excision_pencil_ = pmy_pack->pcoord->excision_pencil;
+  auto &excision_mb_ = pmy_pack->pcoord->excision_mb;
+
+  // with deep_halo, fluxes in earlier stages are also computed over ghost zones
+  int e = DeepHaloExtent(pdriver, stage);
+
+  // with rsolver_hybrid, rows of faces without discontinuities use HLLE instead of the
+  // HLLC or Roe solver, and rows are counted by the solver used.  Counts accumulate on
+  // the device, and are only copied to the host when the event log is written.
+  constexpr bool hybrid_rs = (rsolver_method_ == Hydro_RSolver::hllc ||
+                              rsolver_method_ == Hydro_RSolver::roe);
+  bool hybrid_ = rsolver_hybrid;
+  Real hybrid_tol_ = rsolver_hybrid_tol;
+  auto &nrow_ = rs_nrow;
+
+  // static estimates per face for roofline counters, assuming each primitive is read and
+  // each flux is written once
+  KernelCounters &kc = pmy_pack->pmesh->kcounter;
+  double face_bytes = 2.0*nvars*sizeof(Real);
+  double face_flops = nrec*ReconstructionFlops(recon_method) +
+                      (nvars - nrec)*ReconstructionFlops(ReconstructionMethod::dc) +
+                      RSolverFlops(rsolver_method_);
+
   //--------------------------------------------------------------------------------------
   // i-direction
 
   size_t scr_size = ScrArray2D<Real>::shmem_size(nvars, ncells1) * 2;
   int scr_level = 0;
-  auto &flx1_ = uflx.x1f;
 
   // set the loop limits for 1D/2D/3D problems
   int il = is, iu = ie+1, jl = js, ju = je, kl = ks, ku = ke;
+  if (e > 0) {
+    il = is-e, iu = ie+1+e;
+    if (pmy_pack->pmesh->multi_d) {jl = js-e, ju = je+e;}
+    if (pmy_pack->pmesh->three_d) {kl = ks-e, ku = ke+e;}
+  }
   if (use_fofc) {
     il = is-1, iu = ie+2;
     if (pmy_pack->pmesh->two_d) {
@@ -74,85 +134,118 @@ void Hydro::CalculateFluxes(Driver *pdriver, int stage) {
     }
   }
 
-  par_for_outer("hflux_x1",DevExeSpace(), scr_size, scr_level, 0, nmb1, kl, ku, jl, ju,
-  KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
-    ScrArray2D<Real> wl(member.team_scratch(scr_level), nvars, ncells1);
-    ScrArray2D<Real> wr(member.team_scratch(scr_level), nvars, ncells1);
-
-    // Reconstruct qR[i] and qL[i+1]
-    switch (recon_method_) {
-      case ReconstructionMethod::dc:
-        DonorCellX1(member, m, k, j, il-1, iu, w0_, wl, wr);
-        break;
-      case ReconstructionMethod::plm:
-        PiecewiseLinearX1(member, m, k, j, il-1, iu, w0_, wl, wr);
-        break;
-      case ReconstructionMethod::ppm4:
-      case ReconstructionMethod::ppmx:
-        PiecewiseParabolicX1(member,eos_,extrema,true, m, k, j, il-1, iu, w0_, wl, wr);
-        break;
-      case ReconstructionMethod::wenoz:
-        WENOZX1(member, eos_, true, m, k, j, il-1, iu, w0_, wl, wr);
-        break;
-      default:
-        break;
-    }
-    // Sync all threads in the team so that scratch memory is consistent
-    member.team_barrier();
-
-    // compute fluxes over [is,ie+1]
-    // NOTE(@pdmullen): Capture variables prior to if constexpr.  Required for cuda 11.6+.
-    auto eos = eos_;
-    auto indcs = indcs_;
-    auto size = size_;
-    auto coord = coord_;
-    auto flx1 = flx1_;
-    if constexpr (rsolver_method_ == Hydro_RSolver::advect) {
-      Advect(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    } else if constexpr (rsolver_method_ == Hydro_RSolver::llf) {
-      LLF(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle) {
-      HLLE(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    } else if constexpr (rsolver_method_ == Hydro_RSolver::hllc) {
-      HLLC(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    } else if constexpr (rsolver_method_ == Hydro_RSolver::roe) {
-      Roe(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    } else if constexpr (rsolver_method_ == Hydro_RSolver::llf_sr) {
-      LLF_SR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle_sr) {
-      HLLE_SR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    } else if constexpr (rsolver_method_ == Hydro_RSolver::hllc_sr) {
-      HLLC_SR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    } else if constexpr (rsolver_method_ == Hydro_RSolver::llf_gr) {
-      LLF_GR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle_gr) {
-      HLLE_GR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    }
-    member.team_barrier();
-
-    // calculate fluxes of scalars (if any)
-    if (nvars > nhyd_) {
-      for (int n=nhyd_; n<nvars; ++n) {
-        par_for_inner(member, is, ie+1, [&](const int i) {
-          if (flx1_(m,IDN,k,j,i) >= 0.0) {
-            flx1_(m,n,k,j,i) = flx1_(m,IDN,k,j,i)*wl(n,i);
-          } else {
-            flx1_(m,n,k,j,i) = flx1_(m,IDN,k,j,i)*wr(n,i);
-          }
-        });
+  // x1-fluxes are computed in the fused kernel with <hydro>/fused_update
+  if (!(fused_update)) {
+    auto &flx1_ = uflx.x1f;
+
+    kc.Start("hflux_x1", static_cast<double>(nmb1+1)*(ku-kl+1)*(ju-jl+1)*(iu-il+1),
+             face_bytes, face_flops);
+    par_for_outer("hflux_x1",DevExeSpace(), scr_size, scr_level, 0, nmb1, kl, ku, jl, ju,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+      ScrArray2D<Real> wl(member.team_scratch(scr_level), nvars, ncells1);
+      ScrArray2D<Real> wr(member.team_scratch(scr_level), nvars, ncells1);
+
+      if (excise_ && excision_pencil_(m,k,j)) {
+        for (int n=0; n<nvars; ++n) {
+          par_for_inner(member, il, iu, [&](const int i) {
+            flx1_(m,n,k,j,i) = 0.0;
+          });
+        }
+        return;
       }
-    }
-  });
+
+      // Reconstruct qR[i] and qL[i+1]
+      switch (recon_method_) {
+        case ReconstructionMethod::dc:
+          DonorCellX1(member, m, k, j, il-1, iu, w0_, wl, wr);
+          break;
+        case ReconstructionMethod::plm:
+          PiecewiseLinearX1(member, m, k, j, il-1, iu, w0_, wl, wr, 0, nrec-1);
+          break;
+        case ReconstructionMethod::ppm4:
+        case ReconstructionMethod::ppmx:
+          PiecewiseParabolicX1(member,eos_,extrema,true, m, k, j, il-1, iu, w0_, wl, wr,
+                               0, nrec-1);
+          break;
+        case ReconstructionMethod::wenoz:
+          WENOZX1(member, eos_, true, m, k, j, il-1, iu, w0_, wl, wr, 0, nrec-1);
+          break;
+        default:
+          break;
+      }
+      // diagnostic scalars (if any) are reconstructed with donor cell
+      if (nrec < nvars && recon_method_ != ReconstructionMethod::dc) {
+        DonorCellX1(member, m, k, j, il-1, iu, w0_, wl, wr, nrec);
+      }
+      // Sync all threads in the team so that scratch memory is consistent
+      member.team_barrier();
+
+      // compute fluxes over [is,ie+1]
+      // NOTE(@pdmullen): Capture variables prior to if constexpr. Required for cuda 11.6+
+      auto eos = eos_;
+      auto indcs = indcs_;
+      auto size = size_;
+      auto coord = coord_;
+      auto flx1 = flx1_;
+      bool smooth = false;
+      if constexpr (hybrid_rs) {
+        if (hybrid_) {smooth = SmoothRow(member, eos, il, iu, wl, wr, hybrid_tol_,
+                                         nrow_);}
+      }
+      if (smooth) {
+        HLLE(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::advect) {
+        Advect(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::llf) {
+        LLF(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle) {
+        HLLE(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::hllc) {
+        HLLC(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::roe) {
+        Roe(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::llf_sr) {
+        LLF_SR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle_sr) {
+        HLLE_SR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::hllc_sr) {
+        HLLC_SR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::llf_gr) {
+        LLF_GR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle_gr) {
+        HLLE_GR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      }
+      member.team_barrier();
+
+      // calculate fluxes of scalars (if any)
+      if (nvars > nhyd_) {
+        for (int n=nhyd_; n<nvars; ++n) {
+          par_for_inner(member, is-e, ie+1+e, [&](const int i) {
+            if (flx1_(m,IDN,k,j,i) >= 0.0) {
+              flx1_(m,n,k,j,i) = flx1_(m,IDN,k,j,i)*wl(n,i);
+            } else {
+              flx1_(m,n,k,j,i) = flx1_(m,IDN,k,j,i)*wr(n,i);
+            }
+          });
+        }
+      }
+    });
+    kc.Stop();
+  }
 
   //--------------------------------------------------------------------------------------
   // j-direction
 
-  if (pmy_pack->pmesh->multi_d) {
+  if (pmy_pack->pmesh->multi_d && !(fused_update)) {
     scr_size = ScrArray2D<Real>::shmem_size(nvars, ncells1) * 3;
     auto &flx2_ = uflx.x2f;
 
     // set the loop limits for 1D/2D/3D problems
     il = is, iu = ie, jl = js-1, ju = je+1, kl = ks, ku = ke;
+    if (e > 0) {
+      il = is-e, iu = ie+e, jl = js-1-e, ju = je+1+e;
+      if (pmy_pack->pmesh->three_d) {kl = ks-e, ku = ke+e;}
+    }
     if (use_fofc) {
       jl = js-2, ju = je+2;
       if (pmy_pack->pmesh->two_d) {
@@ -162,12 +255,25 @@ void Hydro::CalculateFluxes(Driver *pdriver, int stage) {
       }
     }
 
+    kc.Start("hflux_x2", static_cast<double>(nmb1+1)*(ku-kl+1)*(ju-jl)*(iu-il+1),
+             face_bytes, face_flops);
     par_for_outer("hflux_x2",DevExeSpace(), scr_size, scr_level, 0, nmb1, kl, ku,
     KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k) {
       ScrArray2D<Real> scr1(member.team_scratch(scr_level), nvars, ncells1);
       ScrArray2D<Real> scr2(member.team_scratch(scr_level), nvars, ncells1);
       ScrArray2D<Real> scr3(member.team_scratch(scr_level), nvars, ncells1);
 
+      if (excise_ && excision_mb_(m)) {
+        for (int j=jl; j<=ju; ++j) {
+          for (int n=0; n<nvars; ++n) {
+            par_for_inner(member, il, iu, [&](const int i) {
+              flx2_(m,n,k,j,i) = 0.0;
+            });
+          }
+        }
+        return;
+      }
+
       for (int j=jl; j<=ju; ++j) {
         // Permute scratch arrays.
         auto wl     = scr1;
@@ -184,18 +290,23 @@ void Hydro::CalculateFluxes(Driver *pdriver, int stage) {
             DonorCellX2(member, m, k, j, il, iu, w0_, wl_jp1, wr);
             break;
           case ReconstructionMethod::plm:
-            PiecewiseLinearX2(member, m, k, j, il, iu, w0_, wl_jp1, wr);
+            PiecewiseLinearX2(member, m, k, j, il, iu, w0_, wl_jp1, wr, 0, nrec-1);
             break;
           case ReconstructionMethod::ppm4:
           case ReconstructionMethod::ppmx:
-            PiecewiseParabolicX2(member,eos_,extrema,true,m,k,j,il,iu, w0_, wl_jp1, wr);
+            PiecewiseParabolicX2(member,eos_,extrema,true,m,k,j,il,iu, w0_, wl_jp1, wr,
+                                 0, nrec-1);
             break;
           case ReconstructionMethod::wenoz:
-            WENOZX2(member, eos_, true, m, k, j, il, iu, w0_, wl_jp1, wr);
+            WENOZX2(member, eos_, true, m, k, j, il, iu, w0_, wl_jp1, wr, 0, nrec-1);
             break;
           default:
             break;
         }
+        // diagnostic scalars (if any) are reconstructed with donor cell
+        if (nrec < nvars && recon_method_ != ReconstructionMethod::dc) {
+          DonorCellX2(member, m, k, j, il, iu, w0_, wl_jp1, wr, nrec);
+        }
         member.team_barrier();
 
         // compute fluxes over [js,je+1].  RS returns flux in input wr array
@@ -206,7 +317,14 @@ void Hydro::CalculateFluxes(Driver *pdriver, int stage) {
           auto size = size_;
           auto coord = coord_;
           auto flx2 = flx2_;
-          if constexpr (rsolver_method_ == Hydro_RSolver::advect) {
+          bool smooth = false;
+          if constexpr (hybrid_rs) {
+            if (hybrid_) {smooth = SmoothRow(member, eos, il, iu, wl, wr, hybrid_tol_,
+                                             nrow_);}
+          }
+          if (smooth) {
+            HLLE(member, eos, indcs, size, coord, m, k, j, il, iu, IVY, wl, wr, flx2);
+          } else if constexpr (rsolver_method_ == Hydro_RSolver::advect) {
             Advect(member, eos, indcs, size, coord, m, k, j, il, iu, IVY, wl, wr, flx2);
           } else if constexpr (rsolver_method_ == Hydro_RSolver::llf) {
             LLF(member, eos, indcs, size, coord, m, k, j, il, iu, IVY, wl, wr, flx2);
@@ -233,7 +351,7 @@ void Hydro::CalculateFluxes(Driver *pdriver, int stage) {
         // calculate fluxes of scalars (if any)
         if (nvars > nhyd_) {
           for (int n=nhyd_; n<nvars; ++n) {
-            par_for_inner(member, is, ie, [&](const int i) {
+            par_for_inner(member, is-e, ie+e, [&](const int i) {
               if (flx2_(m,IDN,k,j,i) >= 0.0) {
                 flx2_(m,n,k,j,i) = flx2_(m,IDN,k,j,i)*wl(n,i);
               } else {
@@ -244,6 +362,7 @@ void Hydro::CalculateFluxes(Driver *pdriver, int stage) {
         }
       } // end of loop over j
     });
+    kc.Stop();
   }
 
   //--------------------------------------------------------------------------------------
@@ -255,14 +374,28 @@ void Hydro::CalculateFluxes(Driver *pdriver, int stage) {
 
     // set the loop limits
     il = is, iu = ie, jl = js, ju = je, kl = ks-1, ku = ke+1;
+    if (e > 0) {il = is-e, iu = ie+e, jl = js-e, ju = je+e, kl = ks-1-e, ku = ke+1+e;}
     if (use_fofc) { il = is-1, iu = ie+1, jl = js-1, ju = je+1, kl = ks-2, ku = ke+2; }
 
+    kc.Start("hflux_x3", static_cast<double>(nmb1+1)*(ku-kl)*(ju-jl+1)*(iu-il+1),
+             face_bytes, face_flops);
     par_for_outer("hflux_x3",DevExeSpace(), scr_size, scr_level, 0, nmb1, jl, ju,
     KOKKOS_LAMBDA(TeamMember_t member, const int m, const int j) {
       ScrArray2D<Real> scr1(member.team_scratch(scr_level), nvars, ncells1);
       ScrArray2D<Real> scr2(member.team_scratch(scr_level), nvars, ncells1);
       ScrArray2D<Real> scr3(member.team_scratch(scr_level), nvars, ncells1);
 
+      if (excise_ && excision_mb_(m)) {
+        for (int k=kl; k<=ku; ++k) {
+          for (int n=0; n<nvars; ++n) {
+            par_for_inner(member, il, iu, [&](const int i) {
+              flx3_(m,n,k,j,i) = 0.0;
+            });
+          }
+        }
+        return;
+      }
+
       for (int k=kl; k<=ku; ++k) {
         // Permute scratch arrays.
         auto wl     = scr1;
@@ -279,18 +412,23 @@ void Hydro::CalculateFluxes(Driver *pdriver, int stage) {
             DonorCellX3(member, m, k, j, il, iu, w0_, wl_kp1, wr);
             break;
           case ReconstructionMethod::plm:
-            PiecewiseLinearX3(member, m, k, j, il, iu, w0_, wl_kp1, wr);
+            PiecewiseLinearX3(member, m, k, j, il, iu, w0_, wl_kp1, wr, 0, nrec-1);
             break;
           case ReconstructionMethod::ppm4:
           case ReconstructionMethod::ppmx:
-            PiecewiseParabolicX3(member,eos_,extrema,true,m,k,j,il,iu, w0_, wl_kp1, wr);
+            PiecewiseParabolicX3(member,eos_,extrema,true,m,k,j,il,iu, w0_, wl_kp1, wr,
+                                 0, nrec-1);
             break;
           case ReconstructionMethod::wenoz:
-            WENOZX3(member, eos_, true, m, k, j, il, iu, w0_, wl_kp1, wr);
+            WENOZX3(member, eos_, true, m, k, j, il, iu, w0_, wl_kp1, wr, 0, nrec-1);
             break;
           default:
             break;
         }
+        // diagnostic scalars (if any) are reconstructed with donor cell
+        if (nrec < nvars && recon_method_ != ReconstructionMethod::dc) {
+          DonorCellX3(member, m, k, j, il, iu, w0_, wl_kp1, wr, nrec);
+        }
         member.team_barrier();
 
         // compute fluxes over [ks,ke+1].  RS returns flux in input wr array
@@ -301,7 +439,14 @@ void Hydro::CalculateFluxes(Driver *pdriver, int stage) {
           auto size = size_;
           auto coord = coord_;
           auto flx3 = flx3_;
-          if constexpr (rsolver_method_ == Hydro_RSolver::advect) {
+          bool smooth = false;
+          if constexpr (hybrid_rs) {
+            if (hybrid_) {smooth = SmoothRow(member, eos, il, iu, wl, wr, hybrid_tol_,
+                                             nrow_);}
+          }
+          if (smooth) {
+            HLLE(member, eos, indcs, size, coord, m, k, j, il, iu, IVZ, wl, wr, flx3);
+          } else if constexpr (rsolver_method_ == Hydro_RSolver::advect) {
             Advect(member, eos, indcs, size, coord, m, k, j, il, iu, IVZ, wl, wr, flx3);
           } else if constexpr (rsolver_method_ == Hydro_RSolver::llf) {
             LLF(member, eos, indcs, size, coord, m, k, j, il, iu, IVZ, wl, wr, flx3);
@@ -328,7 +473,7 @@ void Hydro::CalculateFluxes(Driver *pdriver, int stage) {
         // calculate fluxes of scalars (if any)
         if (nvars > nhyd_) {
           for (int n=nhyd_; n<nvars; ++n) {
-            par_for_inner(member, is, ie, [&](const int i) {
+            par_for_inner(member, is-e, ie+e, [&](const int i) {
               if (flx3_(m,IDN,k,j,i) >= 0.0) {
                 flx3_(m,n,k,j,i) = flx3_(m,IDN,k,j,i)*wl(n,i);
               } else {
@@ -339,6 +484,18 @@ void Hydro::CalculateFluxes(Driver *pdriver, int stage) {
         }
       } // end loop over k
     });
+    kc.Stop();
+  }
+
+  // flux divergence in x1/x2 computed from fluxes in scratch, and added to update
+  if (fused_update) {
+    if (pmy_pack->pmesh->three_d) {
+      CalculateFluxesAndUpdate<rsolver_method_,3>(pdriver, stage);
+    } else if (pmy_pack->pmesh->multi_d) {
+      CalculateFluxesAndUpdate<rsolver_method_,2>(pdriver, stage);
+    } else {
+      CalculateFluxesAndUpdate<rsolver_method_,1>(pdriver, stage);
+    }
   }
 
   return;
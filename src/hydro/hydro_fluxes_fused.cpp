@@ -0,0 +1,353 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file hydro_fluxes_fused.cpp
+//! \brief Fused calculation of x1- and x2-fluxes and RK update for hydro.  Fluxes are
+//! computed in team scratch memory and the flux divergence is added directly to the
+//! conserved variables, so the x1f/x2f flux arrays are never written to or read from
+//! global memory.  Only used on uniform grids (no flux correction) with <hydro>/
+//! fused_update=true.  In 3D, the x3-fluxes are still computed in CalculateFluxes().
+
+#include <iostream>
+
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+#include "driver/driver.hpp"
+#include "coordinates/coordinates.hpp"
+#include "hydro.hpp"
+#include "eos/eos.hpp"
+#include "reconstruct/dc.hpp"
+#include "reconstruct/plm.hpp"
+#include "reconstruct/ppm.hpp"
+#include "reconstruct/wenoz.hpp"
+#include "reconstruct/jump_indicator.hpp"
+#include "hydro/rsolvers/advect_hyd.hpp"
+#include "hydro/rsolvers/llf_hyd.hpp"
+#include "hydro/rsolvers/hlle_hyd.hpp"
+#include "hydro/rsolvers/hllc_hyd.hpp"
+#include "hydro/rsolvers/roe_hyd.hpp"
+#include "hydro/rsolvers/llf_srhyd.hpp"
+#include "hydro/rsolvers/hlle_srhyd.hpp"
+#include "hydro/rsolvers/hllc_srhyd.hpp"
+#include "hydro/rsolvers/llf_grhyd.hpp"
+#include "hydro/rsolvers/hlle_grhyd.hpp"
+
+namespace hydro {
+//----------------------------------------------------------------------------------------
+//! \struct ScrFlux
+//! \brief wrapper around a 2D scratch array (n,i) indexed like the global flux arrays
+//! (m,n,k,j,i), so that Riemann solvers can return fluxes of a single row in scratch
+
+struct ScrFlux {
+  ScrArray2D<Real> flx;
+  KOKKOS_INLINE_FUNCTION
+  Real &operator()(const int m, const int n, const int k, const int j,
+                   const int i) const {
+    return flx(n,i);
+  }
+};
+
+//----------------------------------------------------------------------------------------
+//! \fn void RiemannSolver
+//! \brief Calls Riemann solver selected by template parameter
+
+template <Hydro_RSolver rsolver_method_>
+KOKKOS_INLINE_FUNCTION
+void RiemannSolver(TeamMember_t const &member, const EOS_Data &eos,
+     const RegionIndcs &indcs,const DualArray1D<RegionSize> &size,const CoordData &coord,
+     const int m, const int k, const int j, const int il, const int iu, const int ivx,
+     const ScrArray2D<Real> &wl, const ScrArray2D<Real> &wr, ScrFlux flx) {
+  if constexpr (rsolver_method_ == Hydro_RSolver::advect) {
+    Advect(member, eos, indcs, size, coord, m, k, j, il, iu, ivx, wl, wr, flx);
+  } else if constexpr (rsolver_method_ == Hydro_RSolver::llf) {
+    LLF(member, eos, indcs, size, coord, m, k, j, il, iu, ivx, wl, wr, flx);
+  } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle) {
+    HLLE(member, eos, indcs, size, coord, m, k, j, il, iu, ivx, wl, wr, flx);
+  } else if constexpr (rsolver_method_ == Hydro_RSolver::hllc) {
+    HLLC(member, eos, indcs, size, coord, m, k, j, il, iu, ivx, wl, wr, flx);
+  } else if constexpr (rsolver_method_ == Hydro_RSolver::roe) {
+    Roe(member, eos, indcs, size, coord, m, k, j, il, iu, ivx, wl, wr, flx);
+  } else if constexpr (rsolver_method_ == Hydro_RSolver::llf_sr) {
+    LLF_SR(member, eos, indcs, size, coord, m, k, j, il, iu, ivx, wl, wr, flx);
+  } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle_sr) {
+    HLLE_SR(member, eos, indcs, size, coord, m, k, j, il, iu, ivx, wl, wr, flx);
+  } else if constexpr (rsolver_method_ == Hydro_RSolver::hllc_sr) {
+    HLLC_SR(member, eos, indcs, size, coord, m, k, j, il, iu, ivx, wl, wr, flx);
+  } else if constexpr (rsolver_method_ == Hydro_RSolver::llf_gr) {
+    LLF_GR(member, eos, indcs, size, coord, m, k, j, il, iu, ivx, wl, wr, flx);
+  } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle_gr) {
+    HLLE_GR(member, eos, indcs, size, coord, m, k, j, il, iu, ivx, wl, wr, flx);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Hydro::CalculateFluxesAndUpdate
+//! \brief Computes x1- and x2-fluxes and performs the explicit RK update of u0 in a
+//! single kernel.  Each team sweeps in j over one (m,k) slice: at each j the x2-flux on
+//! face j is computed (reusing the reconstructed L-state from j-1 as in CalculateFluxes),
+//! then the x1-fluxes of row j-1 are computed, and row j-1 is updated using the x2-fluxes
+//! on faces j-1 and j kept in scratch.  Flux differences are summed in the same order as
+//! in RKUpdate(), so results are identical to the unfused path.  Also templated over the
+//! number of dimensions, so that 1D and 2D runs compile without the x2- or x3-terms.
+
+template <Hydro_RSolver rsolver_method_, int ndim_>
+void Hydro::CalculateFluxesAndUpdate(Driver *pdriver, int stage) {
+  RegionIndcs &indcs_ = pmy_pack->pmesh->mb_indcs;
+#if FIXED_MB_NX1 > 0
+  constexpr int is = FIXED_MB_IS, ie = FIXED_MB_IE;
+  constexpr int ncells1 = ScrRowLength(FIXED_MB_NCELLS1);
+#else
+  int is = indcs_.is, ie = indcs_.ie;
+  int ncells1 = ScrRowLength(indcs_.nx1 + 2*(indcs_.ng));
+#endif
+  int js = indcs_.js, je = indcs_.je;
+  int ks = indcs_.ks, ke = indcs_.ke;
+
+  int nhyd_  = nhydro;
+  int nvars = nhydro + nscalars;
+  int nrec = nvars - ndiag_scalars;  // variables reconstructed with recon_method
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  const auto recon_method_ = recon_method;
+  bool extrema = false;
+  if (recon_method == ReconstructionMethod::ppmx) {
+    extrema = true;
+  }
+
+  Real gam0 = pdriver->gam0[stage-1];
+  Real gam1 = pdriver->gam1[stage-1];
+  Real beta_dt = (pdriver->beta[stage-1])*(pmy_pack->pmesh->dt);
+
+  auto &eos_ = peos->eos_data;
+  auto &size_ = pmy_pack->pmb->mb_size;
+  auto &coord_ = pmy_pack->pcoord->coord_data;
+  auto &w0_ = w0;
+  auto &u0_ = u0;
+  auto &u1_ = u1;
+  auto &flx3_ = uflx.x3f;
+  // hybrid Riemann solver (see CalculateFluxes), rows are counted on the device
+  constexpr bool hybrid_rs = (rsolver_method_ == Hydro_RSolver::hllc ||
+                              rsolver_method_ == Hydro_RSolver::roe);
+  bool hybrid_ = rsolver_hybrid;
+  Real hybrid_tol_ = rsolver_hybrid_tol;
+  auto &nrow_ = rs_nrow;
+  // user source terms inlined in update (see pgen/user_hooks.hpp)
+  auto &srcs_hook = pmy_pack->pmesh->pgen->user_srcs_hook;
+  srcs_hook.Update(pmy_pack->pmesh);
+  auto user_src = srcs_hook;
+
+  // three arrays for reconstructed states, one for x1-fluxes, two for x2-fluxes (which
+  // are empty in 1D)
+  int nvars2 = (ndim_ > 1)? nvars : 0;
+  size_t scr_size = ScrArray2D<Real>::shmem_size(nvars, ncells1) * 4 +
+                    ScrArray2D<Real>::shmem_size(nvars2, ncells1) * 2;
+  int scr_level = 0;
+
+  // in 1D only the active rows are swept, otherwise start one row below to compute the
+  // L-state on face js
+  int jl = (ndim_ > 1)? js-1 : js;
+  int ju = (ndim_ > 1)? je+1 : je;
+
+  par_for_outer("hflux_fused",DevExeSpace(), scr_size, scr_level, 0, nmb1, ks, ke,
+  KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k) {
+    ScrArray2D<Real> scr1(member.team_scratch(scr_level), nvars, ncells1);
+    ScrArray2D<Real> scr2(member.team_scratch(scr_level), nvars, ncells1);
+    ScrArray2D<Real> scr3(member.team_scratch(scr_level), nvars, ncells1);
+    ScrArray2D<Real> flx1(member.team_scratch(scr_level), nvars, ncells1);
+    ScrArray2D<Real> scr4(member.team_scratch(scr_level), nvars2, ncells1);
+    ScrArray2D<Real> scr5(member.team_scratch(scr_level), nvars2, ncells1);
+
+    for (int j=jl; j<=ju; ++j) {
+      // Permute scratch arrays.
+      auto wl       = scr1;
+      auto wl_jp1   = scr2;
+      auto wr       = scr3;
+      auto flx2     = scr4;  // x2-fluxes on face j
+      auto flx2_jm1 = scr5;  // x2-fluxes on face j-1
+      if ((j%2) == 0) {
+        wl       = scr2;
+        wl_jp1   = scr1;
+        flx2     = scr5;
+        flx2_jm1 = scr4;
+      }
+
+      // row of cells updated in this iteration
+      int jrow = j;
+
+      if constexpr (ndim_ > 1) {
+        // Reconstruct qR[j] and qL[j+1]
+        switch (recon_method_) {
+          case ReconstructionMethod::dc:
+            DonorCellX2(member, m, k, j, is, ie, w0_, wl_jp1, wr);
+            break;
+          case ReconstructionMethod::plm:
+            PiecewiseLinearX2(member, m, k, j, is, ie, w0_, wl_jp1, wr, 0, nrec-1);
+            break;
+          case ReconstructionMethod::ppm4:
+          case ReconstructionMethod::ppmx:
+            PiecewiseParabolicX2(member,eos_,extrema,true,m,k,j,is,ie, w0_, wl_jp1, wr,
+                                 0, nrec-1);
+            break;
+          case ReconstructionMethod::wenoz:
+            WENOZX2(member, eos_, true, m, k, j, is, ie, w0_, wl_jp1, wr, 0, nrec-1);
+            break;
+          default:
+            break;
+        }
+        // diagnostic scalars (if any) are reconstructed with donor cell
+        if (nrec < nvars && recon_method_ != ReconstructionMethod::dc) {
+          DonorCellX2(member, m, k, j, is, ie, w0_, wl_jp1, wr, nrec);
+        }
+        member.team_barrier();
+
+        // compute x2-fluxes on face j over [is,ie]
+        if (j>jl) {
+          bool smooth = false;
+          if constexpr (hybrid_rs) {
+            if (hybrid_) {smooth = SmoothRow(member, eos_, is, ie, wl, wr, hybrid_tol_,
+                                             nrow_);}
+          }
+          if (smooth) {
+            HLLE(member, eos_, indcs_, size_, coord_, m, k, j, is, ie, IVY, wl, wr,
+                 ScrFlux{flx2});
+          } else {
+            RiemannSolver<rsolver_method_>(member, eos_, indcs_, size_, coord_, m, k, j,
+                                           is, ie, IVY, wl, wr, ScrFlux{flx2});
+          }
+          member.team_barrier();
+
+          // calculate fluxes of scalars (if any)
+          if (nvars > nhyd_) {
+            for (int n=nhyd_; n<nvars; ++n) {
+              par_for_inner(member, is, ie, [&](const int i) {
+                if (flx2(IDN,i) >= 0.0) {
+                  flx2(n,i) = flx2(IDN,i)*wl(n,i);
+                } else {
+                  flx2(n,i) = flx2(IDN,i)*wr(n,i);
+                }
+              });
+            }
+            member.team_barrier();
+          }
+        }
+        jrow = j-1;
+      }
+
+      if (jrow >= js) {
+        // Reconstruct qR[i] and qL[i+1] in row jrow.  Arrays wl and wr are no longer
+        // needed for x2-fluxes (wl is overwritten as wl_jp1 in next iteration).
+        switch (recon_method_) {
+          case ReconstructionMethod::dc:
+            DonorCellX1(member, m, k, jrow, is-1, ie+1, w0_, wl, wr);
+            break;
+          case ReconstructionMethod::plm:
+            PiecewiseLinearX1(member, m, k, jrow, is-1, ie+1, w0_, wl, wr, 0, nrec-1);
+            break;
+          case ReconstructionMethod::ppm4:
+          case ReconstructionMethod::ppmx:
+            PiecewiseParabolicX1(member,eos_,extrema,true,m,k,jrow,is-1,ie+1,w0_,wl,wr,
+                                 0, nrec-1);
+            break;
+          case ReconstructionMethod::wenoz:
+            WENOZX1(member, eos_, true, m, k, jrow, is-1, ie+1, w0_, wl, wr, 0, nrec-1);
+            break;
+          default:
+            break;
+        }
+        // diagnostic scalars (if any) are reconstructed with donor cell
+        if (nrec < nvars && recon_method_ != ReconstructionMethod::dc) {
+          DonorCellX1(member, m, k, jrow, is-1, ie+1, w0_, wl, wr, nrec);
+        }
+        member.team_barrier();
+
+        // compute x1-fluxes over [is,ie+1]
+        bool smooth = false;
+        if constexpr (hybrid_rs) {
+          if (hybrid_) {smooth = SmoothRow(member, eos_, is, ie+1, wl, wr, hybrid_tol_,
+                                           nrow_);}
+        }
+        if (smooth) {
+          HLLE(member, eos_, indcs_, size_, coord_, m, k, jrow, is, ie+1, IVX, wl, wr,
+               ScrFlux{flx1});
+        } else {
+          RiemannSolver<rsolver_method_>(member, eos_, indcs_, size_, coord_, m, k, jrow,
+                                         is, ie+1, IVX, wl, wr, ScrFlux{flx1});
+        }
+        member.team_barrier();
+
+        // calculate fluxes of scalars (if any)
+        if (nvars > nhyd_) {
+          for (int n=nhyd_; n<nvars; ++n) {
+            par_for_inner(member, is, ie+1, [&](const int i) {
+              if (flx1(IDN,i) >= 0.0) {
+                flx1(n,i) = flx1(IDN,i)*wl(n,i);
+              } else {
+                flx1(n,i) = flx1(IDN,i)*wr(n,i);
+              }
+            });
+          }
+          member.team_barrier();
+        }
+
+        // update conserved variables in row jrow using weights and fractional time step
+        // appropriate to stage of time-integrator.
+        // Fluxes must be summed in pairs to symmetrize round-off error in each dir
+        for (int n=0; n<nvars; ++n) {
+          par_for_inner(member, is, ie, [&](const int i) {
+            Real divf = (flx1(n,i+1) - flx1(n,i))/size_.d_view(m).dx1;
+            if constexpr (ndim_ > 1) {
+              divf += (flx2(n,i) - flx2_jm1(n,i))/size_.d_view(m).dx2;
+            }
+            if constexpr (ndim_ > 2) {
+              divf += (flx3_(m,n,k+1,jrow,i) - flx3_(m,n,k,jrow,i))/size_.d_view(m).dx3;
+            }
+            u0_(m,n,k,jrow,i) = gam0*u0_(m,n,k,jrow,i) + gam1*u1_(m,n,k,jrow,i)
+                                - beta_dt*divf;
+            if constexpr (user_hooks::SrcTerm::enabled) {
+              u0_(m,n,k,jrow,i) += beta_dt*user_src(m,n,k,jrow,i);
+            }
+          });
+        }
+        member.team_barrier();
+      }
+    } // end of loop over j
+  });
+
+  return;
+}
+
+// function definitions for each template parameter
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::advect,1>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::llf,1>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::hlle,1>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::hllc,1>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::roe,1>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::llf_sr,1>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::hlle_sr,1>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::hllc_sr,1>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::llf_gr,1>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::hlle_gr,1>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::advect,2>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::llf,2>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::hlle,2>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::hllc,2>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::roe,2>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::llf_sr,2>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::hlle_sr,2>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::hllc_sr,2>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::llf_gr,2>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::hlle_gr,2>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::advect,3>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::llf,3>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::hlle,3>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::hllc,3>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::roe,3>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::llf_sr,3>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::hlle_sr,3>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::hllc_sr,3>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::llf_gr,3>(Driver*, int);
+template void Hydro::CalculateFluxesAndUpdate<Hydro_RSolver::hlle_gr,3>(Driver*, int);
+
+} // namespace hydro
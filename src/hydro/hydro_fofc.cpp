@@ -13,6 +13,7 @@
 #include "coordinates/cartesian_ks.hpp"
 #include "coordinates/cell_locations.hpp"
 #include "eos/eos.hpp"
+#include "eos/eos_traits.hpp"
 #include "hydro/rsolvers/llf_hyd_singlestate.hpp"
 #include "hydro.hpp"
 
@@ -26,6 +27,11 @@ namespace hydro {
 //! Often this is enough to prevent floors from being needed. The FOFC infrastructure is
 //! also exploited for BH excision. If a cell is about the horizon, FOFC is automatically
 //! triggered (without estimating updated conserved variables).
+//!
+//! Since typically only a very small fraction of cells is flagged, the flagged cells are
+//! compacted into a list, and first-order fluxes are only computed for cells in the list.
+//! For non-relativistic hydrodynamics the estimate and the test for floors are computed
+//! in a single kernel without storing the estimate, see FOFCFlagCells().
 
 void Hydro::FOFC(Driver *pdriver, int stage) {
   auto &indcs = pmy_pack->pmesh->mb_indcs;
@@ -42,7 +48,15 @@ void Hydro::FOFC(Driver *pdriver, int stage) {
   auto flx3 = uflx.x3f;
   auto &size = pmy_pack->pmb->mb_size;
 
-  if (use_fofc) {
+  bool &is_sr = pmy_pack->pcoord->is_special_relativistic;
+  bool &is_gr = pmy_pack->pcoord->is_general_relativistic;
+  if (use_fofc && !(is_sr) && !(is_gr)) {
+    if (peos->eos_data.is_ideal) {
+      FOFCFlagCells<EOS_Type::ideal>(pdriver, stage);
+    } else {
+      FOFCFlagCells<EOS_Type::isothermal>(pdriver, stage);
+    }
+  } else if (use_fofc) {
     Real &gam0 = pdriver->gam0[stage-1];
     Real &gam1 = pdriver->gam1[stage-1];
     Real beta_dt = (pdriver->beta[stage-1])*(pmy_pack->pmesh->dt);
@@ -50,7 +64,13 @@ void Hydro::FOFC(Driver *pdriver, int stage) {
     int &nhyd_ = nhydro;
     auto &u0_ = u0;
     auto &u1_ = u1;
-    auto &utest_ = utest;
+    // estimate of updated variables is checked out of the scratch pool
+    int ncells1 = indcs.nx1 + 2*(indcs.ng);
+    int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
+    int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
+    auto utest = pmy_pack->pmesh->scratch.Checkout("utest", nmb, nhydro, ncells3,
+                                                   ncells2, ncells1);
+    auto &utest_ = utest.view;
 
     // Index bounds
     int il = is-1, iu = ie+1, jl = js, ju = je, kl = ks, ku = ke;
@@ -83,8 +103,6 @@ void Hydro::FOFC(Driver *pdriver, int stage) {
   }
 
   auto &coord = pmy_pack->pcoord->coord_data;
-  bool &is_sr = pmy_pack->pcoord->is_special_relativistic;
-  bool &is_gr = pmy_pack->pcoord->is_general_relativistic;
   auto &eos = peos->eos_data;
   auto &use_fofc_ = use_fofc;
   auto &fofc_ = fofc;
@@ -97,10 +115,44 @@ void Hydro::FOFC(Driver *pdriver, int stage) {
   if (multi_d) { jl = js-1, ju = je+1; }
   if (three_d) { kl = ks-1, ku = ke+1; }
 
-  // Now replace fluxes with first-order LLF fluxes for any cell where floors needed (if
-  // using FOFC) and/or for any cell about the excision (if GR+excising)
-  par_for("FOFC-flx", DevExeSpace(), 0, nmb-1, kl, ku, jl, ju, il, iu,
-  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+  // Compact list of cells where floors needed (if using FOFC) and/or about the excision
+  // (if GR+excising).  Cells are stored as index into (m,k,j,i) range of active cells
+  // and first layer of ghost cells.
+  const int ni = iu - il + 1;
+  const int nji = (ju - jl + 1)*ni;
+  const int nkji = (ku - kl + 1)*nji;
+  const int nmkji = nmb*nkji;
+  if (fofc_cells.extent_int(0) < nmkji) {
+    Kokkos::realloc(fofc_cells, nmkji);
+  }
+  auto &cells = fofc_cells;
+  bool excise = (is_gr && use_excise);
+  int ncells = 0;
+  Kokkos::parallel_scan("FOFC-list", Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
+  KOKKOS_LAMBDA(const int idx, int &partial, const bool final) {
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/ni;
+    int i = (idx - m*nkji - k*nji - j*ni) + il;
+    j += jl;
+    k += kl;
+    if ((use_fofc_ && fofc_(m,k,j,i)) || (excise && excision_flux_(m,k,j,i))) {
+      if (final) {cells(partial) = idx;}
+      partial++;
+    }
+  }, ncells);
+  if (ncells == 0) return;
+
+  // Now replace fluxes with first-order LLF fluxes for any cell in list
+  par_for("FOFC-flx", DevExeSpace(), 0, ncells-1,
+  KOKKOS_LAMBDA(const int n) {
+    int m = (cells(n))/nkji;
+    int k = (cells(n) - m*nkji)/nji;
+    int j = (cells(n) - m*nkji - k*nji)/ni;
+    int i = (cells(n) - m*nkji - k*nji - j*ni) + il;
+    j += jl;
+    k += kl;
+
     // Check for FOFC flag
     bool fofc_flag = false;
     if (use_fofc_) { fofc_flag = fofc_(m,k,j,i); }
@@ -368,4 +420,88 @@ void Hydro::FOFC(Driver *pdriver, int stage) {
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void Hydro::FOFCFlagCells
+//! \brief Estimates updated conserved variables and tests whether conversion to
+//! primitives requires floors in a single kernel, for non-relativistic hydrodynamics.
+//! Flags cells in the fofc array in the same way as ConsToPrim() with only_testfloors,
+//! but without storing the estimate in a full-size scratch array.
+
+template <EOS_Type eos_t_>
+void Hydro::FOFCFlagCells(Driver *pdriver, int stage) {
+  using EOS = HydEOSTraits<eos_t_>;
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  int nmb = pmy_pack->nmb_thispack;
+
+  Real &gam0 = pdriver->gam0[stage-1];
+  Real &gam1 = pdriver->gam1[stage-1];
+  Real beta_dt = (pdriver->beta[stage-1])*(pmy_pack->pmesh->dt);
+  auto &u0_ = u0;
+  auto &u1_ = u1;
+  auto flx1 = uflx.x1f;
+  auto flx2 = uflx.x2f;
+  auto flx3 = uflx.x3f;
+  auto &size = pmy_pack->pmb->mb_size;
+  auto &eos = peos->eos_data;
+  auto &fofc_ = fofc;
+
+  // Index bounds
+  int il = indcs.is-1, iu = indcs.ie+1, jl = indcs.js, ju = indcs.je;
+  int kl = indcs.ks, ku = indcs.ke;
+  if (multi_d) { jl = indcs.js-1, ju = indcs.je+1; }
+  if (three_d) { kl = indcs.ks-1, ku = indcs.ke+1; }
+
+  const int ni   = (iu - il + 1);
+  const int nji  = (ju - jl + 1)*ni;
+  const int nkji = (ku - kl + 1)*nji;
+  const int nmkji = nmb*nkji;
+
+  int nflag = 0;
+  Kokkos::parallel_reduce("FOFC-flag",Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
+  KOKKOS_LAMBDA(const int &idx, int &sum) {
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/ni;
+    int i = (idx - m*nkji - k*nji - j*ni) + il;
+    j += jl;
+    k += kl;
+    Real dtodx1 = beta_dt/size.d_view(m).dx1;
+    Real dtodx2 = beta_dt/size.d_view(m).dx2;
+    Real dtodx3 = beta_dt/size.d_view(m).dx3;
+
+    // Estimate conserved variables
+    Real ut[5];
+    for (int n=0; n<(EOS::has_energy? 5 : 4); ++n) {
+      Real divf = dtodx1*(flx1(m,n,k,j,i+1) - flx1(m,n,k,j,i));
+      if (multi_d) {
+        divf += dtodx2*(flx2(m,n,k,j+1,i) - flx2(m,n,k,j,i));
+      }
+      if (three_d) {
+        divf += dtodx3*(flx3(m,n,k+1,j,i) - flx3(m,n,k,j,i));
+      }
+      ut[n] = gam0*u0_(m,n,k,j,i) + gam1*u1_(m,n,k,j,i) - divf;
+    }
+    HydCons1D u;
+    u.d  = ut[IDN];
+    u.mx = ut[IM1];
+    u.my = ut[IM2];
+    u.mz = ut[IM3];
+    if constexpr (EOS::has_energy) {u.e = ut[IEN];}
+
+    // Test whether conversion to primitives requires floors
+    HydPrim1D w;
+    bool dfloor_used=false, efloor_used=false, tfloor_used=false;
+    EOS::C2P(u, eos, w, dfloor_used, efloor_used, tfloor_used);
+    if (dfloor_used || efloor_used || tfloor_used) {
+      fofc_(m,k,j,i) = true;
+      sum++;
+    }
+  }, Kokkos::Sum<int>(nflag));
+  pmy_pack->pmesh->ecounter.nfofc += nflag;
+
+  return;
+}
+
 } // namespace hydro
@@ -17,6 +17,8 @@
 #include "driver/driver.hpp"
 #include "eos/eos.hpp"
 #include "hydro.hpp"
+#include "coordinates/coordinates.hpp"
+#include "coordinates/spherical_polar.hpp"
 #include "diffusion/conduction.hpp"
 #include "srcterms/srcterms.hpp"
 
@@ -47,11 +49,14 @@ TaskStatus Hydro::NewTimeStep(Driver *pdrive, int stage) {
   auto &is_special_relativistic_ = pmy_pack->pcoord->is_special_relativistic;
   auto &is_general_relativistic_ = pmy_pack->pcoord->is_general_relativistic;
   auto &is_dynamical_relativistic_ = pmy_pack->pcoord->is_dynamical_relativistic;
+  bool sph_polar = pmy_pack->pcoord->is_spherical_polar;
   const int nmkji = (pmy_pack->nmb_thispack)*nx3*nx2*nx1;
   const int nkji = nx3*nx2*nx1;
   const int nji  = nx2*nx1;
 
-  if (pdrive->time_evolution == TimeEvolution::kinematic) {
+  if (dtnew_computed) {
+    // dtnew already computed in RKUpdateAndConToPrim() during the last stage
+  } else if (pdrive->time_evolution == TimeEvolution::kinematic) {
     // find smallest (dx/v) in each direction for advection problems
     Kokkos::parallel_reduce("HydroNudt1",Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
     KOKKOS_LAMBDA(const int &idx, Real &min_dt1, Real &min_dt2, Real &min_dt3) {
@@ -112,16 +117,32 @@ TaskStatus Hydro::NewTimeStep(Driver *pdrive, int stage) {
         max_dv2 = fabs(w0_(m,IVY,k,j,i)) + cs;
         max_dv3 = fabs(w0_(m,IVZ,k,j,i)) + cs;
       }
-      min_dt1 = fmin((mbsize.d_view(m).dx1/max_dv1), min_dt1);
-      min_dt2 = fmin((mbsize.d_view(m).dx2/max_dv2), min_dt2);
-      min_dt3 = fmin((mbsize.d_view(m).dx3/max_dv3), min_dt3);
+      Real dx1 = mbsize.d_view(m).dx1;
+      Real dx2 = mbsize.d_view(m).dx2;
+      Real dx3 = mbsize.d_view(m).dx3;
+      // in spherical-polar coordinates use physical widths of the cell (x1 = ln r)
+      if (sph_polar) {
+        Real rm, rp, vol1;
+        SphPolarRadialFactors(i-is, nx1, mbsize.d_view(m).x1min, mbsize.d_view(m).x1max,
+                              rm, rp, vol1);
+        Real th = CellCenterX(j-js, nx2, mbsize.d_view(m).x2min, mbsize.d_view(m).x2max);
+        dx1 = rp - rm;
+        dx2 *= 0.5*(rm + rp);
+        dx3 *= 0.5*(rm + rp)*fabs(sin(th));
+      }
+      min_dt1 = fmin((dx1/max_dv1), min_dt1);
+      min_dt2 = fmin((dx2/max_dv2), min_dt2);
+      min_dt3 = fmin((dx3/max_dv3), min_dt3);
     }, Kokkos::Min<Real>(dt1), Kokkos::Min<Real>(dt2),Kokkos::Min<Real>(dt3));
   }
 
   // compute minimum of dt1/dt2/dt3 for 1D/2D/3D problems
-  dtnew = dt1;
-  if (pmy_pack->pmesh->multi_d) { dtnew = std::min(dtnew, dt2); }
-  if (pmy_pack->pmesh->three_d) { dtnew = std::min(dtnew, dt3); }
+  if (!(dtnew_computed)) {
+    dtnew = dt1;
+    if (pmy_pack->pmesh->multi_d) { dtnew = std::min(dtnew, dt2); }
+    if (pmy_pack->pmesh->three_d) { dtnew = std::min(dtnew, dt3); }
+  }
+  dtnew_computed = false;
 
   // compute timestep for diffusion
   if (pcond != nullptr) {
@@ -0,0 +1,114 @@
+//========================================================================================
+// AthenaK astrophysical fluid dynamics and numerical relativity code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file hydro_sts.cpp
+//! \brief Implements super-time-stepping (STS) of the viscous and heat fluxes in Hydro
+//! with the second-order Runge-Kutta-Legendre (RKL2) method of Meyer, Balsara & Aslam
+//! (2014, JCP 257, 594).  The diffusion terms are operator split from the rest of the
+//! time integrator and advanced over the full timestep dt in s stages, each of which is
+//! stable for dt <= dt_diff*(s^2+s-2)/4, where dt_diff is the explicit diffusion limit.
+//! Each stage is a "sts" TaskList run by the Driver, and exchanges boundary values.
+
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+#include "driver/driver.hpp"
+#include "eos/eos.hpp"
+#include "diffusion/viscosity.hpp"
+#include "diffusion/conduction.hpp"
+#include "hydro.hpp"
+
+namespace hydro {
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus Hydro::STSFluxes
+//! \brief Computes only the viscous and heat fluxes of conserved variables from the
+//! current primitives.
+
+TaskStatus Hydro::STSFluxes(Driver *pdrive, int stage) {
+  Kokkos::deep_copy(DevExeSpace(), uflx.x1f, 0.0);
+  if (pmy_pack->pmesh->multi_d) {Kokkos::deep_copy(DevExeSpace(), uflx.x2f, 0.0);}
+  if (pmy_pack->pmesh->three_d) {Kokkos::deep_copy(DevExeSpace(), uflx.x3f, 0.0);}
+
+  if (pvisc != nullptr) {
+    pvisc->IsotropicViscousFlux(w0, pvisc->nu, peos->eos_data, uflx);
+  }
+  if (pcond != nullptr && !(pcond->implicit)) {
+    pcond->AddHeatFlux(w0, peos->eos_data, uflx);
+  }
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus Hydro::STSUpdate
+//! \brief RKL2 update of conserved variables in stage j of s stages, where with
+//! L(Y) = -div(F) the diffusive flux divergence:
+//!   Y_1 = Y_0 + mu~_1 dt L(Y_0)
+//!   Y_j = mu_j Y_{j-1} + nu_j Y_{j-2} + (1-mu_j-nu_j) Y_0 + mu~_j dt L(Y_{j-1})
+//!         + gamma~_j dt L(Y_0)
+//! Y_0 and dt L(Y_0) are saved in the first stage, and Y_{j-2} is kept in u_sts1.
+
+TaskStatus Hydro::STSUpdate(Driver *pdrive, int stage) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  int nvar = nhydro + nscalars;
+
+  // RKL2 coefficients, with b_j = (j^2+j-2)/(2j(j+1)) and b_0 = b_1 = b_2 = 1/3
+  int s = pdrive->nsts_stages;
+  auto bj = [](int jj) {
+    return (jj < 3)? (1.0/3.0) : static_cast<Real>(jj*jj + jj - 2)/(2.0*jj*(jj + 1));
+  };
+  Real w1 = 4.0/static_cast<Real>(s*s + s - 2);
+  Real mu = 0.0, nu = 0.0, mut = bj(1)*w1, gamt = 0.0;
+  if (stage > 1) {
+    mu = (2.0*stage - 1.0)/stage*bj(stage)/bj(stage-1);
+    nu = -(stage - 1.0)/stage*bj(stage)/bj(stage-2);
+    mut = mu*w1;
+    gamt = -(1.0 - bj(stage-1))*mut;
+  }
+  Real dt = pmy_pack->pmesh->dt;
+  bool first_stage = (stage == 1);
+
+  auto u0_ = u0;
+  auto y0_ = u_sts0;
+  auto y2_ = u_sts1;
+  auto ly0_ = lu_sts0;
+  auto flx1 = uflx.x1f;
+  auto flx2 = uflx.x2f;
+  auto flx3 = uflx.x3f;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+
+  par_for("h_sts_update",DevExeSpace(),0,nmb1,0,nvar-1,ks,ke,js,je,is,ie,
+  KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
+    // dt*L(Y_{j-1}), with fluxes summed in pairs in each direction as in RKUpdate
+    Real divf = (flx1(m,n,k,j,i+1) - flx1(m,n,k,j,i))/mbsize.d_view(m).dx1;
+    if (multi_d) {
+      divf += (flx2(m,n,k,j+1,i) - flx2(m,n,k,j,i))/mbsize.d_view(m).dx2;
+    }
+    if (three_d) {
+      divf += (flx3(m,n,k+1,j,i) - flx3(m,n,k,j,i))/mbsize.d_view(m).dx3;
+    }
+    Real dtl = -dt*divf;
+
+    Real y1 = u0_(m,n,k,j,i);
+    if (first_stage) {
+      y0_(m,n,k,j,i) = y1;
+      y2_(m,n,k,j,i) = y1;
+      ly0_(m,n,k,j,i) = dtl;
+      u0_(m,n,k,j,i) = y1 + mut*dtl;
+    } else {
+      Real y0 = y0_(m,n,k,j,i);
+      u0_(m,n,k,j,i) = mu*y1 + nu*y2_(m,n,k,j,i) + (1.0 - mu - nu)*y0 + mut*dtl
+                     + gamt*ly0_(m,n,k,j,i);
+      y2_(m,n,k,j,i) = y1;
+    }
+  });
+  return TaskStatus::complete;
+}
+
+} // namespace hydro
@@ -24,6 +24,7 @@
 #include "bvals/bvals.hpp"
 #include "shearing_box/shearing_box.hpp"
 #include "hydro/hydro.hpp"
+#include "utils/managed_memory.hpp"
 
 namespace hydro {
 //----------------------------------------------------------------------------------------
@@ -43,10 +44,21 @@ namespace hydro {
 //!
 //! In addition there are "before_timeintegrator" and "after_timeintegrator" task lists
 //! in the tl map, which are generally used for operator split tasks.
+//!
+//! With super-time-stepping, "before_sts", "sts" and "after_sts" task lists are run for
+//! each stage of the RKL2 integration of viscosity and conduction, before the time
+//! integrator.  Not compatible with shearing box, so the orbital advection and shearing
+//! box tasks in InitRecv, ClearSend and ClearRecv are never executed from these lists.
 
 void Hydro::AssembleHydroTasks(std::map<std::string, std::shared_ptr<TaskList>> tl) {
   TaskID none(0);
 
+  // assemble "before_timeintegrator" task list
+  if (pcond != nullptr && pcond->implicit) {
+    id.impcond = tl["before_timeintegrator"]->AddTask(&Hydro::ImplicitConduction, this,
+                                                      none);
+  }
+
   // assemble "before_stagen" task list
   id.irecv = tl["before_stagen"]->AddTask(&Hydro::InitRecv, this, none);
 
@@ -66,8 +78,27 @@ void Hydro::AssembleHydroTasks(std::map<std::string, std::shared_ptr<TaskList>>
   id.recvu_shr = tl["stagen"]->AddTask(&Hydro::RecvU_Shr, this, id.sendu_shr);
   id.bcs       = tl["stagen"]->AddTask(&Hydro::ApplyPhysicalBCs, this, id.recvu_shr);
   id.prol      = tl["stagen"]->AddTask(&Hydro::Prolongate, this, id.bcs);
-  id.c2p       = tl["stagen"]->AddTask(&Hydro::ConToPrim, this, id.prol);
-  id.newdt     = tl["stagen"]->AddTask(&Hydro::NewTimeStep, this, id.c2p);
+  if (fused_c2p) {
+    // ConsToPrim (and new timestep) in active cells already computed in RKUpdate, only
+    // ghost zones wait for RecvU
+    id.newdt   = tl["stagen"]->AddTask(&Hydro::NewTimeStep, this, id.srctrms);
+    id.c2p     = tl["stagen"]->AddTask(&Hydro::ConToPrimGhosts, this,
+                                       (id.prol|id.srctrms));
+  } else if (overlap_comm) {
+    // ConsToPrim (and new timestep) in active cells proceeds while boundary values are
+    // in flight, only ghost zones wait for RecvU
+    id.c2pa    = tl["stagen"]->AddTask(&Hydro::ConToPrimActive, this, id.sendu);
+    id.newdt   = tl["stagen"]->AddTask(&Hydro::NewTimeStep, this, id.c2pa);
+    id.c2p     = tl["stagen"]->AddTask(&Hydro::ConToPrimGhosts, this, (id.prol|id.c2pa));
+    tl["stagen"]->SetLBTimed(id.c2pa);
+  } else {
+    id.c2p     = tl["stagen"]->AddTask(&Hydro::ConToPrim, this, id.prol);
+    id.newdt   = tl["stagen"]->AddTask(&Hydro::NewTimeStep, this, id.c2p);
+  }
+  // flag compute-intensive tasks to be timed for automatic load balancing
+  for (auto tid : {id.flux, id.rkupdt, id.srctrms, id.c2p}) {
+    tl["stagen"]->SetLBTimed(tid);
+  }
 
   // assemble "after_stagen" task list
   id.csend = tl["after_stagen"]->AddTask(&Hydro::ClearSend, this, none);
@@ -75,6 +106,25 @@ void Hydro::AssembleHydroTasks(std::map<std::string, std::shared_ptr<TaskList>>
   // task list anyways to catch potential bugs in MPI communication logic
   id.crecv = tl["after_stagen"]->AddTask(&Hydro::ClearRecv, this, id.csend);
 
+  // assemble super-time-stepping task lists
+  if (use_sts) {
+    id.sts_irecv = tl["before_sts"]->AddTask(&Hydro::InitRecv, this, none);
+
+    id.sts_flux  = tl["sts"]->AddTask(&Hydro::STSFluxes, this, none);
+    id.sts_sendf = tl["sts"]->AddTask(&Hydro::SendFlux, this, id.sts_flux);
+    id.sts_recvf = tl["sts"]->AddTask(&Hydro::RecvFlux, this, id.sts_sendf);
+    id.sts_updt  = tl["sts"]->AddTask(&Hydro::STSUpdate, this, id.sts_recvf);
+    id.sts_restu = tl["sts"]->AddTask(&Hydro::RestrictU, this, id.sts_updt);
+    id.sts_sendu = tl["sts"]->AddTask(&Hydro::SendU, this, id.sts_restu);
+    id.sts_recvu = tl["sts"]->AddTask(&Hydro::RecvU, this, id.sts_sendu);
+    id.sts_bcs   = tl["sts"]->AddTask(&Hydro::ApplyPhysicalBCs, this, id.sts_recvu);
+    id.sts_prol  = tl["sts"]->AddTask(&Hydro::Prolongate, this, id.sts_bcs);
+    id.sts_c2p   = tl["sts"]->AddTask(&Hydro::ConToPrim, this, id.sts_prol);
+
+    id.sts_csend = tl["after_sts"]->AddTask(&Hydro::ClearSend, this, none);
+    id.sts_crecv = tl["after_sts"]->AddTask(&Hydro::ClearRecv, this, id.sts_csend);
+  }
+
   return;
 }
 
@@ -84,8 +134,24 @@ void Hydro::AssembleHydroTasks(std::map<std::string, std::shared_ptr<TaskList>>
 //! initialize all boundary receive status flags to waiting (with or without MPI).
 
 TaskStatus Hydro::InitRecv(Driver *pdrive, int stage) {
+  // with deep_halo ghost zones are only exchanged after the last stage
+  if (DeepHaloExtent(pdrive, stage) > 0) return TaskStatus::complete;
+
+  // with exchange_faces_only, edges and corners are skipped in all stages of the RK
+  // integrator, but are exchanged in Driver::Initialize (stage<0)
+  pbval_u->faces_only = (faces_only_exchange && stage > 0);
+
+  // with fixed_flow, only passive scalars are exchanged in all stages of the RK
+  // integrator, but hydro variables are exchanged in Driver::Initialize (stage<0)
+  pbval_u->var_start = (fixed_flow && stage > 0)? nhydro : 0;
+
+  // coarse arrays used in prolongation may have been evicted from device memory
+  if (pmy_pack->pmesh->multilevel) {
+    ManagedMemory::Prefetch(coarse_u0);
+  }
+
   // post receives for U
-  TaskStatus tstat = pbval_u->InitRecv(nhydro+nscalars);
+  TaskStatus tstat = pbval_u->InitRecv(nhydro+nscalars-(pbval_u->var_start));
   if (tstat != TaskStatus::complete) return tstat;
 
   // with SMR/AMR post receives for fluxes of U
@@ -127,18 +193,21 @@ TaskStatus Hydro::CopyCons(Driver *pdrive, int stage) {
   if (stage == 1) {
     Kokkos::deep_copy(DevExeSpace(), u1, u0);
   } else {
-    if (pdrive->integrator == "rk4") {
-      // parallel loop to update u1 with u0 at later stages, only for rk4
+    if (pdrive->use_delta) {
+      // parallel loop to update u1 with u0 at later stages, only for 2S integrators
       auto &indcs = pmy_pack->pmesh->mb_indcs;
-      int is = indcs.is, ie = indcs.ie;
+      int e = DeepHaloExtent(pdrive, stage);
+      int is = indcs.is - e, ie = indcs.ie + e;
       int js = indcs.js, je = indcs.je;
       int ks = indcs.ks, ke = indcs.ke;
+      if (pmy_pack->pmesh->multi_d) {js -= e; je += e;}
+      if (pmy_pack->pmesh->three_d) {ks -= e; ke += e;}
       int nmb1 = pmy_pack->nmb_thispack - 1;
       int nvar = nhydro + nscalars;
       auto &u0 = pmy_pack->phydro->u0;
       auto &u1 = pmy_pack->phydro->u1;
       Real &delta = pdrive->delta[stage-1];
-      par_for("rk4_copy_cons", DevExeSpace(),0, nmb1, 0, nvar-1, ks, ke, js, je, is, ie,
+      par_for("2s_copy_cons", DevExeSpace(),0, nmb1, 0, nvar-1, ks, ke, js, je, is, ie,
       KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
         u1(m,n,k,j,i) += delta*u0(m,n,k,j,i);
       });
@@ -176,11 +245,11 @@ TaskStatus Hydro::Fluxes(Driver *pdrive, int stage) {
     CalculateFluxes<Hydro_RSolver::hlle_gr>(pdrive, stage);
   }
 
-  // Add viscous, heat-flux, etc fluxes
-  if (pvisc != nullptr) {
+  // Add viscous, heat-flux, etc fluxes (unless integrated separately with STS)
+  if (pvisc != nullptr && !(use_sts)) {
     pvisc->IsotropicViscousFlux(w0, pvisc->nu, peos->eos_data, uflx);
   }
-  if (pcond != nullptr) {
+  if (pcond != nullptr && !(use_sts) && !(pcond->implicit)) {
     pcond->AddHeatFlux(w0, peos->eos_data, uflx);
   }
 
@@ -243,10 +312,22 @@ TaskStatus Hydro::HydroSrcTerms(Driver *pdrive, int stage) {
   if (pmy_pack->pcoord->is_general_relativistic) {
     pmy_pack->pcoord->CoordSrcTerms(w0, peos->eos_data, beta_dt, u0);
   }
+  // Geometric source terms in spherical-polar coordinates also use fluxes of this stage
+  if (pmy_pack->pcoord->is_spherical_polar) {
+    pmy_pack->pcoord->SphericalPolarSrcTerms(w0, uflx, peos->eos_data, beta_dt, u0);
+  }
 
   // Add user source terms
   if (pmy_pack->pmesh->pgen->user_srcs) {
+    if (deep_halo) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<hydro>/deep_halo cannot be used with user source terms"
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
     (pmy_pack->pmesh->pgen->user_srcs_func)(pmy_pack->pmesh, beta_dt);
+    // with fused_c2p, ConsToPrim in active cells was deferred to here by RKUpdate
+    if (fused_c2p) {ConToPrimActive(pdrive, stage);}
   }
 
   return TaskStatus::complete;
@@ -299,6 +380,7 @@ TaskStatus Hydro::RestrictU(Driver *pdrive, int stage) {
 //! \brief Wrapper task list function to pack/send cell-centered conserved variables
 
 TaskStatus Hydro::SendU(Driver *pdrive, int stage) {
+  if (DeepHaloExtent(pdrive, stage) > 0) return TaskStatus::complete;
   TaskStatus tstat = pbval_u->PackAndSendCC(u0, coarse_u0);
   return tstat;
 }
@@ -308,6 +390,7 @@ TaskStatus Hydro::SendU(Driver *pdrive, int stage) {
 //! \brief Wrapper task list function to receive/unpack cell-centered conserved variables
 
 TaskStatus Hydro::RecvU(Driver *pdrive, int stage) {
+  if (DeepHaloExtent(pdrive, stage) > 0) return TaskStatus::complete;
   TaskStatus tstat = pbval_u->RecvAndUnpackCC(u0, coarse_u0);
   return tstat;
 }
@@ -351,8 +434,10 @@ TaskStatus Hydro::ApplyPhysicalBCs(Driver *pdrive, int stage) {
   pbval_u->HydroBCs((pmy_pack), (pbval_u->u_in), u0);
 
   // user BCs
-  if (pmy_pack->pmesh->pgen->user_bcs) {
-    (pmy_pack->pmesh->pgen->user_bcs_func)(pmy_pack->pmesh);
+  // user BCs may instead be defined as a device hook applied in HydroBCs()
+  auto &pgen = pmy_pack->pmesh->pgen;
+  if (pgen->user_bcs && pgen->user_bcs_func != nullptr) {
+    (pgen->user_bcs_func)(pmy_pack->pmesh);
   }
   return TaskStatus::complete;
 }
@@ -366,9 +451,7 @@ TaskStatus Hydro::Prolongate(Driver *pdrive, int stage) {
   if (pmy_pack->pmesh->multilevel) {  // only prolongate with SMR/AMR
     pbval_u->FillCoarseInBndryCC(u0, coarse_u0);
     if (pmy_pack->pmesh->pmr->prolong_prims) {
-      pbval_u->ConsToPrimCoarseBndry(coarse_u0, coarse_w0);
-      pbval_u->ProlongateCC(w0, coarse_w0);
-      pbval_u->PrimToConsFineBndry(w0, u0);
+      pbval_u->ProlongatePrimsCC(coarse_u0, w0, u0);
     } else {
       pbval_u->ProlongateCC(u0, coarse_u0);
     }
@@ -378,18 +461,82 @@ TaskStatus Hydro::Prolongate(Driver *pdrive, int stage) {
 
 //----------------------------------------------------------------------------------------
 //! \fn TaskList Hydro::ConToPrim
-//! \brief Wrapper task list function to call ConsToPrim over entire mesh (including gz)
+//! \brief Wrapper task list function to call ConsToPrim over active cells and the nghost
+//! ghost cells exchanged with neighbors (others may not be filled with <hydro>/nghost)
 
 TaskStatus Hydro::ConToPrim(Driver *pdrive, int stage) {
   auto &indcs = pmy_pack->pmesh->mb_indcs;
-  int &ng = indcs.ng;
-  int n1m1 = indcs.nx1 + 2*ng - 1;
-  int n2m1 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng - 1) : 0;
-  int n3m1 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng - 1) : 0;
-  peos->ConsToPrim(u0, w0, false, 0, n1m1, 0, n2m1, 0, n3m1);
+  int il = indcs.is - nghost, iu = indcs.ie + nghost;
+  int jl = indcs.js, ju = indcs.je, kl = indcs.ks, ku = indcs.ke;
+  if (indcs.nx2 > 1) {jl -= nghost; ju += nghost;}
+  if (indcs.nx3 > 1) {kl -= nghost; ku += nghost;}
+  peos->ConsToPrim(u0, w0, false, il, iu, jl, ju, kl, ku);
   return TaskStatus::complete;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn TaskList Hydro::ConToPrimActive
+//! \brief Wrapper task list function to call ConsToPrim over active cells only.  Used
+//! with overlap_comm=true, in which case it runs while communication of ghost zones is in
+//! flight.  Active cells are not changed by any task after SendU.
+
+TaskStatus Hydro::ConToPrimActive(Driver *pdrive, int stage) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  peos->ConsToPrim(u0, w0, false, indcs.is, indcs.ie, indcs.js, indcs.je,
+                   indcs.ks, indcs.ke);
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskList Hydro::ConToPrimGhosts
+//! \brief Wrapper task list function to call ConsToPrim over ghost zones only, once
+//! boundary values have been received.  Used with overlap_comm=true.
+
+TaskStatus Hydro::ConToPrimGhosts(Driver *pdrive, int stage) {
+  int slab[6][6];
+  int nslab = GhostZoneSlabs(pmy_pack->pmesh->mb_indcs, slab, nghost);
+  for (int n=0; n<nslab; ++n) {
+    peos->ConsToPrim(u0, w0, false, slab[n][0], slab[n][1], slab[n][2], slab[n][3],
+                     slab[n][4], slab[n][5]);
+  }
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool Hydro::FuseConToPrim
+//! \brief Returns true if RKUpdate, ConsToPrim and new timestep in active cells are to be
+//! computed in one kernel.  With user source terms u0 still changes after RKUpdate, so
+//! the separate ConsToPrim and timestep are used instead.
+
+bool Hydro::FuseConToPrim() const {
+  return (fused_c2p && !(pmy_pack->pmesh->pgen->user_srcs));
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn int Hydro::DeepHaloExtent
+//! \brief Returns number of ghost cells in each direction over which fluxes and the RK
+//! update are computed at the given stage with deep_halo.  Each stage invalidates
+//! deep_halo_width ghost cells, so the extent shrinks to zero in the last stage, after
+//! which the ghost zones are exchanged.  Zero is returned for stages outside the RK
+//! integrator (e.g. stage<=0 in Driver::Initialize), and when deep_halo is not used.
+
+int Hydro::DeepHaloExtent(Driver *pdrive, int stage) const {
+  if (!(deep_halo) || (stage <= 0) || (stage > pdrive->nexp_stages)) return 0;
+  return (pdrive->nexp_stages - stage)*deep_halo_width;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskList Hydro::ImplicitConduction
+//! \brief Wrapper task list function for operator split implicit thermal conduction over
+//! the full timestep.  Conduction updates internal energy in active cells and at
+//! MeshBlock boundaries, so only physical BCs and ConsToPrim are needed afterwards.
+
+TaskStatus Hydro::ImplicitConduction(Driver *pdrive, int stage) {
+  pcond->ImplicitUpdate(w0, u0, peos->eos_data, pmy_pack->pmesh->dt);
+  (void) ApplyPhysicalBCs(pdrive, stage);
+  return ConToPrim(pdrive, stage);
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn TaskList Hydro::ClearSend
 //! \brief Wrapper task list function that checks all MPI sends have completed. Used in
@@ -400,6 +547,7 @@ TaskStatus Hydro::ConToPrim(Driver *pdrive, int stage) {
 //! If stage=(-4):              clears sends of                 U_Shr
 
 TaskStatus Hydro::ClearSend(Driver *pdrive, int stage) {
+  if (DeepHaloExtent(pdrive, stage) > 0) return TaskStatus::complete;
   TaskStatus tstat;
   // check sends of U complete
   if ((stage >= 0) || (stage == -1)) {
@@ -443,6 +591,7 @@ TaskStatus Hydro::ClearSend(Driver *pdrive, int stage) {
 //! If stage=(-4):              clears recvs of                 U_Shr
 
 TaskStatus Hydro::ClearRecv(Driver *pdrive, int stage) {
+  if (DeepHaloExtent(pdrive, stage) > 0) return TaskStatus::complete;
   TaskStatus tstat;
   // check receives of U complete
   if ((stage >= 0) || (stage == -1)) {
@@ -7,12 +7,18 @@
 //! \brief Performs explicit update of Hydro conserved variables (u0) for each stage of
 //! the SSP RK integrators (e.g. RK1, RK2, RK3) implemented in AthenaK, using weighted
 //! average and partial time step update of flux divergence. Source terms are added in
-//! the HydroSrcTerms() function.
+//! the HydroSrcTerms() function, except for user source terms defined as a device hook
+//! (see pgen/user_hooks.hpp), which are added in the update kernels.
+
+#include <limits>
 
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
 #include "driver/driver.hpp"
 #include "eos/eos.hpp"
+#include "eos/eos_traits.hpp"
+#include "coordinates/coordinates.hpp"
+#include "coordinates/spherical_polar.hpp"
 #include "hydro.hpp"
 
 namespace hydro {
@@ -21,25 +27,53 @@ namespace hydro {
 //  \brief Explicit RK update including flux divergence terms
 
 TaskStatus Hydro::RKUpdate(Driver *pdriver, int stage) {
+  // update already performed in CalculateFluxesAndUpdate() with fused kernel
+  if (fused_update) {return TaskStatus::complete;}
+  // update, ConsToPrim and timestep in active cells all computed in one kernel
+  if (FuseConToPrim()) {
+    if (peos->eos_data.is_ideal) {
+      return RKUpdateAndConToPrim<EOS_Type::ideal>(pdriver, stage);
+    }
+    return RKUpdateAndConToPrim<EOS_Type::isothermal>(pdriver, stage);
+  }
+
   auto &indcs = pmy_pack->pmesh->mb_indcs;
+#if FIXED_MB_NX1 > 0
+  constexpr int is = FIXED_MB_IS, ie = FIXED_MB_IE;
+  constexpr int ncells1 = FIXED_MB_NCELLS1;
+#else
   int is = indcs.is, ie = indcs.ie;
+  int ncells1 = indcs.nx1 + 2*(indcs.ng);
+#endif
   int js = indcs.js, je = indcs.je;
   int ks = indcs.ks, ke = indcs.ke;
-  int ncells1 = indcs.nx1 + 2*(indcs.ng);
   bool &multi_d = pmy_pack->pmesh->multi_d;
   bool &three_d = pmy_pack->pmesh->three_d;
 
+  // with deep_halo, update in earlier stages also includes ghost zones
+  int e = DeepHaloExtent(pdriver, stage);
+  int il = is-e, iu = ie+e;
+  int jl = (multi_d)? js-e : js, ju = (multi_d)? je+e : je;
+  int kl = (three_d)? ks-e : ks, ku = (three_d)? ke+e : ke;
+
   Real &gam0 = pdriver->gam0[stage-1];
   Real &gam1 = pdriver->gam1[stage-1];
   Real beta_dt = (pdriver->beta[stage-1])*(pmy_pack->pmesh->dt);
   int nmb1 = pmy_pack->nmb_thispack - 1;
   int nvar = nhydro + nscalars;
+  // with fixed_flow, only passive scalars are updated
+  int nv0 = (fixed_flow)? nhydro : 0;
   auto u0_ = u0;
   auto u1_ = u1;
   auto flx1 = uflx.x1f;
   auto flx2 = uflx.x2f;
   auto flx3 = uflx.x3f;
   auto &mbsize = pmy_pack->pmb->mb_size;
+  bool sph_polar = pmy_pack->pcoord->is_spherical_polar;
+  // user source terms inlined in update (see pgen/user_hooks.hpp)
+  auto &srcs_hook = pmy_pack->pmesh->pgen->user_srcs_hook;
+  srcs_hook.Update(pmy_pack->pmesh);
+  auto user_src = srcs_hook;
 
   // hierarchical parallel loop that updates conserved variables to intermediate step
   // using weights and fractional time step appropriate to stages of time-integrator.
@@ -47,38 +81,214 @@ TaskStatus Hydro::RKUpdate(Driver *pdriver, int stage) {
   int scr_level = 0;
   size_t scr_size = ScrArray1D<Real>::shmem_size(ncells1);
 
-  par_for_outer("h_update",DevExeSpace(),scr_size,scr_level,0,nmb1,0,nvar-1,ks,ke,js,je,
+  par_for_outer("h_update",DevExeSpace(),scr_size,scr_level,0,nmb1,nv0,nvar-1,kl,ku,jl,ju,
   KOKKOS_LAMBDA(TeamMember_t member, const int m, const int n, const int k, const int j) {
     ScrArray1D<Real> divf(member.team_scratch(scr_level), ncells1);
 
-    // compute dF1/dx1
-    par_for_inner(member, is, ie, [&](const int i) {
-      divf(i) = (flx1(m,n,k,j,i+1) - flx1(m,n,k,j,i))/mbsize.d_view(m).dx1;
-    });
-    member.team_barrier();
-
-    // Add dF2/dx2
-    // Fluxes must be summed in pairs to symmetrize round-off error in each dir
-    if (multi_d) {
-      par_for_inner(member, is, ie, [&](const int i) {
-        divf(i) += (flx2(m,n,k,j+1,i) - flx2(m,n,k,j,i))/mbsize.d_view(m).dx2;
+    // in spherical-polar coordinates compute the whole divergence using face areas and
+    // cell volumes (x1 = ln r, x2 = theta, x3 = phi), see spherical_polar.hpp
+    if (sph_polar) {
+      Real sm, sp, vol2;
+      SphPolarPolarFactors(j-js, indcs.nx2, mbsize.d_view(m).x2min,
+                           mbsize.d_view(m).x2max, sm, sp, vol2);
+      par_for_inner(member, il, iu, [&](const int i) {
+        Real rm, rp, vol1;
+        SphPolarRadialFactors(i-is, indcs.nx1, mbsize.d_view(m).x1min,
+                              mbsize.d_view(m).x1max, rm, rp, vol1);
+        divf(i) = (rp*rp*flx1(m,n,k,j,i+1) - rm*rm*flx1(m,n,k,j,i))/vol1;
+        Real inv_r = 0.5*(rp*rp - rm*rm)/vol1;  // volume average of 1/r
+        if (multi_d) {
+          divf(i) += inv_r*(sp*flx2(m,n,k,j+1,i) - sm*flx2(m,n,k,j,i))/vol2;
+        }
+        if (three_d) {
+          divf(i) += inv_r*(mbsize.d_view(m).dx2/vol2)*
+                     (flx3(m,n,k+1,j,i) - flx3(m,n,k,j,i))/mbsize.d_view(m).dx3;
+        }
       });
       member.team_barrier();
-    }
-
-    // Add dF3/dx3
-    // Fluxes must be summed in pairs to symmetrize round-off error in each dir
-    if (three_d) {
-      par_for_inner(member, is, ie, [&](const int i) {
-        divf(i) += (flx3(m,n,k+1,j,i) - flx3(m,n,k,j,i))/mbsize.d_view(m).dx3;
+    } else {
+      // compute dF1/dx1
+      par_for_inner(member, il, iu, [&](const int i) {
+        divf(i) = (flx1(m,n,k,j,i+1) - flx1(m,n,k,j,i))/mbsize.d_view(m).dx1;
       });
       member.team_barrier();
+
+      // Add dF2/dx2
+      // Fluxes must be summed in pairs to symmetrize round-off error in each dir
+      if (multi_d) {
+        par_for_inner(member, il, iu, [&](const int i) {
+          divf(i) += (flx2(m,n,k,j+1,i) - flx2(m,n,k,j,i))/mbsize.d_view(m).dx2;
+        });
+        member.team_barrier();
+      }
+
+      // Add dF3/dx3
+      // Fluxes must be summed in pairs to symmetrize round-off error in each dir
+      if (three_d) {
+        par_for_inner(member, il, iu, [&](const int i) {
+          divf(i) += (flx3(m,n,k+1,j,i) - flx3(m,n,k,j,i))/mbsize.d_view(m).dx3;
+        });
+        member.team_barrier();
+      }
     }
 
-    par_for_inner(member, is, ie, [&](const int i) {
+    par_for_inner(member, il, iu, [&](const int i) {
       u0_(m,n,k,j,i) = gam0*u0_(m,n,k,j,i) + gam1*u1_(m,n,k,j,i) - beta_dt*divf(i);
+      if constexpr (user_hooks::SrcTerm::enabled) {
+        u0_(m,n,k,j,i) += beta_dt*user_src(m,n,k,j,i);
+      }
     });
   });
   return TaskStatus::complete;
 }
+
+//----------------------------------------------------------------------------------------
+//! \fn  void Hydro::RKUpdateAndConToPrim
+//  \brief Explicit RK update including flux divergence terms, followed in the same kernel
+//  by ConsToPrim in the active cells and (in the last stage) the reduction for the new
+//  timestep.  Used with fused_c2p=true for non-relativistic hydrodynamics, in which case
+//  no other task changes u0 in active cells between RKUpdate and SendU.  The ghost zones
+//  are converted separately by ConToPrimGhosts() once they are received.  Templated over
+//  the EOS, so the conversion of each cell is inlined through HydEOSTraits.
+
+template <EOS_Type eos_t_>
+TaskStatus Hydro::RKUpdateAndConToPrim(Driver *pdriver, int stage) {
+  using EOS = HydEOSTraits<eos_t_>;
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+#if FIXED_MB_NX1 > 0
+  constexpr int is = FIXED_MB_IS, ie = FIXED_MB_IE;
+#else
+  int is = indcs.is, ie = indcs.ie;
+#endif
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+
+  Real &gam0 = pdriver->gam0[stage-1];
+  Real &gam1 = pdriver->gam1[stage-1];
+  Real beta_dt = (pdriver->beta[stage-1])*(pmy_pack->pmesh->dt);
+  bool last_stage = (stage == pdriver->nexp_stages);
+  int nhyd = nhydro;
+  int nscal = nscalars;
+  int nvar = nhydro + nscalars;
+  auto u0_ = u0;
+  auto u1_ = u1;
+  auto w0_ = w0;
+  auto flx1 = uflx.x1f;
+  auto flx2 = uflx.x2f;
+  auto flx3 = uflx.x3f;
+  auto &eos = peos->eos_data;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+  auto nfloor = c2p_nfloor;
+  Kokkos::deep_copy(nfloor, 0);
+  // user source terms inlined in update (see pgen/user_hooks.hpp)
+  auto &srcs_hook = pmy_pack->pmesh->pgen->user_srcs_hook;
+  srcs_hook.Update(pmy_pack->pmesh);
+  auto user_src = srcs_hook;
+
+  const int nj = je - js + 1;
+  const int nkj = (ke - ks + 1)*nj;
+  const int nmkj = (pmy_pack->nmb_thispack)*nkj;
+
+  Real dt_min = std::numeric_limits<float>::max();
+  Kokkos::TeamPolicy<> policy(DevExeSpace(), nmkj, Kokkos::AUTO);
+  Kokkos::parallel_reduce("h_update_c2p", policy,
+  KOKKOS_LAMBDA(TeamMember_t member, Real &min_dt) {
+    int m = (member.league_rank())/nkj;
+    int k = (member.league_rank() - m*nkj)/nj;
+    int j = (member.league_rank() - m*nkj - k*nj) + js;
+    k += ks;
+
+    // update conserved variables.  Fluxes summed in pairs in each direction to
+    // symmetrize round-off error, in the same order as in RKUpdate().
+    for (int n=0; n<nvar; ++n) {
+      par_for_inner(member, is, ie, [&](const int i) {
+        Real divf = (flx1(m,n,k,j,i+1) - flx1(m,n,k,j,i))/mbsize.d_view(m).dx1;
+        if (multi_d) {
+          divf += (flx2(m,n,k,j+1,i) - flx2(m,n,k,j,i))/mbsize.d_view(m).dx2;
+        }
+        if (three_d) {
+          divf += (flx3(m,n,k+1,j,i) - flx3(m,n,k,j,i))/mbsize.d_view(m).dx3;
+        }
+        u0_(m,n,k,j,i) = gam0*u0_(m,n,k,j,i) + gam1*u1_(m,n,k,j,i) - beta_dt*divf;
+        if constexpr (user_hooks::SrcTerm::enabled) {
+          u0_(m,n,k,j,i) += beta_dt*user_src(m,n,k,j,i);
+        }
+      });
+    }
+    member.team_barrier();
+
+    // convert to primitives, apply floors, and find smallest dx/(|v|+Cs) along pencil
+    Real team_dt = std::numeric_limits<float>::max();
+    Kokkos::parallel_reduce(Kokkos::TeamVectorRange(member, is, ie+1),
+    [&](const int i, Real &lmin_dt) {
+      HydCons1D u;
+      u.d  = u0_(m,IDN,k,j,i);
+      u.mx = u0_(m,IM1,k,j,i);
+      u.my = u0_(m,IM2,k,j,i);
+      u.mz = u0_(m,IM3,k,j,i);
+      if constexpr (EOS::has_energy) {u.e = u0_(m,IEN,k,j,i);}
+
+      HydPrim1D w;
+      bool dfloor_used=false, efloor_used=false, tfloor_used=false;
+      EOS::C2P(u, eos, w, dfloor_used, efloor_used, tfloor_used);
+
+      // update counters, reset conserved if floor was hit
+      if (dfloor_used) {
+        u0_(m,IDN,k,j,i) = u.d;
+        Kokkos::atomic_increment(&nfloor(0));
+      }
+      if (efloor_used) {
+        u0_(m,IEN,k,j,i) = u.e;
+        Kokkos::atomic_increment(&nfloor(1));
+      }
+      if (tfloor_used) {
+        u0_(m,IEN,k,j,i) = u.e;
+        Kokkos::atomic_increment(&nfloor(2));
+      }
+      w0_(m,IDN,k,j,i) = w.d;
+      w0_(m,IVX,k,j,i) = w.vx;
+      w0_(m,IVY,k,j,i) = w.vy;
+      w0_(m,IVZ,k,j,i) = w.vz;
+      if constexpr (EOS::has_energy) {w0_(m,IEN,k,j,i) = w.e;}
+      for (int n=nhyd; n<(nhyd+nscal); ++n) {
+        // apply scalar floor
+        if (u0_(m,n,k,j,i) < 0.0) {
+          u0_(m,n,k,j,i) = 0.0;
+        }
+        w0_(m,n,k,j,i) = u0_(m,n,k,j,i)/u.d;
+      }
+
+      if (last_stage) {
+        Real cs = EOS::SoundSpeed(eos, w);
+        Real dt = mbsize.d_view(m).dx1/(fabs(w.vx) + cs);
+        if (multi_d) {dt = fmin(dt, mbsize.d_view(m).dx2/(fabs(w.vy) + cs));}
+        if (three_d) {dt = fmin(dt, mbsize.d_view(m).dx3/(fabs(w.vz) + cs));}
+        lmin_dt = fmin(dt, lmin_dt);
+      }
+    }, Kokkos::Min<Real>(team_dt));
+
+    Kokkos::single(Kokkos::PerTeam(member), [&]() {
+      min_dt = fmin(team_dt, min_dt);
+    });
+  }, Kokkos::Min<Real>(dt_min));
+
+  // store new timestep and event counters
+  if (last_stage) {
+    dtnew = dt_min;
+    dtnew_computed = true;
+  }
+  auto nfloor_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), nfloor);
+  pmy_pack->pmesh->ecounter.neos_dfloor += nfloor_h(0);
+  pmy_pack->pmesh->ecounter.neos_efloor += nfloor_h(1);
+  pmy_pack->pmesh->ecounter.neos_tfloor += nfloor_h(2);
+
+  return TaskStatus::complete;
+}
+
+// function definitions for each template parameter
+template TaskStatus Hydro::RKUpdateAndConToPrim<EOS_Type::ideal>(Driver *pd, int s);
+template TaskStatus Hydro::RKUpdateAndConToPrim<EOS_Type::isothermal>(Driver *pd, int s);
+
 } // namespace hydro
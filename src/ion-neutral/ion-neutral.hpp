@@ -85,6 +85,7 @@ class IonNeutral {
 
  private:
   MeshBlockPack* pmy_pack;  // ptr to MeshBlockPack containing this Hydro
+  void ImpRKStages(Driver* pdrive, const int el, const int eu);
 };
 
 } // namespace ion_neutral
@@ -104,11 +104,8 @@ TaskStatus IonNeutral::FirstTwoImpRK(Driver *pdrive, int stage) {
   Kokkos::deep_copy(DevExeSpace(), pmhd->b1.x2f, pmhd->b0.x2f);
   Kokkos::deep_copy(DevExeSpace(), pmhd->b1.x3f, pmhd->b0.x3f);
 
-  // Solve implicit equations first time (nexp_stage = -1)
-  auto status = ImpRKUpdate(pdrive, -1);
-
-  // Solve implicit equations second time (nexp_stage = 0)
-  status = ImpRKUpdate(pdrive, 0);
+  // Solve implicit equations first and second time (nexp_stage = -1,0) in one pass
+  ImpRKStages(pdrive, -1, 0);
 
   // update primitive variables for both hydro and MHD
   auto &indcs = pmy_pack->pmesh->mb_indcs;
@@ -140,138 +137,113 @@ TaskStatus IonNeutral::FirstTwoImpRK(Driver *pdrive, int stage) {
 
 
 TaskStatus IonNeutral::ImpRKUpdate(Driver *pdriver, int estage) {
-  // # of implicit stage (1,2,3,4,[5]).  Note estage=(# of explicit stage)=(1,2,[3])
-  // estage <= 0 corresponds to first two fully implicit stages
-  int istage = estage + 2;
+  ImpRKStages(pdriver, estage, estage);
+  return TaskStatus::complete;
+}
 
+//----------------------------------------------------------------------------------------
+//! \fn  void IonNeutral::ImpRKStages
+//  \brief Executes implicit stages estage=(el,...,eu) of the ImEx integrator for the
+//  ion-neutral drag term in a single kernel.  In each cell the densities and momenta of
+//  both fluids are loaded together, and for each stage (1) the stiff source terms from
+//  previous stages are added, (2) the implicit difference equations are solved
+//  analytically, and (3) the stiff source terms R(U^n) for later stages are computed,
+//  before the updated values are stored back to both u0 arrays.
+
+void IonNeutral::ImpRKStages(Driver *pdriver, const int el, const int eu) {
   auto &indcs = pmy_pack->pmesh->mb_indcs;
   int n1 = indcs.nx1 + 2*indcs.ng;
   int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*indcs.ng) : 1;
   int n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*indcs.ng) : 1;
   int nmb1 = pmy_pack->nmb_thispack - 1;
 
-  // Add stiff source term (ion-neutral drag) evaluated with values from previous stages,
-  // i.e. the R(U^1), R(U^2), etc. terms, to partially updated conserved variables.
-  // Only required for istage = (2,3,4,[5])
-  mhd::MHD *pmhd = pmy_pack->pmhd;
-  hydro::Hydro *phyd = pmy_pack->phydro;
-  if (istage > 1) {
-    int scr_level = 0;
-    size_t scr_size = 0;
-    auto ui = pmhd->u0;
-    auto un = phyd->u0;
-    auto &a_twid = pdriver->a_twid;
-    Real dt = pmy_pack->pmesh->dt;
-    auto ru_ = pdriver->impl_src;
-    par_for_outer("imex_exp",DevExeSpace(),scr_size,scr_level,0,nmb1,0,(n3-1),0,(n2-1),
-    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+  auto ui = pmy_pack->pmhd->u0;
+  auto un = pmy_pack->phydro->u0;
+  auto ru_ = pdriver->impl_src;
+  auto &a_twid = pdriver->a_twid;
+  int nexp = pdriver->nexp_stages;
+  Real dt = pmy_pack->pmesh->dt;
+  Real gamma_adt = drag_coeff*(pdriver->a_impl)*dt;
+  Real xi_adt = ionization_coeff*(pdriver->a_impl)*dt;
+  Real alpha_adt = recombination_coeff*(pdriver->a_impl)*dt;
+  auto drag = drag_coeff;
+  auto xi = ionization_coeff;
+  auto alpha = recombination_coeff;
+
+  par_for("imex_ion",DevExeSpace(),0,nmb1,0,(n3-1),0,(n2-1),0,(n1-1),
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    // load ion and neutral densities and momenta
+    Real d_i = ui(m,IDN,k,j,i);
+    Real d_n = un(m,IDN,k,j,i);
+    Real m_i[3], m_n[3];
+    for (int n=0; n<3; ++n) {
+      m_i[n] = ui(m,IM1+n,k,j,i);
+      m_n[n] = un(m,IM1+n,k,j,i);
+    }
+
+    for (int estage=el; estage<=eu; ++estage) {
+      // # of implicit stage (1,2,3,4,[5]).  Note estage=(# of explicit stage)=(1,2,[3])
+      // estage <= 0 corresponds to first two fully implicit stages
+      int istage = estage + 2;
+
+      // Add stiff source term evaluated with values from previous stages, i.e. the
+      // R(U^1), R(U^2), etc. terms.  Only required for istage = (2,3,4,[5])
       for (int s=0; s<=(istage-2); ++s) {
         Real adt = a_twid[istage-2][s]*dt;
-        par_for_inner(member, 0, (n1-1), [&](const int i) {
-          ui(m,IM1,k,j,i) += adt*ru_(s,m,0,k,j,i);
-          ui(m,IM2,k,j,i) += adt*ru_(s,m,1,k,j,i);
-          ui(m,IM3,k,j,i) += adt*ru_(s,m,2,k,j,i);
-          un(m,IM1,k,j,i) += adt*ru_(s,m,3,k,j,i);
-          un(m,IM2,k,j,i) += adt*ru_(s,m,4,k,j,i);
-          un(m,IM3,k,j,i) += adt*ru_(s,m,5,k,j,i);
-          ui(m,IDN,k,j,i) += adt*ru_(s,m,6,k,j,i);
-          un(m,IDN,k,j,i) += adt*ru_(s,m,7,k,j,i);
-        });
+        for (int n=0; n<3; ++n) {
+          m_i[n] += adt*ru_(s,m,n,k,j,i);
+          m_n[n] += adt*ru_(s,m,n+3,k,j,i);
+        }
+        d_i += adt*ru_(s,m,6,k,j,i);
+        d_n += adt*ru_(s,m,7,k,j,i);
       }
-    });
-  }
-
-  // Update ion/neutral momentum equations with analytic solution of implicit difference
-  // equations for ion-neutral drag.
-  // Only required for istage = (1,2,3,[4])
-  if (estage < pdriver->nexp_stages) {
-    Real gamma_adt = drag_coeff*(pdriver->a_impl)*(pmy_pack->pmesh->dt);
-    Real xi_adt = ionization_coeff*(pdriver->a_impl)*(pmy_pack->pmesh->dt);
-    Real alpha_adt = recombination_coeff*(pdriver->a_impl)*(pmy_pack->pmesh->dt);
-    auto ui = pmhd->u0;
-    auto un = phyd->u0;
-    par_for("imex_imp",DevExeSpace(),0,nmb1,0,(n3-1),0,(n2-1),0,(n1-1),
-    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
-      Real rho_i = ui(m,IDN,k,j,i);
-      if (alpha_adt > 0) { // to avoid division by zero
-        Real d = 1./4./alpha_adt/alpha_adt + xi_adt/2./alpha_adt/alpha_adt
-                 + xi_adt*xi_adt/4./alpha_adt/alpha_adt + ui(m,IDN,k,j,i)/alpha_adt +
-                 xi_adt/alpha_adt * (ui(m,IDN,k,j,i)+un(m,IDN,k,j,i));
-        rho_i = -1./2./alpha_adt - xi_adt/2./alpha_adt + sqrt(d);
+
+      // Only required for istage = (1,2,3,[4])
+      if (estage < nexp) {
+        // Update ion/neutral densities and momenta with analytic solution of implicit
+        // difference equations for ion-neutral drag.
+        Real rho_i = d_i;
+        if (alpha_adt > 0) { // to avoid division by zero
+          Real d = 1./4./alpha_adt/alpha_adt + xi_adt/2./alpha_adt/alpha_adt
+                   + xi_adt*xi_adt/4./alpha_adt/alpha_adt + d_i/alpha_adt +
+                   xi_adt/alpha_adt * (d_i + d_n);
+          rho_i = -1./2./alpha_adt - xi_adt/2./alpha_adt + sqrt(d);
+        }
+        Real rho_n = d_i + d_n - rho_i;
+        d_i = rho_i;
+        d_n = rho_n;
+
+        Real denom = 1.0 + gamma_adt*(rho_i+rho_n) + xi_adt + alpha_adt*rho_i;
+        for (int n=0; n<3; ++n) {
+          Real sum = m_i[n] + m_n[n];
+          m_i[n] = (m_i[n] + (gamma_adt*rho_i + xi_adt)*sum)/denom;
+          m_n[n] = sum - m_i[n];
+        }
+
+        // Compute stiff source term using variables updated in this stage, i.e R(U^n),
+        // for use in later stages.  Source terms in neutrals are minus those in ions.
+        int s = istage-1;
+        for (int n=0; n<3; ++n) {
+          Real src = drag*(d_i*m_n[n] - d_n*m_i[n]) + xi*m_n[n] - alpha*d_i*m_i[n];
+          ru_(s,m,n,k,j,i) = src;
+          ru_(s,m,n+3,k,j,i) = -src;
+        }
+        Real src = xi*d_n - alpha*d_i*d_i;
+        ru_(s,m,6,k,j,i) = src;
+        ru_(s,m,7,k,j,i) = -src;
       }
-      Real rho_n = ui(m,IDN,k,j,i) + un(m,IDN,k,j,i) - rho_i;
-      ui(m,IDN,k,j,i) = rho_i;
-      un(m,IDN,k,j,i) = rho_n;
-
-      Real denom = 1.0 + gamma_adt*(rho_i+rho_n) + xi_adt + alpha_adt*rho_i;
-      // compute new ion/neutral momenta in x1
-      Real sum = (ui(m,IM1,k,j,i) + un(m,IM1,k,j,i));
-      Real u_i = (ui(m,IM1,k,j,i) +
-                 (gamma_adt*rho_i + xi_adt)*sum)/denom;
-      Real u_n = sum - u_i;
-      ui(m,IM1,k,j,i) = u_i;
-      un(m,IM1,k,j,i) = u_n;
-      // compute new ion/neutral momenta in x2
-      sum = (ui(m,IM2,k,j,i) + un(m,IM2,k,j,i));
-      u_i = (ui(m,IM2,k,j,i) +
-                 (gamma_adt*rho_i + xi_adt)*sum)/denom;
-      u_n = sum - u_i;
-      ui(m,IM2,k,j,i) = u_i;
-      un(m,IM2,k,j,i) = u_n;
-      // compute new ion/neutral momenta in x3
-      sum = (ui(m,IM3,k,j,i) + un(m,IM3,k,j,i));
-      u_i = (ui(m,IM3,k,j,i) +
-                 (gamma_adt*rho_i + xi_adt)*sum)/denom;
-      u_n = sum - u_i;
-      ui(m,IM3,k,j,i) = u_i;
-      un(m,IM3,k,j,i) = u_n;
-    });
-  }
-
-  // Compute stiff source term (ion-neutral drag) using variables updated in this stage,
-  // i.e R(U^n), for use in later stages.  Only required for istage = (1,2,3,[4])
-  if (estage < pdriver->nexp_stages) {
-    int s = istage-1;
-    auto ui = pmhd->u0;
-    auto un = phyd->u0;
-    auto drag = drag_coeff;
-    auto xi = ionization_coeff;
-    auto alpha = recombination_coeff;
-    auto ru_ = pdriver->impl_src;
-    par_for("imex_rup",DevExeSpace(),0,nmb1,0,(n3-1),0,(n2-1),0,(n1-1),
-    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
-      // drag term in IM1 component of ion momentum
-      ru_(s,m,0,k,j,i) = drag*(ui(m,IDN,k,j,i)*un(m,IM1,k,j,i) -
-                              un(m,IDN,k,j,i)*ui(m,IM1,k,j,i)) +
-                              xi*un(m,IM1,k,j,i) - alpha*ui(m,IDN,k,j,i)*ui(m,IM1,k,j,i);
-      // drag term in IM2 component of ion momentum
-      ru_(s,m,1,k,j,i) = drag*(ui(m,IDN,k,j,i)*un(m,IM2,k,j,i) -
-                              un(m,IDN,k,j,i)*ui(m,IM2,k,j,i)) +
-                              xi*un(m,IM2,k,j,i) - alpha*ui(m,IDN,k,j,i)*ui(m,IM2,k,j,i);
-      // drag term in IM3 component of ion momentum
-      ru_(s,m,2,k,j,i) = drag*(ui(m,IDN,k,j,i)*un(m,IM3,k,j,i) -
-                              un(m,IDN,k,j,i)*ui(m,IM3,k,j,i)) +
-                              xi*un(m,IM3,k,j,i) - alpha*ui(m,IDN,k,j,i)*ui(m,IM3,k,j,i);
-      // drag term in IM1 component of neutral momentum
-      ru_(s,m,3,k,j,i) = drag*(un(m,IDN,k,j,i)*ui(m,IM1,k,j,i) -
-                              ui(m,IDN,k,j,i)*un(m,IM1,k,j,i)) -
-                              xi*un(m,IM1,k,j,i) + alpha*ui(m,IDN,k,j,i)*ui(m,IM1,k,j,i);
-      // drag term in IM2 component of neutral momentum
-      ru_(s,m,4,k,j,i) = drag*(un(m,IDN,k,j,i)*ui(m,IM2,k,j,i) -
-                              ui(m,IDN,k,j,i)*un(m,IM2,k,j,i)) -
-                              xi*un(m,IM2,k,j,i) + alpha*ui(m,IDN,k,j,i)*ui(m,IM2,k,j,i);
-      // drag term in IM3 component of neutral momentum
-      ru_(s,m,5,k,j,i) = drag*(un(m,IDN,k,j,i)*ui(m,IM3,k,j,i) -
-                              ui(m,IDN,k,j,i)*un(m,IM3,k,j,i)) -
-                              xi*un(m,IM3,k,j,i) + alpha*ui(m,IDN,k,j,i)*ui(m,IM3,k,j,i);
-      // drag term in IDN component of ion momentum
-      ru_(s,m,6,k,j,i) = xi*un(m,IDN,k,j,i) - alpha*ui(m,IDN,k,j,i)*ui(m,IDN,k,j,i);
-      // drag term in IDN component of neutral momentum
-      ru_(s,m,7,k,j,i) =-xi*un(m,IDN,k,j,i) + alpha*ui(m,IDN,k,j,i)*ui(m,IDN,k,j,i);
-    });
-  }
+    }
 
-  return TaskStatus::complete;
+    // store updated densities and momenta of both fluids
+    ui(m,IDN,k,j,i) = d_i;
+    un(m,IDN,k,j,i) = d_n;
+    for (int n=0; n<3; ++n) {
+      ui(m,IM1+n,k,j,i) = m_i[n];
+      un(m,IM1+n,k,j,i) = m_n[n];
+    }
+  });
+
+  return;
 }
 
 } // namespace ion_neutral
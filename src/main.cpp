@@ -24,11 +24,16 @@
 //========================================================================================
 
 // C/C++ headers
+#include <algorithm> // min, max
+#include <cstdint>
 #include <cstdlib>
 #include <iostream>
 #include <string>
 #include <memory>
 #include <cstdio> // sscanf
+#include <sstream>
+#include <vector>
+#include <unistd.h> // getcwd, chdir
 
 // Athena headers
 #include "athena.hpp"
@@ -38,6 +43,7 @@
 #include "mesh/mesh.hpp"
 #include "outputs/outputs.hpp"
 #include "driver/driver.hpp"
+#include "utils/managed_memory.hpp"
 
 // MPI/OpenMP headers
 #if MPI_PARALLEL_ENABLED
@@ -52,6 +58,89 @@
 #include <hip/hip_runtime.h>
 #endif
 
+//----------------------------------------------------------------------------------------
+//! \fn void SetEnsembleMember()
+//! \brief Applies the input overrides of ensemble member n, given by <ensemble>/member<n>
+//! as a whitespace-separated list of block/par=value (in the same format as on the
+//! command line), and appends ".m<n>" to <job>/basename so each member writes separate
+//! outputs.
+
+static void SetEnsembleMember(ParameterInput *pin, const int n) {
+  char number[8];
+  std::snprintf(number, sizeof(number), "%03d", n);
+  std::stringstream ss(pin->GetOrAddString("ensemble", "member" + std::to_string(n), ""));
+  std::vector<std::string> args = {"athena"};
+  std::string arg;
+  while (ss >> arg) {args.push_back(arg);}
+  std::vector<char*> pargs;
+  for (auto &a : args) {pargs.push_back(&(a[0]));}
+  pin->ModifyFromCmdline(static_cast<int>(pargs.size()), pargs.data());
+  pin->SetString("job", "basename", pin->GetString("job", "basename") + ".m" + number);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn std::string CurrentDir()
+//! \brief Returns current working directory
+
+static std::string CurrentDir() {
+  char buf[4096];
+  if (getcwd(buf, sizeof(buf)) == nullptr) {return std::string();}
+  return std::string(buf);
+}
+
+#if MPI_PARALLEL_ENABLED
+//----------------------------------------------------------------------------------------
+//! \fn bool RescaleRanks()
+//! \brief Replaces the run communicator (athena_comm) by one with nranks_new ranks, and
+//! publishes the restart image written by the existing ranks so that all ranks of the
+//! new communicator can read it.  Ranks are added by spawning copies of this executable
+//! (args is the null-terminated command line, and new ranks join in main() below), or
+//! dropped by splitting the communicator.  Dropped ranks hold part of the image, so they
+//! wait until it has been read before returning false.  The communicator over which the
+//! image is published is returned in image_comm.
+
+static bool RescaleRanks(char *args[], int nranks_new,
+                         const std::string &hosts, const std::string &wdir,
+                         IOWrapperImage &image, MPI_Comm *image_comm) {
+  MPI_Comm old_comm = global_variable::athena_comm;
+  MPI_Comm new_comm;
+  if (nranks_new > global_variable::nranks) {
+    MPI_Info info;
+    MPI_Info_create(&info);
+    MPI_Info_set(info, "wdir", wdir.c_str());
+    if (!(hosts.empty())) {MPI_Info_set(info, "host", hosts.c_str());}
+    MPI_Comm intercomm;
+    int errcode = MPI_Comm_spawn(args[0], &(args[1]), nranks_new-global_variable::nranks,
+                                 info, 0, old_comm, &intercomm, MPI_ERRCODES_IGNORE);
+    MPI_Info_free(&info);
+    if (errcode != MPI_SUCCESS) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "MPI_Comm_spawn of " << nranks_new-global_variable::nranks
+                << " ranks failed" << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    // existing ranks keep their rank, and new ranks are appended
+    MPI_Intercomm_merge(intercomm, 0, &new_comm);
+    MPI_Comm_free(&intercomm);
+    *image_comm = new_comm;
+  } else {
+    int color = (global_variable::my_rank < nranks_new)? 0 : MPI_UNDEFINED;
+    MPI_Comm_split(old_comm, color, global_variable::my_rank, &new_comm);
+    *image_comm = old_comm;
+  }
+  IOWrapper::PublishImage(image, *image_comm);
+  if (new_comm == MPI_COMM_NULL) {
+    IOWrapper::FreeImage(image);
+    return false;
+  }
+  global_variable::athena_comm = new_comm;
+  MPI_Comm_rank(global_variable::athena_comm, &(global_variable::my_rank));
+  MPI_Comm_size(global_variable::athena_comm, &(global_variable::nranks));
+  return true;
+}
+#endif
+
 //----------------------------------------------------------------------------------------
 //! \fn int main(int argc, char *argv[])
 //! \brief Athena main program
@@ -96,8 +185,10 @@ int main(int argc, char *argv[]) {
     return(0);
   }
 #endif  // OPENMP_PARALLEL_ENABLED
-  // Get process id (rank) in MPI_COMM_WORLD
-  if (MPI_SUCCESS != MPI_Comm_rank(MPI_COMM_WORLD, &(global_variable::my_rank))) {
+  // Get process id (rank) in communicator of all ranks (MPI_COMM_WORLD)
+  global_variable::athena_comm = MPI_COMM_WORLD;
+  if (MPI_SUCCESS != MPI_Comm_rank(global_variable::athena_comm,
+                                   &(global_variable::my_rank))) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
               << "MPI_Comm_rank failed." << std::endl;
     MPI_Finalize();
@@ -105,12 +196,27 @@ int main(int argc, char *argv[]) {
   }
 
   // Get total number of MPI processes (ranks)
-  if (MPI_SUCCESS != MPI_Comm_size(MPI_COMM_WORLD, &global_variable::nranks)) {
+  if (MPI_SUCCESS != MPI_Comm_size(global_variable::athena_comm,
+                                   &global_variable::nranks)) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
               << "MPI_Comm_size failed." << std::endl;
     MPI_Finalize();
     return(0);
   }
+
+  // Bits of MPI tags not used for buffer IDs store MeshBlock local IDs, so the maximum
+  // number of MBs per rank is set by the largest tag supported by the MPI library
+  {
+    void *ptag_ub;
+    int flag;
+    MPI_Comm_get_attr(global_variable::athena_comm, MPI_TAG_UB, &ptag_ub, &flag);
+    if (flag) {
+      int tag_ub = *static_cast<int*>(ptag_ub);
+      int nbits = 0;
+      while (nbits < 30 && (2 << nbits) - 1 <= tag_ub) {nbits++;}
+      global_variable::nbits_lid = nbits - (NUM_BITS_BUFID);
+    }
+  }
 #else  // no MPI
   global_variable::my_rank = 0;
   global_variable::nranks  = 1;
@@ -220,110 +326,319 @@ int main(int argc, char *argv[]) {
     return(0);
   }
 
-  // Start the wall clock timer. This is done here rather than in the Driver to ensure
-  // that the time taken in ProblemGenerator is also captured.
-  Kokkos::Timer timer;
-
-  //--- Step 3. --------------------------------------------------------------------------
-  // Construct ParameterInput object and load data either from restart or input file.
-  // With MPI, the input is read by every rank in parallel using MPI-IO.
-
-  ParameterInput* pinput = new ParameterInput;
-  IOWrapper infile, restartfile;
-  // read parameters from restart file
-  if (res_flag) {
-    restartfile.Open(restart_file.c_str(), IOWrapper::FileMode::read);
-    pinput->LoadFromFile(restartfile);
+  // With <ensemble>/nmember > 1, Steps 3-8 are repeated for each member of an ensemble of
+  // independent runs, which share the Kokkos and MPI environment (see SetEnsembleMember()
+  // for how members differ).  With <ensemble>/ngroups > 1 the ranks are split into that
+  // many groups, each with its own communicator (athena_comm), which run members
+  // concurrently: group g runs members g, g+ngroups, g+2*ngroups, ...
+  int nmember = 1, ngroups = 1, group = 0;
+  bool rescale = false;
+  {
+    ParameterInput epin;
+    if (res_flag) {
+      IOWrapper restartfile;
+      restartfile.Open(restart_file.c_str(), IOWrapper::FileMode::read);
+      epin.LoadFromFile(restartfile);
+      restartfile.Close();
+    }
+    if (iarg_flag) {
+      IOWrapper infile;
+      infile.Open(input_file.c_str(), IOWrapper::FileMode::read);
+      epin.LoadFromFile(infile);
+      infile.Close();
+    }
+    epin.ModifyFromCmdline(argc, argv);
+    nmember = epin.GetOrAddInteger("ensemble", "nmember", 1);
+    ngroups = epin.GetOrAddInteger("ensemble", "ngroups", 1);
+    rescale = (epin.GetOrAddInteger("job", "rescale_cycle", -1) >= 0);
   }
-  // read parameters from input file.  If both -r and -i are specified, this will
-  // override parameters from the restart file
-  if (iarg_flag) {
-    infile.Open(input_file.c_str(), IOWrapper::FileMode::read);
-    pinput->LoadFromFile(infile);
-    infile.Close();
-  }
-  pinput->ModifyFromCmdline(argc, argv);
-
-  // Dump input parameters and quit if code was run with -n option.
-  if (narg_flag) {
-    if (global_variable::my_rank == 0) pinput->ParameterDump(std::cout);
-    if (res_flag) restartfile.Close();
-    delete pinput;
+  if (rescale && nmember > 1) {
+    if (global_variable::my_rank == 0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<job>/rescale_cycle cannot be used with an ensemble"
+                << std::endl;
+    }
     Kokkos::finalize();
 #if MPI_PARALLEL_ENABLED
     MPI_Finalize();
 #endif
     return(0);
   }
-
-  //--- Step 4. --------------------------------------------------------------------------
-  // Construct Mesh.  Then build MeshBlockTree and add MeshBlockPack containing MeshBlocks
-  // on this rank.  Latter cannot be performed in Mesh constructor since it requires
-  // pointer to Mesh.
-
-  Mesh* pmesh = new Mesh(pinput);
-  if (!res_flag) {
-    pmesh->BuildTreeFromScratch(pinput);
-  } else {
-    pmesh->BuildTreeFromRestart(pinput, restartfile);
-  }
-
-  //  If code was run with -m option, write mesh structure to file and quit.
-  if (marg_flag) {
-    if (global_variable::my_rank == 0) {pmesh->WriteMeshStructure();}
-    if (res_flag) {restartfile.Close();}
-    delete pmesh;
-    delete pinput;
+  if (ngroups < 1 || ngroups > global_variable::nranks) {
+    if (global_variable::my_rank == 0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<ensemble>/ngroups=" << ngroups << " must be between 1 "
+                << "and the number of MPI ranks (" << global_variable::nranks << ")"
+                << std::endl;
+    }
     Kokkos::finalize();
 #if MPI_PARALLEL_ENABLED
     MPI_Finalize();
 #endif
     return(0);
   }
+  ngroups = std::min(ngroups, std::max(nmember, 1));
+#if MPI_PARALLEL_ENABLED
+  if (ngroups > 1) {
+    // contiguous blocks of ranks form each group, so groups stay within nodes
+    group = static_cast<int>((static_cast<int64_t>(global_variable::my_rank)*ngroups)/
+                             global_variable::nranks);
+    MPI_Comm_split(MPI_COMM_WORLD, group, global_variable::my_rank,
+                   &(global_variable::athena_comm));
+    MPI_Comm_rank(global_variable::athena_comm, &(global_variable::my_rank));
+    MPI_Comm_size(global_variable::athena_comm, &(global_variable::nranks));
+  }
+#endif
+  std::string start_dir = CurrentDir();
 
-  //--- Step 5. --------------------------------------------------------------------------
-  // Add coordinates and physics modules to MeshBlockPack, and set initial conditions.
-  // Note these steps must occur after Mesh (including MeshBlocks and MeshBlockPack)
-  // is fully constructed.
-
-  pmesh->AddCoordinatesAndPhysics(pinput);
-  if (!res_flag) {
-    // set ICs using ProblemGenerator constructor for new runs
-    pmesh->pgen = std::make_unique<ProblemGenerator>(pinput, pmesh);
-  } else {
-    // read ICs from restart file using ProblemGenerator constructor for restarts
-    pmesh->pgen = std::make_unique<ProblemGenerator>(pinput, pmesh, restartfile);
-    restartfile.Close();
+  // With <job>/rescale_cycle, the run stops at the end of that cycle, writes a restart
+  // image held in memory by each rank, and continues on <job>/rescale_nranks ranks
+  // (repeating Steps 3-8) by reading the image in place of a restart file.  Ranks spawned
+  // to join the run (which have a parent communicator) start by reading the image.
+  std::shared_ptr<IOWrapperImage> image;
+  std::vector<char*> args(argv, argv + argc);
+  args.push_back(nullptr);
+#if MPI_PARALLEL_ENABLED
+  MPI_Comm image_comm = MPI_COMM_NULL;
+  MPI_Comm parent;
+  MPI_Comm_get_parent(&parent);
+  if (parent != MPI_COMM_NULL) {
+    MPI_Intercomm_merge(parent, 1, &(global_variable::athena_comm));
+    MPI_Comm_free(&parent);
+    MPI_Comm_rank(global_variable::athena_comm, &(global_variable::my_rank));
+    MPI_Comm_size(global_variable::athena_comm, &(global_variable::nranks));
+    image = std::make_shared<IOWrapperImage>();
+    image_comm = global_variable::athena_comm;
+    IOWrapper::PublishImage(*image, image_comm);
   }
+#endif
+  for (int member=group; member<nmember; member+=ngroups) {
+    // Start the wall clock timer. This is done here rather than in the Driver to ensure
+    // that the time taken in ProblemGenerator is also captured.
+    Kokkos::Timer timer;
+
+    //--- Step 3. ------------------------------------------------------------------------
+    // Construct ParameterInput object and load data either from restart or input file.
+    // With MPI, the input is read by every rank in parallel using MPI-IO.
+
+    ParameterInput* pinput = new ParameterInput;
+    IOWrapper infile, restartfile;
+    // a rescaled run continues from the restart image, which holds all parameters
+    bool from_image = (image != nullptr);
+    bool restart = (res_flag || from_image);
+    // read parameters from restart file
+    if (from_image) {
+      restartfile.Open(image);
+      pinput->LoadFromFile(restartfile);
+    } else if (res_flag) {
+      restartfile.Open(restart_file.c_str(), IOWrapper::FileMode::read);
+      pinput->LoadFromFile(restartfile);
+    }
+    // read parameters from input file.  If both -r and -i are specified, this will
+    // override parameters from the restart file
+    if (iarg_flag && !(from_image)) {
+      infile.Open(input_file.c_str(), IOWrapper::FileMode::read);
+      pinput->LoadFromFile(infile);
+      infile.Close();
+    }
+    if (!(from_image)) {pinput->ModifyFromCmdline(argc, argv);}
+    if (nmember > 1) {
+      SetEnsembleMember(pinput, member);
+      if (global_variable::my_rank == 0) {
+        std::cout << std::endl << "Ensemble member " << member << " of " << nmember;
+        if (ngroups > 1) {std::cout << " (rank group " << group << ")";}
+        std::cout << std::endl;
+      }
+    }
+
+    // Optionally time each phase of startup.  Kernels are fenced at the end of each phase
+    // so that their cost is attributed to the phase that launched them.
+    bool startup_timing = pinput->GetOrAddBoolean("job","startup_timing",false);
+    const int nphase = 6;
+    const char *phase_name[nphase] = {"read input", "build Mesh and tree",
+        "add coordinates and physics", "problem generator", "construct Driver/Outputs",
+        "initialize Driver"};
+    double phase_time[nphase] = {0.0};
+    int iphase = 0;
+    double t_last = 0.0;
+    auto EndPhase = [&]() {
+      if (!(startup_timing)) return;
+      Kokkos::fence();
+      double t_now = timer.seconds();
+      phase_time[iphase++] = t_now - t_last;
+      t_last = t_now;
+    };
+    EndPhase();
+
+    // Dump input parameters and quit if code was run with -n option.
+    if (narg_flag) {
+      if (global_variable::my_rank == 0) pinput->ParameterDump(std::cout);
+      if (restart) restartfile.Close();
+      delete pinput;
+      Kokkos::finalize();
+#if MPI_PARALLEL_ENABLED
+      MPI_Finalize();
+#endif
+      return(0);
+    }
+
+    // Optionally select MeshBlock size by running a short benchmark of each candidate
+    // size, and quit after reporting the result if <job>/tune_action = print
+    if (!(restart) && pinput->GetOrAddBoolean("job", "tune_meshblock", false)) {
+      if (!(TuneMeshBlockSize(pinput))) {
+        delete pinput;
+        Kokkos::finalize();
+#if MPI_PARALLEL_ENABLED
+        MPI_Finalize();
+#endif
+        return(0);
+      }
+    }
+
+    //--- Step 4. ------------------------------------------------------------------------
+    // Construct Mesh.  Then build MeshBlockTree and add MeshBlockPack containing
+    // MeshBlocks on this rank.  Latter cannot be performed in Mesh constructor since it
+    // requires pointer to Mesh.
+
+    Mesh* pmesh = new Mesh(pinput);
+    if (!restart) {
+      pmesh->BuildTreeFromScratch(pinput);
+    } else {
+      pmesh->BuildTreeFromRestart(pinput, restartfile);
+    }
+    EndPhase();
+
+    //  If code was run with -m option, write mesh structure to file and quit.
+    if (marg_flag) {
+      if (global_variable::my_rank == 0) {pmesh->WriteMeshStructure();}
+      if (restart) {restartfile.Close();}
+      delete pmesh;
+      delete pinput;
+      Kokkos::finalize();
+#if MPI_PARALLEL_ENABLED
+      MPI_Finalize();
+#endif
+      return(0);
+    }
 
-  //--- Step 6. --------------------------------------------------------------------------
-  // Construct Driver and Outputs. Actual outputs (including initial conditions) are made
-  // in Driver.Initialize(). Add wall clock timer to Driver if necessary.
+    //--- Step 5. ------------------------------------------------------------------------
+    // Add coordinates and physics modules to MeshBlockPack, and set initial conditions.
+    // Note these steps must occur after Mesh (including MeshBlocks and MeshBlockPack)
+    // is fully constructed.
 
-  ChangeRunDir(run_dir);
-  Driver* pdriver = new Driver(pinput, pmesh, wtlim, &timer);
-  Outputs* pout = new Outputs(pinput, pmesh);
+    pmesh->AddCoordinatesAndPhysics(pinput);
+    EndPhase();
+    if (!restart) {
+      // set ICs using ProblemGenerator constructor for new runs
+      pmesh->pgen = std::make_unique<ProblemGenerator>(pinput, pmesh);
+    } else {
+      // read ICs from restart file using ProblemGenerator constructor for restarts
+      pmesh->pgen = std::make_unique<ProblemGenerator>(pinput, pmesh, restartfile);
+      restartfile.Close();
+    }
+#if MPI_PARALLEL_ENABLED
+    // once read by all ranks, restart image is freed (also on any dropped ranks holding
+    // part of it), as is the communicator it was published over if no longer used
+    if (from_image) {
+      IOWrapper::FreeImage(*image);
+      image.reset();
+      if (image_comm != global_variable::athena_comm && image_comm != MPI_COMM_WORLD) {
+        MPI_Comm_free(&image_comm);
+      }
+    }
+#endif
+    EndPhase();
+
+    //--- Step 6. ------------------------------------------------------------------------
+    // Construct Driver and Outputs. Actual outputs (including initial conditions) are
+    // made in Driver.Initialize(). Add wall clock timer to Driver if necessary.
+
+    ChangeRunDir(run_dir);
+    InitLaunchTuning(pinput);
+    Driver* pdriver = new Driver(pinput, pmesh, wtlim, &timer);
+    Outputs* pout = new Outputs(pinput, pmesh);
+    EndPhase();
+
+    //--- Step 7. ------------------------------------------------------------------------
+    // Execute Driver.
+    //    1. Initial conditions set in Driver::Initialize()
+    //    2. TaskList(s) executed in Driver::Execute()
+    //    3. Any final analysis or diagnostics run in Driver::Finalize()
+
+    pdriver->Initialize(pmesh, pinput, pout, restart);
+    EndPhase();
+
+    // Report the maximum over ranks of the time spent in each phase of startup
+    if (startup_timing) {
+#if MPI_PARALLEL_ENABLED
+      MPI_Allreduce(MPI_IN_PLACE, phase_time, nphase, MPI_DOUBLE, MPI_MAX,
+                    global_variable::athena_comm);
+#endif
+      if (global_variable::my_rank == 0) {
+        std::cout << std::endl << "Startup timing (max over ranks):" << std::endl;
+        double t_total = 0.0;
+        for (int n=0; n<nphase; ++n) {
+          std::printf("  %-30s %12.4e s\n", phase_name[n], phase_time[n]);
+          t_total += phase_time[n];
+        }
+        std::printf("  %-30s %12.4e s\n", "total", t_total);
+        std::fflush(stdout);
+      }
+    }
+    pdriver->Execute(pmesh, pinput, pout);
+    int nranks_new = pdriver->rescale_nranks;
+    std::string rescale_hosts;
+    if (pdriver->RescaleDue(pmesh)) {
+      // write all data to a restart image (instead of the final outputs), from which the
+      // run continues below.  <job>/rescale_hosts is an optional list of hosts given to
+      // MPI_Comm_spawn for new ranks.
+      rescale_hosts = pinput->GetOrAddString("job", "rescale_hosts", "");
+      pinput->SetInteger("job", "rescale_cycle", -1);
+      image = std::make_shared<IOWrapperImage>();
+      RestartOutput rescale_out(pinput, pmesh, image);
+      rescale_out.LoadOutputData(pmesh);
+      rescale_out.WriteOutputFile(pmesh, pinput);
+      if (global_variable::my_rank == 0) {
+        std::cout << std::endl << "Continuing run on " << nranks_new << " ranks at cycle "
+                  << pmesh->ncycle << std::endl;
+      }
+    } else {
+      pdriver->Finalize(pmesh, pinput, pout);
+    }
+    FinalizeLaunchTuning();
 
-  //--- Step 7. --------------------------------------------------------------------------
-  // Execute Driver.
-  //    1. Initial conditions set in Driver::Initialize()
-  //    2. TaskList(s) executed in Driver::Execute()
-  //    3. Any final analysis or diagnostics run in Driver::Finalize()
+    //--- Step 8. ------------------------------------------------------------------------
+    // clean up, and terminate
+    // Note anything containing a Kokkos::view must be deleted before Kokkos::finalize()
 
-  pdriver->Initialize(pmesh, pinput, pout, res_flag);
-  pdriver->Execute(pmesh, pinput, pout);
-  pdriver->Finalize(pmesh, pinput, pout);
+    delete pout;
+    delete pdriver;
+    delete pmesh;
+    delete pinput;
+    ManagedMemory::Finalize();
 
-  //--- Step 8. -------------------------------------------------------------------------
-  // clean up, and terminate
-  // Note anything containing a Kokkos::view must be deleted before Kokkos::finalize()
+    // run directory (and input file) of next member are relative to starting directory
+    if (!(run_dir.empty()) && chdir(start_dir.c_str()) != 0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Cannot cd to directory '" << start_dir << "'"
+                << std::endl;
+      exit(EXIT_FAILURE);
+    }
 
-  delete pout;
-  delete pdriver;
-  delete pmesh;
-  delete pinput;
+#if MPI_PARALLEL_ENABLED
+    // repeat this member on the new set of ranks, which dropped ranks leave
+    if (image != nullptr) {
+      if (!(RescaleRanks(args.data(), nranks_new, rescale_hosts, start_dir, *image,
+                         &image_comm))) {break;}
+      member -= ngroups;
+    }
+#endif
+  }
   Kokkos::finalize();
 #if MPI_PARALLEL_ENABLED
+  if (global_variable::athena_comm != MPI_COMM_WORLD) {
+    MPI_Comm_free(&(global_variable::athena_comm));
+  }
   MPI_Finalize();
 #endif
   return(0);
@@ -0,0 +1,175 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file amr_replay.cpp
+//! \brief Implements MeshRefinement functions that record the sequence of changes to the
+//! mesh (refinement flags) and to the distribution of MeshBlocks over ranks (results of
+//! LoadBalance) during a run, and that replay such a record in a later run.  Replaying
+//! skips evaluation of the refinement criteria and of the measured costs, so the mesh
+//! and its partitioning evolve identically in both runs, which is useful to profile
+//! changes to communication or kernels without AMR/load balancing noise.
+//!
+//! The record is a text file with one line per event:
+//!   ncycle amr|lb nflag flag[0] ... flag[nflag-1] nmb rank[0] ... rank[nmb-1]
+//! where the flags are the refinement flags of all MBs before the tree is updated (no
+//! flags are stored for load balancing events), and the ranks are the new rank of each
+//! MB after the event.
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "mesh.hpp"
+#include "mesh_refinement.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::ReadReplayFile()
+//! \brief Reads all events recorded in file fname.  Called by all ranks.
+
+void MeshRefinement::ReadReplayFile(const std::string &fname) {
+  std::ifstream file(fname);
+  if (!(file.is_open())) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "AMR replay file '" << fname << "' could not be opened" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::stringstream ss(line);
+    AMREvent event;
+    std::string type;
+    int nflag = 0, nrank = 0;
+    ss >> event.ncycle >> type >> nflag;
+    event.amr = (type == "amr");
+    event.flag.resize(nflag);
+    for (int n=0; n<nflag; ++n) {ss >> event.flag[n];}
+    ss >> nrank;
+    event.rank.resize(nrank);
+    for (int n=0; n<nrank; ++n) {ss >> event.rank[n];}
+    if (ss.fail() || (type != "amr" && type != "lb")) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Could not parse line '" << line.substr(0, 40)
+                << "...' in AMR replay file '" << fname << "'" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    replay_events_.push_back(event);
+  }
+  replay_next_ = 0;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool MeshRefinement::ReplayEventThisCycle()
+//! \brief Returns true if the next recorded event is of the given type (AMR if amr=true,
+//! otherwise load balancing) and occurred on the current cycle.  Events recorded before
+//! the current cycle (e.g. when replaying from a restart) are skipped.
+
+bool MeshRefinement::ReplayEventThisCycle(bool amr) {
+  int ncycle = pmy_mesh->ncycle;
+  while (replay_next_ < replay_events_.size() &&
+         replay_events_[replay_next_].ncycle < ncycle) {
+    replay_next_++;
+  }
+  if (replay_next_ == replay_events_.size()) return false;
+  AMREvent &event = replay_events_[replay_next_];
+  return (event.ncycle == ncycle && event.amr == amr);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::ReplayRefinementFlags()
+//! \brief Sets refinement flags of all MBs from the current event, in place of
+//! CheckForRefinement().
+
+void MeshRefinement::ReplayRefinementFlags() {
+  AMREvent &event = replay_events_[replay_next_];
+  int nmb = pmy_mesh->nmb_total;
+  if (static_cast<int>(event.flag.size()) != nmb) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "AMR replay does not match this run: " << event.flag.size()
+              << " MeshBlocks recorded on cycle " << event.ncycle << " but " << nmb
+              << " exist" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  Kokkos::realloc(refine_flag, nmb);
+  for (int m=0; m<nmb; ++m) {refine_flag.h_view(m) = event.flag[m];}
+  refine_flag.template modify<HostMemSpace>();
+  refine_flag.template sync<DevExeSpace>();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::ReplayLoadBalance()
+//! \brief Sets rank of each of the nb new MBs from the current event, in place of
+//! Mesh::LoadBalance(), and computes the starting gid and number of MBs on each rank.
+
+void MeshRefinement::ReplayLoadBalance(int nb) {
+  AMREvent &event = replay_events_[replay_next_];
+  if (static_cast<int>(event.rank.size()) != nb) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "AMR replay does not match this run: " << event.rank.size()
+              << " MeshBlocks recorded after cycle " << event.ncycle << " but " << nb
+              << " created" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  for (int n=0; n<global_variable::nranks; ++n) {
+    new_gids_eachrank[n] = 0;
+    new_nmb_eachrank[n] = 0;
+  }
+  for (int i=0; i<nb; ++i) {
+    int r = event.rank[i];
+    if (r < 0 || r >= global_variable::nranks || (i > 0 && r < event.rank[i-1])) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "AMR replay does not match this run: invalid rank "
+                << r << " of MeshBlock " << i << " on cycle " << event.ncycle
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    new_rank_eachmb[i] = r;
+    new_nmb_eachrank[r]++;
+  }
+  for (int n=1; n<global_variable::nranks; ++n) {
+    new_gids_eachrank[n] = new_gids_eachrank[n-1] + new_nmb_eachrank[n-1];
+  }
+  replay_next_++;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::RecordEvent()
+//! \brief Appends the flags saved in AdaptiveMeshRefinement() (if amr=true) and the new
+//! rank of each of the nb new MBs to the record file.  Only the master rank writes the
+//! file.
+
+void MeshRefinement::RecordEvent(bool amr, int nb) {
+  if (global_variable::my_rank != 0) return;
+  FILE *pfile;
+  if ((pfile = std::fopen(record_file_.c_str(),"a")) == nullptr) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "AMR record file '" << record_file_ << "' could not be opened"
+              << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  std::fseek(pfile, 0, SEEK_END);
+  if (std::ftell(pfile) == 0) {
+    std::fprintf(pfile, "# AthenaK AMR/load balancing record\n");
+    std::fprintf(pfile, "# ncycle amr|lb nflag flags... nmb ranks...\n");
+  }
+  std::fprintf(pfile, "%d %s", pmy_mesh->ncycle, (amr)? "amr" : "lb");
+  int nflag = (amr)? static_cast<int>(record_flag_.size()) : 0;
+  std::fprintf(pfile, " %d", nflag);
+  for (int n=0; n<nflag; ++n) {std::fprintf(pfile, " %d", record_flag_[n]);}
+  std::fprintf(pfile, " %d", nb);
+  for (int i=0; i<nb; ++i) {std::fprintf(pfile, " %d", new_rank_eachmb[i]);}
+  std::fprintf(pfile, "\n");
+  std::fclose(pfile);
+  return;
+}
@@ -6,6 +6,7 @@
 //! \file build_tree.cpp
 //! \brief Functions to build MeshBlockTreee, both for new runs and restarts
 
+#include <algorithm>
 #include <iostream>
 #include <cinttypes>
 #include <limits> // numeric_limits<>
@@ -18,6 +19,7 @@
 #include "coordinates/cell_locations.hpp"
 #include "hydro/hydro.hpp"
 #include "mhd/mhd.hpp"
+#include "utils/memory_registry.hpp"
 
 #if MPI_PARALLEL_ENABLED
 #include <mpi.h>
@@ -76,24 +78,57 @@ void Mesh::BuildTreeFromScratch(ParameterInput *pin) {
 
     // cycle through ParameterInput list and find "refinement" blocks (SMR), extract data
     // Expand MeshBlockTree to include "refinement" regions specified in input file:
+    // Regions are either boxes (x1min..x3max), or spheres of given radius centered at
+    // (x1c,x2c,x3c) (default origin), which only refine MeshBlocks that intersect the
+    // sphere.  Nested spheres with radius halved on each level give a resolution
+    // proportional to radius, with fewer cells than nested boxes.
     for (auto it = pin->block.begin(); it != pin->block.end(); ++it) {
       if (it->block_name.compare(0, 10, "refinement") == 0) {
         RegionSize ref_size;
-        ref_size.x1min = pin->GetReal(it->block_name, "x1min");
-        ref_size.x1max = pin->GetReal(it->block_name, "x1max");
-        if (multi_d) {
-          ref_size.x2min = pin->GetReal(it->block_name, "x2min");
-          ref_size.x2max = pin->GetReal(it->block_name, "x2max");
-        } else {
+        bool sphere = pin->DoesParameterExist(it->block_name, "radius");
+        Real rad = 0.0, xc[3] = {0.0, 0.0, 0.0};
+        if (sphere) {
+          rad = pin->GetReal(it->block_name, "radius");
+          xc[0] = pin->GetOrAddReal(it->block_name, "x1c", 0.0);
+          xc[1] = (multi_d)? pin->GetOrAddReal(it->block_name, "x2c", 0.0) : 0.0;
+          xc[2] = (three_d)? pin->GetOrAddReal(it->block_name, "x3c", 0.0) : 0.0;
+          if (rad <= 0.0) {
+            std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Radius of refinement region must be > 0" << std::endl;
+            std::exit(EXIT_FAILURE);
+          }
+          // bounding box of sphere, clipped to root mesh
+          ref_size.x1min = std::max(xc[0] - rad, mesh_size.x1min);
+          ref_size.x1max = std::min(xc[0] + rad, mesh_size.x1max);
           ref_size.x2min = mesh_size.x2min;
           ref_size.x2max = mesh_size.x2max;
-        }
-        if (three_d) {
-          ref_size.x3min = pin->GetReal(it->block_name, "x3min");
-          ref_size.x3max = pin->GetReal(it->block_name, "x3max");
-        } else {
           ref_size.x3min = mesh_size.x3min;
           ref_size.x3max = mesh_size.x3max;
+          if (multi_d) {
+            ref_size.x2min = std::max(xc[1] - rad, mesh_size.x2min);
+            ref_size.x2max = std::min(xc[1] + rad, mesh_size.x2max);
+          }
+          if (three_d) {
+            ref_size.x3min = std::max(xc[2] - rad, mesh_size.x3min);
+            ref_size.x3max = std::min(xc[2] + rad, mesh_size.x3max);
+          }
+        } else {
+          ref_size.x1min = pin->GetReal(it->block_name, "x1min");
+          ref_size.x1max = pin->GetReal(it->block_name, "x1max");
+          if (multi_d) {
+            ref_size.x2min = pin->GetReal(it->block_name, "x2min");
+            ref_size.x2max = pin->GetReal(it->block_name, "x2max");
+          } else {
+            ref_size.x2min = mesh_size.x2min;
+            ref_size.x2max = mesh_size.x2max;
+          }
+          if (three_d) {
+            ref_size.x3min = pin->GetReal(it->block_name, "x3min");
+            ref_size.x3max = pin->GetReal(it->block_name, "x3max");
+          } else {
+            ref_size.x3min = mesh_size.x3min;
+            ref_size.x3max = mesh_size.x3max;
+          }
         }
         int phy_ref_lev = pin->GetInteger(it->block_name, "level");
         int log_ref_lev = phy_ref_lev + root_level;
@@ -183,9 +218,34 @@ void Mesh::BuildTreeFromScratch(ParameterInput *pin) {
           if (lx3max % 2 == 0) lx3max++;
         }
 
+        // for spheres, returns true if pair of MeshBlocks starting at (i,j,k) (which
+        // share a parent) intersects the sphere, by distance from center to their box
+        std::int32_t nlx1 = nmb_rootx1*(1<<phy_ref_lev);
+        std::int32_t nlx2 = nmb_rootx2*(1<<phy_ref_lev);
+        std::int32_t nlx3 = nmb_rootx3*(1<<phy_ref_lev);
+        auto in_region = [&](std::int32_t i, std::int32_t j, std::int32_t k) {
+          if (!(sphere)) return true;
+          Real d2 = 0.0;
+          Real xl = LeftEdgeX(i, nlx1, mesh_size.x1min, mesh_size.x1max);
+          Real xr = LeftEdgeX(i+2, nlx1, mesh_size.x1min, mesh_size.x1max);
+          d2 += SQR(std::max(std::max(xl - xc[0], xc[0] - xr), static_cast<Real>(0.0)));
+          if (multi_d) {
+            xl = LeftEdgeX(j, nlx2, mesh_size.x2min, mesh_size.x2max);
+            xr = LeftEdgeX(j+2, nlx2, mesh_size.x2min, mesh_size.x2max);
+            d2 += SQR(std::max(std::max(xl - xc[1], xc[1] - xr), static_cast<Real>(0.0)));
+          }
+          if (three_d) {
+            xl = LeftEdgeX(k, nlx3, mesh_size.x3min, mesh_size.x3max);
+            xr = LeftEdgeX(k+2, nlx3, mesh_size.x3min, mesh_size.x3max);
+            d2 += SQR(std::max(std::max(xl - xc[2], xc[2] - xr), static_cast<Real>(0.0)));
+          }
+          return (d2 < SQR(rad));
+        };
+
         // Now add nodes to the MeshBlockTree corresponding to these MeshBlocks
         if (one_d) {  // 1D
           for (std::int32_t i=lx1min; i<lx1max; i+=2) {
+            if (!(in_region(i, 0, 0))) continue;
             LogicalLocation nlloc;
             nlloc.level = log_ref_lev;
             nlloc.lx1 = i;
@@ -198,6 +258,7 @@ void Mesh::BuildTreeFromScratch(ParameterInput *pin) {
         if (two_d) {  // 2D
           for (std::int32_t j=lx2min; j<lx2max; j+=2) {
             for (std::int32_t i=lx1min; i<lx1max; i+=2) {
+              if (!(in_region(i, j, 0))) continue;
               LogicalLocation nlloc;
               nlloc.level = log_ref_lev;
               nlloc.lx1 = i;
@@ -212,6 +273,7 @@ void Mesh::BuildTreeFromScratch(ParameterInput *pin) {
           for (std::int32_t k=lx3min; k<lx3max; k+=2) {
             for (std::int32_t j=lx2min; j<lx2max; j+=2) {
               for (std::int32_t i=lx1min; i<lx1max; i+=2) {
+                if (!(in_region(i, j, k))) continue;
                 LogicalLocation nlloc;
                 nlloc.level = log_ref_lev;
                 nlloc.lx1 = i;
@@ -251,8 +313,8 @@ void Mesh::BuildTreeFromScratch(ParameterInput *pin) {
   }
 #endif
 
-  // initialize cost array with the simplest estimate; all the blocks are equal
-  // TODO(@user): implement variable cost per MeshBlock as needed
+  // initialize cost array with the simplest estimate; all the blocks are equal.  With
+  // <loadbalancing>/balancer=automatic costs are later updated using measured run times
   for (int i=0; i<nmb_total; i++) {cost_eachmb[i] = 1.0;}
   LoadBalance(cost_eachmb, rank_eachmb, gids_eachrank, nmb_eachrank, nmb_total);
 
@@ -285,25 +347,41 @@ void Mesh::BuildTreeFromScratch(ParameterInput *pin) {
         << std::endl;
       std::exit(EXIT_FAILURE);
     }
+  } else if (lb_automatic) {
+    // allow some headroom on uniform grids so MBs can be rebalanced using measured costs
+    nmb_maxperrank = pin->GetOrAddInteger("loadbalancing", "max_nmb_per_rank",
+                                          nmb_thisrank + (nmb_thisrank+3)/4);
+    if (nmb_maxperrank < nmb_thisrank) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+        << std::endl << "On rank=" << global_variable::my_rank << " Root grid requires "
+        << "more MeshBlocks (nmb_thisrank=" << nmb_thisrank << ") than specified by "
+        << "<loadbalancing>/max_nmb_per_rank=" << nmb_maxperrank << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
   }
 #if MPI_PARALLEL_ENABLED
-  if (nmb_maxperrank > (1 << (NUM_BITS_LID))) {
+  if (nmb_maxperrank > (1 << (global_variable::nbits_lid))) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
-      << "Maximum number of MeshBlocks per rank cannot exceed 2^(NUM_BITS_LID) due to MPI"
-      << " tag limits" << std::endl;
+      << "Maximum number of MeshBlocks per rank cannot exceed 2^"
+      << global_variable::nbits_lid << " due to MPI_TAG_UB of the MPI library"
+      << std::endl;
     std::exit(EXIT_FAILURE);
   }
 #endif
 
-  // Create new MeshRefinement object with either SMR or AMR (SMR needs Restrict fns)
-  if (multilevel) {
+  // Create new MeshRefinement object with either SMR or AMR (SMR needs Restrict fns), or
+  // with automatic load balancing (which uses AMR functions to redistribute MBs)
+  if (multilevel || lb_automatic) {
+    MemoryRegistry::PushTag("amr");
     pmr = new MeshRefinement(this, pin);
+    MemoryRegistry::PopTag();
   }
 
   // set initial time/cycle parameters, output diagnostics
   time = pin->GetOrAddReal("time", "start_time", 0.0);
   dt   = std::numeric_limits<float>::max();
   cfl_no = pin->GetReal("time", "cfl_number");
+  sts_max_dt_ratio = pin->GetOrAddReal("time", "sts_max_dt_ratio", -1.0);
   ncycle = 0;
   if (global_variable::my_rank == 0) {PrintMeshDiagnostics();}
 
@@ -338,7 +416,7 @@ void Mesh::BuildTreeFromRestart(ParameterInput *pin, IOWrapper &resfile) {
 
 #if MPI_PARALLEL_ENABLED
   // then broadcast the header data
-  MPI_Bcast(headerdata, headersize, MPI_CHAR, 0, MPI_COMM_WORLD);
+  MPI_Bcast(headerdata, headersize, MPI_CHAR, 0, global_variable::athena_comm);
 #endif
 
   // Now copy mesh data read from restart file into Mesh variables. Order of variables
@@ -402,7 +480,7 @@ void Mesh::BuildTreeFromRestart(ParameterInput *pin, IOWrapper &resfile) {
   }
 #if MPI_PARALLEL_ENABLED
   // then broadcast the ID list
-  MPI_Bcast(idlist, listsize*nmb_total, MPI_CHAR, 0, MPI_COMM_WORLD);
+  MPI_Bcast(idlist, listsize*nmb_total, MPI_CHAR, 0, global_variable::athena_comm);
 #endif
 
   // everyone sets the logical location and cost lists based on bradcasted data
@@ -425,16 +503,32 @@ void Mesh::BuildTreeFromRestart(ParameterInput *pin, IOWrapper &resfile) {
   for (int i=0; i<nmb_total; i++) {ptree->AddNodeWithoutRefinement(lloc_eachmb[i]);}
 
   // check the tree structure by making sure total # of MBs counted in tree same as the
-  // number read from the restart file.
+  // number read from the restart file.  The costs and MeshBlock data in the file are
+  // stored in the order in which the lloc list was written, so the tree must order the
+  // MBs in the same way (e.g. <loadbalancing>/sfc cannot be changed on restart).
   {
     int nnb;
-    ptree->CreateZOrderedLLList(lloc_eachmb, nullptr, nnb);
+    LogicalLocation *lloc_tree = new LogicalLocation[nmb_total];
+    ptree->CreateZOrderedLLList(lloc_tree, nullptr, nnb);
     if (nnb != nmb_total) {
       std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
         << std::endl << "Tree reconstruction failed. Total number of blocks in "
         << "reconstructed tree=" << nnb << ", number in file=" << nmb_total << std::endl;
       std::exit(EXIT_FAILURE);
     }
+    for (int i=0; i<nmb_total; i++) {
+      if (lloc_tree[i].lx1 != lloc_eachmb[i].lx1 ||
+          lloc_tree[i].lx2 != lloc_eachmb[i].lx2 ||
+          lloc_tree[i].lx3 != lloc_eachmb[i].lx3 ||
+          lloc_tree[i].level != lloc_eachmb[i].level) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+          << std::endl << "Order of MeshBlocks in reconstructed tree differs from order "
+          << "in restart file (MeshBlock " << i << "). <loadbalancing>/sfc must be the "
+          << "same as in the run that wrote the restart." << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+    }
+    delete [] lloc_tree;
   }
 
 #ifdef MPI_PARALLEL_ENABLED
@@ -455,6 +549,7 @@ void Mesh::BuildTreeFromRestart(ParameterInput *pin, IOWrapper &resfile) {
   nmb_thisrank = nmb_eachrank[global_variable::my_rank];
 
   pmb_pack = new MeshBlockPack(this, mbp_gids, mbp_gide);
+  nmb_packs_thisrank = 1;
   pmb_pack->AddMeshBlocks(pin);
   pmb_pack->pmb->SetNeighbors(ptree, rank_eachmb);
 
@@ -477,14 +572,29 @@ void Mesh::BuildTreeFromRestart(ParameterInput *pin, IOWrapper &resfile) {
         << std::endl;
       std::exit(EXIT_FAILURE);
     }
+  } else if (lb_automatic) {
+    // allow some headroom on uniform grids so MBs can be rebalanced using measured costs
+    nmb_maxperrank = pin->GetOrAddInteger("loadbalancing", "max_nmb_per_rank",
+                                          nmb_thisrank + (nmb_thisrank+3)/4);
+    if (nmb_maxperrank < nmb_thisrank) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+        << std::endl << "On rank=" << global_variable::my_rank << " Root grid requires "
+        << "more MeshBlocks (nmb_thisrank=" << nmb_thisrank << ") than specified by "
+        << "<loadbalancing>/max_nmb_per_rank=" << nmb_maxperrank << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
   }
 
-  // Create new MeshRefinement object with either SMR or AMR (SMR needs Restrict fns)
-  if (multilevel) {
+  // Create new MeshRefinement object with either SMR or AMR (SMR needs Restrict fns), or
+  // with automatic load balancing (which uses AMR functions to redistribute MBs)
+  if (multilevel || lb_automatic) {
+    MemoryRegistry::PushTag("amr");
     pmr = new MeshRefinement(this, pin);
+    MemoryRegistry::PopTag();
   }
 
   // set remaining parameters, output diagnostics
   cfl_no = pin->GetReal("time", "cfl_number");
+  sts_max_dt_ratio = pin->GetOrAddReal("time", "sts_max_dt_ratio", -1.0);
   if (global_variable::my_rank == 0) {PrintMeshDiagnostics();}
 }
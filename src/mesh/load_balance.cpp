@@ -7,10 +7,16 @@
 //! \brief Contains various Mesh and MeshRefinement functions associated with
 //! load balancing when MPI is used, both for uniform grids and with SMR/AMR.
 
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <limits> // numeric_limits<>
+#include <sstream>
+#include <string>
 #include <algorithm> // max
 #include <utility> // make_pair
+#include <vector>
 
 #include "athena.hpp"
 #include "globals.hpp"
@@ -18,11 +24,99 @@
 #include "hydro/hydro.hpp"
 #include "mhd/mhd.hpp"
 #include "z4c/z4c.hpp"
+#include "coordinates/coordinates.hpp"
+#include "dyn_grmhd/dyn_grmhd.hpp"
+#include "radiation/radiation.hpp"
+#include "particles/particles.hpp"
+#include "utils/memory_registry.hpp"
 
 #if MPI_PARALLEL_ENABLED
 #include <mpi.h>
 #endif
 
+//----------------------------------------------------------------------------------------
+//! \fn void PartitionCostList()
+//! \brief Divides list of nb MeshBlocks with costs clist into ng contiguous ranges with
+//! cost proportional to weights wlist (uniform weights if wlist=nullptr), e.g. the number
+//! of ranks on each node, or the measured speed of each rank.  Group of each MB is
+//! returned in glist.  Ranges are filled starting from the end of the list, so that
+//! group 0 (e.g. master MPI rank) has the least load.
+
+namespace {
+void PartitionCostList(const float *clist, int nb, const float *wlist, int ng,
+                       int *glist) {
+  float totalcost = 0.0;
+  for (int i=0; i<nb; i++) {totalcost += clist[i];}
+  float totalw = 0.0;
+  for (int n=0; n<ng; n++) {totalw += (wlist == nullptr) ? 1.0 : wlist[n];}
+
+  int j = ng - 1;
+  float wj = (wlist == nullptr) ? 1.0 : wlist[j];
+  float targetcost = totalcost*wj/totalw;
+  float mycost = 0.0;
+  for (int i=nb-1; i>=0; i--) {
+    if (targetcost == 0.0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "There is at least one process which has no MeshBlock"
+                << std::endl << "Decrease the number of processes or use smaller "
+                << "MeshBlocks." << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    mycost += clist[i];
+    glist[i] = j;
+    if (mycost >= targetcost && j>0) {
+      j--;
+      totalcost -= mycost;
+      totalw -= wj;
+      wj = (wlist == nullptr) ? 1.0 : wlist[j];
+      mycost = 0.0;
+      targetcost = totalcost*wj/totalw;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool FitClassCosts()
+//! \brief Solves the nc x nc normal equations a*w = b (a stored by rows, overwritten) of
+//! the least-squares fit of the cost w of a MB in each class to the times measured on all
+//! ranks, by Gaussian elimination with partial pivoting.  Classes with no MBs (zero
+//! diagonal) are given w=1.  Returns false if the system is singular (e.g. every rank
+//! has MBs of the classes in the same ratio) or the fit gives a cost that is not
+//! positive.
+
+bool FitClassCosts(double *a, double *b, int nc, double *w) {
+  double scale = 0.0;
+  for (int i=0; i<nc; ++i) {
+    scale = std::max(scale, a[i*nc + i]);
+    if (a[i*nc + i] == 0.0) {
+      for (int j=0; j<nc; ++j) {a[i*nc + j] = (i == j)? 1.0 : 0.0;}
+      b[i] = 1.0;
+    }
+  }
+  for (int k=0; k<nc; ++k) {
+    int p = k;
+    for (int i=k+1; i<nc; ++i) {
+      if (std::abs(a[i*nc + k]) > std::abs(a[p*nc + k])) {p = i;}
+    }
+    if (std::abs(a[p*nc + k]) <= 1.0e-12*scale) return false;
+    for (int j=0; j<nc; ++j) {std::swap(a[k*nc + j], a[p*nc + j]);}
+    std::swap(b[k], b[p]);
+    for (int i=k+1; i<nc; ++i) {
+      double f = a[i*nc + k]/a[k*nc + k];
+      for (int j=k; j<nc; ++j) {a[i*nc + j] -= f*a[k*nc + j];}
+      b[i] -= f*b[k];
+    }
+  }
+  for (int i=nc-1; i>=0; --i) {
+    double s = b[i];
+    for (int j=i+1; j<nc; ++j) {s -= a[i*nc + j]*w[j];}
+    w[i] = s/a[i*nc + i];
+    if (!(w[i] > 0.0)) return false;
+  }
+  return true;
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------
 //! \fn void Mesh::LoadBalance(double *clist, int *rlist, int *slist, int *nlist, int nb)
 //! \brief Calculate distribution of MeshBlocks across ranks based on input cost list
@@ -33,40 +127,56 @@
 //!         nlist = number of MBs on each rank (array of length nrank)
 //! With multiple ranks in MPI, this function is needed even on a uniform mesh and not
 //! just for SMR/AMR, which is why it is part of the Mesh and not MeshRefinement class.
+//! With <loadbalancing>/partitioner=topology, contiguous ranges of MBs are first assigned
+//! to each node (weighted by the number of ranks on the node), and then divided between
+//! ranks on that node, so that MBs which are neighbors along the space-filling curve (and
+//! therefore mostly neighbors in space) communicate within a node.
+//! With <loadbalancing>/rank_speed, the cost assigned to each rank (and node) is
+//! proportional to its measured speed rather than equal.
 
 void Mesh::LoadBalance(float *clist, int *rlist, int *slist, int *nlist, int nb) {
   float min_cost = std::numeric_limits<float>::max();
-  float max_cost = 0.0, totalcost = 0.0;
-  // find min/max and total cost in clist
+  float max_cost = 0.0;
+  // find min/max cost in clist
   for (int i=0; i<nb; i++) {
-    totalcost += clist[i];
     min_cost = std::min(min_cost,clist[i]);
     max_cost = std::max(max_cost,clist[i]);
   }
 
-  int j = (global_variable::nranks) - 1;
-  float targetcost = totalcost/global_variable::nranks;
-  float mycost = 0.0;
-  // create rank list from the end: the master MPI rank should have less load
-  for (int i=nb-1; i>=0; i--) {
-    if (targetcost == 0.0) {
-      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                << std::endl << "There is at least one process which has no MeshBlock"
-                << std::endl << "Decrease the number of processes or use smaller "
-                << "MeshBlocks." << std::endl;
-      std::exit(EXIT_FAILURE);
+  // weight of each rank is its relative speed, or uniform
+  const float *wrank = (lb_weighted) ? speed_eachrank : nullptr;
+  if (lb_topology && nnodes > 1) {
+    // assign ranges of MBs to nodes (weighted by total weight of ranks on each node),
+    // then divide range on each node between its ranks
+    float *wnode = new float[nnodes];
+    int rs = 0;
+    for (int k=0; k<nnodes; k++) {
+      wnode[k] = 0.0;
+      for (int r=rs; r<rs+nrank_eachnode[k]; r++) {
+        wnode[k] += (wrank == nullptr) ? 1.0 : wrank[r];
+      }
+      rs += nrank_eachnode[k];
     }
-    mycost += clist[i];
-    rlist[i] = j;
-    if (mycost >= targetcost && j>0) {
-      j--;
-      totalcost -= mycost;
-      mycost = 0.0;
-      targetcost = totalcost/(j+1);
+    PartitionCostList(clist, nb, wnode, nnodes, rlist);
+    delete [] wnode;
+    int ib = 0;
+    rs = 0;
+    for (int k=0; k<nnodes; k++) {
+      int ie = ib;
+      while (ie < nb && rlist[ie] == k) {ie++;}
+      const float *wnode_ranks = (wrank == nullptr) ? nullptr : &(wrank[rs]);
+      PartitionCostList(&(clist[ib]), (ie-ib), wnode_ranks, nrank_eachnode[k],
+                        &(rlist[ib]));
+      for (int i=ib; i<ie; i++) {rlist[i] += rs;}
+      rs += nrank_eachnode[k];
+      ib = ie;
     }
+  } else {
+    PartitionCostList(clist, nb, wrank, global_variable::nranks, rlist);
   }
+
   slist[0] = 0;
-  j = 0;
+  int j = 0;
   for (int i=1; i<nb; i++) { // make the list of nbstart and nblocks
     if (rlist[i] != rlist[i-1]) {
       nlist[j] = i-slist[j];
@@ -74,10 +184,17 @@ void Mesh::LoadBalance(float *clist, int *rlist, int *slist, int *nlist, int nb)
     }
   }
   nlist[j] = nb-slist[j];
+  if (j != (global_variable::nranks - 1)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "There is at least one process which has no MeshBlock"
+              << std::endl << "Decrease the number of processes or use smaller "
+              << "MeshBlocks." << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
 
 #if MPI_PARALLEL_ENABLED
-  if (nb % global_variable::nranks != 0
-     && !adaptive && max_cost == min_cost && global_variable::my_rank == 0) {
+  if (nb % global_variable::nranks != 0 && !adaptive && !lb_weighted
+     && max_cost == min_cost && global_variable::my_rank == 0) {
     std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
               << "Number of MeshBlocks cannot be divided evenly by number of MPI ranks. "
               << "This will result in poor load balancing." << std::endl;
@@ -86,6 +203,424 @@ void Mesh::LoadBalance(float *clist, int *rlist, int *slist, int *nlist, int nb)
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::FindNodeTopology()
+//! \brief Finds number of nodes (shared-memory domains) and number of ranks on each node
+//! for topology-aware load balancing.  Requires ranks to be numbered contiguously on
+//! each node (the default placement for most MPI launchers); otherwise the topology is
+//! ignored and MBs are partitioned across ranks only.
+
+void Mesh::FindNodeTopology() {
+  nnodes = 1;
+  nrank_eachnode = new int[global_variable::nranks];
+  nrank_eachnode[0] = global_variable::nranks;
+#if MPI_PARALLEL_ENABLED
+  if (!lb_topology) return;
+  // lowest rank on each node is used to label the node
+  MPI_Comm node_comm;
+  MPI_Comm_split_type(global_variable::athena_comm, MPI_COMM_TYPE_SHARED,
+                      global_variable::my_rank, MPI_INFO_NULL, &node_comm);
+  int node_label = global_variable::my_rank;
+  MPI_Bcast(&node_label, 1, MPI_INT, 0, node_comm);
+  MPI_Comm_free(&node_comm);
+  int *label_eachrank = new int[global_variable::nranks];
+  MPI_Allgather(&node_label, 1, MPI_INT, label_eachrank, 1, MPI_INT,
+                global_variable::athena_comm);
+
+  bool contiguous = true;
+  nrank_eachnode[0] = 1;
+  for (int r=1; r<global_variable::nranks; r++) {
+    if (label_eachrank[r] != label_eachrank[r-1]) {
+      if (label_eachrank[r] != r) {contiguous = false;}
+      nrank_eachnode[nnodes++] = 1;
+    } else {
+      nrank_eachnode[nnodes-1]++;
+    }
+  }
+  delete [] label_eachrank;
+  if (!contiguous) {
+    nnodes = 1;
+    nrank_eachnode[0] = global_variable::nranks;
+    if (global_variable::my_rank == 0) {
+      std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+                << "MPI ranks are not numbered contiguously on each node, "
+                << "<loadbalancing>/partitioner=topology will be ignored" << std::endl;
+    }
+  }
+#endif
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::UpdateCostList()
+//! \brief Updates cost of each MeshBlock using wall-clock time measured in the tasks
+//! flagged for timing in the TaskLists (fluxes, updates, source terms, C2P, etc.).
+//! Since tasks operate on all MBs in a MeshBlockPack at once, the time of individual MBs
+//! cannot be measured.  Instead MBs are sorted into classes by the work done on them
+//! (full update, fluid not evolved since the MB holds only atmosphere, or every cell
+//! excised), the cost of a MB in each class is fitted (least squares) to the times and
+//! number of MBs of each class on all ranks, and the time measured on each rank is
+//! divided between its MBs in proportion to these costs.  If the fit is not determined
+//! (e.g. one class only, or the same mix of classes on every rank) the time is divided
+//! equally between MBs on the rank.  Measured costs are normalized so
+//! that average cost of a MB is one, and then blended into the existing costs using an
+//! exponential moving average with weight set by <loadbalancing>/smoothing.
+//! With particles, the number of particles in each MB (normalized by the average number
+//! per MB) times <loadbalancing>/particle_weight is added to the normalized cost, so MBs
+//! are balanced on mesh work plus particle work.
+//! When ranks are weighted (rank_speed, rank_weights, or calibrate in <loadbalancing>),
+//! the time measured on each rank is first multiplied by the relative speed of the rank,
+//! so that costs measure the work in each MB independent of the speed of the rank on
+//! which it was run.
+
+void Mesh::UpdateCostList() {
+  // sum time accumulated in all TaskLists on this rank since last update, and reset
+  double time_thisrank = 0.0;
+  for (auto &it : pmb_pack->tl_map) {
+    time_thisrank += it.second->GetLBTime();
+    it.second->ResetLBTime();
+  }
+  if (lb_rank_speed) {UpdateRankSpeed(time_thisrank);}
+  if (lb_weighted) {
+    time_thisrank *= static_cast<double>(speed_eachrank[global_variable::my_rank]);
+  }
+
+  // sort MBs on this rank into classes: 0 = full update, 1 = fluid not evolved (only
+  // atmosphere), 2 = every cell excised
+  const int nclass = 3;
+  int *class_eachmb = new int[nmb_thisrank];
+  for (int m=0; m<nmb_thisrank; ++m) {class_eachmb[m] = 0;}
+  if (pmb_pack->pdyngr != nullptr) {
+    for (int m=0; m<nmb_thisrank; ++m) {
+      if (!(pmb_pack->pdyngr->MeshBlockActive(m))) {class_eachmb[m] = 1;}
+    }
+  }
+  if (pmb_pack->pcoord->is_general_relativistic &&
+      pmb_pack->pcoord->coord_data.bh_excise) {
+    auto excised = Kokkos::create_mirror_view_and_copy(HostMemSpace(),
+                                                       pmb_pack->pcoord->excision_mb);
+    for (int m=0; m<nmb_thisrank; ++m) {
+      if (excised(m)) {class_eachmb[m] = 2;}
+    }
+  }
+
+  // normal equations of least-squares fit of cost of each class, summed over ranks
+  double nmb_class[nclass] = {0.0};
+  for (int m=0; m<nmb_thisrank; ++m) {nmb_class[class_eachmb[m]] += 1.0;}
+  double lsq[nclass*nclass + nclass];
+  for (int i=0; i<nclass; ++i) {
+    for (int j=0; j<nclass; ++j) {lsq[i*nclass + j] = nmb_class[i]*nmb_class[j];}
+    lsq[nclass*nclass + i] = nmb_class[i]*time_thisrank;
+  }
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, lsq, nclass*nclass + nclass, MPI_DOUBLE, MPI_SUM,
+                global_variable::athena_comm);
+#endif
+  int nclass_used = 0;
+  for (int i=0; i<nclass; ++i) {
+    if (lsq[i*nclass + i] > 0.0) {nclass_used++;}
+  }
+  double wclass[nclass] = {1.0, 1.0, 1.0};
+  if (nclass_used > 1 &&
+      !(FitClassCosts(lsq, &(lsq[nclass*nclass]), nclass, wclass))) {
+    for (int i=0; i<nclass; ++i) {wclass[i] = 1.0;}
+  }
+  double wsum = 0.0;
+  for (int m=0; m<nmb_thisrank; ++m) {wsum += wclass[class_eachmb[m]];}
+
+  float *new_cost = new float[nmb_total];
+  int gids = gids_eachrank[global_variable::my_rank];
+  for (int m=0; m<nmb_thisrank; ++m) {
+    new_cost[gids + m] = static_cast<float>(time_thisrank*wclass[class_eachmb[m]]/wsum);
+  }
+  delete [] class_eachmb;
+#if MPI_PARALLEL_ENABLED
+  MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, new_cost, nmb_eachrank,
+                 gids_eachrank, MPI_FLOAT, global_variable::athena_comm);
+#endif
+
+  float totalcost = 0.0;
+  for (int i=0; i<nmb_total; ++i) {totalcost += new_cost[i];}
+  // nothing was timed (e.g. no flagged tasks), so keep existing costs
+  bool has_cost = (totalcost > 0.0);
+  float norm = has_cost ? static_cast<float>(nmb_total)/totalcost : 0.0;
+  for (int i=0; i<nmb_total; ++i) {new_cost[i] *= norm;}
+
+  // add particle load of each MB
+  if (pmb_pack->ppart != nullptr && lb_prtcl_weight > 0.0) {
+    int *np_eachmb = new int[nmb_total];
+    pmb_pack->ppart->CountParticlesEachMB(&(np_eachmb[gids]));
+#if MPI_PARALLEL_ENABLED
+    MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, np_eachmb, nmb_eachrank,
+                   gids_eachrank, MPI_INT, global_variable::athena_comm);
+#endif
+    double np_total = 0.0;
+    for (int i=0; i<nmb_total; ++i) {np_total += static_cast<double>(np_eachmb[i]);}
+    if (np_total > 0.0) {
+      float pnorm = static_cast<float>(lb_prtcl_weight*nmb_total/np_total);
+      for (int i=0; i<nmb_total; ++i) {new_cost[i] += pnorm*np_eachmb[i];}
+      has_cost = true;
+    }
+    delete [] np_eachmb;
+  }
+
+  if (has_cost) {
+    for (int i=0; i<nmb_total; ++i) {
+      cost_eachmb[i] = (1.0 - lb_smoothing)*cost_eachmb[i] + lb_smoothing*new_cost[i];
+    }
+  }
+  delete [] new_cost;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::UpdateRankSpeed()
+//! \brief Estimates speed of each rank from the time it took to update MBs with known
+//! total cost (time per unit cost, relative to the average over ranks), and blends it
+//! into the existing speeds with the same exponential moving average as the costs.
+//! Speeds are normalized so their average is one.  A warning naming the host is printed
+//! when the speed of a rank first drops below 1 - <loadbalancing>/straggler_threshold.
+
+void Mesh::UpdateRankSpeed(double time_thisrank) {
+  int nranks = global_variable::nranks;
+  double work = 0.0;
+  int gids = gids_eachrank[global_variable::my_rank];
+  for (int m=0; m<nmb_thisrank; ++m) {work += cost_eachmb[gids + m];}
+  double *tpw = new double[nranks];
+  tpw[global_variable::my_rank] = (work > 0.0) ? time_thisrank/work : 0.0;
+#if MPI_PARALLEL_ENABLED
+  MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, tpw, 1, MPI_DOUBLE,
+                global_variable::athena_comm);
+#endif
+  // nothing was timed on some rank, so keep existing speeds
+  double tpw_mean = 0.0;
+  for (int r=0; r<nranks; ++r) {
+    if (tpw[r] <= 0.0) {delete [] tpw; return;}
+    tpw_mean += tpw[r]/nranks;
+  }
+
+  bool *was_slow = new bool[nranks];
+  float total = 0.0;
+  for (int r=0; r<nranks; ++r) {
+    was_slow[r] = (speed_eachrank[r] < 1.0 - lb_straggler);
+    float speed = static_cast<float>(tpw_mean/tpw[r]);
+    speed_eachrank[r] = (1.0 - lb_smoothing)*speed_eachrank[r] + lb_smoothing*speed;
+    total += speed_eachrank[r];
+  }
+  bool new_slow = false;
+  for (int r=0; r<nranks; ++r) {
+    speed_eachrank[r] *= static_cast<float>(nranks)/total;
+    if (speed_eachrank[r] < 1.0 - lb_straggler && !(was_slow[r])) {new_slow = true;}
+  }
+
+  // speeds are identical on all ranks, so all ranks take part in gathering host names
+  if (new_slow) {
+    char host[64] = "unknown";
+    char *host_eachrank = new char[64*nranks];
+#if MPI_PARALLEL_ENABLED
+    int len;
+    char name[MPI_MAX_PROCESSOR_NAME];
+    MPI_Get_processor_name(name, &len);
+    std::snprintf(host, sizeof(host), "%s", name);
+    MPI_Allgather(host, 64, MPI_CHAR, host_eachrank, 64, MPI_CHAR,
+                  global_variable::athena_comm);
+#else
+    std::snprintf(host_eachrank, 64, "%s", host);
+#endif
+    for (int r=0; r<nranks; ++r) {
+      if (global_variable::my_rank == 0 && speed_eachrank[r] < 1.0 - lb_straggler &&
+          !(was_slow[r])) {
+        std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+                  << "Rank " << r << " on host " << &(host_eachrank[64*r])
+                  << " is running at " << 100.0*speed_eachrank[r] << "% of the "
+                  << "average speed on cycle " << ncycle << ", MeshBlocks will be "
+                  << "shifted to other ranks" << std::endl;
+      }
+    }
+    delete [] host_eachrank;
+  }
+  delete [] was_slow;
+  delete [] tpw;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::SetRankWeights()
+//! \brief Sets relative speed of each rank from comma-separated list of weights given
+//! by <loadbalancing>/rank_weights (e.g. "1.0,1.0,2.5,2.5").  If the list is shorter
+//! than the number of ranks it is repeated, so that e.g. "1,3" weights every second rank
+//! by three.  Weights are normalized so their average is one.
+
+void Mesh::SetRankWeights(const std::string &wlist) {
+  std::vector<float> w;
+  std::stringstream ss(wlist);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    char *end;
+    float value = std::strtof(item.c_str(), &end);
+    if (end == item.c_str() || value <= 0.0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<loadbalancing>/rank_weights = '" << wlist << "' must "
+                << "be a comma-separated list of positive numbers" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    w.push_back(value);
+  }
+  int nranks = global_variable::nranks;
+  float total = 0.0;
+  for (int r=0; r<nranks; ++r) {
+    speed_eachrank[r] = w[r % w.size()];
+    total += speed_eachrank[r];
+  }
+  for (int r=0; r<nranks; ++r) {speed_eachrank[r] *= static_cast<float>(nranks)/total;}
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::CalibrateRankSpeed()
+//! \brief Measures relative speed of each rank at startup by timing a short kernel of
+//! ncalib streaming fused multiply-adds on the device, and sets speed_eachrank from the
+//! inverse of the times (normalized so the average is one).  Only a rough estimate of
+//! the capacity of each rank, that is refined by rank_speed if it is also enabled.
+
+void Mesh::CalibrateRankSpeed(int ncalib) {
+  int nranks = global_variable::nranks;
+  DvceArray1D<Real> a("calib_a", ncalib), b("calib_b", ncalib);
+  Kokkos::deep_copy(a, 1.0);
+  Kokkos::deep_copy(b, 0.0);
+  const int nrep = 5;
+  double time = 0.0;
+  // first pass is untimed warm-up
+  for (int n=0; n<=nrep; ++n) {
+    Kokkos::fence();
+    Kokkos::Timer timer;
+    par_for("lb_calibrate", DevExeSpace(), 0, (ncalib-1),
+    KOKKOS_LAMBDA(const int i) {
+      Real x = a(i), y = b(i);
+      for (int k=0; k<32; ++k) {y = x*y + 0.5;}
+      b(i) = y;
+    });
+    Kokkos::fence();
+    if (n > 0) {time += timer.seconds();}
+  }
+
+  speed_eachrank[global_variable::my_rank] = static_cast<float>(nrep/time);
+#if MPI_PARALLEL_ENABLED
+  MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, speed_eachrank, 1, MPI_FLOAT,
+                global_variable::athena_comm);
+#endif
+  float total = 0.0;
+  for (int r=0; r<nranks; ++r) {total += speed_eachrank[r];}
+  for (int r=0; r<nranks; ++r) {speed_eachrank[r] *= static_cast<float>(nranks)/total;}
+  if (global_variable::my_rank == 0) {
+    float smin = speed_eachrank[0], smax = speed_eachrank[0];
+    for (int r=1; r<nranks; ++r) {
+      smin = std::min(smin, speed_eachrank[r]);
+      smax = std::max(smax, speed_eachrank[r]);
+    }
+    std::cout << "Calibrated relative speed of ranks: min=" << smin << " max=" << smax
+              << std::endl;
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn float Mesh::CostImbalance()
+//! \brief Returns fractional imbalance in cost across ranks, defined as
+//! (maximum cost on any rank)/(average cost per rank) - 1.  When ranks
+//! are weighted, the cost on each rank is divided by its relative speed.
+
+float Mesh::CostImbalance() {
+  float *cost_eachrank = new float[global_variable::nranks];
+  for (int n=0; n<global_variable::nranks; ++n) {cost_eachrank[n] = 0.0;}
+  float totalcost = 0.0;
+  for (int i=0; i<nmb_total; ++i) {
+    cost_eachrank[rank_eachmb[i]] += cost_eachmb[i];
+    totalcost += cost_eachmb[i];
+  }
+  float maxcost = 0.0;
+  for (int n=0; n<global_variable::nranks; ++n) {
+    if (lb_weighted) {cost_eachrank[n] /= speed_eachrank[n];}
+    maxcost = std::max(maxcost, cost_eachrank[n]);
+  }
+  delete [] cost_eachrank;
+  if (totalcost <= 0.0) return 0.0;
+  return maxcost*static_cast<float>(global_variable::nranks)/totalcost - 1.0;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::RebalanceMeshBlocks()
+//! \brief Driver function for automatic load balancing.  Updates measured costs of each
+//! MeshBlock, and if the imbalance across ranks exceeds <loadbalancing>/tolerance,
+//! redistributes MeshBlocks across ranks using the same functions as AMR (but without
+//! any refinement), then sets boundary conditions/timestep on the new distribution.
+
+void MeshRefinement::RebalanceMeshBlocks(Driver *pdriver, ParameterInput *pin) {
+  Mesh* pm = pmy_mesh;
+  pm->UpdateCostList();
+  MeshBlockPack* pmbp = pm->pmb_pack;
+  if (replay_amr) {
+    // when replaying, rebalance only on cycles rebalanced in the recorded run
+    if (!(ReplayEventThisCycle(false))) return;
+  } else {
+    float imbalance = pm->CostImbalance();
+    if (imbalance <= pm->lb_tolerance) return;
+
+    // Radiation data is not yet communicated by the AMR load balancing functions, so
+    // MBs are never redistributed with radiation (a warning is printed at startup)
+    if (pmbp->prad != nullptr) return;
+
+    // compute trial distribution, and rebalance only if MBs move and new distribution
+    // fits within memory on every rank
+    int *rlist = new int[pm->nmb_total];
+    int *slist = new int[global_variable::nranks];
+    int *nlist = new int[global_variable::nranks];
+    pm->LoadBalance(pm->cost_eachmb, rlist, slist, nlist, pm->nmb_total);
+    int nmoved = 0;
+    for (int i=0; i<pm->nmb_total; ++i) {
+      if (rlist[i] != pm->rank_eachmb[i]) {nmoved++;}
+    }
+    int toolarge = (nlist[global_variable::my_rank] > pm->nmb_maxperrank) ? 1 : 0;
+    delete [] rlist;
+    delete [] slist;
+    delete [] nlist;
+#if MPI_PARALLEL_ENABLED
+    MPI_Allreduce(MPI_IN_PLACE, &toolarge, 1, MPI_INT, MPI_MAX,
+                  global_variable::athena_comm);
+#endif
+    if (nmoved == 0) return;
+    if (toolarge != 0) {
+      if (global_variable::my_rank == 0) {
+        std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "Load balancing skipped on cycle " << pm->ncycle
+                  << " since new distribution exceeds max_nmb_per_rank on at least one "
+                  << "rank" << std::endl;
+      }
+      return;
+    }
+  }
+
+  MemoryRegistry::PushTag("amr");
+  RedistAndRefineMeshBlocks(pin, 0, 0);
+  MemoryRegistry::PopTag();
+  // particles are not moved by RedistAndRefineMeshBlocks, so send them to new owners
+  if (pmbp->ppart != nullptr) {
+    pmbp->ppart->RedistributeParticles();
+  }
+  pdriver->InitBoundaryValuesAndPrimitives(pm);
+
+  if (pmbp->phydro != nullptr) {
+    (void) pmbp->phydro->NewTimeStep(pdriver, pdriver->nexp_stages);
+  }
+  if (pmbp->pmhd != nullptr) {
+    (void) pmbp->pmhd->NewTimeStep(pdriver, pdriver->nexp_stages);
+  }
+  if (pmbp->pz4c != nullptr) {
+    (void) pmbp->pz4c->NewTimeStep(pdriver, pdriver->nexp_stages);
+  }
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void MeshRefinement::InitRecvAMR()
 //! \brief Allocates and initializes receive buffers, and posts non-blocking receives,
@@ -127,11 +662,8 @@ void MeshRefinement::InitRecvAMR(int nleaf) {
   if (nmb_recv == 0) return;  // nothing to do
 
   // allocate array of recv buffers
-  Kokkos::realloc(recvbuf, nmb_recv);
-  recv_req = new MPI_Request[nmb_recv];
-  for (int n=0; n<nmb_recv; ++n) {
-    recv_req[n] = MPI_REQUEST_NULL;
-  }
+  if (recvbuf.extent_int(0) < nmb_recv) {Kokkos::realloc(recvbuf, nmb_recv);}
+  recv_req.assign(nmb_recv, MPI_REQUEST_NULL);
 
   // count number of cell- and face-centered variables communicated depending on physics
   int ncc_tosend=0, nfc_tosend=0;
@@ -253,12 +785,15 @@ void MeshRefinement::InitRecvAMR(int nleaf) {
       }
     }
   }
-  // Sync dual array, reallocate receive data array
+  // Sync dual array, grow receive data array if needed
   recvbuf.template modify<HostMemSpace>();
   recvbuf.template sync<DevExeSpace>();
   {
     int ndata = recvbuf.h_view((nmb_recv-1)).offset + recvbuf.h_view((nmb_recv-1)).cnt;
-    Kokkos::realloc(recv_data, ndata);
+    if (recv_data.extent_int(0) < ndata) {
+      Kokkos::realloc(recv_data, ndata);
+      recv_data_mpi = Kokkos::create_mirror_view(MPIBuffMemSpace(), recv_data);
+    }
   }
 
   // Step 3. (InitRecvAMR)
@@ -281,7 +816,7 @@ void MeshRefinement::InitRecvAMR(int nleaf) {
           int ox3 = ((lloc.lx3 & 1) == 1);
           int vs = recvbuf.h_view(rb_idx).offset;
           int ve = vs + recvbuf.h_view(rb_idx).cnt + 1;
-          auto pdata = Kokkos::subview(recv_data, std::make_pair(vs,ve));
+          auto pdata = Kokkos::subview(recv_data_mpi, std::make_pair(vs,ve));
           // create tag using local ID of *receiving* MeshBlock, post receive
           int tag = CreateAMR_MPI_Tag(newm-nmbs, ox1, ox2, ox3);
           // post non-blocking receive
@@ -296,7 +831,7 @@ void MeshRefinement::InitRecvAMR(int nleaf) {
       if (pmy_mesh->rank_eachmb[oldm] != global_variable::my_rank) {
         int vs = recvbuf.h_view(rb_idx).offset;
         int ve = vs + recvbuf.h_view(rb_idx).cnt + 1;
-        auto pdata = Kokkos::subview(recv_data, std::make_pair(vs,ve));
+        auto pdata = Kokkos::subview(recv_data_mpi, std::make_pair(vs,ve));
         // create tag using local ID of *receiving* MeshBlock, post receive
         int tag = CreateAMR_MPI_Tag(newm-nmbs, 0, 0, 0);
         // post non-blocking receive
@@ -312,7 +847,7 @@ void MeshRefinement::InitRecvAMR(int nleaf) {
           (pmy_mesh->rank_eachmb[oldm] != global_variable::my_rank)) {
         int vs = recvbuf.h_view(rb_idx).offset;
         int ve = vs + recvbuf.h_view(rb_idx).cnt + 1;
-        auto pdata = Kokkos::subview(recv_data, std::make_pair(vs,ve));
+        auto pdata = Kokkos::subview(recv_data_mpi, std::make_pair(vs,ve));
         // create tag using local ID of *receiving* MeshBlock, post receive
         int tag = CreateAMR_MPI_Tag(newm-nmbs, 0, 0, 0);
         // post non-blocking receive
@@ -377,11 +912,8 @@ void MeshRefinement::PackAndSendAMR(int nleaf) {
   if (nmb_send == 0) return;  // nothing to do
 
   // allocate array of send buffers
-  Kokkos::realloc(sendbuf, nmb_send);
-  send_req = new MPI_Request[nmb_send];
-  for (int n=0; n<nmb_send; ++n) {
-    send_req[n] = MPI_REQUEST_NULL;
-  }
+  if (sendbuf.extent_int(0) < nmb_send) {Kokkos::realloc(sendbuf, nmb_send);}
+  send_req.assign(nmb_send, MPI_REQUEST_NULL);
 
   // count number of cell- and face-centered variables communicated depending on physics
   int ncc_tosend=0, nfc_tosend=0;
@@ -505,13 +1037,64 @@ void MeshRefinement::PackAndSendAMR(int nleaf) {
       }
     }
   }
-  // Sync dual array, reallocate send data array
+  // If sends are pipelined in chunks of lb_chunk_nmb buffers, then at most
+  // lb_pipeline_depth chunks are in flight at once.  Each chunk is packed into one of
+  // that many slots in send_data, so reset offsets relative to start of its slot.
+  int chunk_nmb = (lb_chunk_nmb > 0)? std::min(lb_chunk_nmb, nmb_send) : nmb_send;
+  int nchunk = (nmb_send + chunk_nmb - 1)/chunk_nmb;
+  int ndata = sendbuf.h_view((nmb_send-1)).offset + sendbuf.h_view((nmb_send-1)).cnt;
+  if (nchunk > lb_pipeline_depth) {
+    int slot_size = 0;
+    for (int c=0; c<nchunk; ++c) {
+      int sbs = c*chunk_nmb, sbe = std::min(sbs+chunk_nmb, nmb_send) - 1;
+      slot_size = std::max(slot_size, (sendbuf.h_view(sbe).offset +
+                           sendbuf.h_view(sbe).cnt - sendbuf.h_view(sbs).offset));
+    }
+    for (int c=0; c<nchunk; ++c) {
+      int sbs = c*chunk_nmb, sbe = std::min(sbs+chunk_nmb, nmb_send) - 1;
+      int shift = (c % lb_pipeline_depth)*slot_size - sendbuf.h_view(sbs).offset;
+      for (int n=sbs; n<=sbe; ++n) {sendbuf.h_view(n).offset += shift;}
+    }
+    ndata = lb_pipeline_depth*slot_size;
+  }
+
+  // Sync dual array, grow send data array if needed
   sendbuf.template modify<HostMemSpace>();
   sendbuf.template sync<DevExeSpace>();
-  {
-    int ndata = sendbuf.h_view((nmb_send-1)).offset + sendbuf.h_view((nmb_send-1)).cnt;
+  if (send_data.extent_int(0) < ndata) {
     Kokkos::realloc(send_data, ndata);
+    send_data_mpi = Kokkos::create_mirror_view(MPIBuffMemSpace(), send_data);
+  }
+
+  // Steps 3-4. (PackAndSendAMR)
+  // Pack and send each chunk, first waiting for sends of chunk that last used its slot
+  for (int c=0; c<nchunk; ++c) {
+    int sbs = c*chunk_nmb, sbe = std::min(sbs+chunk_nmb, nmb_send) - 1;
+    if (c >= lb_pipeline_depth) {
+      int ierr = MPI_Waitall(chunk_nmb, &(send_req[(c-lb_pipeline_depth)*chunk_nmb]),
+                             MPI_STATUSES_IGNORE);
+      if (ierr != MPI_SUCCESS) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "MPI error in pipelined sends with AMR" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+    }
+    PackAndSendChunkAMR(nleaf, sbs, sbe);
   }
+#endif
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::PackAndSendChunkAMR()
+//! \brief Packs data into send buffers with indices [sbs,sbe], and posts non-blocking
+//! sends for these buffers.  Called for each chunk of buffers by PackAndSendAMR() after
+//! send buffers are initialized.
+
+void MeshRefinement::PackAndSendChunkAMR(int nleaf, int sbs, int sbe) {
+#if MPI_PARALLEL_ENABLED
+  int ombs = pmy_mesh->gids_eachrank[global_variable::my_rank];
+  int ombe = ombs + pmy_mesh->nmb_eachrank[global_variable::my_rank] - 1;
 
   // Step 3. (PackAndSendAMR)
   // Pack data into send buffers in parallel
@@ -521,26 +1104,35 @@ void MeshRefinement::PackAndSendAMR(int nleaf) {
 
   int ncc_sent = 0, nfc_sent = 0;
   if (phydro != nullptr) {
-    PackAMRBuffersCC(phydro->u0, phydro->coarse_u0, ncc_sent, nfc_sent);
+    PackAMRBuffersCC(phydro->u0, phydro->coarse_u0, ncc_sent, nfc_sent, sbs, sbe);
     ncc_sent += phydro->nhydro;
   }
   if (pmhd != nullptr) {
-    PackAMRBuffersCC(pmhd->u0, pmhd->coarse_u0, ncc_sent, nfc_sent);
+    PackAMRBuffersCC(pmhd->u0, pmhd->coarse_u0, ncc_sent, nfc_sent, sbs, sbe);
     ncc_sent += pmhd->nmhd;
-    PackAMRBuffersFC(pmhd->b0, pmhd->coarse_b0, ncc_sent, nfc_sent);
+    PackAMRBuffersFC(pmhd->b0, pmhd->coarse_b0, ncc_sent, nfc_sent, sbs, sbe);
     nfc_sent += 1;
   }
   if (pz4c != nullptr) {
-    PackAMRBuffersCC(pz4c->u0, pz4c->coarse_u0, ncc_sent, nfc_sent);
+    PackAMRBuffersCC(pz4c->u0, pz4c->coarse_u0, ncc_sent, nfc_sent, sbs, sbe);
     ncc_sent += pz4c->nz4c;
   }
 
   // Step 4. (PackAndSendAMR)
   // loop over old MBs on this rank, send data using MPI non-blocking sends
   // Send requests will only be accessed on host, so no need to sync after this step.
+  // Without GPU-aware MPI, data of this chunk is first copied to host-pinned memory.
   Kokkos::fence();
+#if !(GPU_AWARE_MPI_ENABLED)
+  {
+    auto range = std::make_pair(sendbuf.h_view(sbs).offset,
+                                sendbuf.h_view(sbe).offset + sendbuf.h_view(sbe).cnt);
+    Kokkos::deep_copy(Kokkos::subview(send_data_mpi, range),
+                      Kokkos::subview(send_data, range));
+  }
+#endif
   bool no_errors=true;
-  sb_idx = 0;     // send buffer index
+  int sb_idx = 0;     // send buffer index
   for (int oldm=ombs; oldm<=ombe; oldm++) {
     int newm = oldtonew[oldm];
     LogicalLocation &old_lloc = pmy_mesh->lloc_eachmb[oldm];
@@ -550,54 +1142,60 @@ void MeshRefinement::PackAndSendAMR(int nleaf) {
         // send if refined MB changes rank, or if any leaf on different rank than root
         if ((new_rank_eachmb[newm] != global_variable::my_rank) ||
             (new_rank_eachmb[newm + l] != global_variable::my_rank)) {
-          int vs = sendbuf.h_view(sb_idx).offset;
-          int ve = vs + sendbuf.h_view(sb_idx).cnt + 1;
-          auto pdata = Kokkos::subview(send_data, std::make_pair(vs,ve));
-          // create tag using local ID of *receiving* MeshBlock
-          int lid = (newm + l) - new_gids_eachrank[new_rank_eachmb[newm+l]];
-          int tag = CreateAMR_MPI_Tag(lid, 0, 0, 0);
-          // post non-blocking send
-          int ierr = MPI_Isend(pdata.data(), sendbuf.h_view(sb_idx).cnt, MPI_ATHENA_REAL,
-                     new_rank_eachmb[newm+l], tag, amr_comm,
-                     &(send_req[sb_idx]));
-          if (ierr != MPI_SUCCESS) {no_errors=false;}
+          if (sb_idx >= sbs && sb_idx <= sbe) {
+            int vs = sendbuf.h_view(sb_idx).offset;
+            int ve = vs + sendbuf.h_view(sb_idx).cnt + 1;
+            auto pdata = Kokkos::subview(send_data_mpi, std::make_pair(vs,ve));
+            // create tag using local ID of *receiving* MeshBlock
+            int lid = (newm + l) - new_gids_eachrank[new_rank_eachmb[newm+l]];
+            int tag = CreateAMR_MPI_Tag(lid, 0, 0, 0);
+            // post non-blocking send
+            int ierr = MPI_Isend(pdata.data(), sendbuf.h_view(sb_idx).cnt,
+                       MPI_ATHENA_REAL, new_rank_eachmb[newm+l], tag, amr_comm,
+                       &(send_req[sb_idx]));
+            if (ierr != MPI_SUCCESS) {no_errors=false;}
+          }
           sb_idx++;
         }
       }
     } else {   // same level or de-refinement
       if (old_lloc.level == new_lloc.level) {   // old MB at same level
         if (new_rank_eachmb[newm] != global_variable::my_rank) {
-          int vs = sendbuf.h_view(sb_idx).offset;
-          int ve = vs + sendbuf.h_view(sb_idx).cnt + 1;
-          auto pdata = Kokkos::subview(send_data, std::make_pair(vs,ve));
-          // create tag using local ID of *receiving* MeshBlock
-          int lid = newm - new_gids_eachrank[new_rank_eachmb[newm]];
-          int tag = CreateAMR_MPI_Tag(lid, 0, 0, 0);
-          // post non-blocking send
-          int ierr = MPI_Isend(pdata.data(), sendbuf.h_view(sb_idx).cnt, MPI_ATHENA_REAL,
-                     new_rank_eachmb[newm], tag, amr_comm,
-                     &(send_req[sb_idx]));
-          if (ierr != MPI_SUCCESS) {no_errors=false;}
+          if (sb_idx >= sbs && sb_idx <= sbe) {
+            int vs = sendbuf.h_view(sb_idx).offset;
+            int ve = vs + sendbuf.h_view(sb_idx).cnt + 1;
+            auto pdata = Kokkos::subview(send_data_mpi, std::make_pair(vs,ve));
+            // create tag using local ID of *receiving* MeshBlock
+            int lid = newm - new_gids_eachrank[new_rank_eachmb[newm]];
+            int tag = CreateAMR_MPI_Tag(lid, 0, 0, 0);
+            // post non-blocking send
+            int ierr = MPI_Isend(pdata.data(), sendbuf.h_view(sb_idx).cnt,
+                       MPI_ATHENA_REAL, new_rank_eachmb[newm], tag, amr_comm,
+                       &(send_req[sb_idx]));
+            if (ierr != MPI_SUCCESS) {no_errors=false;}
+          }
           sb_idx++;
         }
       } else {                                  // old MB was de-refined
         // send whenever root MB changes rank, or if any leaf on different rank than root
         if ((pmy_mesh->rank_eachmb[newtoold[newm]] != global_variable::my_rank) ||
             (new_rank_eachmb[newm] != global_variable::my_rank)) {
-          int vs = sendbuf.h_view(sb_idx).offset;
-          int ve = vs + sendbuf.h_view(sb_idx).cnt + 1;
-          auto pdata = Kokkos::subview(send_data, std::make_pair(vs,ve));
-          // create tag using local ID of *receiving* MeshBlock
-          int ox1 = ((old_lloc.lx1 & 1) == 1);
-          int ox2 = ((old_lloc.lx2 & 1) == 1);
-          int ox3 = ((old_lloc.lx3 & 1) == 1);
-          int lid = newm - new_gids_eachrank[new_rank_eachmb[newm]];
-          int tag = CreateAMR_MPI_Tag(lid, ox1, ox2, ox3);
-          // post non-blocking send
-          int ierr = MPI_Isend(pdata.data(), sendbuf.h_view(sb_idx).cnt, MPI_ATHENA_REAL,
-                     new_rank_eachmb[newm], tag, amr_comm,
-                     &(send_req[sb_idx]));
-          if (ierr != MPI_SUCCESS) {no_errors=false;}
+          if (sb_idx >= sbs && sb_idx <= sbe) {
+            int vs = sendbuf.h_view(sb_idx).offset;
+            int ve = vs + sendbuf.h_view(sb_idx).cnt + 1;
+            auto pdata = Kokkos::subview(send_data_mpi, std::make_pair(vs,ve));
+            // create tag using local ID of *receiving* MeshBlock
+            int ox1 = ((old_lloc.lx1 & 1) == 1);
+            int ox2 = ((old_lloc.lx2 & 1) == 1);
+            int ox3 = ((old_lloc.lx3 & 1) == 1);
+            int lid = newm - new_gids_eachrank[new_rank_eachmb[newm]];
+            int tag = CreateAMR_MPI_Tag(lid, ox1, ox2, ox3);
+            // post non-blocking send
+            int ierr = MPI_Isend(pdata.data(), sendbuf.h_view(sb_idx).cnt,
+                       MPI_ATHENA_REAL, new_rank_eachmb[newm], tag, amr_comm,
+                       &(send_req[sb_idx]));
+            if (ierr != MPI_SUCCESS) {no_errors=false;}
+          }
           sb_idx++;
         }
       }
@@ -622,17 +1220,17 @@ void MeshRefinement::PackAndSendAMR(int nleaf) {
 //! PrepareSendFineToCoarseAMR() functions in amr_loadbalance.cpp
 
 void MeshRefinement::PackAMRBuffersCC(DvceArray5D<Real> &a, DvceArray5D<Real> &ca,
-                                      int ncc, int nfc) {
+                                      int ncc, int nfc, int sbs, int sbe) {
 #if MPI_PARALLEL_ENABLED
   auto &sbuf = sendbuf;
   auto &sdata = send_data;
   // Outer loop over (# of MeshBlocks sent)*(# of variables)
   int nvar = a.extent_int(1);  // TODO(@user): 2nd index from L of in array must be NVAR
-  int nnv = nmb_send*nvar;
+  int nnv = (sbe - sbs + 1)*nvar;
   Kokkos::TeamPolicy<> policy(DevExeSpace(), nnv, Kokkos::AUTO);
   Kokkos::parallel_for("SendBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-    const int n = (tmember.league_rank())/nvar;
-    const int v = (tmember.league_rank() - n*nvar);
+    const int n = (tmember.league_rank())/nvar + sbs;
+    const int v = (tmember.league_rank() - (n-sbs)*nvar);
 
     const int il = sbuf.d_view(n).bis;
     const int jl = sbuf.d_view(n).bjs;
@@ -671,16 +1269,16 @@ void MeshRefinement::PackAMRBuffersCC(DvceArray5D<Real> &a, DvceArray5D<Real> &c
 //! \brief Packs face-centered data into AMR communication buffers for all MBs being sent
 
 void MeshRefinement::PackAMRBuffersFC(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Real> &cb,
-                                      int ncc, int nfc) {
+                                      int ncc, int nfc, int sbs, int sbe) {
 #if MPI_PARALLEL_ENABLED
   auto &sbuf = sendbuf;
   auto &sdata = send_data;
   // Outer loop over (# of MeshBlocks sent)*(3 compnts of field)
-  int nn = 3*nmb_send;
+  int nn = 3*(sbe - sbs + 1);
   Kokkos::TeamPolicy<> policy(DevExeSpace(), nn, Kokkos::AUTO);
   Kokkos::parallel_for("SendBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-    const int n = (tmember.league_rank())/3;
-    const int v = (tmember.league_rank() - 3*n);
+    const int n = (tmember.league_rank())/3 + sbs;
+    const int v = (tmember.league_rank() - 3*(n-sbs));
 
     const int il = sbuf.d_view(n).bis;
     const int jl = sbuf.d_view(n).bjs;
@@ -796,7 +1394,15 @@ void MeshRefinement::ClearRecvAndUnpackAMR() {
               << std::endl;
     std::exit(EXIT_FAILURE);
   }
-  delete [] recv_req;
+#if !(GPU_AWARE_MPI_ENABLED)
+  // copy received data from host-pinned memory to device
+  if (nmb_recv > 0) {
+    auto range = std::make_pair(0, recvbuf.h_view(nmb_recv-1).offset +
+                                   recvbuf.h_view(nmb_recv-1).cnt);
+    Kokkos::deep_copy(Kokkos::subview(recv_data, range),
+                      Kokkos::subview(recv_data_mpi, range));
+  }
+#endif
 
   // Unpack data
   hydro::Hydro* phydro = pmy_mesh->pmb_pack->phydro;
@@ -1003,7 +1609,6 @@ void MeshRefinement::ClearSendAMR() {
               << std::endl;
     std::exit(EXIT_FAILURE);
   }
-  delete [] send_req;
 #endif
   return;
 }
@@ -17,6 +17,7 @@
 #include "globals.hpp"
 #include "parameter_input.hpp"
 #include "mesh.hpp"
+#include "mesh_locator.hpp"
 #include "coordinates/cell_locations.hpp"
 #include "hydro/hydro.hpp"
 #include "mhd/mhd.hpp"
@@ -28,6 +29,9 @@
 #include "particles/particles.hpp"
 #include "srcterms/srcterms.hpp"
 #include "outputs/io_wrapper.hpp"
+#include "utils/first_touch.hpp"
+#include "utils/managed_memory.hpp"
+#include "utils/memory_registry.hpp"
 
 #if MPI_PARALLEL_ENABLED
 #include <mpi.h>
@@ -48,10 +52,27 @@ Mesh::Mesh(ParameterInput *pin) :
   three_d(false),
   multi_d(false),
   strictly_periodic(true),
+  mesh_version(0),
   nmb_packs_thisrank(1),
   nprtcl_thisrank(0),
   nprtcl_total(0),
-  dtold(0.) {
+  dtold(0.),
+  dt_diff(std::numeric_limits<float>::max()),
+  dt_pending_(false),
+  dt_lag_valid_(false),
+  dt_violated_(false),
+  dt_sync_left_(0),
+  dt_lag_old_(std::numeric_limits<float>::max()) {
+  // track device memory allocated by each module (and boundary and AMR buffers), which
+  // is reported at startup, after each AMR event, and at the end of the run
+  if (pin->GetOrAddBoolean("job", "memory_report", false)) {MemoryRegistry::Enable();}
+  // report peak size of transient arrays checked out of the scratch pool at end of run
+  if (pin->GetOrAddBoolean("job", "scratch_report", false)) {scratch.EnableReport();}
+  // place MeshBlockPack arrays in NUMA domain of threads that update them (OpenMP only)
+  if (pin->GetOrAddBoolean("job", "numa_first_touch", false)) {FirstTouch::Enable();}
+  // allocate rarely used arrays in unified memory that can be oversubscribed (GPU only)
+  if (pin->GetOrAddBoolean("job", "managed_memory", false)) {ManagedMemory::Enable();}
+
   // Set physical size and number of cells in mesh (root level)
   mesh_size.x1min = pin->GetReal("mesh", "x1min");
   mesh_size.x1max = pin->GetReal("mesh", "x1max");
@@ -168,6 +189,42 @@ Mesh::Mesh(ParameterInput *pin) :
     mesh_bcs[BoundaryFace::outer_x3] = BoundaryFlag::undef;
   }
 
+  // Reflection symmetry about x3=0 (symmetry=bitant) or x1=0, x2=0 and x3=0 (octant),
+  // which requires the inner boundaries in those directions to be reflecting at zero
+  std::string symmetry = pin->GetOrAddString("mesh", "symmetry", "none");
+  if (symmetry != "none" && symmetry != "bitant" && symmetry != "octant") {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<mesh>/symmetry = '" << symmetry << "' must be 'none', 'bitant' or "
+              << "'octant'" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  symmetric[0] = symmetric[1] = (symmetry == "octant");
+  symmetric[2] = (symmetry != "none");
+  const BoundaryFace inner_face[3] = {BoundaryFace::inner_x1, BoundaryFace::inner_x2,
+                                      BoundaryFace::inner_x3};
+  const Real xmin[3] = {mesh_size.x1min, mesh_size.x2min, mesh_size.x3min};
+  symmetry_factor = 1.0;
+  for (int d=0; d<3; ++d) {
+    if (!(symmetric[d])) continue;
+    if (mesh_bcs[inner_face[d]] != BoundaryFlag::reflect || xmin[d] != 0.0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<mesh>/symmetry = '" << symmetry << "' requires a "
+                << "reflecting inner x" << d+1 << " boundary at x" << d+1 << "min = 0"
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    symmetry_factor *= 2.0;
+  }
+  // B is reflected as a vector (odd normal component) unless reflect_bfield=pseudovector
+  std::string reflect_b = pin->GetOrAddString("mesh", "reflect_bfield", "vector");
+  if (reflect_b != "vector" && reflect_b != "pseudovector") {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<mesh>/reflect_bfield = '" << reflect_b << "' must be 'vector' or "
+              << "'pseudovector'" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  reflect_b_pseudovector = (reflect_b == "pseudovector");
+
   // set boolean flags indicating type of refinement (if any), and whether mesh is
   // periodic, depending on input strings
   adaptive = (pin->GetOrAddString("mesh_refinement","refinement","none") == "adaptive")
@@ -175,6 +232,52 @@ Mesh::Mesh(ParameterInput *pin) :
   multilevel = (adaptive || pin->GetString("mesh_refinement","refinement") == "static")
     ?  true : false;
 
+  // read parameters controlling automatic load balancing based on measured costs
+  lb_automatic = (pin->GetOrAddString("loadbalancing","balancer","default") ==
+                  "automatic") ? true : false;
+  lb_interval  = pin->GetOrAddInteger("loadbalancing","interval",10);
+  lb_tolerance = pin->GetOrAddReal("loadbalancing","tolerance",0.1);
+  lb_smoothing = pin->GetOrAddReal("loadbalancing","smoothing",0.3);
+  lb_prtcl_weight = pin->GetOrAddReal("loadbalancing","particle_weight",0.0);
+  if (global_variable::nranks == 1) {lb_automatic = false;}
+  std::string sfc = pin->GetOrAddString("loadbalancing","sfc","morton");
+  std::string partitioner = pin->GetOrAddString("loadbalancing","partitioner",
+                                                "contiguous");
+  if ((sfc != "morton" && sfc != "hilbert") ||
+      (partitioner != "contiguous" && partitioner != "topology")) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+        << "<loadbalancing>/sfc must be 'morton' or 'hilbert', and "
+        << "<loadbalancing>/partitioner must be 'contiguous' or 'topology'" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  hilbert_order = (sfc == "hilbert");
+  lb_topology = (partitioner == "topology");
+  FindNodeTopology();
+  // with rank_speed, measured costs are used to detect ranks that are persistently slower
+  // (e.g. a throttled GPU), and MBs are distributed in proportion to the speed of ranks
+  lb_rank_speed = pin->GetOrAddBoolean("loadbalancing","rank_speed",false);
+  lb_straggler = pin->GetOrAddReal("loadbalancing","straggler_threshold",0.15);
+  if (!(lb_automatic)) {lb_rank_speed = false;}
+  speed_eachrank = new float[global_variable::nranks];
+  for (int r=0; r<global_variable::nranks; ++r) {speed_eachrank[r] = 1.0;}
+  // initial speeds of ranks with different capacity (e.g. mixed GPU types, or GPU and
+  // CPU ranks) can be given as a list of relative weights, or measured at startup
+  std::string wlist = pin->GetOrAddString("loadbalancing","rank_weights","");
+  bool calibrate = pin->GetOrAddBoolean("loadbalancing","calibrate",false);
+  int ncalib = pin->GetOrAddInteger("loadbalancing","calibrate_size",(1 << 22));
+  if (!(wlist.empty())) {
+    SetRankWeights(wlist);
+  } else if (calibrate) {
+    CalibrateRankSpeed(ncalib);
+  }
+  lb_weighted = (lb_rank_speed || !(wlist.empty()) || calibrate);
+  if (lb_automatic && (lb_interval < 1 || lb_smoothing <= 0.0 || lb_smoothing > 1.0)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+        << "<loadbalancing>/interval must be >= 1 and <loadbalancing>/smoothing must be "
+        << "in range (0,1]" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
   // FIXME: The shearing box is not currently compatible with SMR/AMR
   if (multilevel && pin->DoesBlockExist("shearing_box")) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
@@ -280,6 +383,17 @@ Mesh::Mesh(ParameterInput *pin) :
     std::exit(EXIT_FAILURE);
   }
 
+#if FIXED_MB_NX1 > 0
+  // MeshBlock x1-size and nghost must match values fixed at compile time
+  if (mb_indcs.nx1 != FIXED_MB_NX1 || mesh_indcs.ng != FIXED_NGHOST) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Code compiled with MeshBlock nx1=" << FIXED_MB_NX1 << " and nghost="
+              << FIXED_NGHOST << ", but input file specifies nx1=" << mb_indcs.nx1
+              << " and nghost=" << mesh_indcs.ng << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+#endif
+
   // initialize indices for Mesh cells, MeshBlock cells, and MeshBlock coarse cells
   mb_indcs.ng  = mesh_indcs.ng;
   mb_indcs.cnx1 = mb_indcs.nx1/2;
@@ -340,10 +454,15 @@ Mesh::~Mesh() {
   delete [] lloc_eachmb;
   delete [] gids_eachrank;
   delete [] nmb_eachrank;
+  delete [] nrank_eachnode;
+  delete [] speed_eachrank;
   delete pmb_pack;
-  if (multilevel) {
+  if (pmr != nullptr) {
     delete pmr;
   }
+  if (ploc != nullptr) {
+    delete ploc;
+  }
 }
 
 //----------------------------------------------------------------------------------------
@@ -385,18 +504,18 @@ void Mesh::PrintMeshDiagnostics() {
   std::cout << "Number of parallel ranks = " << global_variable::nranks << std::endl;
   // if more than one rank: compute/output # of blocks and cost per rank
   if (global_variable::nranks > 1) {
-    int nb_per_rank[global_variable::nranks];    // NOLINT(runtime/arrays)
-    int cost_per_rank[global_variable::nranks];  // NOLINT(runtime/arrays)
+    int nb_per_rank[global_variable::nranks];      // NOLINT(runtime/arrays)
+    float cost_per_rank[global_variable::nranks];  // NOLINT(runtime/arrays)
     for (int i=0; i<global_variable::nranks; ++i) {
       nb_per_rank[i] = 0;
-      cost_per_rank[i] = 0;
+      cost_per_rank[i] = 0.0;
     }
     for (int i=0; i<nmb_total; i++) {
       nb_per_rank[rank_eachmb[i]]++;
       cost_per_rank[rank_eachmb[i]] += cost_eachmb[i];
     }
-    int mincost = std::numeric_limits<int>::max();
-    int maxcost = 0, totalcost = 0;
+    float mincost = std::numeric_limits<float>::max();
+    float maxcost = 0.0, totalcost = 0.0;
     for (int i=0; i<global_variable::nranks; ++i) {
       std::cout << "  Rank = " << i << ": " << nb_per_rank[i] <<" MeshBlocks, cost = "
                 << cost_per_rank[i] << std::endl;
@@ -408,8 +527,8 @@ void Mesh::PrintMeshDiagnostics() {
     // output normalized costs per rank
     std::cout << "Load Balancing:" << std::endl;
     std::cout << "  Maximum normalized cost = "
-      << static_cast<float>(maxcost)/static_cast<float>(mincost) << ", Average = "
-      << static_cast<float>(totalcost)/static_cast<float>(global_variable::nranks*mincost)
+      << maxcost/mincost << ", Average = "
+      << totalcost/(static_cast<float>(global_variable::nranks)*mincost)
       << std::endl;
   }
 }
@@ -563,73 +682,217 @@ std::string Mesh::GetBoundaryString(BoundaryFlag input_flag) {
 
 //----------------------------------------------------------------------------------------
 // \fn Mesh::NewTimeStep()
+// \brief Computes new timestep from the constraints of all physics in all MeshBlockPacks
+// on this rank, and the minimum over all ranks (blocking).
 
 void Mesh::NewTimeStep(const Real tlim) {
+  StartNewTimeStep();
+  FinishNewTimeStep(tlim);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+// \fn Mesh::StartNewTimeStep()
+// \brief Finds minimum timestep over all physics and MeshBlockPacks on this rank, and
+// starts a non-blocking reduction over all ranks.  The current dt is not changed until
+// FinishNewTimeStep() is called, so tasks run in between still use the old value.
+// If the reduction started in the previous cycle is still pending (lagged reduction),
+// it is completed first, and the timestep taken since then is checked against its result.
+
+void Mesh::StartNewTimeStep() {
+  if (dt_pending_) {
+#if MPI_PARALLEL_ENABLED
+    MPI_Wait(&dt_req_, MPI_STATUS_IGNORE);
+#endif
+    dt_pending_ = false;
+    if (dt_next_version_ == mesh_version) {
+      // result is the same on all ranks, so all of them detect a violation together
+      Real dt_max = dt_next_[0];
+      if (sts_max_dt_ratio > 0.0) {
+        dt_max = std::min(dt_max, sts_max_dt_ratio*dt_next_[1]);
+      }
+      if (dt > dt_max*(1.0 + 1.0e-6)) {dt_violated_ = true;}
+      dt_lag_old_ = dt_lag_[0];
+      dt_lag_[0] = dt_next_[0];
+      dt_lag_[1] = dt_next_[1];
+      dt_lag_valid_ = true;
+    } else {
+      dt_lag_valid_ = false;
+    }
+  }
+  // limit increase in timestep to 2x old value
+  Real diff_dt = std::numeric_limits<float>::max();
+  dt_next_[0] = std::min(static_cast<Real>(2.0*dt), PackNewTimeStep(pmb_pack, diff_dt));
+  dt_next_[1] = diff_dt;
+  dt_next_version_ = mesh_version;
+  dt_pending_ = true;
+
+#if MPI_PARALLEL_ENABLED
+  // start reduction of minimum dt (and diffusion dt) over all MPI ranks
+  MPI_Iallreduce(MPI_IN_PLACE, dt_next_, 2, MPI_ATHENA_REAL, MPI_MIN,
+                 global_variable::athena_comm,
+                 &dt_req_);
+#endif
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+// \fn Mesh::FinishNewTimeStep()
+// \brief Completes reduction of new timestep started in StartNewTimeStep().  If the
+// MeshBlocks have been refined or redistributed since then, the reduction is repeated
+// with the timesteps computed for the new MeshBlocks.
+
+void Mesh::FinishNewTimeStep(const Real tlim) {
+#if MPI_PARALLEL_ENABLED
+  double t_start = MPI_Wtime();
+  MPI_Wait(&dt_req_, MPI_STATUS_IGNORE);
+#endif
+  if (dt_next_version_ != mesh_version) {
+    StartNewTimeStep();
+#if MPI_PARALLEL_ENABLED
+    MPI_Wait(&dt_req_, MPI_STATUS_IGNORE);
+#endif
+  }
+#if MPI_PARALLEL_ENABLED
+  if (ccounter.enabled) {ccounter.t_dt += MPI_Wtime() - t_start;}
+#endif
+  dt_pending_ = false;
+  // result can be used as lagged timestep of the next cycle
+  dt_lag_old_ = dt_lag_[0];
+  dt_lag_[0] = dt_next_[0];
+  dt_lag_[1] = dt_next_[1];
+  dt_lag_valid_ = true;
+
+  SetTimeStep(dt_next_[0], dt_next_[1], tlim);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+// \fn Mesh::FinishLaggedTimeStep()
+// \brief Sets new timestep from the reduction completed in the last cycle, without
+// waiting for the one started in StartNewTimeStep() in this cycle, so the global
+// reduction is taken off the critical path.  If the timestep has been decreasing, the
+// trend of the last two reductions is extrapolated one more cycle.
+//
+// The reduction is completed synchronously (as in FinishNewTimeStep()) on the first
+// cycle, after the Mesh is refined or redistributed, and for nsync cycles after a lagged
+// timestep exceeded the limit later reduced for its cycle (the CFL condition).  These
+// conditions are the same on all ranks, so all ranks always use the same timestep.
+
+void Mesh::FinishLaggedTimeStep(const Real tlim, const int nsync) {
+  if (dt_violated_) {
+    if (global_variable::my_rank == 0) {
+      std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+                << "Lagged timestep exceeded CFL limit on cycle " << ncycle
+                << ", using synchronous reduction for " << nsync << " cycles"
+                << std::endl;
+    }
+    dt_violated_ = false;
+    dt_sync_left_ = nsync;
+    dt_lag_valid_ = false;
+  }
+  if (global_variable::nranks == 1 || !(dt_lag_valid_) || dt_sync_left_ > 0 ||
+      dt_next_version_ != mesh_version) {
+    if (dt_sync_left_ > 0) {dt_sync_left_--;}
+    FinishNewTimeStep(tlim);
+    return;
+  }
+  Real dt_new = dt_lag_[0];
+  if (dt_lag_old_ > dt_lag_[0]) {dt_new *= dt_lag_[0]/dt_lag_old_;}
+  SetTimeStep(dt_new, dt_lag_[1], tlim);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+// \fn Mesh::WaitNewTimeStep()
+// \brief Completes a lagged reduction still pending at the end of the run.
+
+void Mesh::WaitNewTimeStep() {
+#if MPI_PARALLEL_ENABLED
+  if (dt_pending_) {MPI_Wait(&dt_req_, MPI_STATUS_IGNORE);}
+#endif
+  dt_pending_ = false;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+// \fn Mesh::SetTimeStep()
+// \brief Saves old timestep, and sets new timestep limited by STS and tlim.
+
+void Mesh::SetTimeStep(const Real dt_new, const Real dt_diff_new, const Real tlim) {
   // save old timestep
   dtold = dt;
   if (dt == std::numeric_limits<float>::max()) {
     dtold = 0.;
   }
+  dt = dt_new;
+  dt_diff = dt_diff_new;
+  // with STS, optionally limit ratio of timestep to diffusion timestep
+  if (sts_max_dt_ratio > 0.0) {dt = std::min(dt, sts_max_dt_ratio*dt_diff);}
 
-  // cycle over all MeshBlocks on this rank and find minimum dt
-  // Requires at least ONE of the physics modules to be defined.
-  // limit increase in timestep to 2x old value
-  dt = 2.0*dt;
+  // limit last time step to stop at tlim *exactly*
+  if ( (time < tlim) && ((time + dt) > tlim) ) {dt = tlim - time;}
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+// \fn Mesh::PackNewTimeStep()
+// \brief Returns minimum of the timesteps computed by every physics module (and their
+// diffusion and source terms) in one MeshBlockPack.  Requires at least ONE of the
+// physics modules to be defined.  Diffusion terms integrated with super-time-stepping do
+// not limit the timestep, their limit is returned in diff_dt instead.
+
+Real Mesh::PackNewTimeStep(MeshBlockPack *pmbp, Real &diff_dt) {
+  Real pack_dt = std::numeric_limits<Real>::max();
 
   // Hydro timestep
-  if (pmb_pack->phydro != nullptr) {
-    dt = std::min(dt, (cfl_no)*(pmb_pack->phydro->dtnew) );
+  if (pmbp->phydro != nullptr) {
+    pack_dt = std::min(pack_dt, (cfl_no)*(pmbp->phydro->dtnew) );
+    Real &hyd_dt = (pmbp->phydro->use_sts)? diff_dt : pack_dt;
     // viscosity timestep
-    if (pmb_pack->phydro->pvisc != nullptr) {
-      dt = std::min(dt, (cfl_no)*(pmb_pack->phydro->pvisc->dtnew) );
+    if (pmbp->phydro->pvisc != nullptr) {
+      hyd_dt = std::min(hyd_dt, (cfl_no)*(pmbp->phydro->pvisc->dtnew) );
     }
-    // thermal conduction timestep
-    if (pmb_pack->phydro->pcond != nullptr) {
-      dt = std::min(dt, (cfl_no)*(pmb_pack->phydro->pcond->dtnew) );
+    // thermal conduction timestep (no limit with implicit conduction)
+    if (pmbp->phydro->pcond != nullptr && !(pmbp->phydro->pcond->implicit)) {
+      hyd_dt = std::min(hyd_dt, (cfl_no)*(pmbp->phydro->pcond->dtnew) );
     }
     // source terms timestep
-    dt = std::min(dt, (cfl_no)*(pmb_pack->phydro->psrc->dtnew) );
+    pack_dt = std::min(pack_dt, (cfl_no)*(pmbp->phydro->psrc->dtnew) );
   }
   // MHD timestep
-  if (pmb_pack->pmhd != nullptr) {
-    dt = std::min(dt, (cfl_no)*(pmb_pack->pmhd->dtnew) );
+  if (pmbp->pmhd != nullptr) {
+    pack_dt = std::min(pack_dt, (cfl_no)*(pmbp->pmhd->dtnew) );
     // viscosity timestep
-    if (pmb_pack->pmhd->pvisc != nullptr) {
-      dt = std::min(dt, (cfl_no)*(pmb_pack->pmhd->pvisc->dtnew) );
+    if (pmbp->pmhd->pvisc != nullptr) {
+      pack_dt = std::min(pack_dt, (cfl_no)*(pmbp->pmhd->pvisc->dtnew) );
     }
     // resistivity timestep
-    if (pmb_pack->pmhd->presist != nullptr) {
-      dt = std::min(dt, (cfl_no)*(pmb_pack->pmhd->presist->dtnew) );
+    if (pmbp->pmhd->presist != nullptr) {
+      pack_dt = std::min(pack_dt, (cfl_no)*(pmbp->pmhd->presist->dtnew) );
     }
     // thermal conduction timestep
-    if (pmb_pack->pmhd->pcond != nullptr) {
-      dt = std::min(dt, (cfl_no)*(pmb_pack->pmhd->pcond->dtnew) );
+    if (pmbp->pmhd->pcond != nullptr) {
+      pack_dt = std::min(pack_dt, (cfl_no)*(pmbp->pmhd->pcond->dtnew) );
     }
     // source terms timestep
-    dt = std::min(dt, (cfl_no)*(pmb_pack->pmhd->psrc->dtnew) );
+    pack_dt = std::min(pack_dt, (cfl_no)*(pmbp->pmhd->psrc->dtnew) );
   }
   // z4c timestep
-  if (pmb_pack->pz4c != nullptr) {
-    dt = std::min(dt, (cfl_no)*(pmb_pack->pz4c->dtnew) );
+  if (pmbp->pz4c != nullptr) {
+    pack_dt = std::min(pack_dt, (cfl_no)*(pmbp->pz4c->dtnew) );
   }
   // Radiation timestep
-  if (pmb_pack->prad != nullptr) {
-    dt = std::min(dt, (cfl_no)*(pmb_pack->prad->dtnew) );
+  if (pmbp->prad != nullptr) {
+    pack_dt = std::min(pack_dt, (cfl_no)*(pmbp->prad->dtnew) );
   }
   // Particles timestep
-  if (pmb_pack->ppart != nullptr) {
-    dt = std::min(dt, (pmb_pack->ppart->dtnew) );
+  if (pmbp->ppart != nullptr) {
+    pack_dt = std::min(pack_dt, (pmbp->ppart->dtnew) );
   }
 
-#if MPI_PARALLEL_ENABLED
-  // get minimum dt over all MPI ranks
-  MPI_Allreduce(MPI_IN_PLACE, &dt, 1, MPI_ATHENA_REAL, MPI_MIN, MPI_COMM_WORLD);
-#endif
-
-  // limit last time step to stop at tlim *exactly*
-  if ( (time < tlim) && ((time + dt) > tlim) ) {dt = tlim - time;}
-
-  return;
+  return pack_dt;
 }
 
 //----------------------------------------------------------------------------------------
@@ -642,6 +905,14 @@ void Mesh::AddCoordinatesAndPhysics(ParameterInput *pinput) {
     pmb_pack->AddPhysics(pinput);
   }
 
+  // MBs are not redistributed by automatic load balancing with radiation, since the
+  // radiation data is not yet communicated when MBs are moved between ranks
+  if (lb_automatic && pmb_pack->prad != nullptr && global_variable::my_rank == 0) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<loadbalancing>/balancer=automatic is not supported with radiation, "
+              << "MeshBlocks will not be redistributed" << std::endl;
+  }
+
   // Determine total number of particles across all ranks
   particles::Particles *ppart = pmb_pack->ppart;
   if (ppart != nullptr) {
@@ -653,7 +924,8 @@ void Mesh::AddCoordinatesAndPhysics(ParameterInput *pinput) {
     nprtcl_eachrank[global_variable::my_rank] = nprtcl_thisrank;
 #if MPI_PARALLEL_ENABLED
     // Share number of particles on each rank with all ranks
-    MPI_Allgather(&nprtcl_thisrank,1,MPI_INT,nprtcl_eachrank,1,MPI_INT,MPI_COMM_WORLD);
+    MPI_Allgather(&nprtcl_thisrank,1,MPI_INT,nprtcl_eachrank,1,MPI_INT,
+                  global_variable::athena_comm);
 #endif
     for (int n=0; n<global_variable::nranks; ++n) {
       nprtcl_total += nprtcl_eachrank[n];
@@ -12,10 +12,19 @@
 //! are grouped together into MeshBlockPacks for better performance on GPUs.
 
 #include <cstdint>  // int32_t
+#include <map>
 #include <memory>
 #include <string>
 
 #include "athena.hpp"
+#include "utils/global_reductions.hpp"
+#include "utils/host_task_pool.hpp"
+#include "utils/kernel_counters.hpp"
+#include "utils/scratch_pool.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
 
 // Define following structure before other "include" files to resolve declarations
 //----------------------------------------------------------------------------------------
@@ -41,6 +50,43 @@ struct RegionIndcs {
   int cis,cie,cjs,cje,cks,cke;  // indices of ACTIVE coarse cells
 };
 
+//----------------------------------------------------------------------------------------
+//! \fn int GhostZoneSlabs()
+//! \brief Decomposes the ghost zones of a MeshBlock into (at most 6) non-overlapping
+//! slabs, stored as index ranges {il,iu,jl,ju,kl,ku} in slab[].  Returns the number of
+//! slabs.  Used to split work between active cells and the surrounding ghost-zone shell,
+//! so that active cells can be processed while boundary communications are in flight.
+//! Only the first ng (<= indcs.ng) ghost cells outside the active cells are included.
+
+inline int GhostZoneSlabs(const RegionIndcs &indcs, int slab[6][6], int ng) {
+  int i0 = indcs.is - ng, n1m1 = indcs.ie + ng;
+  int j0 = indcs.js, n2m1 = indcs.je;
+  int k0 = indcs.ks, n3m1 = indcs.ke;
+  if (indcs.nx2 > 1) {j0 -= ng; n2m1 += ng;}
+  if (indcs.nx3 > 1) {k0 -= ng; n3m1 += ng;}
+  int nslab = 0;
+  auto add_slab = [&](int il, int iu, int jl, int ju, int kl, int ku) {
+    slab[nslab][0] = il; slab[nslab][1] = iu;
+    slab[nslab][2] = jl; slab[nslab][3] = ju;
+    slab[nslab][4] = kl; slab[nslab][5] = ku;
+    nslab++;
+  };
+  // x1-faces span all cells in x2 and x3
+  add_slab(i0, indcs.is-1, j0, n2m1, k0, n3m1);
+  add_slab(indcs.ie+1, n1m1, j0, n2m1, k0, n3m1);
+  // x2-faces span active cells in x1, and all cells in x3
+  if (indcs.nx2 > 1) {
+    add_slab(indcs.is, indcs.ie, j0, indcs.js-1, k0, n3m1);
+    add_slab(indcs.is, indcs.ie, indcs.je+1, n2m1, k0, n3m1);
+  }
+  // x3-faces span active cells in x1 and x2
+  if (indcs.nx3 > 1) {
+    add_slab(indcs.is, indcs.ie, indcs.js, indcs.je, k0, indcs.ks-1);
+    add_slab(indcs.is, indcs.ie, indcs.js, indcs.je, indcs.ke+1, n3m1);
+  }
+  return nslab;
+}
+
 //----------------------------------------------------------------------------------------
 //! \struct NeighborBlock
 //! \brief Information about neighboring MeshBlocks stored as 2D DualArray in MeshBlock
@@ -50,6 +96,8 @@ struct NeighborBlock {
   int lev;     // logical level
   int rank;    // MPI rank
   int dest;    // index of recv buffer in target NeighborBlocks
+  bool send_coarse;  // true if coarse data sent to this neighbor at same level (Z4c)
+  bool recv_coarse;  // true if coarse data recv'd from this neighbor at same level (Z4c)
 };
 
 //----------------------------------------------------------------------------------------
@@ -70,14 +118,49 @@ struct LogicalLocation {
 
 struct EventCounters {
   int nfofc, neos_dfloor, neos_efloor, neos_tfloor, neos_vceil, neos_fail, maxit_c2p;
+  int nrs_full, nrs_hlle;  // rows of faces using rsolver or HLLE with rsolver_hybrid
   EventCounters() : nfofc(0), neos_dfloor(0), neos_efloor(0), neos_tfloor(0),
-                    neos_vceil(0), neos_fail(0), maxit_c2p(0) {}
+                    neos_vceil(0), neos_fail(0), maxit_c2p(0), nrs_full(0),
+                    nrs_hlle(0) {}
+};
+
+//----------------------------------------------------------------------------------------
+//! \struct CommCounters
+//! \brief stores time spent waiting for MPI communications on this rank, and number of
+//! messages and bytes exchanged with each neighboring rank.  Only accumulated if enabled
+//! (by requesting an output of type 'comm'), and reset each time that output is written.
+
+struct CommTally {
+  int nsend, nrecv;            // number of messages sent to/received from rank
+  int64_t bsend, brecv;        // number of bytes sent to/received from rank
+  CommTally() : nsend(0), nrecv(0), bsend(0), brecv(0) {}
+};
+
+struct CommCounters {
+  bool enabled;
+  double t_recv, t_send;       // time (s) waiting in ClearRecv/ClearSend functions
+  double t_poll;               // time (s) from first failed poll until recvs completed
+  double t_dt;                 // time (s) waiting for reduction of new timestep
+  int npoll;                   // number of polls of recvs that had not completed
+  std::map<int, CommTally> nghbr;  // messages/bytes exchanged, keyed by neighbor rank
+  CommCounters() : enabled(false), t_recv(0.0), t_send(0.0), t_poll(0.0), t_dt(0.0),
+                   npoll(0) {}
+  void Tally(int rank, bool send, int64_t nbytes) {
+    if (!(enabled)) return;
+    CommTally &t = nghbr[rank];
+    if (send) {t.nsend++; t.bsend += nbytes;} else {t.nrecv++; t.brecv += nbytes;}
+  }
+  void Reset() {
+    t_recv = 0.0; t_send = 0.0; t_poll = 0.0; t_dt = 0.0; npoll = 0;
+    nghbr.clear();
+  }
 };
 
 // Forward declarations required due to recursive definitions amongst mesh classes
 class MeshBlock;
 class MeshBlockPack;
 class MeshBlockTree;
+class MeshLocator;
 class Mesh;
 
 #include "parameter_input.hpp"
@@ -110,6 +193,9 @@ class Mesh {
   RegionIndcs mb_indcs;       // indices of cells in MeshBlocks (same for all MeshBlocks)
   BoundaryFlag mesh_bcs[6];   // physical boundary conditions at 6 faces of mesh
   bool strictly_periodic;     // true if all boundaries are periodic
+  bool symmetric[3];          // reflection symmetry about x1=0, x2=0, x3=0
+  Real symmetry_factor;       // volume of full (unreflected) domain / volume of mesh
+  bool reflect_b_pseudovector;  // reflect B as pseudovector rather than vector
 
   bool one_d, two_d, three_d; // flags to indicate 1D or 2D or 3D calculations
   bool multi_d;               // flag to indicate 2D and 3D calculations
@@ -120,6 +206,7 @@ class Mesh {
   int nmb_total;           // total number of MeshBlocks across all levels/ranks
   int nmb_thisrank;        // number of MeshBlocks on this MPI rank (local)
   int nmb_maxperrank;      // max allowed number of MBs per device (memory limit for AMR)
+  int mesh_version;        // incremented whenever MBs are refined/redistributed
 
   int root_level; // logical level of root (physical) grid (e.g. Fig. 3 of method paper)
   int max_level;  // logical level of maximum refinement grid in Mesh
@@ -138,14 +225,37 @@ class Mesh {
   // following 1x arrays allocated with length [nranks] in AddCoordinatesAndPhysics()
   int *nprtcl_eachrank;    // number of particles on each rank
 
+  // parameters for automatic load balancing using measured cost of each MeshBlock
+  bool lb_automatic;       // true to rebalance MBs using measured costs
+  int lb_interval;         // # of cycles between updates of costs and check of balance
+  float lb_tolerance;      // fractional imbalance in cost across ranks to trigger LB
+  float lb_smoothing;      // weight of new measurement in exponentially smoothed cost
+  float lb_prtcl_weight;   // cost of average # of particles/MB relative to mesh work
+  bool hilbert_order;      // true to order MBs along Hilbert (rather than Morton) curve
+  bool lb_topology;        // true to partition MBs first across nodes, then ranks
+  int nnodes;              // number of nodes (shared-memory domains) used by all ranks
+  int *nrank_eachnode;     // number of ranks on each node (ranks contiguous on nodes)
+  bool lb_rank_speed;      // true to measure speed of each rank and weight LB by it
+  float lb_straggler;      // relative speed below which a rank is reported as slow
+  float *speed_eachrank;   // measured speed of each rank relative to average (LB weight)
+  bool lb_weighted;        // true if MBs are distributed in proportion to speed_eachrank
+
   Real time, dt, dtold, cfl_no;
+  Real dt_diff;            // timestep limit of diffusion terms integrated with STS
+  Real sts_max_dt_ratio;   // maximum dt/dt_diff with STS (no limit if <= 0)
   int ncycle;
   EventCounters ecounter;
+  CommCounters ccounter;
+  KernelCounters kcounter;   // time, bytes and FLOPs of named kernels (<time>/roofline)
+  GlobalReductions greduce;  // batched scalar reductions over ranks of diagnostics
+  HostTaskPool host_pool;    // threads on spare cores running host tasks
+  ScratchPool scratch;       // device arena for transient arrays shared by all modules
 
   int nmb_packs_thisrank;                  // number of MBPacks on this rank
   MeshBlockPack* pmb_pack;                 // container for MeshBlocks on this rank
   std::unique_ptr<ProblemGenerator> pgen;  // class containing functions to set ICs
   MeshRefinement *pmr=nullptr;             // mesh refinement data/functions (if needed)
+  MeshLocator *ploc=nullptr;               // device index of MBs (built by Locator())
 
   // functions
   void BuildTreeFromScratch(ParameterInput *pin);
@@ -153,6 +263,15 @@ class Mesh {
   void PrintMeshDiagnostics();
   void WriteMeshStructure();
   void NewTimeStep(const Real tlim);
+  void StartNewTimeStep();
+  void FinishNewTimeStep(const Real tlim);
+  void FinishLaggedTimeStep(const Real tlim, const int nsync);
+  void WaitNewTimeStep();
+  void UpdateCostList();
+  void UpdateRankSpeed(double time_thisrank);
+  void SetRankWeights(const std::string &wlist);
+  void CalibrateRankSpeed(int ncalib);
+  float CostImbalance();
   void AddCoordinatesAndPhysics(ParameterInput *pinput);
   BoundaryFlag GetBoundaryFlag(const std::string& input_string);
   std::string GetBoundaryString(BoundaryFlag input_flag);
@@ -163,12 +282,12 @@ class Mesh {
   }
 
   // accessors
+  // MBs on this rank have contiguous gids starting at gids of MeshBlockPack
   int FindMeshBlockIndex(int tgid) {
-    for (int m=0; m<pmb_pack->nmb_thispack; ++m) {
-      if (pmb_pack->pmb->mb_gid.h_view(m) == tgid) return m;
-    }
-    return -1;
+    int m = tgid - pmb_pack->gids;
+    return (m >= 0 && m < pmb_pack->nmb_thispack)? m : -1;
   }
+  MeshLocator* Locator();
   int NumberOfMeshBlockCells() const {
     return (mb_indcs.nx1)*(mb_indcs.nx2)*(mb_indcs.nx3);
   }
@@ -176,5 +295,24 @@ class Mesh {
  private:
   std::unique_ptr<MeshBlockTree> ptree;  // pointer to root node in binary/quad/oct-tree
   void LoadBalance(float *clist, int *rlist, int *slist, int *nlist, int nb);
+  void FindNodeTopology();
+  Real PackNewTimeStep(MeshBlockPack *pmbp, Real &diff_dt);
+  void SetTimeStep(const Real dt_new, const Real dt_diff_new, const Real tlim);
+
+  // new timestep and diffusion timestep (with STS) reduced over ranks between
+  // Start/FinishNewTimeStep()
+  Real dt_next_[2];
+  int dt_next_version_;   // mesh_version when reduction of dt_next_ was started
+  // with a lagged reduction (<time>/lag_dt_reduce), the timestep of the next cycle is
+  // set from the last completed reduction, while the latest one is still in progress
+  bool dt_pending_;       // reduction started but not yet completed
+  bool dt_lag_valid_;     // dt_lag_ reduced over the current Mesh
+  bool dt_violated_;      // a lagged timestep exceeded the limit reduced for its cycle
+  int dt_sync_left_;      // remaining cycles with synchronous reduction after violation
+  Real dt_lag_[2];        // last completed reduction of new timestep (and diffusion dt)
+  Real dt_lag_old_;       // reduction completed before dt_lag_, to predict its trend
+#if MPI_PARALLEL_ENABLED
+  MPI_Request dt_req_;
+#endif
 };
 #endif  // MESH_MESH_HPP_
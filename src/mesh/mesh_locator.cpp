@@ -0,0 +1,106 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file mesh_locator.cpp
+//! \brief Implements MeshLocator class, and Mesh::Locator() which builds the index on
+//! first use.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "mesh.hpp"
+#include "mesh_locator.hpp"
+
+//----------------------------------------------------------------------------------------
+// constructor, index is built by first call to Update()
+
+MeshLocator::MeshLocator(Mesh *pm) :
+    pmy_mesh(pm),
+    version(-1),
+    key("mloc_key",1),
+    gid("mloc_gid",1),
+    rank("mloc_rank",1) {
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshLocator::Update()
+//! \brief Rebuilds index from the logical locations and ranks of all MBs, if the Mesh has
+//! changed since it was last built.  The Morton key of each MB is that of its first
+//! (lower-left) location at the finest level, so keys of the locations covered by a
+//! MB at coarser level lie between its key and that of the next MB in sorted order.
+
+void MeshLocator::Update() {
+  Mesh *pm = pmy_mesh;
+  if (version == pm->mesh_version) return;
+
+  ndim = (pm->three_d)? 3 : ((pm->multi_d)? 2 : 1);
+  int dlev = pm->max_level - pm->root_level;
+  nfine[0] = static_cast<std::uint64_t>(pm->nmb_rootx1) << dlev;
+  nfine[1] = (ndim > 1)? (static_cast<std::uint64_t>(pm->nmb_rootx2) << dlev) : 1;
+  nfine[2] = (ndim > 2)? (static_cast<std::uint64_t>(pm->nmb_rootx3) << dlev) : 1;
+  nbits = 0;
+  for (int d=0; d<ndim; ++d) {
+    while ((1ULL << nbits) < nfine[d]) {nbits++;}
+  }
+  if (nbits*ndim > 64) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Morton keys of " << nbits << " bits in each of " << ndim
+              << " dimensions needed to locate MeshBlocks exceed 64 bits" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  msize = pm->mesh_size;
+  nmb_total = pm->nmb_total;
+  gids = pm->gids_eachrank[global_variable::my_rank];
+  nmb_thisrank = pm->nmb_eachrank[global_variable::my_rank];
+
+  // sort MBs by Morton key
+  std::vector<std::pair<std::uint64_t, int>> keys(nmb_total);
+  for (int n=0; n<nmb_total; ++n) {
+    LogicalLocation &loc = pm->lloc_eachmb[n];
+    int shift = pm->max_level - loc.level;
+    std::uint64_t lx[3] = {static_cast<std::uint64_t>(loc.lx1) << shift,
+                           static_cast<std::uint64_t>(loc.lx2) << shift,
+                           static_cast<std::uint64_t>(loc.lx3) << shift};
+    keys[n] = std::make_pair(MortonKey(lx, ndim, nbits), n);
+  }
+  std::sort(keys.begin(), keys.end());
+
+  Kokkos::realloc(key, nmb_total);
+  Kokkos::realloc(gid, nmb_total);
+  Kokkos::realloc(rank, nmb_total);
+  for (int n=0; n<nmb_total; ++n) {
+    key.h_view(n) = keys[n].first;
+    gid.h_view(n) = keys[n].second;
+    rank.h_view(n) = pm->rank_eachmb[n];
+  }
+  key.template modify<HostMemSpace>();
+  key.template sync<DevExeSpace>();
+  gid.template modify<HostMemSpace>();
+  gid.template sync<DevExeSpace>();
+  rank.template modify<HostMemSpace>();
+  rank.template sync<DevExeSpace>();
+
+  version = pm->mesh_version;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn MeshLocator* Mesh::Locator()
+//! \brief Returns index of MBs, which is created on first call and brought up to date
+//! with the Mesh on every call.
+
+MeshLocator* Mesh::Locator() {
+  if (ploc == nullptr) {
+    ploc = new MeshLocator(this);
+  }
+  ploc->Update();
+  return ploc;
+}
@@ -0,0 +1,106 @@
+#ifndef MESH_MESH_LOCATOR_HPP_
+#define MESH_MESH_LOCATOR_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file mesh_locator.hpp
+//! \brief defines MeshLocator class, a device-resident index of all MeshBlocks in the
+//! Mesh that can be used inside kernels to find the MeshBlock containing a point, and
+//! the rank and local index of a MeshBlock from its gid.
+//!
+//! Each MeshBlock (leaf of the MeshBlockTree) covers a contiguous range of Morton keys
+//! of the logical locations of MeshBlocks at the finest level, so the MB containing a
+//! point is found with a binary search in the sorted keys of the first location covered
+//! by each MB, in O(log nmb_total).  Since MBs on each rank have contiguous gids, the
+//! local index of a MB is found from its gid in O(1).  The index is rebuilt whenever
+//! the Mesh changes (Mesh::mesh_version is incremented).
+
+#include <cstdint>
+
+#include "athena.hpp"
+#include "mesh.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \class MeshLocator
+
+class MeshLocator {
+ public:
+  explicit MeshLocator(Mesh *pm);
+  ~MeshLocator() = default;
+
+  // rebuild index if the Mesh has changed since it was last built
+  void Update();
+
+  // gid of MB containing point (x1,x2,x3), or -1 if it is outside the Mesh
+  KOKKOS_INLINE_FUNCTION
+  int FindGID(const Real x1, const Real x2, const Real x3) const {
+    if (x1 < msize.x1min || x1 > msize.x1max) return -1;
+    if (ndim > 1 && (x2 < msize.x2min || x2 > msize.x2max)) return -1;
+    if (ndim > 2 && (x3 < msize.x3min || x3 > msize.x3max)) return -1;
+    std::uint64_t lx[3] = {0, 0, 0};
+    lx[0] = FinestLocation(x1, msize.x1min, msize.x1max, nfine[0]);
+    if (ndim > 1) {lx[1] = FinestLocation(x2, msize.x2min, msize.x2max, nfine[1]);}
+    if (ndim > 2) {lx[2] = FinestLocation(x3, msize.x3min, msize.x3max, nfine[2]);}
+    std::uint64_t tkey = MortonKey(lx, ndim, nbits);
+
+    // largest key <= tkey
+    int lo = 0, hi = nmb_total - 1;
+    while (lo < hi) {
+      int mid = (lo + hi + 1)/2;
+      if (key.d_view(mid) <= tkey) {
+        lo = mid;
+      } else {
+        hi = mid - 1;
+      }
+    }
+    return gid.d_view(lo);
+  }
+  // rank owning MB with gid
+  KOKKOS_INLINE_FUNCTION
+  int Rank(const int tgid) const {return rank.d_view(tgid);}
+  // index of MB with gid in MeshBlockPack on this rank, or -1 if it is on another rank
+  KOKKOS_INLINE_FUNCTION
+  int LocalIndex(const int tgid) const {
+    int m = tgid - gids;
+    return (m >= 0 && m < nmb_thisrank)? m : -1;
+  }
+
+  // rank owning MB with gid, for use on host
+  int RankHost(const int tgid) const {return rank.h_view(tgid);}
+
+  // Morton key of location lx (at the finest level) with nb bits in each of nd dims
+  KOKKOS_INLINE_FUNCTION
+  static std::uint64_t MortonKey(const std::uint64_t lx[3], const int nd, const int nb) {
+    std::uint64_t k = 0;
+    for (int b=0; b<nb; ++b) {
+      for (int d=0; d<nd; ++d) {
+        k |= ((lx[d] >> b) & 1ULL) << (b*nd + d);
+      }
+    }
+    return k;
+  }
+
+ private:
+  Mesh *pmy_mesh;
+  int version;                    // Mesh::mesh_version when index was built
+  int ndim, nbits;                // dimensions and bits per dimension in Morton keys
+  int nmb_total, gids, nmb_thisrank;
+  std::uint64_t nfine[3];         // number of MBs in each direction at finest level
+  RegionSize msize;               // size of Mesh
+  DualArray1D<std::uint64_t> key; // sorted Morton keys of first location in each MB
+  DualArray1D<int> gid;           // gid of MB with each key
+  DualArray1D<int> rank;          // rank of each MB, indexed by gid
+
+  // logical location at finest level of coordinate x in [xmin,xmax]
+  KOKKOS_INLINE_FUNCTION
+  static std::uint64_t FinestLocation(const Real x, const Real xmin, const Real xmax,
+                                      const std::uint64_t n) {
+    std::uint64_t l = static_cast<std::uint64_t>((x - xmin)/(xmax - xmin)*n);
+    // points on upper boundary of mesh belong to last MeshBlock
+    return (l < n)? l : (n - 1);
+  }
+};
+
+#endif // MESH_MESH_LOCATOR_HPP_
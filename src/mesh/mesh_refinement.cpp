@@ -13,7 +13,9 @@
 #include <iostream>
 #include <cmath>     // abs
 #include <algorithm> // sort
+#include <string>
 #include <utility>   // pair
+#include <vector>
 
 #include "athena.hpp"
 #include "globals.hpp"
@@ -26,8 +28,10 @@
 #include "radiation/radiation.hpp"
 #include "z4c/z4c.hpp"
 #include "z4c/z4c_amr.hpp"
+#include "pgen/pgen.hpp"
 #include "prolongation.hpp"
 #include "restriction.hpp"
+#include "utils/memory_registry.hpp"
 
 #if MPI_PARALLEL_ENABLED
 #include <mpi.h>
@@ -41,25 +45,71 @@ MeshRefinement::MeshRefinement(Mesh *pm, ParameterInput *pin) :
   pmy_mesh(pm),
   refine_flag("rflag",pm->nmb_total),
   ncyc_since_ref("cyc_since_ref",pm->nmb_total),
+  nderef_checks("nderef_checks",pm->nmb_total),
   nmb_created(0),
   nmb_deleted(0),
   nmb_sent_thisrank(0),
   ncyc_check_amr(1),
   refinement_interval(5),
+  derefine_interval(5),
+  ncheck_derefine(1),
   prolong_prims(false),
+  lb_chunk_nmb(0),
+  lb_pipeline_depth(2),
+  nmb_reserve(0),
+  record_amr(false),
+  replay_amr(false),
+  restrict_shells(false),
+  async_check(false),
+  refine_strength("rstrength",pm->nmb_total),
+  copy_list("copy_list",1,5),
   d_threshold_(0.0),
   dd_threshold_(0.0),
   dp_threshold_(0.0),
   dv_threshold_(0.0),
-  check_cons_(false) {
+  check_cons_(false),
+  check_pending_(false),
+  exchange_pending_(false),
+  check_gids_(0),
+  check_nmb_(0) {
   if (pin->DoesBlockExist("mesh_refinement")) {
     // read interval (in cycles) between check of AMR and derefinement
     ncyc_check_amr = pin->GetOrAddReal("mesh_refinement", "ncycle_check", 1);
     refinement_interval = pin->GetOrAddReal("mesh_refinement", "refinement_interval", 5);
+    // read hysteresis for derefinement: MBs are only derefined if they have existed for
+    // derefine_interval cycles, and have been flagged on ncheck_derefine checks in a row
+    derefine_interval = pin->GetOrAddInteger("mesh_refinement", "derefine_interval",
+                                             refinement_interval);
+    ncheck_derefine = pin->GetOrAddInteger("mesh_refinement", "ncheck_derefine", 1);
+    // read number of MBs per chunk and number of chunks in flight for pipelined sends
+    // during load balancing (by default all MBs sent at once)
+    lb_chunk_nmb = pin->GetOrAddInteger("mesh_refinement", "lb_chunk_nmb", 0);
+    lb_pipeline_depth = pin->GetOrAddInteger("mesh_refinement", "lb_pipeline_depth", 2);
+    if (lb_chunk_nmb < 0 || lb_pipeline_depth < 1) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<mesh_refinement>/lb_chunk_nmb must be >= 0 and "
+                << "lb_pipeline_depth must be > 0" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    // read number of MBs held back from refinement for those created by 2:1 balancing
+    nmb_reserve = pin->GetOrAddInteger("mesh_refinement", "nmb_reserve", 0);
     // read prolongate primitives flag
     if (pin->DoesParameterExist("mesh_refinement", "prolong_primitives")) {
       prolong_prims = pin->GetBoolean("mesh_refinement", "prolong_primitives");
     }
+    // read flag to restrict only the ng coarse cells adjacent to each face of MBs.  With
+    // SMR these are the only cells of the coarse arrays that are used (they are sent to
+    // coarser neighbors, and used in the stencil of prolongation).  Not possible with AMR
+    // (derefinement copies entire coarse arrays), or Z4c (higher-order restriction).
+    if (!(pm->adaptive) && !(pin->DoesBlockExist("z4c"))) {
+      restrict_shells = pin->GetOrAddBoolean("mesh_refinement","restrict_shells",false);
+    }
+    // read flag to launch refinement criteria at the end of each check cycle, exchange
+    // flags without blocking during the following cycle(s), and apply them (refine the
+    // mesh) on the next check cycle, so flags lag the solution by ncycle_check cycles
+    if (pm->adaptive) {
+      async_check = pin->GetOrAddBoolean("mesh_refinement", "async_check", false);
+    }
     // read refinement criteria thresholds
     if (pin->DoesParameterExist("mesh_refinement", "dens_max")) {
       d_threshold_ = pin->GetReal("mesh_refinement", "dens_max");
@@ -79,17 +129,37 @@ MeshRefinement::MeshRefinement(Mesh *pm, ParameterInput *pin) :
     }
   }
 
+  // read files to which the sequence of refinement flags and load balancing decisions is
+  // recorded, or from which a sequence recorded earlier is replayed
+  record_file_ = pin->GetOrAddString("mesh_refinement", "record_file", "");
+  std::string replay_file = pin->GetOrAddString("mesh_refinement", "replay_file", "");
+  record_amr = !(record_file_.empty());
+  replay_amr = !(replay_file.empty());
+  if (record_amr && replay_amr) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<mesh_refinement>/record_file and replay_file cannot both be set"
+              << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  replay_next_ = 0;
+  if (replay_amr) {ReadReplayFile(replay_file);}
+  if (replay_amr && async_check) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<mesh_refinement>/async_check cannot be used with replay_file"
+              << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
   if (pm->adaptive) {  // allocate arrays for AMR
     nref_eachrank = new int[global_variable::nranks];
     nderef_eachrank = new int[global_variable::nranks];
-    nref_rsum = new int[global_variable::nranks];
-    nderef_rsum = new int[global_variable::nranks];
   }
 
   // be sure Views are initialized to zero
   for (int m=0; m<(pm->nmb_total); ++m) {
     refine_flag.h_view(m) = 0;
     ncyc_since_ref(m) = 0;
+    nderef_checks(m) = 0;
   }
   refine_flag.template modify<HostMemSpace>();
   refine_flag.template sync<DevExeSpace>();
@@ -99,7 +169,7 @@ MeshRefinement::MeshRefinement(Mesh *pm, ParameterInput *pin) :
 
 #if MPI_PARALLEL_ENABLED
   // create unique communicators for AMR
-  MPI_Comm_dup(MPI_COMM_WORLD, &amr_comm);
+  MPI_Comm_dup(global_variable::athena_comm, &amr_comm);
 #endif
 }
 
@@ -110,8 +180,6 @@ MeshRefinement::~MeshRefinement() {
   if (pmy_mesh->adaptive) { // deallocate arrays for AMR
     delete [] nref_eachrank;
     delete [] nderef_eachrank;
-    delete [] nref_rsum;
-    delete [] nderef_rsum;
   }
 }
 
@@ -120,8 +188,17 @@ MeshRefinement::~MeshRefinement() {
 //! \brief Simple driver function for adaptive mesh refinement
 
 void MeshRefinement::AdaptiveMeshRefinement(Driver *pdriver, ParameterInput *pin) {
-  // first check refinement criteria
-  CheckForRefinement(pmy_mesh->pmb_pack);
+  // first check refinement criteria, or set flags recorded on this cycle of earlier run
+  if (replay_amr) {
+    if (!(ReplayEventThisCycle(true))) return;
+    ReplayRefinementFlags();
+  } else {
+    CheckForRefinement(pmy_mesh->pmb_pack);
+    if (record_amr) {
+      record_flag_.assign(refine_flag.h_view.data(),
+                          refine_flag.h_view.data() + pmy_mesh->nmb_total);
+    }
+  }
 
   // then update mesh tree if MeshBlock anywhere (on any rank) is flagged for refinement
   int nnew = 0, ndel = 0;
@@ -129,7 +206,9 @@ void MeshRefinement::AdaptiveMeshRefinement(Driver *pdriver, ParameterInput *pin
 
   // Refine/derefine mesh and evolved data, set boundary conditions/timestep on new mesh
   if (nnew != 0 || ndel != 0) { // at least one (de)refinement flagged
+    MemoryRegistry::PushTag("amr");
     RedistAndRefineMeshBlocks(pin, nnew, ndel);
+    MemoryRegistry::PopTag();
     pdriver->InitBoundaryValuesAndPrimitives(pmy_mesh);
 
     MeshBlockPack* pmbp = pmy_mesh->pmb_pack;
@@ -148,10 +227,47 @@ void MeshRefinement::AdaptiveMeshRefinement(Driver *pdriver, ParameterInput *pin
 
     nmb_created += nnew;
     nmb_deleted += ndel;
+    MemoryRegistry::Report("after AMR at cycle " + std::to_string(pmy_mesh->ncycle));
   }
+
+  // evaluate criteria on (new) mesh, to be applied on next check cycle
+  if (async_check) {LaunchAsyncCheck(pmy_mesh->pmb_pack);}
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \struct RefineCondMax
+//! \brief maxima of the default refinement conditions over a MeshBlock, so that all
+//! conditions can be computed in one reduction.  Used with Kokkos::Sum, so operator+=
+//! returns the maximum of each element (all default conditions are non-negative, and the
+//! flag returned by a user hook is in [-1,1]).
+
+struct RefineCondMax {
+  Real dmax, ddmax, dpmax, umax;
+  KOKKOS_INLINE_FUNCTION RefineCondMax() :
+    dmax(0.0), ddmax(0.0), dpmax(0.0), umax(-1.0) {}
+  KOKKOS_INLINE_FUNCTION RefineCondMax& operator+=(const RefineCondMax& src) {
+    dmax  = fmax(dmax,  src.dmax);
+    ddmax = fmax(ddmax, src.ddmax);
+    dpmax = fmax(dpmax, src.dpmax);
+    umax  = fmax(umax,  src.umax);
+    return *this;
+  }
+  KOKKOS_INLINE_FUNCTION void operator+=(const volatile RefineCondMax& src) volatile {
+    dmax  = fmax(dmax,  src.dmax);
+    ddmax = fmax(ddmax, src.ddmax);
+    dpmax = fmax(dpmax, src.dpmax);
+    umax  = fmax(umax,  src.umax);
+  }
+};
+
+namespace Kokkos {  // reduction identity must be defined in Kokkos namespace
+template<>
+struct reduction_identity<RefineCondMax> {
+  KOKKOS_FORCEINLINE_FUNCTION static RefineCondMax sum() {return RefineCondMax();}
+};
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn bool MeshRefinement::CheckForRefinement()
 //! \brief Checks for refinement/de-refinement and sets refine_flag(m) for all
@@ -167,20 +283,68 @@ void MeshRefinement::AdaptiveMeshRefinement(Driver *pdriver, ParameterInput *pin
 //! pointer in the problem generator.
 
 void MeshRefinement::CheckForRefinement(MeshBlockPack* pmbp) {
+  ResetRefinementFlags();
+
+  // increment cycle counter for each MB
+  for (int m=0; m<(pmy_mesh->nmb_total); ++m) {
+    ncyc_since_ref(m) += 1;
+  }
+  // with async_check, apply flags evaluated at end of last check cycle (if any)
+  if (async_check) {
+    ApplyAsyncCheck();
+    return;
+  }
+  if ((pmbp->pmesh->ncycle)%(ncyc_check_amr) != 0) {return;}  // not cycle to check
+
+  LaunchRefinementCriteria(pmbp);
+  // sync device array with host
+  refine_flag.template modify<DevExeSpace>();
+  refine_flag.template sync<HostMemSpace>();
+  refine_strength.template modify<DevExeSpace>();
+  refine_strength.template sync<HostMemSpace>();
+
+  int nmb = pmbp->nmb_thispack;
+  int mbs = pmy_mesh->gids_eachrank[global_variable::my_rank];
+  CheckLocalRefinementFlags(refine_flag.h_view.data(), mbs, nmb);
+#if MPI_PARALLEL_ENABLED
+  // Pass refine_flag between all ranks
+    MPI_Allgatherv(MPI_IN_PLACE, pmy_mesh->nmb_eachrank[global_variable::my_rank],
+                   MPI_INT, refine_flag.h_view.data(), pmy_mesh->nmb_eachrank,
+                   pmy_mesh->gids_eachrank, MPI_INT, global_variable::athena_comm);
+    MPI_Allgatherv(MPI_IN_PLACE, pmy_mesh->nmb_eachrank[global_variable::my_rank],
+                   MPI_ATHENA_REAL, refine_strength.h_view.data(), pmy_mesh->nmb_eachrank,
+                   pmy_mesh->gids_eachrank, MPI_ATHENA_REAL,
+                   global_variable::athena_comm);
+#endif
+  FinishRefinementFlags();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::ResetRefinementFlags()
+//! \brief Reallocates refine_flag and refine_strength for all MBs, and zeroes them.
+
+void MeshRefinement::ResetRefinementFlags() {
   // reallocate and zero refine_flag in host space and sync with device
   Kokkos::realloc(refine_flag, pmy_mesh->nmb_total);
+  Kokkos::realloc(refine_strength, pmy_mesh->nmb_total);
   for (int m=0; m<(pmy_mesh->nmb_total); ++m) {
     refine_flag.h_view(m) = 0;
+    refine_strength.h_view(m) = 0.0;
   }
   refine_flag.template modify<HostMemSpace>();
   refine_flag.template sync<DevExeSpace>();
+  refine_strength.template modify<HostMemSpace>();
+  refine_strength.template sync<DevExeSpace>();
+  return;
+}
 
-  // increment cycle counter for each MB
-  for (int m=0; m<(pmy_mesh->nmb_total); ++m) {
-    ncyc_since_ref(m) += 1;
-  }
-  if ((pmbp->pmesh->ncycle)%(ncyc_check_amr) != 0) {return;}  // not cycle to check
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::LaunchRefinementCriteria()
+//! \brief Launches kernels evaluating the default and user-defined refinement conditions
+//! on the MBs in the pack, which set refine_flag and refine_strength on the device.
 
+void MeshRefinement::LaunchRefinementCriteria(MeshBlockPack* pmbp) {
   // capture variables for kernels
   auto &multi_d = pmy_mesh->multi_d;
   auto &three_d = pmy_mesh->three_d;
@@ -191,75 +355,89 @@ void MeshRefinement::CheckForRefinement(MeshBlockPack* pmbp) {
   const int nkji = nx3*nx2*nx1;
   const int nji  = nx2*nx1;
 
-  // check (on device) Hydro/MHD refinement conditions for cons vars over all MeshBlocks
+  // check (on device) Hydro/MHD refinement conditions for cons vars over all MeshBlocks,
+  // and user condition defined as a device hook (see pgen/user_hooks.hpp) if any
   auto refine_flag_ = refine_flag;
-  auto &dens_thresh  = d_threshold_;
-  auto &ddens_thresh = dd_threshold_;
-  auto &dpres_thresh = dp_threshold_;
+  auto refine_strength_ = refine_strength;
+  bool check_cons = ((pmbp->phydro != nullptr) || (pmbp->pmhd != nullptr)) && check_cons_;
+  Real dens_thresh  = (check_cons)? d_threshold_ : 0.0;
+  Real ddens_thresh = (check_cons)? dd_threshold_ : 0.0;
+  Real dpres_thresh = (check_cons)? dp_threshold_ : 0.0;
+  auto &ref_hook = pmy_mesh->pgen->user_ref_hook;
+  ref_hook.Update(pmy_mesh);
+  auto user_ref = ref_hook;
   int nmb = pmbp->nmb_thispack;
   int mbs = pmy_mesh->gids_eachrank[global_variable::my_rank];
-  if (((pmbp->phydro != nullptr) || (pmbp->pmhd != nullptr)) && check_cons_) {
-    auto &u0 = (pmbp->phydro != nullptr)? pmbp->phydro->u0 : pmbp->pmhd->u0;
-    auto &w0 = (pmbp->phydro != nullptr)? pmbp->phydro->w0 : pmbp->pmhd->w0;
+  if (check_cons || user_hooks::RefinementCondition::enabled) {
+    DvceArray5D<Real> u0, w0;
+    if (check_cons) {
+      u0 = (pmbp->phydro != nullptr)? pmbp->phydro->u0 : pmbp->pmhd->u0;
+      w0 = (pmbp->phydro != nullptr)? pmbp->phydro->w0 : pmbp->pmhd->w0;
+    }
 
     par_for_outer("ConsRefineCond",DevExeSpace(), 0, 0, 0, (nmb-1),
     KOKKOS_LAMBDA(TeamMember_t tmember, const int m) {
-      // density threshold
-      if (dens_thresh!= 0.0) {
-        Real team_dmax=0.0;
-        Kokkos::parallel_reduce(Kokkos::TeamThreadRange(tmember, nkji),
-        [=](const int idx, Real& dmax) {
-          int k = (idx)/nji;
-          int j = (idx - k*nji)/nx1;
-          int i = (idx - k*nji - j*nx1) + is;
-          j += js;
-          k += ks;
-          dmax = fmax(u0(m,IDN,k,j,i), dmax);
-        },Kokkos::Max<Real>(team_dmax));
-
-        if (team_dmax > dens_thresh) {refine_flag_.d_view(m+mbs) = 1;}
-        if (team_dmax < dens_thresh) {refine_flag_.d_view(m+mbs) = -1;}
-      }
-
-      // density gradient threshold
-      if (ddens_thresh != 0.0) {
-        Real team_ddmax;
-        Kokkos::parallel_reduce(Kokkos::TeamThreadRange(tmember, nkji),
-        [=](const int idx, Real& ddmax) {
-          int k = (idx)/nji;
-          int j = (idx - k*nji)/nx1;
-          int i = (idx - k*nji - j*nx1) + is;
-          j += js;
-          k += ks;
+      // compute maxima of all enabled conditions in a single pass over MeshBlock
+      RefineCondMax team_max;
+      Kokkos::parallel_reduce(Kokkos::TeamThreadRange(tmember, nkji),
+      [=](const int idx, RefineCondMax& rmax) {
+        int k = (idx)/nji;
+        int j = (idx - k*nji)/nx1;
+        int i = (idx - k*nji - j*nx1) + is;
+        j += js;
+        k += ks;
+        // density threshold
+        if (dens_thresh != 0.0) {
+          rmax.dmax = fmax(u0(m,IDN,k,j,i), rmax.dmax);
+        }
+        // density gradient threshold
+        if (ddens_thresh != 0.0) {
           Real d2 = SQR(u0(m,IDN,k,j,i+1) - u0(m,IDN,k,j,i-1));
           if (multi_d) {d2 += SQR(u0(m,IDN,k,j+1,i) - u0(m,IDN,k,j-1,i));}
           if (three_d) {d2 += SQR(u0(m,IDN,k+1,j,i) - u0(m,IDN,k-1,j,i));}
-          ddmax = fmax((sqrt(d2)/u0(m,IDN,k,j,i)), ddmax);
-        },Kokkos::Max<Real>(team_ddmax));
-
-        if (team_ddmax > ddens_thresh) {refine_flag_.d_view(m+mbs) = 1;}
-        if (team_ddmax < 0.25*ddens_thresh) {refine_flag_.d_view(m+mbs) = -1;}
-      }
-
-      // pressure gradient threshold
-      if (dpres_thresh != 0.0) {
-        Real team_dpmax;
-        Kokkos::parallel_reduce(Kokkos::TeamThreadRange(tmember, nkji),
-        [=](const int idx, Real& dpmax) {
-          int k = (idx)/nji;
-          int j = (idx - k*nji)/nx1;
-          int i = (idx - k*nji - j*nx1) + is;
-          j += js;
-          k += ks;
+          rmax.ddmax = fmax((sqrt(d2)/u0(m,IDN,k,j,i)), rmax.ddmax);
+        }
+        // pressure gradient threshold
+        if (dpres_thresh != 0.0) {
           Real d2 = SQR(w0(m,IEN,k,j,i+1) - w0(m,IEN,k,j,i-1));
           if (multi_d) {d2 += SQR(w0(m,IEN,k,j+1,i) - w0(m,IEN,k,j-1,i));}
           if (three_d) {d2 += SQR(w0(m,IEN,k+1,j,i) - w0(m,IEN,k-1,j,i));}
-          dpmax = fmax((sqrt(d2)/w0(m,IEN,k,j,i)), dpmax);
-        },Kokkos::Max<Real>(team_dpmax));
-
-        if (team_dpmax > dpres_thresh) {refine_flag_.d_view(m+mbs) = 1;}
-        if (team_dpmax < 0.25*dpres_thresh) {refine_flag_.d_view(m+mbs) = -1;}
-      }
+          rmax.dpmax = fmax((sqrt(d2)/w0(m,IEN,k,j,i)), rmax.dpmax);
+        }
+        // user condition
+        if constexpr (user_hooks::RefinementCondition::enabled) {
+          rmax.umax = fmax(static_cast<Real>(user_ref(m,k,j,i)), rmax.umax);
+        }
+      },Kokkos::Sum<RefineCondMax>(team_max));
+
+      // set flag, with later conditions taking precedence as before.  Strength of
+      // refinement is largest ratio of any condition to its threshold
+      Kokkos::single(Kokkos::PerTeam(tmember), [&]() {
+        Real strength = 0.0;
+        if (dens_thresh != 0.0) {strength = fmax(strength, team_max.dmax/dens_thresh);}
+        if (ddens_thresh != 0.0) {strength = fmax(strength, team_max.ddmax/ddens_thresh);}
+        if (dpres_thresh != 0.0) {strength = fmax(strength, team_max.dpmax/dpres_thresh);}
+        refine_strength_.d_view(m+mbs) = strength;
+        if (dens_thresh != 0.0) {
+          if (team_max.dmax > dens_thresh) {refine_flag_.d_view(m+mbs) = 1;}
+          if (team_max.dmax < dens_thresh) {refine_flag_.d_view(m+mbs) = -1;}
+        }
+        if (ddens_thresh != 0.0) {
+          if (team_max.ddmax > ddens_thresh) {refine_flag_.d_view(m+mbs) = 1;}
+          if (team_max.ddmax < 0.25*ddens_thresh) {refine_flag_.d_view(m+mbs) = -1;}
+        }
+        if (dpres_thresh != 0.0) {
+          if (team_max.dpmax > dpres_thresh) {refine_flag_.d_view(m+mbs) = 1;}
+          if (team_max.dpmax < 0.25*dpres_thresh) {refine_flag_.d_view(m+mbs) = -1;}
+        }
+        if constexpr (user_hooks::RefinementCondition::enabled) {
+          if (team_max.umax > 0.0) {
+            refine_flag_.d_view(m+mbs) = 1;
+            refine_strength_.d_view(m+mbs) = fmax(strength, 1.0);
+          }
+          if (team_max.umax < 0.0) {refine_flag_.d_view(m+mbs) = -1;}
+        }
+      });
     });
   }
 
@@ -267,34 +445,177 @@ void MeshRefinement::CheckForRefinement(MeshBlockPack* pmbp) {
   if (pmy_mesh->pgen->user_ref_func != nullptr) {
     pmy_mesh->pgen->user_ref_func(pmbp);
   }
-  // sync device array with host
-  refine_flag.template modify<DevExeSpace>();
-  refine_flag.template sync<HostMemSpace>();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::CheckLocalRefinementFlags()
+//! \brief Clears (on host) flags of the nmb MBs starting at gid mbs that cannot be
+//! refined/derefined, since they are at the max/root level or changed recently.
 
+void MeshRefinement::CheckLocalRefinementFlags(int *flag, int mbs, int nmb) {
   // Check (on host) for MeshBlocks at max/root level flagged for refine/derefine
   for (int m=0; m<nmb; ++m) {
     if (pmy_mesh->lloc_eachmb[m+mbs].level == pmy_mesh->max_level) {
-      if (refine_flag.h_view(m+mbs) > 0) {refine_flag.h_view(m+mbs) = 0;}
+      if (flag[m+mbs] > 0) {flag[m+mbs] = 0;}
     }
     if (pmy_mesh->lloc_eachmb[m+mbs].level == pmy_mesh->root_level) {
-      if (refine_flag.h_view(m+mbs) < 0) {refine_flag.h_view(m+mbs) = 0;}
+      if (flag[m+mbs] < 0) {flag[m+mbs] = 0;}
     }
   }
 
   // Check (on host) that MB has not been recently refined
   for (int m=0; m<nmb; ++m) {
-    if (ncyc_since_ref(m+mbs) < refinement_interval) {refine_flag.h_view(m+mbs) = 0;}
+    if (ncyc_since_ref(m+mbs) < refinement_interval) {flag[m+mbs] = 0;}
+    if (ncyc_since_ref(m+mbs) < derefine_interval && flag[m+mbs] < 0) {
+      flag[m+mbs] = 0;
+    }
   }
-#if MPI_PARALLEL_ENABLED
-  // Pass refine_flag between all ranks
-    MPI_Allgatherv(MPI_IN_PLACE, pmy_mesh->nmb_eachrank[global_variable::my_rank],
-                   MPI_INT, refine_flag.h_view.data(), pmy_mesh->nmb_eachrank,
-                   pmy_mesh->gids_eachrank, MPI_INT, MPI_COMM_WORLD);
-#endif
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::FinishRefinementFlags()
+//! \brief Applies (on host) hysteresis of derefinement and memory limits to flags of all
+//! MBs, once they have been passed between all ranks, and syncs them with the device.
+
+void MeshRefinement::FinishRefinementFlags() {
+  // Check (on host) that MB has been flagged for derefinement on ncheck_derefine
+  // successive checks.  Done over all MBs after flags passed so counts agree on all
+  // ranks.
+  for (int m=0; m<(pmy_mesh->nmb_total); ++m) {
+    if (refine_flag.h_view(m) < 0) {
+      nderef_checks(m) += 1;
+      if (nderef_checks(m) < ncheck_derefine) {refine_flag.h_view(m) = 0;}
+    } else {
+      nderef_checks(m) = 0;
+    }
+  }
+  // Limit (on host) refinement so new MBs fit within memory on all ranks
+  LimitRefinement();
+
   // sync host array with device
   refine_flag.template modify<HostMemSpace>();
   refine_flag.template sync<DevExeSpace>();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::LaunchAsyncCheck()
+//! \brief With async_check, launches refinement criteria at the end of each check cycle
+//! (after the mesh has been refined), and copies the flags to host asynchronously.
+//! Kernels and copies are queued on the default execution space ahead of the work of the
+//! next cycle, so they see the solution at the end of this cycle without a fence.
+
+void MeshRefinement::LaunchAsyncCheck(MeshBlockPack* pmbp) {
+  if (check_pending_ || exchange_pending_) return;
+  if ((pmbp->pmesh->ncycle)%(ncyc_check_amr) != 0) return;
+
+  ResetRefinementFlags();
+  LaunchRefinementCriteria(pmbp);
+  // user-defined conditions may set flags on host
+  refine_flag.template sync<DevExeSpace>();
+  Kokkos::realloc(next_flag_, pmy_mesh->nmb_total);
+  Kokkos::realloc(next_strength_, pmy_mesh->nmb_total);
+  Kokkos::deep_copy(DevExeSpace(), next_flag_, refine_flag.d_view);
+  Kokkos::deep_copy(DevExeSpace(), next_strength_, refine_strength.d_view);
+
+  // MBs on each rank may change with load balancing before flags are exchanged
+  check_gids_ = pmy_mesh->gids_eachrank[global_variable::my_rank];
+  check_nmb_ = pmbp->nmb_thispack;
+#if MPI_PARALLEL_ENABLED
+  check_nmb_eachrank_.assign(pmy_mesh->nmb_eachrank,
+                             pmy_mesh->nmb_eachrank + global_variable::nranks);
+  check_gids_eachrank_.assign(pmy_mesh->gids_eachrank,
+                              pmy_mesh->gids_eachrank + global_variable::nranks);
+#endif
+  check_pending_ = true;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::ApplyAsyncCheck()
+//! \brief With async_check, posts the flags launched on an earlier cycle to a
+//! non-blocking allgather on the next cycle, and copies the exchanged flags into
+//! refine_flag on the next check cycle, so that the mesh is refined with them.
+
+void MeshRefinement::ApplyAsyncCheck() {
+  if (check_pending_) {
+    // wait for copies to host queued at end of last cycle
+    Kokkos::fence();
+    CheckLocalRefinementFlags(next_flag_.data(), check_gids_, check_nmb_);
+#if MPI_PARALLEL_ENABLED
+    MPI_Iallgatherv(MPI_IN_PLACE, check_nmb_, MPI_INT, next_flag_.data(),
+                    check_nmb_eachrank_.data(), check_gids_eachrank_.data(), MPI_INT,
+                    amr_comm, &(check_req_[0]));
+    MPI_Iallgatherv(MPI_IN_PLACE, check_nmb_, MPI_ATHENA_REAL, next_strength_.data(),
+                    check_nmb_eachrank_.data(), check_gids_eachrank_.data(),
+                    MPI_ATHENA_REAL, amr_comm, &(check_req_[1]));
+#endif
+    check_pending_ = false;
+    exchange_pending_ = true;
+  }
+  if ((pmy_mesh->ncycle)%(ncyc_check_amr) != 0 || !(exchange_pending_)) return;
 
+#if MPI_PARALLEL_ENABLED
+  MPI_Waitall(2, check_req_, MPI_STATUSES_IGNORE);
+#endif
+  exchange_pending_ = false;
+  if (static_cast<int>(next_flag_.extent(0)) != pmy_mesh->nmb_total) return;
+  for (int m=0; m<(pmy_mesh->nmb_total); ++m) {
+    refine_flag.h_view(m) = next_flag_(m);
+    refine_strength.h_view(m) = next_strength_(m);
+  }
+  refine_strength.template modify<HostMemSpace>();
+  refine_strength.template sync<DevExeSpace>();
+  FinishRefinementFlags();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::LimitRefinement()
+//! \brief Limits the number of MBs flagged for refinement so that the new MeshBlocks fit
+//! within the memory available on all ranks, rather than exceeding max_nmb_per_rank
+//! (which is fatal) in RedistAndRefineMeshBlocks().  All device arrays are allocated
+//! for nmb_maxperrank MBs, so the memory budget is nranks*nmb_maxperrank MBs in total,
+//! less nmb_reserve MBs held back for those created to enforce 2:1 refinement ratios.
+//! Each refinement adds (nleaf-1) MBs, and derefinements are not counted since they
+//! may be cancelled.  When too many MBs are flagged, those with the largest
+//! refine_strength are refined first (ties broken by gid), so refinement degrades
+//! gracefully.  Flags are identical on all ranks, so result is the same on all ranks.
+
+void MeshRefinement::LimitRefinement() {
+  int nleaf = 2;
+  if (pmy_mesh->two_d) {nleaf = 4;}
+  if (pmy_mesh->three_d) {nleaf = 8;}
+
+  std::vector<int> cand;
+  for (int m=0; m<(pmy_mesh->nmb_total); ++m) {
+    if (refine_flag.h_view(m) == 1) {cand.push_back(m);}
+  }
+  int navail = global_variable::nranks*pmy_mesh->nmb_maxperrank - pmy_mesh->nmb_total
+               - nmb_reserve;
+  int nallow = std::max(navail, 0)/(nleaf-1);
+  if (static_cast<int>(cand.size()) <= nallow) {return;}
+
+  // keep strongest nallow refinements.  Flags set only by user or z4c conditions have
+  // zero strength, and are treated as lying just at the threshold.
+  auto &rstr = refine_strength.h_view;
+  std::stable_sort(cand.begin(), cand.end(), [&rstr](int a, int b) {
+    Real sa = (rstr(a) > 0.0)? rstr(a) : 1.0;
+    Real sb = (rstr(b) > 0.0)? rstr(b) : 1.0;
+    return sa > sb;
+  });
+  for (std::size_t n=nallow; n<cand.size(); ++n) {
+    refine_flag.h_view(cand[n]) = 0;
+  }
+  if (global_variable::my_rank == 0) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Only " << nallow << " of " << cand.size() << " MeshBlocks flagged for "
+              << "refinement will be refined at cycle " << pmy_mesh->ncycle << ", since "
+              << "<mesh_refinement>/max_nmb_per_rank=" << pmy_mesh->nmb_maxperrank
+              << " would be exceeded" << std::endl;
+  }
   return;
 }
 
@@ -309,18 +630,18 @@ void MeshRefinement::UpdateMeshBlockTree(int &nnew, int &ndel) {
   if (pmy_mesh->two_d) {nleaf = 4;}
   if (pmy_mesh->three_d) {nleaf = 8;}
 
-  // count the number of the blocks to be (de)refined on this rank
-  nref_eachrank[global_variable::my_rank] = 0;
-  nderef_eachrank[global_variable::my_rank] = 0;
-  int mbs = pmy_mesh->gids_eachrank[global_variable::my_rank];
-  for (int i=0; i<(pmy_mesh->nmb_thisrank); ++i) {
-    if (refine_flag.h_view(i+mbs) ==  1) nref_eachrank[global_variable::my_rank]++;
-    if (refine_flag.h_view(i+mbs) == -1) nderef_eachrank[global_variable::my_rank]++;
+  // count the number of the blocks to be (de)refined on every rank.  Since refine_flag
+  // has already been passed between all ranks in CheckForRefinement(), and the logical
+  // locations of all MBs are stored on every rank, no further communication is needed.
+  for (int n=0; n<global_variable::nranks; n++) {
+    nref_eachrank[n] = 0;
+    nderef_eachrank[n] = 0;
+    int mbs = pmy_mesh->gids_eachrank[n];
+    for (int i=0; i<(pmy_mesh->nmb_eachrank[n]); ++i) {
+      if (refine_flag.h_view(i+mbs) ==  1) nref_eachrank[n]++;
+      if (refine_flag.h_view(i+mbs) == -1) nderef_eachrank[n]++;
+    }
   }
-#if MPI_PARALLEL_ENABLED
-  MPI_Allgather(MPI_IN_PLACE, 1, MPI_INT, nref_eachrank,   1, MPI_INT, MPI_COMM_WORLD);
-  MPI_Allgather(MPI_IN_PLACE, 1, MPI_INT, nderef_eachrank, 1, MPI_INT, MPI_COMM_WORLD);
-#endif
 
   // count the number of the blocks to be (de)refined over all ranks
   int tnref = 0, tnderef = 0;
@@ -343,42 +664,17 @@ void MeshRefinement::UpdateMeshBlockTree(int &nnew, int &ndel) {
     cllderef = new LogicalLocation[tnderef/nleaf];
   }
 
-  // calculate running sum of number of MBs to be refined/de-refined
-  nref_rsum[0] = 0;
-  nderef_rsum[0] = 0;
-  for (int n=1; n<global_variable::nranks; n++) {
-    nref_rsum[n] = nref_rsum[n-1] + nref_eachrank[n-1];
-    nderef_rsum[n] = nderef_rsum[n-1] + nderef_eachrank[n-1];
-  }
-
-  // collect logical locations of MBs to be refined/derefined into arrays
+  // collect logical locations of MBs to be refined/derefined over all ranks into arrays
   {
-    int iref = nref_rsum[global_variable::my_rank];
-    int ideref = nderef_rsum[global_variable::my_rank];
-    for (int i=0; i<(pmy_mesh->nmb_thisrank); ++i) {
-      int gid = pmy_mesh->pmb_pack->pmb->mb_gid.h_view(i);
-      if (refine_flag.h_view(i+mbs) ==  1) {
-        llref[iref++] = pmy_mesh->lloc_eachmb[gid];;
-      } else if (refine_flag.h_view(i+mbs) == -1 && tnderef >= nleaf) {
+    int iref = 0, ideref = 0;
+    for (int gid=0; gid<(pmy_mesh->nmb_total); ++gid) {
+      if (refine_flag.h_view(gid) ==  1) {
+        llref[iref++] = pmy_mesh->lloc_eachmb[gid];
+      } else if (refine_flag.h_view(gid) == -1 && tnderef >= nleaf) {
         llderef[ideref++] = pmy_mesh->lloc_eachmb[gid];
       }
     }
   }
-#if MPI_PARALLEL_ENABLED
-  // Now pass Logical Locations of MBs updated between all ranks.
-  MPI_Datatype lloc_type;
-  MPI_Type_contiguous(4, MPI_INT32_T, &lloc_type);
-  MPI_Type_commit(&lloc_type);
-  if (tnref > 0) {
-    MPI_Allgatherv(MPI_IN_PLACE, nref_eachrank[global_variable::my_rank], lloc_type,
-                   llref, nref_eachrank, nref_rsum, lloc_type, MPI_COMM_WORLD);
-  }
-  if (tnderef >= nleaf) {
-    MPI_Allgatherv(MPI_IN_PLACE, nderef_eachrank[global_variable::my_rank], lloc_type,
-                   llderef, nderef_eachrank, nderef_rsum, lloc_type, MPI_COMM_WORLD);
-  }
-  MPI_Type_free(&lloc_type);
-#endif
 
   // Each rank now has a complete list of the LLs of MBs refined/derefined on other ranks
   // calculate the list of the newly derefined blocks
@@ -505,17 +801,31 @@ void MeshRefinement::RedistAndRefineMeshBlocks(ParameterInput *pin, int nnew, in
   }
 
   // Step 3.
-  // Calculate new load balance. Initialize new cost array with the simplest estimate
-  // possible: all the blocks are equal
-  // TODO(@user): implement variable cost per MeshBlock as needed
+  // Calculate new load balance. Cost of new MBs is inherited from old MBs: refined MBs
+  // take cost of parent, de-refined MBs take average cost of leaves.  Note all costs are
+  // equal unless automatic load balancing is used (or costs were read from restart).
   new_cost_eachmb = new float[new_nmb];
   new_rank_eachmb = new int[new_nmb];
   new_gids_eachrank = new int[global_variable::nranks];
   new_nmb_eachrank = new int[global_variable::nranks];
 
-  for (int i=0; i<new_nmb; i++) {new_cost_eachmb[i] = 1.0;}
-  pm->LoadBalance(new_cost_eachmb, new_rank_eachmb, new_gids_eachrank, new_nmb_eachrank,
-                  new_nmb_total);
+  for (int newm=0; newm<new_nmb; newm++) {
+    int oldm = newtoold[newm];
+    if (pm->lloc_eachmb[oldm].level > new_lloc_eachmb[newm].level) {  // de-refined
+      float cost = 0.0;
+      for (int l=0; l<nleaf; l++) {cost += pm->cost_eachmb[oldm+l];}
+      new_cost_eachmb[newm] = cost/static_cast<float>(nleaf);
+    } else {                                                          // same or refined
+      new_cost_eachmb[newm] = pm->cost_eachmb[oldm];
+    }
+  }
+  if (replay_amr) {
+    ReplayLoadBalance(new_nmb_total);
+  } else {
+    pm->LoadBalance(new_cost_eachmb, new_rank_eachmb, new_gids_eachrank,
+                    new_nmb_eachrank, new_nmb_total);
+  }
+  if (record_amr) {RecordEvent((nnew != 0 || ndel != 0), new_nmb_total);}
   if (new_nmb_eachrank[global_variable::my_rank] > pm->nmb_maxperrank) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
         << "Number of MeshBlocks in this rank on new tree = "
@@ -648,8 +958,21 @@ void MeshRefinement::RedistAndRefineMeshBlocks(ParameterInput *pin, int nnew, in
   Kokkos::realloc(ncyc_since_ref, new_nmb_total);
   Kokkos::deep_copy(ncyc_since_ref, new_ncyc_since_ref);
 
+  // Update new number of successive checks flagged for derefinement
+  HostArray1D<int> new_nderef_checks("nndref",new_nmb_total);
+  for (int m=0; m<(new_nmb_total); ++m) {
+    int oldm = newtoold[m];
+    new_nderef_checks(m) = (refine_flag.h_view(oldm) != 0)? 0 : nderef_checks(oldm);
+  }
+  Kokkos::realloc(nderef_checks, new_nmb_total);
+  Kokkos::deep_copy(nderef_checks, new_nderef_checks);
+
   // Step 10.
   // Update data in Mesh/MeshBlockPack/MeshBlock classes with new grid properties
+  // Save neighbor data of old MBs, to be reused for MBs whose neighbors are unchanged
+  int ombs = pm->gids_eachrank[global_variable::my_rank];
+  int ombe = ombs + pm->nmb_eachrank[global_variable::my_rank] - 1;
+  DualArray2D<NeighborBlock> old_nghbr = pm->pmb_pack->pmb->nghbr;
   delete [] pm->lloc_eachmb;
   delete [] pm->rank_eachmb;
   delete [] pm->cost_eachmb;
@@ -671,7 +994,25 @@ void MeshRefinement::RedistAndRefineMeshBlocks(ParameterInput *pin, int nnew, in
   delete (pm->pmb_pack->pcoord);
   pm->pmb_pack->AddMeshBlocks(pin);
   pm->pmb_pack->AddCoordinates(pin);
-  pm->pmb_pack->pmb->SetNeighbors(pm->ptree, pm->rank_eachmb);
+
+  // Neighbors of a MB can only change if it, or one of its old neighbors, was refined or
+  // derefined.  Otherwise (if MB was on this rank before) reuse its old neighbor data,
+  // and only search the tree for MBs within one MB of a refined/derefined region.
+  int nmb = pm->pmb_pack->nmb_thispack;
+  int nnghbr = old_nghbr.extent_int(1);
+  std::vector<int> old_b(nmb, -1);
+  for (int b=0; b<nmb; ++b) {
+    int oldm = newtoold[b + pm->pmb_pack->gids];
+    if (oldm < ombs || oldm > ombe || refine_flag.h_view(oldm) != 0) continue;
+    bool reuse = true;
+    for (int n=0; n<nnghbr && reuse; ++n) {
+      int ngid = old_nghbr.h_view(oldm-ombs,n).gid;
+      if (ngid >= 0 && refine_flag.h_view(ngid) != 0) {reuse = false;}
+    }
+    if (reuse) {old_b[b] = oldm - ombs;}
+  }
+  pm->pmb_pack->pmb->SetNeighbors(pm->ptree, pm->rank_eachmb, old_b, old_nghbr, oldtonew);
+  pm->mesh_version++;
 
   // clean-up and return
   delete [] newtoold;
@@ -685,53 +1026,30 @@ void MeshRefinement::RedistAndRefineMeshBlocks(ParameterInput *pin, int nnew, in
 //! cell-centered variables in input coarse array for the nleaf MeshBlock indices that are
 //! immediately following to the appropriate quadrant of the MeshBlock m in the input
 //! fine array,overwriting any data located there.  Only operates on MBs on the same rank
+//! All copies are performed in a single kernel over the entries in copy_list.
 
 void MeshRefinement::DerefineCCSameRank(DvceArray5D<Real> &a, DvceArray5D<Real> &ca) {
-  // nleaf = number of leaf MeshBlocks per refined block
-  int nleaf = 2;
-  if (pmy_mesh->two_d) nleaf = 4;
-  if (pmy_mesh->three_d) nleaf = 8;
+  int ncopy = SetDerefineCopyList();
+  if (ncopy == 0) return;
 
   auto &indcs = pmy_mesh->mb_indcs;
-  auto &is  = indcs.is,  &js  = indcs.js,  &ks  = indcs.ks;
-  auto &cis = indcs.cis, &cjs = indcs.cjs, &cks = indcs.cks;
-  auto &cie = indcs.cie, &cje = indcs.cje, &cke = indcs.cke;
-  auto &cnx1 = indcs.cnx1, &cnx2 = indcs.cnx2, &cnx3 = indcs.cnx3;
-
-  // Set indices of source (coarse) array
-  std::pair<int,int> isrc = std::make_pair(cis,cie+1);
-  std::pair<int,int> jsrc = std::make_pair(cjs,cje+1);
-  std::pair<int,int> ksrc = std::make_pair(cks,cke+1);
-
-  // loop over old MBs
-  int ombs = pmy_mesh->gids_eachrank[global_variable::my_rank];
-  int ombe = ombs + pmy_mesh->nmb_eachrank[global_variable::my_rank] - 1;
-  for (int oldm=ombs; oldm<=ombe; ++oldm) {
-    if (refine_flag.h_view(oldm) < -1) {  // only derefine if nleaf blocks flagged
-      int newm = oldtonew[oldm];
-      // only copy data if target MB stays on this rank
-      if (new_rank_eachmb[newm] == global_variable::my_rank) {
-        for (int l=0; l<nleaf; l++) {
-          // only move if source array on this rank
-          if ((oldm+l) <= ombe) {
-            LogicalLocation &lloc = pmy_mesh->lloc_eachmb[oldm+l];
-            int ox1 = ((lloc.lx1 & 1) == 1);
-            int ox2 = ((lloc.lx2 & 1) == 1);
-            int ox3 = ((lloc.lx3 & 1) == 1);
-            std::pair<int,int> idst = std::make_pair((is+ox1*cnx1),(is+(ox1+1)*cnx1));
-            std::pair<int,int> jdst = std::make_pair((js+ox2*cnx2),(js+(ox2+1)*cnx2));
-            std::pair<int,int> kdst = std::make_pair((ks+ox3*cnx3),(ks+(ox3+1)*cnx3));
-
-            // Copy data directly from coarse arrays in MBs to fine array in target MB
-            // use indices of old MBs since this function called before CopyL/R
-            auto src = Kokkos::subview(ca,(oldm-ombs+l),Kokkos::ALL,ksrc,jsrc,isrc);
-            auto dst = Kokkos::subview( a,(oldm-ombs  ),Kokkos::ALL,kdst,jdst,idst);
-            Kokkos::deep_copy(DevExeSpace(), dst, src);
-          }
-        }
-      }
-    }
-  }
+  int &is  = indcs.is,  &js  = indcs.js,  &ks  = indcs.ks;
+  int &cis = indcs.cis, &cjs = indcs.cjs, &cks = indcs.cks;
+  int &cnx1 = indcs.cnx1, &cnx2 = indcs.cnx2, &cnx3 = indcs.cnx3;
+  int nvar = a.extent_int(1);
+  auto &clist = copy_list;
+
+  // Copy data directly from coarse arrays in MBs to fine array in target MB
+  // use indices of old MBs since this function called before CopyL/R
+  par_for("deref_cc", DevExeSpace(),0,(ncopy-1),0,(nvar-1),0,(cnx3-1),0,(cnx2-1),
+                                    0,(cnx1-1),
+  KOKKOS_LAMBDA(int l, int n, int k, int j, int i) {
+    int msrc = clist.d_view(l,0), mdst = clist.d_view(l,1);
+    int fi = is + clist.d_view(l,2)*cnx1 + i;
+    int fj = js + clist.d_view(l,3)*cnx2 + j;
+    int fk = ks + clist.d_view(l,4)*cnx3 + k;
+    a(mdst,n,fk,fj,fi) = ca(msrc,n,cks+k,cjs+j,cis+i);
+  });
   return;
 }
 
@@ -740,63 +1058,33 @@ void MeshRefinement::DerefineCCSameRank(DvceArray5D<Real> &a, DvceArray5D<Real>
 //! \brief Same as DerefineCCSameRank, except for face-centered variables
 
 void MeshRefinement::DerefineFCSameRank(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Real> &cb) {
-  // nleaf = number of leaf MeshBlocks per refined block
-  int nleaf = 2;
-  if (pmy_mesh->two_d) nleaf = 4;
-  if (pmy_mesh->three_d) nleaf = 8;
+  int ncopy = SetDerefineCopyList();
+  if (ncopy == 0) return;
 
   auto &indcs = pmy_mesh->mb_indcs;
-  auto &is  = indcs.is,  &js  = indcs.js,  &ks  = indcs.ks;
-  auto &cis = indcs.cis, &cjs = indcs.cjs, &cks = indcs.cks;
-  auto &cie = indcs.cie, &cje = indcs.cje, &cke = indcs.cke;
-  auto &cnx1 = indcs.cnx1, &cnx2 = indcs.cnx2, &cnx3 = indcs.cnx3;
-
-  // Set indices of source (coarse) array
-  std::pair<int,int> isrc  = std::make_pair(cis,cie+1);
-  std::pair<int,int> isrc1 = std::make_pair(cis,cie+2);
-  std::pair<int,int> jsrc  = std::make_pair(cjs,cje+1);
-  std::pair<int,int> jsrc1 = std::make_pair(cjs,cje+2);
-  std::pair<int,int> ksrc  = std::make_pair(cks,cke+1);
-  std::pair<int,int> ksrc1 = std::make_pair(cks,cke+2);
-
-  // loop over old MBs
-  int ombs = pmy_mesh->gids_eachrank[global_variable::my_rank];
-  int ombe = ombs + pmy_mesh->nmb_eachrank[global_variable::my_rank] - 1;
-  for (int oldm=ombs; oldm<=ombe; ++oldm) {
-    if (refine_flag.h_view(oldm) < -1) {  // only derefine if nleaf blocks flagged
-      int newm = oldtonew[oldm];
-      // only copy data if target MB stays on this rank
-      if (new_rank_eachmb[newm] == global_variable::my_rank) {
-        for (int l=0; l<nleaf; l++) {
-          // only move if source array on this rank
-          if ((oldm+l) <= ombe) {
-            LogicalLocation &lloc = pmy_mesh->lloc_eachmb[oldm+l];
-            int ox1 = ((lloc.lx1 & 1) == 1);
-            int ox2 = ((lloc.lx2 & 1) == 1);
-            int ox3 = ((lloc.lx3 & 1) == 1);
-            std::pair<int,int> idst  = std::make_pair((is+ox1*cnx1),(is+(ox1+1)*cnx1  ));
-            std::pair<int,int> idst1 = std::make_pair((is+ox1*cnx1),(is+(ox1+1)*cnx1+1));
-            std::pair<int,int> jdst  = std::make_pair((js+ox2*cnx2),(js+(ox2+1)*cnx2  ));
-            std::pair<int,int> jdst1 = std::make_pair((js+ox2*cnx2),(js+(ox2+1)*cnx2+1));
-            std::pair<int,int> kdst  = std::make_pair((ks+ox3*cnx3),(ks+(ox3+1)*cnx3  ));
-            std::pair<int,int> kdst1 = std::make_pair((ks+ox3*cnx3),(ks+(ox3+1)*cnx3+1));
-
-            // Copy data directly from coarse arrays in MBs to fine array in target MB
-            // use indices of old MBs since this function called before CopyL/R
-            auto src1 = Kokkos::subview(cb.x1f,(oldm-ombs+l),ksrc,jsrc,isrc1);
-            auto dst1 = Kokkos::subview( b.x1f,(oldm-ombs  ),kdst,jdst,idst1);
-            Kokkos::deep_copy(DevExeSpace(), dst1, src1);
-            auto src2 = Kokkos::subview(cb.x2f,(oldm-ombs+l),ksrc,jsrc1,isrc);
-            auto dst2 = Kokkos::subview( b.x2f,(oldm-ombs  ),kdst,jdst1,idst);
-            Kokkos::deep_copy(DevExeSpace(), dst2, src2);
-            auto src3 = Kokkos::subview(cb.x3f,(oldm-ombs+l),ksrc1,jsrc,isrc);
-            auto dst3 = Kokkos::subview( b.x3f,(oldm-ombs  ),kdst1,jdst,idst);
-            Kokkos::deep_copy(DevExeSpace(), dst3, src3);
-          }
-        }
-      }
+  int &is  = indcs.is,  &js  = indcs.js,  &ks  = indcs.ks;
+  int &cis = indcs.cis, &cjs = indcs.cjs, &cks = indcs.cks;
+  int &cnx1 = indcs.cnx1, &cnx2 = indcs.cnx2, &cnx3 = indcs.cnx3;
+  auto &clist = copy_list;
+
+  // Copy data directly from coarse arrays in MBs to fine array in target MB.  Loop
+  // limits include the extra face in each direction, each component masks the rest.
+  par_for("deref_fc", DevExeSpace(),0,(ncopy-1),0,cnx3,0,cnx2,0,cnx1,
+  KOKKOS_LAMBDA(int l, int k, int j, int i) {
+    int msrc = clist.d_view(l,0), mdst = clist.d_view(l,1);
+    int fi = is + clist.d_view(l,2)*cnx1 + i;
+    int fj = js + clist.d_view(l,3)*cnx2 + j;
+    int fk = ks + clist.d_view(l,4)*cnx3 + k;
+    if (k < cnx3 && j < cnx2) {
+      b.x1f(mdst,fk,fj,fi) = cb.x1f(msrc,cks+k,cjs+j,cis+i);
     }
-  }
+    if (k < cnx3 && i < cnx1) {
+      b.x2f(mdst,fk,fj,fi) = cb.x2f(msrc,cks+k,cjs+j,cis+i);
+    }
+    if (j < cnx2 && i < cnx1) {
+      b.x3f(mdst,fk,fj,fi) = cb.x3f(msrc,cks+k,cjs+j,cis+i);
+    }
+  });
   return;
 }
 
@@ -905,9 +1193,13 @@ void MeshRefinement::CopyFC(DvceFaceFld4D<Real> &b) {
 //! \brief For any MeshBlock m flagged for refinment (refine_flag = 1), copies
 //! cell-centered variables in octants of input fine array to the input coarse arrays at
 //! the nleaf-index locations that are immediately following (overwriting any data located
-//! there).  Only operates on MBs on the same rank.
+//! there).  Only operates on MBs on the same rank.  All copies are performed in a single
+//! kernel over the entries in copy_list.
 
 void MeshRefinement::CopyForRefinementCC(DvceArray5D<Real> &a, DvceArray5D<Real> &ca) {
+  int ncopy = SetRefineCopyList();
+  if (ncopy == 0) return;
+
   auto &indcs = pmy_mesh->mb_indcs;
   auto &ng = indcs.ng;
   int il = indcs.cis - ng, iu = indcs.cie + ng;
@@ -919,39 +1211,19 @@ void MeshRefinement::CopyForRefinementCC(DvceArray5D<Real> &a, DvceArray5D<Real>
   if (pmy_mesh->three_d) {
     kl -= ng; ku += ng;
   }
-  auto &cnx1 = indcs.cnx1, &cnx2 = indcs.cnx2, &cnx3 = indcs.cnx3;
-
-  // Set indices of destination (coarse) array
-  std::pair<int,int> idst = std::make_pair(il,iu+1);
-  std::pair<int,int> jdst = std::make_pair(jl,ju+1);
-  std::pair<int,int> kdst = std::make_pair(kl,ku+1);
-
-  // loop over new MBs on this rank
-  int nmbs = new_gids_eachrank[global_variable::my_rank];
-  int nmbe = nmbs + new_nmb_eachrank[global_variable::my_rank] - 1;
-  for (int newm=nmbs; newm<=nmbe; ++newm) {
-    int oldm = newtoold[newm];
-    if (refine_flag.h_view(oldm) > 0) {
-      // only copy if old and new location of MB on this rank
-      if ((new_rank_eachmb[oldtonew[oldm]] == global_variable::my_rank) &&
-          (new_rank_eachmb[newm] == global_variable::my_rank)) {
-        int msrc = oldtonew[oldm] - nmbs;
-        int mdst = newm - nmbs;
-        LogicalLocation &lloc = new_lloc_eachmb[newm];
-        int ox1 = ((lloc.lx1 & 1) == 1);
-        int ox2 = ((lloc.lx2 & 1) == 1);
-        int ox3 = ((lloc.lx3 & 1) == 1);
-        std::pair<int,int> isrc = std::make_pair((il + ox1*cnx1),(iu+1 + ox1*cnx1));
-        std::pair<int,int> jsrc = std::make_pair((jl + ox2*cnx2),(ju+1 + ox2*cnx2));
-        std::pair<int,int> ksrc = std::make_pair((kl + ox3*cnx3),(ku+1 + ox3*cnx3));
-
-        // copy data in MBs to be refined to coarse arrays in target MBs
-        auto src = Kokkos::subview( a,msrc,Kokkos::ALL,ksrc,jsrc,isrc);
-        auto dst = Kokkos::subview(ca,mdst,Kokkos::ALL,kdst,jdst,idst);
-        Kokkos::deep_copy(DevExeSpace(), dst, src);
-      }
-    }
-  }
+  int &cnx1 = indcs.cnx1, &cnx2 = indcs.cnx2, &cnx3 = indcs.cnx3;
+  int nvar = a.extent_int(1);
+  auto &clist = copy_list;
+
+  // copy data in MBs to be refined to coarse arrays in target MBs
+  par_for("copy_ref_cc", DevExeSpace(),0,(ncopy-1),0,(nvar-1),kl,ku,jl,ju,il,iu,
+  KOKKOS_LAMBDA(int l, int n, int k, int j, int i) {
+    int msrc = clist.d_view(l,0), mdst = clist.d_view(l,1);
+    int fi = i + clist.d_view(l,2)*cnx1;
+    int fj = j + clist.d_view(l,3)*cnx2;
+    int fk = k + clist.d_view(l,4)*cnx3;
+    ca(mdst,n,k,j,i) = a(msrc,n,fk,fj,fi);
+  });
   return;
 }
 
@@ -960,6 +1232,9 @@ void MeshRefinement::CopyForRefinementCC(DvceArray5D<Real> &a, DvceArray5D<Real>
 //! \brief Same as CopyForRefinementCC, but for face-centered arrays
 
 void MeshRefinement::CopyForRefinementFC(DvceFaceFld4D<Real> &b,DvceFaceFld4D<Real> &cb) {
+  int ncopy = SetRefineCopyList();
+  if (ncopy == 0) return;
+
   auto &indcs = pmy_mesh->mb_indcs;
   auto &ng = indcs.ng;
   int il = indcs.cis - ng, iu = indcs.cie + ng;
@@ -971,52 +1246,109 @@ void MeshRefinement::CopyForRefinementFC(DvceFaceFld4D<Real> &b,DvceFaceFld4D<Re
   if (pmy_mesh->three_d) {
     kl -= ng; ku += ng;
   }
-  auto &cnx1 = indcs.cnx1, &cnx2 = indcs.cnx2, &cnx3 = indcs.cnx3;
+  int &cnx1 = indcs.cnx1, &cnx2 = indcs.cnx2, &cnx3 = indcs.cnx3;
+  auto &clist = copy_list;
+
+  // copy data in MBs to be refined to coarse arrays in target MBs.  Loop limits include
+  // the extra face in each direction, each component masks the rest.
+  par_for("copy_ref_fc", DevExeSpace(),0,(ncopy-1),kl,(ku+1),jl,(ju+1),il,(iu+1),
+  KOKKOS_LAMBDA(int l, int k, int j, int i) {
+    int msrc = clist.d_view(l,0), mdst = clist.d_view(l,1);
+    int fi = i + clist.d_view(l,2)*cnx1;
+    int fj = j + clist.d_view(l,3)*cnx2;
+    int fk = k + clist.d_view(l,4)*cnx3;
+    if (k <= ku && j <= ju) {
+      cb.x1f(mdst,k,j,i) = b.x1f(msrc,fk,fj,fi);
+    }
+    if (k <= ku && i <= iu) {
+      cb.x2f(mdst,k,j,i) = b.x2f(msrc,fk,fj,fi);
+    }
+    if (j <= ju && i <= iu) {
+      cb.x3f(mdst,k,j,i) = b.x3f(msrc,fk,fj,fi);
+    }
+  });
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn int MeshRefinement::SetDerefineCopyList
+//! \brief Fills copy_list with (msrc,mdst,ox1,ox2,ox3) for every coarse array in MBs
+//! flagged for derefinement whose data is copied to a target MB on this rank.  Returns
+//! the number of entries.
+
+int MeshRefinement::SetDerefineCopyList() {
+  // nleaf = number of leaf MeshBlocks per refined block
+  int nleaf = 2;
+  if (pmy_mesh->two_d) nleaf = 4;
+  if (pmy_mesh->three_d) nleaf = 8;
+
+  // count entries, then fill list
+  int ombs = pmy_mesh->gids_eachrank[global_variable::my_rank];
+  int ombe = ombs + pmy_mesh->nmb_eachrank[global_variable::my_rank] - 1;
+  int ncopy = 0;
+  for (int pass=0; pass<2; ++pass) {
+    if (pass == 1) {
+      if (ncopy == 0) return 0;
+      if (copy_list.extent_int(0) < ncopy) {Kokkos::realloc(copy_list, ncopy, 5);}
+      ncopy = 0;
+    }
+    for (int oldm=ombs; oldm<=ombe; ++oldm) {
+      // only derefine if nleaf blocks flagged, and target MB stays on this rank
+      if (refine_flag.h_view(oldm) >= -1) continue;
+      if (new_rank_eachmb[oldtonew[oldm]] != global_variable::my_rank) continue;
+      // only move if source array on this rank
+      for (int l=0; l<nleaf && (oldm+l)<=ombe; l++) {
+        if (pass == 1) {
+          LogicalLocation &lloc = pmy_mesh->lloc_eachmb[oldm+l];
+          copy_list.h_view(ncopy,0) = oldm - ombs + l;
+          copy_list.h_view(ncopy,1) = oldm - ombs;
+          copy_list.h_view(ncopy,2) = ((lloc.lx1 & 1) == 1);
+          copy_list.h_view(ncopy,3) = ((lloc.lx2 & 1) == 1);
+          copy_list.h_view(ncopy,4) = ((lloc.lx3 & 1) == 1);
+        }
+        ncopy++;
+      }
+    }
+  }
+  copy_list.template modify<HostMemSpace>();
+  copy_list.template sync<DevExeSpace>();
+  return ncopy;
+}
 
-  // Set indices of destination (coarse) array
-  std::pair<int,int> idst  = std::make_pair(il,iu+1);
-  std::pair<int,int> idst1 = std::make_pair(il,iu+2);
-  std::pair<int,int> jdst  = std::make_pair(jl,ju+1);
-  std::pair<int,int> jdst1 = std::make_pair(jl,ju+2);
-  std::pair<int,int> kdst  = std::make_pair(kl,ku+1);
-  std::pair<int,int> kdst1 = std::make_pair(kl,ku+2);
+//----------------------------------------------------------------------------------------
+//! \fn int MeshRefinement::SetRefineCopyList
+//! \brief Fills copy_list with (msrc,mdst,ox1,ox2,ox3) for every new MB created by
+//! refinement whose parent MB is on this rank.  Returns the number of entries.
 
-  // loop over new MBs on this rank
+int MeshRefinement::SetRefineCopyList() {
   int nmbs = new_gids_eachrank[global_variable::my_rank];
   int nmbe = nmbs + new_nmb_eachrank[global_variable::my_rank] - 1;
-  for (int newm=nmbs; newm<=nmbe; ++newm) {
-    int oldm = newtoold[newm];
-    if (refine_flag.h_view(oldm) > 0) {
-      // only copy if old and new location of MB on this rank
-      if ((new_rank_eachmb[oldtonew[oldm]] == global_variable::my_rank) &&
-          (new_rank_eachmb[newm] == global_variable::my_rank)) {
-        int msrc = oldtonew[oldm] - nmbs;
-        int mdst = newm - nmbs;
+  int ncopy = 0;
+  for (int pass=0; pass<2; ++pass) {
+    if (pass == 1) {
+      if (ncopy == 0) return 0;
+      if (copy_list.extent_int(0) < ncopy) {Kokkos::realloc(copy_list, ncopy, 5);}
+      ncopy = 0;
+    }
+    for (int newm=nmbs; newm<=nmbe; ++newm) {
+      int oldm = newtoold[newm];
+      if (refine_flag.h_view(oldm) <= 0) continue;
+      // only copy if old location of MB on this rank (new location always is)
+      if (new_rank_eachmb[oldtonew[oldm]] != global_variable::my_rank) continue;
+      if (pass == 1) {
         LogicalLocation &lloc = new_lloc_eachmb[newm];
-        int ox1 = ((lloc.lx1 & 1) == 1);
-        int ox2 = ((lloc.lx2 & 1) == 1);
-        int ox3 = ((lloc.lx3 & 1) == 1);
-        std::pair<int,int> isrc  = std::make_pair((il + ox1*cnx1),(iu+1 + ox1*cnx1  ));
-        std::pair<int,int> isrc1 = std::make_pair((il + ox1*cnx1),(iu+1 + ox1*cnx1+1));
-        std::pair<int,int> jsrc  = std::make_pair((jl + ox2*cnx2),(ju+1 + ox2*cnx2  ));
-        std::pair<int,int> jsrc1 = std::make_pair((jl + ox2*cnx2),(ju+1 + ox2*cnx2+1));
-        std::pair<int,int> ksrc  = std::make_pair((kl + ox3*cnx3),(ku+1 + ox3*cnx3  ));
-        std::pair<int,int> ksrc1 = std::make_pair((kl + ox3*cnx3),(ku+1 + ox3*cnx3+1));
-
-        // copy data in MBs to be refined to coarse arrays in target MBs
-        auto src1 = Kokkos::subview( b.x1f,msrc,ksrc,jsrc,isrc1);
-        auto dst1 = Kokkos::subview(cb.x1f,mdst,kdst,jdst,idst1);
-        Kokkos::deep_copy(DevExeSpace(), dst1, src1);
-        auto src2 = Kokkos::subview( b.x2f,msrc,ksrc,jsrc1,isrc);
-        auto dst2 = Kokkos::subview(cb.x2f,mdst,kdst,jdst1,idst);
-        Kokkos::deep_copy(DevExeSpace(), dst2, src2);
-        auto src3 = Kokkos::subview( b.x3f,msrc,ksrc1,jsrc,isrc);
-        auto dst3 = Kokkos::subview(cb.x3f,mdst,kdst1,jdst,idst);
-        Kokkos::deep_copy(DevExeSpace(), dst3, src3);
+        copy_list.h_view(ncopy,0) = oldtonew[oldm] - nmbs;
+        copy_list.h_view(ncopy,1) = newm - nmbs;
+        copy_list.h_view(ncopy,2) = ((lloc.lx1 & 1) == 1);
+        copy_list.h_view(ncopy,3) = ((lloc.lx2 & 1) == 1);
+        copy_list.h_view(ncopy,4) = ((lloc.lx3 & 1) == 1);
       }
+      ncopy++;
     }
   }
-  return;
+  copy_list.template modify<HostMemSpace>();
+  copy_list.template sync<DevExeSpace>();
+  return ncopy;
 }
 
 //----------------------------------------------------------------------------------------
@@ -1074,7 +1406,7 @@ void MeshRefinement::RefineCC(DualArray1D<int> &n2o, DvceArray5D<Real> &a,
 
         // call inlined prolongation operator for CC variables
         if (!is_z4c) {
-          ProlongCC(m,v,k,j,i,fk,fj,fi,multi_d,three_d,ca,a);
+          ProlongCC(m,m,v,k,j,i,fk,fj,fi,multi_d,three_d,ca,a);
         } else {
           switch (indcs.ng) {
             case 2: HighOrderProlongCC<2>(m,v,k,j,i,fk,fj,fi,nx1,nx2,nx3,
@@ -1121,7 +1453,7 @@ void MeshRefinement::RefineFC(DualArray1D<int> &n2o, DvceFaceFld4D<Real> &b,
       int fi = (i - cis)*2 + is;                   // fine i
       int fj = (multi_d)? ((j - cjs)*2 + js) : j;  // fine j
       int fk = (three_d)? ((k - cks)*2 + ks) : k;  // fine k
-      ProlongFCSharedX1Face(m,k,j,i,fk,fj,fi,multi_d,three_d,cb.x1f,b.x1f);
+      ProlongFCSharedX1Face(m,m,k,j,i,fk,fj,fi,multi_d,three_d,cb.x1f,b.x1f);
     }
   });
 
@@ -1133,7 +1465,7 @@ void MeshRefinement::RefineFC(DualArray1D<int> &n2o, DvceFaceFld4D<Real> &b,
       int fi = (i - cis)*2 + is;                   // fine i
       int fj = (multi_d)? ((j - cjs)*2 + js) : j;  // fine j
       int fk = (three_d)? ((k - cks)*2 + ks) : k;  // fine k
-      ProlongFCSharedX2Face(m,k,j,i,fk,fj,fi,three_d,cb.x2f,b.x2f);
+      ProlongFCSharedX2Face(m,m,k,j,i,fk,fj,fi,three_d,cb.x2f,b.x2f);
     }
   });
 
@@ -1145,7 +1477,7 @@ void MeshRefinement::RefineFC(DualArray1D<int> &n2o, DvceFaceFld4D<Real> &b,
       int fi = (i - cis)*2 + is;                   // fine i
       int fj = (multi_d)? ((j - cjs)*2 + js) : j;  // fine j
       int fk = (three_d)? ((k - cks)*2 + ks) : k;  // fine k
-      ProlongFCSharedX3Face(m,k,j,i,fk,fj,fi,multi_d,cb.x3f,b.x3f);
+      ProlongFCSharedX3Face(m,m,k,j,i,fk,fj,fi,multi_d,cb.x3f,b.x3f);
     }
   });
 
@@ -1177,9 +1509,11 @@ void MeshRefinement::RefineFC(DualArray1D<int> &n2o, DvceFaceFld4D<Real> &b,
 //! \fn void MeshRefinement::RestrictCC
 //!  \brief Restricts cell-centered variables to coarse mesh
 
-void MeshRefinement::RestrictCC(DvceArray5D<Real> &u, DvceArray5D<Real> &cu,
-    bool is_z4c) {
-  int nmb  = u.extent_int(0);  // TODO(@user): 1st index from L of in array must be NMB
+template <typename T>
+void MeshRefinement::RestrictCC(DvceArray5D<T> &u, DvceArray5D<T> &cu, bool is_z4c) {
+  // restrict only MBs stored in coarse arrays, where MB index cm maps to m in fine array
+  int nmb = pmy_mesh->pmb_pack->pmb->nmb_coarse;
+  auto &cidx_mb = pmy_mesh->pmb_pack->pmb->cidx_mb;
   int nvar = u.extent_int(1);  // TODO(@user): 2nd index from L of in array must be NVAR
 
   MeshBlockPack* pmbp = pmy_mesh->pmb_pack;
@@ -1193,42 +1527,52 @@ void MeshRefinement::RestrictCC(DvceArray5D<Real> &u, DvceArray5D<Real> &cu,
   auto& restrict_2nd = weights.restrict_2nd;
   auto& restrict_4th = weights.restrict_4th;
   auto& restrict_4th_edge = weights.restrict_4th_edge;
+  // with restrict_shells, skip cells more than ng cells from all faces
+  bool shells = restrict_shells && !(is_z4c);
+  int ng = indcs.ng;
   // restrict in 1D
   if (pmy_mesh->one_d) {
     par_for("restrictCC-1D",DevExeSpace(), 0,nmb-1, 0,nvar-1, cis,cie,
-    KOKKOS_LAMBDA(const int m, const int n, const int i) {
+    KOKKOS_LAMBDA(const int cm, const int n, const int i) {
+      if (shells && (i >= cis+ng && i <= cie-ng)) return;
+      int m = cidx_mb.d_view(cm);
       int finei = 2*i - cis;  // correct when cis=is
-      cu(m,n,cks,cjs,i) = 0.5*(u(m,n,cks,cjs,finei) + u(m,n,cks,cjs,finei+1));
+      cu(cm,n,cks,cjs,i) = 0.5*(u(m,n,cks,cjs,finei) + u(m,n,cks,cjs,finei+1));
     });
   // restrict in 2D
   } else if (pmy_mesh->two_d) {
     par_for("restrictCC-2D",DevExeSpace(), 0,nmb-1, 0,nvar-1, cjs,cje, cis,cie,
-    KOKKOS_LAMBDA(const int m, const int n, const int j, const int i) {
+    KOKKOS_LAMBDA(const int cm, const int n, const int j, const int i) {
+      if (shells && (i >= cis+ng && i <= cie-ng) && (j >= cjs+ng && j <= cje-ng)) return;
+      int m = cidx_mb.d_view(cm);
       int finei = 2*i - cis;  // correct when cis=is
       int finej = 2*j - cjs;  // correct when cjs=js
-      cu(m,n,cks,j,i) = 0.25*(u(m,n,cks,finej  ,finei) + u(m,n,cks,finej  ,finei+1)
-                            + u(m,n,cks,finej+1,finei) + u(m,n,cks,finej+1,finei+1));
+      cu(cm,n,cks,j,i) = 0.25*(u(m,n,cks,finej  ,finei) + u(m,n,cks,finej  ,finei+1)
+                             + u(m,n,cks,finej+1,finei) + u(m,n,cks,finej+1,finei+1));
     });
 
   // restrict in 3D
   } else {
     par_for("restrictCC-3D",DevExeSpace(), 0,nmb-1, 0,nvar-1, cks,cke, cjs,cje, cis,cie,
-    KOKKOS_LAMBDA(const int m, const int n, const int k, const int j, const int i) {
+    KOKKOS_LAMBDA(const int cm, const int n, const int k, const int j, const int i) {
+      if (shells && (i >= cis+ng && i <= cie-ng) && (j >= cjs+ng && j <= cje-ng) &&
+          (k >= cks+ng && k <= cke-ng)) return;
+      int m = cidx_mb.d_view(cm);
       int finei = 2*i - cis;  // correct when cis=is
       int finej = 2*j - cjs;  // correct when cjs=js
       int finek = 2*k - cks;  // correct when cks=ks
       if (!is_z4c) {
-        cu(m,n,k,j,i) =
+        cu(cm,n,k,j,i) =
             0.125*(u(m,n,finek  ,finej  ,finei) + u(m,n,finek  ,finej  ,finei+1)
                 + u(m,n,finek  ,finej+1,finei) + u(m,n,finek  ,finej+1,finei+1)
                 + u(m,n,finek+1,finej,  finei) + u(m,n,finek+1,finej,  finei+1)
                 + u(m,n,finek+1,finej+1,finei) + u(m,n,finek+1,finej+1,finei+1));
       } else {
         switch (indcs.ng) {
-          case 2: cu(m,n,k,j,i) = RestrictInterpolation<2>(m,n,finek,finej,finei,
+          case 2: cu(cm,n,k,j,i) = RestrictInterpolation<2>(m,n,finek,finej,finei,
                           nx1,nx2,nx3,u,restrict_2nd,restrict_4th,restrict_4th_edge);
                   break;
-          case 4: cu(m,n,k,j,i) = RestrictInterpolation<4>(m,n,finek,finej,finei,
+          case 4: cu(cm,n,k,j,i) = RestrictInterpolation<4>(m,n,finek,finej,finei,
                           nx1,nx2,nx3,u,restrict_2nd,restrict_4th,restrict_4th_edge);
                   break;
         }
@@ -1243,7 +1587,9 @@ void MeshRefinement::RestrictCC(DvceArray5D<Real> &u, DvceArray5D<Real> &cu,
 //! \brief Restricts face-centered variables to coarse mesh
 
 void MeshRefinement::RestrictFC(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Real> &cb) {
-  int nmb  = b.x1f.extent_int(0);  // TODO(@user): 1st idx from L of in array must be NMB
+  // restrict only MBs stored in coarse arrays, where MB index cm maps to m in fine array
+  int nmb = pmy_mesh->pmb_pack->pmb->nmb_coarse;
+  auto &cidx_mb = pmy_mesh->pmb_pack->pmb->cidx_mb;
 
   auto &cis = pmy_mesh->mb_indcs.cis;
   auto &cie = pmy_mesh->mb_indcs.cie;
@@ -1251,83 +1597,93 @@ void MeshRefinement::RestrictFC(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Real> &cb)
   auto &cje = pmy_mesh->mb_indcs.cje;
   auto &cks = pmy_mesh->mb_indcs.cks;
   auto &cke = pmy_mesh->mb_indcs.cke;
+  // with restrict_shells, skip cells more than ng cells from all faces
+  bool shells = restrict_shells;
+  int ng = pmy_mesh->mb_indcs.ng;
 
   // restrict in 1D
   if (pmy_mesh->one_d) {
     par_for("restrictFC-1D",DevExeSpace(), 0,nmb-1, cis,cie,
-    KOKKOS_LAMBDA(const int m, const int i) {
+    KOKKOS_LAMBDA(const int cm, const int i) {
+      if (shells && (i >= cis+ng && i <= cie-ng)) return;
+      int m = cidx_mb.d_view(cm);
       int finei = 2*i - cis;  // correct when cis=is
       // restrict B1
-      cb.x1f(m,cks,cjs,i) = b.x1f(m,cks,cjs,finei);
+      cb.x1f(cm,cks,cjs,i) = b.x1f(m,cks,cjs,finei);
       if (i==cie) {
-        cb.x1f(m,cks,cjs,i+1) = b.x1f(m,cks,cjs,finei+2);
+        cb.x1f(cm,cks,cjs,i+1) = b.x1f(m,cks,cjs,finei+2);
       }
       // restrict B2
       Real b2coarse = 0.5*(b.x2f(m,cks,cjs,finei) + b.x2f(m,cks,cjs,finei+1));
-      cb.x2f(m,cks,cjs  ,i) = b2coarse;
-      cb.x2f(m,cks,cjs+1,i) = b2coarse;
+      cb.x2f(cm,cks,cjs  ,i) = b2coarse;
+      cb.x2f(cm,cks,cjs+1,i) = b2coarse;
       // restrict B3
       Real b3coarse = 0.5*(b.x3f(m,cks,cjs,finei) + b.x3f(m,cks,cjs,finei+1));
-      cb.x3f(m,cks  ,cjs,i) = b3coarse;
-      cb.x3f(m,cks+1,cjs,i) = b3coarse;
+      cb.x3f(cm,cks  ,cjs,i) = b3coarse;
+      cb.x3f(cm,cks+1,cjs,i) = b3coarse;
     });
 
   // restrict in 2D
   } else if (pmy_mesh->two_d) {
     par_for("restrictFC-2D",DevExeSpace(), 0,nmb-1, cjs,cje, cis,cie,
-    KOKKOS_LAMBDA(const int m, const int j, const int i) {
+    KOKKOS_LAMBDA(const int cm, const int j, const int i) {
+      if (shells && (i >= cis+ng && i <= cie-ng) && (j >= cjs+ng && j <= cje-ng)) return;
+      int m = cidx_mb.d_view(cm);
       int finei = 2*i - cis;  // correct when cis=is
       int finej = 2*j - cjs;  // correct when cjs=js
       // restrict B1
-      cb.x1f(m,cks,j,i) = 0.5*(b.x1f(m,cks,finej,finei) + b.x1f(m,cks,finej+1,finei));
+      cb.x1f(cm,cks,j,i) = 0.5*(b.x1f(m,cks,finej,finei) + b.x1f(m,cks,finej+1,finei));
       if (i==cie) {
-        cb.x1f(m,cks,j,i+1) =
+        cb.x1f(cm,cks,j,i+1) =
           0.5*(b.x1f(m,cks,finej,finei+2) + b.x1f(m,cks,finej+1,finei+2));
       }
       // restrict B2
-      cb.x2f(m,cks,j,i) = 0.5*(b.x2f(m,cks,finej,finei) + b.x2f(m,cks,finej,finei+1));
+      cb.x2f(cm,cks,j,i) = 0.5*(b.x2f(m,cks,finej,finei) + b.x2f(m,cks,finej,finei+1));
       if (j==cje) {
-        cb.x2f(m,cks,j+1,i) =
+        cb.x2f(cm,cks,j+1,i) =
           0.5*(b.x2f(m,cks,finej+2,finei) + b.x2f(m,cks,finej+2,finei+1));
       }
       // restrict B3
       Real b3coarse = 0.25*(b.x3f(m,cks,finej  ,finei) + b.x3f(m,cks,finej  ,finei+1)
                           + b.x3f(m,cks,finej+1,finei) + b.x3f(m,cks,finej+1,finei+1));
-      cb.x3f(m,cks  ,j,i) = b3coarse;
-      cb.x3f(m,cks+1,j,i) = b3coarse;
+      cb.x3f(cm,cks  ,j,i) = b3coarse;
+      cb.x3f(cm,cks+1,j,i) = b3coarse;
     });
 
   // restrict in 3D
   } else {
     par_for("restrictFC-3D",DevExeSpace(), 0,nmb-1, cks,cke, cjs,cje, cis,cie,
-    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    KOKKOS_LAMBDA(const int cm, const int k, const int j, const int i) {
+      if (shells && (i >= cis+ng && i <= cie-ng) && (j >= cjs+ng && j <= cje-ng) &&
+          (k >= cks+ng && k <= cke-ng)) return;
+      int m = cidx_mb.d_view(cm);
       int finei = 2*i - cis;  // correct when cis=is
       int finej = 2*j - cjs;  // correct when cjs=js
       int finek = 2*k - cks;  // correct when cks=ks
       // restrict B1
-      cb.x1f(m,k,j,i) =
+      cb.x1f(cm,k,j,i) =
         0.25*(b.x1f(m,finek  ,finej,finei) + b.x1f(m,finek  ,finej+1,finei)
             + b.x1f(m,finek+1,finej,finei) + b.x1f(m,finek+1,finej+1,finei));
       if (i==cie) {
-        cb.x1f(m,k,j,i+1) =
+        cb.x1f(cm,k,j,i+1) =
           0.25*(b.x1f(m,finek  ,finej,finei+2) + b.x1f(m,finek  ,finej+1,finei+2)
               + b.x1f(m,finek+1,finej,finei+2) + b.x1f(m,finek+1,finej+1,finei+2));
       }
       // restrict B2
-      cb.x2f(m,k,j,i) =
+      cb.x2f(cm,k,j,i) =
         0.25*(b.x2f(m,finek  ,finej,finei) + b.x2f(m,finek  ,finej,finei+1)
             + b.x2f(m,finek+1,finej,finei) + b.x2f(m,finek+1,finej,finei+1));
       if (j==cje) {
-        cb.x2f(m,k,j+1,i) =
+        cb.x2f(cm,k,j+1,i) =
           0.25*(b.x2f(m,finek  ,finej+2,finei) + b.x2f(m,finek  ,finej+2,finei+1)
               + b.x2f(m,finek+1,finej+2,finei) + b.x2f(m,finek+1,finej+2,finei+1));
       }
       // restrict B3
-      cb.x3f(m,k,j,i) =
+      cb.x3f(cm,k,j,i) =
         0.25*(b.x3f(m,finek,finej  ,finei) + b.x3f(m,finek,finej  ,finei+1)
             + b.x3f(m,finek,finej+1,finei) + b.x3f(m,finek,finej+1,finei+1));
       if (k==cke) {
-        cb.x3f(m,k+1,j,i) =
+        cb.x3f(cm,k+1,j,i) =
           0.25*(b.x3f(m,finek+2,finej  ,finei) + b.x3f(m,finek+2,finej  ,finei+1)
               + b.x3f(m,finek+2,finej+1,finei) + b.x3f(m,finek+2,finej+1,finei+1));
       }
@@ -1414,3 +1770,11 @@ void MeshRefinement::InitInterpWghts() {
   res_4th_e.template modify<HostMemSpace>();
   res_4th_e.template sync<DevExeSpace>();
 }
+
+// function definitions for each template parameter
+template void MeshRefinement::RestrictCC<Real>(DvceArray5D<Real> &a,
+  DvceArray5D<Real> &ca, bool is_z4c);
+#if RAD_MIXED_PRECISION_ENABLED
+template void MeshRefinement::RestrictCC<RadReal>(DvceArray5D<RadReal> &a,
+  DvceArray5D<RadReal> &ca, bool is_z4c);
+#endif
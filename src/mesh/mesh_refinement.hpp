@@ -8,14 +8,20 @@
 //! \file mesh_refinement.hpp
 //! \brief defines MeshRefinement class containing data and functions controlling SMR/AMR
 
+#include <string>
+#include <vector>
+
+#include "globals.hpp"
+
 //----------------------------------------------------------------------------------------
 //! \fn int CreateAMR_MPI_Tag(int lid, int ox1, int ox2, int ox3)
 //! \brief calculate an MPI tag for AMR communications.  Note maximum size of
-//! lid that can be encoded is set by (NUM_BITS_LID) macro.
+//! lid that can be encoded is set by global_variable::nbits_lid.
 //! The convention in Athena++ is lid is for the *receiving* process.
 //! The MPI standard requires signed int tag, with MPI_TAG_UB>=2^15-1 = 32,767 (inclusive)
 static int CreateAMR_MPI_Tag(int lid, int ox1, int ox2, int ox3) {
-  return (ox1<<(NUM_BITS_LID+2)) | (ox2<<(NUM_BITS_LID+1))| (ox3<<(NUM_BITS_LID)) | lid;
+  int nb = global_variable::nbits_lid;
+  return (ox1<<(nb+2)) | (ox2<<(nb+1))| (ox3<<(nb)) | lid;
 }
 
 //----------------------------------------------------------------------------------------
@@ -49,17 +55,28 @@ class MeshRefinement {
   int nmb_sent_thisrank;     // # of MeshBlocks sent during load balancing on this rank
   int ncyc_check_amr;        // # of cycles between checking mesh for ref/derefinement
   int refinement_interval;   // # of cycles between allowing successive ref/derefinement
+  int derefine_interval;     // # of cycles after refinement before allowing derefinement
+  int ncheck_derefine;       // # of successive checks MB flagged before derefinement
   bool prolong_prims;        // flag to enable prolongation of primitive vars
-
-  // following 2x Views are dimensioned [nmb_total]
+  int lb_chunk_nmb;          // # of MBs packed/sent per chunk in load balancing (0=all)
+  int lb_pipeline_depth;     // # of chunks of sends in flight during load balancing
+  int nmb_reserve;           // # of MBs held back from refinement for 2:1 balancing
+  bool record_amr;           // true to record refinement flags and LB to record_file
+  bool replay_amr;           // true to replay refinement flags and LB from replay_file
+  bool restrict_shells;      // true to restrict only cells adjacent to MB faces (SMR)
+  bool async_check;          // true to evaluate criteria one check ahead (AMR)
+
+  // following View dimensioned [nmb_total]
+  DualArray1D<Real> refine_strength;  // (criterion)/(threshold) for each MeshBlock
+
+  // following 3x Views are dimensioned [nmb_total]
   DualArray1D<int> refine_flag;    // refinement flag for each MeshBlock
   HostArray1D<int> ncyc_since_ref; // # of cycles since MB last refined/derefined
+  HostArray1D<int> nderef_checks;  // # of successive checks MB flagged for derefinement
 
-  // following 4x arrays allocated with length [nranks] only with AMR
+  // following 2x arrays allocated with length [nranks] only with AMR
   int *nref_eachrank;     // number of MBs refined per rank
   int *nderef_eachrank;   // number of MBs de-refined per rank
-  int *nref_rsum;         // running sum of number of MBs refined per rank
-  int *nderef_rsum;       // running sum of number of MBs de-refined per rank
   // following 2x arrays allocated with length [nmb_new] and [nmb_old]] only with AMR
   int *newtoold;          // mapping of new gid (index n) to old gid
   int *oldtonew;          // mapping of old gid (index n) to new gid
@@ -84,12 +101,21 @@ class MeshRefinement {
   };
   InterpWeight weights;
 
+  // list of (msrc,mdst,ox1,ox2,ox3) for MBs copied to/from coarse arrays within this
+  // rank during AMR, so that all copies are performed in a single kernel launch
+  DualArray2D<int> copy_list;
+
 #if MPI_PARALLEL_ENABLED
   int nmb_send, nmb_recv;
   MPI_Comm amr_comm;                         // unique communicator for AMR
   DualArray1D<AMRBuffer> sendbuf, recvbuf; // send/recv buffers
-  MPI_Request *send_req, *recv_req;
-  DvceArray1D<Real> send_data, recv_data;    // send/recv device data
+  std::vector<MPI_Request> send_req, recv_req;
+  // send/recv device data.  Buffers (and arrays above) only grow, to the high-water mark
+  // over all AMR/load balancing steps, and are reused to avoid repeated allocations
+  DvceArray1D<Real> send_data, recv_data;
+  // data passed to MPI.  With GPU-aware MPI these are the same Views as send/recv_data,
+  // otherwise they are host-pinned mirrors
+  Kokkos::View<Real*, LayoutWrapper, MPIBuffMemSpace> send_data_mpi, recv_data_mpi;
 #endif
 
   // functions
@@ -111,27 +137,76 @@ class MeshRefinement {
                 bool is_z4c=false);
   void RefineFC(DualArray1D<int> &n2o, DvceFaceFld4D<Real> &b, DvceFaceFld4D<Real> &cb);
 
-  void RestrictCC(DvceArray5D<Real> &a, DvceArray5D<Real> &ca, bool is_z4c=false);
+  template <typename T>
+  void RestrictCC(DvceArray5D<T> &a, DvceArray5D<T> &ca, bool is_z4c=false);
   void RestrictFC(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Real> &cb);
   void HighOrderRestrictCC(DvceArray5D<Real> &a, DvceArray5D<Real> &ca);
 
   // functions for load balancing (in file load_balance.cpp)
   void InitRecvAMR(int nleaf);
   void PackAndSendAMR(int nleaf);
-  void PackAMRBuffersCC(DvceArray5D<Real> &a, DvceArray5D<Real> &ca, int ncc, int nfc);
-  void PackAMRBuffersFC(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Real> &cb, int ncc,int nfc);
+  void PackAndSendChunkAMR(int nleaf, int sbs, int sbe);
+  void PackAMRBuffersCC(DvceArray5D<Real> &a, DvceArray5D<Real> &ca, int ncc, int nfc,
+                        int sbs, int sbe);
+  void PackAMRBuffersFC(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Real> &cb, int ncc,int nfc,
+                        int sbs, int sbe);
   void ClearRecvAndUnpackAMR();
   void UnpackAMRBuffersCC(DvceArray5D<Real> &a, DvceArray5D<Real> &ca, int ncc,int nfc);
   void UnpackAMRBuffersFC(DvceFaceFld4D<Real> &b,DvceFaceFld4D<Real> &cb,int ncc,int nfc);
   void ClearSendAMR();
+  void RebalanceMeshBlocks(Driver *pdrive, ParameterInput *pin);
+
+  // functions to record/replay AMR and load balancing (in file amr_replay.cpp)
+  void ReadReplayFile(const std::string &fname);
+  bool ReplayEventThisCycle(bool amr);
+  void ReplayRefinementFlags();
+  void ReplayLoadBalance(int nb);
+  void RecordEvent(bool amr, int nb);
 
   // initialize interpolation weights
   void InitInterpWghts();
 
  private:
+  // functions to build copy_list
+  int SetDerefineCopyList();
+  int SetRefineCopyList();
+  // function to limit refinement to number of MBs that fit in memory
+  void LimitRefinement();
+  // functions used by CheckForRefinement() to set refine_flag
+  void ResetRefinementFlags();
+  void LaunchRefinementCriteria(MeshBlockPack* pmbp);
+  void CheckLocalRefinementFlags(int *flag, int mbs, int nmb);
+  void FinishRefinementFlags();
+  // functions to evaluate criteria one check ahead with async_check=true
+  void ApplyAsyncCheck();
+  void LaunchAsyncCheck(MeshBlockPack* pmbp);
+
+  // recorded AMR (refinement flags, new ranks) or load balancing (new ranks) event
+  struct AMREvent {
+    int ncycle;
+    bool amr;
+    std::vector<int> flag;
+    std::vector<int> rank;
+  };
+
   // data
   Mesh *pmy_mesh;
+  std::string record_file_;
+  std::vector<int> record_flag_;        // flags on last AMR check, saved for record
+  std::vector<AMREvent> replay_events_;
+  std::size_t replay_next_;             // index of next event to be replayed
   Real d_threshold_, dd_threshold_, dp_threshold_, dv_threshold_, chi_threshold_;
   bool check_cons_;
+  // criteria launched on device at end of last check, with flags and strength copied to
+  // host asynchronously, and exchanged with a non-blocking allgather on the next cycle
+  bool check_pending_;                  // flags not yet posted to allgather
+  bool exchange_pending_;               // flags posted to allgather, not yet applied
+  int check_gids_, check_nmb_;          // MBs on this rank when criteria were launched
+  HostArray1D<int> next_flag_;
+  HostArray1D<Real> next_strength_;
+#if MPI_PARALLEL_ENABLED
+  std::vector<int> check_nmb_eachrank_, check_gids_eachrank_;
+  MPI_Request check_req_[2];
+#endif
 };
 #endif // MESH_MESH_REFINEMENT_HPP_
@@ -6,28 +6,41 @@
 //! \file meshblock.cpp
 //  \brief implementation of constructor and functions in MeshBlock class
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 #include "athena.hpp"
+#include "globals.hpp"
 #include "parameter_input.hpp"
 #include "mesh.hpp"
 #include "coordinates/cell_locations.hpp"
 #include "nghbr_index.hpp"
+#include "pgen/user_hooks.hpp"
 #include "meshblock.hpp"
 
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
 //----------------------------------------------------------------------------------------
 // MeshBlock constructor:
-// Initializes mb_gid, mb_lev, mb_size, mb_bcs arrays.  The nghbrs array is initialized
-// by SetNeighbors function called by BuildTree***() functions.
+// Initializes mb_gid, mb_lev, mb_size, mb_bcs, phys_mb arrays.  The nghbrs array is
+// initialized by SetNeighbors function called by BuildTree***() functions.
 
 MeshBlock::MeshBlock(MeshBlockPack* ppack, int igids, int nmb) :
   pmy_pack(ppack),
   mb_gid("mb_gid",nmb),
   mb_lev("mb_lev",nmb),
   mb_size("mbsize",nmb),
-  mb_bcs("mbbcs",nmb,6) {
+  mb_bcs("mbbcs",nmb,6),
+  nmb_phys(0),
+  compact_coarse(false),
+  nmb_coarse(nmb),
+  mb_cidx("mb_cidx",nmb),
+  cidx_mb("cidx_mb",nmb) {
   Mesh* pm = pmy_pack->pmesh;
   auto &ms = pm->mesh_size;
 
@@ -35,6 +48,8 @@ MeshBlock::MeshBlock(MeshBlockPack* ppack, int igids, int nmb) :
     // initialize host array elements of gids, levels
     mb_gid.h_view(m) = igids + m;
     mb_lev.h_view(m) = pm->lloc_eachmb[igids+m].level;
+    mb_cidx.h_view(m) = m;
+    cidx_mb.h_view(m) = m;
 
     // calculate physical size and set BCs of each MeshBlock in x1
     std::int32_t &lx1 = pm->lloc_eachmb[igids+m].lx1;
@@ -121,16 +136,55 @@ MeshBlock::MeshBlock(MeshBlockPack* ppack, int igids, int nmb) :
     mb_size.h_view(m).idx3 = 1./mb_size.h_view(m).dx3;
   }
 
+  // build table of MBs with faces at physical boundaries, counting only faces in
+  // directions that are resolved
+  int nface = (pm->three_d)? 6 : ((pm->multi_d)? 4 : 2);
+  std::vector<int> phys_faces(nmb, 0);
+  for (int m=0; m<nmb; ++m) {
+    for (int f=0; f<nface; ++f) {
+      switch (mb_bcs.h_view(m,f)) {
+        case BoundaryFlag::reflect:
+        case BoundaryFlag::inflow:
+        case BoundaryFlag::outflow:
+        case BoundaryFlag::diode:
+        case BoundaryFlag::vacuum:
+          phys_faces[m] |= (1 << f);
+          break;
+        case BoundaryFlag::user:
+          // user BCs are applied with physical BCs only if defined as a device hook
+          if (user_hooks::BoundaryCondition::enabled) {phys_faces[m] |= (1 << f);}
+          break;
+        default:
+          break;
+      }
+    }
+    if (phys_faces[m] != 0) {nmb_phys++;}
+  }
+  phys_mb = DualArray2D<int>("phys_mb", std::max(nmb_phys,1), 2);
+  for (int m=0, p=0; m<nmb; ++m) {
+    if (phys_faces[m] != 0) {
+      phys_mb.h_view(p,0) = m;
+      phys_mb.h_view(p,1) = phys_faces[m];
+      ++p;
+    }
+  }
+
   // For each DualArray: mark host views as modified, and then sync to device array
   mb_gid.template modify<HostMemSpace>();
   mb_lev.template modify<HostMemSpace>();
   mb_size.template modify<HostMemSpace>();
   mb_bcs.template modify<HostMemSpace>();
+  phys_mb.template modify<HostMemSpace>();
+  mb_cidx.template modify<HostMemSpace>();
+  cidx_mb.template modify<HostMemSpace>();
 
   mb_gid.template sync<DevExeSpace>();
   mb_lev.template sync<DevExeSpace>();
   mb_size.template sync<DevExeSpace>();
   mb_bcs.template sync<DevExeSpace>();
+  phys_mb.template sync<DevExeSpace>();
+  mb_cidx.template sync<DevExeSpace>();
+  cidx_mb.template sync<DevExeSpace>();
 }
 
 //----------------------------------------------------------------------------------------
@@ -143,6 +197,133 @@ MeshBlock::MeshBlock(MeshBlockPack* ppack, int igids, int nmb) :
 // Based on SearchAndSetNeighbors() function in /src/bvals/bvals_base.cpp in C++ version
 
 void MeshBlock::SetNeighbors(std::unique_ptr<MeshBlockTree> &ptree, int *ranklist) {
+  InitNeighbors();
+  for (int b=0; b<pmy_pack->nmb_thispack; ++b) {
+    SearchNeighbors(ptree, ranklist, b);
+  }
+
+  // For each DualArray: mark host views as modified, and then sync to device array
+  nghbr.template modify<HostMemSpace>();
+  nghbr.template sync<DevExeSpace>();
+
+  SetCoarseIndices();
+  SetCoarseExchange();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+// \!fn void MeshBlock::SetNeighbors()
+// \brief Same as above, but used after AMR to avoid searching the tree for MeshBlocks
+// whose neighbors have not changed.  For each MB b, old_b[b] is the index of the MB in
+// the old_nghbr array if its neighbors can be reused, or -1 if they must be searched for.
+// Reused neighbors keep their level and destination, while their gid and rank are
+// updated using the oldtonew map and the new ranklist.
+
+void MeshBlock::SetNeighbors(std::unique_ptr<MeshBlockTree> &ptree, int *ranklist,
+                             const std::vector<int> &old_b,
+                             DualArray2D<NeighborBlock> &old_nghbr, const int *oldtonew) {
+  InitNeighbors();
+  for (int b=0; b<pmy_pack->nmb_thispack; ++b) {
+    if (old_b[b] < 0) {
+      SearchNeighbors(ptree, ranklist, b);
+    } else {
+      for (int n=0; n<nnghbr; ++n) {
+        NeighborBlock &onb = old_nghbr.h_view(old_b[b],n);
+        if (onb.gid >= 0) {
+          int gid = oldtonew[onb.gid];
+          nghbr.h_view(b,n).gid  = gid;
+          nghbr.h_view(b,n).lev  = onb.lev;
+          nghbr.h_view(b,n).rank = ranklist[gid];
+          nghbr.h_view(b,n).dest = onb.dest;
+        }
+      }
+    }
+  }
+
+  // For each DualArray: mark host views as modified, and then sync to device array
+  nghbr.template modify<HostMemSpace>();
+  nghbr.template sync<DevExeSpace>();
+
+  SetCoarseIndices();
+  SetCoarseExchange();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+// \!fn void MeshBlock::SetCoarseIndices()
+// \brief set index of each MB in arrays on the coarse grid.  With compact_coarse, only
+// MBs with a neighbor at a coarser level (which are the only MBs that restrict data to
+// send to, receive data from, and prolongate data from coarser neighbors) are stored in
+// coarse arrays, which saves memory when most MBs are surrounded by the same level (e.g.
+// nested grids with SMR). Must be called after neighbors are set.
+
+void MeshBlock::SetCoarseIndices() {
+  int nmb = pmy_pack->nmb_thispack;
+  Kokkos::realloc(mb_cidx, nmb);
+  Kokkos::realloc(cidx_mb, nmb);
+  nmb_coarse = 0;
+  for (int m=0; m<nmb; ++m) {
+    bool coarser = !(compact_coarse);
+    for (int n=0; n<nnghbr; ++n) {
+      if ((nghbr.h_view(m,n).gid >= 0) && (nghbr.h_view(m,n).lev < mb_lev.h_view(m))) {
+        coarser = true;
+      }
+    }
+    mb_cidx.h_view(m) = (coarser)? nmb_coarse : -1;
+    if (coarser) {cidx_mb.h_view(nmb_coarse++) = m;}
+  }
+
+  mb_cidx.template modify<HostMemSpace>();
+  cidx_mb.template modify<HostMemSpace>();
+  mb_cidx.template sync<DevExeSpace>();
+  cidx_mb.template sync<DevExeSpace>();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+// \!fn void MeshBlock::SetCoarseExchange()
+// \brief set flags for exchange of coarse data between MBs at the same level, which Z4c
+// uses in the stencil of higher-order prolongation.  Coarse data is only used by MBs
+// with a coarser neighbor, so with sparse_coarse data is only sent to (and received by)
+// such MBs.  Requires a flag for every MB in the Mesh, gathered from all ranks.  Must be
+// called after neighbors are set, by all ranks.
+
+void MeshBlock::SetCoarseExchange() {
+  int nmb = pmy_pack->nmb_thispack;
+  Mesh *pm = pmy_pack->pmesh;
+  std::vector<int> coarser(pm->nmb_total, 1);
+  if (pmy_pack->sparse_coarse) {
+    int mbs = pmy_pack->gids;
+    for (int m=0; m<nmb; ++m) {
+      coarser[mbs + m] = 0;
+      for (int n=0; n<nnghbr; ++n) {
+        if ((nghbr.h_view(m,n).gid >= 0) && (nghbr.h_view(m,n).lev < mb_lev.h_view(m))) {
+          coarser[mbs + m] = 1;
+        }
+      }
+    }
+#if MPI_PARALLEL_ENABLED
+    MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, coarser.data(), pm->nmb_eachrank,
+                   pm->gids_eachrank, MPI_INT, global_variable::athena_comm);
+#endif
+  }
+  for (int m=0; m<nmb; ++m) {
+    for (int n=0; n<nnghbr; ++n) {
+      int gid = nghbr.h_view(m,n).gid;
+      nghbr.h_view(m,n).send_coarse = (gid >= 0) && (coarser[gid] != 0);
+      nghbr.h_view(m,n).recv_coarse = (coarser[pmy_pack->gids + m] != 0);
+    }
+  }
+  nghbr.template modify<HostMemSpace>();
+  nghbr.template sync<DevExeSpace>();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+// \!fn void MeshBlock::InitNeighbors()
+// \brief allocate nghbr array and initialize all elements of host view to -1
+
+void MeshBlock::InitNeighbors() {
   // min number of array elements needed to store MeshBlock neighbors withe SMR/AMR
   // Note not all buffers will be allocated for all nghbrs
   if (pmy_pack->pmesh->one_d) {nnghbr = 8;}
@@ -160,9 +341,19 @@ void MeshBlock::SetNeighbors(std::unique_ptr<MeshBlockTree> &ptree, int *ranklis
       nghbr.h_view(m,n).lev   = -1;
       nghbr.h_view(m,n).rank  = -1;
       nghbr.h_view(m,n).dest  = -1;
+      nghbr.h_view(m,n).send_coarse = true;
+      nghbr.h_view(m,n).recv_coarse = true;
     }
   }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+// \!fn void MeshBlock::SearchNeighbors()
+// \brief Search MeshBlock tree and set host view of nghbr array for MeshBlock b
 
+void MeshBlock::SearchNeighbors(std::unique_ptr<MeshBlockTree> &ptree, int *ranklist,
+                                int b) {
   // set number of subblocks in x2- and x3-dirs
   int nfx = 1, nfy = 1, nfz = 1;
   if (pmy_pack->pmesh->multilevel) {
@@ -171,43 +362,75 @@ void MeshBlock::SetNeighbors(std::unique_ptr<MeshBlockTree> &ptree, int *ranklis
     if (pmy_pack->pmesh->three_d) nfz = 2;
   }
 
-  // Search MeshBlock tree and find neighbors
-  for (int b=0; b<nmb; ++b) {
-    LogicalLocation lloc = pmy_pack->pmesh->lloc_eachmb[mb_gid.h_view(b)];
-
-    // find location of this MeshBlock relative to XXXX
-    int myox1, myox2 = 0, myox3 = 0, myfx1, myfx2, myfx3;
-    myfx1 = ((lloc.lx1 & 1) == 1);
-    myfx2 = ((lloc.lx2 & 1) == 1);
-    myfx3 = ((lloc.lx3 & 1) == 1);
-    myox1 = ((lloc.lx1 & 1) == 1)*2 - 1;
-    if (pmy_pack->pmesh->multi_d) myox2 = ((lloc.lx2 & 1) == 1)*2 - 1;
-    if (pmy_pack->pmesh->three_d) myox3 = ((lloc.lx3 & 1) == 1)*2 - 1;
-
-    // neighbors on x1face
-    for (int n=-1; n<=1; n+=2) {
-      MeshBlockTree* nt = ptree->FindNeighbor(lloc, n, 0, 0);
+  LogicalLocation lloc = pmy_pack->pmesh->lloc_eachmb[mb_gid.h_view(b)];
+
+  // find location of this MeshBlock relative to XXXX
+  int myox1, myox2 = 0, myox3 = 0, myfx1, myfx2, myfx3;
+  myfx1 = ((lloc.lx1 & 1) == 1);
+  myfx2 = ((lloc.lx2 & 1) == 1);
+  myfx3 = ((lloc.lx3 & 1) == 1);
+  myox1 = ((lloc.lx1 & 1) == 1)*2 - 1;
+  if (pmy_pack->pmesh->multi_d) myox2 = ((lloc.lx2 & 1) == 1)*2 - 1;
+  if (pmy_pack->pmesh->three_d) myox3 = ((lloc.lx3 & 1) == 1)*2 - 1;
+
+  // neighbors on x1face
+  for (int n=-1; n<=1; n+=2) {
+    MeshBlockTree* nt = ptree->FindNeighbor(lloc, n, 0, 0);
+    if (nt != nullptr) {
+      if (nt->pleaf_ != nullptr) {  // neighbor at finer level -- requires subblocks
+        int ffx = 1 - (n + 1)/2; // 0 for BoundaryFace::outer_x1, 1 for inner_x1
+        for (int fz=0; fz<nfz; fz++) {
+          for (int fy = 0; fy<nfy; fy++) {
+            MeshBlockTree* nf = nt->GetLeaf(ffx, fy, fz);
+            int inghbr = NeighborIndex(n,0,0,fy,fz);
+            nghbr.h_view(b,inghbr).gid = nf->gid_;
+            nghbr.h_view(b,inghbr).lev = nf->lloc_.level;
+            nghbr.h_view(b,inghbr).rank = ranklist[nf->gid_];
+            nghbr.h_view(b,inghbr).dest = NeighborIndex(-n,0,0,fy,fz);
+          }
+        }
+      } else {   // neighbor at same or coarser level
+        int idest, inghbr;
+        if (nt->lloc_.level == lloc.level) { // neighbor at same level -- no subblocks
+          inghbr = NeighborIndex(n,0,0,0,0);
+          idest = NeighborIndex(-n,0,0,0,0);
+        } else { // neighbor at coarser level, set index/destn to appropriate subblock
+          inghbr = NeighborIndex(n,0,0,myfx2,myfx3);
+          idest = NeighborIndex(-n,0,0,myfx2,myfx3);
+        }
+        nghbr.h_view(b,inghbr).gid = nt->gid_;
+        nghbr.h_view(b,inghbr).lev = nt->lloc_.level;
+        nghbr.h_view(b,inghbr).rank = ranklist[nt->gid_];
+        nghbr.h_view(b,inghbr).dest = idest;
+      }
+    }
+  }
+
+  // neighbors on x2face
+  if (pmy_pack->pmesh->multi_d) {
+    for (int m=-1; m<=1; m+=2) {
+      MeshBlockTree* nt = ptree->FindNeighbor(lloc, 0, m, 0);
       if (nt != nullptr) {
         if (nt->pleaf_ != nullptr) {  // neighbor at finer level -- requires subblocks
-          int ffx = 1 - (n + 1)/2; // 0 for BoundaryFace::outer_x1, 1 for inner_x1
+          int ffy = 1 - (m + 1)/2; // 0 for BoundaryFace::outer_x2, 1 for inner_x2
           for (int fz=0; fz<nfz; fz++) {
-            for (int fy = 0; fy<nfy; fy++) {
-              MeshBlockTree* nf = nt->GetLeaf(ffx, fy, fz);
-              int inghbr = NeighborIndex(n,0,0,fy,fz);
+            for (int fx = 0; fx<nfx; fx++) {
+              MeshBlockTree* nf = nt->GetLeaf(fx, ffy, fz);
+              int inghbr = NeighborIndex(0,m,0,fx,fz);
               nghbr.h_view(b,inghbr).gid = nf->gid_;
               nghbr.h_view(b,inghbr).lev = nf->lloc_.level;
               nghbr.h_view(b,inghbr).rank = ranklist[nf->gid_];
-              nghbr.h_view(b,inghbr).dest = NeighborIndex(-n,0,0,fy,fz);
+              nghbr.h_view(b,inghbr).dest = NeighborIndex(0,-m,0,fx,fz);
             }
           }
         } else {   // neighbor at same or coarser level
-          int idest, inghbr;
+          int idest,inghbr;
           if (nt->lloc_.level == lloc.level) { // neighbor at same level -- no subblocks
-            inghbr = NeighborIndex(n,0,0,0,0);
-            idest = NeighborIndex(-n,0,0,0,0);
+            inghbr = NeighborIndex(0,m,0,0,0);
+            idest = NeighborIndex(0,-m,0,0,0);
           } else { // neighbor at coarser level, set index/destn to appropriate subblock
-            inghbr = NeighborIndex(n,0,0,myfx2,myfx3);
-            idest = NeighborIndex(-n,0,0,myfx2,myfx3);
+            inghbr = NeighborIndex(0,m,0,myfx1,myfx3);
+            idest = NeighborIndex(0,-m,0,myfx1,myfx3);
           }
           nghbr.h_view(b,inghbr).gid = nt->gid_;
           nghbr.h_view(b,inghbr).lev = nt->lloc_.level;
@@ -217,217 +440,178 @@ void MeshBlock::SetNeighbors(std::unique_ptr<MeshBlockTree> &ptree, int *ranklis
       }
     }
 
-    // neighbors on x2face
-    if (pmy_pack->pmesh->multi_d) {
-      for (int m=-1; m<=1; m+=2) {
-        MeshBlockTree* nt = ptree->FindNeighbor(lloc, 0, m, 0);
+    // neighbors on x1x2 edges
+    for (int m=-1; m<=1; m+=2) {
+      for (int n=-1; n<=1; n+=2) {
+        MeshBlockTree* nt = ptree->FindNeighbor(lloc, n, m, 0);
         if (nt != nullptr) {
           if (nt->pleaf_ != nullptr) {  // neighbor at finer level -- requires subblocks
+            int ffx = 1 - (n + 1)/2; // 0 for BoundaryFace::outer_x1, 1 for inner_x1
             int ffy = 1 - (m + 1)/2; // 0 for BoundaryFace::outer_x2, 1 for inner_x2
             for (int fz=0; fz<nfz; fz++) {
-              for (int fx = 0; fx<nfx; fx++) {
-                MeshBlockTree* nf = nt->GetLeaf(fx, ffy, fz);
-                int inghbr = NeighborIndex(0,m,0,fx,fz);
-                nghbr.h_view(b,inghbr).gid = nf->gid_;
-                nghbr.h_view(b,inghbr).lev = nf->lloc_.level;
-                nghbr.h_view(b,inghbr).rank = ranklist[nf->gid_];
-                nghbr.h_view(b,inghbr).dest = NeighborIndex(0,-m,0,fx,fz);
-              }
+              MeshBlockTree* nf = nt->GetLeaf(ffx, ffy, fz);
+              int inghbr = NeighborIndex(n,m,0,fz,0);
+              nghbr.h_view(b,inghbr).gid = nf->gid_;
+              nghbr.h_view(b,inghbr).lev = nf->lloc_.level;
+              nghbr.h_view(b,inghbr).rank = ranklist[nf->gid_];
+              nghbr.h_view(b,inghbr).dest = NeighborIndex(-n,-m,0,fz,0);
             }
           } else {   // neighbor at same or coarser level
             int idest,inghbr;
-            if (nt->lloc_.level == lloc.level) { // neighbor at same level -- no subblocks
-              inghbr = NeighborIndex(0,m,0,0,0);
-              idest = NeighborIndex(0,-m,0,0,0);
-            } else { // neighbor at coarser level, set index/destn to appropriate subblock
-              inghbr = NeighborIndex(0,m,0,myfx1,myfx3);
-              idest = NeighborIndex(0,-m,0,myfx1,myfx3);
+            if (nt->lloc_.level == lloc.level) { // same level -- no subblocks
+              inghbr = NeighborIndex(n,m,0,0,0);
+              idest = NeighborIndex(-n,-m,0,0,0);
+            } else { // neighbor at coarser level, set indx/dest to appropriate subblock
+              inghbr = NeighborIndex(n,m,0,myfx3,0);
+              idest = NeighborIndex(-n,-m,0,myfx3,0);
+            }
+            // only set neighbor for exterior edges of coarser face
+            if (nt->lloc_.level >= lloc.level || (myox1 == n && myox2 == m)) {
+              nghbr.h_view(b,inghbr).gid = nt->gid_;
+              nghbr.h_view(b,inghbr).lev = nt->lloc_.level;
+              nghbr.h_view(b,inghbr).rank = ranklist[nt->gid_];
+              nghbr.h_view(b,inghbr).dest = idest;
             }
-            nghbr.h_view(b,inghbr).gid = nt->gid_;
-            nghbr.h_view(b,inghbr).lev = nt->lloc_.level;
-            nghbr.h_view(b,inghbr).rank = ranklist[nt->gid_];
-            nghbr.h_view(b,inghbr).dest = idest;
           }
         }
       }
+    }
+  }
 
-      // neighbors on x1x2 edges
-      for (int m=-1; m<=1; m+=2) {
-        for (int n=-1; n<=1; n+=2) {
-          MeshBlockTree* nt = ptree->FindNeighbor(lloc, n, m, 0);
-          if (nt != nullptr) {
-            if (nt->pleaf_ != nullptr) {  // neighbor at finer level -- requires subblocks
-              int ffx = 1 - (n + 1)/2; // 0 for BoundaryFace::outer_x1, 1 for inner_x1
-              int ffy = 1 - (m + 1)/2; // 0 for BoundaryFace::outer_x2, 1 for inner_x2
-              for (int fz=0; fz<nfz; fz++) {
-                MeshBlockTree* nf = nt->GetLeaf(ffx, ffy, fz);
-                int inghbr = NeighborIndex(n,m,0,fz,0);
-                nghbr.h_view(b,inghbr).gid = nf->gid_;
-                nghbr.h_view(b,inghbr).lev = nf->lloc_.level;
-                nghbr.h_view(b,inghbr).rank = ranklist[nf->gid_];
-                nghbr.h_view(b,inghbr).dest = NeighborIndex(-n,-m,0,fz,0);
-              }
-            } else {   // neighbor at same or coarser level
-              int idest,inghbr;
-              if (nt->lloc_.level == lloc.level) { // same level -- no subblocks
-                inghbr = NeighborIndex(n,m,0,0,0);
-                idest = NeighborIndex(-n,-m,0,0,0);
-              } else { // neighbor at coarser level, set indx/dest to appropriate subblock
-                inghbr = NeighborIndex(n,m,0,myfx3,0);
-                idest = NeighborIndex(-n,-m,0,myfx3,0);
-              }
-              // only set neighbor for exterior edges of coarser face
-              if (nt->lloc_.level >= lloc.level || (myox1 == n && myox2 == m)) {
-                nghbr.h_view(b,inghbr).gid = nt->gid_;
-                nghbr.h_view(b,inghbr).lev = nt->lloc_.level;
-                nghbr.h_view(b,inghbr).rank = ranklist[nt->gid_];
-                nghbr.h_view(b,inghbr).dest = idest;
-              }
+  // neighbors on x3face
+  if (pmy_pack->pmesh->three_d) {
+    for (int l=-1; l<=1; l+=2) {
+      MeshBlockTree* nt = ptree->FindNeighbor(lloc, 0, 0, l);
+      if (nt != nullptr) {
+        if (nt->pleaf_ != nullptr) {  // neighbor at finer level -- requires subblocks
+          int ffz = 1 - (l + 1)/2; // 0 for BoundaryFace::outer_x3, 1 for inner_x3
+          for (int fy=0; fy<nfy; fy++) {
+            for (int fx = 0; fx<nfx; fx++) {
+              MeshBlockTree* nf = nt->GetLeaf(fx, fy, ffz);
+              int inghbr = NeighborIndex(0,0,l,fx,fy);
+              nghbr.h_view(b,inghbr).gid = nf->gid_;
+              nghbr.h_view(b,inghbr).lev = nf->lloc_.level;
+              nghbr.h_view(b,inghbr).rank = ranklist[nf->gid_];
+              nghbr.h_view(b,inghbr).dest = NeighborIndex(0,0,-l,fx,fy);
             }
           }
+        } else {   // neighbor at same or coarser level -- no subblocks
+          int idest,inghbr;
+          if (nt->lloc_.level == lloc.level) { // neighbor at same level
+            inghbr = NeighborIndex(0,0,l,0,0);
+            idest = NeighborIndex(0,0,-l,0,0);
+          } else { // neighbor at coarser level, set index/destn to appropriate subblock
+            inghbr = NeighborIndex(0,0,l,myfx1,myfx2);
+            idest = NeighborIndex(0,0,-l,myfx1,myfx2);
+          }
+          nghbr.h_view(b,inghbr).gid = nt->gid_;
+          nghbr.h_view(b,inghbr).lev = nt->lloc_.level;
+          nghbr.h_view(b,inghbr).rank = ranklist[nt->gid_];
+          nghbr.h_view(b,inghbr).dest = idest;
         }
       }
     }
 
-    // neighbors on x3face
-    if (pmy_pack->pmesh->three_d) {
-      for (int l=-1; l<=1; l+=2) {
-        MeshBlockTree* nt = ptree->FindNeighbor(lloc, 0, 0, l);
+    // neighbors on x3x1 edges
+    for (int l=-1; l<=1; l+=2) {
+      for (int n=-1; n<=1; n+=2) {
+        MeshBlockTree* nt = ptree->FindNeighbor(lloc, n, 0, l);
         if (nt != nullptr) {
           if (nt->pleaf_ != nullptr) {  // neighbor at finer level -- requires subblocks
+            int ffx = 1 - (n + 1)/2; // 0 for BoundaryFace::outer_x1, 1 for inner_x1
             int ffz = 1 - (l + 1)/2; // 0 for BoundaryFace::outer_x3, 1 for inner_x3
             for (int fy=0; fy<nfy; fy++) {
-              for (int fx = 0; fx<nfx; fx++) {
-                MeshBlockTree* nf = nt->GetLeaf(fx, fy, ffz);
-                int inghbr = NeighborIndex(0,0,l,fx,fy);
-                nghbr.h_view(b,inghbr).gid = nf->gid_;
-                nghbr.h_view(b,inghbr).lev = nf->lloc_.level;
-                nghbr.h_view(b,inghbr).rank = ranklist[nf->gid_];
-                nghbr.h_view(b,inghbr).dest = NeighborIndex(0,0,-l,fx,fy);
-              }
+              MeshBlockTree* nf = nt->GetLeaf(ffx, fy, ffz);
+              int inghbr = NeighborIndex(n,0,l,fy,0);
+              nghbr.h_view(b,inghbr).gid = nf->gid_;
+              nghbr.h_view(b,inghbr).lev = nf->lloc_.level;
+              nghbr.h_view(b,inghbr).rank = ranklist[nf->gid_];
+              nghbr.h_view(b,inghbr).dest = NeighborIndex(-n,0,-l,fy,0);
             }
           } else {   // neighbor at same or coarser level -- no subblocks
             int idest,inghbr;
             if (nt->lloc_.level == lloc.level) { // neighbor at same level
-              inghbr = NeighborIndex(0,0,l,0,0);
-              idest = NeighborIndex(0,0,-l,0,0);
-            } else { // neighbor at coarser level, set index/destn to appropriate subblock
-              inghbr = NeighborIndex(0,0,l,myfx1,myfx2);
-              idest = NeighborIndex(0,0,-l,myfx1,myfx2);
+              inghbr = NeighborIndex(n,0,l,0,0);
+              idest = NeighborIndex(-n,0,-l,0,0);
+            } else { // neighbor at coarser level, set indx/dest to appropriate subblock
+              inghbr = NeighborIndex(n,0,l,myfx2,0);
+              idest = NeighborIndex(-n,0,-l,myfx2,0);
+            }
+            // only set neighbor for exterior edges of coarser face
+            if (nt->lloc_.level >= lloc.level || (myox1 == n && myox3 == l)) {
+              nghbr.h_view(b,inghbr).gid = nt->gid_;
+              nghbr.h_view(b,inghbr).lev = nt->lloc_.level;
+              nghbr.h_view(b,inghbr).rank = ranklist[nt->gid_];
+              nghbr.h_view(b,inghbr).dest = idest;
             }
-            nghbr.h_view(b,inghbr).gid = nt->gid_;
-            nghbr.h_view(b,inghbr).lev = nt->lloc_.level;
-            nghbr.h_view(b,inghbr).rank = ranklist[nt->gid_];
-            nghbr.h_view(b,inghbr).dest = idest;
           }
         }
       }
+    }
 
-      // neighbors on x3x1 edges
-      for (int l=-1; l<=1; l+=2) {
-        for (int n=-1; n<=1; n+=2) {
-          MeshBlockTree* nt = ptree->FindNeighbor(lloc, n, 0, l);
-          if (nt != nullptr) {
-            if (nt->pleaf_ != nullptr) {  // neighbor at finer level -- requires subblocks
-              int ffx = 1 - (n + 1)/2; // 0 for BoundaryFace::outer_x1, 1 for inner_x1
-              int ffz = 1 - (l + 1)/2; // 0 for BoundaryFace::outer_x3, 1 for inner_x3
-              for (int fy=0; fy<nfy; fy++) {
-                MeshBlockTree* nf = nt->GetLeaf(ffx, fy, ffz);
-                int inghbr = NeighborIndex(n,0,l,fy,0);
-                nghbr.h_view(b,inghbr).gid = nf->gid_;
-                nghbr.h_view(b,inghbr).lev = nf->lloc_.level;
-                nghbr.h_view(b,inghbr).rank = ranklist[nf->gid_];
-                nghbr.h_view(b,inghbr).dest = NeighborIndex(-n,0,-l,fy,0);
-              }
-            } else {   // neighbor at same or coarser level -- no subblocks
-              int idest,inghbr;
-              if (nt->lloc_.level == lloc.level) { // neighbor at same level
-                inghbr = NeighborIndex(n,0,l,0,0);
-                idest = NeighborIndex(-n,0,-l,0,0);
-              } else { // neighbor at coarser level, set indx/dest to appropriate subblock
-                inghbr = NeighborIndex(n,0,l,myfx2,0);
-                idest = NeighborIndex(-n,0,-l,myfx2,0);
-              }
-              // only set neighbor for exterior edges of coarser face
-              if (nt->lloc_.level >= lloc.level || (myox1 == n && myox3 == l)) {
-                nghbr.h_view(b,inghbr).gid = nt->gid_;
-                nghbr.h_view(b,inghbr).lev = nt->lloc_.level;
-                nghbr.h_view(b,inghbr).rank = ranklist[nt->gid_];
-                nghbr.h_view(b,inghbr).dest = idest;
-              }
+    // neighbors on x2x3 edges
+    for (int l=-1; l<=1; l+=2) {
+      for (int m=-1; m<=1; m+=2) {
+        MeshBlockTree* nt = ptree->FindNeighbor(lloc, 0, m, l);
+        if (nt != nullptr) {
+          if (nt->pleaf_ != nullptr) {  // neighbor at finer level -- requires subblocks
+            int ffy = 1 - (m + 1)/2; // 0 for BoundaryFace::outer_x2, 1 for inner_x2
+            int ffz = 1 - (l + 1)/2; // 0 for BoundaryFace::outer_x3, 1 for inner_x3
+            for (int fx=0; fx<nfy; fx++) {
+              MeshBlockTree* nf = nt->GetLeaf(fx, ffy, ffz);
+              int inghbr = NeighborIndex(0,m,l,fx,0);
+              nghbr.h_view(b,inghbr).gid = nf->gid_;
+              nghbr.h_view(b,inghbr).lev = nf->lloc_.level;
+              nghbr.h_view(b,inghbr).rank = ranklist[nf->gid_];
+              nghbr.h_view(b,inghbr).dest = NeighborIndex(0,-m,-l,fx,0);
+            }
+          } else {   // neighbor at same or coarser level -- no subblocks
+            int idest,inghbr;
+            if (nt->lloc_.level == lloc.level) { // neighbor at same level
+              inghbr = NeighborIndex(0,m,l,0,0);
+              idest = NeighborIndex(0,-m,-l,0,0);
+            } else { // neighbor at coarser level, set indx/dest to appropriate subblock
+              inghbr = NeighborIndex(0,m,l,myfx1,0);
+              idest = NeighborIndex(0,-m,-l,myfx1,0);
+            }
+            // only set neighbor for exterior edges of coarser face
+            if (nt->lloc_.level >= lloc.level || (myox2 == m && myox3 == l)) {
+              nghbr.h_view(b,inghbr).gid = nt->gid_;
+              nghbr.h_view(b,inghbr).lev = nt->lloc_.level;
+              nghbr.h_view(b,inghbr).rank = ranklist[nt->gid_];
+              nghbr.h_view(b,inghbr).dest = idest;
             }
           }
         }
       }
+    }
 
-      // neighbors on x2x3 edges
-      for (int l=-1; l<=1; l+=2) {
-        for (int m=-1; m<=1; m+=2) {
-          MeshBlockTree* nt = ptree->FindNeighbor(lloc, 0, m, l);
+    // neighbors on corners
+    for (int l=-1; l<=1; l+=2) {
+      for (int m=-1; m<=1; m+=2) {
+        for (int n=-1; n<=1; n+=2) {
+          MeshBlockTree* nt = ptree->FindNeighbor(lloc, n, m, l);
           if (nt != nullptr) {
-            if (nt->pleaf_ != nullptr) {  // neighbor at finer level -- requires subblocks
+            if (nt->pleaf_ != nullptr) {  // neighbor at finer level
+              int ffx = 1 - (n + 1)/2; // 0 for BoundaryFace::outer_x1, 1 for inner_x1
               int ffy = 1 - (m + 1)/2; // 0 for BoundaryFace::outer_x2, 1 for inner_x2
               int ffz = 1 - (l + 1)/2; // 0 for BoundaryFace::outer_x3, 1 for inner_x3
-              for (int fx=0; fx<nfy; fx++) {
-                MeshBlockTree* nf = nt->GetLeaf(fx, ffy, ffz);
-                int inghbr = NeighborIndex(0,m,l,fx,0);
-                nghbr.h_view(b,inghbr).gid = nf->gid_;
-                nghbr.h_view(b,inghbr).lev = nf->lloc_.level;
-                nghbr.h_view(b,inghbr).rank = ranklist[nf->gid_];
-                nghbr.h_view(b,inghbr).dest = NeighborIndex(0,-m,-l,fx,0);
-              }
-            } else {   // neighbor at same or coarser level -- no subblocks
-              int idest,inghbr;
-              if (nt->lloc_.level == lloc.level) { // neighbor at same level
-                inghbr = NeighborIndex(0,m,l,0,0);
-                idest = NeighborIndex(0,-m,-l,0,0);
-              } else { // neighbor at coarser level, set indx/dest to appropriate subblock
-                inghbr = NeighborIndex(0,m,l,myfx1,0);
-                idest = NeighborIndex(0,-m,-l,myfx1,0);
-              }
-              // only set neighbor for exterior edges of coarser face
-              if (nt->lloc_.level >= lloc.level || (myox2 == m && myox3 == l)) {
-                nghbr.h_view(b,inghbr).gid = nt->gid_;
-                nghbr.h_view(b,inghbr).lev = nt->lloc_.level;
-                nghbr.h_view(b,inghbr).rank = ranklist[nt->gid_];
-                nghbr.h_view(b,inghbr).dest = idest;
-              }
+              nt = nt->GetLeaf(ffx, ffy, ffz);
             }
-          }
-        }
-      }
-
-      // neighbors on corners
-      for (int l=-1; l<=1; l+=2) {
-        for (int m=-1; m<=1; m+=2) {
-          for (int n=-1; n<=1; n+=2) {
-            MeshBlockTree* nt = ptree->FindNeighbor(lloc, n, m, l);
-            if (nt != nullptr) {
-              if (nt->pleaf_ != nullptr) {  // neighbor at finer level
-                int ffx = 1 - (n + 1)/2; // 0 for BoundaryFace::outer_x1, 1 for inner_x1
-                int ffy = 1 - (m + 1)/2; // 0 for BoundaryFace::outer_x2, 1 for inner_x2
-                int ffz = 1 - (l + 1)/2; // 0 for BoundaryFace::outer_x3, 1 for inner_x3
-                nt = nt->GetLeaf(ffx, ffy, ffz);
-              }
-              int nlevel = nt->lloc_.level;
-              // only set neighbor for exterior corners of coarser face
-              if (nlevel >= lloc.level || (myox1 == n && myox2 == m && myox3 == l)) {
-                int inghbr = NeighborIndex(n,m,l,0,0);
-                nghbr.h_view(b,inghbr).gid = nt->gid_;
-                nghbr.h_view(b,inghbr).lev = nt->lloc_.level;
-                nghbr.h_view(b,inghbr).rank = ranklist[nt->gid_];
-                nghbr.h_view(b,inghbr).dest = NeighborIndex(-n,-m,-l,0,0);
-              }
+            int nlevel = nt->lloc_.level;
+            // only set neighbor for exterior corners of coarser face
+            if (nlevel >= lloc.level || (myox1 == n && myox2 == m && myox3 == l)) {
+              int inghbr = NeighborIndex(n,m,l,0,0);
+              nghbr.h_view(b,inghbr).gid = nt->gid_;
+              nghbr.h_view(b,inghbr).lev = nt->lloc_.level;
+              nghbr.h_view(b,inghbr).rank = ranklist[nt->gid_];
+              nghbr.h_view(b,inghbr).dest = NeighborIndex(-n,-m,-l,0,0);
             }
           }
         }
       }
-    }  // end loop over three_d
-  }    // end loop over all MeshBlocks
-
-  // For each DualArray: mark host views as modified, and then sync to device array
-  nghbr.template modify<HostMemSpace>();
-  nghbr.template sync<DevExeSpace>();
+    }
+  }  // end loop over three_d
 
   return;
 }
@@ -13,6 +13,7 @@
 //! containers called MashBlockPack.
 
 #include <memory>
+#include <vector>
 
 #include "bvals/bvals.hpp"
 #include "meshblock_pack.hpp"
@@ -42,11 +43,36 @@ class MeshBlock {
   DualArray2D<BoundaryFlag> mb_bcs;  // boundary conditions at 6 faces of each MeshBlock
   DualArray2D<NeighborBlock> nghbr;  // data on all (up to 56) neighbors for each MB
 
-  // function to set data describing neighbors
+  // Table of MBs with at least one face at a physical boundary (reflect, inflow, outflow,
+  // diode, vacuum, or user with a device hook) of the Mesh.  For each entry p,
+  // phys_mb(p,0) is the index of the MB in this pack, and bit f of phys_mb(p,1) is set if
+  // face f is physical.  Used to apply
+  // physical BCs to all faces of all MBs with a single kernel launch.
+  int nmb_phys;                      // number of entries in phys_mb
+  DualArray2D<int> phys_mb;
+
+  // Index of each MB in arrays on the 2x coarser grid used with SMR/AMR (coarse_u0, etc.)
+  // With compact_coarse, only MBs with a coarser neighbor are stored in coarse arrays.
+  // Otherwise (and always with AMR) index of each MB in coarse arrays is simply m.
+  bool compact_coarse;               // flag to compact coarse arrays
+  int nmb_coarse;                    // number of MBs stored in coarse arrays
+  DualArray1D<int> mb_cidx;          // index of each MB in coarse arrays (-1 if none)
+  DualArray1D<int> cidx_mb;          // MB stored at each index in coarse arrays
+
+  // functions to set data describing neighbors
   void SetNeighbors(std::unique_ptr<MeshBlockTree> &ptree, int *ranklist);
+  void SetNeighbors(std::unique_ptr<MeshBlockTree> &ptree, int *ranklist,
+                    const std::vector<int> &old_b, DualArray2D<NeighborBlock> &old_nghbr,
+                    const int *oldtonew);
+  void SetCoarseIndices();
+  void SetCoarseExchange();
 
  private:
   // data
   MeshBlockPack* pmy_pack;
+
+  // functions
+  void InitNeighbors();
+  void SearchNeighbors(std::unique_ptr<MeshBlockTree> &ptree, int *ranklist, int b);
 };
 #endif // MESH_MESHBLOCK_HPP_
@@ -28,8 +28,10 @@
 #include "diffusion/resistivity.hpp"
 #include "radiation/radiation.hpp"
 #include "srcterms/turb_driver.hpp"
+#include "srcterms/self_gravity.hpp"
 #include "particles/particles.hpp"
 #include "units/units.hpp"
+#include "utils/memory_registry.hpp"
 #include "meshblock_pack.hpp"
 
 //----------------------------------------------------------------------------------------
@@ -39,13 +41,17 @@ MeshBlockPack::MeshBlockPack(Mesh *pm, int igids, int igide) :
   pmesh(pm),
   gids(igids),
   gide(igide),
-  nmb_thispack(igide - igids + 1) {
+  nmb_thispack(igide - igids + 1),
+  sparse_coarse(false) {
   // create map for task lists
   tl_map.insert(std::make_pair("before_timeintegrator",std::make_shared<TaskList>()));
   tl_map.insert(std::make_pair("after_timeintegrator",std::make_shared<TaskList>()));
   tl_map.insert(std::make_pair("before_stagen",std::make_shared<TaskList>()));
   tl_map.insert(std::make_pair("stagen",std::make_shared<TaskList>()));
   tl_map.insert(std::make_pair("after_stagen",std::make_shared<TaskList>()));
+  tl_map.insert(std::make_pair("before_sts",std::make_shared<TaskList>()));
+  tl_map.insert(std::make_pair("sts",std::make_shared<TaskList>()));
+  tl_map.insert(std::make_pair("after_sts",std::make_shared<TaskList>()));
 }
 
 //----------------------------------------------------------------------------------------
@@ -61,6 +67,7 @@ MeshBlockPack::~MeshBlockPack() {
   if (pdyngr != nullptr) {delete pdyngr;}
   if (pnr    != nullptr) {delete pnr;}
   if (pturb  != nullptr) {delete pturb;}
+  if (pgrav  != nullptr) {delete pgrav;}
   if (punit  != nullptr) {delete punit;}
   if (pz4c   != nullptr) {
     delete pz4c;
@@ -80,7 +87,9 @@ MeshBlockPack::~MeshBlockPack() {
 //! Allows for passing of pointer to 'this' pack.
 
 void MeshBlockPack::AddMeshBlocks(ParameterInput *pin) {
+  MemoryRegistry::PushTag("mesh");
   pmb = new MeshBlock(this, gids, nmb_thispack);
+  MemoryRegistry::PopTag();
 }
 
 //----------------------------------------------------------------------------------------
@@ -90,7 +99,9 @@ void MeshBlockPack::AddMeshBlocks(ParameterInput *pin) {
 //! function, since latter uses data inside Coordinates class.
 
 void MeshBlockPack::AddCoordinates(ParameterInput *pin) {
+  MemoryRegistry::PushTag("coordinates");
   pcoord = new Coordinates(pin, this);
+  MemoryRegistry::PopTag();
 }
 
 //----------------------------------------------------------------------------------------
@@ -102,6 +113,28 @@ void MeshBlockPack::AddPhysics(ParameterInput *pin) {
   int nphysics = 0;
   TaskID none(0);
 
+  // With SMR, optionally store data on coarse grid only for MBs with coarser neighbors.
+  // Must be set before physics constructors allocate coarse arrays.  Not possible with
+  // AMR (any MB may be refined), or Z4c (which exchanges coarse data at the same level)
+  if (pmesh->multilevel && !(pmesh->adaptive) && !(pin->DoesBlockExist("z4c"))) {
+    pmb->compact_coarse = pin->GetOrAddBoolean("mesh_refinement","compact_coarse",false);
+    // MBs moved by automatic load balancing are rebuilt without compact coarse arrays,
+    // while the coarse arrays of the physics modules keep their compact extent
+    if (pmb->compact_coarse && pmesh->lb_automatic) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<mesh_refinement>/compact_coarse=true cannot be used "
+                << "with <loadbalancing>/balancer=automatic" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    pmb->SetCoarseIndices();
+  }
+  // With Z4c, optionally send coarse data at the same level only to MBs that need it.
+  // Flag is stored in MeshBlockPack since MeshBlocks are recreated after AMR.
+  if (pmesh->multilevel && pin->DoesBlockExist("z4c")) {
+    sparse_coarse = pin->GetOrAddBoolean("z4c","sparse_coarse_exchange",false);
+    pmb->SetCoarseExchange();
+  }
+
   // (1) Units.  Create first so that they can be used in other physics constructors
   // Default units are simply code units
   if (pin->DoesBlockExist("units")) {
@@ -114,7 +147,9 @@ void MeshBlockPack::AddPhysics(ParameterInput *pin) {
   // Create Hydro physics module.  Create TaskLists only for single-fluid hydro
   // (Note TaskLists stored in MeshBlockPack)
   if (pin->DoesBlockExist("hydro")) {
+    MemoryRegistry::PushTag("hydro");
     phydro = new hydro::Hydro(this, pin);
+    MemoryRegistry::PopTag();
     nphysics++;
     if (!(pin->DoesBlockExist("mhd")) && !(pin->DoesBlockExist("radiation")) &&
         !(pin->DoesBlockExist("adm")) && !(pin->DoesBlockExist("z4c")) ) {
@@ -127,7 +162,9 @@ void MeshBlockPack::AddPhysics(ParameterInput *pin) {
   // (3) MHD
   // Create MHD physics module.  Create TaskLists only for single-fluid MHD
   if (pin->DoesBlockExist("mhd")) {
+    MemoryRegistry::PushTag("mhd");
     pmhd = new mhd::MHD(this, pin);
+    MemoryRegistry::PopTag();
     nphysics++;
     if (!(pin->DoesBlockExist("hydro")) && !(pin->DoesBlockExist("radiation")) &&
         !(pin->DoesBlockExist("adm")) && !(pin->DoesBlockExist("z4c")) ) {
@@ -141,7 +178,9 @@ void MeshBlockPack::AddPhysics(ParameterInput *pin) {
   // Create Ion-Neutral physics module and TaskLists. Error if <hydro> and <mhd> are not
   // both defined as well.
   if (pin->DoesBlockExist("ion-neutral")) {
+    MemoryRegistry::PushTag("ion-neutral");
     pionn = new ion_neutral::IonNeutral(this, pin);   // construct new MHD object
+    MemoryRegistry::PopTag();
     if (pin->DoesBlockExist("hydro") && pin->DoesBlockExist("mhd") &&
         !(pin->DoesBlockExist("adm")) && !(pin->DoesBlockExist("z4c")) ) {
       pionn->AssembleIonNeutralTasks(tl_map);
@@ -166,7 +205,9 @@ void MeshBlockPack::AddPhysics(ParameterInput *pin) {
   // (5) RADIATION
   // Create radiation physics module.  Create tasklist.
   if (pin->DoesBlockExist("radiation")) {
+    MemoryRegistry::PushTag("radiation");
     prad = new radiation::Radiation(this, pin);
+    MemoryRegistry::PopTag();
     nphysics++;
     prad->AssembleRadTasks(tl_map);
   } else {
@@ -180,19 +221,40 @@ void MeshBlockPack::AddPhysics(ParameterInput *pin) {
   // force and adding force to fluid are included in operator_split and stage_run
   // task lists respectively.
   if (pin->DoesBlockExist("turb_driving")) {
+    MemoryRegistry::PushTag("turb_driving");
     pturb = new TurbulenceDriver(this, pin);
+    MemoryRegistry::PopTag();
     pturb->IncludeInitializeModesTask(tl_map["before_timeintegrator"], none);
     pturb->IncludeAddForcingTask(tl_map["stagen"], none);
   } else {
     pturb = nullptr;
   }
 
+  // (6b) SELF-GRAVITY
+  // Like the TurbulenceDriver, SelfGravity object is stored in MeshBlockPack, and tasks
+  // for solving Poisson's equation and adding source terms are included in the stagen
+  // task list (after the Hydro or MHD tasks have been assembled).
+  if (pin->DoesBlockExist("self_gravity")) {
+    MemoryRegistry::PushTag("self_gravity");
+    pgrav = new SelfGravity(this, pin);
+    MemoryRegistry::PopTag();
+    pgrav->IncludeSolveTasks(tl_map["stagen"], none);
+  } else {
+    pgrav = nullptr;
+  }
+
   // (7) Z4c and ADM
   // Create Z4c and ADM physics module.
   if (pin->DoesBlockExist("z4c")) {
+    MemoryRegistry::PushTag("z4c");
     pz4c = new z4c::Z4c(this, pin);
+    MemoryRegistry::PopTag();
+    MemoryRegistry::PushTag("adm");
     padm = new adm::ADM(this, pin);
+    MemoryRegistry::PopTag();
+    MemoryRegistry::PushTag("tmunu");
     ptmunu = new Tmunu(this, pin);
+    MemoryRegistry::PopTag();
     // init puncture tracker
     int npunct = pin->GetOrAddInteger("z4c", "npunct", 0);
     if (npunct > 0) {
@@ -206,7 +268,9 @@ void MeshBlockPack::AddPhysics(ParameterInput *pin) {
   } else {
     pz4c = nullptr;
     if (pin->DoesBlockExist("adm")) {
+      MemoryRegistry::PushTag("adm");
       padm = new adm::ADM(this, pin);
+      MemoryRegistry::PopTag();
       //ptmunu = new Tmunu(this, pin);
     } else {
       padm = nullptr;
@@ -222,7 +286,9 @@ void MeshBlockPack::AddPhysics(ParameterInput *pin) {
   }
   if ((pin->DoesBlockExist("z4c") || pin->DoesBlockExist("adm")) &&
       (pin->DoesBlockExist("mhd")) ) {
+    MemoryRegistry::PushTag("dyngr");
     pdyngr = dyngr::BuildDynGRMHD(this, pin);
+    MemoryRegistry::PopTag();
   }
 
   if (pz4c != nullptr || padm != nullptr) {
@@ -233,13 +299,37 @@ void MeshBlockPack::AddPhysics(ParameterInput *pin) {
   // (8) PARTICLES
   // Create particles module.  Create tasklist.
   if (pin->DoesBlockExist("particles")) {
+    MemoryRegistry::PushTag("particles");
     ppart = new particles::Particles(this, pin);
+    MemoryRegistry::PopTag();
     ppart->AssembleTasks(tl_map);
     nphysics++;
   } else {
     ppart = nullptr;
   }
 
+  // Time compute-intensive tasks when automatically load balancing using measured costs
+  if (pmesh->lb_automatic) {
+    for (auto &it : tl_map) {it.second->lb_timing = true;}
+  }
+  // Optionally run host tasks (e.g. puncture tracking) on threads of spare CPU cores
+  int nhost = pin->GetOrAddInteger("job","host_task_threads",0);
+  if (nhost > 0) {
+    pmesh->host_pool.Start(nhost);
+    for (auto &it : tl_map) {it.second->host_pool = &(pmesh->host_pool);}
+  }
+  // Optionally measure time each Task spends waiting (e.g. on communication)
+  if (pin->GetOrAddBoolean("time","task_timing",false)) {
+    for (auto &it : tl_map) {it.second->task_timing = true;}
+  }
+  // Optionally time each call of each Task, for the profiling report written by Driver
+  if (pin->GetOrAddBoolean("time","profile",false)) {
+    for (auto &it : tl_map) {
+      it.second->task_profiling = true;
+      it.second->name = it.first;
+    }
+  }
+
   // Check that at least ONE is requested and initialized.
   // Error if there are no physics blocks in the input file.
   if (nphysics == 0) {
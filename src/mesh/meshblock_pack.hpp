@@ -29,6 +29,7 @@ namespace radiation {class Radiation;}
 namespace dyngr {class DynGRMHD;}
 namespace numrel {class NumericalRelativity;}
 class TurbulenceDriver;
+class SelfGravity;
 namespace radiation {class Radiation;}
 namespace z4c {class Z4c;}
 namespace z4c {class PunctureTracker;}
@@ -55,6 +56,14 @@ class MeshBlockPack {
   int gids, gide;         // start/end of global IDs in this MeshBlockPack
   int nmb_thispack;       // number of MBs in this pack
 
+  // execution-space instance on which boundary buffers for this MeshBlockPack are packed
+  // and unpacked.  MPI sends wait only on this instance, rather than the whole device.
+  DevExeSpace exec_space;
+
+  // With Z4c and SMR/AMR, exchange coarse data between MBs at the same level only when
+  // the receiving MB has a coarser neighbor (and therefore uses it in prolongation)
+  bool sparse_coarse;
+
   // following Grid/Physics objects are all pointers so they can be allocated after
   // MeshBlockPack is constructed with pointer to my_pack.
 
@@ -71,6 +80,7 @@ class MeshBlockPack {
   numrel::NumericalRelativity *pnr=nullptr;
   ion_neutral::IonNeutral *pionn=nullptr;
   TurbulenceDriver *pturb=nullptr;
+  SelfGravity *pgrav=nullptr;
   radiation::Radiation *prad=nullptr;
   std::vector<z4c::PunctureTracker *> pz4c_ptracker;
   particles::Particles *ppart=nullptr;
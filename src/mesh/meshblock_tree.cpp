@@ -6,6 +6,7 @@
 //! \file meshblock_tree.cpp
 //  \brief implementation of constructor and functions in the MeshBlockTree class
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <sstream>
@@ -21,6 +22,68 @@ Mesh* MeshBlockTree::pmesh_;
 MeshBlockTree* MeshBlockTree::proot_;
 int MeshBlockTree::nleaf_;
 
+namespace {
+// number of bits per dimension used to compute Hilbert keys (enough for 31 levels)
+constexpr int kHilbertBits = 31;
+
+//----------------------------------------------------------------------------------------
+//! \fn void HilbertTranspose()
+//! \brief Converts coordinates of a cell at the finest level into the "transposed" form
+//! of its Hilbert index, using the algorithm of J. Skilling, AIP Conf. Proc. 707 (2004).
+//! The Hilbert index is given by interleaving the bits of x[0..ndim-1], starting from
+//! the most significant bit of x[0].
+
+void HilbertTranspose(std::uint32_t *x, int ndim) {
+  std::uint32_t m = 1U << (kHilbertBits - 1);
+  // inverse undo excess work
+  for (std::uint32_t q = m; q > 1; q >>= 1) {
+    std::uint32_t p = q - 1;
+    for (int i=0; i<ndim; ++i) {
+      if (x[i] & q) {
+        x[0] ^= p;
+      } else {
+        std::uint32_t t = (x[0] ^ x[i]) & p;
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+  // Gray encode
+  for (int i=1; i<ndim; ++i) {x[i] ^= x[i-1];}
+  std::uint32_t t = 0;
+  for (std::uint32_t q = m; q > 1; q >>= 1) {
+    if (x[ndim-1] & q) {t ^= q - 1;}
+  }
+  for (int i=0; i<ndim; ++i) {x[i] ^= t;}
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool HilbertLess()
+//! \brief Returns true if Hilbert index of node at location a is smaller than that of b.
+//! Nodes are mapped to their first cell at the finest possible level, so compares the
+//! position of the (contiguous) ranges of the curve spanned by each node.
+
+bool HilbertLess(const LogicalLocation &a, const LogicalLocation &b, int ndim) {
+  std::uint32_t xa[3], xb[3];
+  xa[0] = static_cast<std::uint32_t>(a.lx1) << (kHilbertBits - a.level);
+  xa[1] = static_cast<std::uint32_t>(a.lx2) << (kHilbertBits - a.level);
+  xa[2] = static_cast<std::uint32_t>(a.lx3) << (kHilbertBits - a.level);
+  xb[0] = static_cast<std::uint32_t>(b.lx1) << (kHilbertBits - b.level);
+  xb[1] = static_cast<std::uint32_t>(b.lx2) << (kHilbertBits - b.level);
+  xb[2] = static_cast<std::uint32_t>(b.lx3) << (kHilbertBits - b.level);
+  HilbertTranspose(xa, ndim);
+  HilbertTranspose(xb, ndim);
+  for (int n=kHilbertBits-1; n>=0; --n) {
+    for (int i=0; i<ndim; ++i) {
+      std::uint32_t ba = (xa[i] >> n) & 1U;
+      std::uint32_t bb = (xb[i] >> n) & 1U;
+      if (ba != bb) return (ba < bb);
+    }
+  }
+  return false;
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------
 //! \fn MeshBlockTree::MeshBlockTree()
 //! \brief constructor for the logical root level
@@ -332,6 +395,8 @@ void MeshBlockTree::CountMeshBlocks(int& count) {
 //! to an integer array that is used to store old gid of node on old tree, before creating
 //! a new gid based on Z-ordering in the new tree. Thus pglist[n] is a mapping of
 //! (new gid n) --> (old gid). Also returns total number of MBs in tree in third argument.
+//! With <loadbalancing>/sfc=hilbert leaves are instead sorted by Hilbert ordering, which
+//! improves the locality of the contiguous ranges of gids assigned to each rank.
 
 void MeshBlockTree::CreateZOrderedLLList(LogicalLocation *list, int *pglist, int& count) {
   if (lloc_.level == 0) {count=0;}
@@ -341,6 +406,18 @@ void MeshBlockTree::CreateZOrderedLLList(LogicalLocation *list, int *pglist, int
     if (pglist != nullptr) {pglist[count]=gid_;}
     gid_=count;
     count++;
+  } else if (pmesh_->hilbert_order && pmesh_->multi_d) {
+    // visit leaves in the order in which they are traversed by the Hilbert curve
+    int order[8];
+    for (int n=0; n<nleaf_; n++) {order[n] = n;}
+    int ndim = (pmesh_->three_d) ? 3 : 2;
+    std::sort(order, order+nleaf_, [&](int l, int r) {
+      return HilbertLess(LeafLocation(l), LeafLocation(r), ndim);
+    });
+    for (int n=0; n<nleaf_; n++) {
+      MeshBlockTree *pl = pleaf_[order[n]];
+      if (pl != nullptr) {pl->CreateZOrderedLLList(list, pglist, count);}
+    }
   } else {
     for (int n=0; n<nleaf_; n++) {
       if (pleaf_[n] != nullptr) {pleaf_[n]->CreateZOrderedLLList(list, pglist, count);}
@@ -477,3 +554,23 @@ MeshBlockTree* MeshBlockTree::FindMeshBlock(LogicalLocation tloc) {
   }
   return pleaf_[n]->FindMeshBlock(tloc);
 }
+
+//----------------------------------------------------------------------------------------
+//! \fn MeshBlockTree* MeshBlockTree::FindLeaf(LogicalLocation tloc)
+//! \brief find leaf (MeshBlock) containing LogicalLocation tloc, which may be at a finer
+//! level than the leaf.  Returns nullptr if tloc is not within any MeshBlock.
+
+MeshBlockTree* MeshBlockTree::FindLeaf(LogicalLocation tloc) {
+  if (pleaf_ == nullptr) return this;
+  if (tloc.level == lloc_.level) return nullptr;
+  // get leaf index
+  int sh = tloc.level - lloc_.level - 1;
+  int mx = (((tloc.lx1>>sh) & 1) == 1);
+  int my = (((tloc.lx2>>sh) & 1) == 1);
+  int mz = (((tloc.lx3>>sh) & 1) == 1);
+  int n = mx + (my<<1) + (mz<<2);
+  if (pleaf_[n] == nullptr) {
+    return nullptr;
+  }
+  return pleaf_[n]->FindLeaf(tloc);
+}
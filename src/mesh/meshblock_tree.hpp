@@ -36,6 +36,15 @@ class MeshBlockTree {
   MeshBlockTree* GetLeaf(int ox1, int ox2, int ox3)
     { return pleaf_[(ox1 + (ox2<<1) + (ox3<<2))]; }
   int GetGID() {return gid_;}
+  // logical location of leaf n (even if that leaf does not exist)
+  LogicalLocation LeafLocation(int n) {
+    LogicalLocation loc;
+    loc.lx1 = (lloc_.lx1<<1) + (n & 1);
+    loc.lx2 = (lloc_.lx2<<1) + ((n >> 1) & 1);
+    loc.lx3 = (lloc_.lx3<<1) + ((n >> 2) & 1);
+    loc.level = lloc_.level + 1;
+    return loc;
+  }
 
   // functions
   void CreateRootGrid();
@@ -44,6 +53,7 @@ class MeshBlockTree {
   void Refine(int &nnew);
   void Derefine(int &ndel);
   MeshBlockTree* FindMeshBlock(LogicalLocation tloc);
+  MeshBlockTree* FindLeaf(LogicalLocation tloc);
   void CountMeshBlocks(int& count);
   void CreateZOrderedLLList(LogicalLocation *list, int *pglist, int& count);
   MeshBlockTree* FindNeighbor(LogicalLocation myloc, int ox1, int ox2, int ox3,
@@ -14,45 +14,48 @@
 //----------------------------------------------------------------------------------------
 //! \fn ProlongCC()
 //! \brief 2nd-order (piecewise-linear) prolongation operator for cell-centered variables
+//! Index of MB in coarse array ca is cm, which may differ from m (see MeshBlock::mb_cidx)
 
+template <typename T>
 KOKKOS_INLINE_FUNCTION
-void ProlongCC(const int m, const int v, const int k, const int j, const int i,
+void ProlongCC(const int m, const int cm, const int v,
+               const int k, const int j, const int i,
                const int fk, const int fj, const int fi,
                const bool multi_d, const bool three_d,
-               const DvceArray5D<Real> &ca, const DvceArray5D<Real> &a) {
+               const DvceArray5D<T> &ca, const DvceArray5D<T> &a) {
   // calculate x1-gradient using the min-mod limiter
-  Real dl = ca(m,v,k,j,i  ) - ca(m,v,k,j,i-1);
-  Real dr = ca(m,v,k,j,i+1) - ca(m,v,k,j,i  );
+  Real dl = ca(cm,v,k,j,i  ) - ca(cm,v,k,j,i-1);
+  Real dr = ca(cm,v,k,j,i+1) - ca(cm,v,k,j,i  );
   Real dvar1 = 0.125*(SIGN(dl) + SIGN(dr))*fmin(fabs(dl), fabs(dr));
 
   // calculate x2-gradient using the min-mod limiter
   Real dvar2 = 0.0;
   if (multi_d) {
-    dl = ca(m,v,k,j  ,i) - ca(m,v,k,j-1,i);
-    dr = ca(m,v,k,j+1,i) - ca(m,v,k,j  ,i);
+    dl = ca(cm,v,k,j  ,i) - ca(cm,v,k,j-1,i);
+    dr = ca(cm,v,k,j+1,i) - ca(cm,v,k,j  ,i);
     dvar2 = 0.125*(SIGN(dl) + SIGN(dr))*fmin(fabs(dl), fabs(dr));
   }
 
   // calculate x1-gradient using the min-mod limiter
   Real dvar3 = 0.0;
   if (three_d) {
-    dl = ca(m,v,k  ,j,i) - ca(m,v,k-1,j,i);
-    dr = ca(m,v,k+1,j,i) - ca(m,v,k  ,j,i);
+    dl = ca(cm,v,k  ,j,i) - ca(cm,v,k-1,j,i);
+    dr = ca(cm,v,k+1,j,i) - ca(cm,v,k  ,j,i);
     dvar3 = 0.125*(SIGN(dl) + SIGN(dr))*fmin(fabs(dl), fabs(dr));
   }
 
   // interpolate to the finer grid
-  a(m,v,fk,fj,fi  ) = ca(m,v,k,j,i) - dvar1 - dvar2 - dvar3;
-  a(m,v,fk,fj,fi+1) = ca(m,v,k,j,i) + dvar1 - dvar2 - dvar3;
+  a(m,v,fk,fj,fi  ) = ca(cm,v,k,j,i) - dvar1 - dvar2 - dvar3;
+  a(m,v,fk,fj,fi+1) = ca(cm,v,k,j,i) + dvar1 - dvar2 - dvar3;
   if (multi_d) {
-    a(m,v,fk,fj+1,fi  ) = ca(m,v,k,j,i) - dvar1 + dvar2 - dvar3;
-    a(m,v,fk,fj+1,fi+1) = ca(m,v,k,j,i) + dvar1 + dvar2 - dvar3;
+    a(m,v,fk,fj+1,fi  ) = ca(cm,v,k,j,i) - dvar1 + dvar2 - dvar3;
+    a(m,v,fk,fj+1,fi+1) = ca(cm,v,k,j,i) + dvar1 + dvar2 - dvar3;
   }
   if (three_d) {
-    a(m,v,fk+1,fj  ,fi  ) = ca(m,v,k,j,i) - dvar1 - dvar2 + dvar3;
-    a(m,v,fk+1,fj  ,fi+1) = ca(m,v,k,j,i) + dvar1 - dvar2 + dvar3;
-    a(m,v,fk+1,fj+1,fi  ) = ca(m,v,k,j,i) - dvar1 + dvar2 + dvar3;
-    a(m,v,fk+1,fj+1,fi+1) = ca(m,v,k,j,i) + dvar1 + dvar2 + dvar3;
+    a(m,v,fk+1,fj  ,fi  ) = ca(cm,v,k,j,i) - dvar1 - dvar2 + dvar3;
+    a(m,v,fk+1,fj  ,fi+1) = ca(cm,v,k,j,i) + dvar1 - dvar2 + dvar3;
+    a(m,v,fk+1,fj+1,fi  ) = ca(cm,v,k,j,i) - dvar1 + dvar2 + dvar3;
+    a(m,v,fk+1,fj+1,fi+1) = ca(cm,v,k,j,i) + dvar1 + dvar2 + dvar3;
   }
   return;
 }
@@ -63,32 +66,33 @@ void ProlongCC(const int m, const int v, const int k, const int j, const int i,
 //! on shared X1-faces between fine and coarse cells
 
 KOKKOS_INLINE_FUNCTION
-void ProlongFCSharedX1Face(const int m, const int k, const int j, const int i,
+void ProlongFCSharedX1Face(const int m, const int cm,
+                   const int k, const int j, const int i,
                    const int fk, const int fj, const int fi,
                    const bool multi_d, const bool three_d,
                    const DvceArray4D<Real> &cbx1f, const DvceArray4D<Real> &bx1f) {
   // Prolongate b.x1f (v=0) by interpolating in x2/x3
   Real dvar2 = 0.0;
   if (multi_d) {
-    Real dl = cbx1f(m,k,j  ,i) - cbx1f(m,k,j-1,i);
-    Real dr = cbx1f(m,k,j+1,i) - cbx1f(m,k,j  ,i);
+    Real dl = cbx1f(cm,k,j  ,i) - cbx1f(cm,k,j-1,i);
+    Real dr = cbx1f(cm,k,j+1,i) - cbx1f(cm,k,j  ,i);
     dvar2 = 0.125*(SIGN(dl) + SIGN(dr))*fmin(fabs(dl), fabs(dr));
   }
 
   Real dvar3 = 0.0;
   if (three_d) {
-    Real dl = cbx1f(m,k  ,j,i) - cbx1f(m,k-1,j,i);
-    Real dr = cbx1f(m,k+1,j,i) - cbx1f(m,k  ,j,i);
+    Real dl = cbx1f(cm,k  ,j,i) - cbx1f(cm,k-1,j,i);
+    Real dr = cbx1f(cm,k+1,j,i) - cbx1f(cm,k  ,j,i);
     dvar3 = 0.125*(SIGN(dl) + SIGN(dr))*fmin(fabs(dl), fabs(dr));
   }
 
-  bx1f(m,fk,fj,fi) = cbx1f(m,k,j,i) - dvar2 - dvar3;
+  bx1f(m,fk,fj,fi) = cbx1f(cm,k,j,i) - dvar2 - dvar3;
   if (multi_d) {
-    bx1f(m,fk,fj+1,fi) = cbx1f(m,k,j,i) + dvar2 - dvar3;
+    bx1f(m,fk,fj+1,fi) = cbx1f(cm,k,j,i) + dvar2 - dvar3;
   }
   if (three_d) {
-    bx1f(m,fk+1,fj  ,fi) = cbx1f(m,k,j,i) - dvar2 + dvar3;
-    bx1f(m,fk+1,fj+1,fi) = cbx1f(m,k,j,i) + dvar2 + dvar3;
+    bx1f(m,fk+1,fj  ,fi) = cbx1f(cm,k,j,i) - dvar2 + dvar3;
+    bx1f(m,fk+1,fj+1,fi) = cbx1f(cm,k,j,i) + dvar2 + dvar3;
   }
   return;
 }
@@ -99,27 +103,28 @@ void ProlongFCSharedX1Face(const int m, const int k, const int j, const int i,
 //! on shared X2-faces between fine and coarse cells
 
 KOKKOS_INLINE_FUNCTION
-void ProlongFCSharedX2Face(const int m, const int k, const int j, const int i,
+void ProlongFCSharedX2Face(const int m, const int cm,
+                   const int k, const int j, const int i,
                    const int fk, const int fj, const int fi,
                    const bool three_d,
                    const DvceArray4D<Real> &cbx2f, const DvceArray4D<Real> &bx2f) {
   // Prolongate b.x2f (v=1) by interpolating in x1/x3
-  Real dl = cbx2f(m,k,j,i  ) - cbx2f(m,k,j,i-1);
-  Real dr = cbx2f(m,k,j,i+1) - cbx2f(m,k,j,i  );
+  Real dl = cbx2f(cm,k,j,i  ) - cbx2f(cm,k,j,i-1);
+  Real dr = cbx2f(cm,k,j,i+1) - cbx2f(cm,k,j,i  );
   Real dvar1 = 0.125*(SIGN(dl) + SIGN(dr))*fmin(fabs(dl), fabs(dr));
 
   Real dvar3 = 0.0;
   if (three_d) {
-    dl = cbx2f(m,k  ,j,i) - cbx2f(m,k-1,j,i);
-    dr = cbx2f(m,k+1,j,i) - cbx2f(m,k  ,j,i);
+    dl = cbx2f(cm,k  ,j,i) - cbx2f(cm,k-1,j,i);
+    dr = cbx2f(cm,k+1,j,i) - cbx2f(cm,k  ,j,i);
     dvar3 = 0.125*(SIGN(dl) + SIGN(dr))*fmin(fabs(dl), fabs(dr));
   }
 
-  bx2f(m,fk  ,fj,fi  ) = cbx2f(m,k,j,i) - dvar1 - dvar3;
-  bx2f(m,fk  ,fj,fi+1) = cbx2f(m,k,j,i) + dvar1 - dvar3;
+  bx2f(m,fk  ,fj,fi  ) = cbx2f(cm,k,j,i) - dvar1 - dvar3;
+  bx2f(m,fk  ,fj,fi+1) = cbx2f(cm,k,j,i) + dvar1 - dvar3;
   if (three_d) {
-    bx2f(m,fk+1,fj,fi  ) = cbx2f(m,k,j,i) - dvar1 + dvar3;
-    bx2f(m,fk+1,fj,fi+1) = cbx2f(m,k,j,i) + dvar1 + dvar3;
+    bx2f(m,fk+1,fj,fi  ) = cbx2f(cm,k,j,i) - dvar1 + dvar3;
+    bx2f(m,fk+1,fj,fi+1) = cbx2f(cm,k,j,i) + dvar1 + dvar3;
   }
   return;
 }
@@ -130,27 +135,28 @@ void ProlongFCSharedX2Face(const int m, const int k, const int j, const int i,
 //! on shared X3-faces between fine and coarse cells
 
 KOKKOS_INLINE_FUNCTION
-void ProlongFCSharedX3Face(const int m, const int k, const int j, const int i,
+void ProlongFCSharedX3Face(const int m, const int cm,
+                   const int k, const int j, const int i,
                    const int fk, const int fj, const int fi,
                    const bool multi_d,
                    const DvceArray4D<Real> &cbx3f, const DvceArray4D<Real> &bx3f) {
   // Prolongate b.x3f (v=2) by interpolating in x1/x2
-  Real dl = cbx3f(m,k,j,i  ) - cbx3f(m,k,j,i-1);
-  Real dr = cbx3f(m,k,j,i+1) - cbx3f(m,k,j,i  );
+  Real dl = cbx3f(cm,k,j,i  ) - cbx3f(cm,k,j,i-1);
+  Real dr = cbx3f(cm,k,j,i+1) - cbx3f(cm,k,j,i  );
   Real dvar1 = 0.125*(SIGN(dl) + SIGN(dr))*fmin(fabs(dl), fabs(dr));
 
   Real dvar2 = 0.0;
   if (multi_d) {
-    dl = cbx3f(m,k,j  ,i) - cbx3f(m,k,j-1,i);
-    dr = cbx3f(m,k,j+1,i) - cbx3f(m,k,j  ,i);
+    dl = cbx3f(cm,k,j  ,i) - cbx3f(cm,k,j-1,i);
+    dr = cbx3f(cm,k,j+1,i) - cbx3f(cm,k,j  ,i);
     dvar2 = 0.125*(SIGN(dl) + SIGN(dr))*fmin(fabs(dl), fabs(dr));
   }
 
-  bx3f(m,fk,fj  ,fi  ) = cbx3f(m,k,j,i) - dvar1 - dvar2;
-  bx3f(m,fk,fj  ,fi+1) = cbx3f(m,k,j,i) + dvar1 - dvar2;
+  bx3f(m,fk,fj  ,fi  ) = cbx3f(cm,k,j,i) - dvar1 - dvar2;
+  bx3f(m,fk,fj  ,fi+1) = cbx3f(cm,k,j,i) + dvar1 - dvar2;
   if (multi_d) {
-    bx3f(m,fk,fj+1,fi  ) = cbx3f(m,k,j,i) - dvar1 + dvar2;
-    bx3f(m,fk,fj+1,fi+1) = cbx3f(m,k,j,i) + dvar1 + dvar2;
+    bx3f(m,fk,fj+1,fi  ) = cbx3f(cm,k,j,i) - dvar1 + dvar2;
+    bx3f(m,fk,fj+1,fi+1) = cbx3f(cm,k,j,i) + dvar1 + dvar2;
   }
   return;
 }
@@ -230,12 +236,12 @@ void ProlongFCInternal(const int m, const int fk, const int fj, const int fi,
   return;
 }
 
-template <int NGHOST>
+template <int NGHOST, typename T>
 KOKKOS_INLINE_FUNCTION
 Real ProlongInterpolation(const int m, const int v, int k, int j, int i,
                             const int nx1, const int nx2, const int nx3,
                             const bool offsetk, const bool offsetj, const bool offseti,
-                        const DvceArray5D<Real> &ca, const DualArray3D<Real> &weights) {
+                        const DvceArray5D<T> &ca, const DualArray3D<Real> &weights) {
   // interpolated value at new grid point
   Real ivals = 0;
 
@@ -258,11 +264,11 @@ Real ProlongInterpolation(const int m, const int v, int k, int j, int i,
 //! \fn HighOrderProlongCC()
 //! \brief high-order prolongation operator for cell-centered variables
 
-template <int NGHOST>
+template <int NGHOST, typename T>
 KOKKOS_INLINE_FUNCTION
 void HighOrderProlongCC(const int m, const int v, const int k, const int j, const int i,
                const int fk, const int fj, const int fi, const int nx1, const int nx2,
-               const int nx3, const DvceArray5D<Real> &ca, const DvceArray5D<Real> &a,
+               const int nx3, const DvceArray5D<T> &ca, const DvceArray5D<T> &a,
                const DualArray3D<Real> &weights) {
   // stencil size for interpolator
   a(m,v,fk  ,fj  ,fi  ) = ProlongInterpolation<NGHOST>(m,v,k,j,i, nx1, nx2, nx3,
@@ -15,11 +15,11 @@
 #include "mesh/mesh.hpp"
 #include "coordinates/cell_locations.hpp"
 
-template <int NGHOST>
+template <int NGHOST, typename T>
 KOKKOS_INLINE_FUNCTION
 Real RestrictInterpolation(const int m, const int v, const int fk, const int fj,
                           const int fi, const int nx1, const int nx2, const int nx3,
-                          const DvceArray5D<Real> &a,
+                          const DvceArray5D<T> &a,
                           const DualArray1D<Real> &restrict_2nd,
                           const DualArray1D<Real> &restrict_4th,
                           const DualArray1D<Real> &restrict_4th_edge) {
@@ -20,7 +20,10 @@
 #include "srcterms/srcterms.hpp"
 #include "shearing_box/shearing_box.hpp"
 #include "bvals/bvals.hpp"
+#include "utils/first_touch.hpp"
+#include "utils/managed_memory.hpp"
 #include "mhd/mhd.hpp"
+#include "dyn_grmhd/dyn_grmhd.hpp"
 
 namespace mhd {
 //----------------------------------------------------------------------------------------
@@ -50,9 +53,9 @@ MHD::MHD(MeshBlockPack *ppack, ParameterInput *pin) :
     e1_cc("e1_cc",1,1,1,1),
     e2_cc("e2_cc",1,1,1,1),
     e3_cc("e3_cc",1,1,1,1),
-    utest("utest",1,1,1,1,1),
-    bcctest("bcctest",1,1,1,1,1),
-    fofc("fofc",1,1,1,1) {
+    fofc("fofc",1,1,1,1),
+    fofc_cells("fofc_cells",1),
+    rs_nrow("rs_nrow",1) {
   // Total number of MeshBlocks on this rank to be used in array dimensioning
   int nmb = std::max((ppack->nmb_thispack), (ppack->pmesh->nmb_maxperrank));
 
@@ -90,6 +93,15 @@ MHD::MHD(MeshBlockPack *ppack, ParameterInput *pin) :
 
   // (2) Initialize scalars, diffusion, source terms
   nscalars = pin->GetOrAddInteger("mhd","nscalars",0);
+  // the last ndiag_scalars scalars are diagnostic tracers, always reconstructed with
+  // (cheap) donor cell regardless of <mhd>/reconstruct
+  ndiag_scalars = pin->GetOrAddInteger("mhd","ndiag_scalars",0);
+  if (ndiag_scalars < 0 || ndiag_scalars > nscalars) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<mhd>/ndiag_scalars=" << ndiag_scalars << " must be between 0 and "
+              << "nscalars=" << nscalars << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
 
   // Viscosity (only constructed if needed)
   if (pin->DoesParameterExist("mhd","viscosity")) {
@@ -128,33 +140,42 @@ MHD::MHD(MeshBlockPack *ppack, ParameterInput *pin) :
     int ncells1 = indcs.nx1 + 2*(indcs.ng);
     int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
     int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
-    Kokkos::realloc(u0,   nmb, (nmhd+nscalars), ncells3, ncells2, ncells1);
-    Kokkos::realloc(w0,   nmb, (nmhd+nscalars), ncells3, ncells2, ncells1);
+    FirstTouch::Realloc(u0,   nmb, (nmhd+nscalars), ncells3, ncells2, ncells1);
+    FirstTouch::Realloc(w0,   nmb, (nmhd+nscalars), ncells3, ncells2, ncells1);
 
     // allocate memory for face-centered and cell-centered magnetic fields
-    Kokkos::realloc(bcc0,   nmb, 3, ncells3, ncells2, ncells1);
-    Kokkos::realloc(b0.x1f, nmb, ncells3, ncells2, ncells1+1);
-    Kokkos::realloc(b0.x2f, nmb, ncells3, ncells2+1, ncells1);
-    Kokkos::realloc(b0.x3f, nmb, ncells3+1, ncells2, ncells1);
+    FirstTouch::Realloc(bcc0,   nmb, 3, ncells3, ncells2, ncells1);
+    FirstTouch::Realloc(b0.x1f, nmb, ncells3, ncells2, ncells1+1);
+    FirstTouch::Realloc(b0.x2f, nmb, ncells3, ncells2+1, ncells1);
+    FirstTouch::Realloc(b0.x3f, nmb, ncells3+1, ncells2, ncells1);
   }
 
-  // allocate memory for conserved variables on coarse mesh
+  // allocate memory for conserved variables on coarse mesh (only for MBs with coarser
+  // neighbors when arrays are compacted with SMR)
   if (ppack->pmesh->multilevel) {
     auto &indcs = pmy_pack->pmesh->mb_indcs;
     int n_ccells1 = indcs.cnx1 + 2*(indcs.ng);
     int n_ccells2 = (indcs.cnx2 > 1)? (indcs.cnx2 + 2*(indcs.ng)) : 1;
     int n_ccells3 = (indcs.cnx3 > 1)? (indcs.cnx3 + 2*(indcs.ng)) : 1;
-    Kokkos::realloc(coarse_u0, nmb, (nmhd+nscalars), n_ccells3, n_ccells2, n_ccells1);
-    Kokkos::realloc(coarse_w0, nmb, (nmhd+nscalars), n_ccells3, n_ccells2, n_ccells1);
-    Kokkos::realloc(coarse_b0.x1f, nmb, n_ccells3, n_ccells2, n_ccells1+1);
-    Kokkos::realloc(coarse_b0.x2f, nmb, n_ccells3, n_ccells2+1, n_ccells1);
-    Kokkos::realloc(coarse_b0.x3f, nmb, n_ccells3+1, n_ccells2, n_ccells1);
+    int ncmb = (pmy_pack->pmb->compact_coarse)? pmy_pack->pmb->nmb_coarse : nmb;
+    ManagedMemory::Realloc(coarse_u0, ncmb, (nmhd+nscalars), n_ccells3, n_ccells2,
+                           n_ccells1);
+    ManagedMemory::Realloc(coarse_w0, ncmb, (nmhd+nscalars), n_ccells3, n_ccells2,
+                           n_ccells1);
+    Kokkos::realloc(coarse_b0.x1f, ncmb, n_ccells3, n_ccells2, n_ccells1+1);
+    Kokkos::realloc(coarse_b0.x2f, ncmb, n_ccells3, n_ccells2+1, n_ccells1);
+    Kokkos::realloc(coarse_b0.x3f, ncmb, n_ccells3+1, n_ccells2, n_ccells1);
   }
 
   // allocate boundary buffers for conserved (cell-centered) and face-centered variables
   pbval_u = new MeshBoundaryValuesCC(ppack, pin, false);
+  // optionally send single-precision ghost zones to MeshBlocks on other nodes
+  pbval_u->compress_mpi = pin->GetOrAddBoolean("mhd","compress_mpi",false);
+  // optionally exchange fewer ghost cells than <mesh>/nghost
+  nghost = pbval_u->SetGhostDepth(pin, "mhd");
   pbval_u->InitializeBuffers((nmhd+nscalars));
   pbval_b = new MeshBoundaryValuesFC(ppack, pin);
+  pbval_b->SetGhostDepth(pin, "mhd");
   pbval_b->InitializeBuffers(3);
 
   // Orbital advection and shearing box BCs (if requested in input file)
@@ -175,6 +196,32 @@ MHD::MHD(MeshBlockPack *ppack, ParameterInput *pin) :
     // determine if FOFC is enabled
     use_fofc = pin->GetOrAddBoolean("mhd","fofc",false);
 
+    // determine if CT and ConsToPrim in active cells are overlapped with communications
+    overlap_comm = pin->GetOrAddBoolean("mhd","overlap_comm",false);
+
+    // determine if rows of W and Bcc are staged in scratch for x2/x3 reconstruction
+    scratch_window = pin->GetOrAddBoolean("mhd","scratch_window",false);
+
+    // determine if the flow and magnetic field are held fixed in kinematic problems, so
+    // that only passive scalars are advected.  MHD variables in ghost zones are filled
+    // once in Driver::Initialize and never change, so they are skipped in the exchange
+    // and the E-field/CT tasks are omitted.  Not possible with SMR/AMR since
+    // prolongation acts on all variables.
+    fixed_flow = pin->GetOrAddBoolean("mhd","fixed_flow",false);
+    if (fixed_flow) {
+      if (evolution_t.compare("kinematic") != 0 || ppack->pmesh->multilevel ||
+          (pvisc != nullptr) || (presist != nullptr) || (pcond != nullptr) ||
+          psrc->const_accel || psrc->ism_cooling || psrc->rel_cooling ||
+          psrc->shearing_box || (porb_u != nullptr) || (psbox_u != nullptr) ||
+          pin->DoesBlockExist("hydro")) {
+        std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<mhd>/fixed_flow requires kinematic evolution on "
+                  << "uniform grids without diffusion, source terms, shearing box, or "
+                  << "two-fluid. Evolving all variables." << std::endl;
+        fixed_flow = false;
+      }
+    }
+
     // select reconstruction method (default PLM)
     std::string xorder = pin->GetOrAddString("mhd","reconstruct","plm");
     if (xorder.compare("dc") == 0) {
@@ -182,29 +229,27 @@ MHD::MHD(MeshBlockPack *ppack, ParameterInput *pin) :
     } else if (xorder.compare("plm") == 0) {
       recon_method = ReconstructionMethod::plm;
       // check that nghost > 2 with PLM+FOFC
-      auto &indcs = pmy_pack->pmesh->mb_indcs;
-      if (use_fofc && indcs.ng < 3) {
+      if (use_fofc && nghost < 3) {
         std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
           << std::endl << "FOFC and " << xorder << " reconstruction requires at "
-          << "least 3 ghost zones, but <mesh>/nghost=" << indcs.ng << std::endl;
+          << "least 3 ghost zones, but <mhd>/nghost=" << nghost << std::endl;
         std::exit(EXIT_FAILURE);
       }
     } else if (xorder.compare("ppm4") == 0 ||
                xorder.compare("ppmx") == 0 ||
                xorder.compare("wenoz") == 0) {
       // check that nghost > 2
-      auto &indcs = pmy_pack->pmesh->mb_indcs;
-      if (indcs.ng < 3) {
+      if (nghost < 3) {
         std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
           << std::endl << xorder << " reconstruction requires at least 3 ghost zones, "
-          << "but <mesh>/nghost=" << indcs.ng << std::endl;
+          << "but <mhd>/nghost=" << nghost << std::endl;
         std::exit(EXIT_FAILURE);
       }
       // check that nghost > 3 with PPM4(or PPMX or WENOZ)+FOFC
-      if (use_fofc && indcs.ng < 4) {
+      if (use_fofc && nghost < 4) {
         std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
           << std::endl << "FOFC and " << xorder << " reconstruction requires at "
-          << "least 4 ghost zones, but <mesh>/nghost=" << indcs.ng << std::endl;
+          << "least 4 ghost zones, but <mhd>/nghost=" << nghost << std::endl;
         std::exit(EXIT_FAILURE);
       }
       if (xorder.compare("ppm4") == 0) {
@@ -297,6 +342,20 @@ MHD::MHD(MeshBlockPack *ppack, ParameterInput *pin) :
       }
     }
 
+    // determine if HLLE is used in smooth rows of faces (hybrid Riemann solver)
+    rsolver_hybrid = pin->GetOrAddBoolean("mhd","rsolver_hybrid",false);
+    if (rsolver_hybrid) {
+      if (rsolver_method != MHD_RSolver::hlld) {
+        std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<mhd>/rsolver_hybrid requires rsolver = hlld. Using '"
+                  << rsolver << "' everywhere." << std::endl;
+        rsolver_hybrid = false;
+      } else {
+        rsolver_hybrid_tol = pin->GetOrAddReal("mhd","rsolver_hybrid_tol",0.1);
+        Kokkos::realloc(rs_nrow, 2);
+      }
+    }
+
     // Final memory allocations
     {
       // allocate second registers
@@ -304,15 +363,15 @@ MHD::MHD(MeshBlockPack *ppack, ParameterInput *pin) :
       int ncells1 = indcs.nx1 + 2*(indcs.ng);
       int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
       int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
-      Kokkos::realloc(u1,     nmb, (nmhd+nscalars), ncells3, ncells2, ncells1);
-      Kokkos::realloc(b1.x1f, nmb, ncells3, ncells2, ncells1+1);
-      Kokkos::realloc(b1.x2f, nmb, ncells3, ncells2+1, ncells1);
-      Kokkos::realloc(b1.x3f, nmb, ncells3+1, ncells2, ncells1);
+      FirstTouch::Realloc(u1,     nmb, (nmhd+nscalars), ncells3, ncells2, ncells1);
+      FirstTouch::Realloc(b1.x1f, nmb, ncells3, ncells2, ncells1+1);
+      FirstTouch::Realloc(b1.x2f, nmb, ncells3, ncells2+1, ncells1);
+      FirstTouch::Realloc(b1.x3f, nmb, ncells3+1, ncells2, ncells1);
 
       // allocate fluxes, electric fields
-      Kokkos::realloc(uflx.x1f, nmb, (nmhd+nscalars), ncells3, ncells2, ncells1+1);
-      Kokkos::realloc(uflx.x2f, nmb, (nmhd+nscalars), ncells3, ncells2+1, ncells1);
-      Kokkos::realloc(uflx.x3f, nmb, (nmhd+nscalars), ncells3+1, ncells2, ncells1);
+      FirstTouch::Realloc(uflx.x1f, nmb, (nmhd+nscalars), ncells3, ncells2, ncells1+1);
+      FirstTouch::Realloc(uflx.x2f, nmb, (nmhd+nscalars), ncells3, ncells2+1, ncells1);
+      FirstTouch::Realloc(uflx.x3f, nmb, (nmhd+nscalars), ncells3+1, ncells2, ncells1);
       Kokkos::realloc(efld.x1e, nmb, ncells3+1, ncells2+1, ncells1);
       Kokkos::realloc(efld.x2e, nmb, ncells3+1, ncells2, ncells1+1);
       Kokkos::realloc(efld.x3e, nmb, ncells3, ncells2+1, ncells1+1);
@@ -330,10 +389,7 @@ MHD::MHD(MeshBlockPack *ppack, ParameterInput *pin) :
 
       // allocate array of flags used with FOFC
       if (use_fofc) {
-        int nvars = (pmy_pack->pcoord->is_dynamical_relativistic) ? nmhd+nscalars : nmhd;
         Kokkos::realloc(fofc,    nmb, ncells3, ncells2, ncells1);
-        Kokkos::realloc(utest,   nmb, nvars, ncells3, ncells2, ncells1);
-        Kokkos::realloc(bcctest, nmb, 3,    ncells3, ncells2, ncells1);
         Kokkos::deep_copy(fofc, false);
       }
     }
@@ -370,4 +426,16 @@ void MHD::SetSaveWBcc() {
   wbcc_saved = true;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn Real MHD::FluidDt()
+//! \brief timestep used to update the fluid.  Equal to the mesh timestep, except with
+//! multirate evolution in dynamical GR, in which the fluid is advanced less often.
+
+Real MHD::FluidDt() const {
+  if (pmy_pack->pdyngr != nullptr) {
+    return pmy_pack->pdyngr->FluidDt();
+  }
+  return pmy_pack->pmesh->dt;
+}
+
 } // namespace mhd
@@ -75,6 +75,7 @@ struct MHDTaskIDs {
   TaskID bcs;
   TaskID prol;
   TaskID c2p;
+  TaskID c2pa;
   TaskID newdt;
   TaskID csend;
   TaskID crecv;
@@ -97,6 +98,8 @@ class MHD {
 
   int nmhd;                // number of mhd variables (5/4 for ideal/isothermal EOS)
   int nscalars;            // number of passive scalars
+  int ndiag_scalars;       // number of (last) scalars reconstructed with donor cell
+  int nghost;              // number of ghost cells exchanged with neighbors
   DvceArray5D<Real> u0;    // conserved variables
   DvceArray5D<Real> w0;    // primitive variables
   DvceFaceFld4D<Real> b0;  // face-centered magnetic fields
@@ -142,12 +145,28 @@ class MHD {
   // following used for FOFC algorithm
   DvceArray4D<bool> fofc;  // flag for each cell to indicate if FOFC is needed
   bool use_fofc = false;   // flag to enable FOFC
+  DvceArray1D<int> fofc_cells;  // compacted list of cells flagged for FOFC
+
+  // flag to overlap CornerE/CT and ConsToPrim in active cells with communication of
+  // ghost zones
+  bool overlap_comm = false;
+  // flag to stage rows of w0/bcc0 in scratch memory for x2/x3 reconstruction
+  bool scratch_window = false;
+  // flag to use HLLE instead of HLLD in rows of faces without discontinuities
+  bool rsolver_hybrid = false;
+  Real rsolver_hybrid_tol = 0.1;  // largest relative jump at faces of "smooth" rows
+  DvceArray1D<int> rs_nrow;       // number of rows using (rsolver, HLLE)
+  // flag to hold the flow and magnetic field fixed in kinematic problems, so only the
+  // passive scalars are updated and exchanged
+  bool fixed_flow = false;
 
   // container to hold names of TaskIDs
   MHDTaskIDs id;
 
   // functions...
   void SetSaveWBcc();
+  // timestep used to update fluid; differs from mesh dt with multirate dynamical GR
+  Real FluidDt() const;
   void AssembleMHDTasks(std::map<std::string, std::shared_ptr<TaskList>> tl);
   // ...in "before_timeintegrator" task list
   TaskStatus SaveMHDState(Driver *d, int stage);
@@ -172,6 +191,8 @@ class MHD {
   TaskStatus SendE(Driver *d, int stage);
   TaskStatus RecvE(Driver *d, int stage);
   TaskStatus CT(Driver *d, int stage);
+  template <int NDIM>
+  void CTUpdate(Driver *d, int stage);
   TaskStatus SendB_OA(Driver *d, int stage);
   TaskStatus RecvB_OA(Driver *d, int stage);
   TaskStatus RestrictB(Driver *d, int stage);
@@ -182,6 +203,8 @@ class MHD {
   TaskStatus ApplyPhysicalBCs(Driver* pdrive, int stage);
   TaskStatus Prolongate(Driver* pdrive, int stage);
   TaskStatus ConToPrim(Driver *d, int stage);
+  TaskStatus ConToPrimActive(Driver *d, int stage);
+  TaskStatus ConToPrimGhosts(Driver *d, int stage);
   TaskStatus NewTimeStep(Driver *d, int stage);
   // ...in "after_stagen_tl" task list
   TaskStatus ClearSend(Driver *d, int stage);
@@ -194,7 +217,6 @@ class MHD {
   // first-order flux correction
   void FOFC(Driver *d, int stage);
 
-  DvceArray5D<Real> utest, bcctest;  // scratch arrays for FOFC
 
  private:
   MeshBlockPack* pmy_pack;   // ptr to MeshBlockPack containing this MHD
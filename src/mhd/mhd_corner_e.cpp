@@ -64,7 +64,7 @@ TaskStatus MHD::CornerE(Driver *pdriver, int stage) {
 
     // compute cell-centered EMF in dynamical GRMHD
     if (pmy_pack->padm != nullptr) {
-      auto &adm = pmy_pack->padm->adm;
+      auto &adm = pmy_pack->padm->adm_fluid;
       par_for("e_cc_2d", DevExeSpace(), 0, nmb1, js-1, je+1, is-1, ie+1,
       KOKKOS_LAMBDA(int m, int j, int i) {
         // Calculate the spatial components of the three-velocity
@@ -142,16 +142,14 @@ TaskStatus MHD::CornerE(Driver *pdriver, int stage) {
         Real u0 = sqrt(1.0 + SQR(u1) + SQR(u2) + SQR(u3));
         e3cc_(m,ks,j,i) = (u2 * bcc_(m,IBX,ks,j,i) - u1 * bcc_(m,IBY,ks,j,i)) / u0;
       });
-
-    // compute cell-centered EMF in Newtonian MHD
-    } else {
-      par_for("e_cc_2d", DevExeSpace(), 0, nmb1, js-1, je+1, is-1, ie+1,
-      KOKKOS_LAMBDA(int m, int j, int i) {
-        e3cc_(m,ks,j,i) = w0_(m,IVY,ks,j,i)*bcc_(m,IBX,ks,j,i) -
-                          w0_(m,IVX,ks,j,i)*bcc_(m,IBY,ks,j,i);
-      });
     }
 
+    // In Newtonian MHD the cell-centered EMF is computed directly in the corner
+    // integration kernel below, rather than stored in e3_cc
+    bool fused_ecc = (pmy_pack->padm == nullptr) &&
+                     !(pmy_pack->pcoord->is_general_relativistic) &&
+                     !(pmy_pack->pcoord->is_special_relativistic);
+
     // capture class variables for the kernels
     auto e1 = efld.x1e;
     auto e2 = efld.x2e;
@@ -167,37 +165,77 @@ TaskStatus MHD::CornerE(Driver *pdriver, int stage) {
     //  Note e1[is:ie,  js:je+1,ks:ke+1]
     //       e2[is:ie+1,js:je,  ks:ke+1]
     //       e3[is:ie+1,js:je+1,ks:ke  ]
-    par_for("emf2", DevExeSpace(), 0, nmb1, js, je+1, is, ie+1,
-    KOKKOS_LAMBDA(const int m, const int j, const int i) {
-      e2(m,ks  ,j,i) = e2x1_(m,ks,j,i);
-      e2(m,ke+1,j,i) = e2x1_(m,ks,j,i);
-      e1(m,ks  ,j,i) = e1x2_(m,ks,j,i);
-      e1(m,ke+1,j,i) = e1x2_(m,ks,j,i);
-
-      Real e3_l2, e3_r2, e3_l1, e3_r1;
-      if (flx1(m,IDN,ks,j-1,i) >= 0.0) {
-        e3_l2 = e3x2_(m,ks,j,i-1) - e3cc_(m,ks,j-1,i-1);
-      } else {
-        e3_l2 = e3x2_(m,ks,j,i  ) - e3cc_(m,ks,j-1,i  );
-      }
-      if (flx1(m,IDN,ks,j,i) >= 0.0) {
-        e3_r2 = e3x2_(m,ks,j,i-1) - e3cc_(m,ks,j  ,i-1);
-      } else {
-        e3_r2 = e3x2_(m,ks,j,i  ) - e3cc_(m,ks,j  ,i  );
-      }
-      if (flx2(m,IDN,ks,j,i-1) >= 0.0) {
-        e3_l1 = e3x1_(m,ks,j-1,i) - e3cc_(m,ks,j-1,i-1);
-      } else {
-        e3_l1 = e3x1_(m,ks,j  ,i) - e3cc_(m,ks,j  ,i-1);
-      }
-      if (flx2(m,IDN,ks,j,i) >= 0.0) {
-        e3_r1 = e3x1_(m,ks,j-1,i) - e3cc_(m,ks,j-1,i  );
-      } else {
-        e3_r1 = e3x1_(m,ks,j  ,i) - e3cc_(m,ks,j  ,i  );
-      }
-      e3(m,ks,j,i) = 0.25*(e3_l1 + e3_r1 + e3_l2 + e3_r2 +
-             e3x2_(m,ks,j,i-1) + e3x2_(m,ks,j,i) + e3x1_(m,ks,j-1,i) + e3x1_(m,ks,j,i));
-    });
+    if (fused_ecc) {
+      par_for("emf2_fused", DevExeSpace(), 0, nmb1, js, je+1, is, ie+1,
+      KOKKOS_LAMBDA(const int m, const int j, const int i) {
+        // cell-centered E3=VyBx-VxBy
+        auto e3cc = [&](const int kk, const int jj, const int ii) {
+          return w0_(m,IVY,kk,jj,ii)*bcc_(m,IBX,kk,jj,ii) -
+                 w0_(m,IVX,kk,jj,ii)*bcc_(m,IBY,kk,jj,ii);
+        };
+
+        e2(m,ks  ,j,i) = e2x1_(m,ks,j,i);
+        e2(m,ke+1,j,i) = e2x1_(m,ks,j,i);
+        e1(m,ks  ,j,i) = e1x2_(m,ks,j,i);
+        e1(m,ke+1,j,i) = e1x2_(m,ks,j,i);
+
+        Real e3_l2, e3_r2, e3_l1, e3_r1;
+        if (flx1(m,IDN,ks,j-1,i) >= 0.0) {
+          e3_l2 = e3x2_(m,ks,j,i-1) - e3cc(ks,j-1,i-1);
+        } else {
+          e3_l2 = e3x2_(m,ks,j,i  ) - e3cc(ks,j-1,i  );
+        }
+        if (flx1(m,IDN,ks,j,i) >= 0.0) {
+          e3_r2 = e3x2_(m,ks,j,i-1) - e3cc(ks,j  ,i-1);
+        } else {
+          e3_r2 = e3x2_(m,ks,j,i  ) - e3cc(ks,j  ,i  );
+        }
+        if (flx2(m,IDN,ks,j,i-1) >= 0.0) {
+          e3_l1 = e3x1_(m,ks,j-1,i) - e3cc(ks,j-1,i-1);
+        } else {
+          e3_l1 = e3x1_(m,ks,j  ,i) - e3cc(ks,j  ,i-1);
+        }
+        if (flx2(m,IDN,ks,j,i) >= 0.0) {
+          e3_r1 = e3x1_(m,ks,j-1,i) - e3cc(ks,j-1,i  );
+        } else {
+          e3_r1 = e3x1_(m,ks,j  ,i) - e3cc(ks,j  ,i  );
+        }
+        e3(m,ks,j,i) = 0.25*(e3_l1 + e3_r1 + e3_l2 + e3_r2 +
+               e3x2_(m,ks,j,i-1) + e3x2_(m,ks,j,i) + e3x1_(m,ks,j-1,i) + e3x1_(m,ks,j,i));
+      });
+    } else {
+      par_for("emf2", DevExeSpace(), 0, nmb1, js, je+1, is, ie+1,
+      KOKKOS_LAMBDA(const int m, const int j, const int i) {
+        e2(m,ks  ,j,i) = e2x1_(m,ks,j,i);
+        e2(m,ke+1,j,i) = e2x1_(m,ks,j,i);
+        e1(m,ks  ,j,i) = e1x2_(m,ks,j,i);
+        e1(m,ke+1,j,i) = e1x2_(m,ks,j,i);
+
+        Real e3_l2, e3_r2, e3_l1, e3_r1;
+        if (flx1(m,IDN,ks,j-1,i) >= 0.0) {
+          e3_l2 = e3x2_(m,ks,j,i-1) - e3cc_(m,ks,j-1,i-1);
+        } else {
+          e3_l2 = e3x2_(m,ks,j,i  ) - e3cc_(m,ks,j-1,i  );
+        }
+        if (flx1(m,IDN,ks,j,i) >= 0.0) {
+          e3_r2 = e3x2_(m,ks,j,i-1) - e3cc_(m,ks,j  ,i-1);
+        } else {
+          e3_r2 = e3x2_(m,ks,j,i  ) - e3cc_(m,ks,j  ,i  );
+        }
+        if (flx2(m,IDN,ks,j,i-1) >= 0.0) {
+          e3_l1 = e3x1_(m,ks,j-1,i) - e3cc_(m,ks,j-1,i-1);
+        } else {
+          e3_l1 = e3x1_(m,ks,j  ,i) - e3cc_(m,ks,j  ,i-1);
+        }
+        if (flx2(m,IDN,ks,j,i) >= 0.0) {
+          e3_r1 = e3x1_(m,ks,j-1,i) - e3cc_(m,ks,j-1,i  );
+        } else {
+          e3_r1 = e3x1_(m,ks,j  ,i) - e3cc_(m,ks,j  ,i  );
+        }
+        e3(m,ks,j,i) = 0.25*(e3_l1 + e3_r1 + e3_l2 + e3_r2 +
+               e3x2_(m,ks,j,i-1) + e3x2_(m,ks,j,i) + e3x1_(m,ks,j-1,i) + e3x1_(m,ks,j,i));
+      });
+    }
   }
 
   //---- 3-D problem:
@@ -216,7 +254,7 @@ TaskStatus MHD::CornerE(Driver *pdriver, int stage) {
 
     // compute cell-centered EMFs in dynamical GRMHD
     if (pmy_pack->padm != nullptr) {
-      auto &adm = pmy_pack->padm->adm;
+      auto &adm = pmy_pack->padm->adm_fluid;
       par_for("e_cc_3d", DevExeSpace(), 0, nmb1, ks-1, ke+1, js-1, je+1, is-1, ie+1,
       KOKKOS_LAMBDA(int m, int k, int j, int i) {
         // Calculate something that resembles the spatial components of the four-velocity
@@ -303,20 +341,14 @@ TaskStatus MHD::CornerE(Driver *pdriver, int stage) {
         e2cc_(m,k,j,i) = (u1 * bcc_(m,IBZ,k,j,i) - u3 * bcc_(m,IBX,k,j,i)) / u0;
         e3cc_(m,k,j,i) = (u2 * bcc_(m,IBX,k,j,i) - u1 * bcc_(m,IBY,k,j,i)) / u0;
       });
-
-    // compute cell-centered EMFs in Newtonian MHD
-    } else {
-      par_for("e_cc_3d", DevExeSpace(), 0, nmb1, ks-1, ke+1, js-1, je+1, is-1, ie+1,
-      KOKKOS_LAMBDA(int m, int k, int j, int i) {
-        e1cc_(m,k,j,i) = w0_(m,IVZ,k,j,i)*bcc_(m,IBY,k,j,i) -
-                         w0_(m,IVY,k,j,i)*bcc_(m,IBZ,k,j,i);
-        e2cc_(m,k,j,i) = w0_(m,IVX,k,j,i)*bcc_(m,IBZ,k,j,i) -
-                         w0_(m,IVZ,k,j,i)*bcc_(m,IBX,k,j,i);
-        e3cc_(m,k,j,i) = w0_(m,IVY,k,j,i)*bcc_(m,IBX,k,j,i) -
-                         w0_(m,IVX,k,j,i)*bcc_(m,IBY,k,j,i);
-      });
     }
 
+    // In Newtonian MHD the cell-centered EMFs are simple enough that they are computed
+    // directly in the corner integration kernel below, rather than stored in e?_cc
+    bool fused_ecc = (pmy_pack->padm == nullptr) &&
+                     !(pmy_pack->pcoord->is_general_relativistic) &&
+                     !(pmy_pack->pcoord->is_special_relativistic);
+
     // capture class variables for the kernels
     auto e1 = efld.x1e;
     auto e2 = efld.x2e;
@@ -335,83 +367,177 @@ TaskStatus MHD::CornerE(Driver *pdriver, int stage) {
     //  Note e1[is:ie,  js:je+1,ks:ke+1]
     //       e2[is:ie+1,js:je,  ks:ke+1]
     //       e3[is:ie+1,js:je+1,ks:ke  ]
-    par_for("emf3", DevExeSpace(), 0, nmb1, ks, ke+1, js, je+1, is, ie+1,
-    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
-      // integrate E1 to corner using SG07
-      Real e1_l3, e1_r3, e1_l2, e1_r2;
-      if (flx2(m,IDN,k-1,j,i) >= 0.0) {
-        e1_l3 = e1x3_(m,k,j-1,i) - e1cc_(m,k-1,j-1,i);
-      } else {
-        e1_l3 = e1x3_(m,k,j  ,i) - e1cc_(m,k-1,j  ,i);
-      }
-      if (flx2(m,IDN,k,j,i) >= 0.0) {
-        e1_r3 = e1x3_(m,k,j-1,i) - e1cc_(m,k  ,j-1,i);
-      } else {
-        e1_r3 = e1x3_(m,k,j  ,i) - e1cc_(m,k  ,j  ,i);
-      }
-      if (flx3(m,IDN,k,j-1,i) >= 0.0) {
-        e1_l2 = e1x2_(m,k-1,j,i) - e1cc_(m,k-1,j-1,i);
-      } else {
-        e1_l2 = e1x2_(m,k  ,j,i) - e1cc_(m,k  ,j-1,i);
-      }
-      if (flx3(m,IDN,k,j,i) >= 0.0) {
-        e1_r2 = e1x2_(m,k-1,j,i) - e1cc_(m,k-1,j  ,i);
-      } else {
-        e1_r2 = e1x2_(m,k  ,j,i) - e1cc_(m,k  ,j  ,i);
-      }
-      e1(m,k,j,i) = 0.25*(e1_l3 + e1_r3 + e1_l2 + e1_r2 +
-                e1x2_(m,k-1,j,i) + e1x2_(m,k,j,i) + e1x3_(m,k,j-1,i) + e1x3_(m,k,j,i));
-
-      // integrate E2 to corner using SG07
-      Real e2_l3, e2_r3, e2_l1, e2_r1;
-      if (flx1(m,IDN,k-1,j,i) >= 0.0) {
-        e2_l3 = e2x3_(m,k,j,i-1) - e2cc_(m,k-1,j,i-1);
-      } else {
-        e2_l3 = e2x3_(m,k,j,i  ) - e2cc_(m,k-1,j,i  );
-      }
-      if (flx1(m,IDN,k,j,i) >= 0.0) {
-        e2_r3 = e2x3_(m,k,j,i-1) - e2cc_(m,k  ,j,i-1);
-      } else {
-        e2_r3 = e2x3_(m,k,j,i  ) - e2cc_(m,k  ,j,i  );
-      }
-      if (flx3(m,IDN,k,j,i-1) >= 0.0) {
-        e2_l1 = e2x1_(m,k-1,j,i) - e2cc_(m,k-1,j,i-1);
-      } else {
-        e2_l1 = e2x1_(m,k  ,j,i) - e2cc_(m,k  ,j,i-1);
-      }
-      if (flx3(m,IDN,k,j,i) >= 0.0) {
-        e2_r1 = e2x1_(m,k-1,j,i) - e2cc_(m,k-1,j,i  );
-      } else {
-        e2_r1 = e2x1_(m,k  ,j,i) - e2cc_(m,k  ,j,i  );
-      }
-      e2(m,k,j,i) = 0.25*(e2_l3 + e2_r3 + e2_l1 + e2_r1 +
-                e2x3_(m,k,j,i-1) + e2x3_(m,k,j,i) + e2x1_(m,k-1,j,i) + e2x1_(m,k,j,i));
-
-      // integrate E3 to corner using SG07
-      Real e3_l2, e3_r2, e3_l1, e3_r1;
-      if (flx1(m,IDN,k,j-1,i) >= 0.0) {
-        e3_l2 = e3x2_(m,k,j,i-1) - e3cc_(m,k,j-1,i-1);
-      } else {
-        e3_l2 = e3x2_(m,k,j,i  ) - e3cc_(m,k,j-1,i  );
-      }
-      if (flx1(m,IDN,k,j,i) >= 0.0) {
-        e3_r2 = e3x2_(m,k,j,i-1) - e3cc_(m,k,j  ,i-1);
-      } else {
-        e3_r2 = e3x2_(m,k,j,i  ) - e3cc_(m,k,j  ,i  );
-      }
-      if (flx2(m,IDN,k,j,i-1) >= 0.0) {
-        e3_l1 = e3x1_(m,k,j-1,i) - e3cc_(m,k,j-1,i-1);
-      } else {
-        e3_l1 = e3x1_(m,k,j  ,i) - e3cc_(m,k,j  ,i-1);
-      }
-      if (flx2(m,IDN,k,j,i) >= 0.0) {
-        e3_r1 = e3x1_(m,k,j-1,i) - e3cc_(m,k,j-1,i  );
-      } else {
-        e3_r1 = e3x1_(m,k,j  ,i) - e3cc_(m,k,j  ,i  );
-      }
-      e3(m,k,j,i) = 0.25*(e3_l1 + e3_r1 + e3_l2 + e3_r2 +
-                e3x2_(m,k,j,i-1) + e3x2_(m,k,j,i) + e3x1_(m,k,j-1,i) + e3x1_(m,k,j,i));
-    });
+    if (fused_ecc) {
+      par_for("emf3_fused", DevExeSpace(), 0, nmb1, ks, ke+1, js, je+1, is, ie+1,
+      KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+        // cell-centered E1=VzBy-VyBz, E2=VxBz-VzBx, E3=VyBx-VxBy
+        auto e1cc = [&](const int kk, const int jj, const int ii) {
+          return w0_(m,IVZ,kk,jj,ii)*bcc_(m,IBY,kk,jj,ii) -
+                 w0_(m,IVY,kk,jj,ii)*bcc_(m,IBZ,kk,jj,ii);
+        };
+        auto e2cc = [&](const int kk, const int jj, const int ii) {
+          return w0_(m,IVX,kk,jj,ii)*bcc_(m,IBZ,kk,jj,ii) -
+                 w0_(m,IVZ,kk,jj,ii)*bcc_(m,IBX,kk,jj,ii);
+        };
+        auto e3cc = [&](const int kk, const int jj, const int ii) {
+          return w0_(m,IVY,kk,jj,ii)*bcc_(m,IBX,kk,jj,ii) -
+                 w0_(m,IVX,kk,jj,ii)*bcc_(m,IBY,kk,jj,ii);
+        };
+
+        // integrate E1 to corner using SG07
+        Real e1_l3, e1_r3, e1_l2, e1_r2;
+        if (flx2(m,IDN,k-1,j,i) >= 0.0) {
+          e1_l3 = e1x3_(m,k,j-1,i) - e1cc(k-1,j-1,i);
+        } else {
+          e1_l3 = e1x3_(m,k,j  ,i) - e1cc(k-1,j  ,i);
+        }
+        if (flx2(m,IDN,k,j,i) >= 0.0) {
+          e1_r3 = e1x3_(m,k,j-1,i) - e1cc(k  ,j-1,i);
+        } else {
+          e1_r3 = e1x3_(m,k,j  ,i) - e1cc(k  ,j  ,i);
+        }
+        if (flx3(m,IDN,k,j-1,i) >= 0.0) {
+          e1_l2 = e1x2_(m,k-1,j,i) - e1cc(k-1,j-1,i);
+        } else {
+          e1_l2 = e1x2_(m,k  ,j,i) - e1cc(k  ,j-1,i);
+        }
+        if (flx3(m,IDN,k,j,i) >= 0.0) {
+          e1_r2 = e1x2_(m,k-1,j,i) - e1cc(k-1,j  ,i);
+        } else {
+          e1_r2 = e1x2_(m,k  ,j,i) - e1cc(k  ,j  ,i);
+        }
+        e1(m,k,j,i) = 0.25*(e1_l3 + e1_r3 + e1_l2 + e1_r2 +
+                  e1x2_(m,k-1,j,i) + e1x2_(m,k,j,i) + e1x3_(m,k,j-1,i) + e1x3_(m,k,j,i));
+
+        // integrate E2 to corner using SG07
+        Real e2_l3, e2_r3, e2_l1, e2_r1;
+        if (flx1(m,IDN,k-1,j,i) >= 0.0) {
+          e2_l3 = e2x3_(m,k,j,i-1) - e2cc(k-1,j,i-1);
+        } else {
+          e2_l3 = e2x3_(m,k,j,i  ) - e2cc(k-1,j,i  );
+        }
+        if (flx1(m,IDN,k,j,i) >= 0.0) {
+          e2_r3 = e2x3_(m,k,j,i-1) - e2cc(k  ,j,i-1);
+        } else {
+          e2_r3 = e2x3_(m,k,j,i  ) - e2cc(k  ,j,i  );
+        }
+        if (flx3(m,IDN,k,j,i-1) >= 0.0) {
+          e2_l1 = e2x1_(m,k-1,j,i) - e2cc(k-1,j,i-1);
+        } else {
+          e2_l1 = e2x1_(m,k  ,j,i) - e2cc(k  ,j,i-1);
+        }
+        if (flx3(m,IDN,k,j,i) >= 0.0) {
+          e2_r1 = e2x1_(m,k-1,j,i) - e2cc(k-1,j,i  );
+        } else {
+          e2_r1 = e2x1_(m,k  ,j,i) - e2cc(k  ,j,i  );
+        }
+        e2(m,k,j,i) = 0.25*(e2_l3 + e2_r3 + e2_l1 + e2_r1 +
+                  e2x3_(m,k,j,i-1) + e2x3_(m,k,j,i) + e2x1_(m,k-1,j,i) + e2x1_(m,k,j,i));
+
+        // integrate E3 to corner using SG07
+        Real e3_l2, e3_r2, e3_l1, e3_r1;
+        if (flx1(m,IDN,k,j-1,i) >= 0.0) {
+          e3_l2 = e3x2_(m,k,j,i-1) - e3cc(k,j-1,i-1);
+        } else {
+          e3_l2 = e3x2_(m,k,j,i  ) - e3cc(k,j-1,i  );
+        }
+        if (flx1(m,IDN,k,j,i) >= 0.0) {
+          e3_r2 = e3x2_(m,k,j,i-1) - e3cc(k,j  ,i-1);
+        } else {
+          e3_r2 = e3x2_(m,k,j,i  ) - e3cc(k,j  ,i  );
+        }
+        if (flx2(m,IDN,k,j,i-1) >= 0.0) {
+          e3_l1 = e3x1_(m,k,j-1,i) - e3cc(k,j-1,i-1);
+        } else {
+          e3_l1 = e3x1_(m,k,j  ,i) - e3cc(k,j  ,i-1);
+        }
+        if (flx2(m,IDN,k,j,i) >= 0.0) {
+          e3_r1 = e3x1_(m,k,j-1,i) - e3cc(k,j-1,i  );
+        } else {
+          e3_r1 = e3x1_(m,k,j  ,i) - e3cc(k,j  ,i  );
+        }
+        e3(m,k,j,i) = 0.25*(e3_l1 + e3_r1 + e3_l2 + e3_r2 +
+                  e3x2_(m,k,j,i-1) + e3x2_(m,k,j,i) + e3x1_(m,k,j-1,i) + e3x1_(m,k,j,i));
+      });
+    } else {
+      par_for("emf3", DevExeSpace(), 0, nmb1, ks, ke+1, js, je+1, is, ie+1,
+      KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+        // integrate E1 to corner using SG07
+        Real e1_l3, e1_r3, e1_l2, e1_r2;
+        if (flx2(m,IDN,k-1,j,i) >= 0.0) {
+          e1_l3 = e1x3_(m,k,j-1,i) - e1cc_(m,k-1,j-1,i);
+        } else {
+          e1_l3 = e1x3_(m,k,j  ,i) - e1cc_(m,k-1,j  ,i);
+        }
+        if (flx2(m,IDN,k,j,i) >= 0.0) {
+          e1_r3 = e1x3_(m,k,j-1,i) - e1cc_(m,k  ,j-1,i);
+        } else {
+          e1_r3 = e1x3_(m,k,j  ,i) - e1cc_(m,k  ,j  ,i);
+        }
+        if (flx3(m,IDN,k,j-1,i) >= 0.0) {
+          e1_l2 = e1x2_(m,k-1,j,i) - e1cc_(m,k-1,j-1,i);
+        } else {
+          e1_l2 = e1x2_(m,k  ,j,i) - e1cc_(m,k  ,j-1,i);
+        }
+        if (flx3(m,IDN,k,j,i) >= 0.0) {
+          e1_r2 = e1x2_(m,k-1,j,i) - e1cc_(m,k-1,j  ,i);
+        } else {
+          e1_r2 = e1x2_(m,k  ,j,i) - e1cc_(m,k  ,j  ,i);
+        }
+        e1(m,k,j,i) = 0.25*(e1_l3 + e1_r3 + e1_l2 + e1_r2 +
+                  e1x2_(m,k-1,j,i) + e1x2_(m,k,j,i) + e1x3_(m,k,j-1,i) + e1x3_(m,k,j,i));
+
+        // integrate E2 to corner using SG07
+        Real e2_l3, e2_r3, e2_l1, e2_r1;
+        if (flx1(m,IDN,k-1,j,i) >= 0.0) {
+          e2_l3 = e2x3_(m,k,j,i-1) - e2cc_(m,k-1,j,i-1);
+        } else {
+          e2_l3 = e2x3_(m,k,j,i  ) - e2cc_(m,k-1,j,i  );
+        }
+        if (flx1(m,IDN,k,j,i) >= 0.0) {
+          e2_r3 = e2x3_(m,k,j,i-1) - e2cc_(m,k  ,j,i-1);
+        } else {
+          e2_r3 = e2x3_(m,k,j,i  ) - e2cc_(m,k  ,j,i  );
+        }
+        if (flx3(m,IDN,k,j,i-1) >= 0.0) {
+          e2_l1 = e2x1_(m,k-1,j,i) - e2cc_(m,k-1,j,i-1);
+        } else {
+          e2_l1 = e2x1_(m,k  ,j,i) - e2cc_(m,k  ,j,i-1);
+        }
+        if (flx3(m,IDN,k,j,i) >= 0.0) {
+          e2_r1 = e2x1_(m,k-1,j,i) - e2cc_(m,k-1,j,i  );
+        } else {
+          e2_r1 = e2x1_(m,k  ,j,i) - e2cc_(m,k  ,j,i  );
+        }
+        e2(m,k,j,i) = 0.25*(e2_l3 + e2_r3 + e2_l1 + e2_r1 +
+                  e2x3_(m,k,j,i-1) + e2x3_(m,k,j,i) + e2x1_(m,k-1,j,i) + e2x1_(m,k,j,i));
+
+        // integrate E3 to corner using SG07
+        Real e3_l2, e3_r2, e3_l1, e3_r1;
+        if (flx1(m,IDN,k,j-1,i) >= 0.0) {
+          e3_l2 = e3x2_(m,k,j,i-1) - e3cc_(m,k,j-1,i-1);
+        } else {
+          e3_l2 = e3x2_(m,k,j,i  ) - e3cc_(m,k,j-1,i  );
+        }
+        if (flx1(m,IDN,k,j,i) >= 0.0) {
+          e3_r2 = e3x2_(m,k,j,i-1) - e3cc_(m,k,j  ,i-1);
+        } else {
+          e3_r2 = e3x2_(m,k,j,i  ) - e3cc_(m,k,j  ,i  );
+        }
+        if (flx2(m,IDN,k,j,i-1) >= 0.0) {
+          e3_l1 = e3x1_(m,k,j-1,i) - e3cc_(m,k,j-1,i-1);
+        } else {
+          e3_l1 = e3x1_(m,k,j  ,i) - e3cc_(m,k,j  ,i-1);
+        }
+        if (flx2(m,IDN,k,j,i) >= 0.0) {
+          e3_r1 = e3x1_(m,k,j-1,i) - e3cc_(m,k,j-1,i  );
+        } else {
+          e3_r1 = e3x1_(m,k,j  ,i) - e3cc_(m,k,j  ,i  );
+        }
+        e3(m,k,j,i) = 0.25*(e3_l1 + e3_r1 + e3_l2 + e3_r2 +
+                  e3x2_(m,k,j,i-1) + e3x2_(m,k,j,i) + e3x1_(m,k,j-1,i) + e3x1_(m,k,j,i));
+      });
+    }
   }
 
   // Add resistive electric field (if needed)
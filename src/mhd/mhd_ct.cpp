@@ -21,6 +21,23 @@ namespace mhd {
 //  Temporal update uses multi-step SSP integrators, e.g. RK2, RK3
 
 TaskStatus MHD::CT(Driver *pdriver, int stage) {
+  if (pmy_pack->pmesh->three_d) {
+    CTUpdate<3>(pdriver, stage);
+  } else if (pmy_pack->pmesh->multi_d) {
+    CTUpdate<2>(pdriver, stage);
+  } else {
+    CTUpdate<1>(pdriver, stage);
+  }
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MHD::CTUpdate
+//  \brief Update of face-centered fields in CT, templated over the number of dimensions
+//  so that 1D and 2D runs compile without the curl terms of the missing directions.
+
+template <int ndim_>
+void MHD::CTUpdate(Driver *pdriver, int stage) {
   auto &indcs = pmy_pack->pmesh->mb_indcs;
   int is = indcs.is, ie = indcs.ie;
   int js = indcs.js, je = indcs.je;
@@ -30,52 +47,55 @@ TaskStatus MHD::CT(Driver *pdriver, int stage) {
   // capture class variables for the kernels
   Real &gam0 = pdriver->gam0[stage-1];
   Real &gam1 = pdriver->gam1[stage-1];
-  Real beta_dt = (pdriver->beta[stage-1])*(pmy_pack->pmesh->dt);
-  bool &multi_d = pmy_pack->pmesh->multi_d;
-  bool &three_d = pmy_pack->pmesh->three_d;
+  Real beta_dt = (pdriver->beta[stage-1])*FluidDt();
   auto e1 = efld.x1e;
   auto e2 = efld.x2e;
   auto e3 = efld.x3e;
   auto &mbsize = pmy_pack->pmb->mb_size;
 
-  //---- update B1 (only for 2D/3D problems)
-  if (multi_d) {
-    auto bx1f = b0.x1f;
-    auto bx1f_old = b1.x1f;
-    par_for("CT-b1", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie+1,
-    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+  auto bx1f = b0.x1f;
+  auto bx2f = b0.x2f;
+  auto bx3f = b0.x3f;
+  auto bx1f_old = b1.x1f;
+  auto bx2f_old = b1.x2f;
+  auto bx3f_old = b1.x3f;
+
+  // All three face-centered fields are updated in a single kernel over the union of the
+  // index ranges of the x1-, x2-, and x3-faces, so that each edge E is loaded once.
+  par_for("CT", DevExeSpace(), 0, nmb1, ks, ke+1, js, je+1, is, ie+1,
+  KOKKOS_LAMBDA(int m, int k, int j, int i) {
+    //---- update B1 (only for 2D/3D problems)
+    if (ndim_ > 1 && (k <= ke) && (j <= je)) {
       bx1f(m,k,j,i) = gam0*bx1f(m,k,j,i) + gam1*bx1f_old(m,k,j,i);
       bx1f(m,k,j,i) -= beta_dt*(e3(m,k,j+1,i) - e3(m,k,j,i))/mbsize.d_view(m).dx2;
-      if (three_d) {
+      if constexpr (ndim_ > 2) {
         bx1f(m,k,j,i) += beta_dt*(e2(m,k+1,j,i) - e2(m,k,j,i))/mbsize.d_view(m).dx3;
       }
-    });
-  }
+    }
 
-  //---- update B2 (curl terms in 1D and 3D problems)
-  auto bx2f = b0.x2f;
-  auto bx2f_old = b1.x2f;
-  par_for("CT-b2", DevExeSpace(), 0, nmb1, ks, ke, js, je+1, is, ie,
-  KOKKOS_LAMBDA(int m, int k, int j, int i) {
-    bx2f(m,k,j,i) = gam0*bx2f(m,k,j,i) + gam1*bx2f_old(m,k,j,i);
-    bx2f(m,k,j,i) += beta_dt*(e3(m,k,j,i+1) - e3(m,k,j,i))/mbsize.d_view(m).dx1;
-    if (three_d) {
-      bx2f(m,k,j,i) -= beta_dt*(e1(m,k+1,j,i) - e1(m,k,j,i))/mbsize.d_view(m).dx3;
+    //---- update B2 (curl terms in 1D and 3D problems)
+    if ((k <= ke) && (i <= ie)) {
+      bx2f(m,k,j,i) = gam0*bx2f(m,k,j,i) + gam1*bx2f_old(m,k,j,i);
+      bx2f(m,k,j,i) += beta_dt*(e3(m,k,j,i+1) - e3(m,k,j,i))/mbsize.d_view(m).dx1;
+      if constexpr (ndim_ > 2) {
+        bx2f(m,k,j,i) -= beta_dt*(e1(m,k+1,j,i) - e1(m,k,j,i))/mbsize.d_view(m).dx3;
+      }
     }
-  });
 
-  //---- update B3 (curl terms in 1D and 2D/3D problems)
-  auto bx3f = b0.x3f;
-  auto bx3f_old = b1.x3f;
-  par_for("CT-b3", DevExeSpace(), 0, nmb1, ks, ke+1, js, je, is, ie,
-  KOKKOS_LAMBDA(int m, int k, int j, int i) {
-    bx3f(m,k,j,i) = gam0*bx3f(m,k,j,i) + gam1*bx3f_old(m,k,j,i);
-    bx3f(m,k,j,i) -= beta_dt*(e2(m,k,j,i+1) - e2(m,k,j,i))/mbsize.d_view(m).dx1;
-    if (multi_d) {
-      bx3f(m,k,j,i) += beta_dt*(e1(m,k,j+1,i) - e1(m,k,j,i))/mbsize.d_view(m).dx2;
+    //---- update B3 (curl terms in 1D and 2D/3D problems)
+    if ((j <= je) && (i <= ie)) {
+      bx3f(m,k,j,i) = gam0*bx3f(m,k,j,i) + gam1*bx3f_old(m,k,j,i);
+      bx3f(m,k,j,i) -= beta_dt*(e2(m,k,j,i+1) - e2(m,k,j,i))/mbsize.d_view(m).dx1;
+      if constexpr (ndim_ > 1) {
+        bx3f(m,k,j,i) += beta_dt*(e1(m,k,j+1,i) - e1(m,k,j,i))/mbsize.d_view(m).dx2;
+      }
     }
   });
 
-  return TaskStatus::complete;
+  return;
 }
+
+template void MHD::CTUpdate<1>(Driver *pdriver, int stage);
+template void MHD::CTUpdate<2>(Driver *pdriver, int stage);
+template void MHD::CTUpdate<3>(Driver *pdriver, int stage);
 } // namespace mhd
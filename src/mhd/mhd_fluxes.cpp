@@ -19,6 +19,8 @@
 #include "reconstruct/plm.hpp"
 #include "reconstruct/ppm.hpp"
 #include "reconstruct/wenoz.hpp"
+#include "reconstruct/scratch_window.hpp"
+#include "reconstruct/jump_indicator.hpp"
 #include "mhd/rsolvers/advect_mhd.hpp"
 #include "mhd/rsolvers/llf_mhd.hpp"
 #include "mhd/rsolvers/hlle_mhd.hpp"
@@ -30,6 +32,110 @@
 // #include "mhd/rsolvers/roe_mhd.hpp"
 
 namespace mhd {
+//----------------------------------------------------------------------------------------
+//! \fn void ReconstructX2
+//! \brief Reconstructs W and Bcc in x2-direction to compute qL[j+1] and qR[j].  Input
+//! arrays are either the global arrays, or ScrWindows of their rows in scratch memory.
+//! Only the first nrec components of W are reconstructed with method recon, the rest
+//! (diagnostic scalars) with donor cell.
+
+template <typename QArray>
+KOKKOS_INLINE_FUNCTION
+void ReconstructX2(TeamMember_t const &member, const ReconstructionMethod recon,
+     const EOS_Data &eos, const bool extrema, const int m, const int k, const int j,
+     const int il, const int iu, const QArray &w, const QArray &b,
+     ScrArray2D<Real> &wl_jp1, ScrArray2D<Real> &wr,
+     ScrArray2D<Real> &bl_jp1, ScrArray2D<Real> &br, const int nrec) {
+  switch (recon) {
+    case ReconstructionMethod::dc:
+      DonorCellX2(member, m, k, j, il, iu, w, wl_jp1, wr);
+      DonorCellX2(member, m, k, j, il, iu, b, bl_jp1, br);
+      break;
+    case ReconstructionMethod::plm:
+      PiecewiseLinearX2(member, m, k, j, il, iu, w, wl_jp1, wr, 0, nrec-1);
+      PiecewiseLinearX2(member, m, k, j, il, iu, b, bl_jp1, br);
+      break;
+    case ReconstructionMethod::ppm4:
+    case ReconstructionMethod::ppmx:
+      PiecewiseParabolicX2(member, eos, extrema, true,  m, k, j, il, iu, w, wl_jp1, wr,
+                           0, nrec-1);
+      PiecewiseParabolicX2(member, eos, extrema, false, m, k, j, il, iu, b, bl_jp1, br);
+      break;
+    case ReconstructionMethod::wenoz:
+      WENOZX2(member, eos, true,  m, k, j, il, iu, w, wl_jp1, wr, 0, nrec-1);
+      WENOZX2(member, eos, false, m, k, j, il, iu, b, bl_jp1, br);
+      break;
+    default:
+      break;
+  }
+  // diagnostic scalars (if any) are reconstructed with donor cell
+  if (nrec < w.extent_int(1) && recon != ReconstructionMethod::dc) {
+    DonorCellX2(member, m, k, j, il, iu, w, wl_jp1, wr, nrec);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ReconstructX3
+//! \brief Reconstructs W and Bcc in x3-direction to compute qL[k+1] and qR[k].  Input
+//! arrays are either the global arrays, or ScrWindows of their rows in scratch memory.
+//! W is reconstructed as in ReconstructX2().
+
+template <typename QArray>
+KOKKOS_INLINE_FUNCTION
+void ReconstructX3(TeamMember_t const &member, const ReconstructionMethod recon,
+     const EOS_Data &eos, const bool extrema, const int m, const int k, const int j,
+     const int il, const int iu, const QArray &w, const QArray &b,
+     ScrArray2D<Real> &wl_kp1, ScrArray2D<Real> &wr,
+     ScrArray2D<Real> &bl_kp1, ScrArray2D<Real> &br, const int nrec) {
+  switch (recon) {
+    case ReconstructionMethod::dc:
+      DonorCellX3(member, m, k, j, il, iu, w, wl_kp1, wr);
+      DonorCellX3(member, m, k, j, il, iu, b, bl_kp1, br);
+      break;
+    case ReconstructionMethod::plm:
+      PiecewiseLinearX3(member, m, k, j, il, iu, w, wl_kp1, wr, 0, nrec-1);
+      PiecewiseLinearX3(member, m, k, j, il, iu, b, bl_kp1, br);
+      break;
+    case ReconstructionMethod::ppm4:
+    case ReconstructionMethod::ppmx:
+      PiecewiseParabolicX3(member, eos, extrema, true,  m, k, j, il, iu, w, wl_kp1, wr,
+                           0, nrec-1);
+      PiecewiseParabolicX3(member, eos, extrema, false, m, k, j, il, iu, b, bl_kp1, br);
+      break;
+    case ReconstructionMethod::wenoz:
+      WENOZX3(member, eos, true,  m, k, j, il, iu, w, wl_kp1, wr, 0, nrec-1);
+      WENOZX3(member, eos, false, m, k, j, il, iu, b, bl_kp1, br);
+      break;
+    default:
+      break;
+  }
+  // diagnostic scalars (if any) are reconstructed with donor cell
+  if (nrec < w.extent_int(1) && recon != ReconstructionMethod::dc) {
+    DonorCellX3(member, m, k, j, il, iu, w, wl_kp1, wr, nrec);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn double RSolverFlops()
+//! \brief Rough number of FLOPs of each Riemann solver per face (including electric
+//! fields), used only in estimates passed to KernelCounters (<time>/roofline)
+
+static double RSolverFlops(MHD_RSolver rsolver) {
+  switch (rsolver) {
+    case MHD_RSolver::advect:  return 20.0;
+    case MHD_RSolver::llf:     return 100.0;
+    case MHD_RSolver::hlle:    return 150.0;
+    case MHD_RSolver::hlld:    return 300.0;
+    case MHD_RSolver::llf_sr:  return 250.0;
+    case MHD_RSolver::hlle_sr: return 300.0;
+    case MHD_RSolver::llf_gr:  return 500.0;
+    case MHD_RSolver::hlle_gr: return 600.0;
+    default: return 0.0;
+  }
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void MHD::CalculateFlux
 //! \brief Calculate fluxes of conserved variables, and face-centered area-averaged EMFs
@@ -39,13 +145,19 @@ namespace mhd {
 template <MHD_RSolver rsolver_method_>
 void MHD::CalculateFluxes(Driver *pdriver, int stage) {
   RegionIndcs &indcs_ = pmy_pack->pmesh->mb_indcs;
+#if FIXED_MB_NX1 > 0
+  constexpr int is = FIXED_MB_IS, ie = FIXED_MB_IE;
+  constexpr int ncells1 = ScrRowLength(FIXED_MB_NCELLS1);
+#else
   int is = indcs_.is, ie = indcs_.ie;
+  int ncells1 = ScrRowLength(indcs_.nx1 + 2*(indcs_.ng));
+#endif
   int js = indcs_.js, je = indcs_.je;
   int ks = indcs_.ks, ke = indcs_.ke;
-  int ncells1 = indcs_.nx1 + 2*(indcs_.ng);
 
   int &nmhd_ = nmhd;
   int nvars = nmhd + nscalars;
+  int nrec = nvars - ndiag_scalars;  // variables reconstructed with recon_method
   int nmb1 = pmy_pack->nmb_thispack - 1;
   const auto recon_method_ = recon_method;
   bool extrema = false;
@@ -59,6 +171,33 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
   auto &w0_ = w0;
   auto &b0_ = bcc0;
 
+  // with <mhd>/scratch_window, rows of w0 and bcc0 are staged once in scratch memory in
+  // the x2/x3 sweeps, and reused by all reconstructions whose stencil includes them
+  const bool window_ = scratch_window;
+  const int ns = ScrWindowHalfWidth(recon_method);
+  const int nrow = 2*ns + 1;
+  size_t win_size = 0;
+  if (window_) {
+    win_size = ScrArray3D<Real>::shmem_size(nvars, nrow, ncells1) +
+               ScrArray3D<Real>::shmem_size(3, nrow, ncells1);
+  }
+
+  // with rsolver_hybrid, rows of faces without discontinuities use HLLE instead of the
+  // HLLD solver, and rows are counted by the solver used.  Counts accumulate on the
+  // device, and are only copied to the host when the event log is written.
+  constexpr bool hybrid_rs = (rsolver_method_ == MHD_RSolver::hlld);
+  bool hybrid_ = rsolver_hybrid;
+  Real hybrid_tol_ = rsolver_hybrid_tol;
+  auto &nrow_ = rs_nrow;
+
+  // static estimates per face for roofline counters, assuming W, Bcc and face-centered B
+  // are read and fluxes and two electric fields are written once
+  KernelCounters &kc = pmy_pack->pmesh->kcounter;
+  double face_bytes = (2.0*nvars + 6.0)*sizeof(Real);
+  double face_flops = (nrec + 3)*ReconstructionFlops(recon_method) +
+                      (nvars - nrec)*ReconstructionFlops(ReconstructionMethod::dc) +
+                      RSolverFlops(rsolver_method_);
+
   //--------------------------------------------------------------------------------------
   // i-direction
 
@@ -82,6 +221,8 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
   int il = is, iu = ie+1;
   if (use_fofc) { il = is-1, iu = ie+2; }
 
+  kc.Start("mhd_flux1", static_cast<double>(nmb1+1)*(ku-kl+1)*(ju-jl+1)*(iu-il+1),
+           face_bytes, face_flops);
   par_for_outer("mhd_flux1",DevExeSpace(), scr_size, scr_level, 0, nmb1, kl, ku, jl, ju,
   KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
     ScrArray2D<Real> wl(member.team_scratch(scr_level), nvars, ncells1);
@@ -96,21 +237,26 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
         DonorCellX1(member, m, k, j, il-1, iu, b0_, bl, br);
         break;
       case ReconstructionMethod::plm:
-        PiecewiseLinearX1(member, m, k, j, il-1, iu, w0_, wl, wr);
+        PiecewiseLinearX1(member, m, k, j, il-1, iu, w0_, wl, wr, 0, nrec-1);
         PiecewiseLinearX1(member, m, k, j, il-1, iu, b0_, bl, br);
         break;
       case ReconstructionMethod::ppm4:
       case ReconstructionMethod::ppmx:
-        PiecewiseParabolicX1(member,eos_,extrema,true,  m, k, j, il-1, iu, w0_, wl, wr);
+        PiecewiseParabolicX1(member,eos_,extrema,true,  m, k, j, il-1, iu, w0_, wl, wr,
+                             0, nrec-1);
         PiecewiseParabolicX1(member,eos_,extrema,false, m, k, j, il-1, iu, b0_, bl, br);
         break;
       case ReconstructionMethod::wenoz:
-        WENOZX1(member, eos_, true,  m, k, j, il-1, iu, w0_, wl, wr);
+        WENOZX1(member, eos_, true,  m, k, j, il-1, iu, w0_, wl, wr, 0, nrec-1);
         WENOZX1(member, eos_, false, m, k, j, il-1, iu, b0_, bl, br);
         break;
       default:
         break;
     }
+    // diagnostic scalars (if any) are reconstructed with donor cell
+    if (nrec < nvars && recon_method_ != ReconstructionMethod::dc) {
+      DonorCellX1(member, m, k, j, il-1, iu, w0_, wl, wr, nrec);
+    }
     // Sync all threads in the team so that scratch memory is consistent
     member.team_barrier();
 
@@ -126,7 +272,13 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
     auto flx1 = flx1_;
     auto e31 = e31_;
     auto e21 = e21_;
-    if constexpr (rsolver_method_ == MHD_RSolver::advect) {
+    bool smooth = false;
+    if constexpr (hybrid_rs) {
+      if (hybrid_) {smooth = SmoothRow(member,eos,il,iu,wl,wr,bl,br,hybrid_tol_,nrow_);}
+    }
+    if (smooth) {
+      HLLE(member,eos,indcs,size,coord,m,k,j,il,iu,IVX,wl,wr,bl,br,bx,flx1,e31,e21);
+    } else if constexpr (rsolver_method_ == MHD_RSolver::advect) {
       Advect(member,eos,indcs,size,coord,m,k,j,il,iu,IVX,wl,wr,bl,br,bx,flx1,e31,e21);
     } else if constexpr (rsolver_method_ == MHD_RSolver::llf) {
       LLF(member,eos,indcs,size,coord,m,k,j,il,iu,IVX,wl,wr,bl,br,bx,flx1,e31,e21);
@@ -158,13 +310,14 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
       }
     }
   });
+  kc.Stop();
 
   //--------------------------------------------------------------------------------------
   // j-direction
 
   if (pmy_pack->pmesh->multi_d) {
     scr_size = (ScrArray2D<Real>::shmem_size(nvars, ncells1) +
-                ScrArray2D<Real>::shmem_size(3, ncells1)) * 3;
+                ScrArray2D<Real>::shmem_size(3, ncells1)) * 3 + win_size;
     auto &flx2_ = uflx.x2f;
     auto &by_ = b0.x2f;
     auto &e12_ = e1x2;
@@ -179,6 +332,8 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
     jl = js-1, ju = je+1;
     if (use_fofc) { jl = js-2, ju = je+2; }
 
+    kc.Start("mhd_flux2", static_cast<double>(nmb1+1)*(ku-kl+1)*(ju-jl)*(ie-is+3),
+             face_bytes, face_flops);
     par_for_outer("mhd_flux2",DevExeSpace(),scr_size,scr_level,0,nmb1, kl, ku,
     KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k) {
       ScrArray2D<Real> scr1(member.team_scratch(scr_level), nvars, ncells1);
@@ -187,6 +342,18 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
       ScrArray2D<Real> scr4(member.team_scratch(scr_level), 3, ncells1);
       ScrArray2D<Real> scr5(member.team_scratch(scr_level), 3, ncells1);
       ScrArray2D<Real> scr6(member.team_scratch(scr_level), 3, ncells1);
+      ScrWindow<2> wwin, bwin;
+      if (window_) {
+        wwin.buf = ScrArray3D<Real>(member.team_scratch(scr_level), nvars, nrow, ncells1);
+        bwin.buf = ScrArray3D<Real>(member.team_scratch(scr_level), 3, nrow, ncells1);
+        wwin.nrow = nrow;
+        bwin.nrow = nrow;
+        // load all but last row of stencil of first reconstruction
+        for (int jj=jl-ns; jj<jl+ns; ++jj) {
+          LoadScrWindowRow(member, m, k, jj, is-1, ie+1, w0_, wwin);
+          LoadScrWindowRow(member, m, k, jj, is-1, ie+1, b0_, bwin);
+        }
+      }
 
       for (int j=jl; j<=ju; ++j) {
         // Permute scratch arrays.
@@ -204,26 +371,16 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
         }
 
         // Reconstruct qR[j] and qL[j+1], for both W and Bcc
-        switch (recon_method_) {
-          case ReconstructionMethod::dc:
-            DonorCellX2(member, m, k, j, is-1, ie+1, w0_, wl_jp1, wr);
-            DonorCellX2(member, m, k, j, is-1, ie+1, b0_, bl_jp1, br);
-            break;
-          case ReconstructionMethod::plm:
-            PiecewiseLinearX2(member, m, k, j, is-1, ie+1, w0_, wl_jp1, wr);
-            PiecewiseLinearX2(member, m, k, j, is-1, ie+1, b0_, bl_jp1, br);
-            break;
-          case ReconstructionMethod::ppm4:
-          case ReconstructionMethod::ppmx:
-            PiecewiseParabolicX2(member,eos_,extrema,true, m,k,j,is-1,ie+1,w0_,wl_jp1,wr);
-            PiecewiseParabolicX2(member,eos_,extrema,false,m,k,j,is-1,ie+1,b0_,bl_jp1,br);
-            break;
-          case ReconstructionMethod::wenoz:
-            WENOZX2(member, eos_, true,  m, k, j, is-1, ie+1, w0_, wl_jp1, wr);
-            WENOZX2(member, eos_, false, m, k, j, is-1, ie+1, b0_, bl_jp1, br);
-            break;
-          default:
-            break;
+        if (window_) {
+          // load last row of stencil, replacing row no longer needed
+          LoadScrWindowRow(member, m, k, j+ns, is-1, ie+1, w0_, wwin);
+          LoadScrWindowRow(member, m, k, j+ns, is-1, ie+1, b0_, bwin);
+          member.team_barrier();
+          ReconstructX2(member, recon_method_, eos_, extrema, m, k, j, is-1, ie+1,
+                        wwin, bwin, wl_jp1, wr, bl_jp1, br, nrec);
+        } else {
+          ReconstructX2(member, recon_method_, eos_, extrema, m, k, j, is-1, ie+1,
+                        w0_, b0_, wl_jp1, wr, bl_jp1, br, nrec);
         }
         member.team_barrier();
 
@@ -240,7 +397,15 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
           auto flx2 = flx2_;
           auto e12 = e12_;
           auto e32 = e32_;
-          if constexpr (rsolver_method_ == MHD_RSolver::advect) {
+          bool smooth = false;
+          if constexpr (hybrid_rs) {
+            if (hybrid_) {smooth = SmoothRow(member, eos, is-1, ie+1, wl, wr, bl, br,
+                                             hybrid_tol_, nrow_);}
+          }
+          if (smooth) {
+            HLLE(member,eos,indcs,size,coord,
+                    m,k,j,is-1,ie+1,IVY,wl,wr,bl,br,by,flx2,e12,e32);
+          } else if constexpr (rsolver_method_ == MHD_RSolver::advect) {
             Advect(member,eos,indcs,size,coord,
                     m,k,j,is-1,ie+1,IVY,wl,wr,bl,br,by,flx2,e12,e32);
           } else if constexpr (rsolver_method_ == MHD_RSolver::llf) {
@@ -282,6 +447,7 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
         }
       } // end of loop over j
     });
+    kc.Stop();
   }
 
   //--------------------------------------------------------------------------------------
@@ -289,7 +455,7 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
 
   if (pmy_pack->pmesh->three_d) {
     scr_size = (ScrArray2D<Real>::shmem_size(nvars, ncells1) +
-                ScrArray2D<Real>::shmem_size(3, ncells1)) * 3;
+                ScrArray2D<Real>::shmem_size(3, ncells1)) * 3 + win_size;
     auto &flx3_ = uflx.x3f;
     auto &bz_ = b0.x3f;
     auto &e23_ = e2x3;
@@ -299,6 +465,8 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
     kl = ks-1, ku = ke+1;
     if (use_fofc) { kl = ks-2, ku = ke+2; }
 
+    kc.Start("mhd_flux3", static_cast<double>(nmb1+1)*(ku-kl)*(je-js+3)*(ie-is+3),
+             face_bytes, face_flops);
     par_for_outer("mhd_flux3",DevExeSpace(), scr_size, scr_level, 0, nmb1, js-1, je+1,
     KOKKOS_LAMBDA(TeamMember_t member, const int m, const int j) {
       ScrArray2D<Real> scr1(member.team_scratch(scr_level), nvars, ncells1);
@@ -307,6 +475,18 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
       ScrArray2D<Real> scr4(member.team_scratch(scr_level), 3, ncells1);
       ScrArray2D<Real> scr5(member.team_scratch(scr_level), 3, ncells1);
       ScrArray2D<Real> scr6(member.team_scratch(scr_level), 3, ncells1);
+      ScrWindow<3> wwin, bwin;
+      if (window_) {
+        wwin.buf = ScrArray3D<Real>(member.team_scratch(scr_level), nvars, nrow, ncells1);
+        bwin.buf = ScrArray3D<Real>(member.team_scratch(scr_level), 3, nrow, ncells1);
+        wwin.nrow = nrow;
+        bwin.nrow = nrow;
+        // load all but last row of stencil of first reconstruction
+        for (int kk=kl-ns; kk<kl+ns; ++kk) {
+          LoadScrWindowRow(member, m, kk, j, is-1, ie+1, w0_, wwin);
+          LoadScrWindowRow(member, m, kk, j, is-1, ie+1, b0_, bwin);
+        }
+      }
 
       for (int k=kl; k<=ku; ++k) {
         // Permute scratch arrays.
@@ -324,26 +504,16 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
         }
 
         // Reconstruct qR[k] and qL[k+1], for both W and Bcc
-        switch (recon_method_) {
-          case ReconstructionMethod::dc:
-            DonorCellX3(member, m, k, j, is-1, ie+1, w0_, wl_kp1, wr);
-            DonorCellX3(member, m, k, j, is-1, ie+1, b0_, bl_kp1, br);
-            break;
-          case ReconstructionMethod::plm:
-            PiecewiseLinearX3(member, m, k, j, is-1, ie+1, w0_, wl_kp1, wr);
-            PiecewiseLinearX3(member, m, k, j, is-1, ie+1, b0_, bl_kp1, br);
-            break;
-          case ReconstructionMethod::ppm4:
-          case ReconstructionMethod::ppmx:
-            PiecewiseParabolicX3(member,eos_,extrema,true, m,k,j,is-1,ie+1,w0_,wl_kp1,wr);
-            PiecewiseParabolicX3(member,eos_,extrema,false,m,k,j,is-1,ie+1,b0_,bl_kp1,br);
-            break;
-          case ReconstructionMethod::wenoz:
-            WENOZX3(member, eos_, true,  m, k, j, is-1, ie+1, w0_, wl_kp1, wr);
-            WENOZX3(member, eos_, false, m, k, j, is-1, ie+1, b0_, bl_kp1, br);
-            break;
-          default:
-            break;
+        if (window_) {
+          // load last row of stencil, replacing row no longer needed
+          LoadScrWindowRow(member, m, k+ns, j, is-1, ie+1, w0_, wwin);
+          LoadScrWindowRow(member, m, k+ns, j, is-1, ie+1, b0_, bwin);
+          member.team_barrier();
+          ReconstructX3(member, recon_method_, eos_, extrema, m, k, j, is-1, ie+1,
+                        wwin, bwin, wl_kp1, wr, bl_kp1, br, nrec);
+        } else {
+          ReconstructX3(member, recon_method_, eos_, extrema, m, k, j, is-1, ie+1,
+                        w0_, b0_, wl_kp1, wr, bl_kp1, br, nrec);
         }
         member.team_barrier();
 
@@ -360,7 +530,15 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
           auto flx3 = flx3_;
           auto e23 = e23_;
           auto e13 = e13_;
-          if constexpr (rsolver_method_ == MHD_RSolver::advect) {
+          bool smooth = false;
+          if constexpr (hybrid_rs) {
+            if (hybrid_) {smooth = SmoothRow(member, eos, is-1, ie+1, wl, wr, bl, br,
+                                             hybrid_tol_, nrow_);}
+          }
+          if (smooth) {
+            HLLE(member,eos,indcs,size,coord,
+                    m,k,j,is-1,ie+1,IVZ,wl,wr,bl,br,bz,flx3,e23,e13);
+          } else if constexpr (rsolver_method_ == MHD_RSolver::advect) {
             Advect(member,eos,indcs,size,coord,
                     m,k,j,is-1,ie+1,IVZ,wl,wr,bl,br,bz,flx3,e23,e13);
           } else if constexpr (rsolver_method_ == MHD_RSolver::llf) {
@@ -402,6 +580,7 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
         }
       } // end loop over k
     });
+    kc.Stop();
   }
 
   return;
@@ -26,6 +26,9 @@ namespace mhd {
 //! Often this is enough to prevent floors from being needed.  The FOFC infrastructure is
 //! also exploited for BH excision.  If a cell is about the horizon, FOFC is automatically
 //! triggered (without estimating updated conserved variables).
+//!
+//! Since typically only a very small fraction of cells is flagged, the flagged cells are
+//! compacted into a list, and first-order fluxes are only computed for cells in the list.
 
 void MHD::FOFC(Driver *pdriver, int stage) {
   auto &indcs = pmy_pack->pmesh->mb_indcs;
@@ -53,13 +56,20 @@ void MHD::FOFC(Driver *pdriver, int stage) {
   if (use_fofc) {
     Real &gam0 = pdriver->gam0[stage-1];
     Real &gam1 = pdriver->gam1[stage-1];
-    Real beta_dt = (pdriver->beta[stage-1])*(pmy_pack->pmesh->dt);
+    Real beta_dt = (pdriver->beta[stage-1])*FluidDt();
 
     int &nmhd_ = nmhd;
     auto &u0_ = u0;
     auto &u1_ = u1;
-    auto &utest_ = utest;
-    auto &bcctest_ = bcctest;
+    // estimates of updated variables are checked out of the scratch pool
+    int ncells1 = indcs.nx1 + 2*(indcs.ng);
+    int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
+    int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
+    auto &scratch = pmy_pack->pmesh->scratch;
+    auto utest = scratch.Checkout("utest", nmb, nmhd, ncells3, ncells2, ncells1);
+    auto bcctest = scratch.Checkout("bcctest", nmb, 3, ncells3, ncells2, ncells1);
+    auto &utest_ = utest.view;
+    auto &bcctest_ = bcctest.view;
     auto &b1_ = b1;
 
     // Index bounds
@@ -128,10 +138,43 @@ void MHD::FOFC(Driver *pdriver, int stage) {
   if (multi_d) { jl = js-1, ju = je+1; }
   if (three_d) { kl = ks-1, ku = ke+1; }
 
-  // Replace fluxes with first-order LLF fluxes at i,j,k faces for any cell where FOFC
-  // and/or excision is used (if GR+excising)
-  par_for("FOFC-flx", DevExeSpace(), 0, nmb-1, kl, ku, jl, ju, il, iu,
-  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+  // Compact list of cells where FOFC and/or excision is used (if GR+excising).  Cells are
+  // stored as index into (m,k,j,i) range of active cells and first layer of ghost cells.
+  const int ni = iu - il + 1;
+  const int nji = (ju - jl + 1)*ni;
+  const int nkji = (ku - kl + 1)*nji;
+  const int nmkji = nmb*nkji;
+  if (fofc_cells.extent_int(0) < nmkji) {
+    Kokkos::realloc(fofc_cells, nmkji);
+  }
+  auto &cells = fofc_cells;
+  bool excise = (is_gr && use_excise_);
+  int ncells = 0;
+  Kokkos::parallel_scan("FOFC-list", Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
+  KOKKOS_LAMBDA(const int idx, int &partial, const bool final) {
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/ni;
+    int i = (idx - m*nkji - k*nji - j*ni) + il;
+    j += jl;
+    k += kl;
+    if ((use_fofc_ && fofc_(m,k,j,i)) || (excise && excision_flux_(m,k,j,i))) {
+      if (final) {cells(partial) = idx;}
+      partial++;
+    }
+  }, ncells);
+  if (ncells == 0) return;
+
+  // Replace fluxes with first-order LLF fluxes at i,j,k faces for any cell in list
+  par_for("FOFC-flx", DevExeSpace(), 0, ncells-1,
+  KOKKOS_LAMBDA(const int n) {
+    int m = (cells(n))/nkji;
+    int k = (cells(n) - m*nkji)/nji;
+    int j = (cells(n) - m*nkji - k*nji)/ni;
+    int i = (cells(n) - m*nkji - k*nji - j*ni) + il;
+    j += jl;
+    k += kl;
+
     // Check for FOFC flag
     bool fofc_flag = false;
     if (use_fofc_) { fofc_flag = fofc_(m,k,j,i); }
@@ -305,10 +348,16 @@ void MHD::FOFC(Driver *pdriver, int stage) {
     }
   });
 
-  // Replace fluxes with first-order LLF fluxes at i+1,j+1,k+1 faces for any cell where
-  // FOFC and/or excision is used (if GR+excising)
-  par_for("FOFC-flx", DevExeSpace(), 0, nmb-1, kl, ku, jl, ju, il, iu,
-  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+  // Replace fluxes with first-order LLF fluxes at i+1,j+1,k+1 faces for any cell in list
+  par_for("FOFC-flx", DevExeSpace(), 0, ncells-1,
+  KOKKOS_LAMBDA(const int n) {
+    int m = (cells(n))/nkji;
+    int k = (cells(n) - m*nkji)/nji;
+    int j = (cells(n) - m*nkji - k*nji)/ni;
+    int i = (cells(n) - m*nkji - k*nji - j*ni) + il;
+    j += jl;
+    k += kl;
+
     // Check for FOFC flag
     bool fofc_flag = false;
     if (use_fofc_) { fofc_flag = fofc_(m,k,j,i); }
@@ -482,9 +531,16 @@ void MHD::FOFC(Driver *pdriver, int stage) {
     }
   });
 
-  // reset FOFC flag (do not reset excision flag)
+  // reset FOFC flag of cells in list (do not reset excision flag)
   if (use_fofc_) {
-    Kokkos::deep_copy(fofc, false);
+    par_for("FOFC-reset", DevExeSpace(), 0, ncells-1,
+    KOKKOS_LAMBDA(const int n) {
+      int m = (cells(n))/nkji;
+      int k = (cells(n) - m*nkji)/nji;
+      int j = (cells(n) - m*nkji - k*nji)/ni;
+      int i = (cells(n) - m*nkji - k*nji - j*ni) + il;
+      fofc_(m,k+kl,j+jl,i) = false;
+    });
   }
 
   return;
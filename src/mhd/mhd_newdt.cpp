@@ -19,6 +19,7 @@
 #include "mhd.hpp"
 #include "diffusion/conduction.hpp"
 #include "srcterms/srcterms.hpp"
+#include "dyn_grmhd/dyn_grmhd.hpp"
 
 namespace mhd {
 
@@ -157,6 +158,8 @@ TaskStatus MHD::NewTimeStep(Driver *pdriver, int stage) {
   dtnew = dt1;
   if (pmy_pack->pmesh->multi_d) { dtnew = std::min(dtnew, dt2); }
   if (pmy_pack->pmesh->three_d) { dtnew = std::min(dtnew, dt3); }
+  // with multirate evolution, the fluid takes nmultirate steps of the spacetime per step
+  if (pmy_pack->pdyngr != nullptr) { dtnew /= pmy_pack->pdyngr->nmultirate; }
 
   // compute timestep for diffusion
   if (pcond != nullptr) {
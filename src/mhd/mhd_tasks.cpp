@@ -26,6 +26,7 @@
 #include "shearing_box/shearing_box.hpp"
 #include "mhd/mhd.hpp"
 #include "dyn_grmhd/dyn_grmhd.hpp"
+#include "utils/managed_memory.hpp"
 
 namespace mhd {
 //----------------------------------------------------------------------------------------
@@ -57,7 +58,25 @@ void MHD::AssembleMHDTasks(std::map<std::string, std::shared_ptr<TaskList>> tl)
   id.recvu     = tl["stagen"]->AddTask(&MHD::RecvU, this, id.sendu);
   id.sendu_shr = tl["stagen"]->AddTask(&MHD::SendU_Shr, this, id.recvu);
   id.recvu_shr = tl["stagen"]->AddTask(&MHD::RecvU_Shr, this, id.sendu_shr);
-  id.efld      = tl["stagen"]->AddTask(&MHD::CornerE, this, id.recvu_shr);
+  // with fixed_flow B never changes, so E-field, CT and exchange of B are omitted
+  if (fixed_flow) {
+    id.bcs     = tl["stagen"]->AddTask(&MHD::ApplyPhysicalBCs, this, id.recvu_shr);
+    id.c2p     = tl["stagen"]->AddTask(&MHD::ConToPrim, this, id.bcs);
+    id.newdt   = tl["stagen"]->AddTask(&MHD::NewTimeStep, this, id.c2p);
+    for (auto tid : {id.flux, id.rkupdt, id.srctrms, id.c2p}) {
+      tl["stagen"]->SetLBTimed(tid);
+    }
+    id.csend = tl["after_stagen"]->AddTask(&MHD::ClearSend, this, none);
+    id.crecv = tl["after_stagen"]->AddTask(&MHD::ClearRecv, this, id.csend);
+    return;
+  }
+  // CornerE only uses primitives from the start of the stage, so with overlap_comm it
+  // need not wait for RecvU
+  if (overlap_comm) {
+    id.efld    = tl["stagen"]->AddTask(&MHD::CornerE, this, id.sendu);
+  } else {
+    id.efld    = tl["stagen"]->AddTask(&MHD::CornerE, this, id.recvu_shr);
+  }
   id.efldsrc   = tl["stagen"]->AddTask(&MHD::EFieldSrc, this, id.efld);
   id.sende     = tl["stagen"]->AddTask(&MHD::SendE, this, id.efldsrc);
   id.recve     = tl["stagen"]->AddTask(&MHD::RecvE, this, id.sende);
@@ -69,10 +88,26 @@ void MHD::AssembleMHDTasks(std::map<std::string, std::shared_ptr<TaskList>> tl)
   id.recvb     = tl["stagen"]->AddTask(&MHD::RecvB, this, id.sendb);
   id.sendb_shr = tl["stagen"]->AddTask(&MHD::SendB_Shr, this, id.recvb);
   id.recvb_shr = tl["stagen"]->AddTask(&MHD::RecvB_Shr, this, id.sendb_shr);
-  id.bcs       = tl["stagen"]->AddTask(&MHD::ApplyPhysicalBCs, this, id.recvb_shr);
-  id.prol      = tl["stagen"]->AddTask(&MHD::Prolongate, this, id.bcs);
-  id.c2p       = tl["stagen"]->AddTask(&MHD::ConToPrim, this, id.prol);
-  id.newdt     = tl["stagen"]->AddTask(&MHD::NewTimeStep, this, id.c2p);
+  if (overlap_comm) {
+    id.bcs     = tl["stagen"]->AddTask(&MHD::ApplyPhysicalBCs, this,
+                                       (id.recvb_shr|id.recvu_shr));
+    id.prol    = tl["stagen"]->AddTask(&MHD::Prolongate, this, id.bcs);
+    // ConsToPrim (and new timestep) in active cells proceeds while boundary values are
+    // in flight, only ghost zones wait for RecvU and RecvB
+    id.c2pa    = tl["stagen"]->AddTask(&MHD::ConToPrimActive, this, id.sendb);
+    id.newdt   = tl["stagen"]->AddTask(&MHD::NewTimeStep, this, id.c2pa);
+    id.c2p     = tl["stagen"]->AddTask(&MHD::ConToPrimGhosts, this, (id.prol|id.c2pa));
+    tl["stagen"]->SetLBTimed(id.c2pa);
+  } else {
+    id.bcs     = tl["stagen"]->AddTask(&MHD::ApplyPhysicalBCs, this, id.recvb_shr);
+    id.prol    = tl["stagen"]->AddTask(&MHD::Prolongate, this, id.bcs);
+    id.c2p     = tl["stagen"]->AddTask(&MHD::ConToPrim, this, id.prol);
+    id.newdt   = tl["stagen"]->AddTask(&MHD::NewTimeStep, this, id.c2p);
+  }
+  // flag compute-intensive tasks to be timed for automatic load balancing
+  for (auto tid : {id.flux, id.rkupdt, id.srctrms, id.ct, id.c2p}) {
+    tl["stagen"]->SetLBTimed(tid);
+  }
 
   // assemble "after_stagen" task list
   id.csend = tl["after_stagen"]->AddTask(&MHD::ClearSend, this, none);
@@ -104,9 +139,20 @@ TaskStatus MHD::SaveMHDState(Driver *pdrive, int stage) {
 //! face-centered fields AND their fluxes (with SMR/AMR).
 
 TaskStatus MHD::InitRecv(Driver *pdrive, int stage) {
+  // with fixed_flow, only passive scalars are exchanged in all stages of the RK
+  // integrator, but MHD variables and B are exchanged in Driver::Initialize (stage<0)
+  pbval_u->var_start = (fixed_flow && stage > 0)? nmhd : 0;
+
+  // coarse arrays used in prolongation may have been evicted from device memory
+  if (pmy_pack->pmesh->multilevel) {
+    ManagedMemory::Prefetch(coarse_u0);
+    ManagedMemory::Prefetch(coarse_w0);
+  }
+
   // post receives for U
-  TaskStatus tstat = pbval_u->InitRecv(nmhd+nscalars);
+  TaskStatus tstat = pbval_u->InitRecv(nmhd+nscalars-(pbval_u->var_start));
   if (tstat != TaskStatus::complete) return tstat;
+  if (fixed_flow && stage > 0) return tstat;
   // post receives for B
   tstat = pbval_b->InitRecv(3);
   if (tstat != TaskStatus::complete) return tstat;
@@ -154,7 +200,9 @@ TaskStatus MHD::InitRecv(Driver *pdrive, int stage) {
 
 //----------------------------------------------------------------------------------------
 //! \fn TaskStatus MHD::CopyCons
-//! \brief Simple task list function that copies u0 --> u1, and b0 --> b1 in first stage
+//! \brief Simple task list function that copies u0 --> u1, and b0 --> b1 in first stage.
+//! With 2S low-storage integrators (rk4, ssprk104), u1 and b1 are also updated with u0
+//! and b0 at later stages.
 
 TaskStatus MHD::CopyCons(Driver *pdrive, int stage) {
   if (stage == 1) {
@@ -162,6 +210,36 @@ TaskStatus MHD::CopyCons(Driver *pdrive, int stage) {
     Kokkos::deep_copy(DevExeSpace(), b1.x1f, b0.x1f);
     Kokkos::deep_copy(DevExeSpace(), b1.x2f, b0.x2f);
     Kokkos::deep_copy(DevExeSpace(), b1.x3f, b0.x3f);
+  } else if (pdrive->use_delta) {
+    auto &indcs = pmy_pack->pmesh->mb_indcs;
+    int is = indcs.is, ie = indcs.ie;
+    int js = indcs.js, je = indcs.je;
+    int ks = indcs.ks, ke = indcs.ke;
+    int nmb1 = pmy_pack->nmb_thispack - 1;
+    int nvar = nmhd + nscalars;
+    auto &u0_ = u0;
+    auto &u1_ = u1;
+    Real &delta = pdrive->delta[stage-1];
+    par_for("2s_copy_cons", DevExeSpace(),0, nmb1, 0, nvar-1, ks, ke, js, je, is, ie,
+    KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
+      u1_(m,n,k,j,i) += delta*u0_(m,n,k,j,i);
+    });
+
+    // face-centered fields, including faces on upper boundary of each MeshBlock
+    auto bx1f = b0.x1f, bx2f = b0.x2f, bx3f = b0.x3f;
+    auto bx1f_old = b1.x1f, bx2f_old = b1.x2f, bx3f_old = b1.x3f;
+    par_for("2s_copy_b1", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie+1,
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      bx1f_old(m,k,j,i) += delta*bx1f(m,k,j,i);
+    });
+    par_for("2s_copy_b2", DevExeSpace(), 0, nmb1, ks, ke, js, je+1, is, ie,
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      bx2f_old(m,k,j,i) += delta*bx2f(m,k,j,i);
+    });
+    par_for("2s_copy_b3", DevExeSpace(), 0, nmb1, ks, ke+1, js, je, is, ie,
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      bx3f_old(m,k,j,i) += delta*bx3f(m,k,j,i);
+    });
   }
   return TaskStatus::complete;
 }
@@ -249,7 +327,7 @@ TaskStatus MHD::RecvFlux(Driver *pdrive, int stage) {
 //! variables (u0) have already been partially updated when this fn called.
 
 TaskStatus MHD::MHDSrcTerms(Driver *pdrive, int stage) {
-  Real beta_dt = (pdrive->beta[stage-1])*(pmy_pack->pmesh->dt);
+  Real beta_dt = (pdrive->beta[stage-1])*FluidDt();
 
   // Add source terms for various physics
   if (psrc->const_accel)  psrc->ConstantAccel(w0, peos->eos_data, beta_dt, u0);
@@ -482,8 +560,10 @@ TaskStatus MHD::ApplyPhysicalBCs(Driver *pdrive, int stage) {
   pbval_b->BFieldBCs((pmy_pack), (pbval_b->b_in), b0);
 
   // user BCs
-  if (pmy_pack->pmesh->pgen->user_bcs) {
-    (pmy_pack->pmesh->pgen->user_bcs_func)(pmy_pack->pmesh);
+  // user BCs may instead be defined as a device hook applied in HydroBCs()
+  auto &pgen = pmy_pack->pmesh->pgen;
+  if (pgen->user_bcs && pgen->user_bcs_func != nullptr) {
+    (pgen->user_bcs_func)(pmy_pack->pmesh);
   }
 
   return TaskStatus::complete;
@@ -513,15 +593,44 @@ TaskStatus MHD::Prolongate(Driver *pdrive, int stage) {
 
 //----------------------------------------------------------------------------------------
 //! \fn TaskStatus MHD::ConToPrim
-//! \brief Wrapper task list function to call ConsToPrim over entire mesh (including gz)
+//! \brief Wrapper task list function to call ConsToPrim over active cells and the nghost
+//! ghost cells exchanged with neighbors (others may not be filled with <mhd>/nghost)
 
 TaskStatus MHD::ConToPrim(Driver *pdrive, int stage) {
   auto &indcs = pmy_pack->pmesh->mb_indcs;
-  int &ng = indcs.ng;
-  int n1m1 = indcs.nx1 + 2*ng - 1;
-  int n2m1 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng - 1) : 0;
-  int n3m1 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng - 1) : 0;
-  peos->ConsToPrim(u0, b0, w0, bcc0, false, 0, n1m1, 0, n2m1, 0, n3m1);
+  int il = indcs.is - nghost, iu = indcs.ie + nghost;
+  int jl = indcs.js, ju = indcs.je, kl = indcs.ks, ku = indcs.ke;
+  if (indcs.nx2 > 1) {jl -= nghost; ju += nghost;}
+  if (indcs.nx3 > 1) {kl -= nghost; ku += nghost;}
+  peos->ConsToPrim(u0, b0, w0, bcc0, false, il, iu, jl, ju, kl, ku);
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus MHD::ConToPrimActive
+//! \brief Wrapper task list function to call ConsToPrim over active cells only.  Used
+//! with overlap_comm=true, in which case it runs while communication of ghost zones is in
+//! flight.  Active cells (and faces) are not changed by any task after SendB.
+
+TaskStatus MHD::ConToPrimActive(Driver *pdrive, int stage) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  peos->ConsToPrim(u0, b0, w0, bcc0, false, indcs.is, indcs.ie, indcs.js, indcs.je,
+                   indcs.ks, indcs.ke);
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus MHD::ConToPrimGhosts
+//! \brief Wrapper task list function to call ConsToPrim over ghost zones only, once
+//! boundary values have been received.  Used with overlap_comm=true.
+
+TaskStatus MHD::ConToPrimGhosts(Driver *pdrive, int stage) {
+  int slab[6][6];
+  int nslab = GhostZoneSlabs(pmy_pack->pmesh->mb_indcs, slab, nghost);
+  for (int n=0; n<nslab; ++n) {
+    peos->ConsToPrim(u0, b0, w0, bcc0, false, slab[n][0], slab[n][1], slab[n][2],
+                     slab[n][3], slab[n][4], slab[n][5]);
+  }
   return TaskStatus::complete;
 }
 
@@ -540,6 +649,8 @@ TaskStatus MHD::ClearSend(Driver *pdrive, int stage) {
     // check sends of U complete
     TaskStatus tstat = pbval_u->ClearSend();
     if (tstat != TaskStatus::complete) return tstat;
+    // with fixed_flow B and its fluxes are not sent in the RK integrator
+    if (fixed_flow && stage > 0) return tstat;
     // check sends of B complete
     tstat = pbval_b->ClearSend();
     if (tstat != TaskStatus::complete) return tstat;
@@ -596,6 +707,8 @@ TaskStatus MHD::ClearRecv(Driver *pdrive, int stage) {
     // check receives of U complete
     tstat = pbval_u->ClearRecv();
     if (tstat != TaskStatus::complete) return tstat;
+    // with fixed_flow B and its fluxes are not received in the RK integrator
+    if (fixed_flow && stage > 0) return tstat;
     // check receives of B complete
     tstat = pbval_b->ClearRecv();
     if (tstat != TaskStatus::complete) return tstat;
@@ -7,7 +7,8 @@
 //! \brief Performs explicit update of MHD conserved variables (u0) for each stage of the
 //! SSP RK integrators (e.g. RK1, RK2, RK3) implemented in AthenaK, using weighted average
 //! and partial time update of flux divergence. Source terms are added in the
-//! MHDSrcTerms() function.
+//! MHDSrcTerms() function, except for user source terms defined as a device hook (see
+//! pgen/user_hooks.hpp), which are added in the update kernel.
 
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
@@ -23,24 +24,35 @@ namespace mhd {
 
 TaskStatus MHD::RKUpdate(Driver *pdriver, int stage) {
   auto &indcs = pmy_pack->pmesh->mb_indcs;
+#if FIXED_MB_NX1 > 0
+  constexpr int is = FIXED_MB_IS, ie = FIXED_MB_IE;
+  constexpr int ncells1 = FIXED_MB_NCELLS1;
+#else
   int is = indcs.is, ie = indcs.ie;
+  int ncells1 = indcs.nx1 + 2*(indcs.ng);
+#endif
   int js = indcs.js, je = indcs.je;
   int ks = indcs.ks, ke = indcs.ke;
-  int ncells1 = indcs.nx1 + 2*(indcs.ng);
   bool &multi_d = pmy_pack->pmesh->multi_d;
   bool &three_d = pmy_pack->pmesh->three_d;
 
   Real &gam0 = pdriver->gam0[stage-1];
   Real &gam1 = pdriver->gam1[stage-1];
-  Real beta_dt = (pdriver->beta[stage-1])*(pmy_pack->pmesh->dt);
+  Real beta_dt = (pdriver->beta[stage-1])*FluidDt();
   int nmb1 = pmy_pack->nmb_thispack - 1;
   int nv1 = nmhd + nscalars - 1;
+  // with fixed_flow, only passive scalars are updated
+  int nv0 = (fixed_flow)? nmhd : 0;
   auto u0_ = u0;
   auto u1_ = u1;
   auto flx1 = uflx.x1f;
   auto flx2 = uflx.x2f;
   auto flx3 = uflx.x3f;
   auto &mbsize = pmy_pack->pmb->mb_size;
+  // user source terms inlined in update (see pgen/user_hooks.hpp)
+  auto &srcs_hook = pmy_pack->pmesh->pgen->user_srcs_hook;
+  srcs_hook.Update(pmy_pack->pmesh);
+  auto user_src = srcs_hook;
 
   // hierarchical parallel loop that updates conserved variables to intermediate step
   // using weights and fractional time step appropriate to stages of time-integrator used
@@ -48,7 +60,7 @@ TaskStatus MHD::RKUpdate(Driver *pdriver, int stage) {
   int scr_level = 0;
   size_t scr_size = ScrArray1D<Real>::shmem_size(ncells1);
 
-  par_for_outer("mhd_update",DevExeSpace(),scr_size,scr_level,0,nmb1,0,nv1,ks,ke,js,je,
+  par_for_outer("mhd_update",DevExeSpace(),scr_size,scr_level,0,nmb1,nv0,nv1,ks,ke,js,je,
   KOKKOS_LAMBDA(TeamMember_t member, const int m, const int n, const int k, const int j) {
     ScrArray1D<Real> divf(member.team_scratch(scr_level), ncells1);
 
@@ -78,6 +90,9 @@ TaskStatus MHD::RKUpdate(Driver *pdriver, int stage) {
 
     par_for_inner(member, is, ie, [&](const int i) {
       u0_(m,n,k,j,i) = gam0*u0_(m,n,k,j,i) + gam1*u1_(m,n,k,j,i) - beta_dt*divf(i);
+      if constexpr (user_hooks::SrcTerm::enabled) {
+        u0_(m,n,k,j,i) += beta_dt*user_src(m,n,k,j,i);
+      }
     });
   });
   return TaskStatus::complete;
@@ -289,61 +289,30 @@ void HLLD(TeamMember_t const &member, const EOS_Data &eos,
       urst.by = spd[4] * (urst.by - ur.by);
       urst.bz = spd[4] * (urst.bz - ur.bz);
 
-      if (spd[0] >= 0.0) {
-        // return Fl if flow is supersonic
-        flxi.d = fl.d;
-        flxi.mx = fl.mx;
-        flxi.my = fl.my;
-        flxi.mz = fl.mz;
-        flxi.e  = fl.e;
-        flxi.by = fl.by;
-        flxi.bz = fl.bz;
-      } else if (spd[4] <= 0.0) {
-        // return Fr if flow is supersonic
-        flxi.d = fr.d;
-        flxi.mx = fr.mx;
-        flxi.my = fr.my;
-        flxi.mz = fr.mz;
-        flxi.e  = fr.e;
-        flxi.by = fr.by;
-        flxi.bz = fr.bz;
-      } else if (spd[1] >= 0.0) {
-        // return Fl*
-        flxi.d = fl.d  + ulst.d;
-        flxi.mx = fl.mx + ulst.mx;
-        flxi.my = fl.my + ulst.my;
-        flxi.mz = fl.mz + ulst.mz;
-        flxi.e  = fl.e  + ulst.e;
-        flxi.by = fl.by + ulst.by;
-        flxi.bz = fl.bz + ulst.bz;
-      } else if (spd[2] >= 0.0) {
-        // return Fl**
-        flxi.d = fl.d  + ulst.d + uldst.d;
-        flxi.mx = fl.mx + ulst.mx + uldst.mx;
-        flxi.my = fl.my + ulst.my + uldst.my;
-        flxi.mz = fl.mz + ulst.mz + uldst.mz;
-        flxi.e  = fl.e  + ulst.e + uldst.e;
-        flxi.by = fl.by + ulst.by + uldst.by;
-        flxi.bz = fl.bz + ulst.bz + uldst.bz;
-      } else if (spd[3] > 0.0) {
-        // return Fr**
-        flxi.d = fr.d + urst.d + urdst.d;
-        flxi.mx = fr.mx + urst.mx + urdst.mx;
-        flxi.my = fr.my + urst.my + urdst.my;
-        flxi.mz = fr.mz + urst.mz + urdst.mz;
-        flxi.e  = fr.e + urst.e + urdst.e;
-        flxi.by = fr.by + urst.by + urdst.by;
-        flxi.bz = fr.bz + urst.bz + urdst.bz;
-      } else {
-        // return Fr*
-        flxi.d = fr.d  + urst.d;
-        flxi.mx = fr.mx + urst.mx;
-        flxi.my = fr.my + urst.my;
-        flxi.mz = fr.mz + urst.mz;
-        flxi.e  = fr.e  + urst.e;
-        flxi.by = fr.by + urst.by;
-        flxi.bz = fr.bz + urst.bz;
-      }
+      // The choice among Fl, Fl*, Fl**, Fr**, Fr* and Fr is made with selects rather than
+      // an if/else cascade so that the loop over i vectorizes.  The conditions reproduce
+      // the cascade exactly, including for non-monotonic wave speeds.
+      bool sup_l = (spd[0] >= 0.0);                    // return Fl
+      bool sup_r = !(sup_l) && (spd[4] <= 0.0);        // return Fr
+      bool use_st = !(sup_l || sup_r);                 // add (U*-U) term
+      bool lside = sup_l || (use_st && (spd[1] >= 0.0 || spd[2] >= 0.0));
+      bool use_dst = use_st && (lside ? (spd[1] < 0.0) : (spd[3] > 0.0));
+
+      flxi.d  = (lside ? fl.d  : fr.d ) + (use_st ? (lside ? ulst.d  : urst.d ) : 0.0);
+      flxi.mx = (lside ? fl.mx : fr.mx) + (use_st ? (lside ? ulst.mx : urst.mx) : 0.0);
+      flxi.my = (lside ? fl.my : fr.my) + (use_st ? (lside ? ulst.my : urst.my) : 0.0);
+      flxi.mz = (lside ? fl.mz : fr.mz) + (use_st ? (lside ? ulst.mz : urst.mz) : 0.0);
+      flxi.e  = (lside ? fl.e  : fr.e ) + (use_st ? (lside ? ulst.e  : urst.e ) : 0.0);
+      flxi.by = (lside ? fl.by : fr.by) + (use_st ? (lside ? ulst.by : urst.by) : 0.0);
+      flxi.bz = (lside ? fl.bz : fr.bz) + (use_st ? (lside ? ulst.bz : urst.bz) : 0.0);
+
+      flxi.d  += (use_dst ? (lside ? uldst.d  : urdst.d ) : 0.0);
+      flxi.mx += (use_dst ? (lside ? uldst.mx : urdst.mx) : 0.0);
+      flxi.my += (use_dst ? (lside ? uldst.my : urdst.my) : 0.0);
+      flxi.mz += (use_dst ? (lside ? uldst.mz : urdst.mz) : 0.0);
+      flxi.e  += (use_dst ? (lside ? uldst.e  : urdst.e ) : 0.0);
+      flxi.by += (use_dst ? (lside ? uldst.by : urdst.by) : 0.0);
+      flxi.bz += (use_dst ? (lside ? uldst.bz : urdst.bz) : 0.0);
 
       flx(m,IDN,k,j,i) = flxi.d;
       flx(m,ivx,k,j,i) = flxi.mx;
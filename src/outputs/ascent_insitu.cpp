@@ -0,0 +1,149 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file ascent_insitu.cpp
+//! \brief passes output data to the Ascent in-situ visualization and analysis library,
+//! instead of writing it to a file.  Each output MeshBlock is published as one domain of
+//! a Conduit Blueprint multi-domain mesh with a uniform coordset, and the refinement
+//! level and logical location of the MeshBlock (from the MeshBlockTree) are stored in
+//! the "state" node of each domain.  Since MeshBlocks never overlap, no nesting
+//! relations are needed to describe the AMR hierarchy.  Field values are not copied, but
+//! point directly into the host output array filled by LoadOutputData().
+//!
+//! Renders, extracts, and other analysis are specified in the Ascent actions file, which
+//! is set by actions_file in the <output> block (default "ascent_actions.yaml"), and the
+//! cadence of calls is set by the dt or dcycle parameters as for any other output.
+
+#include <iostream>
+#include <string>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "outputs.hpp"
+
+#if ASCENT_ENABLED
+#include <ascent.hpp>
+#include <conduit_blueprint.hpp>
+
+//----------------------------------------------------------------------------------------
+// Constructor: also calls BaseTypeOutput base class constructor, and opens Ascent
+
+MeshAscentOutput::MeshAscentOutput(ParameterInput *pin, Mesh *pm, OutputParameters op) :
+  BaseTypeOutput(pin, pm, op),
+  pascent(new ascent::Ascent) {
+  conduit::Node opts;
+#if MPI_PARALLEL_ENABLED
+  opts["mpi_comm"] = MPI_Comm_c2f(global_variable::athena_comm);
+#endif
+  opts["actions_file"] = pin->GetOrAddString(op.block_name, "actions_file",
+                                             "ascent_actions.yaml");
+  opts["exceptions"] = "forward";
+  try {
+    pascent->open(opts);
+  } catch (conduit::Error &e) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Ascent could not be initialized for output block '"
+              << op.block_name << "':" << std::endl << e.message() << std::endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+// Destructor: closes Ascent
+
+MeshAscentOutput::~MeshAscentOutput() {
+  pascent->close();
+  delete pascent;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshAscentOutput:::WriteOutputFile(Mesh *pm)
+//  \brief Publishes OutputData over all MeshBlocks to Ascent, and executes actions.
+
+void MeshAscentOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
+  int nout_vars = outvars.size();
+  int nout_mbs = outmbs.size();
+
+  // cells output per MB are the same on every MB
+  auto &indcs = pm->mb_indcs;
+  int nout1 = outarray.extent_int(4);
+  int nout2 = outarray.extent_int(3);
+  int nout3 = outarray.extent_int(2);
+  std::size_t ncells = static_cast<std::size_t>(nout1)*nout2*nout3;
+
+  conduit::Node mesh;
+  for (int m=0; m<nout_mbs; ++m) {
+    auto &omb = outmbs[m];
+    LogicalLocation loc = pm->lloc_eachmb[omb.mb_gid];
+    conduit::Node &dom = mesh.append();
+    dom["state/domain_id"] = omb.mb_gid;
+    dom["state/cycle"] = pm->ncycle;
+    dom["state/time"] = static_cast<double>(pm->time);
+    dom["state/level"] = loc.level - pm->root_level;
+    dom["state/logical_location/lx1"] = loc.lx1;
+    dom["state/logical_location/lx2"] = loc.lx2;
+    dom["state/logical_location/lx3"] = loc.lx3;
+
+    // origin of uniform coordset is at left face of first output cell, which may be in
+    // ghost zones or at a slice
+    double dx1 = (omb.x1max - omb.x1min)/static_cast<double>(indcs.nx1);
+    double dx2 = (omb.x2max - omb.x2min)/static_cast<double>(indcs.nx2);
+    double dx3 = (omb.x3max - omb.x3min)/static_cast<double>(indcs.nx3);
+    dom["coordsets/coords/type"] = "uniform";
+    dom["coordsets/coords/dims/i"] = nout1 + 1;
+    dom["coordsets/coords/dims/j"] = nout2 + 1;
+    dom["coordsets/coords/dims/k"] = nout3 + 1;
+    dom["coordsets/coords/origin/x"] = omb.x1min + (omb.ois - indcs.is)*dx1;
+    dom["coordsets/coords/origin/y"] = omb.x2min + (omb.ojs - indcs.js)*dx2;
+    dom["coordsets/coords/origin/z"] = omb.x3min + (omb.oks - indcs.ks)*dx3;
+    dom["coordsets/coords/spacing/dx"] = dx1;
+    dom["coordsets/coords/spacing/dy"] = dx2;
+    dom["coordsets/coords/spacing/dz"] = dx3;
+    dom["topologies/mesh/type"] = "uniform";
+    dom["topologies/mesh/coordset"] = "coords";
+
+    // fields point directly at data in outarray, in which (k,j,i) of each variable on
+    // each MB are contiguous
+    for (int n=0; n<nout_vars; ++n) {
+      conduit::Node &fld = dom["fields/" + outvars[n].label];
+      fld["association"] = "element";
+      fld["topology"] = "mesh";
+      fld["values"].set_external(&(outarray(n,m,0,0,0)), ncells);
+    }
+  }
+
+  conduit::Node info;
+  if (global_variable::my_rank == 0 && nout_mbs > 0 &&
+      !conduit::blueprint::mesh::verify(mesh, info)) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Mesh published to Ascent does not conform to Blueprint" << std::endl
+              << info.to_yaml() << std::endl;
+  }
+  try {
+    pascent->publish(mesh);
+    conduit::Node actions;
+    pascent->execute(actions);
+  } catch (conduit::Error &e) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Ascent failed in output block '" << out_params.block_name
+              << "':" << std::endl << e.message() << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // increment counters
+  out_params.file_number++;
+  if (out_params.last_time < 0.0) {
+    out_params.last_time = pm->time;
+  } else {
+    out_params.last_time += out_params.dt;
+  }
+  pin->SetInteger(out_params.block_name, "file_number", out_params.file_number);
+  pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
+
+  return;
+}
+#endif // ASCENT_ENABLED
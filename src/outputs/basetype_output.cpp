@@ -42,11 +42,14 @@ BaseTypeOutput::BaseTypeOutput(ParameterInput *pin, Mesh *pm, OutputParameters o
     outarray("cc_outvar",1,1,1,1,1),
     outfield("fc_outvar",1,1,1,1),
     out_params(opar) {
-  // exit for history, restart, or event log files
+  // exit for history, restart, event log, or communication log files
   if (out_params.file_type.compare("hst") == 0 ||
       out_params.file_type.compare("rst") == 0 ||
       out_params.file_type.compare("log") == 0 ||
-      out_params.file_type.compare("trk") == 0) {return;}
+      out_params.file_type.compare("comm") == 0 ||
+      out_params.file_type.compare("trk") == 0 ||
+      out_params.file_type.compare("rt") == 0 ||
+      out_params.file_type.compare("python") == 0) {return;}
 
   // initialize vector containing number of output MBs per rank
   noutmbs.assign(global_variable::nranks, 0);
@@ -684,6 +687,17 @@ BaseTypeOutput::BaseTypeOutput(ParameterInput *pin, Mesh *pm, OutputParameters o
   noutmbs.assign(global_variable::nranks, 0);
 }
 
+//----------------------------------------------------------------------------------------
+// BaseTypeOutput::ReadsArray()
+// true if any output variable of this output type is stored in parray
+
+bool BaseTypeOutput::ReadsArray(const DvceArray5D<Real> *parray) const {
+  for (auto &var : outvars) {
+    if (var.data_ptr == parray) return true;
+  }
+  return false;
+}
+
 //----------------------------------------------------------------------------------------
 // BaseTypeOutput::LoadOutputData()
 // create std::vector of HostArray3Ds containing data specified in <output> block for
@@ -772,54 +786,97 @@ void BaseTypeOutput::LoadOutputData(Mesh *pm) {
   noutmbs[global_variable::my_rank] = outmbs.size();
 #if MPI_PARALLEL_ENABLED
   MPI_Allreduce(MPI_IN_PLACE, noutmbs.data(), global_variable::nranks,
-                MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+                MPI_INT, MPI_SUM, global_variable::athena_comm);
 #endif
   noutmbs_min = *std::min_element(noutmbs.begin(), noutmbs.end());
   noutmbs_max = *std::max_element(noutmbs.begin(), noutmbs.end());
 
 
-  // get number of output vars and MBs, then realloc outarray (HostArray)
+  // get number of output vars and MBs, then realloc outarray (HostArray).  It is only
+  // reallocated when the number of output MBs changes.
   int nout_vars = outvars.size();
   int nout_mbs = outmbs.size();
   // note that while ois,oie,etc. can be different on each MB, the number of cells output
   // on each MeshBlock, i.e. (ois-ois+1), etc. is the same.
+  int nout1 = 0, nout2 = 0, nout3 = 0;
   if (nout_mbs > 0) {
-    int nout1 = (outmbs[0].oie - outmbs[0].ois + 1);
-    int nout2 = (outmbs[0].oje - outmbs[0].ojs + 1);
-    int nout3 = (outmbs[0].oke - outmbs[0].oks + 1);
+    nout1 = (outmbs[0].oie - outmbs[0].ois + 1);
+    nout2 = (outmbs[0].oje - outmbs[0].ojs + 1);
+    nout3 = (outmbs[0].oke - outmbs[0].oks + 1);
+    auto resize = [=](auto &arr) {
+      if (arr.extent_int(0) != nout_vars || arr.extent_int(1) != nout_mbs ||
+          arr.extent_int(2) != nout3 || arr.extent_int(3) != nout2 ||
+          arr.extent_int(4) != nout1) {
+        Kokkos::realloc(arr, nout_vars, nout_mbs, nout3, nout2, nout1);
+      }
+    };
     // NB: outarray stores all output data on Host
-    Kokkos::realloc(outarray, nout_vars, nout_mbs, nout3, nout2, nout1);
+    resize(outarray);
   }
 
   // Calculate derived variables, if required
   if (out_params.contains_derived) {
-    ComputeDerivedVariable(out_params.variable, pm);
+    ComputeDerivedVariables(pm);
+  }
+  if (nout_mbs == 0) {return;}
+
+  // store index of each output MB in MeshBlockPack, and starting indices of output data
+  Kokkos::realloc(outmb_indcs, nout_mbs, 4);
+  for (int m=0; m<nout_mbs; ++m) {
+    outmb_indcs.h_view(m,0) = pm->FindMeshBlockIndex(outmbs[m].mb_gid);
+    outmb_indcs.h_view(m,1) = outmbs[m].ois;
+    outmb_indcs.h_view(m,2) = outmbs[m].ojs;
+    outmb_indcs.h_view(m,3) = outmbs[m].oks;
+  }
+  outmb_indcs.template modify<HostMemSpace>();
+  outmb_indcs.template sync<DevExeSpace>();
+
+  // If all variables were staged this cycle for several outputs, copy them from the
+  // shared host array (see Outputs::StageOutputData())
+  std::vector<int> sidx;
+  bool staged = (pstage != nullptr && pstage->cycle == pm->ncycle &&
+                 pstage->version == pm->mesh_version &&
+                 (pstage->ghost_zones || !(out_params.include_gzs)));
+  for (int n=0; n<nout_vars && staged; ++n) {
+    sidx.push_back(pstage->Find(outvars[n].data_ptr, outvars[n].data_index));
+    if (sidx[n] < 0) {staged = false;}
+  }
+  if (staged) {
+    int off1 = (pstage->ghost_zones)? 0 : indcs.is;
+    int off2 = (pstage->ghost_zones)? 0 : indcs.js;
+    int off3 = (pstage->ghost_zones)? 0 : indcs.ks;
+    auto &sdata = pstage->data;
+    for (int n=0; n<nout_vars; ++n) {
+      for (int m=0; m<nout_mbs; ++m) {
+        int mb = outmb_indcs.h_view(m,0);
+        int i0 = outmb_indcs.h_view(m,1) - off1;
+        int j0 = outmb_indcs.h_view(m,2) - off2;
+        int k0 = outmb_indcs.h_view(m,3) - off3;
+        for (int k=0; k<nout3; ++k) {
+          for (int j=0; j<nout2; ++j) {
+            for (int i=0; i<nout1; ++i) {
+              outarray(n,m,k,j,i) = sdata(sidx[n],mb,k+k0,j+j0,i+i0);
+            }
+          }
+        }
+      }
+    }
+    return;
   }
 
-  // Now copy data to host (outarray) over all variables and MeshBlocks
+  // Now pack data over all variables and MeshBlocks into device staging array (checked
+  // out of the scratch pool), and copy to host (outarray) with a single transfer
+  auto d_outarray = pm->scratch.Checkout("d_outarray", nout_vars, nout_mbs, nout3, nout2,
+                                         nout1);
+  auto &d_out = d_outarray.view;
+  auto idx = outmb_indcs.d_view;
   for (int n=0; n<nout_vars; ++n) {
-    for (int m=0; m<nout_mbs; ++m) {
-      int mbi = pm->FindMeshBlockIndex(outmbs[m].mb_gid);
-      std::pair<int,int> irange = std::make_pair(outmbs[m].ois, outmbs[m].oie+1);
-      std::pair<int,int> jrange = std::make_pair(outmbs[m].ojs, outmbs[m].oje+1);
-      std::pair<int,int> krange = std::make_pair(outmbs[m].oks, outmbs[m].oke+1);
-      int nout1 = (outmbs[0].oie - outmbs[0].ois + 1);
-      int nout2 = (outmbs[0].oje - outmbs[0].ojs + 1);
-      int nout3 = (outmbs[0].oke - outmbs[0].oks + 1);
-
-      // copy output variable to new device View
-      DvceArray3D<Real> d_output_var("d_out_var",nout3,nout2,nout1);
-      auto d_slice = Kokkos::subview(*(outvars[n].data_ptr), mbi, outvars[n].data_index,
-                                     krange,jrange,irange);
-      Kokkos::deep_copy(d_output_var,d_slice);
-
-      // copy new device View to host mirror View
-      DvceArray3D<Real>::HostMirror h_output_var = Kokkos::create_mirror(d_output_var);
-      Kokkos::deep_copy(h_output_var,d_output_var);
-
-      // copy host mirror to 5D host View containing all output variables
-      auto h_slice = Kokkos::subview(outarray,n,m,Kokkos::ALL,Kokkos::ALL,Kokkos::ALL);
-      Kokkos::deep_copy(h_slice,h_output_var);
-    }
+    auto var = *(outvars[n].data_ptr);
+    int indx = outvars[n].data_index;
+    par_for("out_pack",DevExeSpace(),0,(nout_mbs-1),0,(nout3-1),0,(nout2-1),0,(nout1-1),
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      d_out(n,m,k,j,i) = var(idx(m,0),indx,k+idx(m,3),j+idx(m,2),i+idx(m,1));
+    });
   }
+  Kokkos::deep_copy(outarray, d_out);
 }
@@ -6,6 +6,17 @@
 //! \file binary.cpp
 //! \brief writes output data in binary format, which simply consists of each MeshBlock
 //! written contiguously in order of "gid" in binary format.
+//!
+//! With index=true in the <output> block (format version 1.2), the data is followed by
+//! an index with one entry per MeshBlock record, and a trailer, so that readers can find
+//! and memory-map the records of selected MeshBlocks and variables without parsing the
+//! whole file.  Each index entry is
+//!   int64 offset of record, int32 gid, level, lx1, lx2, lx3, (unused),
+//!   Real x1min, x1max, x2min, x2max, x3min, x3max
+//! where gid=-1 for records not containing a MeshBlock.  The trailer at the end of the
+//! file is
+//!   int64 offset of index, number of entries, size of record, offset of first variable
+//!   in record, cells per variable, followed by the 8 characters "ATHKBIDX".
 
 #include <sys/stat.h>  // mkdir
 
@@ -30,6 +41,7 @@
 
 MeshBinaryOutput::MeshBinaryOutput(ParameterInput *pin, Mesh *pm, OutputParameters op) :
   BaseTypeOutput(pin, pm, op) {
+  write_index = pin->GetOrAddBoolean(op.block_name, "index", false);
   // create directories for outputs
   // useful for mpiio-based outputs because on some supercomputers you may need to
   // set different stripe counts depending on whether mpiio is used in order to
@@ -71,7 +83,7 @@ void MeshBinaryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
   // 4. Header (input file information)
   {
     std::stringstream msg;
-    msg << "Athena binary output version=1.1" << std::endl
+    msg << "Athena binary output version=" << ((write_index)? "1.2" : "1.1") << std::endl
         // preheader size includes "size of preheader" line up to "number of variables"
         << "  size of preheader=5" << std::endl
         << "  time=" << pm->time << std::endl
@@ -234,38 +246,92 @@ void MeshBinaryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
       std::size_t myoffset=header_offset+data_size*ns_mbs;
       binfile.Write_any_type_at_all(data,(data_size*nb_mbs),myoffset,"byte");
     } else {
-      // write data over each MeshBlock sequentially and in parallel
-      // calculate max/min number of MeshBlocks across all ranks
+      // write data in chunks of as many MeshBlocks as fit in 2^31-1 bytes, in parallel
+      // calculate max number of MeshBlocks across all ranks
       noutmbs_max = pm->nmb_eachrank[0];
-      noutmbs_min = pm->nmb_eachrank[0];
       for (int i=0; i<(global_variable::nranks); ++i) {
         noutmbs_max = std::max(noutmbs_max,pm->nmb_eachrank[i]);
-        noutmbs_min = std::min(noutmbs_min,pm->nmb_eachrank[i]);
       }
-      for (int m=0;  m<noutmbs_max; ++m) {
-        char *pdata=&(data[m*data_size]);
+      int nchunk = std::max(static_cast<int>(2147483647/data_size), 1);
+      for (int m=0;  m<noutmbs_max; m+=nchunk) {
+        // every rank writes collectively (with zero MBs when it is finished), so that
+        // MPI-IO can aggregate data from all ranks into large writes
+        int nwrite = std::max(std::min(nchunk, nb_mbs-m), 0);
+        char *pdata=&(data[std::min(m,nb_mbs)*data_size]);
         std::size_t myoffset=header_offset+data_size*ns_mbs+data_size*m;
-        // every rank has a MB to write, so write collectively
-        if (m < noutmbs_min) {
-          if (binfile.Write_any_type_at_all(pdata,(data_size),myoffset,"byte") != 1) {
-            std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                << std::endl << "binary data not written correctly to binary file, "
-                << "binary file is broken." << std::endl;
-            exit(EXIT_FAILURE);
-          }
-        // some ranks are finished writing, so use non-collective write
-        } else if (m < pm->nmb_thisrank) {
-          if (binfile.Write_any_type_at(pdata,(data_size),myoffset,"byte") != 1) {
-            std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                 << std::endl << "binary data not written correctly to binary file, "
-                 << "binary file is broken." << std::endl;
-            exit(EXIT_FAILURE);
-          }
+        if (binfile.Write_any_type_at_all(pdata,(data_size*nwrite),myoffset,"byte") !=
+            data_size*nwrite) {
+          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "binary data not written correctly to binary file, "
+              << "binary file is broken." << std::endl;
+          exit(EXIT_FAILURE);
         }
       }
     }
   }
 
+  // 6. Index and trailer
+  if (write_index) {
+    int nidx = (bin_slice)? nout_mbs : nb_mbs;
+    int nidx_total = 0, idx_start = 0;
+    if (bin_slice) {
+      for (int n=0; n<global_variable::nranks; ++n) {
+        if (n < global_variable::my_rank) {idx_start += noutmbs[n];}
+        nidx_total += noutmbs[n];
+      }
+    } else {
+      idx_start = ns_mbs;
+      nidx_total = pm->nmb_total;
+    }
+    std::size_t idx_size = sizeof(int64_t) + 6*sizeof(int32_t) + 6*sizeof(Real);
+    std::size_t idx_offset = header_offset + data_size*nidx_total;
+    char *idx = new char[std::max(nidx,1)*idx_size];
+    for (int m=0; m<nidx; ++m) {
+      char *pidx=&(idx[m*idx_size]);
+      int64_t off = static_cast<int64_t>(header_offset + data_size*(idx_start + m));
+      int32_t iv[6] = {-1, 0, 0, 0, 0, 0};
+      Real xv[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+      if (m < nout_mbs) {
+        LogicalLocation loc = pm->lloc_eachmb[outmbs[m].mb_gid];
+        iv[0] = static_cast<int32_t>(outmbs[m].mb_gid);
+        iv[1] = static_cast<int32_t>(loc.level - pm->root_level);
+        iv[2] = static_cast<int32_t>(loc.lx1);
+        iv[3] = static_cast<int32_t>(loc.lx2);
+        iv[4] = static_cast<int32_t>(loc.lx3);
+        xv[0] = outmbs[m].x1min; xv[1] = outmbs[m].x1max;
+        xv[2] = outmbs[m].x2min; xv[3] = outmbs[m].x2max;
+        xv[4] = outmbs[m].x3min; xv[5] = outmbs[m].x3max;
+      }
+      memcpy(pidx,&(off),sizeof(off));
+      pidx+=sizeof(off);
+      memcpy(pidx,iv,sizeof(iv));
+      pidx+=sizeof(iv);
+      memcpy(pidx,xv,sizeof(xv));
+    }
+    std::size_t myoffset = idx_offset + idx_size*idx_start;
+    if (bin_slice && noutmbs_min == 0) {
+      if (nidx > 0) {
+        binfile.Write_any_type_at(idx,(idx_size*nidx),myoffset,"byte");
+      }
+    } else {
+      binfile.Write_any_type_at_all(idx,(idx_size*nidx),myoffset,"byte");
+    }
+    delete [] idx;
+
+    if (global_variable::my_rank == 0) {
+      int64_t trailer[5];
+      trailer[0] = static_cast<int64_t>(idx_offset);
+      trailer[1] = static_cast<int64_t>(nidx_total);
+      trailer[2] = static_cast<int64_t>(data_size);
+      trailer[3] = static_cast<int64_t>(10*sizeof(int32_t) + 6*sizeof(Real));
+      trailer[4] = static_cast<int64_t>(cells);
+      char trailer_id[9] = "ATHKBIDX";
+      std::size_t toffset = idx_offset + idx_size*nidx_total;
+      binfile.Write_any_type_at(trailer,sizeof(trailer),toffset,"byte");
+      binfile.Write_any_type_at(trailer_id,8,toffset+sizeof(trailer),"byte");
+    }
+  }
+
   // close the output file and clean up ptrs to data
   binfile.Close();
   delete [] data;
@@ -131,7 +131,7 @@ void CoarsenedBinaryOutput::LoadOutputData(Mesh *pm) {
   noutmbs[global_variable::my_rank] = outmbs.size();
 #if MPI_PARALLEL_ENABLED
   MPI_Allreduce(MPI_IN_PLACE, noutmbs.data(), global_variable::nranks,
-                MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+                MPI_INT, MPI_SUM, global_variable::athena_comm);
 #endif
   noutmbs_min = *std::min_element(noutmbs.begin(), noutmbs.end());
   noutmbs_max = *std::max_element(noutmbs.begin(), noutmbs.end());
@@ -158,7 +158,7 @@ void CoarsenedBinaryOutput::LoadOutputData(Mesh *pm) {
 
   // Calculate derived variables, if required
   if (out_params.contains_derived) {
-    ComputeDerivedVariable(out_params.variable, pm);
+    ComputeDerivedVariables(pm);
   }
 
   // Now copy data to host (outarray) over all variables and MeshBlocks
@@ -181,13 +181,9 @@ void CoarsenedBinaryOutput::LoadOutputData(Mesh *pm) {
       int coarsened_nout2 = nout2/out_params.coarsen_factor;
       int coarsened_nout3 = nout3/out_params.coarsen_factor;
 
-      // copy output variable to new device View
-      DvceArray3D<Real> d_output_var("d_out_var",nout3,nout2,nout1);
-      auto d_slice = Kokkos::subview(*(outvars[n].data_ptr), mbi, outvars[n].data_index,
-                                     krange,jrange,irange);
-      Kokkos::deep_copy(d_output_var,d_slice);
-      Kokkos::fence(); // Ensure complete copy
-
+      // output variable on this MB is read directly from device array
+      auto d_output_var = Kokkos::subview(*(outvars[n].data_ptr), mbi,
+                                          outvars[n].data_index, krange, jrange, irange);
 
       int number_of_moments = 1;
       if (out_params.compute_moments) {
@@ -208,59 +204,43 @@ void CoarsenedBinaryOutput::LoadOutputData(Mesh *pm) {
           exit(EXIT_FAILURE);
       }
 
-      int total_iterations = coarsened_nout3
-        * coarsened_nout2 * coarsened_nout1 * coarsen_factor_cubed;
-
+      // Each thread gathers the fine cells of one coarse cell, so that no atomics are
+      // needed, and stores the normalized moments directly.
+      int total_coarsened_elements = coarsened_nout1*coarsened_nout2*coarsened_nout3;
       bool compute_moments = out_params.compute_moments;
       Kokkos::parallel_for("coarsen_variable",
-       Kokkos::RangePolicy<DevExeSpace>(0, total_iterations),
+       Kokkos::RangePolicy<DevExeSpace>(0, total_coarsened_elements),
       KOKKOS_LAMBDA(const int idx) {
         // Calculate the 3D indices for the coarsened data
-        int total_coarsened_elements = coarsened_nout1*coarsened_nout2*coarsened_nout3;
-        int k_c = (idx / (coarsened_nout2 * coarsened_nout1)) % coarsened_nout3;
+        int k_c = idx / (coarsened_nout2 * coarsened_nout1);
         int j_c = (idx / coarsened_nout1) % coarsened_nout2;
         int i_c = idx % coarsened_nout1;
 
-        // Calculate the offset within the coarsen_factor_cubed cube
-        int offset = idx / total_coarsened_elements;
-        int kk = offset / (coarsen_factor * coarsen_factor);
-        int jj = (offset / coarsen_factor) % coarsen_factor;
-        int ii = offset % coarsen_factor;
-
-        // Calculate the corresponding indices in the full data
-        int k = k_c * coarsen_factor + kk;
-        int j = j_c * coarsen_factor + jj;
-        int i = i_c * coarsen_factor + ii;
-
-        // Perform the coarsening operation
-        if(k < nout3 && j < nout2 && i < nout1) {
-          Kokkos::atomic_add(&d_output_var_coarsened(0, k_c, j_c, i_c),
-            d_output_var(k, j, i));
-          if (compute_moments) {
-            Kokkos::atomic_add(&d_output_var_coarsened(1, k_c, j_c, i_c),
-              d_output_var(k, j, i)*d_output_var(k, j, i));
-            Kokkos::atomic_add(&d_output_var_coarsened(2, k_c, j_c, i_c),
-              d_output_var(k, j, i)*d_output_var(k, j, i)*d_output_var(k, j, i));
-            Kokkos::atomic_add(&d_output_var_coarsened(3, k_c, j_c, i_c),
-               d_output_var(k, j, i)*d_output_var(k, j, i)
-              *d_output_var(k, j, i)*d_output_var(k, j, i));
+        Real sum1 = 0.0, sum2 = 0.0, sum3 = 0.0, sum4 = 0.0;
+        for (int kk=0; kk<coarsen_factor; ++kk) {
+          int k = k_c * coarsen_factor + kk;
+          for (int jj=0; jj<coarsen_factor; ++jj) {
+            int j = j_c * coarsen_factor + jj;
+            for (int ii=0; ii<coarsen_factor; ++ii) {
+              int i = i_c * coarsen_factor + ii;
+              Real q = d_output_var(k, j, i);
+              sum1 += q;
+              if (compute_moments) {
+                sum2 += q*q;
+                sum3 += q*q*q;
+                sum4 += q*q*q*q;
+              }
+            }
           }
         }
+        // Normalize the coarsened data
+        d_output_var_coarsened(0, k_c, j_c, i_c) = sum1/coarsen_factor_cubed;
+        if (compute_moments) {
+          d_output_var_coarsened(1, k_c, j_c, i_c) = sum2/coarsen_factor_cubed;
+          d_output_var_coarsened(2, k_c, j_c, i_c) = sum3/coarsen_factor_cubed;
+          d_output_var_coarsened(3, k_c, j_c, i_c) = sum4/coarsen_factor_cubed;
+        }
       });
-      // Normalize the coarsened data
-      int normalize_iterations = number_of_moments * coarsened_nout3
-                                * coarsened_nout2 * coarsened_nout1;
-      Kokkos::parallel_for("normalize_coarsened_variable",
-        Kokkos::RangePolicy<DevExeSpace>(0, normalize_iterations),
-      KOKKOS_LAMBDA(const int idx) {
-        int moment_idx = idx / (coarsened_nout3 * coarsened_nout2 * coarsened_nout1);
-        int k = (idx / (coarsened_nout2 * coarsened_nout1)) % coarsened_nout3;
-        int j = (idx / coarsened_nout1) % coarsened_nout2;
-        int i = idx % coarsened_nout1;
-
-        d_output_var_coarsened(moment_idx, k, j, i) /= coarsen_factor_cubed;
-      });
-
 
       // Now, create a host mirror for the coarsened data.
       DvceArray4D<Real>::HostMirror h_output_var = Kokkos::create_mirror(
@@ -374,9 +354,11 @@ void CoarsenedBinaryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
     nout_vars *= 4;
   }
   int nout_mbs = outmbs.size();
-  int nout1 = ((outmbs[0].oie - outmbs[0].ois + 1)/out_params.coarsen_factor);
-  int nout2 = ((outmbs[0].oje - outmbs[0].ojs + 1)/out_params.coarsen_factor);
-  int nout3 = ((outmbs[0].oke - outmbs[0].oks + 1)/out_params.coarsen_factor);
+  // number of coarsened cells on each MB is set by outarray, so that derived classes can
+  // coarsen differently in each dimension
+  int nout1 = outarray.extent_int(4);
+  int nout2 = outarray.extent_int(3);
+  int nout3 = outarray.extent_int(2);
   int cells = nout1*nout2*nout3;
 
 
@@ -0,0 +1,142 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file commlog.cpp
+//! \brief writes data on MPI communication collected by the CommCounters of each rank to
+//! a log file: the time spent waiting for boundary communications and the timestep
+//! reduction, and the number of messages and bytes exchanged with each neighboring rank,
+//! accumulated since the last output.  Used to tell whether slow cycles are caused by
+//! load imbalance (large waits on some ranks only) or by the network (large waits on all
+//! ranks).
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "mesh/mesh.hpp"
+#include "outputs.hpp"
+
+//----------------------------------------------------------------------------------------
+// ctor: also calls BaseTypeOutput base class constructor
+
+CommLogOutput::CommLogOutput(ParameterInput *pin, Mesh *pm, OutputParameters op) :
+  BaseTypeOutput(pin, pm, op) {
+  header_written = false;
+  // communication counters are only accumulated when this output is requested
+  pm->ccounter.enabled = true;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void CommLogOutput::LoadOutputData()
+//! \brief packs counters of this rank into a vector of doubles, and gathers vectors of
+//! all ranks to the master rank.  Each vector contains the five summary values, followed
+//! by five values (rank, nsend, nrecv, bsend, brecv) for each neighboring rank.
+
+void CommLogOutput::LoadOutputData(Mesh *pm) {
+  CommCounters &cc = pm->ccounter;
+  std::vector<double> local;
+  local.push_back(cc.t_recv);
+  local.push_back(cc.t_send);
+  local.push_back(cc.t_poll);
+  local.push_back(cc.t_dt);
+  local.push_back(static_cast<double>(cc.npoll));
+  for (auto &it : cc.nghbr) {
+    local.push_back(static_cast<double>(it.first));
+    local.push_back(static_cast<double>(it.second.nsend));
+    local.push_back(static_cast<double>(it.second.nrecv));
+    local.push_back(static_cast<double>(it.second.bsend));
+    local.push_back(static_cast<double>(it.second.brecv));
+  }
+
+  int nranks = global_variable::nranks;
+  count.assign(nranks, 0);
+  count[0] = static_cast<int>(local.size());
+#if MPI_PARALLEL_ENABLED
+  int nlocal = static_cast<int>(local.size());
+  MPI_Gather(&nlocal, 1, MPI_INT, count.data(), 1, MPI_INT, 0,
+             global_variable::athena_comm);
+#endif
+  displ.assign(nranks, 0);
+  for (int n=1; n<nranks; ++n) {displ[n] = displ[n-1] + count[n-1];}
+  if (global_variable::my_rank == 0) {
+    data.resize(displ[nranks-1] + count[nranks-1]);
+  }
+#if MPI_PARALLEL_ENABLED
+  MPI_Gatherv(local.data(), nlocal, MPI_DOUBLE, data.data(), count.data(), displ.data(),
+              MPI_DOUBLE, 0, global_variable::athena_comm);
+#else
+  data = local;
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void CommLogOutput::WriteOutputFile()
+//! \brief writes communication data to log file.  For each rank, one line (with nghbr=-1)
+//! gives wait times and totals over all neighbors, followed by one shorter line for each
+//! neighboring rank giving the number of messages and bytes exchanged with it.
+
+void CommLogOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
+  // only the master rank writes the file
+  if (global_variable::my_rank == 0) {
+    // create filename: "file_basename" + ".comm"
+    std::string fname;
+    fname.assign(out_params.file_basename);
+    fname.append(".comm");
+
+    // open file for output
+    FILE *pfile;
+    if ((pfile = std::fopen(fname.c_str(),"a")) == nullptr) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+          << std::endl << "Output file '" << fname << "' could not be opened" <<std::endl;
+      exit(EXIT_FAILURE);
+    }
+
+    // Write header, if it has not been written already
+    if (!(header_written)) {
+      std::fprintf(pfile,"# Athena communication data\n");
+      std::fprintf(pfile,"#  cycle  rank nghbr nmsg_send nmsg_recv  bytes_send");
+      std::fprintf(pfile,"  bytes_recv    t_recv(s)    t_send(s)    t_poll(s)");
+      std::fprintf(pfile,"      t_dt(s)    npoll\n");
+      header_written = true;
+    }
+
+    for (int r=0; r<global_variable::nranks; ++r) {
+      const double *d = data.data() + displ[r];
+      int nnr = (count[r] - 5)/5;
+      double nsend = 0.0, nrecv = 0.0, bsend = 0.0, brecv = 0.0;
+      for (int k=0; k<nnr; ++k) {
+        nsend += d[5*k + 6];
+        nrecv += d[5*k + 7];
+        bsend += d[5*k + 8];
+        brecv += d[5*k + 9];
+      }
+      std::fprintf(pfile, "%8d %5d %5d %9.0f %9.0f %11.0f %11.0f", pm->ncycle, r, -1,
+                   nsend, nrecv, bsend, brecv);
+      std::fprintf(pfile, " %12.5e %12.5e %12.5e %12.5e %8.0f\n", d[0], d[1], d[2], d[3],
+                   d[4]);
+      for (int k=0; k<nnr; ++k) {
+        std::fprintf(pfile, "%8d %5d %5.0f %9.0f %9.0f %11.0f %11.0f\n", pm->ncycle, r,
+                     d[5*k + 5], d[5*k + 6], d[5*k + 7], d[5*k + 8], d[5*k + 9]);
+      }
+    }
+    std::fclose(pfile);
+  }
+
+  // reset counters
+  pm->ccounter.Reset();
+
+  // increment output time, clean up
+  if (out_params.last_time < 0.0) {
+    out_params.last_time = pm->time;
+  } else {
+    out_params.last_time += out_params.dt;
+  }
+  pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
+  return;
+}
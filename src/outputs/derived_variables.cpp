@@ -26,11 +26,37 @@
 #include "hydro/hydro.hpp"
 #include "mhd/mhd.hpp"
 #include "radiation/radiation.hpp"
+#include "radiation/radiation_m1.hpp"
 #include "radiation/radiation_tetrad.hpp"
 #include "particles/particles.hpp"
 #include "outputs.hpp"
 #include "utils/current.hpp"
 
+//----------------------------------------------------------------------------------------
+//! \fn void BaseTypeOutput::ComputeDerivedVariables()
+//! \brief Computes the derived variable(s) of this output (variable, and variable_2 for
+//! 2D PDFs).  If this output, or an earlier output of the same variables, has already
+//! computed them on this cycle (and the mesh has not changed since), they are reused.
+
+void BaseTypeOutput::ComputeDerivedVariables(Mesh *pm) {
+  if (derived_cycle == pm->ncycle && derived_version == pm->mesh_version) {return;}
+  for (auto &peer : derived_peers) {
+    if (peer->derived_cycle == pm->ncycle && peer->derived_version == pm->mesh_version) {
+      derived_var = peer->derived_var;
+      derived_cycle = pm->ncycle;
+      derived_version = pm->mesh_version;
+      return;
+    }
+  }
+  ComputeDerivedVariable(out_params.variable, pm);
+  if (!(out_params.variable_2.empty())) {
+    ComputeDerivedVariable(out_params.variable_2, pm);
+  }
+  derived_cycle = pm->ncycle;
+  derived_version = pm->mesh_version;
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 // BaseTypeOutput::ComputeDerivedVariable()
 
@@ -1016,12 +1042,17 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
     bool &flat = coord.is_minkowski;
     Real &spin = coord.bh_spin;
 
-    // Radiation
-    int nang1 = pm->pmb_pack->prad->prgeo->nangles - 1;
+    // Radiation (with M1, coordinate frame moments are given by E, F^i and closure)
+    bool is_m1 = pm->pmb_pack->prad->is_m1;
+    int nang1 = -1;
+    DualArray1D<Real> solid_angles_;
+    if (!(is_m1)) {
+      nang1 = pm->pmb_pack->prad->prgeo->nangles - 1;
+      solid_angles_ = pm->pmb_pack->prad->prgeo->solid_angles;
+    }
     auto nh_c_ = pm->pmb_pack->prad->nh_c;
     auto tet_c_ = pm->pmb_pack->prad->tet_c;
     auto tetcov_c_ = pm->pmb_pack->prad->tetcov_c;
-    auto solid_angles_ = pm->pmb_pack->prad->prgeo->solid_angles;
     auto i0_ = pm->pmb_pack->prad->i0;
     auto norm_to_tet_ = pm->pmb_pack->prad->norm_to_tet;
 
@@ -1055,7 +1086,19 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
       Real n0 = tet_c_(m,0,0,k,j,i);
 
       // set coordinate frame components
-      for (int n1=0, n12=0; n1<4; ++n1) {
+      if (is_m1) {
+        Real pij[3][3];
+        M1Closure(i0_(m,IRE,k,j,i), i0_(m,IRF1,k,j,i), i0_(m,IRF2,k,j,i),
+                  i0_(m,IRF3,k,j,i), pij);
+        dv(m,0,k,j,i) = i0_(m,IRE,k,j,i);
+        dv(m,1,k,j,i) = i0_(m,IRF1,k,j,i);
+        dv(m,2,k,j,i) = i0_(m,IRF2,k,j,i);
+        dv(m,3,k,j,i) = i0_(m,IRF3,k,j,i);
+        for (int a=0, n12=4; a<3; ++a) {
+          for (int b=a; b<3; ++b, ++n12) { dv(m,n12,k,j,i) = pij[a][b]; }
+        }
+      }
+      for (int n1=0, n12=0; n1<4 && !(is_m1); ++n1) {
         for (int n2=n1; n2<4; ++n2, ++n12) {
           dv(m,n12,k,j,i) = 0.0;
           for (int n=0; n<=nang1; ++n) {
@@ -1181,31 +1224,10 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
     });
   }
 
-  // Particle density binned to mesh.
+  // Particle density deposited to mesh.
   if (name.compare("prtcl_d") == 0) {
     Kokkos::realloc(derived_var, nmb, 1, n3, n2, n1);
-    auto pdens = derived_var;
-    auto pr = pm->pmb_pack->ppart->prtcl_rdata;
-    auto pi = pm->pmb_pack->ppart->prtcl_idata;
-    int &npart = pm->nprtcl_thisrank;
-    int gids = pm->pmb_pack->gids;
-
-    par_for("pdens0", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
-    KOKKOS_LAMBDA(int m, int k, int j, int i) {
-      pdens(m,0,k,j,i) = 0.0;
-    });
-
-    par_for("pdens", DevExeSpace(), 0, (npart-1),
-    KOKKOS_LAMBDA(const int p) {
-      int m = pi(PGID,p) - gids;
-      int ip = (pr(IPX,p) - size.d_view(m).x1min)/size.d_view(m).dx1 + is;
-      int jp = (pr(IPY,p) - size.d_view(m).x2min)/size.d_view(m).dx2 + js;
-      int kp = ks;
-      if (three_d) {
-        kp = (pr(IPZ,p) - size.d_view(m).x3min)/size.d_view(m).dx3 + ks;
-      }
-      pdens(m,0,kp,jp,ip) += 1.0;
-    });
+    pm->pmb_pack->ppart->DepositDensity(derived_var);
   }
   i_dv = i_dv % n_dv; // reset derived variable index
 }
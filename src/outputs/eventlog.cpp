@@ -18,6 +18,8 @@
 #include "athena.hpp"
 #include "globals.hpp"
 #include "mesh/mesh.hpp"
+#include "hydro/hydro.hpp"
+#include "mhd/mhd.hpp"
 #include "outputs.hpp"
 
 //----------------------------------------------------------------------------------------
@@ -33,22 +35,49 @@ EventLogOutput::EventLogOutput(ParameterInput *pin, Mesh *pm, OutputParameters o
 //! \brief sums event counter data across MPI ranks
 
 void EventLogOutput::LoadOutputData(Mesh *pm) {
+  // rows of faces using each Riemann solver with rsolver_hybrid are counted on the
+  // device, so copy them to the event counters (and reset them) only here
+  DvceArray1D<int> rs_nrow[2];
+  if (pm->pmb_pack->phydro != nullptr && pm->pmb_pack->phydro->rsolver_hybrid) {
+    rs_nrow[0] = pm->pmb_pack->phydro->rs_nrow;
+  }
+  if (pm->pmb_pack->pmhd != nullptr && pm->pmb_pack->pmhd->rsolver_hybrid) {
+    rs_nrow[1] = pm->pmb_pack->pmhd->rs_nrow;
+  }
+  for (auto &nrow : rs_nrow) {
+    if (nrow.extent(0) < 2) continue;
+    auto nrow_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), nrow);
+    pm->ecounter.nrs_full += nrow_h(0);
+    pm->ecounter.nrs_hlle += nrow_h(1);
+    Kokkos::deep_copy(nrow, 0);
+  }
+
 #if MPI_PARALLEL_ENABLED
-  // perform in-place sum or max over all MPI ranks, depending on counter
-  int* pdfloor = &(pm->ecounter.neos_dfloor);
-  int* pefloor = &(pm->ecounter.neos_efloor);
-  int* ptfloor = &(pm->ecounter.neos_tfloor);
-  int* pvceil  = &(pm->ecounter.neos_vceil);
-  int* pfail   = &(pm->ecounter.neos_fail);
-  int* pmaxit  = &(pm->ecounter.maxit_c2p);
-  int* pfofc   = &(pm->ecounter.nfofc);
-  MPI_Allreduce(MPI_IN_PLACE, pdfloor, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-  MPI_Allreduce(MPI_IN_PLACE, pefloor, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-  MPI_Allreduce(MPI_IN_PLACE, ptfloor, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-  MPI_Allreduce(MPI_IN_PLACE, pvceil,  1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-  MPI_Allreduce(MPI_IN_PLACE, pfail,   1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-  MPI_Allreduce(MPI_IN_PLACE, pmaxit,  1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
-  MPI_Allreduce(MPI_IN_PLACE, pfofc,   1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  // sum or max over all MPI ranks (depending on counter), batched into two reductions
+  EventCounters &ec = pm->ecounter;
+  GlobalReductions &gr = pm->greduce;
+  gr.Clear();
+  int hdfloor = gr.Add("eos_dfloor", ec.neos_dfloor, ReduceOp::sum);
+  int hefloor = gr.Add("eos_efloor", ec.neos_efloor, ReduceOp::sum);
+  int htfloor = gr.Add("eos_tfloor", ec.neos_tfloor, ReduceOp::sum);
+  int hvceil  = gr.Add("eos_vceil",  ec.neos_vceil,  ReduceOp::sum);
+  int hfail   = gr.Add("eos_fail",   ec.neos_fail,   ReduceOp::sum);
+  int hmaxit  = gr.Add("c2p_it",     ec.maxit_c2p,   ReduceOp::max);
+  int hfofc   = gr.Add("fofc",       ec.nfofc,       ReduceOp::sum);
+  int hrsfull = gr.Add("rs_full",    ec.nrs_full,    ReduceOp::sum);
+  int hrshlle = gr.Add("rs_hlle",    ec.nrs_hlle,    ReduceOp::sum);
+  gr.Start();
+  gr.Finish();
+  ec.neos_dfloor = static_cast<int>(gr.Result(hdfloor));
+  ec.neos_efloor = static_cast<int>(gr.Result(hefloor));
+  ec.neos_tfloor = static_cast<int>(gr.Result(htfloor));
+  ec.neos_vceil  = static_cast<int>(gr.Result(hvceil));
+  ec.neos_fail   = static_cast<int>(gr.Result(hfail));
+  ec.maxit_c2p   = static_cast<int>(gr.Result(hmaxit));
+  ec.nfofc       = static_cast<int>(gr.Result(hfofc));
+  ec.nrs_full    = static_cast<int>(gr.Result(hrsfull));
+  ec.nrs_hlle    = static_cast<int>(gr.Result(hrshlle));
+  gr.Clear();
 #endif
 
   // check if there is any data to be written
@@ -59,7 +88,8 @@ void EventLogOutput::LoadOutputData(Mesh *pm) {
       pm->ecounter.neos_vceil  > 0 ||
       pm->ecounter.neos_fail   > 0 ||
       pm->ecounter.nfofc > 0 ||
-      pm->ecounter.maxit_c2p > 0) {
+      pm->ecounter.maxit_c2p > 0 ||
+      pm->ecounter.nrs_full + pm->ecounter.nrs_hlle > 0) {
     no_output=false;
   }
 }
@@ -91,7 +121,7 @@ void EventLogOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
     if (!(header_written)) {
       std::fprintf(pfile,"# Athena event counter data\n");
       std::fprintf(pfile,"#  cycle eos_dfloor eos_efloor eos_tfloor eos_vceil");
-      std::fprintf(pfile," eos_fail c2p_it fofc");
+      std::fprintf(pfile," eos_fail c2p_it fofc rs_full rs_hlle");
       std::fprintf(pfile,"\n");  // terminate line
       header_written = true;
     }
@@ -106,6 +136,8 @@ void EventLogOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
       std::fprintf(pfile, " %8d", pm->ecounter.neos_fail);
       std::fprintf(pfile, " %6d", pm->ecounter.maxit_c2p);
       std::fprintf(pfile, " %8d", pm->ecounter.nfofc);
+      std::fprintf(pfile, " %8d", pm->ecounter.nrs_full);
+      std::fprintf(pfile, " %8d", pm->ecounter.nrs_hlle);
       std::fprintf(pfile,"\n"); // terminate line
     }
     std::fclose(pfile);
@@ -119,6 +151,8 @@ void EventLogOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
   pm->ecounter.neos_fail = 0;
   pm->ecounter.maxit_c2p = 0;
   pm->ecounter.nfofc = 0;
+  pm->ecounter.nrs_full = 0;
+  pm->ecounter.nrs_hlle = 0;
 
   // increment output time, clean up
   if (out_params.last_time < 0.0) {
@@ -0,0 +1,303 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file hdf5_mesh.cpp
+//! \brief writes output data in HDF5 format.  All output variables are stored in a
+//! single 5D dataset "uov" with dims (variable, MeshBlock, k, j, i) in order of "gid",
+//! chunked so that each chunk holds one variable on one MeshBlock.  Analysis tools can
+//! then read any subset of variables and MeshBlocks without reading the whole file.
+//! Datasets "Levels", "LogicalLocations" and "MeshBlockSize" store the physical
+//! refinement level, logical location, and physical size of each MeshBlock.  Chunks can
+//! optionally be compressed with the lossless deflate filter by setting
+//! compression_level (1-9) in the <output> block, which with MPI requires a parallel HDF5
+//! library (version 1.10.2 or later) that supports filters with collective writes.
+//!
+//! Error-bounded lossy compression is enabled by setting rel_tolerance (for all
+//! variables) and/or rel_tolerance_<label> (for variable <label>) in the <output> block.
+//! Data are then rounded to the fewest mantissa bits that keep the relative error of each
+//! value below the tolerance, so that the trailing zero bits are removed by the deflate
+//! filter (compression_level is set to 1 if not specified).
+
+#include <sys/stat.h>  // mkdir
+
+#include <algorithm>
+#include <cstdio>      // snprintf()
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>     // memcpy()
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "outputs.hpp"
+
+#if HDF5_OUTPUT_ENABLED
+#include <hdf5.h>
+
+//----------------------------------------------------------------------------------------
+// Constructor: also calls BaseTypeOutput base class constructor
+
+MeshHDF5Output::MeshHDF5Output(ParameterInput *pin, Mesh *pm, OutputParameters op) :
+  BaseTypeOutput(pin, pm, op) {
+  // create directories for outputs. Comments in binary.cpp constructor explain why
+  mkdir("hdf5",0775);
+
+  // read relative error tolerance of each output variable, and convert to number of
+  // mantissa bits retained in single precision (23 means data is not rounded)
+  Real tol = pin->GetOrAddReal(op.block_name, "rel_tolerance", 0.0);
+  bool lossy = false;
+  for (auto &var : outvars) {
+    Real vtol = pin->GetOrAddReal(op.block_name, "rel_tolerance_" + var.label, tol);
+    int nbits = 23;
+    if (vtol > 0.0) {
+      // rounding to nbits mantissa bits gives relative error <= 2^-(nbits+1)
+      nbits = static_cast<int>(std::ceil(-std::log2(vtol))) - 1;
+      nbits = std::min(std::max(nbits, 0), 23);
+      lossy = true;
+    }
+    mantissa_bits.push_back(nbits);
+  }
+  if (lossy && out_params.compression_level == 0) {out_params.compression_level = 1;}
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn float RoundMantissa()
+//  \brief rounds single precision value to nearest value with only nbits mantissa bits.
+//  Inf and NaN are returned unchanged.
+
+static float RoundMantissa(float val, int nbits) {
+  if (nbits >= 23) {return val;}
+  std::uint32_t bits;
+  std::memcpy(&bits, &val, sizeof(bits));
+  if ((bits & 0x7f800000u) == 0x7f800000u) {return val;}
+  int drop = 23 - nbits;
+  bits += (1u << (drop - 1));
+  bits &= ~((1u << drop) - 1);
+  std::memcpy(&val, &bits, sizeof(bits));
+  return val;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshHDF5Output:::WriteOutputFile(Mesh *pm)
+//  \brief Writes OutputData over all MeshBlocks to a single HDF5 file, in parallel.
+
+void MeshHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
+  // create filename: "hdf5/file_basename" + "." + "file_id" + "." + XXXXX + ".h5"
+  // where XXXXX = 5-digit file_number
+  std::string fname;
+  char number[6];
+  std::snprintf(number, sizeof(number), "%05d", out_params.file_number);
+
+  fname.assign("hdf5/");
+  fname.append(out_params.file_basename);
+  fname.append(".");
+  fname.append(out_params.file_id);
+  fname.append(".");
+  fname.append(number);
+  fname.append(".h5");
+
+  // number of output variables and MBs on this rank, and over all ranks
+  int nout_vars = outvars.size();
+  int nout_mbs = outmbs.size();
+  int nout_mbs_total = std::accumulate(noutmbs.begin(), noutmbs.end(), 0);
+  std::vector<int> rank_offset(global_variable::nranks, 0);
+  std::partial_sum(noutmbs.begin(),std::prev(noutmbs.end()),
+                   std::next(rank_offset.begin()));
+  hsize_t mboffset = rank_offset[global_variable::my_rank];
+
+  // cells output per MB are the same on every MB (and every rank)
+  auto &indcs = pm->mb_indcs;
+  int nout1, nout2, nout3;
+  if (out_params.include_gzs) {
+    nout1 = indcs.nx1 + 2*(indcs.ng);
+    nout2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
+    nout3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
+  } else {
+    nout1 = indcs.nx1;
+    nout2 = indcs.nx2;
+    nout3 = indcs.nx3;
+  }
+  if (out_params.slice1) {nout1 = 1;}
+  if (out_params.slice2) {nout2 = 1;}
+  if (out_params.slice3) {nout3 = 1;}
+
+  // open file, using MPI-IO with MPI
+  hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+  hid_t dxpl = H5Pcreate(H5P_DATASET_XFER);
+#if MPI_PARALLEL_ENABLED
+  H5Pset_fapl_mpio(fapl, global_variable::athena_comm, MPI_INFO_NULL);
+  H5Pset_dxpl_mpio(dxpl, H5FD_MPIO_COLLECTIVE);
+#endif
+  hid_t file = H5Fcreate(fname.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+  if (file < 0) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Output file '" << fname << "' could not be opened"
+              << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // write attributes: time, cycle, number of MeshBlocks, and variable names
+  {
+    hid_t scalar = H5Screate(H5S_SCALAR);
+    hid_t attr = H5Acreate2(file, "Time", H5T_NATIVE_DOUBLE, scalar, H5P_DEFAULT,
+                            H5P_DEFAULT);
+    double time = static_cast<double>(pm->time);
+    H5Awrite(attr, H5T_NATIVE_DOUBLE, &time);
+    H5Aclose(attr);
+    attr = H5Acreate2(file, "NCycle", H5T_NATIVE_INT, scalar, H5P_DEFAULT, H5P_DEFAULT);
+    H5Awrite(attr, H5T_NATIVE_INT, &(pm->ncycle));
+    H5Aclose(attr);
+    attr = H5Acreate2(file, "NumMeshBlocks", H5T_NATIVE_INT, scalar, H5P_DEFAULT,
+                      H5P_DEFAULT);
+    H5Awrite(attr, H5T_NATIVE_INT, &nout_mbs_total);
+    H5Aclose(attr);
+    H5Sclose(scalar);
+
+    std::string names;
+    std::size_t maxlen = 1;
+    for (int n=0; n<nout_vars; ++n) {maxlen = std::max(maxlen, outvars[n].label.size());}
+    for (int n=0; n<nout_vars; ++n) {
+      names.append(outvars[n].label);
+      names.append(maxlen - outvars[n].label.size(), '\0');
+    }
+    hid_t strtype = H5Tcopy(H5T_C_S1);
+    H5Tset_size(strtype, maxlen);
+    hsize_t nnames = nout_vars;
+    hid_t space = H5Screate_simple(1, &nnames, nullptr);
+    attr = H5Acreate2(file, "VariableNames", strtype, space, H5P_DEFAULT, H5P_DEFAULT);
+    H5Awrite(attr, strtype, names.data());
+    H5Aclose(attr);
+    attr = H5Acreate2(file, "MantissaBits", H5T_NATIVE_INT, space, H5P_DEFAULT,
+                      H5P_DEFAULT);
+    H5Awrite(attr, H5T_NATIVE_INT, mantissa_bits.data());
+    H5Aclose(attr);
+    H5Sclose(space);
+    H5Tclose(strtype);
+  }
+
+  // write levels and logical locations (lx1,lx2,lx3), and physical size of each MB
+  {
+    std::vector<int> levels(nout_mbs);
+    std::vector<int> llocs(3*nout_mbs);
+    std::vector<double> sizes(6*nout_mbs);
+    for (int m=0; m<nout_mbs; ++m) {
+      LogicalLocation loc = pm->lloc_eachmb[outmbs[m].mb_gid];
+      levels[m] = loc.level - pm->root_level;
+      llocs[3*m  ] = loc.lx1;
+      llocs[3*m+1] = loc.lx2;
+      llocs[3*m+2] = loc.lx3;
+      sizes[6*m  ] = outmbs[m].x1min;
+      sizes[6*m+1] = outmbs[m].x1max;
+      sizes[6*m+2] = outmbs[m].x2min;
+      sizes[6*m+3] = outmbs[m].x2max;
+      sizes[6*m+4] = outmbs[m].x3min;
+      sizes[6*m+5] = outmbs[m].x3max;
+    }
+    const char *dset_names[3] = {"Levels", "LogicalLocations", "MeshBlockSize"};
+    const hsize_t ncols[3] = {1, 3, 6};
+    const void *dset_data[3] = {levels.data(), llocs.data(), sizes.data()};
+    hid_t types[3] = {H5T_NATIVE_INT, H5T_NATIVE_INT, H5T_NATIVE_DOUBLE};
+    for (int d=0; d<3; ++d) {
+      hsize_t fdims[2] = {static_cast<hsize_t>(nout_mbs_total), ncols[d]};
+      hsize_t mdims[2] = {static_cast<hsize_t>(nout_mbs), ncols[d]};
+      hsize_t start[2] = {mboffset, 0};
+      hid_t fspace = H5Screate_simple(2, fdims, nullptr);
+      hid_t mspace = H5Screate_simple(2, mdims, nullptr);
+      hid_t dset = H5Dcreate2(file, dset_names[d], types[d], fspace, H5P_DEFAULT,
+                              H5P_DEFAULT, H5P_DEFAULT);
+      if (nout_mbs > 0) {
+        H5Sselect_hyperslab(fspace, H5S_SELECT_SET, start, nullptr, mdims, nullptr);
+      } else {
+        H5Sselect_none(fspace);
+        H5Sselect_none(mspace);
+      }
+      H5Dwrite(dset, types[d], mspace, fspace, dxpl, dset_data[d]);
+      H5Dclose(dset);
+      H5Sclose(mspace);
+      H5Sclose(fspace);
+    }
+  }
+
+  // write data over all variables and MBs with one (collective) call, stored as floats
+  // in chunks of one variable on one MeshBlock
+  {
+    std::size_t cells = static_cast<std::size_t>(nout1)*nout2*nout3;
+    std::vector<float> data(nout_vars*nout_mbs*cells);
+    for (int n=0; n<nout_vars; ++n) {
+      int nbits = mantissa_bits[n];
+      for (int m=0; m<nout_mbs; ++m) {
+        float *pdata = &(data[(n*nout_mbs + m)*cells]);
+        for (int k=0; k<nout3; ++k) {
+          for (int j=0; j<nout2; ++j) {
+            for (int i=0; i<nout1; ++i) {
+              *pdata++ = RoundMantissa(static_cast<float>(outarray(n,m,k,j,i)), nbits);
+            }
+          }
+        }
+      }
+    }
+
+    hsize_t fdims[5] = {static_cast<hsize_t>(nout_vars),
+                        static_cast<hsize_t>(nout_mbs_total),
+                        static_cast<hsize_t>(nout3), static_cast<hsize_t>(nout2),
+                        static_cast<hsize_t>(nout1)};
+    hsize_t mdims[5] = {fdims[0], static_cast<hsize_t>(nout_mbs), fdims[2], fdims[3],
+                        fdims[4]};
+    hsize_t chunk[5] = {1, 1, fdims[2], fdims[3], fdims[4]};
+    hsize_t start[5] = {0, mboffset, 0, 0, 0};
+    hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    if (nout_vars > 0 && nout_mbs_total > 0) {
+      H5Pset_chunk(dcpl, 5, chunk);
+      if (out_params.compression_level > 0) {
+        H5Pset_shuffle(dcpl);
+        H5Pset_deflate(dcpl, out_params.compression_level);
+      }
+    }
+    hid_t fspace = H5Screate_simple(5, fdims, nullptr);
+    hid_t mspace = H5Screate_simple(5, mdims, nullptr);
+    hid_t dset = H5Dcreate2(file, "uov", H5T_NATIVE_FLOAT, fspace, H5P_DEFAULT, dcpl,
+                            H5P_DEFAULT);
+    if (nout_mbs > 0 && nout_vars > 0) {
+      H5Sselect_hyperslab(fspace, H5S_SELECT_SET, start, nullptr, mdims, nullptr);
+    } else {
+      H5Sselect_none(fspace);
+      H5Sselect_none(mspace);
+    }
+    if (H5Dwrite(dset, H5T_NATIVE_FLOAT, mspace, fspace, dxpl, data.data()) < 0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+          << std::endl << "data not written correctly to HDF5 file, "
+          << "HDF5 file is broken." << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    H5Dclose(dset);
+    H5Sclose(mspace);
+    H5Sclose(fspace);
+    H5Pclose(dcpl);
+  }
+
+  // close the output file
+  H5Pclose(dxpl);
+  H5Pclose(fapl);
+  H5Fclose(file);
+
+  // increment counters
+  out_params.file_number++;
+  if (out_params.last_time < 0.0) {
+    out_params.last_time = pm->time;
+  } else {
+    out_params.last_time += out_params.dt;
+  }
+  pin->SetInteger(out_params.block_name, "file_number", out_params.file_number);
+  pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
+
+  return;
+}
+#endif // HDF5_OUTPUT_ENABLED
@@ -13,6 +13,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "athena.hpp"
 #include "globals.hpp"
@@ -21,13 +22,42 @@
 #include "hydro/hydro.hpp"
 #include "mhd/mhd.hpp"
 #include "z4c/z4c.hpp"
+#include "pgen/pgen.hpp"
 #include "outputs.hpp"
 
+namespace {
+//----------------------------------------------------------------------------------------
+//! \fn int AppendHookLabels()
+//! \brief Appends labels of user history variables defined as a device hook (see
+//! pgen/user_hooks.hpp) to those of the physics module in pdata, and updates the hook.
+//! Returns the index of the first user variable.
+
+int AppendHookLabels(HistoryData *pdata, Mesh *pm) {
+  int nh0 = pdata->nhist;
+  if constexpr (user_hooks::HistoryTerms::enabled) {
+    constexpr int nuser = user_hooks::HistoryTerms::nhist;
+    if (nh0 + nuser > NHISTORY_VARIABLES) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Number of history variables (" << nh0 + nuser
+                << ") including user hook exceeds NHISTORY_VARIABLES="
+                << NHISTORY_VARIABLES << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    auto &hook = pm->pgen->user_hist_hook;
+    for (int n=0; n<nuser; ++n) {pdata->label[nh0+n] = hook.Label(n);}
+    pdata->nhist += nuser;
+    hook.Update(pm);
+  }
+  return nh0;
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------
 // Constructor: also calls BaseTypeOutput base class constructor
 
 HistoryOutput::HistoryOutput(ParameterInput *pin, Mesh *pm, OutputParameters op) :
-  BaseTypeOutput(pin, pm, op) {
+  BaseTypeOutput(pin, pm, op),
+  pz4c_con(nullptr) {
   // cycle through physics modules and add HistoryData struct for each
   hist_data.clear();
 
@@ -47,9 +77,19 @@ HistoryOutput::HistoryOutput(ParameterInput *pin, Mesh *pm, OutputParameters op)
 
   if (pm->pmb_pack->pz4c != nullptr) {
     hist_data.emplace_back(PhysicsModule::SpaceTimeDynamics);
+    pz4c_con = &(pm->pmb_pack->pz4c->u_con);
   }
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn bool HistoryOutput::ReadsArray()
+//  \brief history data are computed from the conserved variables, which are always
+//  current, except for the z4c constraint norms which are only computed when needed
+
+bool HistoryOutput::ReadsArray(const DvceArray5D<Real> *parray) const {
+  return (parray == pz4c_con);
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void HistoryOutput::LoadOutputData()
 //  \brief Wrapper function that cycles through hist_data vector and calls
@@ -94,10 +134,13 @@ void HistoryOutput::LoadHydroHistoryData(HistoryData *pdata, Mesh *pm) {
   pdata->label[nhydro_  ] = "1-KE";
   pdata->label[nhydro_+1] = "2-KE";
   pdata->label[nhydro_+2] = "3-KE";
+  // user history variables (if any) are computed in the same kernel
+  int nh0 = AppendHookLabels(pdata, pm);
 
   // capture class variables for kernel
   auto &u0_ = pm->pmb_pack->phydro->u0;
   auto &size = pm->pmb_pack->pmb->mb_size;
+  auto user_hist = pm->pgen->user_hist_hook;
   int &nhist_ = pdata->nhist;
 
   // loop over all MeshBlocks in this pack
@@ -137,10 +180,15 @@ void HistoryOutput::LoadHydroHistoryData(HistoryData *pdata, Mesh *pm) {
     hvars.the_array[nhydro_+2] = vol*0.5*SQR(u0_(m,IM3,k,j,i))/u0_(m,IDN,k,j,i);
 
     // fill rest of the_array with zeros, if nhist < NHISTORY_VARIABLES
-    for (int n=nhist_; n<NHISTORY_VARIABLES; ++n) {
+    for (int n=nh0; n<NHISTORY_VARIABLES; ++n) {
       hvars.the_array[n] = 0.0;
     }
 
+    // user history variables
+    if constexpr (user_hooks::HistoryTerms::enabled) {
+      if (nhist_ > nh0) {user_hist(m,k,j,i,vol,&(hvars.the_array[nh0]));}
+    }
+
     // sum into parallel reduce
     mb_sum += hvars;
   }, Kokkos::Sum<array_sum::GlobalSum>(sum_this_mb));
@@ -255,8 +303,12 @@ void HistoryOutput::LoadMHDHistoryData(HistoryData *pdata, Mesh *pm) {
   pdata->label[nmhd_+3] = "1-ME";
   pdata->label[nmhd_+4] = "2-ME";
   pdata->label[nmhd_+5] = "3-ME";
+  // user history variables (if any) are computed in the same kernel, unless added to
+  // those of Hydro
+  int nh0 = (pm->pmb_pack->phydro == nullptr)? AppendHookLabels(pdata, pm) : pdata->nhist;
 
   // capture class variabels for kernel
+  auto user_hist = pm->pgen->user_hist_hook;
   auto &u0_ = pm->pmb_pack->pmhd->u0;
   auto &bx1f = pm->pmb_pack->pmhd->b0.x1f;
   auto &bx2f = pm->pmb_pack->pmhd->b0.x2f;
@@ -306,14 +358,18 @@ void HistoryOutput::LoadMHDHistoryData(HistoryData *pdata, Mesh *pm) {
     hvars.the_array[nmhd_+5] = vol*0.25*(SQR(bx3f(m,k+1,j,i)) + SQR(bx3f(m,k,j,i)));
 
     // fill rest of the_array with zeros, if nhist < NHISTORY_VARIABLES
-    for (int n=nhist_; n<NHISTORY_VARIABLES; ++n) {
+    for (int n=nh0; n<NHISTORY_VARIABLES; ++n) {
       hvars.the_array[n] = 0.0;
     }
 
+    // user history variables
+    if constexpr (user_hooks::HistoryTerms::enabled) {
+      if (nhist_ > nh0) {user_hist(m,k,j,i,vol,&(hvars.the_array[nh0]));}
+    }
+
     // sum into parallel reduce
     mb_sum += hvars;
   }, Kokkos::Sum<array_sum::GlobalSum>(sum_this_mb));
-  Kokkos::fence();
 
   // store data into hdata array
   for (int n=0; n<pdata->nhist; ++n) {
@@ -324,24 +380,80 @@ void HistoryOutput::LoadMHDHistoryData(HistoryData *pdata, Mesh *pm) {
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn void HistoryOutput::WriteOutputFile()
-//  \brief Cycles through hist_data vector and writes history file for each component
+//! \fn void HistoryOutput::ReduceHistoryData()
+//  \brief Reduces history variables of all physics modules over MPI ranks to the master
+//  rank.  Variables of all modules are packed into one buffer of sums and one buffer of
+//  maxima (minima are stored negated), which are reduced concurrently with non-blocking
+//  calls, rather than with separate blocking calls for each module.
 
-void HistoryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
-  for (auto &data : hist_data) {
-    // first, perform in-place sum over all MPI ranks
+void HistoryOutput::ReduceHistoryData() {
 #if MPI_PARALLEL_ENABLED
-    if (global_variable::my_rank == 0) {
-      MPI_Reduce(MPI_IN_PLACE, &(data.hdata[0]), data.nhist, MPI_ATHENA_REAL,
-         MPI_SUM, 0, MPI_COMM_WORLD);
-    } else {
-      MPI_Reduce(&(data.hdata[0]), &(data.hdata[0]), data.nhist,
-         MPI_ATHENA_REAL, MPI_SUM, 0, MPI_COMM_WORLD);
+  std::vector<Real> sbuf, mbuf;
+  for (auto &data : hist_data) {
+    for (int n=0; n<data.nhist; ++n) {
+      if (data.op[n] == HistoryMax) {
+        mbuf.push_back(data.hdata[n]);
+      } else if (data.op[n] == HistoryMin) {
+        mbuf.push_back(-data.hdata[n]);
+      } else {
+        sbuf.push_back(data.hdata[n]);
+      }
     }
+  }
+  int nsum = static_cast<int>(sbuf.size()), nmax = static_cast<int>(mbuf.size());
+  bool root = (global_variable::my_rank == 0);
+  MPI_Request req[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+  if (nsum > 0) {
+    MPI_Ireduce((root)? MPI_IN_PLACE : sbuf.data(), sbuf.data(), nsum, MPI_ATHENA_REAL,
+                MPI_SUM, 0, global_variable::athena_comm, &req[0]);
+  }
+  if (nmax > 0) {
+    MPI_Ireduce((root)? MPI_IN_PLACE : mbuf.data(), mbuf.data(), nmax, MPI_ATHENA_REAL,
+                MPI_MAX, 0, global_variable::athena_comm, &req[1]);
+  }
+  MPI_Waitall(2, req, MPI_STATUSES_IGNORE);
+  if (!(root)) return;
+
+  int is = 0, im = 0;
+  for (auto &data : hist_data) {
+    for (int n=0; n<data.nhist; ++n) {
+      if (data.op[n] == HistoryMax) {
+        data.hdata[n] = mbuf[im++];
+      } else if (data.op[n] == HistoryMin) {
+        data.hdata[n] = -mbuf[im++];
+      } else {
+        data.hdata[n] = sbuf[is++];
+      }
+    }
+  }
 #endif
+  return;
+}
 
+//----------------------------------------------------------------------------------------
+//! \fn void HistoryOutput::WriteOutputFile()
+//  \brief Cycles through hist_data vector and writes history file for each component
+
+void HistoryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
+  // first, reduce data of all components over all MPI ranks
+  ReduceHistoryData();
+
+  for (auto &data : hist_data) {
     // only the master rank writes the file
     if (global_variable::my_rank == 0) {
+      // with reflection symmetry, convert sums of built-in modules over the Mesh to sums
+      // over the full domain, in which momenta normal to the planes of symmetry vanish
+      if (pm->symmetry_factor > 1.0 && data.physics != PhysicsModule::UserDefined) {
+        for (int n=0; n<data.nhist; ++n) {
+          if (data.op[n] == HistorySum) {data.hdata[n] *= pm->symmetry_factor;}
+        }
+        if (data.physics == PhysicsModule::HydroDynamics ||
+            data.physics == PhysicsModule::MagnetoHydroDynamics) {
+          for (int d=0; d<3; ++d) {
+            if (pm->symmetric[d]) {data.hdata[IM1+d] = 0.0;}
+          }
+        }
+      }
       // create filename: "file_basename" + ".physics" + ".hst"
       // There is no file number or id in history output filenames.
       std::string fname;
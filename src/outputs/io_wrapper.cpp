@@ -6,8 +6,11 @@
 //! \file io_wrapper.cpp
 //! \brief functions that provide wrapper for MPI-IO versus serial input/output
 
+#include <algorithm>
+#include <array>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -15,8 +18,63 @@
 #include <string>
 
 #include "athena.hpp"
+#include "parameter_input.hpp"
 #include "io_wrapper.hpp"
 
+#if MPI_PARALLEL_ENABLED
+MPI_Info IOWrapper::write_info_ = MPI_INFO_NULL;
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \fn void IOWrapper::SetWriteHints(ParameterInput *pin)
+//! \brief Sets MPI-IO hints used when files are opened for writing, read from optional
+//! parameters in the <job> block:
+//!   io_aggregators_per_node = # of ranks per node that gather data and write to file
+//!                             during collective writes (ROMIO "cb_config_list")
+//!   io_aggregators          = total # of aggregator ranks ("cb_nodes")
+//!   io_buffer_size          = size in bytes of buffer on each aggregator
+//!   io_striping_factor      = # of file system stripes (OSTs) for new files (Lustre)
+//!   io_striping_unit        = size in bytes of each stripe (Lustre)
+//! Values <= 0 (the default) leave the choice to the MPI library.  Hints are only applied
+//! when a file is created, and are silently ignored by MPI libraries that do not
+//! recognize them.
+
+void IOWrapper::SetWriteHints(ParameterInput *pin) {
+#if MPI_PARALLEL_ENABLED
+  int naggr_node = pin->GetOrAddInteger("job", "io_aggregators_per_node", 0);
+  int naggr = pin->GetOrAddInteger("job", "io_aggregators", 0);
+  int buf_size = pin->GetOrAddInteger("job", "io_buffer_size", 0);
+  int stripe_factor = pin->GetOrAddInteger("job", "io_striping_factor", 0);
+  int stripe_unit = pin->GetOrAddInteger("job", "io_striping_unit", 0);
+  if (naggr_node <= 0 && naggr <= 0 && buf_size <= 0 && stripe_factor <= 0 &&
+      stripe_unit <= 0) {return;}
+
+  if (write_info_ != MPI_INFO_NULL) {MPI_Info_free(&write_info_);}
+  MPI_Info_create(&write_info_);
+  if (naggr_node > 0 || naggr > 0) {
+    // force two-phase collective buffering so only aggregators access the file
+    MPI_Info_set(write_info_, "romio_cb_write", "enable");
+  }
+  if (naggr_node > 0) {
+    std::string list = "*:" + std::to_string(naggr_node);
+    MPI_Info_set(write_info_, "cb_config_list", list.c_str());
+  }
+  if (naggr > 0) {
+    MPI_Info_set(write_info_, "cb_nodes", std::to_string(naggr).c_str());
+  }
+  if (buf_size > 0) {
+    MPI_Info_set(write_info_, "cb_buffer_size", std::to_string(buf_size).c_str());
+  }
+  if (stripe_factor > 0) {
+    MPI_Info_set(write_info_, "striping_factor", std::to_string(stripe_factor).c_str());
+  }
+  if (stripe_unit > 0) {
+    MPI_Info_set(write_info_, "striping_unit", std::to_string(stripe_unit).c_str());
+  }
+#endif
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn int IOWrapper::Open(const char* fname, FileMode rw)
 //! \brief wrapper for {MPI_File_open} versus {std::fopen} including error check
@@ -32,7 +90,7 @@ int IOWrapper::Open(const char* fname, FileMode rw) {
       int resultlen;
       MPI_Error_string(errcode, msg, &resultlen);
       printf("%.*s\n", resultlen, msg);
-      MPI_Abort(MPI_COMM_WORLD, 1);
+      MPI_Abort(global_variable::athena_comm, 1);
       std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
                 << std::endl << "Input file '" << fname << "' could not be opened"
                 << std::endl;
@@ -52,13 +110,13 @@ int IOWrapper::Open(const char* fname, FileMode rw) {
 #if MPI_PARALLEL_ENABLED
     MPI_File_delete(fname, MPI_INFO_NULL); // truncation
     int errcode = MPI_File_open(comm_, fname, MPI_MODE_WRONLY | MPI_MODE_CREATE,
-                                MPI_INFO_NULL, &fh_);
+                                write_info_, &fh_);
     if (errcode != MPI_SUCCESS) {
       char msg[MPI_MAX_ERROR_STRING];
       int resultlen;
       MPI_Error_string(errcode, msg, &resultlen);
       printf("%.*s\n", resultlen, msg);
-      MPI_Abort(MPI_COMM_WORLD, 1);
+      MPI_Abort(global_variable::athena_comm, 1);
       std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
                 << std::endl << "Input file '" << fname << "' could not be opened"
                 << std::endl;
@@ -77,13 +135,13 @@ int IOWrapper::Open(const char* fname, FileMode rw) {
   } else if (rw == FileMode::append) {
 #if MPI_PARALLEL_ENABLED
     int errcode = MPI_File_open(comm_, fname, MPI_MODE_WRONLY + MPI_MODE_APPEND,
-                                MPI_INFO_NULL, &fh_);
+                                write_info_, &fh_);
     if (errcode != MPI_SUCCESS) {
       char msg[MPI_MAX_ERROR_STRING];
       int resultlen;
       MPI_Error_string(errcode, msg, &resultlen);
       printf("%.*s\n", resultlen, msg);
-      MPI_Abort(MPI_COMM_WORLD, 1);
+      MPI_Abort(global_variable::athena_comm, 1);
       std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
                 << std::endl << "Input file '" << fname << "' could not be appended"
                 << std::endl;
@@ -104,12 +162,28 @@ int IOWrapper::Open(const char* fname, FileMode rw) {
   return true;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn int IOWrapper::Open(std::shared_ptr<IOWrapperImage> image)
+//! \brief opens an in-memory restart image for reads (once published) or writes, instead
+//! of a file.  All subsequent calls read or write the image until Close().
+
+int IOWrapper::Open(std::shared_ptr<IOWrapperImage> image) {
+  image_ = image;
+  image_->pos = 0;
+  return true;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn int IOWrapper::Read_bytes(void *buf, IOWrapperSizeT size, IOWrapperSizeT cnt)
 //! \brief wrapper for {MPI_File_read} versus {std::fread}.  Returns number of byte-blocks
 //! of given "size" actually read.
 
 std::size_t IOWrapper::Read_bytes(void *buf, IOWrapperSizeT size, IOWrapperSizeT cnt) {
+  if (image_ != nullptr) {
+    std::size_t nread = ReadImage(buf, cnt*size, image_->pos);
+    image_->pos += nread;
+    return nread/size;
+  }
 #if MPI_PARALLEL_ENABLED
   MPI_Status status;
   int errcode = MPI_File_read(fh_, buf, cnt*size, MPI_BYTE, &status);
@@ -136,6 +210,7 @@ std::size_t IOWrapper::Read_bytes(void *buf, IOWrapperSizeT size, IOWrapperSizeT
 
 std::size_t IOWrapper::Read_bytes_at(void *buf, IOWrapperSizeT size,
                                      IOWrapperSizeT cnt, IOWrapperSizeT offset) {
+  if (image_ != nullptr) {return ReadImage(buf, cnt*size, offset)/size;}
 #if MPI_PARALLEL_ENABLED
   MPI_Status status;
   int errcode = MPI_File_read_at(fh_, offset, buf, cnt*size, MPI_BYTE, &status);
@@ -163,6 +238,7 @@ std::size_t IOWrapper::Read_bytes_at(void *buf, IOWrapperSizeT size,
 
 std::size_t IOWrapper::Read_bytes_at_all(void *buf, IOWrapperSizeT size,
                                          IOWrapperSizeT cnt, IOWrapperSizeT offset) {
+  if (image_ != nullptr) {return ReadImage(buf, cnt*size, offset)/size;}
 #if MPI_PARALLEL_ENABLED
   MPI_Status status;
   int errcode = MPI_File_read_at_all(fh_, offset, buf, cnt*size, MPI_BYTE, &status);
@@ -188,6 +264,11 @@ std::size_t IOWrapper::Read_bytes_at_all(void *buf, IOWrapperSizeT size,
 //! Returns number of Reals actually read.
 
 std::size_t IOWrapper::Read_Reals(void *buf, IOWrapperSizeT cnt) {
+  if (image_ != nullptr) {
+    std::size_t nread = ReadImage(buf, cnt*sizeof(Real), image_->pos);
+    image_->pos += nread;
+    return nread/sizeof(Real);
+  }
 #if MPI_PARALLEL_ENABLED
   MPI_Status status;
   int errcode = MPI_File_read(fh_, buf, cnt, MPI_ATHENA_REAL, &status);
@@ -213,6 +294,7 @@ std::size_t IOWrapper::Read_Reals(void *buf, IOWrapperSizeT cnt) {
 
 std::size_t IOWrapper::Read_Reals_at(void *buf, IOWrapperSizeT cnt,
                                      IOWrapperSizeT offset) {
+  if (image_ != nullptr) {return ReadImage(buf, cnt*sizeof(Real), offset)/sizeof(Real);}
 #if MPI_PARALLEL_ENABLED
   MPI_Status status;
   int errcode = MPI_File_read_at(fh_, offset, buf, cnt, MPI_ATHENA_REAL, &status);
@@ -240,6 +322,7 @@ std::size_t IOWrapper::Read_Reals_at(void *buf, IOWrapperSizeT cnt,
 
 std::size_t IOWrapper::Read_Reals_at_all(void *buf, IOWrapperSizeT cnt,
                                          IOWrapperSizeT offset) {
+  if (image_ != nullptr) {return ReadImage(buf, cnt*sizeof(Real), offset)/sizeof(Real);}
 #if MPI_PARALLEL_ENABLED
   MPI_Status status;
   int errcode = MPI_File_read_at_all(fh_, offset, buf, cnt, MPI_ATHENA_REAL, &status);
@@ -281,11 +364,18 @@ std::size_t IOWrapper::Write_any_type(const void *buf, IOWrapperSizeT cnt,
   } else if (datatype.compare("Real") == 0) {
     mpitype = MPI_ATHENA_REAL;
   } else {
-    MPI_Abort(MPI_COMM_WORLD, 1);
+    MPI_Abort(global_variable::athena_comm, 1);
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
               << std::endl << "Unrecognized datatype '" << datatype << "'" << std::endl;
     std::exit(EXIT_FAILURE);
   }
+  if (image_ != nullptr) {
+    int tsize;
+    MPI_Type_size(mpitype, &tsize);
+    std::size_t nwrite = WriteImage(buf, cnt*tsize, image_->pos);
+    image_->pos += nwrite;
+    return nwrite/tsize;
+  }
   // Now write data using MPI-IO
   MPI_Status status;
   int errcode = MPI_File_write(fh_, buf, cnt, mpitype, &status);
@@ -317,6 +407,11 @@ std::size_t IOWrapper::Write_any_type(const void *buf, IOWrapperSizeT cnt,
               << std::endl << "Unrecognized datatype '" << datatype << "'" << std::endl;
     std::exit(EXIT_FAILURE);
   }
+  if (image_ != nullptr) {
+    std::size_t nwrite = WriteImage(buf, cnt*datasize, image_->pos);
+    image_->pos += nwrite;
+    return nwrite/datasize;
+  }
   // Write data using standard C functions
   return std::fwrite(buf,datasize,cnt,fh_);
 #endif
@@ -344,11 +439,16 @@ std::size_t IOWrapper::Write_any_type_at(const void *buf, IOWrapperSizeT cnt,
   } else if (datatype.compare("Real") == 0) {
     mpitype = MPI_ATHENA_REAL;
   } else {
-    MPI_Abort(MPI_COMM_WORLD, 1);
+    MPI_Abort(global_variable::athena_comm, 1);
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
               << std::endl << "Unrecognized datatype '" << datatype << "'" << std::endl;
     std::exit(EXIT_FAILURE);
   }
+  if (image_ != nullptr) {
+    int tsize;
+    MPI_Type_size(mpitype, &tsize);
+    return WriteImage(buf, cnt*tsize, offset)/tsize;
+  }
   // Now write data using MPI-IO
   MPI_Status status;
   int errcode = MPI_File_write_at(fh_, offset, buf, cnt, mpitype, &status);
@@ -380,6 +480,7 @@ std::size_t IOWrapper::Write_any_type_at(const void *buf, IOWrapperSizeT cnt,
               << std::endl << "Unrecognized datatype '" << datatype << "'" << std::endl;
     std::exit(EXIT_FAILURE);
   }
+  if (image_ != nullptr) {return WriteImage(buf, cnt*datasize, offset)/datasize;}
   // Write data using standard C functions
   std::fseek(fh_, offset, SEEK_SET);
   return std::fwrite(buf,datasize,cnt,fh_);
@@ -408,11 +509,16 @@ std::size_t IOWrapper::Write_any_type_at_all(const void *buf, IOWrapperSizeT cnt
   } else if (datatype.compare("Real") == 0) {
     mpitype = MPI_ATHENA_REAL;
   } else {
-    MPI_Abort(MPI_COMM_WORLD, 1);
+    MPI_Abort(global_variable::athena_comm, 1);
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
               << std::endl << "Unrecognized datatype '" << datatype << "'" << std::endl;
     std::exit(EXIT_FAILURE);
   }
+  if (image_ != nullptr) {
+    int tsize;
+    MPI_Type_size(mpitype, &tsize);
+    return WriteImage(buf, cnt*tsize, offset)/tsize;
+  }
   // Now write data using MPI-IO
   MPI_Status status;
   int errcode = MPI_File_write_at_all(fh_, offset, buf, cnt, mpitype, &status);
@@ -444,6 +550,7 @@ std::size_t IOWrapper::Write_any_type_at_all(const void *buf, IOWrapperSizeT cnt
               << std::endl << "Unrecognized datatype '" << datatype << "'" << std::endl;
     std::exit(EXIT_FAILURE);
   }
+  if (image_ != nullptr) {return WriteImage(buf, cnt*datasize, offset)/datasize;}
   // Write data using standard C functions
   std::fseek(fh_, offset, SEEK_SET);
   return std::fwrite(buf,datasize,cnt,fh_);
@@ -455,6 +562,10 @@ std::size_t IOWrapper::Write_any_type_at_all(const void *buf, IOWrapperSizeT cnt
 //  \brief wrapper for {MPI_File_close} versus {std::fclose}
 
 int IOWrapper::Close() {
+  if (image_ != nullptr) {
+    image_.reset();
+    return 0;
+  }
 #if MPI_PARALLEL_ENABLED
   return MPI_File_close(&fh_);
 #else
@@ -467,6 +578,10 @@ int IOWrapper::Close() {
 //  \brief wrapper for {MPI_File_seek} versus {std::fseek}
 
 int IOWrapper::Seek(IOWrapperSizeT offset) {
+  if (image_ != nullptr) {
+    image_->pos = offset;
+    return 0;
+  }
 #if MPI_PARALLEL_ENABLED
   return MPI_File_seek(fh_,offset,MPI_SEEK_SET);
 #else
@@ -479,6 +594,7 @@ int IOWrapper::Seek(IOWrapperSizeT offset) {
 //  \brief wrapper for {MPI_File_get_position} versus {ftell}
 
 IOWrapperSizeT IOWrapper::GetPosition() {
+  if (image_ != nullptr) {return image_->pos;}
 #if MPI_PARALLEL_ENABLED
   MPI_Offset position;
   MPI_File_get_position(fh_,&position);
@@ -487,3 +603,113 @@ IOWrapperSizeT IOWrapper::GetPosition() {
   return ftell(fh_);
 #endif
 }
+
+//----------------------------------------------------------------------------------------
+//! \fn std::size_t IOWrapper::WriteImage()
+//  \brief stores nbytes at given offset of in-memory image as a segment written by this
+//  rank.  Returns number of bytes written.
+
+std::size_t IOWrapper::WriteImage(const void *buf, IOWrapperSizeT nbytes,
+                                  IOWrapperSizeT offset) {
+  if (nbytes == 0) {return 0;}
+  const char *pbuf = static_cast<const char*>(buf);
+  image_->segs.push_back(offset);
+  image_->segs.push_back(image_->data.size());
+  image_->segs.push_back(nbytes);
+  image_->data.insert(image_->data.end(), pbuf, pbuf + nbytes);
+  return nbytes;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn std::size_t IOWrapper::ReadImage()
+//  \brief reads nbytes starting at given offset of a published in-memory image.  Bytes
+//  held by other ranks are fetched with MPI_Get.  As for files, fewer bytes are returned
+//  if the end of the image is reached.
+
+std::size_t IOWrapper::ReadImage(void *buf, IOWrapperSizeT nbytes,
+                                 IOWrapperSizeT offset) {
+  char *pbuf = static_cast<char*>(buf);
+  const std::vector<IOWrapperSizeT> &table = image_->table;
+  IOWrapperSizeT nread = 0;
+  // segments do not overlap and are sorted by offset, so copy from consecutive segments
+  // until nbytes are read or a gap (the end of the image) is found
+  for (std::size_t s=0; s<table.size() && nread<nbytes; s+=4) {
+    IOWrapperSizeT pos = offset + nread;
+    if (table[s] + table[s+2] <= pos) continue;
+    if (table[s] > pos) break;
+    IOWrapperSizeT n = std::min(table[s] + table[s+2] - pos, nbytes - nread);
+    IOWrapperSizeT disp = table[s+1] + (pos - table[s]);
+    int rank = static_cast<int>(table[s+3]);
+    if (rank == image_->rank) {
+      std::memcpy(pbuf + nread, &(image_->data[disp]), n);
+    } else {
+#if MPI_PARALLEL_ENABLED
+      // MPI counts are ints, so large segments are read in chunks
+      constexpr IOWrapperSizeT kMaxGet = 1 << 30;
+      for (IOWrapperSizeT c=0; c<n; c+=kMaxGet) {
+        int cnt = static_cast<int>(std::min(kMaxGet, n - c));
+        MPI_Get(pbuf + nread + c, cnt, MPI_BYTE, rank, static_cast<MPI_Aint>(disp + c),
+                cnt, MPI_BYTE, image_->win);
+      }
+#endif
+    }
+    nread += n;
+  }
+#if MPI_PARALLEL_ENABLED
+  if (image_->win != MPI_WIN_NULL) {MPI_Win_flush_all(image_->win);}
+#endif
+  return nread;
+}
+
+#if MPI_PARALLEL_ENABLED
+//----------------------------------------------------------------------------------------
+//! \fn void IOWrapper::PublishImage(IOWrapperImage &image, MPI_Comm comm)
+//  \brief collective over comm.  Gathers the table of segments written by every rank,
+//  and exposes the data of each rank in an MPI window, so that all ranks of comm
+//  (including those that wrote nothing, e.g. newly spawned ranks) can read the image.
+
+void IOWrapper::PublishImage(IOWrapperImage &image, MPI_Comm comm) {
+  int nranks;
+  MPI_Comm_rank(comm, &(image.rank));
+  MPI_Comm_size(comm, &nranks);
+  int nmy = static_cast<int>(image.segs.size());
+  std::vector<int> counts(nranks), displs(nranks, 0);
+  MPI_Allgather(&nmy, 1, MPI_INT, counts.data(), 1, MPI_INT, comm);
+  for (int r=1; r<nranks; ++r) {displs[r] = displs[r-1] + counts[r-1];}
+  std::vector<IOWrapperSizeT> segs(displs[nranks-1] + counts[nranks-1]);
+  MPI_Allgatherv(image.segs.data(), nmy, MPI_UINT64_T, segs.data(), counts.data(),
+                 displs.data(), MPI_UINT64_T, comm);
+
+  std::vector<std::array<IOWrapperSizeT,4>> table;
+  for (int r=0; r<nranks; ++r) {
+    for (int s=displs[r]; s<displs[r]+counts[r]; s+=3) {
+      table.push_back({segs[s], segs[s+1], segs[s+2], static_cast<IOWrapperSizeT>(r)});
+    }
+  }
+  std::sort(table.begin(), table.end());
+  image.table.clear();
+  for (auto &t : table) {image.table.insert(image.table.end(), t.begin(), t.end());}
+
+  MPI_Win_create((image.data.empty())? nullptr : image.data.data(),
+                 static_cast<MPI_Aint>(image.data.size()), 1, MPI_INFO_NULL, comm,
+                 &(image.win));
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, image.win);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void IOWrapper::FreeImage(IOWrapperImage &image)
+//  \brief collective over communicator passed to PublishImage().  Frees the window and
+//  the data of an image once all ranks have read it.
+
+void IOWrapper::FreeImage(IOWrapperImage &image) {
+  if (image.win != MPI_WIN_NULL) {
+    MPI_Win_unlock_all(image.win);
+    MPI_Win_free(&(image.win));
+  }
+  std::vector<char>().swap(image.data);
+  image.segs.clear();
+  image.table.clear();
+  return;
+}
+#endif
@@ -8,9 +8,12 @@
 //! \file io_wrapper.hpp
 //  \brief defines a set of small wrapper functions for MPI versus serial outputs.
 
-#include <string>
 #include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
 #include "athena.hpp"
+#include "globals.hpp"
 
 #if MPI_PARALLEL_ENABLED
 #include <mpi.h>
@@ -21,10 +24,35 @@ using  IOWrapperFile = FILE*;
 
 using IOWrapperSizeT = std::uint64_t;
 
+// forward declarations
+class ParameterInput;
+
+//----------------------------------------------------------------------------------------
+//! \struct IOWrapperImage
+//  \brief restart "file" held in memory by the ranks that wrote it, used to continue a
+//  run on a different number of ranks without writing to disk (<job>/rescale_cycle).
+//  Each rank stores the segments it wrote.  Once published, every rank of the
+//  communicator passed to IOWrapper::PublishImage() reads any part of the image from
+//  the ranks holding it with one-sided MPI.
+
+struct IOWrapperImage {
+  std::vector<char> data;           // bytes written by this rank
+  // (offset in image, offset in data, size) of each segment written by this rank
+  std::vector<IOWrapperSizeT> segs;
+  // (offset in image, offset in data, size, rank) of segments of all ranks, sorted by
+  // offset (set by IOWrapper::PublishImage(), before which only segs can be read)
+  std::vector<IOWrapperSizeT> table;
+  IOWrapperSizeT pos = 0;           // position of sequential reads and writes
+  int rank = 0;                     // rank of this process in table
+#if MPI_PARALLEL_ENABLED
+  MPI_Win win = MPI_WIN_NULL;       // window exposing data to all ranks
+#endif
+};
+
 class IOWrapper {
  public:
 #if MPI_PARALLEL_ENABLED
-  IOWrapper() : fh_(nullptr), comm_(MPI_COMM_WORLD) {}
+  IOWrapper() : fh_(nullptr), comm_(global_variable::athena_comm) {}
   void SetCommunicator(MPI_Comm scomm) { comm_=scomm;}
 #else
   IOWrapper() {fh_=nullptr;}
@@ -33,8 +61,12 @@ class IOWrapper {
   // nested type definition of strongly typed/scoped enum in class definition
   enum class FileMode {read, write, append};
 
+  // set MPI-IO hints (aggregators, buffer size, file striping) used for all writes
+  static void SetWriteHints(ParameterInput *pin);
+
   // wrapper functions for basic I/O tasks
   int Open(const char* fname, FileMode rw);
+  int Open(std::shared_ptr<IOWrapperImage> image);
   std::size_t Read_bytes(void *buf, IOWrapperSizeT size, IOWrapperSizeT count);
   std::size_t Read_bytes_at(void *buf, IOWrapperSizeT size, IOWrapperSizeT count,
                             IOWrapperSizeT offset);
@@ -52,10 +84,20 @@ class IOWrapper {
   int Seek(IOWrapperSizeT offset);
   IOWrapperSizeT GetPosition();
 
+#if MPI_PARALLEL_ENABLED
+  // collective over comm: makes an image written by some of its ranks readable by all
+  static void PublishImage(IOWrapperImage &image, MPI_Comm comm);
+  static void FreeImage(IOWrapperImage &image);
+#endif
+
  private:
   IOWrapperFile fh_;
+  std::shared_ptr<IOWrapperImage> image_;  // set when reading/writing in-memory image
+  std::size_t ReadImage(void *buf, IOWrapperSizeT nbytes, IOWrapperSizeT offset);
+  std::size_t WriteImage(const void *buf, IOWrapperSizeT nbytes, IOWrapperSizeT offset);
 #if MPI_PARALLEL_ENABLED
   MPI_Comm comm_;
+  static MPI_Info write_info_;  // hints passed to MPI_File_open for writes
 #endif
 };
 #endif // OUTPUTS_IO_WRAPPER_HPP_
@@ -18,7 +18,8 @@
 //! Required parameters that must be specified in an <output[n]> block are:
 //!   - variable  = [list of currently implemented strings for specifing output variables
 //!                  is defined at start of outputs.hpp file]
-//!   - file_type = tab,vtk,hst,bin,rst
+//!   - file_type = tab,vtk,hst,bin,cbin,tavg,pyr,rst,hdf5,ascent,python,proj,shell,
+//!                 spec,prof
 //!   - dt        = problem time between outputs
 //!
 //! EXAMPLE of an <output[n]> block for a TAB dump:
@@ -39,6 +40,7 @@
 //! comment text: 'NEW_OUTPUT_TYPES'.
 //========================================================================================
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>    // strcmp
@@ -46,6 +48,8 @@
 #include <iostream>
 #include <sstream>
 #include <string>   // std::string, to_string()
+#include <utility>
+#include <vector>
 
 #include "athena.hpp"
 #include "parameter_input.hpp"
@@ -56,10 +60,13 @@
 // Outputs constructor
 
 Outputs::Outputs(ParameterInput *pin, Mesh *pm) {
+  // set MPI-IO hints for all output files from <job> block
+  IOWrapper::SetWriteHints(pin);
+
   // loop over input block names.  Find those that start with "output", read parameters,
   // and add to linked list of BaseTypeOutputs.
 
-  int num_hst=0, num_rst=0, num_log=0; // count # of hst,rst,log outputs
+  int num_hst=0, num_rst=0, num_log=0, num_comm=0; // # of hst,rst,log,comm outputs
   for (auto it = pin->block.begin(); it != pin->block.end(); ++it) {
     if (it->block_name.compare(0, 6, "output") == 0) {
       OutputParameters opar;  // define temporary OutputParameters struct
@@ -92,7 +99,9 @@ Outputs::Outputs(ParameterInput *pin, Mesh *pm) {
       if (opar.file_type.compare("hst") != 0 &&
           opar.file_type.compare("rst") != 0 &&
           opar.file_type.compare("log") != 0 &&
-          opar.file_type.compare("trk") != 0) {
+          opar.file_type.compare("trk") != 0 &&
+          opar.file_type.compare("rt") != 0 &&
+          opar.file_type.compare("python") != 0) {
         opar.variable = pin->GetString(opar.block_name, "variable");
         opar.file_id = pin->GetOrAddString(opar.block_name,"id",opar.variable);
       }
@@ -182,10 +191,17 @@ Outputs::Outputs(ParameterInput *pin, Mesh *pm) {
       // set output variable and optional file id (default is output variable name)
       if (opar.file_type.compare("hst") != 0 &&
           opar.file_type.compare("rst") != 0 &&
-          opar.file_type.compare("log") != 0) {
+          opar.file_type.compare("log") != 0 &&
+          opar.file_type.compare("comm") != 0 &&
+          opar.file_type.compare("rt") != 0 &&
+          opar.file_type.compare("python") != 0) {
         opar.variable = pin->GetString(opar.block_name, "variable");
         opar.file_id = pin->GetOrAddString(opar.block_name,"id",opar.variable);
       }
+      // ray-traced images depend on no output variable, and have id "image" by default
+      if (opar.file_type.compare("rt") == 0) {
+        opar.file_id = pin->GetOrAddString(opar.block_name,"id","image");
+      }
 
       // check that pdf variables are single variables
       // raise error if variable = mhd_w, mhd_u, hydro_w, hydro_u
@@ -214,6 +230,11 @@ Outputs::Outputs(ParameterInput *pin, Mesh *pm) {
         }
       }
 
+      // set optional boolean to write restart files in a background thread
+      if (opar.file_type.compare("rst") == 0) {
+        opar.async_write = pin->GetOrAddBoolean(opar.block_name, "async_write", false);
+      }
+
       // set optional data format string used in formatted writes
       opar.data_format = pin->GetOrAddString(opar.block_name, "data_format", "%12.5e");
       opar.data_format.insert(0, " "); // prepend with blank to separate columns
@@ -232,6 +253,10 @@ Outputs::Outputs(ParameterInput *pin, Mesh *pm) {
         pnode = new EventLogOutput(pin,pm,opar);
         pout_list.insert(pout_list.begin(),pnode);
         num_log++;
+      } else if (opar.file_type.compare("comm") == 0) {
+        pnode = new CommLogOutput(pin,pm,opar);
+        pout_list.insert(pout_list.begin(),pnode);
+        num_comm++;
       } else if (opar.file_type.compare("vtk") == 0) {
         pnode = new MeshVTKOutput(pin,pm,opar);
         pout_list.insert(pout_list.begin(),pnode);
@@ -247,6 +272,19 @@ Outputs::Outputs(ParameterInput *pin, Mesh *pm) {
           "compute_moments", false);
         pnode = new CoarsenedBinaryOutput(pin,pm,opar);
         pout_list.insert(pout_list.begin(),pnode);
+      } else if (opar.file_type.compare("tavg") == 0) {
+        opar.coarsen_factor = pin->GetOrAddInteger(opar.block_name,"coarsen_factor",1);
+        opar.compute_moments = false;
+        pnode = new TimeAverageOutput(pin,pm,opar);
+        pout_list.insert(pout_list.begin(),pnode);
+      } else if (opar.file_type.compare("pyr") == 0) {
+        // coarsen_factor is that of first level, whose directory is made by cbin
+        std::string levels = pin->GetOrAddString(opar.block_name,"levels","2,4,8,16");
+        opar.coarsen_factor = std::atoi(levels.c_str());
+        opar.compute_moments = pin->GetOrAddBoolean(opar.block_name,
+          "compute_moments", false);
+        pnode = new PyramidOutput(pin,pm,opar);
+        pout_list.insert(pout_list.begin(),pnode);
       } else if (opar.file_type.compare("pdf") == 0) {
         opar.bin_min = pin->GetReal(opar.block_name,"bin_min");
         opar.bin_max = pin->GetReal(opar.block_name,"bin_max");
@@ -269,9 +307,57 @@ Outputs::Outputs(ParameterInput *pin, Mesh *pm) {
         }
         pnode = new PDFOutput(pin,pm,opar);
         pout_list.insert(pout_list.begin(),pnode);
+      } else if (opar.file_type.compare("proj") == 0 ||
+                 opar.file_type.compare("shell") == 0) {
+        pnode = new ProjectionOutput(pin,pm,opar);
+        pout_list.insert(pout_list.begin(),pnode);
+      } else if (opar.file_type.compare("rt") == 0) {
+        pnode = new RayTracingOutput(pin,pm,opar);
+        pout_list.insert(pout_list.begin(),pnode);
+      } else if (opar.file_type.compare("spec") == 0) {
+        pnode = new SpectrumOutput(pin,pm,opar);
+        pout_list.insert(pout_list.begin(),pnode);
+      } else if (opar.file_type.compare("prof") == 0) {
+        pnode = new RadialProfileOutput(pin,pm,opar);
+        pout_list.insert(pout_list.begin(),pnode);
       } else if (opar.file_type.compare("bin") == 0) {
         pnode = new MeshBinaryOutput(pin,pm,opar);
         pout_list.insert(pout_list.begin(),pnode);
+      } else if (opar.file_type.compare("hdf5") == 0) {
+#if HDF5_OUTPUT_ENABLED
+        opar.compression_level = pin->GetOrAddInteger(opar.block_name,
+                                                      "compression_level", 0);
+        pnode = new MeshHDF5Output(pin,pm,opar);
+        pout_list.insert(pout_list.begin(),pnode);
+#else
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+            << std::endl << "HDF5 output requested in output block '"
+            << opar.block_name << "', but code was not compiled with "
+            << "-D Athena_ENABLE_HDF5=ON" << std::endl;
+        exit(EXIT_FAILURE);
+#endif
+      } else if (opar.file_type.compare("ascent") == 0) {
+#if ASCENT_ENABLED
+        pnode = new MeshAscentOutput(pin,pm,opar);
+        pout_list.insert(pout_list.begin(),pnode);
+#else
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+            << std::endl << "Ascent output requested in output block '"
+            << opar.block_name << "', but code was not compiled with "
+            << "-D Athena_ENABLE_ASCENT=ON" << std::endl;
+        exit(EXIT_FAILURE);
+#endif
+      } else if (opar.file_type.compare("python") == 0) {
+#if PYTHON_ENABLED
+        pnode = new MeshPythonOutput(pin,pm,opar);
+        pout_list.insert(pout_list.begin(),pnode);
+#else
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+            << std::endl << "Python output requested in output block '"
+            << opar.block_name << "', but code was not compiled with "
+            << "-D Athena_ENABLE_PYTHON=ON" << std::endl;
+        exit(EXIT_FAILURE);
+#endif
       } else if (opar.file_type.compare("rst") == 0) {
       // Add restarts to the tail end of BaseTypeOutput list, so file counters for other
       // output types are up-to-date in restart file
@@ -287,13 +373,37 @@ Outputs::Outputs(ParameterInput *pin, Mesh *pm) {
     }
   }
 
-  // check there were no more than one history, event log, or restart files requested
-  if (num_hst > 1 || num_rst > 1 || num_log > 1) {
+  // check there were no more than one history, event log, comm log, or restart file
+  if (num_hst > 1 || num_rst > 1 || num_log > 1 || num_comm > 1) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
-              << "More than one history, event log, or restart output block found in "
-              << "input file" << std::endl;
+              << "More than one history, event log, communication log, or restart "
+              << "output block found in input file" << std::endl;
     exit(EXIT_FAILURE);
   }
+
+  // link outputs of the same derived variables, so that they are computed only once if
+  // several outputs are made on the same cycle
+  for (int n=0; n<static_cast<int>(pout_list.size()); ++n) {
+    OutputParameters &op = pout_list[n]->out_params;
+    if (!(op.contains_derived)) continue;
+    for (int m=0; m<n; ++m) {
+      OutputParameters &oq = pout_list[m]->out_params;
+      if (oq.contains_derived && oq.variable == op.variable &&
+          oq.variable_2 == op.variable_2 && oq.i_derived == op.i_derived &&
+          oq.n_derived == op.n_derived) {
+        pout_list[n]->derived_peers.push_back(pout_list[m]);
+      }
+    }
+  }
+
+  // outputs of types that write data loaded by BaseTypeOutput::LoadOutputData() can
+  // share staged variables
+  for (auto pnode : pout_list) {
+    std::string &ft = pnode->out_params.file_type;
+    pnode->stage_data = (ft == "tab" || ft == "vtk" || ft == "bin" || ft == "hdf5" ||
+                         ft == "ascent" || ft == "python");
+    pnode->pstage = &stage;
+  }
 }
 
 //----------------------------------------------------------------------------------------
@@ -306,3 +416,75 @@ Outputs::~Outputs() {
   }
   pout_list.clear();
 }
+
+//----------------------------------------------------------------------------------------
+//! \fn void Outputs::StageOutputData()
+//  \brief Given the list of outputs to be made this cycle, computes the derived variables
+//  of those that can share staged data, gathers the union of their variables into one
+//  device array, and copies it to the host with a single transfer.  LoadOutputData() of
+//  each then copies its variables from the stage, so variables read by several outputs
+//  are transferred only once.  Nothing is staged unless at least two outputs share it.
+
+void Outputs::StageOutputData(Mesh *pm, const std::vector<BaseTypeOutput*> &list) {
+  stage.cycle = -1;
+  int nshare = 0;
+  bool gzs = false;
+  for (auto out : list) {
+    if (out->stage_data) {
+      nshare++;
+      if (out->out_params.include_gzs) {gzs = true;}
+    }
+  }
+  if (nshare < 2) {return;}
+
+  // union of variables, computing derived variables first
+  std::vector<std::pair<const DvceArray5D<Real>*, int>> vars;
+  for (auto out : list) {
+    if (!(out->stage_data)) continue;
+    if (out->out_params.contains_derived) {
+      out->ComputeDerivedVariables(pm);
+    }
+    for (auto &var : out->outvars) {
+      auto v = std::make_pair(static_cast<const DvceArray5D<Real>*>(var.data_ptr),
+                              var.data_index);
+      if (std::find(vars.begin(), vars.end(), v) == vars.end()) {vars.push_back(v);}
+    }
+  }
+
+  // staged data covers active cells of all MeshBlocks, and ghost zones if any output
+  // includes them
+  auto &indcs = pm->mb_indcs;
+  int nmb = pm->pmb_pack->nmb_thispack;
+  int nvar = static_cast<int>(vars.size());
+  int n1 = indcs.nx1, n2 = indcs.nx2, n3 = indcs.nx3;
+  int is = indcs.is, js = indcs.js, ks = indcs.ks;
+  if (gzs) {
+    n1 = indcs.nx1 + 2*(indcs.ng);
+    n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
+    n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
+    is = 0; js = 0; ks = 0;
+  }
+  if (stage.data.extent_int(0) != nvar || stage.data.extent_int(1) != nmb ||
+      stage.data.extent_int(2) != n3 || stage.data.extent_int(3) != n2 ||
+      stage.data.extent_int(4) != n1) {
+    Kokkos::realloc(stage.data, nvar, nmb, n3, n2, n1);
+  }
+  // variables are gathered on the device in an array checked out of the scratch pool
+  auto d_data = pm->scratch.Checkout("out_stage", nvar, nmb, n3, n2, n1);
+  auto &d_stg = d_data.view;
+  for (int n=0; n<nvar; ++n) {
+    auto var = *(vars[n].first);
+    int indx = vars[n].second;
+    par_for("out_stage",DevExeSpace(),0,(nmb-1),0,(n3-1),0,(n2-1),0,(n1-1),
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      d_stg(n,m,k,j,i) = var(m,indx,k+ks,j+js,i+is);
+    });
+  }
+  Kokkos::deep_copy(stage.data, d_stg);
+
+  stage.vars = vars;
+  stage.ghost_zones = gzs;
+  stage.cycle = pm->ncycle;
+  stage.version = pm->mesh_version;
+  return;
+}
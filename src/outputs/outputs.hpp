@@ -8,7 +8,13 @@
 //! \file outputs.hpp
 //  \brief provides classes to handle ALL types of data output
 
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "Kokkos_ScatterView.hpp"
@@ -102,7 +108,9 @@ static const char *var_choice[NOUTPUT_CHOICES] = {
 
 // forward declarations
 class Mesh;
+class MeshBlockPack;
 class ParameterInput;
+class PointInterpolator;
 
 //----------------------------------------------------------------------------------------
 //! \struct OutputParameters
@@ -124,6 +132,7 @@ struct OutputParameters {
   bool slice1, slice2, slice3;
   Real slice_x1, slice_x2, slice_x3;
   bool user_hist_only;
+  bool async_write=false;     // enables writing restart files in a background thread
   std::string data_format;
   bool contains_derived=false;
   // DBF parameters for coarsened binary:
@@ -141,6 +150,7 @@ struct OutputParameters {
   int nbin=0, nbin2=0;
   bool logscale=true, logscale2=true;
   bool mass_weighted=false;
+  int compression_level=0;    // deflate compression level of HDF5 outputs (0=none)
 };
 
 //----------------------------------------------------------------------------------------
@@ -175,26 +185,44 @@ struct OutputMeshBlockInfo {
 
 //----------------------------------------------------------------------------------------
 //! \struct HistoryData
-//  \brief  container for history data for different physics modules
+//  \brief  container for history data for different physics modules.  Each variable is
+//  summed over ranks, unless its entry in op is set to HistoryMax or HistoryMin (e.g. by
+//  a user history function computing a maximum over the domain).
+
+enum HistoryReduction {HistorySum, HistoryMax, HistoryMin};
 
 struct HistoryData {
   int nhist;
   PhysicsModule physics;
   std::string label[NHISTORY_VARIABLES];
   Real hdata[NHISTORY_VARIABLES];
+  HistoryReduction op[NHISTORY_VARIABLES];
   bool header_written;
   // constructor
-  explicit HistoryData(PhysicsModule name) : physics(name), header_written(false) {}
+  explicit HistoryData(PhysicsModule name) : physics(name), header_written(false) {
+    for (int n=0; n<NHISTORY_VARIABLES; ++n) {op[n] = HistorySum;}
+  }
 };
 
 //----------------------------------------------------------------------------------------
-//! \struct TrackedParticleData
-//! \brief data (tag, pos, vel) output for tracked particles
-
-struct TrackedParticleData {
-  int tag;
-  Real x,y,z;
-  Real vx,vy,vz;
+//! \struct OutputStage
+//  \brief host copy of the variables read by all outputs made on the same cycle, which is
+//  transferred from the device once and shared by them (see Outputs::StageOutputData())
+
+struct OutputStage {
+  int cycle=-1;                  // cycle on which variables were staged
+  int version=-1;                // mesh_version when variables were staged
+  bool ghost_zones=false;        // true if staged variables include ghost zones
+  // device array and index in array of each staged variable
+  std::vector<std::pair<const DvceArray5D<Real>*, int>> vars;
+  HostArray5D<Real> data;        // staged variables (n,m,k,j,i) on host
+  // returns index of variable in staged data, or -1 if it is not staged
+  int Find(const DvceArray5D<Real> *ptr, const int indx) const {
+    for (int n=0; n<static_cast<int>(vars.size()); ++n) {
+      if (vars[n].first == ptr && vars[n].second == indx) {return n;}
+    }
+    return -1;
+  }
 };
 
 //----------------------------------------------------------------------------------------
@@ -215,13 +243,31 @@ class BaseTypeOutput {
   // data
   OutputParameters out_params;   // params read from <output> block for this type
   DvceArray5D<Real> derived_var; // array to store output variables computed from u0/b0
+  // earlier outputs with the same derived variables, whose derived_var can be reused
+  std::vector<BaseTypeOutput*> derived_peers;
+  int derived_cycle=-1;          // cycle on which derived_var was last computed
+  int derived_version=-1;        // mesh_version when derived_var was last computed
+  // true if LoadOutputData() of this type can read variables from the shared stage
+  bool stage_data=false;
+  const OutputStage *pstage=nullptr;
+  friend class Outputs;
 
   // function which computes derived output variables like vorticity and current density
   void ComputeDerivedVariable(std::string name, Mesh *pm);
+  // computes all derived variables of this output, or reuses those of a peer
+  void ComputeDerivedVariables(Mesh *pm);
 
   // virtual functions may be over-ridden in derived classes
   virtual void LoadOutputData(Mesh *pm);
   virtual void WriteOutputFile(Mesh *pm, ParameterInput *pin) = 0;
+  // true if this output reads device array parray (used to skip unneeded diagnostics)
+  virtual bool ReadsArray(const DvceArray5D<Real> *parray) const;
+  // writes any data still buffered by this output at the end of the run
+  virtual void Flush(Mesh *pm) {}
+  // called at the end of every cycle, e.g. to update running time-averages
+  virtual void Accumulate(Mesh *pm) {}
+  // true if Accumulate() reads the output variables at the end of cycle ncycle
+  virtual bool SampleDue(int ncycle) const {return false;}
 
   // Functions to detect big endian machine, and to byte-swap 32-bit words.  The vtk
   // legacy format requires data to be stored as big-endian.
@@ -240,6 +286,7 @@ class BaseTypeOutput {
   // CC output data on host with dims (n,m,k,j,i) except
   // for restarts, where dims are (m,n,k,j,i)
   HostArray5D<Real> outarray;
+  DualArray2D<int> outmb_indcs;  // (MB index in pack, ois, ojs, oks) of output MBs
   HostArray5D<Real> outarray_hyd, outarray_mhd, outarray_rad,
                     outarray_force, outarray_z4c, outarray_adm;
   HostFaceFld4D<Real> outfield;  // FC output field on host
@@ -282,6 +329,11 @@ class HistoryOutput : public BaseTypeOutput {
   void LoadMHDHistoryData(HistoryData *pdata, Mesh *pm);
   void LoadZ4cHistoryData(HistoryData *pdata, Mesh *pm);
   void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+  bool ReadsArray(const DvceArray5D<Real> *parray) const override;
+  void ReduceHistoryData();
+
+ private:
+  const DvceArray5D<Real> *pz4c_con;  // constraints read by z4c history, if any
 };
 
 //----------------------------------------------------------------------------------------
@@ -299,6 +351,45 @@ class CoarsenedBinaryOutput : public BaseTypeOutput {
   void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
 };
 
+//----------------------------------------------------------------------------------------
+//! \class TimeAverageOutput
+//  \brief derived CoarsenedBinaryOutput class for time-averages of output variables and
+//  their products, accumulated on the device and written in coarsened binary format
+
+class TimeAverageOutput : public CoarsenedBinaryOutput {
+ public:
+  TimeAverageOutput(ParameterInput *pin, Mesh *pm, OutputParameters oparams);
+  void Accumulate(Mesh *pm) override;
+  bool SampleDue(int ncycle) const override;
+  void LoadOutputData(Mesh *pm) override;
+  void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+ private:
+  int sample_dcycle;            // number of cycles between samples
+  int nvar_in;                  // number of output variables read from device arrays
+  int nsample;                  // number of samples in running sums
+  int sum_version;              // Mesh::mesh_version when running sums were reset
+  DualArray2D<int> prod_index;  // (product, factor) index of each factor, or -1
+  DvceArray5D<Real> stage;      // (m,n,k,j,i) output variables in active cells
+  DvceArray5D<Real> sum;        // (n,m,k,j,i) running sums on coarsened cells
+  void AddSample(Mesh *pm);
+};
+
+//----------------------------------------------------------------------------------------
+//! \class PyramidOutput
+//  \brief derived CoarsenedBinaryOutput class for output variables coarsened by several
+//  factors at once, each level computed on the device from the previous one, and written
+//  as coarsened binary files that share an index file
+
+class PyramidOutput : public CoarsenedBinaryOutput {
+ public:
+  PyramidOutput(ParameterInput *pin, Mesh *pm, OutputParameters oparams);
+  void LoadOutputData(Mesh *pm) override;
+  void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+ private:
+  std::vector<int> factors;                // coarsening factor of each level
+  std::vector<HostArray5D<Real>> levels;   // (n,m,k,j,i) output data of each level
+};
+
 //----------------------------------------------------------------------------------------
 //! \struct PDFData
 //  \brief  container for PDF data
@@ -338,6 +429,87 @@ class PDFOutput : public BaseTypeOutput {
   void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
 };
 
+//----------------------------------------------------------------------------------------
+//! \class ProjectionOutput
+//  \brief derived BaseTypeOutput class for 2D images (projections along an axis, or
+//  spherical shells) computed on the device
+
+class ProjectionOutput : public BaseTypeOutput {
+ public:
+  ProjectionOutput(ParameterInput *pin, Mesh *pm, OutputParameters oparams);
+  void LoadOutputData(Mesh *pm) override;
+  void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+ private:
+  bool shell;                   // true for shell, false for projection along axis
+  int axis;                     // direction of projection (1,2,3)
+  Real radius;                  // radius of shell
+  int npix1, npix2;             // number of pixels in each direction of image
+  Real x1min, x1max, x2min, x2max;  // extent of image (phi and theta for shells)
+  DvceArray3D<Real> d_image;    // image of each variable on device
+  HostArray3D<Real> image;      // image of each variable on host
+};
+
+//----------------------------------------------------------------------------------------
+//! \class RayTracingOutput
+//  \brief derived BaseTypeOutput class for images and light curves ray traced in-situ
+//  through GR Hydro/MHD data
+
+class RayTracingOutput : public BaseTypeOutput {
+ public:
+  RayTracingOutput(ParameterInput *pin, Mesh *pm, OutputParameters oparams);
+  ~RayTracingOutput();
+  void LoadOutputData(Mesh *pm) override;
+  void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+ private:
+  int npix;                     // number of pixels in each direction of image
+  Real fov;                     // half-width of image in image plane
+  Real inclination;             // angle of camera from spin axis (degrees)
+  Real r_obs;                   // distance of camera
+  std::string emission;         // emissivity model
+  int npts;                     // number of points along all rays inside the Mesh
+  PointInterpolator *pinterp;   // interpolator to points along rays
+  DualArray1D<int> ray;         // pixel of each point
+  DualArray2D<Real> kdl;        // (npts,4) k_1,k_2,k_3 and step length at each point
+  DvceArray2D<Real> d_prim;     // primitives interpolated to points
+  DvceArray1D<Real> d_image;    // image on device
+  HostArray1D<Real> image;      // image on host
+};
+
+//----------------------------------------------------------------------------------------
+//! \class SpectrumOutput
+//  \brief derived BaseTypeOutput class for shell-averaged power spectra computed on the
+//  device
+
+class SpectrumOutput : public BaseTypeOutput {
+ public:
+  SpectrumOutput(ParameterInput *pin, Mesh *pm, OutputParameters oparams);
+  void LoadOutputData(Mesh *pm) override;
+  void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+ private:
+  int nkmax;                    // maximum integer wavenumber in each direction
+  int nk1, nk2, nk3;            // number of wavenumbers in each direction
+  std::vector<std::vector<Real>> spec;  // power in each shell (on root) for each var
+};
+
+//----------------------------------------------------------------------------------------
+//! \class RadialProfileOutput
+//  \brief derived BaseTypeOutput class for radial (or radius-polar angle) profiles
+//  computed on the device
+
+class RadialProfileOutput : public BaseTypeOutput {
+ public:
+  RadialProfileOutput(ParameterInput *pin, Mesh *pm, OutputParameters oparams);
+  void LoadOutputData(Mesh *pm) override;
+  void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+ private:
+  int nr, ntheta;               // number of bins in radius and polar angle
+  Real rmin, rmax;              // range of radial bins
+  bool logr;                    // true for logarithmically spaced radial bins
+  bool mass_weighted;           // true to weight by rest mass, otherwise by volume
+  DvceArray2D<Real> d_prof;     // weight and weighted sums of each bin on device
+  HostArray2D<Real> prof;       // weight and weighted sums of each bin on host
+};
+
 //----------------------------------------------------------------------------------------
 //! \class MeshVTKOutput
 //  \brief derived BaseTypeOutput class for mesh data in VTK (legacy) format
@@ -371,7 +543,54 @@ class MeshBinaryOutput : public BaseTypeOutput {
  public:
   MeshBinaryOutput(ParameterInput *pin, Mesh *pm, OutputParameters oparams);
   void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+ private:
+  bool write_index;  // append index of MeshBlock records (format version 1.2)
+};
+
+#if HDF5_OUTPUT_ENABLED
+//----------------------------------------------------------------------------------------
+//! \class MeshHDF5Output
+//  \brief derived BaseTypeOutput class for mesh data in HDF5 format
+class MeshHDF5Output : public BaseTypeOutput {
+ public:
+  MeshHDF5Output(ParameterInput *pin, Mesh *pm, OutputParameters oparams);
+  void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+ private:
+  std::vector<int> mantissa_bits;  // # of mantissa bits retained for each variable
+};
+#endif
+
+#if ASCENT_ENABLED
+namespace ascent {class Ascent;}
+//----------------------------------------------------------------------------------------
+//! \class MeshAscentOutput
+//  \brief derived BaseTypeOutput class for in-situ visualization and analysis with Ascent
+class MeshAscentOutput : public BaseTypeOutput {
+ public:
+  MeshAscentOutput(ParameterInput *pin, Mesh *pm, OutputParameters oparams);
+  ~MeshAscentOutput();
+  void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+ private:
+  ascent::Ascent *pascent;
 };
+#endif
+
+#if PYTHON_ENABLED
+namespace pybind11 {class object;}
+//----------------------------------------------------------------------------------------
+//! \class MeshPythonOutput
+//  \brief derived BaseTypeOutput class for in-situ analysis with user Python functions
+class MeshPythonOutput : public BaseTypeOutput {
+ public:
+  MeshPythonOutput(ParameterInput *pin, Mesh *pm, OutputParameters oparams);
+  ~MeshPythonOutput();
+  void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+ private:
+  static int ninstances;
+  std::vector<std::string> array_names;
+  pybind11::object *pfunc;
+};
+#endif
 
 //----------------------------------------------------------------------------------------
 //! \class RestartOutput
@@ -380,8 +599,39 @@ class MeshBinaryOutput : public BaseTypeOutput {
 class RestartOutput : public BaseTypeOutput {
  public:
   RestartOutput(ParameterInput *pin, Mesh *pm, OutputParameters oparams);
+  // writes one full restart to an in-memory image rather than a file
+  RestartOutput(ParameterInput *pin, Mesh *pm, std::shared_ptr<IOWrapperImage> image);
+  ~RestartOutput();
   void LoadOutputData(Mesh *pm) override;
   void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+  void WriteRestartData(MeshBlockPack *pmbp, IOWrapper resfile, std::string header,
+                        IOWrapperSizeT data_size, IOWrapperSizeT offset_myrank,
+                        int nmb_thisrank);
+  void DrainRestartFile(std::string local_fname, std::string fname);
+ private:
+  std::thread write_thread;  // background thread writing data when async_write=true
+  std::thread drain_thread;  // background thread copying local data file to rst dir
+  int ranks_per_file;        // # of ranks writing each data file (0=one shared file)
+  int group_rank=0;          // rank in group of ranks writing same data file
+  std::string local_dir;     // node-local directory data files are written to first
+  bool keep_local;           // keep data files in local_dir after they are copied
+#if MPI_PARALLEL_ENABLED
+  MPI_Comm group_comm;       // communicator of ranks writing same data file
+#endif
+  std::shared_ptr<IOWrapperImage> image_;  // if set, image written instead of files
+  // data for delta restart files
+  int full_every;            // # of dumps between full restart files (0,1=all full)
+  Real delta_tol;            // relative change in MB data above which it is rewritten
+  int ndumps=0;              // # of dumps written in this run
+  std::string base_fname;    // name of last full restart file
+  IOWrapperSizeT base_dataoffset;  // offset of MB data in last full restart file
+  // (lx1,lx2,lx3,level) -> (gid in last full restart file, index in base arrays)
+  std::map<std::array<std::int32_t,4>, std::pair<int,int>> base_mbs;
+  HostArray5D<Real> base_hyd, base_mhd, base_rad, base_force, base_z4c, base_adm;
+  HostFaceFld4D<Real> base_field;
+  void SaveBaseData(Mesh *pm, std::string fname, IOWrapperSizeT dataoffset);
+  bool MeshBlockChanged(MeshBlockPack *pmbp, int m, int bm);
+  void MoveMeshBlockData(MeshBlockPack *pmbp, int m, int w);
 };
 
 //----------------------------------------------------------------------------------------
@@ -400,22 +650,46 @@ class EventLogOutput : public BaseTypeOutput {
   void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
 };
 
+//----------------------------------------------------------------------------------------
+//! \class CommLogOutput
+//  \brief derived BaseTypeOutput class for MPI communication counter data
+
+class CommLogOutput : public BaseTypeOutput {
+ public:
+  CommLogOutput(ParameterInput *pin, Mesh *pm, OutputParameters oparams);
+
+  bool header_written=false;
+
+  void LoadOutputData(Mesh *pm) override;
+  void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+
+ private:
+  std::vector<int> count, displ;   // # of values from each rank, and offsets into data
+  std::vector<double> data;        // counters gathered from all ranks (on master rank)
+};
+
 //----------------------------------------------------------------------------------------
 //! \class TrackedParticleOutput
-//  \brief derived BaseTypeOutput class for tracked particle data in binary format
+//  \brief derived BaseTypeOutput class for tracked particle data in binary format.
+//  Tracked particles are selected and packed on the device into a buffer holding
+//  nbuffer outputs, which is copied to the host and written only when it is full.
 
 class TrackedParticleOutput : public BaseTypeOutput {
  public:
   TrackedParticleOutput(ParameterInput *pin, Mesh *pm, OutputParameters oparams);
   void LoadOutputData(Mesh *pm) override;
   void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+  void Flush(Mesh *pm) override;
  protected:
   int ntrack;           // total number of tracked particles across all ranks
-  int ntrack_thisrank;  // number of tracked particles this rank (guess)
-  int npout;            // number of tracked particles to be written this rank
-  bool header_written;
-  std::vector<int> npout_eachrank;
-  HostArray1D<TrackedParticleData> outpart;
+  int tag_start;        // particles with tags in [tag_start,tag_start+ntrack) tracked
+  int nbuffer;          // number of outputs held in buffer before it is written
+  int nbuf;             // number of outputs currently in buffer
+  DvceArray1D<float> dbuf;   // (x,y,z,vx,vy,vz) of tracked particles each output
+  DvceArray1D<int> dtag;     // tags of tracked particles each output
+  DvceArray1D<int> dcount;   // number of tracked particles this rank each output
+  std::vector<Real> buf_time;
+  std::vector<int> buf_cycle;
 };
 
 //----------------------------------------------------------------------------------------
@@ -430,6 +704,10 @@ class Outputs {
 
   // use vector of pointers to BaseTypeOutputs since it is an abstract base class
   std::vector<BaseTypeOutput*> pout_list;
+  OutputStage stage;     // variables shared by all outputs made on the same cycle
+
+  // stages the variables of all outputs in list that are to be made this cycle
+  void StageOutputData(Mesh *pm, const std::vector<BaseTypeOutput*> &list);
 };
 
 #endif // OUTPUTS_OUTPUTS_HPP_
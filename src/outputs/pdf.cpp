@@ -153,6 +153,28 @@ PDFOutput::PDFOutput(ParameterInput *pin, Mesh *pm, OutputParameters op) :
 
 
 
+//----------------------------------------------------------------------------------------
+//! \fn int PDFBin()
+//  \brief returns index of bin containing value x, given the bin edges, number of bins,
+//  and (log10 of, if logscale) bin width.  Values below/above the range of the bins are
+//  counted in bins 0 and nbin+1.
+
+namespace {
+// largest histogram (including outlier bins) accumulated in scratch memory of each team
+constexpr int max_private_bins = 4096;
+
+KOKKOS_INLINE_FUNCTION
+int PDFBin(const Real x, const Kokkos::View<Real*> &bins, const int nbin,
+           const Real step, const bool logscale) {
+  if (x < bins(0)) return 0;
+  if (x >= bins(nbin)) return nbin + 1;
+  if (logscale) {
+    return static_cast<int>(log10(x/bins(0))/step) + 1;
+  }
+  return static_cast<int>((x - bins(0))/step) + 1;
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------
 //! \fn void PDFOutput::LoadOutputData()
 //  \brief Wrapper function that cycles through hist_data vector and calls
@@ -165,8 +187,7 @@ void PDFOutput::LoadOutputData(Mesh *pm) {
   // although maybe not optimal -- should probably have a way to
   // know beforehand which needs to be computed
   if (out_params.contains_derived) {
-    ComputeDerivedVariable(out_params.variable, pm);
-    ComputeDerivedVariable(out_params.variable_2, pm);
+    ComputeDerivedVariables(pm);
   }
 
   // Pointer for initial determination
@@ -218,15 +239,10 @@ void PDFOutput::LoadOutputData(Mesh *pm) {
   }
   Kokkos::fence();
 
-  //
-
-  // Reset ScatterView from previous output
-  scatter.reset();
   // Also reset the histogram from previous call.
   // Currently still required for consistent results between host and device backends, see
   // https://github.com/kokkos/kokkos/issues/6363
   Kokkos::deep_copy(result, 0);
-  Kokkos::fence();
 
   // Capture the necessary data from pdf_data
   auto bins = pdf_data.bins;
@@ -240,65 +256,82 @@ void PDFOutput::LoadOutputData(Mesh *pm) {
   bool logscale2 = pdf_data.logscale2;
   bool mass_weighted = pdf_data.mass_weighted;
 
-  par_for("pdf", DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
-  KOKKOS_LAMBDA(int m, int k, int j, int i) {
-    auto &x_val = outvars_device(0, m, k, j, i);
-    int x_bin = -1;
-    // First handle edge cases explicitly
-    if (x_val < bins(0)) {
-      x_bin = 0;
-    } else if (x_val >= bins(nbin_)) {
-      x_bin = nbin_ + 1;
-    } else {
-      if (logscale == false) {
-        x_bin = static_cast<int>((x_val - bins(0)) / step_size) + 1;
-      } else if (logscale == true) {
-        x_bin = static_cast<int>(std::log10(x_val / bins(0)) / step_size) + 1;
-      }
-    }
-    // needs to be zero as for the 1D histogram we need 0 as first index of the 2D
-    // result array
-    int y_bin = 0;
-    if (pdf_dimension == 2) {
-      auto &y_val = outvars_device(1, m, k, j, i);
-
-      y_bin = -1; // reset to impossible value
-      // First handle edge cases explicitly
-      if (y_val < bins2(0)) {
-        y_bin = 0;
-      } else if (y_val >= bins2(nbin2_)) {
-        y_bin = nbin2_ + 1;
-      } else {
-        // for lin and log directly pick index
-        if (logscale2 == false) {
-          y_bin = static_cast<int>((y_val - bins2(0)) / step_size2) + 1;
-        } else if (logscale2 == true) {
-          y_bin = static_cast<int>(std::log10(y_val/bins2(0)) / step_size2) + 1;
+  // With few enough bins, each team accumulates a private histogram of one k-plane of a
+  // MeshBlock in scratch memory, which is then added to the result with one atomic per
+  // bin.  This avoids contention of all threads on the same few bins in global memory.
+  // Large histograms (which would not fit in scratch memory) use the ScatterView.
+  int nres1 = nbin_ + 2;
+  int nres = result.extent_int(0)*nres1;
+  if (nres <= max_private_bins) {
+    int ni = ie - is + 1;
+    int nji = (je - js + 1)*ni;
+    size_t scr_size = ScrArray1D<Real>::shmem_size(nres);
+    par_for_outer("pdf_private", DevExeSpace(), scr_size, 0, 0, (nmb-1), ks, ke,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k) {
+      ScrArray1D<Real> hist(member.team_scratch(0), nres);
+      par_for_inner(member, 0, (nres-1), [&](const int n) {
+        hist(n) = 0.0;
+      });
+      member.team_barrier();
+
+      Real vol = size.d_view(m).dx1*size.d_view(m).dx2*size.d_view(m).dx3;
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(member, nji), [&](const int idx) {
+        int j = idx/ni + js;
+        int i = idx%ni + is;
+        int x_bin = PDFBin(outvars_device(0,m,k,j,i), bins, nbin_, step_size, logscale);
+        int y_bin = 0;
+        if (pdf_dimension == 2) {
+          y_bin = PDFBin(outvars_device(1,m,k,j,i), bins2, nbin2_, step_size2, logscale2);
+        }
+        Real weight = (mass_weighted)? vol*u0_(m,IDN,k,j,i) : vol;
+        Kokkos::atomic_add(&hist(y_bin*nres1 + x_bin), weight);
+      });
+      member.team_barrier();
+
+      par_for_inner(member, 0, (nres-1), [&](const int n) {
+        if (hist(n) != 0.0) {
+          Kokkos::atomic_add(&result(n/nres1, n%nres1), hist(n));
         }
+      });
+    });
+    Kokkos::fence();
+  } else {
+    // Reset ScatterView from previous output
+    scatter.reset();
+    Kokkos::fence();
+
+    par_for("pdf", DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      int x_bin = PDFBin(outvars_device(0,m,k,j,i), bins, nbin_, step_size, logscale);
+      // needs to be zero as for the 1D histogram we need 0 as first index of the 2D
+      // result array
+      int y_bin = 0;
+      if (pdf_dimension == 2) {
+        y_bin = PDFBin(outvars_device(1,m,k,j,i), bins2, nbin2_, step_size2, logscale2);
       }
-    }
-    auto res = scatter.access();
-    Real weight = size.d_view(m).dx1*size.d_view(m).dx2*size.d_view(m).dx3;
-    weight *= mass_weighted == false
-              ? 1.0
-              : u0_(m, IDN, k, j, i);
-    res(y_bin, x_bin) += weight;
-  });
-
-  // "reduce" results from scatter view to original view.
-  // May be a no-op depending on backend.
-  Kokkos::Experimental::contribute(result, scatter); //.KokkosView()
-  // Kokkos::Experimental::contribute(result.KokkosView(), scatter);
-  Kokkos::fence(); // May not be required
+      auto res = scatter.access();
+      Real weight = size.d_view(m).dx1*size.d_view(m).dx2*size.d_view(m).dx3;
+      weight *= mass_weighted == false
+                ? 1.0
+                : u0_(m, IDN, k, j, i);
+      res(y_bin, x_bin) += weight;
+    });
+
+    // "reduce" results from scatter view to original view.
+    // May be a no-op depending on backend.
+    Kokkos::Experimental::contribute(result, scatter); //.KokkosView()
+    // Kokkos::Experimental::contribute(result.KokkosView(), scatter);
+    Kokkos::fence(); // May not be required
+  }
 
   // Now reduce over ranks
 #if MPI_PARALLEL_ENABLED
   if (global_variable::my_rank == 0) {
     MPI_Reduce(MPI_IN_PLACE, result.data(), result.size(),
-                                   MPI_ATHENA_REAL, MPI_SUM, 0, MPI_COMM_WORLD);
+               MPI_ATHENA_REAL, MPI_SUM, 0, global_variable::athena_comm);
   } else {
     MPI_Reduce(result.data(), result.data(), result.size(),
-                                   MPI_ATHENA_REAL, MPI_SUM, 0, MPI_COMM_WORLD);
+               MPI_ATHENA_REAL, MPI_SUM, 0, global_variable::athena_comm);
   }
 #endif
 }
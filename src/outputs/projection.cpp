@@ -0,0 +1,274 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file projection.cpp
+//! \brief writes 2D images of output variables computed on the device: either
+//! line-of-sight projections (integrals along one coordinate axis over the whole Mesh,
+//! file_type = proj), or values sampled on a spherical shell (file_type = shell).  Only
+//! the image is copied to the host and summed over ranks, so whole MeshBlocks are never
+//! transferred to the host.
+//!
+//! Projections are computed on a uniform image with the resolution of the given
+//! refinement level (<output>/level, default is the maximum level in the Mesh) in the two
+//! directions transverse to <output>/axis (default 3).  Cells coarser than the image
+//! deposit into every pixel they cover, and finer cells deposit into one pixel weighted
+//! by their area, so each pixel stores the column integral of the variable averaged over
+//! the pixel.
+//!
+//! Shells are sampled at radius <output>/radius from the origin on a (theta,phi) image
+//! with <output>/ntheta x <output>/nphi pixels, using the value in the cell that
+//! contains the center of each pixel.  Pixels outside the Mesh are zero.
+//!
+//! Files contain a short ASCII header (terminated by a line starting "# data"), followed
+//! by the image of each variable as binary single-precision floats with the first image
+//! coordinate varying fastest.
+
+#include <sys/stat.h>  // mkdir
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "coordinates/cell_locations.hpp"
+#include "outputs.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn void PixelRange()
+//  \brief returns first pixel p0 and number of pixels np covered by a cell with left edge
+//  xl and width dx, on an image of npix pixels of width dp starting at xmin, and the
+//  fraction w of a pixel covered by the cell (1 if cell covers whole pixels).
+
+KOKKOS_INLINE_FUNCTION
+static void PixelRange(Real xl, Real dx, Real xmin, Real dp, int npix,
+                       int &p0, int &np, Real &w) {
+  Real ncov = dx/dp;
+  if (ncov <= 1.0) {
+    p0 = static_cast<int>((xl + 0.5*dx - xmin)/dp);
+    np = 1;
+    w = ncov;
+  } else {
+    p0 = static_cast<int>((xl - xmin)/dp + 0.5);
+    np = static_cast<int>(ncov + 0.5);
+    w = 1.0;
+  }
+  p0 = (p0 < 0)? 0 : p0;
+  p0 = (p0 + np > npix)? npix - np : p0;
+}
+
+//----------------------------------------------------------------------------------------
+// Constructor: also calls BaseTypeOutput base class constructor
+
+ProjectionOutput::ProjectionOutput(ParameterInput *pin, Mesh *pm, OutputParameters op) :
+  BaseTypeOutput(pin, pm, op),
+  shell(op.file_type.compare("shell") == 0),
+  d_image("d_image",1,1,1),
+  image("image",1,1,1) {
+  // create directories for outputs. Comments in binary.cpp constructor explain why
+  mkdir(op.file_type.c_str(),0775);
+
+  if (shell) {
+    if (pm->one_d || pm->two_d) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Shell output in block '" << op.block_name
+                << "' requires a 3D Mesh" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    radius = pin->GetReal(op.block_name, "radius");
+    npix2 = pin->GetInteger(op.block_name, "ntheta");
+    npix1 = pin->GetOrAddInteger(op.block_name, "nphi", 2*npix2);
+    x1min = 0.0;  x1max = 2.0*M_PI;
+    x2min = 0.0;  x2max = M_PI;
+  } else {
+    axis = pin->GetOrAddInteger(op.block_name, "axis", 3);
+    int level = pin->GetOrAddInteger(op.block_name, "level",
+                                     pm->max_level - pm->root_level);
+    if (axis < 1 || axis > 3 || level < 0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Projection in block '" << op.block_name
+                << "' requires axis=1,2,3 and level >= 0" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    // image coordinates are the two directions transverse to axis, in cyclic order
+    auto &msize = pm->mesh_size;
+    auto &mindcs = pm->mesh_indcs;
+    int nx[3] = {mindcs.nx1, mindcs.nx2, mindcs.nx3};
+    Real xmin[3] = {msize.x1min, msize.x2min, msize.x3min};
+    Real xmax[3] = {msize.x1max, msize.x2max, msize.x3max};
+    int a = (axis == 1)? 1 : 0;
+    int b = (axis == 3)? 1 : 2;
+    npix1 = (nx[a] > 1)? (nx[a] << level) : 1;
+    npix2 = (nx[b] > 1)? (nx[b] << level) : 1;
+    x1min = xmin[a];  x1max = xmax[a];
+    x2min = xmin[b];  x2max = xmax[b];
+  }
+  if (npix1 < 1 || npix2 < 1) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Number of pixels in image in block '" << op.block_name
+              << "' must be > 0" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ProjectionOutput::LoadOutputData()
+//  \brief Computes the image of each output variable on the device, and sums images over
+//  all ranks on the root process.
+
+void ProjectionOutput::LoadOutputData(Mesh *pm) {
+  if (out_params.contains_derived) {
+    ComputeDerivedVariables(pm);
+  }
+  int nout_vars = outvars.size();
+  if (d_image.extent_int(0) != nout_vars || d_image.extent_int(1) != npix2 ||
+      d_image.extent_int(2) != npix1) {
+    Kokkos::realloc(d_image, nout_vars, npix2, npix1);
+    Kokkos::realloc(image, nout_vars, npix2, npix1);
+  }
+  Kokkos::deep_copy(d_image, 0.0);
+
+  auto &indcs = pm->mb_indcs;
+  int is = indcs.is, ie = indcs.ie, nx1 = indcs.nx1;
+  int js = indcs.js, je = indcs.je, nx2 = indcs.nx2;
+  int ks = indcs.ks, ke = indcs.ke, nx3 = indcs.nx3;
+  int nmb = pm->pmb_pack->nmb_thispack;
+  auto &size = pm->pmb_pack->pmb->mb_size;
+  auto img = d_image;
+  int n1 = npix1, n2 = npix2;
+  Real dp1 = (x1max - x1min)/static_cast<Real>(npix1);
+  Real dp2 = (x2max - x2min)/static_cast<Real>(npix2);
+  Real p1min = x1min, p2min = x2min;
+
+  for (int n=0; n<nout_vars; ++n) {
+    auto var = *(outvars[n].data_ptr);
+    int indx = outvars[n].data_index;
+    if (shell) {
+      Real r = radius;
+      par_for("shell",DevExeSpace(),0,(nmb-1),0,(n2-1),0,(n1-1),
+      KOKKOS_LAMBDA(int m, int jp, int ip) {
+        Real theta = p2min + (static_cast<Real>(jp) + 0.5)*dp2;
+        Real phi = p1min + (static_cast<Real>(ip) + 0.5)*dp1;
+        Real x1 = r*sin(theta)*cos(phi);
+        Real x2 = r*sin(theta)*sin(phi);
+        Real x3 = r*cos(theta);
+        auto &sz = size.d_view(m);
+        // each point is contained in exactly one MeshBlock
+        if (x1 >= sz.x1min && x1 < sz.x1max && x2 >= sz.x2min && x2 < sz.x2max &&
+            x3 >= sz.x3min && x3 < sz.x3max) {
+          int i = is + CellCenterIndex(x1, nx1, sz.x1min, sz.x1max);
+          int j = js + CellCenterIndex(x2, nx2, sz.x2min, sz.x2max);
+          int k = ks + CellCenterIndex(x3, nx3, sz.x3min, sz.x3max);
+          img(n,jp,ip) = var(m,indx,k,j,i);
+        }
+      });
+    } else {
+      int ax = axis;
+      par_for("proj",DevExeSpace(),0,(nmb-1),ks,ke,js,je,is,ie,
+      KOKKOS_LAMBDA(int m, int k, int j, int i) {
+        auto &sz = size.d_view(m);
+        Real x1l = sz.x1min + (i-is)*sz.dx1;
+        Real x2l = sz.x2min + (j-js)*sz.dx2;
+        Real x3l = sz.x3min + (k-ks)*sz.dx3;
+        // left edges and widths of cell in image directions, and width along axis
+        Real xa = x1l, dxa = sz.dx1, xb = x2l, dxb = sz.dx2, dxc = sz.dx3;
+        if (ax == 1) {
+          xa = x2l; dxa = sz.dx2; xb = x3l; dxb = sz.dx3; dxc = sz.dx1;
+        } else if (ax == 2) {
+          xb = x3l; dxb = sz.dx3; dxc = sz.dx2;
+        }
+        int ia, na, ib, nb;
+        Real wa, wb;
+        PixelRange(xa, dxa, p1min, dp1, n1, ia, na, wa);
+        PixelRange(xb, dxb, p2min, dp2, n2, ib, nb, wb);
+        Real val = var(m,indx,k,j,i)*dxc*wa*wb;
+        for (int jp=ib; jp<ib+nb; ++jp) {
+          for (int ip=ia; ip<ia+na; ++ip) {
+            Kokkos::atomic_add(&img(n,jp,ip), val);
+          }
+        }
+      });
+    }
+  }
+
+  // copy image to host and sum over ranks
+  Kokkos::deep_copy(image, d_image);
+#if MPI_PARALLEL_ENABLED
+  if (global_variable::my_rank == 0) {
+    MPI_Reduce(MPI_IN_PLACE, image.data(), image.size(), MPI_ATHENA_REAL, MPI_SUM, 0,
+               global_variable::athena_comm);
+  } else {
+    MPI_Reduce(image.data(), image.data(), image.size(), MPI_ATHENA_REAL, MPI_SUM, 0,
+               global_variable::athena_comm);
+  }
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ProjectionOutput::WriteOutputFile()
+//  \brief Writes image of each variable from root process.
+
+void ProjectionOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
+  if (global_variable::my_rank == 0) {
+    // create filename: "file_type/file_basename" + "." + "file_id" + "." + XXXXX + "." +
+    // file_type, where XXXXX = 5-digit file_number
+    std::string fname;
+    char number[6];
+    std::snprintf(number, sizeof(number), "%05d", out_params.file_number);
+    fname.assign(out_params.file_type);
+    fname.append("/");
+    fname.append(out_params.file_basename);
+    fname.append(".");
+    fname.append(out_params.file_id);
+    fname.append(".");
+    fname.append(number);
+    fname.append(".");
+    fname.append(out_params.file_type);
+
+    FILE *pfile;
+    if ((pfile = std::fopen(fname.c_str(),"wb")) == nullptr) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Output file '" << fname << "' could not be opened"
+                << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    std::fprintf(pfile, "# Athena++ %s output at time=%e cycle=%d\n",
+                 (shell)? "shell" : "projection", pm->time, pm->ncycle);
+    if (shell) {
+      std::fprintf(pfile, "# radius=%e nphi=%d ntheta=%d\n", radius, npix1, npix2);
+    } else {
+      std::fprintf(pfile, "# axis=%d nx=%d ny=%d xmin=%e xmax=%e ymin=%e ymax=%e\n",
+                   axis, npix1, npix2, x1min, x1max, x2min, x2max);
+    }
+    std::fprintf(pfile, "# variables:");
+    for (auto &var : outvars) {std::fprintf(pfile, " %s", var.label.c_str());}
+    std::fprintf(pfile, "\n# data\n");
+
+    std::vector<float> data(npix1);
+    for (int n=0; n<static_cast<int>(outvars.size()); ++n) {
+      for (int j=0; j<npix2; ++j) {
+        for (int i=0; i<npix1; ++i) {data[i] = static_cast<float>(image(n,j,i));}
+        std::fwrite(data.data(), sizeof(float), npix1, pfile);
+      }
+    }
+    std::fclose(pfile);
+  }
+
+  // increment counters
+  out_params.file_number++;
+  if (out_params.last_time < 0.0) {
+    out_params.last_time = pm->time;
+  } else {
+    out_params.last_time += out_params.dt;
+  }
+  pin->SetInteger(out_params.block_name, "file_number", out_params.file_number);
+  pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
+  return;
+}
@@ -0,0 +1,233 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file pyramid.cpp
+//! \brief writes output variables coarsened by several factors at once (file_type = pyr),
+//! i.e. a multi-resolution "pyramid" of the data, for visualization and quick-look
+//! analysis that only needs to read the level with the required resolution.
+//!
+//! The coarsening factors are set by <output>/levels, a comma-separated list of
+//! increasing factors that are each a multiple of the previous one (default "2,4,8,16").
+//! A factor of 1 includes the data at full resolution.  Cells are only coarsened in the
+//! active dimensions.  Each level is computed on the device from the previous one (the
+//! first from the full grid), so the cost is dominated by a single pass through the data.
+//! With <output>/compute_moments = true the first four moments of each variable are
+//! output, as for cbin.
+//!
+//! Each level is written in coarsened binary format to the directory of cbin outputs
+//! with its factor (see coarsened_binary.cpp), and an index file
+//! "basename.id.XXXXX.pyr" listing the factor, MB size and file of each level is written
+//! to the run directory.
+
+#include <sys/stat.h>  // mkdir
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "outputs.hpp"
+
+//----------------------------------------------------------------------------------------
+// Constructor: also calls CoarsenedBinaryOutput base class constructor, which creates the
+// directory of the first level
+
+PyramidOutput::PyramidOutput(ParameterInput *pin, Mesh *pm, OutputParameters op) :
+  CoarsenedBinaryOutput(pin, pm, op) {
+  if (op.slice1 || op.slice2 || op.slice3 || op.gid >= 0 || op.include_gzs) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Pyramid output in block '" << op.block_name
+              << "' cannot be sliced, restricted to one MeshBlock, or include ghost "
+              << "zones" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  std::stringstream ss(pin->GetOrAddString(op.block_name, "levels", "2,4,8,16"));
+  std::string s;
+  while (std::getline(ss, s, ',')) {
+    if (s.find_first_not_of(" \t") == std::string::npos) continue;
+    factors.push_back(std::atoi(s.c_str()));
+  }
+
+  // check each factor is a multiple of the previous one, and divides the MeshBlocks
+  auto &indcs = pm->mb_indcs;
+  int nlev = static_cast<int>(factors.size());
+  if (nlev == 0) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "No levels specified in block '" << op.block_name << "'"
+              << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  for (int l=0; l<nlev; ++l) {
+    int f = factors[l];
+    bool ok = (f >= 1);
+    if (l > 0) {ok = ok && (f > factors[l-1]) && (f % factors[l-1] == 0);}
+    ok = ok && (indcs.nx1 % f == 0) && (indcs.nx2 == 1 || indcs.nx2 % f == 0) &&
+              (indcs.nx3 == 1 || indcs.nx3 % f == 0);
+    if (!(ok)) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Levels in block '" << op.block_name << "' must be "
+                << "increasing factors that are each a multiple of the previous one, "
+                << "and divide the MeshBlock size" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  }
+  levels.resize(nlev);
+
+  // create directories of the other levels
+  for (int l=1; l<nlev; ++l) {
+    std::string dir_name = "cbin_" + out_params.file_id + "_" +
+                           std::to_string(factors[l]);
+    mkdir(dir_name.c_str(),0775);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void PyramidOutput::LoadOutputData()
+//  \brief Coarsens output variables in all MeshBlocks by the factor of each level, each
+//  level from the previous one, in arrays checked out of the scratch pool, and copies
+//  every level to the host.
+
+void PyramidOutput::LoadOutputData(Mesh *pm) {
+  outmbs.clear();
+  auto &indcs = pm->mb_indcs;
+  auto &size  = pm->pmb_pack->pmb->mb_size;
+  int nmb = pm->pmb_pack->nmb_thispack;
+  for (int m=0; m<nmb; ++m) {
+    int id = pm->pmb_pack->pmb->mb_gid.h_view(m);
+    outmbs.emplace_back(id, indcs.is, indcs.ie, indcs.js, indcs.je, indcs.ks, indcs.ke,
+                        size.h_view(m).x1min, size.h_view(m).x1max,
+                        size.h_view(m).x2min, size.h_view(m).x2max,
+                        size.h_view(m).x3min, size.h_view(m).x3max);
+  }
+
+  if (out_params.contains_derived) {
+    ComputeDerivedVariables(pm);
+  }
+
+  int is = indcs.is, js = indcs.js, ks = indcs.ks;
+  int nvar = static_cast<int>(outvars.size());
+  int nmom = (out_params.compute_moments)? 4 : 1;
+  int nout = nvar*nmom;
+  int nlev = static_cast<int>(factors.size());
+  std::vector<ScratchArray> d_lev;
+  for (int l=0; l<nlev; ++l) {
+    // coarsening factor in each active dimension relative to previous level
+    int r = (l == 0)? factors[0] : factors[l]/factors[l-1];
+    int r1 = r;
+    int r2 = (indcs.nx2 > 1)? r : 1;
+    int r3 = (indcs.nx3 > 1)? r : 1;
+    int nc1 = indcs.nx1/factors[l];
+    int nc2 = (indcs.nx2 > 1)? indcs.nx2/factors[l] : 1;
+    int nc3 = (indcs.nx3 > 1)? indcs.nx3/factors[l] : 1;
+    Real norm = 1.0/static_cast<Real>(r1*r2*r3);
+    d_lev.push_back(pm->scratch.Checkout("pyr_level", nout, nmb, nc3, nc2, nc1));
+    auto lev = d_lev[l].view;
+
+    if (l == 0) {
+      // first level is computed from the full grid, including the moments
+      for (int n=0; n<nvar; ++n) {
+        auto var = *(outvars[n].data_ptr);
+        int indx = outvars[n].data_index;
+        par_for("pyr_coarsen0",DevExeSpace(),0,(nmb-1),0,(nc3-1),0,(nc2-1),0,(nc1-1),
+        KOKKOS_LAMBDA(int m, int kc, int jc, int ic) {
+          Real sum[4] = {0.0, 0.0, 0.0, 0.0};
+          for (int kk=0; kk<r3; ++kk) {
+            for (int jj=0; jj<r2; ++jj) {
+              for (int ii=0; ii<r1; ++ii) {
+                Real q = var(m,indx,ks+kc*r3+kk,js+jc*r2+jj,is+ic*r1+ii);
+                Real qp = q;
+                for (int p=0; p<nmom; ++p) {
+                  sum[p] += qp;
+                  qp *= q;
+                }
+              }
+            }
+          }
+          for (int p=0; p<nmom; ++p) {
+            lev(n*nmom+p,m,kc,jc,ic) = sum[p]*norm;
+          }
+        });
+      }
+    } else {
+      // averages of the moments over coarse cells are averages over the finer level
+      auto prev = d_lev[l-1].view;
+      par_for("pyr_coarsen",DevExeSpace(),0,(nout-1),0,(nmb-1),0,(nc3-1),0,(nc2-1),
+              0,(nc1-1),
+      KOKKOS_LAMBDA(int n, int m, int kc, int jc, int ic) {
+        Real sum = 0.0;
+        for (int kk=0; kk<r3; ++kk) {
+          for (int jj=0; jj<r2; ++jj) {
+            for (int ii=0; ii<r1; ++ii) {
+              sum += prev(n,m,kc*r3+kk,jc*r2+jj,ic*r1+ii);
+            }
+          }
+        }
+        lev(n,m,kc,jc,ic) = sum*norm;
+      });
+    }
+  }
+
+  for (int l=0; l<nlev; ++l) {
+    auto &d = d_lev[l].view;
+    Kokkos::realloc(levels[l], d.extent(0), d.extent(1), d.extent(2), d.extent(3),
+                    d.extent(4));
+    Kokkos::deep_copy(levels[l], d);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void PyramidOutput::WriteOutputFile()
+//  \brief Writes index file, then each level in coarsened binary format.  All levels are
+//  written with the same file number.
+
+void PyramidOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
+  char number[6];
+  std::snprintf(number, sizeof(number), "%05d", out_params.file_number);
+  int nlev = static_cast<int>(factors.size());
+
+  if (global_variable::my_rank == 0) {
+    std::string fname = out_params.file_basename + "." + out_params.file_id + "." +
+                        number + ".pyr";
+    FILE *pfile;
+    if ((pfile = std::fopen(fname.c_str(),"w")) == nullptr) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Output file '" << fname << "' could not be opened"
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    std::fprintf(pfile, "# Athena pyramid output version=1.0\n");
+    std::fprintf(pfile, "# time=%e  cycle=%d  number of levels=%d\n", pm->time,
+                 pm->ncycle, nlev);
+    std::fprintf(pfile, "# level  factor   nx1   nx2   nx3  file\n");
+    for (int l=0; l<nlev; ++l) {
+      std::fprintf(pfile, "  %5d  %6d %5d %5d %5d  cbin_%s_%d/%s.%s.%s.cbin\n", l,
+                   factors[l], levels[l].extent_int(4), levels[l].extent_int(3),
+                   levels[l].extent_int(2), out_params.file_id.c_str(), factors[l],
+                   out_params.file_basename.c_str(), out_params.file_id.c_str(), number);
+    }
+    std::fclose(pfile);
+  }
+
+  // the file number and time of last output are incremented by each call to the base
+  // class function, so reset them before each level
+  int file_number = out_params.file_number;
+  Real last_time = out_params.last_time;
+  for (int l=0; l<nlev; ++l) {
+    out_params.file_number = file_number;
+    out_params.last_time = last_time;
+    out_params.coarsen_factor = factors[l];
+    outarray = levels[l];
+    CoarsenedBinaryOutput::WriteOutputFile(pm, pin);
+  }
+  out_params.coarsen_factor = factors[0];
+  return;
+}
@@ -0,0 +1,187 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file python_insitu.cpp
+//! \brief passes the MeshBlockPack arrays to a user function in an embedded Python
+//! interpreter, instead of writing them to a file.  Arrays are not copied: with GPU
+//! backends each array is passed as an object exposing the __cuda_array_interface__
+//! (which CuPy, PyTorch, Numba, and JAX accept directly, and which can be converted to a
+//! DLPack tensor without a copy), and with host backends as a NumPy array pointing at the
+//! View data.  Arrays must not be kept in Python beyond the call, since they may be
+//! reallocated by AMR or load balancing.
+//!
+//! The arrays passed are set by the comma-separated list arrays in the <output> block,
+//! with choices hydro_u, hydro_w, mhd_u, mhd_w, mhd_bcc, and z4c.  The user function is
+//! set by module (a module on the Python path, which includes the run directory) and
+//! function (default "analyze"), and is called as
+//!   function(cycle, time, gids, mb_size, arrays)
+//! where mb_size is a list of (x1min,x1max,x2min,x2max,x3min,x3max) of each MeshBlock in
+//! the pack, and arrays is a dict of (m,n,k,j,i) arrays including ghost zones.  The
+//! cadence of calls is set by the dt or dcycle parameters as for any other output.
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "hydro/hydro.hpp"
+#include "mhd/mhd.hpp"
+#include "z4c/z4c.hpp"
+#include "outputs.hpp"
+
+#if PYTHON_ENABLED
+#include <pybind11/embed.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+// number of MeshPythonOutput objects sharing the interpreter
+int MeshPythonOutput::ninstances = 0;
+
+namespace {
+//----------------------------------------------------------------------------------------
+//! \fn py::object WrapArray()
+//! \brief Returns object referring to data of the first nmb MeshBlocks in array a
+//! without copying it.  Arrays may be allocated for more MBs than are in the pack.
+
+py::object WrapArray(const DvceArray5D<Real> &a, int nmb) {
+  std::vector<py::ssize_t> shape(5), strides(5);
+  for (int d=0; d<5; ++d) {
+    shape[d] = static_cast<py::ssize_t>(a.extent(d));
+    strides[d] = static_cast<py::ssize_t>(a.stride(d)*sizeof(Real));
+  }
+  shape[0] = std::min(shape[0], static_cast<py::ssize_t>(nmb));
+  if (Kokkos::SpaceAccessibility<Kokkos::HostSpace, DevMemSpace>::accessible) {
+    // capsule with empty destructor as base, so NumPy does not copy or own the data
+    py::capsule base(a.data(), [](void *) {});
+    return py::array(py::dtype::of<Real>(), shape, strides, a.data(), base);
+  }
+  py::dict cai;
+  cai["shape"] = py::tuple(py::cast(shape));
+  cai["strides"] = py::tuple(py::cast(strides));
+  cai["typestr"] = (sizeof(Real) == 8)? "<f8" : "<f4";
+  cai["data"] = py::make_tuple(reinterpret_cast<std::uintptr_t>(a.data()), false);
+  cai["version"] = 3;
+  py::object ns = py::module_::import("types").attr("SimpleNamespace");
+  py::dict kwargs;
+  kwargs["__cuda_array_interface__"] = cai;
+  return ns(**kwargs);
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+// Constructor: also calls BaseTypeOutput base class constructor, starts the Python
+// interpreter (on first call), and imports the user function
+
+MeshPythonOutput::MeshPythonOutput(ParameterInput *pin, Mesh *pm, OutputParameters op) :
+  BaseTypeOutput(pin, pm, op) {
+  std::string slist = pin->GetOrAddString(op.block_name, "arrays", "hydro_w");
+  std::stringstream ss(slist);
+  std::string s;
+  auto pmbp = pm->pmb_pack;
+  while (std::getline(ss, s, ',')) {
+    s.erase(0, s.find_first_not_of(" \t"));
+    s.erase(s.find_last_not_of(" \t") + 1);
+    if (s.empty()) continue;
+    bool ok = false;
+    if (s.compare(0, 6, "hydro_") == 0) {
+      ok = (pmbp->phydro != nullptr) && (s == "hydro_u" || s == "hydro_w");
+    } else if (s.compare(0, 4, "mhd_") == 0) {
+      ok = (pmbp->pmhd != nullptr) && (s == "mhd_u" || s == "mhd_w" || s == "mhd_bcc");
+    } else if (s == "z4c") {
+      ok = (pmbp->pz4c != nullptr);
+    }
+    if (!(ok)) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Array '" << s << "' in output block '" << op.block_name
+                << "' is not a valid choice, or its physics module does not exist"
+                << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    array_names.push_back(s);
+  }
+
+  if (ninstances == 0 && !(Py_IsInitialized())) {py::initialize_interpreter();}
+  ninstances++;
+  std::string mname = pin->GetString(op.block_name, "module");
+  std::string fname = pin->GetOrAddString(op.block_name, "function", "analyze");
+  try {
+    py::module_::import("sys").attr("path").attr("insert")(0, ".");
+    pfunc = new py::object(py::module_::import(mname.c_str()).attr(fname.c_str()));
+  } catch (py::error_already_set &e) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Python function '" << mname << "." << fname
+              << "' in output block '" << op.block_name << "' could not be loaded:"
+              << std::endl << e.what() << std::endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+// Destructor: releases user function, and stops the interpreter after the last output
+
+MeshPythonOutput::~MeshPythonOutput() {
+  delete pfunc;
+  ninstances--;
+  if (ninstances == 0) {py::finalize_interpreter();}
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshPythonOutput:::WriteOutputFile(Mesh *pm)
+//  \brief Calls user Python function with the selected arrays on all MeshBlocks.
+
+void MeshPythonOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
+  auto pmbp = pm->pmb_pack;
+  int nmb = pmbp->nmb_thispack;
+
+  // arrays are read in Python on another stream, so all kernels must be complete
+  Kokkos::fence();
+
+  try {
+    py::list gids, mb_size;
+    auto &size = pmbp->pmb->mb_size;
+    for (int m=0; m<nmb; ++m) {
+      gids.append(pmbp->gids + m);
+      mb_size.append(py::make_tuple(size.h_view(m).x1min, size.h_view(m).x1max,
+                     size.h_view(m).x2min, size.h_view(m).x2max,
+                     size.h_view(m).x3min, size.h_view(m).x3max));
+    }
+    py::dict arrays;
+    for (auto &s : array_names) {
+      if (s == "hydro_u") {arrays[s.c_str()] = WrapArray(pmbp->phydro->u0, nmb);}
+      if (s == "hydro_w") {arrays[s.c_str()] = WrapArray(pmbp->phydro->w0, nmb);}
+      if (s == "mhd_u") {arrays[s.c_str()] = WrapArray(pmbp->pmhd->u0, nmb);}
+      if (s == "mhd_w") {arrays[s.c_str()] = WrapArray(pmbp->pmhd->w0, nmb);}
+      if (s == "mhd_bcc") {arrays[s.c_str()] = WrapArray(pmbp->pmhd->bcc0, nmb);}
+      if (s == "z4c") {arrays[s.c_str()] = WrapArray(pmbp->pz4c->u0, nmb);}
+    }
+    (*pfunc)(pm->ncycle, static_cast<double>(pm->time), gids, mb_size, arrays);
+  } catch (py::error_already_set &e) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Python function failed in output block '"
+              << out_params.block_name << "':" << std::endl << e.what() << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // increment counters
+  out_params.file_number++;
+  if (out_params.last_time < 0.0) {
+    out_params.last_time = pm->time;
+  } else {
+    out_params.last_time += out_params.dt;
+  }
+  pin->SetInteger(out_params.block_name, "file_number", out_params.file_number);
+  pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
+
+  return;
+}
+#endif // PYTHON_ENABLED
@@ -0,0 +1,293 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file radial_profile.cpp
+//! \brief writes radial profiles of output variables computed on the device (file_type
+//! = prof): averages over spherical shells, or over (r,theta) bins of shells in polar
+//! angle, so that profiles can be written at high cadence without dumping 3D snapshots.
+//!
+//! Cells are binned by the radius and polar angle of their centers into <output>/nr bins
+//! between <output>/rmin (default 0) and <output>/rmax, logarithmically spaced if
+//! <output>/logr = true, and <output>/ntheta (default 1) bins of polar angle in [0,pi].
+//! Each cell contributes with weight sqrt(-g) dV, where sqrt(-g) = alpha sqrt(gamma) is
+//! computed from the Kerr-Schild metric in GR, from the ADM variables in dynamical GR,
+//! and is 1 otherwise, times the density rho if <output>/mass_weighted = true.  In GR the
+//! radius is the Kerr-Schild radius, so shells follow the horizon for spinning black
+//! holes.  Each team accumulates the weighted sums of a k-plane of a MeshBlock in bins in
+//! scratch memory, which are then added to the profile with one atomic per bin, and the
+//! profiles are summed over ranks in one reduction onto the root process.
+//!
+//! Files are ASCII tables with the bin centers, total weight (volume or mass) of each
+//! bin, and the weighted averages of each variable.  Empty bins have zero averages.
+
+#include <sys/stat.h>  // mkdir
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "coordinates/adm.hpp"
+#include "coordinates/cartesian_ks.hpp"
+#include "coordinates/cell_locations.hpp"
+#include "hydro/hydro.hpp"
+#include "mhd/mhd.hpp"
+#include "outputs.hpp"
+
+namespace {
+// largest profile (bins times variables) accumulated in scratch memory of each team
+constexpr int max_private_bins = 4096;
+} // namespace
+
+//----------------------------------------------------------------------------------------
+// Constructor: also calls BaseTypeOutput base class constructor
+
+RadialProfileOutput::RadialProfileOutput(ParameterInput *pin, Mesh *pm,
+                                         OutputParameters op) :
+  BaseTypeOutput(pin, pm, op),
+  d_prof("d_prof",1,1),
+  prof("prof",1,1) {
+  // create directories for outputs. Comments in binary.cpp constructor explain why
+  mkdir(op.file_type.c_str(),0775);
+
+  nr = pin->GetInteger(op.block_name, "nr");
+  rmin = pin->GetOrAddReal(op.block_name, "rmin", 0.0);
+  rmax = pin->GetReal(op.block_name, "rmax");
+  logr = pin->GetOrAddBoolean(op.block_name, "logr", false);
+  ntheta = pin->GetOrAddInteger(op.block_name, "ntheta", 1);
+  mass_weighted = pin->GetOrAddBoolean(op.block_name, "mass_weighted", false);
+  if (nr < 1 || ntheta < 1 || rmax <= rmin || rmin < 0.0 || (logr && rmin <= 0.0)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Profile in block '" << op.block_name << "' requires "
+              << "nr,ntheta >= 1 and 0 <= rmin < rmax (rmin > 0 if logr = true)"
+              << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  if (mass_weighted && pm->pmb_pack->phydro == nullptr && pm->pmb_pack->pmhd == nullptr) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Mass-weighted profile in block '" << op.block_name
+              << "' requires Hydro or MHD" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void RadialProfileOutput::LoadOutputData()
+//  \brief Computes the total weight, and weighted sums of each output variable, in each
+//  bin on the device, and sums them over all ranks on the root process.
+
+void RadialProfileOutput::LoadOutputData(Mesh *pm) {
+  if (out_params.contains_derived) {
+    ComputeDerivedVariables(pm);
+  }
+  int nvar = outvars.size();
+  int nw = nvar + 1;
+  int nbin = nr*ntheta;
+  if (d_prof.extent_int(0) != nbin || d_prof.extent_int(1) != nw) {
+    Kokkos::realloc(d_prof, nbin, nw);
+    Kokkos::realloc(prof, nbin, nw);
+  }
+  Kokkos::deep_copy(d_prof, 0.0);
+
+  auto &indcs = pm->mb_indcs;
+  int is = indcs.is, ie = indcs.ie, nx1 = indcs.nx1;
+  int js = indcs.js, je = indcs.je, nx2 = indcs.nx2;
+  int ks = indcs.ks, ke = indcs.ke, nx3 = indcs.nx3;
+  int nmb = pm->pmb_pack->nmb_thispack;
+  auto &size = pm->pmb_pack->pmb->mb_size;
+
+  // gather variables from their device arrays
+  DvceArray5D<Real> stg("prof_stage", nmb, nvar, nx3, nx2, nx1);
+  for (int n=0; n<nvar; ++n) {
+    auto var = *(outvars[n].data_ptr);
+    int indx = outvars[n].data_index;
+    par_for("prof_gather",DevExeSpace(),0,(nmb-1),0,(nx3-1),0,(nx2-1),0,(nx1-1),
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      stg(m,n,k,j,i) = var(m,indx,ks+k,js+j,is+i);
+    });
+  }
+
+  // metric and density used in weights
+  auto &coord = pm->pmb_pack->pcoord->coord_data;
+  bool is_gr = pm->pmb_pack->pcoord->is_general_relativistic;
+  bool is_dyngr = pm->pmb_pack->pcoord->is_dynamical_relativistic;
+  DvceArray5D<Real> u_adm, w0;
+  if (is_dyngr) {u_adm = pm->pmb_pack->padm->u_adm;}
+  bool mass_wght = mass_weighted;
+  if (mass_wght) {
+    w0 = (pm->pmb_pack->phydro != nullptr)? pm->pmb_pack->phydro->w0 :
+                                             pm->pmb_pack->pmhd->w0;
+  }
+
+  int nrad = nr, nth = ntheta;
+  bool lgr = logr;
+  Real r0 = rmin;
+  Real dr = (logr)? std::log(rmax/rmin)/static_cast<Real>(nr) :
+                    (rmax - rmin)/static_cast<Real>(nr);
+  Real dth = M_PI/static_cast<Real>(ntheta);
+
+  // With few enough bins, each team accumulates the profile of one k-plane of a
+  // MeshBlock in scratch memory, otherwise cells are added directly to the profile.
+  int nres = nbin*nw;
+  bool priv = (nres <= max_private_bins);
+  int ni = ie - is + 1;
+  int nji = (je - js + 1)*ni;
+  auto prf = d_prof;
+  size_t scr_size = ScrArray1D<Real>::shmem_size((priv)? nres : 1);
+  par_for_outer("prof", DevExeSpace(), scr_size, 0, 0, (nmb-1), ks, ke,
+  KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k) {
+    ScrArray1D<Real> hist(member.team_scratch(0), (priv)? nres : 1);
+    if (priv) {
+      par_for_inner(member, 0, (nres-1), [&](const int n) {
+        hist(n) = 0.0;
+      });
+      member.team_barrier();
+    }
+    Real *acc = (priv)? hist.data() : prf.data();
+
+    auto &sz = size.d_view(m);
+    Real x3 = CellCenterX(k-ks, nx3, sz.x3min, sz.x3max);
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(member, nji), [&](const int idx) {
+      int j = idx/ni + js;
+      int i = idx%ni + is;
+      Real x1 = CellCenterX(i-is, nx1, sz.x1min, sz.x1max);
+      Real x2 = CellCenterX(j-js, nx2, sz.x2min, sz.x2max);
+      Real rad = sqrt(SQR(x1) + SQR(x2) + SQR(x3));
+      if (is_gr) {
+        // Kerr-Schild radius
+        Real a = coord.bh_spin;
+        rad = sqrt((SQR(rad) - SQR(a) + sqrt(SQR(SQR(rad) - SQR(a)) +
+                    4.0*SQR(a)*SQR(x3)))/2.0);
+      }
+      if (rad < r0) return;
+      Real xr = (lgr)? log(rad/r0)/dr : (rad - r0)/dr;
+      if (xr >= static_cast<Real>(nrad)) return;
+      int ir = static_cast<int>(xr);
+      int it = 0;
+      if (nth > 1 && rad > 0.0) {
+        Real cth = fmin(fmax(x3/rad, -1.0), 1.0);
+        it = static_cast<int>(acos(cth)/dth);
+        it = (it < nth)? it : nth - 1;
+      }
+
+      Real wght = sz.dx1*sz.dx2*sz.dx3;
+      if (is_gr) {
+        Real glower[4][4], gupper[4][4];
+        ComputeMetricAndInverse(x1, x2, x3, coord.is_minkowski, coord.bh_spin,
+                                glower, gupper);
+        Real detg = adm::SpatialDet(glower[1][1], glower[1][2], glower[1][3],
+                                    glower[2][2], glower[2][3], glower[3][3]);
+        wght *= sqrt(detg/(-gupper[0][0]));
+      } else if (is_dyngr) {
+        Real detg = adm::SpatialDet(u_adm(m,adm::ADM::I_ADM_GXX,k,j,i),
+                                    u_adm(m,adm::ADM::I_ADM_GXY,k,j,i),
+                                    u_adm(m,adm::ADM::I_ADM_GXZ,k,j,i),
+                                    u_adm(m,adm::ADM::I_ADM_GYY,k,j,i),
+                                    u_adm(m,adm::ADM::I_ADM_GYZ,k,j,i),
+                                    u_adm(m,adm::ADM::I_ADM_GZZ,k,j,i));
+        wght *= u_adm(m,adm::ADM::I_ADM_ALPHA,k,j,i)*sqrt(detg);
+      }
+      if (mass_wght) {wght *= w0(m,IDN,k,j,i);}
+      int b = (it*nrad + ir)*nw;
+      Kokkos::atomic_add(&acc[b], wght);
+      for (int n=0; n<nvar; ++n) {
+        Kokkos::atomic_add(&acc[b + 1 + n], wght*stg(m,n,k-ks,j-js,i-is));
+      }
+    });
+
+    if (priv) {
+      member.team_barrier();
+      par_for_inner(member, 0, (nres-1), [&](const int n) {
+        if (hist(n) != 0.0) {
+          Kokkos::atomic_add(&prf.data()[n], hist(n));
+        }
+      });
+    }
+  });
+
+  // copy profile to host and sum over ranks
+  Kokkos::deep_copy(prof, d_prof);
+#if MPI_PARALLEL_ENABLED
+  if (global_variable::my_rank == 0) {
+    MPI_Reduce(MPI_IN_PLACE, prof.data(), prof.size(), MPI_ATHENA_REAL, MPI_SUM, 0,
+               global_variable::athena_comm);
+  } else {
+    MPI_Reduce(prof.data(), prof.data(), prof.size(), MPI_ATHENA_REAL, MPI_SUM, 0,
+               global_variable::athena_comm);
+  }
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void RadialProfileOutput::WriteOutputFile()
+//  \brief Writes profile of each variable from root process.
+
+void RadialProfileOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
+  if (global_variable::my_rank == 0) {
+    // create filename: "prof/file_basename" + "." + "file_id" + "." + XXXXX + ".prof",
+    // where XXXXX = 5-digit file_number
+    std::string fname;
+    char number[6];
+    std::snprintf(number, sizeof(number), "%05d", out_params.file_number);
+    fname.assign(out_params.file_type);
+    fname.append("/");
+    fname.append(out_params.file_basename);
+    fname.append(".");
+    fname.append(out_params.file_id);
+    fname.append(".");
+    fname.append(number);
+    fname.append(".");
+    fname.append(out_params.file_type);
+
+    FILE *pfile;
+    if ((pfile = std::fopen(fname.c_str(),"w")) == nullptr) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Output file '" << fname << "' could not be opened"
+                << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    std::fprintf(pfile, "# Athena++ profile output at time=%e cycle=%d nr=%d ntheta=%d\n",
+                 pm->time, pm->ncycle, nr, ntheta);
+    std::fprintf(pfile, "# [1]=r [2]=theta [3]=%s", (mass_weighted)? "mass" : "volume");
+    for (int v=0; v<static_cast<int>(outvars.size()); ++v) {
+      std::fprintf(pfile, " [%d]=%s", v+4, outvars[v].label.c_str());
+    }
+    std::fprintf(pfile, "\n");
+    Real dr = (logr)? std::log(rmax/rmin)/static_cast<Real>(nr) :
+                      (rmax - rmin)/static_cast<Real>(nr);
+    Real dth = M_PI/static_cast<Real>(ntheta);
+    for (int it=0; it<ntheta; ++it) {
+      for (int ir=0; ir<nr; ++ir) {
+        int b = it*nr + ir;
+        Real rc = (logr)? rmin*std::exp((ir + 0.5)*dr) : rmin + (ir + 0.5)*dr;
+        std::fprintf(pfile, out_params.data_format.c_str(), rc);
+        std::fprintf(pfile, out_params.data_format.c_str(), (it + 0.5)*dth);
+        std::fprintf(pfile, out_params.data_format.c_str(), prof(b,0));
+        for (int v=1; v<prof.extent_int(1); ++v) {
+          Real avg = (prof(b,0) > 0.0)? prof(b,v)/prof(b,0) : 0.0;
+          std::fprintf(pfile, out_params.data_format.c_str(), avg);
+        }
+        std::fprintf(pfile, "\n");
+      }
+    }
+    std::fclose(pfile);
+  }
+
+  // increment counters
+  out_params.file_number++;
+  if (out_params.last_time < 0.0) {
+    out_params.last_time = pm->time;
+  } else {
+    out_params.last_time += out_params.dt;
+  }
+  pin->SetInteger(out_params.block_name, "file_number", out_params.file_number);
+  pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
+  return;
+}
@@ -0,0 +1,416 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file ray_tracing.cpp
+//! \brief writes synthetic images and light curves computed in-situ by ray tracing
+//! through GR Hydro or MHD data in Cartesian Kerr-Schild coordinates (file_type = rt),
+//! so that images can be made at high cadence without dumping full snapshots.
+//!
+//! Null geodesics are integrated backwards from a distant camera at radius
+//! <output>/r_obs (default 1000) and inclination <output>/inclination (degrees from the
+//! spin axis, default 60) towards the black hole, through <output>/npix x npix pixels
+//! covering [-fov,fov] in each direction of the image plane (default npix=64, fov=20).
+//! Since the metric is stationary, geodesics are only integrated once (on the host, by
+//! every rank) in the constructor, and points along each ray inside the Mesh are stored
+//! in a PointInterpolator, which locates them again only when the Mesh changes.
+//!
+//! At each output, primitive variables are interpolated to all points on the device,
+//! and an optically thin emissivity is accumulated along each ray, including the
+//! redshift factor g, as I = int g^3 j dlambda.  The emissivity is chosen with
+//! <output>/emission, one of
+//!   density:        j = rho
+//!   bremsstrahlung: j = rho^2 T^(1/2), with T = p/rho (default)
+//!   synchrotron:    j = rho^3 p^(-2) exp(-0.2 (rho^2/(|b| p^2))^(1/3))  (MHD only)
+//! Only the image is summed over ranks and written by the root process, in the format of
+//! projection outputs (see projection.cpp).  The total flux is appended to the light
+//! curve "basename.id.lc".
+
+#include <sys/stat.h>  // mkdir
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "coordinates/coordinates.hpp"
+#include "coordinates/cartesian_ks.hpp"
+#include "eos/eos.hpp"
+#include "hydro/hydro.hpp"
+#include "mhd/mhd.hpp"
+#include "utils/point_interpolator.hpp"
+#include "outputs.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn Real KerrSchildRadius()
+//  \brief returns Kerr-Schild radius r of Cartesian point (x,y,z) for spin a
+
+static Real KerrSchildRadius(Real x, Real y, Real z, Real a) {
+  Real rad2 = SQR(x) + SQR(y) + SQR(z);
+  return sqrt((rad2 - SQR(a) + sqrt(SQR(rad2 - SQR(a)) + 4.0*SQR(a)*SQR(z)))/2.0);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void GeodesicRHS()
+//  \brief computes derivatives of state s = (x^1,x^2,x^3,k_1,k_2,k_3) of a null geodesic
+//  with respect to affine parameter, where k_0 = 1:
+//    dx^i/dlambda = g^{i mu} k_mu,  dk_i/dlambda = (1/2) d_i g_{mu nu} k^mu k^nu
+
+static void GeodesicRHS(const Real s[6], bool flat, Real a, Real ds[6]) {
+  Real glower[4][4], gupper[4][4];
+  ComputeMetricAndInverse(s[0], s[1], s[2], flat, a, glower, gupper);
+  Real kl[4] = {1.0, s[3], s[4], s[5]};
+  Real ku[4];
+  for (int mu=0; mu<4; ++mu) {
+    ku[mu] = 0.0;
+    for (int nu=0; nu<4; ++nu) {ku[mu] += gupper[mu][nu]*kl[nu];}
+  }
+  Real dg[3][4][4];
+  ComputeMetricDerivatives(s[0], s[1], s[2], flat, a, dg[0], dg[1], dg[2]);
+  for (int i=0; i<3; ++i) {
+    ds[i] = ku[i+1];
+    ds[3+i] = 0.0;
+    for (int mu=0; mu<4; ++mu) {
+      for (int nu=0; nu<4; ++nu) {ds[3+i] += 0.5*dg[i][mu][nu]*ku[mu]*ku[nu];}
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------
+// Constructor: also calls BaseTypeOutput base class constructor.  Integrates geodesics
+// of all rays, and stores points along them inside the Mesh in the PointInterpolator.
+
+RayTracingOutput::RayTracingOutput(ParameterInput *pin, Mesh *pm, OutputParameters op) :
+  BaseTypeOutput(pin, pm, op),
+  ray("rt_ray",1),
+  kdl("rt_kdl",1,1),
+  d_prim("rt_prim",1,1),
+  d_image("rt_image",1),
+  image("rt_image",1) {
+  // create directories for outputs. Comments in binary.cpp constructor explain why
+  mkdir(op.file_type.c_str(),0775);
+
+  MeshBlockPack *pmbp = pm->pmb_pack;
+  if (pmbp->pcoord == nullptr || !(pmbp->pcoord->is_general_relativistic) ||
+      !(pm->three_d)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Ray tracing in block '" << op.block_name
+              << "' requires GR Hydro or MHD on a 3D Mesh" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  npix = pin->GetOrAddInteger(op.block_name, "npix", 64);
+  fov = pin->GetOrAddReal(op.block_name, "fov", 20.0);
+  inclination = pin->GetOrAddReal(op.block_name, "inclination", 60.0);
+  r_obs = pin->GetOrAddReal(op.block_name, "r_obs", 1000.0);
+  emission = pin->GetOrAddString(op.block_name, "emission", "bremsstrahlung");
+  Real step_frac = pin->GetOrAddReal(op.block_name, "step_frac", 0.05);
+  int max_steps = pin->GetOrAddInteger(op.block_name, "max_steps", 100000);
+  if (npix < 1 || fov <= 0.0 || step_frac <= 0.0) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Ray tracing in block '" << op.block_name
+              << "' requires npix >= 1, fov > 0, and step_frac > 0" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  if (emission.compare("density") != 0 && emission.compare("bremsstrahlung") != 0 &&
+      emission.compare("synchrotron") != 0) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Emission '" << emission << "' in block '"
+              << op.block_name << "' must be density, bremsstrahlung, or synchrotron"
+              << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  if (emission.compare("synchrotron") == 0 && pmbp->pmhd == nullptr) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Synchrotron emission in block '" << op.block_name
+              << "' requires MHD" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
+  // camera direction n, and directions ea,eb of image plane
+  bool flat = pmbp->pcoord->coord_data.is_minkowski;
+  Real spin = pmbp->pcoord->coord_data.bh_spin;
+  Real inc = inclination*M_PI/180.0;
+  Real nd[3] = {sin(inc), 0.0, cos(inc)};
+  Real ea[3] = {0.0, 1.0, 0.0};
+  Real eb[3] = {-cos(inc), 0.0, sin(inc)};
+
+  // rays are stopped near the horizon, or once they leave the Mesh.  Inside the Mesh the
+  // step is also limited by the size of cells at the root level.
+  auto &ms = pm->mesh_size;
+  Real r_stop = 1.05*(1.0 + sqrt(std::max(1.0 - SQR(spin), 0.0)));
+  Real dl_max = std::min(ms.dx1, std::min(ms.dx2, ms.dx3));
+  Real dpix = 2.0*fov/static_cast<Real>(npix);
+  std::vector<Real> pts, pkdl;
+  std::vector<int> pray;
+  for (int jp=0; jp<npix; ++jp) {
+    for (int ip=0; ip<npix; ++ip) {
+      Real alpha = -fov + (static_cast<Real>(ip) + 0.5)*dpix;
+      Real beta  = -fov + (static_cast<Real>(jp) + 0.5)*dpix;
+      Real s[6];
+      for (int i=0; i<3; ++i) {s[i] = r_obs*nd[i] + alpha*ea[i] + beta*eb[i];}
+
+      // geodesic is traced backwards, with spatial tangent -n at the camera.  Find
+      // past-directed null tangent, and normalize so that k_0 = 1.
+      Real glower[4][4], gupper[4][4];
+      ComputeMetricAndInverse(s[0], s[1], s[2], flat, spin, glower, gupper);
+      Real ku[4] = {0.0, -nd[0], -nd[1], -nd[2]};
+      Real qa = glower[0][0], qb = 0.0, qc = 0.0;
+      for (int i=1; i<4; ++i) {
+        qb += 2.0*glower[0][i]*ku[i];
+        for (int j=1; j<4; ++j) {qc += glower[i][j]*ku[i]*ku[j];}
+      }
+      Real disc = sqrt(std::max(SQR(qb) - 4.0*qa*qc, 0.0));
+      ku[0] = std::min((-qb + disc)/(2.0*qa), (-qb - disc)/(2.0*qa));
+      Real kl[4];
+      for (int mu=0; mu<4; ++mu) {
+        kl[mu] = 0.0;
+        for (int nu=0; nu<4; ++nu) {kl[mu] += glower[mu][nu]*ku[nu];}
+      }
+      for (int i=0; i<3; ++i) {s[3+i] = kl[i+1]/kl[0];}
+
+      // integrate with RK4, storing points inside the Mesh with their step length
+      bool entered = false;
+      for (int n=0; n<max_steps; ++n) {
+        Real r = KerrSchildRadius(s[0], s[1], s[2], spin);
+        if (r < r_stop) break;
+        // distance from point to the Mesh (zero inside)
+        Real d2 = 0.0;
+        d2 += SQR(std::max(std::max(ms.x1min - s[0], s[0] - ms.x1max), 0.0));
+        d2 += SQR(std::max(std::max(ms.x2min - s[1], s[1] - ms.x2max), 0.0));
+        d2 += SQR(std::max(std::max(ms.x3min - s[2], s[2] - ms.x3max), 0.0));
+        bool inside = (d2 == 0.0);
+        if ((entered && !(inside)) || r > 1.01*r_obs) break;
+        entered = entered || inside;
+        Real dl = (inside)? std::min(step_frac*r, dl_max) :
+                            std::max(std::min(step_frac*r, sqrt(d2)), dl_max);
+
+        Real k1[6], k2[6], k3[6], k4[6], st[6];
+        GeodesicRHS(s, flat, spin, k1);
+        for (int i=0; i<6; ++i) {st[i] = s[i] + 0.5*dl*k1[i];}
+        GeodesicRHS(st, flat, spin, k2);
+        for (int i=0; i<6; ++i) {st[i] = s[i] + 0.5*dl*k2[i];}
+        GeodesicRHS(st, flat, spin, k3);
+        for (int i=0; i<6; ++i) {st[i] = s[i] + dl*k3[i];}
+        GeodesicRHS(st, flat, spin, k4);
+        for (int i=0; i<6; ++i) {
+          s[i] += dl*(k1[i] + 2.0*k2[i] + 2.0*k3[i] + k4[i])/6.0;
+        }
+        if (inside) {
+          for (int i=0; i<3; ++i) {pts.push_back(s[i]);}
+          for (int i=0; i<3; ++i) {pkdl.push_back(s[3+i]);}
+          pkdl.push_back(dl);
+          pray.push_back(jp*npix + ip);
+        }
+      }
+    }
+  }
+
+  // store points in PointInterpolator, and rays and tangents on device
+  npts = static_cast<int>(pray.size());
+  pinterp = new PointInterpolator(pmbp, std::max(npts,1));
+  Kokkos::realloc(ray, std::max(npts,1));
+  Kokkos::realloc(kdl, std::max(npts,1), 4);
+  for (int n=0; n<npts; ++n) {
+    for (int i=0; i<3; ++i) {pinterp->coords.h_view(n,i) = pts[3*n+i];}
+    for (int i=0; i<4; ++i) {kdl.h_view(n,i) = pkdl[4*n+i];}
+    ray.h_view(n) = pray[n];
+  }
+  // any unused point is placed outside the Mesh, so it is never owned
+  if (npts == 0) {
+    pinterp->coords.h_view(0,0) = 2.0*ms.x1max - ms.x1min;
+    pinterp->coords.h_view(0,1) = 0.0;
+    pinterp->coords.h_view(0,2) = 0.0;
+    kdl.h_view(0,3) = 0.0;
+    ray.h_view(0) = 0;
+  }
+  ray.template modify<HostMemSpace>();
+  ray.template sync<DevExeSpace>();
+  kdl.template modify<HostMemSpace>();
+  kdl.template sync<DevExeSpace>();
+  Kokkos::realloc(d_image, npix*npix);
+  Kokkos::realloc(image, npix*npix);
+}
+
+//----------------------------------------------------------------------------------------
+// destructor
+
+RayTracingOutput::~RayTracingOutput() {
+  delete pinterp;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void RayTracingOutput::LoadOutputData()
+//  \brief Interpolates primitive variables to all points along rays, accumulates the
+//  emission of each point into its pixel on the device, and sums the image over all
+//  ranks on the root process.
+
+void RayTracingOutput::LoadOutputData(Mesh *pm) {
+  MeshBlockPack *pmbp = pm->pmb_pack;
+  if (pinterp->version != pm->mesh_version) {pinterp->SetPoints();}
+
+  bool is_mhd = (pmbp->pmhd != nullptr);
+  DvceArray5D<Real> &w0 = (is_mhd)? pmbp->pmhd->w0 : pmbp->phydro->w0;
+  Real gm1 = ((is_mhd)? pmbp->pmhd->peos->eos_data.gamma :
+                        pmbp->phydro->peos->eos_data.gamma) - 1.0;
+  int iemis = (emission.compare("density") == 0)? 0 :
+              ((emission.compare("bremsstrahlung") == 0)? 1 : 2);
+
+  // interpolate primitives, then (for synchrotron) cell-centered fields
+  int np = pinterp->npoints;
+  pinterp->Interpolate(5, w0);
+  if (d_prim.extent_int(0) != np) {Kokkos::realloc(d_prim, np, 5);}
+  Kokkos::deep_copy(d_prim, pinterp->vals.d_view);
+  if (iemis == 2) {pinterp->Interpolate(3, pmbp->pmhd->bcc0);}
+
+  auto wv = d_prim;
+  auto bv = pinterp->vals.d_view;
+  auto crd = pinterp->coords.d_view;
+  auto kv = kdl.d_view;
+  auto rv = ray.d_view;
+  auto img = d_image;
+  bool flat = pmbp->pcoord->coord_data.is_minkowski;
+  Real spin = pmbp->pcoord->coord_data.bh_spin;
+  Kokkos::deep_copy(img, 0.0);
+  par_for("rt_emit",DevExeSpace(),0,(np-1),
+  KOKKOS_LAMBDA(int n) {
+    // values are zero at points not on this rank, and interpolation may undershoot
+    Real dens = wv(n,IDN);
+    Real pres = gm1*wv(n,IEN);
+    if (dens <= 0.0 || pres <= 0.0) return;
+
+    Real glower[4][4], gupper[4][4];
+    ComputeMetricAndInverse(crd(n,0), crd(n,1), crd(n,2), flat, spin, glower, gupper);
+
+    // fluid 4-velocity from normal-frame velocity
+    Real uu1 = wv(n,IVX), uu2 = wv(n,IVY), uu3 = wv(n,IVZ);
+    Real tmp = glower[1][1]*uu1*uu1 + 2.0*glower[1][2]*uu1*uu2 + 2.0*glower[1][3]*uu1*uu3
+             + glower[2][2]*uu2*uu2 + 2.0*glower[2][3]*uu2*uu3 + glower[3][3]*uu3*uu3;
+    Real gamma = sqrt(1.0 + tmp);
+    Real lapse = sqrt(1.0/fmax(-gupper[0][0], 1.0e-20));
+    Real u[4];
+    u[0] = gamma/lapse;
+    u[1] = uu1 - gamma*lapse*gupper[0][1];
+    u[2] = uu2 - gamma*lapse*gupper[0][2];
+    u[3] = uu3 - gamma*lapse*gupper[0][3];
+
+    // redshift factor g = 1/(k_mu u^mu), for k_0 = 1
+    Real ku = u[0] + kv(n,0)*u[1] + kv(n,1)*u[2] + kv(n,2)*u[3];
+    if (ku <= 0.0) return;
+    Real g = 1.0/ku;
+
+    Real j;
+    if (iemis == 0) {
+      j = dens;
+    } else if (iemis == 1) {
+      j = SQR(dens)*sqrt(pres/dens);
+    } else {
+      // fluid-frame field b^2 from cell-centered fields B^i
+      Real b0 = 0.0, bsq = 0.0;
+      for (int i=1; i<4; ++i) {
+        for (int mu=0; mu<4; ++mu) {b0 += glower[i][mu]*bv(n,i-1)*u[mu];}
+        for (int k=1; k<4; ++k) {bsq += glower[i][k]*bv(n,i-1)*bv(n,k-1);}
+      }
+      Real bmag = sqrt((bsq + SQR(b0))/SQR(u[0]));
+      if (bmag <= 0.0) return;
+      j = dens*SQR(dens/pres)*exp(-0.2*cbrt(SQR(dens)/(bmag*SQR(pres))));
+    }
+    Kokkos::atomic_add(&img(rv(n)), g*g*g*j*kv(n,3));
+  });
+
+  // copy image to host and sum over ranks
+  Kokkos::deep_copy(image, d_image);
+#if MPI_PARALLEL_ENABLED
+  if (global_variable::my_rank == 0) {
+    MPI_Reduce(MPI_IN_PLACE, image.data(), image.size(), MPI_ATHENA_REAL, MPI_SUM, 0,
+               global_variable::athena_comm);
+  } else {
+    MPI_Reduce(image.data(), image.data(), image.size(), MPI_ATHENA_REAL, MPI_SUM, 0,
+               global_variable::athena_comm);
+  }
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void RayTracingOutput::WriteOutputFile()
+//  \brief Writes image from root process, and appends its total flux to light curve
+
+void RayTracingOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
+  if (global_variable::my_rank == 0) {
+    // create filename: "rt/file_basename" + "." + "file_id" + "." + XXXXX + ".rt",
+    // where XXXXX = 5-digit file_number
+    std::string fname;
+    char number[6];
+    std::snprintf(number, sizeof(number), "%05d", out_params.file_number);
+    fname.assign(out_params.file_type);
+    fname.append("/");
+    fname.append(out_params.file_basename);
+    fname.append(".");
+    fname.append(out_params.file_id);
+    fname.append(".");
+    fname.append(number);
+    fname.append(".");
+    fname.append(out_params.file_type);
+
+    FILE *pfile;
+    if ((pfile = std::fopen(fname.c_str(),"wb")) == nullptr) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Output file '" << fname << "' could not be opened"
+                << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    std::fprintf(pfile, "# Athena++ ray-traced image at time=%e cycle=%d\n",
+                 pm->time, pm->ncycle);
+    std::fprintf(pfile, "# npix=%d fov=%e inclination=%e r_obs=%e spin=%e emission=%s\n",
+                 npix, fov, inclination, r_obs, pm->pmb_pack->pcoord->coord_data.bh_spin,
+                 emission.c_str());
+    std::fprintf(pfile, "# data\n");
+    std::vector<float> data(npix);
+    Real flux = 0.0;
+    for (int j=0; j<npix; ++j) {
+      for (int i=0; i<npix; ++i) {
+        data[i] = static_cast<float>(image(j*npix + i));
+        flux += image(j*npix + i);
+      }
+      std::fwrite(data.data(), sizeof(float), npix, pfile);
+    }
+    std::fclose(pfile);
+
+    // append flux (summed over pixels of area in image plane) to light curve
+    flux *= SQR(2.0*fov/static_cast<Real>(npix));
+    fname = out_params.file_basename + "." + out_params.file_id + ".lc";
+    bool new_file = (out_params.file_number == 0);
+    if ((pfile = std::fopen(fname.c_str(), (new_file)? "w" : "a")) == nullptr) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Output file '" << fname << "' could not be opened"
+                << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    if (new_file) {
+      std::fprintf(pfile, "# Athena++ light curve, emission=%s\n", emission.c_str());
+      std::fprintf(pfile, "# [1]=time     [2]=flux\n");
+    }
+    std::fprintf(pfile, out_params.data_format.c_str(), pm->time);
+    std::fprintf(pfile, out_params.data_format.c_str(), flux);
+    std::fprintf(pfile, "\n");
+    std::fclose(pfile);
+  }
+
+  // increment counters
+  out_params.file_number++;
+  if (out_params.last_time < 0.0) {
+    out_params.last_time = pm->time;
+  } else {
+    out_params.last_time += out_params.dt;
+  }
+  pin->SetInteger(out_params.block_name, "file_number", out_params.file_number);
+  pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
+  return;
+}
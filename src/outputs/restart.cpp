@@ -5,17 +5,29 @@
 //========================================================================================
 //! \file restart.cpp
 //! \brief writes restart files
+//!
+//! With <output>/local_dir set (which requires ranks_per_file > 0, with each group of
+//! ranks on one node), data files are first written to that directory on node-local
+//! storage (e.g. NVMe or a burst buffer), and the run continues while the first rank of
+//! each group copies its file to the rst directory in a background thread.  Copies are
+//! written to a temporary file and renamed when complete, and the local files removed
+//! unless <output>/keep_local = true.  On restart, data files not found in the rst
+//! directory are read from the local directory.
 
 #include <sys/stat.h>  // mkdir
 
 #include <algorithm>
+#include <cmath>
 #include <cstdio>      // fwrite(), fclose(), fopen(), fnprintf(), snprintf()
 #include <cstdlib>
+#include <cstring>     // memcpy()
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <utility> // make_pair
+#include <vector>
 
 #include "athena.hpp"
 #include "coordinates/cell_locations.hpp"
@@ -30,13 +42,117 @@
 #include "srcterms/turb_driver.hpp"
 //#include "outputs.hpp"
 
+namespace {
+//----------------------------------------------------------------------------------------
+//! \fn OutputParameters ImageOutputParameters()
+//! \brief parameters of restarts written to an in-memory image, which are not set by an
+//! <output> block
+
+OutputParameters ImageOutputParameters() {
+  OutputParameters op;
+  op.block_number = -1;
+  op.block_name = "rescale";
+  op.file_type = "rst";
+  op.file_basename = "rescale";
+  op.file_number = 0;
+  op.last_time = -1.0;
+  op.dt = -1.0;
+  op.dcycle = -1;
+  return op;
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------
 // ctor: also calls BaseTypeOutput base class constructor
 
 RestartOutput::RestartOutput(ParameterInput *pin, Mesh *pm, OutputParameters op) :
-  BaseTypeOutput(pin, pm, op) {
+  BaseTypeOutput(pin, pm, op),
+  base_field("rst-base-fc",1,1,1,1) {
   // create directories for outputs. Comments in binary.cpp constructor explain why
   mkdir("rst",0775);
+  // read number of ranks writing to each data file.  By default (0) all ranks write to
+  // one shared file, otherwise header is written to an index file, and data to files
+  // shared by groups of ranks_per_file ranks.
+  ranks_per_file = pin->GetOrAddInteger(op.block_name, "ranks_per_file", 0);
+  if (ranks_per_file < 0) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "ranks_per_file in output block '" << op.block_name
+              << "' must be >= 0" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  // read number of dumps between full restart files.  By default (0 or 1) every dump is
+  // a full restart, otherwise dumps in between are "delta" files that only contain
+  // MeshBlocks whose data has changed by more than delta_tol (relative to maximum value
+  // in MB) since the last full dump, and refer to the full dump for all other MBs.
+  full_every = pin->GetOrAddInteger(op.block_name, "full_every", 0);
+  delta_tol = pin->GetOrAddReal(op.block_name, "delta_tol", 0.0);
+  if (full_every > 1 && ranks_per_file > 0) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "full_every and ranks_per_file cannot both be used in "
+              << "output block '" << op.block_name << "'" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  // read directory on node-local storage to which data files are written first, before
+  // they are copied to rst directory (default "" writes directly to rst directory)
+  local_dir = pin->GetOrAddString(op.block_name, "local_dir", "");
+  keep_local = pin->GetOrAddBoolean(op.block_name, "keep_local", false);
+  if (!(local_dir.empty())) {
+    if (ranks_per_file < 1) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "local_dir in output block '" << op.block_name
+                << "' requires ranks_per_file >= 1" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    mkdir(local_dir.c_str(),0775);
+    mkdir((local_dir + "/rst").c_str(),0775);
+  }
+#if MPI_PARALLEL_ENABLED
+  if (ranks_per_file > 0) {
+    MPI_Comm_split(global_variable::athena_comm, global_variable::my_rank/ranks_per_file,
+                   global_variable::my_rank, &group_comm);
+    MPI_Comm_rank(group_comm, &group_rank);
+  }
+  // MPI-IO calls from background thread require MPI_THREAD_MULTIPLE
+  if (out_params.async_write) {
+    int mpiprv;
+    MPI_Query_thread(&mpiprv);
+    if (mpiprv != MPI_THREAD_MULTIPLE) {
+      out_params.async_write = false;
+      if (global_variable::my_rank == 0) {
+        std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+                  << "MPI_THREAD_MULTIPLE is not supported, so async_write is disabled "
+                  << "in output block '" << out_params.block_name << "'" << std::endl;
+      }
+    }
+  }
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+// ctor for restarts written to an in-memory image, used to continue a run on a different
+// number of ranks (see main.cpp).  Image always holds a full dump of all MeshBlocks,
+// with no parameters read from (or added to) the input.
+
+RestartOutput::RestartOutput(ParameterInput *pin, Mesh *pm,
+                             std::shared_ptr<IOWrapperImage> image) :
+  BaseTypeOutput(pin, pm, ImageOutputParameters()),
+  ranks_per_file(0),
+  keep_local(false),
+  image_(image),
+  full_every(0),
+  delta_tol(0.0),
+  base_field("rst-base-fc",1,1,1,1) {
+}
+
+//----------------------------------------------------------------------------------------
+// dtor: waits for any restart file still being written in background thread
+
+RestartOutput::~RestartOutput() {
+  if (write_thread.joinable()) {write_thread.join();}
+  if (drain_thread.joinable()) {drain_thread.join();}
+#if MPI_PARALLEL_ENABLED
+  if (ranks_per_file > 0) {MPI_Comm_free(&group_comm);}
+#endif
 }
 
 //----------------------------------------------------------------------------------------
@@ -45,6 +161,9 @@ RestartOutput::RestartOutput(ParameterInput *pin, Mesh *pm, OutputParameters op)
 // variables, including ghost zones.
 
 void RestartOutput::LoadOutputData(Mesh *pm) {
+  // wait for previous restart file to be written before overwriting outarrays
+  if (write_thread.joinable()) {write_thread.join();}
+
   // get spatial dimensions of arrays, including ghost zones
   auto &indcs = pm->pmb_pack->pmesh->mb_indcs;
   int nout1 = indcs.nx1 + 2*(indcs.ng);
@@ -73,7 +192,7 @@ void RestartOutput::LoadOutputData(Mesh *pm) {
   }
   // if the spacetime is evolved, we do not need to checkpoint/recover the ADM variables
   if (prad != nullptr) {
-    nrad = prad->prgeo->nangles;
+    nrad = prad->nrad;
   }
 
   // Note for restarts, outarrays are dimensioned (m,n,k,j,i)
@@ -98,8 +217,16 @@ void RestartOutput::LoadOutputData(Mesh *pm) {
   }
   if (prad != nullptr) {
     Kokkos::realloc(outarray_rad, nmb, nrad, nout3, nout2, nout1);
+#if RAD_MIXED_PRECISION_ENABLED
+    // intensities are stored as RadReal, but always written to restarts as Real
+    auto i0_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), Kokkos::subview(
+                prad->i0, std::make_pair(0,nmb), Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
+                Kokkos::ALL));
+    Kokkos::deep_copy(outarray_rad, i0_h);
+#else
     Kokkos::deep_copy(outarray_rad, Kokkos::subview(prad->i0, std::make_pair(0,nmb),
                       Kokkos::ALL, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL));
+#endif
   }
   if (pturb != nullptr) {
     Kokkos::realloc(outarray_force, nmb, nforce, nout3, nout2, nout1);
@@ -149,7 +276,7 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
     nmhd = pmhd->nmhd + pmhd->nscalars;
   }
   if (prad != nullptr) {
-    nrad = prad->prgeo->nangles;
+    nrad = prad->nrad;
   }
   if (pz4c != nullptr) {
     nz4c = pz4c->nz4c;
@@ -169,14 +296,35 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
   fname.append(".rst");
 
   // increment counters now so values for *next* dump are stored in restart file
-  out_params.file_number++;
-  if (out_params.last_time < 0.0) {
-    out_params.last_time = pm->time;
-  } else {
-    out_params.last_time += out_params.dt;
+  if (image_ == nullptr) {
+    out_params.file_number++;
+    if (out_params.last_time < 0.0) {
+      out_params.last_time = pm->time;
+    } else {
+      out_params.last_time += out_params.dt;
+    }
+    pin->SetInteger(out_params.block_name, "file_number", out_params.file_number);
+    pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
+  }
+
+  // dump is a delta file unless it is a multiple of full_every since first dump of run
+  bool delta_dump = (full_every > 1 && !base_fname.empty() && (ndumps % full_every) != 0);
+  ndumps++;
+  if (full_every > 1 || pin->DoesParameterExist("job", "restart_delta")) {
+    pin->SetInteger("job", "restart_delta", (delta_dump)? 1 : 0);
+  }
+
+  // store number of data files in input parameters, so they can be found on restart
+  int nfiles = 0;
+  if (ranks_per_file > 0) {
+    nfiles = (global_variable::nranks + ranks_per_file - 1)/ranks_per_file;
+  }
+  if (nfiles > 0 || pin->DoesParameterExist("job", "restart_nfiles")) {
+    pin->SetInteger("job", "restart_nfiles", nfiles);
+  }
+  if (!(local_dir.empty()) || pin->DoesParameterExist("job", "restart_local_dir")) {
+    pin->SetString("job", "restart_local_dir", local_dir);
   }
-  pin->SetInteger(out_params.block_name, "file_number", out_params.file_number);
-  pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
 
   // create string holding input parameters (copy of input file)
   std::stringstream ost;
@@ -185,33 +333,33 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
 
   //--- STEP 1.  Root process writes header data (input file, critical variables)
   // Input file data is read by ParameterInput on restart, and the remaining header
-  // variables are read in Mesh::BuildTreeFromRestart()
-
-  // open file and  write the header; this part is serial
-  IOWrapper resfile;
-  resfile.Open(fname.c_str(), IOWrapper::FileMode::write);
+  // variables are read in Mesh::BuildTreeFromRestart().  Header is copied into a buffer
+  // here, since Mesh data may change before it is written when async_write=true.
+  std::string header;
+  auto append = [&header](const void *ptr, std::size_t size) {
+    header.append(static_cast<const char*>(ptr), size);
+  };
   if (global_variable::my_rank == 0) {
     // output the input parameters (input file)
-    resfile.Write_any_type(sbuf.c_str(),sbuf.size(),"byte");
+    append(sbuf.c_str(), sbuf.size());
 
     // output Mesh information
-    resfile.Write_any_type(&(pm->nmb_total), (sizeof(int)), "byte");
-    resfile.Write_any_type(&(pm->root_level), (sizeof(int)), "byte");
-    resfile.Write_any_type(&(pm->mesh_size), (sizeof(RegionSize)), "byte");
-    resfile.Write_any_type(&(pm->mesh_indcs), (sizeof(RegionIndcs)), "byte");
-    resfile.Write_any_type(&(pm->mb_indcs), (sizeof(RegionIndcs)), "byte");
-    resfile.Write_any_type(&(pm->time), (sizeof(Real)), "byte");
-    resfile.Write_any_type(&(pm->dt), (sizeof(Real)), "byte");
-    resfile.Write_any_type(&(pm->ncycle), (sizeof(int)), "byte");
+    append(&(pm->nmb_total), sizeof(int));
+    append(&(pm->root_level), sizeof(int));
+    append(&(pm->mesh_size), sizeof(RegionSize));
+    append(&(pm->mesh_indcs), sizeof(RegionIndcs));
+    append(&(pm->mb_indcs), sizeof(RegionIndcs));
+    append(&(pm->time), sizeof(Real));
+    append(&(pm->dt), sizeof(Real));
+    append(&(pm->ncycle), sizeof(int));
   }
 
   //--- STEP 2.  Root process writes list of logical locations and cost of MeshBlocks
   // This data read in Mesh::BuildTreeFromRestart()
 
   if (global_variable::my_rank == 0) {
-    resfile.Write_any_type(&(pm->lloc_eachmb[0]),(pm->nmb_total)*sizeof(LogicalLocation),
-                           "byte");
-    resfile.Write_any_type(&(pm->cost_eachmb[0]), (pm->nmb_total)*sizeof(float),"byte");
+    append(&(pm->lloc_eachmb[0]), (pm->nmb_total)*sizeof(LogicalLocation));
+    append(&(pm->cost_eachmb[0]), (pm->nmb_total)*sizeof(float));
   }
 
   //--- STEP 3.  All ranks write data over all MeshBlocks (5D arrays) in parallel
@@ -241,12 +389,57 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
     data_size += nout1*nout2*nout3*nadm*sizeof(Real);   // adm u_adm
   }
   if (global_variable::my_rank == 0) {
-    resfile.Write_any_type(&(data_size), sizeof(IOWrapperSizeT), "byte");
+    append(&(data_size), sizeof(IOWrapperSizeT));
     if (pturb != nullptr) {
-      resfile.Write_any_type(&(pturb->rstate), sizeof(RNG_State), "byte");
+      append(&(pturb->rstate), sizeof(RNG_State));
+    }
+  }
+
+  // for delta files, find gid in full restart file of each MB that has not changed since
+  // it was written (or -1 if MB must be written to delta file).  Root process stores
+  // gids for all MBs, followed by offset of data and name of full restart file, in header
+  int nmb = pm->nmb_thisrank;
+  int mb0 = pm->gids_eachrank[global_variable::my_rank];
+  std::vector<int> base_gid;
+  if (delta_dump) {
+    std::vector<int> mygid(nmb, -1);
+    for (int m=0; m<nmb; ++m) {
+      LogicalLocation &loc = pm->lloc_eachmb[mb0+m];
+      auto it = base_mbs.find({loc.lx1, loc.lx2, loc.lx3, loc.level});
+      if (it != base_mbs.end() && !MeshBlockChanged(pm->pmb_pack, m, it->second.second)) {
+        mygid[m] = it->second.first;
+      }
+    }
+    base_gid.resize(pm->nmb_total);
+#if MPI_PARALLEL_ENABLED
+    MPI_Allgatherv(mygid.data(), nmb, MPI_INT, base_gid.data(), pm->nmb_eachrank,
+                   pm->gids_eachrank, MPI_INT, global_variable::athena_comm);
+#else
+    base_gid = mygid;
+#endif
+    if (global_variable::my_rank == 0) {
+      append(base_gid.data(), (pm->nmb_total)*sizeof(int));
+      append(&base_dataoffset, sizeof(IOWrapperSizeT));
+      int nchar = base_fname.size();
+      append(&nchar, sizeof(int));
+      append(base_fname.c_str(), nchar);
     }
   }
 
+  // with data split over files, index file also stores gid of first MB in each file
+  // (plus total number of MBs), and name of data files minus the ".pXXXXX.rst" suffix
+  std::string dname = fname.substr(0, fname.size()-4);
+  if (nfiles > 0 && global_variable::my_rank == 0) {
+    append(&nfiles, sizeof(int));
+    for (int f=0; f<nfiles; ++f) {
+      append(&(pm->gids_eachrank[f*ranks_per_file]), sizeof(int));
+    }
+    append(&(pm->nmb_total), sizeof(int));
+    int nchar = dname.size();
+    append(&nchar, sizeof(int));
+    append(dname.c_str(), nchar);
+  }
+
   // calculate size of data written in Steps 1-2 above
   IOWrapperSizeT step1size = sbuf.size()*sizeof(char) + 3*sizeof(int) + 2*sizeof(Real) +
                              sizeof(RegionSize) + 2*sizeof(RegionIndcs);
@@ -256,6 +449,288 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
   IOWrapperSizeT offset_myrank  = step1size + step2size + sizeof(IOWrapperSizeT) +
                                   data_size*(pm->gids_eachrank[global_variable::my_rank]);
   if (pturb != nullptr) offset_myrank += sizeof(RNG_State);
+
+  // delta files contain data of only changed MBs (in order of gid), so move their data
+  // to start of outarrays, and count number of changed MBs on each rank
+  if (delta_dump) {
+    IOWrapperSizeT hdrsize = header.size();
+#if MPI_PARALLEL_ENABLED
+    MPI_Bcast(&hdrsize, sizeof(IOWrapperSizeT), MPI_CHAR, 0,
+              global_variable::athena_comm);
+#endif
+    std::vector<int> nwrite(global_variable::nranks, 0);
+    for (int i=0; i<global_variable::nranks; ++i) {
+      for (int g=0; g<pm->nmb_eachrank[i]; ++g) {
+        if (base_gid[pm->gids_eachrank[i]+g] < 0) {nwrite[i]++;}
+      }
+    }
+    int nbefore = 0;
+    for (int i=0; i<global_variable::my_rank; ++i) {nbefore += nwrite[i];}
+    offset_myrank = hdrsize + data_size*nbefore;
+    int w = 0;
+    for (int m=0; m<nmb; ++m) {
+      if (base_gid[mb0+m] < 0) {
+        if (w != m) {MoveMeshBlockData(pm->pmb_pack, m, w);}
+        w++;
+      }
+    }
+    nmb = w;
+    noutmbs_min = *std::min_element(nwrite.begin(), nwrite.end());
+    noutmbs_max = *std::max_element(nwrite.begin(), nwrite.end());
+
+  // full files are saved as base of later delta files
+  } else if (full_every > 1) {
+    SaveBaseData(pm, fname, offset_myrank - data_size*mb0);
+  }
+
+  // with data split over files, root process writes header to index file, and data is
+  // written starting at beginning of data file for each group of ranks
+  IOWrapper resfile;
+  if (nfiles > 0) {
+    if (global_variable::my_rank == 0) {
+      IOWrapper idxfile;
+#if MPI_PARALLEL_ENABLED
+      idxfile.SetCommunicator(MPI_COMM_SELF);
+#endif
+      idxfile.Open(fname.c_str(), IOWrapper::FileMode::write);
+      idxfile.Write_any_type(header.data(), header.size(), "byte");
+      idxfile.Close();
+    }
+    header.clear();
+    int ifile = global_variable::my_rank/ranks_per_file;
+    offset_myrank = data_size*(pm->gids_eachrank[global_variable::my_rank] -
+                               pm->gids_eachrank[ifile*ranks_per_file]);
+    char part[8];
+    std::snprintf(part, sizeof(part), "p%05d", ifile);
+    fname = dname + "." + part + ".rst";
+#if MPI_PARALLEL_ENABLED
+    resfile.SetCommunicator(group_comm);
+#endif
+  }
+
+  // with two-tier restarts, data file is written to local directory, then copied to rst
+  std::string drain_fname;
+  if (!(local_dir.empty())) {
+    drain_fname = fname;
+    fname = local_dir + "/" + fname;
+  }
+
+  // open file (collective over all ranks, so always called from main thread), then write
+  // header and data, in a background thread if requested.  Previous copy to rst
+  // directory must be finished before local file is copied again.
+  // Copy is made once all ranks in group have closed the file.
+  if (image_ != nullptr) {
+    image_->data.reserve(header.size() + data_size*nmb);
+    resfile.Open(image_);
+  } else {
+    resfile.Open(fname.c_str(), IOWrapper::FileMode::write);
+  }
+  if (drain_thread.joinable()) {drain_thread.join();}
+  MeshBlockPack *pmbp = pm->pmb_pack;
+  if (out_params.async_write) {
+    write_thread = std::thread([=]() {
+      WriteRestartData(pmbp, resfile, header, data_size, offset_myrank, nmb);
+      if (!(drain_fname.empty())) {
+#if MPI_PARALLEL_ENABLED
+        MPI_Barrier(group_comm);
+#endif
+        DrainRestartFile(fname, drain_fname);
+      }
+    });
+  } else {
+    WriteRestartData(pmbp, resfile, header, data_size, offset_myrank, nmb);
+    if (!(drain_fname.empty())) {
+#if MPI_PARALLEL_ENABLED
+      MPI_Barrier(group_comm);
+#endif
+      drain_thread = std::thread(&RestartOutput::DrainRestartFile, this, fname,
+                                 drain_fname);
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void RestartOutput::DrainRestartFile()
+//  \brief Copies data file written to node-local storage to the rst directory, from the
+//  first rank in each group.  Copy is written to a temporary file and renamed when
+//  complete, so that a partial copy is never read on restart.  Uses no MPI calls, so it
+//  can run in a background thread while the Mesh is updated.
+
+void RestartOutput::DrainRestartFile(std::string local_fname, std::string fname) {
+  if (group_rank != 0) return;
+
+  std::string tmp_fname = fname + ".part";
+  std::FILE *src = std::fopen(local_fname.c_str(), "rb");
+  std::FILE *dst = (src != nullptr)? std::fopen(tmp_fname.c_str(), "wb") : nullptr;
+  bool ok = (dst != nullptr);
+  if (ok) {
+    std::vector<char> buf(1 << 24);
+    std::size_t n;
+    while ((n = std::fread(buf.data(), 1, buf.size(), src)) > 0) {
+      if (std::fwrite(buf.data(), 1, n, dst) != n) {
+        ok = false;
+        break;
+      }
+    }
+    ok = ok && !(std::ferror(src));
+  }
+  if (dst != nullptr) {ok = (std::fclose(dst) == 0) && ok;}
+  if (src != nullptr) {std::fclose(src);}
+  ok = ok && (std::rename(tmp_fname.c_str(), fname.c_str()) == 0);
+  if (!(ok)) {
+    std::remove(tmp_fname.c_str());
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Restart data file '" << local_fname << "' could not be copied to '"
+              << fname << "', so it is only stored on local storage" << std::endl;
+    return;
+  }
+  if (!(keep_local)) {std::remove(local_fname.c_str());}
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void RestartOutput::SaveBaseData()
+//  \brief Saves copy of data in outarrays, and location of each MB, when a full restart
+//  file is written, to be compared with data at later dumps written as delta files.
+
+void RestartOutput::SaveBaseData(Mesh *pm, std::string fname, IOWrapperSizeT dataoffset) {
+  base_fname = fname;
+  base_dataoffset = dataoffset;
+  base_mbs.clear();
+  int mb0 = pm->gids_eachrank[global_variable::my_rank];
+  for (int m=0; m<pm->nmb_thisrank; ++m) {
+    LogicalLocation &loc = pm->lloc_eachmb[mb0+m];
+    base_mbs[{loc.lx1, loc.lx2, loc.lx3, loc.level}] = std::make_pair(mb0+m, m);
+  }
+  auto save5 = [](HostArray5D<Real> &arr, HostArray5D<Real> &base) {
+    Kokkos::realloc(base, arr.extent(0), arr.extent(1), arr.extent(2), arr.extent(3),
+                    arr.extent(4));
+    Kokkos::deep_copy(base, arr);
+  };
+  auto save4 = [](HostArray4D<Real> &arr, HostArray4D<Real> &base) {
+    Kokkos::realloc(base, arr.extent(0), arr.extent(1), arr.extent(2), arr.extent(3));
+    Kokkos::deep_copy(base, arr);
+  };
+  save5(outarray_hyd, base_hyd);
+  save5(outarray_mhd, base_mhd);
+  save5(outarray_rad, base_rad);
+  save5(outarray_force, base_force);
+  save5(outarray_z4c, base_z4c);
+  save5(outarray_adm, base_adm);
+  save4(outfield.x1f, base_field.x1f);
+  save4(outfield.x2f, base_field.x2f);
+  save4(outfield.x3f, base_field.x3f);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool RestartOutput::MeshBlockChanged()
+//  \brief Returns true if maximum change in any variable on MB m in outarrays, relative
+//  to the maximum absolute value of that variable on MB bm in the base arrays, exceeds
+//  delta_tol.  With delta_tol=0, MB has changed if data is not bitwise identical.
+
+bool RestartOutput::MeshBlockChanged(MeshBlockPack *pmbp, int m, int bm) {
+  auto changed = [=](const auto &arr, const auto &base) {
+    std::size_t n = arr.size()/arr.extent(0);
+    const Real *pa = arr.data() + m*n;
+    const Real *pb = base.data() + bm*n;
+    Real dmax = 0.0, bmax = 0.0;
+    for (std::size_t i=0; i<n; ++i) {
+      dmax = std::max(dmax, static_cast<Real>(std::fabs(pa[i] - pb[i])));
+      bmax = std::max(bmax, static_cast<Real>(std::fabs(pb[i])));
+    }
+    // written so that NaNs are treated as changed
+    return !(dmax <= delta_tol*bmax);
+  };
+  bool chng = false;
+  if (pmbp->phydro != nullptr) {
+    chng = chng || changed(outarray_hyd, base_hyd);
+  }
+  if (pmbp->pmhd != nullptr) {
+    chng = chng || changed(outarray_mhd, base_mhd) ||
+           changed(outfield.x1f, base_field.x1f) ||
+           changed(outfield.x2f, base_field.x2f) ||
+           changed(outfield.x3f, base_field.x3f);
+  }
+  if (pmbp->prad != nullptr) {
+    chng = chng || changed(outarray_rad, base_rad);
+  }
+  if (pmbp->pturb != nullptr) {
+    chng = chng || changed(outarray_force, base_force);
+  }
+  if (pmbp->pz4c != nullptr) {
+    chng = chng || changed(outarray_z4c, base_z4c);
+  } else if (pmbp->padm != nullptr) {
+    chng = chng || changed(outarray_adm, base_adm);
+  }
+  return chng;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void RestartOutput::MoveMeshBlockData()
+//  \brief Copies data of MB m in outarrays to position w < m
+
+void RestartOutput::MoveMeshBlockData(MeshBlockPack *pmbp, int m, int w) {
+  auto move = [=](auto &arr) {
+    std::size_t n = arr.size()/arr.extent(0);
+    std::memcpy(arr.data() + w*n, arr.data() + m*n, n*sizeof(Real));
+  };
+  if (pmbp->phydro != nullptr) {move(outarray_hyd);}
+  if (pmbp->pmhd != nullptr) {
+    move(outarray_mhd);
+    move(outfield.x1f);
+    move(outfield.x2f);
+    move(outfield.x3f);
+  }
+  if (pmbp->prad != nullptr) {move(outarray_rad);}
+  if (pmbp->pturb != nullptr) {move(outarray_force);}
+  if (pmbp->pz4c != nullptr) {
+    move(outarray_z4c);
+  } else if (pmbp->padm != nullptr) {
+    move(outarray_adm);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void RestartOutput::WriteRestartData()
+//  \brief Writes header (from root process) and data over all MeshBlocks stored in the
+//  outarrays to an open restart file, then closes the file.  All arguments are passed by
+//  value so this function can be run in a background thread while Mesh is updated.
+
+void RestartOutput::WriteRestartData(MeshBlockPack *pmbp, IOWrapper resfile,
+                                     std::string header, IOWrapperSizeT data_size,
+                                     IOWrapperSizeT offset_myrank, int nmb_thisrank) {
+  // get spatial dimensions of arrays, including ghost zones
+  auto &indcs = pmbp->pmesh->mb_indcs;
+  int nout1 = indcs.nx1 + 2*(indcs.ng);
+  int nout2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
+  int nout3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
+  hydro::Hydro* phydro = pmbp->phydro;
+  mhd::MHD* pmhd = pmbp->pmhd;
+  radiation::Radiation* prad = pmbp->prad;
+  TurbulenceDriver* pturb=pmbp->pturb;
+  z4c::Z4c* pz4c = pmbp->pz4c;
+  adm::ADM* padm = pmbp->padm;
+  int nhydro=0, nmhd=0, nrad=0, nforce=3, nz4c=0, nadm=0;
+  if (phydro != nullptr) {
+    nhydro = phydro->nhydro + phydro->nscalars;
+  }
+  if (pmhd != nullptr) {
+    nmhd = pmhd->nmhd + pmhd->nscalars;
+  }
+  if (prad != nullptr) {
+    nrad = prad->nrad;
+  }
+  if (pz4c != nullptr) {
+    nz4c = pz4c->nz4c;
+  } else if (padm != nullptr) {
+    nadm = padm->nadm;
+  }
+
+  // root process writes header data from Steps 1-2
+  if (global_variable::my_rank == 0 && header.size() > 0) {
+    resfile.Write_any_type(header.data(), header.size(), "byte");
+  }
   IOWrapperSizeT myoffset = offset_myrank;
 
   // write cell-centered variables, one MeshBlock at a time (but parallelized over all
@@ -278,7 +753,7 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
         myoffset += data_size;
 
       // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
+      } else if (m < nmb_thisrank) {
         // get ptr to MeshBlock data
         auto mbptr = Kokkos::subview(outarray_hyd, m, Kokkos::ALL, Kokkos::ALL,
                                      Kokkos::ALL, Kokkos::ALL);
@@ -312,7 +787,7 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
         myoffset += data_size;
 
       // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
+      } else if (m < nmb_thisrank) {
         // get ptr to MeshBlock data
         auto mbptr = Kokkos::subview(outarray_mhd, m, Kokkos::ALL, Kokkos::ALL,
                                      Kokkos::ALL, Kokkos::ALL);
@@ -368,7 +843,7 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
         myoffset += data_size-(x1fptr.size()+x2fptr.size()+x3fptr.size())*sizeof(Real);
 
       // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
+      } else if (m < nmb_thisrank) {
         // get ptr to x1-face field
         auto x1fptr = Kokkos::subview(outfield.x1f,m,Kokkos::ALL,Kokkos::ALL,Kokkos::ALL);
         int fldcnt = x1fptr.size();
@@ -428,7 +903,7 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
         myoffset += data_size;
 
       // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
+      } else if (m < nmb_thisrank) {
         // get ptr to MeshBlock data
         auto mbptr = Kokkos::subview(outarray_rad, m, Kokkos::ALL, Kokkos::ALL,
                                      Kokkos::ALL, Kokkos::ALL);
@@ -463,7 +938,7 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
         myoffset += data_size;
 
       // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
+      } else if (m < nmb_thisrank) {
         // get ptr to MeshBlock data
         auto mbptr = Kokkos::subview(outarray_force, m, Kokkos::ALL, Kokkos::ALL,
                                      Kokkos::ALL, Kokkos::ALL);
@@ -498,7 +973,7 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
         myoffset += data_size;
 
       // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
+      } else if (m < nmb_thisrank) {
         // get ptr to MeshBlock data
         auto mbptr = Kokkos::subview(outarray_z4c, m, Kokkos::ALL, Kokkos::ALL,
                                      Kokkos::ALL, Kokkos::ALL);
@@ -531,7 +1006,7 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
         myoffset += data_size;
 
       // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
+      } else if (m < nmb_thisrank) {
         // get ptr to MeshBlock data
         auto mbptr = Kokkos::subview(outarray_adm, m, Kokkos::ALL, Kokkos::ALL,
                                      Kokkos::ALL, Kokkos::ALL);
@@ -0,0 +1,243 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file spectrum.cpp
+//! \brief writes shell-averaged power spectra of output variables computed on the
+//! device (file_type = spec), so that spectra can be computed in-situ rather than from
+//! full snapshots.
+//!
+//! The Fourier transform f_k = (1/V) sum f(x) exp(-i k.x) dV over the whole Mesh is
+//! computed for all integer wavenumbers n = (n1,n2,n3) with |n_d| <= <output>/nkmax,
+//! where k_d = 2 pi n_d/L_d.  The transform is a direct sum rather than an FFT, done
+//! one direction at a time using tables of sines/cosines on each MeshBlock (as in the
+//! TurbulenceDriver), so that it works on any Mesh (including SMR) without an external
+//! FFT library.  Cost scales as (number of cells)*nkmax, so it is intended for the low
+//! wavenumbers where driving and most of the energy reside.  Only the transform at
+//! these wavenumbers is copied to host and summed over ranks.  The root process then
+//! sums |f_k|^2 over shells of integer radius |n| (excluding n=0), and writes the
+//! spectrum of each variable as an ASCII table.  Summing the spectra of the velocity
+//! components gives (twice) the specific kinetic energy spectrum.
+
+#include <sys/stat.h>  // mkdir
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "coordinates/cell_locations.hpp"
+#include "outputs.hpp"
+
+//----------------------------------------------------------------------------------------
+// Constructor: also calls BaseTypeOutput base class constructor
+
+SpectrumOutput::SpectrumOutput(ParameterInput *pin, Mesh *pm, OutputParameters op) :
+  BaseTypeOutput(pin, pm, op) {
+  // create directories for outputs. Comments in binary.cpp constructor explain why
+  mkdir(op.file_type.c_str(),0775);
+
+  nkmax = pin->GetOrAddInteger(op.block_name, "nkmax", 16);
+  if (nkmax < 1) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Spectrum in block '" << op.block_name
+              << "' requires nkmax >= 1" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  // real fields satisfy f_{-k} = conj(f_k), so only n1 >= 0 is needed
+  nk1 = nkmax + 1;
+  nk2 = (pm->multi_d)? 2*nkmax + 1 : 1;
+  nk3 = (pm->three_d)? 2*nkmax + 1 : 1;
+  spec.resize(nkmax + 1);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void SpectrumOutput::LoadOutputData()
+//  \brief Computes Fourier transform of each output variable at wavenumbers up to nkmax
+//  on the device, sums it over all ranks on the root process, and bins the power.
+
+void SpectrumOutput::LoadOutputData(Mesh *pm) {
+  if (out_params.contains_derived) {
+    ComputeDerivedVariables(pm);
+  }
+  int nout_vars = outvars.size();
+
+  auto &indcs = pm->mb_indcs;
+  int is = indcs.is, nx1 = indcs.nx1;
+  int js = indcs.js, nx2 = indcs.nx2;
+  int ks = indcs.ks, nx3 = indcs.nx3;
+  int nmb = pm->pmb_pack->nmb_thispack;
+  auto &size = pm->pmb_pack->pmb->mb_size;
+  auto &msize = pm->mesh_size;
+  Real lx1 = msize.x1max - msize.x1min, mx1min = msize.x1min;
+  Real lx2 = msize.x2max - msize.x2min, mx2min = msize.x2min;
+  Real lx3 = msize.x3max - msize.x3min, mx3min = msize.x3min;
+  int n1 = nk1, n2 = nk2, n3 = nk3;
+  int off2 = (n2 - 1)/2, off3 = (n3 - 1)/2;
+
+  // tables of cos/sin(k.x)*dx in each direction for each MeshBlock
+  DvceArray3D<Real> c1("spec_c1",nmb,n1,nx1), s1("spec_s1",nmb,n1,nx1);
+  DvceArray3D<Real> c2("spec_c2",nmb,n2,nx2), s2("spec_s2",nmb,n2,nx2);
+  DvceArray3D<Real> c3("spec_c3",nmb,n3,nx3), s3("spec_s3",nmb,n3,nx3);
+  par_for("spec_tab1",DevExeSpace(),0,(nmb-1),0,(n1-1),0,(nx1-1),
+  KOKKOS_LAMBDA(int m, int n, int i) {
+    Real x = CellCenterX(i, nx1, size.d_view(m).x1min, size.d_view(m).x1max) - mx1min;
+    Real kx = 2.0*M_PI*static_cast<Real>(n)/lx1;
+    c1(m,n,i) = cos(kx*x)*size.d_view(m).dx1;
+    s1(m,n,i) = sin(kx*x)*size.d_view(m).dx1;
+  });
+  par_for("spec_tab2",DevExeSpace(),0,(nmb-1),0,(n2-1),0,(nx2-1),
+  KOKKOS_LAMBDA(int m, int n, int j) {
+    Real x = CellCenterX(j, nx2, size.d_view(m).x2min, size.d_view(m).x2max) - mx2min;
+    Real kx = 2.0*M_PI*static_cast<Real>(n - off2)/lx2;
+    c2(m,n,j) = cos(kx*x)*size.d_view(m).dx2;
+    s2(m,n,j) = sin(kx*x)*size.d_view(m).dx2;
+  });
+  par_for("spec_tab3",DevExeSpace(),0,(nmb-1),0,(n3-1),0,(nx3-1),
+  KOKKOS_LAMBDA(int m, int n, int k) {
+    Real x = CellCenterX(k, nx3, size.d_view(m).x3min, size.d_view(m).x3max) - mx3min;
+    Real kx = 2.0*M_PI*static_cast<Real>(n - off3)/lx3;
+    c3(m,n,k) = cos(kx*x)*size.d_view(m).dx3;
+    s3(m,n,k) = sin(kx*x)*size.d_view(m).dx3;
+  });
+
+  // partial transforms (real and imaginary parts) after sums over x1, then x2
+  DvceArray5D<Real> ft1("spec_ft1",nmb,2,nx3,nx2,n1);
+  DvceArray5D<Real> ft2("spec_ft2",nmb,2,nx3,n2,n1);
+  DvceArray4D<Real> ft3("spec_ft3",nout_vars,2,n3*n2,n1);
+  for (int v=0; v<nout_vars; ++v) {
+    auto var = *(outvars[v].data_ptr);
+    int indx = outvars[v].data_index;
+    par_for("spec_ft1",DevExeSpace(),0,(nmb-1),0,(nx3-1),0,(nx2-1),0,(n1-1),
+    KOKKOS_LAMBDA(int m, int k, int j, int n) {
+      Real re = 0.0, im = 0.0;
+      for (int i=0; i<nx1; ++i) {
+        Real f = var(m,indx,k+ks,j+js,i+is);
+        re += f*c1(m,n,i);
+        im -= f*s1(m,n,i);
+      }
+      ft1(m,0,k,j,n) = re;
+      ft1(m,1,k,j,n) = im;
+    });
+    par_for("spec_ft2",DevExeSpace(),0,(nmb-1),0,(nx3-1),0,(n2-1),0,(n1-1),
+    KOKKOS_LAMBDA(int m, int k, int n, int l) {
+      Real re = 0.0, im = 0.0;
+      for (int j=0; j<nx2; ++j) {
+        re += ft1(m,0,k,j,l)*c2(m,n,j) + ft1(m,1,k,j,l)*s2(m,n,j);
+        im += ft1(m,1,k,j,l)*c2(m,n,j) - ft1(m,0,k,j,l)*s2(m,n,j);
+      }
+      ft2(m,0,k,n,l) = re;
+      ft2(m,1,k,n,l) = im;
+    });
+    // sum over x3 and over all MeshBlocks on this rank
+    par_for("spec_ft3",DevExeSpace(),0,(n3-1),0,(n2-1),0,(n1-1),
+    KOKKOS_LAMBDA(int p, int n, int l) {
+      Real re = 0.0, im = 0.0;
+      for (int m=0; m<nmb; ++m) {
+        for (int k=0; k<nx3; ++k) {
+          re += ft2(m,0,k,n,l)*c3(m,p,k) + ft2(m,1,k,n,l)*s3(m,p,k);
+          im += ft2(m,1,k,n,l)*c3(m,p,k) - ft2(m,0,k,n,l)*s3(m,p,k);
+        }
+      }
+      ft3(v,0,p*n2 + n,l) = re;
+      ft3(v,1,p*n2 + n,l) = im;
+    });
+  }
+
+  // copy transform to host and sum over ranks
+  auto ft = Kokkos::create_mirror_view_and_copy(HostMemSpace(), ft3);
+#if MPI_PARALLEL_ENABLED
+  if (global_variable::my_rank == 0) {
+    MPI_Reduce(MPI_IN_PLACE, ft.data(), ft.size(), MPI_ATHENA_REAL, MPI_SUM, 0,
+               global_variable::athena_comm);
+  } else {
+    MPI_Reduce(ft.data(), ft.data(), ft.size(), MPI_ATHENA_REAL, MPI_SUM, 0,
+               global_variable::athena_comm);
+  }
+#endif
+  if (global_variable::my_rank != 0) return;
+
+  // sum power over shells in wavenumber space; modes with n1 > 0 also represent -n
+  Real vol = lx1*lx2*lx3;
+  for (int s=0; s<=nkmax; ++s) {spec[s].assign(nout_vars, 0.0);}
+  for (int p=0; p<n3; ++p) {
+    for (int n=0; n<n2; ++n) {
+      for (int l=0; l<n1; ++l) {
+        Real kmag = std::sqrt(static_cast<Real>(SQR(l) + SQR(n - off2) + SQR(p - off3)));
+        int s = static_cast<int>(kmag + 0.5);
+        if (s == 0 || s > nkmax) continue;
+        // with n1 = 0, modes n and -n are both in loop
+        Real wght = (l > 0)? 2.0 : 1.0;
+        for (int v=0; v<nout_vars; ++v) {
+          Real re = ft(v,0,p*n2 + n,l)/vol;
+          Real im = ft(v,1,p*n2 + n,l)/vol;
+          spec[s][v] += wght*(SQR(re) + SQR(im));
+        }
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void SpectrumOutput::WriteOutputFile()
+//  \brief Writes spectrum of each variable from root process.
+
+void SpectrumOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
+  if (global_variable::my_rank == 0) {
+    // create filename: "spec/file_basename" + "." + "file_id" + "." + XXXXX + ".spec",
+    // where XXXXX = 5-digit file_number
+    std::string fname;
+    char number[6];
+    std::snprintf(number, sizeof(number), "%05d", out_params.file_number);
+    fname.assign(out_params.file_type);
+    fname.append("/");
+    fname.append(out_params.file_basename);
+    fname.append(".");
+    fname.append(out_params.file_id);
+    fname.append(".");
+    fname.append(number);
+    fname.append(".");
+    fname.append(out_params.file_type);
+
+    FILE *pfile;
+    if ((pfile = std::fopen(fname.c_str(),"w")) == nullptr) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Output file '" << fname << "' could not be opened"
+                << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    std::fprintf(pfile, "# Athena++ spectrum output at time=%e cycle=%d nkmax=%d\n",
+                 pm->time, pm->ncycle, nkmax);
+    std::fprintf(pfile, "# [1]=k");
+    for (int v=0; v<static_cast<int>(outvars.size()); ++v) {
+      std::fprintf(pfile, " [%d]=%s", v+2, outvars[v].label.c_str());
+    }
+    std::fprintf(pfile, "\n");
+    for (int s=1; s<=nkmax; ++s) {
+      std::fprintf(pfile, "%4d", s);
+      for (auto &p : spec[s]) {
+        std::fprintf(pfile, out_params.data_format.c_str(), p);
+      }
+      std::fprintf(pfile, "\n");
+    }
+    std::fclose(pfile);
+  }
+
+  // increment counters
+  out_params.file_number++;
+  if (out_params.last_time < 0.0) {
+    out_params.last_time = pm->time;
+  } else {
+    out_params.last_time += out_params.dt;
+  }
+  pin->SetInteger(out_params.block_name, "file_number", out_params.file_number);
+  pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
+  return;
+}
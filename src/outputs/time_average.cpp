@@ -0,0 +1,243 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file time_average.cpp
+//! \brief writes time-averages of output variables (file_type = tavg), accumulated in
+//! running sums on the device every <output>/sample_dcycle cycles (default 1), so that
+//! time-averaged quantities do not require dumping full snapshots at high cadence.
+//!
+//! Besides the variables selected by <output>/variable, averages of products of them can
+//! be requested with <output>/products, a comma-separated list of products of up to four
+//! variable labels, e.g. for the Reynolds and Maxwell stresses with variable = mhd_w_bcc
+//!   products = dens*velx*vely, bcc1*bcc2
+//! Sums are stored on cells coarsened by <output>/coarsen_factor (default 1), averaging
+//! each variable and product over the fine cells before coarsening.
+//!
+//! Files are written with the cadence set by dt or dcycle in coarsened binary format
+//! (see coarsened_binary.cpp), and each contains the average over all samples since the
+//! previous file.  The sums are reset when the Mesh is refined or load balanced, and at
+//! restarts, so the averages then only cover the samples taken since.
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "outputs.hpp"
+
+//----------------------------------------------------------------------------------------
+// Constructor: also calls CoarsenedBinaryOutput base class constructor, and appends the
+// products to the list of output variables
+
+TimeAverageOutput::TimeAverageOutput(ParameterInput *pin, Mesh *pm, OutputParameters op) :
+  CoarsenedBinaryOutput(pin, pm, op),
+  nsample(0),
+  sum_version(-1),
+  prod_index("tavg_prod",1,4),
+  stage("tavg_stage",1,1,1,1,1),
+  sum("tavg_sum",1,1,1,1,1) {
+  if (op.slice1 || op.slice2 || op.slice3 || op.gid >= 0 || op.include_gzs) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Time-average output in block '" << op.block_name
+              << "' cannot be sliced, restricted to one MeshBlock, or include ghost "
+              << "zones" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  auto &indcs = pm->mb_indcs;
+  int cf = op.coarsen_factor;
+  if (cf < 1 || indcs.nx1 % cf != 0 || indcs.nx2 % cf != 0 || indcs.nx3 % cf != 0) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "MeshBlock size is not divisible by coarsen_factor="
+              << cf << " in block '" << op.block_name << "'" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  sample_dcycle = pin->GetOrAddInteger(op.block_name, "sample_dcycle", 1);
+
+  // parse products of labels of output variables
+  nvar_in = static_cast<int>(outvars.size());
+  std::vector<std::vector<int>> prods;
+  std::vector<std::string> labels;
+  std::stringstream ss(pin->GetOrAddString(op.block_name, "products", ""));
+  std::string term;
+  while (std::getline(ss, term, ',')) {
+    term.erase(0, term.find_first_not_of(" \t"));
+    term.erase(term.find_last_not_of(" \t") + 1);
+    if (term.empty()) continue;
+    std::vector<int> factors;
+    std::stringstream st(term);
+    std::string f;
+    while (std::getline(st, f, '*')) {
+      f.erase(0, f.find_first_not_of(" \t"));
+      f.erase(f.find_last_not_of(" \t") + 1);
+      int index = -1;
+      for (int n=0; n<nvar_in; ++n) {
+        if (outvars[n].label == f) {index = n;}
+      }
+      if (index < 0 || factors.size() == 4) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "Product '" << term << "' in block '" << op.block_name
+                  << "' must have at most 4 factors, each the label of a variable in "
+                  << "'" << op.variable << "'" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+      factors.push_back(index);
+    }
+    prods.push_back(factors);
+    labels.push_back(term);
+  }
+  int nprod = static_cast<int>(prods.size());
+  Kokkos::realloc(prod_index, std::max(nprod,1), 4);
+  for (int p=0; p<nprod; ++p) {
+    for (int f=0; f<4; ++f) {
+      prod_index.h_view(p,f) = (f < static_cast<int>(prods[p].size()))? prods[p][f] : -1;
+    }
+    // products are written after the variables with the term as label, and point to
+    // their first factor (so ReadsArray() is unchanged)
+    outvars.emplace_back(labels[p], outvars[prods[p][0]].data_index,
+                         outvars[prods[p][0]].data_ptr);
+  }
+  prod_index.template modify<HostMemSpace>();
+  prod_index.template sync<DevExeSpace>();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void TimeAverageOutput::Accumulate()
+//  \brief Adds a sample to the running sums every sample_dcycle cycles
+
+void TimeAverageOutput::Accumulate(Mesh *pm) {
+  if (SampleDue(pm->ncycle)) {AddSample(pm);}
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool TimeAverageOutput::SampleDue()
+//  \brief true if a sample is added to the running sums at the end of cycle ncycle.  Used
+//  by the Driver so that diagnostics read by the samples are computed on these cycles.
+
+bool TimeAverageOutput::SampleDue(int ncycle) const {
+  return (sample_dcycle > 0 && ncycle % sample_dcycle == 0);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void TimeAverageOutput::AddSample()
+//  \brief Adds the current values of all variables and products, averaged over the fine
+//  cells of each coarsened cell, to the running sums.  Sums are reset if the Mesh has
+//  changed since the last sample.
+
+void TimeAverageOutput::AddSample(Mesh *pm) {
+  auto &indcs = pm->mb_indcs;
+  int is = indcs.is, nx1 = indcs.nx1;
+  int js = indcs.js, nx2 = indcs.nx2;
+  int ks = indcs.ks, nx3 = indcs.nx3;
+  int nmb = pm->pmb_pack->nmb_thispack;
+  int cf = out_params.coarsen_factor;
+  int nc1 = nx1/cf, nc2 = nx2/cf, nc3 = nx3/cf;
+  int nvar = nvar_in;
+  int nout = static_cast<int>(outvars.size());
+  if (sum_version != pm->mesh_version || sum.extent_int(1) != nmb) {
+    Kokkos::realloc(stage, nmb, nvar, nx3, nx2, nx1);
+    Kokkos::realloc(sum, nout, nmb, nc3, nc2, nc1);
+    Kokkos::deep_copy(sum, 0.0);
+    nsample = 0;
+    sum_version = pm->mesh_version;
+  }
+
+  if (out_params.contains_derived) {
+    ComputeDerivedVariables(pm);
+  }
+  // gather variables from their device arrays
+  auto stg = stage;
+  for (int n=0; n<nvar; ++n) {
+    auto var = *(outvars[n].data_ptr);
+    int indx = outvars[n].data_index;
+    par_for("tavg_gather",DevExeSpace(),0,(nmb-1),0,(nx3-1),0,(nx2-1),0,(nx1-1),
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      stg(m,n,k,j,i) = var(m,indx,ks+k,js+j,is+i);
+    });
+  }
+
+  // add average over fine cells of each variable and product to sums
+  auto sm = sum;
+  auto pidx = prod_index.d_view;
+  Real norm = 1.0/static_cast<Real>(cf*cf*cf);
+  par_for("tavg_sum",DevExeSpace(),0,(nmb-1),0,(nc3-1),0,(nc2-1),0,(nc1-1),
+  KOKKOS_LAMBDA(int m, int kc, int jc, int ic) {
+    for (int n=0; n<nout; ++n) {
+      Real s = 0.0;
+      for (int kk=0; kk<cf; ++kk) {
+        int k = kc*cf + kk;
+        for (int jj=0; jj<cf; ++jj) {
+          int j = jc*cf + jj;
+          for (int ii=0; ii<cf; ++ii) {
+            int i = ic*cf + ii;
+            if (n < nvar) {
+              s += stg(m,n,k,j,i);
+            } else {
+              Real q = 1.0;
+              for (int f=0; f<4; ++f) {
+                if (pidx(n-nvar,f) >= 0) {q *= stg(m,pidx(n-nvar,f),k,j,i);}
+              }
+              s += q;
+            }
+          }
+        }
+      }
+      sm(n,m,kc,jc,ic) += s*norm;
+    }
+  });
+  nsample++;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void TimeAverageOutput::LoadOutputData()
+//  \brief Copies averages over all samples since the last file to the host.  If there
+//  are no samples (e.g. for the output at the start of the run), one is taken first.
+
+void TimeAverageOutput::LoadOutputData(Mesh *pm) {
+  if (nsample == 0 || sum_version != pm->mesh_version) {AddSample(pm);}
+
+  outmbs.clear();
+  auto &indcs = pm->mb_indcs;
+  auto &size  = pm->pmb_pack->pmb->mb_size;
+  int nmb = pm->pmb_pack->nmb_thispack;
+  for (int m=0; m<nmb; ++m) {
+    int id = pm->pmb_pack->pmb->mb_gid.h_view(m);
+    outmbs.emplace_back(id, indcs.is, indcs.ie, indcs.js, indcs.je, indcs.ks, indcs.ke,
+                        size.h_view(m).x1min, size.h_view(m).x1max,
+                        size.h_view(m).x2min, size.h_view(m).x2max,
+                        size.h_view(m).x3min, size.h_view(m).x3max);
+  }
+
+  DvceArray5D<Real> avg("tavg_avg", sum.extent(0), sum.extent(1), sum.extent(2),
+                        sum.extent(3), sum.extent(4));
+  auto sm = sum;
+  Real rsample = 1.0/static_cast<Real>(nsample);
+  int nout = sum.extent_int(0);
+  int nc3 = sum.extent_int(2), nc2 = sum.extent_int(3), nc1 = sum.extent_int(4);
+  par_for("tavg_avg",DevExeSpace(),0,(nout-1),0,(nmb-1),0,(nc3-1),0,(nc2-1),0,(nc1-1),
+  KOKKOS_LAMBDA(int n, int m, int k, int j, int i) {
+    avg(n,m,k,j,i) = sm(n,m,k,j,i)*rsample;
+  });
+  Kokkos::realloc(outarray, nout, nmb, nc3, nc2, nc1);
+  Kokkos::deep_copy(outarray, avg);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void TimeAverageOutput::WriteOutputFile()
+//  \brief Writes averages in coarsened binary format, then resets the running sums
+
+void TimeAverageOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
+  CoarsenedBinaryOutput::WriteOutputFile(pm, pin);
+  Kokkos::deep_copy(sum, 0.0);
+  nsample = 0;
+  return;
+}
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <cstdio>      // fwrite(), fclose(), fopen(), fnprintf(), snprintf()
 #include <cstdlib>
+#include <cstring>     // memcpy
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -28,65 +29,110 @@
 
 TrackedParticleOutput::TrackedParticleOutput(ParameterInput *pin, Mesh *pm,
                                              OutputParameters op) :
-  BaseTypeOutput(pin, pm, op) {
+  BaseTypeOutput(pin, pm, op),
+  nbuf(0) {
   // create new directory for this output. Comments in binary.cpp constructor explain why
   mkdir("trk",0775);
-  // allocate arrays
-  npout_eachrank.resize(global_variable::nranks);
   ntrack = pin->GetInteger(op.block_name,"nparticles");
-  // TODO(@user) improve guess below?
-  ntrack_thisrank = ntrack;
+  tag_start = pin->GetOrAddInteger(op.block_name,"tag_start",0);
+  nbuffer = pin->GetOrAddInteger(op.block_name,"buffer_outputs",1);
+  if (nbuffer < 1) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "buffer_outputs must be >= 1 in <" << op.block_name
+              << "> block" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  // Each output in buffer has room for all tracked particles, so that particles can be
+  // packed on the device without first counting them on the host
+  Kokkos::realloc(dbuf, 6*nbuffer*ntrack);
+  Kokkos::realloc(dtag, nbuffer*ntrack);
+  Kokkos::realloc(dcount, nbuffer);
 }
 
 //----------------------------------------------------------------------------------------
 // TrackedParticleOutput::LoadOutputData()
-// Copies data for tracked particles on this rank to host outpart array
+// Selects tracked particles on this rank and packs their data into next slot of device
+// buffer.  No data is copied to the host.
 
 void TrackedParticleOutput::LoadOutputData(Mesh *pm) {
-  particles::Particles *pp = pm->pmb_pack->ppart;
-
-  // Load data for tracked particles on this rank into new device array
-  DualArray1D<TrackedParticleData> tracked_prtcl("d_trked",ntrack_thisrank);
-  int npart = pm->nprtcl_thisrank;
+  int npart = pm->pmb_pack->ppart->nprtcl_thispack;
   auto &pr = pm->pmb_pack->ppart->prtcl_rdata;
   auto &pi = pm->pmb_pack->ppart->prtcl_idata;
-  int counter=0;
-  int *pcounter = &counter;
-  par_for("part_update",DevExeSpace(),0,(npart-1), KOKKOS_LAMBDA(const int p) {
-    if (pi(PTAG,p) < ntrack) {
-      int index = Kokkos::atomic_fetch_add(pcounter,1);
-      tracked_prtcl.d_view(index).tag = pi(PTAG,p);
-      tracked_prtcl.d_view(index).x   = pr(IPX,p);
-      tracked_prtcl.d_view(index).y   = pr(IPY,p);
-      tracked_prtcl.d_view(index).z   = pr(IPZ,p);
-      tracked_prtcl.d_view(index).vx  = pr(IPVX,p);
-      tracked_prtcl.d_view(index).vy  = pr(IPVY,p);
-      tracked_prtcl.d_view(index).vz  = pr(IPVZ,p);
+  bool &three_d = pm->three_d;
+  int tag0 = tag_start, ntrk = ntrack;
+  int n = nbuf;
+  auto &dbuf_ = dbuf;
+  auto &dtag_ = dtag;
+  auto &dcount_ = dcount;
+  Kokkos::deep_copy(Kokkos::subview(dcount, n), 0);
+  par_for("trk_pack",DevExeSpace(),0,(npart-1), KOKKOS_LAMBDA(const int p) {
+    int tag = pi(PTAG,p);
+    if (tag >= tag0 && tag < tag0 + ntrk) {
+      int q = Kokkos::atomic_fetch_add(&dcount_(n),1);
+      // skip particles beyond capacity of buffer (only possible if tags not unique)
+      if (q >= ntrk) return;
+      q += n*ntrk;
+      dtag_(q) = tag;
+      dbuf_(6*q    ) = static_cast<float>(pr(IPX,p));
+      dbuf_(6*q + 1) = static_cast<float>(pr(IPY,p));
+      dbuf_(6*q + 3) = static_cast<float>(pr(IPVX,p));
+      dbuf_(6*q + 4) = static_cast<float>(pr(IPVY,p));
+      if (three_d) {
+        dbuf_(6*q + 2) = static_cast<float>(pr(IPZ,p));
+        dbuf_(6*q + 5) = static_cast<float>(pr(IPVZ,p));
+      } else {
+        dbuf_(6*q + 2) = 0.0;
+        dbuf_(6*q + 5) = 0.0;
+      }
     }
   });
-  npout = counter;
-  // share number of tracked particles to be output across all ranks
-  npout_eachrank[global_variable::my_rank] = npout;
-#if MPI_PARALLEL_ENABLED
-  MPI_Allgather(&npout, 1, MPI_INT, npout_eachrank.data(), 1, MPI_INT, MPI_COMM_WORLD);
-#endif
-  tracked_prtcl.resize(npout);
-  // sync tracked particle device array with host
-  tracked_prtcl.template modify<DevExeSpace>();
-  tracked_prtcl.template sync<HostMemSpace>();
-
-  // copy host view into host outpart array
-  Kokkos::realloc(outpart, npout);
-  Kokkos::deep_copy(outpart, tracked_prtcl.h_view);
+  buf_time.push_back(pm->time);
+  buf_cycle.push_back(pm->ncycle);
+  nbuf++;
 }
 
 //----------------------------------------------------------------------------------------
 //! \fn void TrackedParticleOutput:::WriteOutputFile(Mesh *pm)
-//! \brief Cycles over all tracked particles on this rank and writes ouput data
-//! With MPI, all particles are written to the same file.
+//! \brief Writes buffered data to file once nbuffer outputs have been collected.
 
 void TrackedParticleOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
-  int big_end = IsBigEndian(); // =1 on big endian machine
+  if (nbuf == nbuffer) {Flush(pm);}
+
+  // increment counters
+  if (out_params.last_time < 0.0) {
+    out_params.last_time = pm->time;
+  } else {
+    out_params.last_time += out_params.dt;
+  }
+  pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void TrackedParticleOutput:::Flush(Mesh *pm)
+//! \brief Copies all buffered outputs to host and appends them to the file.  With MPI,
+//! all particles are written to the same file.  Each output consists of an ASCII header
+//! followed by one record for each tracked particle, ordered by rank, containing its tag
+//! (int) and (x,y,z,vx,vy,vz) (float).  Data from each output in the buffer is written
+//! by all ranks in one collective call.
+
+void TrackedParticleOutput::Flush(Mesh *pm) {
+  if (nbuf == 0) return;
+  int nranks = global_variable::nranks;
+  int myrank = global_variable::my_rank;
+
+  // copy buffer to host, and share number of particles in each output across all ranks
+  auto count_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), dcount);
+  auto tag_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), dtag);
+  auto buf_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), dbuf);
+  std::vector<int> count_all(nranks*nbuf);
+  for (int n=0; n<nbuf; ++n) {
+    count_all[myrank*nbuf + n] = std::min(count_h(n), ntrack);
+  }
+#if MPI_PARALLEL_ENABLED
+  MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, count_all.data(), nbuf, MPI_INT,
+                global_variable::athena_comm);
+#endif
 
   // create filename: "trk/file_basename".trk
   std::string fname;
@@ -94,84 +140,62 @@ void TrackedParticleOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
   fname.append(out_params.file_basename);
   fname.append(".trk");
 
-  // Root process opens/creates file and appends string
-  if (global_variable::my_rank == 0) {
-    std::stringstream msg;
-    msg << std::endl << "# AthenaK tracked particle data at time= " << pm->time
-        << "  nranks= " << global_variable::nranks
-        << "  cycle=" << pm->ncycle
-        << "  ntracked_prtcls=" << ntrack << std::endl;
-    FILE *pfile;
-    if ((pfile = std::fopen(fname.c_str(),"a")) == nullptr) {
-      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-        << std::endl << "Output file '" << fname << "' could not be opened" <<std::endl;
-      exit(EXIT_FAILURE);
-    }
-    std::fprintf(pfile,"%s \n",msg.str().c_str());
-    std::fclose(pfile);
-  }
-
-  // Now all ranks open file and append data
+  // all ranks open file and append data
   IOWrapper partfile;
   partfile.Open(fname.c_str(), IOWrapper::FileMode::append);
-  std::size_t header_offset = partfile.GetPosition();
-//  std::size_t header_offset = 0;
-
-  // allocate 1D vector of floats used to convert and output particle data
-  float *data = new float[6*npout];
-  // Loop over particles, load positions into data[]
-  for (int p=0; p<npout; ++p) {
-    data[ 6*p   ] = static_cast<float>(outpart(p).x);
-    data[(6*p)+1] = static_cast<float>(outpart(p).y);
-    data[(6*p)+2] = static_cast<float>(outpart(p).z);
-    data[(6*p)+3] = static_cast<float>(outpart(p).vx);
-    data[(6*p)+4] = static_cast<float>(outpart(p).vy);
-    data[(6*p)+5] = static_cast<float>(outpart(p).vz);
-  }
-  // calculate local data offset
-  std::vector<int> rank_offset(global_variable::nranks, 0);
-  int npout_min = pm->nprtcl_eachrank[0];
-  for (int n=1; n<global_variable::nranks; ++n) {
-    rank_offset[n] = rank_offset[n-1] + npout_eachrank[n-1];
-    npout_min = std::min(npout_min, npout_eachrank[n]);
-  }
+  std::size_t offset = partfile.GetPosition();
 
-  std::size_t datasize = sizeof(float);
-  // Write tracked particle data collectively over minimum shared number of prtcls
-  for (int p=0; p<npout_min; ++p) {
-    // offset computed assuming tags run 0...(ntrack-1) sequentially
-    std::size_t myoffset = header_offset + 6*outpart(p).tag;
-    // Write particle positions collectively for minimum number of particles across ranks
-    if (partfile.Write_any_type_at_all(&(data[0]),6,myoffset,"float") != 6) {
-      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-          << std::endl << "particle data not written correctly to tracked particle file"
-          << std::endl;
-      exit(EXIT_FAILURE);
+  const std::size_t recsize = sizeof(int) + 6*sizeof(float);
+  std::vector<char> data(recsize*ntrack);
+  for (int n=0; n<nbuf; ++n) {
+    std::stringstream msg;
+    msg << std::endl << "# AthenaK tracked particle data at time= " << buf_time[n]
+        << "  nranks= " << nranks
+        << "  cycle=" << buf_cycle[n]
+        << "  ntracked_prtcls=" << ntrack << std::endl;
+    std::string header = msg.str() + " \n";
+
+    // root process writes header
+    if (myrank == 0) {
+      if (partfile.Write_any_type_at(header.c_str(), header.size(), offset, "byte") !=
+          header.size()) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "header not written correctly to tracked particle file"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+      }
     }
-  }
-  // Write particle positions individually for remaining particles on each rank
-  for (int p=npout_min; p<npout; ++p) {
-    // offset computed assuming tags run 0...(ntrack-1) sequentially
-    std::size_t myoffset = header_offset + 6*outpart(p).tag;
-    // Write particle positions collectively for minimum number of particles across ranks
-    if (partfile.Write_any_type_at(&(data[0]),6,myoffset,"float") != 6) {
+    offset += header.size();
+
+    // pack records into contiguous bytes, and compute offset of data from this rank
+    int npout = count_all[myrank*nbuf + n];
+    for (int p=0; p<npout; ++p) {
+      int q = n*ntrack + p;
+      std::memcpy(&(data[recsize*p]), &(tag_h(q)), sizeof(int));
+      std::memcpy(&(data[recsize*p + sizeof(int)]), &(buf_h(6*q)), 6*sizeof(float));
+    }
+    std::size_t myoffset = offset;
+    std::size_t npout_total = 0;
+    for (int r=0; r<nranks; ++r) {
+      if (r < myrank) {myoffset += recsize*count_all[r*nbuf + n];}
+      npout_total += count_all[r*nbuf + n];
+    }
+
+    // write data from all ranks collectively
+    if (partfile.Write_any_type_at_all(data.data(), recsize*npout, myoffset, "byte") !=
+        recsize*npout) {
       std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
           << std::endl << "particle data not written correctly to tracked particle file"
           << std::endl;
       exit(EXIT_FAILURE);
     }
+    offset += recsize*npout_total;
   }
 
-  // close the output file and clean up
+  // close the output file and empty buffer
   partfile.Close();
-  delete[] data;
-
-  // increment counters
-  if (out_params.last_time < 0.0) {
-    out_params.last_time = pm->time;
-  } else {
-    out_params.last_time += out_params.dt;
-  }
-  pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
+  buf_time.clear();
+  buf_cycle.clear();
+  nbuf = 0;
   return;
 }
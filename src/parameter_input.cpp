@@ -183,8 +183,8 @@ void ParameterInput::LoadFromFile(IOWrapper &input) {
     }
 #if MPI_PARALLEL_ENABLED
     // then broadcasts it
-    MPI_Bcast(&ret, sizeof(IOWrapperSizeT), MPI_BYTE, 0, MPI_COMM_WORLD);
-    MPI_Bcast(buf, ret, MPI_BYTE, 0, MPI_COMM_WORLD);
+    MPI_Bcast(&ret, sizeof(IOWrapperSizeT), MPI_BYTE, 0, global_variable::athena_comm);
+    MPI_Bcast(buf, ret, MPI_BYTE, 0, global_variable::athena_comm);
 #endif
     par.write(buf, ret); // add the buffer into the stream
     header += ret;
@@ -0,0 +1,100 @@
+#ifndef PARTICLES_PARTICLE_MESH_HPP_
+#define PARTICLES_PARTICLE_MESH_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file particle_mesh.hpp
+//! \brief inline functions to interpolate (gather) cell-centered mesh data to particles,
+//! and to deposit particle data to the mesh, with NGP, CIC, or TSC assignment.  Stencils
+//! extend one cell beyond the cell containing the particle, so gathers use data in ghost
+//! zones and are correct at MeshBlock edges without extra communication.
+
+#include <math.h>
+
+#include "athena.hpp"
+
+namespace particles {
+//----------------------------------------------------------------------------------------
+//! \fn void AssignmentWeights
+//! \brief 1D weights w[0..2] of cells i0,i0+1,i0+2 centered on the cell nearest to a
+//! particle at x, for nearest-grid-point (order=0), cloud-in-cell (order=1), or
+//! triangular-shaped-cloud (order=2) assignment.  Cell i has center at
+//! xmin + (i - is + 1/2)*dx.
+
+KOKKOS_INLINE_FUNCTION
+void AssignmentWeights(const Real x, const Real xmin, const Real dx, const int is,
+                       const int order, int &i0, Real w[3]) {
+  Real xi = (x - xmin)/dx - 0.5;
+  int ic = static_cast<int>(floor(xi + 0.5));
+  Real d = xi - static_cast<Real>(ic);
+  i0 = ic + is - 1;
+  if (order == 0) {
+    w[0] = 0.0;
+    w[1] = 1.0;
+    w[2] = 0.0;
+  } else if (order == 1) {
+    w[0] = fmax(-d, 0.0);
+    w[1] = 1.0 - fabs(d);
+    w[2] = fmax(d, 0.0);
+  } else {
+    w[0] = 0.5*SQR(0.5 - d);
+    w[1] = 0.75 - SQR(d);
+    w[2] = 0.5*SQR(0.5 + d);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Real GatherToParticle
+//! \brief interpolates component n of cell-centered array a in MeshBlock m to a
+//! particle, given weights from AssignmentWeights() in each direction.  Cells with zero
+//! weight (e.g. in x3 for 2D problems, where wz = {0,1,0}) are not accessed.
+
+template <typename ViewType>
+KOKKOS_INLINE_FUNCTION
+Real GatherToParticle(const ViewType &a, const int m, const int n,
+                      const int i0, const int j0, const int k0,
+                      const Real wx[3], const Real wy[3], const Real wz[3]) {
+  Real val = 0.0;
+  for (int kk=0; kk<3; ++kk) {
+    for (int jj=0; jj<3; ++jj) {
+      Real wyz = wz[kk]*wy[jj];
+      if (wyz == 0.0) continue;
+      for (int ii=0; ii<3; ++ii) {
+        if (wx[ii] == 0.0) continue;
+        val += wyz*wx[ii]*a(m,n,k0+kk,j0+jj,i0+ii);
+      }
+    }
+  }
+  return val;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void DepositFromParticle
+//! \brief adds val, distributed with weights from AssignmentWeights(), to component n
+//! of cell-centered array a in MeshBlock m.  Uses atomics, since particles in the same
+//! or neighboring cells deposit to the same cells.
+
+template <typename ViewType>
+KOKKOS_INLINE_FUNCTION
+void DepositFromParticle(const ViewType &a, const int m, const int n,
+                         const int i0, const int j0, const int k0,
+                         const Real wx[3], const Real wy[3], const Real wz[3],
+                         const Real val) {
+  for (int kk=0; kk<3; ++kk) {
+    for (int jj=0; jj<3; ++jj) {
+      Real wyz = wz[kk]*wy[jj];
+      if (wyz == 0.0) continue;
+      for (int ii=0; ii<3; ++ii) {
+        if (wx[ii] == 0.0) continue;
+        Kokkos::atomic_add(&a(m,n,k0+kk,j0+jj,i0+ii), wyz*wx[ii]*val);
+      }
+    }
+  }
+  return;
+}
+
+} // namespace particles
+#endif // PARTICLES_PARTICLE_MESH_HPP_
@@ -9,6 +9,7 @@
 #include <iostream>
 #include <string>
 #include <algorithm>
+#include <vector>
 
 #include "athena.hpp"
 #include "globals.hpp"
@@ -16,6 +17,11 @@
 #include "mesh/mesh.hpp"
 #include "bvals/bvals.hpp"
 #include "particles.hpp"
+#include "particle_mesh.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
 
 namespace particles {
 //----------------------------------------------------------------------------------------
@@ -58,6 +64,26 @@ Particles::Particles(MeshBlockPack *ppack, ParameterInput *pin) :
     std::string ppush = pin->GetString("particles","pusher");
     if (ppush.compare("drift") == 0) {
       pusher = ParticlesPusher::drift;
+    } else if (ppush.compare("lagrangian_tracer") == 0) {
+      pusher = ParticlesPusher::lagrangian_tracer;
+      if (pmy_pack->phydro == nullptr && pmy_pack->pmhd == nullptr) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "Lagrangian tracer particles require a <hydro> or "
+                  << "<mhd> block in input file" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+    } else if (ppush.compare("boris") == 0) {
+      pusher = ParticlesPusher::boris;
+      if (pmy_pack->pmhd == nullptr) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "Boris pusher requires a <mhd> block in input file"
+                  << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+      q_over_m = pin->GetOrAddReal("particles","q_over_m",1.0);
+      speed_of_light = pin->GetOrAddReal("particles","speed_of_light",1.0);
+      gyro_cfl = pin->GetOrAddReal("particles","gyro_cfl",0.1);
+      max_subcycles = pin->GetOrAddInteger("particles","max_subcycles",1000);
     } else {
       std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
                 << std::endl << "Particle pusher must be specified in <particles> block"
@@ -66,6 +92,23 @@ Particles::Particles(MeshBlockPack *ppack, ParameterInput *pin) :
     }
   }
 
+  // select particle-mesh assignment scheme used to gather and deposit
+  {
+    std::string assign = pin->GetOrAddString("particles","assignment","cic");
+    if (assign.compare("ngp") == 0) {
+      assign_order = 0;
+    } else if (assign.compare("cic") == 0) {
+      assign_order = 1;
+    } else if (assign.compare("tsc") == 0) {
+      assign_order = 2;
+    } else {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Particle assignment = '" << assign << "' not recognized"
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  }
+
   // set dimensions of particle arrays. Note particles only work in 2D/3D
   if (pmy_pack->pmesh->one_d) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
@@ -76,7 +119,8 @@ Particles::Particles(MeshBlockPack *ppack, ParameterInput *pin) :
     case ParticleType::cosmic_ray:
       {
         int ndim=4;
-        if (pmy_pack->pmesh->three_d) {ndim+=2;}
+        // Boris pusher evolves all three components of velocity in 2D
+        if (pmy_pack->pmesh->three_d || pusher == ParticlesPusher::boris) {ndim+=2;}
         nrdata = ndim;
         nidata = 2;
         break;
@@ -87,6 +131,10 @@ Particles::Particles(MeshBlockPack *ppack, ParameterInput *pin) :
   Kokkos::realloc(prtcl_rdata, nrdata, nprtcl_thispack);
   Kokkos::realloc(prtcl_idata, nidata, nprtcl_thispack);
 
+  // sort particles by cell every sort_interval cycles
+  sort_interval = pin->GetOrAddInteger("particles","sort_interval",0);
+  Kokkos::realloc(prtcl_cell_offset, (pmy_pack->nmb_thispack)*ncells + 1);
+
   // allocate boundary object
   pbval_part = new ParticlesBoundaryValues(this, pin);
 }
@@ -137,4 +185,255 @@ void Particles::CreateParticleTags(ParameterInput *pin) {
   }
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void Particles::SortParticles()
+//! \brief Sorts particles by (MeshBlock, cell) with a counting sort on the device:
+//! particles in each cell are counted, the counts are scanned into prtcl_cell_offset,
+//! and particles are then scattered into new arrays at the offset of their cell.  The
+//! order of particles within each cell is arbitrary.  Particles are then contiguous in
+//! memory in the same order as cells, so that loops over particles access mesh data
+//! coalesced.
+
+void Particles::SortParticles() {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int nx1 = indcs.nx1, nx2 = indcs.nx2, nx3 = indcs.nx3;
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  int ncells = nx1*nx2*nx3;
+  int ncells_pack = (pmy_pack->nmb_thispack)*ncells;
+  int npart = nprtcl_thispack;
+  int nrdata_ = nrdata, nidata_ = nidata;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+  auto gids = pmy_pack->gids;
+  auto &pr = prtcl_rdata;
+  auto &pi = prtcl_idata;
+
+  if (prtcl_cell_offset.extent_int(0) != ncells_pack + 1) {
+    Kokkos::realloc(prtcl_cell_offset, ncells_pack + 1);
+  }
+  auto &offset = prtcl_cell_offset;
+
+  // index of cell containing each particle, and number of particles in each cell
+  DvceArray1D<int> pcell("pcell", npart);
+  DvceArray1D<int> count("pcount", ncells_pack);
+  par_for("psort_count",DevExeSpace(),0,(npart-1), KOKKOS_LAMBDA(const int p) {
+    int m = pi(PGID,p) - gids;
+    int ip = static_cast<int>((pr(IPX,p) - mbsize.d_view(m).x1min)/mbsize.d_view(m).dx1);
+    ip = (ip < 0)? 0 : ((ip < nx1)? ip : nx1-1);
+    int jp = 0, kp = 0;
+    if (multi_d) {
+      jp = static_cast<int>((pr(IPY,p) - mbsize.d_view(m).x2min)/mbsize.d_view(m).dx2);
+      jp = (jp < 0)? 0 : ((jp < nx2)? jp : nx2-1);
+    }
+    if (three_d) {
+      kp = static_cast<int>((pr(IPZ,p) - mbsize.d_view(m).x3min)/mbsize.d_view(m).dx3);
+      kp = (kp < 0)? 0 : ((kp < nx3)? kp : nx3-1);
+    }
+    int c = ((m*nx3 + kp)*nx2 + jp)*nx1 + ip;
+    pcell(p) = c;
+    Kokkos::atomic_add(&count(c), 1);
+  });
+
+  // exclusive scan of counts gives index of first particle in each cell
+  Kokkos::parallel_scan("psort_scan",Kokkos::RangePolicy<>(DevExeSpace(),0,ncells_pack),
+  KOKKOS_LAMBDA(const int c, int &partial, const bool final) {
+    if (final) {offset(c) = partial;}
+    partial += count(c);
+    if (final && c == ncells_pack-1) {offset(ncells_pack) = partial;}
+  });
+
+  // scatter particles into sorted arrays, using count to fill each cell
+  Kokkos::deep_copy(count, 0);
+  DvceArray2D<Real> new_rdata("prtcl_rdata", nrdata, npart);
+  DvceArray2D<int>  new_idata("prtcl_idata", nidata, npart);
+  par_for("psort_scatter",DevExeSpace(),0,(npart-1), KOKKOS_LAMBDA(const int p) {
+    int c = pcell(p);
+    int q = offset(c) + Kokkos::atomic_fetch_add(&count(c), 1);
+    for (int n=0; n<nrdata_; ++n) {
+      new_rdata(n,q) = pr(n,p);
+    }
+    for (int n=0; n<nidata_; ++n) {
+      new_idata(n,q) = pi(n,p);
+    }
+  });
+  prtcl_rdata = new_rdata;
+  prtcl_idata = new_idata;
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Particles::DepositDensity()
+//! \brief Deposits number of particles per cell into dens(m,0,k,j,i) (which must have
+//! the dimensions of cell-centered arrays including ghost zones) with the assignment
+//! scheme selected by <particles>/assignment.  Weight deposited into ghost zones is not
+//! communicated to neighboring MeshBlocks.
+
+void Particles::DepositDensity(DvceArray5D<Real> &dens) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, js = indcs.js, ks = indcs.ks;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+  auto gids = pmy_pack->gids;
+  auto &pr = prtcl_rdata;
+  auto &pi = prtcl_idata;
+  int order = assign_order;
+
+  Kokkos::deep_copy(dens, 0.0);
+  par_for("pdeposit",DevExeSpace(),0,(nprtcl_thispack-1), KOKKOS_LAMBDA(const int p) {
+    int m = pi(PGID,p) - gids;
+    int i0, j0, k0 = ks - 1;
+    Real wx[3], wy[3], wz[3] = {0.0, 1.0, 0.0};
+    AssignmentWeights(pr(IPX,p), mbsize.d_view(m).x1min, mbsize.d_view(m).dx1, is,
+                      order, i0, wx);
+    AssignmentWeights(pr(IPY,p), mbsize.d_view(m).x2min, mbsize.d_view(m).dx2, js,
+                      order, j0, wy);
+    if (three_d) {
+      AssignmentWeights(pr(IPZ,p), mbsize.d_view(m).x3min, mbsize.d_view(m).dx3, ks,
+                        order, k0, wz);
+    }
+    DepositFromParticle(dens, m, 0, i0, j0, k0, wx, wy, wz, 1.0);
+  });
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Particles::CountParticlesEachMB()
+//! \brief Returns number of particles in each MeshBlock of this pack in the host array
+//! np (of length nmb_thispack).  Used to add the particle load to the cost of each MB.
+
+void Particles::CountParticlesEachMB(int *np) {
+  int nmb = pmy_pack->nmb_thispack;
+  auto gids = pmy_pack->gids;
+  auto &pi = prtcl_idata;
+  DvceArray1D<int> count("pcount_mb", nmb);
+  par_for("pcount_mb",DevExeSpace(),0,(nprtcl_thispack-1), KOKKOS_LAMBDA(const int p) {
+    Kokkos::atomic_add(&count(pi(PGID,p) - gids), 1);
+  });
+  auto count_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), count);
+  for (int m=0; m<nmb; ++m) {np[m] = count_h(m);}
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Particles::RedistributeParticles()
+//! \brief Sends each particle to the rank that owns its MeshBlock after MBs have been
+//! redistributed across ranks by load balancing.  No refinement occurs, so the GID of
+//! each particle is unchanged.  Unlike particles crossing MB boundaries, the new rank
+//! need not be a neighbor, so counts and particles are exchanged with MPI_Alltoall(v).
+//! Particles staying on this rank are compacted to the front of the new arrays, and
+//! received particles appended after them.
+
+void Particles::RedistributeParticles() {
+#if MPI_PARALLEL_ENABLED
+  Mesh *pm = pmy_pack->pmesh;
+  int nranks = global_variable::nranks;
+  int myrank = global_variable::my_rank;
+  int npart = nprtcl_thispack;
+  int nrdata_ = nrdata, nidata_ = nidata;
+  auto &pr = prtcl_rdata;
+  auto &pi = prtcl_idata;
+
+  // rank of each MB in new distribution
+  DualArray1D<int> rank_mb("prank_mb", pm->nmb_total);
+  for (int i=0; i<pm->nmb_total; ++i) {rank_mb.h_view(i) = pm->rank_eachmb[i];}
+  rank_mb.template modify<HostMemSpace>();
+  rank_mb.template sync<DevExeSpace>();
+
+  // destination rank of each particle, and number of particles sent to each rank
+  DvceArray1D<int> pdest("pdest", npart);
+  DvceArray1D<int> count("pcount", nranks);
+  par_for("pdest",DevExeSpace(),0,(npart-1), KOKKOS_LAMBDA(const int p) {
+    int r = rank_mb.d_view(pi(PGID,p));
+    pdest(p) = r;
+    if (r != myrank) {Kokkos::atomic_add(&count(r), 1);}
+  });
+  auto count_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), count);
+
+  std::vector<int> nsend(nranks), nrecv(nranks);
+  for (int n=0; n<nranks; ++n) {nsend[n] = count_h(n);}
+  MPI_Alltoall(nsend.data(), 1, MPI_INT, nrecv.data(), 1, MPI_INT,
+               global_variable::athena_comm);
+
+  // counts and displacements (in units of particles) of send and receive buffers
+  DualArray1D<int> sdispl("psdispl", nranks);
+  std::vector<int> rdispl(nranks);
+  int nsend_tot = 0, nrecv_tot = 0;
+  for (int n=0; n<nranks; ++n) {
+    sdispl.h_view(n) = nsend_tot;
+    rdispl[n] = nrecv_tot;
+    nsend_tot += nsend[n];
+    nrecv_tot += nrecv[n];
+  }
+  sdispl.template modify<HostMemSpace>();
+  sdispl.template sync<DevExeSpace>();
+
+  // pack particles leaving this rank into send buffers, grouped by destination rank
+  DvceArray1D<Real> rsend("prsend", nrdata*nsend_tot);
+  DvceArray1D<int>  isend("pisend", nidata*nsend_tot);
+  Kokkos::deep_copy(count, 0);
+  par_for("ppack_lb",DevExeSpace(),0,(npart-1), KOKKOS_LAMBDA(const int p) {
+    int r = pdest(p);
+    if (r != myrank) {
+      int q = sdispl.d_view(r) + Kokkos::atomic_fetch_add(&count(r), 1);
+      for (int n=0; n<nrdata_; ++n) {rsend(nrdata_*q + n) = pr(n,p);}
+      for (int n=0; n<nidata_; ++n) {isend(nidata_*q + n) = pi(n,p);}
+    }
+  });
+
+  // exchange particles
+  DvceArray1D<Real> rrecv("prrecv", nrdata*nrecv_tot);
+  DvceArray1D<int>  irecv("pirecv", nidata*nrecv_tot);
+  std::vector<int> rscnt(nranks), rsdsp(nranks), rrcnt(nranks), rrdsp(nranks);
+  std::vector<int> iscnt(nranks), isdsp(nranks), ircnt(nranks), irdsp(nranks);
+  for (int n=0; n<nranks; ++n) {
+    rscnt[n] = nrdata*nsend[n];
+    rsdsp[n] = nrdata*sdispl.h_view(n);
+    rrcnt[n] = nrdata*nrecv[n];
+    rrdsp[n] = nrdata*rdispl[n];
+    iscnt[n] = nidata*nsend[n];
+    isdsp[n] = nidata*sdispl.h_view(n);
+    ircnt[n] = nidata*nrecv[n];
+    irdsp[n] = nidata*rdispl[n];
+  }
+  Kokkos::fence();
+  MPI_Alltoallv(rsend.data(), rscnt.data(), rsdsp.data(), MPI_ATHENA_REAL,
+                rrecv.data(), rrcnt.data(), rrdsp.data(), MPI_ATHENA_REAL,
+                global_variable::athena_comm);
+  MPI_Alltoallv(isend.data(), iscnt.data(), isdsp.data(), MPI_INT,
+                irecv.data(), ircnt.data(), irdsp.data(), MPI_INT,
+                global_variable::athena_comm);
+
+  // compact particles staying on this rank, then append received particles
+  int nkeep = npart - nsend_tot;
+  int new_npart = nkeep + nrecv_tot;
+  DvceArray2D<Real> new_rdata("prtcl_rdata", nrdata, new_npart);
+  DvceArray2D<int>  new_idata("prtcl_idata", nidata, new_npart);
+  Kokkos::parallel_scan("pkeep_lb",Kokkos::RangePolicy<>(DevExeSpace(),0,npart),
+  KOKKOS_LAMBDA(const int p, int &partial, const bool final) {
+    if (pdest(p) == myrank) {
+      if (final) {
+        for (int n=0; n<nrdata_; ++n) {new_rdata(n,partial) = pr(n,p);}
+        for (int n=0; n<nidata_; ++n) {new_idata(n,partial) = pi(n,p);}
+      }
+      partial++;
+    }
+  });
+  par_for("punpack_lb",DevExeSpace(),0,(nrecv_tot-1), KOKKOS_LAMBDA(const int q) {
+    for (int n=0; n<nrdata_; ++n) {new_rdata(n,nkeep+q) = rrecv(nrdata_*q + n);}
+    for (int n=0; n<nidata_; ++n) {new_idata(n,nkeep+q) = irecv(nidata_*q + n);}
+  });
+  prtcl_rdata = new_rdata;
+  prtcl_idata = new_idata;
+
+  // update number of particles on each rank
+  nprtcl_thispack = new_npart;
+  pm->nprtcl_thisrank = new_npart;
+  MPI_Allgather(&new_npart,1,MPI_INT,pm->nprtcl_eachrank,1,MPI_INT,
+                global_variable::athena_comm);
+#endif
+  return;
+}
+
 } // namespace particles
@@ -20,7 +20,7 @@
 // forward declarations
 
 // constants that enumerate ParticlesPusher options
-enum class ParticlesPusher {drift, leap_frog, lagrangian_tracer, lagrangian_mc};
+enum class ParticlesPusher {drift, leap_frog, lagrangian_tracer, lagrangian_mc, boris};
 
 // constants that enumerate ParticleTypes
 enum class ParticleType {cosmic_ray};
@@ -38,6 +38,7 @@ struct ParticlesTaskIDs {
   TaskID recvp;
   TaskID csend;
   TaskID crecv;
+  TaskID sort;
 };
 
 namespace particles {
@@ -62,7 +63,20 @@ class Particles {
   DvceArray2D<int>  prtcl_idata;   // integer properties each particle (gid, tag, etc.)
   Real dtnew;
 
+  // particles are sorted by (MeshBlock, cell) every sort_interval cycles (if > 0).
+  // After a sort, particles in cell (m,k,j,i) (interior indices from 0) are stored at
+  // [prtcl_cell_offset(c), prtcl_cell_offset(c+1)) with c = ((m*nx3 + k)*nx2 + j)*nx1 + i
+  int sort_interval;
+  DvceArray1D<int> prtcl_cell_offset;
+
   ParticlesPusher pusher;
+  int assign_order;                // particle-mesh assignment order (0=NGP,1=CIC,2=TSC)
+
+  // parameters of Boris pusher, which sub-cycles each particle within the mesh timestep
+  Real q_over_m;                   // charge-to-mass ratio
+  Real speed_of_light;
+  Real gyro_cfl;                   // maximum gyration angle (radians) per substep
+  int max_subcycles;               // maximum number of substeps per mesh timestep
 
   // Boundary communication buffers and functions for particles
   ParticlesBoundaryValues *pbval_part;
@@ -73,6 +87,10 @@ class Particles {
   // functions...
   void CreateParticleTags(ParameterInput *pin);
   void AssembleTasks(std::map<std::string, std::shared_ptr<TaskList>> tl);
+  void SortParticles();
+  void DepositDensity(DvceArray5D<Real> &dens);
+  void CountParticlesEachMB(int *np);
+  void RedistributeParticles();
   TaskStatus Push(Driver *pdriver, int stage);
   TaskStatus NewGID(Driver *pdriver, int stage);
   TaskStatus SendCnt(Driver *pdriver, int stage);
@@ -81,6 +99,7 @@ class Particles {
   TaskStatus RecvP(Driver *pdriver, int stage);
   TaskStatus ClearSend(Driver *pdriver, int stage);
   TaskStatus ClearRecv(Driver *pdriver, int stage);
+  TaskStatus Sort(Driver *pdriver, int stage);
 
  private:
   MeshBlockPack* pmy_pack;  // ptr to MeshBlockPack containing this Particles
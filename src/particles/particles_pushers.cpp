@@ -6,10 +6,15 @@
 //! \file particle_pushers.cpp
 //  \brief
 
+#include <limits>
+
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
 #include "driver/driver.hpp"
+#include "hydro/hydro.hpp"
+#include "mhd/mhd.hpp"
 #include "particles.hpp"
+#include "particle_mesh.hpp"
 
 namespace particles {
 //----------------------------------------------------------------------------------------
@@ -50,6 +55,119 @@ TaskStatus Particles::Push(Driver *pdriver, int stage) {
       });
 
     break;
+
+    // Lagrangian tracers move with the fluid velocity, interpolated to the particle
+    // from cell centers (including ghost zones) with the selected assignment scheme.
+    case ParticlesPusher::lagrangian_tracer:
+      {
+      auto &w0 = (pmy_pack->phydro != nullptr) ? pmy_pack->phydro->w0 :
+                                                 pmy_pack->pmhd->w0;
+      int order = assign_order;
+      par_for("part_tracer",DevExeSpace(),0,(nprtcl_thispack-1),
+      KOKKOS_LAMBDA(const int p) {
+        int m = pi(PGID,p) - gids;
+        int i0, j0, k0 = ks - 1;
+        Real wx[3], wy[3], wz[3] = {0.0, 1.0, 0.0};
+        AssignmentWeights(pr(IPX,p), mbsize.d_view(m).x1min, mbsize.d_view(m).dx1, is,
+                          order, i0, wx);
+        AssignmentWeights(pr(IPY,p), mbsize.d_view(m).x2min, mbsize.d_view(m).dx2, js,
+                          order, j0, wy);
+        if (three_d) {
+          AssignmentWeights(pr(IPZ,p), mbsize.d_view(m).x3min, mbsize.d_view(m).dx3, ks,
+                            order, k0, wz);
+        }
+        pr(IPVX,p) = GatherToParticle(w0, m, IVX, i0, j0, k0, wx, wy, wz);
+        pr(IPVY,p) = GatherToParticle(w0, m, IVY, i0, j0, k0, wx, wy, wz);
+        pr(IPX,p) += dt_*pr(IPVX,p);
+        pr(IPY,p) += dt_*pr(IPVY,p);
+        if (three_d) {
+          pr(IPVZ,p) = GatherToParticle(w0, m, IVZ, i0, j0, k0, wx, wy, wz);
+          pr(IPZ,p) += dt_*pr(IPVZ,p);
+        }
+      });
+      }
+    break;
+
+    // Relativistic Boris pusher for charged particles in the MHD fields, with u=gamma*v
+    // stored in place of the velocity.  Each particle is sub-cycled within the mesh
+    // timestep with a number of substeps set by its own gyration angle, so that fast
+    // particles in strong fields do not limit the timestep of the fluid.  Since particles
+    // move less than one cell per mesh timestep, B and the ideal MHD electric field
+    // E = -(v_fluid x B) are gathered once and cached for all substeps.  The new
+    // timestep of the particles is limited only by the time to cross one cell.
+    case ParticlesPusher::boris:
+      {
+      auto &w0 = pmy_pack->pmhd->w0;
+      auto &bcc0 = pmy_pack->pmhd->bcc0;
+      int order = assign_order;
+      Real qom = q_over_m;
+      Real c2 = SQR(speed_of_light);
+      Real cfl_gyro = gyro_cfl;
+      int nsub_max = max_subcycles;
+      Real dt_cross = std::numeric_limits<Real>::max();
+      Kokkos::parallel_reduce("part_boris",
+      Kokkos::RangePolicy<>(DevExeSpace(), 0, nprtcl_thispack),
+      KOKKOS_LAMBDA(const int p, Real &min_dt) {
+        int m = pi(PGID,p) - gids;
+        int i0, j0, k0 = ks - 1;
+        Real wx[3], wy[3], wz[3] = {0.0, 1.0, 0.0};
+        AssignmentWeights(pr(IPX,p), mbsize.d_view(m).x1min, mbsize.d_view(m).dx1, is,
+                          order, i0, wx);
+        AssignmentWeights(pr(IPY,p), mbsize.d_view(m).x2min, mbsize.d_view(m).dx2, js,
+                          order, j0, wy);
+        if (three_d) {
+          AssignmentWeights(pr(IPZ,p), mbsize.d_view(m).x3min, mbsize.d_view(m).dx3, ks,
+                            order, k0, wz);
+        }
+        Real b[3], vf[3];
+        for (int d=0; d<3; ++d) {
+          b[d]  = GatherToParticle(bcc0, m, IBX+d, i0, j0, k0, wx, wy, wz);
+          vf[d] = GatherToParticle(w0, m, IVX+d, i0, j0, k0, wx, wy, wz);
+        }
+        Real e[3];
+        e[0] = -(vf[1]*b[2] - vf[2]*b[1]);
+        e[1] = -(vf[2]*b[0] - vf[0]*b[2]);
+        e[2] = -(vf[0]*b[1] - vf[1]*b[0]);
+
+        Real u[3] = {pr(IPVX,p), pr(IPVY,p), pr(IPVZ,p)};
+        Real gam = sqrt(1.0 + (SQR(u[0]) + SQR(u[1]) + SQR(u[2]))/c2);
+        Real bmag = sqrt(SQR(b[0]) + SQR(b[1]) + SQR(b[2]));
+        int nsub = static_cast<int>(ceil(dt_*fabs(qom)*bmag/(gam*cfl_gyro)));
+        nsub = (nsub < 1)? 1 : ((nsub > nsub_max)? nsub_max : nsub);
+        Real h = dt_/static_cast<Real>(nsub);
+        for (int s=0; s<nsub; ++s) {
+          // half kick by E, rotation by B, half kick by E, then drift
+          for (int d=0; d<3; ++d) {u[d] += 0.5*h*qom*e[d];}
+          gam = sqrt(1.0 + (SQR(u[0]) + SQR(u[1]) + SQR(u[2]))/c2);
+          Real t[3], sv[3], up[3];
+          for (int d=0; d<3; ++d) {t[d] = 0.5*h*qom*b[d]/gam;}
+          Real fac = 2.0/(1.0 + SQR(t[0]) + SQR(t[1]) + SQR(t[2]));
+          for (int d=0; d<3; ++d) {sv[d] = fac*t[d];}
+          up[0] = u[0] + (u[1]*t[2] - u[2]*t[1]);
+          up[1] = u[1] + (u[2]*t[0] - u[0]*t[2]);
+          up[2] = u[2] + (u[0]*t[1] - u[1]*t[0]);
+          u[0] += up[1]*sv[2] - up[2]*sv[1];
+          u[1] += up[2]*sv[0] - up[0]*sv[2];
+          u[2] += up[0]*sv[1] - up[1]*sv[0];
+          for (int d=0; d<3; ++d) {u[d] += 0.5*h*qom*e[d];}
+          gam = sqrt(1.0 + (SQR(u[0]) + SQR(u[1]) + SQR(u[2]))/c2);
+          pr(IPX,p) += h*u[0]/gam;
+          pr(IPY,p) += h*u[1]/gam;
+          if (three_d) {pr(IPZ,p) += h*u[2]/gam;}
+        }
+        pr(IPVX,p) = u[0];
+        pr(IPVY,p) = u[1];
+        pr(IPVZ,p) = u[2];
+
+        // time to cross one cell at the new speed
+        Real v = sqrt(SQR(u[0]) + SQR(u[1]) + SQR(u[2]))/gam;
+        Real dx = fmin(mbsize.d_view(m).dx1, mbsize.d_view(m).dx2);
+        if (three_d) {dx = fmin(dx, mbsize.d_view(m).dx3);}
+        if (v > 0.0) {min_dt = fmin(min_dt, dx/v);}
+      }, Kokkos::Min<Real>(dt_cross));
+      dtnew = dt_cross;
+      }
+    break;
   default:
     break;
   }
@@ -37,6 +37,7 @@ void Particles::AssembleTasks(std::map<std::string, std::shared_ptr<TaskList>> t
   id.recvp  = tl["before_timeintegrator"]->AddTask(&Particles::RecvP, this, id.sendp);
   id.crecv  = tl["before_timeintegrator"]->AddTask(&Particles::ClearRecv, this, id.recvp);
   id.csend  = tl["before_timeintegrator"]->AddTask(&Particles::ClearSend, this, id.crecv);
+  id.sort   = tl["before_timeintegrator"]->AddTask(&Particles::Sort, this, id.csend);
 
   return;
 }
@@ -110,4 +111,16 @@ TaskStatus Particles::ClearRecv(Driver *pdrive, int stage) {
   return tstat;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn TaskList Particles::Sort
+//! \brief Wrapper task list function that sorts particles by cell every sort_interval
+//! cycles, once particles have been communicated to their new MeshBlocks.
+
+TaskStatus Particles::Sort(Driver *pdrive, int stage) {
+  if (sort_interval > 0 && (pmy_pack->pmesh->ncycle % sort_interval) == 0) {
+    SortParticles();
+  }
+  return TaskStatus::complete;
+}
+
 } // namespace particles
@@ -27,6 +27,7 @@
 #include "hydro/hydro.hpp"
 #include "mhd/mhd.hpp"
 #include "dyn_grmhd/dyn_grmhd.hpp"
+#include "pgen/id_cache.hpp"
 #include "elliptica_id_reader_lib.h"
 
 void EllipticaHistory(HistoryData *pdata, Mesh *pm);
@@ -55,15 +56,7 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
   }
 
   std::string fname = pin->GetString("problem", "initial_data_file");
-
-  // Initialize the data reader
-  Elliptica_ID_Reader_T *idr = elliptica_id_reader_init(fname.c_str(),"generic");
-
-  // Fields to interpolate
-  idr->ifields = "alpha,betax,betay,betaz,"
-                 "adm_gxx,adm_gxy,adm_gxz,adm_gyy,adm_gyz,adm_gzz,"
-                 "adm_Kxx,adm_Kxy,adm_Kxz,adm_Kyy,adm_Kyz,adm_Kzz,"
-                 "grhd_rho,grhd_p,grhd_vx,grhd_vy,grhd_vz";
+  std::string cache_file = pin->GetOrAddString("problem", "id_cache_file", "");
 
   int ncells1 = indcs.nx1 + 2*(indcs.ng);
   int ncells2 = indcs.nx2 + 2*(indcs.ng);
@@ -72,64 +65,6 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
 
   int width = nmb*ncells1*ncells2*ncells3;
 
-  Real *x_coords = new Real[width];
-  Real *y_coords = new Real[width];
-  Real *z_coords = new Real[width];
-
-  std::cout << "Allocated coordinates of size " << width << std::endl;
-
-  // Populate coordinates for Elliptica
-  // TODO(JMF): Replace with a Kokkos loop on Kokkos::DefaultHostExecutionSpace() to
-  // improve performance.
-  int idx = 0;
-  for (int m = 0; m < nmb; m++) {
-    Real &x1min = size.h_view(m).x1min;
-    Real &x1max = size.h_view(m).x1max;
-    int nx1 = indcs.nx1;
-
-    Real &x2min = size.h_view(m).x2min;
-    Real &x2max = size.h_view(m).x2max;
-    int nx2 = indcs.nx2;
-
-    Real &x3min = size.h_view(m).x3min;
-    Real &x3max = size.h_view(m).x3max;
-    int nx3 = indcs.nx3;
-
-    for (int k = 0; k < ncells3; k++) {
-      Real z = CellCenterX(k - ks, nx3, x3min, x3max);
-      for (int j = 0; j < ncells2; j++) {
-        Real y = CellCenterX(j - js, nx2, x2min, x2max);
-        for (int i = 0; i < ncells1; i++) {
-          Real x = CellCenterX(i - is, nx1, x1min, x1max);
-
-          x_coords[idx] = x;
-          y_coords[idx] = y;
-          z_coords[idx] = z;
-
-          // Increment flat index
-          idx++;
-        }
-      }
-    }
-  }
-
-  idr->set_param("ADM_B1I_form","zero",idr);
-
-  // Interpolate the data
-  idr->npoints  = width;
-  idr->x_coords = x_coords;
-  idr->y_coords = y_coords;
-  idr->z_coords = z_coords;
-  std::cout << "Coordinates assigned." << std::endl;
-  elliptica_id_reader_interpolate(idr);
-
-  // Free the coordinates, since we'll no longer need them.
-  delete[] x_coords;
-  delete[] y_coords;
-  delete[] z_coords;
-
-  std::cout << "Coordinates freed." << std::endl;
-
   // Capture variables for kernel; note that when Z4c is enabled, the gauge variables
   // are part of the Z4c class.
   auto &u_adm = pmbp->padm->u_adm;
@@ -156,101 +91,174 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
 
   std::cout << "Host mirrors created." << std::endl;
 
-  // Save Elliptica field indices for shorthand and a small optimization.
-  const int i_alpha = idr->indx("alpha");
-  const int i_betax = idr->indx("betax");
-  const int i_betay = idr->indx("betay");
-  const int i_betaz = idr->indx("betaz");
-
-  const int i_gxx   = idr->indx("adm_gxx");
-  const int i_gxy   = idr->indx("adm_gxy");
-  const int i_gxz   = idr->indx("adm_gxz");
-  const int i_gyy   = idr->indx("adm_gyy");
-  const int i_gyz   = idr->indx("adm_gyz");
-  const int i_gzz   = idr->indx("adm_gzz");
-
-  const int i_Kxx   = idr->indx("adm_Kxx");
-  const int i_Kxy   = idr->indx("adm_Kxy");
-  const int i_Kxz   = idr->indx("adm_Kxz");
-  const int i_Kyy   = idr->indx("adm_Kyy");
-  const int i_Kyz   = idr->indx("adm_Kyz");
-  const int i_Kzz   = idr->indx("adm_Kzz");
-
-  const int i_rho   = idr->indx("grhd_rho");
-  const int i_p     = idr->indx("grhd_p");
-  const int i_vx    = idr->indx("grhd_vx");
-  const int i_vy    = idr->indx("grhd_vy");
-  const int i_vz    = idr->indx("grhd_vz");
-
-  std::cout << "Label indices saved." << std::endl;
-
-  // TODO(JMF): Replace with a Kokkos loop on Kokkos::DefaultHostExecutionSpace() to
-  // improve performance.
-  idx = 0;
-  for (int m = 0; m < nmb; m++) {
-    for (int k = 0; k < ncells3; k++) {
-      for (int j = 0; j < ncells2; j++) {
-        for (int i = 0; i < ncells1; i++) {
-          // Extract metric quantities
-          host_adm.alpha(m, k, j, i) = idr->field[i_alpha][idx];
-          host_adm.beta_u(m, 0, k, j, i) = idr->field[i_betax][idx];
-          host_adm.beta_u(m, 1, k, j, i) = idr->field[i_betay][idx];
-          host_adm.beta_u(m, 2, k, j, i) = idr->field[i_betaz][idx];
-
-          Real g3d[NSPMETRIC];
-          host_adm.g_dd(m, 0, 0, k, j, i) = g3d[S11] = idr->field[i_gxx][idx];
-          host_adm.g_dd(m, 0, 1, k, j, i) = g3d[S12] = idr->field[i_gxy][idx];
-          host_adm.g_dd(m, 0, 2, k, j, i) = g3d[S13] = idr->field[i_gxz][idx];
-          host_adm.g_dd(m, 1, 1, k, j, i) = g3d[S22] = idr->field[i_gyy][idx];
-          host_adm.g_dd(m, 1, 2, k, j, i) = g3d[S23] = idr->field[i_gyz][idx];
-          host_adm.g_dd(m, 2, 2, k, j, i) = g3d[S33] = idr->field[i_gzz][idx];
-
-          host_adm.vK_dd(m, 0, 0, k, j, i) = idr->field[i_Kxx][idx];
-          host_adm.vK_dd(m, 0, 1, k, j, i) = idr->field[i_Kxy][idx];
-          host_adm.vK_dd(m, 0, 2, k, j, i) = idr->field[i_Kxz][idx];
-          host_adm.vK_dd(m, 1, 1, k, j, i) = idr->field[i_Kyy][idx];
-          host_adm.vK_dd(m, 1, 2, k, j, i) = idr->field[i_Kyz][idx];
-          host_adm.vK_dd(m, 2, 2, k, j, i) = idr->field[i_Kzz][idx];
-
-          // Extract hydro quantities
-          host_w0(m, IDN, k, j, i) = idr->field[i_rho][idx];
-          host_w0(m, IPR, k, j, i) = idr->field[i_p][idx];
-          Real vu[3] = {idr->field[i_vx][idx],
-                        idr->field[i_vy][idx],
-                        idr->field[i_vz][idx]};
-
-          // Before we store the velocity, we need to make sure it's physical and
-          // calculate the Lorentz factor. If the velocity is superluminal, we make a
-          // last-ditch attempt to salvage the solution by rescaling it to
-          // vsq = 1.0 - 1e-15
-          Real vsq = Primitive::SquareVector(vu, g3d);
-          if (1.0 - vsq <= 0) {
-            std::cout << "The velocity is superluminal!" << std::endl
-                      << "Attempting to adjust..." << std::endl;
-            Real fac = sqrt((1.0 - 1e-15)/vsq);
-            vu[0] *= fac;
-            vu[1] *= fac;
-            vu[2] *= fac;
-            vsq = 1.0 - 1.0e-15;
-          }
-          Real W = sqrt(1.0 / (1.0 - vsq));
-
-          host_w0(m, IVX, k, j, i) = W*vu[0];
-          host_w0(m, IVY, k, j, i) = W*vu[1];
-          host_w0(m, IVZ, k, j, i) = W*vu[2];
-
-          idx++;
-        }
+  // Load the initial data from the cache written by an earlier run, if it exists.
+  // Otherwise interpolate it with Elliptica and write the cache.
+  IDCacheArrays cache_arrays = {host_u_adm, host_w0, host_u_z4c};
+  bool cached = id_cache::Load(cache_file, pmbp, fname, cache_arrays);
+  if (cached) {
+    std::cout << "Initial data loaded from cache." << std::endl;
+  } else {
+    // Initialize the data reader
+    Elliptica_ID_Reader_T *idr = elliptica_id_reader_init(fname.c_str(),"generic");
+
+    // Fields to interpolate
+    idr->ifields = "alpha,betax,betay,betaz,"
+                   "adm_gxx,adm_gxy,adm_gxz,adm_gyy,adm_gyz,adm_gzz,"
+                   "adm_Kxx,adm_Kxy,adm_Kxz,adm_Kyy,adm_Kyz,adm_Kzz,"
+                   "grhd_rho,grhd_p,grhd_vx,grhd_vy,grhd_vz";
+
+    Real *x_coords = new Real[width];
+    Real *y_coords = new Real[width];
+    Real *z_coords = new Real[width];
+
+    std::cout << "Allocated coordinates of size " << width << std::endl;
+
+    // Populate coordinates for Elliptica.  The flat index of each cell is computed
+    // directly, so that the loop can be distributed over host threads.
+    const int nkji = ncells3*ncells2*ncells1;
+    const int nji  = ncells2*ncells1;
+    Kokkos::parallel_for("pgen_elliptica_coords",
+    Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, width),
+    [&](const int idx) {
+      int m = (idx)/nkji;
+      int k = (idx - m*nkji)/nji;
+      int j = (idx - m*nkji - k*nji)/ncells1;
+      int i = (idx - m*nkji - k*nji - j*ncells1);
+
+      Real &x1min = size.h_view(m).x1min;
+      Real &x1max = size.h_view(m).x1max;
+      int nx1 = indcs.nx1;
+
+      Real &x2min = size.h_view(m).x2min;
+      Real &x2max = size.h_view(m).x2max;
+      int nx2 = indcs.nx2;
+
+      Real &x3min = size.h_view(m).x3min;
+      Real &x3max = size.h_view(m).x3max;
+      int nx3 = indcs.nx3;
+
+      x_coords[idx] = CellCenterX(i - is, nx1, x1min, x1max);
+      y_coords[idx] = CellCenterX(j - js, nx2, x2min, x2max);
+      z_coords[idx] = CellCenterX(k - ks, nx3, x3min, x3max);
+    });
+
+    idr->set_param("ADM_B1I_form","zero",idr);
+
+    // Interpolate the data
+    idr->npoints  = width;
+    idr->x_coords = x_coords;
+    idr->y_coords = y_coords;
+    idr->z_coords = z_coords;
+    std::cout << "Coordinates assigned." << std::endl;
+    elliptica_id_reader_interpolate(idr);
+
+    // Free the coordinates, since we'll no longer need them.
+    delete[] x_coords;
+    delete[] y_coords;
+    delete[] z_coords;
+
+    std::cout << "Coordinates freed." << std::endl;
+
+    // Save Elliptica field indices for shorthand and a small optimization.
+    const int i_alpha = idr->indx("alpha");
+    const int i_betax = idr->indx("betax");
+    const int i_betay = idr->indx("betay");
+    const int i_betaz = idr->indx("betaz");
+
+    const int i_gxx   = idr->indx("adm_gxx");
+    const int i_gxy   = idr->indx("adm_gxy");
+    const int i_gxz   = idr->indx("adm_gxz");
+    const int i_gyy   = idr->indx("adm_gyy");
+    const int i_gyz   = idr->indx("adm_gyz");
+    const int i_gzz   = idr->indx("adm_gzz");
+
+    const int i_Kxx   = idr->indx("adm_Kxx");
+    const int i_Kxy   = idr->indx("adm_Kxy");
+    const int i_Kxz   = idr->indx("adm_Kxz");
+    const int i_Kyy   = idr->indx("adm_Kyy");
+    const int i_Kyz   = idr->indx("adm_Kyz");
+    const int i_Kzz   = idr->indx("adm_Kzz");
+
+    const int i_rho   = idr->indx("grhd_rho");
+    const int i_p     = idr->indx("grhd_p");
+    const int i_vx    = idr->indx("grhd_vx");
+    const int i_vy    = idr->indx("grhd_vy");
+    const int i_vz    = idr->indx("grhd_vz");
+
+    std::cout << "Label indices saved." << std::endl;
+
+    // Unpack the data on host threads, counting the points at which the velocity has to
+    // be adjusted so that the warning is only printed once.
+    int nadjust = 0;
+    Kokkos::parallel_reduce("pgen_elliptica_unpack",
+    Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, width),
+    [&](const int idx, int &nadj) {
+      int m = (idx)/nkji;
+      int k = (idx - m*nkji)/nji;
+      int j = (idx - m*nkji - k*nji)/ncells1;
+      int i = (idx - m*nkji - k*nji - j*ncells1);
+
+      // Extract metric quantities
+      host_adm.alpha(m, k, j, i) = idr->field[i_alpha][idx];
+      host_adm.beta_u(m, 0, k, j, i) = idr->field[i_betax][idx];
+      host_adm.beta_u(m, 1, k, j, i) = idr->field[i_betay][idx];
+      host_adm.beta_u(m, 2, k, j, i) = idr->field[i_betaz][idx];
+
+      Real g3d[NSPMETRIC];
+      host_adm.g_dd(m, 0, 0, k, j, i) = g3d[S11] = idr->field[i_gxx][idx];
+      host_adm.g_dd(m, 0, 1, k, j, i) = g3d[S12] = idr->field[i_gxy][idx];
+      host_adm.g_dd(m, 0, 2, k, j, i) = g3d[S13] = idr->field[i_gxz][idx];
+      host_adm.g_dd(m, 1, 1, k, j, i) = g3d[S22] = idr->field[i_gyy][idx];
+      host_adm.g_dd(m, 1, 2, k, j, i) = g3d[S23] = idr->field[i_gyz][idx];
+      host_adm.g_dd(m, 2, 2, k, j, i) = g3d[S33] = idr->field[i_gzz][idx];
+
+      host_adm.vK_dd(m, 0, 0, k, j, i) = idr->field[i_Kxx][idx];
+      host_adm.vK_dd(m, 0, 1, k, j, i) = idr->field[i_Kxy][idx];
+      host_adm.vK_dd(m, 0, 2, k, j, i) = idr->field[i_Kxz][idx];
+      host_adm.vK_dd(m, 1, 1, k, j, i) = idr->field[i_Kyy][idx];
+      host_adm.vK_dd(m, 1, 2, k, j, i) = idr->field[i_Kyz][idx];
+      host_adm.vK_dd(m, 2, 2, k, j, i) = idr->field[i_Kzz][idx];
+
+      // Extract hydro quantities
+      host_w0(m, IDN, k, j, i) = idr->field[i_rho][idx];
+      host_w0(m, IPR, k, j, i) = idr->field[i_p][idx];
+      Real vu[3] = {idr->field[i_vx][idx],
+                    idr->field[i_vy][idx],
+                    idr->field[i_vz][idx]};
+
+      // Before we store the velocity, we need to make sure it's physical and
+      // calculate the Lorentz factor. If the velocity is superluminal, we make a
+      // last-ditch attempt to salvage the solution by rescaling it to
+      // vsq = 1.0 - 1e-15
+      Real vsq = Primitive::SquareVector(vu, g3d);
+      if (1.0 - vsq <= 0) {
+        nadj++;
+        Real fac = sqrt((1.0 - 1e-15)/vsq);
+        vu[0] *= fac;
+        vu[1] *= fac;
+        vu[2] *= fac;
+        vsq = 1.0 - 1.0e-15;
       }
+      Real W = sqrt(1.0 / (1.0 - vsq));
+
+      host_w0(m, IVX, k, j, i) = W*vu[0];
+      host_w0(m, IVY, k, j, i) = W*vu[1];
+      host_w0(m, IVZ, k, j, i) = W*vu[2];
+    }, nadjust);
+    if (nadjust > 0) {
+      std::cout << "The velocity is superluminal at " << nadjust << " points!"
+                << std::endl << "Attempting to adjust..." << std::endl;
     }
-  }
 
-  std::cout << "Host mirrors filled." << std::endl;
+    std::cout << "Host mirrors filled." << std::endl;
+
+    // Cleanup
+    elliptica_id_reader_free(idr);
 
-  // Cleanup
-  elliptica_id_reader_free(idr);
+    std::cout << "Elliptica freed." << std::endl;
 
-  std::cout << "Elliptica freed." << std::endl;
+    id_cache::Save(cache_file, pmbp, fname, cache_arrays);
+  }
 
   // Copy the data to the GPU.
   Kokkos::deep_copy(u_adm, host_u_adm);
@@ -340,21 +348,9 @@ void EllipticaHistory(HistoryData *pdata, Mesh *pm) {
     mb_alp_min = fmin(mb_alp_min, adm.alpha(m, k, j, i));
   }, Kokkos::Max<Real>(rho_max), Kokkos::Min<Real>(alpha_min));
 
-  // Currently AthenaK only supports MPI_SUM operations between ranks, but we need MPI_MAX
-  // and MPI_MIN operations instead. This is a cheap hack to make it work as intended.
-#if MPI_PARALLEL_ENABLED
-  if (global_variable::my_rank == 0) {
-    MPI_Reduce(MPI_IN_PLACE, &rho_max, 1, MPI_ATHENA_REAL, MPI_MAX, 0, MPI_COMM_WORLD);
-    MPI_Reduce(MPI_IN_PLACE, &alpha_min, 1, MPI_ATHENA_REAL, MPI_MIN, 0, MPI_COMM_WORLD);
-  } else {
-    MPI_Reduce(&rho_max, &rho_max, 1, MPI_ATHENA_REAL, MPI_MAX, 0, MPI_COMM_WORLD);
-    MPI_Reduce(&alpha_min, &alpha_min, 1, MPI_ATHENA_REAL, MPI_MAX, 0, MPI_COMM_WORLD);
-    rho_max = 0.;
-    alpha_min = 0.;
-  }
-#endif
-
-  // store data in hdata array
+  // store data in hdata array, reduced over ranks with max/min
   pdata->hdata[0] = rho_max;
   pdata->hdata[1] = alpha_min;
+  pdata->op[0] = HistoryMax;
+  pdata->op[1] = HistoryMin;
 }
@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "athena.hpp"
+#include "globals.hpp"
 #include "parameter_input.hpp"
 #include "mesh/mesh.hpp"
 #include "coordinates/adm.hpp"
@@ -195,7 +196,7 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
   int nangles_;
   DualArray2D<Real> nh_c_;
   DvceArray6D<Real> norm_to_tet_, tet_c_, tetcov_c_;
-  DvceArray5D<Real> i0_;
+  DvceArray5D<RadReal> i0_;
   if (is_radiation_enabled) {
     nangles_ = pmbp->prad->prgeo->nangles;
     nh_c_ = pmbp->prad->nh_c;
@@ -814,9 +815,15 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
 
 #if MPI_PARALLEL_ENABLED
     // get maximum value of gas pressure and bsq over all MPI ranks
-    MPI_Allreduce(MPI_IN_PLACE, &ptotmax, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-    MPI_Allreduce(MPI_IN_PLACE, &bsqmax, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-    MPI_Allreduce(MPI_IN_PLACE, &bsqmax_intorus, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    GlobalReductions gr;
+    int hptot = gr.Add("ptotmax", ptotmax, ReduceOp::max);
+    int hbsq = gr.Add("bsqmax", bsqmax, ReduceOp::max);
+    int hbsq_in = gr.Add("bsqmax_intorus", bsqmax_intorus, ReduceOp::max);
+    gr.Start();
+    gr.Finish();
+    ptotmax = gr.Result(hptot);
+    bsqmax = gr.Result(hbsq);
+    bsqmax_intorus = gr.Result(hbsq_in);
 #endif
 
     // Apply renormalization of magnetic field
@@ -1480,7 +1487,7 @@ void NoInflowTorus(Mesh *pm) {
 
   // Determine if radiation is enabled
   const bool is_radiation_enabled = (pm->pmb_pack->prad != nullptr);
-  DvceArray5D<Real> i0_; int nang1;
+  DvceArray5D<RadReal> i0_; int nang1;
   if (is_radiation_enabled) {
     i0_ = pm->pmb_pack->prad->i0;
     nang1 = pm->pmb_pack->prad->prgeo->nangles - 1;
@@ -0,0 +1,126 @@
+#ifndef PGEN_ID_CACHE_HPP_
+#define PGEN_ID_CACHE_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file id_cache.hpp
+//! \brief functions to save and load initial data interpolated by external libraries
+//! (e.g. LORENE or Elliptica) in host mirrors of the MeshBlockPack arrays.  Each rank
+//! writes its own binary file <id_cache_file>.<rank>, so repeated runs with the same
+//! Mesh, number of ranks, and initial data file can skip the interpolation.  The file
+//! starts with a header storing the name of the initial data file, the sizes of all
+//! arrays, and the gid and bounds of every MeshBlock on the rank; the cache is only used
+//! if all of these match the current run.
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "mesh/mesh.hpp"
+
+using IDCacheArrays = std::vector<HostArray5D<Real>::HostMirror>;
+
+namespace id_cache {
+
+//----------------------------------------------------------------------------------------
+//! \fn std::vector<Real> Header()
+//! \brief Returns header identifying the configuration of arrays a on this rank.
+
+inline std::vector<Real> Header(MeshBlockPack *pmbp, const std::string &id_file,
+                                const IDCacheArrays &a) {
+  std::vector<Real> h;
+  for (char c : id_file) {h.push_back(static_cast<Real>(c));}
+  h.push_back(static_cast<Real>(pmbp->nmb_thispack));
+  for (auto &v : a) {
+    for (int d=0; d<5; ++d) {h.push_back(static_cast<Real>(v.extent(d)));}
+  }
+  auto &size = pmbp->pmb->mb_size;
+  for (int m=0; m<pmbp->nmb_thispack; ++m) {
+    h.push_back(static_cast<Real>(pmbp->gids + m));
+    h.push_back(size.h_view(m).x1min); h.push_back(size.h_view(m).x1max);
+    h.push_back(size.h_view(m).x2min); h.push_back(size.h_view(m).x2max);
+    h.push_back(size.h_view(m).x3min); h.push_back(size.h_view(m).x3max);
+  }
+  return h;
+}
+
+inline std::string FileName(const std::string &cache_file) {
+  return cache_file + "." + std::to_string(global_variable::my_rank);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool Load()
+//! \brief Reads arrays a from cache file if it exists and its header matches, and
+//! returns true on success.  Returns false (and leaves a unchanged) otherwise.
+
+inline bool Load(const std::string &cache_file, MeshBlockPack *pmbp,
+                 const std::string &id_file, IDCacheArrays &a) {
+  if (cache_file.empty()) return false;
+  std::string fname = FileName(cache_file);
+  FILE *pfile = std::fopen(fname.c_str(), "rb");
+  if (pfile == nullptr) return false;
+
+  std::vector<Real> h = Header(pmbp, id_file, a);
+  std::size_t nh = 0;
+  bool match = (std::fread(&nh, sizeof(std::size_t), 1, pfile) == 1 && nh == h.size());
+  if (match) {
+    std::vector<Real> hfile(nh);
+    match = (std::fread(hfile.data(), sizeof(Real), nh, pfile) == nh && hfile == h);
+  }
+  if (!(match)) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Initial data cache '" << fname << "' does not match this run and "
+              << "will be overwritten" << std::endl;
+    std::fclose(pfile);
+    return false;
+  }
+  // read into temporary arrays so a is unchanged if the file is truncated
+  IDCacheArrays tmp;
+  for (auto &v : a) {
+    tmp.push_back(HostArray5D<Real>::HostMirror("id_cache", v.extent(0), v.extent(1),
+                  v.extent(2), v.extent(3), v.extent(4)));
+    std::size_t n = tmp.back().size();
+    if (std::fread(tmp.back().data(), sizeof(Real), n, pfile) != n) {
+      std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+                << "Initial data cache '" << fname << "' is truncated and will be "
+                << "overwritten" << std::endl;
+      std::fclose(pfile);
+      return false;
+    }
+  }
+  std::fclose(pfile);
+  for (std::size_t n=0; n<a.size(); ++n) {Kokkos::deep_copy(a[n], tmp[n]);}
+  return true;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Save()
+//! \brief Writes header and arrays a to cache file, if cache_file is not empty.
+
+inline void Save(const std::string &cache_file, MeshBlockPack *pmbp,
+                 const std::string &id_file, const IDCacheArrays &a) {
+  if (cache_file.empty()) return;
+  std::string fname = FileName(cache_file);
+  FILE *pfile = std::fopen(fname.c_str(), "wb");
+  if (pfile == nullptr) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Initial data cache '" << fname << "' could not be opened, initial "
+              << "data will not be cached" << std::endl;
+    return;
+  }
+  std::vector<Real> h = Header(pmbp, id_file, a);
+  std::size_t nh = h.size();
+  std::fwrite(&nh, sizeof(std::size_t), 1, pfile);
+  std::fwrite(h.data(), sizeof(Real), nh, pfile);
+  for (auto &v : a) {std::fwrite(v.data(), sizeof(Real), v.size(), pfile);}
+  std::fclose(pfile);
+  return;
+}
+
+} // namespace id_cache
+#endif // PGEN_ID_CACHE_HPP_
@@ -15,8 +15,7 @@
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
 #include "particles/particles.hpp"
-
-#include <Kokkos_Random.hpp>
+#include "utils/random.hpp"
 
 //----------------------------------------------------------------------------------------
 //! \fn ProblemGenerator::UserProblem_()
@@ -39,37 +38,37 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
   auto &pi = pmy_mesh_->pmb_pack->ppart->prtcl_idata;
   auto &npart = pmy_mesh_->pmb_pack->ppart->nprtcl_thispack;
   auto gids = pmy_mesh_->pmb_pack->gids;
-  auto gide = pmy_mesh_->pmb_pack->gide;
+  int nmb = pmy_mesh_->pmb_pack->nmb_thispack;
+  int64_t seed = pin->GetOrAddInteger("problem", "rng_seed", 1);
 
-  // initialize particles
-  Kokkos::Random_XorShift64_Pool<> rand_pool64(pmbp->gids);
+  // initialize particles.  Random numbers are drawn with the counter-based RNG using the
+  // tag of each particle as counter, and particles are divided evenly between the
+  // MeshBlocks, so with tags in index_order the particles are the same for any number of
+  // ranks (and threads).
   par_for("part_update",DevExeSpace(),0,(npart-1),
   KOKKOS_LAMBDA(const int p) {
-    auto rand_gen = rand_pool64.get_state();  // get random number state this thread
-    // choose parent MeshBlock randomly
-    int m = static_cast<int>(rand_gen.frand()*(gide - gids + 1.0));
+    int64_t ctr = 8*static_cast<int64_t>(pi(PTAG,p));
+    int m = static_cast<int>((static_cast<int64_t>(p)*nmb)/npart);
     pi(PGID,p) = gids + m;
 
-    Real rand = rand_gen.frand();
+    Real rand = RanCounter(seed, 0, ctr);
     pr(IPX,p) = (1. - rand)*mbsize.d_view(m).x1min + rand*mbsize.d_view(m).x1max;
     pr(IPX,p) = fmin(pr(IPX,p),mbsize.d_view(m).x1max);
     pr(IPX,p) = fmax(pr(IPX,p),mbsize.d_view(m).x1min);
 
-    rand = rand_gen.frand();
+    rand = RanCounter(seed, 0, ctr + 1);
     pr(IPY,p) = (1. - rand)*mbsize.d_view(m).x2min + rand*mbsize.d_view(m).x2max;
     pr(IPY,p) = fmin(pr(IPY,p),mbsize.d_view(m).x2max);
     pr(IPY,p) = fmax(pr(IPY,p),mbsize.d_view(m).x2min);
 
-    rand = rand_gen.frand();
+    rand = RanCounter(seed, 0, ctr + 2);
     pr(IPZ,p) = (1. - rand)*mbsize.d_view(m).x3min + rand*mbsize.d_view(m).x3max;
     pr(IPZ,p) = fmin(pr(IPZ,p),mbsize.d_view(m).x3max);
     pr(IPZ,p) = fmax(pr(IPZ,p),mbsize.d_view(m).x3min);
 
-    pr(IPVX,p) = 2.0*(rand_gen.frand() - 0.5);
-    pr(IPVY,p) = 2.0*(rand_gen.frand() - 0.5);
-    pr(IPVZ,p) = 2.0*(rand_gen.frand() - 0.5);
-
-    rand_pool64.free_state(rand_gen);  // free state for use by other threads
+    pr(IPVX,p) = 2.0*(RanCounter(seed, 0, ctr + 3) - 0.5);
+    pr(IPVY,p) = 2.0*(RanCounter(seed, 0, ctr + 4) - 0.5);
+    pr(IPVZ,p) = 2.0*(RanCounter(seed, 0, ctr + 5) - 0.5);
   });
 
   // set timestep (which will remain constant for entire run
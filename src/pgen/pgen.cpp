@@ -8,10 +8,14 @@
 //! Default constructor calls problem generator function, while  constructor for restarts
 //! reads data from restart file, as well as re-initializing problem-specific data.
 
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <utility>
 #include <algorithm>
+#include <vector>
 
 #include "athena.hpp"
 #include "geodesic-grid/geodesic_grid.hpp"
@@ -61,6 +65,8 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm) :
     CheckOrthonormalTetrad(pin, false);
   } else if (pgen_fun_name.compare("hohlraum") == 0) {
     Hohlraum(pin, false);
+  } else if (pgen_fun_name.compare("kernel_benchmark") == 0) {
+    KernelBenchmark(pin, false);
   } else if (pgen_fun_name.compare("linear_wave") == 0) {
     LinearWave(pin, false);
   } else if (pgen_fun_name.compare("implode") == 0) {
@@ -162,7 +168,7 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm, IOWrapper resf
     nmhd = pmhd->nmhd + pmhd->nscalars;
   }
   if (prad != nullptr) {
-    nrad = prad->prgeo->nangles;
+    nrad = prad->nrad;
   }
   if (pz4c != nullptr) {
     nz4c = pz4c->nz4c;
@@ -183,7 +189,7 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm, IOWrapper resf
   }
 #if MPI_PARALLEL_ENABLED
   // then broadcast the datasize information
-  MPI_Bcast(variabledata, variablesize, MPI_CHAR, 0, MPI_COMM_WORLD);
+  MPI_Bcast(variabledata, variablesize, MPI_CHAR, 0, global_variable::athena_comm);
 #endif
 
   IOWrapperSizeT data_size;
@@ -205,11 +211,51 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm, IOWrapper resf
 
 #if MPI_PARALLEL_ENABLED
     // then broadcast the RNG information
-    MPI_Bcast(rng_data, sizeof(RNG_State), MPI_CHAR, 0, MPI_COMM_WORLD);
+    MPI_Bcast(rng_data, sizeof(RNG_State), MPI_CHAR, 0, global_variable::athena_comm);
 #endif
     std::memcpy(&(pturb->rstate), &(rng_data[0]), sizeof(RNG_State));
   }
 
+  // delta restart files store gid in the last full restart file of each MB that is not
+  // stored in delta file (or -1 if it is), followed by offset of MB data in the full
+  // restart file and its name
+  bool rst_delta = false;
+  if (pin->DoesParameterExist("job", "restart_delta")) {
+    rst_delta = (pin->GetInteger("job", "restart_delta") == 1);
+  }
+  std::vector<int> base_gid;
+  IOWrapperSizeT base_offset = 0;
+  std::string base_fname;
+  if (rst_delta) {
+    base_gid.resize(pm->nmb_total);
+    int nchar = 0;
+    if (global_variable::my_rank == 0) {
+      bool ok = (resfile.Read_bytes(base_gid.data(), sizeof(int), pm->nmb_total) ==
+                   static_cast<std::size_t>(pm->nmb_total) &&
+                 resfile.Read_bytes(&base_offset, sizeof(IOWrapperSizeT), 1) == 1 &&
+                 resfile.Read_bytes(&nchar, sizeof(int), 1) == 1 && nchar > 0);
+      if (ok) {
+        base_fname.resize(nchar);
+        ok = (resfile.Read_bytes(&base_fname[0], 1, nchar) ==
+              static_cast<std::size_t>(nchar));
+      }
+      if (!ok) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "Index of delta restart file read incorrectly, "
+                  << "restart file is broken." << std::endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+#if MPI_PARALLEL_ENABLED
+    MPI_Bcast(base_gid.data(), pm->nmb_total, MPI_INT, 0, global_variable::athena_comm);
+    MPI_Bcast(&base_offset, sizeof(IOWrapperSizeT), MPI_CHAR, 0,
+              global_variable::athena_comm);
+    MPI_Bcast(&nchar, 1, MPI_INT, 0, global_variable::athena_comm);
+    base_fname.resize(nchar);
+    MPI_Bcast(&base_fname[0], nchar, MPI_CHAR, 0, global_variable::athena_comm);
+#endif
+  }
+
   IOWrapperSizeT headeroffset;
   // master process gets file offset
   if (global_variable::my_rank == 0) {
@@ -217,7 +263,8 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm, IOWrapper resf
   }
 #if MPI_PARALLEL_ENABLED
   // then broadcasts it
-  MPI_Bcast(&headeroffset, sizeof(IOWrapperSizeT), MPI_CHAR, 0, MPI_COMM_WORLD);
+  MPI_Bcast(&headeroffset, sizeof(IOWrapperSizeT), MPI_CHAR, 0,
+            global_variable::athena_comm);
 #endif
 
   IOWrapperSizeT data_size_ = 0;
@@ -242,6 +289,21 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm, IOWrapper resf
     data_size_ += nout1*nout2*nout3*nadm*sizeof(Real);   // adm u_adm
   }
 
+  // intensities may have been stored on a geodesic grid with a different number of
+  // angles, in which case they are remapped to the current grid below
+  int nrad_rst = nrad;
+  if (prad != nullptr && !(prad->is_m1) && data_size_ != data_size) {
+    IOWrapperSizeT rad_size = nout1*nout2*nout3*sizeof(Real);
+    IOWrapperSizeT other_size = data_size_ - nrad*rad_size;
+    if (data_size > other_size && (data_size - other_size) % rad_size == 0) {
+      int nang = static_cast<int>((data_size - other_size)/rad_size);
+      if (GeodesicGrid::NumLevels(nang) >= 0) {
+        nrad_rst = nang;
+        data_size_ = other_size + nrad_rst*rad_size;
+      }
+    }
+  }
+
   if (data_size_ != data_size) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
               << std::endl << "CC data size read from restart file not equal to size "
@@ -250,343 +312,228 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm, IOWrapper resf
     exit(EXIT_FAILURE);
   }
 
-  // read CC data into host array
+  // Data for all MBs on this rank is read into a host buffer with a few large reads, and
+  // then unpacked into each physics array.  Since MBs are stored in gid order and gids on
+  // each rank are contiguous, data for each rank occupies a single contiguous section of
+  // the restart file (or of the data files), which is read in chunks of whole MBs that
+  // satisfy the 2^31 byte limit of each MPI-IO call.
   int mygids = pm->gids_eachrank[global_variable::my_rank];
-  IOWrapperSizeT offset_myrank = headeroffset + data_size_*mygids;
-  IOWrapperSizeT myoffset = offset_myrank;
+  std::vector<char> rstbuf(data_size*nmb);
+
+  // Reads n MBs into buffer starting at MB m0, using nreads calls (which must be the same
+  // on all ranks for collective reads)
+  IOWrapperSizeT nmb_chunk = std::max(static_cast<IOWrapperSizeT>(1),
+                                      std::numeric_limits<int>::max()/data_size);
+  auto read_mbs = [&rstbuf, data_size, nmb_chunk](IOWrapper &file, int m0, int n,
+                                                  IOWrapperSizeT offset, int nreads,
+                                                  bool collective) {
+    for (int i=0; i<nreads; ++i) {
+      IOWrapperSizeT m = i*nmb_chunk;
+      IOWrapperSizeT cnt = (m < static_cast<IOWrapperSizeT>(n))?
+                           std::min(nmb_chunk, n-m) : 0;
+      char *ptr = rstbuf.data() + (m0 + std::min(m, static_cast<IOWrapperSizeT>(n)))*
+                                  data_size;
+      std::size_t nread = (collective)?
+            file.Read_bytes_at_all(ptr, data_size, cnt, offset + m*data_size) :
+            file.Read_bytes_at(ptr, data_size, cnt, offset + m*data_size);
+      if (nread != cnt) {return false;}
+    }
+    return true;
+  };
+
+  // If data was written to multiple files, restart file is an index containing the gid of
+  // the first MB in each data file, and the name of the data files.  Each rank reads the
+  // data for all of its MBs from only the data files that contain them (which need not
+  // be the files written by the same rank, since number of ranks can change on restart).
+  int nrst_files = 0;
+  if (pin->DoesParameterExist("job", "restart_nfiles")) {
+    nrst_files = pin->GetInteger("job", "restart_nfiles");
+  }
+  if (nrst_files > 0) {
+    std::string local_dir;
+    if (pin->DoesParameterExist("job", "restart_local_dir")) {
+      local_dir = pin->GetString("job", "restart_local_dir");
+    }
+    std::vector<int> gstart(nrst_files+1);
+    int nchar = 0;
+    std::string dname;
+    if (global_variable::my_rank == 0) {
+      int nfiles_idx = 0;
+      bool ok = (resfile.Read_bytes(&nfiles_idx, sizeof(int), 1) == 1 &&
+                 nfiles_idx == nrst_files &&
+                 resfile.Read_bytes(gstart.data(), sizeof(int), nrst_files+1) ==
+                   static_cast<std::size_t>(nrst_files+1) &&
+                 resfile.Read_bytes(&nchar, sizeof(int), 1) == 1 && nchar > 0);
+      if (ok) {
+        dname.resize(nchar);
+        ok = (resfile.Read_bytes(&dname[0], 1, nchar) == static_cast<std::size_t>(nchar));
+      }
+      if (!ok || gstart[nrst_files] != pm->nmb_total) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "Index of restart data files read incorrectly, "
+                  << "restart file is broken." << std::endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+#if MPI_PARALLEL_ENABLED
+    MPI_Bcast(gstart.data(), nrst_files+1, MPI_INT, 0, global_variable::athena_comm);
+    MPI_Bcast(&nchar, 1, MPI_INT, 0, global_variable::athena_comm);
+    dname.resize(nchar);
+    MPI_Bcast(&dname[0], nchar, MPI_CHAR, 0, global_variable::athena_comm);
+#endif
 
+    for (int f=0; f<nrst_files; ++f) {
+      int lo = std::max(mygids, gstart[f]);
+      int hi = std::min(mygids + nmb, gstart[f+1]);
+      if (lo >= hi) continue;
+      char part[8];
+      std::snprintf(part, sizeof(part), "p%05d", f);
+      std::string fname = dname + "." + part + ".rst";
+      // data files of two-tier restarts not yet copied to rst directory (e.g. if the run
+      // ended before the copy finished) are read from node-local directory
+      if (!(local_dir.empty())) {
+        std::FILE *pfile = std::fopen(fname.c_str(), "rb");
+        if (pfile == nullptr) {
+          fname = local_dir + "/" + fname;
+        } else {
+          std::fclose(pfile);
+        }
+      }
+      IOWrapper datafile;
+#if MPI_PARALLEL_ENABLED
+      datafile.SetCommunicator(MPI_COMM_SELF);
+#endif
+      datafile.Open(fname.c_str(), IOWrapper::FileMode::read);
+      int nreads = (hi - lo + nmb_chunk - 1)/nmb_chunk;
+      if (!read_mbs(datafile, lo-mygids, hi-lo, data_size*(lo-gstart[f]), nreads,
+                    false)) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "MeshBlock data not read correctly from '" << fname
+                  << "', restart file is broken." << std::endl;
+        exit(EXIT_FAILURE);
+      }
+      datafile.Close();
+    }
+  } else if (rst_delta) {
+    // MBs not in delta file are read from the full restart file
+    IOWrapper basefile;
+#if MPI_PARALLEL_ENABLED
+    basefile.SetCommunicator(MPI_COMM_SELF);
+#endif
+    basefile.Open(base_fname.c_str(), IOWrapper::FileMode::read);
+    int ndelta = 0;
+    for (int g=0; g<mygids; ++g) {
+      if (base_gid[g] < 0) {ndelta++;}
+    }
+    for (int m=0; m<nmb; ++m) {
+      int bgid = base_gid[mygids+m];
+      bool ok = (bgid < 0)?
+        read_mbs(resfile, m, 1, headeroffset + data_size*(ndelta++), 1, false) :
+        read_mbs(basefile, m, 1, base_offset + data_size*bgid, 1, false);
+      if (!ok) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "MeshBlock data not read correctly from delta restart "
+                  << "file or '" << base_fname << "', restart file is broken."
+                  << std::endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+    basefile.Close();
+  } else {
+    int noutmbs_max = pm->nmb_eachrank[0];
+    for (int i=0; i<(global_variable::nranks); ++i) {
+      noutmbs_max = std::max(noutmbs_max,pm->nmb_eachrank[i]);
+    }
+    int nreads = (noutmbs_max + nmb_chunk - 1)/nmb_chunk;
+    if (!read_mbs(resfile, 0, nmb, headeroffset + data_size*mygids, nreads, true)) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "MeshBlock data not read correctly from rst file, "
+                << "restart file is broken." << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  // copies cnt Reals per MB starting at byte pos of each MB in buffer into dst, then
+  // advances pos past the data
+  IOWrapperSizeT pos = 0;
+  auto unpack = [&rstbuf, &pos, data_size, nmb](Real *dst, std::size_t cnt) {
+    for (int m=0; m<nmb; ++m) {
+      std::memcpy(dst + m*cnt, &rstbuf[m*data_size + pos], cnt*sizeof(Real));
+    }
+    pos += cnt*sizeof(Real);
+  };
+  std::size_t ncells = nout1*nout2*nout3;
   HostArray5D<Real> ccin("rst-cc-in", 1, 1, 1, 1, 1);
   HostFaceFld4D<Real> fcin("rst-fc-in", 1, 1, 1, 1);
 
-  // calculate max/min number of MeshBlocks across all ranks
-  int noutmbs_max = pm->nmb_eachrank[0];
-  int noutmbs_min = pm->nmb_eachrank[0];
-  for (int i=0; i<(global_variable::nranks); ++i) {
-    noutmbs_max = std::max(noutmbs_max,pm->nmb_eachrank[i]);
-    noutmbs_min = std::min(noutmbs_min,pm->nmb_eachrank[i]);
-  }
-
   if (phydro != nullptr) {
     Kokkos::realloc(ccin, nmb, nhydro, nout3, nout2, nout1);
-    for (int m=0;  m<noutmbs_max; ++m) {
-      // every rank has a MB to read, so read collectively
-      if (m < noutmbs_min) {
-        // get ptr to cell-centered MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at_all(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC hydro data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-
-      // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
-        // get ptr to MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC hydro data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-      }
-    }
+    unpack(ccin.data(), nhydro*ncells);
     Kokkos::deep_copy(Kokkos::subview(phydro->u0, std::make_pair(0,nmb), Kokkos::ALL,
                       Kokkos::ALL, Kokkos::ALL, Kokkos::ALL), ccin);
-    offset_myrank += nout1*nout2*nout3*nhydro*sizeof(Real); // hydro u0
-    myoffset = offset_myrank;
   }
 
   if (pmhd != nullptr) {
     Kokkos::realloc(ccin, nmb, nmhd, nout3, nout2, nout1);
-    for (int m=0;  m<noutmbs_max; ++m) {
-      // every rank has a MB to read, so read collectively
-      if (m < noutmbs_min) {
-        // get ptr to cell-centered MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                   Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at_all(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC mhd data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-      // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
-        // get ptr to MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC mhd data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-      }
-    }
+    unpack(ccin.data(), nmhd*ncells);
     Kokkos::deep_copy(Kokkos::subview(pmhd->u0, std::make_pair(0,nmb), Kokkos::ALL,
                       Kokkos::ALL, Kokkos::ALL, Kokkos::ALL), ccin);
-    offset_myrank += nout1*nout2*nout3*nmhd*sizeof(Real);   // mhd u0
-    myoffset = offset_myrank;
 
     Kokkos::realloc(fcin.x1f, nmb, nout3, nout2, nout1+1);
     Kokkos::realloc(fcin.x2f, nmb, nout3, nout2+1, nout1);
     Kokkos::realloc(fcin.x3f, nmb, nout3+1, nout2, nout1);
-    // read FC data into host array, again one MeshBlock at a time
-    for (int m=0;  m<noutmbs_max; ++m) {
-      // every rank has a MB to write, so write collectively
-      if (m < noutmbs_min) {
-        // get ptr to x1-face field
-        auto x1fptr = Kokkos::subview(fcin.x1f, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
-        int fldcnt = x1fptr.size();
-
-        if (resfile.Read_Reals_at_all(x1fptr.data(), fldcnt, myoffset) != fldcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                << std::endl << "Input b0.x1f field not read correctly from rst file, "
-                << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += fldcnt*sizeof(Real);
-
-        // get ptr to x2-face field
-        auto x2fptr = Kokkos::subview(fcin.x2f, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
-        fldcnt = x2fptr.size();
-
-        if (resfile.Read_Reals_at_all(x2fptr.data(), fldcnt, myoffset) != fldcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                << std::endl << "Input b0.x2f field not read correctly from rst file, "
-                << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += fldcnt*sizeof(Real);
-
-        // get ptr to x3-face field
-        auto x3fptr = Kokkos::subview(fcin.x3f, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
-        fldcnt = x3fptr.size();
-
-        if (resfile.Read_Reals_at_all(x3fptr.data(), fldcnt, myoffset) != fldcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                << std::endl << "Input b0.x3f field not read correctly from rst file, "
-                << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += fldcnt*sizeof(Real);
-
-        myoffset += data_size-(x1fptr.size()+x2fptr.size()+x3fptr.size())*sizeof(Real);
-      } else if (m < pm->nmb_thisrank) {
-        // get ptr to x1-face field
-        auto x1fptr = Kokkos::subview(fcin.x1f, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
-        int fldcnt = x1fptr.size();
-
-        if (resfile.Read_Reals_at(x1fptr.data(), fldcnt, myoffset) != fldcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                << std::endl << "Input b0.x1f field not read correctly from rst file, "
-                << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += fldcnt*sizeof(Real);
-
-        // get ptr to x2-face field
-        auto x2fptr = Kokkos::subview(fcin.x2f, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
-        fldcnt = x2fptr.size();
-
-        if (resfile.Read_Reals_at(x2fptr.data(), fldcnt, myoffset) != fldcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                << std::endl << "Input b0.x2f field not read correctly from rst file, "
-                << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += fldcnt*sizeof(Real);
-
-        // get ptr to x3-face field
-        auto x3fptr = Kokkos::subview(fcin.x3f, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
-        fldcnt = x3fptr.size();
-
-        if (resfile.Read_Reals_at(x3fptr.data(), fldcnt, myoffset) != fldcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                << std::endl << "Input b0.x3f field not read correctly from rst file, "
-                << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += fldcnt*sizeof(Real);
-
-        myoffset += data_size-(x1fptr.size()+x2fptr.size()+x3fptr.size())*sizeof(Real);
-      }
-    }
+    // face fields of each MB are stored consecutively (x1f, x2f, then x3f)
+    unpack(fcin.x1f.data(), (nout1+1)*nout2*nout3);
+    unpack(fcin.x2f.data(), nout1*(nout2+1)*nout3);
+    unpack(fcin.x3f.data(), nout1*nout2*(nout3+1));
     Kokkos::deep_copy(Kokkos::subview(pmhd->b0.x1f, std::make_pair(0,nmb), Kokkos::ALL,
                       Kokkos::ALL, Kokkos::ALL), fcin.x1f);
     Kokkos::deep_copy(Kokkos::subview(pmhd->b0.x2f, std::make_pair(0,nmb), Kokkos::ALL,
                       Kokkos::ALL, Kokkos::ALL), fcin.x2f);
     Kokkos::deep_copy(Kokkos::subview(pmhd->b0.x3f, std::make_pair(0,nmb), Kokkos::ALL,
                       Kokkos::ALL, Kokkos::ALL), fcin.x3f);
-    offset_myrank += (nout1+1)*nout2*nout3*sizeof(Real);    // mhd b0.x1f
-    offset_myrank += nout1*(nout2+1)*nout3*sizeof(Real);    // mhd b0.x2f
-    offset_myrank += nout1*nout2*(nout3+1)*sizeof(Real);    // mhd b0.x3f
-    myoffset = offset_myrank;
   }
 
-  if (prad != nullptr) {
+  if (prad != nullptr && nrad_rst != nrad) {
+    Kokkos::realloc(ccin, nmb, nrad_rst, nout3, nout2, nout1);
+    unpack(ccin.data(), nrad_rst*ncells);
+    prad->RemapAngles(ccin, GeodesicGrid::NumLevels(nrad_rst));
+  } else if (prad != nullptr) {
     Kokkos::realloc(ccin, nmb, nrad, nout3, nout2, nout1);
-    for (int m=0;  m<noutmbs_max; ++m) {
-      // every rank has a MB to read, so read collectively
-      if (m < noutmbs_min) {
-        // get ptr to cell-centered MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at_all(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC rad data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-
-      // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
-        // get ptr to MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC rad data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-      }
-    }
+    unpack(ccin.data(), nrad*ncells);
+#if RAD_MIXED_PRECISION_ENABLED
+    // restarts always store intensities as Real, convert on host before copy to device
+    auto i0_sub = Kokkos::subview(prad->i0, std::make_pair(0,nmb), Kokkos::ALL,
+                                  Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
+    auto i0_h = Kokkos::create_mirror_view(i0_sub);
+    Kokkos::deep_copy(i0_h, ccin);
+    Kokkos::deep_copy(i0_sub, i0_h);
+#else
     Kokkos::deep_copy(Kokkos::subview(prad->i0, std::make_pair(0,nmb), Kokkos::ALL,
                       Kokkos::ALL, Kokkos::ALL, Kokkos::ALL), ccin);
-    offset_myrank += nout1*nout2*nout3*nrad*sizeof(Real);   // radiation i0
-    myoffset = offset_myrank;
+#endif
   }
 
   if (pturb != nullptr) {
     Kokkos::realloc(ccin, nmb, nforce, nout3, nout2, nout1);
-    for (int m=0;  m<noutmbs_max; ++m) {
-      // every rank has a MB to read, so read collectively
-      if (m < noutmbs_min) {
-        // get ptr to cell-centered MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at_all(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC turb data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-
-      // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
-        // get ptr to MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC turb data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-      }
-    }
+    unpack(ccin.data(), nforce*ncells);
     Kokkos::deep_copy(Kokkos::subview(pturb->force, std::make_pair(0,nmb), Kokkos::ALL,
                       Kokkos::ALL, Kokkos::ALL, Kokkos::ALL), ccin);
-    offset_myrank += nout1*nout2*nout3*nforce*sizeof(Real); // forcing
-    myoffset = offset_myrank;
   }
 
   if (pz4c != nullptr) {
     Kokkos::realloc(ccin, nmb, nz4c, nout3, nout2, nout1);
-    for (int m=0;  m<noutmbs_max; ++m) {
-      // every rank has a MB to read, so read collectively
-      if (m < noutmbs_min) {
-        // get ptr to cell-centered MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at_all(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC z4c data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-
-      // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
-        // get ptr to MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC z4c data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-      }
-    }
+    unpack(ccin.data(), nz4c*ncells);
     Kokkos::deep_copy(Kokkos::subview(pz4c->u0, std::make_pair(0,nmb), Kokkos::ALL,
                       Kokkos::ALL, Kokkos::ALL, Kokkos::ALL), ccin);
-    offset_myrank += nout1*nout2*nout3*nz4c*sizeof(Real);   // z4c u0
-    myoffset = offset_myrank;
 
     // We also need to reinitialize the ADM data.
     pz4c->Z4cToADM(pmy_mesh_->pmb_pack);
   } else if (padm != nullptr) {
     Kokkos::realloc(ccin, nmb, nadm, nout3, nout2, nout1);
-    for (int m=0;  m<noutmbs_max; ++m) {
-      // every rank has a MB to read, so read collectively
-      if (m < noutmbs_min) {
-        // get ptr to cell-centered MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at_all(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC adm data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-
-      // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
-        // get ptr to MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC adm data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-      }
-    }
+    unpack(ccin.data(), nadm*ncells);
     Kokkos::deep_copy(Kokkos::subview(padm->u_adm, std::make_pair(0,nmb), Kokkos::ALL,
                       Kokkos::ALL, Kokkos::ALL, Kokkos::ALL), ccin);
-    offset_myrank += nout1*nout2*nout3*nadm*sizeof(Real);   // adm u_adm
-    myoffset = offset_myrank;
   }
 
   // call problem generator again to re-initialize data, fn ptrs, as needed
@@ -605,6 +552,8 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm, IOWrapper resf
     CheckOrthonormalTetrad(pin, true);
   } else if (pgen_fun_name.compare("hohlraum") == 0) {
     Hohlraum(pin, true);
+  } else if (pgen_fun_name.compare("kernel_benchmark") == 0) {
+    KernelBenchmark(pin, true);
   } else if (pgen_fun_name.compare("linear_wave") == 0) {
     LinearWave(pin, true);
   } else if (pgen_fun_name.compare("implode") == 0) {
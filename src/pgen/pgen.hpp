@@ -14,6 +14,7 @@
 
 #include "geodesic-grid/spherical_grid.hpp"
 #include "parameter_input.hpp"
+#include "pgen/user_hooks.hpp"
 
 using ProblemFinalizeFnPtr = void (*)(ParameterInput *pin, Mesh *pm);
 using UserBoundaryFnPtr = void (*)(Mesh* pm);
@@ -53,12 +54,20 @@ class ProblemGenerator {
   UserRefinementFnPtr user_ref_func=nullptr;
   UserHistoryFnPtr user_hist_func=nullptr;
 
+  // device functors inlined into kernels of the core code, selected at compile time (see
+  // user_hooks.hpp).  Parameters of each hook can be set in UserProblem().
+  user_hooks::SrcTerm user_srcs_hook;
+  user_hooks::RefinementCondition user_ref_hook;
+  user_hooks::HistoryTerms user_hist_hook;
+  user_hooks::BoundaryCondition user_bcs_hook;
+
   // predefined problem generator functions (default test suite)
   void Advection(ParameterInput *pin, const bool restart);
   void AlfvenWave(ParameterInput *pin, const bool restart);
   void BondiAccretion(ParameterInput *pin, const bool restart);
   void CheckOrthonormalTetrad(ParameterInput *pin, const bool restart);
   void Hohlraum(ParameterInput *pin, const bool restart);
+  void KernelBenchmark(ParameterInput *pin, const bool restart);
   void LinearWave(ParameterInput *pin, const bool restart);
   void LWImplode(ParameterInput *pin, const bool restart);
   void Monopole(ParameterInput *pin, const bool restart);
@@ -149,7 +149,7 @@ void ZeroIntensity(Mesh *pm) {
 
   // Determine if radiation is enabled
   bool is_radiation_enabled_ = (pm->pmb_pack->prad != nullptr) ? true : false;
-  DvceArray5D<Real> i0_; int nang1;
+  DvceArray5D<RadReal> i0_; int nang1;
   if (is_radiation_enabled_) {
     i0_ = pm->pmb_pack->prad->i0;
     nang1 = pm->pmb_pack->prad->prgeo->nangles - 1;
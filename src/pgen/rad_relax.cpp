@@ -40,7 +40,6 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
   auto &size = pmbp->pmb->mb_size;
   auto &coord = pmbp->pcoord->coord_data;
   int nmb1 = (pmbp->nmb_thispack-1);
-  int nang1 = (pmbp->prad->prgeo->nangles-1);
 
   // get problem parameters
   Real erad = pin->GetReal("problem", "erad");
@@ -63,12 +62,25 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
   auto &u0 = pmbp->phydro->u0;
   pmbp->phydro->peos->PrimToCons(w0, u0, 0, (n1-1), 0, (n2-1), 0, (n3-1));
 
+  // with M1, set lab frame moments of radiation which is isotropic in fluid frame
+  auto &i0 = pmbp->prad->i0;
+  if (pmbp->prad->is_m1) {
+    par_for("rad_relax_m1",DevExeSpace(),0,nmb1,0,(n3-1),0,(n2-1),0,(n1-1),
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      i0(m,IRE, k,j,i) = erad*(4.0*SQR(lf) - 1.0)/3.0;
+      i0(m,IRF1,k,j,i) = 4.0/3.0*erad*SQR(lf)*v1;
+      i0(m,IRF2,k,j,i) = 0.0;
+      i0(m,IRF3,k,j,i) = 0.0;
+    });
+    return;
+  }
+
+  int nang1 = (pmbp->prad->prgeo->nangles-1);
   auto &norm_to_tet_ = pmbp->prad->norm_to_tet;
   auto &nh_c_ = pmbp->prad->nh_c;
   auto &tet_c_ = pmbp->prad->tet_c;
   auto &tetcov_c_ = pmbp->prad->tetcov_c;
 
-  auto &i0 = pmbp->prad->i0;
   par_for("rad_relax",DevExeSpace(),0,nmb1,0,(n3-1),0,(n2-1),0,(n1-1),
   KOKKOS_LAMBDA(int m, int k, int j, int i) {
     // Compute fluid velocity in tetrad frame
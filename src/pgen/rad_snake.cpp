@@ -35,6 +35,12 @@ void ComputeSnakeMetricAndTetrad(Real x, Real y, Real z,
 
 void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
   MeshBlockPack *pmbp = pmy_mesh_->pmb_pack;
+  if (pmbp->prad->na_on_the_fly) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Snake metric requires stored tetrad, set <radiation>/na_on_the_fly "
+              << "= false" << std::endl;
+    exit(EXIT_FAILURE);
+  }
 
   // capture variables for kernel
   auto &indcs = pmy_mesh_->mb_indcs;
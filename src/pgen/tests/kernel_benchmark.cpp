@@ -0,0 +1,424 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file kernel_benchmark.cpp
+//! \brief Problem generator for micro-benchmarks of the core kernels.  Initializes a
+//! smooth state in every physics module in the input file.  Then, in Driver::Finalize(),
+//! times repeated calls of the flux kernels (with every Riemann solver compatible with
+//! the EOS and coordinates), conservative-to-primitive conversion, ghost zone exchange,
+//! and prolongation (with SMR/AMR) of each module.  Results are written to the file
+//! "basename.bench.json" for regression tracking.  Use with nlim=0, so that the state is
+//! not evolved, and vary the block and pack sizes from the command line (see
+//! tst/run_benchmarks.py).
+
+#include <cmath>
+#include <cstdio>     // fopen(), fprintf()
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "coordinates/cell_locations.hpp"
+#include "coordinates/coordinates.hpp"
+#include "mesh/mesh.hpp"
+#include "bvals/bvals.hpp"
+#include "eos/eos.hpp"
+#include "hydro/hydro.hpp"
+#include "mhd/mhd.hpp"
+#include "radiation/radiation.hpp"
+#include "z4c/z4c.hpp"
+#include "driver/driver.hpp"
+#include "pgen/pgen.hpp"
+
+// function to run benchmarks at end of run
+void KernelBenchmarks(ParameterInput *pin, Mesh *pm);
+
+namespace {
+int nwarm, nrepeat;    // number of untimed and timed calls of each kernel
+
+//----------------------------------------------------------------------------------------
+//! \fn double TimeKernel()
+//! \brief Returns wall-clock time (s) per call of function f, averaged over nrepeat calls
+//! made after nwarm untimed calls.  The device is fenced before and after timing.
+
+template <typename F>
+double TimeKernel(F f) {
+  for (int n=0; n<nwarm; ++n) {f();}
+  Kokkos::fence();
+  Kokkos::Timer timer;
+  for (int n=0; n<nrepeat; ++n) {f();}
+  Kokkos::fence();
+  return timer.seconds()/static_cast<double>(nrepeat);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void HydroFluxes()
+//! \brief Calls Hydro::CalculateFluxes templated on given Riemann solver
+
+void HydroFluxes(hydro::Hydro *phyd, Driver *pdrive, Hydro_RSolver rs) {
+  if (rs == Hydro_RSolver::advect) {
+    phyd->CalculateFluxes<Hydro_RSolver::advect>(pdrive, 1);
+  } else if (rs == Hydro_RSolver::llf) {
+    phyd->CalculateFluxes<Hydro_RSolver::llf>(pdrive, 1);
+  } else if (rs == Hydro_RSolver::hlle) {
+    phyd->CalculateFluxes<Hydro_RSolver::hlle>(pdrive, 1);
+  } else if (rs == Hydro_RSolver::hllc) {
+    phyd->CalculateFluxes<Hydro_RSolver::hllc>(pdrive, 1);
+  } else if (rs == Hydro_RSolver::roe) {
+    phyd->CalculateFluxes<Hydro_RSolver::roe>(pdrive, 1);
+  } else if (rs == Hydro_RSolver::llf_sr) {
+    phyd->CalculateFluxes<Hydro_RSolver::llf_sr>(pdrive, 1);
+  } else if (rs == Hydro_RSolver::hlle_sr) {
+    phyd->CalculateFluxes<Hydro_RSolver::hlle_sr>(pdrive, 1);
+  } else if (rs == Hydro_RSolver::hllc_sr) {
+    phyd->CalculateFluxes<Hydro_RSolver::hllc_sr>(pdrive, 1);
+  } else if (rs == Hydro_RSolver::llf_gr) {
+    phyd->CalculateFluxes<Hydro_RSolver::llf_gr>(pdrive, 1);
+  } else if (rs == Hydro_RSolver::hlle_gr) {
+    phyd->CalculateFluxes<Hydro_RSolver::hlle_gr>(pdrive, 1);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MHDFluxes()
+//! \brief Calls MHD::CalculateFluxes templated on given Riemann solver
+
+void MHDFluxes(mhd::MHD *pmhd, Driver *pdrive, MHD_RSolver rs) {
+  if (rs == MHD_RSolver::advect) {
+    pmhd->CalculateFluxes<MHD_RSolver::advect>(pdrive, 1);
+  } else if (rs == MHD_RSolver::llf) {
+    pmhd->CalculateFluxes<MHD_RSolver::llf>(pdrive, 1);
+  } else if (rs == MHD_RSolver::hlle) {
+    pmhd->CalculateFluxes<MHD_RSolver::hlle>(pdrive, 1);
+  } else if (rs == MHD_RSolver::hlld) {
+    pmhd->CalculateFluxes<MHD_RSolver::hlld>(pdrive, 1);
+  } else if (rs == MHD_RSolver::llf_sr) {
+    pmhd->CalculateFluxes<MHD_RSolver::llf_sr>(pdrive, 1);
+  } else if (rs == MHD_RSolver::hlle_sr) {
+    pmhd->CalculateFluxes<MHD_RSolver::hlle_sr>(pdrive, 1);
+  } else if (rs == MHD_RSolver::llf_gr) {
+    pmhd->CalculateFluxes<MHD_RSolver::llf_gr>(pdrive, 1);
+  } else if (rs == MHD_RSolver::hlle_gr) {
+    pmhd->CalculateFluxes<MHD_RSolver::hlle_gr>(pdrive, 1);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ExchangeCC()
+//! \brief Complete exchange of ghost zones of CC variables: posts receives, packs and
+//! sends buffers, polls receives until all have been unpacked, and clears requests
+
+template <typename T>
+void ExchangeCC(MeshBoundaryValuesCC *pbval, DvceArray5D<T> &a, DvceArray5D<T> &ca) {
+  pbval->InitRecv(a.extent_int(1));
+  pbval->PackAndSendCC(a, ca);
+  while (pbval->RecvAndUnpackCC(a, ca) == TaskStatus::incomplete) {}
+  pbval->ClearSend();
+  pbval->ClearRecv();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ExchangeFC()
+//! \brief Complete exchange of ghost zones of face-centered fields
+
+void ExchangeFC(MeshBoundaryValuesFC *pbval, DvceFaceFld4D<Real> &b,
+                DvceFaceFld4D<Real> &cb) {
+  pbval->InitRecv(3);
+  pbval->PackAndSendFC(b, cb);
+  while (pbval->RecvAndUnpackFC(b, cb) == TaskStatus::incomplete) {}
+  pbval->ClearSend();
+  pbval->ClearRecv();
+  return;
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void ProblemGenerator::KernelBenchmark()
+//! \brief Sets smooth initial conditions: a sinusoidal density perturbation in a uniform
+//! flow (and uniform field for MHD), flat spacetime for Z4c, and isotropic intensities
+//! for radiation.  Benchmarks are run by KernelBenchmarks() in Driver::Finalize().
+
+void ProblemGenerator::KernelBenchmark(ParameterInput *pin, const bool restart) {
+  pgen_final_func = KernelBenchmarks;
+  if (restart) return;
+
+  MeshBlockPack *pmbp = pmy_mesh_->pmb_pack;
+  if ((pmbp->phydro != nullptr || pmbp->pmhd != nullptr) &&
+      pmbp->pcoord->is_dynamical_relativistic) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Kernel benchmarks cannot be run with dynamical GR fluids" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  Real amp = pin->GetOrAddReal("problem", "amp", 0.1);
+  Real vel = pin->GetOrAddReal("problem", "vel", 0.1);
+
+  // capture variables for kernel
+  auto &indcs = pmy_mesh_->mb_indcs;
+  int &is = indcs.is; int &ie = indcs.ie;
+  int &js = indcs.js; int &je = indcs.je;
+  int &ks = indcs.ks; int &ke = indcs.ke;
+  auto &size = pmbp->pmb->mb_size;
+  int nmb = pmbp->nmb_thispack;
+  Real lx1 = pmy_mesh_->mesh_size.x1max - pmy_mesh_->mesh_size.x1min;
+
+  // initialize Hydro variables ----------------------------------------------------------
+  if (pmbp->phydro != nullptr) {
+    EOS_Data &eos = pmbp->phydro->peos->eos_data;
+    auto &w0 = pmbp->phydro->w0;
+    int nhyd = pmbp->phydro->nhydro;
+    int nvar = nhyd + pmbp->phydro->nscalars;
+    par_for("pgen_bench1",DevExeSpace(),0,(nmb-1),ks,ke,js,je,is,ie,
+    KOKKOS_LAMBDA(int m,int k,int j,int i) {
+      Real &x1min = size.d_view(m).x1min;
+      Real &x1max = size.d_view(m).x1max;
+      Real x1v = CellCenterX(i-is, indcs.nx1, x1min, x1max);
+      Real dens = 1.0 + amp*sin(2.0*M_PI*x1v/lx1);
+      w0(m,IDN,k,j,i) = dens;
+      w0(m,IVX,k,j,i) = vel;
+      w0(m,IVY,k,j,i) = 0.5*vel;
+      w0(m,IVZ,k,j,i) = 0.25*vel;
+      if (eos.is_ideal) {w0(m,IEN,k,j,i) = 1.0/(eos.gamma*(eos.gamma - 1.0));}
+      for (int n=nhyd; n<nvar; ++n) {w0(m,n,k,j,i) = dens;}
+    });
+    pmbp->phydro->peos->PrimToCons(w0, pmbp->phydro->u0, is, ie, js, je, ks, ke);
+  }
+
+  // initialize MHD variables ------------------------------------------------------------
+  if (pmbp->pmhd != nullptr) {
+    EOS_Data &eos = pmbp->pmhd->peos->eos_data;
+    auto &w0 = pmbp->pmhd->w0;
+    auto &b0 = pmbp->pmhd->b0;
+    auto &bcc0 = pmbp->pmhd->bcc0;
+    int nmhd = pmbp->pmhd->nmhd;
+    int nvar = nmhd + pmbp->pmhd->nscalars;
+    par_for("pgen_bench2",DevExeSpace(),0,(nmb-1),ks,ke,js,je,is,ie,
+    KOKKOS_LAMBDA(int m,int k,int j,int i) {
+      Real &x1min = size.d_view(m).x1min;
+      Real &x1max = size.d_view(m).x1max;
+      Real x1v = CellCenterX(i-is, indcs.nx1, x1min, x1max);
+      Real dens = 1.0 + amp*sin(2.0*M_PI*x1v/lx1);
+      w0(m,IDN,k,j,i) = dens;
+      w0(m,IVX,k,j,i) = vel;
+      w0(m,IVY,k,j,i) = 0.5*vel;
+      w0(m,IVZ,k,j,i) = 0.25*vel;
+      if (eos.is_ideal) {w0(m,IEN,k,j,i) = 1.0/(eos.gamma*(eos.gamma - 1.0));}
+      for (int n=nmhd; n<nvar; ++n) {w0(m,n,k,j,i) = dens;}
+
+      // uniform field, so face- and cell-centered values are equal
+      b0.x1f(m,k,j,i) = 1.0;
+      b0.x2f(m,k,j,i) = 0.5;
+      b0.x3f(m,k,j,i) = 0.25;
+      if (i==ie) {b0.x1f(m,k,j,i+1) = 1.0;}
+      if (j==je) {b0.x2f(m,k,j+1,i) = 0.5;}
+      if (k==ke) {b0.x3f(m,k+1,j,i) = 0.25;}
+      bcc0(m,IBX,k,j,i) = 1.0;
+      bcc0(m,IBY,k,j,i) = 0.5;
+      bcc0(m,IBZ,k,j,i) = 0.25;
+    });
+    pmbp->pmhd->peos->PrimToCons(w0, bcc0, pmbp->pmhd->u0, is, ie, js, je, ks, ke);
+  }
+
+  // initialize Z4c variables to flat spacetime (unit lapse and metric) ------------------
+  if (pmbp->pz4c != nullptr) {
+    auto &u0 = pmbp->pz4c->u0;
+    int n1m1 = indcs.nx1 + 2*indcs.ng - 1;
+    int n2m1 = (indcs.nx2 > 1)? (indcs.nx2 + 2*indcs.ng - 1) : 0;
+    int n3m1 = (indcs.nx3 > 1)? (indcs.nx3 + 2*indcs.ng - 1) : 0;
+    Kokkos::deep_copy(DevExeSpace(), u0, 0.0);
+    par_for("pgen_bench3",DevExeSpace(),0,(nmb-1),0,n3m1,0,n2m1,0,n1m1,
+    KOKKOS_LAMBDA(int m,int k,int j,int i) {
+      u0(m,z4c::Z4c::I_Z4C_CHI,k,j,i) = 1.0;
+      u0(m,z4c::Z4c::I_Z4C_GXX,k,j,i) = 1.0;
+      u0(m,z4c::Z4c::I_Z4C_GYY,k,j,i) = 1.0;
+      u0(m,z4c::Z4c::I_Z4C_GZZ,k,j,i) = 1.0;
+      u0(m,z4c::Z4c::I_Z4C_ALPHA,k,j,i) = 1.0;
+    });
+  }
+
+  // initialize radiation intensities to be isotropic ------------------------------------
+  if (pmbp->prad != nullptr) {
+    Kokkos::deep_copy(DevExeSpace(), pmbp->prad->i0, 1.0);
+  }
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void KernelBenchmarks()
+//! \brief Times kernels of every physics module, and writes time per call (maximum over
+//! ranks) and cell updates per second to "basename.bench.json".  A Driver is constructed
+//! only to provide the weights of the first stage of the integrator to the kernels.
+
+void KernelBenchmarks(ParameterInput *pin, Mesh *pm) {
+  nwarm = pin->GetOrAddInteger("problem", "nwarm", 2);
+  nrepeat = pin->GetOrAddInteger("problem", "nrepeat", 10);
+  if (nrepeat < 1) {nrepeat = 1;}
+  Driver bench_driver(pin, pm, -1.0, nullptr);
+  Driver *pdrive = &bench_driver;
+
+  MeshBlockPack *pmbp = pm->pmb_pack;
+  auto &indcs = pm->mb_indcs;
+  int n1m1 = indcs.nx1 + 2*indcs.ng - 1;
+  int n2m1 = (indcs.nx2 > 1)? (indcs.nx2 + 2*indcs.ng - 1) : 0;
+  int n3m1 = (indcs.nx3 > 1)? (indcs.nx3 + 2*indcs.ng - 1) : 0;
+  bool sr = pmbp->pcoord->is_special_relativistic;
+  bool gr = pmbp->pcoord->is_general_relativistic;
+  std::vector<std::pair<std::string, double>> results;
+
+  // Hydro kernels
+  if (pmbp->phydro != nullptr) {
+    hydro::Hydro *phyd = pmbp->phydro;
+    std::vector<std::pair<std::string, Hydro_RSolver>> rsolvers;
+    if (sr) {
+      rsolvers.push_back({"llf_sr", Hydro_RSolver::llf_sr});
+      rsolvers.push_back({"hlle_sr", Hydro_RSolver::hlle_sr});
+      rsolvers.push_back({"hllc_sr", Hydro_RSolver::hllc_sr});
+    } else if (gr) {
+      rsolvers.push_back({"llf_gr", Hydro_RSolver::llf_gr});
+      rsolvers.push_back({"hlle_gr", Hydro_RSolver::hlle_gr});
+    } else if (phyd->rsolver_method == Hydro_RSolver::advect) {
+      rsolvers.push_back({"advect", Hydro_RSolver::advect});
+    } else {
+      rsolvers.push_back({"llf", Hydro_RSolver::llf});
+      rsolvers.push_back({"hlle", Hydro_RSolver::hlle});
+      rsolvers.push_back({"roe", Hydro_RSolver::roe});
+      if (phyd->peos->eos_data.is_ideal) {
+        rsolvers.push_back({"hllc", Hydro_RSolver::hllc});
+      }
+    }
+    for (auto &rs : rsolvers) {
+      double t = TimeKernel([&]() {HydroFluxes(phyd, pdrive, rs.second);});
+      results.push_back({"hydro/fluxes/" + rs.first, t});
+    }
+    double t = TimeKernel([&]() {
+      phyd->peos->ConsToPrim(phyd->u0, phyd->w0, false, 0, n1m1, 0, n2m1, 0, n3m1);
+    });
+    results.push_back({"hydro/cons_to_prim", t});
+    t = TimeKernel([&]() {ExchangeCC(phyd->pbval_u, phyd->u0, phyd->coarse_u0);});
+    results.push_back({"hydro/exchange_cc", t});
+    if (pm->multilevel) {
+      t = TimeKernel([&]() {phyd->pbval_u->ProlongateCC(phyd->u0, phyd->coarse_u0);});
+      results.push_back({"hydro/prolongate_cc", t});
+    }
+  }
+
+  // MHD kernels
+  if (pmbp->pmhd != nullptr) {
+    mhd::MHD *pmhd = pmbp->pmhd;
+    std::vector<std::pair<std::string, MHD_RSolver>> rsolvers;
+    if (sr) {
+      rsolvers.push_back({"llf_sr", MHD_RSolver::llf_sr});
+      rsolvers.push_back({"hlle_sr", MHD_RSolver::hlle_sr});
+    } else if (gr) {
+      rsolvers.push_back({"llf_gr", MHD_RSolver::llf_gr});
+      rsolvers.push_back({"hlle_gr", MHD_RSolver::hlle_gr});
+    } else if (pmhd->rsolver_method == MHD_RSolver::advect) {
+      rsolvers.push_back({"advect", MHD_RSolver::advect});
+    } else {
+      rsolvers.push_back({"llf", MHD_RSolver::llf});
+      rsolvers.push_back({"hlle", MHD_RSolver::hlle});
+      rsolvers.push_back({"hlld", MHD_RSolver::hlld});
+    }
+    for (auto &rs : rsolvers) {
+      double t = TimeKernel([&]() {MHDFluxes(pmhd, pdrive, rs.second);});
+      results.push_back({"mhd/fluxes/" + rs.first, t});
+    }
+    double t = TimeKernel([&]() {
+      pmhd->peos->ConsToPrim(pmhd->u0, pmhd->b0, pmhd->w0, pmhd->bcc0, false,
+                             0, n1m1, 0, n2m1, 0, n3m1);
+    });
+    results.push_back({"mhd/cons_to_prim", t});
+    t = TimeKernel([&]() {ExchangeCC(pmhd->pbval_u, pmhd->u0, pmhd->coarse_u0);});
+    results.push_back({"mhd/exchange_cc", t});
+    t = TimeKernel([&]() {ExchangeFC(pmhd->pbval_b, pmhd->b0, pmhd->coarse_b0);});
+    results.push_back({"mhd/exchange_fc", t});
+    if (pm->multilevel) {
+      t = TimeKernel([&]() {pmhd->pbval_u->ProlongateCC(pmhd->u0, pmhd->coarse_u0);});
+      results.push_back({"mhd/prolongate_cc", t});
+      t = TimeKernel([&]() {pmhd->pbval_b->ProlongateFC(pmhd->b0, pmhd->coarse_b0);});
+      results.push_back({"mhd/prolongate_fc", t});
+    }
+  }
+
+  // Z4c kernels
+  if (pmbp->pz4c != nullptr) {
+    z4c::Z4c *pz4c = pmbp->pz4c;
+    double t = 0.0;
+    switch (indcs.ng) {
+      case 2: t = TimeKernel([&]() {pz4c->CalcRHS<2>(pdrive, 1);});
+              break;
+      case 3: t = TimeKernel([&]() {pz4c->CalcRHS<3>(pdrive, 1);});
+              break;
+      case 4: t = TimeKernel([&]() {pz4c->CalcRHS<4>(pdrive, 1);});
+              break;
+    }
+    results.push_back({"z4c/calc_rhs", t});
+    t = TimeKernel([&]() {ExchangeCC(pz4c->pbval_u, pz4c->u0, pz4c->coarse_u0);});
+    results.push_back({"z4c/exchange_cc", t});
+  }
+
+  // Radiation kernels
+  if (pmbp->prad != nullptr) {
+    double t = TimeKernel([&]() {pmbp->prad->CalculateFluxes(pdrive, 1);});
+    results.push_back({"radiation/fluxes", t});
+  }
+
+  // report maximum time over all ranks, since slowest rank limits performance
+  int nres = static_cast<int>(results.size());
+  std::vector<double> tmax(nres);
+  for (int n=0; n<nres; ++n) {tmax[n] = results[n].second;}
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, tmax.data(), nres, MPI_DOUBLE, MPI_MAX,
+                global_variable::athena_comm);
+#endif
+  if (global_variable::my_rank != 0) return;
+
+  // cells updated by each call of a kernel, summed over all ranks
+  double ncells = static_cast<double>(pm->nmb_total)*static_cast<double>(indcs.nx1)*
+                  static_cast<double>(indcs.nx2)*static_cast<double>(indcs.nx3);
+  std::string fname;
+  fname.assign(pin->GetString("job","basename"));
+  fname.append(".bench.json");
+  FILE *pfile;
+  if ((pfile = std::fopen(fname.c_str(), "w")) == nullptr) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Benchmark output file could not be opened" <<std::endl;
+    exit(EXIT_FAILURE);
+  }
+  std::fprintf(pfile, "{\n");
+  std::fprintf(pfile, "  \"exec_space\": \"%s\",\n", DevExeSpace::name());
+  std::fprintf(pfile, "  \"sizeof_real\": %d,\n", static_cast<int>(sizeof(Real)));
+  std::fprintf(pfile, "  \"nranks\": %d,\n", global_variable::nranks);
+  std::fprintf(pfile, "  \"nmb_total\": %d,\n", pm->nmb_total);
+  std::fprintf(pfile, "  \"nmb_thispack\": %d,\n", pmbp->nmb_thispack);
+  std::fprintf(pfile, "  \"meshblock\": [%d, %d, %d],\n", indcs.nx1, indcs.nx2,
+               indcs.nx3);
+  std::fprintf(pfile, "  \"nghost\": %d,\n", indcs.ng);
+  std::fprintf(pfile, "  \"nrepeat\": %d,\n", nrepeat);
+  std::fprintf(pfile, "  \"kernels\": [\n");
+  for (int n=0; n<nres; ++n) {
+    std::fprintf(pfile, "    {\"name\": \"%s\", \"time_per_call\": %.6e, ",
+                 results[n].first.c_str(), tmax[n]);
+    std::fprintf(pfile, "\"cell_updates_per_sec\": %.6e}%s\n", ncells/tmax[n],
+                 (n < nres-1)? "," : "");
+  }
+  std::fprintf(pfile, "  ]\n}\n");
+  std::fclose(pfile);
+
+  std::cout << std::endl << "Kernel benchmarks (s per call, max over ranks):"
+            << std::endl;
+  for (int n=0; n<nres; ++n) {
+    std::printf("  %-32s %12.5e\n", results[n].first.c_str(), tmax[n]);
+  }
+  return;
+}
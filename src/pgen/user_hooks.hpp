@@ -0,0 +1,105 @@
+#ifndef PGEN_USER_HOOKS_HPP_
+#define PGEN_USER_HOOKS_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file user_hooks.hpp
+//! \brief device functors ("hooks") for user source terms, refinement conditions, history
+//! variables, and BCs, which are inlined into the corresponding kernels of the core code,
+//! so that they cost no extra kernel launches or sweeps through memory.  They are an
+//! alternative to the user function pointers in ProblemGenerator, which launch their own
+//! kernels.
+//!
+//! Hooks are selected at compile time with '-D USER_HOOKS=file', where file.hpp is a
+//! header in src/pgen that defines any of the macros USER_SRCTERM_HOOK,
+//! USER_REFINEMENT_HOOK, USER_HISTORY_HOOK, USER_BOUNDARY_HOOK as the name of a class
+//! with the same interface as the corresponding default class below (which does nothing,
+//! and generates no code).  Each hook is a member of the ProblemGenerator, so its
+//! parameters can be set in UserProblem().  Its Update() function is called (on the host)
+//! before every kernel using it, and can be used to store the current Views it reads,
+//! since these are reallocated by AMR.  Since this header is included before the Mesh
+//! class is defined, Update() must be defined in the problem generator file.
+//!
+//! The hooks are used in:
+//!  - SrcTerm: RK update of Hydro and MHD.  Returns the time derivative of conserved
+//!    variable n, which must be computed from the primitives (as for user_srcs_func).
+//!  - RefinementCondition: the kernel evaluating refinement conditions of each MB.
+//!    Returns +1 if the MB containing the cell should be refined, -1 if the cell allows
+//!    it to be derefined, and 0 otherwise.  The maximum over all cells in the MB sets
+//!    its flag, taking precedence over the default conditions.
+//!  - HistoryTerms: reduction over cells of the Hydro (or else MHD) history variables.
+//!    Adds the contributions of a cell to nhist variables appended to those of Hydro.
+//!  - BoundaryCondition: physical BCs of cell-centered variables (HydroBCs) at faces with
+//!    BoundaryFlag::user.  Sets ghost cell (m,n,k,j,i) of the array a at the given face.
+
+#include <string>
+
+#include "athena.hpp"
+
+class Mesh;
+
+namespace user_hooks {
+
+struct NoSrcTerm {
+  static constexpr bool enabled = false;
+  void Update(Mesh *pm) {}
+  KOKKOS_INLINE_FUNCTION
+  Real operator()(const int m, const int n, const int k, const int j, const int i) const {
+    return 0.0;
+  }
+};
+
+struct NoRefinementCondition {
+  static constexpr bool enabled = false;
+  void Update(Mesh *pm) {}
+  KOKKOS_INLINE_FUNCTION
+  int operator()(const int m, const int k, const int j, const int i) const {return 0;}
+};
+
+struct NoHistoryTerms {
+  static constexpr bool enabled = false;
+  static constexpr int nhist = 0;
+  void Update(Mesh *pm) {}
+  std::string Label(const int n) const {return "";}
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int m, const int k, const int j, const int i, const Real vol,
+                  Real *h) const {}
+};
+
+struct NoBoundaryCondition {
+  static constexpr bool enabled = false;
+  void Update(Mesh *pm) {}
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int face, const DvceArray5D<Real> &a, const int m, const int n,
+                  const int k, const int j, const int i) const {}
+};
+
+} // namespace user_hooks
+
+#if USER_HOOKS_ENABLED
+#include USER_HOOKS_HEADER
+#endif
+
+#ifndef USER_SRCTERM_HOOK
+#define USER_SRCTERM_HOOK user_hooks::NoSrcTerm
+#endif
+#ifndef USER_REFINEMENT_HOOK
+#define USER_REFINEMENT_HOOK user_hooks::NoRefinementCondition
+#endif
+#ifndef USER_HISTORY_HOOK
+#define USER_HISTORY_HOOK user_hooks::NoHistoryTerms
+#endif
+#ifndef USER_BOUNDARY_HOOK
+#define USER_BOUNDARY_HOOK user_hooks::NoBoundaryCondition
+#endif
+
+namespace user_hooks {
+using SrcTerm = USER_SRCTERM_HOOK;
+using RefinementCondition = USER_REFINEMENT_HOOK;
+using HistoryTerms = USER_HISTORY_HOOK;
+using BoundaryCondition = USER_BOUNDARY_HOOK;
+} // namespace user_hooks
+
+#endif // PGEN_USER_HOOKS_HPP_
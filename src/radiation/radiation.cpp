@@ -21,6 +21,7 @@
 #include "geodesic-grid/geodesic_grid.hpp"
 #include "units/units.hpp"
 #include "radiation/radiation.hpp"
+#include "utils/managed_memory.hpp"
 
 namespace radiation {
 //----------------------------------------------------------------------------------------
@@ -41,7 +42,8 @@ Radiation::Radiation(MeshBlockPack *ppack, ParameterInput *pin) :
     tet_d3_x3f("tet_d3_x3f",1,1,1,1,1),
     na("na",1,1,1,1,1,1),
     norm_to_tet("norm_to_tet",1,1,1,1,1,1),
-    beam_mask("beam_mask",1,1,1,1,1) {
+    beam_mask("beam_mask",1,1,1,1,1),
+    m1_sigma("m1_sigma",1,1,1,1) {
   // Check for general relativity
   if (!(pmy_pack->pcoord->is_general_relativistic)) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
@@ -57,6 +59,15 @@ Radiation::Radiation(MeshBlockPack *ppack, ParameterInput *pin) :
     std::exit(EXIT_FAILURE);
   }
 
+  // Check for M1 closure, currently only implemented in flat spacetime
+  is_m1 = pin->GetOrAddBoolean("radiation","m1",false);
+  if (is_m1 && !(pmy_pack->pcoord->coord_data.is_minkowski)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+      << std::endl << "<radiation>/m1 = true requires <coord>/minkowski = true"
+      << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
   // Check for hydrodynamics, mhd, and units
   is_hydro_enabled = pin->DoesBlockExist("hydro");
   is_mhd_enabled = pin->DoesBlockExist("mhd");
@@ -99,7 +110,14 @@ Radiation::Radiation(MeshBlockPack *ppack, ParameterInput *pin) :
     } else {
       arad = pin->GetReal("radiation","arad");
     }
+    if (is_compton_enabled && is_m1) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+        << std::endl << "Compton is not implemented with <radiation>/m1 = true"
+        << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
     affect_fluid = pin->GetOrAddBoolean("radiation","affect_fluid",true);
+    team_source = pin->GetOrAddBoolean("radiation","team_source",false);
   }
 
   // Check for fluid evolution
@@ -107,14 +125,48 @@ Radiation::Radiation(MeshBlockPack *ppack, ParameterInput *pin) :
 
   // Other rad source terms (constructor parses input file to init only srcterms needed)
   beam_source = pin->GetOrAddBoolean("radiation","beam_source",false);
+  if (beam_source && is_m1) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+      << std::endl << "Beam source is not implemented with <radiation>/m1 = true"
+      << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
   psrc = new SourceTerms("radiation", ppack, pin);
 
-  // Setup angular mesh and radiation geometry data
-  int nlevel = pin->GetInteger("radiation", "nlevel");
-  rotate_geo = pin->GetOrAddBoolean("radiation","rotate_geo",true);
-  angular_fluxes = pin->GetOrAddBoolean("radiation","angular_fluxes",true);
-  n_0_floor = pin->GetOrAddReal("radiation","n_0_floor",0.1);
-  prgeo = new GeodesicGrid(nlevel, rotate_geo, angular_fluxes);
+  // determine if the explicit RK update of the intensities is applied cell by cell in
+  // the team-per-cell implicit source term kernel, so that i0 is read and written only
+  // once per stage.  Only possible when no other term changes i0 between the two.
+  fused_update = pin->GetOrAddBoolean("radiation","fused_update",false);
+  if (fused_update) {
+    if (is_m1 || !(rad_source) || !(team_source) || beam_source) {
+      std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<radiation>/fused_update requires rad_source and "
+                << "team_source, and cannot be used with M1 or beam source. "
+                << "Using unfused update and source term." << std::endl;
+      fused_update = false;
+    }
+  }
+
+  // Setup angular mesh and radiation geometry data (no angular mesh with M1)
+  if (is_m1) {
+    rotate_geo = false;
+    angular_fluxes = false;
+    angle_blocked = false;
+    na_on_the_fly = false;
+    n_0_floor = 0.0;
+    nrad = NRMOM;
+  } else {
+    int nlevel = pin->GetInteger("radiation", "nlevel");
+    rotate_geo = pin->GetOrAddBoolean("radiation","rotate_geo",true);
+    angular_fluxes = pin->GetOrAddBoolean("radiation","angular_fluxes",true);
+    angle_blocked = pin->GetOrAddBoolean("radiation","angle_blocked",false);
+    // recompute angular flux coefficients n^a (6 per angle per cell) from the tetrad
+    // in each kernel that uses them, instead of storing them
+    na_on_the_fly = pin->GetOrAddBoolean("radiation","na_on_the_fly",false);
+    n_0_floor = pin->GetOrAddReal("radiation","n_0_floor",0.1);
+    prgeo = new GeodesicGrid(nlevel, rotate_geo, angular_fluxes);
+    nrad = prgeo->nangles;
+  }
 
   int nmb = ppack->nmb_thispack;
   auto &indcs = pmy_pack->pmesh->mb_indcs;
@@ -122,16 +174,20 @@ Radiation::Radiation(MeshBlockPack *ppack, ParameterInput *pin) :
   int ncells1 = indcs.nx1 + 2*(indcs.ng);
   int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
   int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
-  Kokkos::realloc(nh_c,prgeo->nangles,4);
-  Kokkos::realloc(nh_f,prgeo->nangles,6,4);
-  Kokkos::realloc(tet_c,nmb,4,4,ncells3,ncells2,ncells1);
-  Kokkos::realloc(tetcov_c,nmb,4,4,ncells3,ncells2,ncells1);
+  if (!(is_m1)) {
+    Kokkos::realloc(nh_c,nrad,4);
+    Kokkos::realloc(nh_f,nrad,6,4);
+  }
+  ManagedMemory::Realloc(tet_c,nmb,4,4,ncells3,ncells2,ncells1);
+  ManagedMemory::Realloc(tetcov_c,nmb,4,4,ncells3,ncells2,ncells1);
   Kokkos::realloc(tet_d1_x1f,nmb,4,ncells3,ncells2,ncells1+1);
   Kokkos::realloc(tet_d2_x2f,nmb,4,ncells3,ncells2+1,ncells1);
   Kokkos::realloc(tet_d3_x3f,nmb,4,ncells3+1,ncells2,ncells1);
-  if (angular_fluxes) {Kokkos::realloc(na,nmb,prgeo->nangles,ncells3,ncells2,ncells1,6);}
+  if (angular_fluxes && !(na_on_the_fly)) {
+    Kokkos::realloc(na,nmb,nrad,ncells3,ncells2,ncells1,6);
+  }
   if (is_hydro_enabled || is_mhd_enabled) {
-    Kokkos::realloc(norm_to_tet,nmb,4,4,ncells3,ncells2,ncells1);
+    ManagedMemory::Realloc(norm_to_tet,nmb,4,4,ncells3,ncells2,ncells1);
   }
   }
   SetOrthonormalTetrad();
@@ -145,21 +201,25 @@ Radiation::Radiation(MeshBlockPack *ppack, ParameterInput *pin) :
   int ncells1 = indcs.nx1 + 2*(indcs.ng);
   int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
   int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
-  Kokkos::realloc(i0,nmb,prgeo->nangles,ncells3,ncells2,ncells1);
+  Kokkos::realloc(i0,nmb,nrad,ncells3,ncells2,ncells1);
   }
 
-  // allocate memory for conserved variables on coarse mesh
+  // allocate memory for conserved variables on coarse mesh (only for MBs with coarser
+  // neighbors when arrays are compacted with SMR)
   if (ppack->pmesh->multilevel) {
     auto &indcs = pmy_pack->pmesh->mb_indcs;
     int nccells1 = indcs.cnx1 + 2*(indcs.ng);
     int nccells2 = (indcs.cnx2 > 1)? (indcs.cnx2 + 2*(indcs.ng)) : 1;
     int nccells3 = (indcs.cnx3 > 1)? (indcs.cnx3 + 2*(indcs.ng)) : 1;
-    Kokkos::realloc(coarse_i0,nmb,prgeo->nangles,nccells3,nccells2,nccells1);
+    int ncmb = (pmy_pack->pmb->compact_coarse)? pmy_pack->pmb->nmb_coarse : nmb;
+    Kokkos::realloc(coarse_i0,ncmb,nrad,nccells3,nccells2,nccells1);
   }
 
   // allocate boundary buffers for conserved (cell-centered) variables
   pbval_i = new MeshBoundaryValuesCC(ppack, pin, false);
-  pbval_i->InitializeBuffers(prgeo->nangles);
+  // optionally exchange fewer ghost cells than <mesh>/nghost
+  nghost = pbval_i->SetGhostDepth(pin, "radiation");
+  pbval_i->InitializeBuffers(nrad);
 
   // for time-evolving problems, continue to construct methods, allocate arrays
   if (evolution_t.compare("stationary") != 0) {
@@ -173,10 +233,10 @@ Radiation::Radiation(MeshBlockPack *ppack, ParameterInput *pin) :
                xorder.compare("ppmx") == 0 ||
                xorder.compare("wenoz") == 0) {
       // check that nghost > 2
-      if (indcs.ng < 3) {
+      if (nghost < 3) {
         std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
           << std::endl << xorder << " reconstruction requires at least 3 ghost zones, "
-          << "but <mesh>/nghost=" << indcs.ng << std::endl;
+          << "but <radiation>/nghost=" << nghost << std::endl;
         std::exit(EXIT_FAILURE);
       }
       if (xorder.compare("ppm4") == 0) {
@@ -192,21 +252,30 @@ Radiation::Radiation(MeshBlockPack *ppack, ParameterInput *pin) :
                 << std::endl;
       std::exit(EXIT_FAILURE);
     }
+    if (is_m1 && recon_method > ReconstructionMethod::plm) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<radiation> recon = '" << xorder << "' not implemented"
+                << " with <radiation>/m1 = true, use 'dc' or 'plm'" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
     }
 
     // allocate second registers, fluxes, masks
     int ncells1 = indcs.nx1 + 2*(indcs.ng);
     int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
     int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
-    Kokkos::realloc(i1,      nmb,prgeo->nangles,ncells3,ncells2,ncells1);
-    Kokkos::realloc(iflx.x1f,nmb,prgeo->nangles,ncells3,ncells2,ncells1);
-    Kokkos::realloc(iflx.x2f,nmb,prgeo->nangles,ncells3,ncells2,ncells1);
-    Kokkos::realloc(iflx.x3f,nmb,prgeo->nangles,ncells3,ncells2,ncells1);
+    Kokkos::realloc(i1,      nmb,nrad,ncells3,ncells2,ncells1);
+    Kokkos::realloc(iflx.x1f,nmb,nrad,ncells3,ncells2,ncells1);
+    Kokkos::realloc(iflx.x2f,nmb,nrad,ncells3,ncells2,ncells1);
+    Kokkos::realloc(iflx.x3f,nmb,nrad,ncells3,ncells2,ncells1);
     if (angular_fluxes) {
-      Kokkos::realloc(divfa,nmb,prgeo->nangles,ncells3,ncells2,ncells1);
+      Kokkos::realloc(divfa,nmb,nrad,ncells3,ncells2,ncells1);
     }
     if (beam_source) {
-      Kokkos::realloc(beam_mask,nmb,prgeo->nangles,ncells3,ncells2,ncells1);
+      Kokkos::realloc(beam_mask,nmb,nrad,ncells3,ncells2,ncells1);
+    }
+    if (is_m1 && rad_source) {
+      Kokkos::realloc(m1_sigma,nmb,ncells3,ncells2,ncells1);
     }
   }
 }
@@ -95,6 +95,8 @@ class Radiation {
   bool rad_source;          // flag to enable/disable radiation source term
   bool fixed_fluid;         // flag to enable/disable fluid integration
   bool affect_fluid;        // flag to enable/disable feedback of rad field on fluid
+  bool team_source;         // flag to solve source term with one team per cell
+  bool fused_update;        // flag to apply explicit RK update in source term kernel
   Real arad;                // radiation constant
   Real kappa_a;             // constant Rosseland mean absoprtion coefficient
   Real kappa_s;             // constant scattering coefficient
@@ -106,9 +108,16 @@ class Radiation {
   bool beam_source;
   SourceTerms *psrc = nullptr;
 
+  // Moment closure (grey M1) instead of discrete ordinates
+  bool is_m1;               // flag to evolve E,F^i with M1 closure instead of i(n)
+  int nrad;                 // number of radiation variables (nangles, or NRMOM for M1)
+  int nghost;               // number of ghost cells exchanged with neighbors
+
   // Angular mesh
   bool rotate_geo;                    // rotate geodesic mesh
   bool angular_fluxes;                // flag to enable/disable angular fluxes
+  bool angle_blocked;                 // flag to loop over angles within each team
+  bool na_on_the_fly;                 // compute n^a from tetrad in kernels, not store it
   Real n_0_floor;                     // floor on n_0
   GeodesicGrid *prgeo = nullptr;      // pointer to radiation angular mesh
 
@@ -123,19 +132,21 @@ class Radiation {
   DvceArray6D<Real> na;               // n^a
   DvceArray6D<Real> norm_to_tet;      // used in transform b/w normal frame and tet frame
   void SetOrthonormalTetrad();
+  void RemapAngles(HostArray5D<Real> &iin, int nlevel_in);
 
   // intensity arrays
-  DvceArray5D<Real> i0;         // intensities
-  DvceArray5D<Real> coarse_i0;  // intensities on 2x coarser grid (for SMR/AMR)
+  DvceArray5D<RadReal> i0;         // intensities
+  DvceArray5D<RadReal> coarse_i0;  // intensities on 2x coarser grid (for SMR/AMR)
 
   // Boundary communication buffers and functions for i
   MeshBoundaryValuesCC *pbval_i;
 
   // following only used for time-evolving flow
-  DvceArray5D<Real> i1;         // intensity at intermediate step
-  DvceFaceFld5D<Real> iflx;     // spatial fluxes on zone faces
+  DvceArray5D<RadReal> i1;         // intensity at intermediate step
+  DvceFaceFld5D<RadReal> iflx;     // spatial fluxes on zone faces
   DvceArray5D<Real> divfa;      // angular flux divergence
   DvceArray5D<bool> beam_mask;  // boolean mask used for beam source term
+  DvceArray4D<Real> m1_sigma;   // total opacity, used to limit diffusion of M1 fluxes
   Real dtnew;
 
   // reconstruction method
@@ -151,6 +162,8 @@ class Radiation {
   // ...in "stagen_tl" task list
   TaskStatus CopyCons(Driver *d, int stage);
   TaskStatus CalculateFluxes(Driver *d, int stage);
+  void CalculateFluxesAngleBlocked();
+  void CalculateAngularFluxesOnTheFly();
   TaskStatus SendFlux(Driver *d, int stage);
   TaskStatus RecvFlux(Driver *d, int stage);
   TaskStatus RKUpdate(Driver *d, int stage);
@@ -161,6 +174,11 @@ class Radiation {
   TaskStatus ApplyPhysicalBCs(Driver* pdrive, int stage);
   TaskStatus Prolongate(Driver* pdrive, int stage);
   TaskStatus NewTimeStep(Driver *d, int stage);
+  // ...M1 versions of above, called by them when is_m1=true
+  void CalculateFluxesM1();
+  void RKUpdateM1(Driver *d, int stage);
+  void AddRadiationSourceTermM1(Driver *d, int stage);
+  void NewTimeStepM1();
   // ...in "after_stagen_tl" task list
   TaskStatus ClearSend(Driver *d, int stage);
   TaskStatus ClearRecv(Driver *d, int stage);
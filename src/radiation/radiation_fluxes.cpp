@@ -10,21 +10,69 @@
 
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
+#include "coordinates/cartesian_ks.hpp"
 #include "coordinates/coordinates.hpp"
+#include "coordinates/cell_locations.hpp"
 #include "eos/eos.hpp"
 #include "geodesic-grid/geodesic_grid.hpp"
 #include "radiation.hpp"
+#include "radiation_tetrad.hpp"
 #include "reconstruct/dc.hpp"
 #include "reconstruct/plm.hpp"
 #include "reconstruct/ppm.hpp"
 #include "reconstruct/wenoz.hpp"
 
 namespace radiation {
+//----------------------------------------------------------------------------------------
+//! \fn Real UpwindIntensity
+//! \brief reconstructs primitive intensity on the upwind side of a face, given values in
+//! the cells i-3..i+2 about a face at i-1/2 and the sign of the normal component nd
+
+KOKKOS_INLINE_FUNCTION
+Real UpwindIntensity(const int recon_method, const Real nd,
+                     const Real iim3, const Real iim2, const Real iim1,
+                     const Real iicc, const Real iip1, const Real iip2) {
+  Real iiu, scr;
+  switch (recon_method) {
+    case ReconstructionMethod::dc:
+      if (nd > 0.0) iiu = iim1;
+      else          iiu = iicc;
+      break;
+    case ReconstructionMethod::plm:
+      if (nd > 0.0) PLM(iim2, iim1, iicc, iiu, scr);
+      else          PLM(iim1, iicc, iip1, scr, iiu);
+      break;
+    case ReconstructionMethod::ppm4:
+      if (nd > 0.0) PPM4(iim3, iim2, iim1, iicc, iip1, iiu, scr);
+      else          PPM4(iim2, iim1, iicc, iip1, iip2, scr, iiu);
+      break;
+    case ReconstructionMethod::ppmx:
+      if (nd > 0.0) PPMX(iim3, iim2, iim1, iicc, iip1, iiu, scr);
+      else          PPMX(iim2, iim1, iicc, iip1, iip2, scr, iiu);
+      break;
+    case ReconstructionMethod::wenoz:
+      if (nd > 0.0) WENOZ(iim3, iim2, iim1, iicc, iip1, iiu, scr);
+      else          WENOZ(iim2, iim1, iicc, iip1, iip2, scr, iiu);
+      break;
+    default:
+      break;
+  }
+  return iiu;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn  void Radiation::CalculateFluxes
 //! \brief Compute radiation fluxes
 
 TaskStatus Radiation::CalculateFluxes(Driver *pdriver, int stage) {
+  if (is_m1) {
+    CalculateFluxesM1();
+    return TaskStatus::complete;
+  }
+  if (angle_blocked) {
+    CalculateFluxesAngleBlocked();
+    return TaskStatus::complete;
+  }
   RegionIndcs &indcs = pmy_pack->pmesh->mb_indcs;
   int &is = indcs.is, &ie = indcs.ie;
   int &js = indcs.js, &je = indcs.je;
@@ -38,11 +86,20 @@ TaskStatus Radiation::CalculateFluxes(Driver *pdriver, int stage) {
   auto &nh_c_ = nh_c;
   auto &tet_c_ = tet_c;
 
+  // static estimates per face and angle for roofline counters, assuming each intensity
+  // is read and each flux is written once (tetrads are reused by all angles), and that
+  // only the upwind state is reconstructed
+  KernelCounters &kc = pmy_pack->pmesh->kcounter;
+  double face_bytes = 2.0*sizeof(Real);
+  double face_flops = 14.0 + 0.5*ReconstructionFlops(recon_method);
+  double nfaces = static_cast<double>(nmb1+1)*(nang1+1)*(ke-ks+1)*(je-js+1)*(ie-is+1);
+
   //--------------------------------------------------------------------------------------
   // i-direction
 
   auto &t1d1 = tet_d1_x1f;
   auto &flx1 = iflx.x1f;
+  kc.Start("rflux_x1", nfaces*(ie-is+2)/(ie-is+1), face_bytes, face_flops);
   par_for("rflux_x1",DevExeSpace(),0,nmb1,0,nang1,ks,ke,js,je,is,ie+1,
   KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
     // calculate n^1 (hence determining upwinding direction)
@@ -50,7 +107,7 @@ TaskStatus Radiation::CalculateFluxes(Driver *pdriver, int stage) {
             + t1d1(m,2,k,j,i)*nh_c_.d_view(n,2) + t1d1(m,3,k,j,i)*nh_c_.d_view(n,3);
 
     // convert to primitive n_0 I
-    Real iim1, iicc, iim2, iip1, iim3, iip2;
+    Real iim1, iicc, iim2 = 0.0, iip1 = 0.0, iim3 = 0.0, iip2 = 0.0;
     iim1 = i0_(m,n,k,j,i-1)/tet_c_(m,0,0,k,j,i-1);
     iicc = i0_(m,n,k,j,i  )/tet_c_(m,0,0,k,j,i  );
     if (recon_method_ > 0) {
@@ -63,35 +120,12 @@ TaskStatus Radiation::CalculateFluxes(Driver *pdriver, int stage) {
     }
 
     // reconstruct primitive intensity
-    Real iiu, scr;
-    switch (recon_method_) {
-      case ReconstructionMethod::dc:
-        if (n1 > 0.0) iiu = iim1;
-        else          iiu = iicc;
-        break;
-      case ReconstructionMethod::plm:
-        if (n1 > 0.0) PLM(iim2, iim1, iicc, iiu, scr);
-        else          PLM(iim1, iicc, iip1, scr, iiu);
-        break;
-      case ReconstructionMethod::ppm4:
-        if (n1 > 0.0) PPM4(iim3, iim2, iim1, iicc, iip1, iiu, scr);
-        else          PPM4(iim2, iim1, iicc, iip1, iip2, scr, iiu);
-        break;
-      case ReconstructionMethod::ppmx:
-        if (n1 > 0.0) PPMX(iim3, iim2, iim1, iicc, iip1, iiu, scr);
-        else          PPMX(iim2, iim1, iicc, iip1, iip2, scr, iiu);
-        break;
-      case ReconstructionMethod::wenoz:
-        if (n1 > 0.0) WENOZ(iim3, iim2, iim1, iicc, iip1, iiu, scr);
-        else          WENOZ(iim2, iim1, iicc, iip1, iip2, scr, iiu);
-        break;
-      default:
-        break;
-    }
+    Real iiu = UpwindIntensity(recon_method_, n1, iim3, iim2, iim1, iicc, iip1, iip2);
 
     // compute x1flux
     flx1(m,n,k,j,i) = n1*iiu;
   });
+  kc.Stop();
 
   //--------------------------------------------------------------------------------------
   // j-direction
@@ -99,6 +133,7 @@ TaskStatus Radiation::CalculateFluxes(Driver *pdriver, int stage) {
   if (pmy_pack->pmesh->multi_d) {
     auto &t2d2 = tet_d2_x2f;
     auto &flx2 = iflx.x2f;
+    kc.Start("rflux_x2", nfaces*(je-js+2)/(je-js+1), face_bytes, face_flops);
     par_for("rflux_x2",DevExeSpace(),0,nmb1,0,nang1,ks,ke,js,je+1,is,ie,
     KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
       // calculate n^2 (hence determining upwinding direction)
@@ -106,7 +141,7 @@ TaskStatus Radiation::CalculateFluxes(Driver *pdriver, int stage) {
               + t2d2(m,2,k,j,i)*nh_c_.d_view(n,2) + t2d2(m,3,k,j,i)*nh_c_.d_view(n,3);
 
       // convert to primitive n_0 I
-      Real iim1, iicc, iim2, iip1, iim3, iip2;
+      Real iim1, iicc, iim2 = 0.0, iip1 = 0.0, iim3 = 0.0, iip2 = 0.0;
       iim1 = i0_(m,n,k,j-1,i)/tet_c_(m,0,0,k,j-1,i);
       iicc = i0_(m,n,k,j  ,i)/tet_c_(m,0,0,k,j  ,i);
       if (recon_method_ > 0) {
@@ -119,35 +154,12 @@ TaskStatus Radiation::CalculateFluxes(Driver *pdriver, int stage) {
       }
 
       // reconstruct primitive intensity
-      Real iiu, scr;
-      switch (recon_method_) {
-        case ReconstructionMethod::dc:
-          if (n2 > 0.0) iiu = iim1;
-          else          iiu = iicc;
-          break;
-        case ReconstructionMethod::plm:
-          if (n2 > 0.0) PLM(iim2, iim1, iicc, iiu, scr);
-          else          PLM(iim1, iicc, iip1, scr, iiu);
-          break;
-        case ReconstructionMethod::ppm4:
-          if (n2 > 0.0) PPM4(iim3, iim2, iim1, iicc, iip1, iiu, scr);
-          else          PPM4(iim2, iim1, iicc, iip1, iip2, scr, iiu);
-          break;
-        case ReconstructionMethod::ppmx:
-          if (n2 > 0.0) PPMX(iim3, iim2, iim1, iicc, iip1, iiu, scr);
-          else          PPMX(iim2, iim1, iicc, iip1, iip2, scr, iiu);
-          break;
-        case ReconstructionMethod::wenoz:
-          if (n2 > 0.0) WENOZ(iim3, iim2, iim1, iicc, iip1, iiu, scr);
-          else          WENOZ(iim2, iim1, iicc, iip1, iip2, scr, iiu);
-          break;
-        default:
-          break;
-      }
+      Real iiu = UpwindIntensity(recon_method_, n2, iim3, iim2, iim1, iicc, iip1, iip2);
 
       // compute x2flux
       flx2(m,n,k,j,i) = n2*iiu;
     });
+    kc.Stop();
   }
 
   //--------------------------------------------------------------------------------------
@@ -156,6 +168,7 @@ TaskStatus Radiation::CalculateFluxes(Driver *pdriver, int stage) {
   if (pmy_pack->pmesh->three_d) {
     auto &t3d3 = tet_d3_x3f;
     auto &flx3 = iflx.x3f;
+    kc.Start("rflux_x3", nfaces*(ke-ks+2)/(ke-ks+1), face_bytes, face_flops);
     par_for("rflux_x3",DevExeSpace(),0,nmb1,0,nang1,ks,ke+1,js,je,is,ie,
     KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
       // calculate n^3 (hence determining upwinding direction)
@@ -163,7 +176,7 @@ TaskStatus Radiation::CalculateFluxes(Driver *pdriver, int stage) {
               + t3d3(m,2,k,j,i)*nh_c_.d_view(n,2) + t3d3(m,3,k,j,i)*nh_c_.d_view(n,3);
 
       // convert to primitive n_0 I
-      Real iim1, iicc, iim2, iip1, iim3, iip2;
+      Real iim1, iicc, iim2 = 0.0, iip1 = 0.0, iim3 = 0.0, iip2 = 0.0;
       iim1 = i0_(m,n,k-1,j,i)/tet_c_(m,0,0,k-1,j,i);
       iicc = i0_(m,n,k  ,j,i)/tet_c_(m,0,0,k  ,j,i);
       if (recon_method_ > 0) {
@@ -176,63 +189,307 @@ TaskStatus Radiation::CalculateFluxes(Driver *pdriver, int stage) {
       }
 
       // reconstruct primitive intensity
-      Real iiu, scr;
-      switch (recon_method_) {
-        case ReconstructionMethod::dc:
-          if (n3 > 0.0) iiu = iim1;
-          else          iiu = iicc;
-          break;
-        case ReconstructionMethod::plm:
-          if (n3 > 0.0) PLM(iim2, iim1, iicc, iiu, scr);
-          else          PLM(iim1, iicc, iip1, scr, iiu);
-          break;
-        case ReconstructionMethod::ppm4:
-          if (n3 > 0.0) PPM4(iim3, iim2, iim1, iicc, iip1, iiu, scr);
-          else          PPM4(iim2, iim1, iicc, iip1, iip2, scr, iiu);
-          break;
-        case ReconstructionMethod::ppmx:
-          if (n3 > 0.0) PPMX(iim3, iim2, iim1, iicc, iip1, iiu, scr);
-          else          PPMX(iim2, iim1, iicc, iip1, iip2, scr, iiu);
-          break;
-        case ReconstructionMethod::wenoz:
-          if (n3 > 0.0) WENOZ(iim3, iim2, iim1, iicc, iip1, iiu, scr);
-          else          WENOZ(iim2, iim1, iicc, iip1, iip2, scr, iiu);
-          break;
-        default:
-          break;
-      }
+      Real iiu = UpwindIntensity(recon_method_, n3, iim3, iim2, iim1, iicc, iip1, iip2);
 
       // compute x3flux
       flx3(m,n,k,j,i) = n3*iiu;
     });
+    kc.Stop();
   }
 
   //--------------------------------------------------------------------------------------
   // Angular Fluxes
 
-  if (angular_fluxes) {
-    auto &numn = prgeo->num_neighbors;
-    auto &indn = prgeo->ind_neighbors;
-    auto &arcl = prgeo->arc_lengths;
-    auto &solid_angles_ = prgeo->solid_angles;
+  // Neighbors and geometric weights are read from the CSR table in GeodesicGrid, and the
+  // angular flux coefficients na (set once with the tetrad) are cached in each cell.
+
+  if (angular_fluxes && na_on_the_fly) {
+    CalculateAngularFluxesOnTheFly();
+  } else if (angular_fluxes) {
+    auto &noff = prgeo->nbr_offset;
+    auto &nind = prgeo->nbr_index;
+    auto &nwgt = prgeo->nbr_weight;
 
     auto &na_ = na;
     auto &divfa_ = divfa;
 
     par_for("rflux_angular",DevExeSpace(),0,nmb1,0,nang1,ks,ke,js,je,is,ie,
     KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
-      divfa_(m,n,k,j,i) = 0.0;
-      for (int nb=0; nb<numn.d_view(n); ++nb) {
-        Real flx_edge = na_(m,n,k,j,i,nb) *
-                        ((na_(m,n,k,j,i,nb) < 0.0) ?
-                         i0_(m,indn.d_view(n,nb),k,j,i)/tet_c_(m,0,0,k,j,i) :
-                         i0_(m,n,k,j,i)/tet_c_(m,0,0,k,j,i));
-        divfa_(m,n,k,j,i) += (arcl.d_view(n,nb)*flx_edge/solid_angles_.d_view(n));
+      Real itc = 1.0/tet_c_(m,0,0,k,j,i);
+      Real iicc = i0_(m,n,k,j,i)*itc;
+      Real divfa = 0.0;
+      int e0 = noff.d_view(n);
+      for (int e=e0; e<noff.d_view(n+1); ++e) {
+        Real nav = na_(m,n,k,j,i,e-e0);
+        Real flx_edge = nav*((nav < 0.0) ? i0_(m,nind.d_view(e),k,j,i)*itc : iicc);
+        divfa += nwgt.d_view(e)*flx_edge;
       }
+      divfa_(m,n,k,j,i) = divfa;
     });
   }
 
   return TaskStatus::complete;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn  void Radiation::CalculateFluxesAngleBlocked
+//! \brief Same fluxes as CalculateFluxes, but each team holds a (m,k,j) row of cells
+//! fixed and loops over all angles.  The angle-independent tetrad components at faces
+//! and cell centers are loaded into scratch once per row, rather than once per angle.
+
+void Radiation::CalculateFluxesAngleBlocked() {
+  RegionIndcs &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  int n1m1 = indcs.nx1 + 2*(indcs.ng) - 1;
+  int n2m1 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng) - 1) : 0;
+  int n3m1 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng) - 1) : 0;
+  int ncells1 = ScrRowLength(indcs.nx1 + 2*(indcs.ng));
+  int nang1 = prgeo->nangles - 1;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  int scr_level = 0;
+
+  const auto &recon_method_ = recon_method;
+
+  auto &i0_ = i0;
+  auto &nh_c_ = nh_c;
+  auto &tet_c_ = tet_c;
+
+  //--------------------------------------------------------------------------------------
+  // i-direction
+
+  size_t scr_size = ScrArray2D<Real>::shmem_size(4, ncells1) +
+                    ScrArray1D<Real>::shmem_size(ncells1);
+  auto &t1d1 = tet_d1_x1f;
+  auto &flx1 = iflx.x1f;
+  par_for_outer("rflux_x1_ab",DevExeSpace(),scr_size,scr_level,0,nmb1,ks,ke,js,je,
+  KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+    ScrArray2D<Real> tf(member.team_scratch(scr_level), 4, ncells1);
+    ScrArray1D<Real> tc(member.team_scratch(scr_level), ncells1);
+    par_for_inner(member, 0, n1m1, [&](const int i) {
+      tc(i) = tet_c_(m,0,0,k,j,i);
+      for (int d=0; d<4; ++d) {tf(d,i) = t1d1(m,d,k,j,i);}
+    });
+    member.team_barrier();
+
+    for (int n=0; n<=nang1; ++n) {
+      Real nh0 = nh_c_.d_view(n,0), nh1 = nh_c_.d_view(n,1);
+      Real nh2 = nh_c_.d_view(n,2), nh3 = nh_c_.d_view(n,3);
+      par_for_inner(member, is, ie+1, [&](const int i) {
+        Real n1 = tf(0,i)*nh0 + tf(1,i)*nh1 + tf(2,i)*nh2 + tf(3,i)*nh3;
+        Real iim1, iicc, iim2 = 0.0, iip1 = 0.0, iim3 = 0.0, iip2 = 0.0;
+        iim1 = i0_(m,n,k,j,i-1)/tc(i-1);
+        iicc = i0_(m,n,k,j,i  )/tc(i  );
+        if (recon_method_ > 0) {
+          iim2 = i0_(m,n,k,j,i-2)/tc(i-2);
+          iip1 = i0_(m,n,k,j,i+1)/tc(i+1);
+        }
+        if (recon_method_ > 1) {
+          iim3 = i0_(m,n,k,j,i-3)/tc(i-3);
+          iip2 = i0_(m,n,k,j,i+2)/tc(i+2);
+        }
+        Real iiu = UpwindIntensity(recon_method_, n1, iim3, iim2, iim1, iicc, iip1, iip2);
+        flx1(m,n,k,j,i) = n1*iiu;
+      });
+    }
+  });
+
+  //--------------------------------------------------------------------------------------
+  // j-direction.  Rows j-3..j+2 of tet_c are held in scratch.
+
+  if (pmy_pack->pmesh->multi_d) {
+    scr_size = ScrArray2D<Real>::shmem_size(4, ncells1) +
+               ScrArray2D<Real>::shmem_size(6, ncells1);
+    auto &t2d2 = tet_d2_x2f;
+    auto &flx2 = iflx.x2f;
+    par_for_outer("rflux_x2_ab",DevExeSpace(),scr_size,scr_level,0,nmb1,ks,ke,js,je+1,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+      ScrArray2D<Real> tf(member.team_scratch(scr_level), 4, ncells1);
+      ScrArray2D<Real> tc(member.team_scratch(scr_level), 6, ncells1);
+      par_for_inner(member, is, ie, [&](const int i) {
+        for (int d=0; d<4; ++d) {tf(d,i) = t2d2(m,d,k,j,i);}
+        for (int r=0; r<6; ++r) {
+          int jj = j + r - 3;
+          tc(r,i) = (jj >= 0 && jj <= n2m1)? tet_c_(m,0,0,k,jj,i) : 1.0;
+        }
+      });
+      member.team_barrier();
+
+      for (int n=0; n<=nang1; ++n) {
+        Real nh0 = nh_c_.d_view(n,0), nh1 = nh_c_.d_view(n,1);
+        Real nh2 = nh_c_.d_view(n,2), nh3 = nh_c_.d_view(n,3);
+        par_for_inner(member, is, ie, [&](const int i) {
+          Real n2 = tf(0,i)*nh0 + tf(1,i)*nh1 + tf(2,i)*nh2 + tf(3,i)*nh3;
+          Real iim1, iicc, iim2 = 0.0, iip1 = 0.0, iim3 = 0.0, iip2 = 0.0;
+          iim1 = i0_(m,n,k,j-1,i)/tc(2,i);
+          iicc = i0_(m,n,k,j  ,i)/tc(3,i);
+          if (recon_method_ > 0) {
+            iim2 = i0_(m,n,k,j-2,i)/tc(1,i);
+            iip1 = i0_(m,n,k,j+1,i)/tc(4,i);
+          }
+          if (recon_method_ > 1) {
+            iim3 = i0_(m,n,k,j-3,i)/tc(0,i);
+            iip2 = i0_(m,n,k,j+2,i)/tc(5,i);
+          }
+          Real iiu = UpwindIntensity(recon_method_, n2, iim3, iim2, iim1, iicc, iip1,
+                                     iip2);
+          flx2(m,n,k,j,i) = n2*iiu;
+        });
+      }
+    });
+  }
+
+  //--------------------------------------------------------------------------------------
+  // k-direction.  Rows k-3..k+2 of tet_c are held in scratch.
+
+  if (pmy_pack->pmesh->three_d) {
+    scr_size = ScrArray2D<Real>::shmem_size(4, ncells1) +
+               ScrArray2D<Real>::shmem_size(6, ncells1);
+    auto &t3d3 = tet_d3_x3f;
+    auto &flx3 = iflx.x3f;
+    par_for_outer("rflux_x3_ab",DevExeSpace(),scr_size,scr_level,0,nmb1,ks,ke+1,js,je,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+      ScrArray2D<Real> tf(member.team_scratch(scr_level), 4, ncells1);
+      ScrArray2D<Real> tc(member.team_scratch(scr_level), 6, ncells1);
+      par_for_inner(member, is, ie, [&](const int i) {
+        for (int d=0; d<4; ++d) {tf(d,i) = t3d3(m,d,k,j,i);}
+        for (int r=0; r<6; ++r) {
+          int kk = k + r - 3;
+          tc(r,i) = (kk >= 0 && kk <= n3m1)? tet_c_(m,0,0,kk,j,i) : 1.0;
+        }
+      });
+      member.team_barrier();
+
+      for (int n=0; n<=nang1; ++n) {
+        Real nh0 = nh_c_.d_view(n,0), nh1 = nh_c_.d_view(n,1);
+        Real nh2 = nh_c_.d_view(n,2), nh3 = nh_c_.d_view(n,3);
+        par_for_inner(member, is, ie, [&](const int i) {
+          Real n3 = tf(0,i)*nh0 + tf(1,i)*nh1 + tf(2,i)*nh2 + tf(3,i)*nh3;
+          Real iim1, iicc, iim2 = 0.0, iip1 = 0.0, iim3 = 0.0, iip2 = 0.0;
+          iim1 = i0_(m,n,k-1,j,i)/tc(2,i);
+          iicc = i0_(m,n,k  ,j,i)/tc(3,i);
+          if (recon_method_ > 0) {
+            iim2 = i0_(m,n,k-2,j,i)/tc(1,i);
+            iip1 = i0_(m,n,k+1,j,i)/tc(4,i);
+          }
+          if (recon_method_ > 1) {
+            iim3 = i0_(m,n,k-3,j,i)/tc(0,i);
+            iip2 = i0_(m,n,k+2,j,i)/tc(5,i);
+          }
+          Real iiu = UpwindIntensity(recon_method_, n3, iim3, iim2, iim1, iicc, iip1,
+                                     iip2);
+          flx3(m,n,k,j,i) = n3*iiu;
+        });
+      }
+    });
+  }
+
+  //--------------------------------------------------------------------------------------
+  // Angular Fluxes
+
+  if (angular_fluxes && na_on_the_fly) {
+    CalculateAngularFluxesOnTheFly();
+  } else if (angular_fluxes) {
+    auto &noff = prgeo->nbr_offset;
+    auto &nind = prgeo->nbr_index;
+    auto &nwgt = prgeo->nbr_weight;
+
+    auto &na_ = na;
+    auto &divfa_ = divfa;
+
+    scr_size = ScrArray1D<Real>::shmem_size(ncells1);
+    par_for_outer("rflux_angular_ab",DevExeSpace(),scr_size,scr_level,0,nmb1,ks,ke,js,je,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+      ScrArray1D<Real> tc(member.team_scratch(scr_level), ncells1);
+      par_for_inner(member, is, ie, [&](const int i) {
+        tc(i) = tet_c_(m,0,0,k,j,i);
+      });
+      member.team_barrier();
+
+      for (int n=0; n<=nang1; ++n) {
+        int e0 = noff.d_view(n), e1 = noff.d_view(n+1);
+        par_for_inner(member, is, ie, [&](const int i) {
+          Real itc = 1.0/tc(i);
+          Real iicc = i0_(m,n,k,j,i)*itc;
+          Real divfa = 0.0;
+          for (int e=e0; e<e1; ++e) {
+            Real nav = na_(m,n,k,j,i,e-e0);
+            Real flx_edge = nav*((nav < 0.0) ? i0_(m,nind.d_view(e),k,j,i)*itc : iicc);
+            divfa += nwgt.d_view(e)*flx_edge;
+          }
+          divfa_(m,n,k,j,i) = divfa;
+        });
+      }
+    });
+  }
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void Radiation::CalculateAngularFluxesOnTheFly
+//! \brief Same angular fluxes as in CalculateFluxes, but with the coefficients n^a
+//! computed from the tetrad at each cell instead of read from the (6*nangles per cell)
+//! array na.  Each thread computes the tetrad and its rotation coefficients once and
+//! then loops over all angles, trading FLOPs for memory.
+
+void Radiation::CalculateAngularFluxesOnTheFly() {
+  RegionIndcs &indcs = pmy_pack->pmesh->mb_indcs;
+  int &is = indcs.is, &ie = indcs.ie;
+  int &js = indcs.js, &je = indcs.je;
+  int &ks = indcs.ks, &ke = indcs.ke;
+  int nang1 = prgeo->nangles - 1;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  auto &size = pmy_pack->pmb->mb_size;
+  auto &coord = pmy_pack->pcoord->coord_data;
+  bool &flat = coord.is_minkowski;
+  Real &spin = coord.bh_spin;
+
+  auto &noff = prgeo->nbr_offset;
+  auto &nind = prgeo->nbr_index;
+  auto &nwgt = prgeo->nbr_weight;
+  auto &uflux = prgeo->unit_flux;
+  auto &nh_f_ = nh_f;
+  auto &i0_ = i0;
+  auto &divfa_ = divfa;
+
+  par_for("rflux_angular_otf",DevExeSpace(),0,nmb1,ks,ke,js,je,is,ie,
+  KOKKOS_LAMBDA(int m, int k, int j, int i) {
+    Real &x1min = size.d_view(m).x1min;
+    Real &x1max = size.d_view(m).x1max;
+    Real x1v = CellCenterX(i-is, indcs.nx1, x1min, x1max);
+
+    Real &x2min = size.d_view(m).x2min;
+    Real &x2max = size.d_view(m).x2max;
+    Real x2v = CellCenterX(j-js, indcs.nx2, x2min, x2max);
+
+    Real &x3min = size.d_view(m).x3min;
+    Real &x3max = size.d_view(m).x3max;
+    Real x3v = CellCenterX(k-ks, indcs.nx3, x3min, x3max);
+
+    Real glower[4][4], gupper[4][4];
+    ComputeMetricAndInverse(x1v,x2v,x3v,flat,spin,glower,gupper);
+    Real dgx[4][4], dgy[4][4], dgz[4][4];
+    ComputeMetricDerivatives(x1v,x2v,x3v,flat,spin,dgx,dgy,dgz);
+    Real e[4][4], e_cov[4][4], omega[4][4][4];
+    ComputeTetrad(x1v,x2v,x3v,flat,spin,glower,gupper,dgx,dgy,dgz,e,e_cov,omega);
+
+    Real itc = 1.0/e[0][0];
+    for (int n=0; n<=nang1; ++n) {
+      Real iicc = i0_(m,n,k,j,i)*itc;
+      Real divfa = 0.0;
+      int e0 = noff.d_view(n);
+      for (int ed=e0; ed<noff.d_view(n+1); ++ed) {
+        Real nav = AngularFluxCoeff(omega, nh_f_, uflux, n, ed-e0);
+        Real flx_edge = nav*((nav < 0.0) ? i0_(m,nind.d_view(ed),k,j,i)*itc : iicc);
+        divfa += nwgt.d_view(ed)*flx_edge;
+      }
+      divfa_(m,n,k,j,i) = divfa;
+    }
+  });
+
+  return;
+}
+
 } // namespace radiation
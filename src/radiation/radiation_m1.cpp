@@ -0,0 +1,273 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file radiation_m1.cpp
+//! \brief fluxes, RK update and timestep for the grey M1 moment scheme.  With
+//! <radiation>/m1 = true, i0 stores the radiation energy density E and flux F^i
+//! (indexed by IRE, IRF1, IRF2, IRF3) rather than intensities, and these functions are
+//! called by the corresponding Radiation tasks.  Only implemented in flat spacetime.
+
+#include <float.h>
+#include <math.h>
+
+#include <algorithm>  // min
+#include <limits>
+
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+#include "driver/driver.hpp"
+#include "eos/eos.hpp"
+#include "hydro/hydro.hpp"
+#include "mhd/mhd.hpp"
+#include "units/units.hpp"
+#include "radiation.hpp"
+#include "radiation/radiation_m1.hpp"
+#include "radiation/radiation_opacities.hpp"
+#include "reconstruct/plm.hpp"
+
+namespace radiation {
+//----------------------------------------------------------------------------------------
+//! \fn void M1FluxLLF
+//! \brief local Lax-Friedrichs flux of (E,F^i) in direction d given L/R states, with
+//! signal speed c=1.  Dissipation is multiplied by eps <= 1, which is reduced in
+//! optically thick cells to recover the correct diffusion limit.
+
+KOKKOS_INLINE_FUNCTION
+void M1FluxLLF(const int d, const Real ql[NRMOM], const Real qr[NRMOM], const Real eps,
+               Real flx[NRMOM]) {
+  Real pl[3][3], pr[3][3];
+  M1Closure(ql[IRE], ql[IRF1], ql[IRF2], ql[IRF3], pl);
+  M1Closure(qr[IRE], qr[IRF1], qr[IRF2], qr[IRF3], pr);
+  flx[IRE] = 0.5*(ql[IRF1+d] + qr[IRF1+d]) - 0.5*eps*(qr[IRE] - ql[IRE]);
+  for (int a=0; a<3; ++a) {
+    flx[IRF1+a] = 0.5*(pl[d][a] + pr[d][a]) - 0.5*eps*(qr[IRF1+a] - ql[IRF1+a]);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void Radiation::CalculateFluxesM1
+//! \brief Compute fluxes of M1 moments using DC or PLM reconstruction of (E,F^i)
+
+void Radiation::CalculateFluxesM1() {
+  RegionIndcs &indcs = pmy_pack->pmesh->mb_indcs;
+  int &is = indcs.is, &ie = indcs.ie;
+  int &js = indcs.js, &je = indcs.je;
+  int &ks = indcs.ks, &ke = indcs.ke;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  auto &size = pmy_pack->pmb->mb_size;
+  const auto &recon_method_ = recon_method;
+  auto &i0_ = i0;
+
+  // total opacity is only needed to limit numerical diffusion when coupled to fluid
+  bool rad_source_ = rad_source;
+  auto &sigma_ = m1_sigma;
+  if (rad_source) {
+    Real density_scale_ = 1.0, temperature_scale_ = 1.0, length_scale_ = 1.0;
+    Real mean_mol_weight_ = 1.0;
+    Real rosseland_coef_ = 1.0, planck_minus_rosseland_coef_ = 0.0;
+    if (are_units_enabled) {
+      density_scale_ = pmy_pack->punit->density_cgs();
+      temperature_scale_ = pmy_pack->punit->temperature_cgs();
+      length_scale_ = pmy_pack->punit->length_cgs();
+      mean_mol_weight_ = pmy_pack->punit->mu();
+      rosseland_coef_ = pmy_pack->punit->rosseland_coef_cgs;
+      planck_minus_rosseland_coef_ = pmy_pack->punit->planck_minus_rosseland_coef_cgs;
+  }
+  Real gm1 = 0.0;
+  DvceArray5D<Real> w0_;
+  if (is_hydro_enabled) {
+    gm1 = pmy_pack->phydro->peos->eos_data.gamma - 1.0;
+    w0_ = pmy_pack->phydro->w0;
+  } else if (is_mhd_enabled) {
+    gm1 = pmy_pack->pmhd->peos->eos_data.gamma - 1.0;
+    w0_ = pmy_pack->pmhd->w0;
+  }
+  Real kappa_a_ = kappa_a, kappa_s_ = kappa_s, kappa_p_ = kappa_p;
+  bool power_opacity_ = power_opacity;
+
+  // total (absorption plus scattering) opacity in all cells including ghost zones
+  int n1 = indcs.nx1 + 2*indcs.ng;
+  int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*indcs.ng) : 1;
+  int n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*indcs.ng) : 1;
+  par_for("rsigma_m1",DevExeSpace(),0,nmb1,0,(n3-1),0,(n2-1),0,(n1-1),
+  KOKKOS_LAMBDA(int m, int k, int j, int i) {
+    Real sigma_a, sigma_s, sigma_p;
+    Real wdn = w0_(m,IDN,k,j,i);
+    Real tgas = gm1*w0_(m,IEN,k,j,i)/wdn;
+    OpacityFunction(wdn, density_scale_,
+                    tgas, temperature_scale_,
+                    length_scale_, gm1, mean_mol_weight_,
+                    power_opacity_, rosseland_coef_, planck_minus_rosseland_coef_,
+                    kappa_a_, kappa_s_, kappa_p_,
+                    sigma_a, sigma_s, sigma_p);
+    sigma_(m,k,j,i) = sigma_a + sigma_s;
+  });
+  }
+
+  //--------------------------------------------------------------------------------------
+  // i-direction
+
+  auto &flx1 = iflx.x1f;
+  par_for("rflux_m1_x1",DevExeSpace(),0,nmb1,ks,ke,js,je,is,ie+1,
+  KOKKOS_LAMBDA(int m, int k, int j, int i) {
+    Real ql[NRMOM], qr[NRMOM], flx[NRMOM], scr;
+    for (int n=0; n<NRMOM; ++n) {
+      if (recon_method_ == ReconstructionMethod::dc) {
+        ql[n] = i0_(m,n,k,j,i-1);
+        qr[n] = i0_(m,n,k,j,i  );
+      } else {
+        PLM(i0_(m,n,k,j,i-2), i0_(m,n,k,j,i-1), i0_(m,n,k,j,i  ), ql[n], scr);
+        PLM(i0_(m,n,k,j,i-1), i0_(m,n,k,j,i  ), i0_(m,n,k,j,i+1), scr, qr[n]);
+      }
+    }
+    Real eps = 1.0;
+    if (rad_source_) {
+      Real tau = 0.5*size.d_view(m).dx1*(sigma_(m,k,j,i-1) + sigma_(m,k,j,i));
+      eps = fmin(1.0, 1.0/tau);
+    }
+    M1FluxLLF(0, ql, qr, eps, flx);
+    for (int n=0; n<NRMOM; ++n) { flx1(m,n,k,j,i) = flx[n]; }
+  });
+
+  //--------------------------------------------------------------------------------------
+  // j-direction
+
+  if (pmy_pack->pmesh->multi_d) {
+    auto &flx2 = iflx.x2f;
+    par_for("rflux_m1_x2",DevExeSpace(),0,nmb1,ks,ke,js,je+1,is,ie,
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      Real ql[NRMOM], qr[NRMOM], flx[NRMOM], scr;
+      for (int n=0; n<NRMOM; ++n) {
+        if (recon_method_ == ReconstructionMethod::dc) {
+          ql[n] = i0_(m,n,k,j-1,i);
+          qr[n] = i0_(m,n,k,j  ,i);
+        } else {
+          PLM(i0_(m,n,k,j-2,i), i0_(m,n,k,j-1,i), i0_(m,n,k,j  ,i), ql[n], scr);
+          PLM(i0_(m,n,k,j-1,i), i0_(m,n,k,j  ,i), i0_(m,n,k,j+1,i), scr, qr[n]);
+        }
+      }
+      Real eps = 1.0;
+      if (rad_source_) {
+        Real tau = 0.5*size.d_view(m).dx2*(sigma_(m,k,j-1,i) + sigma_(m,k,j,i));
+        eps = fmin(1.0, 1.0/tau);
+      }
+      M1FluxLLF(1, ql, qr, eps, flx);
+      for (int n=0; n<NRMOM; ++n) { flx2(m,n,k,j,i) = flx[n]; }
+    });
+  }
+
+  //--------------------------------------------------------------------------------------
+  // k-direction
+
+  if (pmy_pack->pmesh->three_d) {
+    auto &flx3 = iflx.x3f;
+    par_for("rflux_m1_x3",DevExeSpace(),0,nmb1,ks,ke+1,js,je,is,ie,
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      Real ql[NRMOM], qr[NRMOM], flx[NRMOM], scr;
+      for (int n=0; n<NRMOM; ++n) {
+        if (recon_method_ == ReconstructionMethod::dc) {
+          ql[n] = i0_(m,n,k-1,j,i);
+          qr[n] = i0_(m,n,k  ,j,i);
+        } else {
+          PLM(i0_(m,n,k-2,j,i), i0_(m,n,k-1,j,i), i0_(m,n,k  ,j,i), ql[n], scr);
+          PLM(i0_(m,n,k-1,j,i), i0_(m,n,k  ,j,i), i0_(m,n,k+1,j,i), scr, qr[n]);
+        }
+      }
+      Real eps = 1.0;
+      if (rad_source_) {
+        Real tau = 0.5*size.d_view(m).dx3*(sigma_(m,k-1,j,i) + sigma_(m,k,j,i));
+        eps = fmin(1.0, 1.0/tau);
+      }
+      M1FluxLLF(2, ql, qr, eps, flx);
+      for (int n=0; n<NRMOM; ++n) { flx3(m,n,k,j,i) = flx[n]; }
+    });
+  }
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void Radiation::RKUpdateM1
+//! \brief Explicit RK update of flux divergence of M1 moments.  E is floored, and F^i
+//! limited so that |F| <= E.
+
+void Radiation::RKUpdateM1(Driver *pdriver, int stage) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int &is = indcs.is, &ie = indcs.ie;
+  int &js = indcs.js, &je = indcs.je;
+  int &ks = indcs.ks, &ke = indcs.ke;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+
+  auto &mbsize  = pmy_pack->pmb->mb_size;
+
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+
+  Real &gam0 = pdriver->gam0[stage-1];
+  Real &gam1 = pdriver->gam1[stage-1];
+  Real beta_dt = (pdriver->beta[stage-1])*(pmy_pack->pmesh->dt);
+
+  auto &i0_ = i0;
+  auto &i1_ = i1;
+  auto &flx1 = iflx.x1f;
+  auto &flx2 = iflx.x2f;
+  auto &flx3 = iflx.x3f;
+
+  par_for("r_update_m1",DevExeSpace(),0,nmb1,ks,ke,js,je,is,ie,
+  KOKKOS_LAMBDA(int m, int k, int j, int i) {
+    Real q[NRMOM];
+    for (int n=0; n<NRMOM; ++n) {
+      Real divf_s = (flx1(m,n,k,j,i+1) - flx1(m,n,k,j,i))/mbsize.d_view(m).dx1;
+      if (multi_d) {
+        divf_s += (flx2(m,n,k,j+1,i) - flx2(m,n,k,j,i))/mbsize.d_view(m).dx2;
+      }
+      if (three_d) {
+        divf_s += (flx3(m,n,k+1,j,i) - flx3(m,n,k,j,i))/mbsize.d_view(m).dx3;
+      }
+      q[n] = gam0*i0_(m,n,k,j,i) + gam1*i1_(m,n,k,j,i) - beta_dt*divf_s;
+    }
+
+    // floor energy density and limit flux to causal values
+    q[IRE] = fmax(q[IRE], (FLT_MIN));
+    Real fmag = sqrt(SQR(q[IRF1]) + SQR(q[IRF2]) + SQR(q[IRF3]));
+    Real lim = (fmag > q[IRE])? q[IRE]/fmag : 1.0;
+    i0_(m,IRE, k,j,i) = q[IRE];
+    i0_(m,IRF1,k,j,i) = lim*q[IRF1];
+    i0_(m,IRF2,k,j,i) = lim*q[IRF2];
+    i0_(m,IRF3,k,j,i) = lim*q[IRF3];
+  });
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Radiation::NewTimeStepM1()
+//! \brief minimum timestep (dx/c) within a MeshBlockPack for M1 radiation problems.
+
+void Radiation::NewTimeStepM1() {
+  Real dt1 = std::numeric_limits<float>::max();
+  Real dt2 = std::numeric_limits<float>::max();
+  Real dt3 = std::numeric_limits<float>::max();
+
+  // timestep only depends on cell size, so reduce over MeshBlocks
+  auto &size = pmy_pack->pmb->mb_size;
+  const int nmb = pmy_pack->nmb_thispack;
+  Kokkos::parallel_reduce("RadiationM1Nudt",Kokkos::RangePolicy<>(DevExeSpace(), 0, nmb),
+  KOKKOS_LAMBDA(const int &m, Real &min_dt1, Real &min_dt2, Real &min_dt3) {
+    min_dt1 = fmin((size.d_view(m).dx1), min_dt1);
+    min_dt2 = fmin((size.d_view(m).dx2), min_dt2);
+    min_dt3 = fmin((size.d_view(m).dx3), min_dt3);
+  }, Kokkos::Min<Real>(dt1),  Kokkos::Min<Real>(dt2), Kokkos::Min<Real>(dt3));
+
+  // compute minimum of dt1/dt2/dt3 for 1D/2D/3D problems
+  dtnew = dt1;
+  if (pmy_pack->pmesh->multi_d) { dtnew = std::min(dtnew, dt2); }
+  if (pmy_pack->pmesh->three_d) { dtnew = std::min(dtnew, dt3); }
+
+  return;
+}
+
+} // namespace radiation
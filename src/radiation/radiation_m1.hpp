@@ -0,0 +1,40 @@
+#ifndef RADIATION_RADIATION_M1_HPP_
+#define RADIATION_RADIATION_M1_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file radiation_m1.hpp
+//! \brief implements closure for the grey M1 moment scheme as an inline function
+
+#include <math.h>
+
+#include "athena.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn void M1Closure
+//! \brief computes radiation pressure tensor P^{ij} from energy density e and flux f^i
+//! using the Levermore (1984) closure for the Eddington factor chi(|f|/e), which
+//! reduces to P^{ij} = e/3 delta^{ij} for isotropic radiation and to P^{ij} = e n^i n^j
+//! for free streaming along n^i = f^i/|f|.
+
+KOKKOS_INLINE_FUNCTION
+void M1Closure(const Real e, const Real f1, const Real f2, const Real f3,
+               Real p[3][3]) {
+  Real fmag = sqrt(SQR(f1) + SQR(f2) + SQR(f3));
+  Real ff = (e > 0.0)? fmin(fmag/e, 1.0) : 0.0;
+  Real chi = (3.0 + 4.0*SQR(ff))/(5.0 + 2.0*sqrt(4.0 - 3.0*SQR(ff)));
+  Real cdiff = 0.5*(1.0 - chi)*e;
+  Real cfree = (fmag > 0.0)? 0.5*(3.0*chi - 1.0)*e/SQR(fmag) : 0.0;
+  Real f[3] = {f1, f2, f3};
+  for (int a=0; a<3; ++a) {
+    for (int b=0; b<3; ++b) {
+      p[a][b] = cfree*f[a]*f[b];
+    }
+    p[a][a] += cdiff;
+  }
+  return;
+}
+
+#endif // RADIATION_RADIATION_M1_HPP_
@@ -16,6 +16,7 @@
 
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
+#include "coordinates/cartesian_ks.hpp"
 #include "coordinates/coordinates.hpp"
 #include "coordinates/cell_locations.hpp"
 #include "geodesic-grid/geodesic_grid.hpp"
@@ -31,6 +32,10 @@ namespace radiation {
 //        Only computed once at beginning of calculation.
 
 TaskStatus Radiation::NewTimeStep(Driver *pdriver, int stage) {
+  if (is_m1) {
+    NewTimeStepM1();
+    return TaskStatus::complete;
+  }
   auto &indcs = pmy_pack->pmesh->mb_indcs;
   int &is = indcs.is, &nx1 = indcs.nx1;
   int &js = indcs.js, &nx2 = indcs.nx2;
@@ -57,6 +62,12 @@ TaskStatus Radiation::NewTimeStep(Driver *pdriver, int stage) {
   auto &rad_mask_ = pmy_pack->pcoord->excision_floor;
   auto &numn = prgeo->num_neighbors;
   auto &indn = prgeo->ind_neighbors;
+  bool na_otf = na_on_the_fly;
+  auto &nh_f_ = nh_f;
+  auto &uflux = prgeo->unit_flux;
+  auto &coord = pmy_pack->pcoord->coord_data;
+  bool &flat = coord.is_minkowski;
+  Real &spin = coord.bh_spin;
 
   // find smallest (dx/c) and (dangle/na) in each direction for radiation problems
   Kokkos::parallel_reduce("RadiationNudt",Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
@@ -71,6 +82,19 @@ TaskStatus Radiation::NewTimeStep(Driver *pdriver, int stage) {
 
     Real tmp_min_dta = (FLT_MAX);
     if (angular_fluxes_) {
+      // rotation coefficients of tetrad, if n^a is computed on the fly
+      Real omega[4][4][4];
+      if (na_otf) {
+        Real x1v = CellCenterX(i-is, nx1, size.d_view(m).x1min, size.d_view(m).x1max);
+        Real x2v = CellCenterX(j-js, nx2, size.d_view(m).x2min, size.d_view(m).x2max);
+        Real x3v = CellCenterX(k-ks, nx3, size.d_view(m).x3min, size.d_view(m).x3max);
+        Real glower[4][4], gupper[4][4];
+        ComputeMetricAndInverse(x1v,x2v,x3v,flat,spin,glower,gupper);
+        Real dgx[4][4], dgy[4][4], dgz[4][4];
+        ComputeMetricDerivatives(x1v,x2v,x3v,flat,spin,dgx,dgy,dgz);
+        Real e[4][4], e_cov[4][4];
+        ComputeTetrad(x1v,x2v,x3v,flat,spin,glower,gupper,dgx,dgy,dgz,e,e_cov,omega);
+      }
       for (int n=0; n<=nang1; ++n) {
         // find position at angle center
         Real x = nh_c_.d_view(n,1);
@@ -83,7 +107,9 @@ TaskStatus Radiation::NewTimeStep(Driver *pdriver, int stage) {
           Real zn = nh_c_.d_view(indn.d_view(n,nb),3);
           // compute timestep limitation
           Real n0 = tet_c_(m,0,0,k,j,i);
-          Real adt = fmin(tmp_min_dta,(acos(x*xn+y*yn+z*zn)/fabs(na_(m,n,k,j,i,nb)/n0)));
+          Real nav = (na_otf)? AngularFluxCoeff(omega, nh_f_, uflux, n, nb) :
+                               na_(m,n,k,j,i,nb);
+          Real adt = fmin(tmp_min_dta,(acos(x*xn+y*yn+z*zn)/fabs(nav/n0)));
           // set timestep limitation if not excising this cell
           if (excise) {
             if (!(rad_mask_(m,k,j,i))) { tmp_min_dta = adt; }
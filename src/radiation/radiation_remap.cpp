@@ -0,0 +1,130 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file radiation_remap.cpp
+//  \brief remaps intensities between geodesic grids with different angular resolution
+
+#include <math.h>
+
+#include <vector>
+
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+#include "coordinates/coordinates.hpp"
+#include "geodesic-grid/geodesic_grid.hpp"
+#include "radiation.hpp"
+
+namespace radiation {
+//----------------------------------------------------------------------------------------
+//! \fn  void Radiation::RemapAngles()
+//! \brief Sets i0 from intensities iin (nmb,nang_in,n3,n2,n1) stored on a geodesic grid
+//! of level nlevel_in, e.g. when restarting with a different <radiation>/nlevel.
+//! Intensities in the tetrad frame, I = i0/(n^0 n_0), are remapped.  If the input
+//! grid is finer, each input angle is assigned to the nearest angle of the current grid
+//! and I is averaged over the input angles assigned to each angle, weighted by solid
+//! angle (restriction).  Otherwise, each angle takes I of the nearest input angle
+//! (prolongation by injection).  Restriction conserves the energy density in the tetrad
+//! frame, prolongation conserves it only to the accuracy of the coarser grid.
+
+void Radiation::RemapAngles(HostArray5D<Real> &iin, int nlevel_in) {
+  // geodesic grid on which input intensities are stored (nlevel=0 cannot be rotated)
+  GeodesicGrid src_geo(nlevel_in, (rotate_geo && nlevel_in > 0), false);
+  int nang_src = src_geo.nangles;
+  int nang_dst = prgeo->nangles;
+
+  // nearest angle of grid b to each angle of grid a
+  auto nearest = [](const DualArray2D<Real> &a, int na, const DualArray2D<Real> &b,
+                    int nb, std::vector<int> &near) {
+    near.resize(na);
+    for (int n=0; n<na; ++n) {
+      Real ra = sqrt(SQR(a.h_view(n,0)) + SQR(a.h_view(n,1)) + SQR(a.h_view(n,2)));
+      Real dmax = -2.0;
+      for (int l=0; l<nb; ++l) {
+        Real rb = sqrt(SQR(b.h_view(l,0)) + SQR(b.h_view(l,1)) + SQR(b.h_view(l,2)));
+        Real d = (a.h_view(n,0)*b.h_view(l,0) + a.h_view(n,1)*b.h_view(l,1) +
+                  a.h_view(n,2)*b.h_view(l,2))/(ra*rb);
+        if (d > dmax) {dmax = d; near[n] = l;}
+      }
+    }
+  };
+  std::vector<int> near_src, near_dst;
+  nearest(prgeo->cart_pos, nang_dst, src_geo.cart_pos, nang_src, near_src);
+  nearest(src_geo.cart_pos, nang_src, prgeo->cart_pos, nang_dst, near_dst);
+
+  // weights stored in compressed rows: row n contains input angles (and weights) that
+  // contribute to angle n of current grid
+  std::vector<std::vector<int>> rows(nang_dst);
+  if (nang_src > nang_dst) {
+    for (int l=0; l<nang_src; ++l) {rows[near_dst[l]].push_back(l);}
+  }
+  for (int n=0; n<nang_dst; ++n) {
+    if (rows[n].empty()) {rows[n].push_back(near_src[n]);}
+  }
+  DualArray1D<int> offset("remap_offset", nang_dst+1);
+  offset.h_view(0) = 0;
+  for (int n=0; n<nang_dst; ++n) {
+    offset.h_view(n+1) = offset.h_view(n) + static_cast<int>(rows[n].size());
+  }
+  DualArray1D<int> indx("remap_indx", offset.h_view(nang_dst));
+  DualArray1D<Real> wght("remap_wght", offset.h_view(nang_dst));
+  for (int n=0; n<nang_dst; ++n) {
+    Real wsum = 0.0;
+    for (int l : rows[n]) {wsum += src_geo.solid_angles.h_view(l);}
+    for (int r=0; r<static_cast<int>(rows[n].size()); ++r) {
+      int l = rows[n][r];
+      indx.h_view(offset.h_view(n) + r) = l;
+      wght.h_view(offset.h_view(n) + r) = src_geo.solid_angles.h_view(l)/wsum;
+    }
+  }
+  DualArray2D<Real> nh_src("remap_nh", nang_src, 4);
+  for (int l=0; l<nang_src; ++l) {
+    nh_src.h_view(l,0) = 1.0;
+    nh_src.h_view(l,1) = src_geo.cart_pos.h_view(l,0);
+    nh_src.h_view(l,2) = src_geo.cart_pos.h_view(l,1);
+    nh_src.h_view(l,3) = src_geo.cart_pos.h_view(l,2);
+  }
+
+  // sync dual arrays
+  offset.template modify<HostMemSpace>();
+  offset.template sync<DevExeSpace>();
+  indx.template modify<HostMemSpace>();
+  indx.template sync<DevExeSpace>();
+  wght.template modify<HostMemSpace>();
+  wght.template sync<DevExeSpace>();
+  nh_src.template modify<HostMemSpace>();
+  nh_src.template sync<DevExeSpace>();
+
+  // copy input intensities to device and remap in all cells (including ghost zones)
+  auto iin_d = Kokkos::create_mirror_view_and_copy(DevMemSpace(), iin);
+  int nmb1 = iin.extent_int(0) - 1;
+  int n3 = iin.extent_int(2), n2 = iin.extent_int(3), n1 = iin.extent_int(4);
+  auto &i0_ = i0;
+  auto &nh_c_ = nh_c;
+  auto &tt = tet_c;
+  auto &tc = tetcov_c;
+  bool &excise = pmy_pack->pcoord->coord_data.bh_excise;
+  Real &n_0_floor_ = n_0_floor;
+  par_for("rad_remap",DevExeSpace(),0,nmb1,0,nang_dst-1,0,n3-1,0,n2-1,0,n1-1,
+  KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
+    Real n0 = tt(m,0,0,k,j,i);
+    Real ii = 0.0;
+    for (int r=offset.d_view(n); r<offset.d_view(n+1); ++r) {
+      int l = indx.d_view(r);
+      Real n_0 = tc(m,0,0,k,j,i)*nh_src.d_view(l,0) + tc(m,1,0,k,j,i)*nh_src.d_view(l,1)
+               + tc(m,2,0,k,j,i)*nh_src.d_view(l,2) + tc(m,3,0,k,j,i)*nh_src.d_view(l,3);
+      // intensities in excised angles are zero
+      if (!(excise) || fabs(n_0) >= n_0_floor_) {
+        ii += wght.d_view(r)*iin_d(m,l,k,j,i)/(n0*n_0);
+      }
+    }
+    Real n_0 = tc(m,0,0,k,j,i)*nh_c_.d_view(n,0) + tc(m,1,0,k,j,i)*nh_c_.d_view(n,1) +
+               tc(m,2,0,k,j,i)*nh_c_.d_view(n,2) + tc(m,3,0,k,j,i)*nh_c_.d_view(n,3);
+    i0_(m,n,k,j,i) = n0*n_0*ii;
+  });
+
+  return;
+}
+
+} // namespace radiation
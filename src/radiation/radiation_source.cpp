@@ -21,6 +21,33 @@
 #include "radiation/radiation_tetrad.hpp"
 #include "radiation/radiation_opacities.hpp"
 
+//----------------------------------------------------------------------------------------
+//! \struct RadAngleSum
+//! \brief N sums over angles, so that all moments needed at one stage of the implicit
+//! source term solve can be computed in a single team reduction.  Used with Kokkos::Sum.
+
+template <int N>
+struct RadAngleSum {
+  Real s[N];
+  KOKKOS_INLINE_FUNCTION RadAngleSum() {
+    for (int l=0; l<N; ++l) {s[l] = 0.0;}
+  }
+  KOKKOS_INLINE_FUNCTION RadAngleSum& operator+=(const RadAngleSum& src) {
+    for (int l=0; l<N; ++l) {s[l] += src.s[l];}
+    return *this;
+  }
+  KOKKOS_INLINE_FUNCTION void operator+=(const volatile RadAngleSum& src) volatile {
+    for (int l=0; l<N; ++l) {s[l] += src.s[l];}
+  }
+};
+
+namespace Kokkos {  // reduction identity must be defined in Kokkos namespace
+template<int N>
+struct reduction_identity<RadAngleSum<N>> {
+  KOKKOS_FORCEINLINE_FUNCTION static RadAngleSum<N> sum() {return RadAngleSum<N>();}
+};
+}
+
 namespace radiation {
 
 KOKKOS_INLINE_FUNCTION
@@ -36,6 +63,10 @@ TaskStatus Radiation::AddRadiationSourceTerm(Driver *pdriver, int stage) {
   if (!(rad_source)) {
     return TaskStatus::complete;
   }
+  if (is_m1) {
+    AddRadiationSourceTermM1(pdriver, stage);
+    return TaskStatus::complete;
+  }
 
   // Extract indices, size data, hydro/mhd/units flags, and coupling flags
   auto &indcs = pmy_pack->pmesh->mb_indcs;
@@ -109,6 +140,20 @@ TaskStatus Radiation::AddRadiationSourceTerm(Driver *pdriver, int stage) {
   // Extract timestep
   Real dt_ = (pdriver->beta[stage-1])*(pmy_pack->pmesh->dt);
 
+  // Extract data needed for explicit RK update fused into team source term kernel
+  bool fused_update_ = fused_update;
+  Real gam0 = pdriver->gam0[stage-1];
+  Real gam1 = pdriver->gam1[stage-1];
+  auto &i1_ = i1;
+  auto &flx1 = iflx.x1f;
+  auto &flx2 = iflx.x2f;
+  auto &flx3 = iflx.x3f;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  bool &angular_fluxes_ = angular_fluxes;
+  auto &divfa_ = divfa;
+
   // Call ConsToPrim over active zones prior to source term application
   if (!(fixed_fluid_)) {
     if (is_hydro_enabled_) {
@@ -120,6 +165,302 @@ TaskStatus Radiation::AddRadiationSourceTerm(Driver *pdriver, int stage) {
     }
   }
 
+  // compute implicit source term with one team per cell, and team reductions over angles
+  if (team_source) {
+    par_for_outer("radiation_source_team",DevExeSpace(),0,0,0,nmb1,ks,ke,js,je,is,ie,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j,
+                  const int i) {
+      Real &x1min = size.d_view(m).x1min;
+      Real &x1max = size.d_view(m).x1max;
+      Real x1v = CellCenterX(i-is, indcs.nx1, x1min, x1max);
+
+      Real &x2min = size.d_view(m).x2min;
+      Real &x2max = size.d_view(m).x2max;
+      Real x2v = CellCenterX(j-js, indcs.nx2, x2min, x2max);
+
+      Real &x3min = size.d_view(m).x3min;
+      Real &x3max = size.d_view(m).x3max;
+      Real x3v = CellCenterX(k-ks, indcs.nx3, x3min, x3max);
+
+      // explicit RK update of intensities in this cell (same as in RKUpdate()), so they
+      // are still in cache when used in the implicit solve below
+      if (fused_update_) {
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member, nang1+1), [=](const int n) {
+          Real divf_s = (flx1(m,n,k,j,i+1) - flx1(m,n,k,j,i))/mbsize.d_view(m).dx1;
+          if (multi_d) {
+            divf_s += (flx2(m,n,k,j+1,i) - flx2(m,n,k,j,i))/mbsize.d_view(m).dx2;
+          }
+          if (three_d) {
+            divf_s += (flx3(m,n,k+1,j,i) - flx3(m,n,k,j,i))/mbsize.d_view(m).dx3;
+          }
+          Real inew = gam0*i0_(m,n,k,j,i) + gam1*i1_(m,n,k,j,i) - dt_*divf_s;
+          if (angular_fluxes_) { inew -= dt_*divfa_(m,n,k,j,i); }
+
+          // zero intensity if negative, and handle excision
+          Real tn0 = tt(m,0,0,k,j,i);
+          Real tn_0 = 0.0;
+          for (int d=0; d<4; ++d) {tn_0 += tc(m,d,0,k,j,i)*nh_c_.d_view(n,d);}
+          inew = tn0*tn_0*fmax((inew/(tn0*tn_0)), 0.0);
+          if (excise) {
+            if (rad_mask_(m,k,j,i) || fabs(tn_0) < n_0_floor_) { inew = 0.0; }
+          }
+          i0_(m,n,k,j,i) = inew;
+        });
+        member.team_barrier();
+      }
+
+      // compute metric and inverse (redundantly on every thread of the team)
+      Real glower[4][4], gupper[4][4];
+      ComputeMetricAndInverse(x1v,x2v,x3v,flat,spin,glower,gupper);
+      Real alpha = sqrt(-1.0/gupper[0][0]);
+
+      // fluid state
+      Real &wdn = w0_(m,IDN,k,j,i);
+      Real &wvx = w0_(m,IVX,k,j,i);
+      Real &wvy = w0_(m,IVY,k,j,i);
+      Real &wvz = w0_(m,IVZ,k,j,i);
+      Real &wen = w0_(m,IEN,k,j,i);
+
+      // derived quantities
+      Real pgas = gm1*wen;
+      Real tgas = pgas/wdn;
+      Real q = glower[1][1]*wvx*wvx + 2.0*glower[1][2]*wvx*wvy + 2.0*glower[1][3]*wvx*wvz
+             + glower[2][2]*wvy*wvy + 2.0*glower[2][3]*wvy*wvz
+             + glower[3][3]*wvz*wvz;
+      Real gamma = sqrt(1.0 + q);
+      Real u0 = gamma/alpha;
+
+      // set opacities
+      Real sigma_a, sigma_s, sigma_p;
+      OpacityFunction(wdn, density_scale_,
+                      tgas, temperature_scale_,
+                      length_scale_, gm1, mean_mol_weight_,
+                      power_opacity_, rosseland_coef_, planck_minus_rosseland_coef_,
+                      kappa_a_, kappa_s_, kappa_p_,
+                      sigma_a, sigma_s, sigma_p);
+      Real dtcsiga = dt_*sigma_a;
+      Real dtcsigs = dt_*sigma_s;
+      Real dtcsigp = dt_*sigma_p;
+      Real dtaucsiga = dtcsiga/u0;
+      Real dtaucsigs = dtcsigs/u0;
+      Real dtaucsigp = dtcsigp/u0;
+
+      // compute fluid velocity in tetrad frame
+      Real u_tet[4];
+      for (int d=0; d<4; ++d) {
+        u_tet[d] = (norm_to_tet_(m,d,0,k,j,i)*gamma + norm_to_tet_(m,d,1,k,j,i)*wvx +
+                    norm_to_tet_(m,d,2,k,j,i)*wvy   + norm_to_tet_(m,d,3,k,j,i)*wvz);
+      }
+
+      // coordinate component n^0
+      Real n0 = tt(m,0,0,k,j,i);
+
+      // Calculate polynomial coefficients
+      RadAngleSum<3> sum1;
+      Kokkos::parallel_reduce(Kokkos::TeamThreadRange(member, nang1+1),
+      [=](const int n, RadAngleSum<3>& sum) {
+        Real n_0 = tc(m,0,0,k,j,i)*nh_c_.d_view(n,0) + tc(m,1,0,k,j,i)*nh_c_.d_view(n,1)
+                 + tc(m,2,0,k,j,i)*nh_c_.d_view(n,2) + tc(m,3,0,k,j,i)*nh_c_.d_view(n,3);
+        Real n0_cm = (u_tet[0]*nh_c_.d_view(n,0) - u_tet[1]*nh_c_.d_view(n,1) -
+                      u_tet[2]*nh_c_.d_view(n,2) - u_tet[3]*nh_c_.d_view(n,3));
+        Real omega_cm = solid_angles_.d_view(n)/SQR(n0_cm);
+        Real intensity_cm = 4.0*M_PI*(i0_(m,n,k,j,i)/(n0*n_0))*SQR(SQR(n0_cm));
+        Real vncsigma = 1.0/(n0 + (dtcsiga + dtcsigs)*n0_cm);
+        Real vncsigma2 = n0_cm*vncsigma;
+        Real ir_weight = intensity_cm*omega_cm;
+        sum.s[0] += omega_cm;
+        sum.s[1] += omega_cm*vncsigma2;
+        sum.s[2] += ir_weight*n0*vncsigma;
+      }, Kokkos::Sum<RadAngleSum<3>>(sum1));
+      Real wght_sum = sum1.s[0];
+      Real suma1 = sum1.s[1]/wght_sum;
+      Real suma2 = sum1.s[2]/wght_sum;
+      Real suma3 = suma1*(dtcsigs - dtcsigp);
+      suma1 *= (dtcsiga + dtcsigp);
+
+      // compute coefficients
+      Real coef[2];
+      coef[1] = ((dtaucsiga+dtaucsigp-(dtaucsiga+dtaucsigp)*suma1/(1.0-suma3))*
+                 arad_*gm1/wdn);
+      coef[0] = -tgas-(dtaucsiga+dtaucsigp)*suma2*gm1/(wdn*(1.0-suma3));
+
+      // Calculate new gas temperature
+      Real tgasnew = tgas;
+      bool badcell = false;
+      if (fabs(coef[1]) > 1.0e-20) {
+        bool flag = FourthPolyRoot(coef[1], coef[0], tgasnew);
+        if (!(flag) || !(isfinite(tgasnew))) {
+          badcell = true;
+          tgasnew = tgas;
+        }
+      } else {
+        tgasnew = -coef[0];
+      }
+
+      // Update the specific intensity, with moments before (s[0-3]) and after (s[4-7])
+      if (!(badcell)) {
+        Real emission = arad_*SQR(SQR(tgasnew));
+        Real jr_cm = (suma1*emission + suma2)/(1.0 - suma3);
+        RadAngleSum<8> mom;
+        Kokkos::parallel_reduce(Kokkos::TeamThreadRange(member, nang1+1),
+        [=](const int n, RadAngleSum<8>& sum) {
+          // compute coordinate normal components
+          Real n_[4];
+          for (int d=0; d<4; ++d) {
+            n_[d] = tc(m,0,d,k,j,i)*nh_c_.d_view(n,0) + tc(m,1,d,k,j,i)*nh_c_.d_view(n,1)
+                  + tc(m,2,d,k,j,i)*nh_c_.d_view(n,2) + tc(m,3,d,k,j,i)*nh_c_.d_view(n,3);
+          }
+
+          // compute moments before coupling
+          Real domega = solid_angles_.d_view(n);
+          sum.s[0] += (      i0_(m,n,k,j,i)      *domega);
+          sum.s[1] += (n_[1]*i0_(m,n,k,j,i)/n_[0]*domega);
+          sum.s[2] += (n_[2]*i0_(m,n,k,j,i)/n_[0]*domega);
+          sum.s[3] += (n_[3]*i0_(m,n,k,j,i)/n_[0]*domega);
+
+          // update intensity
+          Real n0_cm = (u_tet[0]*nh_c_.d_view(n,0) - u_tet[1]*nh_c_.d_view(n,1) -
+                        u_tet[2]*nh_c_.d_view(n,2) - u_tet[3]*nh_c_.d_view(n,3));
+          Real intensity_cm = 4.0*M_PI*(i0_(m,n,k,j,i)/(n0*n_[0]))*SQR(SQR(n0_cm));
+          Real vncsigma = 1.0/(n0 + (dtcsiga + dtcsigs)*n0_cm);
+          Real vncsigma2 = n0_cm*vncsigma;
+          Real di_cm = ( ((dtcsigs-dtcsigp)*jr_cm
+                        + (dtcsiga+dtcsigp)*emission
+                        - (dtcsigs+dtcsiga)*intensity_cm)*vncsigma2 );
+          i0_(m,n,k,j,i) = n0*n_[0]*fmax(i0_(m,n,k,j,i)/(n0*n_[0]) +
+                                         di_cm/(4.0*M_PI*SQR(SQR(n0_cm))), 0.0);
+
+          // compute moments after coupling
+          sum.s[4] += (      i0_(m,n,k,j,i)      *domega);
+          sum.s[5] += (n_[1]*i0_(m,n,k,j,i)/n_[0]*domega);
+          sum.s[6] += (n_[2]*i0_(m,n,k,j,i)/n_[0]*domega);
+          sum.s[7] += (n_[3]*i0_(m,n,k,j,i)/n_[0]*domega);
+
+          // handle excision (see notes in cell-parallel kernel below)
+          if (excise) {
+            bool apply_excision = (rad_mask_(m,k,j,i) ||
+                                   (!(is_compton_enabled_) && fabs(n_[0]) < n_0_floor_));
+            if (apply_excision) { i0_(m,n,k,j,i) = 0.0; }
+          }
+        }, Kokkos::Sum<RadAngleSum<8>>(mom));
+
+        // update conserved fluid variables
+        if (affect_fluid_) {
+          Kokkos::single(Kokkos::PerTeam(member), [&]() {
+            u0_(m,IEN,k,j,i) += (mom.s[0] - mom.s[4]);
+            u0_(m,IM1,k,j,i) += (mom.s[1] - mom.s[5]);
+            u0_(m,IM2,k,j,i) += (mom.s[2] - mom.s[6]);
+            u0_(m,IM3,k,j,i) += (mom.s[3] - mom.s[7]);
+          });
+        }
+      }
+
+      // compton scattering
+      if (is_compton_enabled_) {
+        // intensities updated above may have been written by other threads of the team
+        member.team_barrier();
+
+        // use partially updated gas temperature
+        tgas = tgasnew;
+
+        // compute polynomial coefficients using partially updated gas temp and intensity
+        RadAngleSum<2> sum2;
+        Kokkos::parallel_reduce(Kokkos::TeamThreadRange(member, nang1+1),
+        [=](const int n, RadAngleSum<2>& sum) {
+          Real n_0 = tc(m,0,0,k,j,i)*nh_c_.d_view(n,0)+tc(m,1,0,k,j,i)*nh_c_.d_view(n,1)
+                   + tc(m,2,0,k,j,i)*nh_c_.d_view(n,2)+tc(m,3,0,k,j,i)*nh_c_.d_view(n,3);
+          Real n0_cm = (u_tet[0]*nh_c_.d_view(n,0) - u_tet[1]*nh_c_.d_view(n,1) -
+                        u_tet[2]*nh_c_.d_view(n,2) - u_tet[3]*nh_c_.d_view(n,3));
+          Real wght_cm = solid_angles_.d_view(n)/SQR(n0_cm)/wght_sum;
+          Real intensity_cm = 4.0*M_PI*(i0_(m,n,k,j,i)/(n0*n_0))*SQR(SQR(n0_cm));
+          sum.s[0] += (n0_cm/n0)*4.0*dtcsigs*inv_t_electron_*wght_cm;
+          sum.s[1] += intensity_cm*wght_cm;
+        }, Kokkos::Sum<RadAngleSum<2>>(sum2));
+        suma1 = sum2.s[0];
+        Real jr_cm = sum2.s[1];
+        suma2 = 4.0*dtaucsigs*inv_t_electron_*gm1/wdn;
+
+        // compute partially updated radiation temperature
+        Real trad = sqrt(sqrt(jr_cm/arad_));
+        const bool temp_equil = (fabs(trad - tgas) < 1.0e-12);
+
+        // Calculate new gas temperature due to Compton
+        Real tradnew = trad;
+        badcell = false;
+        if (!(temp_equil)) {
+          coef[1] = (1.0 + suma2*jr_cm)/(suma1*jr_cm)*arad_;
+          coef[0] = -(1.0 + suma2*jr_cm)/suma1 - tgas;
+          bool flag = FourthPolyRoot(coef[1], coef[0], tradnew);
+          if (!(flag) || !(isfinite(tradnew))) {
+            badcell = true;
+          }
+        }
+
+        // Update the specific intensity
+        if (!(badcell) && !(temp_equil)) {
+          // Compute updated gas temperature
+          tgasnew = (arad_*SQR(SQR(tradnew)) - jr_cm)/(suma1*jr_cm) + tradnew;
+          RadAngleSum<8> mom;
+          Kokkos::parallel_reduce(Kokkos::TeamThreadRange(member, nang1+1),
+          [=](const int n, RadAngleSum<8>& sum) {
+            // compute coordinate normal components
+            Real n_[4];
+            for (int d=0; d<4; ++d) {
+              n_[d] = tc(m,0,d,k,j,i)*nh_c_.d_view(n,0)+tc(m,1,d,k,j,i)*nh_c_.d_view(n,1)
+                    + tc(m,2,d,k,j,i)*nh_c_.d_view(n,2)+tc(m,3,d,k,j,i)*nh_c_.d_view(n,3);
+            }
+
+            // compute moments before coupling
+            Real domega = solid_angles_.d_view(n);
+            sum.s[0] += (      i0_(m,n,k,j,i)      *domega);
+            sum.s[1] += (n_[1]*i0_(m,n,k,j,i)/n_[0]*domega);
+            sum.s[2] += (n_[2]*i0_(m,n,k,j,i)/n_[0]*domega);
+            sum.s[3] += (n_[3]*i0_(m,n,k,j,i)/n_[0]*domega);
+
+            // update intensity
+            Real n0_cm = (u_tet[0]*nh_c_.d_view(n,0) - u_tet[1]*nh_c_.d_view(n,1) -
+                          u_tet[2]*nh_c_.d_view(n,2) - u_tet[3]*nh_c_.d_view(n,3));
+            Real di_cm = (n0_cm/n0)*dtcsigs*4.0*jr_cm*inv_t_electron_*(tgasnew - tradnew);
+            i0_(m,n,k,j,i) = n0*n_[0]*fmax(i0_(m,n,k,j,i)/(n0*n_[0]) +
+                                           di_cm/(4.0*M_PI*SQR(SQR(n0_cm))), 0.0);
+
+            // compute moments after coupling
+            sum.s[4] += (      i0_(m,n,k,j,i)      *domega);
+            sum.s[5] += (n_[1]*i0_(m,n,k,j,i)/n_[0]*domega);
+            sum.s[6] += (n_[2]*i0_(m,n,k,j,i)/n_[0]*domega);
+            sum.s[7] += (n_[3]*i0_(m,n,k,j,i)/n_[0]*domega);
+
+            // handle excision
+            if (excise) {
+              if (rad_mask_(m,k,j,i) || fabs(n_[0]) < n_0_floor_) {i0_(m,n,k,j,i) = 0.0;}
+            }
+          }, Kokkos::Sum<RadAngleSum<8>>(mom));
+
+          // feedback on fluid
+          if (affect_fluid_) {
+            Kokkos::single(Kokkos::PerTeam(member), [&]() {
+              u0_(m,IEN,k,j,i) += (mom.s[0] - mom.s[4]);
+              u0_(m,IM1,k,j,i) += (mom.s[1] - mom.s[5]);
+              u0_(m,IM2,k,j,i) += (mom.s[2] - mom.s[6]);
+              u0_(m,IM3,k,j,i) += (mom.s[3] - mom.s[7]);
+            });
+          }
+        } else if (excise) {
+          // apply excision delayed by Compton (see notes in cell-parallel kernel below)
+          Kokkos::parallel_for(Kokkos::TeamThreadRange(member, nang1+1),
+          [&](const int n) {
+            Real n_0 = tc(m,0,0,k,j,i)*nh_c_.d_view(n,0)+
+                       tc(m,1,0,k,j,i)*nh_c_.d_view(n,1)+
+                       tc(m,2,0,k,j,i)*nh_c_.d_view(n,2)+
+                       tc(m,3,0,k,j,i)*nh_c_.d_view(n,3);
+            if (rad_mask_(m,k,j,i) || fabs(n_0) < n_0_floor_) { i0_(m,n,k,j,i) = 0.0; }
+          });
+        }
+      }
+    });
+    return TaskStatus::complete;
+  }
+
   // compute implicit source term
   par_for("radiation_source",DevExeSpace(),0,nmb1,ks,ke,js,je,is,ie,
   KOKKOS_LAMBDA(int m, int k, int j, int i) {
@@ -392,6 +733,142 @@ TaskStatus Radiation::AddRadiationSourceTerm(Driver *pdriver, int stage) {
   return TaskStatus::complete;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void Radiation::AddRadiationSourceTermM1(Driver *pdriver, int stage)
+// \brief Add implicit grey source term for M1 moments in flat spacetime.  Absorption
+// and emission (with sigma_a+sigma_p) are solved implicitly together with the gas
+// temperature, and flux is damped by sigma_a+sigma_s.  Velocity dependent terms are
+// neglected, i.e. source terms are evaluated as if the fluid were at rest.
+
+void Radiation::AddRadiationSourceTermM1(Driver *pdriver, int stage) {
+  // Extract indices, size data, hydro/mhd/units flags, and coupling flags
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int &is = indcs.is, &ie = indcs.ie;
+  int &js = indcs.js, &je = indcs.je;
+  int &ks = indcs.ks, &ke = indcs.ke;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  bool &is_hydro_enabled_ = is_hydro_enabled;
+  bool &is_mhd_enabled_ = is_mhd_enabled;
+  bool &are_units_enabled_ = are_units_enabled;
+  bool &fixed_fluid_ = fixed_fluid;
+  bool &affect_fluid_ = affect_fluid;
+
+  // Extract radiation constant and units
+  Real &arad_ = arad;
+  Real density_scale_ = 1.0, temperature_scale_ = 1.0, length_scale_ = 1.0;
+  Real mean_mol_weight_ = 1.0;
+  Real rosseland_coef_ = 1.0, planck_minus_rosseland_coef_ = 0.0;
+  if (are_units_enabled_) {
+    density_scale_ = pmy_pack->punit->density_cgs();
+    temperature_scale_ = pmy_pack->punit->temperature_cgs();
+    length_scale_ = pmy_pack->punit->length_cgs();
+    mean_mol_weight_ = pmy_pack->punit->mu();
+    rosseland_coef_ = pmy_pack->punit->rosseland_coef_cgs;
+    planck_minus_rosseland_coef_ = pmy_pack->punit->planck_minus_rosseland_coef_cgs;
+  }
+
+  // Extract adiabatic index
+  Real gm1;
+  if (is_hydro_enabled_) {
+    gm1 = pmy_pack->phydro->peos->eos_data.gamma - 1.0;
+  } else if (is_mhd_enabled_) {
+    gm1 = pmy_pack->pmhd->peos->eos_data.gamma - 1.0;
+  }
+
+  // Extract radiation moments and opacities
+  auto &i0_ = i0;
+  Real &kappa_a_ = kappa_a;
+  Real &kappa_s_ = kappa_s;
+  Real &kappa_p_ = kappa_p;
+  bool &power_opacity_ = power_opacity;
+
+  // Extract hydro/mhd quantities
+  DvceArray5D<Real> u0_, w0_;
+  if (is_hydro_enabled_) {
+    u0_ = pmy_pack->phydro->u0;
+    w0_ = pmy_pack->phydro->w0;
+  } else if (is_mhd_enabled_) {
+    u0_ = pmy_pack->pmhd->u0;
+    w0_ = pmy_pack->pmhd->w0;
+  }
+
+  // Extract timestep
+  Real dt_ = (pdriver->beta[stage-1])*(pmy_pack->pmesh->dt);
+
+  // Call ConsToPrim over active zones prior to source term application
+  if (!(fixed_fluid_)) {
+    if (is_hydro_enabled_) {
+      pmy_pack->phydro->peos->ConsToPrim(u0_,w0_,false,is,ie,js,je,ks,ke);
+    } else if (is_mhd_enabled_) {
+      auto &b0_ = pmy_pack->pmhd->b0;
+      auto &bcc0_ = pmy_pack->pmhd->bcc0;
+      pmy_pack->pmhd->peos->ConsToPrim(u0_,b0_,w0_,bcc0_,false,is,ie,js,je,ks,ke);
+    }
+  }
+
+  par_for("radiation_source_m1",DevExeSpace(),0,nmb1,ks,ke,js,je,is,ie,
+  KOKKOS_LAMBDA(int m, int k, int j, int i) {
+    // fluid state
+    Real &wdn = w0_(m,IDN,k,j,i);
+    Real &wen = w0_(m,IEN,k,j,i);
+    Real tgas = gm1*wen/wdn;
+
+    // set opacities
+    Real sigma_a, sigma_s, sigma_p;
+    OpacityFunction(wdn, density_scale_,
+                    tgas, temperature_scale_,
+                    length_scale_, gm1, mean_mol_weight_,
+                    power_opacity_, rosseland_coef_, planck_minus_rosseland_coef_,
+                    kappa_a_, kappa_s_, kappa_p_,
+                    sigma_a, sigma_s, sigma_p);
+    Real dtcsige = dt_*(sigma_a + sigma_p);
+    Real dtcsigf = dt_*(sigma_a + sigma_s);
+
+    // moments before coupling
+    Real e_old = i0_(m,IRE,k,j,i);
+    Real f_old[3] = {i0_(m,IRF1,k,j,i), i0_(m,IRF2,k,j,i), i0_(m,IRF3,k,j,i)};
+
+    // Calculate new gas temperature from
+    // T_new - T + gm1/rho*dtcsige/(1+dtcsige)*(arad*T_new^4 - E) = 0
+    Real coef[2];
+    coef[1] = dtcsige/(1.0 + dtcsige)*arad_*gm1/wdn;
+    coef[0] = -tgas - dtcsige/(1.0 + dtcsige)*e_old*gm1/wdn;
+    Real tgasnew = tgas;
+    bool badcell = false;
+    if (fabs(coef[1]) > 1.0e-20) {
+      bool flag = FourthPolyRoot(coef[1], coef[0], tgasnew);
+      if (!(flag) || !(isfinite(tgasnew))) {
+        badcell = true;
+        tgasnew = tgas;
+      }
+    } else {
+      tgasnew = -coef[0];
+    }
+
+    // Update the moments
+    if (!(badcell)) {
+      Real emission = arad_*SQR(SQR(tgasnew));
+      Real e_new = (e_old + dtcsige*emission)/(1.0 + dtcsige);
+      Real f_new[3];
+      for (int d=0; d<3; ++d) { f_new[d] = f_old[d]/(1.0 + dtcsigf); }
+      i0_(m,IRE, k,j,i) = e_new;
+      i0_(m,IRF1,k,j,i) = f_new[0];
+      i0_(m,IRF2,k,j,i) = f_new[1];
+      i0_(m,IRF3,k,j,i) = f_new[2];
+
+      // update conserved fluid variables (IEN stores T^t_t, so energy sign is flipped)
+      if (affect_fluid_) {
+        u0_(m,IEN,k,j,i) += (e_new - e_old);
+        u0_(m,IM1,k,j,i) += (f_old[0] - f_new[0]);
+        u0_(m,IM2,k,j,i) += (f_old[1] - f_new[1]);
+        u0_(m,IM3,k,j,i) += (f_old[2] - f_new[2]);
+      }
+    }
+  });
+
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn  bool FourthPolyRoot
 //  \brief Exact solution for fourth order polynomial of
@@ -19,9 +19,11 @@
 #include "mesh/mesh.hpp"
 #include "eos/eos.hpp"
 #include "bvals/bvals.hpp"
+#include "driver/driver.hpp"
 #include "hydro/hydro.hpp"
 #include "mhd/mhd.hpp"
 #include "radiation/radiation.hpp"
+#include "utils/managed_memory.hpp"
 
 namespace radiation {
 //----------------------------------------------------------------------------------------
@@ -154,15 +156,20 @@ void Radiation::AssembleRadTasks(std::map<std::string, std::shared_ptr<TaskList>
 //  receive status flags to waiting (with or without MPI) for Radiation variables.
 
 TaskStatus Radiation::InitRecv(Driver *pdrive, int stage) {
+  // tetrads may have been evicted from device memory
+  ManagedMemory::Prefetch(tet_c);
+  ManagedMemory::Prefetch(tetcov_c);
+  ManagedMemory::Prefetch(norm_to_tet);
+
   // post receives for I
-  TaskStatus tstat = pbval_i->InitRecv(prgeo->nangles);
+  TaskStatus tstat = pbval_i->InitRecv(nrad);
   if (tstat != TaskStatus::complete) return tstat;
 
   // do not post receives for fluxes when stage < 0 (i.e. ICs)
   if (stage >= 0) {
     // with SMR/AMR, post receives for fluxes of I
     if (pmy_pack->pmesh->multilevel) {
-      tstat = pbval_i->InitFluxRecv(prgeo->nangles);
+      tstat = pbval_i->InitFluxRecv(nrad);
       if (tstat != TaskStatus::complete) return tstat;
     }
   }
@@ -172,24 +179,37 @@ TaskStatus Radiation::InitRecv(Driver *pdrive, int stage) {
 
 //----------------------------------------------------------------------------------------
 //! \fn  void Radiation::CopyCons
-//  \brief  copy u0 --> u1 in first stage
+//  \brief  copy i0 --> i1 in first stage.  With 2S low-storage integrators (rk4,
+//  ssprk104), i1 is also updated with i0 at later stages.  The conserved variables of
+//  hydro or MHD (if enabled) are updated by their own CopyCons functions, since their
+//  tasks are not queued separately when coupled to radiation.
 
 TaskStatus Radiation::CopyCons(Driver *pdrive, int stage) {
   if (stage == 1) {
-    // radiation
     Kokkos::deep_copy(DevExeSpace(), i1, i0);
+  } else if (pdrive->use_delta) {
+    auto &indcs = pmy_pack->pmesh->mb_indcs;
+    int is = indcs.is, ie = indcs.ie;
+    int js = indcs.js, je = indcs.je;
+    int ks = indcs.ks, ke = indcs.ke;
+    int nmb1 = pmy_pack->nmb_thispack - 1;
+    int nvar = i0.extent_int(1);
+    auto &i0_ = i0;
+    auto &i1_ = i1;
+    RadReal delta = static_cast<RadReal>(pdrive->delta[stage-1]);
+    par_for("2s_copy_rad", DevExeSpace(), 0, nmb1, 0, nvar-1, ks, ke, js, je, is, ie,
+    KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
+      i1_(m,n,k,j,i) += delta*i0_(m,n,k,j,i);
+    });
+  }
 
-    // hydro and MHD (if enabled)
-    hydro::Hydro *phyd = pmy_pack->phydro;
-    mhd::MHD *pmhd = pmy_pack->pmhd;
-    if (pmhd != nullptr) {
-      Kokkos::deep_copy(DevExeSpace(), pmhd->u1, pmhd->u0);
-      Kokkos::deep_copy(DevExeSpace(), pmhd->b1.x1f, pmhd->b0.x1f);
-      Kokkos::deep_copy(DevExeSpace(), pmhd->b1.x2f, pmhd->b0.x2f);
-      Kokkos::deep_copy(DevExeSpace(), pmhd->b1.x3f, pmhd->b0.x3f);
-    } else if (phyd != nullptr) {
-      Kokkos::deep_copy(DevExeSpace(), phyd->u1, phyd->u0);
-    }
+  // hydro and MHD (if enabled)
+  hydro::Hydro *phyd = pmy_pack->phydro;
+  mhd::MHD *pmhd = pmy_pack->pmhd;
+  if (pmhd != nullptr) {
+    (void) pmhd->CopyCons(pdrive, stage);
+  } else if (phyd != nullptr) {
+    (void) phyd->CopyCons(pdrive, stage);
   }
   return TaskStatus::complete;
 }
@@ -274,8 +294,10 @@ TaskStatus Radiation::ApplyPhysicalBCs(Driver *pdrive, int stage) {
   }
 
   // user BCs
-  if (pmy_pack->pmesh->pgen->user_bcs) {
-    (pmy_pack->pmesh->pgen->user_bcs_func)(pmy_pack->pmesh);
+  // user BCs may instead be defined as a device hook applied in HydroBCs()
+  auto &pgen = pmy_pack->pmesh->pgen;
+  if (pgen->user_bcs && pgen->user_bcs_func != nullptr) {
+    (pgen->user_bcs_func)(pmy_pack->pmesh);
   }
 
   return TaskStatus::complete;
@@ -35,28 +35,27 @@ void Radiation::SetOrthonormalTetrad() {
   int &ks = indcs.ks;
   int &nmb = pmy_pack->nmb_thispack;
 
-  int nang1 = prgeo->nangles - 1;
-  auto &num_neighbors_ = prgeo->num_neighbors;
+  int nang1 = nrad - 1;
   auto nh_c_ = nh_c;
 
   auto &coord = pmy_pack->pcoord->coord_data;
   bool &flat = coord.is_minkowski;
   Real &spin = coord.bh_spin;
 
-  // define tetrad frame
-  for (int n=0; n<=nang1; ++n) {
+  // define tetrad frame (M1 does not use an angular mesh)
+  for (int n=0; n<=nang1 && !(is_m1); ++n) {
     nh_c.h_view(n,0) = 1.0;
     nh_c.h_view(n,1) = prgeo->cart_pos.h_view(n,0);
     nh_c.h_view(n,2) = prgeo->cart_pos.h_view(n,1);
     nh_c.h_view(n,3) = prgeo->cart_pos.h_view(n,2);
     if (angular_fluxes) {
-      for (int nb=0; nb<num_neighbors_.h_view(n); ++nb) {
+      for (int nb=0; nb<prgeo->num_neighbors.h_view(n); ++nb) {
         nh_f.h_view(n,nb,0) = 1.0;
         nh_f.h_view(n,nb,1) = prgeo->cart_pos_mid.h_view(n,nb,0);
         nh_f.h_view(n,nb,2) = prgeo->cart_pos_mid.h_view(n,nb,1);
         nh_f.h_view(n,nb,3) = prgeo->cart_pos_mid.h_view(n,nb,2);
       }
-      if (num_neighbors_.h_view(n)==5) {
+      if (prgeo->num_neighbors.h_view(n)==5) {
         nh_f.h_view(n,5,0) = (FLT_MAX);
         nh_f.h_view(n,5,1) = (FLT_MAX);
         nh_f.h_view(n,5,2) = (FLT_MAX);
@@ -175,8 +174,9 @@ void Radiation::SetOrthonormalTetrad() {
     for (int d=0; d<4; ++d) { tet_d3_x3f_(m,d,k,j,i) = e[d][3]; }
   });
 
-  // Calculate n^angle
-  if (angular_fluxes) {
+  // Calculate n^angle (unless computed on the fly in the flux and timestep kernels)
+  if (angular_fluxes && !(na_on_the_fly)) {
+    auto &num_neighbors_ = prgeo->num_neighbors;
     auto uflux = prgeo->unit_flux;
     auto nh_f_ = nh_f;
     auto na_ = na;
@@ -202,18 +202,7 @@ void Radiation::SetOrthonormalTetrad() {
       ComputeTetrad(x1v,x2v,x3v,flat,spin,glower,gupper,dgx,dgy,dgz,e,e_cov,omega);
       for (int n=0; n<=nang1; ++n) {
         for (int nb=0; nb<num_neighbors_.d_view(n); ++nb) {
-          Real iszetaf = 1.0/sqrt(1.0 - SQR(nh_f_.d_view(n,nb,3)));
-          Real na1 = 0.0; Real na2 = 0.0;
-          for (int q=0; q<4; ++q) {
-            for (int p=0; p<4; ++p) {
-              Real nhfqp = nh_f_.d_view(n,nb,q)*nh_f_.d_view(n,nb,p);
-              na1 += (nhfqp*(nh_f_.d_view(n,nb,0)*omega[3][q][p] -
-                             nh_f_.d_view(n,nb,3)*omega[0][q][p]));
-              na2 += (nhfqp*(nh_f_.d_view(n,nb,2)*omega[1][q][p] -
-                             nh_f_.d_view(n,nb,1)*omega[2][q][p]));
-            }
-          }
-          na_(m,n,k,j,i,nb) = iszetaf*na1*uflux.d_view(n,nb,0)+na2*uflux.d_view(n,nb,1);
+          na_(m,n,k,j,i,nb) = AngularFluxCoeff(omega, nh_f_, uflux, n, nb);
         }
       }
     });
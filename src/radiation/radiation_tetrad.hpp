@@ -180,4 +180,23 @@ void ComputeTetrad(Real x, Real y, Real z, const bool minkowski, const Real a,
   return;
 }
 
+// computes angular flux coefficient n^a at edge nb of angle n from the Ricci rotation
+// coefficients omega of the tetrad
+KOKKOS_INLINE_FUNCTION
+Real AngularFluxCoeff(const Real omega[][4][4], const DualArray3D<Real> &nh_f,
+                      const DualArray3D<Real> &uflux, const int n, const int nb) {
+  Real iszetaf = 1.0/sqrt(1.0 - SQR(nh_f.d_view(n,nb,3)));
+  Real na1 = 0.0; Real na2 = 0.0;
+  for (int q=0; q<4; ++q) {
+    for (int p=0; p<4; ++p) {
+      Real nhfqp = nh_f.d_view(n,nb,q)*nh_f.d_view(n,nb,p);
+      na1 += (nhfqp*(nh_f.d_view(n,nb,0)*omega[3][q][p] -
+                     nh_f.d_view(n,nb,3)*omega[0][q][p]));
+      na2 += (nhfqp*(nh_f.d_view(n,nb,2)*omega[1][q][p] -
+                     nh_f.d_view(n,nb,1)*omega[2][q][p]));
+    }
+  }
+  return iszetaf*na1*uflux.d_view(n,nb,0) + na2*uflux.d_view(n,nb,1);
+}
+
 #endif // RADIATION_RADIATION_TETRAD_HPP_
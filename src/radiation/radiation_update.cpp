@@ -26,6 +26,12 @@ namespace radiation {
 //  \brief Explicit RK update of flux divergence and physical source terms
 
 TaskStatus Radiation::RKUpdate(Driver *pdriver, int stage) {
+  if (is_m1) {
+    RKUpdateM1(pdriver, stage);
+    return TaskStatus::complete;
+  }
+  // update is instead applied in AddRadiationSourceTerm()
+  if (fused_update) {return TaskStatus::complete;}
   auto &indcs = pmy_pack->pmesh->mb_indcs;
   int &is = indcs.is, &ie = indcs.ie;
   int &js = indcs.js, &je = indcs.je;
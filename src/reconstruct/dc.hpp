@@ -7,6 +7,9 @@
 //========================================================================================
 //! \file dc.hpp
 //! \brief piecewise constant (donor cell) reconstruction implemented as inline functions
+//! The optional arguments (nl,nu) of the wrapper functions in this and the other
+//! reconstruct/ files restrict the reconstruction to variables nl..nu of q (default all
+//! variables), so that different variables can be reconstructed with different methods.
 
 #include "athena.hpp"
 
@@ -16,12 +19,14 @@
 //! Therefore range of indices for which BOTH L/R states returned is il+1 to il-1
 //! This function should be called over [is-1,ie+1] to get BOTH L/R states over [is,ie]
 
+template <typename QArray>
 KOKKOS_INLINE_FUNCTION
 void DonorCellX1(TeamMember_t const &member, const int m, const int k, const int j,
-     const int il, const int iu, const DvceArray5D<Real> &q,
-     ScrArray2D<Real> &ql, ScrArray2D<Real> &qr) {
-  int nvar = q.extent_int(1);
-  for (int n=0; n<nvar; ++n) {
+     const int il, const int iu, const QArray &q,
+     ScrArray2D<Real> &ql, ScrArray2D<Real> &qr,
+     const int nl=0, const int nu=-1) {
+  int nvar = (nu < 0)? q.extent_int(1) : nu+1;
+  for (int n=nl; n<nvar; ++n) {
     par_for_inner(member, il, iu, [&](const int i) {
       ql(n,i+1) = q(m,n,k,j,i);
       qr(n,i  ) = q(m,n,k,j,i);
@@ -35,12 +40,14 @@ void DonorCellX1(TeamMember_t const &member, const int m, const int k, const int
 //! \brief For each cell-centered value q(j), returns ql(j+1) and qr(j) over il to iu.
 //! This function should be called over [js-1,je+1] to get BOTH L/R states over [js,je]
 
+template <typename QArray>
 KOKKOS_INLINE_FUNCTION
 void DonorCellX2(TeamMember_t const &member, const int m, const int k, const int j,
-     const int il, const int iu, const DvceArray5D<Real> &q,
-     ScrArray2D<Real> &ql_jp1, ScrArray2D<Real> &qr_j) {
-  int nvar = q.extent_int(1);
-  for (int n=0; n<nvar; ++n) {
+     const int il, const int iu, const QArray &q,
+     ScrArray2D<Real> &ql_jp1, ScrArray2D<Real> &qr_j,
+     const int nl=0, const int nu=-1) {
+  int nvar = (nu < 0)? q.extent_int(1) : nu+1;
+  for (int n=nl; n<nvar; ++n) {
     par_for_inner(member, il, iu, [&](const int i) {
       ql_jp1(n,i) = q(m,n,k,j,i);
       qr_j  (n,i) = q(m,n,k,j,i);
@@ -54,12 +61,14 @@ void DonorCellX2(TeamMember_t const &member, const int m, const int k, const int
 //! \brief For each cell-centered value q(k), returns ql(k+1) and qr(k) over il to iu.
 //! This function should be called over [ks-1,ke+1] to get BOTH L/R states over [ks,ke]
 
+template <typename QArray>
 KOKKOS_INLINE_FUNCTION
 void DonorCellX3(TeamMember_t const &member, const int m, const int k, const int j,
-     const int il, const int iu, const DvceArray5D<Real> &q,
-     ScrArray2D<Real> &ql_kp1, ScrArray2D<Real> &qr_k) {
-  int nvar = q.extent_int(1);
-  for (int n=0; n<nvar; ++n) {
+     const int il, const int iu, const QArray &q,
+     ScrArray2D<Real> &ql_kp1, ScrArray2D<Real> &qr_k,
+     const int nl=0, const int nu=-1) {
+  int nvar = (nu < 0)? q.extent_int(1) : nu+1;
+  for (int n=nl; n<nvar; ++n) {
     par_for_inner(member, il, iu, [&](const int i) {
       ql_kp1(n,i) = q(m,n,k,j,i);
       qr_k  (n,i) = q(m,n,k,j,i);
@@ -0,0 +1,90 @@
+#ifndef RECONSTRUCT_JUMP_INDICATOR_HPP_
+#define RECONSTRUCT_JUMP_INDICATOR_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file jump_indicator.hpp
+//! \brief smoothness indicator used by the hybrid Riemann solver (<hydro>/rsolver_hybrid
+//! or <mhd>/rsolver_hybrid).  It is evaluated over a whole row of faces from the L/R
+//! states returned by the reconstruction, so that every thread of a team calls the same
+//! Riemann solver for the row.  A row is smooth if at every face the relative jump in
+//! density and pressure (and in MHD the jump in the cell-centered field, relative to the
+//! total pressure) is below tol.  Smooth rows use the HLLE solver, and all other rows the
+//! more accurate (and more expensive) solver selected by rsolver.  Each row is counted in
+//! nrow(0) if it uses rsolver, or in nrow(1) if it uses HLLE, for the event log.
+
+#include "athena.hpp"
+#include "eos/eos.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn Real FacePressure()
+//! \brief Returns pressure of primitive state w at face i, or (for an isothermal EOS)
+//! d*cs^2.
+
+KOKKOS_INLINE_FUNCTION
+Real FacePressure(const EOS_Data &eos, const ScrArray2D<Real> &w, const int i) {
+  if (eos.is_ideal) {
+    // primitive in IEN is internal energy, or temperature T = p/d
+    return (eos.use_e)? eos.IdealGasPressure(w(IEN,i)) : w(IDN,i)*w(IEN,i);
+  }
+  return w(IDN,i)*SQR(eos.iso_cs);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool SmoothRow()
+//! \brief Returns true (on all threads of the team) if the jumps between the L/R states
+//! at every face in [il,iu] are below tol.  Hydrodynamics version.
+
+KOKKOS_INLINE_FUNCTION
+bool SmoothRow(TeamMember_t const &member, const EOS_Data &eos, const int il,
+               const int iu, const ScrArray2D<Real> &wl, const ScrArray2D<Real> &wr,
+               const Real tol, const DvceArray1D<int> &nrow) {
+  Real jmax = 0.0;
+  Kokkos::parallel_reduce(Kokkos::TeamVectorRange(member, il, iu+1),
+  [&](const int i, Real &jm) {
+    Real jd = fabs(wr(IDN,i) - wl(IDN,i))/fmin(wl(IDN,i), wr(IDN,i));
+    Real pl = FacePressure(eos, wl, i);
+    Real pr = FacePressure(eos, wr, i);
+    Real jp = fabs(pr - pl)/fmin(pl, pr);
+    jm = fmax(jm, fmax(jd, jp));
+  }, Kokkos::Max<Real>(jmax));
+  bool smooth = (jmax < tol);
+  Kokkos::single(Kokkos::PerTeam(member), [&]() {
+    Kokkos::atomic_increment(&nrow((smooth)? 1 : 0));
+  });
+  return smooth;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool SmoothRow()
+//! \brief MHD version, which also tests the jump in the cell-centered field bl/br (which
+//! in a rotational discontinuity is the only jump).
+
+KOKKOS_INLINE_FUNCTION
+bool SmoothRow(TeamMember_t const &member, const EOS_Data &eos, const int il,
+               const int iu, const ScrArray2D<Real> &wl, const ScrArray2D<Real> &wr,
+               const ScrArray2D<Real> &bl, const ScrArray2D<Real> &br, const Real tol,
+               const DvceArray1D<int> &nrow) {
+  Real jmax = 0.0;
+  Kokkos::parallel_reduce(Kokkos::TeamVectorRange(member, il, iu+1),
+  [&](const int i, Real &jm) {
+    Real jd = fabs(wr(IDN,i) - wl(IDN,i))/fmin(wl(IDN,i), wr(IDN,i));
+    Real bsql = SQR(bl(0,i)) + SQR(bl(1,i)) + SQR(bl(2,i));
+    Real bsqr = SQR(br(0,i)) + SQR(br(1,i)) + SQR(br(2,i));
+    Real pl = FacePressure(eos, wl, i) + 0.5*bsql;
+    Real pr = FacePressure(eos, wr, i) + 0.5*bsqr;
+    Real jp = fabs(pr - pl)/fmin(pl, pr);
+    Real db2 = SQR(br(0,i) - bl(0,i)) + SQR(br(1,i) - bl(1,i)) + SQR(br(2,i) - bl(2,i));
+    Real jb = sqrt(0.5*db2/fmin(pl, pr));
+    jm = fmax(jm, fmax(jd, fmax(jp, jb)));
+  }, Kokkos::Max<Real>(jmax));
+  bool smooth = (jmax < tol);
+  Kokkos::single(Kokkos::PerTeam(member), [&]() {
+    Kokkos::atomic_increment(&nrow((smooth)? 1 : 0));
+  });
+  return smooth;
+}
+
+#endif // RECONSTRUCT_JUMP_INDICATOR_HPP_
@@ -0,0 +1,74 @@
+#ifndef RECONSTRUCT_SCRATCH_WINDOW_HPP_
+#define RECONSTRUCT_SCRATCH_WINDOW_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file scratch_window.hpp
+//! \brief Sliding window of rows of a cell-centered array held in team scratch memory.
+//! Used by flux kernels that sweep in x2 (or x3) within a team: each row of the input
+//! array is loaded from global memory once and then shared by all reconstructions whose
+//! stencil includes it, rather than being re-read 2*NS+1 times, where NS is the
+//! half-width of the stencil.  The window is indexed exactly like the DvceArray5D it
+//! caches, so it can be passed directly to the reconstruction functions.
+
+#include "athena.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \struct ScrWindow
+//! \brief Ring buffer of rows (n,row%nrow,i), where row is j for DIR=2 and k for DIR=3
+
+template <int DIR>
+struct ScrWindow {
+  ScrArray3D<Real> buf;
+  int nrow;
+  KOKKOS_INLINE_FUNCTION
+  Real &operator()(const int m, const int n, const int k, const int j,
+                   const int i) const {
+    if constexpr (DIR == 2) {
+      return buf(n, j%nrow, i);
+    } else {
+      return buf(n, k%nrow, i);
+    }
+  }
+  KOKKOS_INLINE_FUNCTION
+  int extent_int(const int d) const {
+    return (d == 1)? buf.extent_int(0) : 0;
+  }
+};
+
+//----------------------------------------------------------------------------------------
+//! \fn ScrWindowHalfWidth()
+//! \brief Returns half-width of the stencil of a reconstruction method, which sets the
+//! number of rows (2*NS+1) held in a ScrWindow
+
+KOKKOS_INLINE_FUNCTION
+int ScrWindowHalfWidth(const ReconstructionMethod recon) {
+  switch (recon) {
+    case ReconstructionMethod::dc:
+      return 0;
+    case ReconstructionMethod::plm:
+      return 1;
+    default:  // ppm4, ppmx, and wenoz
+      return 2;
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn LoadScrWindowRow()
+//! \brief Copies row (k,j) of q over [il,iu] into the window, replacing the oldest row
+
+template <int DIR>
+KOKKOS_INLINE_FUNCTION
+void LoadScrWindowRow(TeamMember_t const &member, const int m, const int k, const int j,
+     const int il, const int iu, const DvceArray5D<Real> &q, const ScrWindow<DIR> &win) {
+  int nvar = q.extent_int(1);
+  for (int n=0; n<nvar; ++n) {
+    par_for_inner(member, il, iu, [&](const int i) {
+      win(m,n,k,j,i) = q(m,n,k,j,i);
+    });
+  }
+  return;
+}
+#endif // RECONSTRUCT_SCRATCH_WINDOW_HPP_
@@ -86,15 +86,17 @@ void WENOZ(const Real &q_im2, const Real &q_im1, const Real &q_i, const Real &q_
 //! \brief Wrapper function for WENOZ reconstruction in x1-direction.
 //! This function should be called over [is-1,ie+1] to get BOTH L/R states over [is,ie]
 
+template <typename QArray>
 KOKKOS_INLINE_FUNCTION
 void WENOZX1(TeamMember_t const &member, const EOS_Data &eos, const bool apply_floors,
      const int m, const int k, const int j, const int il, const int iu,
-     const DvceArray5D<Real> &q, ScrArray2D<Real> &ql, ScrArray2D<Real> &qr) {
-  int nvar = q.extent_int(1);
+     const QArray &q, ScrArray2D<Real> &ql, ScrArray2D<Real> &qr,
+     const int nl=0, const int nu=-1) {
+  int nvar = (nu < 0)? q.extent_int(1) : nu+1;
   const Real &dfloor_ = eos.dfloor;
   // TODO(jmstone): ideal gas only for now
   Real efloor_ = eos.pfloor/(eos.gamma - 1.0);
-  for (int n=0; n<nvar; ++n) {
+  for (int n=nl; n<nvar; ++n) {
     par_for_inner(member, il, iu, [&](const int i) {
       Real &qim2 = q(m,n,k,j,i-2);
       Real &qim1 = q(m,n,k,j,i-1);
@@ -122,15 +124,17 @@ void WENOZX1(TeamMember_t const &member, const EOS_Data &eos, const bool apply_f
 //! \brief Wrapper function for WENOZ reconstruction in x1-direction.
 //! This function should be called over [js-1,je+1] to get BOTH L/R states over [js,je]
 
+template <typename QArray>
 KOKKOS_INLINE_FUNCTION
 void WENOZX2(TeamMember_t const &member, const EOS_Data &eos, const bool apply_floors,
      const int m, const int k, const int j, const int il, const int iu,
-     const DvceArray5D<Real> &q, ScrArray2D<Real> &ql_jp1, ScrArray2D<Real> &qr_j) {
-  int nvar = q.extent_int(1);
+     const QArray &q, ScrArray2D<Real> &ql_jp1, ScrArray2D<Real> &qr_j,
+     const int nl=0, const int nu=-1) {
+  int nvar = (nu < 0)? q.extent_int(1) : nu+1;
   const Real &dfloor_ = eos.dfloor;
   // TODO(jmstone): ideal gas only for now
   Real efloor_ = eos.pfloor/(eos.gamma - 1.0);
-  for (int n=0; n<nvar; ++n) {
+  for (int n=nl; n<nvar; ++n) {
     par_for_inner(member, il, iu, [&](const int i) {
       Real &qjm2 = q(m,n,k,j-2,i);
       Real &qjm1 = q(m,n,k,j-1,i);
@@ -158,15 +162,17 @@ void WENOZX2(TeamMember_t const &member, const EOS_Data &eos, const bool apply_f
 //! \brief Wrapper function for WENOZ reconstruction in x1-direction.
 //! This function should be called over [ks-1,ke+1] to get BOTH L/R states over [ks,ke]
 
+template <typename QArray>
 KOKKOS_INLINE_FUNCTION
 void WENOZX3(TeamMember_t const &member, const EOS_Data &eos, const bool apply_floors,
      const int m, const int k, const int j, const int il, const int iu,
-     const DvceArray5D<Real> &q, ScrArray2D<Real> &ql_kp1, ScrArray2D<Real> &qr_k) {
-  int nvar = q.extent_int(1);
+     const QArray &q, ScrArray2D<Real> &ql_kp1, ScrArray2D<Real> &qr_k,
+     const int nl=0, const int nu=-1) {
+  int nvar = (nu < 0)? q.extent_int(1) : nu+1;
   const Real &dfloor_ = eos.dfloor;
   // TODO(jmstone): ideal gas only for now
   Real efloor_ = eos.pfloor/(eos.gamma - 1.0);
-  for (int n=0; n<nvar; ++n) {
+  for (int n=nl; n<nvar; ++n) {
     par_for_inner(member, il, iu, [&](const int i) {
       Real &qkm2 = q(m,n,k-2,j,i);
       Real &qkm1 = q(m,n,k-1,j,i);
@@ -37,6 +37,8 @@ OrbitalAdvectionCC::OrbitalAdvectionCC(MeshBlockPack *pp, ParameterInput *pin, i
   for (int n=0; n<2; ++n) {
     Kokkos::realloc(sendbuf[n].vars,nmb,nv,ncells3,ncells2,ncells1);
     Kokkos::realloc(recvbuf[n].vars,nmb,nv,ncells3,ncells2,ncells1);
+    sendbuf[n].vars_mpi = Kokkos::create_mirror_view(MPIBuffMemSpace(), sendbuf[n].vars);
+    recvbuf[n].vars_mpi = Kokkos::create_mirror_view(MPIBuffMemSpace(), recvbuf[n].vars);
   }
 }
 
@@ -129,6 +131,11 @@ TaskStatus OrbitalAdvectionCC::PackAndSendCC(DvceArray5D<Real> &a) {
 #if MPI_PARALLEL_ENABLED
   // Send boundary buffer to neighboring MeshBlocks using MPI
   Kokkos::fence();
+#if !(GPU_AWARE_MPI_ENABLED)
+  for (int n=0; n<2; ++n) {
+    Kokkos::deep_copy(sbuf[n].vars_mpi, sbuf[n].vars);
+  }
+#endif
   bool no_errors=true;
   for (int m=0; m<nmb; ++m) {
     for (int n=0; n<2; ++n) {
@@ -146,7 +153,7 @@ TaskStatus OrbitalAdvectionCC::PackAndSendCC(DvceArray5D<Real> &a) {
 
           // get ptr to send buffer when neighbor is at coarser/same/fine level
           using Kokkos::ALL;
-          auto send_ptr = Kokkos::subview(sbuf[n].vars, m, ALL, ALL, ALL, ALL);
+          auto send_ptr = Kokkos::subview(sbuf[n].vars_mpi, m, ALL, ALL, ALL, ALL);
           int data_size = send_ptr.size();
 
           int ierr = MPI_Isend(send_ptr.data(), data_size, MPI_ATHENA_REAL, drank, tag,
@@ -209,6 +216,21 @@ TaskStatus OrbitalAdvectionCC::RecvAndUnpackCC(DvceArray5D<Real> &a,
   }
   // exit if recv boundary buffer communications have not completed
   if (bflag) {return TaskStatus::incomplete;}
+#if !(GPU_AWARE_MPI_ENABLED)
+  // copy buffers received with MPI from host-pinned mirrors to device
+  for (int m=0; m<nmb; ++m) {
+    for (int n=0; n<2; ++n) {
+      int nnghbr;
+      if (n==0) {nnghbr=8;} else {nnghbr=12;}
+      if ( (nghbr.h_view(m,nnghbr).gid >= 0) &&
+           (nghbr.h_view(m,nnghbr).rank != global_variable::my_rank) ) {
+        using Kokkos::ALL;
+        Kokkos::deep_copy(Kokkos::subview(rbuf[n].vars, m, ALL, ALL, ALL, ALL),
+                          Kokkos::subview(rbuf[n].vars_mpi, m, ALL, ALL, ALL, ALL));
+      }
+    }
+  }
+#endif
 #endif
 
   //----- STEP 2: buffers have all completed, so unpack and apply shift
@@ -245,8 +267,12 @@ TaskStatus OrbitalAdvectionCC::RecvAndUnpackCC(DvceArray5D<Real> &a,
     Real yshear = -qom*x1v*dt;
     int joffset = static_cast<int>(yshear/(mbsize.d_view(m).dx2));
 
-    // Load scratch array with no shift
-    par_for_inner(member, 0, (nfx-1), [&](const int jf) {
+    // Load scratch array with no shift.  The integer part of the shift is applied as an
+    // index offset into scratch, so only the window of cells [jfs-joffset,jfe-joffset]
+    // plus the two-cell stencil of the remap fluxes has to be read from memory.
+    int jwl = (jfs-joffset-2 > 0)? (jfs-joffset-2) : 0;
+    int jwu = (jfe-joffset+2 < nfx-1)? (jfe-joffset+2) : (nfx-1);
+    par_for_inner(member, jwl, jwu, [&](const int jf) {
       if (jf < jfs) {
         // Load from L boundary buffer
         a_(jf) = rbuf[0].vars(m,n,(k-ks),jf,(i-is));
@@ -37,6 +37,8 @@ OrbitalAdvectionFC::OrbitalAdvectionFC(MeshBlockPack *pp, ParameterInput *pin) :
   for (int n=0; n<2; ++n) {
     Kokkos::realloc(sendbuf[n].vars,nmb,2,ncells3,ncells2,ncells1);
     Kokkos::realloc(recvbuf[n].vars,nmb,2,ncells3,ncells2,ncells1);
+    sendbuf[n].vars_mpi = Kokkos::create_mirror_view(MPIBuffMemSpace(), sendbuf[n].vars);
+    recvbuf[n].vars_mpi = Kokkos::create_mirror_view(MPIBuffMemSpace(), recvbuf[n].vars);
   }
 }
 
@@ -125,6 +127,11 @@ TaskStatus OrbitalAdvectionFC::PackAndSendFC(DvceFaceFld4D<Real> &b) {
 #if MPI_PARALLEL_ENABLED
   // Send boundary buffer to neighboring MeshBlocks using MPI
   Kokkos::fence();
+#if !(GPU_AWARE_MPI_ENABLED)
+  for (int n=0; n<2; ++n) {
+    Kokkos::deep_copy(sbuf[n].vars_mpi, sbuf[n].vars);
+  }
+#endif
   bool no_errors=true;
   for (int m=0; m<nmb; ++m) {
     for (int n=0; n<2; ++n) {
@@ -142,7 +149,7 @@ TaskStatus OrbitalAdvectionFC::PackAndSendFC(DvceFaceFld4D<Real> &b) {
 
           // get ptr to send buffer when neighbor is at coarser/same/fine level
           using Kokkos::ALL;
-          auto send_ptr = Kokkos::subview(sbuf[n].vars, m, ALL, ALL, ALL, ALL);
+          auto send_ptr = Kokkos::subview(sbuf[n].vars_mpi, m, ALL, ALL, ALL, ALL);
           int data_size = send_ptr.size();
 
           int ierr = MPI_Isend(send_ptr.data(), data_size, MPI_ATHENA_REAL, drank, tag,
@@ -207,6 +214,21 @@ TaskStatus OrbitalAdvectionFC::RecvAndUnpackFC(DvceFaceFld4D<Real> &b0,
   }
   // exit if recv boundary buffer communications have not completed
   if (bflag) {return TaskStatus::incomplete;}
+#if !(GPU_AWARE_MPI_ENABLED)
+  // copy buffers received with MPI from host-pinned mirrors to device
+  for (int m=0; m<nmb; ++m) {
+    for (int n=0; n<2; ++n) {
+      int nnghbr;
+      if (n==0) {nnghbr=8;} else {nnghbr=12;}
+      if ( (nghbr.h_view(m,nnghbr).gid >= 0) &&
+           (nghbr.h_view(m,nnghbr).rank != global_variable::my_rank) ) {
+        using Kokkos::ALL;
+        Kokkos::deep_copy(Kokkos::subview(rbuf[n].vars, m, ALL, ALL, ALL, ALL),
+                          Kokkos::subview(rbuf[n].vars_mpi, m, ALL, ALL, ALL, ALL));
+      }
+    }
+  }
+#endif
 #endif
 
   //----- STEP 2: buffers have all completed, so unpack and compute effective EMF
@@ -254,8 +276,14 @@ TaskStatus OrbitalAdvectionFC::RecvAndUnpackFC(DvceFaceFld4D<Real> &b0,
     Real yshear = -qom*x1*dt;
     int joffset = static_cast<int>(yshear/(mbsize.d_view(m).dx2));
 
-    // Load scratch array with no shift
-    par_for_inner(member, 0, (nfx-1), [&](const int jf) {
+    // Load scratch array with no shift.  Only the window of cells needed by the remap
+    // fluxes (shifted by the integer offset) and by the sums of integer offsets into
+    // the EMFs is read from memory.
+    int jwl = ((joffset > 0)? (jfs-joffset) : jfs) - 2;
+    int jwu = ((joffset < 0)? (jfe-joffset) : jfe) + 2;
+    if (jwl < 0) {jwl = 0;}
+    if (jwu > nfx-1) {jwu = nfx-1;}
+    par_for_inner(member, jwl, jwu, [&](const int jf) {
       if (jf < jfs) {
         // Load from L boundary buffer
         b0_(jf) = rbuf[0].vars(m,v,(k-ks),jf,(i-is));
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "athena.hpp"
+#include "globals.hpp"
 #include "parameter_input.hpp"
 #include "mesh/mesh.hpp"
 #include "shearing_box.hpp"
@@ -56,6 +57,7 @@ ShearingBoxBoundary::ShearingBoxBoundary(MeshBlockPack *ppack, ParameterInput *p
   // sync with device
   x1bndry_mbgid.template modify<HostMemSpace>();
   x1bndry_mbgid.template sync<DevExeSpace>();
+  SetTargetMBs();
 
 
 #if MPI_PARALLEL_ENABLED
@@ -74,7 +76,7 @@ ShearingBoxBoundary::ShearingBoxBoundary(MeshBlockPack *ppack, ParameterInput *p
     }
   }
   // create unique communicators for shearing box
-  MPI_Comm_dup(MPI_COMM_WORLD, &comm_sbox);
+  MPI_Comm_dup(global_variable::athena_comm, &comm_sbox);
 #endif
 }
 
@@ -93,20 +95,38 @@ ShearingBoxBoundary::~ShearingBoxBoundary() {
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn void ShearingBoxBoundary::FindTargetMB()
-//! \brief  function to find target MB offset by shear.  Returns GID and rank
+//! \fn void ShearingBoxBoundary::SetTargetMBs()
+//! \brief Stores GID and rank of the MB offset by every possible number of MBs in the x2
+//! direction from each MB at x1 boundaries, and index in x1bndry arrays of each MB.
+//! Searches the MeshBlockTree once, rather than for each target on every stage.
 
-void ShearingBoxBoundary::FindTargetMB(const int igid, const int jshift, int &gid,
-                                       int &rank) {
+void ShearingBoxBoundary::SetTargetMBs() {
   Mesh *pm = pmy_pack->pmesh;
-  // find lloc of input MB
-  LogicalLocation lloc = pm->lloc_eachmb[igid];
-  // find number of MBs in x2 direction at this level
-  std::int32_t nmbx2 = pm->nmb_rootx2 << (lloc.level - pm->root_level);
-  // apply shift by input number of blocks
-  lloc.lx2 = static_cast<std::int32_t>((lloc.lx2 + jshift) % nmbx2);
-  // find target GID and rank
-  gid = (pm->ptree->FindMeshBlock(lloc))->GetGID();
-  rank = pm->rank_eachmb[gid];
+  int nmb = pmy_pack->nmb_thispack;
+  Kokkos::realloc(target_nmbx2, nmb);
+  Kokkos::realloc(x1bndry_indx, 2, nmb);
+  int nmbx2_max = 1;
+  for (int m=0; m<nmb; ++m) {
+    LogicalLocation &lloc = pm->lloc_eachmb[m + pmy_pack->gids];
+    target_nmbx2(m) = pm->nmb_rootx2 << (lloc.level - pm->root_level);
+    nmbx2_max = std::max(nmbx2_max, target_nmbx2(m));
+    x1bndry_indx(0,m) = -1;
+    x1bndry_indx(1,m) = -1;
+  }
+  Kokkos::realloc(target_gid, nmb, nmbx2_max);
+  Kokkos::realloc(target_rank, nmb, nmbx2_max);
+  for (int n=0; n<2; ++n) {
+    for (int mb=0; mb<nmb_x1bndry(n); ++mb) {
+      int m = x1bndry_mbgid.h_view(n,mb) - pmy_pack->gids;
+      x1bndry_indx(n,m) = mb;
+      for (int j=0; j<target_nmbx2(m); ++j) {
+        LogicalLocation lloc = pm->lloc_eachmb[m + pmy_pack->gids];
+        lloc.lx2 = static_cast<std::int32_t>((lloc.lx2 + j) % target_nmbx2(m));
+        int gid = (pm->ptree->FindMeshBlock(lloc))->GetGID();
+        target_gid(m,j) = gid;
+        target_rank(m,j) = pm->rank_eachmb[gid];
+      }
+    }
+  }
   return;
 }
@@ -38,6 +38,9 @@ struct ShearingBoxTaskIDs {
 struct ShearingBoxBoundaryBuffer {
   // Views that store buffer data and fluxes on device
   DvceArray5D<Real> vars, flux;
+  // buffer data passed to MPI.  With GPU-aware MPI (or without MPI) this is the same View
+  // as vars, otherwise it is a host-pinned mirror
+  Kokkos::View<Real*****, LayoutWrapper, MPIBuffMemSpace> vars_mpi;
 #if MPI_PARALLEL_ENABLED
   // vectors of length (number of MBs) to hold MPI requests
   // Using STL vector causes problems with some GPU compilers, so just use plain C array
@@ -128,19 +131,32 @@ class ShearingBoxBoundary {
   TaskStatus ClearRecv();
   TaskStatus ClearSend();
   // function to find target MB offset by shear.  Returns GID and rank
-  void FindTargetMB(const int igid, const int jshift, int &gid, int &rank);
-  // function to find index in x1bndry array of MB with input GID
+  void FindTargetMB(const int igid, const int jshift, int &gid, int &rank) {
+    int m = igid - pmy_pack->gids;
+    int nmbx2 = target_nmbx2(m);
+    int j = ((jshift % nmbx2) + nmbx2) % nmbx2;
+    gid = target_gid(m,j);
+    rank = target_rank(m,j);
+  }
+  // function to find index in x1bndry array of MB with input GID (on this rank)
   int TargetIndex(const int n, const int tgid) {
-    for (int m=0; m<nmb_x1bndry(n); ++m) {
-      if (x1bndry_mbgid.h_view(n,m) == tgid) return m;
-    }
-    return -1;
+    return x1bndry_indx(n, tgid - pmy_pack->gids);
   }
 
  protected:
   // must use pointer to MBPack and not parent physics module since parent can be one of
   // many types (Hydro, MHD, Radiation, etc.)
   MeshBlockPack *pmy_pack;
+
+ private:
+  // Targets of every possible shift of each MB at x1 boundaries, and index of each MB
+  // in x1bndry arrays, precomputed once so that no searches of the MeshBlockTree are
+  // needed when boundary buffers are communicated on each stage.
+  HostArray1D<int> target_nmbx2;   // number of MBs in x2 at level of each MB
+  HostArray2D<int> target_gid;     // GID of MB shifted by j MBs in x2 from each MB
+  HostArray2D<int> target_rank;    // rank of MB shifted by j MBs in x2 from each MB
+  HostArray2D<int> x1bndry_indx;   // index in x1bndry_mbgid of each MB (or -1)
+  void SetTargetMBs();
 };
 
 //----------------------------------------------------------------------------------------
@@ -37,6 +37,8 @@ ShearingBoxBoundaryCC::ShearingBoxBoundaryCC(MeshBlockPack *pp, ParameterInput *
     int nmb = std::max(1,nmb_x1bndry(n));
     Kokkos::realloc(sendbuf[n].vars,nmb,ncells2,nvar,ncells3,ncells1);
     Kokkos::realloc(recvbuf[n].vars,nmb,ncells2,nvar,ncells3,ncells1);
+    sendbuf[n].vars_mpi = Kokkos::create_mirror_view(MPIBuffMemSpace(), sendbuf[n].vars);
+    recvbuf[n].vars_mpi = Kokkos::create_mirror_view(MPIBuffMemSpace(), recvbuf[n].vars);
   }
 }
 
@@ -123,8 +125,14 @@ TaskStatus ShearingBoxBoundaryCC::PackAndSendCC(DvceArray5D<Real> &a,
   //    to three separate target MBs.
   //  * Case2 is when the sending MB straddles the boundary between MBs, and so requires
   //    copy/send to only two target MBs.
-  // Use deep copy if target MB on same rank, or MPI sends if not
+  // Use deep copy if target MB on same rank, or MPI sends if not.  Without GPU-aware MPI,
+  // data is sent from, and copies on the same rank go into, the host-pinned mirrors.
   Kokkos::fence();
+#if MPI_PARALLEL_ENABLED && !(GPU_AWARE_MPI_ENABLED)
+  for (int n=0; n<2; ++n) {
+    Kokkos::deep_copy(sendbuf[n].vars_mpi, sendbuf[n].vars);
+  }
+#endif
   const int &nx2 = indcs.nx2;
   bool no_errors=true;
   for (int n=0; n<2; ++n) {
@@ -165,12 +173,12 @@ TaskStatus ShearingBoxBoundaryCC::PackAndSendCC(DvceArray5D<Real> &a,
             int tm = TargetIndex(n,tgid);
             using Kokkos::ALL;
             auto src = subview(sendbuf[n].vars,m, jsrc[l],ALL,ALL,ALL);
-            auto dst = subview(recvbuf[n].vars,tm,jdst[l],ALL,ALL,ALL);
+            auto dst = subview(recvbuf[n].vars_mpi,tm,jdst[l],ALL,ALL,ALL);
             deep_copy(DevExeSpace(), dst, src);
 #if MPI_PARALLEL_ENABLED
           } else {
             using Kokkos::ALL;
-            auto send_ptr = subview(sendbuf[n].vars,m,jsrc[l],ALL,ALL,ALL);
+            auto send_ptr = subview(sendbuf[n].vars_mpi,m,jsrc[l],ALL,ALL,ALL);
             // create tag using GID of *receiving* MeshBlock
             int tag = CreateBvals_MPI_Tag(tgid, ((n<<2) | l));
             int data_size = send_ptr.size();
@@ -204,12 +212,12 @@ TaskStatus ShearingBoxBoundaryCC::PackAndSendCC(DvceArray5D<Real> &a,
             int tm = TargetIndex(n,tgid);
             using Kokkos::ALL;
             auto src = subview(sendbuf[n].vars,m, jsrc[l],ALL,ALL,ALL);
-            auto dst = subview(recvbuf[n].vars,tm,jdst[l],ALL,ALL,ALL);
+            auto dst = subview(recvbuf[n].vars_mpi,tm,jdst[l],ALL,ALL,ALL);
             deep_copy(DevExeSpace(), dst, src);
 #if MPI_PARALLEL_ENABLED
           } else {
             using Kokkos::ALL;
-            auto send_ptr = subview(sendbuf[n].vars,m,jsrc[l],ALL,ALL,ALL);
+            auto send_ptr = subview(sendbuf[n].vars_mpi,m,jsrc[l],ALL,ALL,ALL);
             // create tag using GID of *receiving* MeshBlock
             int tag = CreateBvals_MPI_Tag(tgid, ((n<<2) | l));
             int data_size = send_ptr.size();
@@ -247,12 +255,12 @@ TaskStatus ShearingBoxBoundaryCC::PackAndSendCC(DvceArray5D<Real> &a,
             int tm = TargetIndex(n,tgid);
             using Kokkos::ALL;
             auto src = subview(sendbuf[n].vars,m, jsrc[l],ALL,ALL,ALL);
-            auto dst = subview(recvbuf[n].vars,tm,jdst[l],ALL,ALL,ALL);
+            auto dst = subview(recvbuf[n].vars_mpi,tm,jdst[l],ALL,ALL,ALL);
             deep_copy(DevExeSpace(), dst, src);
 #if MPI_PARALLEL_ENABLED
           } else {
             using Kokkos::ALL;
-            auto send_ptr = subview(sendbuf[n].vars,m,jsrc[l],ALL,ALL,ALL);
+            auto send_ptr = subview(sendbuf[n].vars_mpi,m,jsrc[l],ALL,ALL,ALL);
             // create tag using GID of *receiving* MeshBlock
             int tag = CreateBvals_MPI_Tag(tgid, ((n<<2) | l));
             int data_size = send_ptr.size();
@@ -354,6 +362,12 @@ TaskStatus ShearingBoxBoundaryCC::RecvAndUnpackCC(DvceArray5D<Real> &a) {
   }
   // exit if recv boundary buffer communications have not completed
   if (bflag) {return TaskStatus::incomplete;}
+#if !(GPU_AWARE_MPI_ENABLED)
+  // copy recv buffers from host-pinned mirrors to device
+  for (int n=0; n<2; ++n) {
+    Kokkos::deep_copy(recvbuf[n].vars, recvbuf[n].vars_mpi);
+  }
+#endif
 #endif
 
   //----- STEP 2: communications have all completed, so unpack and apply shift
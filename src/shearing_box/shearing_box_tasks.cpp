@@ -46,7 +46,7 @@ TaskStatus OrbitalAdvection::InitRecv() {
 
           // get pointer to variables
           using Kokkos::ALL;
-          auto recv_ptr = Kokkos::subview(recvbuf[n].vars, m, ALL, ALL, ALL, ALL);
+          auto recv_ptr = Kokkos::subview(recvbuf[n].vars_mpi, m, ALL, ALL, ALL, ALL);
           int data_size = recv_ptr.size();
 
           // Post non-blocking receive for this buffer on this MeshBlock
@@ -187,7 +187,8 @@ TaskStatus ShearingBoxBoundary::InitRecv(Real qom, Real time) {
 
             // get pointer to variables
             using Kokkos::ALL;
-            auto recv_ptr = Kokkos::subview(recvbuf[n].vars, m, jdst[l], ALL, ALL, ALL);
+            auto recv_ptr = Kokkos::subview(recvbuf[n].vars_mpi, m, jdst[l],
+                                            ALL, ALL, ALL);
             int data_size = recv_ptr.size();
 
             // Post non-blocking receive for this buffer on this MeshBlock
@@ -218,7 +219,8 @@ TaskStatus ShearingBoxBoundary::InitRecv(Real qom, Real time) {
 
             // get pointer to variables
             using Kokkos::ALL;
-            auto recv_ptr = Kokkos::subview(recvbuf[n].vars, m, jdst[l], ALL, ALL, ALL);
+            auto recv_ptr = Kokkos::subview(recvbuf[n].vars_mpi, m, jdst[l],
+                                            ALL, ALL, ALL);
             int data_size = recv_ptr.size();
 
             // Post non-blocking receive for this buffer on this MeshBlock
@@ -251,7 +253,8 @@ TaskStatus ShearingBoxBoundary::InitRecv(Real qom, Real time) {
 
             // get pointer to variables
             using Kokkos::ALL;
-            auto recv_ptr = Kokkos::subview(recvbuf[n].vars, m, jdst[l], ALL, ALL, ALL);
+            auto recv_ptr = Kokkos::subview(recvbuf[n].vars_mpi, m, jdst[l],
+                                            ALL, ALL, ALL);
             int data_size = recv_ptr.size();
 
             // Post non-blocking receive for this buffer on this MeshBlock
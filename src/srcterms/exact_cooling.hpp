@@ -0,0 +1,119 @@
+#ifndef SRCTERMS_EXACT_COOLING_HPP_
+#define SRCTERMS_EXACT_COOLING_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file exact_cooling.hpp
+//! \brief table of the temporal evolution function (TEF) used to integrate optically thin
+//! cooling exactly, following Townsend, ApJS 181, 391 (2009).  With the cooling function
+//! approximated by a power law Lambda_k (T/T_k)^alpha_k between tabulated temperatures
+//! T_k, the TEF
+//!    Y(T) = (Lambda(T_ref)/T_ref) int_T^T_ref dT'/Lambda(T')
+//! and its inverse are known in closed form in each interval, and the temperature after
+//! cooling for dt at constant density is
+//!    T(t+dt) = Y^{-1}[Y(T) + (gamma-1) n dt Lambda(T_ref)/(k_B T_ref)]
+//! which is stable and accurate for any dt, so cooling does not limit the timestep.
+
+#include <cmath>
+
+#include "athena.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \struct ExactCoolingTable
+//! \brief TEF at temperatures uniformly spaced in log(T), stored on the device.  The last
+//! temperature in the table is the reference temperature T_ref.
+
+struct ExactCoolingTable {
+  int ntab;              // number of temperatures in table
+  Real logt_min, dlogt;  // log10 of lowest temperature in table, and spacing of log10(T)
+  Real tref;             // reference temperature (highest in table)
+  // (ntab,3) Lambda(T_k)/Lambda(T_ref), power-law index in [T_k,T_k+1], and Y(T_k)
+  DualArray2D<Real> data;
+
+  ExactCoolingTable() : ntab(0), logt_min(0.0), dlogt(1.0), tref(1.0),
+                        data("cool_table",1,1) {}
+
+  // Builds table of ntab temperatures in [tmin,tmax] for cooling function f(T)
+  template <typename F>
+  void Build(const F &f, const int n, const Real tmin, const Real tmax) {
+    ntab = n;
+    logt_min = log10(tmin);
+    dlogt = (log10(tmax) - logt_min)/static_cast<Real>(ntab - 1);
+    tref = tmax;
+    Kokkos::realloc(data, ntab, 3);
+    Real lref = f(tref);
+    for (int k=0; k<ntab; ++k) {data.h_view(k,0) = f(Temperature(k))/lref;}
+    for (int k=0; k<ntab-1; ++k) {
+      data.h_view(k,1) = log10(data.h_view(k+1,0)/data.h_view(k,0))/dlogt;
+    }
+    data.h_view(ntab-1,1) = data.h_view(ntab-2,1);
+    // Y(T_ref) = 0, and integrate downwards in T
+    data.h_view(ntab-1,2) = 0.0;
+    for (int k=ntab-2; k>=0; --k) {
+      data.h_view(k,2) = data.h_view(k+1,2) - Segment(k, Temperature(k+1));
+    }
+    data.template modify<HostMemSpace>();
+    data.template sync<DevExeSpace>();
+  }
+
+  // temperature of entry k
+  KOKKOS_INLINE_FUNCTION
+  Real Temperature(const int k) const {
+    return pow(10.0, logt_min + static_cast<Real>(k)*dlogt);
+  }
+
+  // Y(T) - Y(T_k) for T in interval k, evaluated on the host
+  Real Segment(const int k, const Real temp) const {
+    Real tk = Temperature(k);
+    Real lk = data.h_view(k,0), alpha = data.h_view(k,1);
+    Real c = tk/(tref*lk);
+    if (fabs(alpha - 1.0) < 1.0e-12) {
+      return c*log(tk/temp);
+    }
+    return c/(1.0 - alpha)*(1.0 - pow(tk/temp, alpha - 1.0));
+  }
+
+  // TEF Y(T), evaluated on the device
+  KOKKOS_INLINE_FUNCTION
+  Real TEF(const Real temp) const {
+    Real x = (log10(temp) - logt_min)/dlogt;
+    if (x <= 0.0) {return data.d_view(0,2);}
+    int k = static_cast<int>(x);
+    k = (k < ntab-2)? k : ntab-2;
+    Real tk = Temperature(k);
+    Real lk = data.d_view(k,0), alpha = data.d_view(k,1);
+    Real c = tk/(tref*lk);
+    if (fabs(alpha - 1.0) < 1.0e-12) {
+      return data.d_view(k,2) + c*log(tk/temp);
+    }
+    return data.d_view(k,2) + c/(1.0 - alpha)*(1.0 - pow(tk/temp, alpha - 1.0));
+  }
+
+  // inverse of TEF, evaluated on the device.  Temperatures below the table are set to
+  // the lowest temperature in the table.
+  KOKKOS_INLINE_FUNCTION
+  Real InverseTEF(const Real y) const {
+    if (y >= data.d_view(0,2)) {return Temperature(0);}
+    // Y decreases with T, find interval k with Y(T_k) > y >= Y(T_k+1)
+    int lo = 0, hi = ntab - 2;
+    while (lo < hi) {
+      int mid = (lo + hi + 1)/2;
+      if (data.d_view(mid,2) > y) {
+        lo = mid;
+      } else {
+        hi = mid - 1;
+      }
+    }
+    Real tk = Temperature(lo);
+    Real lk = data.d_view(lo,0), alpha = data.d_view(lo,1);
+    Real dy = (y - data.d_view(lo,2))*tref*lk/tk;
+    if (fabs(alpha - 1.0) < 1.0e-12) {
+      return tk*exp(-dy);
+    }
+    return tk*pow(1.0 - (1.0 - alpha)*dy, 1.0/(1.0 - alpha));
+  }
+};
+
+#endif // SRCTERMS_EXACT_COOLING_HPP_
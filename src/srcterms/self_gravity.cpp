@@ -0,0 +1,407 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file self_gravity.cpp
+//  \brief implementation of functions in SelfGravity.  Poisson's equation
+//    -Lap(phi) = -4 pi G (rho - <rho>)
+//  is solved in each stage of the integrator with a matrix-free conjugate gradient (CG)
+//  method on the second-order Laplacian, started from the potential of the previous
+//  stage so that few iterations are usually needed.  With <self_gravity>/precond =
+//  multigrid, CG is preconditioned with one geometric multigrid V-cycle within each
+//  MeshBlock (see utils/block_multigrid.hpp).  Currently limited to strictly periodic
+//  uniform meshes.
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "hydro/hydro.hpp"
+#include "mhd/mhd.hpp"
+#include "driver/driver.hpp"
+#include "eos/eos.hpp"
+#include "bvals/bvals.hpp"
+#include "self_gravity.hpp"
+#include "utils/block_multigrid.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+//----------------------------------------------------------------------------------------
+// constructor, initializes data structures and parameters
+
+SelfGravity::SelfGravity(MeshBlockPack *pp, ParameterInput *pin) :
+  pmy_pack(pp),
+  phi("phi",1,1,1,1,1),
+  cg_p("cg_p",1,1,1,1,1),
+  cg_r("cg_r",1,1,1,1),
+  cg_q("cg_q",1,1,1,1),
+  cg_z("cg_z",1,1,1,1) {
+  four_pi_G = pin->GetReal("self_gravity", "four_pi_G");
+  max_iter = pin->GetOrAddInteger("self_gravity", "max_iter", 100);
+  tol = pin->GetOrAddReal("self_gravity", "tol", 1.0e-8);
+  niter = 0;
+  std::string precond = pin->GetOrAddString("self_gravity", "precond", "none");
+  use_mg = (precond.compare("multigrid") == 0);
+  if (!(use_mg) && precond.compare("none") != 0) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<self_gravity>/precond = '" << precond << "' not implemented, valid "
+              << "choices are [none,multigrid]" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
+  if (!(pmy_pack->pmesh->strictly_periodic) || pmy_pack->pmesh->multilevel ||
+      pmy_pack->pmesh->nmb_packs_thisrank > 1 || pmy_pack->pionn != nullptr ||
+      pmy_pack->pcoord->is_special_relativistic ||
+      pmy_pack->pcoord->is_general_relativistic) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Self-gravity only implemented for non-relativistic single-fluid Hydro "
+              << "or MHD on strictly periodic uniform meshes with one MeshBlockPack per "
+              << "rank" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  if (pmy_pack->phydro != nullptr && pmy_pack->phydro->fused_c2p) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Self-gravity cannot be used with <hydro>/fused_c2p=true" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
+  // allocate memory for potential and CG vectors
+  int nmb = std::max((pmy_pack->nmb_thispack), (pmy_pack->pmesh->nmb_maxperrank));
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int ncells1 = indcs.nx1 + 2*(indcs.ng);
+  int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
+  int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
+  Kokkos::realloc(phi, nmb, 1, ncells3, ncells2, ncells1);
+  Kokkos::realloc(cg_p, nmb, 1, ncells3, ncells2, ncells1);
+  Kokkos::realloc(cg_r, nmb, ncells3, ncells2, ncells1);
+  Kokkos::realloc(cg_q, nmb, ncells3, ncells2, ncells1);
+  if (use_mg) {Kokkos::realloc(cg_z, nmb, ncells3, ncells2, ncells1);}
+
+  pbval_phi = new MeshBoundaryValuesCC(pmy_pack, pin, false);
+  pbval_phi->InitializeBuffers(1);
+  if (use_mg) {
+    pmg = new BlockMultigrid(pmy_pack,
+                             pin->GetOrAddInteger("self_gravity", "mg_nsmooth", 2),
+                             pin->GetOrAddInteger("self_gravity", "mg_ncoarse", 16));
+    pmg->SetOperator(1.0);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+// destructor
+
+SelfGravity::~SelfGravity() {
+  delete pbval_phi;
+  if (pmg != nullptr) {delete pmg;}
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void IncludeSolveTasks
+//  \brief includes tasks in the stagen task list for solving for the potential, and
+//  adding gravitational source terms after the RK update.  The solve uses the primitive
+//  density at the start of the stage, so it does not depend on (and can be run while
+//  waiting for communications of) the fluxes.  Called by MeshBlockPack::AddPhysics()
+
+void SelfGravity::IncludeSolveTasks(std::shared_ptr<TaskList> tl, TaskID start) {
+  auto id_solve = tl->AddTask(&SelfGravity::Solve, this, start);
+  if (pmy_pack->phydro != nullptr) {
+    auto dep = id_solve | pmy_pack->phydro->id.rkupdt;
+    tl->InsertTask(&SelfGravity::AddSourceTerms, this, dep,
+                   pmy_pack->phydro->id.srctrms);
+  }
+  if (pmy_pack->pmhd != nullptr) {
+    auto dep = id_solve | pmy_pack->pmhd->id.rkupdt;
+    tl->InsertTask(&SelfGravity::AddSourceTerms, this, dep,
+                   pmy_pack->pmhd->id.srctrms);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Solve()
+//  \brief Solves Poisson's equation for the potential with CG, and sets ghost zones of
+//  the potential.
+
+TaskStatus SelfGravity::Solve(Driver *pdrive, int stage) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, nx1 = indcs.nx1;
+  int js = indcs.js, nx2 = indcs.nx2;
+  int ks = indcs.ks, nx3 = indcs.nx3;
+  int ie = indcs.ie, je = indcs.je, ke = indcs.ke;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  const int nmkji = (pmy_pack->nmb_thispack)*nx3*nx2*nx1;
+  const int nkji = nx3*nx2*nx1;
+  const int nji  = nx2*nx1;
+  auto &w0 = (pmy_pack->phydro != nullptr)? pmy_pack->phydro->w0 : pmy_pack->pmhd->w0;
+  auto phi_ = phi;
+  auto p_ = cg_p;
+  auto r_ = cg_r;
+  auto q_ = cg_q;
+  auto z_ = cg_z;
+  bool mg = use_mg;
+  Real fpg = four_pi_G;
+
+  // mean density (on a uniform mesh all cells have the same volume)
+  Real rho_sum = 0.0;
+  Kokkos::parallel_reduce("grav_rho", Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
+  KOKKOS_LAMBDA(const int &idx, Real &sum) {
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/nx1;
+    int i = (idx - m*nkji - k*nji - j*nx1) + is;
+    k += ks;
+    j += js;
+    sum += w0(m,IDN,k,j,i);
+  }, Kokkos::Sum<Real>(rho_sum));
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, &rho_sum, 1, MPI_ATHENA_REAL, MPI_SUM,
+                global_variable::athena_comm);
+#endif
+  Real rho_mean = rho_sum/static_cast<Real>((pmy_pack->pmesh->nmb_total)*nkji);
+
+  // r = b - A phi,  p = r (without preconditioner), and sums of r*r and b*b
+  ApplyLaplacian(phi_, q_);
+  array_sum::GlobalSum sum0;
+  Kokkos::parallel_reduce("grav_r0", Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
+  KOKKOS_LAMBDA(const int &idx, array_sum::GlobalSum &rsum) {
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/nx1;
+    int i = (idx - m*nkji - k*nji - j*nx1) + is;
+    k += ks;
+    j += js;
+    Real b = -fpg*(w0(m,IDN,k,j,i) - rho_mean);
+    Real r = b - q_(m,k,j,i);
+    r_(m,k,j,i) = r;
+    p_(m,0,k,j,i) = r;
+    rsum.the_array[0] += r*r;
+    rsum.the_array[1] += b*b;
+  }, Kokkos::Sum<array_sum::GlobalSum>(sum0));
+  Real gsum[5];
+  gsum[0] = sum0.the_array[0];
+  gsum[1] = sum0.the_array[1];
+  if (mg) {Precondition(&(gsum[2]));}
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, gsum, (mg)? 5 : 2, MPI_ATHENA_REAL, MPI_SUM,
+                global_variable::athena_comm);
+#endif
+  Real rr = gsum[0];
+  Real bb = gsum[1];
+  Real tol2 = SQR(tol)*bb;
+  // the potential is only defined up to a constant, so the preconditioned residual is
+  // projected onto zero mean, which keeps CG in the range of the Laplacian
+  Real ncells = static_cast<Real>((pmy_pack->pmesh->nmb_total)*nkji);
+  Real zmean = (mg)? gsum[2]/ncells : 0.0;
+  Real rz = (mg)? (gsum[3] - zmean*gsum[4]) : rr;
+  if (mg) {
+    par_for("grav_p0", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie,
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      p_(m,0,k,j,i) = z_(m,k,j,i) - zmean;
+    });
+  }
+
+  niter = 0;
+  while (rr > tol2 && niter < max_iter) {
+    // A*p, with ghost zones of p from neighbors
+    ExchangeGhosts(p_);
+    ApplyLaplacian(p_, q_);
+    Real pq = 0.0;
+    Kokkos::parallel_reduce("grav_pq", Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
+    KOKKOS_LAMBDA(const int &idx, Real &sum) {
+      int m = (idx)/nkji;
+      int k = (idx - m*nkji)/nji;
+      int j = (idx - m*nkji - k*nji)/nx1;
+      int i = (idx - m*nkji - k*nji - j*nx1) + is;
+      k += ks;
+      j += js;
+      sum += p_(m,0,k,j,i)*q_(m,k,j,i);
+    }, Kokkos::Sum<Real>(pq));
+#if MPI_PARALLEL_ENABLED
+    MPI_Allreduce(MPI_IN_PLACE, &pq, 1, MPI_ATHENA_REAL, MPI_SUM,
+                  global_variable::athena_comm);
+#endif
+    Real alpha = rz/pq;
+
+    // phi += alpha p,  r -= alpha A*p, and new sum of r*r
+    Real rr_new = 0.0;
+    Kokkos::parallel_reduce("grav_xr", Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
+    KOKKOS_LAMBDA(const int &idx, Real &sum) {
+      int m = (idx)/nkji;
+      int k = (idx - m*nkji)/nji;
+      int j = (idx - m*nkji - k*nji)/nx1;
+      int i = (idx - m*nkji - k*nji - j*nx1) + is;
+      k += ks;
+      j += js;
+      phi_(m,0,k,j,i) += alpha*p_(m,0,k,j,i);
+      Real r = r_(m,k,j,i) - alpha*q_(m,k,j,i);
+      r_(m,k,j,i) = r;
+      sum += r*r;
+    }, Kokkos::Sum<Real>(rr_new));
+    gsum[0] = rr_new;
+    if (mg) {Precondition(&(gsum[1]));}
+#if MPI_PARALLEL_ENABLED
+    MPI_Allreduce(MPI_IN_PLACE, gsum, (mg)? 4 : 1, MPI_ATHENA_REAL, MPI_SUM,
+                  global_variable::athena_comm);
+#endif
+    rr = gsum[0];
+    zmean = (mg)? gsum[1]/ncells : 0.0;
+    Real rz_new = (mg)? (gsum[2] - zmean*gsum[3]) : rr;
+    Real beta = rz_new/rz;
+    rz = rz_new;
+
+    // p = z + beta p, with z = r without preconditioner
+    par_for("grav_p", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie,
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      Real z = (mg)? (z_(m,k,j,i) - zmean) : r_(m,k,j,i);
+      p_(m,0,k,j,i) = z + beta*p_(m,0,k,j,i);
+    });
+    niter++;
+  }
+
+  if (rr > tol2 && global_variable::my_rank == 0) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Self-gravity solver did not converge in " << max_iter
+              << " iterations, |r|/|b|=" << std::sqrt(rr/bb) << std::endl;
+  }
+
+  // ghost zones of potential, used for its gradient in source terms
+  ExchangeGhosts(phi_);
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn AddSourceTerms()
+//  \brief Adds momentum and energy source terms -rho grad(phi) and -rho v.grad(phi),
+//  computed from primitives at the start of the stage, to the conserved variables.
+
+TaskStatus SelfGravity::AddSourceTerms(Driver *pdrive, int stage) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  Real beta_dt = (pdrive->beta[stage-1])*(pmy_pack->pmesh->dt);
+  auto phi_ = phi;
+
+  bool is_ideal;
+  DvceArray5D<Real> u0, w0;
+  if (pmy_pack->phydro != nullptr) {
+    u0 = pmy_pack->phydro->u0;
+    w0 = pmy_pack->phydro->w0;
+    is_ideal = pmy_pack->phydro->peos->eos_data.is_ideal;
+  } else {
+    u0 = pmy_pack->pmhd->u0;
+    w0 = pmy_pack->pmhd->w0;
+    is_ideal = pmy_pack->pmhd->peos->eos_data.is_ideal;
+  }
+
+  par_for("grav_src", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie,
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    Real rho = w0(m,IDN,k,j,i);
+    Real g1 = (phi_(m,0,k,j,i+1) - phi_(m,0,k,j,i-1))/(2.0*mbsize.d_view(m).dx1);
+    Real g2 = 0.0, g3 = 0.0;
+    if (multi_d) {
+      g2 = (phi_(m,0,k,j+1,i) - phi_(m,0,k,j-1,i))/(2.0*mbsize.d_view(m).dx2);
+    }
+    if (three_d) {
+      g3 = (phi_(m,0,k+1,j,i) - phi_(m,0,k-1,j,i))/(2.0*mbsize.d_view(m).dx3);
+    }
+    u0(m,IM1,k,j,i) -= beta_dt*rho*g1;
+    u0(m,IM2,k,j,i) -= beta_dt*rho*g2;
+    u0(m,IM3,k,j,i) -= beta_dt*rho*g3;
+    if (is_ideal) {
+      u0(m,IEN,k,j,i) -= beta_dt*rho*(w0(m,IVX,k,j,i)*g1 + w0(m,IVY,k,j,i)*g2 +
+                                      w0(m,IVZ,k,j,i)*g3);
+    }
+  });
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn ApplyLaplacian()
+//  \brief Computes A*v = -Lap(v) in active cells with the second-order stencil.  Ghost
+//  zones of v must be set.
+
+void SelfGravity::ApplyLaplacian(const DvceArray5D<Real> &v, DvceArray4D<Real> &av) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+
+  par_for("grav_lap", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie,
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    Real vc = v(m,0,k,j,i);
+    Real lap = (v(m,0,k,j,i+1) - 2.0*vc + v(m,0,k,j,i-1))/SQR(mbsize.d_view(m).dx1);
+    if (multi_d) {
+      lap += (v(m,0,k,j+1,i) - 2.0*vc + v(m,0,k,j-1,i))/SQR(mbsize.d_view(m).dx2);
+    }
+    if (three_d) {
+      lap += (v(m,0,k+1,j,i) - 2.0*vc + v(m,0,k-1,j,i))/SQR(mbsize.d_view(m).dx3);
+    }
+    av(m,k,j,i) = -lap;
+  });
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Precondition()
+//  \brief Computes the preconditioned residual z = M r with the multigrid V-cycle, and
+//  the sums of z, r*z and r over active cells on this rank, returned in gsum[0..2].
+
+void SelfGravity::Precondition(Real *gsum) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, nx1 = indcs.nx1;
+  int js = indcs.js, nx2 = indcs.nx2;
+  int ks = indcs.ks, nx3 = indcs.nx3;
+  const int nmkji = (pmy_pack->nmb_thispack)*nx3*nx2*nx1;
+  const int nkji = nx3*nx2*nx1;
+  const int nji  = nx2*nx1;
+  auto r_ = cg_r;
+  auto z_ = cg_z;
+  pmg->Precondition(r_, z_);
+  array_sum::GlobalSum sum0;
+  Kokkos::parallel_reduce("grav_rz", Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
+  KOKKOS_LAMBDA(const int &idx, array_sum::GlobalSum &rsum) {
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/nx1;
+    int i = (idx - m*nkji - k*nji - j*nx1) + is;
+    k += ks;
+    j += js;
+    rsum.the_array[0] += z_(m,k,j,i);
+    rsum.the_array[1] += r_(m,k,j,i)*z_(m,k,j,i);
+    rsum.the_array[2] += r_(m,k,j,i);
+  }, Kokkos::Sum<array_sum::GlobalSum>(sum0));
+  for (int n=0; n<3; ++n) {gsum[n] = sum0.the_array[n];}
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn ExchangeGhosts()
+//  \brief Sets ghost zones of potential or CG vector by (blocking) exchange with
+//  neighbors, in the same sequence as Driver::InitBoundaryValuesAndPrimitives().
+
+void SelfGravity::ExchangeGhosts(DvceArray5D<Real> &v) {
+  (void) pbval_phi->InitRecv(1);
+  (void) pbval_phi->PackAndSendCC(v, cphi);
+  (void) pbval_phi->ClearSend();
+  (void) pbval_phi->ClearRecv();
+  (void) pbval_phi->RecvAndUnpackCC(v, cphi);
+  return;
+}
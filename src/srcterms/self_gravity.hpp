@@ -0,0 +1,57 @@
+#ifndef SRCTERMS_SELF_GRAVITY_HPP_
+#define SRCTERMS_SELF_GRAVITY_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file self_gravity.hpp
+//  \brief defines SelfGravity class, which solves Poisson's equation for the
+//  gravitational potential of the fluid and adds the resulting source terms
+
+#include <memory>
+
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+#include "parameter_input.hpp"
+
+// forward declarations
+class MeshBoundaryValuesCC;
+class BlockMultigrid;
+
+//----------------------------------------------------------------------------------------
+//! \class SelfGravity
+
+class SelfGravity {
+ public:
+  SelfGravity(MeshBlockPack *pp, ParameterInput *pin);
+  ~SelfGravity();
+
+  DvceArray5D<Real> phi;   // gravitational potential (with ghost zones)
+
+  // parameters of solver
+  Real four_pi_G;          // 4*pi*G in code units
+  int max_iter;            // maximum number of CG iterations
+  Real tol;                // tolerance on |r|/|b| of CG solution
+  int niter;               // number of CG iterations used in last solve
+  bool use_mg;             // precondition CG with multigrid V-cycle
+
+  // functions
+  void IncludeSolveTasks(std::shared_ptr<TaskList> tl, TaskID start);
+  TaskStatus Solve(Driver *pdrive, int stage);
+  TaskStatus AddSourceTerms(Driver *pdrive, int stage);
+
+ private:
+  MeshBlockPack *pmy_pack;  // ptr to MeshBlockPack containing this SelfGravity
+  MeshBoundaryValuesCC *pbval_phi;  // boundary values of potential and CG vectors
+  BlockMultigrid *pmg = nullptr;    // multigrid preconditioner
+  DvceArray5D<Real> cg_p;   // CG search direction (with ghost zones)
+  DvceArray5D<Real> cphi;   // unused coarse array required by boundary exchange
+  DvceArray4D<Real> cg_r, cg_q;  // CG residual and A*p
+  DvceArray4D<Real> cg_z;        // preconditioned residual
+  void ApplyLaplacian(const DvceArray5D<Real> &v, DvceArray4D<Real> &av);
+  void ExchangeGhosts(DvceArray5D<Real> &v);
+  void Precondition(Real *gsum);
+};
+
+#endif  // SRCTERMS_SELF_GRAVITY_HPP_
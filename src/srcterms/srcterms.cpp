@@ -52,6 +52,32 @@ SourceTerms::SourceTerms(std::string block, MeshBlockPack *pp, ParameterInput *p
     hrate = pin->GetReal(block, "hrate");
   }
 
+  // (2b) integration scheme for ISM and relativistic cooling
+  exact_cooling = false;
+  if (ism_cooling || pin->GetOrAddBoolean(block, "rel_cooling", false)) {
+    std::string scheme = pin->GetOrAddString(block, "cooling_scheme", "explicit");
+    if (scheme == "exact") {
+      exact_cooling = true;
+    } else if (scheme != "explicit") {
+      std::cout << "### FATAL ERROR in "<< __FILE__ <<" at line " << __LINE__ << std::endl
+                << "cooling_scheme = '" << scheme << "' must be 'explicit' or 'exact'"
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  }
+  if (ism_cooling && exact_cooling) {
+    int ntab = pin->GetOrAddInteger(block, "cooling_ntab", 4096);
+    Real tmin = pin->GetOrAddReal(block, "cooling_tmin", 10.0);
+    Real tmax = pin->GetOrAddReal(block, "cooling_tmax", 1.0e9);
+    if (ntab < 2 || tmin <= 0.0 || tmax <= tmin) {
+      std::cout << "### FATAL ERROR in "<< __FILE__ <<" at line " << __LINE__ << std::endl
+                << "cooling table requires cooling_ntab >= 2 and "
+                << "0 < cooling_tmin < cooling_tmax" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    cool_table.Build([](const Real t) {return ISMCoolFn(t);}, ntab, tmin, tmax);
+  }
+
   // (3) beam source (radiation)
   beam = pin->GetOrAddBoolean(block, "beam_source", false);
   if (beam) {
@@ -110,6 +136,8 @@ void SourceTerms::ConstantAccel(const DvceArray5D<Real> &w0, const EOS_Data &eos
 //----------------------------------------------------------------------------------------
 //! \fn void SourceTerms::ISMCooling()
 //! \brief Add explict ISM cooling and heating source terms in the energy equations.
+//! With cooling_scheme=exact, the temperature after cooling for bdt at fixed density is
+//! found from the TEF table, and heating is added explicitly.
 // NOTE source terms must be computed using primitive (w0) and NOT conserved (u0) vars
 
 void SourceTerms::ISMCooling(const DvceArray5D<Real> &w0, const EOS_Data &eos_data,
@@ -130,6 +158,31 @@ void SourceTerms::ISMCooling(const DvceArray5D<Real> &w0, const EOS_Data &eos_da
                       /n_unit/n_unit;
   Real heating_unit = pmy_pack->punit->pressure_cgs()/pmy_pack->punit->time_cgs()/n_unit;
 
+  if (exact_cooling) {
+    auto &tab = cool_table;
+    // increment of TEF per unit density and time, in code units
+    Real dy_coef = gm1*(ISMCoolFn(tab.tref)/cooling_unit)/(tab.tref/temp_unit);
+    par_for("cooling_exact", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie,
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      // temperature in cgs unit
+      Real temp = 1.0;
+      if (use_e) {
+        temp = temp_unit*w0(m,IEN,k,j,i)/w0(m,IDN,k,j,i)*gm1;
+      } else {
+        temp = temp_unit*w0(m,ITM,k,j,i);
+      }
+      Real &dens = w0(m,IDN,k,j,i);
+      Real temp_new = tab.InverseTEF(tab.TEF(temp) + dy_coef*dens*bdt);
+      // only cool, so temperatures below the table are unchanged
+      temp_new = fmin(temp_new, temp);
+      Real gamma_heating = heating_rate/heating_unit;
+
+      u0(m,IEN,k,j,i) += dens*(temp_new - temp)/(temp_unit*gm1) +
+                         bdt*dens*gamma_heating;
+    });
+    return;
+  }
+
   par_for("cooling", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie,
   KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
     // temperature in cgs unit
@@ -153,6 +206,9 @@ void SourceTerms::ISMCooling(const DvceArray5D<Real> &w0, const EOS_Data &eos_da
 //----------------------------------------------------------------------------------------
 //! \fn void SourceTerms::RelCooling()
 //! \brief Add explict relativistic cooling in the energy and momentum equations.
+//! With cooling_scheme=exact, the energy radiated per unit mass bdt*(rate*T)^power is
+//! replaced by the exact solution of dT/dt = -(gamma-1)(rate*T)^power over bdt, which is
+//! a power law so needs no table.
 // NOTE source terms must be computed using primitive (w0) and NOT conserved (u0) vars
 
 void SourceTerms::RelCooling(const DvceArray5D<Real> &w0, const EOS_Data &eos_data,
@@ -167,6 +223,7 @@ void SourceTerms::RelCooling(const DvceArray5D<Real> &w0, const EOS_Data &eos_da
   Real gm1 = gamma - 1.0;
   Real cooling_rate = crate_rel;
   Real cooling_power = cpower_rel;
+  bool exact = exact_cooling;
 
   par_for("cooling", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie,
   KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
@@ -185,10 +242,24 @@ void SourceTerms::RelCooling(const DvceArray5D<Real> &w0, const EOS_Data &eos_da
     auto ut = 1.0 + ux*ux + uy*uy + uz*uz;
     ut = sqrt(ut);
 
-    u0(m,IEN,k,j,i) -= bdt*w0(m,IDN,k,j,i)*ut*pow((temp*cooling_rate), cooling_power);
-    u0(m,IM1,k,j,i) -= bdt*w0(m,IDN,k,j,i)*ux*pow((temp*cooling_rate), cooling_power);
-    u0(m,IM2,k,j,i) -= bdt*w0(m,IDN,k,j,i)*uy*pow((temp*cooling_rate), cooling_power);
-    u0(m,IM3,k,j,i) -= bdt*w0(m,IDN,k,j,i)*uz*pow((temp*cooling_rate), cooling_power);
+    // energy radiated per unit mass
+    Real de = bdt*pow((temp*cooling_rate), cooling_power);
+    if (exact) {
+      Real temp_new;
+      if (fabs(cooling_power - 1.0) < 1.0e-12) {
+        temp_new = temp*exp(-gm1*cooling_rate*bdt);
+      } else {
+        Real x = pow(temp, 1.0 - cooling_power) + (cooling_power - 1.0)*gm1*
+                 pow(cooling_rate, cooling_power)*bdt;
+        temp_new = (x > 0.0)? pow(x, 1.0/(1.0 - cooling_power)) : 0.0;
+      }
+      de = (temp - temp_new)/gm1;
+    }
+
+    u0(m,IEN,k,j,i) -= w0(m,IDN,k,j,i)*ut*de;
+    u0(m,IM1,k,j,i) -= w0(m,IDN,k,j,i)*ux*de;
+    u0(m,IM2,k,j,i) -= w0(m,IDN,k,j,i)*uy*de;
+    u0(m,IM3,k,j,i) -= w0(m,IDN,k,j,i)*uz*de;
   });
 
   return;
@@ -198,7 +269,7 @@ void SourceTerms::RelCooling(const DvceArray5D<Real> &w0, const EOS_Data &eos_da
 //! \fn SourceTerms::BeamSource()
 // \brief Add beam of radiation
 
-void SourceTerms::BeamSource(DvceArray5D<Real> &i0, const Real bdt) {
+void SourceTerms::BeamSource(DvceArray5D<RadReal> &i0, const Real bdt) {
   auto &indcs = pmy_pack->pmesh->mb_indcs;
   int is = indcs.is, ie = indcs.ie;
   int js = indcs.js, je = indcs.je;
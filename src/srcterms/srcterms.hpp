@@ -18,6 +18,7 @@
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
 #include "parameter_input.hpp"
+#include "exact_cooling.hpp"
 
 // forward declarations
 class TurbulenceDriver;
@@ -50,6 +51,11 @@ class SourceTerms {
   // heating rate used with ISM cooling
   Real hrate;
 
+  // exact integration of cooling (Townsend 2009) rather than explicit update, which
+  // removes the cooling timestep limit.  ISM cooling uses a table of the TEF.
+  bool exact_cooling;
+  ExactCoolingTable cool_table;
+
   // cooling rate used with relativistic cooling
   Real crate_rel;
   Real cpower_rel;
@@ -67,7 +73,7 @@ class SourceTerms {
                   const Real dt, DvceArray5D<Real> &u0);
   void RelCooling(const DvceArray5D<Real> &w0, const EOS_Data &eos,
                   const Real dt, DvceArray5D<Real> &u0);
-  void BeamSource(DvceArray5D<Real> &i0, const Real dt);
+  void BeamSource(DvceArray5D<RadReal> &i0, const Real dt);
   void ShearingBox(const DvceArray5D<Real> &w0, const EOS_Data &eos_data, const Real bdt,
                    DvceArray5D<Real> &u0);
   void ShearingBox(const DvceArray5D<Real> &w0, const DvceArray5D<Real> &bcc0,
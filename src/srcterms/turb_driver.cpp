@@ -12,6 +12,7 @@
 #include <memory>
 
 #include "athena.hpp"
+#include "globals.hpp"
 #include "parameter_input.hpp"
 #include "coordinates/cell_locations.hpp"
 #include "mesh/mesh.hpp"
@@ -39,6 +40,7 @@ TurbulenceDriver::TurbulenceDriver(MeshBlockPack *pp, ParameterInput *pin) :
   zccc("zccc",1),zccs("zccs",1),zcsc("zcsc",1),zcss("zcss",1),
   zscc("zscc",1),zscs("zscs",1),zssc("zssc",1),zsss("zsss",1),
   kx_mode("kx_mode",1),ky_mode("ky_mode",1),kz_mode("kz_mode",1),
+  n_mode("n_mode",1,3),
   xcos("xcos",1,1,1),xsin("xsin",1,1,1),ycos("ycos",1,1,1),
   ysin("ysin",1,1,1),zcos("zcos",1,1,1),zsin("zsin",1,1,1) {
   // allocate memory for force registers
@@ -64,6 +66,9 @@ TurbulenceDriver::TurbulenceDriver(MeshBlockPack *pp, ParameterInput *pin) :
   dedt = pin->GetOrAddReal("turb_driving", "dedt", 0.0);
   // correlation time
   tcorr = pin->GetOrAddReal("turb_driving", "tcorr", 0.0);
+  // draw amplitudes in parallel on the device with a counter-based RNG
+  device_rng = pin->GetOrAddBoolean("turb_driving", "device_rng", false);
+  rng_seed = pin->GetOrAddInteger("turb_driving", "rng_seed", 1);
 
   Real nlow_sqr = nlow*nlow;
   Real nhigh_sqr = nhigh*nhigh;
@@ -126,6 +131,7 @@ TurbulenceDriver::TurbulenceDriver(MeshBlockPack *pp, ParameterInput *pin) :
   Kokkos::realloc(kx_mode, mode_count);
   Kokkos::realloc(ky_mode, mode_count);
   Kokkos::realloc(kz_mode, mode_count);
+  Kokkos::realloc(n_mode, mode_count, 3);
 
   Kokkos::realloc(xcos, nmb, mode_count, ncells1);
   Kokkos::realloc(xsin, nmb, mode_count, ncells1);
@@ -218,6 +224,9 @@ void TurbulenceDriver::Initialize() {
           kx_mode_.h_view(nmode) = kx;
           ky_mode_.h_view(nmode) = ky;
           kz_mode_.h_view(nmode) = kz;
+          n_mode.h_view(nmode,0) = nkx;
+          n_mode.h_view(nmode,1) = nky;
+          n_mode.h_view(nmode,2) = nkz;
           nmode++;
         }
       }
@@ -230,6 +239,8 @@ void TurbulenceDriver::Initialize() {
   ky_mode_.template sync<DevExeSpace>();
   kz_mode_.template modify<HostMemSpace>();
   kz_mode_.template sync<DevExeSpace>();
+  n_mode.template modify<HostMemSpace>();
+  n_mode.template sync<DevExeSpace>();
 
   auto &size = pmy_pack->pmb->mb_size;
 
@@ -333,16 +344,9 @@ TaskStatus TurbulenceDriver::InitializeModes(Driver *pdrive, int stage) {
 
   // Now compute new force using new random amplitudes and phases
 
-  // Zero out new force array
   auto force_tmp_ = force_tmp;
   int &nmb = pmy_pack->nmb_thispack;
-  par_for("force_init", DevExeSpace(),0,nmb-1,0,2,ks,ke,js,je,is,ie,
-  KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
-    force_tmp_(m,n,k,j,i) = 0.0;
-  });
 
-  int nlow_sqr = SQR(nlow);
-  int nhigh_sqr = SQR(nhigh);
   auto mode_count_ = mode_count;
 
   auto xccc_ = xccc;
@@ -372,460 +376,164 @@ TaskStatus TurbulenceDriver::InitializeModes(Driver *pdrive, int stage) {
   auto zssc_ = zssc;
   auto zsss_ = zsss;
 
-  Real dkx, dky, dkz, kx, ky, kz;
-  Real iky, ikz;
-  Real lx = pm->mesh_size.x1max - pm->mesh_size.x1min;
-  Real ly = pm->mesh_size.x2max - pm->mesh_size.x2min;
-  Real lz = pm->mesh_size.x3max - pm->mesh_size.x3min;
-  dkx = 2.0*M_PI/lx;
-  dky = 2.0*M_PI/ly;
-  dkz = 2.0*M_PI/lz;
+  // draw new random amplitudes of all modes
+  if (device_rng) {
+    DrawAmplitudesDevice(pm->ncycle);
+  } else {
+    DrawAmplitudesHost();
+  }
 
-  Real &ex = expo;
-  Real &ex_prp = exp_prp;
-  Real &ex_prl = exp_prl;
-  Real norm, kprl, kprp, kiso;
+  auto xcos_ = xcos;
+  auto xsin_ = xsin;
+  auto ycos_ = ycos;
+  auto ysin_ = ysin;
+  auto zcos_ = zcos;
+  auto zsin_ = zsin;
 
-  int nmode = 0;
-  int nkx, nky, nkz, nsqr;
-  for (nkx = 0; nkx <= nhigh; nkx++) {
-    for (nky = 0; nky <= nhigh; nky++) {
-      for (nkz = 0; nkz <= nhigh; nkz++) {
-        if (nkx == 0 && nky == 0 && nkz == 0) continue;
-        norm = 0.0;
-        nsqr = 0.0;
-        bool flag_prl = true;
-        if (driving_type == 0) {
-          nsqr = SQR(nkx) + SQR(nky) + SQR(nkz);
-        } else if (driving_type == 1) {
-          nsqr = SQR(nkx) + SQR(nky);
-          Real nprlsqr = SQR(nkz);
-          if (nprlsqr >= nlow_sqr && nprlsqr <= nhigh_sqr) {
-            flag_prl = true;
-          } else {
-            flag_prl = false;
-          }
-        }
-        if (nsqr >= nlow_sqr && nsqr <= nhigh_sqr && flag_prl) {
-          kx = dkx*nkx;
-          ky = dky*nky;
-          kz = dkz*nkz;
+  // static estimates per cell for roofline counters: 60 FLOPs per mode, and only the
+  // three components of the force are written (mode arrays are reused from cache)
+  KernelCounters &kc = pmy_pack->pmesh->kcounter;
+  kc.Start("force_compute", static_cast<double>(nmb)*(ke-ks+1)*(je-js+1)*(ie-is+1),
+           3.0*sizeof(Real), 60.0*mode_count_);
 
-          // Generate Fourier amplitudes
-          if (driving_type == 0) {
-            kiso = sqrt(SQR(kx) + SQR(ky) + SQR(kz));
-            if (kiso > 1e-16) {
-              norm = 1.0/pow(kiso,(ex+2.0)/2.0);
-            } else {
-              norm = 0.0;
-            }
-            if (nkz != 0) {
-              ikz = 1.0/(dkz*((Real) nkz));
+  // sum all modes in a single kernel, accumulating force in each cell in registers
+  par_for("force_compute", DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
+  KOKKOS_LAMBDA(int m, int k, int j, int i) {
+    Real f1 = 0.0, f2 = 0.0, f3 = 0.0;
+    for (int n=0; n<mode_count_; n++) {
+      Real xc = xcos_(m,n,i), xs = xsin_(m,n,i);
+      Real yc = ycos_(m,n,j), ys = ysin_(m,n,j);
+      Real zc = zcos_(m,n,k), zs = zsin_(m,n,k);
+      Real cc = xc*yc, cs = xc*ys, sc = xs*yc, ss = xs*ys;
+      Real ccc = cc*zc, ccs = cc*zs, csc = cs*zc, css = cs*zs;
+      Real scc = sc*zc, scs = sc*zs, ssc = ss*zc, sss = ss*zs;
+
+      f1 += xccc_.d_view(n)*ccc + xccs_.d_view(n)*ccs + xcsc_.d_view(n)*csc +
+            xcss_.d_view(n)*css + xscc_.d_view(n)*scc + xscs_.d_view(n)*scs +
+            xssc_.d_view(n)*ssc + xsss_.d_view(n)*sss;
+      f2 += yccc_.d_view(n)*ccc + yccs_.d_view(n)*ccs + ycsc_.d_view(n)*csc +
+            ycss_.d_view(n)*css + yscc_.d_view(n)*scc + yscs_.d_view(n)*scs +
+            yssc_.d_view(n)*ssc + ysss_.d_view(n)*sss;
+      f3 += zccc_.d_view(n)*ccc + zccs_.d_view(n)*ccs + zcsc_.d_view(n)*csc +
+            zcss_.d_view(n)*css + zscc_.d_view(n)*scc + zscs_.d_view(n)*scs +
+            zssc_.d_view(n)*ssc + zsss_.d_view(n)*sss;
+    }
+    force_tmp_(m,0,k,j,i) = f1;
+    force_tmp_(m,1,k,j,i) = f2;
+    force_tmp_(m,2,k,j,i) = f3;
+  });
+  kc.Stop();
 
-              xccc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              xccs_.h_view(nmode) = RanGaussianSt(&(rstate));
-              xcsc_.h_view(nmode) = (nky==0)           ? 0.0 : RanGaussianSt(&(rstate));
-              xcss_.h_view(nmode) = (nky==0)           ? 0.0 : RanGaussianSt(&(rstate));
-              xscc_.h_view(nmode) = (nkx==0)           ? 0.0 : RanGaussianSt(&(rstate));
-              xscs_.h_view(nmode) = (nkx==0)           ? 0.0 : RanGaussianSt(&(rstate));
-              xssc_.h_view(nmode) = (nkx==0 || nky==0) ? 0.0 : RanGaussianSt(&(rstate));
-              xsss_.h_view(nmode) = (nkx==0 || nky==0) ? 0.0 : RanGaussianSt(&(rstate));
+  DvceArray5D<Real> u0, u0_;
+  if (pmy_pack->phydro != nullptr) u0 = (pmy_pack->phydro->u0);
+  if (pmy_pack->pmhd != nullptr) u0 = (pmy_pack->pmhd->u0);
+  bool flag_twofl = false;
+  if (pmy_pack->pionn != nullptr) {
+    u0 = (pmy_pack->phydro->u0);
+    u0_ = (pmy_pack->pmhd->u0);
+    flag_twofl = true;
+  }
 
-              yccc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              yccs_.h_view(nmode) = RanGaussianSt(&(rstate));
-              ycsc_.h_view(nmode) = (nky==0)           ? 0.0 : RanGaussianSt(&(rstate));
-              ycss_.h_view(nmode) = (nky==0)           ? 0.0 : RanGaussianSt(&(rstate));
-              yscc_.h_view(nmode) = (nkx==0)           ? 0.0 : RanGaussianSt(&(rstate));
-              yscs_.h_view(nmode) = (nkx==0)           ? 0.0 : RanGaussianSt(&(rstate));
-              yssc_.h_view(nmode) = (nkx==0 || nky==0) ? 0.0 : RanGaussianSt(&(rstate));
-              ysss_.h_view(nmode) = (nkx==0 || nky==0) ? 0.0 : RanGaussianSt(&(rstate));
+  const int nmkji = nmb*nx3*nx2*nx1;
+  const int nkji = nx3*nx2*nx1;
+  const int nji  = nx2*nx1;
+  // Compute all moments needed to remove net momentum and normalize force in a single
+  // reduction: total mass M, net force F = sum(den*f), sum(den*f^2), total momentum P,
+  // and sum(mom.f).  Moments of the force with net momentum removed, f' = f - F/M, are
+  //   sum(den*f'^2) = sum(den*f^2) - F.F/M  and  sum(mom.f') = sum(mom.f) - P.F/M
+  array_sum::GlobalSum sum_fm;
+  Kokkos::parallel_reduce("force_moments", Kokkos::RangePolicy<>(DevExeSpace(),0,nmkji),
+  KOKKOS_LAMBDA(const int &idx, array_sum::GlobalSum &fm_sum) {
+    // compute n,k,j,i indices of thread
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/nx1;
+    int i = (idx - m*nkji - k*nji - j*nx1) + is;
+    k += ks;
+    j += js;
 
-              // imcompressibility
-              zccc_.h_view(nmode) =  ikz*( kx*xscs_.h_view(nmode)+ky*ycss_.h_view(nmode));
-              zccs_.h_view(nmode) = -ikz*( kx*xscc_.h_view(nmode)+ky*ycsc_.h_view(nmode));
-              zcsc_.h_view(nmode) =  ikz*( kx*xsss_.h_view(nmode)-ky*yccs_.h_view(nmode));
-              zcss_.h_view(nmode) =  ikz*(-kx*xssc_.h_view(nmode)+ky*yccc_.h_view(nmode));
-              zscc_.h_view(nmode) =  ikz*(-kx*xccs_.h_view(nmode)+ky*ysss_.h_view(nmode));
-              zscs_.h_view(nmode) =  ikz*( kx*xccc_.h_view(nmode)-ky*yssc_.h_view(nmode));
-              zssc_.h_view(nmode) = -ikz*( kx*xcss_.h_view(nmode)+ky*yscs_.h_view(nmode));
-              zsss_.h_view(nmode) =  ikz*( kx*xcsc_.h_view(nmode)+ky*yscc_.h_view(nmode));
-            } else if (nky != 0) {  // kz == 0
-              iky = 1.0/(dky*((Real) nky));
+    Real den  = u0(m,IDN,k,j,i);
+    Real mom1 = u0(m,IM1,k,j,i);
+    Real mom2 = u0(m,IM2,k,j,i);
+    Real mom3 = u0(m,IM3,k,j,i);
+    if (flag_twofl) {
+      den  += u0_(m,IDN,k,j,i);
+      mom1 += u0_(m,IM1,k,j,i);
+      mom2 += u0_(m,IM2,k,j,i);
+      mom3 += u0_(m,IM3,k,j,i);
+    }
+    Real v1 = force_tmp_(m,0,k,j,i);
+    Real v2 = force_tmp_(m,1,k,j,i);
+    Real v3 = force_tmp_(m,2,k,j,i);
 
-              xccc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              xcsc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              xscc_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
-              xssc_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
-              xccs_.h_view(nmode) = 0.0;
-              xscs_.h_view(nmode) = 0.0;
-              xcss_.h_view(nmode) = 0.0;
-              xsss_.h_view(nmode) = 0.0;
+    array_sum::GlobalSum fvars;
+    fvars.the_array[0] = den;
+    fvars.the_array[1] = den*v1;
+    fvars.the_array[2] = den*v2;
+    fvars.the_array[3] = den*v3;
+    fvars.the_array[4] = den*(v1*v1 + v2*v2 + v3*v3);
+    fvars.the_array[5] = mom1;
+    fvars.the_array[6] = mom2;
+    fvars.the_array[7] = mom3;
+    fvars.the_array[8] = mom1*v1 + mom2*v2 + mom3*v3;
+    fm_sum += fvars;
+  }, Kokkos::Sum<array_sum::GlobalSum>(sum_fm));
+
+  Real fm[9];
+  for (int n=0; n<9; ++n) {fm[n] = sum_fm.the_array[n];}
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, fm, 9, MPI_ATHENA_REAL, MPI_SUM,
+                global_variable::athena_comm);
+#endif
 
-              zccc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              zcsc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              zscc_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
-              zssc_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
-              zccs_.h_view(nmode) = 0.0;
-              zcss_.h_view(nmode) = 0.0;
-              zscs_.h_view(nmode) = 0.0;
-              zsss_.h_view(nmode) = 0.0;
+  // mean force (weighted by density) to be removed
+  Real f1avg = fm[1]/fm[0];
+  Real f2avg = fm[2]/fm[0];
+  Real f3avg = fm[3]/fm[0];
+  Real t0 = fm[4] - (fm[1]*f1avg + fm[2]*f2avg + fm[3]*f3avg);
+  Real t1 = fm[8] - (fm[5]*f1avg + fm[6]*f2avg + fm[7]*f3avg);
 
-              // incompressibility
-              yccc_.h_view(nmode) =  iky*kx*xssc_.h_view(nmode);
-              ycsc_.h_view(nmode) = -iky*kx*xscc_.h_view(nmode);
-              yscc_.h_view(nmode) = -iky*kx*xcsc_.h_view(nmode);
-              yssc_.h_view(nmode) =  iky*kx*xccc_.h_view(nmode);
-              yccs_.h_view(nmode) = 0.0;
-              ycss_.h_view(nmode) = 0.0;
-              yscs_.h_view(nmode) = 0.0;
-              ysss_.h_view(nmode) = 0.0;
-            } else {  // kz == ky == 0, kx != 0 by initial if statement
-              zccc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              zscc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              zcsc_.h_view(nmode) = 0.0;
-              zssc_.h_view(nmode) = 0.0;
-              zccs_.h_view(nmode) = 0.0;
-              zcss_.h_view(nmode) = 0.0;
-              zscs_.h_view(nmode) = 0.0;
-              zsss_.h_view(nmode) = 0.0;
+  t0 = std::max(t0, 1.0e-20);
+  t1 = std::max(t1, 1.0e-20);
 
-              yccc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              yscc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              ycsc_.h_view(nmode) = 0.0;
-              yssc_.h_view(nmode) = 0.0;
-              yccs_.h_view(nmode) = 0.0;
-              ycss_.h_view(nmode) = 0.0;
-              yscs_.h_view(nmode) = 0.0;
-              ysss_.h_view(nmode) = 0.0;
+  Real m0 = t0, m1 = t1;
+  Real dt = pm->dt;
+  Real dvol = 1.0/(gnx1*gnx2*gnx3);
+  m0 = 0.5*m0*dvol*dt;
+  m1 = m1*dvol;
 
-              // incompressibility
-              xccc_.h_view(nmode) = 0.0;
-              xscc_.h_view(nmode) = 0.0;
-              xcsc_.h_view(nmode) = 0.0;
-              xssc_.h_view(nmode) = 0.0;
-              xccs_.h_view(nmode) = 0.0;
-              xscs_.h_view(nmode) = 0.0;
-              xcss_.h_view(nmode) = 0.0;
-              xsss_.h_view(nmode) = 0.0;
-            }
-          } else if (driving_type == 1) {
-            kprl = sqrt(SQR(kx));
-            kprp = sqrt(SQR(ky) + SQR(kz));
-            if (kprl > 1e-16 && kprp > 1e-16) {
-              norm = 1.0/pow(kprp,(ex_prp+1.0)/2.0)/pow(kprl,ex_prl/2.0);
-            } else {
-              norm = 0.0;
-            }
+  Real s;
+  if (m1 >= 0) {
+    s = -m1/2./m0 + sqrt(m1*m1/4./m0/m0 + dedt/m0);
+  } else {
+    s = m1/2./m0 + sqrt(m1*m1/4./m0/m0 + dedt/m0);
+  }
+  if (m0 == 0.0) s = 0.0;
 
-            if (nky != 0) {
-              iky = 1.0/(dky*((Real) nky));
+  // remove net momentum and normalize force in one pass
+  par_for("force_norm", DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
+  KOKKOS_LAMBDA(int m, int k, int j, int i) {
+    force_tmp_(m,0,k,j,i) = s*(force_tmp_(m,0,k,j,i) - f1avg);
+    force_tmp_(m,1,k,j,i) = s*(force_tmp_(m,1,k,j,i) - f2avg);
+    force_tmp_(m,2,k,j,i) = s*(force_tmp_(m,2,k,j,i) - f3avg);
+  });
 
-              xccc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              xccs_.h_view(nmode) = RanGaussianSt(&(rstate));
-              xcsc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              xcss_.h_view(nmode) = RanGaussianSt(&(rstate));
-              xscc_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
-              xscs_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
-              xssc_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
-              xsss_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
+  return TaskStatus::complete;
+}
 
-              // incompressibility
-              yccc_.h_view(nmode) =  iky*(kx*xssc_.h_view(nmode));
-              yccs_.h_view(nmode) =  iky*(kx*xsss_.h_view(nmode));
-              ycsc_.h_view(nmode) = -iky*(kx*xscc_.h_view(nmode));
-              ycss_.h_view(nmode) = -iky*(kx*xscs_.h_view(nmode));
-              yscc_.h_view(nmode) = -iky*(kx*xcsc_.h_view(nmode));
-              yscs_.h_view(nmode) = -iky*(kx*xcss_.h_view(nmode));
-              yssc_.h_view(nmode) =  iky*(kx*xccc_.h_view(nmode));
-              ysss_.h_view(nmode) =  iky*(kx*xccs_.h_view(nmode));
+//----------------------------------------------------------------------------------------
+//! \fn apply forcing
 
-              zccc_.h_view(nmode) = 0.0;
-              zccs_.h_view(nmode) = 0.0;
-              zcsc_.h_view(nmode) = 0.0;
-              zcss_.h_view(nmode) = 0.0;
-              zscc_.h_view(nmode) = 0.0;
-              zscs_.h_view(nmode) = 0.0;
-              zssc_.h_view(nmode) = 0.0;
-              zsss_.h_view(nmode) = 0.0;
-            } else {  // ky == 0
-              yccc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              yscc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              ycsc_.h_view(nmode) = 0.0;
-              yssc_.h_view(nmode) = 0.0;
-              yccs_.h_view(nmode) = 0.0;
-              ycss_.h_view(nmode) = 0.0;
-              yscs_.h_view(nmode) = 0.0;
-              ysss_.h_view(nmode) = 0.0;
-
-              // incompressibility
-              xccc_.h_view(nmode) = 0.0;
-              xscc_.h_view(nmode) = 0.0;
-              xcsc_.h_view(nmode) = 0.0;
-              xssc_.h_view(nmode) = 0.0;
-              xccs_.h_view(nmode) = 0.0;
-              xscs_.h_view(nmode) = 0.0;
-              xcss_.h_view(nmode) = 0.0;
-              xsss_.h_view(nmode) = 0.0;
-
-              zccc_.h_view(nmode) = 0.0;
-              zscc_.h_view(nmode) = 0.0;
-              zcsc_.h_view(nmode) = 0.0;
-              zssc_.h_view(nmode) = 0.0;
-              zccs_.h_view(nmode) = 0.0;
-              zcss_.h_view(nmode) = 0.0;
-              zscs_.h_view(nmode) = 0.0;
-              zsss_.h_view(nmode) = 0.0;
-            }
-          }
-          // normalization
-          xccc_.h_view(nmode) *= norm;
-          xscc_.h_view(nmode) *= norm;
-          xcsc_.h_view(nmode) *= norm;
-          xssc_.h_view(nmode) *= norm;
-          xccs_.h_view(nmode) *= norm;
-          xscs_.h_view(nmode) *= norm;
-          xcss_.h_view(nmode) *= norm;
-          xsss_.h_view(nmode) *= norm;
-          yccc_.h_view(nmode) *= norm;
-          yscc_.h_view(nmode) *= norm;
-          ycsc_.h_view(nmode) *= norm;
-          yssc_.h_view(nmode) *= norm;
-          yccs_.h_view(nmode) *= norm;
-          yscs_.h_view(nmode) *= norm;
-          ycss_.h_view(nmode) *= norm;
-          ysss_.h_view(nmode) *= norm;
-          zccc_.h_view(nmode) *= norm;
-          zscc_.h_view(nmode) *= norm;
-          zcsc_.h_view(nmode) *= norm;
-          zssc_.h_view(nmode) *= norm;
-          zccs_.h_view(nmode) *= norm;
-          zscs_.h_view(nmode) *= norm;
-          zcss_.h_view(nmode) *= norm;
-          zsss_.h_view(nmode) *= norm;
-
-          nmode++;
-        }
-      }
-    }
-  }
-
-  xccc_.template modify<HostMemSpace>();
-  xccc_.template sync<DevExeSpace>();
-  xccs_.template modify<HostMemSpace>();
-  xccs_.template sync<DevExeSpace>();
-  xcsc_.template modify<HostMemSpace>();
-  xcsc_.template sync<DevExeSpace>();
-  xcss_.template modify<HostMemSpace>();
-  xcss_.template sync<DevExeSpace>();
-  xscc_.template modify<HostMemSpace>();
-  xscc_.template sync<DevExeSpace>();
-  xscs_.template modify<HostMemSpace>();
-  xscs_.template sync<DevExeSpace>();
-  xssc_.template modify<HostMemSpace>();
-  xssc_.template sync<DevExeSpace>();
-  xsss_.template modify<HostMemSpace>();
-  xsss_.template sync<DevExeSpace>();
-
-  yccc_.template modify<HostMemSpace>();
-  yccc_.template sync<DevExeSpace>();
-  yccs_.template modify<HostMemSpace>();
-  yccs_.template sync<DevExeSpace>();
-  ycsc_.template modify<HostMemSpace>();
-  ycsc_.template sync<DevExeSpace>();
-  ycss_.template modify<HostMemSpace>();
-  ycss_.template sync<DevExeSpace>();
-  yscc_.template modify<HostMemSpace>();
-  yscc_.template sync<DevExeSpace>();
-  yscs_.template modify<HostMemSpace>();
-  yscs_.template sync<DevExeSpace>();
-  yssc_.template modify<HostMemSpace>();
-  yssc_.template sync<DevExeSpace>();
-  ysss_.template modify<HostMemSpace>();
-  ysss_.template sync<DevExeSpace>();
-
-  zccc_.template modify<HostMemSpace>();
-  zccc_.template sync<DevExeSpace>();
-  zccs_.template modify<HostMemSpace>();
-  zccs_.template sync<DevExeSpace>();
-  zcsc_.template modify<HostMemSpace>();
-  zcsc_.template sync<DevExeSpace>();
-  zcss_.template modify<HostMemSpace>();
-  zcss_.template sync<DevExeSpace>();
-  zscc_.template modify<HostMemSpace>();
-  zscc_.template sync<DevExeSpace>();
-  zscs_.template modify<HostMemSpace>();
-  zscs_.template sync<DevExeSpace>();
-  zssc_.template modify<HostMemSpace>();
-  zssc_.template sync<DevExeSpace>();
-  zsss_.template modify<HostMemSpace>();
-  zsss_.template sync<DevExeSpace>();
-
-  auto xcos_ = xcos;
-  auto xsin_ = xsin;
-  auto ycos_ = ycos;
-  auto ysin_ = ysin;
-  auto zcos_ = zcos;
-  auto zsin_ = zsin;
-
-  for (int n=0; n<mode_count_; n++) {
-    par_for("force_compute", DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
-    KOKKOS_LAMBDA(int m, int k, int j, int i) {
-      force_tmp_(m,0,k,j,i) += xccc_.d_view(n)*xcos_(m,n,i)*ycos_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,0,k,j,i) += xccs_.d_view(n)*xcos_(m,n,i)*ycos_(m,n,j)*zsin_(m,n,k);
-      force_tmp_(m,0,k,j,i) += xcsc_.d_view(n)*xcos_(m,n,i)*ysin_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,0,k,j,i) += xcss_.d_view(n)*xcos_(m,n,i)*ysin_(m,n,j)*zsin_(m,n,k);
-      force_tmp_(m,0,k,j,i) += xscc_.d_view(n)*xsin_(m,n,i)*ycos_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,0,k,j,i) += xscs_.d_view(n)*xsin_(m,n,i)*ycos_(m,n,j)*zsin_(m,n,k);
-      force_tmp_(m,0,k,j,i) += xssc_.d_view(n)*xsin_(m,n,i)*ysin_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,0,k,j,i) += xsss_.d_view(n)*xsin_(m,n,i)*ysin_(m,n,j)*zsin_(m,n,k);
-
-      force_tmp_(m,1,k,j,i) += yccc_.d_view(n)*xcos_(m,n,i)*ycos_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,1,k,j,i) += yccs_.d_view(n)*xcos_(m,n,i)*ycos_(m,n,j)*zsin_(m,n,k);
-      force_tmp_(m,1,k,j,i) += ycsc_.d_view(n)*xcos_(m,n,i)*ysin_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,1,k,j,i) += ycss_.d_view(n)*xcos_(m,n,i)*ysin_(m,n,j)*zsin_(m,n,k);
-      force_tmp_(m,1,k,j,i) += yscc_.d_view(n)*xsin_(m,n,i)*ycos_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,1,k,j,i) += yscs_.d_view(n)*xsin_(m,n,i)*ycos_(m,n,j)*zsin_(m,n,k);
-      force_tmp_(m,1,k,j,i) += yssc_.d_view(n)*xsin_(m,n,i)*ysin_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,1,k,j,i) += ysss_.d_view(n)*xsin_(m,n,i)*ysin_(m,n,j)*zsin_(m,n,k);
-
-      force_tmp_(m,2,k,j,i) += zccc_.d_view(n)*xcos_(m,n,i)*ycos_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,2,k,j,i) += zccs_.d_view(n)*xcos_(m,n,i)*ycos_(m,n,j)*zsin_(m,n,k);
-      force_tmp_(m,2,k,j,i) += zcsc_.d_view(n)*xcos_(m,n,i)*ysin_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,2,k,j,i) += zcss_.d_view(n)*xcos_(m,n,i)*ysin_(m,n,j)*zsin_(m,n,k);
-      force_tmp_(m,2,k,j,i) += zscc_.d_view(n)*xsin_(m,n,i)*ycos_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,2,k,j,i) += zscs_.d_view(n)*xsin_(m,n,i)*ycos_(m,n,j)*zsin_(m,n,k);
-      force_tmp_(m,2,k,j,i) += zssc_.d_view(n)*xsin_(m,n,i)*ysin_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,2,k,j,i) += zsss_.d_view(n)*xsin_(m,n,i)*ysin_(m,n,j)*zsin_(m,n,k);
-    });
-  }
-
-  DvceArray5D<Real> u0, u0_;
-  if (pmy_pack->phydro != nullptr) u0 = (pmy_pack->phydro->u0);
-  if (pmy_pack->pmhd != nullptr) u0 = (pmy_pack->pmhd->u0);
-  bool flag_twofl = false;
-  if (pmy_pack->pionn != nullptr) {
-    u0 = (pmy_pack->phydro->u0);
-    u0_ = (pmy_pack->pmhd->u0);
-    flag_twofl = true;
-  }
-
-  const int nmkji = nmb*nx3*nx2*nx1;
-  const int nkji = nx3*nx2*nx1;
-  const int nji  = nx2*nx1;
-  Real t0 = 0.0, t1 = 0.0, t2 = 0.0, t3 = 0.0;
-
-  Kokkos::parallel_reduce("net_mom_1", Kokkos::RangePolicy<>(DevExeSpace(),0,nmkji),
-  KOKKOS_LAMBDA(const int &idx, Real &sum_t0, Real &sum_t1,
-                                Real &sum_t2, Real &sum_t3) {
-    // compute n,k,j,i indices of thread
-    int m = (idx)/nkji;
-    int k = (idx - m*nkji)/nji;
-    int j = (idx - m*nkji - k*nji)/nx1;
-    int i = (idx - m*nkji - k*nji - j*nx1) + is;
-    k += ks;
-    j += js;
-    Real den = u0(m,IDN,k,j,i);
-    if (flag_twofl) {
-      den += u0_(m,IDN,k,j,i);
-    }
-    sum_t0 += den;
-    sum_t1 += den*force_tmp_(m,0,k,j,i);
-    sum_t2 += den*force_tmp_(m,1,k,j,i);
-    sum_t3 += den*force_tmp_(m,2,k,j,i);
-  }, Kokkos::Sum<Real>(t0), Kokkos::Sum<Real>(t1),
-     Kokkos::Sum<Real>(t2), Kokkos::Sum<Real>(t3));
-
-
-#if MPI_PARALLEL_ENABLED
-  Real m[4], gm[4];
-  m[0] = t0; m[1] = t1; m[2] = t2; m[3] = t3;
-  MPI_Allreduce(m, gm, 4, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  t0 = gm[0]; t1 = gm[1]; t2 = gm[2]; t3 = gm[3];
-#endif
-
-  par_for("force_remove_net_mom", DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
-  KOKKOS_LAMBDA(int m, int k, int j, int i) {
-    force_tmp_(m,0,k,j,i) -= t1/t0;
-    force_tmp_(m,1,k,j,i) -= t2/t0;
-    force_tmp_(m,2,k,j,i) -= t3/t0;
-  });
-
-  t0 = 0.0;
-  t1 = 0.0;
-  Kokkos::parallel_reduce("net_mom_2", Kokkos::RangePolicy<>(DevExeSpace(),0,nmkji),
-  KOKKOS_LAMBDA(const int &idx, Real &sum_t0, Real &sum_t1) {
-    // compute n,k,j,i indices of thread
-    int m = (idx)/nkji;
-    int k = (idx - m*nkji)/nji;
-    int j = (idx - m*nkji - k*nji)/nx1;
-    int i = (idx - m*nkji - k*nji - j*nx1) + is;
-    k += ks;
-    j += js;
-
-    Real den  = u0(m,IDN,k,j,i);
-    Real mom1 = u0(m,IM1,k,j,i);
-    Real mom2 = u0(m,IM2,k,j,i);
-    Real mom3 = u0(m,IM3,k,j,i);
-    if (flag_twofl) {
-      den  += u0_(m,IDN,k,j,i);
-      mom1 += u0_(m,IM1,k,j,i);
-      mom2 += u0_(m,IM2,k,j,i);
-      mom3 += u0_(m,IM3,k,j,i);
-    }
-    Real v1 = force_tmp_(m,0,k,j,i);
-    Real v2 = force_tmp_(m,1,k,j,i);
-    Real v3 = force_tmp_(m,2,k,j,i);
-
-    sum_t0 += den*(v1*v1+v2*v2+v3*v3);
-    sum_t1 += mom1*v1+mom2*v2+mom3*v3;
-  }, Kokkos::Sum<Real>(t0), Kokkos::Sum<Real>(t1));
-
-#if MPI_PARALLEL_ENABLED
-  m[0] = t0; m[1] = t1;
-  MPI_Allreduce(m, gm, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  t0 = gm[0]; t1 = gm[1];
-#endif
-
-  t0 = std::max(t0, 1.0e-20);
-  t1 = std::max(t1, 1.0e-20);
-
-  Real m0 = t0, m1 = t1;
-  Real dt = pm->dt;
-  Real dvol = 1.0/(gnx1*gnx2*gnx3);
-  m0 = 0.5*m0*dvol*dt;
-  m1 = m1*dvol;
-
-  Real s;
-  if (m1 >= 0) {
-    s = -m1/2./m0 + sqrt(m1*m1/4./m0/m0 + dedt/m0);
-  } else {
-    s = m1/2./m0 + sqrt(m1*m1/4./m0/m0 + dedt/m0);
-  }
-  if (m0 == 0.0) s = 0.0;
-
-  par_for("force_norm", DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
-  KOKKOS_LAMBDA(int m, int k, int j, int i) {
-    force_tmp_(m,0,k,j,i) *= s;
-    force_tmp_(m,1,k,j,i) *= s;
-    force_tmp_(m,2,k,j,i) *= s;
-  });
-
-  return TaskStatus::complete;
-}
-
-//----------------------------------------------------------------------------------------
-//! \fn apply forcing
-
-TaskStatus TurbulenceDriver::AddForcing(Driver *pdrive, int stage) {
-  Mesh *pm = pmy_pack->pmesh;
-  auto &indcs = pmy_pack->pmesh->mb_indcs;
-  int is = indcs.is, ie = indcs.ie;
-  int js = indcs.js, je = indcs.je;
-  int ks = indcs.ks, ke = indcs.ke;
-  int &nmb = pmy_pack->nmb_thispack;
-  int &nx1 = indcs.nx1;
-  int &nx2 = indcs.nx2;
-  int &nx3 = indcs.nx3;
+TaskStatus TurbulenceDriver::AddForcing(Driver *pdrive, int stage) {
+  Mesh *pm = pmy_pack->pmesh;
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  int &nmb = pmy_pack->nmb_thispack;
+  int &nx1 = indcs.nx1;
+  int &nx2 = indcs.nx2;
+  int &nx3 = indcs.nx3;
 
   Real dt = pm->dt;
   Real fcorr, gcorr;
@@ -863,15 +571,27 @@ TaskStatus TurbulenceDriver::AddForcing(Driver *pdrive, int stage) {
   auto force_ = force;
   auto force_tmp_ = force_tmp;
 
-  par_for("force_OU_process",DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
-  KOKKOS_LAMBDA(int m, int k, int j, int i) {
+  const int nmkji = nmb*nx3*nx2*nx1;
+  const int nkji = nx3*nx2*nx1;
+  const int nji = nx2*nx1;
+
+  // Evolve force via O-U process and apply it in a single pass, which also sums the
+  // mass and momentum (after the update) needed to remove net momentum below
+  Real p0 = 0.0, p1 = 0.0, p2 = 0.0, p3 = 0.0;
+  Kokkos::parallel_reduce("force_push", Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
+  KOKKOS_LAMBDA(const int &idx, Real &sum_p0, Real &sum_p1, Real &sum_p2,
+                Real &sum_p3) {
+    // compute n,k,j,i indices of thread
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/nx1;
+    int i = (idx - m*nkji - k*nji - j*nx1) + is;
+    k += ks;
+    j += js;
+
     force_(m,0,k,j,i) = fcorr*force_(m,0,k,j,i) + gcorr*force_tmp_(m,0,k,j,i);
     force_(m,1,k,j,i) = fcorr*force_(m,1,k,j,i) + gcorr*force_tmp_(m,1,k,j,i);
     force_(m,2,k,j,i) = fcorr*force_(m,2,k,j,i) + gcorr*force_tmp_(m,2,k,j,i);
-  });
-
-  par_for("push",DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
-  KOKKOS_LAMBDA(int m, int k, int j, int i) {
     Real v1 = force_(m,0,k,j,i);
     Real v2 = force_(m,1,k,j,i);
     Real v3 = force_(m,2,k,j,i);
@@ -894,18 +614,23 @@ TaskStatus TurbulenceDriver::AddForcing(Driver *pdrive, int stage) {
     u0(m,IM1,k,j,i) += den*v1*dt;
     u0(m,IM2,k,j,i) += den*v2*dt;
     u0(m,IM3,k,j,i) += den*v3*dt;
+    sum_p0 += u0(m,IDN,k,j,i);
+    sum_p1 += u0(m,IM1,k,j,i);
+    sum_p2 += u0(m,IM2,k,j,i);
+    sum_p3 += u0(m,IM3,k,j,i);
 
     if (flag_twofl) {
       den = u0_(m,IDN,k,j,i);
       u0_(m,IM1,k,j,i) += den*v1*dt;
       u0_(m,IM2,k,j,i) += den*v2*dt;
       u0_(m,IM3,k,j,i) += den*v3*dt;
+      sum_p0 += den;
+      sum_p1 += u0_(m,IM1,k,j,i);
+      sum_p2 += u0_(m,IM2,k,j,i);
+      sum_p3 += u0_(m,IM3,k,j,i);
     }
-  });
-
-  const int nmkji = nmb*nx3*nx2*nx1;
-  const int nkji = nx3*nx2*nx1;
-  const int nji = nx2*nx1;
+  }, Kokkos::Sum<Real>(p0), Kokkos::Sum<Real>(p1),
+     Kokkos::Sum<Real>(p2), Kokkos::Sum<Real>(p3));
 
   // Relativistic case will require a Lorentz transformation
   if (flag_relativistic) {
@@ -1033,7 +758,7 @@ TaskStatus TurbulenceDriver::AddForcing(Driver *pdrive, int stage) {
 #if MPI_PARALLEL_ENABLED
     Real m[4], gm[4];
     m[0] = t0; m[1] = t1; m[2] = t2; m[3] = t3;
-    MPI_Allreduce(m, gm, 4, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(m, gm, 4, MPI_DOUBLE, MPI_SUM, global_variable::athena_comm);
     t0 = gm[0]; t1 = gm[1]; t2 = gm[2]; t3 = gm[3];
 #endif
 
@@ -1145,41 +870,12 @@ TaskStatus TurbulenceDriver::AddForcing(Driver *pdrive, int stage) {
     }
 
   } else {
-    // remove net momentum
-    Real t0 = 0.0, t1 = 0.0, t2 = 0.0, t3 = 0.0;
-    Kokkos::parallel_reduce("net_mom_3", Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
-    KOKKOS_LAMBDA(const int &idx, Real &sum_t0, Real &sum_t1, Real &sum_t2,
-                  Real &sum_t3) {
-      // compute n,k,j,i indices of thread
-      int m = (idx)/nkji;
-      int k = (idx - m*nkji)/nji;
-      int j = (idx - m*nkji - k*nji)/nx1;
-      int i = (idx - m*nkji - k*nji - j*nx1) + is;
-      k += ks;
-      j += js;
-
-      Real den = u0(m,IDN,k,j,i);
-      Real mom1 = u0(m,IM1,k,j,i);
-      Real mom2 = u0(m,IM2,k,j,i);
-      Real mom3 = u0(m,IM3,k,j,i);
-      if (flag_twofl) {
-        den += u0_(m,IDN,k,j,i);
-        mom1 += u0_(m,IM1,k,j,i);
-        mom2 += u0_(m,IM2,k,j,i);
-        mom3 += u0_(m,IM3,k,j,i);
-      }
-
-      sum_t0 += den;
-      sum_t1 += mom1;
-      sum_t2 += mom2;
-      sum_t3 += mom3;
-    }, Kokkos::Sum<Real>(t0), Kokkos::Sum<Real>(t1),
-       Kokkos::Sum<Real>(t2), Kokkos::Sum<Real>(t3));
-
+    // remove net momentum, using mass and momentum summed in force_push
+    Real t0 = p0, t1 = p1, t2 = p2, t3 = p3;
 #if MPI_PARALLEL_ENABLED
     Real m[4], gm[4];
     m[0] = t0; m[1] = t1; m[2] = t2; m[3] = t3;
-    MPI_Allreduce(m, gm, 4, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(m, gm, 4, MPI_DOUBLE, MPI_SUM, global_variable::athena_comm);
     t0 = gm[0]; t1 = gm[1]; t2 = gm[2]; t3 = gm[3];
 #endif
 
@@ -1214,3 +910,472 @@ TaskStatus TurbulenceDriver::AddForcing(Driver *pdrive, int stage) {
 
   return TaskStatus::complete;
 }
+
+//----------------------------------------------------------------------------------------
+//! \fn void DrawAmplitudesHost()
+//  \brief Draws random amplitudes of all modes on the host with the sequential RNG in
+//  utils/random.hpp, and copies them to the device.
+
+void TurbulenceDriver::DrawAmplitudesHost() {
+  Mesh *pm = pmy_pack->pmesh;
+  int nlow_sqr = SQR(nlow);
+  int nhigh_sqr = SQR(nhigh);
+
+  auto xccc_ = xccc;
+  auto xccs_ = xccs;
+  auto xcsc_ = xcsc;
+  auto xcss_ = xcss;
+  auto xscc_ = xscc;
+  auto xscs_ = xscs;
+  auto xssc_ = xssc;
+  auto xsss_ = xsss;
+
+  auto yccc_ = yccc;
+  auto yccs_ = yccs;
+  auto ycsc_ = ycsc;
+  auto ycss_ = ycss;
+  auto yscc_ = yscc;
+  auto yscs_ = yscs;
+  auto yssc_ = yssc;
+  auto ysss_ = ysss;
+
+  auto zccc_ = zccc;
+  auto zccs_ = zccs;
+  auto zcsc_ = zcsc;
+  auto zcss_ = zcss;
+  auto zscc_ = zscc;
+  auto zscs_ = zscs;
+  auto zssc_ = zssc;
+  auto zsss_ = zsss;
+
+  Real dkx, dky, dkz, kx, ky, kz;
+  Real iky, ikz;
+  Real lx = pm->mesh_size.x1max - pm->mesh_size.x1min;
+  Real ly = pm->mesh_size.x2max - pm->mesh_size.x2min;
+  Real lz = pm->mesh_size.x3max - pm->mesh_size.x3min;
+  dkx = 2.0*M_PI/lx;
+  dky = 2.0*M_PI/ly;
+  dkz = 2.0*M_PI/lz;
+
+  Real &ex = expo;
+  Real &ex_prp = exp_prp;
+  Real &ex_prl = exp_prl;
+  Real norm, kprl, kprp, kiso;
+
+  int nmode = 0;
+  int nkx, nky, nkz, nsqr;
+  for (nkx = 0; nkx <= nhigh; nkx++) {
+    for (nky = 0; nky <= nhigh; nky++) {
+      for (nkz = 0; nkz <= nhigh; nkz++) {
+        if (nkx == 0 && nky == 0 && nkz == 0) continue;
+        norm = 0.0;
+        nsqr = 0.0;
+        bool flag_prl = true;
+        if (driving_type == 0) {
+          nsqr = SQR(nkx) + SQR(nky) + SQR(nkz);
+        } else if (driving_type == 1) {
+          nsqr = SQR(nkx) + SQR(nky);
+          Real nprlsqr = SQR(nkz);
+          if (nprlsqr >= nlow_sqr && nprlsqr <= nhigh_sqr) {
+            flag_prl = true;
+          } else {
+            flag_prl = false;
+          }
+        }
+        if (nsqr >= nlow_sqr && nsqr <= nhigh_sqr && flag_prl) {
+          kx = dkx*nkx;
+          ky = dky*nky;
+          kz = dkz*nkz;
+
+          // Generate Fourier amplitudes
+          if (driving_type == 0) {
+            kiso = sqrt(SQR(kx) + SQR(ky) + SQR(kz));
+            if (kiso > 1e-16) {
+              norm = 1.0/pow(kiso,(ex+2.0)/2.0);
+            } else {
+              norm = 0.0;
+            }
+            if (nkz != 0) {
+              ikz = 1.0/(dkz*((Real) nkz));
+
+              xccc_.h_view(nmode) = RanGaussianSt(&(rstate));
+              xccs_.h_view(nmode) = RanGaussianSt(&(rstate));
+              xcsc_.h_view(nmode) = (nky==0)           ? 0.0 : RanGaussianSt(&(rstate));
+              xcss_.h_view(nmode) = (nky==0)           ? 0.0 : RanGaussianSt(&(rstate));
+              xscc_.h_view(nmode) = (nkx==0)           ? 0.0 : RanGaussianSt(&(rstate));
+              xscs_.h_view(nmode) = (nkx==0)           ? 0.0 : RanGaussianSt(&(rstate));
+              xssc_.h_view(nmode) = (nkx==0 || nky==0) ? 0.0 : RanGaussianSt(&(rstate));
+              xsss_.h_view(nmode) = (nkx==0 || nky==0) ? 0.0 : RanGaussianSt(&(rstate));
+
+              yccc_.h_view(nmode) = RanGaussianSt(&(rstate));
+              yccs_.h_view(nmode) = RanGaussianSt(&(rstate));
+              ycsc_.h_view(nmode) = (nky==0)           ? 0.0 : RanGaussianSt(&(rstate));
+              ycss_.h_view(nmode) = (nky==0)           ? 0.0 : RanGaussianSt(&(rstate));
+              yscc_.h_view(nmode) = (nkx==0)           ? 0.0 : RanGaussianSt(&(rstate));
+              yscs_.h_view(nmode) = (nkx==0)           ? 0.0 : RanGaussianSt(&(rstate));
+              yssc_.h_view(nmode) = (nkx==0 || nky==0) ? 0.0 : RanGaussianSt(&(rstate));
+              ysss_.h_view(nmode) = (nkx==0 || nky==0) ? 0.0 : RanGaussianSt(&(rstate));
+
+              // imcompressibility
+              zccc_.h_view(nmode) =  ikz*( kx*xscs_.h_view(nmode)+ky*ycss_.h_view(nmode));
+              zccs_.h_view(nmode) = -ikz*( kx*xscc_.h_view(nmode)+ky*ycsc_.h_view(nmode));
+              zcsc_.h_view(nmode) =  ikz*( kx*xsss_.h_view(nmode)-ky*yccs_.h_view(nmode));
+              zcss_.h_view(nmode) =  ikz*(-kx*xssc_.h_view(nmode)+ky*yccc_.h_view(nmode));
+              zscc_.h_view(nmode) =  ikz*(-kx*xccs_.h_view(nmode)+ky*ysss_.h_view(nmode));
+              zscs_.h_view(nmode) =  ikz*( kx*xccc_.h_view(nmode)-ky*yssc_.h_view(nmode));
+              zssc_.h_view(nmode) = -ikz*( kx*xcss_.h_view(nmode)+ky*yscs_.h_view(nmode));
+              zsss_.h_view(nmode) =  ikz*( kx*xcsc_.h_view(nmode)+ky*yscc_.h_view(nmode));
+            } else if (nky != 0) {  // kz == 0
+              iky = 1.0/(dky*((Real) nky));
+
+              xccc_.h_view(nmode) = RanGaussianSt(&(rstate));
+              xcsc_.h_view(nmode) = RanGaussianSt(&(rstate));
+              xscc_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
+              xssc_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
+              xccs_.h_view(nmode) = 0.0;
+              xscs_.h_view(nmode) = 0.0;
+              xcss_.h_view(nmode) = 0.0;
+              xsss_.h_view(nmode) = 0.0;
+
+              zccc_.h_view(nmode) = RanGaussianSt(&(rstate));
+              zcsc_.h_view(nmode) = RanGaussianSt(&(rstate));
+              zscc_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
+              zssc_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
+              zccs_.h_view(nmode) = 0.0;
+              zcss_.h_view(nmode) = 0.0;
+              zscs_.h_view(nmode) = 0.0;
+              zsss_.h_view(nmode) = 0.0;
+
+              // incompressibility
+              yccc_.h_view(nmode) =  iky*kx*xssc_.h_view(nmode);
+              ycsc_.h_view(nmode) = -iky*kx*xscc_.h_view(nmode);
+              yscc_.h_view(nmode) = -iky*kx*xcsc_.h_view(nmode);
+              yssc_.h_view(nmode) =  iky*kx*xccc_.h_view(nmode);
+              yccs_.h_view(nmode) = 0.0;
+              ycss_.h_view(nmode) = 0.0;
+              yscs_.h_view(nmode) = 0.0;
+              ysss_.h_view(nmode) = 0.0;
+            } else {  // kz == ky == 0, kx != 0 by initial if statement
+              zccc_.h_view(nmode) = RanGaussianSt(&(rstate));
+              zscc_.h_view(nmode) = RanGaussianSt(&(rstate));
+              zcsc_.h_view(nmode) = 0.0;
+              zssc_.h_view(nmode) = 0.0;
+              zccs_.h_view(nmode) = 0.0;
+              zcss_.h_view(nmode) = 0.0;
+              zscs_.h_view(nmode) = 0.0;
+              zsss_.h_view(nmode) = 0.0;
+
+              yccc_.h_view(nmode) = RanGaussianSt(&(rstate));
+              yscc_.h_view(nmode) = RanGaussianSt(&(rstate));
+              ycsc_.h_view(nmode) = 0.0;
+              yssc_.h_view(nmode) = 0.0;
+              yccs_.h_view(nmode) = 0.0;
+              ycss_.h_view(nmode) = 0.0;
+              yscs_.h_view(nmode) = 0.0;
+              ysss_.h_view(nmode) = 0.0;
+
+              // incompressibility
+              xccc_.h_view(nmode) = 0.0;
+              xscc_.h_view(nmode) = 0.0;
+              xcsc_.h_view(nmode) = 0.0;
+              xssc_.h_view(nmode) = 0.0;
+              xccs_.h_view(nmode) = 0.0;
+              xscs_.h_view(nmode) = 0.0;
+              xcss_.h_view(nmode) = 0.0;
+              xsss_.h_view(nmode) = 0.0;
+            }
+          } else if (driving_type == 1) {
+            kprl = sqrt(SQR(kx));
+            kprp = sqrt(SQR(ky) + SQR(kz));
+            if (kprl > 1e-16 && kprp > 1e-16) {
+              norm = 1.0/pow(kprp,(ex_prp+1.0)/2.0)/pow(kprl,ex_prl/2.0);
+            } else {
+              norm = 0.0;
+            }
+
+            if (nky != 0) {
+              iky = 1.0/(dky*((Real) nky));
+
+              xccc_.h_view(nmode) = RanGaussianSt(&(rstate));
+              xccs_.h_view(nmode) = RanGaussianSt(&(rstate));
+              xcsc_.h_view(nmode) = RanGaussianSt(&(rstate));
+              xcss_.h_view(nmode) = RanGaussianSt(&(rstate));
+              xscc_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
+              xscs_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
+              xssc_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
+              xsss_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
+
+              // incompressibility
+              yccc_.h_view(nmode) =  iky*(kx*xssc_.h_view(nmode));
+              yccs_.h_view(nmode) =  iky*(kx*xsss_.h_view(nmode));
+              ycsc_.h_view(nmode) = -iky*(kx*xscc_.h_view(nmode));
+              ycss_.h_view(nmode) = -iky*(kx*xscs_.h_view(nmode));
+              yscc_.h_view(nmode) = -iky*(kx*xcsc_.h_view(nmode));
+              yscs_.h_view(nmode) = -iky*(kx*xcss_.h_view(nmode));
+              yssc_.h_view(nmode) =  iky*(kx*xccc_.h_view(nmode));
+              ysss_.h_view(nmode) =  iky*(kx*xccs_.h_view(nmode));
+
+              zccc_.h_view(nmode) = 0.0;
+              zccs_.h_view(nmode) = 0.0;
+              zcsc_.h_view(nmode) = 0.0;
+              zcss_.h_view(nmode) = 0.0;
+              zscc_.h_view(nmode) = 0.0;
+              zscs_.h_view(nmode) = 0.0;
+              zssc_.h_view(nmode) = 0.0;
+              zsss_.h_view(nmode) = 0.0;
+            } else {  // ky == 0
+              yccc_.h_view(nmode) = RanGaussianSt(&(rstate));
+              yscc_.h_view(nmode) = RanGaussianSt(&(rstate));
+              ycsc_.h_view(nmode) = 0.0;
+              yssc_.h_view(nmode) = 0.0;
+              yccs_.h_view(nmode) = 0.0;
+              ycss_.h_view(nmode) = 0.0;
+              yscs_.h_view(nmode) = 0.0;
+              ysss_.h_view(nmode) = 0.0;
+
+              // incompressibility
+              xccc_.h_view(nmode) = 0.0;
+              xscc_.h_view(nmode) = 0.0;
+              xcsc_.h_view(nmode) = 0.0;
+              xssc_.h_view(nmode) = 0.0;
+              xccs_.h_view(nmode) = 0.0;
+              xscs_.h_view(nmode) = 0.0;
+              xcss_.h_view(nmode) = 0.0;
+              xsss_.h_view(nmode) = 0.0;
+
+              zccc_.h_view(nmode) = 0.0;
+              zscc_.h_view(nmode) = 0.0;
+              zcsc_.h_view(nmode) = 0.0;
+              zssc_.h_view(nmode) = 0.0;
+              zccs_.h_view(nmode) = 0.0;
+              zcss_.h_view(nmode) = 0.0;
+              zscs_.h_view(nmode) = 0.0;
+              zsss_.h_view(nmode) = 0.0;
+            }
+          }
+          // normalization
+          xccc_.h_view(nmode) *= norm;
+          xscc_.h_view(nmode) *= norm;
+          xcsc_.h_view(nmode) *= norm;
+          xssc_.h_view(nmode) *= norm;
+          xccs_.h_view(nmode) *= norm;
+          xscs_.h_view(nmode) *= norm;
+          xcss_.h_view(nmode) *= norm;
+          xsss_.h_view(nmode) *= norm;
+          yccc_.h_view(nmode) *= norm;
+          yscc_.h_view(nmode) *= norm;
+          ycsc_.h_view(nmode) *= norm;
+          yssc_.h_view(nmode) *= norm;
+          yccs_.h_view(nmode) *= norm;
+          yscs_.h_view(nmode) *= norm;
+          ycss_.h_view(nmode) *= norm;
+          ysss_.h_view(nmode) *= norm;
+          zccc_.h_view(nmode) *= norm;
+          zscc_.h_view(nmode) *= norm;
+          zcsc_.h_view(nmode) *= norm;
+          zssc_.h_view(nmode) *= norm;
+          zccs_.h_view(nmode) *= norm;
+          zscs_.h_view(nmode) *= norm;
+          zcss_.h_view(nmode) *= norm;
+          zsss_.h_view(nmode) *= norm;
+
+          nmode++;
+        }
+      }
+    }
+  }
+
+  xccc_.template modify<HostMemSpace>();
+  xccc_.template sync<DevExeSpace>();
+  xccs_.template modify<HostMemSpace>();
+  xccs_.template sync<DevExeSpace>();
+  xcsc_.template modify<HostMemSpace>();
+  xcsc_.template sync<DevExeSpace>();
+  xcss_.template modify<HostMemSpace>();
+  xcss_.template sync<DevExeSpace>();
+  xscc_.template modify<HostMemSpace>();
+  xscc_.template sync<DevExeSpace>();
+  xscs_.template modify<HostMemSpace>();
+  xscs_.template sync<DevExeSpace>();
+  xssc_.template modify<HostMemSpace>();
+  xssc_.template sync<DevExeSpace>();
+  xsss_.template modify<HostMemSpace>();
+  xsss_.template sync<DevExeSpace>();
+
+  yccc_.template modify<HostMemSpace>();
+  yccc_.template sync<DevExeSpace>();
+  yccs_.template modify<HostMemSpace>();
+  yccs_.template sync<DevExeSpace>();
+  ycsc_.template modify<HostMemSpace>();
+  ycsc_.template sync<DevExeSpace>();
+  ycss_.template modify<HostMemSpace>();
+  ycss_.template sync<DevExeSpace>();
+  yscc_.template modify<HostMemSpace>();
+  yscc_.template sync<DevExeSpace>();
+  yscs_.template modify<HostMemSpace>();
+  yscs_.template sync<DevExeSpace>();
+  yssc_.template modify<HostMemSpace>();
+  yssc_.template sync<DevExeSpace>();
+  ysss_.template modify<HostMemSpace>();
+  ysss_.template sync<DevExeSpace>();
+
+  zccc_.template modify<HostMemSpace>();
+  zccc_.template sync<DevExeSpace>();
+  zccs_.template modify<HostMemSpace>();
+  zccs_.template sync<DevExeSpace>();
+  zcsc_.template modify<HostMemSpace>();
+  zcsc_.template sync<DevExeSpace>();
+  zcss_.template modify<HostMemSpace>();
+  zcss_.template sync<DevExeSpace>();
+  zscc_.template modify<HostMemSpace>();
+  zscc_.template sync<DevExeSpace>();
+  zscs_.template modify<HostMemSpace>();
+  zscs_.template sync<DevExeSpace>();
+  zssc_.template modify<HostMemSpace>();
+  zssc_.template sync<DevExeSpace>();
+  zsss_.template modify<HostMemSpace>();
+  zsss_.template sync<DevExeSpace>();
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void DrawAmplitudesDevice()
+//  \brief Draws random amplitudes of all modes in parallel on the device with the
+//  counter-based RNG in utils/random.hpp, using the given stream (the cycle number) and
+//  the index of the mode and amplitude as counter.  The amplitudes are therefore the same
+//  on all ranks and independent of the number of ranks, and reproducible after restarts,
+//  without any host loops or host-device transfers.  Modes, zeros, and the constraints
+//  from incompressibility are as in DrawAmplitudesHost().
+
+void TurbulenceDriver::DrawAmplitudesDevice(const int64_t stream) {
+  Mesh *pm = pmy_pack->pmesh;
+  Real lx = pm->mesh_size.x1max - pm->mesh_size.x1min;
+  Real ly = pm->mesh_size.x2max - pm->mesh_size.x2min;
+  Real lz = pm->mesh_size.x3max - pm->mesh_size.x3min;
+  Real dkx = 2.0*M_PI/lx;
+  Real dky = 2.0*M_PI/ly;
+  Real dkz = 2.0*M_PI/lz;
+  Real ex = expo, ex_prp = exp_prp, ex_prl = exp_prl;
+  int dtype = driving_type;
+  int64_t seed = rng_seed;
+  auto nmode_ = n_mode.d_view;
+
+  auto xccc_ = xccc.d_view, xccs_ = xccs.d_view, xcsc_ = xcsc.d_view;
+  auto xcss_ = xcss.d_view, xscc_ = xscc.d_view, xscs_ = xscs.d_view;
+  auto xssc_ = xssc.d_view, xsss_ = xsss.d_view;
+  auto yccc_ = yccc.d_view, yccs_ = yccs.d_view, ycsc_ = ycsc.d_view;
+  auto ycss_ = ycss.d_view, yscc_ = yscc.d_view, yscs_ = yscs.d_view;
+  auto yssc_ = yssc.d_view, ysss_ = ysss.d_view;
+  auto zccc_ = zccc.d_view, zccs_ = zccs.d_view, zcsc_ = zcsc.d_view;
+  auto zcss_ = zcss.d_view, zscc_ = zscc.d_view, zscs_ = zscs.d_view;
+  auto zssc_ = zssc.d_view, zsss_ = zsss.d_view;
+
+  par_for("turb_amplitudes", DevExeSpace(), 0, mode_count-1,
+  KOKKOS_LAMBDA(int n) {
+    enum {ccc, ccs, csc, css, scc, scs, ssc, sss};
+    int nkx = nmode_(n,0), nky = nmode_(n,1), nkz = nmode_(n,2);
+    Real kx = dkx*nkx, ky = dky*nky, kz = dkz*nkz;
+    // amplitudes of x,y,z components, and random deviate for each one (24 per mode)
+    Real x[8], y[8], z[8];
+    for (int l=0; l<8; ++l) {x[l] = 0.0; y[l] = 0.0; z[l] = 0.0;}
+    auto ran = [=](const int l) {
+      return RanGaussianCounter(seed, stream, 24*static_cast<int64_t>(n) + l);
+    };
+
+    Real norm = 0.0;
+    if (dtype == 0) {
+      Real kiso = sqrt(SQR(kx) + SQR(ky) + SQR(kz));
+      if (kiso > 1e-16) {norm = 1.0/pow(kiso,(ex+2.0)/2.0);}
+      if (nkz != 0) {
+        Real ikz = 1.0/(dkz*static_cast<Real>(nkz));
+        for (int l=0; l<8; ++l) {
+          bool zero = ((l == csc || l == css) && nky == 0) ||
+                      ((l == scc || l == scs) && nkx == 0) ||
+                      ((l == ssc || l == sss) && (nkx == 0 || nky == 0));
+          x[l] = (zero)? 0.0 : ran(l);
+          y[l] = (zero)? 0.0 : ran(8 + l);
+        }
+        // incompressibility
+        z[ccc] =  ikz*( kx*x[scs] + ky*y[css]);
+        z[ccs] = -ikz*( kx*x[scc] + ky*y[csc]);
+        z[csc] =  ikz*( kx*x[sss] - ky*y[ccs]);
+        z[css] =  ikz*(-kx*x[ssc] + ky*y[ccc]);
+        z[scc] =  ikz*(-kx*x[ccs] + ky*y[sss]);
+        z[scs] =  ikz*( kx*x[ccc] - ky*y[ssc]);
+        z[ssc] = -ikz*( kx*x[css] + ky*y[scs]);
+        z[sss] =  ikz*( kx*x[csc] + ky*y[scc]);
+      } else if (nky != 0) {  // kz == 0
+        Real iky = 1.0/(dky*static_cast<Real>(nky));
+        x[ccc] = ran(0);
+        x[csc] = ran(1);
+        x[scc] = (nkx == 0)? 0.0 : ran(2);
+        x[ssc] = (nkx == 0)? 0.0 : ran(3);
+        z[ccc] = ran(16);
+        z[csc] = ran(17);
+        z[scc] = (nkx == 0)? 0.0 : ran(18);
+        z[ssc] = (nkx == 0)? 0.0 : ran(19);
+        // incompressibility
+        y[ccc] =  iky*kx*x[ssc];
+        y[csc] = -iky*kx*x[scc];
+        y[scc] = -iky*kx*x[csc];
+        y[ssc] =  iky*kx*x[ccc];
+      } else {  // kz == ky == 0, kx != 0
+        z[ccc] = ran(16);
+        z[scc] = ran(17);
+        y[ccc] = ran(8);
+        y[scc] = ran(9);
+      }
+    } else if (dtype == 1) {
+      Real kprl = sqrt(SQR(kx));
+      Real kprp = sqrt(SQR(ky) + SQR(kz));
+      if (kprl > 1e-16 && kprp > 1e-16) {
+        norm = 1.0/pow(kprp,(ex_prp+1.0)/2.0)/pow(kprl,ex_prl/2.0);
+      }
+      if (nky != 0) {
+        Real iky = 1.0/(dky*static_cast<Real>(nky));
+        for (int l=0; l<8; ++l) {
+          x[l] = (l >= scc && nkx == 0)? 0.0 : ran(l);
+        }
+        // incompressibility
+        y[ccc] =  iky*(kx*x[ssc]);
+        y[ccs] =  iky*(kx*x[sss]);
+        y[csc] = -iky*(kx*x[scc]);
+        y[css] = -iky*(kx*x[scs]);
+        y[scc] = -iky*(kx*x[csc]);
+        y[scs] = -iky*(kx*x[css]);
+        y[ssc] =  iky*(kx*x[ccc]);
+        y[sss] =  iky*(kx*x[ccs]);
+      } else {  // ky == 0
+        y[ccc] = ran(8);
+        y[scc] = ran(9);
+      }
+    }
+
+    // normalization
+    xccc_(n) = norm*x[ccc]; xccs_(n) = norm*x[ccs]; xcsc_(n) = norm*x[csc];
+    xcss_(n) = norm*x[css]; xscc_(n) = norm*x[scc]; xscs_(n) = norm*x[scs];
+    xssc_(n) = norm*x[ssc]; xsss_(n) = norm*x[sss];
+    yccc_(n) = norm*y[ccc]; yccs_(n) = norm*y[ccs]; ycsc_(n) = norm*y[csc];
+    ycss_(n) = norm*y[css]; yscc_(n) = norm*y[scc]; yscs_(n) = norm*y[scs];
+    yssc_(n) = norm*y[ssc]; ysss_(n) = norm*y[sss];
+    zccc_(n) = norm*z[ccc]; zccs_(n) = norm*z[ccs]; zcsc_(n) = norm*z[csc];
+    zcss_(n) = norm*z[css]; zscc_(n) = norm*z[scc]; zscs_(n) = norm*z[scs];
+    zssc_(n) = norm*z[ssc]; zsss_(n) = norm*z[sss];
+  });
+
+  // host copies of amplitudes are now out of date
+  xccc.template modify<DevExeSpace>(); xccs.template modify<DevExeSpace>();
+  xcsc.template modify<DevExeSpace>(); xcss.template modify<DevExeSpace>();
+  xscc.template modify<DevExeSpace>(); xscs.template modify<DevExeSpace>();
+  xssc.template modify<DevExeSpace>(); xsss.template modify<DevExeSpace>();
+  yccc.template modify<DevExeSpace>(); yccs.template modify<DevExeSpace>();
+  ycsc.template modify<DevExeSpace>(); ycss.template modify<DevExeSpace>();
+  yscc.template modify<DevExeSpace>(); yscs.template modify<DevExeSpace>();
+  yssc.template modify<DevExeSpace>(); ysss.template modify<DevExeSpace>();
+  zccc.template modify<DevExeSpace>(); zccs.template modify<DevExeSpace>();
+  zcsc.template modify<DevExeSpace>(); zcss.template modify<DevExeSpace>();
+  zscc.template modify<DevExeSpace>(); zscs.template modify<DevExeSpace>();
+  zssc.template modify<DevExeSpace>(); zsss.template modify<DevExeSpace>();
+  return;
+}
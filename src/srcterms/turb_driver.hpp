@@ -26,11 +26,14 @@ class TurbulenceDriver {
 
   DvceArray5D<Real> force, force_tmp;  // arrays used for turb forcing
   RNG_State rstate;                    // random state
+  bool device_rng;                     // draw amplitudes on device with counter RNG
+  int64_t rng_seed;                    // seed of counter-based RNG
 
   DualArray1D<Real> xccc, xccs, xcsc, xcss, xscc, xscs, xssc, xsss;
   DualArray1D<Real> yccc, yccs, ycsc, ycss, yscc, yscs, yssc, ysss;
   DualArray1D<Real> zccc, zccs, zcsc, zcss, zscc, zscs, zssc, zsss;
   DualArray1D<Real> kx_mode, ky_mode, kz_mode;
+  DualArray2D<int> n_mode;             // integer wavenumbers (nkx,nky,nkz) of each mode
   DvceArray3D<Real> xcos, xsin, ycos, ysin, zcos, zsin;
 
   // parameters of driving
@@ -48,6 +51,8 @@ class TurbulenceDriver {
   void Initialize();
 
  private:
+  void DrawAmplitudesHost();
+  void DrawAmplitudesDevice(const int64_t stream);
   bool first_time = true;   // flag to enable initialization on first call
   MeshBlockPack *pmy_pack;  // ptr to MeshBlockPack containing this TurbulenceDriver
 };
@@ -109,6 +109,14 @@ void NumericalRelativity::AddExtraDependencies(std::vector<TaskName>& required,
   }
 }
 
+void NumericalRelativity::SetHostTask(TaskName name) {
+  for (auto queue : {&start_queue, &run_queue, &end_queue}) {
+    for (auto &task : *queue) {
+      if (task.name == name) {task.host = true;}
+    }
+  }
+}
+
 bool NumericalRelativity::AssembleNumericalRelativityTasks(
     std::shared_ptr<TaskList>& list, std::vector<QueuedTask> &queue) {
   int added = 0;
@@ -119,7 +127,18 @@ bool NumericalRelativity::AssembleNumericalRelativityTasks(
       TaskID dep(0);
       if (DependenciesMet(task, queue, dep) && !task.added) {
         task.added = true;
-        task.id = list->AddTask(task.func_, dep);
+        // with multirate evolution, fluid tasks only run on cycles the fluid is advanced
+        if (NeedsPhysics(task.name) == Phys_MHD && task.name != MHD_MRStart &&
+            task.name != MHD_MRTmunu && pmy_pack->pdyngr->nmultirate > 1) {
+          dyngr::DynGRMHD *pdyngr = pmy_pack->pdyngr;
+          auto func = task.func_;
+          task.id = list->AddTask([=](Driver *d, int s) -> TaskStatus {
+            return (pdyngr->FluidCycle())? func(d,s) : TaskStatus::complete;
+          }, dep);
+        } else {
+          task.id = list->AddTask(task.func_, dep);
+        }
+        if (task.host) {list->SetHostTask(task.id);}
         cycle_added++;
         added++;
         /*std::cout << "Successfully added " << task.name_string << " to task list!\n"
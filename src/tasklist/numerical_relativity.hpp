@@ -53,13 +53,16 @@ enum TaskName {
   MHD_Newdt,
   MHD_ClearS,
   MHD_ClearR,
+  MHD_MRStart,
+  MHD_MRMetric,
+  MHD_MRTmunu,
+  MHD_SetActive,
   MHD_NTASKS,
 
   Z4c_Recv,
   Z4c_IRecvW,
   Z4c_CopyU,
   Z4c_CalcRHS,
-  Z4c_SomBC,
   Z4c_ExplRK,
   Z4c_SendU,
   Z4c_RestU,
@@ -73,7 +76,6 @@ enum TaskName {
   Z4c_ADMC,
   Z4c_ClearS,
   Z4c_ClearR,
-  Z4c_Weyl,
   Z4c_RestW,
   Z4c_SendW,
   Z4c_RecvW,
@@ -82,6 +84,8 @@ enum TaskName {
   Z4c_ClearRW,
   Z4c_Wave,
   Z4c_PT,
+  Z4c_PTEvolve,
+  Z4c_AHF,
   Z4c_NTASKS
 };
 
@@ -104,6 +108,7 @@ struct QueuedTask {
   TaskName name;
   const std::string name_string;
   bool added;
+  bool host = false;  // run on HostTaskPool, see TaskList::SetHostTask()
   TaskID id;
   std::vector<TaskName> dependencies;
 
@@ -155,6 +160,9 @@ class NumericalRelativity {
       [=](Driver *d, int s) mutable -> TaskStatus {return (obj->*func)(d,s);}));
   }
 
+  // Flag a queued task to be run on the HostTaskPool once added to the task list
+  void SetHostTask(TaskName name);
+
   void AssembleNumericalRelativityTasks(
          std::map<std::string, std::shared_ptr<TaskList>>& tl);
 
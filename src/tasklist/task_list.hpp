@@ -13,17 +13,27 @@
 // This version includes improvements due to Josh Dolence and the Parthenon dev team, and
 // extensions by J.M.Stone.
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
-#include <bitset>
 #include <functional>
+#include <memory>
+#include <string>
 #include <vector>
 #include <list>
 #include <iterator>
 
+#include <Kokkos_Core.hpp>
+
+#include "utils/host_task_pool.hpp"
+
 class Driver;
 
-// Maximum size of TL
-#define NUMBER_TASKID_BITS 64
+// Number of bits in each word of TaskID bit field.  There is no limit on the number of
+// Tasks in a TaskList, the bit field simply grows by one word every 64 Tasks.
+#define TASKID_WORD_BITS 64
 
 // constants = return codes for functions working on individual Tasks and TaskList
 enum class TaskStatus {fail, complete, incomplete};
@@ -38,63 +48,102 @@ class TaskID {
   TaskID() = default;
   // ctor, default id = 0.
   explicit TaskID(unsigned int id) {
-    if (id == 0) {
-      bitfld_.reset();      // set all bits to zero
-    } else {
-      bitfld_.set((--id));  // set [id-1] bit to one
+    if (id != 0) {
+      --id;  // set [id-1] bit to one
+      bitfld_.assign(id/TASKID_WORD_BITS + 1, 0);
+      bitfld_.back() = (static_cast<std::uint64_t>(1) << (id % TASKID_WORD_BITS));
     }
   }
 
   // functions (all implemented here)
-  void Clear() { bitfld_.reset(); }  // set all bits to zero
+  void Clear() { bitfld_.clear(); }  // set all bits to zero
   // return true if input dependencies are clear
   bool CheckDependencies(const TaskID &dep) const {
-    return ((bitfld_ & dep.bitfld_) == dep.bitfld_);
+    for (std::size_t i=0; i<dep.bitfld_.size(); ++i) {
+      if ((Word(i) & dep.bitfld_[i]) != dep.bitfld_[i]) return false;
+    }
+    return true;
+  }
+  // return indices of all set bits (i.e. id-1 of each TaskID encoded in bit field)
+  std::vector<int> GetBits() const {
+    std::vector<int> bits;
+    for (std::size_t i=0; i<bitfld_.size(); ++i) {
+      for (int b=0; b<TASKID_WORD_BITS; ++b) {
+        if ((bitfld_[i] >> b) & 1) {bits.push_back(i*TASKID_WORD_BITS + b);}
+      }
+    }
+    return bits;
   }
   // output ID (useful for debugging)
-  void PrintID() {std::cout << "TaskID = " << bitfld_.to_string() << std::endl;}
+  void PrintID() {
+    std::string str(bitfld_.size()*TASKID_WORD_BITS, '0');
+    for (int b : GetBits()) {str[str.size() - 1 - b] = '1';}
+    std::cout << "TaskID = " << str << std::endl;
+  }
   // mark task with input TaskID as complete
-  void SetComplete(const TaskID &rhs) { bitfld_ |= rhs.bitfld_; }
+  void SetComplete(const TaskID &rhs) { *this = (*this | rhs); }
 
   // overload some operators
-  bool operator== (const TaskID &rhs) const {return (bitfld_ == rhs.bitfld_); }
-  bool operator!= (const TaskID &rhs) const {return (bitfld_ != rhs.bitfld_); }
+  bool operator== (const TaskID &rhs) const {
+    std::size_t n = std::max(bitfld_.size(), rhs.bitfld_.size());
+    for (std::size_t i=0; i<n; ++i) {
+      if (Word(i) != rhs.Word(i)) return false;
+    }
+    return true;
+  }
+  bool operator!= (const TaskID &rhs) const {return !(*this == rhs); }
   TaskID operator| (const TaskID &rhs) const {
     TaskID ret;
-    ret.bitfld_ = (bitfld_ | rhs.bitfld_);
+    ret.bitfld_.resize(std::max(bitfld_.size(), rhs.bitfld_.size()));
+    for (std::size_t i=0; i<ret.bitfld_.size(); ++i) {ret.bitfld_[i]=Word(i)|rhs.Word(i);}
     return ret;
   }
   TaskID operator^ (const TaskID &rhs) const {
     TaskID ret;
-    ret.bitfld_ = (bitfld_ ^ rhs.bitfld_);
+    ret.bitfld_.resize(std::max(bitfld_.size(), rhs.bitfld_.size()));
+    for (std::size_t i=0; i<ret.bitfld_.size(); ++i) {ret.bitfld_[i]=Word(i)^rhs.Word(i);}
     return ret;
   }
   TaskID operator& (const TaskID &rhs) const {
     TaskID ret;
-    ret.bitfld_ = (bitfld_ & rhs.bitfld_);
+    ret.bitfld_.resize(std::max(bitfld_.size(), rhs.bitfld_.size()));
+    for (std::size_t i=0; i<ret.bitfld_.size(); ++i) {ret.bitfld_[i]=Word(i)&rhs.Word(i);}
     return ret;
   }
 
  private:
-  std::bitset<NUMBER_TASKID_BITS> bitfld_;
+  // bit field stored as vector of 64-bit words, missing words are all zero
+  std::vector<std::uint64_t> bitfld_;
+  std::uint64_t Word(std::size_t i) const {return (i < bitfld_.size())? bitfld_[i] : 0;}
 };
 
 //----------------------------------------------------------------------------------------
 //! \class Task
 //  \brief data and function pointer for an individual Task
 //  NOTE: Task function must take arguments (Driver*, int)
+//  The callable (e.g. a lambda binding a member function to its object) is stored once
+//  on the heap when the Task is created, and called through a plain function pointer to
+//  a trampoline that is instantiated for its type, so no std::function is involved.
 
 class Task {
  public:
-  Task(TaskID id, TaskID dep, std::function<TaskStatus(Driver*, int)> func) :
-  myid_(id), dep_(dep), func_(func) {}
+  using TaskFunc = TaskStatus (*)(void *, Driver *, int);
+  template <class C>
+  Task(TaskID id, TaskID dep, C callable) :
+    myid_(id), dep_(dep), func_(&Invoke<C>), obj_(std::make_shared<C>(callable)) {}
   // overloaded operator() calls task function
-  TaskStatus operator()(Driver *d, int s) {return func_(d,s);}
+  TaskStatus operator()(Driver *d, int s) {return func_(obj_.get(),d,s);}
+  TaskFunc GetFunc() {return func_;}
+  void *GetObj() {return obj_.get();}
   TaskID GetID() {return myid_;}
   TaskID GetDependency() {return dep_;}
   void SetComplete() {complete_ = true;}
   void SetIncomplete() {complete_ = false;}
   bool IsComplete() {return complete_;}
+  void SetLBTime() {lb_time_ = true;}
+  bool IsLBTimed() {return lb_time_;}
+  void SetHostTask() {host_task_ = true;}
+  bool IsHostTask() {return host_task_;}
   // If this Task depends on id, change that dependency to 'newdep'
   void ChangeDependency(TaskID id, TaskID newdep) {
     if ((dep_ & id) == id) {dep_ = ((dep_ ^ id) | newdep);}
@@ -103,9 +152,16 @@ class Task {
  private:
   TaskID myid_;    // encodes task ID in bitfld_
   TaskID dep_;     // encodes dependencies to other tasks in bitfld_
-  // bool lb_time_;   // flag to include this task in timing for automatic load balancing
+  bool lb_time_ = false;  // flag to include this task in timing for automatic load bal
+  bool host_task_ = false;  // flag to run this task on a thread of the HostTaskPool
   bool complete_ = false;
-  std::function<TaskStatus(Driver*, int)> func_;  // ptr to Task function
+  TaskFunc func_;              // ptr to trampoline that calls Task function
+  std::shared_ptr<void> obj_;  // callable that is passed to trampoline
+
+  template <class C>
+  static TaskStatus Invoke(void *obj, Driver *d, int s) {
+    return (*static_cast<C*>(obj))(d,s);
+  }
 };
 
 //----------------------------------------------------------------------------------------
@@ -119,41 +175,149 @@ class TaskList {
 
   // functions (all implemented here)
   bool IsComplete() {
-    // cycle through task list and check if each task completed
+    // after Reset() the number of completed Tasks is tracked by DoAvailable()
+    if (graph_built_) {return (ncomplete_ == static_cast<int>(tasks_.size()));}
+    // otherwise cycle through task list and check if each task completed
     for (auto &it : task_list_) {
-      auto id = it.GetID();
-      if (!(tasks_completed_.CheckDependencies(id))) return false;
+      if (!(it.IsComplete())) return false;
     }
     // everything is done
     return true;
   }
   int Size() {return task_list_.size();}
   bool Empty() {return task_list_.empty();}
-  void MarkTaskComplete(TaskID id) { tasks_completed_.SetComplete(id); }
   TaskID GetIDLastTask() {return task_list_.back().GetID();}
   // output diagnostics (useful for debugging)
   void PrintIDs() { for (auto &it : task_list_) {it.GetID().PrintID();} }
   void PrintDependencies() { for (auto &it : task_list_) {it.GetDependency().PrintID();} }
 
-  //
+  // flag Task with input TaskID to be included in timing for automatic load balancing
+  void SetLBTimed(TaskID id) {
+    for (auto &it : task_list_) { if (it.GetID() == id) {it.SetLBTime();} }
+    graph_built_ = false;
+  }
+  // accumulated wall-clock time spent in timed Tasks since last call to ResetLBTime()
+  double GetLBTime() const {return lb_time_;}
+  void ResetLBTime() {lb_time_ = 0.0;}
+  bool lb_timing = false;  // true to time flagged tasks (set by Mesh for automatic LB)
+
+  // flag Task with input TaskID to be run on a thread of host_pool (if set), overlapping
+  // with the other Tasks in the list.  See utils/host_task_pool.hpp for the restrictions
+  // on such Tasks.  Host tasks are not profiled or timed for load balancing.
+  void SetHostTask(TaskID id) {
+    for (auto &it : task_list_) { if (it.GetID() == id) {it.SetHostTask();} }
+    graph_built_ = false;
+  }
+  HostTaskPool *host_pool = nullptr;  // pool running host tasks, or null to run inline
+
+  // accumulated wall-clock time n-th Task (in order added) spent stuck, i.e. between its
+  // first attempt returning TaskStatus::incomplete and its completion
+  double GetStuckTime(int n) const {
+    return (n < static_cast<int>(stuck_time_.size()))? stuck_time_[n] : 0.0;
+  }
+  bool task_timing = false;  // true to measure time each Task spends stuck
+
+  // accumulated wall-clock time n-th Task (in order added) spent executing, and number
+  // of calls to it, when task_profiling is enabled.  Each call of each Task is also
+  // wrapped in a Kokkos::Profiling region named "<name>/task<n>"
+  double GetRunTime(int n) const {
+    return (n < static_cast<int>(run_time_.size()))? run_time_[n] : 0.0;
+  }
+  int GetNCalls(int n) const {
+    return (n < static_cast<int>(ncalls_.size()))? ncalls_[n] : 0;
+  }
+  bool task_profiling = false;  // true to time each call of each Task
+  std::string name;             // name of TaskList used in profiling regions
+
+  // reset all Tasks to incomplete, and initialize queue of ready Tasks
   void Reset() {
-    tasks_completed_.Clear();  // TaskID Clear() fn
     for (auto &it : task_list_) { it.SetIncomplete(); }
+    if (!(graph_built_)) {BuildGraph();}
+    ndep_left_ = ndep_;
+    ready_.clear();
+    for (int n=0; n<static_cast<int>(ndep_.size()); ++n) {
+      if (ndep_[n] == 0) {ready_.push_back(n);}
+    }
+    ncomplete_ = 0;
+    stuck_since_.assign(tasks_.size(), -1.0);
+    for (std::size_t n=0; n<tasks_.size(); ++n) {host_state_[n].store(host_idle);}
   }
 
-  // cycle through task list once, do any tasks whose dependencies are clear
+  // cycle once through queue of ready Tasks (all dependencies complete), and execute
+  // each.  Tasks that become ready are appended to the queue and run in the same pass,
+  // so completed Tasks and Tasks with unmet dependencies are never re-scanned.  Returns
+  // TaskListStatus::stuck if no Task could be completed in this pass.  Only the flat
+  // arrays built by BuildGraph() are used here; no TaskID bit fields are touched.
+  // Host tasks are submitted to host_pool when first ready, and stay in the queue until
+  // the thread running them has finished, when they are completed (or resubmitted if
+  // they returned TaskStatus::incomplete).
   TaskListStatus DoAvailable(Driver *d, int s) {
-    for (auto &task : task_list_) {
-      auto dep = task.GetDependency();
-      if ( tasks_completed_.CheckDependencies(dep) && !(task.IsComplete()) ) {
-        TaskStatus status = task(d,s);  // calls Task function using overloaded operator()
-        if (status == TaskStatus::complete) {
-          task.SetComplete();              // set bool flag in task
-          MarkTaskComplete(task.GetID());  // add TaskID to tasks_completed_
+    bool progress = false;
+    std::size_t nkeep = 0;
+    for (std::size_t q=0; q<ready_.size(); ++q) {
+      int n = ready_[q];
+      TaskStatus status;
+      if (host_pool != nullptr && host_task_[n]) {
+        int state = host_state_[n].load(std::memory_order_acquire);
+        if (state == host_done) {
+          status = host_status_[n];
+          host_state_[n].store(host_idle, std::memory_order_relaxed);
+        } else {
+          if (state == host_idle) {
+            host_state_[n].store(host_running, std::memory_order_relaxed);
+            Task::TaskFunc f = func_[n];
+            void *obj = obj_[n];
+            TaskStatus *pstatus = &host_status_[n];
+            std::atomic<int> *pstate = &host_state_[n];
+            host_pool->Submit([=]() {
+              *pstatus = f(obj,d,s);  // calls Task function through trampoline
+              pstate->store(host_done, std::memory_order_release);
+            });
+            progress = true;
+          }
+          status = TaskStatus::incomplete;
+        }
+      } else if (task_profiling) {
+        // fence before and after so only device work of this Task is measured
+        Kokkos::fence();
+        Kokkos::Profiling::pushRegion(region_[n]);
+        Kokkos::Timer timer;
+        status = func_[n](obj_[n],d,s);  // calls Task function through trampoline
+        Kokkos::fence();
+        double t = timer.seconds();
+        Kokkos::Profiling::popRegion();
+        run_time_[n] += t;
+        ncalls_[n]++;
+        if (lb_timing && lb_timed_[n]) {lb_time_ += t;}
+      } else if (lb_timing && lb_timed_[n]) {
+        // fence before and after so only device work of this Task is measured
+        Kokkos::fence();
+        Kokkos::Timer timer;
+        status = func_[n](obj_[n],d,s);  // calls Task function through trampoline
+        Kokkos::fence();
+        lb_time_ += timer.seconds();
+      } else {
+        status = func_[n](obj_[n],d,s);  // calls Task function through trampoline
+      }
+      if (status == TaskStatus::complete) {
+        tasks_[n]->SetComplete();  // set bool flag in task
+        ncomplete_++;
+        progress = true;
+        if (task_timing && stuck_since_[n] >= 0.0) {
+          stuck_time_[n] += clock_.seconds() - stuck_since_[n];
+        }
+        // release successors, which are run later in this same pass once ready
+        for (int i=succ_start_[n]; i<succ_start_[n+1]; ++i) {
+          if (--ndep_left_[succ_[i]] == 0) {ready_.push_back(succ_[i]);}
         }
+      } else {
+        if (task_timing && stuck_since_[n] < 0.0) {stuck_since_[n] = clock_.seconds();}
+        ready_[nkeep++] = n;  // keep incomplete Task in queue (nkeep <= q always)
       }
     }
-    if (IsComplete()) return TaskListStatus::complete;
+    ready_.resize(nkeep);
+    if (ncomplete_ == static_cast<int>(tasks_.size())) return TaskListStatus::complete;
+    if (!(progress)) return TaskListStatus::stuck;
     return TaskListStatus::running;
   }
 
@@ -167,6 +331,7 @@ class TaskList {
     TaskID id(size+1);
     task_list_.push_back(
       Task(id, dep, [=](Driver *d, int s) mutable -> TaskStatus {return func(d,s);}));
+    graph_built_ = false;
     return id;
   }
 
@@ -180,6 +345,7 @@ class TaskList {
     TaskID id(size+1);
     task_list_.push_back( Task(id, dep,
        [=](Driver *d, int s) mutable -> TaskStatus {return (obj->*func)(d,s);}) );
+    graph_built_ = false;
     return id;
   }
 
@@ -191,6 +357,7 @@ class TaskList {
     auto size = task_list_.size();
     TaskID id(size+1);
     task_list_.push_back(Task(id, dep, func));
+    graph_built_ = false;
     return id;
   }
 
@@ -214,6 +381,7 @@ class TaskList {
             it2->ChangeDependency(old_dep, id);
           }
         }
+        graph_built_ = false;
         return id;
       }
     }
@@ -222,7 +390,96 @@ class TaskList {
 
  protected:
   std::list<Task> task_list_;
-  TaskID tasks_completed_;
+  double lb_time_ = 0.0;
+
+  // dependency graph, built from TaskIDs whenever the list has changed.  Tasks are
+  // indexed by their position in task_list_.  Successors of Task n are stored in
+  // succ_[succ_start_[n]] ... succ_[succ_start_[n+1]-1].
+  bool graph_built_ = false;
+  std::vector<Task*> tasks_;            // ptr to each Task (std::list ptrs are stable)
+  std::vector<Task::TaskFunc> func_;    // trampoline of each Task
+  std::vector<void*> obj_;              // callable of each Task
+  std::vector<char> lb_timed_;          // flag for Tasks timed for load balancing
+  std::vector<int> ndep_;               // number of dependencies of each Task
+  std::vector<int> succ_start_;         // start of successors of each Task in succ_
+  std::vector<int> succ_;               // Tasks that depend on each Task
+  std::vector<int> ndep_left_;          // number of incomplete dependencies
+  std::vector<int> ready_;              // queue of Tasks whose dependencies are complete
+  int ncomplete_ = 0;                   // number of completed Tasks
+  Kokkos::Timer clock_;                 // clock used to measure time Tasks are stuck
+  std::vector<double> stuck_since_;     // time of first incomplete attempt, or -1
+  std::vector<double> stuck_time_;      // accumulated time each Task was stuck
+  std::vector<double> run_time_;        // accumulated time each Task was executing
+  std::vector<int> ncalls_;             // number of calls to each Task
+  std::vector<std::string> region_;     // name of profiling region of each Task
+  // host tasks and their state: idle, running on host_pool, or done with host_status_
+  enum {host_idle, host_running, host_done};
+  std::vector<char> host_task_;         // flag for Tasks run on host_pool
+  std::unique_ptr<std::atomic<int>[]> host_state_;
+  std::vector<TaskStatus> host_status_;
+
+  void BuildGraph() {
+    tasks_.clear();
+    func_.clear();
+    obj_.clear();
+    lb_timed_.clear();
+    host_task_.clear();
+    for (auto &it : task_list_) {
+      tasks_.push_back(&it);
+      func_.push_back(it.GetFunc());
+      obj_.push_back(it.GetObj());
+      lb_timed_.push_back(it.IsLBTimed());
+      host_task_.push_back(it.IsHostTask());
+    }
+    int ntask = static_cast<int>(tasks_.size());
+    host_state_.reset(new std::atomic<int>[ntask]);
+    for (int n=0; n<ntask; ++n) {host_state_[n].store(host_idle);}
+    host_status_.assign(ntask, TaskStatus::incomplete);
+    // map from bit set in each TaskID to position of Task in list (InsertTask() means
+    // position and ID can differ)
+    std::vector<int> task_of_bit;
+    for (int j=0; j<ntask; ++j) {
+      for (int b : tasks_[j]->GetID().GetBits()) {
+        if (b >= static_cast<int>(task_of_bit.size())) {task_of_bit.resize(b+1, -1);}
+        task_of_bit[b] = j;
+      }
+    }
+    // count dependencies of each Task, and successors of each Task
+    std::vector<std::vector<int>> deps(ntask);
+    std::vector<int> nsucc(ntask, 0);
+    ndep_.assign(ntask, 0);
+    for (int n=0; n<ntask; ++n) {
+      for (int b : tasks_[n]->GetDependency().GetBits()) {
+        int j = (b < static_cast<int>(task_of_bit.size()))? task_of_bit[b] : -1;
+        if (j < 0) {
+          // dependency on a Task not in this list can never be satisfied
+          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                    << std::endl << "Task " << n << " depends on a Task not in TaskList"
+                    << std::endl;
+          std::exit(EXIT_FAILURE);
+        }
+        if (j != n) {
+          deps[n].push_back(j);
+          ndep_[n]++;
+          nsucc[j]++;
+        }
+      }
+    }
+    // store successors contiguously
+    succ_start_.assign(ntask+1, 0);
+    for (int j=0; j<ntask; ++j) {succ_start_[j+1] = succ_start_[j] + nsucc[j];}
+    succ_.assign(succ_start_[ntask], 0);
+    std::vector<int> next(succ_start_.begin(), succ_start_.end()-1);
+    for (int n=0; n<ntask; ++n) {
+      for (int j : deps[n]) {succ_[next[j]++] = n;}
+    }
+    stuck_time_.resize(ntask, 0.0);
+    run_time_.resize(ntask, 0.0);
+    ncalls_.resize(ntask, 0);
+    region_.clear();
+    for (int n=0; n<ntask; ++n) {region_.push_back(name + "/task" + std::to_string(n));}
+    graph_built_ = true;
+  }
 };
 
 #endif  // TASKLIST_TASK_LIST_HPP_
@@ -0,0 +1,363 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file block_multigrid.cpp
+//! \brief functions of BlockMultigrid class
+
+#include <algorithm>
+#include <vector>
+
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+#include "block_multigrid.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn bool DirichletFace()
+//! \brief true if a face of a MB is shared with another MB (or periodic), in which case
+//! the V-cycle uses a homogeneous Dirichlet boundary there, rather than zero flux
+
+KOKKOS_INLINE_FUNCTION
+bool DirichletFace(const BoundaryFlag bc) {
+  return (bc == BoundaryFlag::block || bc == BoundaryFlag::periodic);
+}
+
+//----------------------------------------------------------------------------------------
+// constructor, allocates arrays on all levels
+
+BlockMultigrid::BlockMultigrid(MeshBlockPack *pp, const int nsmooth, const int ncoarse) :
+  pmy_pack(pp),
+  nsmooth_(nsmooth),
+  ncoarse_(ncoarse),
+  dcoef_(1.0) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  int ndim = 1 + ((multi_d)? 1 : 0) + ((three_d)? 1 : 0);
+  omega_ = 2.0*ndim/(2.0*ndim + 1.0);
+
+  // coarsen while number of cells in every active direction is even
+  int n1 = indcs.nx1, n2 = indcs.nx2, n3 = indcs.nx3;
+  nlevels = 0;
+  while (true) {
+    n1_.push_back(n1);
+    n2_.push_back(n2);
+    n3_.push_back(n3);
+    nlevels++;
+    if ((n1 % 2 != 0) || (multi_d && n2 % 2 != 0) || (three_d && n3 % 2 != 0)) break;
+    n1 /= 2;
+    if (multi_d) {n2 /= 2;}
+    if (three_d) {n3 /= 2;}
+  }
+
+  int nmb = std::max((pmy_pack->nmb_thispack), (pmy_pack->pmesh->nmb_maxperrank));
+  for (int l=0; l<nlevels; ++l) {
+    int nc1 = n1_[l] + 2;
+    int nc2 = (multi_d)? (n2_[l] + 2) : 1;
+    int nc3 = (three_d)? (n3_[l] + 2) : 1;
+    u_.emplace_back("mg_u", nmb, nc3, nc2, nc1);
+    f_.emplace_back("mg_f", nmb, nc3, nc2, nc1);
+    r_.emplace_back("mg_r", nmb, nc3, nc2, nc1);
+    a_.emplace_back("mg_a", nmb, nc3, nc2, nc1);
+    d_.emplace_back("mg_d", nmb, nc3, nc2, nc1);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BlockMultigrid::SetOperator()
+//! \brief Sets operator A u = -D Lap(u) (a = 0) on all levels
+
+void BlockMultigrid::SetOperator(const Real d) {
+  dcoef_ = d;
+  for (int l=0; l<nlevels; ++l) {
+    Kokkos::deep_copy(DevExeSpace(), a_[l], 0.0);
+  }
+  SetDiagonal();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BlockMultigrid::SetOperator()
+//! \brief Sets operator A u = a u - D Lap(u) on all levels, given a in the active cells
+//! of MBs (array with the usual ghost zones), and averages of a on coarser levels
+
+void BlockMultigrid::SetOperator(const DvceArray4D<Real> &a, const Real d) {
+  dcoef_ = d;
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, js = indcs.js, ks = indcs.ks;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  int g2 = (pmy_pack->pmesh->multi_d)? 1 : 0;
+  int g3 = (pmy_pack->pmesh->three_d)? 1 : 0;
+  auto a0 = a_[0];
+  par_for("mg_seta", DevExeSpace(), 0, nmb1, g3, n3_[0]+g3-1, g2, n2_[0]+g2-1,
+          1, n1_[0],
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    a0(m,k,j,i) = a(m,k-g3+ks,j-g2+js,i-1+is);
+  });
+  for (int l=0; l<nlevels-1; ++l) {
+    Restrict(a_[l], a_[l+1], l);
+  }
+  SetDiagonal();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BlockMultigrid::SetDiagonal()
+//! \brief Stores diagonal of A on each level, used by the Jacobi smoother.  Neighbors
+//! across Dirichlet faces add to the diagonal, neighbors across zero-flux faces do not.
+
+void BlockMultigrid::SetDiagonal() {
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  bool multi_d = pmy_pack->pmesh->multi_d;
+  bool three_d = pmy_pack->pmesh->three_d;
+  int g2 = (multi_d)? 1 : 0;
+  int g3 = (three_d)? 1 : 0;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+  auto &mb_bcs = pmy_pack->pmb->mb_bcs;
+  for (int l=0; l<nlevels; ++l) {
+    int n1 = n1_[l], n2 = n2_[l], n3 = n3_[l];
+    // coefficient 2^l D on cells of size 2^l dx gives D/(2^l dx^2)
+    Real dl = dcoef_/static_cast<Real>(1 << l);
+    auto al = a_[l];
+    auto dg = d_[l];
+    par_for("mg_diag", DevExeSpace(), 0, nmb1, g3, n3+g3-1, g2, n2+g2-1, 1, n1,
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      Real c1 = dl/SQR(mbsize.d_view(m).dx1);
+      Real diag = 2.0;
+      if (i == 1) {
+        diag += DirichletFace(mb_bcs.d_view(m,BoundaryFace::inner_x1))? 1.0 : -1.0;
+      }
+      if (i == n1) {
+        diag += DirichletFace(mb_bcs.d_view(m,BoundaryFace::outer_x1))? 1.0 : -1.0;
+      }
+      Real dsum = c1*diag;
+      if (multi_d) {
+        Real c2 = dl/SQR(mbsize.d_view(m).dx2);
+        diag = 2.0;
+        if (j == 1) {
+          diag += DirichletFace(mb_bcs.d_view(m,BoundaryFace::inner_x2))? 1.0 : -1.0;
+        }
+        if (j == n2) {
+          diag += DirichletFace(mb_bcs.d_view(m,BoundaryFace::outer_x2))? 1.0 : -1.0;
+        }
+        dsum += c2*diag;
+      }
+      if (three_d) {
+        Real c3 = dl/SQR(mbsize.d_view(m).dx3);
+        diag = 2.0;
+        if (k == 1) {
+          diag += DirichletFace(mb_bcs.d_view(m,BoundaryFace::inner_x3))? 1.0 : -1.0;
+        }
+        if (k == n3) {
+          diag += DirichletFace(mb_bcs.d_view(m,BoundaryFace::outer_x3))? 1.0 : -1.0;
+        }
+        dsum += c3*diag;
+      }
+      dg(m,k,j,i) = al(m,k,j,i) + dsum;
+    });
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BlockMultigrid::Precondition()
+//! \brief Computes z = M r, with M one V-cycle started from zero.  Only the active cells
+//! of r (array with the usual ghost zones) are read, and only those of z are set.
+
+void BlockMultigrid::Precondition(const DvceArray4D<Real> &r, DvceArray4D<Real> &z) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, js = indcs.js, ks = indcs.ks;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  int g2 = (pmy_pack->pmesh->multi_d)? 1 : 0;
+  int g3 = (pmy_pack->pmesh->three_d)? 1 : 0;
+  auto f0 = f_[0];
+  par_for("mg_rhs", DevExeSpace(), 0, nmb1, g3, n3_[0]+g3-1, g2, n2_[0]+g2-1, 1, n1_[0],
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    f0(m,k,j,i) = r(m,k-g3+ks,j-g2+js,i-1+is);
+  });
+
+  VCycle(0);
+
+  auto u0 = u_[0];
+  par_for("mg_sol", DevExeSpace(), 0, nmb1, g3, n3_[0]+g3-1, g2, n2_[0]+g2-1, 1, n1_[0],
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    z(m,k-g3+ks,j-g2+js,i-1+is) = u0(m,k,j,i);
+  });
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BlockMultigrid::VCycle()
+//! \brief V-cycle from level l (started from u=0) to the coarsest level and back
+
+void BlockMultigrid::VCycle(const int l) {
+  Kokkos::deep_copy(DevExeSpace(), u_[l], 0.0);
+  if (l == nlevels-1) {
+    Smooth(l, ncoarse_);
+    return;
+  }
+  Smooth(l, nsmooth_);
+  SetGhosts(l);
+  Residual(l);
+  Restrict(r_[l], f_[l+1], l);
+  VCycle(l+1);
+  Prolongate(l);
+  Smooth(l, nsmooth_);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BlockMultigrid::SetGhosts()
+//! \brief Sets ghost cells of u on level l across each face of the MB, to -u at faces
+//! shared with other MBs (or periodic), and to u at physical boundaries.  Edge and corner
+//! ghost cells are not used by the stencil.
+
+void BlockMultigrid::SetGhosts(const int l) {
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  bool multi_d = pmy_pack->pmesh->multi_d;
+  bool three_d = pmy_pack->pmesh->three_d;
+  int g2 = (multi_d)? 1 : 0;
+  int g3 = (three_d)? 1 : 0;
+  int n1 = n1_[l], n2 = n2_[l], n3 = n3_[l];
+  auto &mb_bcs = pmy_pack->pmb->mb_bcs;
+  auto u = u_[l];
+
+  par_for("mg_gx1", DevExeSpace(), 0, nmb1, g3, n3+g3-1, g2, n2+g2-1,
+  KOKKOS_LAMBDA(const int m, const int k, const int j) {
+    Real si = DirichletFace(mb_bcs.d_view(m,BoundaryFace::inner_x1))? -1.0 : 1.0;
+    Real so = DirichletFace(mb_bcs.d_view(m,BoundaryFace::outer_x1))? -1.0 : 1.0;
+    u(m,k,j,0) = si*u(m,k,j,1);
+    u(m,k,j,n1+1) = so*u(m,k,j,n1);
+  });
+  if (multi_d) {
+    par_for("mg_gx2", DevExeSpace(), 0, nmb1, g3, n3+g3-1, 1, n1,
+    KOKKOS_LAMBDA(const int m, const int k, const int i) {
+      Real si = DirichletFace(mb_bcs.d_view(m,BoundaryFace::inner_x2))? -1.0 : 1.0;
+      Real so = DirichletFace(mb_bcs.d_view(m,BoundaryFace::outer_x2))? -1.0 : 1.0;
+      u(m,k,0,i) = si*u(m,k,1,i);
+      u(m,k,n2+1,i) = so*u(m,k,n2,i);
+    });
+  }
+  if (three_d) {
+    par_for("mg_gx3", DevExeSpace(), 0, nmb1, 1, n2, 1, n1,
+    KOKKOS_LAMBDA(const int m, const int j, const int i) {
+      Real si = DirichletFace(mb_bcs.d_view(m,BoundaryFace::inner_x3))? -1.0 : 1.0;
+      Real so = DirichletFace(mb_bcs.d_view(m,BoundaryFace::outer_x3))? -1.0 : 1.0;
+      u(m,0,j,i) = si*u(m,1,j,i);
+      u(m,n3+1,j,i) = so*u(m,n3,j,i);
+    });
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BlockMultigrid::Residual()
+//! \brief Computes r = f - A u on level l.  Ghost cells of u must be set.
+
+void BlockMultigrid::Residual(const int l) {
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  bool multi_d = pmy_pack->pmesh->multi_d;
+  bool three_d = pmy_pack->pmesh->three_d;
+  int g2 = (multi_d)? 1 : 0;
+  int g3 = (three_d)? 1 : 0;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+  Real dl = dcoef_/static_cast<Real>(1 << l);
+  auto u = u_[l];
+  auto f = f_[l];
+  auto r = r_[l];
+  auto a = a_[l];
+
+  par_for("mg_res", DevExeSpace(), 0, nmb1, g3, n3_[l]+g3-1, g2, n2_[l]+g2-1, 1, n1_[l],
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    Real uc = u(m,k,j,i);
+    Real au = a(m,k,j,i)*uc + dl*(2.0*uc - u(m,k,j,i-1) - u(m,k,j,i+1))
+                              /SQR(mbsize.d_view(m).dx1);
+    if (multi_d) {
+      au += dl*(2.0*uc - u(m,k,j-1,i) - u(m,k,j+1,i))/SQR(mbsize.d_view(m).dx2);
+    }
+    if (three_d) {
+      au += dl*(2.0*uc - u(m,k-1,j,i) - u(m,k+1,j,i))/SQR(mbsize.d_view(m).dx3);
+    }
+    r(m,k,j,i) = f(m,k,j,i) - au;
+  });
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BlockMultigrid::Smooth()
+//! \brief nsweep damped Jacobi sweeps u += omega (f - A u)/diag(A) on level l
+
+void BlockMultigrid::Smooth(const int l, const int nsweep) {
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  int g2 = (pmy_pack->pmesh->multi_d)? 1 : 0;
+  int g3 = (pmy_pack->pmesh->three_d)? 1 : 0;
+  Real omega = omega_;
+  auto u = u_[l];
+  auto r = r_[l];
+  auto dg = d_[l];
+  for (int n=0; n<nsweep; ++n) {
+    SetGhosts(l);
+    Residual(l);
+    par_for("mg_jacobi", DevExeSpace(), 0, nmb1, g3, n3_[l]+g3-1, g2, n2_[l]+g2-1,
+            1, n1_[l],
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      u(m,k,j,i) += omega*r(m,k,j,i)/dg(m,k,j,i);
+    });
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BlockMultigrid::Restrict()
+//! \brief Averages array on level l over the 2^d fine cells in each cell of level l+1
+
+void BlockMultigrid::Restrict(const DvceArray4D<Real> &fine, DvceArray4D<Real> &coarse,
+                              const int l) {
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  bool multi_d = pmy_pack->pmesh->multi_d;
+  bool three_d = pmy_pack->pmesh->three_d;
+  int g2 = (multi_d)? 1 : 0;
+  int g3 = (three_d)? 1 : 0;
+  Real wght = 1.0/static_cast<Real>(1 << (1 + g2 + g3));
+
+  par_for("mg_restrict", DevExeSpace(), 0, nmb1, g3, n3_[l+1]+g3-1, g2, n2_[l+1]+g2-1,
+          1, n1_[l+1],
+  KOKKOS_LAMBDA(const int m, const int kc, const int jc, const int ic) {
+    int i = 2*ic - 1;
+    int j = (multi_d)? (2*jc - 1) : jc;
+    int k = (three_d)? (2*kc - 1) : kc;
+    Real sum = 0.0;
+    for (int dk=0; dk<=g3; ++dk) {
+      for (int dj=0; dj<=g2; ++dj) {
+        sum += fine(m,k+dk,j+dj,i) + fine(m,k+dk,j+dj,i+1);
+      }
+    }
+    coarse(m,kc,jc,ic) = wght*sum;
+  });
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BlockMultigrid::Prolongate()
+//! \brief Adds (piecewise constant) correction on level l+1 to u on level l
+
+void BlockMultigrid::Prolongate(const int l) {
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  bool multi_d = pmy_pack->pmesh->multi_d;
+  bool three_d = pmy_pack->pmesh->three_d;
+  int g2 = (multi_d)? 1 : 0;
+  int g3 = (three_d)? 1 : 0;
+  auto u = u_[l];
+  auto uc = u_[l+1];
+
+  par_for("mg_prolong", DevExeSpace(), 0, nmb1, g3, n3_[l]+g3-1, g2, n2_[l]+g2-1,
+          1, n1_[l],
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    int ic = (i + 1)/2;
+    int jc = (multi_d)? ((j + 1)/2) : j;
+    int kc = (three_d)? ((k + 1)/2) : k;
+    u(m,k,j,i) += uc(m,kc,jc,ic);
+  });
+  return;
+}
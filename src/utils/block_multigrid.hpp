@@ -0,0 +1,66 @@
+#ifndef UTILS_BLOCK_MULTIGRID_HPP_
+#define UTILS_BLOCK_MULTIGRID_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file block_multigrid.hpp
+//! \brief defines BlockMultigrid class, a geometric multigrid V-cycle used as the
+//! preconditioner of the matrix-free CG solvers (implicit conduction and self-gravity)
+//! for the operator
+//!   A u = a u - D Lap(u)
+//! with the second-order Laplacian, a >= 0 set in each cell and D > 0 a constant.
+//!
+//! The V-cycle is local to each MeshBlock: cells are coarsened by factors of two within
+//! the MB (while the number of cells in every active direction is even), and faces of
+//! the MB shared with other MBs (or periodic) are treated as homogeneous Dirichlet
+//! boundaries (ghost = -u), faces at physical boundaries as zero-flux boundaries (ghost
+//! = u).  Coupling between MBs is therefore only provided by the outer CG iteration,
+//! which the preconditioner accelerates by removing the error at all scales within each
+//! MB.  Restriction averages the 2^d fine cells in each coarse cell, prolongation is
+//! piecewise constant, and the coarse operator (the Galerkin operator for these
+//! transfers) has a averaged to the coarse cells and D doubled on each coarser level.
+//! The smoother is damped Jacobi with the same number of sweeps before and after the
+//! coarse correction, and a fixed number of sweeps is used on the coarsest level, so
+//! the V-cycle is a fixed, symmetric linear operator as required by CG.
+
+#include <vector>
+
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \class BlockMultigrid
+
+class BlockMultigrid {
+ public:
+  BlockMultigrid(MeshBlockPack *pp, const int nsmooth, const int ncoarse);
+
+  int nlevels;         // number of levels, including finest (MB) level
+
+  // functions
+  void SetOperator(const Real d);
+  void SetOperator(const DvceArray4D<Real> &a, const Real d);
+  void Precondition(const DvceArray4D<Real> &r, DvceArray4D<Real> &z);
+
+ private:
+  MeshBlockPack *pmy_pack;  // ptr to MeshBlockPack containing the solver
+  int nsmooth_;             // number of Jacobi sweeps before and after coarse correction
+  int ncoarse_;             // number of Jacobi sweeps on coarsest level
+  Real omega_;              // weight of damped Jacobi smoother
+  Real dcoef_;              // coefficient D of Laplacian on finest level
+  // arrays on each level respectively storing the solution and right-hand side (with
+  // one ghost cell in active directions), residual, coefficient a and diagonal of A
+  std::vector<DvceArray4D<Real>> u_, f_, r_, a_, d_;
+  std::vector<int> n1_, n2_, n3_;  // number of cells in MB on each level
+  void SetDiagonal();
+  void SetGhosts(const int l);
+  void Residual(const int l);
+  void Smooth(const int l, const int nsweep);
+  void Restrict(const DvceArray4D<Real> &fine, DvceArray4D<Real> &coarse, const int l);
+  void Prolongate(const int l);
+  void VCycle(const int l);
+};
+
+#endif // UTILS_BLOCK_MULTIGRID_HPP_
@@ -0,0 +1,193 @@
+#ifndef UTILS_FD_STENCILS_HPP_
+#define UTILS_FD_STENCILS_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file fd_stencils.hpp
+//! \brief compile-time coefficients and stencil sums of centered finite-difference
+//! operators for any number of ghost zones NGHOST (up to 8), used by the operators in
+//! finite_diff.hpp.  The first and second derivatives are accurate to order
+//! 2*(NGHOST-1), and the dissipation operator is the 2*NGHOST difference.
+//!
+//! Coefficients are exact rationals reduced at compile time, so they round to the same
+//! double as the literals (e.g. 1./12.) written by hand, and the stencil sums add the
+//! terms in the same order (outermost pair of points first), so all operators give
+//! bitwise identical results to the earlier generated code.  Coefficients are doubles
+//! (as were the literals), and the sums are only converted to Real by the caller.
+//!
+//! Each sum takes an accessor q(s) returning the value at offset s along the direction
+//! of the derivative (or q(sx,sy) for mixed derivatives), so the same stencils apply to
+//! Views, AthenaTensors, or tiles of a View in scratch memory.  The fused versions take
+//! q(s,n) for NV fields and loop over fields innermost, so that the address of each
+//! point of the stencil is computed once for all fields (e.g. all 6 components of g_dd).
+
+#include <utility>
+
+#include "athena.hpp"
+
+namespace fd {
+
+//----------------------------------------------------------------------------------------
+// exact rational arithmetic evaluated at compile time
+
+struct Rational {
+  long long n, d;
+};
+
+constexpr long long Factorial(int n) {
+  long long f = 1;
+  for (int i=2; i<=n; ++i) {f *= i;}
+  return f;
+}
+
+constexpr long long Gcd(long long a, long long b) {
+  if (a < 0) {a = -a;}
+  while (b != 0) {
+    long long t = a % b;
+    a = b;
+    b = (t < 0)? -t : t;
+  }
+  return a;
+}
+
+constexpr Rational Reduce(long long n, long long d) {
+  long long g = Gcd(n, d);
+  return Rational{n/g, d/g};
+}
+
+constexpr Rational Add(Rational a, Rational b) {
+  long long g = Gcd(a.d, b.d);
+  return Reduce(a.n*(b.d/g) + b.n*(a.d/g), (a.d/g)*b.d);
+}
+
+constexpr double Value(Rational r) {return static_cast<double>(r.n)/r.d;}
+
+// coefficient of point +k (1<=k<=p) of centered first derivative of order 2p.  The
+// coefficient of point -k is minus this, and of the center is zero.
+constexpr Rational D1Coeff(int p, int k) {
+  Rational r = Reduce(Factorial(p)*Factorial(p), k*Factorial(p-k)*Factorial(p+k));
+  if (k % 2 == 0) {r.n = -r.n;}
+  return r;
+}
+
+// coefficient of points +k and -k (k>=1), and of the center (k=0), of centered second
+// derivative of order 2p
+constexpr Rational D2Coeff(int p, int k) {
+  if (k == 0) {
+    Rational sum{0, 1};
+    for (int l=1; l<=p; ++l) {sum = Add(sum, D2Coeff(p, l));}
+    return Rational{-2*sum.n, sum.d};
+  }
+  Rational r = Reduce(2*Factorial(p)*Factorial(p), k*k*Factorial(p-k)*Factorial(p+k));
+  if (k % 2 == 0) {r.n = -r.n;}
+  return r;
+}
+
+// coefficient of points +k and -k (0<=k<=n) of 2n-th difference used for dissipation,
+// (-1)^(n+k) (2n)!/((n-k)!(n+k)!)
+constexpr Rational DissCoeff(int n, int k) {
+  long long c = Factorial(2*n)/(Factorial(n-k)*Factorial(n+k));
+  return Rational{((n + k) % 2 == 0)? c : -c, 1};
+}
+
+template <int P, int K> constexpr double kD1 = Value(D1Coeff(P, K));
+template <int P, int K> constexpr double kD2 = Value(D2Coeff(P, K));
+template <int N, int K> constexpr double kDiss = Value(DissCoeff(N, K));
+
+//----------------------------------------------------------------------------------------
+// stencil sums over pairs of points, from outermost (offset P) to innermost (offset 1)
+
+template <int P, typename F, int... L>
+KOKKOS_FORCEINLINE_FUNCTION
+double D1Sum(const F &q, std::integer_sequence<int, L...>) {
+  return (0.0 + ... + (-kD1<P,P-L>*q(-(P-L)) + kD1<P,P-L>*q(P-L)));
+}
+
+template <int P, typename F, int... L>
+KOKKOS_FORCEINLINE_FUNCTION
+double D2Sum(const F &q, std::integer_sequence<int, L...>) {
+  return (0.0 + ... + (kD2<P,P-L>*q(-(P-L)) + kD2<P,P-L>*q(P-L))) + kD2<P,0>*q(0);
+}
+
+template <int N, typename F, int... L>
+KOKKOS_FORCEINLINE_FUNCTION
+double DissSum(const F &q, std::integer_sequence<int, L...>) {
+  return (0.0 + ... + (kDiss<N,N-L>*q(-(N-L)) + kDiss<N,N-L>*q(N-L))) + kDiss<N,0>*q(0);
+}
+
+// sum over points (+/-KX, +/-KY) of product of first derivative stencils
+template <int P, int KX, int KY, typename F>
+KOKKOS_FORCEINLINE_FUNCTION
+double D1D1Term(const F &q) {
+  return (-kD1<P,KX>*(-kD1<P,KY>)*q(-KX,-KY) + -kD1<P,KX>*kD1<P,KY>*q(-KX,KY))
+       + (kD1<P,KX>*(-kD1<P,KY>)*q(KX,-KY) + kD1<P,KX>*kD1<P,KY>*q(KX,KY));
+}
+
+// sum over all P*P pairs of offsets, with KX outer and KY inner (both from P to 1)
+template <int P, typename F, int... L>
+KOKKOS_FORCEINLINE_FUNCTION
+double D1D1Sum(const F &q, std::integer_sequence<int, L...>) {
+  return (0.0 + ... + D1D1Term<P,P-L/P,P-L%P>(q));
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn D1(), D2(), D11(), Diss()
+//! \brief Centered stencils for NGHOST ghost zones, without the factors of 1/dx.
+
+template <int NGHOST, typename F>
+KOKKOS_FORCEINLINE_FUNCTION
+double D1(const F &q) {
+  static_assert(NGHOST >= 2 && NGHOST <= 8, "NGHOST must be in [2,8]");
+  return D1Sum<NGHOST-1>(q, std::make_integer_sequence<int, NGHOST-1>{});
+}
+
+template <int NGHOST, typename F>
+KOKKOS_FORCEINLINE_FUNCTION
+double D2(const F &q) {
+  static_assert(NGHOST >= 2 && NGHOST <= 8, "NGHOST must be in [2,8]");
+  return D2Sum<NGHOST-1>(q, std::make_integer_sequence<int, NGHOST-1>{});
+}
+
+template <int NGHOST, typename F>
+KOKKOS_FORCEINLINE_FUNCTION
+double D11(const F &q) {
+  static_assert(NGHOST >= 2 && NGHOST <= 8, "NGHOST must be in [2,8]");
+  constexpr int p = NGHOST-1;
+  return D1D1Sum<p>(q, std::make_integer_sequence<int, p*p>{});
+}
+
+template <int NGHOST, typename F>
+KOKKOS_FORCEINLINE_FUNCTION
+double Diss(const F &q) {
+  static_assert(NGHOST >= 2 && NGHOST <= 8, "NGHOST must be in [2,8]");
+  return DissSum<NGHOST>(q, std::make_integer_sequence<int, NGHOST>{});
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn D1Fused()
+//! \brief First derivative of NV fields q(s,n) sharing one stencil, with the same order
+//! of additions for each field as D1().  Results (without 1/dx) are stored in out[].
+
+template <int P, int NV, typename F, int... L>
+KOKKOS_FORCEINLINE_FUNCTION
+void D1FusedSum(const F &q, Real out[NV], std::integer_sequence<int, L...>) {
+  double sum[NV];
+  for (int n=0; n<NV; ++n) {sum[n] = 0.0;}
+  auto pair = [&](const int kk, const double c) {
+    for (int n=0; n<NV; ++n) {sum[n] = sum[n] + (-c*q(-kk,n) + c*q(kk,n));}
+  };
+  (pair(P-L, kD1<P,P-L>), ...);
+  for (int n=0; n<NV; ++n) {out[n] = sum[n];}
+}
+
+template <int NGHOST, int NV, typename F>
+KOKKOS_FORCEINLINE_FUNCTION
+void D1Fused(const F &q, Real out[NV]) {
+  static_assert(NGHOST >= 2 && NGHOST <= 8, "NGHOST must be in [2,8]");
+  D1FusedSum<NGHOST-1, NV>(q, out, std::make_integer_sequence<int, NGHOST-1>{});
+}
+
+} // namespace fd
+#endif // UTILS_FD_STENCILS_HPP_
@@ -6,10 +6,12 @@
 // Licensed under the 3-clause BSD License (the "LICENSE")
 //========================================================================================
 //! \file finite_diff.hpp
-//  \brief high order finite-differencing operators.
+//  \brief high order finite-differencing operators.  Centered operators (Dx, Dxx, Dxy,
+//  Diss) are built from the compile-time stencils in fd_stencils.hpp for any NGHOST, and
+//  the lopsided advective operators (Lx) are generated code.
+
+#include "utils/fd_stencils.hpp"
 
-// Reminder: this code has been generated with py/write_FD.py,
-// please do modifications there.
 // 1st derivative scalar
 template <int NGHOST, typename TYPE>
 KOKKOS_INLINE_FUNCTION
@@ -20,53 +22,14 @@ Real Dx(int const dir,
   int const shiftk = dir==2;
   int const shiftj = dir==1;
   int const shifti = dir==0;
-  Real out;
-  if constexpr ( NGHOST == 2 ) {
-    out = + (  -1./2.   * quant(m,k+(-1)*shiftk,
-                                  j+(-1)*shiftj,
-                                  i+(-1)*shifti)
-               +1./2.   * quant(m,k+( 1)*shiftk,
-                                  j+( 1)*shiftj,
-                                  i+( 1)*shifti));
-  } else if constexpr ( NGHOST == 3 ) {
-    out = + ( +1./12.   * quant(m,k+(-2)*shiftk,
-                                  j+(-2)*shiftj,
-                                  i+(-2)*shifti)
-              -1./12.   * quant(m,k+( 2)*shiftk,
-                                  j+( 2)*shiftj,
-                                  i+( 2)*shifti))
-          + (  -2./3.   * quant(m,k+(-1)*shiftk,
-                                  j+(-1)*shiftj,
-                                  i+(-1)*shifti)
-               +2./3.   * quant(m,k+( 1)*shiftk,
-                                  j+( 1)*shiftj,
-                                  i+( 1)*shifti));
-  } else if constexpr ( NGHOST == 4 ) {
-    out = + ( -1./60.   * quant(m,k+(-3)*shiftk,
-                                  j+(-3)*shiftj,
-                                  i+(-3)*shifti)
-              +1./60.   * quant(m,k+( 3)*shiftk,
-                                  j+( 3)*shiftj,
-                                  i+( 3)*shifti))
-          + ( +3./20.   * quant(m,k+(-2)*shiftk,
-                                  j+(-2)*shiftj,
-                                  i+(-2)*shifti)
-              -3./20.   * quant(m,k+( 2)*shiftk,
-                                  j+( 2)*shiftj,
-                                  i+( 2)*shifti))
-          + (  -3./4.   * quant(m,k+(-1)*shiftk,
-                                  j+(-1)*shiftj,
-                                  i+(-1)*shifti)
-               +3./4.   * quant(m,k+( 1)*shiftk,
-                                  j+( 1)*shiftj,
-                                  i+( 1)*shifti));
-  }
+  Real out = fd::D1<NGHOST>([&](const int s) {
+    return quant(m,k+s*shiftk, j+s*shiftj, i+s*shifti);
+  });
   return out*idx[dir];
 }
 
 
-// Reminder: this code has been generated with py/write_FD.py,
-// please do modifications there.// 1st derivative vector
+// 1st derivative vector
 template <int NGHOST, typename TYPE>
 KOKKOS_INLINE_FUNCTION
 Real Dx(int const dir,
@@ -76,53 +39,14 @@ Real Dx(int const dir,
   int const shiftk = dir==2;
   int const shiftj = dir==1;
   int const shifti = dir==0;
-  Real out;
-  if constexpr ( NGHOST == 2 ) {
-    out = + (  -1./2.   * quant(m,a,k+(-1)*shiftk,
-                                    j+(-1)*shiftj,
-                                    i+(-1)*shifti)
-               +1./2.   * quant(m,a,k+( 1)*shiftk,
-                                    j+( 1)*shiftj,
-                                    i+( 1)*shifti));
-  } else if constexpr ( NGHOST == 3 ) {
-    out = + ( +1./12.   * quant(m,a,k+(-2)*shiftk,
-                                    j+(-2)*shiftj,
-                                    i+(-2)*shifti)
-              -1./12.   * quant(m,a,k+( 2)*shiftk,
-                                    j+( 2)*shiftj,
-                                    i+( 2)*shifti))
-          + (  -2./3.   * quant(m,a,k+(-1)*shiftk,
-                                    j+(-1)*shiftj,
-                                    i+(-1)*shifti)
-               +2./3.   * quant(m,a,k+( 1)*shiftk,
-                                    j+( 1)*shiftj,
-                                    i+( 1)*shifti));
-  } else if constexpr ( NGHOST == 4 ) {
-    out = + ( -1./60.   * quant(m,a,k+(-3)*shiftk,
-                                    j+(-3)*shiftj,
-                                    i+(-3)*shifti)
-              +1./60.   * quant(m,a,k+( 3)*shiftk,
-                                    j+( 3)*shiftj,
-                                    i+( 3)*shifti))
-          + ( +3./20.   * quant(m,a,k+(-2)*shiftk,
-                                    j+(-2)*shiftj,
-                                    i+(-2)*shifti)
-              -3./20.   * quant(m,a,k+( 2)*shiftk,
-                                    j+( 2)*shiftj,
-                                    i+( 2)*shifti))
-          + (  -3./4.   * quant(m,a,k+(-1)*shiftk,
-                                    j+(-1)*shiftj,
-                                    i+(-1)*shifti)
-               +3./4.   * quant(m,a,k+( 1)*shiftk,
-                                    j+( 1)*shiftj,
-                                    i+( 1)*shifti));
-  }
+  Real out = fd::D1<NGHOST>([&](const int s) {
+    return quant(m,a,k+s*shiftk, j+s*shiftj, i+s*shifti);
+  });
   return out*idx[dir];
 }
 
 
-// Reminder: this code has been generated with py/write_FD.py,
-// please do modifications there.// 1st derivative 2D tensor
+// 1st derivative 2D tensor
 template <int NGHOST, typename TYPE>
 KOKKOS_INLINE_FUNCTION
 Real Dx(int const dir,
@@ -132,53 +56,14 @@ Real Dx(int const dir,
   int const shiftk = dir==2;
   int const shiftj = dir==1;
   int const shifti = dir==0;
-  Real out;
-  if constexpr ( NGHOST == 2 ) {
-    out = + (  -1./2.   * quant(m,a,b,k+(-1)*shiftk,
-                                      j+(-1)*shiftj,
-                                      i+(-1)*shifti)
-               +1./2.   * quant(m,a,b,k+( 1)*shiftk,
-                                      j+( 1)*shiftj,
-                                      i+( 1)*shifti));
-  } else if constexpr ( NGHOST == 3 ) {
-    out = + ( +1./12.   * quant(m,a,b,k+(-2)*shiftk,
-                                      j+(-2)*shiftj,
-                                      i+(-2)*shifti)
-              -1./12.   * quant(m,a,b,k+( 2)*shiftk,
-                                      j+( 2)*shiftj,
-                                      i+( 2)*shifti))
-          + (  -2./3.   * quant(m,a,b,k+(-1)*shiftk,
-                                      j+(-1)*shiftj,
-                                      i+(-1)*shifti)
-               +2./3.   * quant(m,a,b,k+( 1)*shiftk,
-                                      j+( 1)*shiftj,
-                                      i+( 1)*shifti));
-  } else if constexpr ( NGHOST == 4 ) {
-    out = + ( -1./60.   * quant(m,a,b,k+(-3)*shiftk,
-                                      j+(-3)*shiftj,
-                                      i+(-3)*shifti)
-              +1./60.   * quant(m,a,b,k+( 3)*shiftk,
-                                      j+( 3)*shiftj,
-                                      i+( 3)*shifti))
-          + ( +3./20.   * quant(m,a,b,k+(-2)*shiftk,
-                                      j+(-2)*shiftj,
-                                      i+(-2)*shifti)
-              -3./20.   * quant(m,a,b,k+( 2)*shiftk,
-                                      j+( 2)*shiftj,
-                                      i+( 2)*shifti))
-          + (  -3./4.   * quant(m,a,b,k+(-1)*shiftk,
-                                      j+(-1)*shiftj,
-                                      i+(-1)*shifti)
-               +3./4.   * quant(m,a,b,k+( 1)*shiftk,
-                                      j+( 1)*shiftj,
-                                      i+( 1)*shifti));
-  }
+  Real out = fd::D1<NGHOST>([&](const int s) {
+    return quant(m,a,b,k+s*shiftk, j+s*shiftj, i+s*shifti);
+  });
   return out*idx[dir];
 }
 
 
-// Reminder: this code has been generated with py/write_FD.py,
-// please do modifications there.// 1st derivative scalar
+// 2nd derivative scalar
 template <int NGHOST, typename TYPE>
 KOKKOS_INLINE_FUNCTION
 Real Dxx(int const dir,
@@ -188,62 +73,14 @@ Real Dxx(int const dir,
   int const shiftk = dir==2;
   int const shiftj = dir==1;
   int const shifti = dir==0;
-  Real out;
-  if constexpr ( NGHOST == 2 ) {
-    out = + (   +1.     * quant(m,k+(-1)*shiftk,
-                                  j+(-1)*shiftj,
-                                  i+(-1)*shifti)
-                +1.     * quant(m,k+( 1)*shiftk,
-                                  j+( 1)*shiftj,
-                                  i+( 1)*shifti))
-                -2.     * quant(m,k,
-                                  j,
-                                  i);
-  } else if constexpr ( NGHOST == 3 ) {
-    out = + ( -1./12.   * quant(m,k+(-2)*shiftk,
-                                  j+(-2)*shiftj,
-                                  i+(-2)*shifti)
-              -1./12.   * quant(m,k+( 2)*shiftk,
-                                  j+( 2)*shiftj,
-                                  i+( 2)*shifti))
-          + (  +4./3.   * quant(m,k+(-1)*shiftk,
-                                  j+(-1)*shiftj,
-                                  i+(-1)*shifti)
-               +4./3.   * quant(m,k+( 1)*shiftk,
-                                  j+( 1)*shiftj,
-                                  i+( 1)*shifti))
-               -5./2.   * quant(m,k,
-                                  j,
-                                  i);
-  } else if constexpr ( NGHOST == 4 ) {
-    out = + ( +1./90.   * quant(m,k+(-3)*shiftk,
-                                  j+(-3)*shiftj,
-                                  i+(-3)*shifti)
-              +1./90.   * quant(m,k+( 3)*shiftk,
-                                  j+( 3)*shiftj,
-                                  i+( 3)*shifti))
-          + ( -3./20.   * quant(m,k+(-2)*shiftk,
-                                  j+(-2)*shiftj,
-                                  i+(-2)*shifti)
-              -3./20.   * quant(m,k+( 2)*shiftk,
-                                  j+( 2)*shiftj,
-                                  i+( 2)*shifti))
-          + (  +3./2.   * quant(m,k+(-1)*shiftk,
-                                  j+(-1)*shiftj,
-                                  i+(-1)*shifti)
-               +3./2.   * quant(m,k+( 1)*shiftk,
-                                  j+( 1)*shiftj,
-                                  i+( 1)*shifti))
-              -49./18.  * quant(m,k,
-                                  j,
-                                  i);
-  }
+  Real out = fd::D2<NGHOST>([&](const int s) {
+    return quant(m,k+s*shiftk, j+s*shiftj, i+s*shifti);
+  });
   return out*idx[dir]*idx[dir];
 }
 
 
-// Reminder: this code has been generated with py/write_FD.py,
-// please do modifications there.// 1st derivative vector
+// 2nd derivative vector
 template <int NGHOST, typename TYPE>
 KOKKOS_INLINE_FUNCTION
 Real Dxx(int const dir,
@@ -253,62 +90,14 @@ Real Dxx(int const dir,
   int const shiftk = dir==2;
   int const shiftj = dir==1;
   int const shifti = dir==0;
-  Real out;
-  if constexpr ( NGHOST == 2 ) {
-    out = + (   +1.     * quant(m,a,k+(-1)*shiftk,
-                                    j+(-1)*shiftj,
-                                    i+(-1)*shifti)
-                +1.     * quant(m,a,k+( 1)*shiftk,
-                                    j+( 1)*shiftj,
-                                    i+( 1)*shifti))
-                -2.     * quant(m,a,k,
-                                    j,
-                                    i);
-  } else if constexpr ( NGHOST == 3 ) {
-    out = + ( -1./12.   * quant(m,a,k+(-2)*shiftk,
-                                    j+(-2)*shiftj,
-                                    i+(-2)*shifti)
-              -1./12.   * quant(m,a,k+( 2)*shiftk,
-                                    j+( 2)*shiftj,
-                                    i+( 2)*shifti))
-          + (  +4./3.   * quant(m,a,k+(-1)*shiftk,
-                                    j+(-1)*shiftj,
-                                    i+(-1)*shifti)
-               +4./3.   * quant(m,a,k+( 1)*shiftk,
-                                    j+( 1)*shiftj,
-                                    i+( 1)*shifti))
-               -5./2.   * quant(m,a,k,
-                                    j,
-                                    i);
-  } else if constexpr ( NGHOST == 4 ) {
-    out = + ( +1./90.   * quant(m,a,k+(-3)*shiftk,
-                                    j+(-3)*shiftj,
-                                    i+(-3)*shifti)
-              +1./90.   * quant(m,a,k+( 3)*shiftk,
-                                    j+( 3)*shiftj,
-                                    i+( 3)*shifti))
-          + ( -3./20.   * quant(m,a,k+(-2)*shiftk,
-                                    j+(-2)*shiftj,
-                                    i+(-2)*shifti)
-              -3./20.   * quant(m,a,k+( 2)*shiftk,
-                                    j+( 2)*shiftj,
-                                    i+( 2)*shifti))
-          + (  +3./2.   * quant(m,a,k+(-1)*shiftk,
-                                    j+(-1)*shiftj,
-                                    i+(-1)*shifti)
-               +3./2.   * quant(m,a,k+( 1)*shiftk,
-                                    j+( 1)*shiftj,
-                                    i+( 1)*shifti))
-              -49./18.  * quant(m,a,k,
-                                    j,
-                                    i);
-  }
+  Real out = fd::D2<NGHOST>([&](const int s) {
+    return quant(m,a,k+s*shiftk, j+s*shiftj, i+s*shifti);
+  });
   return out*idx[dir]*idx[dir];
 }
 
 
-// Reminder: this code has been generated with py/write_FD.py,
-// please do modifications there.// 1st derivative 2D tensor
+// 2nd derivative 2D tensor
 template <int NGHOST, typename TYPE>
 KOKKOS_INLINE_FUNCTION
 Real Dxx(int const dir,
@@ -318,62 +107,14 @@ Real Dxx(int const dir,
   int const shiftk = dir==2;
   int const shiftj = dir==1;
   int const shifti = dir==0;
-  Real out;
-  if constexpr ( NGHOST == 2 ) {
-    out = + (   +1.     * quant(m,a,b,k+(-1)*shiftk,
-                                      j+(-1)*shiftj,
-                                      i+(-1)*shifti)
-                +1.     * quant(m,a,b,k+( 1)*shiftk,
-                                      j+( 1)*shiftj,
-                                      i+( 1)*shifti))
-                -2.     * quant(m,a,b,k,
-                                      j,
-                                      i);
-  } else if constexpr ( NGHOST == 3 ) {
-    out = + ( -1./12.   * quant(m,a,b,k+(-2)*shiftk,
-                                      j+(-2)*shiftj,
-                                      i+(-2)*shifti)
-              -1./12.   * quant(m,a,b,k+( 2)*shiftk,
-                                      j+( 2)*shiftj,
-                                      i+( 2)*shifti))
-          + (  +4./3.   * quant(m,a,b,k+(-1)*shiftk,
-                                      j+(-1)*shiftj,
-                                      i+(-1)*shifti)
-               +4./3.   * quant(m,a,b,k+( 1)*shiftk,
-                                      j+( 1)*shiftj,
-                                      i+( 1)*shifti))
-               -5./2.   * quant(m,a,b,k,
-                                      j,
-                                      i);
-  } else if constexpr ( NGHOST == 4 ) {
-    out = + ( +1./90.   * quant(m,a,b,k+(-3)*shiftk,
-                                      j+(-3)*shiftj,
-                                      i+(-3)*shifti)
-              +1./90.   * quant(m,a,b,k+( 3)*shiftk,
-                                      j+( 3)*shiftj,
-                                      i+( 3)*shifti))
-          + ( -3./20.   * quant(m,a,b,k+(-2)*shiftk,
-                                      j+(-2)*shiftj,
-                                      i+(-2)*shifti)
-              -3./20.   * quant(m,a,b,k+( 2)*shiftk,
-                                      j+( 2)*shiftj,
-                                      i+( 2)*shifti))
-          + (  +3./2.   * quant(m,a,b,k+(-1)*shiftk,
-                                      j+(-1)*shiftj,
-                                      i+(-1)*shifti)
-               +3./2.   * quant(m,a,b,k+( 1)*shiftk,
-                                      j+( 1)*shiftj,
-                                      i+( 1)*shifti))
-              -49./18.  * quant(m,a,b,k,
-                                      j,
-                                      i);
-  }
+  Real out = fd::D2<NGHOST>([&](const int s) {
+    return quant(m,a,b,k+s*shiftk, j+s*shiftj, i+s*shifti);
+  });
   return out*idx[dir]*idx[dir];
 }
 
 
-// Reminder: this code has been generated with py/write_FD.py,
-// please do modifications there.// 1st derivative scalar
+// mixed 2nd derivative scalar
 template <int NGHOST, typename TYPE>
 KOKKOS_INLINE_FUNCTION
 Real Dxy(int const dirx, int const diry,
@@ -386,269 +127,15 @@ Real Dxy(int const dirx, int const diry,
   int const shiftyk = diry==2;
   int const shiftyj = diry==1;
   int const shiftyi = diry==0;
-  Real out;
-  if constexpr ( NGHOST == 2 ) {
-    out = + (
-            + (
-              + (  -1./2.  ) * (  -1./2.  ) * quant(m,k+(-1)*shiftxk + (-1)*shiftyk,
-                                                      j+(-1)*shiftxj + (-1)*shiftyj,
-                                                      i+(-1)*shiftxi + (-1)*shiftyi)
-              + (  -1./2.  ) * (  1./2.   ) * quant(m,k+(-1)*shiftxk + ( 1)*shiftyk,
-                                                      j+(-1)*shiftxj + ( 1)*shiftyj,
-                                                      i+(-1)*shiftxi + ( 1)*shiftyi)
-              )
-            + (
-              + (  1./2.   ) * (  -1./2.  ) * quant(m,k+( 1)*shiftxk + (-1)*shiftyk,
-                                                      j+( 1)*shiftxj + (-1)*shiftyj,
-                                                      i+( 1)*shiftxi + (-1)*shiftyi)
-              + (  1./2.   ) * (  1./2.   ) * quant(m,k+( 1)*shiftxk + ( 1)*shiftyk,
-                                                      j+( 1)*shiftxj + ( 1)*shiftyj,
-                                                      i+( 1)*shiftxi + ( 1)*shiftyi)
-              )
-            );
-  } else if constexpr ( NGHOST == 3 ) {
-    out = + (
-            + (
-              + (  1./12.  ) * (  1./12.  ) * quant(m,k+(-2)*shiftxk + (-2)*shiftyk,
-                                                      j+(-2)*shiftxj + (-2)*shiftyj,
-                                                      i+(-2)*shiftxi + (-2)*shiftyi)
-              + (  1./12.  ) * ( -1./12.  ) * quant(m,k+(-2)*shiftxk + ( 2)*shiftyk,
-                                                      j+(-2)*shiftxj + ( 2)*shiftyj,
-                                                      i+(-2)*shiftxi + ( 2)*shiftyi)
-              )
-            + (
-              + ( -1./12.  ) * (  1./12.  ) * quant(m,k+( 2)*shiftxk + (-2)*shiftyk,
-                                                      j+( 2)*shiftxj + (-2)*shiftyj,
-                                                      i+( 2)*shiftxi + (-2)*shiftyi)
-              + ( -1./12.  ) * ( -1./12.  ) * quant(m,k+( 2)*shiftxk + ( 2)*shiftyk,
-                                                      j+( 2)*shiftxj + ( 2)*shiftyj,
-                                                      i+( 2)*shiftxi + ( 2)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  1./12.  ) * (  -2./3.  ) * quant(m,k+(-2)*shiftxk + (-1)*shiftyk,
-                                                      j+(-2)*shiftxj + (-1)*shiftyj,
-                                                      i+(-2)*shiftxi + (-1)*shiftyi)
-              + (  1./12.  ) * (  2./3.   ) * quant(m,k+(-2)*shiftxk + ( 1)*shiftyk,
-                                                      j+(-2)*shiftxj + ( 1)*shiftyj,
-                                                      i+(-2)*shiftxi + ( 1)*shiftyi)
-              )
-            + (
-              + ( -1./12.  ) * (  -2./3.  ) * quant(m,k+( 2)*shiftxk + (-1)*shiftyk,
-                                                      j+( 2)*shiftxj + (-1)*shiftyj,
-                                                      i+( 2)*shiftxi + (-1)*shiftyi)
-              + ( -1./12.  ) * (  2./3.   ) * quant(m,k+( 2)*shiftxk + ( 1)*shiftyk,
-                                                      j+( 2)*shiftxj + ( 1)*shiftyj,
-                                                      i+( 2)*shiftxi + ( 1)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  -2./3.  ) * (  1./12.  ) * quant(m,k+(-1)*shiftxk + (-2)*shiftyk,
-                                                      j+(-1)*shiftxj + (-2)*shiftyj,
-                                                      i+(-1)*shiftxi + (-2)*shiftyi)
-              + (  -2./3.  ) * ( -1./12.  ) * quant(m,k+(-1)*shiftxk + ( 2)*shiftyk,
-                                                      j+(-1)*shiftxj + ( 2)*shiftyj,
-                                                      i+(-1)*shiftxi + ( 2)*shiftyi)
-              )
-            + (
-              + (  2./3.   ) * (  1./12.  ) * quant(m,k+( 1)*shiftxk + (-2)*shiftyk,
-                                                      j+( 1)*shiftxj + (-2)*shiftyj,
-                                                      i+( 1)*shiftxi + (-2)*shiftyi)
-              + (  2./3.   ) * ( -1./12.  ) * quant(m,k+( 1)*shiftxk + ( 2)*shiftyk,
-                                                      j+( 1)*shiftxj + ( 2)*shiftyj,
-                                                      i+( 1)*shiftxi + ( 2)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  -2./3.  ) * (  -2./3.  ) * quant(m,k+(-1)*shiftxk + (-1)*shiftyk,
-                                                      j+(-1)*shiftxj + (-1)*shiftyj,
-                                                      i+(-1)*shiftxi + (-1)*shiftyi)
-              + (  -2./3.  ) * (  2./3.   ) * quant(m,k+(-1)*shiftxk + ( 1)*shiftyk,
-                                                      j+(-1)*shiftxj + ( 1)*shiftyj,
-                                                      i+(-1)*shiftxi + ( 1)*shiftyi)
-              )
-            + (
-              + (  2./3.   ) * (  -2./3.  ) * quant(m,k+( 1)*shiftxk + (-1)*shiftyk,
-                                                      j+( 1)*shiftxj + (-1)*shiftyj,
-                                                      i+( 1)*shiftxi + (-1)*shiftyi)
-              + (  2./3.   ) * (  2./3.   ) * quant(m,k+( 1)*shiftxk + ( 1)*shiftyk,
-                                                      j+( 1)*shiftxj + ( 1)*shiftyj,
-                                                      i+( 1)*shiftxi + ( 1)*shiftyi)
-              )
-            );
-  } else if constexpr ( NGHOST == 4 ) {
-    out = + (
-            + (
-              + ( -1./60.  ) * ( -1./60.  ) * quant(m,k+(-3)*shiftxk + (-3)*shiftyk,
-                                                      j+(-3)*shiftxj + (-3)*shiftyj,
-                                                      i+(-3)*shiftxi + (-3)*shiftyi)
-              + ( -1./60.  ) * (  1./60.  ) * quant(m,k+(-3)*shiftxk + ( 3)*shiftyk,
-                                                      j+(-3)*shiftxj + ( 3)*shiftyj,
-                                                      i+(-3)*shiftxi + ( 3)*shiftyi)
-              )
-            + (
-              + (  1./60.  ) * ( -1./60.  ) * quant(m,k+( 3)*shiftxk + (-3)*shiftyk,
-                                                      j+( 3)*shiftxj + (-3)*shiftyj,
-                                                      i+( 3)*shiftxi + (-3)*shiftyi)
-              + (  1./60.  ) * (  1./60.  ) * quant(m,k+( 3)*shiftxk + ( 3)*shiftyk,
-                                                      j+( 3)*shiftxj + ( 3)*shiftyj,
-                                                      i+( 3)*shiftxi + ( 3)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + ( -1./60.  ) * (  3./20.  ) * quant(m,k+(-3)*shiftxk + (-2)*shiftyk,
-                                                      j+(-3)*shiftxj + (-2)*shiftyj,
-                                                      i+(-3)*shiftxi + (-2)*shiftyi)
-              + ( -1./60.  ) * ( -3./20.  ) * quant(m,k+(-3)*shiftxk + ( 2)*shiftyk,
-                                                      j+(-3)*shiftxj + ( 2)*shiftyj,
-                                                      i+(-3)*shiftxi + ( 2)*shiftyi)
-              )
-            + (
-              + (  1./60.  ) * (  3./20.  ) * quant(m,k+( 3)*shiftxk + (-2)*shiftyk,
-                                                      j+( 3)*shiftxj + (-2)*shiftyj,
-                                                      i+( 3)*shiftxi + (-2)*shiftyi)
-              + (  1./60.  ) * ( -3./20.  ) * quant(m,k+( 3)*shiftxk + ( 2)*shiftyk,
-                                                      j+( 3)*shiftxj + ( 2)*shiftyj,
-                                                      i+( 3)*shiftxi + ( 2)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + ( -1./60.  ) * (  -3./4.  ) * quant(m,k+(-3)*shiftxk + (-1)*shiftyk,
-                                                      j+(-3)*shiftxj + (-1)*shiftyj,
-                                                      i+(-3)*shiftxi + (-1)*shiftyi)
-              + ( -1./60.  ) * (  3./4.   ) * quant(m,k+(-3)*shiftxk + ( 1)*shiftyk,
-                                                      j+(-3)*shiftxj + ( 1)*shiftyj,
-                                                      i+(-3)*shiftxi + ( 1)*shiftyi)
-              )
-            + (
-              + (  1./60.  ) * (  -3./4.  ) * quant(m,k+( 3)*shiftxk + (-1)*shiftyk,
-                                                      j+( 3)*shiftxj + (-1)*shiftyj,
-                                                      i+( 3)*shiftxi + (-1)*shiftyi)
-              + (  1./60.  ) * (  3./4.   ) * quant(m,k+( 3)*shiftxk + ( 1)*shiftyk,
-                                                      j+( 3)*shiftxj + ( 1)*shiftyj,
-                                                      i+( 3)*shiftxi + ( 1)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  3./20.  ) * ( -1./60.  ) * quant(m,k+(-2)*shiftxk + (-3)*shiftyk,
-                                                      j+(-2)*shiftxj + (-3)*shiftyj,
-                                                      i+(-2)*shiftxi + (-3)*shiftyi)
-              + (  3./20.  ) * (  1./60.  ) * quant(m,k+(-2)*shiftxk + ( 3)*shiftyk,
-                                                      j+(-2)*shiftxj + ( 3)*shiftyj,
-                                                      i+(-2)*shiftxi + ( 3)*shiftyi)
-              )
-            + (
-              + ( -3./20.  ) * ( -1./60.  ) * quant(m,k+( 2)*shiftxk + (-3)*shiftyk,
-                                                      j+( 2)*shiftxj + (-3)*shiftyj,
-                                                      i+( 2)*shiftxi + (-3)*shiftyi)
-              + ( -3./20.  ) * (  1./60.  ) * quant(m,k+( 2)*shiftxk + ( 3)*shiftyk,
-                                                      j+( 2)*shiftxj + ( 3)*shiftyj,
-                                                      i+( 2)*shiftxi + ( 3)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  3./20.  ) * (  3./20.  ) * quant(m,k+(-2)*shiftxk + (-2)*shiftyk,
-                                                      j+(-2)*shiftxj + (-2)*shiftyj,
-                                                      i+(-2)*shiftxi + (-2)*shiftyi)
-              + (  3./20.  ) * ( -3./20.  ) * quant(m,k+(-2)*shiftxk + ( 2)*shiftyk,
-                                                      j+(-2)*shiftxj + ( 2)*shiftyj,
-                                                      i+(-2)*shiftxi + ( 2)*shiftyi)
-              )
-            + (
-              + ( -3./20.  ) * (  3./20.  ) * quant(m,k+( 2)*shiftxk + (-2)*shiftyk,
-                                                      j+( 2)*shiftxj + (-2)*shiftyj,
-                                                      i+( 2)*shiftxi + (-2)*shiftyi)
-              + ( -3./20.  ) * ( -3./20.  ) * quant(m,k+( 2)*shiftxk + ( 2)*shiftyk,
-                                                      j+( 2)*shiftxj + ( 2)*shiftyj,
-                                                      i+( 2)*shiftxi + ( 2)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  3./20.  ) * (  -3./4.  ) * quant(m,k+(-2)*shiftxk + (-1)*shiftyk,
-                                                      j+(-2)*shiftxj + (-1)*shiftyj,
-                                                      i+(-2)*shiftxi + (-1)*shiftyi)
-              + (  3./20.  ) * (  3./4.   ) * quant(m,k+(-2)*shiftxk + ( 1)*shiftyk,
-                                                      j+(-2)*shiftxj + ( 1)*shiftyj,
-                                                      i+(-2)*shiftxi + ( 1)*shiftyi)
-              )
-            + (
-              + ( -3./20.  ) * (  -3./4.  ) * quant(m,k+( 2)*shiftxk + (-1)*shiftyk,
-                                                      j+( 2)*shiftxj + (-1)*shiftyj,
-                                                      i+( 2)*shiftxi + (-1)*shiftyi)
-              + ( -3./20.  ) * (  3./4.   ) * quant(m,k+( 2)*shiftxk + ( 1)*shiftyk,
-                                                      j+( 2)*shiftxj + ( 1)*shiftyj,
-                                                      i+( 2)*shiftxi + ( 1)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  -3./4.  ) * ( -1./60.  ) * quant(m,k+(-1)*shiftxk + (-3)*shiftyk,
-                                                      j+(-1)*shiftxj + (-3)*shiftyj,
-                                                      i+(-1)*shiftxi + (-3)*shiftyi)
-              + (  -3./4.  ) * (  1./60.  ) * quant(m,k+(-1)*shiftxk + ( 3)*shiftyk,
-                                                      j+(-1)*shiftxj + ( 3)*shiftyj,
-                                                      i+(-1)*shiftxi + ( 3)*shiftyi)
-              )
-            + (
-              + (  3./4.   ) * ( -1./60.  ) * quant(m,k+( 1)*shiftxk + (-3)*shiftyk,
-                                                      j+( 1)*shiftxj + (-3)*shiftyj,
-                                                      i+( 1)*shiftxi + (-3)*shiftyi)
-              + (  3./4.   ) * (  1./60.  ) * quant(m,k+( 1)*shiftxk + ( 3)*shiftyk,
-                                                      j+( 1)*shiftxj + ( 3)*shiftyj,
-                                                      i+( 1)*shiftxi + ( 3)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  -3./4.  ) * (  3./20.  ) * quant(m,k+(-1)*shiftxk + (-2)*shiftyk,
-                                                      j+(-1)*shiftxj + (-2)*shiftyj,
-                                                      i+(-1)*shiftxi + (-2)*shiftyi)
-              + (  -3./4.  ) * ( -3./20.  ) * quant(m,k+(-1)*shiftxk + ( 2)*shiftyk,
-                                                      j+(-1)*shiftxj + ( 2)*shiftyj,
-                                                      i+(-1)*shiftxi + ( 2)*shiftyi)
-              )
-            + (
-              + (  3./4.   ) * (  3./20.  ) * quant(m,k+( 1)*shiftxk + (-2)*shiftyk,
-                                                      j+( 1)*shiftxj + (-2)*shiftyj,
-                                                      i+( 1)*shiftxi + (-2)*shiftyi)
-              + (  3./4.   ) * ( -3./20.  ) * quant(m,k+( 1)*shiftxk + ( 2)*shiftyk,
-                                                      j+( 1)*shiftxj + ( 2)*shiftyj,
-                                                      i+( 1)*shiftxi + ( 2)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  -3./4.  ) * (  -3./4.  ) * quant(m,k+(-1)*shiftxk + (-1)*shiftyk,
-                                                      j+(-1)*shiftxj + (-1)*shiftyj,
-                                                      i+(-1)*shiftxi + (-1)*shiftyi)
-              + (  -3./4.  ) * (  3./4.   ) * quant(m,k+(-1)*shiftxk + ( 1)*shiftyk,
-                                                      j+(-1)*shiftxj + ( 1)*shiftyj,
-                                                      i+(-1)*shiftxi + ( 1)*shiftyi)
-              )
-            + (
-              + (  3./4.   ) * (  -3./4.  ) * quant(m,k+( 1)*shiftxk + (-1)*shiftyk,
-                                                      j+( 1)*shiftxj + (-1)*shiftyj,
-                                                      i+( 1)*shiftxi + (-1)*shiftyi)
-              + (  3./4.   ) * (  3./4.   ) * quant(m,k+( 1)*shiftxk + ( 1)*shiftyk,
-                                                      j+( 1)*shiftxj + ( 1)*shiftyj,
-                                                      i+( 1)*shiftxi + ( 1)*shiftyi)
-              )
-            );
-  }
+  Real out = fd::D11<NGHOST>([&](const int sx, const int sy) {
+    return quant(m,k+sx*shiftxk+sy*shiftyk, j+sx*shiftxj+sy*shiftyj,
+                 i+sx*shiftxi+sy*shiftyi);
+  });
   return out*idx[dirx]*idx[diry];
 }
 
 
-// Reminder: this code has been generated with py/write_FD.py,
-// please do modifications there.// 1st derivative vector
+// mixed 2nd derivative vector
 template <int NGHOST, typename TYPE>
 KOKKOS_INLINE_FUNCTION
 Real Dxy(int const dirx, int const diry,
@@ -661,269 +148,15 @@ Real Dxy(int const dirx, int const diry,
   int const shiftyk = diry==2;
   int const shiftyj = diry==1;
   int const shiftyi = diry==0;
-  Real out;
-  if constexpr ( NGHOST == 2 ) {
-    out = + (
-            + (
-              + (  -1./2.  ) * (  -1./2.  ) * quant(m,a,k+(-1)*shiftxk + (-1)*shiftyk,
-                                                        j+(-1)*shiftxj + (-1)*shiftyj,
-                                                        i+(-1)*shiftxi + (-1)*shiftyi)
-              + (  -1./2.  ) * (  1./2.   ) * quant(m,a,k+(-1)*shiftxk + ( 1)*shiftyk,
-                                                        j+(-1)*shiftxj + ( 1)*shiftyj,
-                                                        i+(-1)*shiftxi + ( 1)*shiftyi)
-              )
-            + (
-              + (  1./2.   ) * (  -1./2.  ) * quant(m,a,k+( 1)*shiftxk + (-1)*shiftyk,
-                                                        j+( 1)*shiftxj + (-1)*shiftyj,
-                                                        i+( 1)*shiftxi + (-1)*shiftyi)
-              + (  1./2.   ) * (  1./2.   ) * quant(m,a,k+( 1)*shiftxk + ( 1)*shiftyk,
-                                                        j+( 1)*shiftxj + ( 1)*shiftyj,
-                                                        i+( 1)*shiftxi + ( 1)*shiftyi)
-              )
-            );
-  } else if constexpr ( NGHOST == 3 ) {
-    out = + (
-            + (
-              + (  1./12.  ) * (  1./12.  ) * quant(m,a,k+(-2)*shiftxk + (-2)*shiftyk,
-                                                        j+(-2)*shiftxj + (-2)*shiftyj,
-                                                        i+(-2)*shiftxi + (-2)*shiftyi)
-              + (  1./12.  ) * ( -1./12.  ) * quant(m,a,k+(-2)*shiftxk + ( 2)*shiftyk,
-                                                        j+(-2)*shiftxj + ( 2)*shiftyj,
-                                                        i+(-2)*shiftxi + ( 2)*shiftyi)
-              )
-            + (
-              + ( -1./12.  ) * (  1./12.  ) * quant(m,a,k+( 2)*shiftxk + (-2)*shiftyk,
-                                                        j+( 2)*shiftxj + (-2)*shiftyj,
-                                                        i+( 2)*shiftxi + (-2)*shiftyi)
-              + ( -1./12.  ) * ( -1./12.  ) * quant(m,a,k+( 2)*shiftxk + ( 2)*shiftyk,
-                                                        j+( 2)*shiftxj + ( 2)*shiftyj,
-                                                        i+( 2)*shiftxi + ( 2)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  1./12.  ) * (  -2./3.  ) * quant(m,a,k+(-2)*shiftxk + (-1)*shiftyk,
-                                                        j+(-2)*shiftxj + (-1)*shiftyj,
-                                                        i+(-2)*shiftxi + (-1)*shiftyi)
-              + (  1./12.  ) * (  2./3.   ) * quant(m,a,k+(-2)*shiftxk + ( 1)*shiftyk,
-                                                        j+(-2)*shiftxj + ( 1)*shiftyj,
-                                                        i+(-2)*shiftxi + ( 1)*shiftyi)
-              )
-            + (
-              + ( -1./12.  ) * (  -2./3.  ) * quant(m,a,k+( 2)*shiftxk + (-1)*shiftyk,
-                                                        j+( 2)*shiftxj + (-1)*shiftyj,
-                                                        i+( 2)*shiftxi + (-1)*shiftyi)
-              + ( -1./12.  ) * (  2./3.   ) * quant(m,a,k+( 2)*shiftxk + ( 1)*shiftyk,
-                                                        j+( 2)*shiftxj + ( 1)*shiftyj,
-                                                        i+( 2)*shiftxi + ( 1)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  -2./3.  ) * (  1./12.  ) * quant(m,a,k+(-1)*shiftxk + (-2)*shiftyk,
-                                                        j+(-1)*shiftxj + (-2)*shiftyj,
-                                                        i+(-1)*shiftxi + (-2)*shiftyi)
-              + (  -2./3.  ) * ( -1./12.  ) * quant(m,a,k+(-1)*shiftxk + ( 2)*shiftyk,
-                                                        j+(-1)*shiftxj + ( 2)*shiftyj,
-                                                        i+(-1)*shiftxi + ( 2)*shiftyi)
-              )
-            + (
-              + (  2./3.   ) * (  1./12.  ) * quant(m,a,k+( 1)*shiftxk + (-2)*shiftyk,
-                                                        j+( 1)*shiftxj + (-2)*shiftyj,
-                                                        i+( 1)*shiftxi + (-2)*shiftyi)
-              + (  2./3.   ) * ( -1./12.  ) * quant(m,a,k+( 1)*shiftxk + ( 2)*shiftyk,
-                                                        j+( 1)*shiftxj + ( 2)*shiftyj,
-                                                        i+( 1)*shiftxi + ( 2)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  -2./3.  ) * (  -2./3.  ) * quant(m,a,k+(-1)*shiftxk + (-1)*shiftyk,
-                                                        j+(-1)*shiftxj + (-1)*shiftyj,
-                                                        i+(-1)*shiftxi + (-1)*shiftyi)
-              + (  -2./3.  ) * (  2./3.   ) * quant(m,a,k+(-1)*shiftxk + ( 1)*shiftyk,
-                                                        j+(-1)*shiftxj + ( 1)*shiftyj,
-                                                        i+(-1)*shiftxi + ( 1)*shiftyi)
-              )
-            + (
-              + (  2./3.   ) * (  -2./3.  ) * quant(m,a,k+( 1)*shiftxk + (-1)*shiftyk,
-                                                        j+( 1)*shiftxj + (-1)*shiftyj,
-                                                        i+( 1)*shiftxi + (-1)*shiftyi)
-              + (  2./3.   ) * (  2./3.   ) * quant(m,a,k+( 1)*shiftxk + ( 1)*shiftyk,
-                                                        j+( 1)*shiftxj + ( 1)*shiftyj,
-                                                        i+( 1)*shiftxi + ( 1)*shiftyi)
-              )
-            );
-  } else if constexpr ( NGHOST == 4 ) {
-    out = + (
-            + (
-              + ( -1./60.  ) * ( -1./60.  ) * quant(m,a,k+(-3)*shiftxk + (-3)*shiftyk,
-                                                        j+(-3)*shiftxj + (-3)*shiftyj,
-                                                        i+(-3)*shiftxi + (-3)*shiftyi)
-              + ( -1./60.  ) * (  1./60.  ) * quant(m,a,k+(-3)*shiftxk + ( 3)*shiftyk,
-                                                        j+(-3)*shiftxj + ( 3)*shiftyj,
-                                                        i+(-3)*shiftxi + ( 3)*shiftyi)
-              )
-            + (
-              + (  1./60.  ) * ( -1./60.  ) * quant(m,a,k+( 3)*shiftxk + (-3)*shiftyk,
-                                                        j+( 3)*shiftxj + (-3)*shiftyj,
-                                                        i+( 3)*shiftxi + (-3)*shiftyi)
-              + (  1./60.  ) * (  1./60.  ) * quant(m,a,k+( 3)*shiftxk + ( 3)*shiftyk,
-                                                        j+( 3)*shiftxj + ( 3)*shiftyj,
-                                                        i+( 3)*shiftxi + ( 3)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + ( -1./60.  ) * (  3./20.  ) * quant(m,a,k+(-3)*shiftxk + (-2)*shiftyk,
-                                                        j+(-3)*shiftxj + (-2)*shiftyj,
-                                                        i+(-3)*shiftxi + (-2)*shiftyi)
-              + ( -1./60.  ) * ( -3./20.  ) * quant(m,a,k+(-3)*shiftxk + ( 2)*shiftyk,
-                                                        j+(-3)*shiftxj + ( 2)*shiftyj,
-                                                        i+(-3)*shiftxi + ( 2)*shiftyi)
-              )
-            + (
-              + (  1./60.  ) * (  3./20.  ) * quant(m,a,k+( 3)*shiftxk + (-2)*shiftyk,
-                                                        j+( 3)*shiftxj + (-2)*shiftyj,
-                                                        i+( 3)*shiftxi + (-2)*shiftyi)
-              + (  1./60.  ) * ( -3./20.  ) * quant(m,a,k+( 3)*shiftxk + ( 2)*shiftyk,
-                                                        j+( 3)*shiftxj + ( 2)*shiftyj,
-                                                        i+( 3)*shiftxi + ( 2)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + ( -1./60.  ) * (  -3./4.  ) * quant(m,a,k+(-3)*shiftxk + (-1)*shiftyk,
-                                                        j+(-3)*shiftxj + (-1)*shiftyj,
-                                                        i+(-3)*shiftxi + (-1)*shiftyi)
-              + ( -1./60.  ) * (  3./4.   ) * quant(m,a,k+(-3)*shiftxk + ( 1)*shiftyk,
-                                                        j+(-3)*shiftxj + ( 1)*shiftyj,
-                                                        i+(-3)*shiftxi + ( 1)*shiftyi)
-              )
-            + (
-              + (  1./60.  ) * (  -3./4.  ) * quant(m,a,k+( 3)*shiftxk + (-1)*shiftyk,
-                                                        j+( 3)*shiftxj + (-1)*shiftyj,
-                                                        i+( 3)*shiftxi + (-1)*shiftyi)
-              + (  1./60.  ) * (  3./4.   ) * quant(m,a,k+( 3)*shiftxk + ( 1)*shiftyk,
-                                                        j+( 3)*shiftxj + ( 1)*shiftyj,
-                                                        i+( 3)*shiftxi + ( 1)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  3./20.  ) * ( -1./60.  ) * quant(m,a,k+(-2)*shiftxk + (-3)*shiftyk,
-                                                        j+(-2)*shiftxj + (-3)*shiftyj,
-                                                        i+(-2)*shiftxi + (-3)*shiftyi)
-              + (  3./20.  ) * (  1./60.  ) * quant(m,a,k+(-2)*shiftxk + ( 3)*shiftyk,
-                                                        j+(-2)*shiftxj + ( 3)*shiftyj,
-                                                        i+(-2)*shiftxi + ( 3)*shiftyi)
-              )
-            + (
-              + ( -3./20.  ) * ( -1./60.  ) * quant(m,a,k+( 2)*shiftxk + (-3)*shiftyk,
-                                                        j+( 2)*shiftxj + (-3)*shiftyj,
-                                                        i+( 2)*shiftxi + (-3)*shiftyi)
-              + ( -3./20.  ) * (  1./60.  ) * quant(m,a,k+( 2)*shiftxk + ( 3)*shiftyk,
-                                                        j+( 2)*shiftxj + ( 3)*shiftyj,
-                                                        i+( 2)*shiftxi + ( 3)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  3./20.  ) * (  3./20.  ) * quant(m,a,k+(-2)*shiftxk + (-2)*shiftyk,
-                                                        j+(-2)*shiftxj + (-2)*shiftyj,
-                                                        i+(-2)*shiftxi + (-2)*shiftyi)
-              + (  3./20.  ) * ( -3./20.  ) * quant(m,a,k+(-2)*shiftxk + ( 2)*shiftyk,
-                                                        j+(-2)*shiftxj + ( 2)*shiftyj,
-                                                        i+(-2)*shiftxi + ( 2)*shiftyi)
-              )
-            + (
-              + ( -3./20.  ) * (  3./20.  ) * quant(m,a,k+( 2)*shiftxk + (-2)*shiftyk,
-                                                        j+( 2)*shiftxj + (-2)*shiftyj,
-                                                        i+( 2)*shiftxi + (-2)*shiftyi)
-              + ( -3./20.  ) * ( -3./20.  ) * quant(m,a,k+( 2)*shiftxk + ( 2)*shiftyk,
-                                                        j+( 2)*shiftxj + ( 2)*shiftyj,
-                                                        i+( 2)*shiftxi + ( 2)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  3./20.  ) * (  -3./4.  ) * quant(m,a,k+(-2)*shiftxk + (-1)*shiftyk,
-                                                        j+(-2)*shiftxj + (-1)*shiftyj,
-                                                        i+(-2)*shiftxi + (-1)*shiftyi)
-              + (  3./20.  ) * (  3./4.   ) * quant(m,a,k+(-2)*shiftxk + ( 1)*shiftyk,
-                                                        j+(-2)*shiftxj + ( 1)*shiftyj,
-                                                        i+(-2)*shiftxi + ( 1)*shiftyi)
-              )
-            + (
-              + ( -3./20.  ) * (  -3./4.  ) * quant(m,a,k+( 2)*shiftxk + (-1)*shiftyk,
-                                                        j+( 2)*shiftxj + (-1)*shiftyj,
-                                                        i+( 2)*shiftxi + (-1)*shiftyi)
-              + ( -3./20.  ) * (  3./4.   ) * quant(m,a,k+( 2)*shiftxk + ( 1)*shiftyk,
-                                                        j+( 2)*shiftxj + ( 1)*shiftyj,
-                                                        i+( 2)*shiftxi + ( 1)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  -3./4.  ) * ( -1./60.  ) * quant(m,a,k+(-1)*shiftxk + (-3)*shiftyk,
-                                                        j+(-1)*shiftxj + (-3)*shiftyj,
-                                                        i+(-1)*shiftxi + (-3)*shiftyi)
-              + (  -3./4.  ) * (  1./60.  ) * quant(m,a,k+(-1)*shiftxk + ( 3)*shiftyk,
-                                                        j+(-1)*shiftxj + ( 3)*shiftyj,
-                                                        i+(-1)*shiftxi + ( 3)*shiftyi)
-              )
-            + (
-              + (  3./4.   ) * ( -1./60.  ) * quant(m,a,k+( 1)*shiftxk + (-3)*shiftyk,
-                                                        j+( 1)*shiftxj + (-3)*shiftyj,
-                                                        i+( 1)*shiftxi + (-3)*shiftyi)
-              + (  3./4.   ) * (  1./60.  ) * quant(m,a,k+( 1)*shiftxk + ( 3)*shiftyk,
-                                                        j+( 1)*shiftxj + ( 3)*shiftyj,
-                                                        i+( 1)*shiftxi + ( 3)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  -3./4.  ) * (  3./20.  ) * quant(m,a,k+(-1)*shiftxk + (-2)*shiftyk,
-                                                        j+(-1)*shiftxj + (-2)*shiftyj,
-                                                        i+(-1)*shiftxi + (-2)*shiftyi)
-              + (  -3./4.  ) * ( -3./20.  ) * quant(m,a,k+(-1)*shiftxk + ( 2)*shiftyk,
-                                                        j+(-1)*shiftxj + ( 2)*shiftyj,
-                                                        i+(-1)*shiftxi + ( 2)*shiftyi)
-              )
-            + (
-              + (  3./4.   ) * (  3./20.  ) * quant(m,a,k+( 1)*shiftxk + (-2)*shiftyk,
-                                                        j+( 1)*shiftxj + (-2)*shiftyj,
-                                                        i+( 1)*shiftxi + (-2)*shiftyi)
-              + (  3./4.   ) * ( -3./20.  ) * quant(m,a,k+( 1)*shiftxk + ( 2)*shiftyk,
-                                                        j+( 1)*shiftxj + ( 2)*shiftyj,
-                                                        i+( 1)*shiftxi + ( 2)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  -3./4.  ) * (  -3./4.  ) * quant(m,a,k+(-1)*shiftxk + (-1)*shiftyk,
-                                                        j+(-1)*shiftxj + (-1)*shiftyj,
-                                                        i+(-1)*shiftxi + (-1)*shiftyi)
-              + (  -3./4.  ) * (  3./4.   ) * quant(m,a,k+(-1)*shiftxk + ( 1)*shiftyk,
-                                                        j+(-1)*shiftxj + ( 1)*shiftyj,
-                                                        i+(-1)*shiftxi + ( 1)*shiftyi)
-              )
-            + (
-              + (  3./4.   ) * (  -3./4.  ) * quant(m,a,k+( 1)*shiftxk + (-1)*shiftyk,
-                                                        j+( 1)*shiftxj + (-1)*shiftyj,
-                                                        i+( 1)*shiftxi + (-1)*shiftyi)
-              + (  3./4.   ) * (  3./4.   ) * quant(m,a,k+( 1)*shiftxk + ( 1)*shiftyk,
-                                                        j+( 1)*shiftxj + ( 1)*shiftyj,
-                                                        i+( 1)*shiftxi + ( 1)*shiftyi)
-              )
-            );
-  }
+  Real out = fd::D11<NGHOST>([&](const int sx, const int sy) {
+    return quant(m,a,k+sx*shiftxk+sy*shiftyk, j+sx*shiftxj+sy*shiftyj,
+                 i+sx*shiftxi+sy*shiftyi);
+  });
   return out*idx[dirx]*idx[diry];
 }
 
 
-// Reminder: this code has been generated with py/write_FD.py,
-// please do modifications there.// 1st derivative 2D tensor
+// mixed 2nd derivative 2D tensor
 template <int NGHOST, typename TYPE>
 KOKKOS_INLINE_FUNCTION
 Real Dxy(int const dirx, int const diry,
@@ -936,267 +169,34 @@ Real Dxy(int const dirx, int const diry,
   int const shiftyk = diry==2;
   int const shiftyj = diry==1;
   int const shiftyi = diry==0;
-  Real out;
-  if constexpr ( NGHOST == 2 ) {
-    out = + (
-            + (
-              + (  -1./2.  ) * (  -1./2.  ) * quant(m,a,b,k+(-1)*shiftxk + (-1)*shiftyk,
-                                                          j+(-1)*shiftxj + (-1)*shiftyj,
-                                                          i+(-1)*shiftxi + (-1)*shiftyi)
-              + (  -1./2.  ) * (  1./2.   ) * quant(m,a,b,k+(-1)*shiftxk + ( 1)*shiftyk,
-                                                          j+(-1)*shiftxj + ( 1)*shiftyj,
-                                                          i+(-1)*shiftxi + ( 1)*shiftyi)
-              )
-            + (
-              + (  1./2.   ) * (  -1./2.  ) * quant(m,a,b,k+( 1)*shiftxk + (-1)*shiftyk,
-                                                          j+( 1)*shiftxj + (-1)*shiftyj,
-                                                          i+( 1)*shiftxi + (-1)*shiftyi)
-              + (  1./2.   ) * (  1./2.   ) * quant(m,a,b,k+( 1)*shiftxk + ( 1)*shiftyk,
-                                                          j+( 1)*shiftxj + ( 1)*shiftyj,
-                                                          i+( 1)*shiftxi + ( 1)*shiftyi)
-              )
-            );
-  } else if constexpr ( NGHOST == 3 ) {
-    out = + (
-            + (
-              + (  1./12.  ) * (  1./12.  ) * quant(m,a,b,k+(-2)*shiftxk + (-2)*shiftyk,
-                                                          j+(-2)*shiftxj + (-2)*shiftyj,
-                                                          i+(-2)*shiftxi + (-2)*shiftyi)
-              + (  1./12.  ) * ( -1./12.  ) * quant(m,a,b,k+(-2)*shiftxk + ( 2)*shiftyk,
-                                                          j+(-2)*shiftxj + ( 2)*shiftyj,
-                                                          i+(-2)*shiftxi + ( 2)*shiftyi)
-              )
-            + (
-              + ( -1./12.  ) * (  1./12.  ) * quant(m,a,b,k+( 2)*shiftxk + (-2)*shiftyk,
-                                                          j+( 2)*shiftxj + (-2)*shiftyj,
-                                                          i+( 2)*shiftxi + (-2)*shiftyi)
-              + ( -1./12.  ) * ( -1./12.  ) * quant(m,a,b,k+( 2)*shiftxk + ( 2)*shiftyk,
-                                                          j+( 2)*shiftxj + ( 2)*shiftyj,
-                                                          i+( 2)*shiftxi + ( 2)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  1./12.  ) * (  -2./3.  ) * quant(m,a,b,k+(-2)*shiftxk + (-1)*shiftyk,
-                                                          j+(-2)*shiftxj + (-1)*shiftyj,
-                                                          i+(-2)*shiftxi + (-1)*shiftyi)
-              + (  1./12.  ) * (  2./3.   ) * quant(m,a,b,k+(-2)*shiftxk + ( 1)*shiftyk,
-                                                          j+(-2)*shiftxj + ( 1)*shiftyj,
-                                                          i+(-2)*shiftxi + ( 1)*shiftyi)
-              )
-            + (
-              + ( -1./12.  ) * (  -2./3.  ) * quant(m,a,b,k+( 2)*shiftxk + (-1)*shiftyk,
-                                                          j+( 2)*shiftxj + (-1)*shiftyj,
-                                                          i+( 2)*shiftxi + (-1)*shiftyi)
-              + ( -1./12.  ) * (  2./3.   ) * quant(m,a,b,k+( 2)*shiftxk + ( 1)*shiftyk,
-                                                          j+( 2)*shiftxj + ( 1)*shiftyj,
-                                                          i+( 2)*shiftxi + ( 1)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  -2./3.  ) * (  1./12.  ) * quant(m,a,b,k+(-1)*shiftxk + (-2)*shiftyk,
-                                                          j+(-1)*shiftxj + (-2)*shiftyj,
-                                                          i+(-1)*shiftxi + (-2)*shiftyi)
-              + (  -2./3.  ) * ( -1./12.  ) * quant(m,a,b,k+(-1)*shiftxk + ( 2)*shiftyk,
-                                                          j+(-1)*shiftxj + ( 2)*shiftyj,
-                                                          i+(-1)*shiftxi + ( 2)*shiftyi)
-              )
-            + (
-              + (  2./3.   ) * (  1./12.  ) * quant(m,a,b,k+( 1)*shiftxk + (-2)*shiftyk,
-                                                          j+( 1)*shiftxj + (-2)*shiftyj,
-                                                          i+( 1)*shiftxi + (-2)*shiftyi)
-              + (  2./3.   ) * ( -1./12.  ) * quant(m,a,b,k+( 1)*shiftxk + ( 2)*shiftyk,
-                                                          j+( 1)*shiftxj + ( 2)*shiftyj,
-                                                          i+( 1)*shiftxi + ( 2)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  -2./3.  ) * (  -2./3.  ) * quant(m,a,b,k+(-1)*shiftxk + (-1)*shiftyk,
-                                                          j+(-1)*shiftxj + (-1)*shiftyj,
-                                                          i+(-1)*shiftxi + (-1)*shiftyi)
-              + (  -2./3.  ) * (  2./3.   ) * quant(m,a,b,k+(-1)*shiftxk + ( 1)*shiftyk,
-                                                          j+(-1)*shiftxj + ( 1)*shiftyj,
-                                                          i+(-1)*shiftxi + ( 1)*shiftyi)
-              )
-            + (
-              + (  2./3.   ) * (  -2./3.  ) * quant(m,a,b,k+( 1)*shiftxk + (-1)*shiftyk,
-                                                          j+( 1)*shiftxj + (-1)*shiftyj,
-                                                          i+( 1)*shiftxi + (-1)*shiftyi)
-              + (  2./3.   ) * (  2./3.   ) * quant(m,a,b,k+( 1)*shiftxk + ( 1)*shiftyk,
-                                                          j+( 1)*shiftxj + ( 1)*shiftyj,
-                                                          i+( 1)*shiftxi + ( 1)*shiftyi)
-              )
-            );
-  } else if constexpr ( NGHOST == 4 ) {
-    out = + (
-            + (
-              + ( -1./60.  ) * ( -1./60.  ) * quant(m,a,b,k+(-3)*shiftxk + (-3)*shiftyk,
-                                                          j+(-3)*shiftxj + (-3)*shiftyj,
-                                                          i+(-3)*shiftxi + (-3)*shiftyi)
-              + ( -1./60.  ) * (  1./60.  ) * quant(m,a,b,k+(-3)*shiftxk + ( 3)*shiftyk,
-                                                          j+(-3)*shiftxj + ( 3)*shiftyj,
-                                                          i+(-3)*shiftxi + ( 3)*shiftyi)
-              )
-            + (
-              + (  1./60.  ) * ( -1./60.  ) * quant(m,a,b,k+( 3)*shiftxk + (-3)*shiftyk,
-                                                          j+( 3)*shiftxj + (-3)*shiftyj,
-                                                          i+( 3)*shiftxi + (-3)*shiftyi)
-              + (  1./60.  ) * (  1./60.  ) * quant(m,a,b,k+( 3)*shiftxk + ( 3)*shiftyk,
-                                                          j+( 3)*shiftxj + ( 3)*shiftyj,
-                                                          i+( 3)*shiftxi + ( 3)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + ( -1./60.  ) * (  3./20.  ) * quant(m,a,b,k+(-3)*shiftxk + (-2)*shiftyk,
-                                                          j+(-3)*shiftxj + (-2)*shiftyj,
-                                                          i+(-3)*shiftxi + (-2)*shiftyi)
-              + ( -1./60.  ) * ( -3./20.  ) * quant(m,a,b,k+(-3)*shiftxk + ( 2)*shiftyk,
-                                                          j+(-3)*shiftxj + ( 2)*shiftyj,
-                                                          i+(-3)*shiftxi + ( 2)*shiftyi)
-              )
-            + (
-              + (  1./60.  ) * (  3./20.  ) * quant(m,a,b,k+( 3)*shiftxk + (-2)*shiftyk,
-                                                          j+( 3)*shiftxj + (-2)*shiftyj,
-                                                          i+( 3)*shiftxi + (-2)*shiftyi)
-              + (  1./60.  ) * ( -3./20.  ) * quant(m,a,b,k+( 3)*shiftxk + ( 2)*shiftyk,
-                                                          j+( 3)*shiftxj + ( 2)*shiftyj,
-                                                          i+( 3)*shiftxi + ( 2)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + ( -1./60.  ) * (  -3./4.  ) * quant(m,a,b,k+(-3)*shiftxk + (-1)*shiftyk,
-                                                          j+(-3)*shiftxj + (-1)*shiftyj,
-                                                          i+(-3)*shiftxi + (-1)*shiftyi)
-              + ( -1./60.  ) * (  3./4.   ) * quant(m,a,b,k+(-3)*shiftxk + ( 1)*shiftyk,
-                                                          j+(-3)*shiftxj + ( 1)*shiftyj,
-                                                          i+(-3)*shiftxi + ( 1)*shiftyi)
-              )
-            + (
-              + (  1./60.  ) * (  -3./4.  ) * quant(m,a,b,k+( 3)*shiftxk + (-1)*shiftyk,
-                                                          j+( 3)*shiftxj + (-1)*shiftyj,
-                                                          i+( 3)*shiftxi + (-1)*shiftyi)
-              + (  1./60.  ) * (  3./4.   ) * quant(m,a,b,k+( 3)*shiftxk + ( 1)*shiftyk,
-                                                          j+( 3)*shiftxj + ( 1)*shiftyj,
-                                                          i+( 3)*shiftxi + ( 1)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  3./20.  ) * ( -1./60.  ) * quant(m,a,b,k+(-2)*shiftxk + (-3)*shiftyk,
-                                                          j+(-2)*shiftxj + (-3)*shiftyj,
-                                                          i+(-2)*shiftxi + (-3)*shiftyi)
-              + (  3./20.  ) * (  1./60.  ) * quant(m,a,b,k+(-2)*shiftxk + ( 3)*shiftyk,
-                                                          j+(-2)*shiftxj + ( 3)*shiftyj,
-                                                          i+(-2)*shiftxi + ( 3)*shiftyi)
-              )
-            + (
-              + ( -3./20.  ) * ( -1./60.  ) * quant(m,a,b,k+( 2)*shiftxk + (-3)*shiftyk,
-                                                          j+( 2)*shiftxj + (-3)*shiftyj,
-                                                          i+( 2)*shiftxi + (-3)*shiftyi)
-              + ( -3./20.  ) * (  1./60.  ) * quant(m,a,b,k+( 2)*shiftxk + ( 3)*shiftyk,
-                                                          j+( 2)*shiftxj + ( 3)*shiftyj,
-                                                          i+( 2)*shiftxi + ( 3)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  3./20.  ) * (  3./20.  ) * quant(m,a,b,k+(-2)*shiftxk + (-2)*shiftyk,
-                                                          j+(-2)*shiftxj + (-2)*shiftyj,
-                                                          i+(-2)*shiftxi + (-2)*shiftyi)
-              + (  3./20.  ) * ( -3./20.  ) * quant(m,a,b,k+(-2)*shiftxk + ( 2)*shiftyk,
-                                                          j+(-2)*shiftxj + ( 2)*shiftyj,
-                                                          i+(-2)*shiftxi + ( 2)*shiftyi)
-              )
-            + (
-              + ( -3./20.  ) * (  3./20.  ) * quant(m,a,b,k+( 2)*shiftxk + (-2)*shiftyk,
-                                                          j+( 2)*shiftxj + (-2)*shiftyj,
-                                                          i+( 2)*shiftxi + (-2)*shiftyi)
-              + ( -3./20.  ) * ( -3./20.  ) * quant(m,a,b,k+( 2)*shiftxk + ( 2)*shiftyk,
-                                                          j+( 2)*shiftxj + ( 2)*shiftyj,
-                                                          i+( 2)*shiftxi + ( 2)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  3./20.  ) * (  -3./4.  ) * quant(m,a,b,k+(-2)*shiftxk + (-1)*shiftyk,
-                                                          j+(-2)*shiftxj + (-1)*shiftyj,
-                                                          i+(-2)*shiftxi + (-1)*shiftyi)
-              + (  3./20.  ) * (  3./4.   ) * quant(m,a,b,k+(-2)*shiftxk + ( 1)*shiftyk,
-                                                          j+(-2)*shiftxj + ( 1)*shiftyj,
-                                                          i+(-2)*shiftxi + ( 1)*shiftyi)
-              )
-            + (
-              + ( -3./20.  ) * (  -3./4.  ) * quant(m,a,b,k+( 2)*shiftxk + (-1)*shiftyk,
-                                                          j+( 2)*shiftxj + (-1)*shiftyj,
-                                                          i+( 2)*shiftxi + (-1)*shiftyi)
-              + ( -3./20.  ) * (  3./4.   ) * quant(m,a,b,k+( 2)*shiftxk + ( 1)*shiftyk,
-                                                          j+( 2)*shiftxj + ( 1)*shiftyj,
-                                                          i+( 2)*shiftxi + ( 1)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  -3./4.  ) * ( -1./60.  ) * quant(m,a,b,k+(-1)*shiftxk + (-3)*shiftyk,
-                                                          j+(-1)*shiftxj + (-3)*shiftyj,
-                                                          i+(-1)*shiftxi + (-3)*shiftyi)
-              + (  -3./4.  ) * (  1./60.  ) * quant(m,a,b,k+(-1)*shiftxk + ( 3)*shiftyk,
-                                                          j+(-1)*shiftxj + ( 3)*shiftyj,
-                                                          i+(-1)*shiftxi + ( 3)*shiftyi)
-              )
-            + (
-              + (  3./4.   ) * ( -1./60.  ) * quant(m,a,b,k+( 1)*shiftxk + (-3)*shiftyk,
-                                                          j+( 1)*shiftxj + (-3)*shiftyj,
-                                                          i+( 1)*shiftxi + (-3)*shiftyi)
-              + (  3./4.   ) * (  1./60.  ) * quant(m,a,b,k+( 1)*shiftxk + ( 3)*shiftyk,
-                                                          j+( 1)*shiftxj + ( 3)*shiftyj,
-                                                          i+( 1)*shiftxi + ( 3)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  -3./4.  ) * (  3./20.  ) * quant(m,a,b,k+(-1)*shiftxk + (-2)*shiftyk,
-                                                          j+(-1)*shiftxj + (-2)*shiftyj,
-                                                          i+(-1)*shiftxi + (-2)*shiftyi)
-              + (  -3./4.  ) * ( -3./20.  ) * quant(m,a,b,k+(-1)*shiftxk + ( 2)*shiftyk,
-                                                          j+(-1)*shiftxj + ( 2)*shiftyj,
-                                                          i+(-1)*shiftxi + ( 2)*shiftyi)
-              )
-            + (
-              + (  3./4.   ) * (  3./20.  ) * quant(m,a,b,k+( 1)*shiftxk + (-2)*shiftyk,
-                                                          j+( 1)*shiftxj + (-2)*shiftyj,
-                                                          i+( 1)*shiftxi + (-2)*shiftyi)
-              + (  3./4.   ) * ( -3./20.  ) * quant(m,a,b,k+( 1)*shiftxk + ( 2)*shiftyk,
-                                                          j+( 1)*shiftxj + ( 2)*shiftyj,
-                                                          i+( 1)*shiftxi + ( 2)*shiftyi)
-              )
-            )
-          + (
-            + (
-              + (  -3./4.  ) * (  -3./4.  ) * quant(m,a,b,k+(-1)*shiftxk + (-1)*shiftyk,
-                                                          j+(-1)*shiftxj + (-1)*shiftyj,
-                                                          i+(-1)*shiftxi + (-1)*shiftyi)
-              + (  -3./4.  ) * (  3./4.   ) * quant(m,a,b,k+(-1)*shiftxk + ( 1)*shiftyk,
-                                                          j+(-1)*shiftxj + ( 1)*shiftyj,
-                                                          i+(-1)*shiftxi + ( 1)*shiftyi)
-              )
-            + (
-              + (  3./4.   ) * (  -3./4.  ) * quant(m,a,b,k+( 1)*shiftxk + (-1)*shiftyk,
-                                                          j+( 1)*shiftxj + (-1)*shiftyj,
-                                                          i+( 1)*shiftxi + (-1)*shiftyi)
-              + (  3./4.   ) * (  3./4.   ) * quant(m,a,b,k+( 1)*shiftxk + ( 1)*shiftyk,
-                                                          j+( 1)*shiftxj + ( 1)*shiftyj,
-                                                          i+( 1)*shiftxi + ( 1)*shiftyi)
-              )
-            );
-  }
+  Real out = fd::D11<NGHOST>([&](const int sx, const int sy) {
+    return quant(m,a,b,k+sx*shiftxk+sy*shiftyk, j+sx*shiftxj+sy*shiftyj,
+                 i+sx*shiftxi+sy*shiftyi);
+  });
   return out*idx[dirx]*idx[diry];
 }
 
 
+// 1st derivative of the 6 independent components of a symmetric 2D tensor from one
+// shared stencil, stored in out[] in the order (00,01,02,11,12,22)
+template <int NGHOST, typename TYPE>
+KOKKOS_INLINE_FUNCTION
+void DxSym(int const dir,
+        const Real idx[], TYPE &quant,
+        int const m,
+        int const k, int const j, int const i, Real out[6]) {
+  int const shiftk = dir==2;
+  int const shiftj = dir==1;
+  int const shifti = dir==0;
+  int const ia[6] = {0, 0, 0, 1, 1, 2};
+  int const ib[6] = {0, 1, 2, 1, 2, 2};
+  fd::D1Fused<NGHOST, 6>([&](const int s, const int n) {
+    return quant(m,ia[n],ib[n],k+s*shiftk, j+s*shiftj, i+s*shifti);
+  }, out);
+  for (int n=0; n<6; ++n) {out[n] = out[n]*idx[dir];}
+}
+
+
 // Reminder: this code has been generated with py/write_FD.py,
 // please do modifications there.// 1st advective derivative scalar
 template <int NGHOST, typename TYPE1, typename TYPE2>
@@ -1530,8 +530,8 @@ Real Lx(int const dir,
 }
 
 
-// Reminder: this code has been generated with py/write_FD.py,
-// please do modifications there.// 1st derivative vector
+
+// Kreiss-Oliger dissipation vector
 template <int NGHOST, typename TYPE>
 KOKKOS_INLINE_FUNCTION
 Real Diss(int const dir,
@@ -1541,74 +541,9 @@ Real Diss(int const dir,
   int const shiftk = dir==2;
   int const shiftj = dir==1;
   int const shifti = dir==0;
-  Real out;
-  if constexpr ( NGHOST == 2 ) {
-    out = + (   +1.     * quant(m,a,k+(-2)*shiftk,
-                                    j+(-2)*shiftj,
-                                    i+(-2)*shifti)
-                +1.     * quant(m,a,k+( 2)*shiftk,
-                                    j+( 2)*shiftj,
-                                    i+( 2)*shifti))
-          + (   -4.     * quant(m,a,k+(-1)*shiftk,
-                                    j+(-1)*shiftj,
-                                    i+(-1)*shifti)
-                -4.     * quant(m,a,k+( 1)*shiftk,
-                                    j+( 1)*shiftj,
-                                    i+( 1)*shifti))
-                +6.     * quant(m,a,k,
-                                    j,
-                                    i);
-  } else if constexpr ( NGHOST == 3 ) {
-    out = + (   +1.     * quant(m,a,k+(-3)*shiftk,
-                                    j+(-3)*shiftj,
-                                    i+(-3)*shifti)
-                +1.     * quant(m,a,k+( 3)*shiftk,
-                                    j+( 3)*shiftj,
-                                    i+( 3)*shifti))
-          + (   -6.     * quant(m,a,k+(-2)*shiftk,
-                                    j+(-2)*shiftj,
-                                    i+(-2)*shifti)
-                -6.     * quant(m,a,k+( 2)*shiftk,
-                                    j+( 2)*shiftj,
-                                    i+( 2)*shifti))
-          + (   +15.    * quant(m,a,k+(-1)*shiftk,
-                                    j+(-1)*shiftj,
-                                    i+(-1)*shifti)
-                +15.    * quant(m,a,k+( 1)*shiftk,
-                                    j+( 1)*shiftj,
-                                    i+( 1)*shifti))
-                -20.    * quant(m,a,k,
-                                    j,
-                                    i);
-  } else if constexpr ( NGHOST == 4 ) {
-    out = + (   +1.     * quant(m,a,k+(-4)*shiftk,
-                                    j+(-4)*shiftj,
-                                    i+(-4)*shifti)
-                +1.     * quant(m,a,k+( 4)*shiftk,
-                                    j+( 4)*shiftj,
-                                    i+( 4)*shifti))
-          + (   -8.     * quant(m,a,k+(-3)*shiftk,
-                                    j+(-3)*shiftj,
-                                    i+(-3)*shifti)
-                -8.     * quant(m,a,k+( 3)*shiftk,
-                                    j+( 3)*shiftj,
-                                    i+( 3)*shifti))
-          + (   +28.    * quant(m,a,k+(-2)*shiftk,
-                                    j+(-2)*shiftj,
-                                    i+(-2)*shifti)
-                +28.    * quant(m,a,k+( 2)*shiftk,
-                                    j+( 2)*shiftj,
-                                    i+( 2)*shifti))
-          + (   -56.    * quant(m,a,k+(-1)*shiftk,
-                                    j+(-1)*shiftj,
-                                    i+(-1)*shifti)
-                -56.    * quant(m,a,k+( 1)*shiftk,
-                                    j+( 1)*shiftj,
-                                    i+( 1)*shifti))
-                +70.    * quant(m,a,k,
-                                    j,
-                                    i);
-  }
+  Real out = fd::Diss<NGHOST>([&](const int s) {
+    return quant(m,a,k+s*shiftk, j+s*shiftj, i+s*shifti);
+  });
   return out*idx[dir];
 }
 
@@ -0,0 +1,75 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file first_touch.cpp
+//! \brief functions of FirstTouch class.  Threads are pinned by the OpenMP runtime, which
+//! reads OMP_PROC_BIND and OMP_PLACES when Kokkos is initialized (before the input file
+//! is parsed), so their binding can only be reported here, not changed.
+
+#include <iostream>
+#include <string>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "first_touch.hpp"
+
+#if OPENMP_PARALLEL_ENABLED
+#include <omp.h>
+#endif
+
+bool FirstTouch::enabled_ = false;
+
+//----------------------------------------------------------------------------------------
+//! \fn void FirstTouch::Enable()
+//! \brief Enables first touch of arrays allocated later with Realloc().  Only has an
+//! effect with OpenMP host backends, otherwise a warning is printed and the default
+//! Kokkos initialization is used.
+
+void FirstTouch::Enable() {
+#if OPENMP_PARALLEL_ENABLED
+  if (Kokkos::SpaceAccessibility<Kokkos::HostSpace, DevMemSpace>::accessible) {
+    enabled_ = true;
+    return;
+  }
+#endif
+  if (global_variable::my_rank == 0) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<job>/numa_first_touch only has an effect with OpenMP host backends"
+              << std::endl;
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void FirstTouch::Report()
+//! \brief Prints number of threads and their binding on rank 0, and the number nmb of
+//! MeshBlocks whose (k,j) rows are distributed over them.  Warns if threads are not
+//! pinned, since threads can then migrate away from the pages they touched first.
+
+void FirstTouch::Report(const int nmb) {
+  if (!(enabled_) || global_variable::my_rank != 0) return;
+#if OPENMP_PARALLEL_ENABLED
+  int nthreads = omp_get_max_threads();
+  int nplaces = omp_get_num_places();
+  omp_proc_bind_t bind = omp_get_proc_bind();
+  std::string sbind;
+  switch (bind) {
+    case omp_proc_bind_false: sbind = "false"; break;
+    case omp_proc_bind_true: sbind = "true"; break;
+    case omp_proc_bind_close: sbind = "close"; break;
+    case omp_proc_bind_spread: sbind = "spread"; break;
+    default: sbind = "primary"; break;
+  }
+  std::cout << std::endl << "NUMA first touch: " << nthreads << " threads, "
+            << "OMP_PROC_BIND=" << sbind << ", " << nplaces << " places, "
+            << nmb << " MeshBlocks in pack" << std::endl;
+  if (bind == omp_proc_bind_false) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Threads are not pinned, set e.g. OMP_PROC_BIND=spread and "
+              << "OMP_PLACES=cores for first touch to be effective" << std::endl;
+  }
+#endif
+  return;
+}
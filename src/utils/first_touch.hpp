@@ -0,0 +1,70 @@
+#ifndef UTILS_FIRST_TOUCH_HPP_
+#define UTILS_FIRST_TOUCH_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file first_touch.hpp
+//! \brief defines FirstTouch class, which allocates the large MeshBlockPack arrays with
+//! NUMA-aware first touch on host (OpenMP) backends.  Kokkos zero-fills new Views with a
+//! single-threaded memset, so all their pages are placed in the NUMA domain of the master
+//! thread.  With <job>/numa_first_touch=true the arrays are instead allocated without
+//! initialization, and zeroed with a team loop over (m,k,j) that is distributed over
+//! threads in the same way as the par_for_outer kernels that later use them.  With
+//! pinned threads (OMP_PROC_BIND/OMP_PLACES), each page then lives in the NUMA domain of
+//! the thread that updates it.  There is no effect with GPU backends.
+
+#include "athena.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \class FirstTouch
+
+class FirstTouch {
+ public:
+  // functions
+  static void Enable();
+  static bool Enabled() {return enabled_;}
+  static void Report(const int nmb);
+
+  // reallocate 5D (m,n,k,j,i) or 4D (m,k,j,i) array, with first touch if enabled
+  template <typename T>
+  static void Realloc(DvceArray5D<T> &a, const int nm, const int nn, const int nk,
+                      const int nj, const int ni) {
+    if (!(enabled_)) {
+      Kokkos::realloc(a, nm, nn, nk, nj, ni);
+      return;
+    }
+    Kokkos::realloc(Kokkos::WithoutInitializing, a, nm, nn, nk, nj, ni);
+    par_for_outer("first_touch5d",DevExeSpace(),0,0,0,(nm-1),0,(nk-1),0,(nj-1),
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+      for (int n=0; n<nn; ++n) {
+        par_for_inner(member, 0, (ni-1), [&](const int i) {
+          a(m,n,k,j,i) = static_cast<T>(0);
+        });
+      }
+    });
+    Kokkos::fence();
+  }
+  template <typename T>
+  static void Realloc(DvceArray4D<T> &a, const int nm, const int nk, const int nj,
+                      const int ni) {
+    if (!(enabled_)) {
+      Kokkos::realloc(a, nm, nk, nj, ni);
+      return;
+    }
+    Kokkos::realloc(Kokkos::WithoutInitializing, a, nm, nk, nj, ni);
+    par_for_outer("first_touch4d",DevExeSpace(),0,0,0,(nm-1),0,(nk-1),0,(nj-1),
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+      par_for_inner(member, 0, (ni-1), [&](const int i) {
+        a(m,k,j,i) = static_cast<T>(0);
+      });
+    });
+    Kokkos::fence();
+  }
+
+ private:
+  static bool enabled_;
+};
+
+#endif // UTILS_FIRST_TOUCH_HPP_
@@ -0,0 +1,129 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file global_reductions.cpp
+//! \brief functions of GlobalReductions class
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "global_reductions.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn int GlobalReductions::Add()
+//! \brief Adds value val on this rank to be reduced over all ranks with operation op, and
+//! returns its handle.  Adding a name that already exists replaces its value.
+
+int GlobalReductions::Add(const std::string &name, const double val,
+                          const ReduceOp op) {
+  if (pending_) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Value '" << name << "' added while reductions are in progress"
+              << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  auto it = names_.find(name);
+  if (it != names_.end()) {
+    Entry &e = entries_[it->second];
+    if (e.op != op) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Value '" << name << "' added with different reduction"
+                << " operations" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    if (op == ReduceOp::sum) {
+      sum_[e.index] = val;
+    } else {
+      max_[e.index] = (op == ReduceOp::max)? val : -val;
+    }
+    return it->second;
+  }
+
+  Entry e;
+  e.op = op;
+  if (op == ReduceOp::sum) {
+    e.index = static_cast<int>(sum_.size());
+    sum_.push_back(val);
+  } else {
+    e.index = static_cast<int>(max_.size());
+    max_.push_back((op == ReduceOp::max)? val : -val);
+  }
+  int handle = static_cast<int>(entries_.size());
+  entries_.push_back(e);
+  names_[name] = handle;
+  return handle;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void GlobalReductions::Start()
+//! \brief Starts non-blocking reductions of all values added (in place)
+
+void GlobalReductions::Start() {
+  if (pending_) return;
+#if MPI_PARALLEL_ENABLED
+  req_[0] = MPI_REQUEST_NULL;
+  req_[1] = MPI_REQUEST_NULL;
+  if (sum_.size() > 0) {
+    MPI_Iallreduce(MPI_IN_PLACE, sum_.data(), static_cast<int>(sum_.size()), MPI_DOUBLE,
+                   MPI_SUM, global_variable::athena_comm, &(req_[0]));
+  }
+  if (max_.size() > 0) {
+    MPI_Iallreduce(MPI_IN_PLACE, max_.data(), static_cast<int>(max_.size()), MPI_DOUBLE,
+                   MPI_MAX, global_variable::athena_comm, &(req_[1]));
+  }
+#endif
+  pending_ = true;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void GlobalReductions::Finish()
+//! \brief Waits for reductions started by Start() to complete
+
+void GlobalReductions::Finish() {
+  if (!(pending_)) return;
+#if MPI_PARALLEL_ENABLED
+  MPI_Waitall(2, req_, MPI_STATUSES_IGNORE);
+#endif
+  pending_ = false;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void GlobalReductions::Clear()
+//! \brief Removes all values (after waiting for any reductions in progress)
+
+void GlobalReductions::Clear() {
+  Finish();
+  entries_.clear();
+  names_.clear();
+  sum_.clear();
+  max_.clear();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn double GlobalReductions::Result()
+//! \brief Returns value with given handle (or name).  After Finish() this is the value
+//! reduced over all ranks, before Start() it is the value on this rank.
+
+double GlobalReductions::Result(const int handle) const {
+  const Entry &e = entries_[handle];
+  if (e.op == ReduceOp::sum) return sum_[e.index];
+  return (e.op == ReduceOp::max)? max_[e.index] : -max_[e.index];
+}
+
+double GlobalReductions::Result(const std::string &name) const {
+  auto it = names_.find(name);
+  if (it == names_.end()) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Reduced value '" << name << "' does not exist" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  return Result(it->second);
+}
@@ -0,0 +1,63 @@
+#ifndef UTILS_GLOBAL_REDUCTIONS_HPP_
+#define UTILS_GLOBAL_REDUCTIONS_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file global_reductions.hpp
+//! \brief defines GlobalReductions class, which batches scalar reductions over all MPI
+//! ranks.  Modules add named values with a reduction operation (sum, max, or min), and
+//! all values are then reduced together with at most two non-blocking MPI_Iallreduce
+//! (one for sums, one for maxima and minima, with minima stored negated), instead of one
+//! collective per value.  Values are reduced as doubles, which is exact for counters.
+//!
+//! Usage: Add() values (the same names in the same order on all ranks), Start() the
+//! reductions, do other work, then Finish() and read the Result() of each value.  Clear()
+//! removes all values so that the object can be reused (e.g. every cycle).
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+enum class ReduceOp {sum, max, min};
+
+//----------------------------------------------------------------------------------------
+//! \class GlobalReductions
+
+class GlobalReductions {
+ public:
+  GlobalReductions() : pending_(false) {}
+  ~GlobalReductions() {Finish();}
+
+  // functions
+  int Add(const std::string &name, const double val, const ReduceOp op);
+  void Start();
+  void Finish();
+  void Clear();
+  double Result(const int handle) const;
+  double Result(const std::string &name) const;
+  bool Pending() const {return pending_;}
+  int NumValues() const {return static_cast<int>(entries_.size());}
+
+ private:
+  struct Entry {
+    ReduceOp op;
+    int index;      // index of value in sum_ or max_
+  };
+  std::vector<Entry> entries_;        // values in the order they were added
+  std::map<std::string, int> names_;  // handle of each named value
+  std::vector<double> sum_, max_;     // values to be summed, and maxima (or -minima)
+  bool pending_;                      // reductions started but not yet finished
+#if MPI_PARALLEL_ENABLED
+  MPI_Request req_[2];
+#endif
+};
+
+#endif // UTILS_GLOBAL_REDUCTIONS_HPP_
@@ -0,0 +1,79 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file host_task_pool.cpp
+//! \brief functions of HostTaskPool class
+
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "athena.hpp"
+#include "host_task_pool.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn void HostTaskPool::Start()
+//! \brief Launches nthreads worker threads
+
+void HostTaskPool::Start(const int nthreads) {
+  if (!(threads_.empty())) return;
+  stop_ = false;
+  for (int n=0; n<nthreads; ++n) {
+    threads_.emplace_back(&HostTaskPool::Loop, this);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void HostTaskPool::Stop()
+//! \brief Finishes all submitted jobs, then stops worker threads and waits for them to
+//! exit
+
+void HostTaskPool::Stop() {
+  if (threads_.empty()) return;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto &t : threads_) {
+    if (t.joinable()) {t.join();}
+  }
+  threads_.clear();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void HostTaskPool::Submit()
+//! \brief Queues job to be run by the next idle thread
+
+void HostTaskPool::Submit(std::function<void()> job) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.push_back(std::move(job));
+  }
+  cv_.notify_one();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void HostTaskPool::Loop()
+//! \brief Body of each worker thread, which runs jobs until the pool is stopped and no
+//! jobs are left
+
+void HostTaskPool::Loop() {
+  while (true) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] {return stop_ || !(jobs_.empty());});
+      if (jobs_.empty()) return;
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+    job();
+  }
+}
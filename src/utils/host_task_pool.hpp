@@ -0,0 +1,49 @@
+#ifndef UTILS_HOST_TASK_POOL_HPP_
+#define UTILS_HOST_TASK_POOL_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file host_task_pool.hpp
+//! \brief defines HostTaskPool class, a pool of threads on spare CPU cores that execute
+//! Tasks marked as host tasks (TaskList::SetHostTask()), so that lightweight analysis and
+//! output on the host overlaps with the kernels launched by the other Tasks.  The number
+//! of threads is set by <job>/host_task_threads (default 0, in which case host tasks are
+//! executed by the main thread as any other Task).
+//!
+//! Host tasks must only work on host data that no other Task in the same TaskList uses
+//! while they run: they must not launch kernels, copy between host and device, or call
+//! MPI (which is only initialized for use by the main thread).
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------------------------
+//! \class HostTaskPool
+
+class HostTaskPool {
+ public:
+  HostTaskPool() : stop_(false) {}
+  ~HostTaskPool() {Stop();}
+
+  // functions
+  void Start(const int nthreads);
+  void Stop();
+  void Submit(std::function<void()> job);
+  int NumThreads() const {return static_cast<int>(threads_.size());}
+
+ private:
+  std::vector<std::thread> threads_;
+  std::deque<std::function<void()>> jobs_;  // jobs waiting for a thread
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_;
+  void Loop();
+};
+
+#endif // UTILS_HOST_TASK_POOL_HPP_
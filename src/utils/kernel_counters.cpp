@@ -0,0 +1,140 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file kernel_counters.cpp
+//! \brief functions of KernelCounters class.  The device is fenced before and after
+//! each timed kernel, so timing kernels serializes them; counters should only be enabled
+//! in runs made to measure performance.  Bytes and FLOPs are static estimates per cell
+//! supplied by the caller (ignoring cache reuse of stencils and masked operations), so
+//! achieved rates are approximate and mainly useful to compare kernels and platforms.
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "global_reductions.hpp"
+#include "kernel_counters.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \fn void KernelCounters::Start()
+//! \brief Starts timing kernel with given name, and adds estimates of bytes and FLOPs for
+//! the ncells cells (or faces, angles, etc.) it will update
+
+void KernelCounters::Start(const std::string &name, double ncells, double bytes_per_cell,
+                           double flops_per_cell) {
+  if (!(enabled)) return;
+  if (kernels_.find(name) == kernels_.end()) {order_.push_back(name);}
+  Kernel &k = kernels_[name];
+  k.ncalls++;
+  k.bytes += ncells*bytes_per_cell;
+  k.flops += ncells*flops_per_cell;
+  current_ = name;
+  Kokkos::fence();
+  start_ = clock_.seconds();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void KernelCounters::Stop()
+//! \brief Stops timing current kernel, and adds time since it was started
+
+void KernelCounters::Stop() {
+  if (!(enabled) || current_.empty()) return;
+  Kokkos::fence();
+  kernels_[current_].time += clock_.seconds() - start_;
+  current_.clear();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void KernelCounters::WriteReport()
+//! \brief Sums time, bytes and FLOPs of each kernel over ranks, and on rank 0 writes the
+//! achieved rates per device (one device per rank is assumed) to file 'fname', and
+//! optionally prints them to stdout.  If peak bandwidth and FLOP rate of the device are
+//! both set, also writes the attainable FLOP rate min(peak_flops, AI*peak_bw) given by
+//! the roofline for the arithmetic intensity AI of each kernel, and the fraction of it
+//! achieved.  Must be called by all ranks.
+
+void KernelCounters::WriteReport(const std::string &fname, bool print) {
+  if (!(enabled)) return;
+  int nk = static_cast<int>(order_.size());
+  std::vector<double> data(3*nk);
+  for (int n=0; n<nk; ++n) {
+    data[3*n    ] = kernels_[order_[n]].time;
+    data[3*n + 1] = kernels_[order_[n]].bytes;
+    data[3*n + 2] = kernels_[order_[n]].flops;
+  }
+  int nranks = 1;
+#if MPI_PARALLEL_ENABLED
+  int nk_min = nk, nk_max = nk;
+  GlobalReductions gr;
+  gr.Add("nk_min", nk, ReduceOp::min);
+  gr.Add("nk_max", nk, ReduceOp::max);
+  gr.Start();
+  gr.Finish();
+  nk_min = static_cast<int>(gr.Result("nk_min"));
+  nk_max = static_cast<int>(gr.Result("nk_max"));
+  if (nk_min == nk_max) {
+    MPI_Allreduce(MPI_IN_PLACE, data.data(), 3*nk, MPI_DOUBLE, MPI_SUM,
+                  global_variable::athena_comm);
+    nranks = global_variable::nranks;
+  } else if (global_variable::my_rank == 0) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Timed kernels differ between ranks, reporting rank 0 only" << std::endl;
+  }
+#endif
+  if (global_variable::my_rank != 0) return;
+
+  bool roofline = (peak_bw > 0.0 && peak_flops > 0.0);
+  std::ofstream file(fname, std::ios::trunc);
+  if (!(file.is_open())) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Kernel report file '" << fname << "' could not be opened" << std::endl;
+    return;
+  }
+  file << "# peak_bandwidth(GB/s) = " << peak_bw << "  peak_gflops = " << peak_flops
+       << std::endl;
+  file << "# kernel  ncalls  time(s)  GB  GFLOP  AI(FLOP/byte)  GB/s  GFLOP/s";
+  if (roofline) {file << "  roofline(GFLOP/s)  fraction";}
+  file << std::endl;
+  if (print) {
+    std::cout << std::endl << "Achieved rates of timed kernels, per device:" << std::endl;
+  }
+  for (int n=0; n<nk; ++n) {
+    // time per device is mean over ranks, so rates are per device
+    double time = data[3*n]/nranks;
+    double gb = 1.0e-9*data[3*n + 1], gflop = 1.0e-9*data[3*n + 2];
+    double ai = (gb > 0.0)? gflop/gb : 0.0;
+    double bw = (time > 0.0)? gb/(nranks*time) : 0.0;
+    double fr = (time > 0.0)? gflop/(nranks*time) : 0.0;
+    double roof = std::min(peak_flops, ai*peak_bw);
+    file << order_[n] << " " << kernels_[order_[n]].ncalls << std::scientific
+         << std::setprecision(6) << " " << time << " " << gb << " " << gflop << " " << ai
+         << " " << bw << " " << fr;
+    if (roofline) {file << " " << roof << " " << ((roof > 0.0)? fr/roof : 0.0);}
+    file << std::defaultfloat << std::endl;
+    if (print) {
+      std::cout << "  " << std::left << std::setw(24) << order_[n] << std::right
+                << std::fixed << std::setprecision(2) << " AI=" << std::setw(7) << ai
+                << " GB/s=" << std::setw(9) << bw << " GFLOP/s=" << std::setw(9) << fr;
+      if (roofline) {
+        std::cout << " roofline=" << std::setw(6) << 100.0*fr/std::max(roof, 1.0e-30)
+                  << "%";
+      }
+      std::cout << std::defaultfloat << std::endl;
+    }
+  }
+  return;
+}
@@ -0,0 +1,71 @@
+#ifndef UTILS_KERNEL_COUNTERS_HPP_
+#define UTILS_KERNEL_COUNTERS_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file kernel_counters.hpp
+//! \brief defines KernelCounters class, which accumulates the measured time of named
+//! kernels together with static estimates (provided by each kernel) of the bytes moved
+//! and floating-point operations performed per cell.  The report gives the achieved
+//! bandwidth and FLOP rate of each kernel, and the fraction of the roofline of the device
+//! (set by <time>/peak_bandwidth and <time>/peak_gflops) that this represents.
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+
+#include "athena.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \class KernelCounters
+
+class KernelCounters {
+ public:
+  KernelCounters() = default;
+  ~KernelCounters() = default;
+
+  bool enabled = false;     // kernels are only timed when true (<time>/roofline)
+  double peak_bw = 0.0;     // peak memory bandwidth of device (GB/s)
+  double peak_flops = 0.0;  // peak floating-point rate of device (GFLOP/s)
+
+  // functions
+  void Start(const std::string &name, double ncells, double bytes_per_cell,
+             double flops_per_cell);
+  void Stop();
+  void WriteReport(const std::string &fname, bool print);
+
+ private:
+  struct Kernel {
+    double time = 0.0;   // accumulated wall-clock time (s)
+    double bytes = 0.0;  // accumulated estimate of bytes moved
+    double flops = 0.0;  // accumulated estimate of floating-point operations
+    int ncalls = 0;      // number of times kernel was launched
+  };
+  std::vector<std::string> order_;         // names of kernels in order first launched
+  std::map<std::string, Kernel> kernels_;  // data for each kernel, keyed by name
+  std::string current_;                    // name of currently timed kernel
+  double start_ = 0.0;                     // start time of current kernel
+  Kokkos::Timer clock_;                    // clock used to time all kernels
+};
+
+//----------------------------------------------------------------------------------------
+//! \fn double ReconstructionFlops()
+//! \brief Rough number of FLOPs to reconstruct both interface states of one variable at
+//! one face, used in estimates passed to KernelCounters by flux kernels
+
+inline double ReconstructionFlops(ReconstructionMethod recon) {
+  switch (recon) {
+    case ReconstructionMethod::dc:    return 0.0;
+    case ReconstructionMethod::plm:   return 20.0;
+    case ReconstructionMethod::ppm4:  return 60.0;
+    case ReconstructionMethod::ppmx:  return 90.0;
+    case ReconstructionMethod::wenoz: return 120.0;
+    default: return 0.0;
+  }
+}
+
+#endif // UTILS_KERNEL_COUNTERS_HPP_
@@ -0,0 +1,173 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file launch_tuning.cpp
+//! \brief functions to read, calibrate, and write the team size and vector length used
+//! by each named par_for_outer kernel.
+//!
+//! Tuning is controlled by the <launch_tuning> block in the input file:
+//!   file      = name of file of tuned values (read if it exists, written if calibrating)
+//!   calibrate = true to search for the fastest parameters for every kernel not in file
+//!   ntrials   = number of timed launches of each candidate (minimum time is used)
+//! During calibration, successive launches of each kernel cycle through the candidates,
+//! so every launch still executes exactly once on real data. Once all candidates have
+//! been timed the fastest is used for the rest of the run. Each kernel is tuned
+//! independently on each rank, and the values found on rank 0 are written to the file.
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "utils/utils.hpp"
+
+namespace launch_tuning {
+
+bool active = false;
+
+namespace {
+struct KernelEntry {
+  LaunchParams best;
+  bool tuned = false;  // true when best is final (read from file or calibrated)
+  int icand = 0;       // index of candidate being timed
+  int itrial = 0;      // number of trials of this candidate
+  double cand_time = std::numeric_limits<double>::max();  // min time of candidate
+  double best_time = std::numeric_limits<double>::max();  // min time of best
+};
+
+bool calibrate = false;
+int ntrials = 3;
+std::string tune_file;
+std::vector<LaunchParams> candidates;
+std::map<std::string, KernelEntry> kernels;
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn LaunchParams GetParams()
+//! \brief Returns launch parameters to be used for the next launch of kernel 'name', and
+//! sets calibrating=true if this launch is to be timed.
+
+LaunchParams GetParams(const std::string &name, bool &calibrating) {
+  auto it = kernels.find(name);
+  if (it == kernels.end()) {
+    if (!calibrate) {
+      calibrating = false;
+      return LaunchParams{0, 0};
+    }
+    it = kernels.emplace(name, KernelEntry()).first;
+    it->second.best = candidates[0];
+  }
+  KernelEntry &kern = it->second;
+  calibrating = !kern.tuned;
+  return (kern.tuned)? kern.best : candidates[kern.icand];
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void RecordTime()
+//! \brief Records time of one launch of kernel 'name' with the current candidate.  A
+//! negative time indicates the candidate cannot be launched, and it is skipped.
+
+void RecordTime(const std::string &name, double time) {
+  KernelEntry &kern = kernels[name];
+  if (time >= 0.0) {
+    kern.cand_time = std::min(kern.cand_time, time);
+    kern.itrial++;
+    if (kern.itrial < ntrials) return;
+    if (kern.cand_time < kern.best_time) {
+      kern.best_time = kern.cand_time;
+      kern.best = candidates[kern.icand];
+    }
+  }
+  // move to next candidate
+  kern.icand++;
+  kern.itrial = 0;
+  kern.cand_time = std::numeric_limits<double>::max();
+  if (kern.icand == static_cast<int>(candidates.size())) {kern.tuned = true;}
+  return;
+}
+
+} // namespace launch_tuning
+
+//----------------------------------------------------------------------------------------
+//! \fn void InitLaunchTuning()
+//! \brief Reads <launch_tuning> block and file of tuned values, and sets candidates.
+
+void InitLaunchTuning(ParameterInput *pin) {
+  using namespace launch_tuning;  // NOLINT(build/namespaces)
+  if (!pin->DoesBlockExist("launch_tuning")) return;
+  tune_file = pin->GetOrAddString("launch_tuning", "file", "athena_launch.tune");
+  calibrate = pin->GetOrAddBoolean("launch_tuning", "calibrate", false);
+  ntrials = pin->GetOrAddInteger("launch_tuning", "ntrials", 3);
+  if (ntrials < 1) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "<launch_tuning>/ntrials must be > 0" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
+  // read tuned values from file, one kernel per line: team vector name
+  // (name is rest of line, since it may contain spaces)
+  std::ifstream infile(tune_file);
+  std::string line;
+  while (std::getline(infile, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream iss(line);
+    LaunchParams lp;
+    std::string name;
+    if (!(iss >> lp.team_size >> lp.vector_length)) continue;
+    std::getline(iss >> std::ws, name);
+    if (name.empty()) continue;
+    KernelEntry &kern = kernels[name];
+    kern.best = lp;
+    kern.tuned = true;
+  }
+
+  if (calibrate) {
+    // first candidate must be the default, which can always be launched
+    const int team_sizes[] = {0, 32, 64, 128, 256, 512};
+    const int vector_lengths[] = {0, 1, 2, 4, 8, 16, 32, 64};
+    for (int vl : vector_lengths) {
+      for (int ts : team_sizes) {
+        candidates.push_back(LaunchParams{ts, vl});
+      }
+    }
+  }
+  active = calibrate || !kernels.empty();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void FinalizeLaunchTuning()
+//! \brief Writes tuned values to file (from rank 0) at end of a calibration run.
+
+void FinalizeLaunchTuning() {
+  using namespace launch_tuning;  // NOLINT(build/namespaces)
+  if (!calibrate || global_variable::my_rank != 0) return;
+
+  std::ofstream outfile(tune_file);
+  if (!outfile) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Cannot open launch tuning file '" << tune_file << "'" << std::endl;
+    return;
+  }
+  outfile << "# team_size vector_length kernel (0 = AUTO)" << std::endl;
+  int ntuned = 0;
+  for (auto &it : kernels) {
+    if (!it.second.tuned) continue;
+    auto &lp = it.second.best;
+    outfile << lp.team_size << " " << lp.vector_length << " " << it.first << std::endl;
+    ntuned++;
+  }
+  std::cout << std::endl << "Launch parameters for " << ntuned << " kernels written to '"
+            << tune_file << "'" << std::endl;
+  return;
+}
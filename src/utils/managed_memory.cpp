@@ -0,0 +1,93 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file managed_memory.cpp
+//! \brief functions of ManagedMemory class.  Advice and prefetches are only hints to the
+//! driver, so errors returned by them are ignored.
+
+#include <iostream>
+#include <map>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "managed_memory.hpp"
+
+#if defined(KOKKOS_ENABLE_CUDA)
+#include <cuda_runtime.h>
+#elif defined(KOKKOS_ENABLE_HIP)
+#include <hip/hip_runtime.h>
+#endif
+
+bool ManagedMemory::enabled_ = false;
+std::map<const void*, Kokkos::View<char*, ManagedMemSpace>> ManagedMemory::owners_;
+
+//----------------------------------------------------------------------------------------
+//! \fn void ManagedMemory::Enable()
+//! \brief Enables allocation of arrays in managed memory with Realloc().  Only has an
+//! effect with CUDA or HIP backends, otherwise a warning is printed.
+
+void ManagedMemory::Enable() {
+#if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP)
+  enabled_ = true;
+#else
+  if (global_variable::my_rank == 0) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<job>/managed_memory only has an effect with CUDA or HIP backends"
+              << std::endl;
+  }
+#endif
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ManagedMemory::Finalize()
+//! \brief Frees all managed memory.  Must be called after the objects holding arrays
+//! allocated with Realloc() are deleted, and before Kokkos::finalize().
+
+void ManagedMemory::Finalize() {
+  owners_.clear();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ManagedMemory::Advise()
+//! \brief Advises driver that the nbytes at p are accessed by this device, so pages
+//! resident in host memory are mapped (rather than faulted back) when evicted.
+
+void ManagedMemory::Advise(void *p, const std::size_t nbytes) {
+#if defined(KOKKOS_ENABLE_CUDA)
+  int dev;
+  if (cudaGetDevice(&dev) == cudaSuccess) {
+    (void) cudaMemAdvise(p, nbytes, cudaMemAdviseSetAccessedBy, dev);
+  }
+#elif defined(KOKKOS_ENABLE_HIP)
+  int dev;
+  if (hipGetDevice(&dev) == hipSuccess) {
+    (void) hipMemAdvise(p, nbytes, hipMemAdviseSetAccessedBy, dev);
+  }
+#endif
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ManagedMemory::PrefetchBytes()
+//! \brief Migrates the nbytes at p to the device (or host) asynchronously on the stream
+//! of the default execution space, so kernels launched later on it wait for the copy.
+//! Arrays that were not allocated with Realloc() are skipped.
+
+void ManagedMemory::PrefetchBytes(const void *p, const std::size_t nbytes,
+                                  const bool to_device) {
+  if (owners_.find(p) == owners_.end()) return;
+#if defined(KOKKOS_ENABLE_CUDA)
+  int dev = cudaCpuDeviceId;
+  if (to_device && cudaGetDevice(&dev) != cudaSuccess) return;
+  (void) cudaMemPrefetchAsync(p, nbytes, dev, DevExeSpace().cuda_stream());
+#elif defined(KOKKOS_ENABLE_HIP)
+  int dev = hipCpuDeviceId;
+  if (to_device && hipGetDevice(&dev) != hipSuccess) return;
+  (void) hipMemPrefetchAsync(p, nbytes, dev, DevExeSpace().hip_stream());
+#endif
+  return;
+}
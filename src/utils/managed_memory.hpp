@@ -0,0 +1,75 @@
+#ifndef UTILS_MANAGED_MEMORY_HPP_
+#define UTILS_MANAGED_MEMORY_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file managed_memory.hpp
+//! \brief defines ManagedMemory class, which allocates large but rarely used arrays
+//! (coarse arrays with SMR/AMR, constraints and Weyl scalars of z4c, tetrads of
+//! radiation) in unified (managed) memory on GPU backends.  With
+//! <job>/managed_memory=true the driver can then evict their pages to host memory when
+//! the device is oversubscribed (e.g. after a burst of refinement), so the run slows down
+//! instead of failing with an out-of-memory error.  Arrays are advised to be accessed by
+//! the device, and are prefetched to the device before the tasks that use them with
+//! Prefetch().  Arrays are allocated as usual on host backends, or if not enabled.
+
+#include <map>
+
+#include "athena.hpp"
+
+#if defined(KOKKOS_ENABLE_CUDA)
+using ManagedMemSpace = Kokkos::CudaUVMSpace;
+#elif defined(KOKKOS_ENABLE_HIP)
+using ManagedMemSpace = Kokkos::HIPManagedSpace;
+#else
+using ManagedMemSpace = DevMemSpace;
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \class ManagedMemory
+
+class ManagedMemory {
+ public:
+  // functions
+  static void Enable();
+  static bool Enabled() {return enabled_;}
+  static void Finalize();
+
+  // reallocate array of any rank (e.g. DvceArray5D), in managed memory if enabled
+  template <typename ViewType, typename... Dims>
+  static void Realloc(ViewType &a, const Dims... dims) {
+    if (!(enabled_)) {
+      Kokkos::realloc(a, dims...);
+      return;
+    }
+    using T = typename ViewType::value_type;
+    Release(a.data());
+    std::size_t n = 1;
+    for (std::size_t d : {static_cast<std::size_t>(dims)...}) {n *= d;}
+    // owner is zero-initialized by Kokkos, a is an unmanaged View of the same type
+    Kokkos::View<char*, ManagedMemSpace> owner(a.label().empty()? "managed" : a.label(),
+                                               n*sizeof(T));
+    Advise(owner.data(), owner.size());
+    owners_[owner.data()] = owner;
+    a = ViewType(reinterpret_cast<T*>(owner.data()), dims...);
+  }
+
+  // migrate pages of array to device (or host), if it is in managed memory
+  template <typename ViewType>
+  static void Prefetch(const ViewType &a, const bool to_device = true) {
+    if (!(enabled_) || a.data() == nullptr) return;
+    PrefetchBytes(a.data(), a.span()*sizeof(typename ViewType::value_type), to_device);
+  }
+
+ private:
+  static bool enabled_;
+  static std::map<const void*, Kokkos::View<char*, ManagedMemSpace>> owners_;
+
+  static void Release(const void *p) {owners_.erase(p);}
+  static void Advise(void *p, const std::size_t nbytes);
+  static void PrefetchBytes(const void *p, const std::size_t nbytes, const bool to_dev);
+};
+
+#endif // UTILS_MANAGED_MEMORY_HPP_
@@ -0,0 +1,153 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file memory_registry.cpp
+//! \brief functions of MemoryRegistry class.  Only allocations in the memory space of
+//! DvceArrays are counted (with host-only builds this includes HostArrays and mirrors).
+//! Allocations made while no tag is open are charged to the tag "other".
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "global_reductions.hpp"
+#include "memory_registry.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+bool MemoryRegistry::enabled_ = false;
+std::vector<std::string> MemoryRegistry::stack_;
+std::vector<std::string> MemoryRegistry::order_;
+std::map<std::string, MemoryRegistry::Usage> MemoryRegistry::usage_;
+MemoryRegistry::Usage MemoryRegistry::total_;
+std::map<const void*, std::pair<std::string, uint64_t>> MemoryRegistry::allocs_;
+Kokkos::Tools::Experimental::EventSet MemoryRegistry::prev_;
+
+//----------------------------------------------------------------------------------------
+//! \fn void MemoryRegistry::Enable()
+//! \brief Sets Kokkos Tools callbacks so that all later allocations are tracked.  Must be
+//! called after Kokkos::initialize() (which sets callbacks of any Kokkos tool loaded).
+
+void MemoryRegistry::Enable() {
+  if (enabled_) return;
+  prev_ = Kokkos::Tools::Experimental::get_callbacks();
+  Kokkos::Tools::Experimental::set_allocate_data_callback(&MemoryRegistry::Allocate);
+  Kokkos::Tools::Experimental::set_deallocate_data_callback(&MemoryRegistry::Deallocate);
+  enabled_ = true;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MemoryRegistry::PushTag()
+//! \brief Opens new tag nested within the current one
+
+void MemoryRegistry::PushTag(const std::string &name) {
+  if (!(enabled_)) return;
+  stack_.push_back((stack_.empty())? name : (stack_.back() + "/" + name));
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MemoryRegistry::PopTag()
+//! \brief Closes current tag
+
+void MemoryRegistry::PopTag() {
+  if (!(enabled_) || stack_.empty()) return;
+  stack_.pop_back();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MemoryRegistry::Allocate()
+//! \brief Kokkos Tools callback: charges allocation to the current tag
+
+void MemoryRegistry::Allocate(const Kokkos::Tools::SpaceHandle space, const char *label,
+                              const void *ptr, const uint64_t size) {
+  if (prev_.allocate_data != nullptr) {prev_.allocate_data(space, label, ptr, size);}
+  if (std::strcmp(space.name, DevMemSpace::name()) != 0) return;
+  std::string tag = (stack_.empty())? "other" : stack_.back();
+  if (usage_.find(tag) == usage_.end()) {order_.push_back(tag);}
+  Usage &u = usage_[tag];
+  u.current += static_cast<int64_t>(size);
+  u.peak = std::max(u.peak, u.current);
+  total_.current += static_cast<int64_t>(size);
+  total_.peak = std::max(total_.peak, total_.current);
+  allocs_[ptr] = std::make_pair(tag, size);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MemoryRegistry::Deallocate()
+//! \brief Kokkos Tools callback: returns memory to the tag the allocation was charged to
+
+void MemoryRegistry::Deallocate(const Kokkos::Tools::SpaceHandle space, const char *label,
+                                const void *ptr, const uint64_t size) {
+  if (prev_.deallocate_data != nullptr) {prev_.deallocate_data(space, label, ptr, size);}
+  auto it = allocs_.find(ptr);
+  if (it == allocs_.end()) return;
+  usage_[it->second.first].current -= static_cast<int64_t>(it->second.second);
+  total_.current -= static_cast<int64_t>(it->second.second);
+  allocs_.erase(it);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MemoryRegistry::Report()
+//! \brief Prints current and peak device memory (MB) charged to each tag, as the maximum
+//! over all MPI ranks, with the label 'when' (e.g. "startup", "after AMR").  Must be
+//! called by all ranks.  If ranks charged memory to different sets of tags, only the
+//! usage on rank 0 is reported.
+
+void MemoryRegistry::Report(const std::string &when) {
+  if (!(enabled_)) return;
+  int ntag = static_cast<int>(order_.size());
+  std::vector<double> mb(2*(ntag + 1));
+  for (int n=0; n<ntag; ++n) {
+    mb[2*n    ] = usage_[order_[n]].current/1.048576e6;
+    mb[2*n + 1] = usage_[order_[n]].peak/1.048576e6;
+  }
+  mb[2*ntag    ] = total_.current/1.048576e6;
+  mb[2*ntag + 1] = total_.peak/1.048576e6;
+  int nranks = 1;
+#if MPI_PARALLEL_ENABLED
+  int ntag_min = ntag, ntag_max = ntag;
+  GlobalReductions gr;
+  gr.Add("ntag_min", ntag, ReduceOp::min);
+  gr.Add("ntag_max", ntag, ReduceOp::max);
+  gr.Start();
+  gr.Finish();
+  ntag_min = static_cast<int>(gr.Result("ntag_min"));
+  ntag_max = static_cast<int>(gr.Result("ntag_max"));
+  if (ntag_min == ntag_max) {
+    MPI_Allreduce(MPI_IN_PLACE, mb.data(), 2*(ntag + 1), MPI_DOUBLE, MPI_MAX,
+                  global_variable::athena_comm);
+    nranks = global_variable::nranks;
+  } else if (global_variable::my_rank == 0) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Memory tags differ between ranks, reporting rank 0 only" << std::endl;
+  }
+#endif
+  if (global_variable::my_rank != 0) return;
+
+  std::cout << std::endl << "Device memory (MB) " << when << ", max over " << nranks
+            << " rank(s):" << std::endl;
+  std::cout << "  " << std::left << std::setw(32) << "tag" << std::right
+            << std::setw(12) << "current" << std::setw(12) << "peak" << std::endl;
+  for (int n=0; n<=ntag; ++n) {
+    std::cout << "  " << std::left << std::setw(32) << ((n < ntag)? order_[n] : "total")
+              << std::right << std::fixed << std::setprecision(2) << std::setw(12)
+              << mb[2*n] << std::setw(12) << mb[2*n + 1] << std::defaultfloat
+              << std::endl;
+  }
+  return;
+}
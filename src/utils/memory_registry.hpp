@@ -0,0 +1,60 @@
+#ifndef UTILS_MEMORY_REGISTRY_HPP_
+#define UTILS_MEMORY_REGISTRY_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file memory_registry.hpp
+//! \brief defines MemoryRegistry class, which tracks the current and peak size of all
+//! Kokkos allocations in device memory, grouped by tag.  Tags are nested like the
+//! RegionTimers: code that allocates memory for a module (e.g. its constructor) opens a
+//! tag with the name of the module, and every View allocated until the tag is closed is
+//! charged to it (and not to enclosing tags).  Memory is returned to the tag it was
+//! charged to when the View is freed.
+//! Allocations are intercepted with the Kokkos Tools allocate/deallocate callbacks, which
+//! are chained to any callbacks already set by a Kokkos tool.  All members are static,
+//! since the callbacks cannot carry state.
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+
+//----------------------------------------------------------------------------------------
+//! \class MemoryRegistry
+
+class MemoryRegistry {
+ public:
+  // functions
+  static void Enable();
+  static bool Enabled() {return enabled_;}
+  static int64_t CurrentBytes() {return total_.current;}
+  static int64_t PeakBytes() {return total_.peak;}
+  static void PushTag(const std::string &name);
+  static void PopTag();
+  static void Report(const std::string &when);
+
+ private:
+  struct Usage {
+    int64_t current = 0;   // bytes currently allocated
+    int64_t peak = 0;      // high-water mark of bytes allocated
+  };
+  static bool enabled_;
+  static std::vector<std::string> stack_;              // full names of open tags
+  static std::vector<std::string> order_;              // tags in order first charged
+  static std::map<std::string, Usage> usage_;          // usage of each tag
+  static Usage total_;                                 // usage summed over all tags
+  static std::map<const void*, std::pair<std::string, uint64_t>> allocs_;  // live Views
+  static Kokkos::Tools::Experimental::EventSet prev_;  // callbacks set by Kokkos tools
+
+  static void Allocate(const Kokkos::Tools::SpaceHandle space, const char *label,
+                       const void *ptr, const uint64_t size);
+  static void Deallocate(const Kokkos::Tools::SpaceHandle space, const char *label,
+                         const void *ptr, const uint64_t size);
+};
+
+#endif // UTILS_MEMORY_REGISTRY_HPP_
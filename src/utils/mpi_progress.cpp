@@ -0,0 +1,64 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file mpi_progress.cpp
+//! \brief functions of MPIProgressThread class
+
+#include <chrono>
+#include <thread>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "mpi_progress.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \fn void MPIProgressThread::Start()
+//! \brief Launches progress thread, which polls MPI every interval_us microseconds
+
+void MPIProgressThread::Start(const int interval_us) {
+  if (run_.load()) return;
+  interval_us_ = interval_us;
+  run_.store(true);
+  thread_ = std::thread(&MPIProgressThread::Loop, this);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MPIProgressThread::Stop()
+//! \brief Stops progress thread and waits for it to exit.  Must be called before
+//! MPI_Finalize().
+
+void MPIProgressThread::Stop() {
+  if (!(run_.load())) return;
+  run_.store(false);
+  if (thread_.joinable()) {thread_.join();}
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MPIProgressThread::Loop()
+//! \brief Body of progress thread.  MPI_Iprobe is used since it is cheap, never receives
+//! a message, and drives the progress engine of the library for all communicators.
+
+void MPIProgressThread::Loop() {
+  while (run_.load()) {
+#if MPI_PARALLEL_ENABLED
+    int flag;
+    MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, global_variable::athena_comm, &flag,
+               MPI_STATUS_IGNORE);
+#endif
+    npoll_++;
+    if (interval_us_ > 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(interval_us_));
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  return;
+}
@@ -0,0 +1,46 @@
+#ifndef UTILS_MPI_PROGRESS_HPP_
+#define UTILS_MPI_PROGRESS_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file mpi_progress.hpp
+//! \brief defines MPIProgressThread class, a background thread that repeatedly enters
+//! the MPI library so that non-blocking sends and receives (boundary values, fluxes, AMR
+//! and load balancing data) keep progressing while the main thread is busy launching
+//! kernels, waiting on a fence, or writing outputs.  Many MPI implementations only make
+//! progress inside MPI calls, so without this thread transfers stall between the
+//! MPI_Test calls of the receive tasks.  Requires MPI_THREAD_MULTIPLE.
+//!
+//! The thread does not test any requests itself (requests may not be tested concurrently
+//! by two threads), so receive tasks still complete through their own MPI_Test, which
+//! then finds the transfer already finished.
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+//----------------------------------------------------------------------------------------
+//! \class MPIProgressThread
+
+class MPIProgressThread {
+ public:
+  MPIProgressThread() : run_(false), interval_us_(0), npoll_(0) {}
+  ~MPIProgressThread() {Stop();}
+
+  // functions
+  void Start(const int interval_us);
+  void Stop();
+  bool Running() const {return run_.load();}
+  std::uint64_t NumPolls() const {return npoll_.load();}
+
+ private:
+  std::thread thread_;
+  std::atomic<bool> run_;
+  int interval_us_;                   // sleep between polls (0 = yield only)
+  std::atomic<std::uint64_t> npoll_;  // number of polls made by thread
+  void Loop();
+};
+
+#endif // UTILS_MPI_PROGRESS_HPP_
@@ -0,0 +1,144 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file nccl_channel.cpp
+//! \brief functions of NcclChannel class
+
+#include <cstdlib>
+#include <iostream>
+
+#include "athena.hpp"
+#include "nccl_channel.hpp"
+
+#if NCCL_ENABLED
+namespace {
+#if SINGLE_PRECISION_ENABLED
+constexpr ncclDataType_t kNcclReal = ncclFloat;
+#else
+constexpr ncclDataType_t kNcclReal = ncclDouble;
+#endif
+
+// exits on errors in NCCL, CUDA, or HIP functions
+void NcclCheck(bool ok, const char *func) {
+  if (!(ok)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << func << " failed in NCCL boundary exchange" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+}
+
+GpuStream_t StreamOf(const DevExeSpace &exec_space) {
+#if defined(KOKKOS_ENABLE_CUDA)
+  return exec_space.cuda_stream();
+#else
+  return exec_space.hip_stream();
+#endif
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void NcclChannel::Init()
+//! \brief Creates NCCL communicator over all ranks of comm (collective), and the stream
+//! and events of the channel
+
+void NcclChannel::Init(MPI_Comm comm) {
+  if (active_) return;
+  int rank, nranks;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &nranks);
+  ncclUniqueId id;
+  if (rank == 0) {NcclCheck(ncclGetUniqueId(&id) == ncclSuccess, "ncclGetUniqueId");}
+  MPI_Bcast(&id, sizeof(id), MPI_BYTE, 0, comm);
+  NcclCheck(ncclCommInitRank(&comm_, nranks, id, rank) == ncclSuccess,
+            "ncclCommInitRank");
+#if defined(KOKKOS_ENABLE_CUDA)
+  NcclCheck(cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking) == cudaSuccess &&
+            cudaEventCreateWithFlags(&ready_, cudaEventDisableTiming) == cudaSuccess &&
+            cudaEventCreateWithFlags(&done_, cudaEventDisableTiming) == cudaSuccess,
+            "cudaStreamCreate");
+#else
+  NcclCheck(hipStreamCreateWithFlags(&stream_, hipStreamNonBlocking) == hipSuccess &&
+            hipEventCreateWithFlags(&ready_, hipEventDisableTiming) == hipSuccess &&
+            hipEventCreateWithFlags(&done_, hipEventDisableTiming) == hipSuccess,
+            "hipStreamCreate");
+#endif
+  active_ = true;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void NcclChannel::Free()
+//! \brief Destroys NCCL communicator, stream, and events
+
+void NcclChannel::Free() {
+  if (!(active_)) return;
+  ncclCommDestroy(comm_);
+#if defined(KOKKOS_ENABLE_CUDA)
+  cudaEventDestroy(ready_);
+  cudaEventDestroy(done_);
+  cudaStreamDestroy(stream_);
+#else
+  hipEventDestroy(ready_);
+  hipEventDestroy(done_);
+  hipStreamDestroy(stream_);
+#endif
+  active_ = false;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void NcclChannel::Start()
+//! \brief Makes channel stream wait for work launched on exec_space, and starts group
+
+void NcclChannel::Start(const DevExeSpace &exec_space) {
+#if defined(KOKKOS_ENABLE_CUDA)
+  NcclCheck(cudaEventRecord(ready_, StreamOf(exec_space)) == cudaSuccess &&
+            cudaStreamWaitEvent(stream_, ready_, 0) == cudaSuccess, "cudaEventRecord");
+#else
+  NcclCheck(hipEventRecord(ready_, StreamOf(exec_space)) == hipSuccess &&
+            hipStreamWaitEvent(stream_, ready_, 0) == hipSuccess, "hipEventRecord");
+#endif
+  NcclCheck(ncclGroupStart() == ncclSuccess, "ncclGroupStart");
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void NcclChannel::Send()
+//! \brief Adds send of n Reals in device memory to rank to current group
+
+void NcclChannel::Send(const Real *data, int n, int rank) {
+  NcclCheck(ncclSend(data, n, kNcclReal, rank, comm_, stream_) == ncclSuccess,
+            "ncclSend");
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void NcclChannel::Recv()
+//! \brief Adds receive of n Reals in device memory from rank to current group
+
+void NcclChannel::Recv(Real *data, int n, int rank) {
+  NcclCheck(ncclRecv(data, n, kNcclReal, rank, comm_, stream_) == ncclSuccess,
+            "ncclRecv");
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void NcclChannel::Finish()
+//! \brief Ends group, and makes work launched afterwards on exec_space wait for it
+
+void NcclChannel::Finish(const DevExeSpace &exec_space) {
+  NcclCheck(ncclGroupEnd() == ncclSuccess, "ncclGroupEnd");
+#if defined(KOKKOS_ENABLE_CUDA)
+  NcclCheck(cudaEventRecord(done_, stream_) == cudaSuccess &&
+            cudaStreamWaitEvent(StreamOf(exec_space), done_, 0) == cudaSuccess,
+            "cudaStreamWaitEvent");
+#else
+  NcclCheck(hipEventRecord(done_, stream_) == hipSuccess &&
+            hipStreamWaitEvent(StreamOf(exec_space), done_, 0) == hipSuccess,
+            "hipStreamWaitEvent");
+#endif
+  return;
+}
+#endif // NCCL_ENABLED
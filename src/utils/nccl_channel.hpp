@@ -0,0 +1,61 @@
+#ifndef UTILS_NCCL_CHANNEL_HPP_
+#define UTILS_NCCL_CHANNEL_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file nccl_channel.hpp
+//! \brief defines NcclChannel class, an NCCL (or RCCL) communicator with its own device
+//! stream, used to send coalesced boundary messages device-to-device (enabled with
+//! <mesh>/nccl=true, and compiled with -D Athena_ENABLE_NCCL=ON).
+//!
+//! All sends and receives of one exchange are issued between Start() and Finish() as
+//! one NCCL group.  The group runs on the stream of the channel, after all work already
+//! launched on the given execution space, and work launched on that execution space
+//! afterwards waits for the group.  So no fence is needed before the messages are sent
+//! or after they are received.  Each channel has its own stream so that exchanges of
+//! different channels cannot block each other, whatever order they are issued in.
+
+#include "athena.hpp"
+
+#if NCCL_ENABLED
+#include <mpi.h>
+
+#if defined(KOKKOS_ENABLE_CUDA)
+#include <cuda_runtime.h>
+#include <nccl.h>
+using GpuStream_t = cudaStream_t;
+using GpuEvent_t = cudaEvent_t;
+#else
+#include <hip/hip_runtime.h>
+#include <rccl/rccl.h>
+using GpuStream_t = hipStream_t;
+using GpuEvent_t = hipEvent_t;
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \class NcclChannel
+
+class NcclChannel {
+ public:
+  NcclChannel() = default;
+  ~NcclChannel() {Free();}
+
+  // functions
+  void Init(MPI_Comm comm);
+  void Free();
+  void Start(const DevExeSpace &exec_space);
+  void Send(const Real *data, int n, int rank);
+  void Recv(Real *data, int n, int rank);
+  void Finish(const DevExeSpace &exec_space);
+
+ private:
+  bool active_ = false;
+  ncclComm_t comm_;
+  GpuStream_t stream_;
+  GpuEvent_t ready_, done_;  // end of work before and of group on channel stream
+};
+#endif // NCCL_ENABLED
+
+#endif // UTILS_NCCL_CHANNEL_HPP_
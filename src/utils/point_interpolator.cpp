@@ -0,0 +1,217 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file point_interpolator.cpp
+//! \brief Implements PointInterpolator class.  Points are located with the MeshLocator,
+//! interpolation weights are computed and all variables at all points are interpolated
+//! in single kernels, and values are combined over ranks with a single reduction.
+
+#include <cmath>
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "coordinates/cell_locations.hpp"
+#include "mesh/mesh.hpp"
+#include "mesh/mesh_locator.hpp"
+#include "point_interpolator.hpp"
+
+//----------------------------------------------------------------------------------------
+// constructor, allocates arrays for npts points (coordinates must be set by the caller
+// followed by a call to SetPoints())
+
+PointInterpolator::PointInterpolator(MeshBlockPack *ppack, int npts) :
+    npoints(npts),
+    coords("interp_coords",1,1),
+    vals("interp_vals",1,1),
+    nowners("interp_nowners",1),
+    version(-1),
+    pmy_pack(ppack),
+    indcs("interp_indcs",1,1),
+    wghts("interp_wghts",1,1,1) {
+  int &ng = pmy_pack->pmesh->mb_indcs.ng;
+  Kokkos::realloc(coords,npoints,3);
+  Kokkos::realloc(vals,npoints,1);
+  Kokkos::realloc(nowners,npoints);
+  Kokkos::realloc(indcs,npoints,4);
+  Kokkos::realloc(wghts,npoints,2*ng,3);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void PointInterpolator::SetPoints
+//! \brief Finds the MeshBlock containing each point with the MeshLocator on the device,
+//! and if that MeshBlock is on this rank stores it and the index of the cell containing
+//! the point.  Then computes Lagrange weights on the device.  If coords_on_device, the
+//! coordinates were set in coords.d_view by a kernel and are not copied from the host.
+
+void PointInterpolator::SetPoints(bool coords_on_device) {
+  Mesh *pm = pmy_pack->pmesh;
+  auto &size = pmy_pack->pmb->mb_size;
+  MeshLocator mloc = *(pm->Locator());
+
+  if (!(coords_on_device)) {
+    coords.template modify<HostMemSpace>();
+    coords.template sync<DevExeSpace>();
+  }
+  auto &coords_ = coords;
+  auto &indcs_ = indcs;
+  par_for("interp_locate",DevExeSpace(),0,npoints-1,
+  KOKKOS_LAMBDA(int n) {
+    // indices default to -1 if point does not reside in this MeshBlockPack
+    for (int i=0; i<4; ++i) {indcs_.d_view(n,i) = -1;}
+    Real x1 = coords_.d_view(n,0);
+    Real x2 = coords_.d_view(n,1);
+    Real x3 = coords_.d_view(n,2);
+    int tgid = mloc.FindGID(x1, x2, x3);
+    if (tgid < 0) return;
+    int m = mloc.LocalIndex(tgid);
+    if (m < 0) return;
+
+    indcs_.d_view(n,0) = m;
+    indcs_.d_view(n,1) = static_cast<int>(floor((x1 - (size.d_view(m).x1min +
+                                          size.d_view(m).dx1/2.0))/size.d_view(m).dx1));
+    indcs_.d_view(n,2) = static_cast<int>(floor((x2 - (size.d_view(m).x2min +
+                                          size.d_view(m).dx2/2.0))/size.d_view(m).dx2));
+    indcs_.d_view(n,3) = static_cast<int>(floor((x3 - (size.d_view(m).x3min +
+                                          size.d_view(m).dx3/2.0))/size.d_view(m).dx3));
+  });
+  indcs.template modify<DevExeSpace>();
+  indcs.template sync<HostMemSpace>();
+
+  // compute Lagrange weights for all points on the device
+  auto &mbi = pm->mb_indcs;
+  int ng = mbi.ng;
+  int nmx1 = mbi.nx1, nmx2 = mbi.nx2, nmx3 = mbi.nx3;
+  auto &size_ = size;
+  auto &wghts_ = wghts;
+  par_for("interp_wghts",DevExeSpace(),0,npoints-1,0,2*ng-1,
+  KOKKOS_LAMBDA(int n, int i) {
+    int ii0 = indcs_.d_view(n,0);
+    if (ii0 == -1) {  // point not on this rank
+      wghts_.d_view(n,i,0) = 0.0;
+      wghts_.d_view(n,i,1) = 0.0;
+      wghts_.d_view(n,i,2) = 0.0;
+      return;
+    }
+    int ii1 = indcs_.d_view(n,1);
+    int ii2 = indcs_.d_view(n,2);
+    int ii3 = indcs_.d_view(n,3);
+    Real &x1min = size_.d_view(ii0).x1min;
+    Real &x1max = size_.d_view(ii0).x1max;
+    Real &x2min = size_.d_view(ii0).x2min;
+    Real &x2max = size_.d_view(ii0).x2max;
+    Real &x3min = size_.d_view(ii0).x3min;
+    Real &x3max = size_.d_view(ii0).x3max;
+    Real w1 = 1.0, w2 = 1.0, w3 = 1.0;
+    for (int j=0; j<2*ng; ++j) {
+      if (j != i) {
+        Real x1vpi1 = CellCenterX(ii1-ng+i+1, nmx1, x1min, x1max);
+        Real x1vpj1 = CellCenterX(ii1-ng+j+1, nmx1, x1min, x1max);
+        w1 *= (coords_.d_view(n,0)-x1vpj1)/(x1vpi1-x1vpj1);
+        Real x2vpi1 = CellCenterX(ii2-ng+i+1, nmx2, x2min, x2max);
+        Real x2vpj1 = CellCenterX(ii2-ng+j+1, nmx2, x2min, x2max);
+        w2 *= (coords_.d_view(n,1)-x2vpj1)/(x2vpi1-x2vpj1);
+        Real x3vpi1 = CellCenterX(ii3-ng+i+1, nmx3, x3min, x3max);
+        Real x3vpj1 = CellCenterX(ii3-ng+j+1, nmx3, x3min, x3max);
+        w3 *= (coords_.d_view(n,2)-x3vpj1)/(x3vpi1-x3vpj1);
+      }
+    }
+    wghts_.d_view(n,i,0) = w1;
+    wghts_.d_view(n,i,1) = w2;
+    wghts_.d_view(n,i,2) = w3;
+  });
+  // weights are only used on the device, so are not copied to host
+  wghts.template modify<DevExeSpace>();
+  version = pm->mesh_version;
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void PointInterpolator::Interpolate
+//! \brief interpolate variables [vs,vs+nvars) of val to all points in one kernel, and
+//! copy results to host
+
+void PointInterpolator::Interpolate(int nvars, DvceArray5D<Real> &val, int vs) {
+  auto &mbi = pmy_pack->pmesh->mb_indcs;
+  int is = mbi.is, js = mbi.js, ks = mbi.ks;
+  int ng = mbi.ng;
+
+  // reallocate container
+  if (vals.extent_int(1) != nvars) {
+    Kokkos::realloc(vals,npoints,nvars);
+  }
+
+  auto &indcs_ = indcs;
+  auto &wghts_ = wghts;
+  auto &vals_ = vals;
+  par_for("interp_pts",DevExeSpace(),0,npoints-1,0,nvars-1,
+  KOKKOS_LAMBDA(int n, int v) {
+    int ii0 = indcs_.d_view(n,0);
+    int ii1 = indcs_.d_view(n,1);
+    int ii2 = indcs_.d_view(n,2);
+    int ii3 = indcs_.d_view(n,3);
+
+    if (ii0==-1) {  // point not on this rank
+      vals_.d_view(n,v) = 0.0;
+    } else {
+      Real int_value = 0.0;
+      for (int i=0; i<2*ng; i++) {
+        for (int j=0; j<2*ng; j++) {
+          for (int k=0; k<2*ng; k++) {
+            Real iwght = wghts_.d_view(n,i,0)*wghts_.d_view(n,j,1)*wghts_.d_view(n,k,2);
+            int_value += iwght*val(ii0,vs+v,ii3-(ng-k-ks)+1,ii2-(ng-j-js)+1,
+                                   ii1-(ng-i-is)+1);
+          }
+        }
+      }
+      vals_.d_view(n,v) = int_value;
+    }
+  });
+
+  // sync dual arrays
+  vals.template modify<DevExeSpace>();
+  vals.template sync<HostMemSpace>();
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void PointInterpolator::ReduceValues
+//! \brief Sums values at all points over ranks with a single reduction, together with
+//! the number of ranks owning each point.  Since points are located in the global
+//! MeshBlockTree, each point is owned by exactly one rank if it is on the mesh, and by
+//! none (nowners = 0, values of zero) otherwise.
+
+void PointInterpolator::ReduceValues() {
+  int nvars = vals.extent_int(1);
+  for (int n=0; n<npoints; ++n) {
+    nowners(n) = (indcs.h_view(n,0) >= 0)? 1.0 : 0.0;
+  }
+#if MPI_PARALLEL_ENABLED
+  HostArray1D<Real> buf("interp_buf", npoints*(nvars + 1));
+  for (int n=0; n<npoints; ++n) {
+    for (int v=0; v<nvars; ++v) {
+      buf(n*(nvars + 1) + v) = vals.h_view(n,v);
+    }
+    buf(n*(nvars + 1) + nvars) = nowners(n);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, buf.data(), npoints*(nvars + 1), MPI_ATHENA_REAL, MPI_SUM,
+                global_variable::athena_comm);
+  for (int n=0; n<npoints; ++n) {
+    nowners(n) = buf(n*(nvars + 1) + nvars);
+    for (int v=0; v<nvars; ++v) {
+      vals.h_view(n,v) = buf(n*(nvars + 1) + v);
+    }
+  }
+#endif
+  vals.template modify<HostMemSpace>();
+  vals.template sync<DevExeSpace>();
+
+  return;
+}
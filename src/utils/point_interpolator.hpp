@@ -0,0 +1,51 @@
+#ifndef UTILS_POINT_INTERPOLATOR_HPP_
+#define UTILS_POINT_INTERPOLATOR_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file point_interpolator.hpp
+//! \brief definitions for PointInterpolator class, which interpolates cell-centered data
+//! to a batch of arbitrary points with Lagrange polynomials.  Used by SphericalGrid (wave
+//! extraction, flux diagnostics) and the puncture trackers.
+
+#include "athena.hpp"
+
+// Forward declarations
+class MeshBlockPack;
+
+//----------------------------------------------------------------------------------------
+//! \class PointInterpolator
+
+class PointInterpolator {
+ public:
+  PointInterpolator(MeshBlockPack *ppack, int npts);
+  ~PointInterpolator() = default;
+
+  int npoints;                 // number of points
+  DualArray2D<Real> coords;    // (npoints,3) Cartesian coordinates of points
+  DualArray2D<Real> vals;      // (npoints,nvars) interpolated values
+  HostArray1D<Real> nowners;   // number of ranks owning each point, set by ReduceValues
+
+  int version;                 // Mesh::mesh_version when points were last located
+
+  // locate points set in coords.h_view (or in coords.d_view if coords_on_device) and
+  // compute interpolation weights.  Must be called again whenever the points move or
+  // the mesh is refined (version differs from Mesh::mesh_version).
+  void SetPoints(bool coords_on_device = false);
+  // interpolate variables [vs,vs+nvars) of val to all points owned by this rank, values
+  // at points not owned by this rank are zero
+  void Interpolate(int nvars, DvceArray5D<Real> &val, int vs = 0);
+  // sum values over all ranks, so that every rank holds values at all points on host
+  void ReduceValues();
+  // true if point n resides in a MeshBlock on this rank
+  bool IsOwned(int n) const {return (indcs.h_view(n,0) >= 0);}
+
+ private:
+  MeshBlockPack* pmy_pack;     // ptr to MeshBlockPack containing this interpolator
+  DualArray2D<int> indcs;      // (npoints,4) MeshBlock and cell indices for interp
+  DualArray3D<Real> wghts;     // (npoints,2*ng,3) Lagrange weights in each direction
+};
+
+#endif // UTILS_POINT_INTERPOLATOR_HPP_
@@ -0,0 +1,238 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file power_manager.cpp
+//! \brief functions of PowerManager class
+
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "power_manager.hpp"
+
+#if POWER_CONTROL_ENABLED
+#if defined(KOKKOS_ENABLE_CUDA)
+#include <cuda_runtime.h>
+#else
+#include <hip/hip_runtime.h>
+#endif
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \fn void PowerManager::Init()
+//! \brief Reads <time> parameters, and initializes NVML or ROCm SMI for the device used
+//! by this rank.  Records the energy counter and power limit of the device, so the
+//! energy used by the run can be measured and the power limit restored at the end.
+
+void PowerManager::Init(ParameterInput *pin) {
+  control = pin->GetOrAddBoolean("time", "power_control", false);
+  requested = control || pin->GetOrAddBoolean("time", "power_report", false);
+  if (!(requested)) return;
+  std::stringstream ss(pin->GetOrAddString("time", "power_low_regions",
+                                           "outputs,new_timestep"));
+  std::string s;
+  while (std::getline(ss, s, ',')) {
+    s.erase(0, s.find_first_not_of(" \t"));
+    s.erase(s.find_last_not_of(" \t") + 1);
+    if (!(s.empty())) {low_regions_.push_back(s);}
+  }
+  sm_clock_ = static_cast<unsigned int>(pin->GetOrAddInteger("time", "power_sm_clock",
+                                                             0));
+  low_cap_ = pin->GetOrAddReal("time", "power_low_cap", 0.0);
+
+#if POWER_CONTROL_ENABLED
+#if defined(KOKKOS_ENABLE_CUDA)
+  // NVML device with the PCI bus id of the current CUDA device (indices may differ)
+  char busid[32];
+  int cuda_dev;
+  active_ = (nvmlInit() == NVML_SUCCESS) && (cudaGetDevice(&cuda_dev) == cudaSuccess) &&
+            (cudaDeviceGetPCIBusId(busid, sizeof(busid), cuda_dev) == cudaSuccess) &&
+            (nvmlDeviceGetHandleByPciBusId(busid, &dev_) == NVML_SUCCESS);
+  if (active_) {
+    unsigned int mw;
+    if (nvmlDeviceGetPowerManagementLimit(dev_, &mw) == NVML_SUCCESS) {
+      cap0_ = 1.0e-3*mw;
+    }
+    // lowest SM clock supported at the current memory clock (list is descending)
+    unsigned int mem_clock, nclk = 128, clks[128];
+    if (control && sm_clock_ == 0 &&
+        nvmlDeviceGetClockInfo(dev_, NVML_CLOCK_MEM, &mem_clock) == NVML_SUCCESS &&
+        nvmlDeviceGetSupportedGraphicsClocks(dev_, mem_clock, &nclk, clks) ==
+        NVML_SUCCESS && nclk > 0) {
+      sm_clock_ = clks[nclk-1];
+    }
+  }
+#else
+  // ROCm SMI device with the PCI bus/device of the current HIP device
+  int hip_dev;
+  hipDeviceProp_t prop;
+  uint32_t ndev = 0;
+  active_ = (rsmi_init(0) == RSMI_STATUS_SUCCESS) &&
+            (hipGetDevice(&hip_dev) == hipSuccess) &&
+            (hipGetDeviceProperties(&prop, hip_dev) == hipSuccess) &&
+            (rsmi_num_monitor_devices(&ndev) == RSMI_STATUS_SUCCESS);
+  if (active_) {
+    uint64_t target = (static_cast<uint64_t>(prop.pciDomainID) << 32) |
+                      ((static_cast<uint64_t>(prop.pciBusID) & 0xff) << 8) |
+                      ((static_cast<uint64_t>(prop.pciDeviceID) & 0x1f) << 3);
+    bool found = false;
+    for (uint32_t d=0; d<ndev && !(found); ++d) {
+      uint64_t bdfid;
+      if (rsmi_dev_pci_id_get(d, &bdfid) == RSMI_STATUS_SUCCESS &&
+          (bdfid & ~static_cast<uint64_t>(0x7)) == target) {
+        dev_ = d;
+        found = true;
+      }
+    }
+    active_ = found;
+  }
+  if (active_) {
+    uint64_t uw;
+    if (rsmi_dev_power_cap_get(dev_, 0, &uw) == RSMI_STATUS_SUCCESS) {cap0_ = 1.0e-6*uw;}
+  }
+#endif
+#endif
+
+  if (!(active_)) {
+    if (global_variable::my_rank == 0) {
+      std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+#if POWER_CONTROL_ENABLED
+                << "Device could not be accessed with NVML/ROCm SMI, "
+#else
+                << "Code must be compiled with -D Athena_ENABLE_POWER=ON, "
+#endif
+                << "<time>/power_control and power_report ignored" << std::endl;
+    }
+    control = false;
+    return;
+  }
+  energy0_ = EnergyCounter();
+  clock_.reset();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void PowerManager::EnterRegion()
+//! \brief Called by RegionTimers after the device is fenced, each time the innermost open
+//! region changes to the region with the given full name ("" when none are open).
+//! Switches the device to the low state if the region, or any region enclosing it, is
+//! listed in <time>/power_low_regions, and to full clocks otherwise.
+
+void PowerManager::EnterRegion(const std::string &full) {
+  if (!(control)) return;
+  bool low = false;
+  std::stringstream ss(full);
+  std::string s;
+  while (!(low) && std::getline(ss, s, '/')) {
+    for (auto &r : low_regions_) {
+      if (s == r) {low = true;}
+    }
+  }
+  if (low == low_) return;
+  if (!(SetLow(low))) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Device clocks or power limit could not be changed on rank "
+              << global_variable::my_rank << " (administrator rights may be required), "
+              << "power control disabled" << std::endl;
+    SetLow(false);
+    control = false;
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool PowerManager::SetLow()
+//! \brief Switches device to low (or full) clocks and power limit.  Returns false if the
+//! library call failed.
+
+bool PowerManager::SetLow(bool low) {
+  bool ok = true;
+#if POWER_CONTROL_ENABLED
+#if defined(KOKKOS_ENABLE_CUDA)
+  if (low) {
+    ok = (nvmlDeviceSetGpuLockedClocks(dev_, sm_clock_, sm_clock_) == NVML_SUCCESS);
+  } else {
+    ok = (nvmlDeviceResetGpuLockedClocks(dev_) == NVML_SUCCESS);
+  }
+  if (ok && low_cap_ > 0.0 && cap0_ > 0.0) {
+    double cap = (low)? low_cap_ : cap0_;
+    ok = (nvmlDeviceSetPowerManagementLimit(dev_, static_cast<unsigned int>(1.0e3*cap))
+          == NVML_SUCCESS);
+  }
+#else
+  ok = (rsmi_dev_perf_level_set(dev_, (low)? RSMI_DEV_PERF_LEVEL_LOW :
+                                RSMI_DEV_PERF_LEVEL_AUTO) == RSMI_STATUS_SUCCESS);
+  if (ok && low_cap_ > 0.0 && cap0_ > 0.0) {
+    double cap = (low)? low_cap_ : cap0_;
+    ok = (rsmi_dev_power_cap_set(dev_, 0, static_cast<uint64_t>(1.0e6*cap)) ==
+          RSMI_STATUS_SUCCESS);
+  }
+#endif
+#endif
+  if (low && !(low_)) {
+    nswitch_++;
+    low_start_ = clock_.seconds();
+  } else if (!(low) && low_) {
+    low_time_ += clock_.seconds() - low_start_;
+  }
+  low_ = low;
+  return ok;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn double PowerManager::EnergyCounter()
+//! \brief Returns energy counter of device (J), or 0 if it cannot be read
+
+double PowerManager::EnergyCounter() {
+  double e = 0.0;
+#if POWER_CONTROL_ENABLED
+#if defined(KOKKOS_ENABLE_CUDA)
+  unsigned long long mj;  // NOLINT(runtime/int)
+  if (nvmlDeviceGetTotalEnergyConsumption(dev_, &mj) == NVML_SUCCESS) {e = 1.0e-3*mj;}
+#else
+  uint64_t count, tstamp;
+  float res;
+  if (rsmi_dev_energy_count_get(dev_, &count, &res, &tstamp) == RSMI_STATUS_SUCCESS) {
+    e = 1.0e-6*static_cast<double>(count)*res;
+  }
+#endif
+#endif
+  return e;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn double PowerManager::Energy()
+//! \brief Returns energy (J) used by device of this rank since Init(), or 0 if it is
+//! not measured
+
+double PowerManager::Energy() {
+  if (!(active_)) return 0.0;
+  return EnergyCounter() - energy0_;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void PowerManager::Restore()
+//! \brief Returns device to full clocks and its original power limit, and shuts down the
+//! library.  Called at the end of the run, and by the destructor.
+
+void PowerManager::Restore() {
+  if (!(active_)) return;
+  if (low_) {SetLow(false);}
+  control = false;
+#if POWER_CONTROL_ENABLED
+#if defined(KOKKOS_ENABLE_CUDA)
+  nvmlShutdown();
+#else
+  rsmi_shut_down();
+#endif
+#endif
+  active_ = false;
+  return;
+}
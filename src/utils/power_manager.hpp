@@ -0,0 +1,82 @@
+#ifndef UTILS_POWER_MANAGER_HPP_
+#define UTILS_POWER_MANAGER_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file power_manager.hpp
+//! \brief defines PowerManager class, which measures the energy used by the GPU of each
+//! rank, and optionally lowers its clocks (or power cap) in phases of the cycle that
+//! leave the GPU mostly idle or are limited by memory bandwidth (enabled with
+//! <time>/power_control=true, and compiled with -D Athena_ENABLE_POWER=ON).
+//!
+//! Phases are the named regions of RegionTimers: the GPU is switched to the low state
+//! when a region listed in <time>/power_low_regions (or a region nested in one) is
+//! entered, and back to full clocks when it is left.  Regions are fenced on entry and
+//! exit, so the switch happens at the phase boundary on the device.  With NVML (CUDA) the
+//! SM clock is locked to <time>/power_sm_clock MHz (default the lowest supported), with
+//! ROCm SMI (HIP) the lowest performance level is used.  With <time>/power_low_cap > 0
+//! the power limit (W) is also lowered in the low state.  Changing clocks and power
+//! limits usually requires administrator rights, otherwise control is disabled with a
+//! warning and only the energy is measured.  Settings apply to the whole device, so one
+//! MPI rank per GPU is assumed.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "parameter_input.hpp"
+
+#if POWER_CONTROL_ENABLED
+#if defined(KOKKOS_ENABLE_CUDA)
+#include <nvml.h>
+#else
+#include <rocm_smi/rocm_smi.h>
+#endif
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \class PowerManager
+
+class PowerManager {
+ public:
+  PowerManager() = default;
+  ~PowerManager() {Restore();}
+
+  bool requested = false;   // energy measured (<time>/power_control or power_report)
+  bool control = false;     // clocks switched between phases
+
+  // functions
+  void Init(ParameterInput *pin);
+  void EnterRegion(const std::string &full);
+  double Energy();              // energy (J) used by device since Init()
+  double LowTime() const {return low_time_;}
+  int NSwitch() const {return nswitch_;}
+  void Restore();
+
+ private:
+  bool active_ = false;         // device management library initialized
+  bool low_ = false;            // device currently in low state
+  int nswitch_ = 0;             // number of switches to low state
+  double low_time_ = 0.0;       // wall-clock time spent in low state (s)
+  double low_start_ = 0.0;
+  double energy0_ = 0.0;        // energy counter of device at Init() (J)
+  std::vector<std::string> low_regions_;
+  unsigned int sm_clock_ = 0;   // SM clock (MHz) in low state
+  double low_cap_ = 0.0;        // power limit (W) in low state, 0 = unchanged
+  double cap0_ = 0.0;           // power limit (W) of device at Init()
+  Kokkos::Timer clock_;
+  bool SetLow(bool low);
+  double EnergyCounter();
+#if POWER_CONTROL_ENABLED
+#if defined(KOKKOS_ENABLE_CUDA)
+  nvmlDevice_t dev_;
+#else
+  uint32_t dev_ = 0;
+#endif
+#endif
+};
+
+#endif // UTILS_POWER_MANAGER_HPP_
@@ -8,6 +8,8 @@
 //! \file random.cpp
 //  \brief Random number generators (that can be included in Kokkos parallel for regions)
 
+#include <cstdint>
+
 #include "athena.hpp"
 
 //----------------------------------------------------------------------------------------
@@ -189,4 +191,64 @@ static Real RanGaussian(int64_t *idum) {
   }
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn Philox4x32
+//! \brief Counter-based RNG Philox4x32-10 of Salmon et al., "Parallel random numbers: as
+//! easy as 1, 2, 3" (SC11).  Encrypts the 128-bit counter ctr with the 64-bit key, so
+//! each random number is a pure function of (key, counter).  Unlike the generators above
+//! there is no state, so any number of threads on the device can draw independent
+//! deviates in parallel, and results do not depend on the number of threads or ranks, or
+//! on the order in which they are drawn.
+
+KOKKOS_INLINE_FUNCTION
+void Philox4x32(uint32_t ctr[4], uint32_t key0, uint32_t key1) {
+  for (int r=0; r<10; ++r) {
+    uint64_t p0 = static_cast<uint64_t>(0xD2511F53u)*ctr[0];
+    uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u)*ctr[2];
+    uint32_t c0 = static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key0;
+    uint32_t c2 = static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key1;
+    ctr[1] = static_cast<uint32_t>(p1);
+    ctr[3] = static_cast<uint32_t>(p0);
+    ctr[0] = c0;
+    ctr[2] = c2;
+    key0 += 0x9E3779B9u;
+    key1 += 0xBB67AE85u;
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn RanCounter, RanGaussianCounter
+//! \brief Uniform deviate in (0,1), and Gaussian deviate with zero mean and unit
+//! variance, for the given seed, stream (e.g. the cycle number), and counter (e.g. the
+//! index of the deviate within the stream), using Philox4x32.
+
+KOKKOS_INLINE_FUNCTION
+Real RanCounter(const int64_t seed, const int64_t stream, const int64_t counter) {
+  uint32_t ctr[4] = {static_cast<uint32_t>(counter),
+                     static_cast<uint32_t>(static_cast<uint64_t>(counter) >> 32),
+                     static_cast<uint32_t>(stream),
+                     static_cast<uint32_t>(static_cast<uint64_t>(stream) >> 32)};
+  Philox4x32(ctr, static_cast<uint32_t>(seed),
+             static_cast<uint32_t>(static_cast<uint64_t>(seed) >> 32));
+  // 53 random bits, offset by half a unit so endpoint values cannot occur
+  uint64_t x = ((static_cast<uint64_t>(ctr[0]) << 32) | ctr[1]) >> 11;
+  return (static_cast<double>(x) + 0.5)*(1.0/9007199254740992.0);
+}
+
+KOKKOS_INLINE_FUNCTION
+Real RanGaussianCounter(const int64_t seed, const int64_t stream, const int64_t counter) {
+  uint32_t ctr[4] = {static_cast<uint32_t>(counter),
+                     static_cast<uint32_t>(static_cast<uint64_t>(counter) >> 32),
+                     static_cast<uint32_t>(stream),
+                     static_cast<uint32_t>(static_cast<uint64_t>(stream) >> 32)};
+  Philox4x32(ctr, static_cast<uint32_t>(seed),
+             static_cast<uint32_t>(static_cast<uint64_t>(seed) >> 32));
+  // Box-Muller transform of two uniform deviates in (0,1)
+  uint64_t x1 = ((static_cast<uint64_t>(ctr[0]) << 32) | ctr[1]) >> 11;
+  uint64_t x2 = ((static_cast<uint64_t>(ctr[2]) << 32) | ctr[3]) >> 11;
+  double u1 = (static_cast<double>(x1) + 0.5)*(1.0/9007199254740992.0);
+  double u2 = (static_cast<double>(x2) + 0.5)*(1.0/9007199254740992.0);
+  return sqrt(-2.0*log(u1))*cos(2.0*M_PI*u2);
+}
+
 #endif // UTILS_RANDOM_HPP_
@@ -0,0 +1,145 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file region_timers.cpp
+//! \brief functions of RegionTimers class.  Regions are nested: the full name of each
+//! region is the name of the enclosing region followed by "/" and its own name.  The
+//! device is fenced when each region starts and stops, so that the time of kernels
+//! launched inside a region is attributed to it.  Reports list the minimum, mean, and
+//! maximum over all MPI ranks of the time spent in each region.
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "global_reductions.hpp"
+#include "power_manager.hpp"
+#include "region_timers.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \fn void RegionTimers::Start()
+//! \brief Opens new region nested within the current one
+
+void RegionTimers::Start(const std::string &name) {
+  if (!(enabled)) return;
+  std::string full = (stack_.empty())? name : (stack_.back() + "/" + name);
+  Kokkos::fence();
+  Kokkos::Profiling::pushRegion(full);
+  if (regions_.find(full) == regions_.end()) {order_.push_back(full);}
+  regions_[full].ncalls++;
+  stack_.push_back(full);
+  start_.push_back(clock_.seconds());
+  if (ppower != nullptr) {ppower->EnterRegion(full);}
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void RegionTimers::Stop()
+//! \brief Closes current region, and adds time since it was opened
+
+void RegionTimers::Stop() {
+  if (!(enabled) || stack_.empty()) return;
+  Kokkos::fence();
+  regions_[stack_.back()].time += clock_.seconds() - start_.back();
+  Kokkos::Profiling::popRegion();
+  stack_.pop_back();
+  start_.pop_back();
+  if (ppower != nullptr) {ppower->EnterRegion((stack_.empty())? "" : stack_.back());}
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void RegionTimers::Set()
+//! \brief Sets total time and calls of region with given full name, from values
+//! accumulated elsewhere (e.g. the time of each Task measured by a TaskList)
+
+void RegionTimers::Set(const std::string &name, double time, int ncalls) {
+  if (!(enabled)) return;
+  if (regions_.find(name) == regions_.end()) {order_.push_back(name);}
+  regions_[name].time = time;
+  regions_[name].ncalls = ncalls;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void RegionTimers::WriteReport()
+//! \brief Computes min/mean/max over ranks of time in each region, and on rank 0 writes
+//! them to file 'fname' (appended if append=true), and optionally prints them to stdout.
+//! The file has one line per region with columns: cycle, name, ncalls, min, mean, max.
+//! Must be called by all ranks.  If ranks recorded different sets of regions, only
+//! the times on rank 0 are reported.
+
+void RegionTimers::WriteReport(const std::string &fname, int ncycle, bool append,
+                               bool print) {
+  if (!(enabled)) return;
+  int nreg = static_cast<int>(order_.size());
+  std::vector<double> tmin(nreg), tmax(nreg), tsum(nreg);
+  for (int n=0; n<nreg; ++n) {
+    tmin[n] = regions_[order_[n]].time;
+    tmax[n] = tmin[n];
+    tsum[n] = tmin[n];
+  }
+  int nranks = 1;
+#if MPI_PARALLEL_ENABLED
+  int nreg_min = nreg, nreg_max = nreg;
+  GlobalReductions gr;
+  gr.Add("nreg_min", nreg, ReduceOp::min);
+  gr.Add("nreg_max", nreg, ReduceOp::max);
+  gr.Start();
+  gr.Finish();
+  nreg_min = static_cast<int>(gr.Result("nreg_min"));
+  nreg_max = static_cast<int>(gr.Result("nreg_max"));
+  if (nreg_min == nreg_max) {
+    MPI_Allreduce(MPI_IN_PLACE, tmin.data(), nreg, MPI_DOUBLE, MPI_MIN,
+                  global_variable::athena_comm);
+    MPI_Allreduce(MPI_IN_PLACE, tmax.data(), nreg, MPI_DOUBLE, MPI_MAX,
+                  global_variable::athena_comm);
+    MPI_Allreduce(MPI_IN_PLACE, tsum.data(), nreg, MPI_DOUBLE, MPI_SUM,
+                  global_variable::athena_comm);
+    nranks = global_variable::nranks;
+  } else if (global_variable::my_rank == 0) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Timed regions differ between ranks, reporting rank 0 only" << std::endl;
+  }
+#endif
+  if (global_variable::my_rank != 0) return;
+
+  std::ofstream file(fname, (append)? std::ios::app : std::ios::trunc);
+  if (!(file.is_open())) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Timing report file '" << fname << "' could not be opened" << std::endl;
+  } else {
+    if (!(append)) {
+      file << "# cycle  region  ncalls  min(s)  mean(s)  max(s)" << std::endl;
+    }
+    for (int n=0; n<nreg; ++n) {
+      file << ncycle << " " << order_[n] << " " << regions_[order_[n]].ncalls << " "
+           << std::scientific << std::setprecision(6) << tmin[n] << " "
+           << tsum[n]/nranks << " " << tmax[n] << std::defaultfloat << std::endl;
+    }
+  }
+
+  if (print) {
+    std::cout << std::endl << "Time (s) spent in each region, min/mean/max over "
+              << nranks << " rank(s):" << std::endl;
+    for (int n=0; n<nreg; ++n) {
+      std::cout << "  " << std::left << std::setw(48) << order_[n] << std::right
+                << std::scientific << std::setprecision(3) << std::setw(11) << tmin[n]
+                << std::setw(11) << tsum[n]/nranks << std::setw(11) << tmax[n]
+                << std::defaultfloat << std::endl;
+    }
+  }
+  return;
+}
@@ -0,0 +1,51 @@
+#ifndef UTILS_REGION_TIMERS_HPP_
+#define UTILS_REGION_TIMERS_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file region_timers.hpp
+//! \brief defines RegionTimers class, which accumulates wall-clock time spent in named,
+//! nested regions of the code (e.g. each TaskList, outputs, AMR).  Each region is also
+//! registered with Kokkos::Profiling, so it appears in external profiling tools, and
+//! passed to the PowerManager (if set), which uses regions as phases of the cycle.
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+
+class PowerManager;
+
+//----------------------------------------------------------------------------------------
+//! \class RegionTimers
+
+class RegionTimers {
+ public:
+  RegionTimers() = default;
+  ~RegionTimers() = default;
+
+  bool enabled = false;   // regions are only timed when true
+  PowerManager *ppower = nullptr;   // notified when innermost open region changes
+
+  // functions
+  void Start(const std::string &name);
+  void Stop();
+  void Set(const std::string &name, double time, int ncalls);
+  void WriteReport(const std::string &fname, int ncycle, bool append, bool print);
+
+ private:
+  struct Region {
+    double time = 0.0;   // accumulated wall-clock time (s)
+    int ncalls = 0;      // number of times region was entered
+  };
+  std::vector<std::string> order_;        // full names of regions in order first entered
+  std::map<std::string, Region> regions_; // data for each region, keyed by full name
+  std::vector<std::string> stack_;        // full names of currently open regions
+  std::vector<double> start_;             // start time of each open region
+  Kokkos::Timer clock_;                   // clock used to time all regions
+};
+
+#endif // UTILS_REGION_TIMERS_HPP_
@@ -0,0 +1,133 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file scratch_pool.cpp
+//! \brief functions of ScratchPool and ScratchArray classes
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "memory_registry.hpp"
+#include "scratch_pool.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+// checkouts are rounded up to a multiple of this number of Reals, so that each starts on
+// a 256-byte boundary of the arena
+static constexpr std::size_t kScratchAlign = 32;
+
+//----------------------------------------------------------------------------------------
+// ScratchArray move constructor and assignment: the checkout is transferred, so only the
+// destination returns it to the pool
+
+ScratchArray::ScratchArray(ScratchArray &&other) noexcept :
+  view(other.view), pool_(other.pool_), slot_(other.slot_), size_(other.size_) {
+  other.pool_ = nullptr;
+}
+
+ScratchArray &ScratchArray::operator=(ScratchArray &&other) noexcept {
+  if (this != &other) {
+    Release();
+    view = other.view;
+    pool_ = other.pool_;
+    slot_ = other.slot_;
+    size_ = other.size_;
+    other.pool_ = nullptr;
+  }
+  return *this;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ScratchArray::Release()
+//! \brief Returns checkout to the pool (if not already returned)
+
+void ScratchArray::Release() {
+  if (pool_ == nullptr) return;
+  view = DvceArray5D<Real>();
+  pool_->Release(slot_, size_);
+  pool_ = nullptr;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn ScratchArray ScratchPool::Checkout()
+//! \brief Returns array with dims (n0,n1,n2,n3,n4) in the arena, or allocated separately
+//! (with the given label) if it does not fit.  Contents are not initialized.
+
+ScratchArray ScratchPool::Checkout(const std::string &label, const int n0, const int n1,
+                                   const int n2, const int n3, const int n4) {
+  std::size_t n = static_cast<std::size_t>(n0)*static_cast<std::size_t>(n1)*
+                  static_cast<std::size_t>(n2)*static_cast<std::size_t>(n3)*
+                  static_cast<std::size_t>(n4);
+  std::size_t size = ((n + kScratchAlign - 1)/kScratchAlign)*kScratchAlign;
+  live_ += size;
+  peak_ = std::max(peak_, live_);
+
+  // enlarge arena to peak size of live checkouts when none are live.  Kernels using
+  // released checkouts may still be running, so fence before the arena is freed.
+  if (slots_.empty() && peak_ > static_cast<std::size_t>(arena_.extent(0))) {
+    Kokkos::fence();
+    MemoryRegistry::PushTag("scratch");
+    Kokkos::realloc(arena_, peak_);
+    MemoryRegistry::PopTag();
+  }
+
+  if (top_ + size <= static_cast<std::size_t>(arena_.extent(0))) {
+    slots_.push_back({top_, size, true});
+    DvceArray5D<Real> v(arena_.data() + top_, n0, n1, n2, n3, n4);
+    top_ += size;
+    return ScratchArray(this, static_cast<int>(slots_.size()) - 1, size, v);
+  }
+  noverflow_++;
+  MemoryRegistry::PushTag("scratch");
+  DvceArray5D<Real> v(label, n0, n1, n2, n3, n4);
+  MemoryRegistry::PopTag();
+  return ScratchArray(this, -1, size, v);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ScratchPool::Release()
+//! \brief Marks checkout as released, and frees the top of the arena above the last live
+//! checkout
+
+void ScratchPool::Release(const int slot, const std::size_t size) {
+  live_ -= size;
+  if (slot < 0) return;
+  slots_[slot].live = false;
+  while (!(slots_.empty()) && !(slots_.back().live)) {slots_.pop_back();}
+  top_ = (slots_.empty())? 0 : (slots_.back().offset + slots_.back().size);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ScratchPool::Report()
+//! \brief Prints peak size of live checkouts and size of arena (maximum over all MPI
+//! ranks), and number of checkouts allocated separately (summed over ranks), with the
+//! label 'when'.  Must be called by all ranks.
+
+void ScratchPool::Report(const std::string &when) {
+  if (!(report_)) return;
+  double mb[2] = {peak_*sizeof(Real)/1.048576e6,
+                  arena_.extent(0)*sizeof(Real)/1.048576e6};
+  int nover = noverflow_;
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, mb, 2, MPI_DOUBLE, MPI_MAX, global_variable::athena_comm);
+  MPI_Allreduce(MPI_IN_PLACE, &nover, 1, MPI_INT, MPI_SUM, global_variable::athena_comm);
+#endif
+  if (global_variable::my_rank != 0) return;
+
+  std::cout << std::endl << "Scratch pool " << when << ", max over "
+            << global_variable::nranks << " rank(s):" << std::endl << std::fixed
+            << std::setprecision(2) << "  peak live checkouts (MB) " << mb[0] << std::endl
+            << "  arena size (MB)          " << mb[1] << std::defaultfloat << std::endl
+            << "  separate allocations     " << nover << std::endl;
+  return;
+}
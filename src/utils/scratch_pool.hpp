@@ -0,0 +1,90 @@
+#ifndef UTILS_SCRATCH_POOL_HPP_
+#define UTILS_SCRATCH_POOL_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file scratch_pool.hpp
+//! \brief defines ScratchPool class, a single device arena shared by all modules for
+//! transient arrays that are only needed within one function (e.g. the estimate of the
+//! updated conserved variables in FOFC, or the device staging arrays of outputs), rather
+//! than each module storing its own persistent array.  Arrays are checked out of the
+//! arena as ScratchArrays, and returned to it when they go out of scope.  Checkouts are
+//! stacked in the arena, so memory is only reused once all later checkouts are released.
+//!
+//! The arena grows to the peak size of live checkouts.  Since it cannot be reallocated
+//! while checkouts are live, a checkout that does not fit is instead allocated as its own
+//! View, and the arena is enlarged at the next checkout made with none live.  With
+//! <job>/scratch_report = true the peak size of live checkouts is reported at the end of
+//! the run.
+//!
+//! Kernels reading ScratchArrays must be launched in DevExeSpace(), so that kernels
+//! using the same memory after it is released are executed after them.  The pool is not
+//! thread-safe, and must only be used by the main thread.
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+
+class ScratchPool;
+
+//----------------------------------------------------------------------------------------
+//! \class ScratchArray
+//! \brief array checked out of a ScratchPool, which is returned to the pool when the
+//! ScratchArray is destroyed.  Copies of the View must not be used after that.
+
+class ScratchArray {
+ public:
+  ScratchArray() = default;
+  ScratchArray(ScratchPool *pool, const int slot, const std::size_t size,
+               DvceArray5D<Real> v) : view(v), pool_(pool), slot_(slot), size_(size) {}
+  ~ScratchArray() {Release();}
+  ScratchArray(const ScratchArray &) = delete;
+  ScratchArray &operator=(const ScratchArray &) = delete;
+  ScratchArray(ScratchArray &&other) noexcept;
+  ScratchArray &operator=(ScratchArray &&other) noexcept;
+
+  void Release();
+  DvceArray5D<Real> view;
+
+ private:
+  ScratchPool *pool_=nullptr;
+  int slot_=-1;             // index of checkout in arena, or -1 if allocated separately
+  std::size_t size_=0;      // number of Reals checked out
+};
+
+//----------------------------------------------------------------------------------------
+//! \class ScratchPool
+
+class ScratchPool {
+ public:
+  ScratchPool() : arena_("scratch_arena",0) {}
+
+  // functions
+  ScratchArray Checkout(const std::string &label, const int n0, const int n1,
+                        const int n2, const int n3, const int n4);
+  void EnableReport() {report_ = true;}
+  std::size_t PeakBytes() const {return peak_*sizeof(Real);}
+  void Report(const std::string &when);
+
+ private:
+  friend class ScratchArray;
+  struct Slot {
+    std::size_t offset;     // offset of checkout in arena
+    std::size_t size;       // number of Reals in checkout (rounded up for alignment)
+    bool live;
+  };
+  DvceArray1D<Real> arena_;
+  std::vector<Slot> slots_;        // stack of checkouts in arena
+  std::size_t top_=0;              // first free Real in arena
+  std::size_t live_=0;             // number of Reals in live checkouts
+  std::size_t peak_=0;             // high-water mark of live_
+  int noverflow_=0;                // number of checkouts allocated separately
+  bool report_=false;
+  void Release(const int slot, const std::size_t size);
+};
+
+#endif // UTILS_SCRATCH_POOL_HPP_
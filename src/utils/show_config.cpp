@@ -22,6 +22,17 @@ void ShowConfig() {
   } else {
     std::cout<<"  Floating-point precision:   double" << std::endl;
   }
+  if (MIXED_PRECISION_ENABLED) {
+    std::cout<<"  Hydro flux storage:         single" << std::endl;
+  }
+  if (RAD_MIXED_PRECISION_ENABLED) {
+    std::cout<<"  Rad intensity storage:      single" << std::endl;
+  }
+  if (FIXED_MB_NX1 > 0) {
+    std::cout<<"  Fixed MeshBlock nx1/nghost: " << FIXED_MB_NX1 << "/" << FIXED_NGHOST
+             << std::endl;
+  }
+  std::cout<<"  Scratch row SIMD width:     " << SIMD_WIDTH << std::endl;
 #if MPI_PARALLEL_ENABLED
   std::cout<<"  MPI parallelism:            ON" << std::endl;
 #else
@@ -5,27 +5,37 @@
 //========================================================================================
 //! \file tr_table.cpp
 //! \brief Implementation of Table class
+#include <cstdlib>
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <map>
 #include <vector>
 
+#include "globals.hpp"
 #include "tr_table.hpp"
 #include "tr_utils.hpp"
 
 using namespace TableReader; // NOLINT
 
-Table::Table() : ndim(0), npoints(0), mem_size(0), initialized(false) {
+Table::Table() : ndim(0), npoints(0), mem_size(0), checksum(0), initialized(false),
+                 shared(false) {
 }
 
 Table::~Table() {
   if (initialized) {
+#if MPI_PARALLEL_ENABLED
+    if (shared) {
+      MPI_Win_free(&data_win);
+      MPI_Comm_free(&node_comm);
+      return;
+    }
+#endif
     delete[] data;
   }
 }
 
-ReadResult Table::ReadTable(const std::string fname) {
+ReadResult Table::ReadTable(const std::string fname, bool node_shared) {
   ReadResult result;
 
   std::ifstream file;
@@ -125,7 +135,31 @@ ReadResult Table::ReadTable(const std::string fname) {
     mem_size += p.second;
   }
   mem_size += npoints*field_names.size();
+
+  // Only the lowest rank on each node reads the data into shared memory.
+  bool reader = true;
+#if MPI_PARALLEL_ENABLED
+  if (node_shared) {
+    MPI_Comm_split_type(global_variable::athena_comm, MPI_COMM_TYPE_SHARED, 0,
+                        MPI_INFO_NULL,
+                        &node_comm);
+    int node_rank;
+    MPI_Comm_rank(node_comm, &node_rank);
+    reader = (node_rank == 0);
+    MPI_Aint win_size = (reader) ? mem_size*sizeof(double) : 0;
+    MPI_Win_allocate_shared(win_size, sizeof(double), MPI_INFO_NULL, node_comm, &data,
+                            &data_win);
+    if (!reader) {
+      int disp_unit;
+      MPI_Win_shared_query(data_win, 0, &win_size, &disp_unit, &data);
+    }
+    shared = true;
+  } else {
+    data = new double[mem_size];
+  }
+#else
   data = new double[mem_size];
+#endif
 
   // Set the memory offsets for all the fields.
   size_t offset = 0;
@@ -140,6 +174,32 @@ ReadResult Table::ReadTable(const std::string fname) {
 
   initialized = true;
 
+  if (reader) {
+    result = ReadData(fname, header_size);
+  }
+#if MPI_PARALLEL_ENABLED
+  if (shared) {
+    // Make the data written by the reader visible to all ranks on the node.
+    MPI_Win_fence(0, data_win);
+    int error = static_cast<int>(result.error);
+    MPI_Bcast(&error, 1, MPI_INT, 0, node_comm);
+    MPI_Bcast(&checksum, 1, MPI_UINT64_T, 0, node_comm);
+    if (!reader) {
+      result.error = static_cast<ReadResult::ErrorCode>(error);
+      if (result.error != ReadResult::SUCCESS) {
+        result.message = "Reading '" + fname + "' failed on another rank of this node\n";
+      }
+    }
+  }
+#endif
+
+  return result;
+}
+
+ReadResult Table::ReadData(const std::string fname, size_t header_size) {
+  ReadResult result;
+  std::ifstream file;
+
   // Now we need to load the table memory itself. We reopen the file as a binary.
   try {
     file.open(fname.c_str(), std::ifstream::in | std::ifstream::binary);
@@ -167,6 +227,30 @@ ReadResult Table::ReadTable(const std::string fname) {
   // FIXME(JMF): This doesn't handle single precision data correctly!
   char *memblock = reinterpret_cast<char*>(data);
   file.read(memblock, mem_size*sizeof(double));
+  if (static_cast<size_t>(file.gcount()) != mem_size*sizeof(double)) {
+    file.close();
+    result.error = ReadResult::BAD_DATA;
+    std::stringstream ss;
+    ss << "'" << fname << "' is truncated: expected " << mem_size*sizeof(double)
+       << " bytes of data but read " << file.gcount() << "\n";
+    result.message = ss.str();
+    return result;
+  }
+
+  // Verify the checksum of the data as stored in the file, if one is given.
+  checksum = Checksum(memblock, mem_size*sizeof(double));
+  if (metadata.find("checksum") != metadata.end()) {
+    uint64_t expected = std::strtoull(metadata["checksum"].c_str(), nullptr, 16);
+    if (expected != checksum) {
+      file.close();
+      result.error = ReadResult::BAD_CHECKSUM;
+      std::stringstream ss;
+      ss << "Checksum of data in '" << fname << "' is " << std::hex << checksum
+         << " but header gives " << metadata["checksum"] << "\n";
+      result.message = ss.str();
+      return result;
+    }
+  }
 
   // Now we need to check for endianness.
   if ((!metadata["endianness"].compare("little") && !IsLittleEndian()) ||
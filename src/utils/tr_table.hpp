@@ -8,6 +8,7 @@
 //! \file tr_table.hpp
 //! \brief Declares Table class
 
+#include <cstdint>
 #include <string>
 #include <map>
 #include <vector>
@@ -15,13 +16,21 @@
 #include <sstream>
 #include <utility>
 
+#include "config.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
 namespace TableReader {
 
 struct ReadResult {
   enum ErrorCode {
     SUCCESS,
     BAD_FILENAME,
-    BAD_HEADER
+    BAD_HEADER,
+    BAD_DATA,
+    BAD_CHECKSUM
   };
   ErrorCode error;
   std::string message;
@@ -32,7 +41,11 @@ class Table {
   Table();
   ~Table();
 
-  ReadResult ReadTable(const std::string fname);
+  //! \brief Read a table from file. With node_shared (and MPI), the table data is
+  //! read by one rank on each node into an MPI shared-memory window that all ranks on
+  //! the node then point to, so that it is read from disk and held in host memory only
+  //! once per node. Must then be called collectively by all ranks.
+  ReadResult ReadTable(const std::string fname, bool node_shared = false);
 
   inline const std::map<std::string, std::string> GetMetadata() {
     return metadata;
@@ -78,6 +91,12 @@ class Table {
     return data;
   }
 
+  // 64-bit FNV-1a checksum of the table data as stored in the file. If the metadata
+  // contains a 'checksum' (in hexadecimal), ReadTable() fails if they do not match.
+  inline uint64_t GetChecksum() {
+    return checksum;
+  }
+
  private:
   template<typename F>
   ReadResult ParseBlock(std::string name, std::vector<std::string>& block_lines, F add) {
@@ -102,6 +121,8 @@ class Table {
   ReadResult ExtractBlock(std::ifstream& file, const std::string name,
                           std::vector<std::string>& lines);
 
+  ReadResult ReadData(const std::string fname, size_t header_size);
+
   bool SplitToken(const std::string& in, std::string& key, std::string& value);
 
   void TrimWhiteSpace(std::string& str);
@@ -115,7 +136,13 @@ class Table {
   size_t ndim;
   size_t npoints;
   size_t mem_size;
+  uint64_t checksum;
   bool initialized;
+  bool shared;          // data is stored in an MPI shared-memory window
+#if MPI_PARALLEL_ENABLED
+  MPI_Comm node_comm;   // communicator of ranks sharing the window
+  MPI_Win data_win;     // shared-memory window containing data
+#endif
 };
 
 } // namespace TableReader
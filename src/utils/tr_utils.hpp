@@ -9,6 +9,8 @@
 //! \brief Various utility functions needed by the table reader which aren't necessarily
 //!        specific to the table reader itself.
 #include <climits>
+#include <cstddef>
+#include <cstdint>
 
 namespace TableReader {
 
@@ -51,6 +53,18 @@ inline bool IsLittleEndian() {
   return *lsa == 0x01;
 }
 
+// 64-bit FNV-1a hash of a block of memory, used as a checksum of table data. Data can
+// be hashed in pieces by passing the hash of the previous piece as the seed.
+inline uint64_t Checksum(const void *mem, size_t nbytes,
+                         uint64_t hash = 14695981039346656037ULL) {
+  const unsigned char *bytes = static_cast<const unsigned char*>(mem);
+  for (size_t k = 0; k < nbytes; k++) {
+    hash ^= bytes[k];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
 } // namespace TableReader
 
 #endif // UTILS_TR_UTILS_HPP_
@@ -0,0 +1,186 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file tune_meshblock.cpp
+//! \brief selects the MeshBlock size at startup by running a short benchmark of the
+//! actual problem (same physics, pgen, and refinement) with each candidate size, and
+//! measuring the zone-cycles/second.
+//!
+//! Tuning is controlled by parameters in the <job> block of the input file:
+//!   tune_meshblock = true to run the benchmark (new runs only, not restarts)
+//!   tune_sizes     = comma-separated list of candidate sizes (default "8,16,32,64,128"),
+//!                    used for each active dimension.  The sizes in <meshblock> are also
+//!                    always tried.
+//!   tune_ncycle    = number of cycles run with each candidate (default 10)
+//!   tune_action    = "run" to continue with the fastest size, or "print" to report it
+//!                    and quit
+//! Candidates are skipped unless they are compatible with the root grid (the same checks
+//! as in the Mesh constructor), and give at least one MeshBlock per rank.  Outputs are
+//! not written during the benchmark.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "outputs/outputs.hpp"
+#include "driver/driver.hpp"
+#include "pgen/pgen.hpp"
+#include "utils/utils.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+namespace {
+//----------------------------------------------------------------------------------------
+//! \fn double RunTrial()
+//! \brief Runs ncycle cycles of problem in input stream with MeshBlocks of size nx[], and
+//! returns zone-cycles/second (the same on all ranks).
+
+double RunTrial(const std::string &input, const int nx[3], const int ncycle) {
+  std::stringstream ss(input);
+  ParameterInput *pin = new ParameterInput;
+  pin->LoadFromStream(ss);
+  pin->SetInteger("meshblock", "nx1", nx[0]);
+  pin->SetInteger("meshblock", "nx2", nx[1]);
+  pin->SetInteger("meshblock", "nx3", nx[2]);
+  pin->SetInteger("time", "nlim", ncycle);
+  pin->SetInteger("time", "ndiag", ncycle + 1);
+  pin->SetInteger("time", "telemetry_dcycle", 0);
+  pin->SetInteger("time", "profile_dcycle", 0);
+
+  Kokkos::Timer timer;
+  Mesh *pmesh = new Mesh(pin);
+  pmesh->BuildTreeFromScratch(pin);
+  pmesh->AddCoordinatesAndPhysics(pin);
+  pmesh->pgen = std::make_unique<ProblemGenerator>(pin, pmesh);
+  Driver *pdriver = new Driver(pin, pmesh, 0.0, &timer);
+  Outputs *pout = new Outputs(pin, pmesh);
+  for (auto pnode : pout->pout_list) {delete pnode;}
+  pout->pout_list.clear();
+  pdriver->Initialize(pmesh, pin, pout, false);
+
+  Kokkos::fence();
+  double t_start = timer.seconds();
+  pdriver->Execute(pmesh, pin, pout);
+  Kokkos::fence();
+  double t_run = timer.seconds() - t_start;
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, &t_run, 1, MPI_DOUBLE, MPI_MAX,
+                global_variable::athena_comm);
+#endif
+  double zcycles = static_cast<double>(pmesh->nmb_total)*
+                   static_cast<double>(pmesh->NumberOfMeshBlockCells())*
+                   static_cast<double>(pmesh->ncycle);
+
+  delete pout;
+  delete pdriver;
+  delete pmesh;
+  delete pin;
+  return (t_run > 0.0)? zcycles/t_run : 0.0;
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn bool TuneMeshBlockSize()
+//! \brief Benchmarks candidate MeshBlock sizes, and sets the fastest in <meshblock>.
+//! Returns false if the run should stop after reporting the result.
+
+bool TuneMeshBlockSize(ParameterInput *pin) {
+  int ncycle = pin->GetOrAddInteger("job", "tune_ncycle", 10);
+  std::string slist = pin->GetOrAddString("job", "tune_sizes", "8,16,32,64,128");
+  std::string action = pin->GetOrAddString("job", "tune_action", "run");
+  if (action != "run" && action != "print") {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<job>/tune_action = '" << action << "' must be 'run' or 'print'"
+              << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  // trials read a copy of the input, with tuning disabled
+  pin->SetBoolean("job", "tune_meshblock", false);
+  std::stringstream input;
+  pin->ParameterDump(input);
+
+  int mesh_nx[3], ndim = 1;
+  mesh_nx[0] = pin->GetInteger("mesh", "nx1");
+  mesh_nx[1] = pin->GetInteger("mesh", "nx2");
+  mesh_nx[2] = pin->GetInteger("mesh", "nx3");
+  if (mesh_nx[1] > 1) {ndim = (mesh_nx[2] > 1)? 3 : 2;}
+  bool multilevel = (pin->GetOrAddString("mesh_refinement", "refinement", "none")
+                     != "none");
+
+  // candidates: sizes in <meshblock> first, then the same size in each active dimension
+  std::vector<std::vector<int>> cand;
+  std::vector<int> nx0 = {pin->GetOrAddInteger("meshblock", "nx1", mesh_nx[0]),
+                          pin->GetOrAddInteger("meshblock", "nx2", mesh_nx[1]),
+                          pin->GetOrAddInteger("meshblock", "nx3", mesh_nx[2])};
+  cand.push_back(nx0);
+  std::stringstream ss(slist);
+  std::string s;
+  while (std::getline(ss, s, ',')) {
+    int n = std::atoi(s.c_str());
+    std::vector<int> nx = {n, (ndim > 1)? n : 1, (ndim > 2)? n : 1};
+    if (std::find(cand.begin(), cand.end(), nx) == cand.end()) {cand.push_back(nx);}
+  }
+
+  if (global_variable::my_rank == 0) {
+    std::cout << std::endl << "Tuning MeshBlock size with " << ncycle
+              << " cycles per candidate" << std::endl;
+  }
+  int best = -1;
+  double best_speed = 0.0;
+  std::vector<double> speed(cand.size(), 0.0);
+  for (std::size_t c=0; c<cand.size(); ++c) {
+    // skip candidates that are incompatible with the root grid
+    auto &nx = cand[c];
+    bool ok = true;
+    int nmb = 1;
+    for (int d=0; d<ndim; ++d) {
+      if (nx[d] < 4 || mesh_nx[d] % nx[d] != 0) {ok = false; break;}
+      if (multilevel && nx[d] % 2 != 0) {ok = false;}
+      nmb *= mesh_nx[d]/nx[d];
+    }
+#if FIXED_MB_NX1 > 0
+    if (nx[0] != FIXED_MB_NX1) {ok = false;}
+#endif
+    if (!(ok) || nmb < global_variable::nranks) continue;
+
+    speed[c] = RunTrial(input.str(), nx.data(), ncycle);
+    if (speed[c] > best_speed) {
+      best_speed = speed[c];
+      best = static_cast<int>(c);
+    }
+  }
+
+  if (best < 0) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "No MeshBlock size in <job>/tune_sizes is compatible with the Mesh"
+              << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  if (global_variable::my_rank == 0) {
+    std::cout << std::endl << "MeshBlock size tuning (zone-cycles/second):" << std::endl;
+    for (std::size_t c=0; c<cand.size(); ++c) {
+      if (speed[c] > 0.0) {
+        std::printf("  %4d x %4d x %4d  %12.4e%s\n", cand[c][0], cand[c][1], cand[c][2],
+                    speed[c], (static_cast<int>(c) == best)? "  (best)" : "");
+      }
+    }
+    std::fflush(stdout);
+  }
+  pin->SetInteger("meshblock", "nx1", cand[best][0]);
+  pin->SetInteger("meshblock", "nx2", cand[best][1]);
+  pin->SetInteger("meshblock", "nx3", cand[best][2]);
+  return (action == "run");
+}
@@ -11,8 +11,13 @@
 
 #include <string>
 
+class ParameterInput;
+
 void ShowConfig();
 void ChangeRunDir(const std::string dir);
 int CreateMPITag(int lid, int buff_id, int phys_id);
+void InitLaunchTuning(ParameterInput *pin);
+void FinalizeLaunchTuning();
+bool TuneMeshBlockSize(ParameterInput *pin);
 
 #endif // UTILS_UTILS_HPP_
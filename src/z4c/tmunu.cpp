@@ -6,6 +6,8 @@
 //! \file tmunu.hpp
 //! \brief implementation of Tmunu class
 
+#include <algorithm>
+
 #include "athena.hpp"
 #include "athena_tensor.hpp"
 #include "parameter_input.hpp"
@@ -22,7 +24,9 @@ char const * const Tmunu::Tmunu_names[Tmunu::N_Tmunu] = {
 Tmunu::Tmunu(MeshBlockPack *ppack, ParameterInput *pin):
   pmy_pack(ppack),
   u_tmunu("u_tmunu",1,1,1,1,1) {
-  int nmb = ppack->nmb_thispack;
+  // Total number of MeshBlocks on this rank to be used in array dimensioning.  Tmunu is
+  // not re-allocated when MBs are refined/redistributed, so it must hold the maximum.
+  int nmb = std::max((ppack->nmb_thispack), (ppack->pmesh->nmb_maxperrank));
   auto &indcs = pmy_pack->pmesh->mb_indcs;
   int ncells1 = indcs.nx1 + 2*(indcs.ng);
   int ncells2 = (indcs.nx2 > 1) ? (indcs.nx2 + 2*(indcs.ng)) : 1;
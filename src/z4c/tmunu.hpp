@@ -13,6 +13,7 @@
 #include "athena.hpp"
 #include "athena_tensor.hpp"
 #include "mesh/mesh.hpp"
+#include "coordinates/adm.hpp"
 #include "eos/primitive-solver/ps_types.hpp"
 
 // forward declarations
@@ -50,4 +51,78 @@ class Tmunu {
   MeshBlockPack* pmy_pack;
 };
 
+//----------------------------------------------------------------------------------------
+//! \struct TmunuFromArrays
+//! \brief reads E, S_i, and S_{ij} in one cell from the arrays of the Tmunu class.  Has
+//! the same interface as TmunuFromFluid, so kernels can be written for either.
+
+struct TmunuFromArrays {
+  Tmunu::Tmunu_vars tmunu;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int m, const int k, const int j, const int i,
+                  Real &E, Real S_d[3], Real S_dd[3][3]) const {
+    E = tmunu.E(m,k,j,i);
+    for (int a = 0; a < 3; ++a) {
+      S_d[a] = tmunu.S_d(m,a,k,j,i);
+      for (int b = 0; b < 3; ++b) {
+        S_dd[a][b] = tmunu.S_dd(m,a,b,k,j,i);
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------------------
+//! \struct TmunuFromFluid
+//! \brief evaluates the perfect fluid (GRMHD) E, S_i, and S_{ij} in one cell from the
+//! primitive and conserved variables, cell-centered magnetic field, and spatial metric.
+//! Used by DynGRMHD::SetTmunu, and by the Z4c RHS to evaluate the matter sources on the
+//! fly with <mhd>/fused_tmunu = true.
+
+struct TmunuFromFluid {
+  DvceArray5D<Real> prim, cons, bcc;
+  AthenaTensor<Real, TensorSymm::SYM2, 3, 2> g_dd;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int m, const int k, const int j, const int i,
+                  Real &E, Real S_d[3], Real S_dd[3][3]) const {
+    // Calculate the determinant/volume form
+    Real detg = adm::SpatialDet(g_dd(m,0,0,k,j,i), g_dd(m,0,1,k,j,i),
+                                g_dd(m,0,2,k,j,i), g_dd(m,1,1,k,j,i),
+                                g_dd(m,1,2,k,j,i), g_dd(m,2,2,k,j,i));
+    Real ivol = 1.0/sqrt(detg);
+
+    // Calculate the lower velocity components
+    Real v_d[3] = {0.0};
+    Real iW = 0.;
+    Real B_d[3] = {0.0};
+    for (int a = 0; a < 3; ++a) {
+      for (int b = 0; b < 3; ++b) {
+        v_d[a] += prim(m, IVX + b, k, j, i)*g_dd(m, a, b, k, j, i);
+        iW += prim(m, IVX + a, k, j, i)*prim(m, IVX + b, k, j, i)*g_dd(m, a, b, k, j, i);
+        B_d[a] += bcc(m, b, k, j, i)*g_dd(m, a, b, k, j, i)*ivol;
+      }
+    }
+    iW = 1.0/sqrt(1. + iW);
+    Real Bv = 0.;
+    Real Bsq = 0.;
+    for (int a = 0; a < 3; ++a) {
+      Bv += bcc(m, a, k, j, i) * v_d[a]*ivol;
+      Bsq += bcc(m, a, k, j, i) * B_d[a]*ivol;
+    }
+    Real bsq = (Bsq + Bv*Bv)*(iW*iW);
+
+    E = (cons(m, IEN, k, j, i) + cons(m, IDN, k, j, i))*ivol;
+    for (int a = 0; a < 3; ++a) {
+      S_d[a] = cons(m, IM1 + a, k, j, i)*ivol;
+      for (int b = a; b < 3; ++b) {
+        S_dd[a][b] = cons(m, IM1 + a, k, j, i)*ivol*v_d[b]*iW
+                   - (B_d[a] + Bv*v_d[a])*SQR(iW)*B_d[b]
+                   + (prim(m, IPR, k, j, i) + 0.5*bsq)*g_dd(m, a, b, k, j, i);
+        S_dd[b][a] = S_dd[a][b];
+      }
+    }
+  }
+};
+
 #endif  // Z4C_TMUNU_HPP_
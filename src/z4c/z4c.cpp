@@ -22,7 +22,9 @@
 #include "bvals/bvals.hpp"
 #include "z4c/z4c.hpp"
 #include "z4c/z4c_amr.hpp"
+#include "z4c/z4c_horizon_finder.hpp"
 #include "coordinates/adm.hpp"
+#include "utils/managed_memory.hpp"
 
 namespace z4c {
 
@@ -65,6 +67,8 @@ Z4c::Z4c(MeshBlockPack *ppack, ParameterInput *pin) :
   u_weyl("u_weyl",1,1,1,1,1),
   coarse_u_weyl("coarse_u_weyl",1,1,1,1,1),
   psi_out("psi_out",1,1,1),
+  swsh_wghts("swsh_wghts",1,1,1),
+  psi_modes("psi_modes",1,1,1),
   pz4c_amr(new Z4c_AMR(this,pin)) {
   // (1) read time-evolution option [already error checked in driver constructor]
   // Then initialize memory and algorithms for reconstruction and Riemann solvers
@@ -78,13 +82,13 @@ Z4c::Z4c(MeshBlockPack *ppack, ParameterInput *pin) :
   int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
   int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
   Kokkos::Profiling::pushRegion("Tensor fields");
-  Kokkos::realloc(u_con, nmb, (ncon), ncells3, ncells2, ncells1);
+  ManagedMemory::Realloc(u_con, nmb, (ncon), ncells3, ncells2, ncells1);
   // Matter commented out
   // kokkos::realloc(u_mat, nmb, (N_MAT), ncells3, ncells2, ncells1);
   Kokkos::realloc(u0,    nmb, (nz4c), ncells3, ncells2, ncells1);
   Kokkos::realloc(u1,    nmb, (nz4c), ncells3, ncells2, ncells1);
   Kokkos::realloc(u_rhs, nmb, (nz4c), ncells3, ncells2, ncells1);
-  Kokkos::realloc(u_weyl,    nmb, (2), ncells3, ncells2, ncells1);
+  ManagedMemory::Realloc(u_weyl, nmb, (2), ncells3, ncells2, ncells1);
 
   con.C.InitWithShallowSlice(u_con, I_CON_C);
   con.H.InitWithShallowSlice(u_con, I_CON_H);
@@ -121,6 +125,7 @@ Z4c::Z4c(MeshBlockPack *ppack, ParameterInput *pin) :
   opt.chi_psi_power = pin->GetOrAddReal("z4c", "chi_psi_power", -4.0);
   opt.chi_div_floor = pin->GetOrAddReal("z4c", "chi_div_floor", -1000.0);
   opt.diss = pin->GetOrAddReal("z4c", "diss", 0.0);
+  overlap_comm = pin->GetOrAddBoolean("z4c", "overlap_comm", false);
   opt.eps_floor = pin->GetOrAddReal("z4c", "eps_floor", 1e-12);
   opt.damp_kappa1 = pin->GetOrAddReal("z4c", "damp_kappa1", 0.0);
   opt.damp_kappa2 = pin->GetOrAddReal("z4c", "damp_kappa2", 0.0);
@@ -144,6 +149,28 @@ Z4c::Z4c(MeshBlockPack *ppack, ParameterInput *pin) :
   opt.extrap_order = fmax(2,fmin(indcs.ng,fmin(4,
       pin->GetOrAddInteger("z4c", "extrap_order", 2))));
 
+  std::string rhs_method = pin->GetOrAddString("z4c", "rhs_method", "monolithic");
+  if (rhs_method.compare("monolithic") == 0) {
+    opt.rhs_method = Z4cRHSMethod::monolithic;
+  } else if (rhs_method.compare("tiled") == 0) {
+    opt.rhs_method = Z4cRHSMethod::tiled;
+  } else if (rhs_method.compare("split") == 0) {
+    opt.rhs_method = Z4cRHSMethod::split;
+  } else {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "<z4c>/rhs_method = '" << rhs_method << "' not implemented"
+              << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  opt.rhs_tile_nk = pin->GetOrAddInteger("z4c", "rhs_tile_nk", 2);
+  opt.rhs_tile_nj = pin->GetOrAddInteger("z4c", "rhs_tile_nj", 2);
+  if (opt.rhs_tile_nk < 1 || opt.rhs_tile_nj < 1) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "<z4c>/rhs_tile_nk and rhs_tile_nj must be > 0"
+              << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
   diss = opt.diss*pow(2., -2.*indcs.ng)*(indcs.ng % 2 == 0 ? -1. : 1.);
   }
 
@@ -153,14 +180,16 @@ Z4c::Z4c(MeshBlockPack *ppack, ParameterInput *pin) :
     int nccells1 = indcs.cnx1 + 2*(indcs.ng);
     int nccells2 = (indcs.cnx2 > 1)? (indcs.cnx2 + 2*(indcs.ng)) : 1;
     int nccells3 = (indcs.cnx3 > 1)? (indcs.cnx3 + 2*(indcs.ng)) : 1;
-    Kokkos::realloc(coarse_u0, nmb, (nz4c), nccells3, nccells2, nccells1);
-    Kokkos::realloc(coarse_u_weyl, nmb, (2), nccells3, nccells2, nccells1);
+    ManagedMemory::Realloc(coarse_u0, nmb, (nz4c), nccells3, nccells2, nccells1);
+    ManagedMemory::Realloc(coarse_u_weyl, nmb, (2), nccells3, nccells2, nccells1);
   }
   Kokkos::Profiling::popRegion();
 
   // allocate boundary buffers for conserved (cell-centered) variables
   Kokkos::Profiling::pushRegion("Buffers");
   pbval_u = new MeshBoundaryValuesCC(ppack, pin, true);
+  // optionally send single-precision ghost zones to MeshBlocks on other nodes
+  pbval_u->compress_mpi = pin->GetOrAddBoolean("z4c","compress_mpi",false);
   pbval_u->InitializeBuffers((nz4c));
   pbval_weyl = new MeshBoundaryValuesCC(ppack, pin, true);
   pbval_weyl->InitializeBuffers((2));
@@ -180,6 +209,12 @@ Z4c::Z4c(MeshBlockPack *ppack, ParameterInput *pin) :
   mkdir("waveforms",0775);
   waveform_dt = pin->GetOrAddReal("z4c", "waveform_dt", 1);
   last_output_time = 0;
+
+  // apparent horizon finders
+  int nhorizons = pin->GetOrAddInteger("z4c", "nhorizons", 0);
+  for (int n=0; n<nhorizons; ++n) {
+    horizon_finders.push_back(std::make_unique<HorizonFinder>(ppack, pin, n));
+  }
 }
 
 //----------------------------------------------------------------------------------------
@@ -188,7 +223,6 @@ Z4c::Z4c(MeshBlockPack *ppack, ParameterInput *pin) :
 //
 // This function operates on all grid points of the MeshBlock
 void Z4c::AlgConstr(MeshBlockPack *pmbp) {
-  // capture variables for the kernel
   auto &indcs = pmbp->pmesh->mb_indcs;
   int &is = indcs.is; int &ie = indcs.ie;
   int &js = indcs.js; int &je = indcs.je;
@@ -197,13 +231,23 @@ void Z4c::AlgConstr(MeshBlockPack *pmbp) {
   int isg = is-indcs.ng; int ieg = ie+indcs.ng;
   int jsg = js-indcs.ng; int jeg = je+indcs.ng;
   int ksg = ks-indcs.ng; int keg = ke+indcs.ng;
+  AlgConstr(pmbp, isg, ieg, jsg, jeg, ksg, keg);
+}
 
+//----------------------------------------------------------------------------------------
+//! \fn void Z4c::AlgConstr(MeshBlockPack *pmbp, int il, int iu, ...)
+//! \brief algebraic constraints projection over the given range of grid points.  The
+//! projection is pointwise, so it can be split between active cells and ghost zones.
+
+void Z4c::AlgConstr(MeshBlockPack *pmbp, const int il, const int iu, const int jl,
+                    const int ju, const int kl, const int ku) {
+  // capture variables for the kernel
   int nmb = pmbp->nmb_thispack;
 
   auto &z4c = pmbp->pz4c->z4c;
   auto &opt = pmbp->pz4c->opt;
   par_for("Alg constr loop",DevExeSpace(),
-  0,nmb-1,ksg,keg,jsg,jeg,isg,ieg,
+  0,nmb-1,kl,ku,jl,ju,il,iu,
   KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
     Real detg = adm::SpatialDet(z4c.g_dd(m,0,0,k,j,i), z4c.g_dd(m,0,1,k,j,i),
                               z4c.g_dd(m,0,2,k,j,i),z4c.g_dd(m,1,1,k,j,i),
@@ -34,7 +34,6 @@ struct Z4cTaskIDs {
   TaskID irecvweyl;
   TaskID copyu;
   TaskID crhs;
-  TaskID sombc;
   TaskID expl;
   TaskID sendu;
   TaskID recvu;
@@ -42,13 +41,14 @@ struct Z4cTaskIDs {
   TaskID bcs;
   TaskID prol;
   TaskID algc;
+  TaskID algca;
   TaskID z4tad;
   TaskID admc;
   TaskID csend;
   TaskID crecv;
   TaskID restu;
   TaskID ptrck;
-  TaskID weyl_scalar;
+  TaskID ptevo;
   TaskID wave_extr;
   TaskID weyl_rest;
   TaskID weyl_send;
@@ -56,10 +56,15 @@ struct Z4cTaskIDs {
   TaskID weyl_recv;
   TaskID csendweyl;
   TaskID crecvweyl;
+  TaskID ahf;
 };
 
 namespace z4c {
 class Z4c_AMR;
+class HorizonFinder;
+
+// kernels available to compute the RHS
+enum class Z4cRHSMethod {monolithic, tiled, split};
 
 // Shift needed for derivatives
 //----------------------------------------------------------------------------------------
@@ -112,6 +117,7 @@ class Z4c {
   DvceArray5D<Real> u0;        // z4c solution
   DvceArray5D<Real> u1;        // z4c solution at intermediate timestep
   DvceArray5D<Real> u_rhs;     // z4c rhs storage
+  DvceArray5D<Real> u_der;     // derivatives stored between passes of split rhs
   DvceArray5D<Real> coarse_u0; // coarse representation of z4c solution
   DvceArray5D<Real> u_weyl; // weyl scalars
   DvceArray5D<Real> coarse_u_weyl; // coarse representation of weyl scalars
@@ -199,6 +205,10 @@ class Z4c {
     bool user_Sbc;
     // Boundary extrapolation order
     int extrap_order;
+    // Kernel(s) used to evaluate the RHS
+    Z4cRHSMethod rhs_method;
+    // rows of cells in each brick staged in scratch by the tiled RHS, in x3 and x2
+    int rhs_tile_nk, rhs_tile_nj;
   };
   Options opt;
   Real diss;              // Dissipation parameter
@@ -211,6 +221,8 @@ class Z4c {
 
   // following only used for time-evolving flow
   Real dtnew;
+  // flag to overlap algebraic constraints in active cells with communication
+  bool overlap_comm = false;
   // container to hold names of TaskIDs
   Z4cTaskIDs id;
 
@@ -218,10 +230,17 @@ class Z4c {
   std::vector<std::unique_ptr<SphericalGrid>> spherical_grids;
   // array storing waveform at each radii
   HostArray3D<Real> psi_out;
+  // solid-angle weighted Y^{-2}_{lm} at each angle of the extraction spheres, and modes
+  // of each sphere computed on the device
+  DvceArray3D<Real> swsh_wghts;
+  DvceArray3D<Real> psi_modes;
   Real waveform_dt;
   Real last_output_time;
   int nrad; // number of radii to perform wave extraction
 
+  // apparent horizon finders, which hold the shape of the last horizon found
+  std::vector<std::unique_ptr<HorizonFinder>> horizon_finders;
+
   // functions
   void AssembleZ4cTasks(std::map<std::string, std::shared_ptr<TaskList>> tl);
   void QueueZ4cTasks();
@@ -242,16 +261,19 @@ class Z4c {
   TaskStatus NewTimeStep(Driver *d, int stage);
   TaskStatus ApplyPhysicalBCs(Driver *d, int stage);
   TaskStatus EnforceAlgConstr(Driver *d, int stage);
+  TaskStatus EnforceAlgConstrActive(Driver *d, int stage);
+  TaskStatus EnforceAlgConstrGhosts(Driver *d, int stage);
 
   TaskStatus Z4cToADM_(Driver *d, int stage);
   TaskStatus UpdateExcisionMasks(Driver *d, int stage);
-  TaskStatus ADMConstraints_(Driver *d, int stage);
+  TaskStatus CalcDiagnostics(Driver *d, int stage);
   TaskStatus Z4cBoundaryRHS(Driver *d, int stage);
   TaskStatus RestrictU(Driver *d, int stage);
   TaskStatus RestrictWeyl(Driver *d, int stage);
   TaskStatus PunctureTracker(Driver *d, int stage);
-  TaskStatus CalcWeylScalar(Driver *d, int stage);
+  TaskStatus EvolvePunctures(Driver *d, int stage);
   TaskStatus CalcWaveForm(Driver *d, int stage);
+  TaskStatus FindHorizons(Driver *d, int stage);
 
   template <int NGHOST>
   TaskStatus CalcRHS(Driver *d, int stage);
@@ -259,18 +281,28 @@ class Z4c {
   void ADMToZ4c(MeshBlockPack *pmbp, ParameterInput *pin);
   void GaugePreCollapsedLapse(MeshBlockPack *pmbp, ParameterInput *pin);
   void Z4cToADM(MeshBlockPack *pmbp);
+  void Diagnostics(bool calc_con, bool calc_weyl);
+  template <int NGHOST>
+  void Z4cDiagnostics(MeshBlockPack *pmbp, bool calc_con, bool calc_weyl);
   template <int NGHOST>
   void ADMConstraints(MeshBlockPack *pmbp);
   template <int NGHOST>
   void Z4cWeyl(MeshBlockPack *pmbp);
   void WaveExtr(MeshBlockPack *pmbp);
   void AlgConstr(MeshBlockPack *pmbp);
+  void AlgConstr(MeshBlockPack *pmbp, const int il, const int iu, const int jl,
+                 const int ju, const int kl, const int ku);
 
   // amr criteria
   Z4c_AMR *pz4c_amr{nullptr};
 
  private:
   MeshBlockPack* pmy_pack;  // ptr to MeshBlockPack containing this Z4c
+  int dtnew_version_ = -1;  // Mesh::mesh_version when dtnew was last computed
+  // (MeshBlock, face) pairs with Sommerfeld BCs, and Mesh::mesh_version when listed
+  DualArray2D<int> sbc_face_;
+  int nsbc_face_ = 0;
+  int sbc_version_ = -1;
 };
 
 
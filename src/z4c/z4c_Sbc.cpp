@@ -10,6 +10,7 @@
 #include <cinttypes>
 #include <iostream>
 #include <limits>
+#include <vector>
 
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
@@ -123,145 +124,69 @@ static void Z4cSommerfeld(const Z4c::Z4c_vars& z4c, const Z4c::Z4c_vars& rhs,
 
 //---------------------------------------------------------------------------------------
 //! \fn TaskStatus Z4c::Z4cBoundaryRHS
-//! \brief placeholder for the Sommerfield Boundary conditions for z4c
+//! \brief Sommerfeld boundary conditions for z4c.  Applied in one launch over a compact
+//! list of the (MeshBlock, face) pairs at outflow, diode, or (with user_Sbc) user
+//! boundaries, which is rebuilt whenever the mesh changes.  Nothing is launched on packs
+//! without such faces.  Called at the end of CalcRHS, since it overwrites the RHS
+//! (including dissipation) in the outermost active cells.
 TaskStatus Z4c::Z4cBoundaryRHS(Driver *pdriver, int stage) {
   auto &pm = pmy_pack->pmesh;
-  int &ng = pmy_pack->pmesh->mb_indcs.ng;
   auto &mb_bcs = pmy_pack->pmb->mb_bcs;
   auto &indcs = pmy_pack->pmesh->mb_indcs;
   auto &size = pmy_pack->pmb->mb_size;
 
-  int nmb = pmy_pack->nmb_thispack;
-  int n1 = indcs.nx1 + 2*ng;
-  int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng) : 1;
-  int n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng) : 1;
-  int is = indcs.is;
-  int ie = indcs.ie;
-  int js = indcs.js;
-  int je = indcs.je;
-  int ks = indcs.ks;
-  int ke = indcs.ke;
-
-  auto &z4c_ = z4c;
-  auto &rhs_ = rhs;
-  bool &user_Sbc = opt.user_Sbc;
-
   // We only need to apply this condition for outflow boundaries
-  if (pm->mesh_bcs[BoundaryFace::inner_x1] == BoundaryFlag::outflow
-      || pm->mesh_bcs[BoundaryFace::inner_x1] == BoundaryFlag::diode
-      || pm->mesh_bcs[BoundaryFace::inner_x1] == BoundaryFlag::user
-      || pm->mesh_bcs[BoundaryFace::outer_x1] == BoundaryFlag::outflow
-      || pm->mesh_bcs[BoundaryFace::outer_x1] == BoundaryFlag::diode
-      || pm->mesh_bcs[BoundaryFace::outer_x1] == BoundaryFlag::user) {
-    par_for("z4crhs_bc_x1", DevExeSpace(), 0, (nmb-1), ks, ke, js, je,
-    KOKKOS_LAMBDA(int m, int k, int j) {
-      // Inner boundary
-      switch(mb_bcs.d_view(m,BoundaryFace::inner_x1)) {
-        case BoundaryFlag::diode:
-        case BoundaryFlag::outflow:
-            Z4cSommerfeld(z4c_, rhs_, indcs, size, m, k, j, is);
-          break;
-        case BoundaryFlag::user:
-            if (user_Sbc) {
-              Z4cSommerfeld(z4c_, rhs_, indcs, size, m, k, j, is);
-            }
-          break;
-        default:
-          break;
-      }
-      // Outer boundary
-      switch (mb_bcs.d_view(m,BoundaryFace::outer_x1)) {
-        case BoundaryFlag::diode:
-        case BoundaryFlag::outflow:
-            Z4cSommerfeld(z4c_, rhs_, indcs, size, m, k, j, ie);
-          break;
-        case BoundaryFlag::user:
-            if (user_Sbc) {
-              Z4cSommerfeld(z4c_, rhs_, indcs, size, m, k, j, ie);
-            }
-          break;
-        default:
-          break;
+  if (sbc_version_ != pm->mesh_version) {
+    int nmb = pmy_pack->nmb_thispack;
+    std::vector<int> list;
+    for (int m=0; m<nmb; ++m) {
+      for (int f=0; f<6; ++f) {
+        BoundaryFlag bc = mb_bcs.h_view(m,f);
+        if (bc == BoundaryFlag::outflow || bc == BoundaryFlag::diode ||
+            (bc == BoundaryFlag::user && opt.user_Sbc)) {
+          list.push_back(m);
+          list.push_back(f);
+        }
       }
-    });
-  }
-  if (pm->mesh_bcs[BoundaryFace::inner_x2] == BoundaryFlag::outflow
-      || pm->mesh_bcs[BoundaryFace::inner_x2] == BoundaryFlag::diode
-      || pm->mesh_bcs[BoundaryFace::inner_x2] == BoundaryFlag::user
-      || pm->mesh_bcs[BoundaryFace::outer_x2] == BoundaryFlag::outflow
-      || pm->mesh_bcs[BoundaryFace::outer_x2] == BoundaryFlag::diode
-      || pm->mesh_bcs[BoundaryFace::outer_x2] == BoundaryFlag::user) {
-    par_for("z4crhs_bc_x2", DevExeSpace(), 0, (nmb-1), ks, ke, is, ie,
-    KOKKOS_LAMBDA(int m, int k, int i) {
-      // Inner boundary
-      switch(mb_bcs.d_view(m,BoundaryFace::inner_x2)) {
-        case BoundaryFlag::diode:
-        case BoundaryFlag::outflow:
-            Z4cSommerfeld(z4c_, rhs_, indcs, size, m, k, js, i);
-          break;
-        case BoundaryFlag::user:
-            if (user_Sbc) {
-              Z4cSommerfeld(z4c_, rhs_, indcs, size, m, k, js, i);
-            }
-          break;
-        default:
-          break;
-      }
-      // Outer boundary
-      switch (mb_bcs.d_view(m,BoundaryFace::outer_x2)) {
-        case BoundaryFlag::diode:
-        case BoundaryFlag::outflow:
-            Z4cSommerfeld(z4c_, rhs_, indcs, size, m, k, je, i);
-          break;
-        case BoundaryFlag::user:
-            if (user_Sbc) {
-              Z4cSommerfeld(z4c_, rhs_, indcs, size, m, k, je, i);
-            }
-          break;
-        default:
-          break;
-      }
-    });
-  }
-  if (pm->mesh_bcs[BoundaryFace::inner_x3] == BoundaryFlag::outflow
-      || pm->mesh_bcs[BoundaryFace::inner_x3] == BoundaryFlag::diode
-      || pm->mesh_bcs[BoundaryFace::inner_x3] == BoundaryFlag::user
-      || pm->mesh_bcs[BoundaryFace::outer_x3] == BoundaryFlag::outflow
-      || pm->mesh_bcs[BoundaryFace::outer_x3] == BoundaryFlag::diode
-      || pm->mesh_bcs[BoundaryFace::outer_x3] == BoundaryFlag::user) {
-    par_for("z4crhs_bc_x3", DevExeSpace(), 0, (nmb-1), js, je, is, ie,
-    KOKKOS_LAMBDA(int m, int j, int i) {
-      // Inner boundary
-      switch(mb_bcs.d_view(m,BoundaryFace::inner_x3)) {
-        case BoundaryFlag::diode:
-        case BoundaryFlag::outflow:
-            Z4cSommerfeld(z4c_, rhs_, indcs, size, m, ks, j, i);
-          break;
-        case BoundaryFlag::user:
-            if (user_Sbc) {
-              Z4cSommerfeld(z4c_, rhs_, indcs, size, m, ks, j, i);
-            }
-          break;
-        default:
-          break;
-      }
-      // Outer boundary
-      switch (mb_bcs.d_view(m,BoundaryFace::outer_x3)) {
-        case BoundaryFlag::diode:
-        case BoundaryFlag::outflow:
-            Z4cSommerfeld(z4c_, rhs_, indcs, size, m, ke, j, i);
-          break;
-        case BoundaryFlag::user:
-            if (user_Sbc) {
-              Z4cSommerfeld(z4c_, rhs_, indcs, size, m, ke, j, i);
-            }
-          break;
-        default:
-          break;
-      }
-    });
+    }
+    nsbc_face_ = static_cast<int>(list.size())/2;
+    Kokkos::realloc(sbc_face_, std::max(nsbc_face_, 1), 2);
+    for (int n=0; n<nsbc_face_; ++n) {
+      sbc_face_.h_view(n,0) = list[2*n];
+      sbc_face_.h_view(n,1) = list[2*n+1];
+    }
+    sbc_face_.template modify<HostMemSpace>();
+    sbc_face_.template sync<DevExeSpace>();
+    sbc_version_ = pm->mesh_version;
   }
-
+  if (nsbc_face_ == 0) return TaskStatus::complete;
+
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  // (b,a) loop over the largest face, cells outside of smaller faces are skipped
+  int nb = std::max(indcs.nx3, indcs.nx2);
+  int na = std::max(indcs.nx2, indcs.nx1);
+  auto &z4c_ = z4c;
+  auto &rhs_ = rhs;
+  auto &face_ = sbc_face_;
+  par_for("z4crhs_bc", DevExeSpace(), 0, (nsbc_face_-1), 0, (nb-1), 0, (na-1),
+  KOKKOS_LAMBDA(int n, int b, int a) {
+    int m = face_.d_view(n,0);
+    int f = face_.d_view(n,1);
+    int k, j, i;
+    if (f < 2) {          // x1-face: (b,a) = (k,j)
+      if (b >= indcs.nx3 || a >= indcs.nx2) return;
+      k = ks + b; j = js + a; i = (f == BoundaryFace::inner_x1)? is : ie;
+    } else if (f < 4) {   // x2-face: (b,a) = (k,i)
+      if (b >= indcs.nx3 || a >= indcs.nx1) return;
+      k = ks + b; j = (f == BoundaryFace::inner_x2)? js : je; i = is + a;
+    } else {              // x3-face: (b,a) = (j,i)
+      if (b >= indcs.nx2 || a >= indcs.nx1) return;
+      k = (f == BoundaryFace::inner_x3)? ks : ke; j = js + b; i = is + a;
+    }
+    Z4cSommerfeld(z4c_, rhs_, indcs, size, m, k, j, i);
+  });
 
   return TaskStatus::complete;
 }
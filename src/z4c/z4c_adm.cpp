@@ -234,282 +234,4 @@ void Z4c::Z4cToADM(MeshBlockPack *pmbp) {
   });
   return;
 }
-//----------------------------------------------------------------------------------------
-//! \fn void Z4c::ADMConstraints(AthenaArray<Real> & u_adm, AthenaArray<Real> & u_mat)
-//! \brief compute constraints ADM vars
-//
-// Note: we are assuming that u_adm has been initialized with the correct
-// metric and matter quantities
-//
-// BAM: adm_constraints_N()
-// https://git.tpi.uni-jena.de/bamdev/adm
-// https://git.tpi.uni-jena.de/bamdev/adm/blob/master/adm_constraints_N.m
-//
-// The constraints are set only in the MeshBlock interior, because derivatives
-// of the ADM quantities are neded to compute them.
-template <int NGHOST>
-void Z4c::ADMConstraints(MeshBlockPack *pmbp) {
-  // capture variables for the kernel
-  auto &indcs = pmbp->pmesh->mb_indcs;
-  auto &size = pmbp->pmb->mb_size;
-  int &is = indcs.is; int &ie = indcs.ie;
-  int &js = indcs.js; int &je = indcs.je;
-  int &ks = indcs.ks; int &ke = indcs.ke;
-  //For GLOOPS
-
-  int ncells1 = indcs.nx1 + 2*(indcs.ng);
-  int nmb = pmbp->nmb_thispack;
-
-  auto &z4c = pmbp->pz4c->z4c;
-  auto &opt = pmbp->pz4c->opt;
-  auto &adm = pmbp->padm->adm;
-  auto &tmunu = pmbp->ptmunu->tmunu;
-  auto &u_con = pmbp->pz4c->u_con;
-  Kokkos::deep_copy(u_con, 0.);
-  auto &con = pmbp->pz4c->con;
-  par_for("ADM constraints loop",DevExeSpace(),
-  0,nmb-1,ks,ke,js,je,is,ie,
-  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> Gamma_u;
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> Gamma_u_z4c;
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> M_u;
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dpsi4_d;
-
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> g_uu;
-    //AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> g_uu_z4c;
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> R_dd;
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> K_ud;
-
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> dg_ddd;
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> dg_ddd_z4c;
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> dK_ddd;
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_ddd;
-    //AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_ddd_z4c;
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_udd;
-    //AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_udd_z4c;
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> DK_ddd;
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> DK_udd;
-
-    AthenaScratchTensor<Real, TensorSymm::SYM22, 3, 4> ddg_dddd;
-
-    Real idx[] = {1/size.d_view(m).dx1, 1/size.d_view(m).dx2, 1/size.d_view(m).dx3};
-
-    // -----------------------------------------------------------------------------------
-    // derivatives
-    //
-    // first derivatives of g and K
-    for(int c = 0; c < 3; ++c)
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      dg_ddd(c,a,b) = Dx<NGHOST>(c, idx, adm.g_dd, m,a,b,k,j,i);
-      dg_ddd_z4c(c,a,b) = Dx<NGHOST>(c, idx, z4c.g_dd, m,a,b,k,j,i);
-      dK_ddd(c,a,b) = Dx<NGHOST>(c, idx, adm.vK_dd, m,a,b,k,j,i);
-    }
-
-    // first derivative of psi4
-    for (int a =0; a < 3; ++a) {
-      dpsi4_d(a) = Dx<NGHOST>(a, idx, adm.psi4, m, k, j, i);
-    }
-
-    // second derivatives of g
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b)
-    for(int c = 0; c < 3; ++c)
-    for(int d = c; d < 3; ++d) {
-      if(a == b) {
-        ddg_dddd(a,a,c,d) = Dxx<NGHOST>(a, idx, adm.g_dd, m,c,d,k,j,i);
-      } else {
-        ddg_dddd(a,b,c,d) = Dxy<NGHOST>(a, b, idx, adm.g_dd, m,c,d,k,j,i);
-      }
-    }
-
-    // -----------------------------------------------------------------------------------
-    // inverse metric
-    //
-    Real detg = adm::SpatialDet(adm.g_dd(m,0,0,k,j,i), adm.g_dd(m,0,1,k,j,i),
-                                adm.g_dd(m,0,2,k,j,i), adm.g_dd(m,1,1,k,j,i),
-                                adm.g_dd(m,1,2,k,j,i), adm.g_dd(m,2,2,k,j,i));
-    adm::SpatialInv(1./detg,
-               adm.g_dd(m,0,0,k,j,i), adm.g_dd(m,0,1,k,j,i), adm.g_dd(m,0,2,k,j,i),
-               adm.g_dd(m,1,1,k,j,i), adm.g_dd(m,1,2,k,j,i), adm.g_dd(m,2,2,k,j,i),
-               &g_uu(0,0), &g_uu(0,1), &g_uu(0,2),
-               &g_uu(1,1), &g_uu(1,2), &g_uu(2,2));
-
-    /*Real detg_z4c = adm::SpatialDet(z4c.g_dd(m,0,0,k,j,i), z4c.g_dd(m,0,1,k,j,i),
-                                z4c.g_dd(m,0,2,k,j,i), z4c.g_dd(m,1,1,k,j,i),
-                                z4c.g_dd(m,1,2,k,j,i), z4c.g_dd(m,2,2,k,j,i));
-    adm::SpatialInv(1./detg_z4c,
-               z4c.g_dd(m,0,0,k,j,i), z4c.g_dd(m,0,1,k,j,i), z4c.g_dd(m,0,2,k,j,i),
-               z4c.g_dd(m,1,1,k,j,i), z4c.g_dd(m,1,2,k,j,i), z4c.g_dd(m,2,2,k,j,i),
-               &g_uu_z4c(0,0), &g_uu_z4c(0,1), &g_uu_z4c(0,2),
-               &g_uu_z4c(1,1), &g_uu_z4c(1,2), &g_uu_z4c(2,2));*/
-
-    // -----------------------------------------------------------------------------------
-    // Christoffel symbols
-    //
-    for(int c = 0; c < 3; ++c)
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      Gamma_ddd(c,a,b) = 0.5*(dg_ddd(a,b,c) + dg_ddd(b,a,c) - dg_ddd(c,a,b));
-      Gamma_udd(c,a,b) = 0.0;
-    }
-
-    for(int c = 0; c < 3; ++c)
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b)
-    for(int d = 0; d < 3; ++d) {
-      Gamma_udd(c,a,b) += g_uu(c,d)*Gamma_ddd(d,a,b);
-    }
-
-    for(int a = 0; a < 3; ++a) {
-      Gamma_u(a) = 0.0;
-      for(int b = 0; b < 3; ++b)
-      for(int c = 0; c < 3; ++c) {
-        Gamma_u(a) += g_uu(b,c)*Gamma_udd(a,b,c);
-      }
-    }
-
-    // same but for z4c metric
-    /*for(int c = 0; c < 3; ++c)
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      Gamma_ddd_z4c(c,a,b) = 0.5*(dg_ddd_z4c(a,b,c)
-                          + dg_ddd_z4c(b,a,c) - dg_ddd_z4c(c,a,b));
-      Gamma_udd_z4c(c,a,b) = 0.0;
-    }
-
-    for(int c = 0; c < 3; ++c)
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b)
-    for(int d = 0; d < 3; ++d) {
-      Gamma_udd_z4c(c,a,b) += g_uu_z4c(c,d)*Gamma_ddd_z4c(d,a,b);
-    }
-
-    for(int a = 0; a < 3; ++a) {
-      Gamma_u_z4c(a) = 0.0;
-      for(int b = 0; b < 3; ++b)
-      for(int c = 0; c < 3; ++c) {
-        Gamma_u_z4c(a) += g_uu_z4c(b,c)*Gamma_udd_z4c(a,b,c);
-      }
-    }*/
-    // Find the contracted conformal Christoffel symbol
-    for (int a = 0; a < 3; ++a) {
-      Gamma_u_z4c(a) = adm.psi4(m,k,j,i)*Gamma_u(a);
-      for (int b = 0; b < 3; ++b) {
-        Gamma_u_z4c(a) += 0.5*g_uu(a,b)*dpsi4_d(b);
-      }
-    }
-
-    // -----------------------------------------------------------------------------------
-    // Ricci tensor and Ricci scalar
-    //
-    Real R = 0.0;
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      R_dd(a,b) = 0.0;
-      for(int c = 0; c < 3; ++c)
-      for(int d = 0; d < 3; ++d) {
-        // Part with the Christoffel symbols
-        for(int e = 0; e < 3; ++e) {
-          R_dd(a,b) += g_uu(c,d) * Gamma_udd(e,a,c) * Gamma_ddd(e,b,d);
-          R_dd(a,b) -= g_uu(c,d) * Gamma_udd(e,a,b) * Gamma_ddd(e,c,d);
-        }
-        // Wave operator part of the Ricci
-        R_dd(a,b) += 0.5*g_uu(c,d)*(
-            - ddg_dddd(c,d,a,b) - ddg_dddd(a,b,c,d) +
-              ddg_dddd(a,c,b,d) + ddg_dddd(b,c,a,d));
-      }
-      R += g_uu(a,b) * R_dd(a,b);
-    }
-
-    // -----------------------------------------------------------------------------------
-    // Extrinsic curvature: traces and derivatives
-    //
-    Real K = 0.0;
-    for(int a = 0; a < 3; ++a) {
-      for(int b = a; b < 3; ++b) {
-        K_ud(a,b) = 0.0;
-        for(int c = 0; c < 3; ++c) {
-          K_ud(a,b) += g_uu(a,c) * adm.vK_dd(m,c,b,k,j,i);
-        }
-      }
-      K += K_ud(a,a);
-    }
-
-    // K^a_b K^b_a
-    Real KK = 0.0;
-    for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b) {
-      KK += K_ud(a,b) * K_ud(b,a);
-    }
-
-    // Covariant derivative of K
-    for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b)
-    for(int c = b; c < 3; ++c) {
-      DK_ddd(a,b,c) = dK_ddd(a,b,c);
-      for(int d = 0; d < 3; ++d) {
-        DK_ddd(a,b,c) -= Gamma_udd(d,a,b) * adm.vK_dd(m,d,c,k,j,i);
-        DK_ddd(a,b,c) -= Gamma_udd(d,a,c) * adm.vK_dd(m,b,d,k,j,i);
-      }
-    }
-
-    for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b)
-    for(int c = b; c < 3; ++c) {
-      DK_udd(a,b,c) = 0.0;
-      for(int d = 0; d < 3; ++d) {
-        DK_udd(a,b,c) += g_uu(a,d) * DK_ddd(d,b,c);
-      }
-    }
-
-    // -----------------------------------------------------------------------------------
-    // Actual constraints
-    //
-    // Hamiltonian constraint
-    //
-    con.H(m,k,j,i) = R + SQR(K) - KK - 16*M_PI * tmunu.E(m,k,j,i);
-
-    // Momentum constraint (contravariant)
-    //
-    for(int a = 0; a < 3; ++a) {
-      M_u(a) = 0.0;
-      for(int b = 0; b < 3; ++b) {
-        M_u(a) -= 8*M_PI * g_uu(a,b) * tmunu.S_d(m,b,k,j,i);
-        for(int c = 0; c < 3; ++c) {
-          M_u(a) += g_uu(a,b) * DK_udd(c,b,c);
-          M_u(a) -= g_uu(b,c) * DK_udd(a,b,c);
-        }
-      }
-    }
-
-    // Momentum constraint (covariant)
-    for(int a = 0; a < 3; ++a) {
-      for(int b = 0; b < 3; ++b) {
-        con.M_d(m,a,k,j,i) += adm.g_dd(m,a,b,k,j,i) * M_u(b);
-      }
-    }
-
-    // Momentum constraint (norm squared)
-    for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b) {
-      con.M(m,k,j,i) += adm.g_dd(m,a,b,k,j,i) * M_u(a) * M_u(b);
-    }
-
-    // Constraint violation Z (norm squared)
-    for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b) {
-      con.Z(m,k,j,i) += 0.25*z4c.g_dd(m,a,b,k,j,i)
-                        *(z4c.vGam_u(m,a,k,j,i) - Gamma_u_z4c(a))
-                        *(z4c.vGam_u(m,b,k,j,i) - Gamma_u_z4c(b));
-    }
-
-    // Constraint violation monitor C^2
-    con.C(m,k,j,i) = SQR(con.H(m,k,j,i)) + con.M(m,k,j,i) +
-                     SQR(z4c.vTheta(m,k,j,i)) + 4.0*con.Z(m,k,j,i);
-});
-}
-template void Z4c::ADMConstraints<2>(MeshBlockPack *pmbp);
-template void Z4c::ADMConstraints<3>(MeshBlockPack *pmbp);
-template void Z4c::ADMConstraints<4>(MeshBlockPack *pmbp);
 } // namespace z4c
@@ -4,6 +4,7 @@
 // Licensed under the 3-clause BSD License (the "LICENSE")
 //========================================================================================
 
+#include <algorithm>
 #include <cstdio>
 #include <iostream>
 #include <limits>
@@ -15,6 +16,7 @@
 #include "parameter_input.hpp"
 #include "z4c/z4c.hpp"
 #include "z4c/z4c_puncture_tracker.hpp"
+#include "z4c/z4c_horizon_finder.hpp"
 
 #if 0
 #define PR(x)                                                                  \
@@ -45,11 +47,14 @@ namespace z4c {
 
 // set some parameters
 Z4c_AMR::Z4c_AMR(Z4c *z4c, ParameterInput *pin): pz4c(z4c), pin(pin) {
-  // available methods: "Linf_box_in_box", "L2_sphere_in_sphere", and
-  // "chi_min"
+  // available methods: "Linf_box_in_box", "L2_sphere_in_sphere", "chi_min",
+  // "dchi_max", and "trunc_err"
   ref_method = pin->GetOrAddString("z4c_amr", "method", "L2_sphere_in_sphere");
   chi_thresh = pin->GetOrAddReal("z4c_amr", "chi_min", 0.2);
   dchi_thresh = pin->GetOrAddReal("z4c_amr", "dchi_max", 0.1);
+  trunc_err_tol = pin->GetOrAddReal("z4c_amr", "trunc_err_tol", 1.0e-4);
+  horizon_refine = pin->GetOrAddBoolean("z4c_amr", "horizon_refine", true);
+  horizon_buffer = pin->GetOrAddReal("z4c_amr", "horizon_buffer", 0.25);
   x1max      = pin->GetReal("mesh", "x1max");
   x1min      = pin->GetReal("mesh", "x1min");
   half_initial_d = pin->GetOrAddReal("problem", "par_b", 1.);
@@ -67,11 +72,24 @@ void Z4c_AMR::Refine(MeshBlockPack *pmy_pack) {
     ChiMin(pmy_pack);
   } else if (ref_method == "dchi_max") {
     DchiMax(pmy_pack);
+  } else if (ref_method == "trunc_err") {
+    switch (pmy_pack->pmesh->mb_indcs.ng) {
+      case 2: TruncErr<2>(pmy_pack);
+              break;
+      case 3: TruncErr<3>(pmy_pack);
+              break;
+      case 4: TruncErr<4>(pmy_pack);
+              break;
+    }
   } else {
     std::stringstream msg;
     msg << "No such option for z4c/refinement" << std::endl;
     std::exit(EXIT_FAILURE);
   }
+  // apparent horizons found so far override the flags above
+  if (horizon_refine && !pz4c->horizon_finders.empty()) {
+    HorizonShell(pmy_pack);
+  }
 }
 
 // Mimicking box in box refinement with Linf
@@ -394,4 +412,103 @@ void Z4c_AMR::DchiMax(MeshBlockPack *pmbp) {
     });
 }
 
+// refine MeshBlocks that intersect a shell about each apparent horizon found to the
+// finest level, using the extent of the horizon widened by horizon_buffer on each side
+void Z4c_AMR::HorizonShell(MeshBlockPack *pmbp) {
+  Mesh *pmesh       = pmbp->pmesh;
+  auto &refine_flag = pmesh->pmr->refine_flag;
+  auto &size        = pmbp->pmb->mb_size;
+  int nmb           = pmbp->nmb_thispack;
+  int mbs           = pmesh->gids_eachrank[global_variable::my_rank];
+  int max_level     = pmesh->max_level - pmesh->root_level;
+
+  // flags may have been set on either host or device by the method above
+  Kokkos::fence();
+  Kokkos::deep_copy(refine_flag.h_view, refine_flag.d_view);
+
+  for (auto &pahf : pz4c->horizon_finders) {
+    if (!pahf->found) continue;
+    Real rin  = (1. - horizon_buffer) * pahf->rmin;
+    Real rout = (1. + horizon_buffer) * pahf->rmax;
+    for (int m = 0; m < nmb; ++m) {
+      int level = pmesh->lloc_eachmb[m + mbs].level - pmesh->root_level;
+      Real xmin[3] = {size.h_view(m).x1min, size.h_view(m).x2min, size.h_view(m).x3min};
+      Real xmax[3] = {size.h_view(m).x1max, size.h_view(m).x2max, size.h_view(m).x3max};
+      // nearest and farthest distance from the center of the horizon to the block
+      Real dmin2 = 0., dmax2 = 0.;
+      for (int a = 0; a < 3; ++a) {
+        Real c  = pahf->center[a];
+        Real dn = (c < xmin[a]) ? xmin[a] - c : ((c > xmax[a]) ? c - xmax[a] : 0.);
+        Real df = std::max(std::abs(c - xmin[a]), std::abs(c - xmax[a]));
+        dmin2 += dn * dn;
+        dmax2 += df * df;
+      }
+      if (std::sqrt(dmin2) <= rout && std::sqrt(dmax2) >= rin) {
+        refine_flag.h_view(m + mbs) = (level < max_level) ? 1 : 0;
+      }
+    }
+  }
+
+  // sync host and device
+  refine_flag.template modify<HostMemSpace>();
+  refine_flag.template sync<DevExeSpace>();
+}
+
+// refine based on an estimate of the local truncation error.  The undivided
+// difference of order 2*NGHOST (the stencil of the K-O dissipation applied in CalcRHS)
+// of chi and alpha scales as dx^(2*NGHOST) times the leading error term of the
+// derivative operators.  Refine where it exceeds trunc_err_tol, and de-refine where the
+// estimate on the coarser level, larger by 2^(2*NGHOST), would still be well below it.
+template <int NGHOST>
+void Z4c_AMR::TruncErr(MeshBlockPack *pmbp) {
+  Mesh *pmesh       = pmbp->pmesh;
+  int nmb           = pmbp->nmb_thispack;
+  int mbs           = pmesh->gids_eachrank[global_variable::my_rank];
+  auto &refine_flag = pmesh->pmr->refine_flag;
+  auto &size        = pmbp->pmb->mb_size;
+  auto &indcs       = pmesh->mb_indcs;
+  int &is = indcs.is, nx1 = indcs.nx1;
+  int &js = indcs.js, nx2 = indcs.nx2;
+  int &ks = indcs.ks, nx3 = indcs.nx3;
+  const int nkji = nx3 * nx2 * nx1;
+  const int nji  = nx2 * nx1;
+  auto &u0       = pmbp->pz4c->u0;
+  int I_Z4C_CHI  = pmbp->pz4c->I_Z4C_CHI;
+  int I_Z4C_ALPHA = pmbp->pz4c->I_Z4C_ALPHA;
+  // note: we need this to prevent capture by this in the lambda expr.
+  auto tol = this->trunc_err_tol;
+  Real deref_tol = 0.5 * tol / static_cast<Real>(1 << (2 * NGHOST));
+
+  par_for_outer(
+    "Z4c_AMR::TruncErr", DevExeSpace(), 0, 0, 0, (nmb - 1),
+    KOKKOS_LAMBDA(TeamMember_t tmember, const int m) {
+      Real dxi[] = {1/size.d_view(m).dx1, 1/size.d_view(m).dx2,
+                    1/size.d_view(m).dx3};
+      Real team_emax;
+      Kokkos::parallel_reduce(
+        Kokkos::TeamThreadRange(tmember, nkji),
+        [=](const int idx, Real &emax) {
+          int k = (idx) / nji;
+          int j = (idx - k * nji) / nx1;
+          int i = (idx - k * nji - j * nx1) + is;
+          j += js;
+          k += ks;
+          for (int a = 0; a < 3; ++a) {
+            // Diss returns the undivided difference divided by dx
+            Real e0 = Diss<NGHOST>(a, dxi, u0, m, I_Z4C_CHI, k, j, i) / dxi[a];
+            Real e1 = Diss<NGHOST>(a, dxi, u0, m, I_Z4C_ALPHA, k, j, i) / dxi[a];
+            emax = fmax(emax, fmax(fabs(e0), fabs(e1)));
+          }
+        },
+        Kokkos::Max<Real>(team_emax));
+
+      if (team_emax > tol) {
+        refine_flag.d_view(m + mbs) = 1;
+      }
+      if (team_emax < deref_tol) {
+        refine_flag.d_view(m + mbs) = -1;
+      }
+    });
+}
+
 } // namespace z4c
@@ -32,11 +32,17 @@ class Z4c_AMR {
   Real half_initial_d; // half of the initial separation,e.g.,two puncture par_b
   Real chi_thresh;     // chi threshold for chi refinement method
   Real dchi_thresh;    // dchi threshold for dchi refinement method
+  Real trunc_err_tol;  // tolerance for truncation error refinement method
+  bool horizon_refine; // refine MeshBlocks about apparent horizons to the finest level
+  Real horizon_buffer; // relative width of the shell refined about each horizon
  public:
   void LinfBoxInBox(MeshBlockPack *pmbp);     // Linf box in box method
   void L2SphereInSphere(MeshBlockPack *pmbp); // L2 Sphere in Sphere method
   void ChiMin(MeshBlockPack *pmbp);           // Refine based on min{chi}
   void DchiMax(MeshBlockPack *pmbp);           // Refine based on max{dchi}
+  template <int NGHOST>
+  void TruncErr(MeshBlockPack *pmbp);          // Refine based on truncation error
+  void HorizonShell(MeshBlockPack *pmbp);      // Refine about apparent horizons
 };
 
 } // namespace z4c
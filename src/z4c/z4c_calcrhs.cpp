@@ -8,7 +8,7 @@
 
 #include <math.h>
 
-//#include <algorithm>
+#include <algorithm>
 //#include <cinttypes>
 #include <iostream>
 //#include <limits>
@@ -19,161 +19,106 @@
 #include "z4c/z4c.hpp"
 #include "z4c/tmunu.hpp"
 #include "coordinates/cell_locations.hpp"
+#include "mhd/mhd.hpp"
+#include "dyn_grmhd/dyn_grmhd.hpp"
 
 namespace z4c {
 
-template <int NGHOST>
-//! \fn void Z4c::CalcRHS(Driver *pdriver, int stage)
-//! \brief compute rhs of the z4c equations
-TaskStatus Z4c::CalcRHS(Driver *pdriver, int stage) {
-  auto &indcs = pmy_pack->pmesh->mb_indcs;
-  auto &size = pmy_pack->pmb->mb_size;
-  int &is = indcs.is; int &ie = indcs.ie;
-  int &js = indcs.js; int &je = indcs.je;
-  int &ks = indcs.ks; int &ke = indcs.ke;
-
-  int nmb = pmy_pack->nmb_thispack;
-
-  auto &z4c = pmy_pack->pz4c->z4c;
-  auto &tmunu = pmy_pack->ptmunu->tmunu;
-  auto &rhs = pmy_pack->pz4c->rhs;
-  auto &opt = pmy_pack->pz4c->opt;
-
-  // ===================================================================================
-  // Main RHS calculation
-  //
-  par_for("z4c rhs loop",DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
-  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
-    // Define scratch arrays to be used in the following calculations
-
-    // Gamma computed from the metric
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> Gamma_u;
-    // Covariant derivative of A
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> DA_u;
-
-    // inverse of conf. metric
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> g_uu;
-    // inverse of A
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> A_uu;
-    // g^cd A_ac A_db
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> AA_dd;
-    // Ricci tensor
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> R_dd;
-    // Ricci tensor, conformal contribution
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> Rphi_dd;
-    // 2nd differential of the lapse
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> Ddalpha_dd;
-    // 2nd differential of phi
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> Ddphi_dd;
-
-    // Christoffel symbols of 1st kind
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_ddd;
-    // Christoffel symbols of 2nd kind
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_udd;
-
-    // auxiliary derivatives
-
-    // lapse 1st drvts
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dalpha_d;
-    // 2nd "divergence" of beta
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> ddbeta_d;
-    // chi 1st drvts
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dchi_d;
-    // phi 1st drvts
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dphi_d;
-    // Khat 1st drvts
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dKhat_d;
-    // Theta 1st drvts
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dTheta_d;
-
-    // lapse 2nd drvts
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> ddalpha_dd;
-    // shift 1st drvts
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 2> dbeta_du;
-    // chi 2nd drvts
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> ddchi_dd;
-    // Gamma 1st drvts
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 2> dGam_du;
-
-    // metric 1st drvts
-    AthenaScratchTensor<Real, TensorSymm::SYM2,  3, 3> dg_ddd;
-    // shift 2nd drvts
-    AthenaScratchTensor<Real, TensorSymm::ISYM2, 3, 3> ddbeta_ddu;
-
-    // metric 2nd drvts
-    AthenaScratchTensor<Real, TensorSymm::SYM22, 3, 4> ddg_dddd;
-
-    // Lie derivative of Gamma
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> LGam_u;
-    // Lie derivative of the shift
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> Lbeta_u;
-
-    // Lie derivative of conf. 3-metric
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> Lg_dd;
-    // Lie derivative of A
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> LA_dd;
-
-    Real idx[] = {1/size.d_view(m).dx1, 1/size.d_view(m).dx2, 1/size.d_view(m).dx3};
-
-    // -----------------------------------------------------------------------------------
-    // Initialize everything to zero
-    //
-    // Scalars
-
-    // auxiliary Lie derivatives along the shift vector
-    // Lie derivative of the lapse
-    Real Lalpha = 0.0;
-    // Lie derivative of chi
-    Real Lchi = 0.0;
-    // Lie derivative of Khat
-    Real LKhat = 0.0;
-    // Lie derivative of Theta
-    Real LTheta = 0.0;
-
-    // determinant of three metric
-    Real detg = 0.0;
-    // bounded version of chi
-    Real chi_guarded = 0.0;
-    // 1/psi4
-    Real oopsi4 = 0.0;
-    // trace of A
-    Real AA = 0.0;
-    // Ricci scalar
-    Real R = 0.0;
-    // tilde H
-    Real Ht = 0.0;
-    // trace of extrinsic curvature
-    Real K = 0.0;
-    // Trace of S_ik
-    Real S = 0.0;
-    // Trace of Ddalpha_dd
-    Real Ddalpha = 0.0;
-
-    // d_a beta^a
-    Real dbeta = 0.0;
-
-    //
-    // Vectors
+namespace {
+//----------------------------------------------------------------------------------------
+//! \struct Z4cScrField
+//! \brief one Z4c variable in a brick of u0 staged in team scratch.  Provides the same
+//! (m,[a,[b,]]k,j,i) interface as the AthenaTensors in Z4c_vars, with (k,j,i) the indices
+//! in the MeshBlock, so finite differences and the RHS can be evaluated from scratch
+//! with the same code as from global memory.  Index m is ignored.
+
+struct Z4cScrField {
+  ScrArray4D<Real> u;  // brick of all variables (n,k,j,i) including ghost zones
+  int n0;              // index of first component of this variable in u
+  int k0, j0, i0;      // MeshBlock indices of first cell in brick
+
+  KOKKOS_INLINE_FUNCTION
+  Real &operator()(int m, int k, int j, int i) const {
+    return u(n0, k-k0, j-j0, i-i0);
+  }
+  KOKKOS_INLINE_FUNCTION
+  Real &operator()(int m, int a, int k, int j, int i) const {
+    return u(n0 + a, k-k0, j-j0, i-i0);
+  }
+  // symmetric 2-tensors are stored as (xx,xy,xz,yy,yz,zz)
+  KOKKOS_INLINE_FUNCTION
+  Real &operator()(int m, int a, int b, int k, int j, int i) const {
+    int lo = (a < b)? a : b;
+    int hi = (a < b)? b : a;
+    return u(n0 + (lo*(5 - lo))/2 + hi, k-k0, j-j0, i-i0);
+  }
+};
+
+struct Z4cScrVars {
+  Z4cScrField chi, vKhat, vTheta, alpha, vGam_u, beta_u, g_dd, vA_dd;
+};
+
+//----------------------------------------------------------------------------------------
+//! \struct Z4cDerivs
+//! \brief finite-difference and advective derivatives of the Z4c variables in one cell.
+//! These are all the stencil operations of the RHS.  The remaining algebra only needs
+//! the derivatives and the variables in the cell itself, so for the split RHS the
+//! derivatives are stored in a global array between the two passes.
+
+struct Z4cDerivs {
+  // lapse 1st drvts
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dalpha_d;
+  // chi 1st drvts
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dchi_d;
+  // Khat 1st drvts
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dKhat_d;
+  // Theta 1st drvts
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dTheta_d;
+  // lapse 2nd drvts
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> ddalpha_dd;
+  // shift 1st drvts
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 2> dbeta_du;
+  // chi 2nd drvts
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> ddchi_dd;
+  // Gamma 1st drvts
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 2> dGam_du;
+  // metric 1st drvts
+  AthenaScratchTensor<Real, TensorSymm::SYM2,  3, 3> dg_ddd;
+  // shift 2nd drvts
+  AthenaScratchTensor<Real, TensorSymm::ISYM2, 3, 3> ddbeta_ddu;
+  // metric 2nd drvts
+  AthenaScratchTensor<Real, TensorSymm::SYM22, 3, 4> ddg_dddd;
+
+  // auxiliary Lie derivatives along the shift vector
+  Real Lalpha, Lchi, LKhat, LTheta;
+  // Lie derivative of Gamma
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> LGam_u;
+  // Lie derivative of the shift
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> Lbeta_u;
+  // Lie derivative of conf. 3-metric
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> Lg_dd;
+  // Lie derivative of A
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> LA_dd;
+
+  // number of independent components of all of the above
+  static constexpr int ndof = 12 + 18 + 18 + 12 + 18 + 36 + 22;
+
+  template <int NGHOST, typename Z4C_VARS>
+  KOKKOS_INLINE_FUNCTION
+  void Compute(const Z4C_VARS &z4c, const Real idx[],
+               const int m, const int k, const int j, const int i) {
+    Lalpha = 0.0;
+    Lchi = 0.0;
+    LKhat = 0.0;
+    LTheta = 0.0;
     for (int a = 0; a < 3; ++a) {
       Lbeta_u(a) = 0.0;
       LGam_u(a) = 0.0;
-      Gamma_u(a) = 0.0;
-      DA_u(a) = 0.0;
-      ddbeta_d(a) = 0.0;
     }
-
-    //
-    // Symmetric tensors
     for (int a = 0; a < 3; ++a)
     for (int b = a; b < 3; ++b) {
       Lg_dd(a,b) = 0.0;
       LA_dd(a,b) = 0.0;
-      AA_dd(a,b) = 0.0;
-      R_dd(a,b) = 0.0;
-      A_uu(a,b) = 0.0;
-      for (int c = 0; c < 3; ++c) {
-          Gamma_udd(c,a,b) = 0.0;
-      }
     }
 
     // -----------------------------------------------------------------------------------
@@ -194,11 +139,15 @@ TaskStatus Z4c::CalcRHS(Driver *pdriver, int stage) {
       dGam_du(b,a) = Dx<NGHOST>(b, idx, z4c.vGam_u,  m,a,k,j,i);
     }
 
-    // Tensors
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b)
+    // Tensors (all components of g from one stencil in each direction)
     for(int c = 0; c < 3; ++c) {
-      dg_ddd(c,a,b) = Dx<NGHOST>(c, idx, z4c.g_dd, m,a,b,k,j,i);
+      Real dg[6];
+      DxSym<NGHOST>(c, idx, z4c.g_dd, m,k,j,i, dg);
+      int n = 0;
+      for(int a = 0; a < 3; ++a)
+      for(int b = a; b < 3; ++b) {
+        dg_ddd(c,a,b) = dg[n++];
+      }
     }
 
     // -----------------------------------------------------------------------------------
@@ -263,307 +212,658 @@ TaskStatus Z4c::CalcRHS(Driver *pdriver, int stage) {
       Lg_dd(a,b) += Lx<NGHOST>(c, idx, z4c.beta_u, z4c.g_dd, m,c,a,b,k,j,i);
       LA_dd(a,b) += Lx<NGHOST>(c, idx, z4c.beta_u, z4c.vA_dd, m,c,a,b,k,j,i);
     }
-
-    // -----------------------------------------------------------------------------------
-    // Get K from Khat
-    //
-    K = z4c.vKhat(m,k,j,i) + 2.*z4c.vTheta(m,k,j,i);
-
-    // -----------------------------------------------------------------------------------
-    // Inverse metric
-
-    detg = adm::SpatialDet(z4c.g_dd(m,0,0,k,j,i), z4c.g_dd(m,0,1,k,j,i),
-                              z4c.g_dd(m,0,2,k,j,i), z4c.g_dd(m,1,1,k,j,i),
-                              z4c.g_dd(m,1,2,k,j,i), z4c.g_dd(m,2,2,k,j,i));
-    adm::SpatialInv(1.0/detg,
-               z4c.g_dd(m,0,0,k,j,i), z4c.g_dd(m,0,1,k,j,i), z4c.g_dd(m,0,2,k,j,i),
-               z4c.g_dd(m,1,1,k,j,i), z4c.g_dd(m,1,2,k,j,i), z4c.g_dd(m,2,2,k,j,i),
-               &g_uu(0,0), &g_uu(0,1), &g_uu(0,2),
-               &g_uu(1,1), &g_uu(1,2), &g_uu(2,2));
-
-    // -----------------------------------------------------------------------------------
-    // Christoffel symbols
-
-    for(int c = 0; c < 3; ++c)
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      Gamma_ddd(c,a,b) = 0.5*(dg_ddd(a,b,c) + dg_ddd(b,a,c) - dg_ddd(c,a,b));
+  }
+
+  // Copies independent components to (STORE=true) or from (STORE=false) components
+  // n0,...,n0+ndof-1 of u, in the same order in which they are computed.
+  template <bool STORE>
+  KOKKOS_INLINE_FUNCTION
+  void Copy(const DvceArray5D<Real> &u, const int n0,
+            const int m, const int k, const int j, const int i) {
+    int n = n0;
+    auto cp = [&](Real &v) {
+      if constexpr (STORE) {
+        u(m,n,k,j,i) = v;
+      } else {
+        v = u(m,n,k,j,i);
+      }
+      n++;
+    };
+    for(int a = 0; a < 3; ++a) {
+      cp(dalpha_d(a)); cp(dchi_d(a)); cp(dKhat_d(a)); cp(dTheta_d(a));
     }
-    for(int c = 0; c < 3; ++c)
     for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b)
-    for(int d = 0; d < 3; ++d) {
-      Gamma_udd(c,a,b) += g_uu(c,d)*Gamma_ddd(d,a,b);
+    for(int b = 0; b < 3; ++b) {
+      cp(dbeta_du(b,a)); cp(dGam_du(b,a));
     }
-    // Gamma's computed from the conformal metric (not evolved)
     for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b)
+    for(int b = a; b < 3; ++b)
     for(int c = 0; c < 3; ++c) {
-      Gamma_u(a) += g_uu(b,c)*Gamma_udd(a,b,c);
+      cp(dg_ddd(c,a,b));
     }
-
-    // -----------------------------------------------------------------------------------
-    // Curvature of conformal metric
-    //
     for(int a = 0; a < 3; ++a)
     for(int b = a; b < 3; ++b) {
-      for(int c = 0; c < 3; ++c) {
-        R_dd(a,b) += 0.5*(z4c.g_dd(m,c,a,k,j,i)*dGam_du(b,c) +
-                          z4c.g_dd(m,c,b,k,j,i)*dGam_du(a,c) +
-                          Gamma_u(c)*(Gamma_ddd(a,b,c) + Gamma_ddd(b,a,c)));
-      }
-      for(int c = 0; c < 3; ++c)
-      for(int d = 0; d < 3; ++d) {
-        R_dd(a,b) -= 0.5*g_uu(c,d)*ddg_dddd(c,d,a,b);
-      }
-      for(int c = 0; c < 3; ++c)
-      for(int d = 0; d < 3; ++d)
-      for(int e = 0; e < 3; ++e) {
-        R_dd(a,b) += g_uu(c,d)*(
-            Gamma_udd(e,c,a)*Gamma_ddd(b,e,d) +
-            Gamma_udd(e,c,b)*Gamma_ddd(a,e,d) +
-            Gamma_udd(e,a,d)*Gamma_ddd(e,c,b));
-      }
-    }
-
-    // -----------------------------------------------------------------------------------
-    // Derivatives of conformal factor phi
-    //
-    chi_guarded = (z4c.chi(m,k,j,i)>opt.chi_div_floor)
-                    ? z4c.chi(m,k,j,i) : opt.chi_div_floor;
-    oopsi4 = pow(chi_guarded, -4./opt.chi_psi_power);
-    for(int a = 0; a < 3; ++a) {
-      dphi_d(a) = dchi_d(a)/(chi_guarded * opt.chi_psi_power);
+      cp(ddalpha_dd(a,b)); cp(ddchi_dd(a,b));
     }
+    for(int c = 0; c < 3; ++c)
     for(int a = 0; a < 3; ++a)
     for(int b = a; b < 3; ++b) {
-      Ddphi_dd(a,b) = ddchi_dd(a,b)/(chi_guarded * opt.chi_psi_power) -
-        opt.chi_psi_power * dphi_d(a) * dphi_d(b);
-      for(int c = 0; c < 3; ++c) {
-        Ddphi_dd(a,b) -= Gamma_udd(c,a,b)*dphi_d(c);
-      }
+      cp(ddbeta_ddu(a,b,c));
     }
-
-    // -----------------------------------------------------------------------------------
-    // Curvature contribution from conformal factor
-    //
+    for(int c = 0; c < 3; ++c)
+    for(int d = c; d < 3; ++d)
     for(int a = 0; a < 3; ++a)
     for(int b = a; b < 3; ++b) {
-      Rphi_dd(a,b) = 4.*dphi_d(a)*dphi_d(b) - 2.*Ddphi_dd(a,b);
-      for(int c = 0; c < 3; ++c)
-      for(int d = 0; d < 3; ++d) {
-        Rphi_dd(a,b) -= 2.*z4c.g_dd(m,a,b,k,j,i) * g_uu(c,d)*(Ddphi_dd(c,d) +
-            2.*dphi_d(c)*dphi_d(d));
-      }
+      cp(ddg_dddd(a,b,c,d));
     }
-
-    // TODO(JMF): Update with Tmunu terms.
-    // -----------------------------------------------------------------------------------
-    // Trace of the matter stress tensor
-    //
-    // Matter commented out
-    //S.ZeroClear();
-    //member.team_barrier();
-    //for(int a = 0; a < 3; ++a)
-    //for(int b = 0; b < 3; ++b) {
-    //  ILOOP1(1) {
-    //    S(1) += oopsi4(1) * g_uu(a,b,i) * mat.S_dd(m,a,b,k,j,i);
-    //  }
-    //}
-    for (int a = 0; a < 3; ++a)
-    for (int b = 0; b < 3; ++b) {
-      S += oopsi4 * g_uu(a,b) * tmunu.S_dd(m,a,b,k,j,i);
+    cp(Lalpha); cp(Lchi); cp(LKhat); cp(LTheta);
+    for(int a = 0; a < 3; ++a) {
+      cp(Lbeta_u(a)); cp(LGam_u(a));
     }
-
-    // -----------------------------------------------------------------------------------
-    // 2nd covariant derivative of the lapse
-    // TODO(JMF): This could potentially be sped up by calculating d_i phi d^i alpha
-    // beforehand.
     for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b) {
-      Ddalpha_dd(a,b) = ddalpha_dd(a,b)
-                       - 2.*(dphi_d(a)*dalpha_d(b) + dphi_d(b)*dalpha_d(a));
-      for(int c = 0; c < 3; ++c) {
-        Ddalpha_dd(a,b) -= Gamma_udd(c,a,b)*dalpha_d(c);
-        for(int d = 0; d < 3; ++d) {
-            Ddalpha_dd(a,b) += 2.*z4c.g_dd(m,a,b,k,j,i) * g_uu(c,d)
-            * dphi_d(c) * dalpha_d(d);
-        }
-      }
-    }
+    for(int b = a; b < 3; ++b) {
+      cp(Lg_dd(a,b)); cp(LA_dd(a,b));
+    }
+  }
+};
+
+//----------------------------------------------------------------------------------------
+//! \fn void Z4cAlgebraCell()
+//! \brief computes rhs of the z4c equations in one cell from the variables and their
+//! derivatives in that cell. Z4C_VARS is either Z4c_vars, for variables read from global
+//! memory, or Z4cScrVars, for variables read from scratch.  TMUNU is either
+//! TmunuFromArrays or TmunuFromFluid, which evaluates the matter sources on the fly.
+//! Overwrites the Lie derivatives in der.
+
+template <typename Z4C_VARS, typename TMUNU>
+KOKKOS_INLINE_FUNCTION
+void Z4cAlgebraCell(const Z4C_VARS &z4c, Z4cDerivs &der, const Z4c::Z4c_vars &rhs,
+                    const TMUNU &tmunu, const Z4c::Options &opt,
+                    const int m, const int k, const int j, const int i) {
+  auto &dalpha_d = der.dalpha_d;
+  auto &dchi_d = der.dchi_d;
+  auto &dKhat_d = der.dKhat_d;
+  auto &dTheta_d = der.dTheta_d;
+  auto &ddalpha_dd = der.ddalpha_dd;
+  auto &dbeta_du = der.dbeta_du;
+  auto &ddchi_dd = der.ddchi_dd;
+  auto &dGam_du = der.dGam_du;
+  auto &dg_ddd = der.dg_ddd;
+  auto &ddbeta_ddu = der.ddbeta_ddu;
+  auto &ddg_dddd = der.ddg_dddd;
+  auto &Lalpha = der.Lalpha;
+  auto &Lchi = der.Lchi;
+  auto &LKhat = der.LKhat;
+  auto &LTheta = der.LTheta;
+  auto &LGam_u = der.LGam_u;
+  auto &Lbeta_u = der.Lbeta_u;
+  auto &Lg_dd = der.Lg_dd;
+  auto &LA_dd = der.LA_dd;
+
+  // Define scratch arrays to be used in the following calculations
+
+  // Gamma computed from the metric
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> Gamma_u;
+  // Covariant derivative of A
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> DA_u;
+
+  // inverse of conf. metric
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> g_uu;
+  // inverse of A
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> A_uu;
+  // g^cd A_ac A_db
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> AA_dd;
+  // Ricci tensor
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> R_dd;
+  // Ricci tensor, conformal contribution
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> Rphi_dd;
+  // 2nd differential of the lapse
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> Ddalpha_dd;
+  // 2nd differential of phi
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> Ddphi_dd;
+
+  // Christoffel symbols of 1st kind
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_ddd;
+  // Christoffel symbols of 2nd kind
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_udd;
+
+  // 2nd "divergence" of beta
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> ddbeta_d;
+  // phi 1st drvts
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dphi_d;
+
+  // -----------------------------------------------------------------------------------
+  // Initialize everything to zero
+  //
+  // Scalars
+
+  // determinant of three metric
+  Real detg = 0.0;
+  // bounded version of chi
+  Real chi_guarded = 0.0;
+  // 1/psi4
+  Real oopsi4 = 0.0;
+  // trace of A
+  Real AA = 0.0;
+  // Ricci scalar
+  Real R = 0.0;
+  // tilde H
+  Real Ht = 0.0;
+  // trace of extrinsic curvature
+  Real K = 0.0;
+  // Trace of S_ik
+  Real S = 0.0;
+  // Trace of Ddalpha_dd
+  Real Ddalpha = 0.0;
+
+  // d_a beta^a
+  Real dbeta = 0.0;
 
-    for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b) {
-      Ddalpha += oopsi4 * g_uu(a,b) * Ddalpha_dd(a,b);
-    }
+  //
+  // Vectors
+  for (int a = 0; a < 3; ++a) {
+    Gamma_u(a) = 0.0;
+    DA_u(a) = 0.0;
+    ddbeta_d(a) = 0.0;
+  }
 
-    // -----------------------------------------------------------------------------------
-    // Contractions of A_ab, inverse, and derivatives
-    //
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b)
+  //
+  // Symmetric tensors
+  for (int a = 0; a < 3; ++a)
+  for (int b = a; b < 3; ++b) {
+    AA_dd(a,b) = 0.0;
+    R_dd(a,b) = 0.0;
+    A_uu(a,b) = 0.0;
+    for (int c = 0; c < 3; ++c) {
+        Gamma_udd(c,a,b) = 0.0;
+    }
+  }
+
+  // -----------------------------------------------------------------------------------
+  // Get K from Khat
+  //
+  K = z4c.vKhat(m,k,j,i) + 2.*z4c.vTheta(m,k,j,i);
+
+  // -----------------------------------------------------------------------------------
+  // Inverse metric
+
+  detg = adm::SpatialDet(z4c.g_dd(m,0,0,k,j,i), z4c.g_dd(m,0,1,k,j,i),
+                            z4c.g_dd(m,0,2,k,j,i), z4c.g_dd(m,1,1,k,j,i),
+                            z4c.g_dd(m,1,2,k,j,i), z4c.g_dd(m,2,2,k,j,i));
+  adm::SpatialInv(1.0/detg,
+             z4c.g_dd(m,0,0,k,j,i), z4c.g_dd(m,0,1,k,j,i), z4c.g_dd(m,0,2,k,j,i),
+             z4c.g_dd(m,1,1,k,j,i), z4c.g_dd(m,1,2,k,j,i), z4c.g_dd(m,2,2,k,j,i),
+             &g_uu(0,0), &g_uu(0,1), &g_uu(0,2),
+             &g_uu(1,1), &g_uu(1,2), &g_uu(2,2));
+
+  // -----------------------------------------------------------------------------------
+  // Christoffel symbols
+
+  for(int c = 0; c < 3; ++c)
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b) {
+    Gamma_ddd(c,a,b) = 0.5*(dg_ddd(a,b,c) + dg_ddd(b,a,c) - dg_ddd(c,a,b));
+  }
+  for(int c = 0; c < 3; ++c)
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b)
+  for(int d = 0; d < 3; ++d) {
+    Gamma_udd(c,a,b) += g_uu(c,d)*Gamma_ddd(d,a,b);
+  }
+  // Gamma's computed from the conformal metric (not evolved)
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b)
+  for(int c = 0; c < 3; ++c) {
+    Gamma_u(a) += g_uu(b,c)*Gamma_udd(a,b,c);
+  }
+
+  // -----------------------------------------------------------------------------------
+  // Curvature of conformal metric
+  //
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b) {
+    for(int c = 0; c < 3; ++c) {
+      R_dd(a,b) += 0.5*(z4c.g_dd(m,c,a,k,j,i)*dGam_du(b,c) +
+                        z4c.g_dd(m,c,b,k,j,i)*dGam_du(a,c) +
+                        Gamma_u(c)*(Gamma_ddd(a,b,c) + Gamma_ddd(b,a,c)));
+    }
     for(int c = 0; c < 3; ++c)
     for(int d = 0; d < 3; ++d) {
-      AA_dd(a,b) += g_uu(c,d) * z4c.vA_dd(m,a,c,k,j,i) * z4c.vA_dd(m,d,b,k,j,i);
+      R_dd(a,b) -= 0.5*g_uu(c,d)*ddg_dddd(c,d,a,b);
     }
-    for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b) {
-      AA += g_uu(a,b) * AA_dd(a,b);
+    for(int c = 0; c < 3; ++c)
+    for(int d = 0; d < 3; ++d)
+    for(int e = 0; e < 3; ++e) {
+      R_dd(a,b) += g_uu(c,d)*(
+          Gamma_udd(e,c,a)*Gamma_ddd(b,e,d) +
+          Gamma_udd(e,c,b)*Gamma_ddd(a,e,d) +
+          Gamma_udd(e,a,d)*Gamma_ddd(e,c,b));
     }
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b)
+  }
+
+  // -----------------------------------------------------------------------------------
+  // Derivatives of conformal factor phi
+  //
+  chi_guarded = (z4c.chi(m,k,j,i)>opt.chi_div_floor)
+                  ? z4c.chi(m,k,j,i) : opt.chi_div_floor;
+  oopsi4 = pow(chi_guarded, -4./opt.chi_psi_power);
+  for(int a = 0; a < 3; ++a) {
+    dphi_d(a) = dchi_d(a)/(chi_guarded * opt.chi_psi_power);
+  }
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b) {
+    Ddphi_dd(a,b) = ddchi_dd(a,b)/(chi_guarded * opt.chi_psi_power) -
+      opt.chi_psi_power * dphi_d(a) * dphi_d(b);
+    for(int c = 0; c < 3; ++c) {
+      Ddphi_dd(a,b) -= Gamma_udd(c,a,b)*dphi_d(c);
+    }
+  }
+
+  // -----------------------------------------------------------------------------------
+  // Curvature contribution from conformal factor
+  //
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b) {
+    Rphi_dd(a,b) = 4.*dphi_d(a)*dphi_d(b) - 2.*Ddphi_dd(a,b);
     for(int c = 0; c < 3; ++c)
     for(int d = 0; d < 3; ++d) {
-      A_uu(a,b) += g_uu(a,c) * g_uu(b,d) * z4c.vA_dd(m,c,d,k,j,i);
-    }
-    // TODO(JMF): dchi_d/chi_guarded is opt.chi_psi_power * dphi_d.
-    for(int a = 0; a < 3; ++a) {
-      for(int b = 0; b < 3; ++b) {
-          DA_u(a) -= (3./2.) * A_uu(a,b) * dchi_d(b) / chi_guarded;
-          DA_u(a) -= (1./3.) * g_uu(a,b) * (2.*dKhat_d(b) + dTheta_d(b));
-      }
-      for(int b = 0; b < 3; ++b)
-      for(int c = 0; c < 3; ++c) {
-        DA_u(a) += Gamma_udd(a,b,c) * A_uu(b,c);
-      }
+      Rphi_dd(a,b) -= 2.*z4c.g_dd(m,a,b,k,j,i) * g_uu(c,d)*(Ddphi_dd(c,d) +
+          2.*dphi_d(c)*dphi_d(d));
     }
+  }
 
-    // -----------------------------------------------------------------------------------
-    // Ricci scalar
-    //
-    for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b) {
-      R += oopsi4 * g_uu(a,b) * (R_dd(a,b) + Rphi_dd(a,b));
+  // TODO(JMF): Update with Tmunu terms.
+  // -----------------------------------------------------------------------------------
+  // Trace of the matter stress tensor
+  //
+  // Matter commented out
+  //S.ZeroClear();
+  //member.team_barrier();
+  //for(int a = 0; a < 3; ++a)
+  //for(int b = 0; b < 3; ++b) {
+  //  ILOOP1(1) {
+  //    S(1) += oopsi4(1) * g_uu(a,b,i) * mat.S_dd(m,a,b,k,j,i);
+  //  }
+  //}
+  Real E, S_d[3], S_dd[3][3];
+  tmunu(m, k, j, i, E, S_d, S_dd);
+  for (int a = 0; a < 3; ++a)
+  for (int b = 0; b < 3; ++b) {
+    S += oopsi4 * g_uu(a,b) * S_dd[a][b];
+  }
+
+  // -----------------------------------------------------------------------------------
+  // 2nd covariant derivative of the lapse
+  // TODO(JMF): This could potentially be sped up by calculating d_i phi d^i alpha
+  // beforehand.
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b) {
+    Ddalpha_dd(a,b) = ddalpha_dd(a,b)
+                     - 2.*(dphi_d(a)*dalpha_d(b) + dphi_d(b)*dalpha_d(a));
+    for(int c = 0; c < 3; ++c) {
+      Ddalpha_dd(a,b) -= Gamma_udd(c,a,b)*dalpha_d(c);
+      for(int d = 0; d < 3; ++d) {
+          Ddalpha_dd(a,b) += 2.*z4c.g_dd(m,a,b,k,j,i) * g_uu(c,d)
+          * dphi_d(c) * dalpha_d(d);
+      }
     }
+  }
 
-    // -----------------------------------------------------------------------------------
-    // Hamiltonian constraint
-    //
-    Ht = R + (2./3.)*SQR(K) - AA;// - 16.*M_PI*tmunu.E(m,k,j,i);
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b) {
+    Ddalpha += oopsi4 * g_uu(a,b) * Ddalpha_dd(a,b);
+  }
 
-    // -----------------------------------------------------------------------------------
-    // Finalize advective (Lie) derivatives
-    //
-    // Shift vector contractions
-    for(int a = 0; a < 3; ++a) {
-      dbeta += dbeta_du(a,a);
-    }
-    for(int a = 0; a < 3; ++a)
+  // -----------------------------------------------------------------------------------
+  // Contractions of A_ab, inverse, and derivatives
+  //
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b)
+  for(int c = 0; c < 3; ++c)
+  for(int d = 0; d < 3; ++d) {
+    AA_dd(a,b) += g_uu(c,d) * z4c.vA_dd(m,a,c,k,j,i) * z4c.vA_dd(m,d,b,k,j,i);
+  }
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b) {
+    AA += g_uu(a,b) * AA_dd(a,b);
+  }
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b)
+  for(int c = 0; c < 3; ++c)
+  for(int d = 0; d < 3; ++d) {
+    A_uu(a,b) += g_uu(a,c) * g_uu(b,d) * z4c.vA_dd(m,c,d,k,j,i);
+  }
+  // TODO(JMF): dchi_d/chi_guarded is opt.chi_psi_power * dphi_d.
+  for(int a = 0; a < 3; ++a) {
     for(int b = 0; b < 3; ++b) {
-      ddbeta_d(a) += (1./3.) * ddbeta_ddu(a,b,b);
+        DA_u(a) -= (3./2.) * A_uu(a,b) * dchi_d(b) / chi_guarded;
+        DA_u(a) -= (1./3.) * g_uu(a,b) * (2.*dKhat_d(b) + dTheta_d(b));
     }
+    for(int b = 0; b < 3; ++b)
+    for(int c = 0; c < 3; ++c) {
+      DA_u(a) += Gamma_udd(a,b,c) * A_uu(b,c);
+    }
+  }
 
-    // Finalize Lchi
-    Lchi += (1./6.) * opt.chi_psi_power * chi_guarded * dbeta;
+  // -----------------------------------------------------------------------------------
+  // Ricci scalar
+  //
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b) {
+    R += oopsi4 * g_uu(a,b) * (R_dd(a,b) + Rphi_dd(a,b));
+  }
 
-    // Finalize LGam_u (note that this is not a real Lie derivative)
-    for(int a = 0; a < 3; ++a) {
-      LGam_u(a) += (2./3.) * Gamma_u(a) * dbeta;
-      for(int b = 0; b < 3; ++b) {
-        LGam_u(a) += g_uu(a,b) * ddbeta_d(b) - Gamma_u(b) * dbeta_du(b,a);
-        for(int c = 0; c < 3; ++c) {
-          LGam_u(a) += g_uu(b,c) * ddbeta_ddu(b,c,a);
-        }
-      }
-    }
+  // -----------------------------------------------------------------------------------
+  // Hamiltonian constraint
+  //
+  Ht = R + (2./3.)*SQR(K) - AA;// - 16.*M_PI*tmunu.E(m,k,j,i);
 
-    // Finalize Lg_dd and LA_dd
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      Lg_dd(a,b) -= (2./3.) * z4c.g_dd(m,a,b,k,j,i) * dbeta;
-      for(int c = 0; c < 3; ++c) {
-        Lg_dd(a,b) += dbeta_du(a,c) * z4c.g_dd(m,b,c,k,j,i);
-        Lg_dd(a,b) += dbeta_du(b,c) * z4c.g_dd(m,a,c,k,j,i);
-      }
-    }
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      LA_dd(a,b) -= (2./3.) * z4c.vA_dd(m,a,b,k,j,i) * dbeta;
+  // -----------------------------------------------------------------------------------
+  // Finalize advective (Lie) derivatives
+  //
+  // Shift vector contractions
+  for(int a = 0; a < 3; ++a) {
+    dbeta += dbeta_du(a,a);
+  }
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b) {
+    ddbeta_d(a) += (1./3.) * ddbeta_ddu(a,b,b);
+  }
+
+  // Finalize Lchi
+  Lchi += (1./6.) * opt.chi_psi_power * chi_guarded * dbeta;
+
+  // Finalize LGam_u (note that this is not a real Lie derivative)
+  for(int a = 0; a < 3; ++a) {
+    LGam_u(a) += (2./3.) * Gamma_u(a) * dbeta;
+    for(int b = 0; b < 3; ++b) {
+      LGam_u(a) += g_uu(a,b) * ddbeta_d(b) - Gamma_u(b) * dbeta_du(b,a);
       for(int c = 0; c < 3; ++c) {
-        LA_dd(a,b) += dbeta_du(b,c) * z4c.vA_dd(m,a,c,k,j,i);
-        LA_dd(a,b) += dbeta_du(a,c) * z4c.vA_dd(m,b,c,k,j,i);
+        LGam_u(a) += g_uu(b,c) * ddbeta_ddu(b,c,a);
       }
     }
+  }
 
-    // -----------------------------------------------------------------------------------
-    // Assemble RHS
-    //
-    // Khat, chi, and Theta
-    rhs.vKhat(m,k,j,i) = - Ddalpha + z4c.alpha(m,k,j,i)
-      * (AA + (1./3.)*SQR(K)) +
-      LKhat + opt.damp_kappa1*(1 - opt.damp_kappa2)
-      * z4c.alpha(m,k,j,i) * z4c.vTheta(m,k,j,i);
-    // Matter term
-    rhs.vKhat(m,k,j,i) += 4.*M_PI * z4c.alpha(m,k,j,i) * (S + tmunu.E(m,k,j,i));
-    rhs.chi(m,k,j,i) = Lchi - (1./6.) * opt.chi_psi_power *
-      chi_guarded * z4c.alpha(m,k,j,i) * K;
-    rhs.vTheta(m,k,j,i) = LTheta + z4c.alpha(m,k,j,i) * (
-        0.5*Ht - (2. + opt.damp_kappa2) * opt.damp_kappa1 * z4c.vTheta(m,k,j,i));
-    // Matter term
-    rhs.vTheta(m,k,j,i) -= 8.*M_PI * z4c.alpha(m,k,j,i) * tmunu.E(m,k,j,i);
-    // If BSSN is enabled, theta is disabled.
-    rhs.vTheta(m,k,j,i) *= opt.use_z4c;
-    // Gamma's
-    for(int a = 0; a < 3; ++a) {
-      rhs.vGam_u(m,a,k,j,i) = 2.*z4c.alpha(m,k,j,i)*DA_u(a) + LGam_u(a);
-      rhs.vGam_u(m,a,k,j,i) -= 2.*z4c.alpha(m,k,j,i) * opt.damp_kappa1 *
-          (z4c.vGam_u(m,a,k,j,i) - Gamma_u(a));
-      for(int b = 0; b < 3; ++b) {
-        rhs.vGam_u(m,a,k,j,i) -= 2. * A_uu(a,b) * dalpha_d(b);
-        // Matter term
-        rhs.vGam_u(m,a,k,j,i) -= 16.*M_PI * z4c.alpha(m,k,j,i)
-                              * g_uu(a,b) * tmunu.S_d(m,b,k,j,i);
-      }
+  // Finalize Lg_dd and LA_dd
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b) {
+    Lg_dd(a,b) -= (2./3.) * z4c.g_dd(m,a,b,k,j,i) * dbeta;
+    for(int c = 0; c < 3; ++c) {
+      Lg_dd(a,b) += dbeta_du(a,c) * z4c.g_dd(m,b,c,k,j,i);
+      Lg_dd(a,b) += dbeta_du(b,c) * z4c.g_dd(m,a,c,k,j,i);
     }
+  }
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b) {
+    LA_dd(a,b) -= (2./3.) * z4c.vA_dd(m,a,b,k,j,i) * dbeta;
+    for(int c = 0; c < 3; ++c) {
+      LA_dd(a,b) += dbeta_du(b,c) * z4c.vA_dd(m,a,c,k,j,i);
+      LA_dd(a,b) += dbeta_du(a,c) * z4c.vA_dd(m,b,c,k,j,i);
+    }
+  }
 
-    // g and A
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      rhs.g_dd(m,a,b,k,j,i) = - 2. * z4c.alpha(m,k,j,i) * z4c.vA_dd(m,a,b,k,j,i)
-                      + Lg_dd(a,b);
-      rhs.vA_dd(m,a,b,k,j,i) = oopsi4 *
-          (-Ddalpha_dd(a,b) + z4c.alpha(m,k,j,i) * (R_dd(a,b) + Rphi_dd(a,b)));
-      rhs.vA_dd(m,a,b,k,j,i) -= (1./3.) * z4c.g_dd(m,a,b,k,j,i)
-                             * (-Ddalpha + z4c.alpha(m,k,j,i)*R);
-      rhs.vA_dd(m,a,b,k,j,i) += z4c.alpha(m,k,j,i) * (K*z4c.vA_dd(m,a,b,k,j,i)
-                             - 2.*AA_dd(a,b));
-      rhs.vA_dd(m,a,b,k,j,i) += LA_dd(a,b);
+  // -----------------------------------------------------------------------------------
+  // Assemble RHS
+  //
+  // Khat, chi, and Theta
+  rhs.vKhat(m,k,j,i) = - Ddalpha + z4c.alpha(m,k,j,i)
+    * (AA + (1./3.)*SQR(K)) +
+    LKhat + opt.damp_kappa1*(1 - opt.damp_kappa2)
+    * z4c.alpha(m,k,j,i) * z4c.vTheta(m,k,j,i);
+  // Matter term
+  rhs.vKhat(m,k,j,i) += 4.*M_PI * z4c.alpha(m,k,j,i) * (S + E);
+  rhs.chi(m,k,j,i) = Lchi - (1./6.) * opt.chi_psi_power *
+    chi_guarded * z4c.alpha(m,k,j,i) * K;
+  rhs.vTheta(m,k,j,i) = LTheta + z4c.alpha(m,k,j,i) * (
+      0.5*Ht - (2. + opt.damp_kappa2) * opt.damp_kappa1 * z4c.vTheta(m,k,j,i));
+  // Matter term
+  rhs.vTheta(m,k,j,i) -= 8.*M_PI * z4c.alpha(m,k,j,i) * E;
+  // If BSSN is enabled, theta is disabled.
+  rhs.vTheta(m,k,j,i) *= opt.use_z4c;
+  // Gamma's
+  for(int a = 0; a < 3; ++a) {
+    rhs.vGam_u(m,a,k,j,i) = 2.*z4c.alpha(m,k,j,i)*DA_u(a) + LGam_u(a);
+    rhs.vGam_u(m,a,k,j,i) -= 2.*z4c.alpha(m,k,j,i) * opt.damp_kappa1 *
+        (z4c.vGam_u(m,a,k,j,i) - Gamma_u(a));
+    for(int b = 0; b < 3; ++b) {
+      rhs.vGam_u(m,a,k,j,i) -= 2. * A_uu(a,b) * dalpha_d(b);
       // Matter term
-      rhs.vA_dd(m,a,b,k,j,i) -= 8.*M_PI * z4c.alpha(m,k,j,i) *
-        (oopsi4*tmunu.S_dd(m,a,b,k,j,i) - (1./3.)*S*z4c.g_dd(m,a,b,k,j,i));
+      rhs.vGam_u(m,a,k,j,i) -= 16.*M_PI * z4c.alpha(m,k,j,i)
+                            * g_uu(a,b) * S_d[b];
+    }
+  }
+
+  // g and A
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b) {
+    rhs.g_dd(m,a,b,k,j,i) = - 2. * z4c.alpha(m,k,j,i) * z4c.vA_dd(m,a,b,k,j,i)
+                    + Lg_dd(a,b);
+    rhs.vA_dd(m,a,b,k,j,i) = oopsi4 *
+        (-Ddalpha_dd(a,b) + z4c.alpha(m,k,j,i) * (R_dd(a,b) + Rphi_dd(a,b)));
+    rhs.vA_dd(m,a,b,k,j,i) -= (1./3.) * z4c.g_dd(m,a,b,k,j,i)
+                           * (-Ddalpha + z4c.alpha(m,k,j,i)*R);
+    rhs.vA_dd(m,a,b,k,j,i) += z4c.alpha(m,k,j,i) * (K*z4c.vA_dd(m,a,b,k,j,i)
+                           - 2.*AA_dd(a,b));
+    rhs.vA_dd(m,a,b,k,j,i) += LA_dd(a,b);
+    // Matter term
+    rhs.vA_dd(m,a,b,k,j,i) -= 8.*M_PI * z4c.alpha(m,k,j,i) *
+      (oopsi4*S_dd[a][b] - (1./3.)*S*z4c.g_dd(m,a,b,k,j,i));
+  }
+  // lapse function
+  Real const f = opt.lapse_oplog * opt.lapse_harmonicf
+               + opt.lapse_harmonic * z4c.alpha(m,k,j,i);
+  rhs.alpha(m,k,j,i) = opt.lapse_advect * Lalpha
+                     - f * z4c.alpha(m,k,j,i) * z4c.vKhat(m,k,j,i);
+
+  // shift vector
+  for(int a = 0; a < 3; ++a) {
+    rhs.beta_u(m,a,k,j,i) = opt.shift_ggamma * z4c.vGam_u(m,a,k,j,i)
+                          + opt.shift_advect * Lbeta_u(a);
+    rhs.beta_u(m,a,k,j,i) -= opt.shift_eta * z4c.beta_u(m,a,k,j,i);
+    // FORCE beta = 0
+    //rhs.beta_u(m,a,k,j,i) = 0;
+  }
+
+  // harmonic gauge terms
+  for(int a = 0; a < 3; ++a) {
+    rhs.beta_u(m,a,k,j,i) += opt.shift_alpha2ggamma *
+                        SQR(z4c.alpha(m,k,j,i)) * z4c.vGam_u(m,a,k,j,i);
+    for(int b = 0; b < 3; ++b) {
+      rhs.beta_u(m,a,k,j,i) += opt.shift_hh * z4c.alpha(m,k,j,i) *
+        chi_guarded * (0.5 * z4c.alpha(m,k,j,i) * dchi_d(b) - dalpha_d(b)) * g_uu(a,b);
     }
-    // lapse function
-    Real const f = opt.lapse_oplog * opt.lapse_harmonicf
-                 + opt.lapse_harmonic * z4c.alpha(m,k,j,i);
-    rhs.alpha(m,k,j,i) = opt.lapse_advect * Lalpha
-                       - f * z4c.alpha(m,k,j,i) * z4c.vKhat(m,k,j,i);
+  }
+}
 
-    // shift vector
-    for(int a = 0; a < 3; ++a) {
-      rhs.beta_u(m,a,k,j,i) = opt.shift_ggamma * z4c.vGam_u(m,a,k,j,i)
-                            + opt.shift_advect * Lbeta_u(a);
-      rhs.beta_u(m,a,k,j,i) -= opt.shift_eta * z4c.beta_u(m,a,k,j,i);
-      // FORCE beta = 0
-      //rhs.beta_u(m,a,k,j,i) = 0;
-    }
+//----------------------------------------------------------------------------------------
+//! \fn void Z4cRHSCell()
+//! \brief computes derivatives and rhs of the z4c equations in one cell
+
+template <int NGHOST, typename Z4C_VARS, typename TMUNU>
+KOKKOS_INLINE_FUNCTION
+void Z4cRHSCell(const Z4C_VARS &z4c, const Z4c::Z4c_vars &rhs,
+                const TMUNU &tmunu, const Z4c::Options &opt,
+                const Real idx[], const int m, const int k, const int j, const int i) {
+  Z4cDerivs der;
+  der.Compute<NGHOST>(z4c, idx, m, k, j, i);
+  Z4cAlgebraCell(z4c, der, rhs, tmunu, opt, m, k, j, i);
+}
+} // namespace
 
-    // harmonic gauge terms
-    for(int a = 0; a < 3; ++a) {
-      rhs.beta_u(m,a,k,j,i) += opt.shift_alpha2ggamma *
-                          SQR(z4c.alpha(m,k,j,i)) * z4c.vGam_u(m,a,k,j,i);
-      for(int b = 0; b < 3; ++b) {
-        rhs.beta_u(m,a,k,j,i) += opt.shift_hh * z4c.alpha(m,k,j,i) *
-          chi_guarded * (0.5 * z4c.alpha(m,k,j,i) * dchi_d(b) - dalpha_d(b)) * g_uu(a,b);
+template <int NGHOST>
+//! \fn void Z4c::CalcRHS(Driver *pdriver, int stage)
+//! \brief compute rhs of the z4c equations
+TaskStatus Z4c::CalcRHS(Driver *pdriver, int stage) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  auto &size = pmy_pack->pmb->mb_size;
+  int &is = indcs.is; int &ie = indcs.ie;
+  int &js = indcs.js; int &je = indcs.je;
+  int &ks = indcs.ks; int &ke = indcs.ke;
+
+  int nmb = pmy_pack->nmb_thispack;
+
+  auto &z4c = pmy_pack->pz4c->z4c;
+  auto &rhs = pmy_pack->pz4c->rhs;
+  auto &opt = pmy_pack->pz4c->opt;
+  auto &u0 = pmy_pack->pz4c->u0;
+  auto &u_rhs = pmy_pack->pz4c->u_rhs;
+  Real &diss = pmy_pack->pz4c->diss;
+
+  // matter sources are either read from u_tmunu, or with <mhd>/fused_tmunu evaluated in
+  // the RHS kernels from the fluid variables, which saves writing and reading u_tmunu
+  bool fused = (pmy_pack->pdyngr != nullptr && pmy_pack->pdyngr->fused_tmunu);
+  TmunuFromArrays tmunu{pmy_pack->ptmunu->tmunu};
+  TmunuFromFluid fluid;
+  if (fused) {
+    fluid = {pmy_pack->pmhd->w0, pmy_pack->pmhd->u0, pmy_pack->pmhd->bcc0,
+             pmy_pack->padm->adm.g_dd};
+  }
+
+  if (opt.rhs_method == Z4cRHSMethod::split) {
+    // ===================================================================================
+    // Split RHS calculation: pass 1 evaluates all stencils (derivatives and dissipation)
+    // and stores them, pass 2 evaluates the algebra from the stored values.  Each pass
+    // needs far fewer registers than the monolithic kernel.
+    //
+    constexpr int nder = Z4cDerivs::ndof;
+    auto &u_der = pmy_pack->pz4c->u_der;
+    if (u_der.extent_int(0) != nmb || u_der.extent_int(1) != nder + nz4c) {
+      int ncells1 = indcs.nx1 + 2*(indcs.ng);
+      int ncells2 = indcs.nx2 + 2*(indcs.ng);
+      int ncells3 = indcs.nx3 + 2*(indcs.ng);
+      Kokkos::realloc(u_der, nmb, nder + nz4c, ncells3, ncells2, ncells1);
+    }
+
+    par_for("z4c rhs derivatives",DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      Real idx[] = {1/size.d_view(m).dx1, 1/size.d_view(m).dx2, 1/size.d_view(m).dx3};
+      Z4cDerivs der;
+      der.Compute<NGHOST>(z4c, idx, m, k, j, i);
+      der.Copy<true>(u_der, 0, m, k, j, i);
+      // K-O dissipation of every variable
+      for (int n = 0; n < nz4c; ++n) {
+        Real d = 0.0;
+        for(int a = 0; a < 3; ++a) {
+          d += Diss<NGHOST>(a, idx, u0, m, n, k, j, i)*diss;
+        }
+        u_der(m,nder+n,k,j,i) = d;
       }
-    }
-  });
+    });
+
+    par_for("z4c rhs algebra",DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      Z4cDerivs der;
+      der.Copy<false>(u_der, 0, m, k, j, i);
+      if (fused) {
+        Z4cAlgebraCell(z4c, der, rhs, fluid, opt, m, k, j, i);
+      } else {
+        Z4cAlgebraCell(z4c, der, rhs, tmunu, opt, m, k, j, i);
+      }
+      for (int n = 0; n < nz4c; ++n) {
+        u_rhs(m,n,k,j,i) += u_der(m,nder+n,k,j,i);
+      }
+    });
+    return Z4cBoundaryRHS(pdriver, stage);
+  }
+
+  // static estimates per cell for roofline counters, assuming each variable and T_munu
+  // component (or the 12 fluid variables and 6 metric components it is evaluated from
+  // with fused_tmunu) is read and each RHS is written once.  About 200 first, advective
+  // and second derivatives are each computed from 2*NGHOST+1 points, and the algebra
+  // takes about 2500 FLOPs.
+  KernelCounters &kc = pmy_pack->pmesh->kcounter;
+  double cell_bytes = (2.0*nz4c + ((fused)? 18.0 : 10.0))*sizeof(Real);
+  double cell_flops = 2500.0 + 396.0*(2*NGHOST + 1);
+  double ncells = static_cast<double>(nmb)*(ke-ks+1)*(je-js+1)*(ie-is+1);
+
+  // ===================================================================================
+  // Main RHS calculation
+  //
+  if (opt.rhs_method == Z4cRHSMethod::monolithic) {
+    kc.Start("z4c rhs loop", ncells, cell_bytes, cell_flops);
+    par_for("z4c rhs loop",DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      Real idx[] = {1/size.d_view(m).dx1, 1/size.d_view(m).dx2, 1/size.d_view(m).dx3};
+      if (fused) {
+        Z4cRHSCell<NGHOST>(z4c, rhs, fluid, opt, idx, m, k, j, i);
+      } else {
+        Z4cRHSCell<NGHOST>(z4c, rhs, tmunu, opt, idx, m, k, j, i);
+      }
+    });
+    kc.Stop();
+  } else {
+    // Each team stages all variables in a brick of (rhs_tile_nk x rhs_tile_nj) rows of
+    // cells plus NGHOST ghost zones in every direction in scratch, so that all stencils
+    // of the RHS in the brick are evaluated from scratch rather than global memory.
+    int ntk = std::min(opt.rhs_tile_nk, indcs.nx3);
+    int ntj = std::min(opt.rhs_tile_nj, indcs.nx2);
+    int nbk = (indcs.nx3 + ntk - 1)/ntk;
+    int nbj = (indcs.nx2 + ntj - 1)/ntj;
+    int ncells1 = indcs.nx1 + 2*NGHOST;
+    int ncells2 = ntj + 2*NGHOST;
+    int ncells3 = ntk + 2*NGHOST;
+    size_t scr_size = ScrArray4D<Real>::shmem_size(nz4c, ncells3, ncells2, ncells1);
+    // use level 0 (shared memory on GPUs) if brick fits, otherwise level 1
+    Kokkos::TeamPolicy<> policy(DevExeSpace(), 1, Kokkos::AUTO);
+    int scr_level = (static_cast<int>(scr_size) <= policy.scratch_size_max(0))? 0 : 1;
+
+    kc.Start("z4c rhs tiled", ncells, cell_bytes, cell_flops);
+    par_for_outer("z4c rhs tiled",DevExeSpace(),scr_size,scr_level,0,nmb-1,0,nbk-1,
+                  0,nbj-1,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int bk, const int bj) {
+      ScrArray4D<Real> ubrick(member.team_scratch(scr_level), nz4c, ncells3, ncells2,
+                              ncells1);
+      const int kl = ks + bk*ntk;
+      const int jl = js + bj*ntj;
+      const int nk = (kl + ntk - 1 <= ke)? ntk : ke - kl + 1;
+      const int nj = (jl + ntj - 1 <= je)? ntj : je - jl + 1;
+
+      // load brick, including ghost zones
+      const int nk3 = nk + 2*NGHOST;
+      const int nj2 = nj + 2*NGHOST;
+      Kokkos::parallel_for(Kokkos::TeamThreadRange<>(member, nz4c*nk3*nj2),
+      [&](const int idx) {
+        int n = idx/(nk3*nj2);
+        int kk = (idx - n*nk3*nj2)/nj2;
+        int jj = idx - n*nk3*nj2 - kk*nj2;
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(member, ncells1),
+        [&](const int ii) {
+          ubrick(n,kk,jj,ii) = u0(m,n,kl-NGHOST+kk,jl-NGHOST+jj,is-NGHOST+ii);
+        });
+      });
+      member.team_barrier();
+
+      Z4cScrVars zscr;
+      const int k0 = kl - NGHOST, j0 = jl - NGHOST, i0 = is - NGHOST;
+      zscr.chi    = {ubrick, I_Z4C_CHI,   k0, j0, i0};
+      zscr.vKhat  = {ubrick, I_Z4C_KHAT,  k0, j0, i0};
+      zscr.vTheta = {ubrick, I_Z4C_THETA, k0, j0, i0};
+      zscr.alpha  = {ubrick, I_Z4C_ALPHA, k0, j0, i0};
+      zscr.vGam_u = {ubrick, I_Z4C_GAMX,  k0, j0, i0};
+      zscr.beta_u = {ubrick, I_Z4C_BETAX, k0, j0, i0};
+      zscr.g_dd   = {ubrick, I_Z4C_GXX,   k0, j0, i0};
+      zscr.vA_dd  = {ubrick, I_Z4C_AXX,   k0, j0, i0};
+      Real idx[] = {1/size.d_view(m).dx1, 1/size.d_view(m).dx2, 1/size.d_view(m).dx3};
+
+      Kokkos::parallel_for(Kokkos::TeamThreadRange<>(member, nk*nj), [&](const int kj) {
+        int k = kl + kj/nj;
+        int j = jl + kj - (kj/nj)*nj;
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(member, is, ie+1),
+        [&](const int i) {
+          if (fused) {
+            Z4cRHSCell<NGHOST>(zscr, rhs, fluid, opt, idx, m, k, j, i);
+          } else {
+            Z4cRHSCell<NGHOST>(zscr, rhs, tmunu, opt, idx, m, k, j, i);
+          }
+        });
+      });
+    });
+    kc.Stop();
+  }
 
   // ===================================================================================
   // Add dissipation for stability
   //
-  Real &diss = pmy_pack->pz4c->diss;
-  auto &u0 = pmy_pack->pz4c->u0;
-  auto &u_rhs = pmy_pack->pz4c->u_rhs;
   par_for("K-O Dissipation",
   DevExeSpace(),0,nmb-1,0,nz4c-1,ks,ke,js,je,is,ie,
   KOKKOS_LAMBDA(const int m, const int n, const int k, const int j, const int i) {
@@ -573,7 +873,8 @@ TaskStatus Z4c::CalcRHS(Driver *pdriver, int stage) {
     }
   });
 
-  return TaskStatus::complete;
+  // Sommerfeld BCs on blocks at outer boundaries
+  return Z4cBoundaryRHS(pdriver, stage);
 }
 
 template TaskStatus Z4c::CalcRHS<2>(Driver *pdriver, int stage);
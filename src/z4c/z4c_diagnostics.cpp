@@ -0,0 +1,498 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file z4c_diagnostics.cpp
+//! \brief implementation of functions in the Z4c class that compute diagnostics from the
+//! ADM variables: the constraints and the Weyl scalar.  Both need the first and second
+//! derivatives of the metric, the Christoffel symbols, the Ricci tensor, and the
+//! covariant derivative of K, so they are computed in a single kernel that evaluates
+//! these once per cell.
+
+// C++ standard headers
+#include <cmath>
+#include <iostream>
+
+// Athena++ headers
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+#include "coordinates/adm.hpp"
+#include "coordinates/cell_locations.hpp"
+#include "z4c/z4c.hpp"
+#include "z4c/tmunu.hpp"
+#include "mhd/mhd.hpp"
+#include "dyn_grmhd/dyn_grmhd.hpp"
+
+namespace z4c {
+//----------------------------------------------------------------------------------------
+//! \fn void Z4c::Z4cDiagnostics(MeshBlockPack *pmbp, bool calc_con, bool calc_weyl)
+//! \brief compute the constraints (if calc_con) and the Weyl scalar psi4 (if calc_weyl)
+//! from the ADM variables and matter state, in one pass over the MeshBlocks
+//
+// Note: we are assuming that u_adm has been initialized with the correct
+// metric and matter quantities
+//
+// BAM: adm_constraints_N()
+// https://git.tpi.uni-jena.de/bamdev/adm
+// https://git.tpi.uni-jena.de/bamdev/adm/blob/master/adm_constraints_N.m
+//
+// Diagnostics are set only in the MeshBlock interior, because derivatives
+// of the ADM quantities are neded to compute them.
+template <int NGHOST>
+void Z4c::Z4cDiagnostics(MeshBlockPack *pmbp, bool calc_con, bool calc_weyl) {
+  if (!calc_con && !calc_weyl) return;
+  // capture variables for the kernel
+  auto &indcs = pmbp->pmesh->mb_indcs;
+  auto &size = pmbp->pmb->mb_size;
+  int &is = indcs.is; int &ie = indcs.ie;
+  int &js = indcs.js; int &je = indcs.je;
+  int &ks = indcs.ks; int &ke = indcs.ke;
+  int nmb = pmbp->nmb_thispack;
+
+  auto &z4c = pmbp->pz4c->z4c;
+  auto &adm = pmbp->padm->adm;
+  // with <mhd>/fused_tmunu u_tmunu is not set every stage, so evaluate Tmunu from fluid
+  bool fused = (pmbp->pdyngr != nullptr && pmbp->pdyngr->fused_tmunu);
+  TmunuFromArrays tmunu{pmbp->ptmunu->tmunu};
+  TmunuFromFluid fluid;
+  if (fused) {
+    fluid = {pmbp->pmhd->w0, pmbp->pmhd->u0, pmbp->pmhd->bcc0, adm.g_dd};
+  }
+  auto &con = pmbp->pz4c->con;
+  auto &weyl = pmbp->pz4c->weyl;
+  if (calc_con) Kokkos::deep_copy(pmbp->pz4c->u_con, 0.);
+  if (calc_weyl) Kokkos::deep_copy(pmbp->pz4c->u_weyl, 0.);
+
+  par_for("z4c diagnostics",DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> Gamma_u;
+    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dpsi4_d;
+
+    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> g_uu;
+    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> R_dd;
+    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> K_ud;
+
+    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> dg_ddd;
+    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> dK_ddd;
+    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_ddd;
+    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_udd;
+    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> DK_ddd;
+
+    AthenaScratchTensor<Real, TensorSymm::SYM22, 3, 4> ddg_dddd;
+
+    Real idx[] = {1/size.d_view(m).dx1, 1/size.d_view(m).dx2, 1/size.d_view(m).dx3};
+
+    // -----------------------------------------------------------------------------------
+    // derivatives
+    //
+    // first derivatives of g and K
+    for(int c = 0; c < 3; ++c) {
+      Real dg[6], dK[6];
+      DxSym<NGHOST>(c, idx, adm.g_dd, m,k,j,i, dg);
+      DxSym<NGHOST>(c, idx, adm.vK_dd, m,k,j,i, dK);
+      int n = 0;
+      for(int a = 0; a < 3; ++a)
+      for(int b = a; b < 3; ++b) {
+        dg_ddd(c,a,b) = dg[n];
+        dK_ddd(c,a,b) = dK[n++];
+      }
+    }
+
+    // first derivative of psi4
+    for (int a =0; a < 3; ++a) {
+      dpsi4_d(a) = Dx<NGHOST>(a, idx, adm.psi4, m, k, j, i);
+    }
+
+    // second derivatives of g
+    for(int a = 0; a < 3; ++a)
+    for(int b = a; b < 3; ++b)
+    for(int c = 0; c < 3; ++c)
+    for(int d = c; d < 3; ++d) {
+      if(a == b) {
+        ddg_dddd(a,a,c,d) = Dxx<NGHOST>(a, idx, adm.g_dd, m,c,d,k,j,i);
+      } else {
+        ddg_dddd(a,b,c,d) = Dxy<NGHOST>(a, b, idx, adm.g_dd, m,c,d,k,j,i);
+      }
+    }
+
+    // -----------------------------------------------------------------------------------
+    // inverse metric
+    //
+    Real detg = adm::SpatialDet(adm.g_dd(m,0,0,k,j,i), adm.g_dd(m,0,1,k,j,i),
+                                adm.g_dd(m,0,2,k,j,i), adm.g_dd(m,1,1,k,j,i),
+                                adm.g_dd(m,1,2,k,j,i), adm.g_dd(m,2,2,k,j,i));
+    adm::SpatialInv(1./detg,
+               adm.g_dd(m,0,0,k,j,i), adm.g_dd(m,0,1,k,j,i), adm.g_dd(m,0,2,k,j,i),
+               adm.g_dd(m,1,1,k,j,i), adm.g_dd(m,1,2,k,j,i), adm.g_dd(m,2,2,k,j,i),
+               &g_uu(0,0), &g_uu(0,1), &g_uu(0,2),
+               &g_uu(1,1), &g_uu(1,2), &g_uu(2,2));
+
+    // -----------------------------------------------------------------------------------
+    // Christoffel symbols
+    //
+    for(int c = 0; c < 3; ++c)
+    for(int a = 0; a < 3; ++a)
+    for(int b = a; b < 3; ++b) {
+      Gamma_ddd(c,a,b) = 0.5*(dg_ddd(a,b,c) + dg_ddd(b,a,c) - dg_ddd(c,a,b));
+      Gamma_udd(c,a,b) = 0.0;
+    }
+
+    for(int c = 0; c < 3; ++c)
+    for(int a = 0; a < 3; ++a)
+    for(int b = a; b < 3; ++b)
+    for(int d = 0; d < 3; ++d) {
+      Gamma_udd(c,a,b) += g_uu(c,d)*Gamma_ddd(d,a,b);
+    }
+
+    for(int a = 0; a < 3; ++a) {
+      Gamma_u(a) = 0.0;
+      for(int b = 0; b < 3; ++b)
+      for(int c = 0; c < 3; ++c) {
+        Gamma_u(a) += g_uu(b,c)*Gamma_udd(a,b,c);
+      }
+    }
+
+    // -----------------------------------------------------------------------------------
+    // Ricci tensor and Ricci scalar
+    //
+    Real R = 0.0;
+    for(int a = 0; a < 3; ++a)
+    for(int b = a; b < 3; ++b) {
+      R_dd(a,b) = 0.0;
+      for(int c = 0; c < 3; ++c)
+      for(int d = 0; d < 3; ++d) {
+        // Part with the Christoffel symbols
+        for(int e = 0; e < 3; ++e) {
+          R_dd(a,b) += g_uu(c,d) * Gamma_udd(e,a,c) * Gamma_ddd(e,b,d);
+          R_dd(a,b) -= g_uu(c,d) * Gamma_udd(e,a,b) * Gamma_ddd(e,c,d);
+        }
+        // Wave operator part of the Ricci
+        R_dd(a,b) += 0.5*g_uu(c,d)*(
+            - ddg_dddd(c,d,a,b) - ddg_dddd(a,b,c,d) +
+              ddg_dddd(a,c,b,d) + ddg_dddd(b,c,a,d));
+      }
+      R += g_uu(a,b) * R_dd(a,b);
+    }
+
+    // -----------------------------------------------------------------------------------
+    // Extrinsic curvature: traces and derivatives
+    //
+    Real K = 0.0;
+    for(int a = 0; a < 3; ++a) {
+      for(int b = a; b < 3; ++b) {
+        K_ud(a,b) = 0.0;
+        for(int c = 0; c < 3; ++c) {
+          K_ud(a,b) += g_uu(a,c) * adm.vK_dd(m,c,b,k,j,i);
+        }
+      }
+      K += K_ud(a,a);
+    }
+
+    // Covariant derivative of K
+    for(int a = 0; a < 3; ++a)
+    for(int b = 0; b < 3; ++b)
+    for(int c = b; c < 3; ++c) {
+      DK_ddd(a,b,c) = dK_ddd(a,b,c);
+      for(int d = 0; d < 3; ++d) {
+        DK_ddd(a,b,c) -= Gamma_udd(d,a,b) * adm.vK_dd(m,d,c,k,j,i);
+        DK_ddd(a,b,c) -= Gamma_udd(d,a,c) * adm.vK_dd(m,b,d,k,j,i);
+      }
+    }
+
+    if (calc_con) {
+      AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> Gamma_u_z4c;
+      AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> M_u;
+      AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> DK_udd;
+
+      // K^a_b K^b_a
+      Real KK = 0.0;
+      for(int a = 0; a < 3; ++a)
+      for(int b = 0; b < 3; ++b) {
+        KK += K_ud(a,b) * K_ud(b,a);
+      }
+
+      for(int a = 0; a < 3; ++a)
+      for(int b = 0; b < 3; ++b)
+      for(int c = b; c < 3; ++c) {
+        DK_udd(a,b,c) = 0.0;
+        for(int d = 0; d < 3; ++d) {
+          DK_udd(a,b,c) += g_uu(a,d) * DK_ddd(d,b,c);
+        }
+      }
+
+      // Find the contracted conformal Christoffel symbol
+      for (int a = 0; a < 3; ++a) {
+        Gamma_u_z4c(a) = adm.psi4(m,k,j,i)*Gamma_u(a);
+        for (int b = 0; b < 3; ++b) {
+          Gamma_u_z4c(a) += 0.5*g_uu(a,b)*dpsi4_d(b);
+        }
+      }
+
+      // Matter sources
+      Real E, S_d[3], S_dd[3][3];
+      if (fused) {
+        fluid(m, k, j, i, E, S_d, S_dd);
+      } else {
+        tmunu(m, k, j, i, E, S_d, S_dd);
+      }
+
+      // -------------------------------------------------------------------------------
+      // Actual constraints
+      //
+      // Hamiltonian constraint
+      //
+      con.H(m,k,j,i) = R + SQR(K) - KK - 16*M_PI * E;
+
+      // Momentum constraint (contravariant)
+      //
+      for(int a = 0; a < 3; ++a) {
+        M_u(a) = 0.0;
+        for(int b = 0; b < 3; ++b) {
+          M_u(a) -= 8*M_PI * g_uu(a,b) * S_d[b];
+          for(int c = 0; c < 3; ++c) {
+            M_u(a) += g_uu(a,b) * DK_udd(c,b,c);
+            M_u(a) -= g_uu(b,c) * DK_udd(a,b,c);
+          }
+        }
+      }
+
+      // Momentum constraint (covariant)
+      for(int a = 0; a < 3; ++a) {
+        for(int b = 0; b < 3; ++b) {
+          con.M_d(m,a,k,j,i) += adm.g_dd(m,a,b,k,j,i) * M_u(b);
+        }
+      }
+
+      // Momentum constraint (norm squared)
+      for(int a = 0; a < 3; ++a)
+      for(int b = 0; b < 3; ++b) {
+        con.M(m,k,j,i) += adm.g_dd(m,a,b,k,j,i) * M_u(a) * M_u(b);
+      }
+
+      // Constraint violation Z (norm squared)
+      for(int a = 0; a < 3; ++a)
+      for(int b = 0; b < 3; ++b) {
+        con.Z(m,k,j,i) += 0.25*z4c.g_dd(m,a,b,k,j,i)
+                          *(z4c.vGam_u(m,a,k,j,i) - Gamma_u_z4c(a))
+                          *(z4c.vGam_u(m,b,k,j,i) - Gamma_u_z4c(b));
+      }
+
+      // Constraint violation monitor C^2
+      con.C(m,k,j,i) = SQR(con.H(m,k,j,i)) + con.M(m,k,j,i) +
+                       SQR(z4c.vTheta(m,k,j,i)) + 4.0*con.Z(m,k,j,i);
+    }
+
+    if (calc_weyl) {
+      // Simplify constants (2 & sqrt 2 factors) featured in re/im[psi4]
+      const Real FR4 = 0.25;
+      Real &x1min = size.d_view(m).x1min;
+      Real &x1max = size.d_view(m).x1max;
+      Real x1v = CellCenterX(i-is, indcs.nx1, x1min, x1max);
+      Real &x2min = size.d_view(m).x2min;
+      Real &x2max = size.d_view(m).x2max;
+      Real x2v = CellCenterX(j-js, indcs.nx2, x2min, x2max);
+      Real &x3min = size.d_view(m).x3min;
+      Real &x3max = size.d_view(m).x3max;
+      Real x3v = CellCenterX(k-ks, indcs.nx3, x3min, x3max);
+
+      Real dotp1 = 0.0;
+      Real dotp2 = 0.0;
+      AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> uvec;
+      AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> vvec;
+      AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> wvec;
+      AthenaScratchTensor<Real, TensorSymm::NONE, 3, 2> Riemm4_dd;   // 4D Riemann*n^a*n^c
+      AthenaScratchTensor<Real, TensorSymm::NONE, 3, 3> Riemm4_ddd;  // 4D Riemann * n^a
+      AthenaScratchTensor<Real, TensorSymm::NONE, 3, 4> Riem3_dddd;  // 3D Riemann tensor
+      AthenaScratchTensor<Real, TensorSymm::NONE, 3, 4> Riemm4_dddd; // 4D Riemann tensor
+
+      //--------------------------------------------------------------------------------
+      //     Construct tetrad
+      //
+      //     Initial tetrad guess. NB, aligned with z axis - possible problem if points
+      //     lie on z axis theta and phi vectors degenerate
+      //     Like BAM start with phi vector
+      //     uvec = radial vec
+      //     vvec = theta vec
+      //     wvec = phi vec
+      Real xx = x1v;
+      if(SQR(x1v) +  SQR(x2v) < 1e-10)
+        xx = xx + 1e-8;
+      uvec(0) = xx;
+      uvec(1) = x2v;
+      uvec(2) = x3v;
+      vvec(0) = xx*x3v;
+      vvec(1) = x2v*x3v;
+      vvec(2) = -SQR(xx)-SQR(x2v);
+      wvec(0) = x2v*-1.0;
+      wvec(1) = xx;
+      wvec(2) = 0.0;
+
+      //Gram-Schmidt orthonormalisation with spacetime metric.
+
+      // (1) normalize phi vec
+      for(int a = 0; a<3; ++a) {
+        for(int b = 0; b<3; ++b) {
+            dotp1 += adm.g_dd(m,a,b,k,j,i)*wvec(a)*wvec(b);
+        }
+      }
+      for(int a =0; a<3; ++a) {
+          wvec(a) = wvec(a)/std::sqrt(dotp1);
+      }
+
+      // (2) make radial vec orthogonal to phi vec
+      dotp1 = 0;
+      for(int a = 0; a<3; ++a) {
+        for( int b = 0; b<3; ++b) {
+          dotp1 += adm.g_dd(m,a,b,k,j,i)*wvec(a)*uvec(b);
+        }
+      }
+      for(int a = 0; a<3; ++a) {
+        uvec(a) -= dotp1*wvec(a);
+      }
+
+      // (3) normalize radial vec
+      dotp1 = 0;
+      for(int a = 0; a<3; ++a) {
+        for(int b = 0; b<3; ++b) {
+            dotp1 += adm.g_dd(m,a,b,k,j,i)*uvec(a)*uvec(b);
+        }
+      }
+
+      for(int a =0; a<3; ++a) {
+          uvec(a) = uvec(a)/std::sqrt(dotp1);
+      }
+
+      // (4) make theta vec orthogonal to both radial and phi vec
+      dotp1 = 0;
+      for(int a = 0; a<3; ++a) {
+        for(int b = 0; b<3; ++b) {
+          dotp1 += adm.g_dd(m,a,b,k,j,i)*wvec(a)*vvec(b);
+        }
+      }
+
+      dotp2 = 0;
+      for(int a = 0; a<3; ++a) {
+        for( int b = 0; b<3; ++b) {
+          dotp2 += adm.g_dd(m,a,b,k,j,i)*uvec(a)*vvec(b);
+        }
+      }
+
+      for(int a = 0; a<3; ++a) {
+        vvec(a) -= dotp1*wvec(a)+dotp2*uvec(a);
+      }
+
+      // (3) normalize theta vec
+      dotp1 = 0;
+      for(int a = 0; a<3; ++a) {
+        for( int b = 0; b<3; ++b) {
+          dotp1 += adm.g_dd(m,a,b,k,j,i)*vvec(a)*vvec(b);
+        }
+      }
+
+      for(int a =0; a<3; ++a) {
+        vvec(a) = vvec(a)/std::sqrt(dotp1);
+      }
+
+      //   Riem3_dddd = Riemann tensor of spacelike hypersurface
+      //   Riemm4_dddd = Riemann tensor of 4D spacetime
+      //   Riemm4_ddd  = Riemann tensor of 4D spacetime contracted once with n
+      //   Riemm4_dd  = Riemann tensor of 4D spacetime contracted twice with n
+
+      for(int a = 0; a < 3; ++a)
+      for(int b = 0; b < 3; ++b)
+      for(int c = 0; c < 3; ++c)
+      for(int d = 0; d < 3; ++d) {
+        Riem3_dddd(a,b,c,d) = adm.g_dd(m,a,c,k,j,i)*R_dd(b,d)
+                              + adm.g_dd(m,b,d,k,j,i)*R_dd(a,c)
+                              - adm.g_dd(m,a,d,k,j,i)*R_dd(b,c)
+                              - adm.g_dd(m,b,c,k,j,i)*R_dd(a,d)
+                              - 0.5*R*adm.g_dd(m,a,c,k,j,i)*adm.g_dd(m,b,d,k,j,i)
+                              + 0.5*R*adm.g_dd(m,a,d,k,j,i)*adm.g_dd(m,b,c,k,j,i);
+        Riemm4_dddd(a,b,c,d) = Riem3_dddd(a,b,c,d)
+                              + adm.vK_dd(m,a,c,k,j,i)*adm.vK_dd(m,b,d,k,j,i)
+                              - adm.vK_dd(m,a,d,k,j,i)*adm.vK_dd(m,b,c,k,j,i);
+      }
+
+      for(int a = 0; a < 3; ++a) {
+        for(int b = 0; b < 3; ++b) {
+          for(int c = 0; c < 3; ++c) {
+            Riemm4_ddd(a,b,c) = - (DK_ddd(c,a,b) - DK_ddd(b,a,c));
+          }
+        }
+      }
+
+
+      for(int a = 0; a < 3; ++a) {
+        for(int b = 0; b < 3; ++b) {
+          Riemm4_dd(a,b) = R_dd(a,b) + K*adm.vK_dd(m,a,b,k,j,i);
+          for(int c = 0; c < 3; ++c) {
+            for(int d = 0; d < 3; ++d) {
+              Riemm4_dd(a,b) += - g_uu(c,d)*adm.vK_dd(m,a,c,k,j,i)
+                                          *adm.vK_dd(m,d,b,k,j,i);
+            }
+          }
+        }
+      }
+
+      for(int a = 0; a < 3; ++a) {
+        for(int b = 0; b < 3; ++b) {
+          weyl.rpsi4(m,k,j,i) += - FR4 * Riemm4_dd(a,b) * (
+            vvec(a) * vvec(b) - (-wvec(a) * (-wvec(b)))
+          );
+          weyl.ipsi4(m,k,j,i) += - FR4 * Riemm4_dd(a,b) * (
+            -vvec(a) * wvec(b) - wvec(a)*vvec(b)
+          );
+          for(int c = 0; c < 3; ++c) {
+            weyl.rpsi4(m,k,j,i) += 0.5 * Riemm4_ddd(a,c,b) * uvec(c) * (
+              vvec(a) * vvec(b) - (-wvec(a)*(-wvec(b)))
+            );
+            weyl.ipsi4(m,k,j,i) += 0.5 * Riemm4_ddd(a,c,b) * uvec(c) * (
+              -vvec(a) * wvec(b) - wvec(a)*vvec(b)
+            );
+            for(int d = 0; d < 3; ++d) {
+              weyl.rpsi4(m,k,j,i) += -FR4 * (Riemm4_dddd(d,a,c,b) * uvec(d) * uvec(c)) * (
+                vvec(a) * vvec(b) - (-wvec(a)*(-wvec(b)))
+              );
+              weyl.ipsi4(m,k,j,i) += -FR4 * (Riemm4_dddd(d,a,c,b) * uvec(d) * uvec(c)) * (
+                -vvec(a) * wvec(b) - wvec(a)*vvec(b)
+              );
+            }
+          }
+        }
+      }
+      Real r = std::sqrt(SQR(x1v) +  SQR(x2v) + SQR(x3v));
+      weyl.rpsi4(m,k,j,i) *= r;
+      weyl.ipsi4(m,k,j,i) *= r;
+    }
+  });
+}
+
+template void Z4c::Z4cDiagnostics<2>(MeshBlockPack *pmbp, bool calc_con, bool calc_weyl);
+template void Z4c::Z4cDiagnostics<3>(MeshBlockPack *pmbp, bool calc_con, bool calc_weyl);
+template void Z4c::Z4cDiagnostics<4>(MeshBlockPack *pmbp, bool calc_con, bool calc_weyl);
+
+//----------------------------------------------------------------------------------------
+//! \fn void Z4c::ADMConstraints(MeshBlockPack *pmbp)
+//! \brief compute constraints ADM vars
+
+template <int NGHOST>
+void Z4c::ADMConstraints(MeshBlockPack *pmbp) {
+  Z4cDiagnostics<NGHOST>(pmbp, true, false);
+}
+template void Z4c::ADMConstraints<2>(MeshBlockPack *pmbp);
+template void Z4c::ADMConstraints<3>(MeshBlockPack *pmbp);
+template void Z4c::ADMConstraints<4>(MeshBlockPack *pmbp);
+
+//----------------------------------------------------------------------------------------
+//! \fn void Z4c::Z4cWeyl(MeshBlockPack *pmbp)
+//! \brief compute the weyl scalars given the adm variables and matter state
+
+template <int NGHOST>
+void Z4c::Z4cWeyl(MeshBlockPack *pmbp) {
+  Z4cDiagnostics<NGHOST>(pmbp, false, true);
+}
+template void Z4c::Z4cWeyl<2>(MeshBlockPack *pmbp);
+template void Z4c::Z4cWeyl<3>(MeshBlockPack *pmbp);
+template void Z4c::Z4cWeyl<4>(MeshBlockPack *pmbp);
+} // namespace z4c
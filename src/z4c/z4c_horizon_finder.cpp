@@ -0,0 +1,382 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file z4c_horizon_finder.cpp
+//! \brief Implements HorizonFinder class.  The trial surface r = h(theta,phi) is
+//! expanded in real spherical harmonics up to lmax, and is relaxed by the fast-flow
+//! iteration
+//!    a_lm <- a_lm - A/(1 + B l(l+1)) (rho Theta)_lm
+//! until the expansion Theta vanishes to within a tolerance.  The expansion at all
+//! angles is computed in a single kernel, from values interpolated by one batch of the
+//! PointInterpolator, so every rank holds the full surface and performs the same update.
+
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "coordinates/adm.hpp"
+#include "utils/point_interpolator.hpp"
+#include "z4c/z4c.hpp"
+#include "z4c/z4c_puncture_tracker.hpp"
+#include "z4c/z4c_horizon_finder.hpp"
+
+namespace z4c {
+
+namespace {
+// number of interpolation points per angle: the surface point and its neighbors
+// displaced by +/- delta along each Cartesian direction
+constexpr int npt_angle = 7;
+
+//----------------------------------------------------------------------------------------
+//! \fn Real LevelSet
+//! \brief F = r - h(theta,phi), which vanishes on the trial surface
+
+template <typename ViewType>
+KOKKOS_INLINE_FUNCTION
+Real LevelSet(const ViewType &a, const int lmax, const Real c0, const Real c1,
+              const Real c2, const Real x1, const Real x2, const Real x3) {
+  Real dx = x1 - c0, dy = x2 - c1, dz = x3 - c2;
+  Real r = sqrt(dx*dx + dy*dy + dz*dz);
+  return r - RealYlmSum(a, lmax, acos(dz/r), atan2(dy, dx));
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+// constructor, reads parameters of horizon n and tabulates Y_lm on the geodesic grid
+
+HorizonFinder::HorizonFinder(MeshBlockPack *ppack, ParameterInput *pin, int n) :
+    found(false),
+    rmin(0.0), rmax(0.0), area(0.0), mass(0.0),
+    alm("ah_alm",1),
+    pmy_pack(ppack),
+    nhorizon(n),
+    theta_max(0.0),
+    ylm("ah_ylm",1,1),
+    rhs("ah_rhs",1,1) {
+  std::string pre = "ah_" + std::to_string(n) + "_";
+  int nlev = pin->GetOrAddInteger("z4c", "horizon_nlev", 8);
+  lmax = pin->GetOrAddInteger("z4c", "horizon_lmax", 8);
+  ncycle_find = pin->GetOrAddInteger("z4c", "horizon_ncycle", 16);
+  max_iter = pin->GetOrAddInteger("z4c", "horizon_max_iter", 200);
+  tol = pin->GetOrAddReal("z4c", "horizon_tol", 1.0e-4);
+  flow_alpha = pin->GetOrAddReal("z4c", "horizon_flow_alpha", 1.0);
+  flow_beta = pin->GetOrAddReal("z4c", "horizon_flow_beta", 0.5);
+  int npunct_def = (pin->GetOrAddInteger("z4c", "npunct", 0) > n)? n : -1;
+  npunct = pin->GetOrAddInteger("z4c", pre + "punct", npunct_def);
+  center[0] = pin->GetOrAddReal("z4c", pre + "x", 0.0);
+  center[1] = pin->GetOrAddReal("z4c", pre + "y", 0.0);
+  center[2] = pin->GetOrAddReal("z4c", pre + "z", 0.0);
+  rinit = pin->GetOrAddReal("z4c", pre + "rinit", 1.0);
+  if (lmax < 0 || ncycle_find < 1) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "horizon_lmax must be >= 0 and horizon_ncycle >= 1"
+              << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  nlm = (lmax + 1)*(lmax + 1);
+
+  pgrid = std::make_unique<GeodesicGrid>(nlev, false, false);
+  int nangles = pgrid->nangles;
+  pinterp = new PointInterpolator(pmy_pack, npt_angle*nangles);
+  Kokkos::realloc(alm, nlm);
+  Kokkos::realloc(ylm, nangles, nlm);
+  Kokkos::realloc(rhs, nangles, 3);
+
+  // Y_lm at each angle never change, so tabulate them once
+  for (int p=0; p<nangles; ++p) {
+    Real theta = pgrid->polar_pos.h_view(p,0);
+    Real phi = pgrid->polar_pos.h_view(p,1);
+    for (int l=0; l<=lmax; ++l) {
+      for (int m=-l; m<=l; ++m) {
+        ylm.h_view(p,l*l + l + m) = RealYlm(l, m, theta, phi);
+      }
+    }
+  }
+  ylm.template modify<HostMemSpace>();
+  ylm.template sync<DevExeSpace>();
+
+  // initial guess is a sphere of radius rinit
+  for (int i=0; i<nlm; ++i) {alm.h_view(i) = 0.0;}
+  alm.h_view(0) = rinit*2.0*sqrt(M_PI);
+  alm.template modify<HostMemSpace>();
+  alm.template sync<DevExeSpace>();
+
+  ofname = pin->GetString("job", "basename") + ".";
+  ofname += pin->GetOrAddString("z4c", "horizon_filename", "horizon_");
+  ofname += std::to_string(n) + ".txt";
+  if (0 == global_variable::my_rank) {
+    bool exists = (access(ofname.c_str(), F_OK) == 0);
+    pofile = fopen(ofname.c_str(), exists? "a" : "w");
+    if (NULL == pofile) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Could not open file '" << ofname << "' for writing!"
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    if (!exists) {
+      fprintf(pofile, "# 1:time 2:found 3:x 4:y 5:z 6:rmin 7:rmax 8:area 9:mass "
+              "10:max|Theta|\n");
+      fflush(pofile);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------
+// destructor
+
+HorizonFinder::~HorizonFinder() {
+  delete pinterp;
+  if (0 == global_variable::my_rank) {
+    fclose(pofile);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void HorizonFinder::Find
+//! \brief Runs the fast-flow iteration every ncycle_find cycles.  Starts from the last
+//! horizon found (or the initial sphere), and restores the last horizon found if the
+//! iteration does not converge, so that excision and AMR always see a valid surface.
+
+void HorizonFinder::Find(int ncycle) {
+  if (ncycle % ncycle_find != 0) return;
+  Mesh *pm = pmy_pack->pmesh;
+
+  // follow the puncture, if the horizon is associated with one
+  if (npunct >= 0 && npunct < static_cast<int>(pmy_pack->pz4c_ptracker.size())) {
+    for (int a=0; a<3; ++a) {
+      center[a] = pmy_pack->pz4c_ptracker[npunct]->GetPos(a);
+    }
+  }
+
+  // offsets used for derivatives are one cell width on the finest level
+  int dlev = pm->max_level - pm->root_level;
+  Real delta = (pm->mesh_size.x1max - pm->mesh_size.x1min)/
+               static_cast<Real>(pm->mesh_indcs.nx1 << dlev);
+
+  std::vector<Real> alm_last(nlm);
+  for (int i=0; i<nlm; ++i) {alm_last[i] = alm.h_view(i);}
+  if (!found) {
+    for (int i=0; i<nlm; ++i) {alm.h_view(i) = 0.0;}
+    alm.h_view(0) = rinit*2.0*sqrt(M_PI);
+    alm.template modify<HostMemSpace>();
+    alm.template sync<DevExeSpace>();
+  }
+
+  int nangles = pgrid->nangles;
+  auto &omega = pgrid->solid_angles;
+  Real aflow = flow_alpha/(lmax*(lmax + 1) + 1.0) + flow_beta;
+  Real bflow = flow_beta/flow_alpha;
+  bool converged = false;
+  for (int iter=0; iter<max_iter; ++iter) {
+    SetSurfacePoints(delta);
+    pinterp->SetPoints();
+    bool on_mesh = true;
+    pinterp->Interpolate(12, pmy_pack->padm->u_adm, adm::ADM::I_ADM_GXX);
+    pinterp->ReduceValues();
+    for (int p=0; p<pinterp->npoints; ++p) {
+      if (pinterp->nowners(p) == 0.0) on_mesh = false;
+    }
+    if (!on_mesh) break;
+
+    Expansion(delta);
+    if (!std::isfinite(theta_max)) break;
+    if (theta_max < tol) {
+      converged = true;
+      break;
+    }
+
+    // fast-flow update of the spectral coefficients
+    for (int l=0; l<=lmax; ++l) {
+      Real fac = aflow/(1.0 + bflow*l*(l + 1));
+      for (int m=-l; m<=l; ++m) {
+        int lm = l*l + l + m;
+        Real proj = 0.0;
+        for (int p=0; p<nangles; ++p) {
+          proj += rhs.h_view(p,0)*ylm.h_view(p,lm)*omega.h_view(p);
+        }
+        alm.h_view(lm) -= fac*proj;
+      }
+    }
+    alm.template modify<HostMemSpace>();
+    alm.template sync<DevExeSpace>();
+  }
+
+  if (converged) {
+    found = true;
+    area = 0.0;
+    rmin = rhs.h_view(0,2);
+    rmax = rhs.h_view(0,2);
+    for (int p=0; p<nangles; ++p) {
+      area += rhs.h_view(p,1)*omega.h_view(p);
+      rmin = fmin(rmin, rhs.h_view(p,2));
+      rmax = fmax(rmax, rhs.h_view(p,2));
+    }
+    mass = sqrt(area/(16.0*M_PI));
+  } else {
+    for (int i=0; i<nlm; ++i) {alm.h_view(i) = alm_last[i];}
+    alm.template modify<HostMemSpace>();
+    alm.template sync<DevExeSpace>();
+  }
+  Write(pm->time, converged);
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void HorizonFinder::SetSurfacePoints
+//! \brief sets coordinates of the trial surface, and of its neighbors at distance delta
+//! in each Cartesian direction, in the interpolator
+
+void HorizonFinder::SetSurfacePoints(Real delta) {
+  auto &coords = pinterp->coords;
+  for (int p=0; p<pgrid->nangles; ++p) {
+    Real theta = pgrid->polar_pos.h_view(p,0);
+    Real phi = pgrid->polar_pos.h_view(p,1);
+    Real h = RealYlmSum(alm.h_view, lmax, theta, phi);
+    Real x0[3] = {center[0] + h*sin(theta)*cos(phi),
+                  center[1] + h*sin(theta)*sin(phi),
+                  center[2] + h*cos(theta)};
+    for (int q=0; q<npt_angle; ++q) {
+      for (int a=0; a<3; ++a) {
+        coords.h_view(npt_angle*p + q, a) = x0[a];
+      }
+    }
+    for (int a=0; a<3; ++a) {
+      coords.h_view(npt_angle*p + 2*a + 1, a) += delta;
+      coords.h_view(npt_angle*p + 2*a + 2, a) -= delta;
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void HorizonFinder::Expansion
+//! \brief computes rho*Theta, the area element, and h at every angle in one kernel.  With
+//! s^i the unit normal to F = r - h = 0 and m^ij = g^ij - s^i s^j,
+//!    Theta = m^ij (D_i D_j F / |DF| - K_ij)
+//! Derivatives of F are taken by central differences of the spectral representation,
+//! and derivatives of the metric by central differences of the interpolated values.
+//! The weight rho = h^2 gives the flow the dimension of h.
+
+void HorizonFinder::Expansion(Real delta) {
+  int nangles = pgrid->nangles;
+  int lmax_ = lmax;
+  Real c0 = center[0], c1 = center[1], c2 = center[2];
+  auto &alm_ = alm;
+  auto &pos = pgrid->polar_pos;
+  auto &vals = pinterp->vals;
+  auto &rhs_ = rhs;
+  par_for("ah_expansion",DevExeSpace(),0,nangles-1,
+  KOKKOS_LAMBDA(const int p) {
+    // index of symmetric components in g_dd and K_dd (ordered as in ADM), stored as a
+    // flattened 3x3 array
+    const int iv[9] = {0, 1, 2, 1, 3, 4, 2, 4, 5};
+    int p0 = npt_angle*p;
+    Real g[3][3], vK[3][3], dg[3][3][3];
+    for (int a=0; a<3; ++a) {
+      for (int b=0; b<3; ++b) {
+        g[a][b] = vals.d_view(p0,iv[3*a+b]);
+        vK[a][b] = vals.d_view(p0,6 + iv[3*a+b]);
+        for (int c=0; c<3; ++c) {
+          dg[c][a][b] = (vals.d_view(p0 + 2*c + 1,iv[3*a+b]) -
+                         vals.d_view(p0 + 2*c + 2,iv[3*a+b]))/(2.0*delta);
+        }
+      }
+    }
+    Real detg = adm::SpatialDet(g[0][0], g[0][1], g[0][2], g[1][1], g[1][2], g[2][2]);
+    Real gu[3][3];
+    adm::SpatialInv(1.0/detg, g[0][0], g[0][1], g[0][2], g[1][1], g[1][2], g[2][2],
+                    &gu[0][0], &gu[0][1], &gu[0][2], &gu[1][1], &gu[1][2], &gu[2][2]);
+    gu[1][0] = gu[0][1]; gu[2][0] = gu[0][2]; gu[2][1] = gu[1][2];
+
+    // surface point and derivatives of the level set there
+    Real theta = pos.d_view(p,0);
+    Real phi = pos.d_view(p,1);
+    Real h = RealYlmSum(alm_.d_view, lmax_, theta, phi);
+    Real x[3] = {c0 + h*sin(theta)*cos(phi), c1 + h*sin(theta)*sin(phi),
+                 c2 + h*cos(theta)};
+    Real f0 = LevelSet(alm_.d_view, lmax_, c0, c1, c2, x[0], x[1], x[2]);
+    Real dF[3], ddF[3][3];
+    for (int a=0; a<3; ++a) {
+      Real xp[3] = {x[0], x[1], x[2]};
+      Real xm[3] = {x[0], x[1], x[2]};
+      xp[a] += delta;
+      xm[a] -= delta;
+      Real fp = LevelSet(alm_.d_view, lmax_, c0, c1, c2, xp[0], xp[1], xp[2]);
+      Real fm = LevelSet(alm_.d_view, lmax_, c0, c1, c2, xm[0], xm[1], xm[2]);
+      dF[a] = (fp - fm)/(2.0*delta);
+      ddF[a][a] = (fp - 2.0*f0 + fm)/(delta*delta);
+      for (int b=a+1; b<3; ++b) {
+        Real fs[4];
+        for (int s=0; s<4; ++s) {
+          Real xs[3] = {x[0], x[1], x[2]};
+          xs[a] += (s < 2)? delta : -delta;
+          xs[b] += (s % 2 == 0)? delta : -delta;
+          fs[s] = LevelSet(alm_.d_view, lmax_, c0, c1, c2, xs[0], xs[1], xs[2]);
+        }
+        ddF[a][b] = (fs[0] - fs[1] - fs[2] + fs[3])/(4.0*delta*delta);
+        ddF[b][a] = ddF[a][b];
+      }
+    }
+
+    // unit normal
+    Real dFu[3], nrm2 = 0.0;
+    for (int a=0; a<3; ++a) {
+      dFu[a] = gu[a][0]*dF[0] + gu[a][1]*dF[1] + gu[a][2]*dF[2];
+      nrm2 += dFu[a]*dF[a];
+    }
+    Real nrm = sqrt(nrm2);
+
+    // Theta = m^ij (d_i d_j F - Gamma^k_ij d_k F)/|DF| - m^ij K_ij
+    Real expansion = 0.0;
+    for (int a=0; a<3; ++a) {
+      for (int b=0; b<3; ++b) {
+        Real mab = gu[a][b] - dFu[a]*dFu[b]/nrm2;
+        // Gamma^k_ab d_k F = g^kl Gamma_lab d_k F = dFu^l Gamma_lab
+        Real gdf = 0.0;
+        for (int l=0; l<3; ++l) {
+          gdf += 0.5*dFu[l]*(dg[a][b][l] + dg[b][a][l] - dg[l][a][b]);
+        }
+        expansion += mab*((ddF[a][b] - gdf)/nrm - vK[a][b]);
+      }
+    }
+    rhs_.d_view(p,0) = h*h*expansion;
+    rhs_.d_view(p,1) = sqrt(detg)*nrm*h*h;
+    rhs_.d_view(p,2) = h;
+  });
+  rhs.template modify<DevExeSpace>();
+  rhs.template sync<HostMemSpace>();
+
+  theta_max = 0.0;
+  for (int p=0; p<nangles; ++p) {
+    Real h = rhs.h_view(p,2);
+    theta_max = fmax(theta_max, fabs(rhs.h_view(p,0))/(h*h));
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void HorizonFinder::Write
+//! \brief appends properties of the horizon to its output file, with a flag indicating
+//! whether the last search converged
+
+void HorizonFinder::Write(Real time, bool converged) const {
+  if (0 == global_variable::my_rank) {
+    fprintf(pofile, "%.15e %d %.15e %.15e %.15e %.15e %.15e %.15e %.15e %.15e\n", time,
+            converged? 1 : 0, center[0], center[1], center[2], rmin, rmax, area, mass,
+            theta_max);
+    fflush(pofile);
+  }
+}
+
+} // namespace z4c
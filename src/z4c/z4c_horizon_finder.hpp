@@ -0,0 +1,151 @@
+#ifndef Z4C_Z4C_HORIZON_FINDER_HPP_
+#define Z4C_Z4C_HORIZON_FINDER_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file z4c_horizon_finder.hpp
+//! \brief definitions for HorizonFinder class, which locates apparent horizons with the
+//! fast-flow algorithm of Gundlach (gr-qc/9707050), using the angles of a GeodesicGrid
+//! and the PointInterpolator to evaluate the expansion on the trial surface.
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "athena.hpp"
+#include "geodesic-grid/geodesic_grid.hpp"
+
+// Forward declarations
+class MeshBlockPack;
+class ParameterInput;
+class PointInterpolator;
+
+namespace z4c {
+
+//----------------------------------------------------------------------------------------
+//! \fn Real RealYlm
+//! \brief orthonormal real spherical harmonic Y_lm, with cos(m phi) for m > 0 and
+//! sin(|m| phi) for m < 0.  Normalized associated Legendre functions are computed by
+//! the usual three-term recursion, so no factorials are required.
+
+KOKKOS_INLINE_FUNCTION
+Real RealYlm(const int l, const int m, const Real theta, const Real phi) {
+  int am = (m < 0)? -m : m;
+  Real x = cos(theta), s = sin(theta);
+  Real pmm = 0.5/sqrt(M_PI);
+  for (int mm=1; mm<=am; ++mm) {
+    pmm *= sqrt((2.0*mm + 1.0)/(2.0*mm))*s;
+  }
+  Real plm2 = 0.0, plm1 = pmm;
+  for (int ll=am+1; ll<=l; ++ll) {
+    Real l1 = ll - 1.0;
+    Real plm = sqrt((4.0*ll*ll - 1.0)/(ll*ll - am*am))*
+               (x*plm1 - sqrt((l1*l1 - am*am)/(4.0*l1*l1 - 1.0))*plm2);
+    plm2 = plm1;
+    plm1 = plm;
+  }
+  if (m > 0) return sqrt(2.0)*plm1*cos(am*phi);
+  if (m < 0) return sqrt(2.0)*plm1*sin(am*phi);
+  return plm1;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Real RealYlmSum
+//! \brief evaluates sum_{l<=lmax} a_lm Y_lm(theta,phi), with a_lm stored in a(l*l+l+m).
+//! Sums over l at fixed m, so that each normalized Legendre function is computed once.
+//! Templated on the view type so it can be called with host or device data.
+
+template <typename ViewType>
+KOKKOS_INLINE_FUNCTION
+Real RealYlmSum(const ViewType &a, const int lmax, const Real theta, const Real phi) {
+  Real x = cos(theta), s = sin(theta);
+  Real pmm = 0.5/sqrt(M_PI);
+  Real sum = 0.0;
+  for (int m=0; m<=lmax; ++m) {
+    if (m > 0) pmm *= sqrt((2.0*m + 1.0)/(2.0*m))*s;
+    Real cm = (m > 0)? sqrt(2.0)*cos(m*phi) : 1.0;
+    Real sm = sqrt(2.0)*sin(m*phi);
+    Real plm2 = 0.0, plm1 = pmm;
+    for (int l=m; l<=lmax; ++l) {
+      if (l > m) {
+        Real l1 = l - 1.0;
+        Real plm = sqrt((4.0*l*l - 1.0)/(l*l - m*m))*
+                   (x*plm1 - sqrt((l1*l1 - m*m)/(4.0*l1*l1 - 1.0))*plm2);
+        plm2 = plm1;
+        plm1 = plm;
+      }
+      sum += a(l*l + l + m)*cm*plm1;
+      if (m > 0) sum += a(l*l + l - m)*sm*plm1;
+    }
+  }
+  return sum;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool InsideHorizon
+//! \brief true if (x1,x2,x3) lies inside the fraction frac of a horizon with the given
+//! center and spectral coefficients of its radius
+
+template <typename ViewType>
+KOKKOS_INLINE_FUNCTION
+bool InsideHorizon(const ViewType &a, const int lmax, const Real c[3], const Real frac,
+                   const Real x1, const Real x2, const Real x3) {
+  Real dx = x1 - c[0], dy = x2 - c[1], dz = x3 - c[2];
+  Real r = sqrt(dx*dx + dy*dy + dz*dz);
+  if (r == 0.0) return true;
+  Real h = RealYlmSum(a, lmax, acos(dz/r), atan2(dy, dx));
+  return (r < frac*h);
+}
+
+//----------------------------------------------------------------------------------------
+//! \class HorizonFinder
+//! \brief Finds a single apparent horizon, parametrized as r = h(theta,phi) about a
+//! center.  Each iteration places the trial surface on the geodesic grid, interpolates
+//! the ADM metric and extrinsic curvature to it (and to points displaced by one finest
+//! cell width in each direction, for derivatives of the metric), computes the expansion
+//! at every angle in one kernel, and updates the spectral coefficients of h.
+
+class HorizonFinder {
+ public:
+  HorizonFinder(MeshBlockPack *ppack, ParameterInput *pin, int n);
+  ~HorizonFinder();
+
+  int lmax;                 // maximum l of the expansion of h
+  int nlm;                  // number of coefficients, (lmax+1)^2
+  bool found;               // true once a horizon has been found
+  Real center[3];           // center of the surface
+  Real rmin, rmax;          // extent of the last horizon found
+  Real area, mass;          // area and irreducible mass of the last horizon found
+  DualArray1D<Real> alm;    // coefficients of h, used by excision and AMR
+
+  // run the finder if this is a cycle on which it is due
+  void Find(int ncycle);
+  // write properties of the horizon to file
+  void Write(Real time, bool converged) const;
+
+ private:
+  MeshBlockPack *pmy_pack;  // ptr to MeshBlockPack containing this finder
+  int nhorizon;             // index of this horizon (from 0)
+  int npunct;               // index of puncture used as center (-1 for fixed center)
+  int ncycle_find;          // run finder every ncycle_find cycles
+  int max_iter;             // maximum number of fast-flow iterations
+  Real tol;                 // tolerance on max |expansion|
+  Real flow_alpha, flow_beta;  // fast-flow parameters
+  Real rinit;               // radius of initial guess
+  Real theta_max;           // max |expansion| on last iteration
+  std::unique_ptr<GeodesicGrid> pgrid;  // angles and solid angles of trial surface
+  PointInterpolator *pinterp;           // interpolates ADM variables to surface
+  DualArray2D<Real> ylm;    // (nangles,nlm) real Y_lm at each angle
+  DualArray2D<Real> rhs;    // (nangles,3) rho*Theta, area element and h on surface
+  std::string ofname;
+  FILE *pofile;
+
+  void SetSurfacePoints(Real delta);
+  void Expansion(Real delta);
+};
+
+} // namespace z4c
+#endif // Z4C_Z4C_HORIZON_FINDER_HPP_
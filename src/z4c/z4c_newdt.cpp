@@ -22,40 +22,34 @@ namespace z4c {
 //----------------------------------------------------------------------------------------
 //! \fn void Z4c::NewTimeStep()
 //! \brief calculate the minimum timestep within a MeshBlockPack for z4c problems
+//! The timestep depends only on the MeshBlock sizes, so it is computed on the host from
+//! the host mirror of mb_size, and only when the Mesh has changed (refinement or load
+//! balancing).  This avoids a device reduction and synchronization in every cycle.
 
 TaskStatus Z4c::NewTimeStep(Driver *pdriver, int stage) {
   if (stage != (pdriver->nexp_stages)) {
     return TaskStatus::complete; // only execute last stage
   }
-
-  auto &indcs = pmy_pack->pmesh->mb_indcs;
-  int nx1 = indcs.nx1;
-  int nx2 = indcs.nx2;
-  int nx3 = indcs.nx3;
+  if (dtnew_version_ == pmy_pack->pmesh->mesh_version) {
+    return TaskStatus::complete; // MeshBlocks unchanged since dtnew computed
+  }
 
   Real dt1 = std::numeric_limits<float>::max();
   Real dt2 = std::numeric_limits<float>::max();
   Real dt3 = std::numeric_limits<float>::max();
 
-  // capture class variables for kernel
   auto &mbsize = pmy_pack->pmb->mb_size;
-  const int nmkji = (pmy_pack->nmb_thispack)*nx3*nx2*nx1;
-  const int nkji = nx3*nx2*nx1;
-
-  Kokkos::parallel_reduce("Z4c dt",Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
-  KOKKOS_LAMBDA(const int &idx, Real &min_dt1, Real &min_dt2, Real &min_dt3) {
-    // compute m,k,j,i indices of thread and call function
-    int m = (idx)/nkji;
-
-    min_dt1 = fmin((mbsize.d_view(m).dx1), min_dt1);
-    min_dt2 = fmin((mbsize.d_view(m).dx2), min_dt2);
-    min_dt3 = fmin((mbsize.d_view(m).dx3), min_dt3);
-  }, Kokkos::Min<Real>(dt1), Kokkos::Min<Real>(dt2),Kokkos::Min<Real>(dt3));
+  for (int m=0; m<(pmy_pack->nmb_thispack); ++m) {
+    dt1 = std::min(mbsize.h_view(m).dx1, dt1);
+    dt2 = std::min(mbsize.h_view(m).dx2, dt2);
+    dt3 = std::min(mbsize.h_view(m).dx3, dt3);
+  }
 
   // compute minimum of dt1/dt2/dt3 for 1D/2D/3D problems
   dtnew = dt1;
   if (pmy_pack->pmesh->multi_d) { dtnew = std::min(dtnew, dt2); }
   if (pmy_pack->pmesh->three_d) { dtnew = std::min(dtnew, dt3); }
+  dtnew_version_ = pmy_pack->pmesh->mesh_version;
 
   return TaskStatus::complete;
 }
@@ -14,15 +14,11 @@
 #include <sstream>
 #include <string>
 
-#if MPI_PARALLEL_ENABLED
-#include <mpi.h>
-#endif
-
 #include "athena.hpp"
 #include "globals.hpp"
 #include "mesh/mesh.hpp"
 #include "parameter_input.hpp"
-#include "utils/lagrange_interpolator.hpp"
+#include "utils/point_interpolator.hpp"
 #include "z4c/z4c.hpp"
 #include "z4c_puncture_tracker.hpp"
 
@@ -39,7 +35,9 @@ PunctureTracker::PunctureTracker(Mesh *pmesh, ParameterInput *pin, int n):
   pos[0] = pin->GetOrAddReal("z4c", "bh_" + std::to_string(n) + "_x", 0.0);
   pos[1] = pin->GetOrAddReal("z4c", "bh_" + std::to_string(n) + "_y", 0.0);
   pos[2] = pin->GetOrAddReal("z4c", "bh_" + std::to_string(n) + "_z", 0.0);
-  bitant = pin->GetOrAddBoolean("z4c", "bitant", false);
+  // punctures stay on z=0 in domains with reflection symmetry about that plane (set by
+  // <mesh>/symmetry = bitant or octant)
+  bitant = pin->GetOrAddBoolean("z4c", "bitant", pmesh->symmetric[2]);
   if (0 == global_variable::my_rank) {
     // check if output file already exists
     if (access(ofname.c_str(), F_OK) == 0) {
@@ -93,64 +91,43 @@ PunctureTracker::~PunctureTracker() {
 }
 
 //----------------------------------------------------------------------------------------
-void PunctureTracker::InterpolateShift(MeshBlockPack *pmbp) {
+// Interpolates the shift to all punctures in one kernel, and shares the result with all
+// ranks in a single reduction, so every rank holds the position of every puncture.
+void PunctureTracker::InterpolateShift(MeshBlockPack *pmbp,
+                                       const std::vector<PunctureTracker *> &trackers) {
   auto &pz4c = pmbp->pz4c;
-  auto &u0   = pz4c->u0;
-  auto *S    = new LagrangeInterpolator(pmbp, pos);
-
-  if (S->point_exist) {
-    betap[0]      = S->Interpolate(u0, pz4c->I_Z4C_BETAX);
-    betap[1]      = S->Interpolate(u0, pz4c->I_Z4C_BETAY);
-    betap[2]      = S->Interpolate(u0, pz4c->I_Z4C_BETAZ);
-    owns_puncture = true;
+  int npunct = trackers.size();
+  PointInterpolator interp(pmbp, npunct);
+  for (int n = 0; n < npunct; ++n) {
+    for (int a = 0; a < NDIM; ++a) {
+      interp.coords.h_view(n,a) = trackers[n]->pos[a];
+    }
+  }
+  interp.SetPoints();
+  interp.Interpolate(NDIM, pz4c->u0, pz4c->I_Z4C_BETAX);
+  interp.ReduceValues();
+  for (int n = 0; n < npunct; ++n) {
+    trackers[n]->owns_puncture = (interp.nowners(n) > 0.0);
+    for (int a = 0; a < NDIM; ++a) {
+      trackers[n]->betap[a] = interp.vals.h_view(n,a);
+    }
   }
-
-  delete S;
 }
 
 //----------------------------------------------------------------------------------------
 void PunctureTracker::EvolveTracker() {
-  if (owns_puncture) {
-    for (int a = 0; a < NDIM; ++a) {
-      pos[a] -= pmesh->dt * betap[a];
-    }
-    // Impose the motion on the z = 0 plane with bitant.
-    if (bitant)
-      pos[2] = 0;
-#if !(MPI_PARALLEL_ENABLED)
-  } else {
-    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-              << std::endl;
-    std::cout << "couldn't find the puncture!" << std::endl;
-    std::exit(EXIT_FAILURE);
-  }
-#else
-  }
-  Real buf[2 * NDIM + 1] = {0., 0., 0., 0., 0., 0., 0.};
-  if (owns_puncture) {
-    buf[0] = pos[0];
-    buf[1] = pos[1];
-    buf[2] = pos[2];
-    buf[3] = betap[0];
-    buf[4] = betap[1];
-    buf[5] = betap[2];
-    buf[6] = 1.0;
-  }
-  MPI_Allreduce(
-    MPI_IN_PLACE, buf, 2 * NDIM + 1, MPI_ATHENA_REAL, MPI_SUM, MPI_COMM_WORLD);
-  if (buf[6] < 1.) {
+  if (!owns_puncture) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
               << std::endl;
     std::cout << "The puncture has left the grid" << std::endl;
     std::exit(EXIT_FAILURE);
   }
-  pos[0]   = buf[0] / buf[6];
-  pos[1]   = buf[1] / buf[6];
-  pos[2]   = buf[2] / buf[6];
-  betap[0] = buf[3] / buf[6];
-  betap[1] = buf[4] / buf[6];
-  betap[2] = buf[5] / buf[6];
-#endif // MPI_PARALLEL_ENABLED
+  for (int a = 0; a < NDIM; ++a) {
+    pos[a] -= pmesh->dt * betap[a];
+  }
+  // Impose the motion on the z = 0 plane with bitant.
+  if (bitant)
+    pos[2] = 0;
 
   // After the puncture has moved it might have changed ownership
   owns_puncture = false;
@@ -9,6 +9,7 @@
 
 #include <cstdio>
 #include <string>
+#include <vector>
 
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
@@ -28,8 +29,9 @@ class PunctureTracker {
   PunctureTracker(Mesh *pmesh, ParameterInput *pin, int n);
   //! Destructor (will close output file)
   ~PunctureTracker();
-  //! Interpolate the shift vector to the puncture position
-  void InterpolateShift(MeshBlockPack *pmbp);
+  //! Interpolate the shift vector to the positions of all punctures
+  static void InterpolateShift(MeshBlockPack *pmbp,
+                               const std::vector<PunctureTracker *> &trackers);
   //! Update and broadcast the puncture position
   void EvolveTracker();
   //! Write data to file
@@ -21,6 +21,8 @@
 #include "z4c/z4c.hpp"
 #include "tasklist/numerical_relativity.hpp"
 #include "z4c/z4c_puncture_tracker.hpp"
+#include "z4c/z4c_horizon_finder.hpp"
+#include "utils/managed_memory.hpp"
 
 namespace z4c {
 //----------------------------------------------------------------------------------------
@@ -48,22 +50,28 @@ void Z4c::AssembleZ4cTasks(std::map<std::string, std::shared_ptr<TaskList>> tl)
       case 4: id.crhs  = tl["stagen"]->AddTask(&Z4c::CalcRHS<4>, this, id.copyu);
               break;
   }
-  id.sombc = tl["stagen"]->AddTask(&Z4c::Z4cBoundaryRHS, this, id.crhs);
-  id.expl  = tl["stagen"]->AddTask(&Z4c::ExpRKUpdate, this, id.sombc);
+  id.expl  = tl["stagen"]->AddTask(&Z4c::ExpRKUpdate, this, id.crhs);
   id.restu = tl["stagen"]->AddTask(&Z4c::RestrictU, this, id.expl);
   id.sendu = tl["stagen"]->AddTask(&Z4c::SendU, this, id.restu);
   id.recvu = tl["stagen"]->AddTask(&Z4c::RecvU, this, id.sendu);
   id.bcs   = tl["stagen"]->AddTask(&Z4c::ApplyPhysicalBCs, this, id.recvu);
   id.prol  = tl["stagen"]->AddTask(&Z4c::Prolongate, this, id.bcs);
-  id.algc  = tl["stagen"]->AddTask(&Z4c::EnforceAlgConstr, this, id.prol);
+  if (overlap_comm) {
+    // constraints in active cells are enforced while boundary values are in flight,
+    // only ghost zones wait for RecvU
+    id.algca = tl["stagen"]->AddTask(&Z4c::EnforceAlgConstrActive, this, id.sendu);
+    id.algc  = tl["stagen"]->AddTask(&Z4c::EnforceAlgConstrGhosts, this,
+                                     (id.prol|id.algca));
+  } else {
+    id.algc  = tl["stagen"]->AddTask(&Z4c::EnforceAlgConstr, this, id.prol);
+  }
   id.newdt = tl["stagen"]->AddTask(&Z4c::NewTimeStep, this, id.algc);
   // "after_stagen" task list
   id.csend = tl["after_stagen"]->AddTask(&Z4c::ClearSend, this, none);
   id.crecv = tl["after_stagen"]->AddTask(&Z4c::ClearRecv, this, id.csend);
   id.z4tad = tl["after_stagen"]->AddTask(&Z4c::Z4cToADM_, this, id.crecv);
-  id.admc  = tl["after_stagen"]->AddTask(&Z4c::ADMConstraints_, this, id.z4tad);
-  id.weyl_scalar  = tl["after_stagen"]->AddTask(&Z4c::CalcWeylScalar, this, id.z4tad);
-  id.weyl_rest = tl["after_stagen"]->AddTask(&Z4c::RestrictWeyl, this, id.weyl_scalar);
+  id.admc  = tl["after_stagen"]->AddTask(&Z4c::CalcDiagnostics, this, id.z4tad);
+  id.weyl_rest = tl["after_stagen"]->AddTask(&Z4c::RestrictWeyl, this, id.admc);
   id.weyl_send = tl["after_stagen"]->AddTask(&Z4c::SendWeyl, this, id.weyl_rest);
   id.weyl_recv = tl["after_stagen"]->AddTask(&Z4c::RecvWeyl, this, id.weyl_send);
   id.weyl_prol  = tl["after_stagen"]->AddTask(&Z4c::ProlongateWeyl, this, id.weyl_recv);
@@ -71,6 +79,9 @@ void Z4c::AssembleZ4cTasks(std::map<std::string, std::shared_ptr<TaskList>> tl)
   id.crecvweyl = tl["after_stagen"]->AddTask(&Z4c::ClearRecvWeyl, this, id.csendweyl);
   id.wave_extr = tl["after_stagen"]->AddTask(&Z4c::CalcWaveForm, this, id.crecvweyl);
   id.ptrck = tl["after_stagen"]->AddTask(&Z4c::PunctureTracker, this, id.z4tad);
+  id.ptevo = tl["after_stagen"]->AddTask(&Z4c::EvolvePunctures, this, id.ptrck);
+  tl["after_stagen"]->SetHostTask(id.ptevo);
+  id.ahf = tl["after_stagen"]->AddTask(&Z4c::FindHorizons, this, id.ptevo);
   return;
 }
 
@@ -103,10 +114,8 @@ void Z4c::QueueZ4cTasks() {
                      Task_Run, {Z4c_CopyU}, {MHD_SetTmunu});
       break;
   }
-  pnr->QueueTask(&Z4c::Z4cBoundaryRHS, this, Z4c_SomBC, "Z4c_SomBC", Task_Run,
-                 {Z4c_CalcRHS});
   pnr->QueueTask(&Z4c::ExpRKUpdate, this, Z4c_ExplRK, "Z4c_ExplRK", Task_Run,
-                 {Z4c_SomBC},{MHD_EField});
+                 {Z4c_CalcRHS},{MHD_EField});
   pnr->QueueTask(&Z4c::RestrictU, this, Z4c_RestU, "Z4c_RestU", Task_Run, {Z4c_ExplRK});
   pnr->QueueTask(&Z4c::SendU, this, Z4c_SendU, "Z4c_SendU", Task_Run, {Z4c_RestU});
   pnr->QueueTask(&Z4c::RecvU, this, Z4c_RecvU, "Z4c_RecvU", Task_Run, {Z4c_SendU});
@@ -127,11 +136,10 @@ void Z4c::QueueZ4cTasks() {
   pnr->QueueTask(&Z4c::ClearRecv, this, Z4c_ClearR, "Z4c_ClearR", Task_End, {Z4c_ClearS});
   /*pnr->QueueTask(&Z4c::Z4cToADM_, this, Z4c_Z4c2ADM, "Z4c_Z4c2ADM", Task_End,
                  {Z4c_ClearR});*/
-  pnr->QueueTask(&Z4c::ADMConstraints_, this, Z4c_ADMC, "Z4c_ADMC", Task_End,
+  pnr->QueueTask(&Z4c::CalcDiagnostics, this, Z4c_ADMC, "Z4c_ADMC", Task_End,
   //               {Z4c_Z4c2ADM});
                  {Z4c_ClearR});
-  pnr->QueueTask(&Z4c::CalcWeylScalar, this, Z4c_Weyl, "Z4c_Weyl", Task_End, {Z4c_ADMC});
-  pnr->QueueTask(&Z4c::RestrictWeyl, this, Z4c_RestW, "Z4c_RestW", Task_End, {Z4c_Weyl});
+  pnr->QueueTask(&Z4c::RestrictWeyl, this, Z4c_RestW, "Z4c_RestW", Task_End, {Z4c_ADMC});
   pnr->QueueTask(&Z4c::SendWeyl, this, Z4c_SendW, "Z4c_SendW", Task_End, {Z4c_RestW});
   pnr->QueueTask(&Z4c::RecvWeyl, this, Z4c_RecvW, "Z4c_RecvW", Task_End, {Z4c_SendW});
   pnr->QueueTask(&Z4c::ProlongateWeyl, this, Z4c_ProlW, "Z4c_ProlW", Task_End,
@@ -143,6 +151,11 @@ void Z4c::QueueZ4cTasks() {
   pnr->QueueTask(&Z4c::CalcWaveForm, this, Z4c_Wave, "Z4c_Wave", Task_End,
                  {Z4c_ClearRW});
   pnr->QueueTask(&Z4c::PunctureTracker, this, Z4c_PT, "Z4c_PT", Task_End, {Z4c_ADMC});
+  pnr->QueueTask(&Z4c::EvolvePunctures, this, Z4c_PTEvolve, "Z4c_PTEvolve", Task_End,
+                 {Z4c_PT});
+  pnr->SetHostTask(Z4c_PTEvolve);
+  pnr->QueueTask(&Z4c::FindHorizons, this, Z4c_AHF, "Z4c_AHF", Task_End,
+                 {Z4c_PTEvolve});
 }
 
 //----------------------------------------------------------------------------------------
@@ -151,6 +164,7 @@ void Z4c::QueueZ4cTasks() {
 //  receive status flags to waiting (with or without MPI) for Wave variables.
 
 TaskStatus Z4c::InitRecv(Driver *pdrive, int stage) {
+  if (pmy_pack->pmesh->multilevel) {ManagedMemory::Prefetch(coarse_u0);}
   TaskStatus tstat = pbval_u->InitRecv(nz4c);
   if (tstat != TaskStatus::complete) return tstat;
   return tstat;
@@ -178,11 +192,10 @@ TaskStatus Z4c::ClearSend(Driver *pdrive, int stage) {
 
 //----------------------------------------------------------------------------------------
 //! \fn  void Z4c::CopyU
-//! \brief  copy u0 --> u1 in first stage
+//! \brief  update u1 with u0 at later stages of 2S integrators (copy u0 --> u1 in first
+//!  stage is fused with ExpRKUpdate)
 
 TaskStatus Z4c::CopyU(Driver *pdrive, int stage) {
-  auto integrator = pdrive->integrator;
-
   auto &indcs = pmy_pack->pmesh->mb_indcs;
   int is = indcs.is, ie = indcs.ie;
   int js = indcs.js, je = indcs.je;
@@ -192,23 +205,16 @@ TaskStatus Z4c::CopyU(Driver *pdrive, int stage) {
   auto &u0 = pmy_pack->pz4c->u0;
   auto &u1 = pmy_pack->pz4c->u1;
 
-  // hierarchical parallel loop that updates conserved variables to intermediate step
-  // using weights and fractional time step appropriate to stages of time-integrator.
-  // Important to use vector inner loop for good performance on cpus
-  if (integrator == "rk4") {
+  // In the first stage the copy u0 --> u1 is performed by ExpRKUpdate() in the same
+  // kernel as the update, so that u0 is not read (and u1 written) in a separate pass.
+  // Only active cells of u1 are ever used.  With 2S integrators, u1 is updated with u0
+  // at later stages.
+  if (pdrive->use_delta && stage > 1) {
     Real &delta = pdrive->delta[stage-1];
-    if (stage == 1) {
-      Kokkos::deep_copy(DevExeSpace(), u1, u0);
-    } else {
-      par_for("CopyCons", DevExeSpace(),0, nmb1, 0, nvar-1, ks, ke, js, je, is, ie,
-      KOKKOS_LAMBDA(int m, int n, int k, int j, int i){
-        u1(m,n,k,j,i) += delta*u0(m,n,k,j,i);
-      });
-    }
-  } else {
-    if (stage == 1) {
-      Kokkos::deep_copy(DevExeSpace(), u1, u0);
-    }
+    par_for("CopyCons", DevExeSpace(),0, nmb1, 0, nvar-1, ks, ke, js, je, is, ie,
+    KOKKOS_LAMBDA(int m, int n, int k, int j, int i){
+      u1(m,n,k,j,i) += delta*u0(m,n,k,j,i);
+    });
   }
   return TaskStatus::complete;
 }
@@ -242,6 +248,38 @@ TaskStatus Z4c::EnforceAlgConstr(Driver *pdrive, int stage) {
   return TaskStatus::complete;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn  void Z4c::EnforceAlgConstrActive
+//! \brief Enforces algebraic constraints in active cells only.  Used with
+//! overlap_comm=true, in which case it runs while communication of ghost zones is in
+//! flight.  Neighbors receive unconstrained data, exactly as without overlap.
+
+TaskStatus Z4c::EnforceAlgConstrActive(Driver *pdrive, int stage) {
+  if (pmy_pack->pdyngr != nullptr || stage == pdrive->nexp_stages) {
+    auto &indcs = pmy_pack->pmesh->mb_indcs;
+    AlgConstr(pmy_pack, indcs.is, indcs.ie, indcs.js, indcs.je, indcs.ks, indcs.ke);
+  }
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void Z4c::EnforceAlgConstrGhosts
+//! \brief Enforces algebraic constraints in ghost zones only, once boundary values have
+//! been received.  Used with overlap_comm=true.
+
+TaskStatus Z4c::EnforceAlgConstrGhosts(Driver *pdrive, int stage) {
+  if (pmy_pack->pdyngr != nullptr || stage == pdrive->nexp_stages) {
+    int slab[6][6];
+    int nslab = GhostZoneSlabs(pmy_pack->pmesh->mb_indcs, slab,
+                               pmy_pack->pmesh->mb_indcs.ng);
+    for (int n=0; n<nslab; ++n) {
+      AlgConstr(pmy_pack, slab[n][0], slab[n][1], slab[n][2], slab[n][3], slab[n][4],
+                slab[n][5]);
+    }
+  }
+  return TaskStatus::complete;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn  void Z4c::ADMToZ4c_
 //! \brief
@@ -265,24 +303,44 @@ TaskStatus Z4c::UpdateExcisionMasks(Driver *pdrive, int stage) {
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn  void Z4c::ADM_Constraints_
-//! \brief
+//! \fn  void Z4c::CalcDiagnostics
+//! \brief computes the constraints and Weyl scalar at the end of the step, but only when
+//! an output (or wave extraction) that reads them is due this cycle
 
-TaskStatus Z4c::ADMConstraints_(Driver *pdrive, int stage) {
-  auto &indcs = pmy_pack->pmesh->mb_indcs;
+TaskStatus Z4c::CalcDiagnostics(Driver *pdrive, int stage) {
   if (stage == pdrive->nexp_stages) {
-    switch (indcs.ng) {
-      case 2: ADMConstraints<2>(pmy_pack);
-              break;
-      case 3: ADMConstraints<3>(pmy_pack);
-              break;
-      case 4: ADMConstraints<4>(pmy_pack);
-              break;
+    float time_32 = static_cast<float>(pmy_pack->pmesh->time);
+    bool calc_wave = (nrad != 0) && (last_output_time == time_32);
+    bool calc_con = pdrive->OutputDue(&u_con);
+    bool calc_weyl = calc_wave || pdrive->OutputDue(&u_weyl);
+    // arrays are only used on output cycles, so may have been evicted from device memory
+    if (calc_con) {ManagedMemory::Prefetch(u_con);}
+    if (calc_weyl) {
+      ManagedMemory::Prefetch(u_weyl);
+      ManagedMemory::Prefetch(coarse_u_weyl);
     }
+    Diagnostics(calc_con, calc_weyl);
   }
   return TaskStatus::complete;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn  void Z4c::Diagnostics
+//! \brief selects the fused diagnostics kernel for the number of ghost zones
+
+void Z4c::Diagnostics(bool calc_con, bool calc_weyl) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  switch (indcs.ng) {
+    case 2: Z4cDiagnostics<2>(pmy_pack, calc_con, calc_weyl);
+            break;
+    case 3: Z4cDiagnostics<3>(pmy_pack, calc_con, calc_weyl);
+            break;
+    case 4: Z4cDiagnostics<4>(pmy_pack, calc_con, calc_weyl);
+            break;
+  }
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn  void Z4c::RestrictU
 //! \brief
@@ -319,17 +377,35 @@ TaskStatus Z4c::ApplyPhysicalBCs(Driver *pdrive, int stage) {
     pbval_u->Z4cBCs((pmy_pack), (pbval_u->u_in), u0, coarse_u0);
 
     // user BCs
-    if (pmy_pack->pmesh->pgen->user_bcs) {
-      (pmy_pack->pmesh->pgen->user_bcs_func)(pmy_pack->pmesh);
+    auto &pgen = pmy_pack->pmesh->pgen;
+    if (pgen->user_bcs && pgen->user_bcs_func != nullptr) {
+      (pgen->user_bcs_func)(pmy_pack->pmesh);
     }
   }
   return TaskStatus::complete;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn  void Z4c::PunctureTracker
+//! \brief Interpolates the shift to the punctures at the end of the step (launches
+//! kernels and reduces over ranks, so this is a device task).
+
 TaskStatus Z4c::PunctureTracker(Driver *pdrive, int stage) {
+  if (stage == pdrive->nexp_stages) {
+    z4c::PunctureTracker::InterpolateShift(pmy_pack, pmy_pack->pz4c_ptracker);
+  }
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void Z4c::EvolvePunctures
+//! \brief Advances the punctures with the interpolated shift and writes their positions.
+//! Only host data is used, so this is a host task, which runs on the HostTaskPool
+//! (if enabled) while CalcWaveForm and the other tasks of the list proceed.
+
+TaskStatus Z4c::EvolvePunctures(Driver *pdrive, int stage) {
   if (stage == pdrive->nexp_stages) {
     for (auto ptracker : pmy_pack->pz4c_ptracker) {
-      ptracker->InterpolateShift(pmy_pack);
       ptracker->EvolveTracker();
       ptracker->WriteTracker();
     }
@@ -337,29 +413,18 @@ TaskStatus Z4c::PunctureTracker(Driver *pdrive, int stage) {
   return TaskStatus::complete;
 }
 
-
 //----------------------------------------------------------------------------------------
-//! \fn  void Z4c::CalcWeylScalar_
-//! \brief
+//! \fn  void Z4c::FindHorizons
+//! \brief Searches for apparent horizons at the end of the step.  Excision masks and
+//! AMR use the last horizon found, so they never wait on a search in progress.
 
-TaskStatus Z4c::CalcWeylScalar(Driver *pdrive, int stage) {
-  if (pmy_pack->pz4c->nrad == 0) {
-    return TaskStatus::complete;
-  } else {
-    float time_32 = static_cast<float>(pmy_pack->pmesh->time);
-    if (last_output_time==time_32 && stage == pdrive->nexp_stages) {
-      auto &indcs = pmy_pack->pmesh->mb_indcs;
-      switch (indcs.ng) {
-        case 2: Z4cWeyl<2>(pmy_pack);
-                break;
-        case 3: Z4cWeyl<3>(pmy_pack);
-                break;
-        case 4: Z4cWeyl<4>(pmy_pack);
-                break;
-      }
+TaskStatus Z4c::FindHorizons(Driver *pdrive, int stage) {
+  if (stage == pdrive->nexp_stages) {
+    for (auto &pahf : horizon_finders) {
+      pahf->Find(pmy_pack->pmesh->ncycle);
     }
-    return TaskStatus::complete;
   }
+  return TaskStatus::complete;
 }
 
 TaskStatus Z4c::CalcWaveForm(Driver *pdrive, int stage) {
@@ -439,6 +504,10 @@ TaskStatus Z4c::ProlongateWeyl(Driver *pdrive, int stage) {
   } else {
     float time_32 = static_cast<float>(pmy_pack->pmesh->time);
     if ((last_output_time==time_32) && (stage == pdrive->nexp_stages)) {
+      // reflecting BCs, needed to interpolate near planes of symmetry
+      if (!(pmy_pack->pmesh->strictly_periodic)) {
+        pbval_weyl->WeylBCs(pmy_pack, u_weyl, coarse_u_weyl);
+      }
       if (pmy_pack->pmesh->multilevel) {
         pbval_weyl->ProlongateCC(u_weyl, coarse_u_weyl);
       }
@@ -34,6 +34,20 @@ TaskStatus Z4c::ExpRKUpdate(Driver *pdriver, int stage) {
   int nmb1 = pmy_pack->nmb_thispack - 1;
   int nvar = nz4c;
 
+  // In the first stage u1 = u0 at start of the step, so store u0 into u1 (in place of a
+  // separate copy in CopyU) while updating it
+  if (stage == 1) {
+    Real gam01 = gam0 + gam1;
+    par_for("z4c RK update",DevExeSpace(),
+        0,nmb1,0,nvar-1,ks,ke,js,je,is,ie,
+    KOKKOS_LAMBDA(const int m, const int n, const int k, const int j, const int i) {
+      Real u = u0(m,n,k,j,i);
+      u1(m,n,k,j,i) = u;
+      u0(m,n,k,j,i) = gam01*u + beta_dt*u_rhs(m,n,k,j,i);
+    });
+    return TaskStatus::complete;
+  }
+
   par_for("z4c RK update",DevExeSpace(),
       0,nmb1,0,nvar-1,ks,ke,js,je,is,ie,
   KOKKOS_LAMBDA(const int m, const int n, const int k, const int j, const int i) {
@@ -74,67 +74,81 @@ void Z4c::WaveExtr(MeshBlockPack *pmbp) {
 
   // number of radii
   int nradii = grids.size();
+  if (nradii == 0) return;
 
   // maximum l; TODO(@hzhu): read in from input file
   int lmax = 8;
-  bool bitant = false;
-
-  Real ylmR,ylmI;
-  for (int g=0; g<nradii; ++g) {
-    // Interpolate Weyl scalars to the surface
-    grids[g]->InterpolateToSphere(2, u_weyl);
+  int nlm = LmIndex(lmax,lmax) + 1;
+
+  // Tabulate solid-angle weighted spin-weighted spherical harmonics at every angle the
+  // first time through.  All extraction spheres are built with the same geodesic grid
+  // level, so they share angles and a single table is used for all radii.
+  int nangles = grids[0]->nangles;
+  auto &ylm = pmbp->pz4c->swsh_wghts;
+  if (ylm.extent_int(0) != nlm || ylm.extent_int(1) != nangles) {
+    Kokkos::realloc(ylm, nlm, nangles, 2);
+    auto ylm_h = Kokkos::create_mirror_view(ylm);
+    Real ylmR,ylmI;
     for (int l = 2; l < lmax+1; ++l) {
       for (int m = -l; m < l+1 ; ++m) {
-        Real psilmR = 0.0;
-        Real psilmI = 0.0;
-          for (int ip = 0; ip < grids[g]->nangles; ++ip) {
-            Real theta = grids[g]->polar_pos.h_view(ip,0);
-            Real phi = grids[g]->polar_pos.h_view(ip,1);
-            Real datareal = grids[g]->interp_vals.h_view(ip,0);
-            Real dataim = grids[g]->interp_vals.h_view(ip,1);
-            Real weight = grids[g]->solid_angles.h_view(ip);
-            swsh(&ylmR,&ylmI,l,m,theta,phi);
-            // The spherical harmonics transform as
-            // Y^s_{l m}( Pi-th, ph ) = (-1)^{l+s} Y^s_{l -m}(th, ph)
-            // but the PoisitionPolar function returns theta \in [0,\pi],
-            // so these are correct for bitant.
-            // With bitant, under reflection the imaginary part of
-            // the weyl scalar should pick a - sign,
-            // which is accounted for here.
-            // Real bitant_z_fac = (bitant && theta > M_PI/2) ? -1 : 1;
-            psilmR += weight*(datareal*ylmR + dataim*ylmI);
-            psilmI += weight*(dataim*ylmR - datareal*ylmI);
-          }
-        psi_out(g,LmIndex(l,m),0) = psilmR;
-        psi_out(g,LmIndex(l,m),1) = psilmI;
+        for (int ip = 0; ip < nangles; ++ip) {
+          Real theta = grids[0]->polar_pos.h_view(ip,0);
+          Real phi = grids[0]->polar_pos.h_view(ip,1);
+          Real weight = grids[0]->solid_angles.h_view(ip);
+          swsh(&ylmR,&ylmI,l,m,theta,phi);
+          ylm_h(LmIndex(l,m),ip,0) = weight*ylmR;
+          ylm_h(LmIndex(l,m),ip,1) = weight*ylmI;
+        }
       }
     }
+    Kokkos::deep_copy(ylm, ylm_h);
+    Kokkos::realloc(pmbp->pz4c->psi_modes, nradii, nlm, 2);
   }
 
-  // write output
+  auto &psi_modes = pmbp->pz4c->psi_modes;
+  for (int g=0; g<nradii; ++g) {
+    // Interpolate Weyl scalars to the surface
+    grids[g]->InterpolateToSphere(2, u_weyl);
+
+    // project onto every mode on the device, one team per (l,m) and real/imaginary part
+    // The spherical harmonics transform as
+    // Y^s_{l m}( Pi-th, ph ) = (-1)^{l+s} Y^s_{l -m}(th, ph)
+    // but the PoisitionPolar function returns theta \in [0,\pi],
+    // so these are correct for bitant.
+    // With reflection symmetry, points outside the Mesh are interpolated at their
+    // reflection, under which the imaginary part of the weyl scalar picks a - sign
+    // (for an odd number of reflections), which is accounted for here.
+    auto &ivals = grids[g]->interp_vals;
+    auto &nreflect = grids[g]->nreflect;
+    par_for_outer("wave_extr",DevExeSpace(),0,0,0,nlm-1,0,1,
+    KOKKOS_LAMBDA(TeamMember_t member, const int lm, const int c) {
+      Real psilm = 0.0;
+      Kokkos::parallel_reduce(Kokkos::TeamThreadRange(member, nangles),
+      [&](const int ip, Real &sum) {
+        Real datareal = ivals.d_view(ip,0);
+        Real dataim = (nreflect.d_view(ip) % 2)? -ivals.d_view(ip,1) : ivals.d_view(ip,1);
+        if (c == 0) {
+          sum += datareal*ylm(lm,ip,0) + dataim*ylm(lm,ip,1);
+        } else {
+          sum += dataim*ylm(lm,ip,0) - datareal*ylm(lm,ip,1);
+        }
+      }, psilm);
+      Kokkos::single(Kokkos::PerTeam(member), [&]() {
+        psi_modes(g,lm,c) = psilm;
+      });
+    });
+  }
+  Kokkos::deep_copy(psi_out, psi_modes);
+
+  // sum contributions of all ranks with a single reduction
   #if MPI_PARALLEL_ENABLED
+  int count = nradii*nlm*2;
   if (0 == global_variable::my_rank) {
-    for (int g=0; g<nradii; ++g) {
-      for(int l=2; l<lmax+1; ++l) {
-        for(int m=-l; m<l+1; ++m) {
-        MPI_Reduce(MPI_IN_PLACE, &psi_out(g,LmIndex(l,m),0), 1,
-          MPI_ATHENA_REAL, MPI_SUM, 0, MPI_COMM_WORLD);
-        MPI_Reduce(MPI_IN_PLACE, &psi_out(g,LmIndex(l,m),1), 1,
-          MPI_ATHENA_REAL, MPI_SUM, 0, MPI_COMM_WORLD);
-        }
-      }
-    }
+    MPI_Reduce(MPI_IN_PLACE, psi_out.data(), count, MPI_ATHENA_REAL, MPI_SUM, 0,
+               global_variable::athena_comm);
   } else {
-    for (int g=0; g<nradii; ++g) {
-      for(int l=2; l<lmax+1; ++l) {
-        for(int m=-l; m<l+1; ++m) {
-        MPI_Reduce(&psi_out(g,LmIndex(l,m),0), &psi_out(g,LmIndex(l,m),0), 1,
-          MPI_ATHENA_REAL, MPI_SUM, 0, MPI_COMM_WORLD);
-        MPI_Reduce(&psi_out(g,LmIndex(l,m),1), &psi_out(g,LmIndex(l,m),1), 1,
-          MPI_ATHENA_REAL, MPI_SUM, 0, MPI_COMM_WORLD);
-        }
-      }
-    }
+    MPI_Reduce(psi_out.data(), psi_out.data(), count, MPI_ATHENA_REAL, MPI_SUM, 0,
+               global_variable::athena_comm);
   }
   #endif
   if (0 == global_variable::my_rank) {
@@ -0,0 +1,109 @@
+#!/usr/bin/env python
+
+# Kernel benchmark script.
+
+# Usage: From this directory, after building AthenaK in build/ (e.g. with
+#        'cmake -B build ..' and 'make -C build'), call this script with python:
+#        python run_benchmarks.py --output results.json
+#        To compare against results from an earlier version:
+#        python run_benchmarks.py --output new.json --compare results.json
+
+# Notes:
+#   - Requires Python 3+.
+#   - Runs the kernel_benchmark problem generator with each input file, MeshBlock size,
+#     and number of MeshBlocks per pack, and merges the "basename.bench.json" files it
+#     writes into one JSON file.
+#   - The number of MeshBlocks in each pack is varied by extending the Mesh along x1.
+
+# Modules
+import argparse
+import json
+import os
+import subprocess
+import sys
+
+# Input files (relative to inputs/tests) run by default
+default_inputs = ['kernel_benchmark_hydro.athinput', 'kernel_benchmark_mhd.athinput']
+
+
+# Runs one benchmark and returns the contents of the JSON file written by AthenaK
+def run_benchmark(exe, input_file, nx, nmb, nproc):
+    basename = 'bench'
+    args = ['job/basename=' + basename,
+            'mesh/nx1=' + str(nx*nmb), 'mesh/nx2=' + str(nx), 'mesh/nx3=' + str(nx),
+            'meshblock/nx1=' + str(nx), 'meshblock/nx2=' + str(nx),
+            'meshblock/nx3=' + str(nx)]
+    cmd = [exe, '-i', input_file] + args
+    if nproc > 1:
+        cmd = ['mpiexec', '-n', str(nproc)] + cmd
+    subprocess.check_call(cmd, stdout=subprocess.DEVNULL)
+    with open(basename + '.bench.json') as f:
+        data = json.load(f)
+    os.remove(basename + '.bench.json')
+    data['input'] = os.path.basename(input_file)
+    return data
+
+
+# Prints kernels that are slower than in baseline run by more than tolerance
+def compare(runs, baseline, tolerance):
+    def key(r):
+        return (r['input'], tuple(r['meshblock']), r['nmb_total'], r['nranks'])
+    old = {key(r): {k['name']: k['time_per_call'] for k in r['kernels']}
+           for r in baseline}
+    nslow = 0
+    for r in runs:
+        if key(r) not in old:
+            continue
+        for k in r['kernels']:
+            t_old = old[key(r)].get(k['name'])
+            if t_old is not None and k['time_per_call'] > (1.0 + tolerance)*t_old:
+                print('SLOWER: {0} {1} nmb={2} {3}: {4:.3e} s -> {5:.3e} s'.format(
+                      r['input'], r['meshblock'], r['nmb_total'], k['name'], t_old,
+                      k['time_per_call']))
+                nslow += 1
+    return nslow
+
+
+# Main function
+def main(**kwargs):
+    inputs = kwargs['inputs'] if len(kwargs['inputs']) > 0 else default_inputs
+    runs = []
+    for input_file in inputs:
+        input_full = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                  '../inputs/tests', input_file)
+        for nx in kwargs['block_sizes']:
+            for nmb in kwargs['pack_sizes']:
+                print('Running {0} with {1}^3 MeshBlocks, {2} per pack'.format(
+                      input_file, nx, nmb))
+                runs.append(run_benchmark(os.path.abspath(kwargs['exe']), input_full,
+                                          nx, nmb, kwargs['nproc']))
+    with open(kwargs['output'], 'w') as f:
+        json.dump(runs, f, indent=2)
+    if kwargs['compare'] is not None:
+        with open(kwargs['compare']) as f:
+            baseline = json.load(f)
+        if compare(runs, baseline, kwargs['tolerance']) > 0:
+            sys.exit(1)
+
+
+# Execute main function
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('inputs', type=str, default=[], nargs='*',
+                        help='input files in inputs/tests to run')
+    parser.add_argument('--exe', type=str, default='build/src/athena',
+                        help='path to AthenaK executable')
+    parser.add_argument('--block_sizes', type=int, default=[16, 32, 64], nargs='+',
+                        help='MeshBlock sizes (cells per direction)')
+    parser.add_argument('--pack_sizes', type=int, default=[1, 8], nargs='+',
+                        help='numbers of MeshBlocks per pack')
+    parser.add_argument('--nproc', type=int, default=1,
+                        help='number of MPI ranks')
+    parser.add_argument('--output', type=str, default='benchmarks.json',
+                        help='file to which combined results are written')
+    parser.add_argument('--compare', type=str, default=None,
+                        help='earlier results to compare against')
+    parser.add_argument('--tolerance', type=float, default=0.1,
+                        help='fractional slowdown reported by --compare')
+    args = parser.parse_args()
+    main(**vars(args))
@@ -0,0 +1,260 @@
+#!/usr/bin/env python
+
+# Weak and strong scaling study script.
+
+# Usage: From this directory, call this script with python in three steps:
+#        python run_scaling.py generate --problems linear_wave blast --ranks 1 64
+#        python run_scaling.py run
+#        python run_scaling.py analyze
+#   - 'generate' writes a job script in scaling/<job>/ for every problem, scaling type
+#     and rank count (powers of two in the given range), plus scaling/jobs.json.
+#   - 'run' executes the job scripts one after another (or submit them to the batch
+#     system instead, e.g. with --launcher "srun -n {nproc}").
+#   - 'analyze' parses the performance summary printed by Driver::Finalize() and the
+#     region timers (<time>/profile) in each job, writes scaling/results.json, prints
+#     parallel efficiencies, and plots them in scaling/efficiency.png (if matplotlib is
+#     installed).
+
+# Notes:
+#   - Requires Python 3+.
+#   - Weak scaling keeps the number of MeshBlocks per rank fixed by doubling the number
+#     of cells along x1, x2, x3 in turn.  Strong scaling keeps the Mesh of the smallest
+#     rank count fixed.  The extent of the domain is unchanged in both cases.
+#   - Each job runs a fixed number of cycles, with all outputs effectively disabled.
+#   - gr_torus and z4c_two_puncture require executables compiled with
+#     '-D PROBLEM=gr_torus' and '-D PROBLEM=z4c_two_puncture', passed with --exe.
+
+# Modules
+import argparse
+import json
+import math
+import os
+import re
+import stat
+import subprocess
+import sys
+
+# Standard problem decks (relative to inputs/)
+decks = {'linear_wave': 'tests/linear_wave_hydro.athinput',
+         'blast': 'mhd/blast_mhd.athinput',
+         'gr_torus': 'grhydro/gr_fm_torus_uniform.athinput',
+         'z4c_two_puncture': 'z4c/twopuncture/z4c_twopuncture.athinput'}
+
+inputs_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)), '../inputs')
+
+
+# Returns dictionary of blocks, each a dictionary of parameters, read from input file
+def read_deck(fname):
+    blocks = {}
+    block = None
+    with open(fname) as f:
+        for line in f:
+            line = line.split('#')[0].strip()
+            if line.startswith('<') and line.endswith('>'):
+                block = line[1:-1]
+                blocks[block] = {}
+            elif '=' in line and block is not None:
+                key, value = line.split('=', 1)
+                blocks[block][key.strip()] = value.strip()
+    return blocks
+
+
+# Returns number of cells in Mesh along each direction for given number of MeshBlocks
+def mesh_size(nmb, mb, ndim):
+    nx = [mb if d < ndim else 1 for d in range(3)]
+    n = 1
+    d = 0
+    while n < nmb:
+        nx[d] *= 2
+        n *= 2
+        d = (d + 1) % ndim
+    return nx
+
+
+# Writes job scripts and list of jobs
+def generate(**kwargs):
+    nmin, nmax = kwargs['ranks']
+    ranks = [2**p for p in range(int(math.log2(nmin)), int(math.log2(nmax)) + 1)]
+    os.makedirs(kwargs['dir'], exist_ok=True)
+    jobs = []
+    for problem in kwargs['problems']:
+        deck = os.path.join(inputs_dir, decks[problem])
+        blocks = read_deck(deck)
+        ndim = 3 if int(blocks['mesh'].get('nx3', '1')) > 1 else \
+            (2 if int(blocks['mesh'].get('nx2', '1')) > 1 else 1)
+        mb = kwargs['meshblock']
+        exe = os.path.abspath(kwargs['exe'].get(problem, kwargs['exe']['default']))
+        for scaling in kwargs['scaling']:
+            for nproc in ranks:
+                if scaling == 'weak':
+                    nx = mesh_size(nproc*kwargs['mb_per_rank'], mb, ndim)
+                else:
+                    nx = mesh_size(ranks[0]*kwargs['mb_per_rank'], mb, ndim)
+                    if (nx[0]*nx[1]*nx[2])//(mb**ndim) < nproc:
+                        print('WARNING: fewer MeshBlocks than ranks in {0} strong '
+                              'scaling with {1} ranks, skipping'.format(problem, nproc))
+                        continue
+                name = '{0}_{1}_n{2}'.format(problem, scaling, nproc)
+                args = ['job/basename=scaling', 'time/nlim=' + str(kwargs['ncycles']),
+                        'time/tlim=1.0e20', 'time/profile=true']
+                for d in range(3):
+                    args.append('mesh/nx{0}={1}'.format(d + 1, nx[d]))
+                    args.append('meshblock/nx{0}={1}'.format(d + 1, min(mb, nx[d])))
+                for block, pars in blocks.items():
+                    if block.startswith('output'):
+                        key = 'dcycle' if 'dcycle' in pars else 'dt'
+                        args.append('{0}/{1}=1.0e20'.format(block, key))
+                launch = kwargs['launcher'].format(nproc=nproc)
+                jobdir = os.path.join(kwargs['dir'], name)
+                os.makedirs(jobdir, exist_ok=True)
+                script = os.path.join(jobdir, 'job.sh')
+                with open(script, 'w') as f:
+                    f.write('#!/bin/bash\n')
+                    f.write('cd "$(dirname "$0")"\n')
+                    f.write('{0} {1} -i {2} {3} > athena.log 2>&1\n'.format(
+                            launch, exe, deck, ' '.join(args)))
+                os.chmod(script, os.stat(script).st_mode | stat.S_IEXEC)
+                jobs.append({'name': name, 'problem': problem, 'scaling': scaling,
+                             'nproc': nproc, 'mesh': nx, 'meshblock': mb})
+    with open(os.path.join(kwargs['dir'], 'jobs.json'), 'w') as f:
+        json.dump(jobs, f, indent=2)
+    print('Generated {0} jobs in {1}'.format(len(jobs), kwargs['dir']))
+
+
+# Executes all generated job scripts
+def run(**kwargs):
+    with open(os.path.join(kwargs['dir'], 'jobs.json')) as f:
+        jobs = json.load(f)
+    for job in jobs:
+        print('Running ' + job['name'])
+        subprocess.call([os.path.join(kwargs['dir'], job['name'], 'job.sh')])
+
+
+# Returns performance summary and final region times parsed from output of one job
+def parse_job(jobdir):
+    result = {}
+    patterns = {'zcps': r'zone-cycles/cpu_second = (\S+)',
+                'cpu_time': r'cpu time used\s+= (\S+)',
+                'mb_cycles': r'MeshBlock-cycles = (\S+)'}
+    with open(os.path.join(jobdir, 'athena.log')) as f:
+        log = f.read()
+    for key, pattern in patterns.items():
+        match = re.search(pattern, log)
+        if match is None:
+            return None
+        result[key] = float(match.group(1))
+    # region timer report: "cycle region ncalls min mean max", keep last cycle
+    regions = {}
+    prof = os.path.join(jobdir, 'scaling.prof')
+    if os.path.isfile(prof):
+        with open(prof) as f:
+            for line in f:
+                if line.startswith('#'):
+                    continue
+                cols = line.split()
+                regions[cols[1]] = {'ncalls': int(cols[2]), 'min': float(cols[3]),
+                                    'mean': float(cols[4]), 'max': float(cols[5])}
+    result['regions'] = regions
+    return result
+
+
+# Parses output of all jobs, computes efficiencies, and plots them
+def analyze(**kwargs):
+    with open(os.path.join(kwargs['dir'], 'jobs.json')) as f:
+        jobs = json.load(f)
+    curves = {}
+    for job in jobs:
+        result = parse_job(os.path.join(kwargs['dir'], job['name']))
+        if result is None:
+            print('WARNING: no performance summary for ' + job['name'])
+            continue
+        job.update(result)
+        curves.setdefault((job['problem'], job['scaling']), []).append(job)
+
+    # weak: zone-cycles/s per rank relative to smallest run
+    # strong: speedup relative to smallest run, divided by increase in ranks
+    for (problem, scaling), runs in sorted(curves.items()):
+        runs.sort(key=lambda r: r['nproc'])
+        r0 = runs[0]
+        print('\n{0} {1} scaling'.format(problem, scaling))
+        print('  {0:>8} {1:>14} {2:>12} {3:>10}'.format('ranks', 'zone-cycles/s',
+                                                      'cpu time', 'efficiency'))
+        for r in runs:
+            if scaling == 'weak':
+                r['efficiency'] = (r['zcps']/r['nproc'])/(r0['zcps']/r0['nproc'])
+            else:
+                r['efficiency'] = (r0['cpu_time']*r0['nproc'])/(r['cpu_time']*r['nproc'])
+            print('  {0:>8d} {1:>14.4e} {2:>12.4e} {3:>10.3f}'.format(
+                  r['nproc'], r['zcps'], r['cpu_time'], r['efficiency']))
+
+    with open(os.path.join(kwargs['dir'], 'results.json'), 'w') as f:
+        json.dump([job for job in jobs if 'efficiency' in job], f, indent=2)
+
+    try:
+        import matplotlib
+        matplotlib.use('Agg')
+        import matplotlib.pyplot as plt
+    except ImportError:
+        print('\nmatplotlib not found, efficiency curves not plotted')
+        return
+    fig, axes = plt.subplots(1, 2, figsize=(10, 4), sharey=True)
+    for ax, scaling in zip(axes, ['weak', 'strong']):
+        for (problem, s), runs in sorted(curves.items()):
+            if s == scaling:
+                ax.semilogx([r['nproc'] for r in runs],
+                            [r['efficiency'] for r in runs], 'o-', base=2, label=problem)
+        ax.set_title(scaling + ' scaling')
+        ax.set_xlabel('ranks')
+        ax.set_ylim(0.0, 1.1)
+        ax.legend()
+    axes[0].set_ylabel('parallel efficiency')
+    fig.tight_layout()
+    fig.savefig(os.path.join(kwargs['dir'], 'efficiency.png'))
+
+
+# Parses --exe arguments of the form 'path' or 'problem=path'
+def parse_exe(values):
+    exe = {'default': 'build/src/athena'}
+    for value in values:
+        if '=' in value:
+            problem, path = value.split('=', 1)
+            exe[problem] = path
+        else:
+            exe['default'] = value
+    return exe
+
+
+# Execute main function
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('step', type=str, choices=['generate', 'run', 'analyze'],
+                        help='step of scaling study to perform')
+    parser.add_argument('--dir', type=str, default='scaling',
+                        help='directory for job scripts and results')
+    parser.add_argument('--problems', type=str, nargs='+', default=['linear_wave'],
+                        choices=list(decks.keys()), help='problem decks to run')
+    parser.add_argument('--scaling', type=str, nargs='+', default=['weak', 'strong'],
+                        choices=['weak', 'strong'], help='types of scaling study')
+    parser.add_argument('--ranks', type=int, nargs=2, default=[1, 8],
+                        help='smallest and largest number of ranks (or GPUs)')
+    parser.add_argument('--meshblock', type=int, default=32,
+                        help='MeshBlock size (cells per direction)')
+    parser.add_argument('--mb_per_rank', type=int, default=8,
+                        help='MeshBlocks per rank (weak) or at smallest rank count '
+                        '(strong)')
+    parser.add_argument('--ncycles', type=int, default=100,
+                        help='number of cycles run in each job')
+    parser.add_argument('--exe', type=str, nargs='+', default=[],
+                        help='AthenaK executable, or problem=path for one problem')
+    parser.add_argument('--launcher', type=str, default='mpiexec -n {nproc}',
+                        help='command used to launch {nproc} ranks')
+    args = vars(parser.parse_args())
+    args['exe'] = parse_exe(args['exe'])
+    step = args.pop('step')
+    if step == 'generate':
+        generate(**args)
+    elif step == 'run':
+        run(**args)
+    else:
+        analyze(**args)
+    sys.exit(0)
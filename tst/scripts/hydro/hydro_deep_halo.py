@@ -0,0 +1,49 @@
+# Regression test of the deep-halo ghost-zone exchange
+#
+# Runs a 2D hydro linear wave on eight MeshBlocks with the ghost zones exchanged at
+# every stage (default) and once per timestep with <hydro>/deep_halo=true, for both
+# the RK2 and RK3 integrators (each one with enough ghost zones for deep_halo), and
+# checks that the solution in rows of cells next to the boundaries of MeshBlocks is
+# bitwise identical.  Rows are written with 17 significant digits, so identical files
+# imply identical values.
+
+# Modules
+import filecmp
+import glob
+import logging
+import os
+import scripts.utils.athena as athena
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name
+_integrators = [('rk2', 4), ('rk3', 6)]
+
+
+# Run AthenaK
+def run(**kwargs):
+    logger.debug('Runnning test ' + __name__)
+    for integrator, nghost in _integrators:
+        for deep_halo in ['false', 'true']:
+            arguments = ['job/basename=hydro_halo_' + integrator + '_' + deep_halo,
+                         'time/integrator=' + integrator,
+                         'mesh/nghost=' + repr(nghost),
+                         'hydro/deep_halo=' + deep_halo]
+            athena.run('tests/linear_wave_hydro_halo.athinput', arguments)
+
+
+# Analyze outputs
+def analyze():
+    logger.debug('Analyzing test ' + __name__)
+    analyze_status = True
+    for integrator, nghost in _integrators:
+        base = 'build/src/tab/hydro_halo_' + integrator + '_'
+        files = sorted(glob.glob(base + 'false.*.tab'))
+        if len(files) == 0:
+            logger.warning('no outputs found for ' + base + 'false')
+            analyze_status = False
+        for fname in files:
+            other = fname.replace(base + 'false', base + 'true')
+            if not os.path.isfile(other) or not filecmp.cmp(fname, other, shallow=False):
+                logger.warning('deep_halo solution with {0} differs from default: {1}'.
+                               format(integrator, os.path.basename(other)))
+                analyze_status = False
+
+    return analyze_status
@@ -0,0 +1,48 @@
+# Regression test of the ghost-zone exchange that skips edges and corners
+#
+# Runs a 2D hydro linear wave on eight MeshBlocks with all ghost zones exchanged
+# (default) and with <hydro>/exchange_faces_only=true, for PLM and PPM reconstruction,
+# and checks that the solution in rows of cells next to the boundaries of MeshBlocks is
+# bitwise identical (since stencils are dimensionally split, cells in edge and corner
+# ghost zones are never used).  Rows are written with 17 significant digits, so
+# identical files imply identical values.
+
+# Modules
+import filecmp
+import glob
+import logging
+import os
+import scripts.utils.athena as athena
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name
+_recons = ['plm', 'ppm4']
+
+
+# Run AthenaK
+def run(**kwargs):
+    logger.debug('Runnning test ' + __name__)
+    for recon in _recons:
+        for faces_only in ['false', 'true']:
+            arguments = ['job/basename=hydro_faces_' + recon + '_' + faces_only,
+                         'hydro/reconstruct=' + recon,
+                         'hydro/exchange_faces_only=' + faces_only]
+            athena.run('tests/linear_wave_hydro_halo.athinput', arguments)
+
+
+# Analyze outputs
+def analyze():
+    logger.debug('Analyzing test ' + __name__)
+    analyze_status = True
+    for recon in _recons:
+        base = 'build/src/tab/hydro_faces_' + recon + '_'
+        files = sorted(glob.glob(base + 'false.*.tab'))
+        if len(files) == 0:
+            logger.warning('no outputs found for ' + base + 'false')
+            analyze_status = False
+        for fname in files:
+            other = fname.replace(base + 'false', base + 'true')
+            if not os.path.isfile(other) or not filecmp.cmp(fname, other, shallow=False):
+                logger.warning('exchange_faces_only solution with {0} differs from '
+                               'default: {1}'.format(recon, os.path.basename(other)))
+                analyze_status = False
+
+    return analyze_status
@@ -0,0 +1,70 @@
+# Regression test of fourth-order convergence with the SSPRK(10,4) integrator
+#
+# Runs a 1D hydro sound wave with WENOZ reconstruction and a large CFL number (so the
+# error of the time integrator is significant), and checks that the L1 error
+# (computed by the executable and stored in hydro_lin_wave_ssprk104-errs.dat) is
+# reduced at least by a factor expected of a fourth-order method when the resolution
+# (and timestep) are halved.  The 2S low-storage integrators update u1 with u0 at every
+# stage, so this also checks the register logic of CopyCons.
+
+# Modules
+import logging
+import scripts.utils.athena as athena
+import sys
+sys.path.insert(0, '../vis/python')
+import athena_read  # noqa
+athena_read.check_nan_flag = True
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name
+_res = [32, 64]
+
+
+# Run AthenaK
+def run(**kwargs):
+    logger.debug('Runnning test ' + __name__)
+    for res in _res:
+        arguments = ['job/basename=hydro_lin_wave_ssprk104',
+                     'time/tlim=1.0',
+                     'time/nlim=1000',
+                     'time/integrator=ssprk104',
+                     'time/cfl_number=2.4',
+                     'mesh/nghost=3',
+                     'mesh/nx1=' + repr(res),
+                     'mesh/nx2=1',
+                     'mesh/nx3=1',
+                     'meshblock/nx1=' + repr(res),
+                     'meshblock/nx2=1',
+                     'meshblock/nx3=1',
+                     'hydro/reconstruct=wenoz',
+                     'hydro/rsolver=hllc',
+                     'problem/along_x1=true',
+                     'problem/wave_flag=0',
+                     'problem/vflow=0.0',
+                     'problem/amp=1.0e-6',
+                     'output1/dt=-1.0',
+                     'output2/dt=-1.0',
+                     'output3/dt=-1.0']
+        athena.run('tests/linear_wave_hydro.athinput', arguments)
+
+
+# Analyze outputs
+def analyze():
+    # Errors of a fourth-order method are reduced by 1/16 when dx and dt are halved, a
+    # third-order method would give 1/8.
+    logger.debug('Analyzing test ' + __name__)
+    data = athena_read.error_dat('build/src/hydro_lin_wave_ssprk104-errs.dat')
+    analyze_status = True
+    error_threshold = 1.0e-8
+    conv_threshold = 0.09
+    l1_rms_lo = data[0][4]
+    l1_rms_hi = data[1][4]
+    if l1_rms_hi > error_threshold:
+        logger.warning("wave error too large, error: {0:g} threshold: {1:g}".
+                       format(l1_rms_hi, error_threshold))
+        analyze_status = False
+    if l1_rms_hi/l1_rms_lo > conv_threshold:
+        logger.warning("wave not converging at fourth order, conv: {0:g} "
+                       "threshold: {1:g}".format(l1_rms_hi/l1_rms_lo,
+                                                 conv_threshold))
+        analyze_status = False
+
+    return analyze_status
@@ -0,0 +1,46 @@
+# Regression test of hydrodynamics in logarithmic spherical-polar coordinates
+#
+# Runs a uniform medium at rest in a 3D wedge (x1 = ln r, x2 = theta, x3 = phi), with
+# PLM and PPM reconstruction.  The pressure fluxes through the faces of every cell are
+# balanced exactly by the geometric source terms, so the medium must remain at rest,
+# which is checked through the kinetic energies in the history file.
+
+# Modules
+import logging
+import scripts.utils.athena as athena
+import sys
+sys.path.insert(0, '../vis/python')
+import athena_read  # noqa
+athena_read.check_nan_flag = True
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name
+_recons = ['plm', 'ppm4']
+
+
+# Run AthenaK
+def run(**kwargs):
+    logger.debug('Runnning test ' + __name__)
+    for recon in _recons:
+        arguments = ['job/basename=hydro_sph_polar_' + recon,
+                     'mesh/nghost=3',
+                     'hydro/reconstruct=' + recon]
+        athena.run('tests/sph_polar_static.athinput', arguments)
+
+
+# Analyze outputs
+def analyze():
+    logger.debug('Analyzing test ' + __name__)
+    analyze_status = True
+    ke_threshold = 1.0e-20
+    for recon in _recons:
+        data = athena_read.hst('build/src/hydro_sph_polar_' + recon + '.hydro.hst')
+        if len(data['time']) < 2:
+            logger.warning('no history output found for ' + recon)
+            analyze_status = False
+            continue
+        ke = max(max(data[key]) for key in ['1-KE', '2-KE', '3-KE'])
+        if ke > ke_threshold:
+            logger.warning("medium at rest not preserved with {0}, max KE: {1:g} "
+                           "threshold: {2:g}".format(recon, ke, ke_threshold))
+            analyze_status = False
+
+    return analyze_status
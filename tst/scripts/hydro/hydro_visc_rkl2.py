@@ -0,0 +1,75 @@
+# Regression test of second-order convergence of RKL2 super-time-stepping
+#
+# Runs a 1D viscous shear wave (wave_flag=1 of the hydro linear wave, with a very small
+# background flow so the wave barely moves), whose amplitude decays as exp(-nu k^2 t),
+# with viscosity integrated by RKL2 (time/sts_integrator=rkl2) and, as a reference with
+# the same spatial discretization and a negligible time error, explicitly.  The decay
+# factor of each run is obtained from the M2 error (computed by the executable relative
+# to the initial conditions, and stored in <basename>-errs.dat), and the difference
+# between the RKL2 and explicit decay factors (the time error of RKL2) is checked to be
+# reduced at least by a factor expected of a second-order method when the resolution
+# (and timestep) are halved.
+
+# Modules
+import logging
+import math
+import scripts.utils.athena as athena
+import sys
+sys.path.insert(0, '../vis/python')
+import athena_read  # noqa
+athena_read.check_nan_flag = True
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name
+_res = [64, 128]
+_amp = 1.0e-3
+_nu = 0.1
+_vflow = 1.0e-3
+_tlim = 1.0
+
+
+# Run AthenaK
+def run(**kwargs):
+    logger.debug('Runnning test ' + __name__)
+    for sts in ['rkl2', 'none']:
+        for res in _res:
+            arguments = ['job/basename=hydro_visc_' + sts,
+                         'time/tlim=' + repr(_tlim*_vflow),
+                         'time/sts_integrator=' + sts,
+                         'mesh/nx1=' + repr(res),
+                         'meshblock/nx1=' + repr(res),
+                         'hydro/viscosity=' + repr(_nu),
+                         'problem/vflow=' + repr(_vflow),
+                         'problem/amp=' + repr(_amp)]
+            athena.run('tests/viscous_shear_wave.athinput', arguments)
+
+
+# Analyze outputs
+def analyze():
+    # Time errors of a second-order method are reduced by 1/4 when dt is halved.  The
+    # explicit time error is smaller by (dt_explicit/dt)^2, so it does not affect the
+    # difference.
+    logger.debug('Analyzing test ' + __name__)
+    data_sts = athena_read.error_dat('build/src/hydro_visc_rkl2-errs.dat')
+    data_exp = athena_read.error_dat('build/src/hydro_visc_none-errs.dat')
+    analyze_status = True
+    error_threshold = 3.0e-4
+    conv_threshold = 0.3
+    decay_ex = math.exp(-_nu*(2.0*math.pi)**2*_tlim)
+    err = []
+    for n, res in enumerate(_res):
+        # mean over cells of |sin(k x)| of initial vy, so M2_L1 = amp*mean*(1 - decay)
+        mean = sum(abs(math.sin(2.0*math.pi*(i + 0.5)/res)) for i in range(res))/res
+        decay_sts = 1.0 - data_sts[n][8]/(_amp*mean)
+        decay_exp = 1.0 - data_exp[n][8]/(_amp*mean)
+        logger.debug('res {0:d} decay rkl2: {1:g} explicit: {2:g} exact: {3:g}'.
+                     format(res, decay_sts, decay_exp, decay_ex))
+        err.append(abs(decay_sts - decay_exp)/decay_ex)
+    if err[1] > error_threshold:
+        logger.warning("RKL2 error too large, error: {0:g} threshold: {1:g}".
+                       format(err[1], error_threshold))
+        analyze_status = False
+    if err[1]/err[0] > conv_threshold:
+        logger.warning("RKL2 not converging at second order, conv: {0:g} "
+                       "threshold: {1:g}".format(err[1]/err[0], conv_threshold))
+        analyze_status = False
+
+    return analyze_status
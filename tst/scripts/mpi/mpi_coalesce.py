@@ -0,0 +1,48 @@
+# Regression test of ghost-zone exchange with messages coalesced per pair of ranks
+#
+# Runs a 2D hydro linear wave on eight MeshBlocks distributed over four MPI ranks, with
+# the default exchange and with <mesh>/coalesce_mpi=true (with and without persistent
+# requests), and checks that rows of the solution next to the boundaries of MeshBlocks
+# are bitwise identical.  Rows are written with 17 significant digits, so identical
+# files imply identical values.  AthenaK must be built with MPI.
+
+# Modules
+import filecmp
+import glob
+import logging
+import os
+import scripts.utils.athena as athena
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name
+_nproc = 4
+_cases = [('default', 'false', 'false'), ('coalesce', 'true', 'false'),
+          ('coalesce_persistent', 'true', 'true')]
+
+
+# Run AthenaK
+def run(**kwargs):
+    logger.debug('Runnning test ' + __name__)
+    for name, coalesce, persistent in _cases:
+        arguments = ['job/basename=mpi_coalesce_' + name,
+                     'mesh/coalesce_mpi=' + coalesce,
+                     'mesh/persistent_mpi=' + persistent]
+        athena.mpirun(_nproc, 'tests/linear_wave_hydro_halo.athinput', arguments)
+
+
+# Analyze outputs
+def analyze():
+    logger.debug('Analyzing test ' + __name__)
+    analyze_status = True
+    base = 'build/src/tab/mpi_coalesce_'
+    files = sorted(glob.glob(base + 'default.*.tab'))
+    if len(files) == 0:
+        logger.warning('no outputs found for ' + base + 'default')
+        analyze_status = False
+    for name, coalesce, persistent in _cases[1:]:
+        for fname in files:
+            other = fname.replace(base + 'default', base + name)
+            if not os.path.isfile(other) or not filecmp.cmp(fname, other, shallow=False):
+                logger.warning('solution with {0} differs from default: {1}'.
+                               format(name, os.path.basename(other)))
+                analyze_status = False
+
+    return analyze_status
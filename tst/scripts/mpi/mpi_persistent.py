@@ -0,0 +1,44 @@
+# Regression test of ghost-zone exchange with persistent MPI requests
+#
+# Runs a 2D hydro linear wave on eight MeshBlocks distributed over four MPI ranks, with
+# the default exchange and with <mesh>/persistent_mpi=true, and checks that rows of the
+# solution next to the boundaries of MeshBlocks are bitwise identical.  Rows are
+# written with 17 significant digits, so identical files imply identical values.
+# AthenaK must be built with MPI.
+
+# Modules
+import filecmp
+import glob
+import logging
+import os
+import scripts.utils.athena as athena
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name
+_nproc = 4
+
+
+# Run AthenaK
+def run(**kwargs):
+    logger.debug('Runnning test ' + __name__)
+    for persistent in ['false', 'true']:
+        arguments = ['job/basename=mpi_persistent_' + persistent,
+                     'mesh/persistent_mpi=' + persistent]
+        athena.mpirun(_nproc, 'tests/linear_wave_hydro_halo.athinput', arguments)
+
+
+# Analyze outputs
+def analyze():
+    logger.debug('Analyzing test ' + __name__)
+    analyze_status = True
+    base = 'build/src/tab/mpi_persistent_'
+    files = sorted(glob.glob(base + 'false.*.tab'))
+    if len(files) == 0:
+        logger.warning('no outputs found for ' + base + 'false')
+        analyze_status = False
+    for fname in files:
+        other = fname.replace(base + 'false', base + 'true')
+        if not os.path.isfile(other) or not filecmp.cmp(fname, other, shallow=False):
+            logger.warning('solution with persistent_mpi differs from default: ' +
+                           os.path.basename(other))
+            analyze_status = False
+
+    return analyze_status
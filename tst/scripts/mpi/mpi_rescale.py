@@ -0,0 +1,48 @@
+# Regression test of continuing a run in-process on a different number of MPI ranks
+#
+# Runs a 2D hydro linear wave on eight MeshBlocks over four MPI ranks without rescaling,
+# then starting on four ranks and continuing on two after cycle 20 (dropping ranks), and
+# starting on two ranks and continuing on four (spawning ranks), using
+# <job>/rescale_cycle and <job>/rescale_nranks.  Checks that rows of the final solution
+# of the rescaled runs are bitwise identical to those of the run on four ranks.  Rows
+# are written with 17 significant digits, so identical files imply identical values.
+# AthenaK must be built with MPI, and the MPI library must support MPI_Comm_spawn.
+
+# Modules
+import filecmp
+import glob
+import logging
+import os
+import scripts.utils.athena as athena
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name
+_runs = [('none', 4, 4), ('shrink', 4, 2), ('grow', 2, 4)]
+
+
+# Run AthenaK
+def run(**kwargs):
+    logger.debug('Runnning test ' + __name__)
+    for name, nproc, nranks in _runs:
+        arguments = ['job/basename=mpi_rescale_' + name]
+        if nranks != nproc:
+            arguments += ['job/rescale_cycle=20', 'job/rescale_nranks=' + repr(nranks)]
+        athena.mpirun(nproc, 'tests/linear_wave_hydro_halo.athinput', arguments)
+
+
+# Analyze outputs
+def analyze():
+    logger.debug('Analyzing test ' + __name__)
+    analyze_status = True
+    base = 'build/src/tab/mpi_rescale_'
+    files = sorted(glob.glob(base + 'none.*.tab'))
+    if len(files) == 0:
+        logger.warning('no outputs found for ' + base + 'none')
+        analyze_status = False
+    for name, nproc, nranks in _runs[1:]:
+        for fname in files:
+            other = fname.replace(base + 'none', base + name)
+            if not os.path.isfile(other) or not filecmp.cmp(fname, other, shallow=False):
+                logger.warning('solution of rescaled run differs from default: ' +
+                               os.path.basename(other))
+                analyze_status = False
+
+    return analyze_status
@@ -0,0 +1,51 @@
+# Regression test of radiation coupled to hydro with a 2S low-storage integrator
+#
+# Runs the radiation linear wave convergence test with integrator=ssprk104, which
+# updates the intermediate registers (i1 for radiation, u1 for the fluid) with i0 and u0
+# at every stage, and checks the L1 errors (stored in rad_linwave_ssprk104-errs.dat)
+# have the same magnitude and convergence as with the default integrator.
+
+# Modules
+import logging
+import scripts.utils.athena as athena
+import sys
+sys.path.insert(0, '../vis/python')
+import athena_read  # noqa
+athena_read.check_nan_flag = True
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name
+
+
+# Run AthenaK
+def run(**kwargs):
+    logger.debug('Runnning test ' + __name__)
+    for res in (64, 128):
+        arguments = ['job/basename=rad_linwave_ssprk104',
+                     'time/tlim=1.0',
+                     'time/integrator=ssprk104',
+                     'mesh/nx1=' + repr(res),
+                     'mesh/nx2=1',
+                     'mesh/nx3=1',
+                     'output1/dt=-1.0',
+                     'output2/dt=-1.0']
+        athena.run('tests/rad_linwave.athinput', arguments)
+
+
+# Analyze outputs
+def analyze():
+    logger.debug('Analyzing test ' + __name__)
+    data = athena_read.error_dat('build/src/rad_linwave_ssprk104-errs.dat')
+    analyze_status = True
+    error_threshold = 1.0e-8
+    conv_threshold = 0.3
+    l1_rms_n64 = data[0][4]
+    l1_rms_n128 = data[1][4]
+    if l1_rms_n128 > error_threshold:
+        logger.warning("wave error too large, error: {0:g} threshold: {1:g}".
+                       format(l1_rms_n128, error_threshold))
+        analyze_status = False
+    if l1_rms_n128/l1_rms_n64 > conv_threshold:
+        logger.warning("wave not converging, conv: {0:g} threshold: {1:g}".
+                       format(l1_rms_n128/l1_rms_n64, conv_threshold))
+        analyze_status = False
+
+    return analyze_status
@@ -123,9 +123,13 @@ def read_binary(filename):
             + '(should be "Athena")'
         )
     version = code_header[-1].split(b"=")[-1]
-    if version != b"1.1":
+    if version not in [b"1.1", b"1.2"]:
         raise TypeError(f"unsupported file format version {version.decode('utf-8')}")
 
+    # with an index (version 1.2), meshblock records end where the index starts
+    if version == b"1.2":
+        filesize = read_binary_index(filename)["index_offset"]
+
     pheader_count = int(fp.readline().split(b"=")[-1])
     pheader = {}
     for _ in range(pheader_count - 1):
@@ -425,6 +429,130 @@ def read_coarsened_binary(filename):
     return filedata
 
 
+def read_binary_index(filename):
+    """
+    Reads the index of meshblock records from a bin file written with index=true
+    (format version 1.2), without reading any of the data.
+
+    args:
+      filename - string
+          filename of bin file to read
+
+    returns:
+      index - dict
+          dictionary with the offset of the index, the size of each record, the offset
+          of the first variable in a record, the number of cells per variable, and
+          arrays with one entry per record: 'offset', 'gid' (-1 for empty records),
+          'level', 'lx' with shape [n, 3], and 'bounds' with shape [n, 6] holding
+          x1min,x1max,x2min,x2max,x3min,x3max
+    """
+
+    with open(filename, "rb") as fp:
+        fp.seek(-48, 2)
+        trailer = fp.read(48)
+        if trailer[40:] != b"ATHKBIDX":
+            raise TypeError(f"file {filename} does not contain a meshblock index")
+        index_offset, n_idx, record_size, var_offset, cells = struct.unpack(
+            "@5q", trailer[:40]
+        )
+        fp.seek(0, 0)
+        locsizebytes = 8
+        for _ in range(6):
+            line = fp.readline()
+            if line.startswith(b"  size of location="):
+                locsizebytes = int(line.split(b"=")[-1])
+        fp.seek(index_offset, 0)
+        locfmt = "f8" if locsizebytes == 8 else "f4"
+        dtype = np.dtype([("offset", "i8"), ("ints", "i4", 6), ("bounds", locfmt, 6)])
+        entries = np.frombuffer(fp.read(n_idx * dtype.itemsize), dtype=dtype)
+
+    index = {}
+    index["index_offset"] = index_offset
+    index["record_size"] = record_size
+    index["var_offset"] = var_offset
+    index["cells"] = cells
+    index["offset"] = entries["offset"]
+    index["gid"] = entries["ints"][:, 0]
+    index["level"] = entries["ints"][:, 1]
+    index["lx"] = entries["ints"][:, 2:5]
+    index["bounds"] = entries["bounds"]
+    return index
+
+
+def read_binary_blocks(filename, variables=None, gids=None, bounds=None):
+    """
+    Memory-maps a bin file written with index=true (format version 1.2), and returns
+    the data of selected variables on selected meshblocks only.  Only the pages of the
+    file holding the selected data are read from disk.
+
+    args:
+      filename - string
+          filename of bin file to read
+      variables - list of strings (optional)
+          names of variables to read, default all
+      gids - list of ints (optional)
+          gids of meshblocks to read, default all
+      bounds - list of 6 floats (optional)
+          x1min,x1max,x2min,x2max,x3min,x3max of region, only meshblocks overlapping
+          the region are read
+
+    returns:
+      blockdata - dict
+          dictionary with 'gid', 'level', 'lx', 'bounds', and 'mb_index' (is,ie,js,
+          je,ks,ke including ghost zones) of the selected meshblocks, and 'mb_data', a
+          dict of read-only arrays with shape [n_mbs, nx3, nx2, nx1] for each selected
+          variable
+    """
+
+    index = read_binary_index(filename)
+    with open(filename, "rb") as fp:
+        fp.readline()
+        pheader_count = int(fp.readline().split(b"=")[-1])
+        for _ in range(pheader_count - 1):
+            fp.readline()
+        fp.readline()
+        var_list = [v.decode("utf-8") for v in fp.readline().split()[1:]]
+    if variables is None:
+        variables = var_list
+    for var in variables:
+        if var not in var_list:
+            raise KeyError(f"no variable called {var} in {filename}")
+
+    sel = index["gid"] >= 0
+    if gids is not None:
+        sel &= np.isin(index["gid"], gids)
+    if bounds is not None:
+        b = index["bounds"]
+        for d in range(3):
+            sel &= (b[:, 2 * d] < bounds[2 * d + 1]) & (b[:, 2 * d + 1] > bounds[2 * d])
+    sel = np.nonzero(sel)[0]
+
+    # variables are always written as 4-byte floats
+    mm = np.memmap(filename, dtype=np.uint8, mode="r")
+    cells = index["cells"]
+    varsizebytes = 4
+    mb_index = []
+    mb_data = {var: [] for var in variables}
+    for n in sel:
+        off = index["offset"][n]
+        ind = np.frombuffer(mm[off:off + 24], dtype=np.int32)
+        mb_index.append(ind)
+        shape = (ind[5] - ind[4] + 1, ind[3] - ind[2] + 1, ind[1] - ind[0] + 1)
+        for var in variables:
+            voff = off + index["var_offset"] + var_list.index(var) * cells * varsizebytes
+            vdata = mm[voff:voff + cells * varsizebytes].view(np.float32)
+            mb_data[var].append(vdata.reshape(shape))
+
+    blockdata = {}
+    blockdata["gid"] = index["gid"][sel]
+    blockdata["level"] = index["level"][sel]
+    blockdata["lx"] = index["lx"][sel]
+    blockdata["bounds"] = index["bounds"][sel]
+    blockdata["mb_index"] = np.array(mb_index)
+    blockdata["mb_data"] = mb_data
+    return blockdata
+
+
 def write_athdf(filename, fdata, varsize_bytes=4, locsize_bytes=8):
     """
     Writes an athdf (hdf5) file from a loaded python filedata object.
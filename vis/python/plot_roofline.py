@@ -0,0 +1,85 @@
+#! /usr/bin/env python
+
+# Script for plotting achieved FLOP rates of kernels against the roofline of a device,
+# from the basename.roofline file written with <time>/roofline=true.
+
+# Run "plot_roofline.py -h" for help.
+
+# Python modules
+import argparse
+import re
+
+import numpy as np
+
+
+# Returns peak bandwidth (GB/s) and FLOP rate (GFLOP/s) from header, and tuples of
+# (name, arithmetic intensity, GFLOP/s) for each kernel
+def read_roofline(fname):
+    peak_bw, peak_flops = 0.0, 0.0
+    kernels = []
+    with open(fname) as f:
+        for line in f:
+            if line.startswith('#'):
+                match = re.search(r'peak_bandwidth\(GB/s\) = (\S+)\s+peak_gflops = (\S+)',
+                                  line)
+                if match is not None:
+                    peak_bw, peak_flops = float(match.group(1)), float(match.group(2))
+                continue
+            cols = line.split()
+            # kernel names may contain spaces, so count columns from the end
+            ncol = 10 if len(cols) >= 10 and peak_bw > 0.0 and peak_flops > 0.0 else 8
+            name = ' '.join(cols[:len(cols) - ncol + 1])
+            values = cols[len(cols) - ncol + 1:]
+            kernels.append((name, float(values[4]), float(values[6])))
+    return peak_bw, peak_flops, kernels
+
+
+# Main function
+def main(**kwargs):
+    peak_bw, peak_flops, kernels = read_roofline(kwargs['input'])
+    if kwargs['peak_bandwidth'] is not None:
+        peak_bw = kwargs['peak_bandwidth']
+    if kwargs['peak_gflops'] is not None:
+        peak_flops = kwargs['peak_gflops']
+
+    # Load Python plotting modules
+    output_file = kwargs['output']
+    if output_file != 'show':
+        import matplotlib
+        matplotlib.use('agg')
+    import matplotlib.pyplot as plt
+
+    # Plot roofline (if peaks are known) and one point for each kernel
+    plt.figure()
+    ai = [k[1] for k in kernels if k[1] > 0.0]
+    if peak_bw > 0.0 and peak_flops > 0.0:
+        x = np.logspace(np.log10(min(ai + [peak_flops/peak_bw])/10.0),
+                        np.log10(max(ai + [peak_flops/peak_bw])*10.0), 200)
+        plt.loglog(x, np.minimum(peak_flops, x*peak_bw), 'k-', label='roofline')
+    for name, intensity, rate in kernels:
+        if intensity > 0.0 and rate > 0.0:
+            plt.loglog(intensity, rate, 'o', label=name)
+    plt.xlabel('arithmetic intensity (FLOP/byte)')
+    plt.ylabel('GFLOP/s')
+    plt.legend(fontsize='small')
+    if output_file == 'show':
+        plt.show()
+    else:
+        plt.savefig(output_file, bbox_inches='tight')
+
+
+# Execute main function
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('-i', '--input',
+                        help='name of input (roofline) file')
+    parser.add_argument('-o', '--output',
+                        default='show',
+                        help='image filename; omit to display to screen')
+    parser.add_argument('--peak_bandwidth', type=float, default=None,
+                        help='peak bandwidth of device (GB/s), if not set in file')
+    parser.add_argument('--peak_gflops', type=float, default=None,
+                        help='peak FLOP rate of device (GFLOP/s), if not set in file')
+
+    args = parser.parse_args()
+    main(**vars(args))